@@ -4,6 +4,7 @@
 #define MAX_LOCAL_LIGHTS 4
 @1// Forward Shading: Includes
 #include "./Flax/LightingCommon.hlsl"
+#include "./Flax/LightClusters.hlsl"
 #if USE_REFLECTIONS
 #include "./Flax/ReflectionsCommon.hlsl"
 #define MATERIAL_REFLECTIONS_SSR 1
@@ -23,10 +24,15 @@ ExponentialHeightFogData ExponentialHeightFog;
 float3 Dummy2;
 uint LocalLightsCount;
 LightData LocalLights[MAX_LOCAL_LIGHTS];
+LightClustersData LightClusters;
 @3// Forward Shading: Resources
 TextureCube EnvProbe : register(t__SRV__);
 TextureCube SkyLightTexture : register(t__SRV__);
 Texture2DArray DirectionalLightShadowMap : register(t__SRV__);
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+StructuredBuffer<uint> LightClustersIndices : register(t__SRV__);
+StructuredBuffer<LightData> LightClustersLights : register(t__SRV__);
+#endif
 @4// Forward Shading: Utilities
 DECLARE_LIGHTSHADOWDATA_ACCESS(DirectionalLightShadow);
 @5// Forward Shading: Shaders
@@ -91,13 +97,32 @@ void PS_Forward(
 	light += GetSkyLightLighting(SkyLight, gBuffer, SkyLightTexture);
 
 	// Calculate lighting from local lights
-	LOOP
-	for (uint localLightIndex = 0; localLightIndex < LocalLightsCount; localLightIndex++)
+	shadowMask = 1.0f;
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+	BRANCH
+	if (LightClusters.LightsCount > 0)
+	{
+		// Use lights from the pixel cluster
+		uint clusterOffset = GetLightClusterOffset(LightClusters, materialInput.SvPosition.xy * ScreenSize.zw, gBuffer.ViewPos.z);
+		uint clusterLightsCount = LightClustersIndices[clusterOffset];
+		LOOP
+		for (uint clusterLightIndex = 1; clusterLightIndex <= clusterLightsCount; clusterLightIndex++)
+		{
+			const LightData localLight = LightClustersLights[LightClustersIndices[clusterOffset + clusterLightIndex]];
+			bool isSpotLight = localLight.SpotAngles.x > -2.0f;
+			light += GetLighting(ViewPos, localLight, gBuffer, shadowMask, true, isSpotLight);
+		}
+	}
+	else
+#endif
 	{
-		const LightData localLight = LocalLights[localLightIndex];
-		bool isSpotLight = localLight.SpotAngles.x > -2.0f;
-		shadowMask = 1.0f;
-		light += GetLighting(ViewPos, localLight, gBuffer, shadowMask, true, isSpotLight);
+		LOOP
+		for (uint localLightIndex = 0; localLightIndex < LocalLightsCount; localLightIndex++)
+		{
+			const LightData localLight = LocalLights[localLightIndex];
+			bool isSpotLight = localLight.SpotAngles.x > -2.0f;
+			light += GetLighting(ViewPos, localLight, gBuffer, shadowMask, true, isSpotLight);
+		}
 	}
 
 	// Calculate lighting from Global Illumination
@@ -487,7 +487,7 @@ float3x3 SkinTangents(ModelInput_Skinned input, SkinningData data)
 }
 
 // Vertex Shader function for GBuffers/Depth Pass (skinned mesh rendering)
-META_VS(true, FEATURE_LEVEL_ES2)
+META_VS(USE_SKINNING_PERMUTATIONS, FEATURE_LEVEL_ES2)
 META_PERMUTATION_1(USE_SKINNING=1)
 META_PERMUTATION_2(USE_SKINNING=1, PER_BONE_MOTION_BLUR=1)
 META_VS_IN_ELEMENT(POSITION,     0, R32G32B32_FLOAT,   0, 0,     PER_VERTEX, 0, true)
@@ -27,7 +27,9 @@ float TerrainChunkSizeLOD0;
 float4 HeightmapUVScaleBias;
 float4 NeighborLOD;
 float2 OffsetUV;
-float2 Dummy0;
+float HeightmapMipOffset;
+float SplatmapMipOffset;
+float4 VirtualTextureUVScaleBias;
 @1META_CB_END
 
 // Terrain data
@@ -35,6 +37,11 @@ Texture2D Heightmap : register(t0);
 Texture2D Splatmap0 : register(t1);
 Texture2D Splatmap1 : register(t2);
 
+// Terrain virtual texture with the baked material layers (in GBuffer format)
+Texture2D VirtualTexture0 : register(t3);
+Texture2D VirtualTexture1 : register(t4);
+Texture2D VirtualTexture2 : register(t5);
+
 // Shader resources
 @2
 // Geometry data passed though the graphics rendering stages up to the pixel shader
@@ -48,6 +55,7 @@ struct GeometryData
 #if USE_TERRAIN_LAYERS
 	float4 Layers[TERRAIN_LAYERS_DATA_SIZE] : TEXCOORD5;
 #endif
+	nointerpolation float4 InstanceParams : TEXCOORD7; // xyz-chunk origin, w-per-instance random
 };
 
 // Interpolants passed from the vertex shader
@@ -91,6 +99,7 @@ struct MaterialInput
 #if USE_TERRAIN_LAYERS
 	float4 Layers[TERRAIN_LAYERS_DATA_SIZE];
 #endif
+	float4 InstanceParams;
 #if USE_CUSTOM_VERTEX_INTERPOLATORS
 	float4 CustomVSToPS[CUSTOM_VERTEX_INTERPOLATORS_COUNT];
 #endif
@@ -110,6 +119,7 @@ MaterialInput GetGeometryMaterialInput(GeometryData geometry)
 #if USE_TERRAIN_LAYERS
 	output.Layers = geometry.Layers;
 #endif
+	output.InstanceParams = geometry.InstanceParams;
 	return output;
 }
 
@@ -142,6 +152,7 @@ GeometryData InterpolateGeometry(GeometryData p0, float w0, GeometryData p1, flo
 	for (int i = 0; i < TERRAIN_LAYERS_DATA_SIZE; i++)
 		output.Layers[i] = p0.Layers[i] * w0 + p1.Layers[i] * w1 + p2.Layers[i] * w2;
 #endif
+	output.InstanceParams = p0.InstanceParams;
 	return output;
 }
 
@@ -210,7 +221,7 @@ float3 TransformWorldVectorToLocal(MaterialInput input, float3 worldVector)
 // Gets the current object position
 float3 GetObjectPosition(MaterialInput input)
 {
-	return WorldMatrix[3].xyz;
+	return input.InstanceParams.xyz;
 }
 
 // Gets the current object size
@@ -222,7 +233,7 @@ float3 GetObjectSize(MaterialInput input)
 // Get the current object random value
 float GetPerInstanceRandom(MaterialInput input)
 {
-	return PerInstanceRandom;
+	return input.InstanceParams.w;
 }
 
 // Get the current object LOD transition dither factor
@@ -251,18 +262,46 @@ Material GetMaterialDS(MaterialInput input)
 @6
 }
 
+// Get material properties function (for pixel shader, evaluates all material layers)
+Material GetMaterialLayersPS(MaterialInput input)
+{
+@4
+}
+
 // Get material properties function (for pixel shader)
 Material GetMaterialPS(MaterialInput input)
 {
-@4
+#if MATERIAL_BLEND == MATERIAL_BLEND_OPAQUE && MATERIAL_SHADING_MODEL == SHADING_MODEL_LIT && !USE_EMISSIVE
+	// Use the material layers baked into the virtual texture page (if chunk has it)
+	BRANCH
+	if (VirtualTextureUVScaleBias.x != 0)
+	{
+		float2 uv = (input.TexCoord - OffsetUV) * VirtualTextureUVScaleBias.xy + VirtualTextureUVScaleBias.zw;
+		float4 gBuffer0 = VirtualTexture0.SampleLevel(SamplerLinearClamp, uv, 0);
+		float4 gBuffer1 = VirtualTexture1.SampleLevel(SamplerLinearClamp, uv, 0);
+		float4 gBuffer2 = VirtualTexture2.SampleLevel(SamplerLinearClamp, uv, 0);
+		Material material = (Material)0;
+		material.Color = gBuffer0.rgb;
+		material.AO = gBuffer0.a;
+		material.WorldNormal = normalize(gBuffer1.rgb * 2.0 - 1.0);
+		material.TangentNormal = normalize(TransformWorldVectorToTangent(input, material.WorldNormal));
+		material.Roughness = gBuffer2.r;
+		material.Metalness = gBuffer2.g;
+		material.Specular = gBuffer2.b;
+		material.Opacity = 1;
+		material.Mask = input.HolesMask;
+		return material;
+	}
+#endif
+	return GetMaterialLayersPS(input);
 }
 
 // Calculates LOD value (with fractional part for blending)
-float CalcLOD(float2 xy, float4 morph)
+float CalcLOD(float2 xy, float4 morph, float4 neighborLOD)
 {
 #if USE_SMOOTH_LOD_TRANSITION
 	// Use LOD value based on Barycentric coordinates to morph to the lower LOD near chunk edges
-	float4 lodCalculated = morph * CurrentLOD + NeighborLOD * (float4(1, 1, 1, 1) - morph);
+	float4 lodCalculated = morph * CurrentLOD + neighborLOD * (float4(1, 1, 1, 1) - morph);
 
 	// Pick a quadrant (top, left, right or bottom)
 	float lod;
@@ -306,47 +345,77 @@ struct TerrainVertexInput
 {
 	float2 TexCoord : TEXCOORD0;
 	float4 Morph : TEXCOORD1;
+#if USE_INSTANCING
+	// Must match structure defined in TerrainMaterialShader.cpp
+	float4 InstanceOrigin : ATTRIBUTE0; // .w contains PerInstanceRandom
+	float4 InstanceHeightmapUVScaleBias : ATTRIBUTE1;
+	float4 InstanceNeighborLOD : ATTRIBUTE2;
+	float4 InstanceOffsetUV : ATTRIBUTE3; // .zw unused
+#endif
 };
 
-// Vertex Shader function for terrain rendering
+// Vertex Shader function for terrain rendering (instanced variant draws many chunks of the same patch and LOD at once)
 META_VS(true, FEATURE_LEVEL_ES2)
-META_VS_IN_ELEMENT(TEXCOORD, 0, R32G32_FLOAT,   0, ALIGN, PER_VERTEX, 0, true)
-META_VS_IN_ELEMENT(TEXCOORD, 1, R8G8B8A8_UNORM, 0, ALIGN, PER_VERTEX, 0, true)
+META_PERMUTATION_1(USE_INSTANCING=0)
+META_PERMUTATION_1(USE_INSTANCING=1)
+META_VS_IN_ELEMENT(TEXCOORD, 0, R32G32_FLOAT,      0, ALIGN, PER_VERTEX,   0, true)
+META_VS_IN_ELEMENT(TEXCOORD, 1, R8G8B8A8_UNORM,    0, ALIGN, PER_VERTEX,   0, true)
+META_VS_IN_ELEMENT(ATTRIBUTE,0, R32G32B32A32_FLOAT,3, 0,     PER_INSTANCE, 1, USE_INSTANCING)
+META_VS_IN_ELEMENT(ATTRIBUTE,1, R32G32B32A32_FLOAT,3, ALIGN, PER_INSTANCE, 1, USE_INSTANCING)
+META_VS_IN_ELEMENT(ATTRIBUTE,2, R32G32B32A32_FLOAT,3, ALIGN, PER_INSTANCE, 1, USE_INSTANCING)
+META_VS_IN_ELEMENT(ATTRIBUTE,3, R32G32B32A32_FLOAT,3, ALIGN, PER_INSTANCE, 1, USE_INSTANCING)
 VertexOutput VS(TerrainVertexInput input)
 {
 	VertexOutput output;
 
+	// Get the per-chunk data (the instanced chunks share rotation and scale of the terrain)
+	float4x4 world = WorldMatrix;
+#if USE_INSTANCING
+	world[3] = float4(input.InstanceOrigin.xyz, 1.0f);
+	float4 heightmapUVScaleBias = input.InstanceHeightmapUVScaleBias;
+	float4 neighborLOD = input.InstanceNeighborLOD;
+	float2 offsetUV = input.InstanceOffsetUV.xy;
+	output.Geometry.InstanceParams = input.InstanceOrigin;
+#else
+	float4 heightmapUVScaleBias = HeightmapUVScaleBias;
+	float4 neighborLOD = NeighborLOD;
+	float2 offsetUV = OffsetUV;
+	output.Geometry.InstanceParams = float4(WorldMatrix[3].xyz, PerInstanceRandom);
+#endif
+
 	// Calculate terrain LOD for this chunk
-	float lodCalculated = CalcLOD(input.TexCoord, input.Morph);
+	float lodCalculated = CalcLOD(input.TexCoord, input.Morph, neighborLOD);
 	float lodValue = CurrentLOD;
 	float morphAlpha = lodCalculated - CurrentLOD;
 
-	// Sample heightmap
-	float2 heightmapUVs = input.TexCoord * HeightmapUVScaleBias.xy + HeightmapUVScaleBias.zw;
+	// Sample heightmap (mip levels are relative to the resident mips of the streamed textures)
+	float heightmapLOD = max(lodValue - HeightmapMipOffset, 0);
+	float splatmapLOD = max(lodValue - SplatmapMipOffset, 0);
+	float2 heightmapUVs = input.TexCoord * heightmapUVScaleBias.xy + heightmapUVScaleBias.zw;
 #if USE_SMOOTH_LOD_TRANSITION
-	float4 heightmapValueThisLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 heightmapValueThisLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, heightmapLOD);
 	float2 nextLODPos = round(input.TexCoord * ChunkSizeNextLOD) / ChunkSizeNextLOD;
-	float2 heightmapUVsNextLOD = nextLODPos * HeightmapUVScaleBias.xy + HeightmapUVScaleBias.zw;
-	float4 heightmapValueNextLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	float2 heightmapUVsNextLOD = nextLODPos * heightmapUVScaleBias.xy + heightmapUVScaleBias.zw;
+	float4 heightmapValueNextLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, heightmapLOD + 1);
 	float4 heightmapValue = lerp(heightmapValueThisLOD, heightmapValueNextLOD, morphAlpha);
 	bool isHole = max(heightmapValueThisLOD.b + heightmapValueThisLOD.a, heightmapValueNextLOD.b + heightmapValueNextLOD.a) >= 1.9f;
 #if USE_TERRAIN_LAYERS
-	float4 splatmapValueThisLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
-	float4 splatmapValueNextLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	float4 splatmapValueThisLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, splatmapLOD);
+	float4 splatmapValueNextLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, splatmapLOD + 1);
 	float4 splatmap0Value = lerp(splatmapValueThisLOD, splatmapValueNextLOD, morphAlpha);
 #if TERRAIN_LAYERS_DATA_SIZE > 1
-	splatmapValueThisLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
-	splatmapValueNextLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	splatmapValueThisLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, splatmapLOD);
+	splatmapValueNextLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, splatmapLOD + 1);
 	float4 splatmap1Value = lerp(splatmapValueThisLOD, splatmapValueNextLOD, morphAlpha);
 #endif
 #endif
 #else
-	float4 heightmapValue = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 heightmapValue = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, heightmapLOD);
 	bool isHole = (heightmapValue.b + heightmapValue.a) >= 1.9f;
 #if USE_TERRAIN_LAYERS
-	float4 splatmap0Value = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 splatmap0Value = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, splatmapLOD);
 #if TERRAIN_LAYERS_DATA_SIZE > 1
-	float4 splatmap1Value = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 splatmap1Value = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, splatmapLOD);
 #endif
 #endif
 #endif
@@ -373,7 +442,7 @@ VertexOutput VS(TerrainVertexInput input)
 	float3 position = float3(positionXZ.x, height, positionXZ.y);
 
 	// Compute world space vertex position
-	output.Geometry.WorldPosition = mul(float4(position, 1), WorldMatrix).xyz;
+	output.Geometry.WorldPosition = mul(float4(position, 1), world).xyz;
 
 	// Compute clip space position
 	output.Position = mul(float4(output.Geometry.WorldPosition, 1), ViewProjectionMatrix);
@@ -384,7 +453,7 @@ VertexOutput VS(TerrainVertexInput input)
 #else
 	float2 texCoord = input.TexCoord;
 #endif
-	output.Geometry.TexCoord = positionXZ * (1.0f / TerrainChunkSizeLOD0) + OffsetUV;
+	output.Geometry.TexCoord = positionXZ * (1.0f / TerrainChunkSizeLOD0) + offsetUV;
 	output.Geometry.LightmapUV = texCoord * LightmapArea.zw + LightmapArea.xy;
 
 	// Extract terrain layers weights from the splatmap
@@ -397,7 +466,7 @@ VertexOutput VS(TerrainVertexInput input)
 
 	// Compute world space normal vector
 	float3x3 tangentToLocal = CalcTangentBasisFromWorldNormal(normal);
-	float3x3 tangentToWorld = CalcTangentToWorld(WorldMatrix, tangentToLocal);
+	float3x3 tangentToWorld = CalcTangentToWorld(world, tangentToLocal);
 	output.Geometry.WorldNormal = tangentToWorld[2];
 
 	// Get material input params if need to evaluate any material property
@@ -417,6 +486,7 @@ VertexOutput VS(TerrainVertexInput input)
 #if USE_TERRAIN_LAYERS
 	materialInput.Layers = output.Geometry.Layers;
 #endif
+	materialInput.InstanceParams = output.Geometry.InstanceParams;
 	Material material = GetMaterialVS(materialInput);
 #endif
 
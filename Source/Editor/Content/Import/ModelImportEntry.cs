@@ -135,7 +135,7 @@ public class ModelImportSettings
         private bool ShowSmoothingTangentsAngle => ShowGeometry && CalculateTangents;
 
         /// <summary>
-        /// Enable/disable meshes geometry optimization.
+        /// Enable/disable meshes geometry optimization (reorders triangles and vertices for the GPU vertex cache, overdraw and vertex fetch efficiency, removes unused vertices).
         /// </summary>
         [EditorDisplay("Geometry"), VisibleIf(nameof(ShowGeometry))]
         [EditorOrder(50), DefaultValue(true)]
@@ -337,6 +337,34 @@ public class ModelImportSettings
         [EditorOrder(1510), DefaultValue(1.0f), Limit(0.0001f, 100.0f)]
         public float SDFResolution { get; set; } = 1.0f;
 
+        /// <summary>
+        /// If checked, enables baking of the octahedral impostor used to draw the model as a single quad at far distances (captured from the last LOD).
+        /// </summary>
+        [EditorDisplay("Impostor"), VisibleIf(nameof(ShowModel))]
+        [EditorOrder(1600), DefaultValue(false)]
+        public bool GenerateImpostor { get; set; } = false;
+
+        /// <summary>
+        /// The amount of the impostor views captured per atlas side (total views count is squared). Higher values reduce popping when view angle changes but increase memory usage.
+        /// </summary>
+        [EditorDisplay("Impostor"), VisibleIf(nameof(ShowModel))]
+        [EditorOrder(1610), DefaultValue(8), Limit(2, 32)]
+        public int ImpostorFrames { get; set; } = 8;
+
+        /// <summary>
+        /// The resolution (in pixels) of a single impostor view in the atlas.
+        /// </summary>
+        [EditorDisplay("Impostor"), VisibleIf(nameof(ShowModel))]
+        [EditorOrder(1620), DefaultValue(128), Limit(16, 1024)]
+        public int ImpostorResolution { get; set; } = 128;
+
+        /// <summary>
+        /// The model screen size below which the impostor is used instead of the meshes.
+        /// </summary>
+        [EditorDisplay("Impostor"), VisibleIf(nameof(ShowModel))]
+        [EditorOrder(1630), DefaultValue(0.05f), Limit(0.0f, 1.0f, 0.001f)]
+        public float ImpostorScreenSize { get; set; } = 0.05f;
+
         /// <summary>
         /// If checked, the imported mesh/animations are splitted into separate assets. Used if ObjectIndex is set to -1.
         /// </summary>
@@ -405,6 +433,12 @@ internal struct InternalOptions
             public byte GenerateSDF;
             public float SDFResolution;
 
+            // Impostor
+            public byte GenerateImpostor;
+            public int ImpostorFrames;
+            public int ImpostorResolution;
+            public float ImpostorScreenSize;
+
             // Splitting
             public byte SplitObjects;
             public int ObjectIndex;
@@ -449,6 +483,10 @@ internal void ToInternal(out InternalOptions options)
                 RestoreMaterialsOnReimport = (byte)(RestoreMaterialsOnReimport ? 1 : 0),
                 GenerateSDF = (byte)(GenerateSDF ? 1 : 0),
                 SDFResolution = SDFResolution,
+                GenerateImpostor = (byte)(GenerateImpostor ? 1 : 0),
+                ImpostorFrames = ImpostorFrames,
+                ImpostorResolution = ImpostorResolution,
+                ImpostorScreenSize = ImpostorScreenSize,
                 SplitObjects = (byte)(SplitObjects ? 1 : 0),
                 ObjectIndex = ObjectIndex,
             };
@@ -490,6 +528,10 @@ internal void FromInternal(ref InternalOptions options)
             RestoreMaterialsOnReimport = options.RestoreMaterialsOnReimport != 0;
             GenerateSDF = options.GenerateSDF != 0;
             SDFResolution = options.SDFResolution;
+            GenerateImpostor = options.GenerateImpostor != 0;
+            ImpostorFrames = options.ImpostorFrames;
+            ImpostorResolution = options.ImpostorResolution;
+            ImpostorScreenSize = options.ImpostorScreenSize;
             SplitObjects = options.SplitObjects != 0;
             ObjectIndex = options.ObjectIndex;
         }
@@ -27,7 +27,8 @@ DECLARE_BINARY_ASSET_HEADER(PreviewsCache, TexturesSerializedVersion);
     public:
 
         FlushTask(PreviewsCache* cache)
-            : _cache(cache)
+            : ThreadPoolTask(ThreadPoolTaskPriority::Background)
+            , _cache(cache)
         {
         }
 
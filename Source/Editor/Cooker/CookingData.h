@@ -283,6 +283,16 @@ DECLARE_SCRIPTING_TYPE(CookingData);
     /// </summary>
     HashSet<Guid> Assets;
 
+    /// <summary>
+    /// The direct dependencies (referenced assets) of the assets included in build (valid only after CollectAssetsStep). Saved to the assets registry index to prefetch dependencies at runtime.
+    /// </summary>
+    Dictionary<Guid, Array<Guid>> AssetDependencies;
+
+    /// <summary>
+    /// The materials used by the skinned models included in build (valid only during CookAssetsStep and if BuildSettings::StripUnusedMaterialPermutations is enabled). Contains the base materials of the used material instances.
+    /// </summary>
+    HashSet<Guid> SkinnedMaterials;
+
     struct BinaryModuleInfo
     {
         String Name;
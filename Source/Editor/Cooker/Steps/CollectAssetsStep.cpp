@@ -30,6 +30,15 @@ bool CollectAssetsStep::Process(CookingData& data, Asset* asset)
     asset->Locker.Unlock();
     _assetsQueue.Add(_references);
 
+    // Record asset dependencies (used to prefetch them at runtime)
+    auto& dependencies = data.AssetDependencies[asset->GetID()];
+    dependencies.Clear();
+    for (const Guid& id : _references)
+    {
+        if (id.IsValid() && id != asset->GetID() && !dependencies.Contains(id))
+            dependencies.Add(id);
+    }
+
     return false;
 }
 
@@ -39,6 +48,7 @@ bool CollectAssetsStep::Perform(CookingData& data)
     data.StepProgress(TEXT("Collecting assets"), 0);
 
     // Initialize assets queue
+    data.AssetDependencies.Clear();
     _assetsQueue.Clear();
     _assetsQueue.EnsureCapacity(1024);
     for (auto i = data.RootAssets.Begin(); i.IsNotEnd(); ++i)
@@ -79,6 +89,17 @@ bool CollectAssetsStep::Perform(CookingData& data)
         Process(data, asset);
     }
 
+    // Skip references to objects that are not assets included in build (eg. scene objects or missing assets)
+    for (auto i = data.AssetDependencies.Begin(); i.IsNotEnd(); ++i)
+    {
+        auto& dependencies = i->Value;
+        for (int32 j = dependencies.Count() - 1; j >= 0; j--)
+        {
+            if (!data.Assets.Contains(dependencies[j]))
+                dependencies.RemoveAt(j);
+        }
+    }
+
     data.Stats.TotalAssets = data.Assets.Count();
     LOG(Info, "Found {0} assets to deploy!", data.Assets.Count());
 
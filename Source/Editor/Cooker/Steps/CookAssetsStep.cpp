@@ -5,6 +5,7 @@
 #include "Engine/Core/DeleteMe.h"
 #include "Engine/Core/Utilities.h"
 #include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Platform/File.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Content/Asset.h"
@@ -12,14 +13,22 @@
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Content/Assets/Material.h"
+#include "Engine/Content/Assets/MaterialInstance.h"
+#include "Engine/Content/Assets/SkinnedModel.h"
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Assets/Texture.h"
 #include "Engine/Content/Assets/CubeTexture.h"
 #include "Engine/Render2D/SpriteAtlas.h"
 #include "Engine/Content/Storage/FlaxFile.h"
 #include "Engine/Particles/ParticleEmitter.h"
+#include "Engine/Level/Prefabs/Prefab.h"
+#include "Engine/Level/Scene/SceneAsset.h"
 #include "Engine/Utilities/Encryption.h"
+#include "Engine/Utilities/Crc.h"
+#include "Engine/Threading/ThreadSpawner.h"
+#include "Engine/Threading/Threading.h"
 #include "Engine/Serialization/JsonWriters.h"
+#include "Engine/Serialization/JsonTools.h"
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Core/Config/PlatformSettings.h"
@@ -28,6 +37,7 @@
 #include "Engine/Streaming/StreamingSettings.h"
 #include "Engine/ShadersCompilation/ShadersCompilation.h"
 #include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Graphics/Materials/MaterialShader.h"
@@ -46,7 +56,42 @@
 #endif
 #include "FlaxEngine.Gen.h"
 
+// Version of the cooking cache header file format
+#define COOKING_CACHE_VERSION 3
+#define COOKING_MAX_THREADS 8
+
 Dictionary<String, CookAssetsStep::ProcessAssetFunc> CookAssetsStep::AssetProcessors;
+HashSet<String> CookAssetsStep::ParallelAssetProcessors;
+
+static uint32 GetFileHash(const StringView& path)
+{
+    auto file = File::Open(path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+    if (!file)
+        return 0;
+    uint32 hash = 0;
+    Array<byte> buffer;
+    buffer.Resize(1024 * 1024);
+    uint32 bytesRead;
+    while (!file->Read(buffer.Get(), buffer.Count(), &bytesRead) && bytesRead != 0)
+        hash = Crc::MemCrc32(buffer.Get(), (int32)bytesRead, hash);
+    Delete(file);
+    return hash;
+}
+
+static bool IsFileValid(const StringView& path, DateTime& modified, uint32 hash)
+{
+    const DateTime fileModified = FileSystem::GetFileLastEditTime(path);
+    if (fileModified <= modified)
+        return true;
+
+    // File could be touched without changing its contents (eg. by source control checkout)
+    if (hash != 0 && GetFileHash(path) == hash)
+    {
+        modified = fileModified;
+        return true;
+    }
+    return false;
+}
 
 bool CookAssetsStep::CacheEntry::IsValid(bool withDependencies)
 {
@@ -55,14 +100,15 @@ bool CookAssetsStep::CacheEntry::IsValid(bool withDependencies)
     {
         if (TypeName == assetInfo.TypeName)
         {
-            if (FileSystem::GetFileLastEditTime(assetInfo.Path) <= FileModified)
+            if (IsFileValid(assetInfo.Path, FileModified, FileHash))
             {
                 bool isValid = true;
                 if (withDependencies)
                 {
-                    for (auto& f : FileDependencies)
+                    for (int32 i = 0; i < FileDependencies.Count(); i++)
                     {
-                        if (FileSystem::GetFileLastEditTime(f.First) > f.Second)
+                        auto& f = FileDependencies[i];
+                        if (!IsFileValid(f.First, f.Second, i < FileDependenciesHashes.Count() ? FileDependenciesHashes[i] : 0))
                         {
                             isValid = false;
                             break;
@@ -110,9 +156,17 @@ void CookAssetsStep::CacheData::InvalidateCachePerType(const StringView& typeNam
     }
 }
 
+uint32 GetSkinnedMaterialsHash(const CookingData& data)
+{
+    uint32 hash = 0;
+    for (auto i = data.SkinnedMaterials.Begin(); i.IsNotEnd(); ++i)
+        hash ^= GetHash(i->Item);
+    return hash;
+}
+
 void CookAssetsStep::CacheData::Load(CookingData& data)
 {
-    HeaderFilePath = data.CacheDirectory / String::Format(TEXT("CookedHeader_{0}.bin"), FLAXENGINE_VERSION_BUILD);
+    HeaderFilePath = data.CacheDirectory / String::Format(TEXT("CookedHeader_{0}_{1}.bin"), FLAXENGINE_VERSION_BUILD, COOKING_CACHE_VERSION);
     CacheFolder = data.CacheDirectory / TEXT("Cooked");
     Entries.Clear();
 
@@ -148,6 +202,7 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
     Entries.EnsureCapacity(Math::RoundUpToPowerOf2(static_cast<int32>(entriesCount * 3.0f)));
 
     Array<Pair<String, DateTime>> fileDependencies;
+    Array<uint32> fileDependenciesHashes;
     for (int32 i = 0; i < entriesCount; i++)
     {
         Guid id;
@@ -156,15 +211,20 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
         file->ReadString(&typeName);
         DateTime fileModified;
         file->Read(fileModified);
+        uint32 fileHash;
+        file->ReadUint32(&fileHash);
         int32 fileDependenciesCount;
         file->ReadInt32(&fileDependenciesCount);
         fileDependencies.Clear();
         fileDependencies.Resize(fileDependenciesCount);
+        fileDependenciesHashes.Clear();
+        fileDependenciesHashes.Resize(fileDependenciesCount);
         for (int32 j = 0; j < fileDependenciesCount; j++)
         {
             Pair<String, DateTime>& f = fileDependencies[j];
             file->ReadString(&f.First, 10);
             file->Read(f.Second);
+            file->ReadUint32(&fileDependenciesHashes[j]);
         }
 
         // Skip missing entries
@@ -175,7 +235,9 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
         e.ID = id;
         e.TypeName = typeName;
         e.FileModified = fileModified;
+        e.FileHash = fileHash;
         e.FileDependencies = fileDependencies;
+        e.FileDependenciesHashes = fileDependenciesHashes;
     }
 
     int32 checkChar;
@@ -216,6 +278,12 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
         LOG(Info, "{0} option has been modified.", TEXT("ShadersGenerateDebugData"));
         invalidateShaders = true;
     }
+    if (buildSettings->StripUnusedMaterialPermutations != Settings.Global.StripUnusedMaterialPermutations ||
+        (buildSettings->StripUnusedMaterialPermutations && GetSkinnedMaterialsHash(data) != Settings.Global.SkinnedMaterialsHash))
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("StripUnusedMaterialPermutations"));
+        InvalidateCachePerType(Material::TypeName);
+    }
 #if PLATFORM_TOOLS_WINDOWS
     if (data.Platform == BuildPlatform::Windows32 || data.Platform == BuildPlatform::Windows64)
     {
@@ -277,6 +345,7 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
 
 void CookAssetsStep::CacheData::Save()
 {
+    ScopeLock lock(Locker);
     LOG(Info, "Saving incremental build cooking cache (entries count: {0})", Entries.Count());
 
     auto file = FileWriteStream::Open(HeaderFilePath);
@@ -294,11 +363,14 @@ void CookAssetsStep::CacheData::Save()
         file->Write(e.ID);
         file->WriteString(e.TypeName);
         file->Write(e.FileModified);
+        file->WriteUint32(e.FileHash);
         file->WriteInt32(e.FileDependencies.Count());
-        for (auto& f : e.FileDependencies)
+        for (int32 j = 0; j < e.FileDependencies.Count(); j++)
         {
+            auto& f = e.FileDependencies[j];
             file->Write(f.First, 10);
             file->Write(f.Second);
+            file->WriteUint32(j < e.FileDependenciesHashes.Count() ? e.FileDependenciesHashes[j] : 0);
         }
     }
     file->WriteInt32(13);
@@ -395,6 +467,7 @@ bool ProcessShaderBase(CookAssetsStep::AssetCookData& data, ShaderAssetBase* ass
     options.NoOptimize = data.Cache.Settings.Global.ShadersNoOptimize;
     options.GenerateDebugData = data.Cache.Settings.Global.ShadersGenerateDebugData;
     options.TreatWarningsAsErrors = false;
+    options.StripSkinning = data.Cache.Settings.Global.StripUnusedMaterialPermutations && !data.Data.SkinnedMaterials.Contains(asset->GetID());
     options.Output = &cacheStream;
     Array<String> includes;
 
@@ -747,6 +820,29 @@ CookAssetsStep::CookAssetsStep()
     AssetProcessors.Add(Texture::TypeName, ProcessTextureBase);
     AssetProcessors.Add(CubeTexture::TypeName, ProcessTextureBase);
     AssetProcessors.Add(SpriteAtlas::TypeName, ProcessTextureBase);
+    ParallelAssetProcessors.Add(Material::TypeName);
+    ParallelAssetProcessors.Add(Shader::TypeName);
+    ParallelAssetProcessors.Add(ParticleEmitter::TypeName);
+    ParallelAssetProcessors.Add(Texture::TypeName);
+    ParallelAssetProcessors.Add(CubeTexture::TypeName);
+    ParallelAssetProcessors.Add(SpriteAtlas::TypeName);
+}
+
+template<typename AssetType>
+static void UpdateCacheEntry(CookAssetsStep::CacheData& cache, const AssetType* asset, CookAssetsStep::FileDependenciesList& fileDependencies, String& cachedFilePath)
+{
+    // Hash inputs before locking the cache (it reads whole files)
+    const uint32 fileHash = GetFileHash(asset->GetPath());
+    Array<uint32> fileDependenciesHashes;
+    fileDependenciesHashes.Resize(fileDependencies.Count());
+    for (int32 i = 0; i < fileDependencies.Count(); i++)
+        fileDependenciesHashes[i] = GetFileHash(fileDependencies[i].First);
+
+    ScopeLock lock(cache.Locker);
+    auto& entry = cache.CreateEntry(asset, cachedFilePath);
+    entry.FileHash = fileHash;
+    entry.FileDependencies = MoveTemp(fileDependencies);
+    entry.FileDependenciesHashes = MoveTemp(fileDependenciesHashes);
 }
 
 bool CookAssetsStep::Process(CookingData& data, CacheData& cache, BinaryAsset* asset)
@@ -791,8 +887,7 @@ bool CookAssetsStep::Process(CookingData& data, CacheData& cache, BinaryAsset* a
 
     // Save cache
     String cachedFilePath;
-    auto& entry = cache.CreateEntry(asset, cachedFilePath);
-    entry.FileDependencies = MoveTemp(fileDependencies);
+    UpdateCacheEntry(cache, asset, fileDependencies, cachedFilePath);
     const bool result = FlaxStorage::Create(cachedFilePath, initData);
 
     // Cleanup allocated data chunks
@@ -835,8 +930,7 @@ bool CookAssetsStep::Process(CookingData& data, CacheData& cache, JsonAssetBase*
 
     // Save cache
     String cachedFilePath;
-    auto& entry = cache.CreateEntry(asset, cachedFilePath);
-    entry.FileDependencies = MoveTemp(fileDependencies);
+    UpdateCacheEntry(cache, asset, fileDependencies, cachedFilePath);
     const bool result = FlaxStorage::Create(cachedFilePath, initData);
 
     // Cleanup allocated data chunks
@@ -953,6 +1047,7 @@ class PackageBuilder : public NonCopyable
             return false;
 
         // Get assets init data and load all chunks
+        const auto& compressionRules = BuildSettings::Get()->ChunksCompressionRules;
         Array<AssetInitData> assetsData;
         assetsData.Resize(count);
         for (int32 i = 0; i < count; i++)
@@ -974,6 +1069,25 @@ class PackageBuilder : public NonCopyable
                     }
                 }
             }
+
+            // Apply chunks compression rule for this asset type
+            for (const ChunksCompressionRule& rule : compressionRules)
+            {
+                if (rule.AssetType != assetsData[i].Header.TypeName)
+                    continue;
+                for (int32 j = 0; j < ASSET_FILE_DATA_CHUNKS; j++)
+                {
+                    const auto chunk = assetsData[i].Header.Chunks[j];
+                    if (!chunk)
+                        continue;
+                    chunk->Flags &= ~(FlaxChunkFlags::CompressedLZ4 | FlaxChunkFlags::HighCompression);
+                    if (rule.Compression == ChunksCompression::LZ4)
+                        chunk->Flags |= FlaxChunkFlags::CompressedLZ4;
+                    else if (rule.Compression == ChunksCompression::LZ4HC)
+                        chunk->Flags |= FlaxChunkFlags::CompressedLZ4 | FlaxChunkFlags::HighCompression;
+                }
+                break;
+            }
         }
 
         // Create package
@@ -1000,6 +1114,102 @@ class PackageBuilder : public NonCopyable
     }
 };
 
+bool CookAssetsStep::Cook(CookingData& data, CacheData& cache, const Guid& assetId)
+{
+    // Load asset (and keep ref)
+    AssetReference<Asset> assetRef;
+    assetRef.Unload.Bind([]() { LOG(Error, "Asset gets unloaded while cooking it!"); Platform::Sleep(100); });
+    assetRef = Content::LoadAsync<Asset>(assetId);
+    if (assetRef == nullptr)
+    {
+        data.Error(TEXT("Failed to load asset included in build."));
+        return true;
+    }
+    cache.Locker.Lock();
+    AssetsRegistry[assetId].Info.TypeName = assetRef->GetTypeName();
+    cache.Locker.Unlock();
+
+    // Cook asset
+    if (Process(data, cache, assetRef.Get()))
+        return true;
+
+    // Auto save build cache after every few cooked assets (reduces next build time if cooking fails later)
+    ScopeLock lock(cache.Locker);
+    data.Stats.CookedAssets++;
+    if (data.Stats.CookedAssets % 50 == 0)
+    {
+        cache.Save();
+    }
+    return false;
+}
+
+void AddSkinnedMaterial(CookingData& data, MaterialBase* material)
+{
+    // Material instances use the shader of the base material
+    while (material && !material->WaitForLoaded())
+    {
+        if (!material->IsMaterialInstance())
+        {
+            data.SkinnedMaterials.Add(material->GetID());
+            break;
+        }
+        material = static_cast<MaterialInstance*>(material)->GetBaseMaterial();
+    }
+}
+
+void CollectSkinnedMaterials(CookingData& data)
+{
+    // Default material is used as a fallback for skinned meshes
+    AddSkinnedMaterial(data, GPUDevice::Instance->GetDefaultMaterial());
+
+    AssetInfo assetInfo;
+    for (auto i = data.Assets.Begin(); i.IsNotEnd(); ++i)
+    {
+        if (!Content::GetAssetInfo(i->Item, assetInfo))
+            continue;
+        if (assetInfo.TypeName == SkinnedModel::TypeName)
+        {
+            // Materials assigned to the skinned model slots
+            const auto model = Content::Load<SkinnedModel>(i->Item);
+            if (!model)
+                continue;
+            for (const MaterialSlot& slot : model->MaterialSlots)
+                AddSkinnedMaterial(data, slot.Material);
+        }
+        else if (assetInfo.TypeName == SceneAsset::TypeName || assetInfo.TypeName == Prefab::TypeName)
+        {
+            // Materials overriden by the animated models (objects without type are prefab instances so check them too)
+            const auto asset = Content::Load<JsonAssetBase>(i->Item);
+            if (!asset || !asset->Data || !asset->Data->IsArray())
+                continue;
+            for (auto& obj : asset->Data->GetArray())
+            {
+                if (!obj.IsObject())
+                    continue;
+                const auto typeName = obj.FindMember("TypeName");
+                if (typeName != obj.MemberEnd() && typeName->value.IsString() && StringAnsiView(typeName->value.GetString(), (int32)typeName->value.GetStringLength()) != StringAnsiView("FlaxEngine.AnimatedModel"))
+                    continue;
+                const auto buffer = obj.FindMember("Buffer");
+                if (buffer == obj.MemberEnd() || !buffer->value.IsObject())
+                    continue;
+                const auto entries = buffer->value.FindMember("Entries");
+                if (entries == buffer->value.MemberEnd() || !entries->value.IsArray())
+                    continue;
+                for (auto& entry : entries->value.GetArray())
+                {
+                    if (!entry.IsObject())
+                        continue;
+                    const Guid materialId = JsonTools::GetGuid(entry, "Material");
+                    if (materialId.IsValid())
+                        AddSkinnedMaterial(data, Content::Load<MaterialBase>(materialId));
+                }
+            }
+        }
+    }
+
+    LOG(Info, "Found {0} materials used by skinned models", data.SkinnedMaterials.Count());
+}
+
 bool CookAssetsStep::Perform(CookingData& data)
 {
     float Step1ProgressStart = 0.1f;
@@ -1018,6 +1228,14 @@ bool CookAssetsStep::Perform(CookingData& data)
     AssetsRegistry.Clear();
     AssetPathsMapping.Clear();
 
+    // Find materials used by the skinned models to skip unused shader permutations
+    data.SkinnedMaterials.Clear();
+    if (buildSettings->StripUnusedMaterialPermutations)
+    {
+        data.StepProgress(TEXT("Collecting skinned materials"), 0);
+        CollectSkinnedMaterials(data);
+    }
+
     // Load incremental build cache
     CacheData cache;
     cache.Load(data);
@@ -1048,6 +1266,8 @@ bool CookAssetsStep::Perform(CookingData& data)
     {
         cache.Settings.Global.ShadersNoOptimize = buildSettings->ShadersNoOptimize;
         cache.Settings.Global.ShadersGenerateDebugData = buildSettings->ShadersGenerateDebugData;
+        cache.Settings.Global.StripUnusedMaterialPermutations = buildSettings->StripUnusedMaterialPermutations;
+        cache.Settings.Global.SkinnedMaterialsHash = GetSkinnedMaterialsHash(data);
         cache.Settings.Global.StreamingSettingsAssetId = gameSettings->Streaming;
         cache.Settings.Global.ShadersVersion = GPU_SHADER_CACHE_VERSION;
         cache.Settings.Global.MaterialGraphVersion = MATERIAL_GRAPH_VERSION;
@@ -1062,14 +1282,11 @@ bool CookAssetsStep::Perform(CookingData& data)
 #if ENABLE_ASSETS_DISCOVERY
     auto minDateTime = DateTime::MinValue();
 #endif
-    int32 subStepIndex = 0;
-    AssetReference<Asset> assetRef;
-    assetRef.Unload.Bind([]() { LOG(Error, "Asset gets unloaded while cooking it!"); Platform::Sleep(100); });
+    Array<Guid> assetsToCook, assetsToCookSerial;
     for (auto i = data.Assets.Begin(); i.IsNotEnd(); ++i)
     {
         BUILD_STEP_CANCEL_CHECK;
 
-        data.StepProgress(Step1Info, Math::Lerp(Step1ProgressStart, Step1ProgressEnd, static_cast<float>(subStepIndex++) / data.Assets.Count()));
         const Guid assetId = i->Item;
 
         // Register asset
@@ -1084,62 +1301,77 @@ bool CookAssetsStep::Perform(CookingData& data)
         if (cachedEntry)
         {
             ASSERT(cachedEntry->ID == assetId);
-
-            // Get actual asset info
-            if (Content::GetAssetInfo(assetId, assetInfo))
+            if (cachedEntry->IsValid(true))
             {
-                // Ensure that cached entry is valid
-                if (cachedEntry->TypeName == assetInfo.TypeName)
-                {
-                    // Check if file hasn't been modified
-                    if (FileSystem::GetFileLastEditTime(assetInfo.Path) <= cachedEntry->FileModified)
-                    {
-                        // Check all dependant files
-                        bool isValid = true;
-                        for (auto& f : cachedEntry->FileDependencies)
-                        {
-                            if (FileSystem::GetFileLastEditTime(f.First) > f.Second)
-                            {
-                                isValid = false;
-                                break;
-                            }
-                        }
+                // Cache hit!
+                e.Info.TypeName = cachedEntry->TypeName;
+                continue;
+            }
+        }
 
-                        if (isValid)
-                        {
-                            // Cache hit!
-                            e.Info.TypeName = assetInfo.TypeName;
-                            continue;
-                        }
-                    }
-                }
-                else
+        // Assets with processors that are not thread-safe are cooked on a single thread
+        if (!Content::GetAssetInfo(assetId, assetInfo) || (AssetProcessors.ContainsKey(assetInfo.TypeName) && !ParallelAssetProcessors.Contains(assetInfo.TypeName)))
+            assetsToCookSerial.Add(assetId);
+        else
+            assetsToCook.Add(assetId);
+    }
+    const int32 assetsToCookCount = assetsToCook.Count() + assetsToCookSerial.Count();
+    LOG(Info, "Cooking {0} assets ({1} in parallel), {2} assets up to date", assetsToCookCount, assetsToCook.Count(), data.Assets.Count() - assetsToCookCount);
+
+    // Cook assets in parallel (on a few dedicated threads to keep the Job System workers free for the Editor frames)
+    if (assetsToCook.HasItems())
+    {
+        volatile int64 nextIndex = 0, doneCount = 0, failedCount = 0;
+        const Function<int32()> worker = [&]()
+        {
+            int64 i;
+            while ((i = Platform::InterlockedIncrement(&nextIndex) - 1) < assetsToCook.Count())
+            {
+                if (Platform::AtomicRead(&failedCount) == 0 && !GameCooker::IsCancelRequested())
                 {
-                    // Remove invalid entry
-                    cache.Entries.Remove(assetId);
+                    if (Cook(data, cache, assetsToCook[(int32)i]))
+                        Platform::InterlockedIncrement(&failedCount);
                 }
+                Platform::InterlockedIncrement(&doneCount);
             }
+            return 0;
+        };
+        const int32 threadsCount = Math::Clamp<int32>((int32)Platform::GetCPUInfo().ProcessorCoreCount / 2, 1, Math::Min(COOKING_MAX_THREADS, assetsToCook.Count()));
+        Array<Thread*, InlinedAllocation<COOKING_MAX_THREADS>> threads;
+        for (int32 i = 0; i < threadsCount; i++)
+        {
+            Thread* thread = ThreadSpawner::Start(worker, String::Format(TEXT("Cook Assets {0}"), i), ThreadPriority::BelowNormal);
+            if (thread)
+                threads.Add(thread);
         }
-
-        // Load asset (and keep ref)
-        assetRef = Content::LoadAsync<Asset>(assetId);
-        if (assetRef == nullptr)
+        if (threads.IsEmpty())
         {
-            data.Error(TEXT("Failed to load asset included in build."));
-            return true;
+            // Fallback to cooking on the build thread
+            worker();
         }
-        e.Info.TypeName = assetRef->GetTypeName();
-
-        // Cook asset
-        if (Process(data, cache, assetRef.Get()))
-            return true;
-        data.Stats.CookedAssets++;
-
-        // Auto save build cache after every few cooked assets (reduces next build time if cooking fails later)
-        if (data.Stats.CookedAssets % 50 == 0)
+        int64 done;
+        while ((done = Platform::AtomicRead(&doneCount)) < assetsToCook.Count())
         {
-            cache.Save();
+            data.StepProgress(Step1Info, Math::Lerp(Step1ProgressStart, Step1ProgressEnd, static_cast<float>(done) / assetsToCookCount));
+            Platform::Sleep(10);
         }
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            Delete(thread);
+        }
+        if (Platform::AtomicRead(&failedCount) != 0)
+            return true;
+    }
+
+    // Cook remaining assets
+    for (int32 i = 0; i < assetsToCookSerial.Count(); i++)
+    {
+        BUILD_STEP_CANCEL_CHECK;
+
+        data.StepProgress(Step1Info, Math::Lerp(Step1ProgressStart, Step1ProgressEnd, static_cast<float>(assetsToCook.Count() + i) / assetsToCookCount));
+        if (Cook(data, cache, assetsToCookSerial[i]))
+            return true;
     }
 
     // Save build cache header
@@ -1187,13 +1419,54 @@ bool CookAssetsStep::Perform(CookingData& data)
     {
         PackageBuilder packageBuilder(buildSettings->MaxAssetsPerPackage, buildSettings->MaxPackageSizeMB, contentKey);
 
-        subStepIndex = 0;
+        // Sort assets to match the recorded load order (traced assets go first in the first-use order)
+        Array<AssetsCache::Entry*> assetsOrder;
+        assetsOrder.EnsureCapacity(AssetsRegistry.Count());
         for (auto i = AssetsRegistry.Begin(); i.IsNotEnd(); ++i)
+            assetsOrder.Add(&i->Value);
+        if (buildSettings->LoadOrderTraces.HasItems())
+        {
+            Dictionary<Guid, int32> loadOrder;
+            for (const String& tracePath : buildSettings->LoadOrderTraces)
+            {
+                StringAnsi trace;
+                if (File::ReadAllText(FileSystem::ConvertRelativePathToAbsolute(Globals::ProjectFolder, tracePath), trace))
+                {
+                    LOG(Warning, "Failed to load assets load order trace '{0}'", tracePath);
+                    continue;
+                }
+                Array<StringAnsi> lines;
+                trace.Split('\n', lines);
+                for (const StringAnsi& line : lines)
+                {
+                    Guid id;
+                    if (line.Length() >= 32 && !Guid::Parse(StringAnsiView(line.Get(), 32), id) && !loadOrder.ContainsKey(id))
+                        loadOrder.Add(id, loadOrder.Count());
+                }
+            }
+            LOG(Info, "Using assets load order trace with {0} assets", loadOrder.Count());
+            Array<int64> assetsOrderKeys; // Load order in high bits, collection index in low bits
+            assetsOrderKeys.Resize(assetsOrder.Count());
+            for (int32 i = 0; i < assetsOrder.Count(); i++)
+            {
+                int32 order;
+                if (!loadOrder.TryGet(assetsOrder[i]->Info.ID, order))
+                    order = MAX_int32;
+                assetsOrderKeys[i] = ((int64)order << 32) | i;
+            }
+            Sorting::QuickSort(assetsOrderKeys.Get(), assetsOrderKeys.Count());
+            auto assetsOrderUnsorted = assetsOrder;
+            for (int32 i = 0; i < assetsOrder.Count(); i++)
+                assetsOrder[i] = assetsOrderUnsorted[(int32)(assetsOrderKeys[i] & MAX_uint32)];
+        }
+
+        int32 subStepIndex = 0;
+        for (AssetsCache::Entry* entry : assetsOrder)
         {
             BUILD_STEP_CANCEL_CHECK;
 
             data.StepProgress(Step2Info, Math::Lerp(Step2ProgressStart, Step2ProgressEnd, static_cast<float>(subStepIndex++) / AssetsRegistry.Count()));
-            const auto assetId = i->Key;
+            const auto assetId = entry->Info.ID;
 
             String cookedFilePath;
             cache.GetFilePath(assetId, cookedFilePath);
@@ -1204,11 +1477,11 @@ bool CookAssetsStep::Perform(CookingData& data)
                 continue;
             }
 
-            auto& assetStats = data.Stats.AssetStats[i->Value.Info.TypeName];
+            auto& assetStats = data.Stats.AssetStats[entry->Info.TypeName];
             assetStats.Count++;
             assetStats.ContentSize += FileSystem::GetFileSize(cookedFilePath);
 
-            if (packageBuilder.Add(data, i->Value, cookedFilePath))
+            if (packageBuilder.Add(data, *entry, cookedFilePath))
                 return true;
         }
         if (packageBuilder.Package(data))
@@ -1251,6 +1524,11 @@ bool CookAssetsStep::Perform(CookingData& data)
         data.Error(TEXT("Failed to create assets registry."));
         return true;
     }
+    if (AssetsCache::SaveIndex(data.DataOutputPath / TEXT("Content/AssetsCache.idx"), AssetsRegistry, AssetPathsMapping, &data.AssetDependencies, AssetsCacheFlags::RelativePaths))
+    {
+        data.Error(TEXT("Failed to create assets registry index."));
+        return true;
+    }
 
     // Print stats
     LOG(Info, "Cooked {0} assets, total assets: {1}, total content packages size: {2} MB", data.Stats.CookedAssets, AssetsRegistry.Count(), data.Stats.ContentSizeMB);
@@ -6,8 +6,10 @@
 #include "Engine/Core/Types/Pair.h"
 #include "Engine/Core/Types/DateTime.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Content/AssetInfo.h"
 #include "Engine/Content/Cache/AssetsCache.h"
+#include "Engine/Platform/CriticalSection.h"
 
 class Asset;
 class BinaryAsset;
@@ -45,11 +47,21 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
         /// </summary>
         DateTime FileModified;
 
+        /// <summary>
+        /// The asset file contents hash. Used to keep the entry valid if file has been touched but not modified (eg. after a fresh source control checkout).
+        /// </summary>
+        uint32 FileHash = 0;
+
         /// <summary>
         /// The list of files on which this entry depends on. Cached date is the last edit time used to discard cache result on modification.
         /// </summary>
         FileDependenciesList FileDependencies;
 
+        /// <summary>
+        /// The contents hashes of the files from the FileDependencies list (in the same order).
+        /// </summary>
+        Array<uint32> FileDependenciesHashes;
+
         bool IsValid(bool withDependencies = false);
     };
 
@@ -96,6 +108,8 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
             {
                 bool ShadersNoOptimize;
                 bool ShadersGenerateDebugData;
+                bool StripUnusedMaterialPermutations;
+                uint32 SkinnedMaterialsHash;
                 Guid StreamingSettingsAssetId;
                 int32 ShadersVersion;
                 int32 MaterialGraphVersion;
@@ -108,6 +122,11 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
         /// </summary>
         Dictionary<Guid, CacheEntry> Entries;
 
+        /// <summary>
+        /// The cache data access locker (assets are cooked in parallel).
+        /// </summary>
+        CriticalSection Locker;
+
     public:
 
         /// <summary>
@@ -174,6 +193,11 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
     /// </summary>
     static Dictionary<String, ProcessAssetFunc> AssetProcessors;
 
+    /// <summary>
+    /// The asset types with a custom processor that can be cooked in parallel (processor is thread-safe). Assets without a custom processor are always cooked in parallel.
+    /// </summary>
+    static HashSet<String> ParallelAssetProcessors;
+
     static bool ProcessDefaultAsset(AssetCookData& options);
     
 private:
@@ -184,6 +208,7 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
     bool Process(CookingData& data, CacheData& cache, Asset* asset);
     bool Process(CookingData& data, CacheData& cache, BinaryAsset* asset);
     bool Process(CookingData& data, CacheData& cache, JsonAssetBase* asset);
+    bool Cook(CookingData& data, CacheData& cache, const Guid& assetId);
 
 public:
 
@@ -5,6 +5,7 @@
 #include "Editor/Cooker/PlatformTools.h"
 #include "Engine/Core/Config/BuildSettings.h"
 #include "Engine/Core/Config/GameSettings.h"
+#include "Engine/Renderer/AtmospherePreCompute.h"
 #include "Engine/Renderer/ReflectionsPass.h"
 #include "Engine/Renderer/AntiAliasing/SMAA.h"
 #include "Engine/Engine/Globals.h"
@@ -48,6 +49,11 @@ bool DeployDataStep::Perform(CookingData& data)
         return true;
     GameCooker::DeployFiles();
 
+    // Deploy precomputed atmosphere data (skips atmosphere precompute on game start)
+    const String atmosphereCache = AtmospherePreCompute::GetCachePath();
+    if (FileSystem::FileExists(atmosphereCache))
+        FileSystem::CopyFile(contentDir / StringUtils::GetFileName(atmosphereCache), atmosphereCache);
+
     // Register engine in-build assets
     data.AddRootEngineAsset(TEXT("Shaders/AtmospherePreCompute"));
     data.AddRootEngineAsset(TEXT("Shaders/ColorGrading"));
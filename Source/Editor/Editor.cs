@@ -563,6 +563,7 @@ private void InitProject()
             GameSettings.Save(new LocalizationSettings());
             GameSettings.Save(new BuildSettings());
             GameSettings.Save(new StreamingSettings());
+            GameSettings.Save(new ThreadingSettings());
             GameSettings.Save(new WindowsPlatformSettings());
             GameSettings.Save(new LinuxPlatformSettings());
             GameSettings.Save(new AndroidPlatformSettings());
@@ -201,6 +201,12 @@ struct InternalModelOptions
     byte GenerateSDF;
     float SDFResolution;
 
+    // Impostor
+    byte GenerateImpostor;
+    int32 ImpostorFrames;
+    int32 ImpostorResolution;
+    float ImpostorScreenSize;
+
     // Splitting
     byte SplitObjects;
     int32 ObjectIndex;
@@ -242,6 +248,10 @@ struct InternalModelOptions
         to->RestoreMaterialsOnReimport = from->RestoreMaterialsOnReimport;
         to->GenerateSDF = from->GenerateSDF;
         to->SDFResolution = from->SDFResolution;
+        to->GenerateImpostor = from->GenerateImpostor;
+        to->ImpostorFrames = from->ImpostorFrames;
+        to->ImpostorResolution = from->ImpostorResolution;
+        to->ImpostorScreenSize = from->ImpostorScreenSize;
         to->SplitObjects = from->SplitObjects;
         to->ObjectIndex = from->ObjectIndex;
     }
@@ -283,6 +293,10 @@ struct InternalModelOptions
         to->RestoreMaterialsOnReimport = from->RestoreMaterialsOnReimport;
         to->GenerateSDF = from->GenerateSDF;
         to->SDFResolution = from->SDFResolution;
+        to->GenerateImpostor = from->GenerateImpostor;
+        to->ImpostorFrames = from->ImpostorFrames;
+        to->ImpostorResolution = from->ImpostorResolution;
+        to->ImpostorScreenSize = from->ImpostorScreenSize;
         to->SplitObjects = from->SplitObjects;
         to->ObjectIndex = from->ObjectIndex;
     }
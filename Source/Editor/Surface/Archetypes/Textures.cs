@@ -430,6 +430,21 @@ private void OnSelectedTextureGroupChanged(ComboBox comboBox)
                     NodeElementArchetype.Factory.ComboBox(50, Surface.Constants.LayoutOffsetY * 4, 100, 0, typeof(CommonSamplerType))
                 }
             },
+            new NodeArchetype
+            {
+                TypeID = 18,
+                Title = "Vertex Animation Texture",
+                Description = "Plays the vertex animation baked into the texture (see SkinnedModel.BakeVertexAnimation). Connect Position Offset to the material Position Offset. Works only in the vertex shader.",
+                Flags = NodeFlags.MaterialGraph,
+                Size = new Float2(240, 60),
+                Elements = new[]
+                {
+                    NodeElementArchetype.Factory.Input(0, "Texture", true, typeof(FlaxEngine.Object), 0),
+                    NodeElementArchetype.Factory.Input(1, "Time", true, typeof(float), 1),
+                    NodeElementArchetype.Factory.Output(0, "Position Offset", typeof(Float3), 2),
+                    NodeElementArchetype.Factory.Output(1, "Normal", typeof(Float3), 3),
+                }
+            },
         };
     }
 }
@@ -160,7 +160,6 @@ protected override void OnApplyTransformation(ref Vector3 translationDelta, ref
             // Transform foliage instance
             instance.Transform = foliage.Transform.WorldToLocal(trans);
             foliage.SetInstanceTransform(instanceIndex, ref instance.Transform);
-            foliage.RebuildClusters();
         }
 
         /// <inheritdoc />
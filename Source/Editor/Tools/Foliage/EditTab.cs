@@ -67,7 +67,6 @@ public void SetOptions()
                 if (Foliage != null && InstanceIndex > -1 && InstanceIndex < Foliage.InstancesCount)
                 {
                     Foliage.SetInstanceTransform(InstanceIndex, ref _instance.Transform);
-                    Foliage.RebuildClusters();
                 }
             }
 
@@ -344,8 +344,6 @@ void FoliageTools::Paint(Foliage* foliage, Span<int32> foliageTypesIndices, cons
             // Add foliage instance
             foliage->AddInstance(instance);
         }
-
-        foliage->RebuildClusters();
     }
 }
 
@@ -385,6 +383,4 @@ void FoliageTools::Remove(Foliage* foliage, Span<int32> foliageTypesIndices, con
         foliage->RemoveInstance(i);
         --i;
     }
-
-    foliage->RebuildClusters();
 }
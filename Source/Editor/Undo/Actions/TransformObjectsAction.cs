@@ -2,8 +2,10 @@
 
 using System;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using FlaxEditor.Modules;
 using FlaxEditor.SceneGraph;
+using FlaxEditor.Utilities;
 using FlaxEngine;
 
 namespace FlaxEditor
@@ -12,6 +14,7 @@ namespace FlaxEditor
     /// Implementation of <see cref="IUndoAction"/> used to transform a selection of <see cref="SceneGraphNode"/>.
     /// The same logic could be achieved using <see cref="UndoMultiBlock"/> but it would be slower.
     /// Since we use this kind of action very ofter (for <see cref="FlaxEditor.Gizmo.TransformGizmo"/> operations) it's better to provide faster implementation.
+    /// Data is stored in a compact binary form (the 'after' state as a delta against the 'before' state) and only the state that is applied gets decoded.
     /// </summary>
     /// <seealso cref="FlaxEditor.IUndoAction" />
     [Serializable]
@@ -59,6 +62,56 @@ public struct DataStorage
             public bool NavigationDirty;
         }
 
+        [Serialize]
+        private Guid _sceneId;
+
+        [Serialize]
+        private Guid[] _selection;
+
+        [Serialize]
+        private byte[] _before;
+
+        [Serialize]
+        private byte[] _afterDelta;
+
+        [Serialize]
+        private BoundingBox _beforeBounds;
+
+        [Serialize]
+        private BoundingBox _afterBounds;
+
+        [Serialize]
+        private bool _navigationDirty;
+
+        /// <inheritdoc />
+        [NoSerialize]
+        public override DataStorage Data
+        {
+            get => new DataStorage
+            {
+                Scene = Level.FindScene(_sceneId),
+                Selection = GetSelection(),
+                Before = GetBefore(),
+                After = GetAfter(),
+                BeforeBounds = _beforeBounds,
+                AfterBounds = _afterBounds,
+                NavigationDirty = _navigationDirty,
+            };
+            protected set
+            {
+                _sceneId = value.Scene?.ID ?? Guid.Empty;
+                _selection = new Guid[value.Selection.Length];
+                for (int i = 0; i < _selection.Length; i++)
+                    _selection[i] = value.Selection[i].ID;
+                var before = MemoryMarshal.AsBytes(value.Before.AsSpan());
+                _before = before.ToArray();
+                _afterDelta = BinaryDelta.Encode(before, MemoryMarshal.AsBytes(value.After.AsSpan()));
+                _beforeBounds = value.BeforeBounds;
+                _afterBounds = value.AfterBounds;
+                _navigationDirty = value.NavigationDirty;
+            }
+        }
+
         internal TransformObjectsAction(List<SceneGraphNode> selection, List<Transform> before, ref BoundingBox boundsBefore, bool navigationDirty)
         {
             var after = Utilities.Utils.GetTransformsAndBounds(selection, out var afterBounds);
@@ -78,7 +131,7 @@ internal TransformObjectsAction(List<SceneGraphNode> selection, List<Transform>
             };
             Data = data;
 
-            InvalidateBounds(ref data);
+            InvalidateBounds();
         }
 
         /// <inheritdoc />
@@ -87,56 +140,87 @@ internal TransformObjectsAction(List<SceneGraphNode> selection, List<Transform>
         /// <inheritdoc />
         public override void Do()
         {
-            var data = Data;
-            for (int i = 0; i < data.Selection.Length; i++)
-            {
-                data.Selection[i].Transform = data.After[i];
-            }
-            InvalidateBounds(ref data);
+            Apply(GetAfter());
         }
 
         /// <inheritdoc />
         public override void Undo()
         {
-            var data = Data;
-            for (int i = 0; i < data.Selection.Length; i++)
+            Apply(GetBefore());
+        }
+
+        /// <inheritdoc />
+        public override void Dispose()
+        {
+            base.Dispose();
+
+            _selection = null;
+            _before = null;
+            _afterDelta = null;
+        }
+
+        private SceneGraphNode[] GetSelection()
+        {
+            var selection = new SceneGraphNode[_selection.Length];
+            for (int i = 0; i < selection.Length; i++)
+                selection[i] = SceneGraphFactory.FindNode(_selection[i]);
+            return selection;
+        }
+
+        private Transform[] GetBefore()
+        {
+            return MemoryMarshal.Cast<byte, Transform>(_before).ToArray();
+        }
+
+        private Transform[] GetAfter()
+        {
+            return MemoryMarshal.Cast<byte, Transform>(BinaryDelta.Decode(_before, _afterDelta)).ToArray();
+        }
+
+        private void Apply(Transform[] transforms)
+        {
+            for (int i = 0; i < _selection.Length; i++)
             {
-                data.Selection[i].Transform = data.Before[i];
+                var node = SceneGraphFactory.FindNode(_selection[i]);
+                if (node != null)
+                    node.Transform = transforms[i];
             }
-            InvalidateBounds(ref data);
+            InvalidateBounds();
         }
 
-        private void InvalidateBounds(ref DataStorage data)
+        private void InvalidateBounds()
         {
-            if (!data.NavigationDirty)
+            if (!_navigationDirty)
                 return;
 
             var editor = Editor.Instance;
             bool isPlayMode = editor.StateMachine.IsPlayMode;
             var options = editor.Options.Options;
+            var scene = Level.FindScene(_sceneId);
 
             // Auto NavMesh rebuild
-            if (!isPlayMode && options.General.AutoRebuildNavMesh && data.Scene != null)
+            if (!isPlayMode && options.General.AutoRebuildNavMesh && scene != null)
             {
                 // Handle simple case where objects were moved just a little and use one navmesh build request to improve performance
-                if (data.BeforeBounds.Intersects(ref data.AfterBounds))
+                if (_beforeBounds.Intersects(ref _afterBounds))
                 {
-                    Navigation.BuildNavMesh(data.Scene, BoundingBox.Merge(data.BeforeBounds, data.AfterBounds), options.General.AutoRebuildNavMeshTimeoutMs);
+                    Navigation.BuildNavMesh(scene, BoundingBox.Merge(_beforeBounds, _afterBounds), options.General.AutoRebuildNavMeshTimeoutMs);
                 }
                 else
                 {
-                    Navigation.BuildNavMesh(data.Scene, data.BeforeBounds, options.General.AutoRebuildNavMeshTimeoutMs);
-                    Navigation.BuildNavMesh(data.Scene, data.AfterBounds, options.General.AutoRebuildNavMeshTimeoutMs);
+                    Navigation.BuildNavMesh(scene, _beforeBounds, options.General.AutoRebuildNavMeshTimeoutMs);
+                    Navigation.BuildNavMesh(scene, _afterBounds, options.General.AutoRebuildNavMeshTimeoutMs);
                 }
             }
         }
 
         void ISceneEditAction.MarkSceneEdited(SceneModule sceneModule)
         {
-            var data = Data;
-            for (int i = 0; i < data.Selection.Length; i++)
+            for (int i = 0; i < _selection.Length; i++)
             {
-                sceneModule.MarkSceneEdited(data.Selection[i].ParentScene);
+                var node = SceneGraphFactory.FindNode(_selection[i]);
+                if (node != null)
+                    sceneModule.MarkSceneEdited(node.ParentScene);
             }
         }
     }
@@ -0,0 +1,92 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+using System;
+using System.IO;
+
+namespace FlaxEditor.Utilities
+{
+    /// <summary>
+    /// Compact binary delta encoding used by the undo snapshots. Stores the XOR of the current data against the baseline with zero bytes run-length encoded (unchanged data takes almost no space).
+    /// </summary>
+    public static class BinaryDelta
+    {
+        /// <summary>
+        /// Encodes the delta between two data buffers of the same size.
+        /// </summary>
+        /// <param name="baseline">The baseline data.</param>
+        /// <param name="current">The current data.</param>
+        /// <returns>The encoded delta.</returns>
+        public static byte[] Encode(ReadOnlySpan<byte> baseline, ReadOnlySpan<byte> current)
+        {
+            if (baseline.Length != current.Length)
+                throw new ArgumentException("Delta encoding requires data of the same size.");
+            var stream = new MemoryStream();
+            int i = 0, length = current.Length;
+            while (i < length)
+            {
+                // Count unchanged bytes
+                int zeros = 0;
+                while (i + zeros < length && baseline[i + zeros] == current[i + zeros])
+                    zeros++;
+                i += zeros;
+
+                // Count changed bytes
+                int literals = 0;
+                while (i + literals < length && baseline[i + literals] != current[i + literals])
+                    literals++;
+
+                WriteCount(stream, zeros);
+                WriteCount(stream, literals);
+                for (int j = 0; j < literals; j++)
+                    stream.WriteByte((byte)(baseline[i + j] ^ current[i + j]));
+                i += literals;
+            }
+            return stream.ToArray();
+        }
+
+        /// <summary>
+        /// Decodes the data from the baseline and the delta.
+        /// </summary>
+        /// <param name="baseline">The baseline data.</param>
+        /// <param name="delta">The delta encoded with <see cref="Encode"/>.</param>
+        /// <returns>The decoded data.</returns>
+        public static byte[] Decode(ReadOnlySpan<byte> baseline, byte[] delta)
+        {
+            var result = baseline.ToArray();
+            int i = 0, pos = 0;
+            while (pos < delta.Length)
+            {
+                i += ReadCount(delta, ref pos);
+                int literals = ReadCount(delta, ref pos);
+                for (int j = 0; j < literals; j++)
+                    result[i++] ^= delta[pos++];
+            }
+            return result;
+        }
+
+        private static void WriteCount(MemoryStream stream, int value)
+        {
+            // 7-bit variable length integer
+            uint v = (uint)value;
+            while (v >= 0x80)
+            {
+                stream.WriteByte((byte)(v | 0x80));
+                v >>= 7;
+            }
+            stream.WriteByte((byte)v);
+        }
+
+        private static int ReadCount(byte[] data, ref int pos)
+        {
+            int result = 0, shift = 0;
+            byte b;
+            do
+            {
+                b = data[pos++];
+                result |= (b & 0x7f) << shift;
+                shift += 7;
+            } while ((b & 0x80) != 0);
+            return result;
+        }
+    }
+}
@@ -15,9 +15,18 @@ EditorScene::EditorScene(const SpawnParams& params)
 void EditorScene::Update()
 {
     for (auto& e : Ticking.Update.Ticks)
-        e.Call();
+    {
+        if (e.FunctionObj)
+            e.Call();
+    }
     for (auto& e : Ticking.LateUpdate.Ticks)
-        e.Call();
+    {
+        if (e.FunctionObj)
+            e.Call();
+    }
     for (auto& e : Ticking.FixedUpdate.Ticks)
-        e.Call();
+    {
+        if (e.FunctionObj)
+            e.Call();
+    }
 }
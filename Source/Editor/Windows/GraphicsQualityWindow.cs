@@ -104,6 +104,30 @@ public bool AllowCSMBlending
                 set => Graphics.AllowCSMBlending = value;
             }
 
+            [DefaultValue(Quality.High)]
+            [EditorOrder(1330), EditorDisplay("Quality"), Tooltip("The Bloom quality. Controls the amount of the downsampled mip levels used by the compute shaders bloom.")]
+            public Quality BloomQuality
+            {
+                get => Graphics.BloomQuality;
+                set => Graphics.BloomQuality = value;
+            }
+
+            [DefaultValue(Quality.High)]
+            [EditorOrder(1340), EditorDisplay("Quality", "Depth Of Field Quality"), Tooltip("The Depth Of Field quality. Low renders the effect in quarter resolution, Medium in half resolution and High or Ultra in full resolution.")]
+            public Quality DepthOfFieldQuality
+            {
+                get => Graphics.DepthOfFieldQuality;
+                set => Graphics.DepthOfFieldQuality = value;
+            }
+
+            [DefaultValue(Quality.High)]
+            [EditorOrder(1350), EditorDisplay("Quality"), Tooltip("The distortion (refraction) quality. Low and Medium render the distortion vectors in half resolution, High or Ultra in full resolution.")]
+            public Quality DistortionQuality
+            {
+                get => Graphics.DistortionQuality;
+                set => Graphics.DistortionQuality = value;
+            }
+
             [NoSerialize, DefaultValue(1.0f), Limit(0.05f, 5, 0)]
             [EditorOrder(1400), EditorDisplay("Quality")]
             [Tooltip("The scale of the rendering resolution relative to the output dimensions. If lower than 1 the scene and postprocessing will be rendered at a lower resolution and upscaled to the output backbuffer.")]
@@ -12,29 +12,15 @@ partial class ProfilerCPU
     {
         partial struct Event
         {
-            /// <summary>
-            /// Gets the event name.
-            /// </summary>
-            public unsafe string Name
-            {
-                get
-                {
-                    fixed (char* name = &Name0)
-                    {
-                        return new string(name);
-                    }
-                }
-            }
-
             internal unsafe bool NameStartsWith(string prefix)
             {
-                fixed (char* name = &Name0)
+                char* name = Name;
+                for (int i = 0; i < prefix.Length; i++)
                 {
-                    fixed (char* p = prefix)
-                    {
-                        return Utils.MemoryCompare(new IntPtr(name), new IntPtr(p), (ulong)(prefix.Length * 2)) == 0;
-                    }
+                    if (name[i] != prefix[i])
+                        return false;
                 }
+                return true;
             }
         }
     }
@@ -255,7 +241,7 @@ private ViewRange GetEventsViewRange()
                             {
                                 var e = events[i];
 
-                                if (e.Depth == 0 && e.Name == "Update")
+                                if (e.Depth == 0 && new string(e.Name) == "Update")
                                 {
                                     return new ViewRange(ref e);
                                 }
@@ -290,7 +276,7 @@ private void AddEvent(double startTime, int maxDepth, float xOffset, int depthOf
                 control = new Timeline.Event();
             }
             control.Bounds = new Rectangle(x + xOffset, (e.Depth + depthOffset) * Timeline.Event.DefaultHeight, width, Timeline.Event.DefaultHeight - 1);
-            control.Name = e.Name.Replace("::", ".");
+            control.Name = new string(e.Name).Replace("::", ".");
             control.TooltipText = string.Format("{0}, {1} ms", control.Name, ((int)(length * 1000.0) / 1000.0f));
             control.Parent = parent;
 
@@ -486,7 +472,7 @@ private void UpdateTableInner(ref ViewRange viewRange)
                         subEventsMemoryTotal += sub.ManagedMemoryAllocation + e.NativeMemoryAllocation;
                     }
 
-                    string name = e.Name.Replace("::", ".");
+                    string name = new string(e.Name).Replace("::", ".");
 
                     Row row;
                     if (_tableRowsCache.Count != 0)
@@ -0,0 +1,423 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+using System;
+using System.Collections.Generic;
+using FlaxEditor.GUI;
+using FlaxEngine;
+using FlaxEngine.GUI;
+
+namespace FlaxEditor.Windows.Profiler
+{
+    /// <summary>
+    /// The content loading profiling mode.
+    /// </summary>
+    /// <seealso cref="FlaxEditor.Windows.Profiler.ProfilerMode" />
+    internal sealed class Loading : ProfilerMode
+    {
+        private const int StagesCount = 4;
+
+        private readonly SingleChart _loadTimeChart;
+        private readonly Timeline _timeline;
+        private readonly Table _table;
+        private SamplesBuffer<ProfilingTools.ContentLoadEvent[]> _events;
+        private SamplesBuffer<ProfilingTools.ContentLoadTypeStats[]> _types;
+        private List<Timeline.TrackLabel> _timelineLabelsCache;
+        private List<Timeline.Event> _timelineEventsCache;
+        private List<Row> _tableRowsCache;
+
+        public Loading()
+        : base("Loading")
+        {
+            // Layout
+            var panel = new Panel(ScrollBars.Vertical)
+            {
+                AnchorPreset = AnchorPresets.StretchAll,
+                Offsets = Margin.Zero,
+                Parent = this,
+            };
+            var layout = new VerticalPanel
+            {
+                AnchorPreset = AnchorPresets.HorizontalStretchTop,
+                Offsets = Margin.Zero,
+                IsScrollable = true,
+                Parent = panel,
+            };
+
+            // Chart
+            _loadTimeChart = new SingleChart
+            {
+                Title = "Content Loading Time",
+                FormatSample = v => (Mathf.RoundToInt(v * 10.0f) / 10.0f) + " ms",
+                Parent = layout,
+            };
+            _loadTimeChart.SelectedSampleChanged += OnSelectedSampleChanged;
+
+            // Timeline
+            _timeline = new Timeline
+            {
+                Height = 200,
+                Parent = layout,
+            };
+
+            // Export
+            var exportPanel = new HorizontalPanel
+            {
+                Height = 24,
+                Parent = layout,
+            };
+            var exportEvents = new Button
+            {
+                Text = "Export events to CSV",
+                Width = 160,
+                Parent = exportPanel,
+            };
+            exportEvents.Clicked += () => Export(false);
+            var exportTypes = new Button
+            {
+                Text = "Export asset types to CSV",
+                Width = 160,
+                Parent = exportPanel,
+            };
+            exportTypes.Clicked += () => Export(true);
+
+            // Table
+            var headerColor = Style.Current.LightBackground;
+            _table = new Table
+            {
+                Columns = new[]
+                {
+                    new ColumnDefinition
+                    {
+                        UseExpandCollapseMode = true,
+                        CellAlignment = TextAlignment.Near,
+                        Title = "Type",
+                        TitleBackgroundColor = headerColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Count",
+                        TitleBackgroundColor = headerColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Load ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Queue ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Stream ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Upload ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Finalize ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "I/O",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)v),
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "I/O ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Decompress ms",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = FormatCellMs,
+                    },
+                },
+                Parent = layout,
+            };
+            _table.Splits = new[]
+            {
+                0.19f,
+                0.06f,
+                0.09f,
+                0.09f,
+                0.09f,
+                0.09f,
+                0.09f,
+                0.1f,
+                0.09f,
+                0.11f,
+            };
+        }
+
+        private string FormatCellMs(object x)
+        {
+            return ((float)x).ToString("0.00");
+        }
+
+        /// <inheritdoc />
+        public override void Init()
+        {
+            ProfilingTools.TrackContentLoads = true;
+        }
+
+        /// <inheritdoc />
+        public override void Clear()
+        {
+            _loadTimeChart.Clear();
+            _events?.Clear();
+            _types?.Clear();
+        }
+
+        /// <inheritdoc />
+        public override void Update(ref SharedUpdateData sharedData)
+        {
+            var events = ProfilingTools.ContentLoads;
+            float loadTime = 0.0f;
+            for (int i = 0; i < events.Length; i++)
+                loadTime += events[i].DurationMs;
+            _loadTimeChart.AddSample(loadTime);
+
+            // Per-type stats are accumulated so reuse the last snapshot when nothing got loaded
+            if (_events == null)
+                _events = new SamplesBuffer<ProfilingTools.ContentLoadEvent[]>();
+            if (_types == null)
+                _types = new SamplesBuffer<ProfilingTools.ContentLoadTypeStats[]>();
+            _events.Add(events);
+            _types.Add(events.Length != 0 || _types.Count == 0 ? ProfilingTools.ContentLoadTypes : _types.Last);
+        }
+
+        /// <inheritdoc />
+        public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents)
+        {
+            _loadTimeChart.SelectedSampleIndex = selectedFrame;
+
+            if (_events == null)
+                return;
+            if (_timelineLabelsCache == null)
+                _timelineLabelsCache = new List<Timeline.TrackLabel>();
+            if (_timelineEventsCache == null)
+                _timelineEventsCache = new List<Timeline.Event>();
+            if (_tableRowsCache == null)
+                _tableRowsCache = new List<Row>();
+            UpdateTimeline();
+            UpdateTable();
+        }
+
+        /// <inheritdoc />
+        public override void OnDestroy()
+        {
+            ProfilingTools.TrackContentLoads = false;
+            _events?.Clear();
+            _types?.Clear();
+            _timelineLabelsCache?.Clear();
+            _timelineEventsCache?.Clear();
+            _tableRowsCache?.Clear();
+
+            base.OnDestroy();
+        }
+
+        private static void Export(bool perType)
+        {
+            if (FileSystem.ShowSaveFileDialog(null, null, "*.csv", false, "Export content loading stats to .csv file", out var filenames))
+                return;
+            var filename = filenames[0];
+            if (!filename.EndsWith(".csv"))
+                filename += ".csv";
+            if (ProfilingTools.SaveContentLoads(filename, perType))
+                Editor.LogWarning("Failed to export content loading stats to " + filename);
+        }
+
+        private void UpdateTimeline()
+        {
+            var container = _timeline.EventsContainer;
+            container.IsLayoutLocked = true;
+            int idx = 0;
+            while (container.Children.Count > idx)
+            {
+                var child = container.Children[idx];
+                if (child is Timeline.Event e)
+                {
+                    _timelineEventsCache.Add(e);
+                    child.Parent = null;
+                }
+                else if (child is Timeline.TrackLabel l)
+                {
+                    _timelineLabelsCache.Add(l);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            container.LockChildrenRecursive();
+
+            _timeline.Height = UpdateTimelineInner();
+
+            container.UnlockChildrenRecursive();
+            container.PerformLayout();
+        }
+
+        private float UpdateTimelineInner()
+        {
+            if (_events.Count == 0)
+                return 0;
+            var events = _events.Get(_loadTimeChart.SelectedSampleIndex);
+            if (events == null || events.Length == 0)
+                return 0;
+
+            // Find the first event start time (for the timeline start time)
+            double startTime = double.MaxValue;
+            for (int i = 0; i < events.Length; i++)
+                startTime = Math.Min(startTime, events[i].StartTime);
+
+            // Create timeline track per thread (with a row per loading stage)
+            var container = _timeline.EventsContainer;
+            var threads = new List<string>();
+            for (int i = 0; i < events.Length; i++)
+            {
+                if (!threads.Contains(events[i].Thread))
+                    threads.Add(events[i].Thread);
+            }
+            float xOffset = 90;
+            int trackHeight = StagesCount + 1;
+            for (int threadIndex = 0; threadIndex < threads.Count; threadIndex++)
+            {
+                var thread = threads[threadIndex];
+                int depthOffset = threadIndex * trackHeight;
+
+                // Add thread label
+                Timeline.TrackLabel trackLabel;
+                if (_timelineLabelsCache.Count != 0)
+                {
+                    var last = _timelineLabelsCache.Count - 1;
+                    trackLabel = _timelineLabelsCache[last];
+                    _timelineLabelsCache.RemoveAt(last);
+                }
+                else
+                {
+                    trackLabel = new Timeline.TrackLabel();
+                }
+                trackLabel.Bounds = new Rectangle(0, depthOffset * Timeline.Event.DefaultHeight, xOffset, trackHeight * Timeline.Event.DefaultHeight);
+                trackLabel.Name = thread;
+                trackLabel.BackgroundColor = Style.Current.Background * 1.1f;
+                trackLabel.Parent = container;
+
+                // Add events
+                for (int i = 0; i < events.Length; i++)
+                {
+                    ref var e = ref events[i];
+                    if (e.Thread != thread)
+                        continue;
+                    double scale = 100.0;
+                    float x = (float)((e.StartTime - startTime) * scale);
+                    float width = Mathf.Max((float)(e.DurationMs * scale), 1.0f);
+                    Timeline.Event control;
+                    if (_timelineEventsCache.Count != 0)
+                    {
+                        var last = _timelineEventsCache.Count - 1;
+                        control = _timelineEventsCache[last];
+                        _timelineEventsCache.RemoveAt(last);
+                    }
+                    else
+                    {
+                        control = new Timeline.Event();
+                    }
+                    control.Bounds = new Rectangle(x + xOffset, (depthOffset + (int)e.Stage) * Timeline.Event.DefaultHeight, width, Timeline.Event.DefaultHeight - 1);
+                    control.Name = e.TypeName + ' ' + e.Name;
+                    control.TooltipText = string.Format("{0} {1}\n{2}: {3} ms, queue wait: {4} ms\nI/O: {5}, {6} ms, decompression: {7} ms", e.TypeName, e.Name, e.Stage, ((int)(e.DurationMs * 1000.0f) / 1000.0f), ((int)(e.QueueWaitMs * 1000.0f) / 1000.0f), Utilities.Utils.FormatBytesCount(e.IOBytes), ((int)(e.IOTimeMs * 1000.0f) / 1000.0f), ((int)(e.DecompressTimeMs * 1000.0f) / 1000.0f));
+                    control.Parent = container;
+                }
+            }
+
+            return Timeline.Event.DefaultHeight * trackHeight * threads.Count;
+        }
+
+        private void UpdateTable()
+        {
+            _table.IsLayoutLocked = true;
+            int idx = 0;
+            while (_table.Children.Count > idx)
+            {
+                var child = _table.Children[idx];
+                if (child is Row row)
+                {
+                    _tableRowsCache.Add(row);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            _table.LockChildrenRecursive();
+
+            UpdateTableInner();
+
+            _table.UnlockChildrenRecursive();
+            _table.PerformLayout();
+        }
+
+        private void UpdateTableInner()
+        {
+            if (_types.Count == 0)
+                return;
+            var types = _types.Get(_loadTimeChart.SelectedSampleIndex);
+            if (types == null || types.Length == 0)
+                return;
+
+            // Add rows
+            var rowColor2 = Style.Current.Background * 1.4f;
+            for (int i = 0; i < types.Length; i++)
+            {
+                ref var e = ref types[i];
+
+                Row row;
+                if (_tableRowsCache.Count != 0)
+                {
+                    // Reuse row
+                    var last = _tableRowsCache.Count - 1;
+                    row = _tableRowsCache[last];
+                    _tableRowsCache.RemoveAt(last);
+                }
+                else
+                {
+                    // Allocate new row
+                    row = new Row { Values = new object[10] };
+                }
+
+                // Setup row data
+                row.Values[0] = e.TypeName;
+                row.Values[1] = e.Count;
+                row.Values[2] = e.LoadTimeMs;
+                row.Values[3] = e.QueueWaitMs;
+                row.Values[4] = e.StreamTimeMs;
+                row.Values[5] = e.UploadTimeMs;
+                row.Values[6] = e.FinalizeTimeMs;
+                row.Values[7] = e.IOBytes;
+                row.Values[8] = e.IOTimeMs;
+                row.Values[9] = e.DecompressTimeMs;
+
+                // Add row to the table
+                row.Width = _table.Width;
+                row.BackgroundColor = i % 2 == 0 ? rowColor2 : Color.Transparent;
+                row.Parent = _table;
+            }
+        }
+    }
+}
@@ -1,6 +1,9 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 using System;
+using System.Collections.Generic;
+using FlaxEditor.GUI;
+using FlaxEngine;
 using FlaxEngine.GUI;
 
 namespace FlaxEditor.Windows.Profiler
@@ -13,6 +16,12 @@ internal sealed class Memory : ProfilerMode
     {
         private readonly SingleChart _nativeAllocationsChart;
         private readonly SingleChart _managedAllocationsChart;
+        private readonly Table _groupsTable;
+        private readonly Table _sitesTable;
+        private SamplesBuffer<ProfilerMemory.GroupStats[]> _groups;
+        private SamplesBuffer<ProfilerMemory.AllocationSiteStats[]> _sites;
+        private List<Row> _groupsRowsCache;
+        private List<Row> _sitesRowsCache;
 
         public Memory()
         : base("Memory")
@@ -47,6 +56,87 @@ public Memory()
                 Parent = layout,
             };
             _managedAllocationsChart.SelectedSampleChanged += OnSelectedSampleChanged;
+
+            // Memory groups table (requires engine build with memory tracking)
+            if (ProfilerMemory.IsAvailable)
+            {
+                var headerColor = Style.Current.LightBackground;
+                _groupsTable = new Table
+                {
+                    Columns = new[]
+                    {
+                        new ColumnDefinition
+                        {
+                            CellAlignment = TextAlignment.Near,
+                            Title = "Memory Group",
+                            TitleBackgroundColor = headerColor,
+                        },
+                        new ColumnDefinition
+                        {
+                            Title = "Memory Usage",
+                            TitleBackgroundColor = headerColor,
+                            FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)(long)v),
+                        },
+                        new ColumnDefinition
+                        {
+                            Title = "Peak",
+                            TitleBackgroundColor = headerColor,
+                            FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)(long)v),
+                        },
+                        new ColumnDefinition
+                        {
+                            Title = "Allocations",
+                            TitleBackgroundColor = headerColor,
+                        },
+                    },
+                    Parent = layout,
+                };
+                _groupsTable.Splits = new[]
+                {
+                    0.4f,
+                    0.2f,
+                    0.2f,
+                    0.2f,
+                };
+
+                // Sampled allocations call sites table
+                _sitesTable = new Table
+                {
+                    Columns = new[]
+                    {
+                        new ColumnDefinition
+                        {
+                            CellAlignment = TextAlignment.Near,
+                            Title = "Allocation Site",
+                            TitleBackgroundColor = headerColor,
+                        },
+                        new ColumnDefinition
+                        {
+                            Title = "Sampled Allocations",
+                            TitleBackgroundColor = headerColor,
+                        },
+                        new ColumnDefinition
+                        {
+                            Title = "Sampled Memory",
+                            TitleBackgroundColor = headerColor,
+                            FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)(long)v),
+                        },
+                    },
+                    Parent = layout,
+                };
+                _sitesTable.Splits = new[]
+                {
+                    0.6f,
+                    0.2f,
+                    0.2f,
+                };
+            }
+        }
+
+        /// <inheritdoc />
+        public override void Init()
+        {
+            ProfilerMemory.SampleAllocations = ProfilerMemory.IsAvailable;
         }
 
         /// <inheritdoc />
@@ -54,6 +144,8 @@ public override void Clear()
         {
             _nativeAllocationsChart.Clear();
             _managedAllocationsChart.Clear();
+            _groups?.Clear();
+            _sites?.Clear();
         }
 
         /// <inheritdoc />
@@ -81,6 +173,20 @@ public override void Update(ref SharedUpdateData sharedData)
 
             _nativeAllocationsChart.AddSample(nativeMemoryAllocation);
             _managedAllocationsChart.AddSample(managedMemoryAllocation);
+
+            // Capture memory groups stats
+            if (_groupsTable != null)
+            {
+                if (_groups == null)
+                    _groups = new SamplesBuffer<ProfilerMemory.GroupStats[]>();
+                _groups.Add(ProfilingTools.MemoryGroups);
+            }
+            if (_sitesTable != null)
+            {
+                if (_sites == null)
+                    _sites = new SamplesBuffer<ProfilerMemory.AllocationSiteStats[]>();
+                _sites.Add(ProfilingTools.AllocationSites);
+            }
         }
 
         /// <inheritdoc />
@@ -88,6 +194,129 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
         {
             _nativeAllocationsChart.SelectedSampleIndex = selectedFrame;
             _managedAllocationsChart.SelectedSampleIndex = selectedFrame;
+            UpdateGroupsTable();
+            UpdateSitesTable();
+        }
+
+        /// <inheritdoc />
+        public override void OnDestroy()
+        {
+            ProfilerMemory.SampleAllocations = false;
+            _groups?.Clear();
+            _sites?.Clear();
+            _groupsRowsCache?.Clear();
+            _sitesRowsCache?.Clear();
+
+            base.OnDestroy();
+        }
+
+        private void UpdateGroupsTable()
+        {
+            if (_groups == null || _groups.Count == 0)
+                return;
+            if (_groupsRowsCache == null)
+                _groupsRowsCache = new List<Row>();
+            _groupsTable.IsLayoutLocked = true;
+            int idx = 0;
+            while (_groupsTable.Children.Count > idx)
+            {
+                var child = _groupsTable.Children[idx];
+                if (child is Row row)
+                {
+                    _groupsRowsCache.Add(row);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            _groupsTable.LockChildrenRecursive();
+
+            var groups = _groups.Get(_nativeAllocationsChart.SelectedSampleIndex);
+            if (groups != null)
+            {
+                var rowColor2 = Style.Current.Background * 1.4f;
+                for (int i = 0; i < groups.Length; i++)
+                {
+                    ref var e = ref groups[i];
+                    Row row;
+                    if (_groupsRowsCache.Count != 0)
+                    {
+                        var last = _groupsRowsCache.Count - 1;
+                        row = _groupsRowsCache[last];
+                        _groupsRowsCache.RemoveAt(last);
+                    }
+                    else
+                    {
+                        row = new Row { Values = new object[4] };
+                    }
+                    row.Values[0] = ((ProfilerMemory.Groups)i).ToString();
+                    row.Values[1] = e.Current;
+                    row.Values[2] = e.Peak;
+                    row.Values[3] = e.Count;
+                    row.Width = _groupsTable.Width;
+                    row.BackgroundColor = i % 2 == 0 ? rowColor2 : Color.Transparent;
+                    row.Parent = _groupsTable;
+                }
+            }
+
+            _groupsTable.UnlockChildrenRecursive();
+            _groupsTable.PerformLayout();
+        }
+
+        private void UpdateSitesTable()
+        {
+            if (_sites == null || _sites.Count == 0)
+                return;
+            if (_sitesRowsCache == null)
+                _sitesRowsCache = new List<Row>();
+            _sitesTable.IsLayoutLocked = true;
+            int idx = 0;
+            while (_sitesTable.Children.Count > idx)
+            {
+                var child = _sitesTable.Children[idx];
+                if (child is Row row)
+                {
+                    _sitesRowsCache.Add(row);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            _sitesTable.LockChildrenRecursive();
+
+            var sites = _sites.Get(_nativeAllocationsChart.SelectedSampleIndex);
+            if (sites != null)
+            {
+                var rowColor2 = Style.Current.Background * 1.4f;
+                for (int i = 0; i < sites.Length; i++)
+                {
+                    ref var e = ref sites[i];
+                    Row row;
+                    if (_sitesRowsCache.Count != 0)
+                    {
+                        var last = _sitesRowsCache.Count - 1;
+                        row = _sitesRowsCache[last];
+                        _sitesRowsCache.RemoveAt(last);
+                    }
+                    else
+                    {
+                        row = new Row { Values = new object[3] };
+                    }
+                    row.Values[0] = e.Name;
+                    row.Values[1] = e.Samples;
+                    row.Values[2] = e.Bytes;
+                    row.Width = _sitesTable.Width;
+                    row.BackgroundColor = i % 2 == 0 ? rowColor2 : Color.Transparent;
+                    row.Parent = _sitesTable;
+                }
+            }
+
+            _sitesTable.UnlockChildrenRecursive();
+            _sitesTable.PerformLayout();
         }
     }
 }
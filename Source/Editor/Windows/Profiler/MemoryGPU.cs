@@ -20,15 +20,19 @@ private struct Resource
             public string Name;
             public string Tooltip;
             public GPUResourceType Type;
+            public GPUResourceCategory Category;
             public ulong MemoryUsage;
             public Guid AssetId;
             public bool IsAssetItem;
         }
 
         private readonly SingleChart _memoryUsageChart;
+        private readonly Table _categoriesTable;
         private readonly Table _table;
         private SamplesBuffer<Resource[]> _resources;
+        private SamplesBuffer<ProfilingTools.MemoryGroupStatsGPU[]> _categories;
         private List<ClickableRow> _tableRowsCache;
+        private List<Row> _categoriesTableRowsCache;
         private string[] _resourceTypesNames;
         private Dictionary<string, Guid> _assetPathToId;
         private Dictionary<Guid, Resource> _resourceCache;
@@ -61,8 +65,41 @@ public MemoryGPU()
             };
             _memoryUsageChart.SelectedSampleChanged += OnSelectedSampleChanged;
 
-            // Table
+            // Categories table
             var headerColor = Style.Current.LightBackground;
+            _categoriesTable = new Table
+            {
+                Columns = new[]
+                {
+                    new ColumnDefinition
+                    {
+                        UseExpandCollapseMode = true,
+                        CellAlignment = TextAlignment.Near,
+                        Title = "Category",
+                        TitleBackgroundColor = headerColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Resources",
+                        TitleBackgroundColor = headerColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Memory Usage",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)v),
+                    },
+                },
+                Parent = layout,
+            };
+            _categoriesTable.Splits = new[]
+            {
+                0.6f,
+                0.2f,
+                0.2f,
+            };
+
+            // Table
             _table = new Table
             {
                 Columns = new[]
@@ -81,6 +118,12 @@ public MemoryGPU()
                         TitleBackgroundColor = headerColor,
                     },
                     new ColumnDefinition
+                    {
+                        Title = "Category",
+                        CellAlignment = TextAlignment.Center,
+                        TitleBackgroundColor = headerColor,
+                    },
+                    new ColumnDefinition
                     {
                         Title = "Memory Usage",
                         TitleBackgroundColor = headerColor,
@@ -91,17 +134,25 @@ public MemoryGPU()
             };
             _table.Splits = new[]
             {
-                0.6f,
-                0.2f,
+                0.5f,
+                0.15f,
+                0.15f,
                 0.2f,
             };
         }
 
+        /// <inheritdoc />
+        public override void Init()
+        {
+            ProfilingTools.TrackMemoryGPU = true;
+        }
+
         /// <inheritdoc />
         public override void Clear()
         {
             _memoryUsageChart.Clear();
             _resources?.Clear();
+            _categories?.Clear();
             _assetPathToId?.Clear();
             _resourceCache?.Clear();
         }
@@ -191,6 +242,7 @@ public override void Update(ref SharedUpdateData sharedData)
                     _resourceCache.Add(gpuResourceId, resource);
                 }
 
+                resource.Category = gpuResource.Category;
                 resource.MemoryUsage = gpuResource.MemoryUsage;
                 if (resource.MemoryUsage == 1)
                     resource.MemoryUsage = 0; // Sometimes GPU backend fakes memory usage as 1 to mark as allocated but not resided in actual GPU memory
@@ -200,6 +252,27 @@ public override void Update(ref SharedUpdateData sharedData)
             if (_resources == null)
                 _resources = new SamplesBuffer<Resource[]>();
             _resources.Add(resources);
+
+            // Capture memory usage per category and per texture group
+            var categoriesStats = ProfilingTools.MemoryCategoriesGPU;
+            var textureGroupsStats = ProfilingTools.MemoryTextureGroupsGPU;
+            var categories = new List<ProfilingTools.MemoryGroupStatsGPU>(categoriesStats.Length + textureGroupsStats.Length);
+            foreach (var e in categoriesStats)
+            {
+                if (e.Count != 0)
+                    categories.Add(e);
+            }
+            foreach (var e in textureGroupsStats)
+            {
+                if (e.Count == 0)
+                    continue;
+                var group = e;
+                group.Name = "Texture Group: " + e.Name;
+                categories.Add(group);
+            }
+            if (_categories == null)
+                _categories = new SamplesBuffer<ProfilingTools.MemoryGroupStatsGPU[]>();
+            _categories.Add(categories.ToArray());
         }
 
         /// <inheritdoc />
@@ -211,6 +284,8 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
                 return;
             if (_tableRowsCache == null)
                 _tableRowsCache = new List<ClickableRow>();
+            if (_categoriesTableRowsCache == null)
+                _categoriesTableRowsCache = new List<Row>();
             if (_resourceTypesNames == null)
                 _resourceTypesNames = new string[(int)GPUResourceType.MAX]
                 {
@@ -225,16 +300,20 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
                     "Query",
                     "Sampler",
                 };
+            UpdateCategoriesTable();
             UpdateTable();
         }
 
         /// <inheritdoc />
         public override void OnDestroy()
         {
+            ProfilingTools.TrackMemoryGPU = false;
             _resources?.Clear();
+            _categories?.Clear();
             _resourceCache?.Clear();
             _assetPathToId?.Clear();
             _tableRowsCache?.Clear();
+            _categoriesTableRowsCache?.Clear();
             _stringBuilder?.Clear();
 
             base.OnDestroy();
@@ -245,6 +324,63 @@ private static int SortResources(Resource a, Resource b)
             return (int)(b.MemoryUsage - a.MemoryUsage);
         }
 
+        private void UpdateCategoriesTable()
+        {
+            _categoriesTable.IsLayoutLocked = true;
+            int idx = 0;
+            while (_categoriesTable.Children.Count > idx)
+            {
+                var child = _categoriesTable.Children[idx];
+                if (child is Row row)
+                {
+                    _categoriesTableRowsCache.Add(row);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            _categoriesTable.LockChildrenRecursive();
+
+            var categories = _categories != null && _categories.Count != 0 ? _categories.Get(_memoryUsageChart.SelectedSampleIndex) : null;
+            if (categories != null)
+            {
+                var rowColor2 = Style.Current.Background * 1.4f;
+                for (int i = 0; i < categories.Length; i++)
+                {
+                    ref var e = ref categories[i];
+
+                    Row row;
+                    if (_categoriesTableRowsCache.Count != 0)
+                    {
+                        // Reuse row
+                        var last = _categoriesTableRowsCache.Count - 1;
+                        row = _categoriesTableRowsCache[last];
+                        _categoriesTableRowsCache.RemoveAt(last);
+                    }
+                    else
+                    {
+                        // Allocate new row
+                        row = new Row { Values = new object[3] };
+                    }
+
+                    // Setup row data
+                    row.Values[0] = e.Name;
+                    row.Values[1] = e.Count;
+                    row.Values[2] = e.MemoryUsage;
+
+                    // Add row to the table
+                    row.Width = _categoriesTable.Width;
+                    row.BackgroundColor = i % 2 == 0 ? rowColor2 : Color.Transparent;
+                    row.Parent = _categoriesTable;
+                }
+            }
+
+            _categoriesTable.UnlockChildrenRecursive();
+            _categoriesTable.PerformLayout();
+        }
+
         private void UpdateTable()
         {
             _table.IsLayoutLocked = true;
@@ -295,13 +431,14 @@ private void UpdateTableInner()
                 else
                 {
                     // Allocate new row
-                    row = new ClickableRow { Values = new object[3] };
+                    row = new ClickableRow { Values = new object[4] };
                 }
 
                 // Setup row data
                 row.Values[0] = e.Name;
                 row.Values[1] = _resourceTypesNames[(int)e.Type];
-                row.Values[2] = e.MemoryUsage;
+                row.Values[2] = e.Category;
+                row.Values[3] = e.MemoryUsage;
 
                 // Setup row interactions
                 row.Tag = e;
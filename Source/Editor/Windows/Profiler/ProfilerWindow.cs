@@ -196,6 +196,7 @@ public override void OnInit()
             AddMode(new MemoryGPU());
             AddMode(new Memory());
             AddMode(new Assets());
+            AddMode(new Loading());
             AddMode(new Network());
 
             // Init view
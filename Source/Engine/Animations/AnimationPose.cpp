@@ -0,0 +1,132 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "AnimationPose.h"
+#include "Engine/Core/SIMD.h"
+
+namespace
+{
+    // Rotations of 4 nodes in structure-of-arrays layout
+    struct Quaternion4
+    {
+        SimdVector4 X, Y, Z, W;
+    };
+
+    FORCE_INLINE Quaternion4 LoadRotations(const Transform* pose)
+    {
+        Quaternion4 q;
+        q.X = SIMD::LoadUnaligned(&pose[0].Orientation);
+        q.Y = SIMD::LoadUnaligned(&pose[1].Orientation);
+        q.Z = SIMD::LoadUnaligned(&pose[2].Orientation);
+        q.W = SIMD::LoadUnaligned(&pose[3].Orientation);
+        SIMD::Transpose(q.X, q.Y, q.Z, q.W);
+        return q;
+    }
+
+    FORCE_INLINE void StoreRotations(Transform* pose, Quaternion4 q)
+    {
+        SIMD::Transpose(q.X, q.Y, q.Z, q.W);
+        SIMD::StoreUnaligned(&pose[0].Orientation, q.X);
+        SIMD::StoreUnaligned(&pose[1].Orientation, q.Y);
+        SIMD::StoreUnaligned(&pose[2].Orientation, q.Z);
+        SIMD::StoreUnaligned(&pose[3].Orientation, q.W);
+    }
+
+    FORCE_INLINE SimdVector4 Dot(const Quaternion4& a, const Quaternion4& b)
+    {
+        return SIMD::Add(SIMD::Add(SIMD::Mul(a.X, b.X), SIMD::Mul(a.Y, b.Y)), SIMD::Add(SIMD::Mul(a.Z, b.Z), SIMD::Mul(a.W, b.W)));
+    }
+
+    FORCE_INLINE Quaternion4 Normalize(const Quaternion4& q)
+    {
+        const SimdVector4 invLength = SIMD::Div(SIMD::Splat(1.0f), SIMD::Sqrt(SIMD::Max(Dot(q, q), SIMD::Splat(ZeroTolerance))));
+        return { SIMD::Mul(q.X, invLength), SIMD::Mul(q.Y, invLength), SIMD::Mul(q.Z, invLength), SIMD::Mul(q.W, invLength) };
+    }
+
+    FORCE_INLINE Quaternion4 Nlerp(const Quaternion4& a, const Quaternion4& b, SimdVector4 weightA, SimdVector4 weightB)
+    {
+        // Pick the shortest path
+        weightB = SIMD::Mul(weightB, SIMD::SignNonZero(Dot(a, b)));
+        Quaternion4 q;
+        q.X = SIMD::Add(SIMD::Mul(a.X, weightA), SIMD::Mul(b.X, weightB));
+        q.Y = SIMD::Add(SIMD::Mul(a.Y, weightA), SIMD::Mul(b.Y, weightB));
+        q.Z = SIMD::Add(SIMD::Mul(a.Z, weightA), SIMD::Mul(b.Z, weightB));
+        q.W = SIMD::Add(SIMD::Mul(a.W, weightA), SIMD::Mul(b.W, weightB));
+        return Normalize(q);
+    }
+
+    FORCE_INLINE Quaternion4 Multiply(const Quaternion4& l, const Quaternion4& r)
+    {
+        // Matches Quaternion::Multiply
+        const SimdVector4 a = SIMD::Sub(SIMD::Mul(l.Y, r.Z), SIMD::Mul(l.Z, r.Y));
+        const SimdVector4 b = SIMD::Sub(SIMD::Mul(l.Z, r.X), SIMD::Mul(l.X, r.Z));
+        const SimdVector4 c = SIMD::Sub(SIMD::Mul(l.X, r.Y), SIMD::Mul(l.Y, r.X));
+        const SimdVector4 d = SIMD::Add(SIMD::Add(SIMD::Mul(l.X, r.X), SIMD::Mul(l.Y, r.Y)), SIMD::Mul(l.Z, r.Z));
+        Quaternion4 q;
+        q.X = SIMD::Add(SIMD::Add(SIMD::Mul(l.X, r.W), SIMD::Mul(r.X, l.W)), a);
+        q.Y = SIMD::Add(SIMD::Add(SIMD::Mul(l.Y, r.W), SIMD::Mul(r.Y, l.W)), b);
+        q.Z = SIMD::Add(SIMD::Add(SIMD::Mul(l.Z, r.W), SIMD::Mul(r.Z, l.W)), c);
+        q.W = SIMD::Sub(SIMD::Mul(l.W, r.W), d);
+        return q;
+    }
+
+    FORCE_INLINE void Nlerp(const Quaternion& a, const Quaternion& b, float alpha, Quaternion& result)
+    {
+        const float weightB = Quaternion::Dot(a, b) < 0.0f ? -alpha : alpha;
+        result = a * (1.0f - alpha) + b * weightB;
+        result.Normalize();
+    }
+}
+
+void AnimationPose::Blend(const Transform* a, const Transform* b, float alpha, Transform* result, int32 count)
+{
+    // Rotations (blocks of 4 nodes and the remaining ones)
+    const SimdVector4 weightA = SIMD::Splat(1.0f - alpha);
+    const SimdVector4 weightB = SIMD::Splat(alpha);
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        StoreRotations(result + i, Nlerp(LoadRotations(a + i), LoadRotations(b + i), weightA, weightB));
+    for (; i < count; i++)
+        Nlerp(a[i].Orientation, b[i].Orientation, alpha, result[i].Orientation);
+
+    // Translations and scales
+    for (i = 0; i < count; i++)
+    {
+        result[i].Translation = a[i].Translation + (b[i].Translation - a[i].Translation) * alpha;
+        result[i].Scale = a[i].Scale + (b[i].Scale - a[i].Scale) * alpha;
+    }
+}
+
+void AnimationPose::BlendAdditive(const Transform* base, const Transform* additive, float alpha, Transform* result, int32 count)
+{
+    // Rotations (blocks of 4 nodes and the remaining ones)
+    const SimdVector4 weightA = SIMD::Splat(1.0f - alpha);
+    const SimdVector4 weightB = SIMD::Splat(alpha);
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const Quaternion4 q = LoadRotations(base + i);
+        StoreRotations(result + i, Nlerp(q, Normalize(Multiply(q, LoadRotations(additive + i))), weightA, weightB));
+    }
+    for (; i < count; i++)
+    {
+        Quaternion q = base[i].Orientation * additive[i].Orientation;
+        q.Normalize();
+        Nlerp(base[i].Orientation, q, alpha, result[i].Orientation);
+    }
+
+    // Translations and scales
+    for (i = 0; i < count; i++)
+    {
+        result[i].Translation = base[i].Translation + additive[i].Translation * alpha;
+        result[i].Scale = base[i].Scale + (base[i].Scale * additive[i].Scale - base[i].Scale) * alpha;
+    }
+}
+
+void AnimationPose::NormalizeRotations(Transform* pose, int32 count)
+{
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        StoreRotations(pose + i, Normalize(LoadRotations(pose + i)));
+    for (; i < count; i++)
+        pose[i].Orientation.Normalize();
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Math/Transform.h"
+
+/// <summary>
+/// Vectorized kernels for the skeleton poses (arrays of the nodes local transformations). Rotations are processed in blocks of 4 nodes transposed into the structure-of-arrays layout (separate vector per quaternion component) so all math is done without shuffles.
+/// </summary>
+namespace AnimationPose
+{
+    /// <summary>
+    /// Blends the poses. Rotations use the normalized lerp along the shortest path.
+    /// </summary>
+    /// <param name="a">The first pose.</param>
+    /// <param name="b">The second pose.</param>
+    /// <param name="alpha">The blend weight (0 returns the first pose, 1 returns the second pose).</param>
+    /// <param name="result">The result pose (can be the same as any of the inputs).</param>
+    /// <param name="count">The amount of the nodes.</param>
+    FLAXENGINE_API void Blend(const Transform* a, const Transform* b, float alpha, Transform* result, int32 count);
+
+    /// <summary>
+    /// Applies the additive pose to the base pose (translations are added, rotations and scales are multiplied) and blends the result with the base pose.
+    /// </summary>
+    /// <param name="base">The base pose.</param>
+    /// <param name="additive">The additive pose.</param>
+    /// <param name="alpha">The blend weight of the additive pose.</param>
+    /// <param name="result">The result pose (can be the same as any of the inputs).</param>
+    /// <param name="count">The amount of the nodes.</param>
+    FLAXENGINE_API void BlendAdditive(const Transform* base, const Transform* additive, float alpha, Transform* result, int32 count);
+
+    /// <summary>
+    /// Normalizes the rotations of the pose nodes.
+    /// </summary>
+    /// <param name="pose">The pose.</param>
+    /// <param name="count">The amount of the nodes.</param>
+    FLAXENGINE_API void NormalizeRotations(Transform* pose, int32 count);
+}
@@ -1,13 +1,21 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "Animations.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Content/Assets/AnimationGraph.h"
+#include "Engine/Content/Assets/SkinnedModel.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Level/Actors/AnimatedModel.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/TaskGraph.h"
 
+// The precision of the floating-point graph parameters used to match the models that share the animation pose
+#define POSE_SHARING_PARAMETERS_PRECISION 100.0f
+
 class AnimationsService : public EngineService
 {
 public:
@@ -29,8 +37,30 @@ class AnimationsSystem : public TaskGraphSystem
     void PostExecute(TaskGraph* graph) override;
 };
 
+struct PoseSharingKey
+{
+    AnimationGraph* Graph;
+    SkinnedModel* Model;
+    uint32 ParametersHash;
+
+    bool operator==(const PoseSharingKey& other) const
+    {
+        return Graph == other.Graph && Model == other.Model && ParametersHash == other.ParametersHash;
+    }
+};
+
+uint32 GetHash(const PoseSharingKey& key)
+{
+    uint32 hash = GetHash(key.Graph);
+    CombineHash(hash, GetHash(key.Model));
+    CombineHash(hash, key.ParametersHash);
+    return hash;
+}
+
 AnimationsService AnimationManagerInstance;
 Array<AnimatedModel*> UpdateList;
+Array<AnimatedModel*> SharedPoseList;
+Dictionary<PoseSharingKey, AnimatedModel*> SharedPoses;
 TaskGraphSystem* Animations::System = nullptr;
 #if USE_EDITOR
 Delegate<Asset*, ScriptingObject*, uint32, uint32> Animations::DebugFlow;
@@ -46,20 +76,29 @@ bool AnimationsService::Init()
 void AnimationsService::Dispose()
 {
     UpdateList.Resize(0);
+    SharedPoseList.Resize(0);
+    SharedPoses.Clear();
     SAFE_DELETE(Animations::System);
 }
 
-void AnimationsSystem::Job(int32 index)
+bool CanUpdate(AnimatedModel* animatedModel)
 {
-    PROFILE_CPU_NAMED("Animations.Job");
-    auto animatedModel = UpdateList[index];
     auto skinnedModel = animatedModel->SkinnedModel.Get();
     auto graph = animatedModel->AnimationGraph.Get();
-    if (graph && graph->IsLoaded() && graph->Graph.CanUseWithSkeleton(skinnedModel)
+    return graph && graph->IsLoaded() && graph->Graph.CanUseWithSkeleton(skinnedModel)
 #if USE_EDITOR
-        && graph->Graph.Parameters.Count() == animatedModel->GraphInstance.Parameters.Count() // It may happen in editor so just add safe check to prevent any crashes
+            && graph->Graph.Parameters.Count() == animatedModel->GraphInstance.Parameters.Count() // It may happen in editor so just add safe check to prevent any crashes
 #endif
-    )
+            ;
+}
+
+void AnimationsSystem::Job(int32 index)
+{
+    PROFILE_CPU_NAMED("Animations.Job");
+    PROFILE_MEM(Animations);
+    auto animatedModel = UpdateList[index];
+    auto graph = animatedModel->AnimationGraph.Get();
+    if (CanUpdate(animatedModel))
     {
 #if COMPILE_WITH_PROFILER && TRACY_ENABLE
         const StringView graphName(graph->GetPath());
@@ -93,6 +132,48 @@ void AnimationsSystem::Execute(TaskGraph* graph)
     if (UpdateList.Count() == 0)
         return;
 
+    // Group models that share the pose (only the first model from the group gets evaluated, others copy its pose after the update)
+    int32 updateCount = 0;
+    for (int32 index = 0; index < UpdateList.Count(); index++)
+    {
+        auto animatedModel = UpdateList[index];
+        animatedModel->_sharedPose = nullptr;
+        if (!animatedModel->SharePose || !CanUpdate(animatedModel))
+        {
+            UpdateList[updateCount++] = animatedModel;
+            continue;
+        }
+        PoseSharingKey key;
+        key.Graph = animatedModel->AnimationGraph.Get();
+        key.Model = animatedModel->SkinnedModel.Get();
+        key.ParametersHash = 0;
+        for (const auto& parameter : animatedModel->GraphInstance.Parameters)
+        {
+            const Variant& value = parameter.Value;
+            uint32 hash;
+            if (value.Type.Type == VariantType::Float)
+                hash = GetHash(Math::RoundToInt(value.AsFloat * POSE_SHARING_PARAMETERS_PRECISION));
+            else if (value.Type.Type == VariantType::Double)
+                hash = GetHash(Math::RoundToInt((float)value.AsDouble * POSE_SHARING_PARAMETERS_PRECISION));
+            else
+                hash = GetHash(value);
+            CombineHash(key.ParametersHash, hash);
+        }
+        AnimatedModel* sharedPose;
+        if (SharedPoses.TryGet(key, sharedPose))
+        {
+            animatedModel->_sharedPose = sharedPose;
+            SharedPoseList.Add(animatedModel);
+        }
+        else
+        {
+            SharedPoses.Add(key, animatedModel);
+            UpdateList[updateCount++] = animatedModel;
+        }
+    }
+    UpdateList.Resize(updateCount);
+    SharedPoses.Clear();
+
     // Setup data for async update
     const auto& tickData = Time::Update;
     DeltaTime = tickData.DeltaTime.GetTotalSeconds();
@@ -106,6 +187,9 @@ void AnimationsSystem::Execute(TaskGraph* graph)
         Animations::DebugFlow(nullptr, nullptr, 0, 0);
 #endif
 
+    // Evaluate independent graph branches in parallel only when there are not enough models to keep all job threads busy
+    AnimGraphExecutor::AllowParallelBranches = UpdateList.Count() < JobSystem::GetThreadsCount();
+
     // Schedule work to update all animated models in async
     Function<void(int32)> job;
     job.Bind<AnimationsSystem, &AnimationsSystem::Job>(this);
@@ -120,20 +204,25 @@ void AnimationsSystem::PostExecute(TaskGraph* graph)
     for (int32 index = 0; index < UpdateList.Count(); index++)
     {
         auto animatedModel = UpdateList[index];
-        auto skinnedModel = animatedModel->SkinnedModel.Get();
-        auto animGraph = animatedModel->AnimationGraph.Get();
-        if (animGraph && animGraph->IsLoaded() && animGraph->Graph.CanUseWithSkeleton(skinnedModel)
-#if USE_EDITOR
-            && animGraph->Graph.Parameters.Count() == animatedModel->GraphInstance.Parameters.Count() // It may happen in editor so just add safe check to prevent any crashes
-#endif
-        )
+        if (CanUpdate(animatedModel))
         {
             animatedModel->OnAnimationUpdated_Sync();
         }
     }
 
+    // Update models that share the pose with the evaluated models
+    for (int32 index = 0; index < SharedPoseList.Count(); index++)
+    {
+        auto animatedModel = SharedPoseList[index];
+        animatedModel->GraphInstance.LastUpdateTime = animatedModel->UseTimeScale ? Time : UnscaledTime;
+        animatedModel->SetupSkinningData();
+        animatedModel->OnAnimationUpdated_Async();
+        animatedModel->OnAnimationUpdated_Sync();
+    }
+
     // Cleanup
     UpdateList.Clear();
+    SharedPoseList.Clear();
 }
 
 void Animations::AddToUpdate(AnimatedModel* obj)
@@ -144,4 +233,5 @@ void Animations::AddToUpdate(AnimatedModel* obj)
 void Animations::RemoveFromUpdate(AnimatedModel* obj)
 {
     UpdateList.Remove(obj);
+    SharedPoseList.Remove(obj);
 }
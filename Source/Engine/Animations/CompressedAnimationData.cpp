@@ -0,0 +1,335 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "CompressedAnimationData.h"
+#include "AnimationData.h"
+#include "Config.h"
+#include "Engine/Core/SIMD.h"
+
+// The range of the smallest three quaternion components (1/sqrt(2))
+#define ROTATION_RANGE 0.70710678f
+
+// The amount of quantization steps for the smallest three quaternion components (15-bits, the highest bits store the index of the largest component)
+#define ROTATION_STEPS 32767.0f
+
+// The amount of quantization steps for positions and scales
+#define QUANTIZATION_STEPS 65535.0f
+
+namespace
+{
+    template<typename T>
+    void SampleCurve(const LinearCurve<T>& curve, int32 framesCount, Array<T>& values)
+    {
+        values.Resize(framesCount, false);
+        for (int32 frame = 0; frame < framesCount; frame++)
+            curve.Evaluate(values[frame], (float)frame, false);
+    }
+
+    void EncodeRotation(Quaternion q, uint16* dst)
+    {
+        // Drop the largest component (the remaining ones are in the [-1/sqrt(2), 1/sqrt(2)] range and the largest can be restored from the unit length)
+        int32 largest = 0;
+        for (int32 i = 1; i < 4; i++)
+        {
+            if (Math::Abs(q.Raw[i]) > Math::Abs(q.Raw[largest]))
+                largest = i;
+        }
+        if (q.Raw[largest] < 0.0f)
+            q *= -1.0f;
+        uint16 components[3];
+        for (int32 i = 0, j = 0; i < 4; i++)
+        {
+            if (i != largest)
+                components[j++] = (uint16)Math::Clamp(Math::RoundToInt((q.Raw[i] * (0.5f / ROTATION_RANGE) + 0.5f) * ROTATION_STEPS), 0, (int32)ROTATION_STEPS);
+        }
+        dst[0] = components[0] | (uint16)((largest >> 1) << 15);
+        dst[1] = components[1] | (uint16)((largest & 1) << 15);
+        dst[2] = components[2];
+    }
+
+    FORCE_INLINE SimdVector4 DecodeRotation(const uint16* src)
+    {
+        const int32 largest = ((src[0] >> 15) << 1) | (src[1] >> 15);
+        const float scale = 2.0f * ROTATION_RANGE / ROTATION_STEPS;
+        const float a = (float)(src[0] & 0x7fff) * scale - ROTATION_RANGE;
+        const float b = (float)(src[1] & 0x7fff) * scale - ROTATION_RANGE;
+        const float c = (float)(src[2] & 0x7fff) * scale - ROTATION_RANGE;
+        const float d = Math::Sqrt(Math::Max(1.0f - a * a - b * b - c * c, 0.0f));
+        switch (largest)
+        {
+        case 0:
+            return SIMD::Load(d, a, b, c);
+        case 1:
+            return SIMD::Load(a, d, b, c);
+        case 2:
+            return SIMD::Load(a, b, d, c);
+        default:
+            return SIMD::Load(a, b, c, d);
+        }
+    }
+
+    FORCE_INLINE SimdVector4 DecodeVector(const CompressedAnimationData::Track& track, const uint16* src)
+    {
+        if (track.Format == CompressedAnimationData::TrackFormat::Raw)
+        {
+            float raw[3];
+            Platform::MemoryCopy(raw, src, sizeof(raw));
+            return SIMD::Load(raw[0], raw[1], raw[2], 0.0f);
+        }
+        const SimdVector4 value = SIMD::Load((float)src[0], (float)src[1], (float)src[2], 0.0f);
+        return SIMD::Add(SIMD::Load(track.Min.X, track.Min.Y, track.Min.Z, 0.0f), SIMD::Mul(value, SIMD::Load(track.Scale.X, track.Scale.Y, track.Scale.Z, 0.0f)));
+    }
+
+    FORCE_INLINE SimdVector4 Lerp(SimdVector4 a, SimdVector4 b, SimdVector4 alpha)
+    {
+        return SIMD::Add(a, SIMD::Mul(SIMD::Sub(b, a), alpha));
+    }
+
+    FORCE_INLINE bool SampleVector(const CompressedAnimationData::Track& track, const uint16* frameA, const uint16* frameB, SimdVector4 alpha, Float4& result)
+    {
+        switch (track.Format)
+        {
+        case CompressedAnimationData::TrackFormat::Constant:
+            result = track.Min;
+            return true;
+        case CompressedAnimationData::TrackFormat::Quantized:
+        case CompressedAnimationData::TrackFormat::Raw:
+        {
+            ALIGN_BEGIN(16) Float4 value ALIGN_END(16);
+            SIMD::Store(&value, Lerp(DecodeVector(track, frameA + track.Offset), DecodeVector(track, frameB + track.Offset), alpha));
+            result = value;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    FORCE_INLINE bool SampleRotation(const CompressedAnimationData::Track& track, const uint16* frameA, const uint16* frameB, float alpha, Quaternion& result)
+    {
+        switch (track.Format)
+        {
+        case CompressedAnimationData::TrackFormat::Constant:
+            result = Quaternion(track.Min.X, track.Min.Y, track.Min.Z, track.Min.W);
+            return true;
+        case CompressedAnimationData::TrackFormat::Quantized:
+        {
+            // Normalized lerp along the shortest path (frames are dense so it matches the slerp of the source curve within the error bounds)
+            ALIGN_BEGIN(16) Float4 a ALIGN_END(16);
+            ALIGN_BEGIN(16) Float4 b ALIGN_END(16);
+            SIMD::Store(&a, DecodeRotation(frameA + track.Offset));
+            SIMD::Store(&b, DecodeRotation(frameB + track.Offset));
+            const float sign = a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W < 0.0f ? -1.0f : 1.0f;
+            SIMD::Store(&a, SIMD::Add(SIMD::Mul(SIMD::Load(&a), SIMD::Splat(1.0f - alpha)), SIMD::Mul(SIMD::Load(&b), SIMD::Splat(alpha * sign))));
+            result = Quaternion(a.X, a.Y, a.Z, a.W);
+            result.Normalize();
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    FORCE_INLINE void SampleChannel(const CompressedAnimationData::Channel& channel, const uint16* frameA, const uint16* frameB, float alpha, SimdVector4 alphaVector, Transform& result)
+    {
+        Float4 value;
+        if (SampleVector(channel.Position, frameA, frameB, alphaVector, value))
+            result.Translation = Vector3(value.X, value.Y, value.Z);
+        SampleRotation(channel.Rotation, frameA, frameB, alpha, result.Orientation);
+        if (SampleVector(channel.Scale, frameA, frameB, alphaVector, value))
+            result.Scale = Float3(value.X, value.Y, value.Z);
+    }
+
+    bool InitVectorTrack(CompressedAnimationData::Track& track, const LinearCurve<Float3>& curve, int32 framesCount, float maxError, uint16& offset, Array<Float3>& values)
+    {
+        if (curve.GetKeyframes().IsEmpty())
+            return false;
+        SampleCurve(curve, framesCount, values);
+        Float3 min = values[0], max = values[0];
+        for (const Float3& e : values)
+        {
+            min = Float3::Min(min, e);
+            max = Float3::Max(max, e);
+        }
+        const Float3 extent = max - min;
+        if (extent.MaxValue() <= maxError)
+        {
+            track.Format = CompressedAnimationData::TrackFormat::Constant;
+            track.Min = Float4((min + max) * 0.5f, 0.0f);
+            return false;
+        }
+        track.Offset = offset;
+        if (extent.MaxValue() / QUANTIZATION_STEPS <= maxError)
+        {
+            track.Format = CompressedAnimationData::TrackFormat::Quantized;
+            track.Min = Float4(min, 0.0f);
+            track.Scale = Float4(extent / QUANTIZATION_STEPS, 0.0f);
+            offset += 3;
+        }
+        else
+        {
+            track.Format = CompressedAnimationData::TrackFormat::Raw;
+            offset += 6;
+        }
+        return true;
+    }
+
+    void WriteVectorTrack(const CompressedAnimationData::Track& track, const Float3& value, uint16* dst)
+    {
+        if (track.Format == CompressedAnimationData::TrackFormat::Raw)
+        {
+            Platform::MemoryCopy(dst + track.Offset, value.Raw, sizeof(Float3));
+        }
+        else if (track.Format == CompressedAnimationData::TrackFormat::Quantized)
+        {
+            for (int32 i = 0; i < 3; i++)
+                dst[track.Offset + i] = track.Scale.Raw[i] > ZeroTolerance ? (uint16)Math::Clamp(Math::RoundToInt((value.Raw[i] - track.Min.Raw[i]) / track.Scale.Raw[i]), 0, (int32)QUANTIZATION_STEPS) : 0;
+        }
+    }
+
+    template<typename T>
+    uint64 GetCurveSize(const LinearCurve<T>& curve)
+    {
+        return curve.GetKeyframes().Count() * sizeof(LinearCurveKeyframe<T>);
+    }
+}
+
+bool CompressedAnimationData::Init(const AnimationData& data)
+{
+    Release();
+    const int32 framesCount = Math::CeilToInt((float)data.Duration) + 1;
+    const int32 channelsCount = data.Channels.Count();
+    if (channelsCount == 0)
+        return true;
+
+    // Setup tracks
+    Array<Channel> channels;
+    channels.Resize(channelsCount);
+    Array<Array<Float3>> positions, scales;
+    Array<Array<Quaternion>> rotations;
+    positions.Resize(channelsCount);
+    rotations.Resize(channelsCount);
+    scales.Resize(channelsCount);
+    uint16 stride = 0;
+    uint64 sourceSize = 0;
+    for (int32 i = 0; i < channelsCount; i++)
+    {
+        const NodeAnimationData& source = data.Channels[i];
+        Channel& channel = channels[i];
+        sourceSize += GetCurveSize(source.Position) + GetCurveSize(source.Rotation) + GetCurveSize(source.Scale);
+        InitVectorTrack(channel.Position, source.Position, framesCount, ANIM_COMPRESSION_POSITION_ERROR, stride, positions[i]);
+        InitVectorTrack(channel.Scale, source.Scale, framesCount, ANIM_COMPRESSION_SCALE_ERROR, stride, scales[i]);
+        if (source.Rotation.GetKeyframes().HasItems())
+        {
+            auto& values = rotations[i];
+            SampleCurve(source.Rotation, framesCount, values);
+            bool isConstant = true;
+            for (int32 frame = 1; frame < framesCount && isConstant; frame++)
+                isConstant = Math::Abs(Quaternion::Dot(values[0], values[frame])) > 1.0f - ANIM_COMPRESSION_ROTATION_ERROR;
+            if (isConstant)
+            {
+                channel.Rotation.Format = TrackFormat::Constant;
+                channel.Rotation.Min = Float4(values[0].X, values[0].Y, values[0].Z, values[0].W);
+            }
+            else
+            {
+                channel.Rotation.Format = TrackFormat::Quantized;
+                channel.Rotation.Offset = stride;
+                stride += 3;
+            }
+        }
+        if (stride >= MAX_uint16 - 9)
+            return true;
+    }
+
+    // Skip if the compression doesn't save memory (eg. long animation with a few keyframes)
+    if ((uint64)framesCount * stride * sizeof(uint16) + channelsCount * sizeof(Channel) >= sourceSize)
+        return true;
+
+    // Write frames
+    _frames.Resize(framesCount * stride);
+    for (int32 frame = 0; frame < framesCount; frame++)
+    {
+        uint16* dst = _frames.Get() + frame * stride;
+        for (int32 i = 0; i < channelsCount; i++)
+        {
+            const Channel& channel = channels[i];
+            if (positions[i].HasItems())
+                WriteVectorTrack(channel.Position, positions[i][frame], dst);
+            if (scales[i].HasItems())
+                WriteVectorTrack(channel.Scale, scales[i][frame], dst);
+            if (channel.Rotation.Format == TrackFormat::Quantized)
+                EncodeRotation(rotations[i][frame], dst + channel.Rotation.Offset);
+        }
+    }
+    _channels = MoveTemp(channels);
+    _framesCount = framesCount;
+    _frameStride = stride;
+
+    // Validate the error at the source keyframes (eg. keyframes placed between the frames cannot be represented by the resampled animation)
+    for (int32 i = 0; i < channelsCount; i++)
+    {
+        const NodeAnimationData& source = data.Channels[i];
+        Transform value = Transform::Identity;
+        for (const auto& k : source.Position.GetKeyframes())
+        {
+            Sample(i, k.Time, value);
+            if (Float3::Distance(Float3(value.Translation), k.Value) > ANIM_COMPRESSION_POSITION_ERROR * 2.0f)
+            {
+                Release();
+                return true;
+            }
+        }
+        for (const auto& k : source.Rotation.GetKeyframes())
+        {
+            Sample(i, k.Time, value);
+            if (Math::Abs(Quaternion::Dot(value.Orientation, k.Value)) < 1.0f - ANIM_COMPRESSION_ROTATION_ERROR * 2.0f)
+            {
+                Release();
+                return true;
+            }
+        }
+        for (const auto& k : source.Scale.GetKeyframes())
+        {
+            Sample(i, k.Time, value);
+            if (Float3::Distance(value.Scale, k.Value) > ANIM_COMPRESSION_SCALE_ERROR * 2.0f)
+            {
+                Release();
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void CompressedAnimationData::Release()
+{
+    _channels.Resize(0);
+    _frames.Resize(0);
+    _framesCount = 0;
+    _frameStride = 0;
+}
+
+void CompressedAnimationData::Sample(float time, Transform* result) const
+{
+    ASSERT_LOW_LAYER(IsValid());
+    time = Math::Clamp(time, 0.0f, (float)(_framesCount - 1));
+    const int32 frame = Math::Min(Math::FloorToInt(time), _framesCount - 2 < 0 ? 0 : _framesCount - 2);
+    const float alpha = Math::Saturate(time - (float)frame);
+    const SimdVector4 alphaVector = SIMD::Splat(alpha);
+    const uint16* frameA = _frames.Get() + frame * _frameStride;
+    const uint16* frameB = frame + 1 < _framesCount ? frameA + _frameStride : frameA;
+    for (int32 i = 0; i < _channels.Count(); i++)
+        SampleChannel(_channels.Get()[i], frameA, frameB, alpha, alphaVector, result[i]);
+}
+
+void CompressedAnimationData::Sample(int32 channelIndex, float time, Transform& result) const
+{
+    ASSERT_LOW_LAYER(IsValid());
+    time = Math::Clamp(time, 0.0f, (float)(_framesCount - 1));
+    const int32 frame = Math::Min(Math::FloorToInt(time), _framesCount - 2 < 0 ? 0 : _framesCount - 2);
+    const float alpha = Math::Saturate(time - (float)frame);
+    const uint16* frameA = _frames.Get() + frame * _frameStride;
+    const uint16* frameB = frame + 1 < _framesCount ? frameA + _frameStride : frameA;
+    SampleChannel(_channels[channelIndex], frameA, frameB, alpha, SIMD::Splat(alpha), result);
+}
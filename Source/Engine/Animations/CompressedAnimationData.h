@@ -0,0 +1,104 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/Math/Transform.h"
+
+struct AnimationData;
+
+/// <summary>
+/// Compressed skeleton nodes animation data. Contains the animation resampled at every frame with quantized channels (range-reduced 16-bit positions and scales, smallest-three rotations) and constant tracks stored once. Frames data is laid out frame after frame so all channels of the clip get sampled at once without searching the keyframes.
+/// </summary>
+class FLAXENGINE_API CompressedAnimationData
+{
+public:
+    /// <summary>
+    /// The storage format of the animation track.
+    /// </summary>
+    enum class TrackFormat : byte
+    {
+        // Track not animated (uses the node default value).
+        None,
+        // Single value for the whole animation.
+        Constant,
+        // Per-frame 16-bit values (3 components).
+        Quantized,
+        // Per-frame 32-bit float values (3 components), used when quantization error would be too high.
+        Raw,
+    };
+
+    struct Track
+    {
+        TrackFormat Format = TrackFormat::None;
+        // The offset of the track data in the frame (in 16-bit elements).
+        uint16 Offset = 0;
+        // The constant value or the minimum of the quantized range.
+        Float4 Min = Float4::Zero;
+        // The quantized range extent divided by the quantization steps.
+        Float4 Scale = Float4::Zero;
+    };
+
+    struct Channel
+    {
+        Track Position;
+        Track Rotation;
+        Track Scale;
+    };
+
+private:
+    Array<Channel> _channels;
+    Array<uint16> _frames;
+    int32 _framesCount = 0;
+    int32 _frameStride = 0;
+
+public:
+    /// <summary>
+    /// Determines whether the compressed data is valid and can be sampled.
+    /// </summary>
+    FORCE_INLINE bool IsValid() const
+    {
+        return _framesCount != 0;
+    }
+
+    /// <summary>
+    /// Gets the amount of compressed animation channels (matches the source animation channels).
+    /// </summary>
+    FORCE_INLINE int32 GetChannelsCount() const
+    {
+        return _channels.Count();
+    }
+
+    /// <summary>
+    /// Compresses the animation. Fails if any channel cannot be represented within the error bounds (eg. keyframes not aligned to the animation frames) or if the compressed data would be larger than the source.
+    /// </summary>
+    /// <param name="data">The source animation data.</param>
+    /// <returns>True if failed (compressed data cannot be used), otherwise false.</returns>
+    bool Init(const AnimationData& data);
+
+    /// <summary>
+    /// Releases the data.
+    /// </summary>
+    void Release();
+
+    /// <summary>
+    /// Samples all channels of the animation at the specified time (clamped to the animation duration). Not animated tracks are not modified.
+    /// </summary>
+    /// <param name="time">The time to sample the animation at (in frames).</param>
+    /// <param name="result">The output transformations for all animation channels (array of size equal to channels count).</param>
+    void Sample(float time, Transform* result) const;
+
+    /// <summary>
+    /// Samples a single channel of the animation at the specified time (clamped to the animation duration). Not animated tracks are not modified.
+    /// </summary>
+    /// <param name="channelIndex">The animation channel index.</param>
+    /// <param name="time">The time to sample the animation at (in frames).</param>
+    /// <param name="result">The output transformation.</param>
+    void Sample(int32 channelIndex, float time, Transform& result) const;
+
+    uint64 GetMemoryUsage() const
+    {
+        return _channels.Capacity() * sizeof(Channel) + _frames.Capacity() * sizeof(uint16);
+    }
+};
@@ -15,3 +15,11 @@
 #else
 #define ANIM_GRAPH_PROFILE_EVENT(name)
 #endif
+
+// Maximum nesting depth of the anim graph branches forked into parallel jobs (eg. 2 allows evaluating 3 layers at once)
+#define ANIM_GRAPH_MAX_FORK_DEPTH 2
+
+// Maximum error introduced by the animation keyframes reduction and compression (positions and scales in node local space units, rotations as 1-|dot| of the quaternions)
+#define ANIM_COMPRESSION_POSITION_ERROR 0.01f
+#define ANIM_COMPRESSION_ROTATION_ERROR 1e-6f
+#define ANIM_COMPRESSION_SCALE_ERROR 0.0001f
@@ -2,6 +2,7 @@
 
 #include "AnimGraph.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Assets/SkeletonMask.h"
 #include "Engine/Content/Assets/AnimationGraphFunction.h"
@@ -9,6 +10,72 @@
 #include "Engine/Utilities/Delaunay2D.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 
+namespace
+{
+    bool IsForkBranchLeaf(const AnimGraphNode* node)
+    {
+        // Constants and parameter getters have no inputs nor state so can be shared between branches
+        return node->GroupID == 2 || (node->GroupID == 6 && node->TypeID == 1);
+    }
+
+    bool CanForkBranchNode(const AnimGraphNode* node)
+    {
+        // Custom nodes, functions and slots use shared (or managed) state that is not safe to access from multiple threads
+        return node->GroupID != 13 && node->GroupID != 16 && !(node->GroupID == 9 && (node->TypeID == 24 || node->TypeID == 32));
+    }
+
+    bool IsIndependentBranch(AnimGraphNode* forkNode, AnimGraphBox* box, AnimGraphNode* rootNode)
+    {
+        if (!box->HasConnection())
+            return false;
+
+        // Branch cannot reach (via any connection) the graph output or nodes connected to the other boxes of the forked node (the branch must not be evaluated elsewhere)
+        HashSet<AnimGraphNode*> forbidden;
+        if (rootNode)
+            forbidden.Add(rootNode);
+        for (auto& e : forkNode->Boxes)
+        {
+            if (&e == box)
+                continue;
+            for (auto connection : e.Connections)
+                forbidden.Add(connection->GetParent<AnimGraphNode>());
+        }
+        HashSet<AnimGraphNode*> visited;
+        Array<AnimGraphNode*, InlinedAllocation<64>> stack;
+        visited.Add(forkNode);
+        for (auto connection : box->Connections)
+        {
+            auto node = connection->GetParent<AnimGraphNode>();
+            if (!visited.Contains(node))
+            {
+                visited.Add(node);
+                stack.Add(node);
+            }
+        }
+        while (stack.HasItems())
+        {
+            const auto node = stack.Pop();
+            if (IsForkBranchLeaf(node))
+                continue;
+            if (forbidden.Contains(node) || !CanForkBranchNode(node))
+                return false;
+            for (auto& e : node->Boxes)
+            {
+                for (auto connection : e.Connections)
+                {
+                    auto other = connection->GetParent<AnimGraphNode>();
+                    if (!visited.Contains(other))
+                    {
+                        visited.Add(other);
+                        stack.Add(other);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
 AnimSubGraph* AnimGraphBase::LoadSubGraph(const void* data, int32 dataLength, const Char* name)
 {
     if (data == nullptr || dataLength == 0)
@@ -51,6 +118,13 @@ bool AnimGraphBase::Load(ReadStream* stream, bool loadMeta)
 
     BucketsCountTotal += BucketsCountSelf;
 
+    // Find blend nodes which inputs can be evaluated in parallel
+    for (auto& node : Nodes)
+    {
+        if (node.GroupID == 9 && (node.TypeID == 9 || node.TypeID == 10 || node.TypeID == 11))
+            node.CanForkInputs = IsIndependentBranch(&node, node.GetBox(2), (AnimGraphNode*)_rootNode);
+    }
+
     return false;
 }
 
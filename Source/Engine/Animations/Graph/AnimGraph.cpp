@@ -6,8 +6,39 @@
 #include "Engine/Content/Assets/SkinnedModel.h"
 #include "Engine/Graphics/Models/SkeletonData.h"
 #include "Engine/Scripting/Scripting.h"
+#include "Engine/Threading/JobSystem.h"
 
 ThreadLocal<AnimGraphContext> AnimGraphExecutor::Context;
+bool AnimGraphExecutor::AllowParallelBranches = false;
+
+namespace
+{
+    // Graph branch evaluated in a separate job (shared by the job and the forking thread, released by the last user)
+    struct AnimGraphFork
+    {
+        int64 State; // 0 - pending, 1 - taken, 2 - done
+        int64 RefCount;
+        AnimGraphImpulse* Result;
+        bool HasResult;
+        VisjectExecutor::Node* Node;
+        VisjectExecutor::Box* Box;
+        AnimGraphInstanceData* Data;
+        float DeltaTime;
+        uint64 CurrentFrameIndex;
+        int32 ForkDepth;
+        AnimGraphImpulse* EmptyNodes;
+        AnimGraphTransitionData TransitionData;
+        Array<VisjectExecutor::Node*, FixedAllocation<ANIM_GRAPH_MAX_CALL_STACK>> CallStack;
+        Array<VisjectExecutor::Graph*, FixedAllocation<32>> GraphStack;
+        Dictionary<VisjectExecutor::Node*, VisjectExecutor::Graph*> Functions;
+
+        void Release()
+        {
+            if (Platform::InterlockedDecrement(&RefCount) == 0)
+                Delete(this);
+        }
+    };
+}
 
 RootMotionData RootMotionData::Identity = { Vector3(0.0f), Quaternion(0.0f, 0.0f, 0.0f, 1.0f) };
 
@@ -238,6 +269,7 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         context.Functions.Clear();
         context.PoseCacheSize = 0;
         context.ValueCache.Clear();
+        context.ForkDepth = 0;
 
         // Prepare instance data
         if (data.Version != _graph.Version)
@@ -337,6 +369,90 @@ void AnimGraphExecutor::GetInputValue(Box* box, Value& result)
     result = eatBox(box->GetParent<Node>(), box->FirstConnection());
 }
 
+void AnimGraphExecutor::GetPoseInputs(AnimGraphNode* node, Value& valueA, Value& valueB)
+{
+    auto& context = Context.Get();
+    Box* boxA = node->GetBox(1);
+    Box* boxB = node->GetBox(2);
+    if (!AllowParallelBranches || !node->CanForkInputs || context.ForkDepth >= ANIM_GRAPH_MAX_FORK_DEPTH || !boxA->HasConnection() || !boxB->HasConnection())
+    {
+        valueA = tryGetValue(boxA, Value::Null);
+        valueB = tryGetValue(boxB, Value::Null);
+        return;
+    }
+
+    // Fork the second branch into a job (snapshot the context state because this thread keeps using it)
+    auto fork = New<AnimGraphFork>();
+    fork->State = 0;
+    fork->RefCount = 2;
+    fork->Result = node->GetNodes(this);
+    fork->HasResult = false;
+    fork->Node = (Node*)node;
+    fork->Box = boxB->FirstConnection();
+    fork->Data = context.Data;
+    fork->DeltaTime = context.DeltaTime;
+    fork->CurrentFrameIndex = context.CurrentFrameIndex;
+    fork->ForkDepth = context.ForkDepth + 1;
+    fork->EmptyNodes = &context.EmptyNodes;
+    fork->TransitionData = context.TransitionData;
+    fork->CallStack = context.CallStack;
+    fork->GraphStack = context.GraphStack;
+    if (context.Functions.HasItems())
+        fork->Functions = context.Functions;
+    context.ForkDepth++;
+    JobSystem::Dispatch([this, fork](int32)
+    {
+        if (Platform::InterlockedCompareExchange(&fork->State, 1, 0) == 0)
+        {
+            ANIM_GRAPH_PROFILE_EVENT("Fork");
+            auto& forkContext = Context.Get();
+            forkContext.Data = fork->Data;
+            forkContext.DeltaTime = fork->DeltaTime;
+            forkContext.CurrentFrameIndex = fork->CurrentFrameIndex;
+            forkContext.ForkDepth = fork->ForkDepth;
+            forkContext.TransitionData = fork->TransitionData;
+            forkContext.CallStack = fork->CallStack;
+            forkContext.GraphStack = fork->GraphStack;
+            forkContext.Functions = fork->Functions;
+            forkContext.PoseCacheSize = 0;
+            forkContext.ValueCache.Clear();
+            forkContext.EmptyNodes.Nodes = fork->EmptyNodes->Nodes;
+            forkContext.EmptyNodes.RootMotion = fork->EmptyNodes->RootMotion;
+            forkContext.EmptyNodes.Position = fork->EmptyNodes->Position;
+            forkContext.EmptyNodes.Length = fork->EmptyNodes->Length;
+
+            // Evaluate branch and copy the pose into the forking thread memory (this thread context can be reused by other jobs)
+            const Value result = eatBox(fork->Node, fork->Box);
+            if (ANIM_GRAPH_IS_VALID_PTR(result))
+            {
+                CopyNodes(fork->Result, result);
+                fork->Result->RootMotion = static_cast<AnimGraphImpulse*>(result.AsPointer)->RootMotion;
+                fork->HasResult = true;
+            }
+            forkContext.Data = nullptr;
+            Platform::AtomicStore(&fork->State, 2);
+        }
+        fork->Release();
+    });
+
+    // Evaluate the first branch on this thread
+    valueA = tryGetValue(boxA, Value::Null);
+
+    // Join (evaluate the second branch here if the job has not started yet, eg. all job threads are busy)
+    if (Platform::InterlockedCompareExchange(&fork->State, 1, 0) == 0)
+    {
+        valueB = tryGetValue(boxB, Value::Null);
+    }
+    else
+    {
+        while (Platform::AtomicRead(&fork->State) != 2)
+            Platform::Sleep(0);
+        valueB = fork->HasResult ? Value(fork->Result) : Value::Null;
+    }
+    context.ForkDepth--;
+    fork->Release();
+}
+
 AnimGraphImpulse* AnimGraphExecutor::GetEmptyNodes()
 {
     return &Context.Get().EmptyNodes;
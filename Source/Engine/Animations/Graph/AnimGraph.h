@@ -581,6 +581,11 @@ class AnimGraphNode : public VisjectGraphNode<AnimGraphBox>
     /// </summary>
     AdditionalData Data;
 
+    /// <summary>
+    /// True if the second pose input of this blend node is an independent graph branch (not shared with the rest of the graph) so it can be evaluated in parallel to the first input.
+    /// </summary>
+    bool CanForkInputs = false;
+
 public:
     AnimGraphNode()
     {
@@ -795,6 +800,7 @@ struct AnimGraphContext
     ChunkedArray<AnimGraphImpulse, 256> PoseCache;
     int32 PoseCacheSize;
     Dictionary<VisjectExecutor::Box*, Variant> ValueCache;
+    int32 ForkDepth;
 };
 
 /// <summary>
@@ -812,6 +818,11 @@ class AnimGraphExecutor : public VisjectExecutor
     static ThreadLocal<AnimGraphContext> Context;
 
 public:
+    /// <summary>
+    /// Enables evaluating the independent graph branches (eg. blended layers) in parallel via Job System. Set by the animations system when there are fewer models to update than the job threads.
+    /// </summary>
+    static bool AllowParallelBranches;
+
     /// <summary>
     /// Initializes the managed runtime calls.
     /// </summary>
@@ -887,5 +898,6 @@ class AnimGraphExecutor : public VisjectExecutor
     Variant SampleAnimationsWithBlend(AnimGraphNode* node, bool loop, float length, float startTimePos, float prevTimePos, float& newTimePos, Animation* animA, Animation* animB, float speedA, float speedB, float alpha);
     Variant SampleAnimationsWithBlend(AnimGraphNode* node, bool loop, float length, float startTimePos, float prevTimePos, float& newTimePos, Animation* animA, Animation* animB, Animation* animC, float speedA, float speedB, float speedC, float alphaA, float alphaB, float alphaC);
     Variant Blend(AnimGraphNode* node, const Value& poseA, const Value& poseB, float alpha, AlphaBlendMode alphaMode);
+    void GetPoseInputs(AnimGraphNode* node, Value& valueA, Value& valueB);
     Variant SampleState(AnimGraphNode* state);
 };
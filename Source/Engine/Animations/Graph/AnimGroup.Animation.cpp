@@ -5,12 +5,17 @@
 #include "Engine/Content/Assets/SkeletonMask.h"
 #include "Engine/Content/Assets/AnimationGraphFunction.h"
 #include "Engine/Animations/AlphaBlend.h"
+#include "Engine/Animations/AnimationPose.h"
 #include "Engine/Animations/AnimEvent.h"
 #include "Engine/Animations/InverseKinematics.h"
 #include "Engine/Level/Actors/AnimatedModel.h"
+#include "Engine/Threading/Threading.h"
 
 namespace
 {
+    // Used to sync events processing from the graph branches evaluated in parallel
+    CriticalSection EventsLocker;
+
     void BlendAdditiveWeightedRotation(Quaternion& base, Quaternion& additive, float weight)
     {
         // Pick a shortest path between rotation to fix blending artifacts
@@ -19,6 +24,14 @@ namespace
             additive *= -1;
         base += additive;
     }
+
+    void EvaluateChannel(Animation* anim, int32 channelIndex, float time, Transform& result)
+    {
+        if (anim->CompressedData.IsValid())
+            anim->CompressedData.Sample(channelIndex, time, result);
+        else
+            anim->Data.Channels[channelIndex].Evaluate(time, &result, false);
+    }
 }
 
 int32 AnimGraphExecutor::GetRootNodeIndex(Animation* anim)
@@ -48,8 +61,7 @@ void AnimGraphExecutor::ExtractRootMotion(const Animation::NodeToChannel* mappin
     {
         // Get the root bone transformation
         Transform rootBefore = refPose;
-        const NodeAnimationData& rootChannel = anim->Data.Channels[nodeToChannel];
-        rootChannel.Evaluate(prevPos, &rootBefore, false);
+        EvaluateChannel(anim, nodeToChannel, prevPos, rootBefore);
 
         // Check if animation looped
         if (pos < prevPos)
@@ -59,10 +71,10 @@ void AnimGraphExecutor::ExtractRootMotion(const Animation::NodeToChannel* mappin
             const float timeToEnd = endPos - prevPos;
 
             Transform rootBegin = refPose;
-            rootChannel.Evaluate(0, &rootBegin, false);
+            EvaluateChannel(anim, nodeToChannel, 0, rootBegin);
 
             Transform rootEnd = refPose;
-            rootChannel.Evaluate(endPos, &rootEnd, false);
+            EvaluateChannel(anim, nodeToChannel, endPos, rootEnd);
 
             //rootChannel.Evaluate(pos - timeToEnd, &rootNow, true);
 
@@ -92,6 +104,9 @@ void AnimGraphExecutor::ProcessAnimEvents(AnimGraphNode* node, bool loop, float
         return;
     ANIM_GRAPH_PROFILE_EVENT("Events");
     auto& context = Context.Get();
+    CriticalSection* locker = context.ForkDepth != 0 ? &EventsLocker : nullptr;
+    if (locker)
+        locker->Lock();
     float eventTimeMin = animPrevPos;
     float eventTimeMax = animPos;
     if (loop && context.DeltaTime * speed < 0)
@@ -159,6 +174,8 @@ void AnimGraphExecutor::ProcessAnimEvents(AnimGraphNode* node, bool loop, float
             }
         }
     }
+    if (locker)
+        locker->Unlock();
 }
 
 float GetAnimPos(float& timePos, float startTimePos, bool loop, float length)
@@ -261,6 +278,20 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
     const auto mapping = anim->GetMapping(_graph.BaseModel);
     const bool weighted = weight < 1.0f;
     const auto emptyNodes = GetEmptyNodes();
+    Array<Transform, InlinedAllocation<128>> channels;
+    const bool compressed = anim->CompressedData.IsValid();
+    if (compressed)
+    {
+        // Sample all animation channels at once (not animated tracks use the nodes reference pose)
+        channels.Resize(anim->CompressedData.GetChannelsCount(), false);
+        for (int32 i = 0; i < nodes->Nodes.Count(); i++)
+        {
+            const int32 nodeToChannel = mapping->At(i);
+            if (nodeToChannel != -1)
+                channels[nodeToChannel] = emptyNodes->Nodes[i];
+        }
+        anim->CompressedData.Sample(animPos, channels.Get());
+    }
     for (int32 i = 0; i < nodes->Nodes.Count(); i++)
     {
         const int32 nodeToChannel = mapping->At(i);
@@ -269,7 +300,10 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         if (nodeToChannel != -1)
         {
             // Calculate the animated node transformation
-            anim->Data.Channels[nodeToChannel].Evaluate(animPos, &srcNode, false);
+            if (compressed)
+                srcNode = channels[nodeToChannel];
+            else
+                anim->Data.Channels[nodeToChannel].Evaluate(animPos, &srcNode, false);
         }
 
         // Blend node
@@ -372,10 +406,7 @@ Variant AnimGraphExecutor::SampleAnimationsWithBlend(AnimGraphNode* node, bool l
     ProcessAnimation(nodes, node, loop, length, pos, prevPos, animB, speedB, alpha, ProcessAnimationMode::BlendAdditive);
 
     // Normalize rotations
-    for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-    {
-        nodes->Nodes[i].Orientation.Normalize();
-    }
+    AnimationPose::NormalizeRotations(nodes->Nodes.Get(), nodes->Nodes.Count());
     if (_rootMotionMode != RootMotionMode::NoExtraction)
     {
         nodes->RootMotion.Rotation.Normalize();
@@ -406,10 +437,7 @@ Variant AnimGraphExecutor::SampleAnimationsWithBlend(AnimGraphNode* node, bool l
     ProcessAnimation(nodes, node, loop, length, pos, prevPos, animC, speedC, alphaC, ProcessAnimationMode::BlendAdditive);
 
     // Normalize rotations
-    for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-    {
-        nodes->Nodes[i].Orientation.Normalize();
-    }
+    AnimationPose::NormalizeRotations(nodes->Nodes.Get(), nodes->Nodes.Count());
     if (_rootMotionMode != RootMotionMode::NoExtraction)
     {
         nodes->RootMotion.Rotation.Normalize();
@@ -433,10 +461,7 @@ Variant AnimGraphExecutor::Blend(AnimGraphNode* node, const Value& poseA, const
     if (!ANIM_GRAPH_IS_VALID_PTR(poseB))
         nodesB = GetEmptyNodes();
 
-    for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-    {
-        Transform::Lerp(nodesA->Nodes[i], nodesB->Nodes[i], alpha, nodes->Nodes[i]);
-    }
+    AnimationPose::Blend(nodesA->Nodes.Get(), nodesB->Nodes.Get(), alpha, nodes->Nodes.Get(), nodes->Nodes.Count());
     RootMotionData::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
     nodes->Position = Math::Lerp(nodesA->Position, nodesB->Position, alpha);
     nodes->Length = Math::Lerp(nodesA->Length, nodesB->Length, alpha);
@@ -643,9 +668,9 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
     {
         const auto anim = node->Assets[0].As<Animation>();
         auto& bucket = context.Data->State[node->BucketIndex].Animation;
-        const float speed = (float)tryGetValue(node->GetBox(5), node->Values[1]);
-        const bool loop = (bool)tryGetValue(node->GetBox(6), node->Values[2]);
-        const float startTimePos = (float)tryGetValue(node->GetBox(7), node->Values[3]);
+        const float speed = tryGetValue<float>(node->GetBox(5), node->Values[1]);
+        const bool loop = tryGetValue<bool>(node->GetBox(6), node->Values[2]);
+        const float startTimePos = tryGetValue<float>(node->GetBox(7), node->Values[3]);
 
         switch (box->ID)
         {
@@ -704,8 +729,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get the transformation
         Transform transform;
         transform.Translation = (Vector3)tryGetValue(node->GetBox(2), Vector3::Zero);
-        transform.Orientation = (Quaternion)tryGetValue(node->GetBox(3), Quaternion::Identity);
-        transform.Scale = (Float3)tryGetValue(node->GetBox(4), Float3::One);
+        transform.Orientation = tryGetValue<Quaternion>(node->GetBox(3), Quaternion::Identity);
+        transform.Scale = tryGetValue<Float3>(node->GetBox(4), Float3::One);
 
         // Skip if no change will be performed
         auto& skeleton = _graph.BaseModel->Skeleton;
@@ -882,7 +907,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
     // Blend
     case 9:
     {
-        const float alpha = Math::Saturate((float)tryGetValue(node->GetBox(3), node->Values[0]));
+        const float alpha = Math::Saturate(tryGetValue<float>(node->GetBox(3), node->Values[0]));
 
         // Only A
         if (Math::NearEqual(alpha, 0.0f, ANIM_GRAPH_BLEND_THRESHOLD))
@@ -897,8 +922,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Blend A and B
         else
         {
-            const auto valueA = tryGetValue(node->GetBox(1), Value::Null);
-            const auto valueB = tryGetValue(node->GetBox(2), Value::Null);
+            Value valueA, valueB;
+            GetPoseInputs(node, valueA, valueB);
             const auto nodes = node->GetNodes(this);
 
             auto nodesA = static_cast<AnimGraphImpulse*>(valueA.AsPointer);
@@ -908,10 +933,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
             if (!ANIM_GRAPH_IS_VALID_PTR(valueB))
                 nodesB = GetEmptyNodes();
 
-            for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-            {
-                Transform::Lerp(nodesA->Nodes[i], nodesB->Nodes[i], alpha, nodes->Nodes[i]);
-            }
+            AnimationPose::Blend(nodesA->Nodes.Get(), nodesB->Nodes.Get(), alpha, nodes->Nodes.Get(), nodes->Nodes.Count());
             RootMotionData::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
             value = nodes;
         }
@@ -921,7 +943,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
     // Blend Additive
     case 10:
     {
-        const float alpha = Math::Saturate((float)tryGetValue(node->GetBox(3), node->Values[0]));
+        const float alpha = Math::Saturate(tryGetValue<float>(node->GetBox(3), node->Values[0]));
 
         // Only A
         if (Math::NearEqual(alpha, 0.0f, ANIM_GRAPH_BLEND_THRESHOLD))
@@ -931,8 +953,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Blend A and B
         else
         {
-            const auto valueA = tryGetValue(node->GetBox(1), Value::Null);
-            const auto valueB = tryGetValue(node->GetBox(2), Value::Null);
+            Value valueA, valueB;
+            GetPoseInputs(node, valueA, valueB);
 
             if (!ANIM_GRAPH_IS_VALID_PTR(valueA))
             {
@@ -947,17 +969,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
                 const auto nodes = node->GetNodes(this);
                 const auto nodesA = static_cast<AnimGraphImpulse*>(valueA.AsPointer);
                 const auto nodesB = static_cast<AnimGraphImpulse*>(valueB.AsPointer);
-                Transform t, tA, tB;
-                for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-                {
-                    tA = nodesA->Nodes[i];
-                    tB = nodesB->Nodes[i];
-                    t.Translation = tA.Translation + tB.Translation;
-                    t.Orientation = tA.Orientation * tB.Orientation;
-                    t.Scale = tA.Scale * tB.Scale;
-                    t.Orientation.Normalize();
-                    Transform::Lerp(tA, t, alpha, nodes->Nodes[i]);
-                }
+                AnimationPose::BlendAdditive(nodesA->Nodes.Get(), nodesB->Nodes.Get(), alpha, nodes->Nodes.Get(), nodes->Nodes.Count());
                 RootMotionData::Lerp(nodesA->RootMotion, nodesA->RootMotion + nodesB->RootMotion, alpha, nodes->RootMotion);
                 value = nodes;
             }
@@ -968,7 +980,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
     // Blend with Mask
     case 11:
     {
-        const float alpha = Math::Saturate((float)tryGetValue(node->GetBox(3), node->Values[0]));
+        const float alpha = Math::Saturate(tryGetValue<float>(node->GetBox(3), node->Values[0]));
         auto mask = node->Assets[0].As<SkeletonMask>();
 
         // Only A or missing/invalid mask
@@ -979,8 +991,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Blend A and B with mask
         else
         {
-            auto valueA = tryGetValue(node->GetBox(1), Value::Null);
-            auto valueB = tryGetValue(node->GetBox(2), Value::Null);
+            Value valueA, valueB;
+            GetPoseInputs(node, valueA, valueB);
             const auto nodes = node->GetNodes(this);
 
             if (!ANIM_GRAPH_IS_VALID_PTR(valueA))
@@ -1031,9 +1043,9 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Prepare
         auto& bucket = context.Data->State[node->BucketIndex].MultiBlend;
         const auto range = node->Values[0].AsFloat4();
-        const auto speed = (float)tryGetValue(node->GetBox(1), node->Values[1]);
-        const auto loop = (bool)tryGetValue(node->GetBox(2), node->Values[2]);
-        const auto startTimePos = (float)tryGetValue(node->GetBox(3), node->Values[3]);
+        const auto speed = tryGetValue<float>(node->GetBox(1), node->Values[1]);
+        const auto loop = tryGetValue<bool>(node->GetBox(2), node->Values[2]);
+        const auto startTimePos = tryGetValue<float>(node->GetBox(3), node->Values[3]);
         auto& data = node->Data.MultiBlend1D;
 
         // Check if not valid animation binded
@@ -1041,7 +1053,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
             break;
 
         // Get axis X
-        float x = (float)tryGetValue(node->GetBox(4), Value::Zero);
+        float x = tryGetValue<float>(node->GetBox(4), Value::Zero);
         x = Math::Clamp(x, range.X, range.Y);
 
         // Check if need to evaluate multi blend length
@@ -1120,9 +1132,9 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Prepare
         auto& bucket = context.Data->State[node->BucketIndex].MultiBlend;
         const auto range = node->Values[0].AsFloat4();
-        const auto speed = (float)tryGetValue(node->GetBox(1), node->Values[1]);
-        const auto loop = (bool)tryGetValue(node->GetBox(2), node->Values[2]);
-        const auto startTimePos = (float)tryGetValue(node->GetBox(3), node->Values[3]);
+        const auto speed = tryGetValue<float>(node->GetBox(1), node->Values[1]);
+        const auto loop = tryGetValue<bool>(node->GetBox(2), node->Values[2]);
+        const auto startTimePos = tryGetValue<float>(node->GetBox(3), node->Values[3]);
         auto& data = node->Data.MultiBlend2D;
 
         // Check if not valid animation binded
@@ -1130,11 +1142,11 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
             break;
 
         // Get axis X
-        float x = (float)tryGetValue(node->GetBox(4), Value::Zero);
+        float x = tryGetValue<float>(node->GetBox(4), Value::Zero);
         x = Math::Clamp(x, range.X, range.Y);
 
         // Get axis Y
-        float y = (float)tryGetValue(node->GetBox(5), Value::Zero);
+        float y = tryGetValue<float>(node->GetBox(5), Value::Zero);
         y = Math::Clamp(y, range.Z, range.W);
 
         // Check if need to evaluate multi blend length
@@ -1345,8 +1357,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
 
         // Prepare
         auto& bucket = context.Data->State[node->BucketIndex].BlendPose;
-        const int32 poseIndex = (int32)tryGetValue(node->GetBox(1), node->Values[0]);
-        const float blendDuration = (float)tryGetValue(node->GetBox(2), node->Values[1]);
+        const int32 poseIndex = tryGetValue<int32>(node->GetBox(1), node->Values[0]);
+        const float blendDuration = tryGetValue<float>(node->GetBox(2), node->Values[1]);
         const int32 poseCount = Math::Clamp(node->Values[2].AsInt, 0, MaxBlendPoses);
         const AlphaBlendMode mode = (AlphaBlendMode)node->Values[3].AsInt;
 
@@ -1423,7 +1435,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto nodes = node->GetNodes(this);
         nodes->Nodes = poseData->Nodes;
         nodes->RootMotion.Translation = (Vector3)tryGetValue(node->GetBox(2), Value::Zero);
-        nodes->RootMotion.Rotation = (Quaternion)tryGetValue(node->GetBox(3), Value::Zero);
+        nodes->RootMotion.Rotation = tryGetValue<Quaternion>(node->GetBox(3), Value::Zero);
         value = nodes;
         break;
     }
@@ -1441,7 +1453,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto nodes = node->GetNodes(this);
         nodes->Nodes = poseData->Nodes;
         nodes->RootMotion.Translation = poseData->RootMotion.Translation + (Vector3)tryGetValue(node->GetBox(2), Value::Zero);
-        nodes->RootMotion.Rotation = poseData->RootMotion.Rotation * (Quaternion)tryGetValue(node->GetBox(3), Value::Zero);
+        nodes->RootMotion.Rotation = poseData->RootMotion.Rotation * tryGetValue<Quaternion>(node->GetBox(3), Value::Zero);
         value = nodes;
         break;
     }
@@ -1719,8 +1731,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get the transformation
         Transform transform;
         transform.Translation = (Vector3)tryGetValue(node->GetBox(2), Vector3::Zero);
-        transform.Orientation = (Quaternion)tryGetValue(node->GetBox(3), Quaternion::Identity);
-        transform.Scale = (Float3)tryGetValue(node->GetBox(4), Float3::One);
+        transform.Orientation = tryGetValue<Quaternion>(node->GetBox(3), Quaternion::Identity);
+        transform.Scale = tryGetValue<Float3>(node->GetBox(4), Float3::One);
 
         // Skip if no change will be performed
         if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || transformMode == BoneTransformMode::None || (transformMode == BoneTransformMode::Add && transform.IsIdentity()))
@@ -1833,7 +1845,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get input
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
-        float weight = (float)tryGetValue(node->GetBox(3), node->Values[1]);
+        float weight = tryGetValue<float>(node->GetBox(3), node->Values[1]);
         if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
         {
             // Pass through the input
@@ -1890,7 +1902,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get input
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
-        float weight = (float)tryGetValue(node->GetBox(4), node->Values[1]);
+        float weight = tryGetValue<float>(node->GetBox(4), node->Values[1]);
         if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
         {
             // Pass through the input
@@ -1911,8 +1923,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         }
         const Vector3 target = (Vector3)tryGetValue(node->GetBox(2), Vector3::Zero);
         const Vector3 jointTarget = (Vector3)tryGetValue(node->GetBox(3), Vector3::Zero);
-        const bool allowStretching = (bool)tryGetValue(node->GetBox(5), node->Values[2]);
-        const float maxStretchScale = (float)tryGetValue(node->GetBox(6), node->Values[3]);
+        const bool allowStretching = tryGetValue<bool>(node->GetBox(5), node->Values[2]);
+        const float maxStretchScale = tryGetValue<float>(node->GetBox(6), node->Values[3]);
         weight = Math::Saturate(weight);
 
         // Solve IK
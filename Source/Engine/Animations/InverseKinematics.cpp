@@ -1,6 +1,236 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "InverseKinematics.h"
+#include "Engine/Core/SIMD.h"
+
+namespace
+{
+    // Vectors of 4 chains in structure-of-arrays layout
+    struct Vector3x4
+    {
+        SimdVector4 X, Y, Z;
+    };
+
+    // Rotations of 4 chains in structure-of-arrays layout
+    struct Quaternion4
+    {
+        SimdVector4 X, Y, Z, W;
+    };
+
+    FORCE_INLINE Vector3x4 LoadVectors(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d)
+    {
+        Vector3x4 v;
+        v.X = SIMD::Load((float)a.X, (float)b.X, (float)c.X, (float)d.X);
+        v.Y = SIMD::Load((float)a.Y, (float)b.Y, (float)c.Y, (float)d.Y);
+        v.Z = SIMD::Load((float)a.Z, (float)b.Z, (float)c.Z, (float)d.Z);
+        return v;
+    }
+
+    FORCE_INLINE void StoreVectors(const Vector3x4& v, Vector3& a, Vector3& b, Vector3& c, Vector3& d)
+    {
+        float x[4], y[4], z[4];
+        SIMD::StoreUnaligned(x, v.X);
+        SIMD::StoreUnaligned(y, v.Y);
+        SIMD::StoreUnaligned(z, v.Z);
+        a = Vector3(x[0], y[0], z[0]);
+        b = Vector3(x[1], y[1], z[1]);
+        c = Vector3(x[2], y[2], z[2]);
+        d = Vector3(x[3], y[3], z[3]);
+    }
+
+    FORCE_INLINE Quaternion4 LoadRotations(const Quaternion& a, const Quaternion& b, const Quaternion& c, const Quaternion& d)
+    {
+        Quaternion4 q;
+        q.X = SIMD::LoadUnaligned(&a);
+        q.Y = SIMD::LoadUnaligned(&b);
+        q.Z = SIMD::LoadUnaligned(&c);
+        q.W = SIMD::LoadUnaligned(&d);
+        SIMD::Transpose(q.X, q.Y, q.Z, q.W);
+        return q;
+    }
+
+    FORCE_INLINE void StoreRotations(Quaternion4 q, Quaternion& a, Quaternion& b, Quaternion& c, Quaternion& d)
+    {
+        SIMD::Transpose(q.X, q.Y, q.Z, q.W);
+        SIMD::StoreUnaligned(&a, q.X);
+        SIMD::StoreUnaligned(&b, q.Y);
+        SIMD::StoreUnaligned(&c, q.Z);
+        SIMD::StoreUnaligned(&d, q.W);
+    }
+
+    FORCE_INLINE SimdVector4 Abs(SimdVector4 a)
+    {
+        return SIMD::Max(a, SIMD::Sub(SIMD::Splat(0.0f), a));
+    }
+
+    FORCE_INLINE Vector3x4 Add(const Vector3x4& a, const Vector3x4& b)
+    {
+        return { SIMD::Add(a.X, b.X), SIMD::Add(a.Y, b.Y), SIMD::Add(a.Z, b.Z) };
+    }
+
+    FORCE_INLINE Vector3x4 Sub(const Vector3x4& a, const Vector3x4& b)
+    {
+        return { SIMD::Sub(a.X, b.X), SIMD::Sub(a.Y, b.Y), SIMD::Sub(a.Z, b.Z) };
+    }
+
+    FORCE_INLINE Vector3x4 Mul(const Vector3x4& a, SimdVector4 b)
+    {
+        return { SIMD::Mul(a.X, b), SIMD::Mul(a.Y, b), SIMD::Mul(a.Z, b) };
+    }
+
+    FORCE_INLINE Vector3x4 Select(SimdVector4 mask, const Vector3x4& a, const Vector3x4& b)
+    {
+        return { SIMD::Select(mask, a.X, b.X), SIMD::Select(mask, a.Y, b.Y), SIMD::Select(mask, a.Z, b.Z) };
+    }
+
+    FORCE_INLINE SimdVector4 Dot(const Vector3x4& a, const Vector3x4& b)
+    {
+        return SIMD::Add(SIMD::Add(SIMD::Mul(a.X, b.X), SIMD::Mul(a.Y, b.Y)), SIMD::Mul(a.Z, b.Z));
+    }
+
+    FORCE_INLINE Vector3x4 Cross(const Vector3x4& a, const Vector3x4& b)
+    {
+        return
+        {
+            SIMD::Sub(SIMD::Mul(a.Y, b.Z), SIMD::Mul(a.Z, b.Y)),
+            SIMD::Sub(SIMD::Mul(a.Z, b.X), SIMD::Mul(a.X, b.Z)),
+            SIMD::Sub(SIMD::Mul(a.X, b.Y), SIMD::Mul(a.Y, b.X)),
+        };
+    }
+
+    FORCE_INLINE Vector3x4 Normalize(const Vector3x4& v)
+    {
+        // Matches Vector3::Normalize (too short vectors are left unchanged)
+        const SimdVector4 lengthSqr = Dot(v, v);
+        const SimdVector4 one = SIMD::Splat(1.0f);
+        const SimdVector4 invLength = SIMD::Select(SIMD::Less(lengthSqr, SIMD::Splat(ZeroTolerance * ZeroTolerance)), one, SIMD::Div(one, SIMD::Sqrt(lengthSqr)));
+        return Mul(v, invLength);
+    }
+
+    FORCE_INLINE Quaternion4 Multiply(const Quaternion4& l, const Quaternion4& r)
+    {
+        // Matches Quaternion::Multiply
+        const SimdVector4 a = SIMD::Sub(SIMD::Mul(l.Y, r.Z), SIMD::Mul(l.Z, r.Y));
+        const SimdVector4 b = SIMD::Sub(SIMD::Mul(l.Z, r.X), SIMD::Mul(l.X, r.Z));
+        const SimdVector4 c = SIMD::Sub(SIMD::Mul(l.X, r.Y), SIMD::Mul(l.Y, r.X));
+        const SimdVector4 d = SIMD::Add(SIMD::Add(SIMD::Mul(l.X, r.X), SIMD::Mul(l.Y, r.Y)), SIMD::Mul(l.Z, r.Z));
+        Quaternion4 q;
+        q.X = SIMD::Add(SIMD::Add(SIMD::Mul(l.X, r.W), SIMD::Mul(r.X, l.W)), a);
+        q.Y = SIMD::Add(SIMD::Add(SIMD::Mul(l.Y, r.W), SIMD::Mul(r.Y, l.W)), b);
+        q.Z = SIMD::Add(SIMD::Add(SIMD::Mul(l.Z, r.W), SIMD::Mul(r.Z, l.W)), c);
+        q.W = SIMD::Sub(SIMD::Mul(l.W, r.W), d);
+        return q;
+    }
+
+    FORCE_INLINE Quaternion4 FindBetween(const Vector3x4& from, const Vector3x4& to)
+    {
+        // Matches Quaternion::FindBetween
+        const SimdVector4 zero = SIMD::Splat(0.0f);
+        const SimdVector4 one = SIMD::Splat(1.0f);
+        const SimdVector4 normFromNormTo = SIMD::Sqrt(SIMD::Mul(Dot(from, from), Dot(to, to)));
+        const SimdVector4 w = SIMD::Add(normFromNormTo, Dot(from, to));
+        const Vector3x4 cross = Cross(from, to);
+        const SimdVector4 opposite = SIMD::Less(w, SIMD::Mul(normFromNormTo, SIMD::Splat(1.e-6f)));
+        const SimdVector4 useX = SIMD::Less(Abs(from.Z), Abs(from.X));
+        Quaternion4 q;
+        q.X = SIMD::Select(opposite, SIMD::Select(useX, SIMD::Sub(zero, from.Y), zero), cross.X);
+        q.Y = SIMD::Select(opposite, SIMD::Select(useX, from.X, SIMD::Sub(zero, from.Z)), cross.Y);
+        q.Z = SIMD::Select(opposite, SIMD::Select(useX, zero, from.Y), cross.Z);
+        q.W = SIMD::Select(opposite, zero, w);
+
+        // Normalize (too short quaternions are left unchanged) and use identity for degenerated input vectors
+        const SimdVector4 lengthSqr = SIMD::Add(SIMD::Add(SIMD::Mul(q.X, q.X), SIMD::Mul(q.Y, q.Y)), SIMD::Add(SIMD::Mul(q.Z, q.Z), SIMD::Mul(q.W, q.W)));
+        const SimdVector4 invLength = SIMD::Select(SIMD::Less(lengthSqr, SIMD::Splat(ZeroTolerance * ZeroTolerance)), one, SIMD::Div(one, SIMD::Sqrt(lengthSqr)));
+        const SimdVector4 identity = SIMD::Less(normFromNormTo, SIMD::Splat(ZeroTolerance));
+        q.X = SIMD::Select(identity, zero, SIMD::Mul(q.X, invLength));
+        q.Y = SIMD::Select(identity, zero, SIMD::Mul(q.Y, invLength));
+        q.Z = SIMD::Select(identity, zero, SIMD::Mul(q.Z, invLength));
+        q.W = SIMD::Select(identity, one, SIMD::Mul(q.W, invLength));
+        return q;
+    }
+
+    void SolveTwoBoneIK4(InverseKinematics::TwoBoneChain* c, bool allowStretching, float maxStretchScale)
+    {
+        const SimdVector4 zero = SIMD::Splat(0.0f);
+        const SimdVector4 one = SIMD::Splat(1.0f);
+        const SimdVector4 epsilon = SIMD::Splat(ZeroTolerance);
+        const SimdVector4 epsilonSqr = SIMD::Splat(ZeroTolerance * ZeroTolerance);
+        const Vector3x4 rootPos = LoadVectors(c[0].RootNode->Translation, c[1].RootNode->Translation, c[2].RootNode->Translation, c[3].RootNode->Translation);
+        const Vector3x4 jointPos = LoadVectors(c[0].JointNode->Translation, c[1].JointNode->Translation, c[2].JointNode->Translation, c[3].JointNode->Translation);
+        const Vector3x4 endPos = LoadVectors(c[0].TargetNode->Translation, c[1].TargetNode->Translation, c[2].TargetNode->Translation, c[3].TargetNode->Translation);
+        const Vector3x4 target = LoadVectors(c[0].Target, c[1].Target, c[2].Target, c[3].Target);
+        const Vector3x4 jointTarget = LoadVectors(c[0].JointTarget, c[1].JointTarget, c[2].JointTarget, c[3].JointTarget);
+
+        const Vector3x4 lowerLimb = Sub(endPos, jointPos);
+        const Vector3x4 upperLimb = Sub(jointPos, rootPos);
+        SimdVector4 lowerLimbLength = SIMD::Sqrt(Dot(lowerLimb, lowerLimb));
+        SimdVector4 upperLimbLength = SIMD::Sqrt(Dot(upperLimb, upperLimb));
+        const Vector3x4 desiredDelta = Sub(target, rootPos);
+        const SimdVector4 desiredLengthRaw = SIMD::Sqrt(Dot(desiredDelta, desiredDelta));
+        const SimdVector4 desiredTooShort = SIMD::Less(desiredLengthRaw, epsilon);
+        const SimdVector4 desiredLength = SIMD::Max(desiredLengthRaw, epsilon);
+        SimdVector4 limbLengthLimit = SIMD::Add(lowerLimbLength, upperLimbLength);
+        const Vector3x4 desiredDir = Select(desiredTooShort, { one, zero, zero }, Mul(desiredDelta, SIMD::Div(one, desiredLength)));
+
+        // Bend direction
+        const Vector3x4 jointTargetDelta = Sub(jointTarget, rootPos);
+        const Vector3x4 jointPlaneNormal = Cross(desiredDir, jointTargetDelta);
+        Vector3x4 jointBendDir = Normalize(Sub(jointTargetDelta, Mul(desiredDir, Dot(jointTargetDelta, desiredDir))));
+        {
+            // Matches Vector3::FindBestAxisVectors for the direction parallel to the joint target
+            const SimdVector4 absX = Abs(desiredDir.X), absY = Abs(desiredDir.Y), absZ = Abs(desiredDir.Z);
+            const SimdVector4 useX = SIMD::Less(SIMD::Max(absX, absY), absZ);
+            Vector3x4 firstAxis = { SIMD::Select(useX, one, zero), zero, SIMD::Select(useX, zero, one) };
+            firstAxis = Normalize(Sub(firstAxis, Mul(desiredDir, Dot(firstAxis, desiredDir))));
+            jointBendDir = Select(SIMD::Less(Dot(jointPlaneNormal, jointPlaneNormal), epsilonSqr), Cross(firstAxis, desiredDir), jointBendDir);
+        }
+        jointBendDir = Select(SIMD::Less(Dot(jointTargetDelta, jointTargetDelta), epsilonSqr), { zero, zero, one }, jointBendDir);
+
+        if (allowStretching)
+        {
+            const float initialStretchRatio = 1.0f;
+            const float range = maxStretchScale - initialStretchRatio;
+            if (range > ZeroTolerance)
+            {
+                const SimdVector4 reachRatio = SIMD::Div(desiredLength, SIMD::Max(limbLengthLimit, epsilon));
+                const SimdVector4 saturated = SIMD::Min(SIMD::Max(SIMD::Mul(SIMD::Sub(reachRatio, SIMD::Splat(initialStretchRatio)), SIMD::Splat(1.0f / range)), zero), one);
+                SimdVector4 scalingFactor = SIMD::Mul(SIMD::Splat(maxStretchScale - 1.0f), saturated);
+                scalingFactor = SIMD::Select(SIMD::Less(epsilon, scalingFactor), scalingFactor, zero);
+                scalingFactor = SIMD::Select(SIMD::Less(epsilon, limbLengthLimit), scalingFactor, zero);
+                const SimdVector4 scale = SIMD::Add(one, scalingFactor);
+                lowerLimbLength = SIMD::Mul(lowerLimbLength, scale);
+                upperLimbLength = SIMD::Mul(upperLimbLength, scale);
+                limbLengthLimit = SIMD::Mul(limbLengthLimit, scale);
+            }
+        }
+
+        // Out of reach: straighten the chain towards the target
+        const SimdVector4 canReach = SIMD::Less(desiredLength, limbLengthLimit);
+        const Vector3x4 straightEndPos = Add(rootPos, Mul(desiredDir, limbLengthLimit));
+        const Vector3x4 straightJointPos = Add(rootPos, Mul(desiredDir, upperLimbLength));
+
+        // In reach: place the joint using law of cosines (projected distance is upper*cos and distance from line is upper*sin of the same angle)
+        const SimdVector4 twoAb = SIMD::Mul(SIMD::Splat(2.0f), SIMD::Mul(upperLimbLength, desiredLength));
+        const SimdVector4 cosAngleRaw = SIMD::Div(SIMD::Sub(SIMD::Add(SIMD::Mul(upperLimbLength, upperLimbLength), SIMD::Mul(desiredLength, desiredLength)), SIMD::Mul(lowerLimbLength, lowerLimbLength)), SIMD::Max(twoAb, epsilon));
+        const SimdVector4 cosAngle = SIMD::Select(SIMD::Less(epsilon, twoAb), SIMD::Min(SIMD::Max(cosAngleRaw, SIMD::Splat(-1.0f)), one), zero);
+        const SimdVector4 jointLineDist = SIMD::Mul(upperLimbLength, SIMD::Sqrt(SIMD::Max(SIMD::Sub(one, SIMD::Mul(cosAngle, cosAngle)), zero)));
+        const SimdVector4 projJointDist = SIMD::Mul(upperLimbLength, cosAngle);
+        const Vector3x4 bentJointPos = Add(rootPos, Add(Mul(desiredDir, projJointDist), Mul(jointBendDir, jointLineDist)));
+
+        const Vector3x4 resultEndPos = Select(canReach, target, straightEndPos);
+        const Vector3x4 resultJointPos = Select(canReach, bentJointPos, straightJointPos);
+
+        // Rotate bones
+        const Quaternion4 rootDelta = FindBetween(Normalize(upperLimb), Normalize(Sub(resultJointPos, rootPos)));
+        const Quaternion4 jointDelta = FindBetween(Normalize(lowerLimb), Normalize(Sub(resultEndPos, resultJointPos)));
+        const Quaternion4 rootRotation = Multiply(rootDelta, LoadRotations(c[0].RootNode->Orientation, c[1].RootNode->Orientation, c[2].RootNode->Orientation, c[3].RootNode->Orientation));
+        const Quaternion4 jointRotation = Multiply(jointDelta, LoadRotations(c[0].JointNode->Orientation, c[1].JointNode->Orientation, c[2].JointNode->Orientation, c[3].JointNode->Orientation));
+        StoreRotations(rootRotation, c[0].RootNode->Orientation, c[1].RootNode->Orientation, c[2].RootNode->Orientation, c[3].RootNode->Orientation);
+        StoreRotations(jointRotation, c[0].JointNode->Orientation, c[1].JointNode->Orientation, c[2].JointNode->Orientation, c[3].JointNode->Orientation);
+        StoreVectors(resultJointPos, c[0].JointNode->Translation, c[1].JointNode->Translation, c[2].JointNode->Translation, c[3].JointNode->Translation);
+        StoreVectors(resultEndPos, c[0].TargetNode->Translation, c[1].TargetNode->Translation, c[2].TargetNode->Translation, c[3].TargetNode->Translation);
+    }
+}
 
 void InverseKinematics::SolveAimIK(const Transform& node, const Vector3& target, Quaternion& outNodeCorrection)
 {
@@ -110,3 +340,31 @@ void InverseKinematics::SolveTwoBoneIK(Transform& rootNode, Transform& jointNode
 
     targetNode.Translation = resultEndPos;
 }
+
+void InverseKinematics::SolveAimIK(const Transform* nodes, const Vector3* targets, Quaternion* outNodeCorrections, int32 count)
+{
+    int32 i = 0;
+    const SimdVector4 zero = SIMD::Splat(0.0f);
+    const Vector3x4 forward = { zero, zero, SIMD::Splat(1.0f) };
+    for (; i + 4 <= count; i += 4)
+    {
+        const Vector3x4 position = LoadVectors(nodes[i].Translation, nodes[i + 1].Translation, nodes[i + 2].Translation, nodes[i + 3].Translation);
+        const Vector3x4 target = LoadVectors(targets[i], targets[i + 1], targets[i + 2], targets[i + 3]);
+        const Quaternion4 correction = FindBetween(forward, Normalize(Sub(target, position)));
+        StoreRotations(correction, outNodeCorrections[i], outNodeCorrections[i + 1], outNodeCorrections[i + 2], outNodeCorrections[i + 3]);
+    }
+    for (; i < count; i++)
+        SolveAimIK(nodes[i], targets[i], outNodeCorrections[i]);
+}
+
+void InverseKinematics::SolveTwoBoneIK(TwoBoneChain* chains, int32 count, bool allowStretching, float maxStretchScale)
+{
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        SolveTwoBoneIK4(chains + i, allowStretching, maxStretchScale);
+    for (; i < count; i++)
+    {
+        auto& chain = chains[i];
+        SolveTwoBoneIK(*chain.RootNode, *chain.JointNode, *chain.TargetNode, chain.Target, chain.JointTarget, allowStretching, maxStretchScale);
+    }
+}
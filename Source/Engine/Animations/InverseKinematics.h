@@ -11,6 +11,24 @@
 /// </summary>
 class FLAXENGINE_API InverseKinematics
 {
+public:
+    /// <summary>
+    /// The three nodes chain description for the batched two bone IK solver.
+    /// </summary>
+    struct TwoBoneChain
+    {
+        /// <summary>The start node transformation (in model space).</summary>
+        Transform* RootNode;
+        /// <summary>The middle node transformation (in model space).</summary>
+        Transform* JointNode;
+        /// <summary>The end node transformation (in model space).</summary>
+        Transform* TargetNode;
+        /// <summary>The target position of the end node to reach (in model space).</summary>
+        Vector3 Target;
+        /// <summary>The target position of the middle node to face into (in model space).</summary>
+        Vector3 JointTarget;
+    };
+
 public:
     /// <summary>
     /// Rotates a node so it aims at a target. Solves the transformation (rotation) that needs to be applied to the node such that a provided forward vector (in node local space) aims at the target position (in skeleton model space).
@@ -31,4 +49,22 @@ class FLAXENGINE_API InverseKinematics
     /// <param name="allowStretching">True if allow bones stretching, otherwise bone lengths will be preserved when trying to reach the target.</param>
     /// <param name="maxStretchScale">The maximum scale when stretching bones. Used only if allowStretching is true.</param>
     static void SolveTwoBoneIK(Transform& rootNode, Transform& jointNode, Transform& targetNode, const Vector3& target, const Vector3& jointTarget, bool allowStretching = false, float maxStretchScale = 1.5f);
+
+    /// <summary>
+    /// Solves the aim IK for many nodes at once (processed in blocks of 4 with SIMD). Matches SolveAimIK called for every node.
+    /// </summary>
+    /// <param name="nodes">The nodes transformations (in model space).</param>
+    /// <param name="targets">The target positions to aim at (in model space).</param>
+    /// <param name="outNodeCorrections">The calculated output nodes corrections (in model space).</param>
+    /// <param name="count">The amount of the nodes.</param>
+    static void SolveAimIK(const Transform* nodes, const Vector3* targets, Quaternion* outNodeCorrections, int32 count);
+
+    /// <summary>
+    /// Solves the two bone IK for many chains at once (processed in blocks of 4 with SIMD). Use it to solve the same kind of IK for many characters in a single pass (eg. foot placement).
+    /// </summary>
+    /// <param name="chains">The chains to solve. Nodes transformations are modified in-place.</param>
+    /// <param name="count">The amount of the chains.</param>
+    /// <param name="allowStretching">True if allow bones stretching, otherwise bone lengths will be preserved when trying to reach the target.</param>
+    /// <param name="maxStretchScale">The maximum scale when stretching bones. Used only if allowStretching is true.</param>
+    static void SolveTwoBoneIK(TwoBoneChain* chains, int32 count, bool allowStretching = false, float maxStretchScale = 1.5f);
 };
@@ -23,12 +23,14 @@ public override void Setup(BuildOptions options)
         bool useNone = true;
         bool useOpenAL = false;
         bool useXAudio2 = false;
+        bool useMixer = false;
 
         switch (options.Platform.Target)
         {
         case TargetPlatform.Windows:
             useNone = true;
             useOpenAL = true;
+            useMixer = true;
             //useXAudio2 = true;
             break;
         case TargetPlatform.XboxOne:
@@ -38,6 +40,7 @@ public override void Setup(BuildOptions options)
             break;
         case TargetPlatform.Linux:
             useOpenAL = true;
+            useMixer = true;
             break;
         case TargetPlatform.PS4:
             options.SourcePaths.Add(Path.Combine(Globals.EngineRoot, "Source", "Platforms", "PS4", "Engine", "Audio"));
@@ -56,6 +59,7 @@ public override void Setup(BuildOptions options)
             break;
         case TargetPlatform.Mac:
             useOpenAL = true;
+            useMixer = true;
             break;
         default: throw new InvalidPlatformException(options.Platform.Target);
         }
@@ -112,6 +116,13 @@ public override void Setup(BuildOptions options)
             }
         }
 
+        if (useMixer)
+        {
+            // Native mixer (outputs the final mix via the platform audio backend)
+            options.SourcePaths.Add(Path.Combine(FolderPath, "Mixer"));
+            options.CompileEnv.PreprocessorDefinitions.Add("AUDIO_API_MIXER");
+        }
+
         options.PrivateDependencies.Add("AudioTool");
     }
 
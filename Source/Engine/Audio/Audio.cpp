@@ -3,11 +3,17 @@
 #include "Audio.h"
 #include "AudioBackend.h"
 #include "AudioSettings.h"
+#include "AudioListener.h"
+#include "AudioSource.h"
+#include "AudioStreamingVoice.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Engine/Time.h"
 #include "FlaxEngine.Gen.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Level/Level.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/CommandLine.h"
 #include "Engine/Core/Log.h"
@@ -30,6 +36,9 @@
 #if AUDIO_API_XAUDIO2
 #include "XAudio2/AudioBackendXAudio2.h"
 #endif
+#if AUDIO_API_MIXER
+#include "Mixer/AudioBackendMixer.h"
+#endif
 
 const Char* ToString(AudioFormat value)
 {
@@ -57,6 +66,38 @@ namespace
     float Volume = 1.0f;
     int32 ActiveDeviceIndex = -1;
     bool MuteOnFocusLoss = true;
+    int32 MaxVoices = 64;
+    float VirtualizationThreshold = 0.001f;
+
+    struct VoiceCandidate
+    {
+        AudioSource* Source;
+        float Score;
+
+        static bool Compare(const VoiceCandidate& a, const VoiceCandidate& b)
+        {
+            return a.Score > b.Score;
+        }
+    };
+
+    Array<VoiceCandidate> VoiceCandidates;
+
+    float GetAudibility(const AudioSource* source)
+    {
+        float volume = source->GetVolume();
+        if (source->Clip->Is3D() && Audio::Listeners.HasItems())
+        {
+            // Estimate the distance attenuation (matches the inverse clamped distance model)
+            Real distanceSq = MAX_Real;
+            const Vector3 position = source->GetPosition();
+            for (const AudioListener* listener : Audio::Listeners)
+                distanceSq = Math::Min(distanceSq, Vector3::DistanceSquared(position, listener->GetPosition()));
+            const float minDistance = Math::Max(source->GetMinDistance(), ZeroTolerance);
+            const float distance = Math::Max((float)Math::Sqrt(distanceSq), minDistance);
+            volume *= minDistance / (minDistance + source->GetAttenuation() * (distance - minDistance));
+        }
+        return volume;
+    }
 }
 
 class AudioService : public EngineService
@@ -66,11 +107,18 @@ class AudioService : public EngineService
     AudioService()
         : EngineService(TEXT("Audio"), -50)
     {
+#if !AUDIO_API_XAUDIO2
+        // XAudio2 requires COM to be initialized on the calling thread (done only for the main thread)
+        ParallelInit = true;
+#endif
     }
 
     bool Init() override;
     void Update() override;
     void Dispose() override;
+
+private:
+    void UpdateVoices();
 };
 
 AudioService AudioServiceInstance;
@@ -91,6 +139,10 @@ namespace
 void AudioSettings::Apply()
 {
     ::MuteOnFocusLoss = MuteOnFocusLoss;
+    ::MaxVoices = MaxVoices;
+    ::VirtualizationThreshold = VirtualizationThreshold;
+    AudioStreamingVoice::Enabled = UseStreamingVoices;
+    AudioStreamingVoice::PrefetchTime = StreamingPrefetchTime;
 }
 
 AudioDevice* Audio::GetActiveDevice()
@@ -175,6 +227,51 @@ void Audio::OnRemoveSource(AudioSource* source)
     }
 }
 
+void AudioService::UpdateVoices()
+{
+    PROFILE_CPU();
+    const float dt = Time::Update.UnscaledDeltaTime.GetTotalSeconds();
+
+    // Collect the playing sources
+    VoiceCandidates.Clear();
+    for (AudioSource* source : Audio::Sources)
+    {
+        if (source->IsVirtual())
+            source->UpdateVirtual(dt);
+        if (source->GetState() != AudioSource::States::Playing || !source->Clip || !source->Clip->IsLoaded())
+            continue;
+        VoiceCandidates.Add({ source, GetAudibility(source) });
+    }
+
+    // Pick the most important sources to use the real voices, virtualize the others
+    for (auto& e : VoiceCandidates)
+    {
+        if (e.Score < VirtualizationThreshold)
+            e.Score = 0.0f;
+        else
+            e.Score *= e.Source->Priority;
+
+        // Prefer sources that already play to reduce voices swapping around the limit
+        if (!e.Source->IsVirtual())
+            e.Score *= 1.1f;
+    }
+    const int32 maxVoices = MaxVoices > 0 ? MaxVoices : MAX_int32;
+    if (VoiceCandidates.Count() > maxVoices)
+        Sorting::QuickSort(VoiceCandidates.Get(), VoiceCandidates.Count(), &VoiceCandidate::Compare);
+    for (int32 i = 0; i < VoiceCandidates.Count(); i++)
+    {
+        const auto& e = VoiceCandidates[i];
+        const bool isVirtual = i >= maxVoices || e.Score <= 0.0f;
+        if (isVirtual != e.Source->IsVirtual())
+        {
+            if (isVirtual)
+                e.Source->Virtualize();
+            else
+                e.Source->Devirtualize();
+        }
+    }
+}
+
 bool AudioService::Init()
 {
     PROFILE_CPU_NAMED("Audio.Init");
@@ -187,6 +284,10 @@ bool AudioService::Init()
     if (mute)
         backend = New<AudioBackendNone>();
 #endif
+#if AUDIO_API_MIXER
+    if (!backend && settings->UseNativeMixer)
+        backend = New<AudioBackendMixer>();
+#endif
 #if AUDIO_API_PS4
     if (!backend)
         backend = New<AudioBackendPS4>();
@@ -237,6 +338,7 @@ bool AudioService::Init()
 void AudioService::Update()
 {
     PROFILE_CPU_NAMED("Audio.Update");
+    PROFILE_MEM(Audio);
 
     // Update the master volume
     float masterVolume = MasterVolume;
@@ -251,6 +353,8 @@ void AudioService::Update()
         AudioBackend::SetVolume(masterVolume);
     }
 
+    UpdateVoices();
+
     AudioBackend::Update();
 }
 
@@ -4,9 +4,11 @@
 #include "Audio.h"
 #include "AudioSource.h"
 #include "AudioBackend.h"
+#include "AudioStreamingVoice.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Content/Upgraders/AudioClipUpgrader.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
 #include "Engine/Scripting/ManagedCLR/MUtils.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Serialization/MemoryReadStream.h"
@@ -322,9 +324,11 @@ Task* AudioClip::CreateStreamingTask(int32 residency)
         const int32 idx = StreamingQueue[i];
         if (Buffers[idx] == AUDIO_BUFFER_ID_INVALID)
         {
-            const auto task = (Task*)RequestChunkDataAsync(idx);
+            const auto task = RequestChunkDataAsync(idx);
             if (task)
             {
+                // Audio playback stalls on missing data so don't wait behind other resources streaming
+                task->SetPriority(ContentLoadTask::Priority::High);
                 if (result)
                     result->ContinueWith(task);
                 else
@@ -466,6 +470,7 @@ Asset::LoadResult AudioClip::load()
 
 void AudioClip::unload(bool isReloading)
 {
+    AudioStreamingVoice::OnClipUnloading(this);
     StopStreaming();
     StreamingQueue.Clear();
     if (Buffers.HasItems())
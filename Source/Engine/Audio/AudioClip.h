@@ -51,7 +51,8 @@ DECLARE_BINARY_ASSET_HEADER(AudioClip, 2);
         /// </summary>
         /// <param name="asset">Parent asset</param>
         StreamingTask(AudioClip* asset)
-            : _asset(asset)
+            : ThreadPoolTask(ThreadPoolTaskPriority::Critical)
+            , _asset(asset)
             , _dataLock(asset->Storage->Lock())
         {
         }
@@ -4,6 +4,47 @@
 
 #include "Engine/Core/Config/Settings.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/ISerializable.h"
+
+/// <summary>
+/// The native audio mixer bus. Mixes the audio sources routed to it, applies its effects and sends the result to the parent bus.
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API AudioMixerBus : ISerializable
+{
+    API_AUTO_SERIALIZATION();
+    DECLARE_SCRIPTING_TYPE_MINIMAL(AudioMixerBus);
+
+    /// <summary>
+    /// The bus name (for the user).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(0)")
+    String Name;
+
+    /// <summary>
+    /// The bus volume, in [0, 1] range.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), DefaultValue(1.0f), Limit(0, 1, 0.01f)")
+    float Volume = 1.0f;
+
+    /// <summary>
+    /// The index of the parent bus (in AudioSettings.MixerBuses) that receives this bus output. Use -1 for the master bus. Parent bus has to be placed before its children.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), DefaultValue(-1), Limit(-1)")
+    int32 Parent = -1;
+
+    /// <summary>
+    /// The cutoff frequency (in Hz) of the low-pass filter applied to the bus output. Use 0 to disable filtering.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), DefaultValue(0.0f), Limit(0, 22000, 10.0f)")
+    float LowPassFrequency = 0.0f;
+
+    /// <summary>
+    /// The amount of the bus output sent to the reverb effect, in [0, 1] range.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), DefaultValue(0.0f), Limit(0, 1, 0.01f)")
+    float ReverbSend = 0.0f;
+};
 
 /// <summary>
 /// Audio settings container.
@@ -31,6 +72,54 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(AudioSettings);
     API_FIELD(Attributes="EditorOrder(200), DefaultValue(true), EditorDisplay(\"General\", \"Mute On Focus Loss\")")
     bool MuteOnFocusLoss = true;
 
+    /// <summary>
+    /// The maximum amount of the audio sources played by the audio backend at once (real voices). Other playing sources are virtualized (their playback time advances but they are not mixed) and get promoted back by their priority and audibility. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(300), DefaultValue(64), Limit(0), EditorDisplay(\"Voices\")")
+    int32 MaxVoices = 64;
+
+    /// <summary>
+    /// The audibility (volume after distance attenuation) below which the playing audio sources are virtualized.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(310), DefaultValue(0.001f), Limit(0, 1, 0.0001f), EditorDisplay(\"Voices\")")
+    float VirtualizationThreshold = 0.001f;
+
+    /// <summary>
+    /// If checked, streamable audio clips are decoded incrementally on a dedicated audio thread into a small ring of fixed-size buffers per playing source (constant memory usage). Otherwise, whole clip data chunks are decoded into the audio buffers by the content streaming.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(400), DefaultValue(true), EditorDisplay(\"Streaming\")")
+    bool UseStreamingVoices = true;
+
+    /// <summary>
+    /// The time (in seconds) before the streaming voice playback reaches the next clip data chunk to start loading it.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(410), DefaultValue(2.0f), Limit(0, 60, 0.1f), EditorDisplay(\"Streaming\")")
+    float StreamingPrefetchTime = 2.0f;
+
+    /// <summary>
+    /// If checked, the native engine audio mixer is used (if supported on the platform) instead of the platform audio backend mixing. All voices are mixed by the engine on a dedicated audio thread which gives predictable mixing cost and supports mixer buses with effects.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(500), DefaultValue(false), EditorDisplay(\"Mixer\", \"Use Native Mixer\")")
+    bool UseNativeMixer = false;
+
+    /// <summary>
+    /// The output sample rate (in Hz) of the native audio mixer.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(510), DefaultValue(48000), Limit(8000, 192000), EditorDisplay(\"Mixer\")")
+    int32 MixerSampleRate = 48000;
+
+    /// <summary>
+    /// The reverb effect decay (feedback amount) of the native audio mixer, in [0, 1) range.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(520), DefaultValue(0.7f), Limit(0, 0.98f, 0.01f), EditorDisplay(\"Mixer\")")
+    float MixerReverbDecay = 0.7f;
+
+    /// <summary>
+    /// The buses of the native audio mixer. Audio sources are routed to the bus via AudioSource.MixerBus.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(530), EditorDisplay(\"Mixer\")")
+    Array<AudioMixerBus> MixerBuses;
+
 public:
 
     /// <summary>
@@ -46,5 +135,13 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(AudioSettings);
         DESERIALIZE(DisableAudio);
         DESERIALIZE(DopplerFactor);
         DESERIALIZE(MuteOnFocusLoss);
+        DESERIALIZE(MaxVoices);
+        DESERIALIZE(VirtualizationThreshold);
+        DESERIALIZE(UseStreamingVoices);
+        DESERIALIZE(StreamingPrefetchTime);
+        DESERIALIZE(UseNativeMixer);
+        DESERIALIZE(MixerSampleRate);
+        DESERIALIZE(MixerReverbDecay);
+        DESERIALIZE(MixerBuses);
     }
 };
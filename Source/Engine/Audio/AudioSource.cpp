@@ -9,6 +9,7 @@
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "AudioBackend.h"
+#include "AudioStreamingVoice.h"
 #include "Audio.h"
 
 AudioSource::AudioSource(const SpawnParams& params)
@@ -65,6 +66,10 @@ void AudioSource::SetIsLooping(bool value)
     {
         AudioBackend::Source::IsLoopingChanged(this);
     }
+    if (_streamingVoice)
+    {
+        _streamingVoice->SetLooping(value);
+    }
 }
 
 void AudioSource::SetPlayOnStart(bool value)
@@ -114,12 +119,29 @@ void AudioSource::Play()
     _state = States::Playing;
     _isActuallyPlayingSth = false;
 
+    // Virtual source resumes playback when it gets a voice
+    if (_isVirtual)
+        return;
+
     // Don't block scripting if audio is not loaded or has missing streaming data
     if (!Clip->IsLoaded())
         return;
 
     // Audio clips with disabled streaming are controlled by audio source, otherwise streaming manager will play it
-    if (Clip->IsStreamable())
+    if (Clip->IsStreamable() && AudioStreamingVoice::Enabled)
+    {
+        if (state == States::Paused && _streamingVoice)
+        {
+            // Resume (otherwise the playback starts once the first voice block gets decoded)
+            if (_streamingVoice->GetQueuedBlocksCount() != 0)
+                PlayInternal();
+        }
+        else
+        {
+            StartStreamingVoice(0.0f);
+        }
+    }
+    else if (Clip->IsStreamable())
     {
         if (state == States::Paused)
         {
@@ -165,21 +187,33 @@ void AudioSource::Stop()
 
     _state = States::Stopped;
     _isActuallyPlayingSth = false;
+    _isVirtual = false;
+    _virtualTime = 0;
     _streamingFirstChunk = 0;
 
     if (SourceIDs.HasItems())
         AudioBackend::Source::Stop(this);
+    StopStreamingVoice();
 }
 
 float AudioSource::GetTime() const
 {
+    if (_isVirtual)
+        return _virtualTime;
     if (_state == States::Stopped || SourceIDs.IsEmpty())
         return 0.0f;
 
     float time = AudioBackend::Source::GetCurrentBufferTime(this);
     ASSERT(time >= 0.0f && time <= Clip->GetLength());
 
-    if (UseStreaming())
+    if (_streamingVoice)
+    {
+        // Apply time offset to the currently played voice block
+        int32 numProcessedBuffers = 0;
+        AudioBackend::Source::GetProcessedBuffersCount(const_cast<AudioSource*>(this), numProcessedBuffers);
+        time += _streamingVoice->GetQueuedBlockStartTime(numProcessedBuffers);
+    }
+    else if (UseStreaming())
     {
         // Apply time offset to the first streaming buffer binded to the source including the already queued buffers
         int32 numProcessedBuffers = 0;
@@ -196,6 +230,22 @@ void AudioSource::SetTime(float time)
 {
     if (_state == States::Stopped)
         return;
+    if (_isVirtual)
+    {
+        _virtualTime = Math::Clamp(time, 0.0f, Clip ? Clip->GetLength() : 0.0f);
+        return;
+    }
+
+    if (_streamingVoice)
+    {
+        // Restart the voice decoding from the new position (audio source resumes playback once the first block gets decoded)
+        if (SourceIDs.HasItems())
+            AudioBackend::Source::Stop(this);
+        _isActuallyPlayingSth = false;
+        StopStreamingVoice();
+        StartStreamingVoice(Math::Clamp(time, 0.0f, Clip->GetLength()));
+        return;
+    }
 
     const bool isActuallyPlayingSth = _isActuallyPlayingSth;
     const auto state = _state;
@@ -262,9 +312,14 @@ void AudioSource::OnClipLoaded()
     AudioBackend::Source::ClipLoaded(this);
 
     // Start playing if source was waiting for the clip to load
-    if (SourceIDs.HasItems() && _state == States::Playing && !_isActuallyPlayingSth)
+    if (SourceIDs.HasItems() && _state == States::Playing && !_isActuallyPlayingSth && !_isVirtual)
     {
-        if (Clip->IsStreamable())
+        if (Clip->IsStreamable() && AudioStreamingVoice::Enabled)
+        {
+            if (!_streamingVoice)
+                StartStreamingVoice(0.0f);
+        }
+        else if (Clip->IsStreamable())
         {
             // Request faster streaming update
             Clip->RequestStreamingUpdate();
@@ -313,6 +368,94 @@ void AudioSource::PlayInternal()
     _isActuallyPlayingSth = true;
 }
 
+void AudioSource::StartStreamingVoice(float time)
+{
+    ASSERT(!_streamingVoice && UseStreaming());
+    _streamingVoice = AudioStreamingVoice::Create(Clip.Get(), time, _loop);
+}
+
+void AudioSource::StopStreamingVoice()
+{
+    if (_streamingVoice)
+    {
+        AudioStreamingVoice::Destroy(_streamingVoice);
+        _streamingVoice = nullptr;
+    }
+}
+
+void AudioSource::UpdateStreamingVoice()
+{
+    auto voice = _streamingVoice;
+
+    // Release the played blocks so the voice can decode the next ones
+    if (_isActuallyPlayingSth)
+    {
+        int32 numProcessedBuffers = 0;
+        AudioBackend::Source::GetProcessedBuffersCount(this, numProcessedBuffers);
+        if (numProcessedBuffers > 0)
+        {
+            AudioBackend::Source::DequeueProcessedBuffers(this);
+            voice->ReleaseBlocks(numProcessedBuffers);
+
+            // Backend stops the source once it runs out of the queued data so play it again after the decoding catches up
+            if (voice->GetQueuedBlocksCount() == 0)
+                _isActuallyPlayingSth = false;
+        }
+    }
+
+    // Submit the decoded blocks
+    voice->QueueBlocks(this);
+    if (voice->IsFinished())
+    {
+        Stop();
+        return;
+    }
+    if (_state == States::Playing && !_isActuallyPlayingSth && voice->GetQueuedBlocksCount() != 0)
+    {
+        PlayInternal();
+    }
+}
+
+void AudioSource::Virtualize()
+{
+    ASSERT(!_isVirtual && _state == States::Playing);
+    const float time = GetTime();
+
+    // Release the backend voice but keep the playing state
+    Stop();
+    _state = States::Playing;
+    _needToUpdateStreamingBuffers = false;
+    _isVirtual = true;
+    _virtualTime = time;
+}
+
+void AudioSource::Devirtualize()
+{
+    ASSERT(_isVirtual);
+    _isVirtual = false;
+
+    // Resume the backend playback from the virtual time
+    _savedState = _state;
+    _savedTime = _virtualTime;
+    _state = States::Stopped;
+    Restore();
+}
+
+void AudioSource::UpdateVirtual(float dt)
+{
+    if (_state != States::Playing)
+        return;
+    const float length = Clip ? Clip->GetLength() : 0.0f;
+    _virtualTime += dt * _pitch;
+    if (_virtualTime >= length)
+    {
+        if (_loop && length > ZeroTolerance)
+            _virtualTime = Math::Mod(_virtualTime, length);
+        else
+            Stop();
+    }
+}
+
 void AudioSource::Serialize(SerializeStream& stream, const void* otherObj)
 {
     // Base
@@ -327,6 +470,8 @@ void AudioSource::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(Attenuation, _attenuation);
     SERIALIZE_MEMBER(Loop, _loop);
     SERIALIZE_MEMBER(PlayOnStart, _playOnStart);
+    SERIALIZE(Priority);
+    SERIALIZE(MixerBus);
 }
 
 void AudioSource::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -341,6 +486,8 @@ void AudioSource::Deserialize(DeserializeStream& stream, ISerializeModifier* mod
     DESERIALIZE_MEMBER(Attenuation, _attenuation);
     DESERIALIZE_MEMBER(Loop, _loop);
     DESERIALIZE_MEMBER(PlayOnStart, _playOnStart);
+    DESERIALIZE(Priority);
+    DESERIALIZE(MixerBus);
 }
 
 bool AudioSource::HasContentLoaded() const
@@ -371,6 +518,11 @@ void AudioSource::Update()
     // Skip other update logic if it's not valid streamable source
     if (!UseStreaming() || SourceIDs.IsEmpty())
         return;
+    if (_streamingVoice)
+    {
+        UpdateStreamingVoice();
+        return;
+    }
     auto clip = Clip.Get();
     clip->Locker.Lock();
 
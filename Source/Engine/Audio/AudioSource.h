@@ -7,6 +7,8 @@
 #include "AudioClip.h"
 #include "Config.h"
 
+class AudioStreamingVoice;
+
 /// <summary>
 /// Represents a source for emitting audio. Audio can be played spatially (gun shot), or normally (music). Each audio source must have an AudioClip to play - back, and it can also have a position in the case of spatial(3D) audio.
 /// </summary>
@@ -19,6 +21,7 @@ class FLAXENGINE_API AudioSource : public Actor
     DECLARE_SCENE_OBJECT(AudioSource);
     friend class AudioStreamingHandler;
     friend class AudioClip;
+    friend class AudioService;
 public:
     /// <summary>
     /// Valid states in which AudioSource can be in.
@@ -53,11 +56,14 @@ class FLAXENGINE_API AudioSource : public Actor
 
     bool _isActuallyPlayingSth = false;
     bool _needToUpdateStreamingBuffers = false;
+    bool _isVirtual = false;
+    float _virtualTime = 0;
     States _state = States::Stopped;
 
     States _savedState = States::Stopped;
     float _savedTime = 0;
     int32 _streamingFirstChunk = 0;
+    AudioStreamingVoice* _streamingVoice = nullptr;
 
 public:
     /// <summary>
@@ -164,6 +170,18 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     API_PROPERTY() void SetAttenuation(float value);
 
+    /// <summary>
+    /// The playback priority used by the voices limit. Sources with higher priority (multiplied by their audibility) are less likely to be virtualized.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(80), DefaultValue(1.0f), Limit(0, float.MaxValue, 0.1f), EditorDisplay(\"Audio Source\")")
+    float Priority = 1.0f;
+
+    /// <summary>
+    /// The index of the native audio mixer bus (see AudioSettings.MixerBuses) that this source is routed to. Use -1 for the master bus. Used only by the native audio mixer.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(90), DefaultValue(-1), Limit(-1), EditorDisplay(\"Audio Source\")")
+    int32 MixerBus = -1;
+
 public:
     /// <summary>
     /// Starts playing the currently assigned audio clip.
@@ -223,6 +241,14 @@ class FLAXENGINE_API AudioSource : public Actor
         return _isActuallyPlayingSth;
     }
 
+    /// <summary>
+    /// Determines whether this audio source is playing virtually (playback time advances but audio is not mixed by the audio backend). Sources get virtualized when they are inaudible or exceed the voices limit (see AudioSettings).
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE bool IsVirtual() const
+    {
+        return _isVirtual;
+    }
+
     /// <summary>
     /// Requests the audio streaming buffers update. Rises tha flag to synchronize audio backend buffers of the emitter during next game logic update.
     /// </summary>
@@ -247,6 +273,14 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     void PlayInternal();
 
+    void StartStreamingVoice(float time);
+    void StopStreamingVoice();
+    void UpdateStreamingVoice();
+
+    void Virtualize();
+    void Devirtualize();
+    void UpdateVirtual(float dt);
+
     void Update();
 
 public:
@@ -0,0 +1,400 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "AudioStreamingVoice.h"
+#include "AudioClip.h"
+#include "AudioSource.h"
+#include "AudioBackend.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ConditionVariable.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/ThreadSpawner.h"
+#include "Engine/Tools/AudioTool/AudioDecoder.h"
+#include "Engine/Tools/AudioTool/OggVorbisDecoder.h"
+
+bool AudioStreamingVoice::Enabled = true;
+float AudioStreamingVoice::PrefetchTime = 2.0f;
+
+class AudioStreamingService : public EngineService
+{
+public:
+    AudioStreamingService()
+        : EngineService(TEXT("Audio Streaming"), -49)
+    {
+        AddDependency(TEXT("Audio"));
+    }
+
+    static int32 Run();
+    void Dispose() override;
+};
+
+namespace
+{
+    CriticalSection VoicesLocker;
+    ConditionVariable VoicesSignal;
+    Array<AudioStreamingVoice*> Voices;
+    Thread* DecodingThread = nullptr;
+    volatile int64 DecodingThreadActive = 0;
+
+    FORCE_INLINE int32 GetState(const volatile int32& state)
+    {
+        return Platform::AtomicRead(const_cast<volatile int32*>(&state));
+    }
+
+    FORCE_INLINE int64 GetDeadline(float bufferedTime)
+    {
+        return (int64)((Platform::GetTimeSeconds() + bufferedTime) * 1000000.0);
+    }
+}
+
+AudioStreamingService AudioStreamingServiceInstance;
+
+int32 AudioStreamingService::Run()
+{
+    Array<byte> data;
+    while (Platform::AtomicRead(&DecodingThreadActive))
+    {
+        VoicesLocker.Lock();
+
+        // Pick the voice that will run out of the decoded audio first
+        AudioStreamingVoice* voice = nullptr;
+        int64 deadline = MAX_int64;
+        for (AudioStreamingVoice* e : Voices)
+        {
+            const int64 voiceDeadline = Platform::AtomicRead(&e->_deadline);
+            if (voiceDeadline < deadline && e->CanDecode())
+            {
+                voice = e;
+                deadline = voiceDeadline;
+            }
+        }
+        if (!voice)
+        {
+            VoicesSignal.Wait(VoicesLocker, 10);
+            VoicesLocker.Unlock();
+            continue;
+        }
+        voice->_decoding = true;
+        VoicesLocker.Unlock();
+
+        // Decode a single block at once to keep the other voices responsive
+        const int32 blockSize = AUDIO_STREAMING_VOICE_BLOCK_SAMPLES * voice->_info.NumChannels * (voice->_info.BitDepth / 8);
+        if (data.Count() < blockSize)
+            data.Resize(blockSize, false);
+        voice->Decode(data.Get());
+
+        VoicesLocker.Lock();
+        voice->_decoding = false;
+        if (voice->_released)
+            Delete(voice);
+        VoicesLocker.Unlock();
+    }
+    return 0;
+}
+
+void AudioStreamingService::Dispose()
+{
+    if (DecodingThread)
+    {
+        Platform::AtomicStore(&DecodingThreadActive, 0);
+        VoicesSignal.NotifyAll();
+        DecodingThread->Join();
+        Delete(DecodingThread);
+        DecodingThread = nullptr;
+    }
+    Voices.ClearDelete();
+}
+
+AudioStreamingVoice::AudioStreamingVoice(AudioClip* clip, float time, bool loop)
+    : _clip(clip)
+    , _info(clip->Info())
+    , _loop(loop)
+{
+    if (clip->Format() == AudioFormat::Vorbis)
+        _info.BitDepth = 16;
+    for (Block& block : _blocks)
+    {
+        block.State = BlockFree;
+        block.StartTime = time;
+        AudioBackend::Buffer::Create(block.BufferId);
+    }
+
+    // Locate the data chunk and the samples offset to start decoding from
+    float offset = 0.0f;
+    _chunkIndex = clip->GetFirstBufferIndex(time, offset);
+    _chunkPosition = (uint32)(offset * (float)_info.SampleRate) * _info.NumChannels;
+    _decodeTime = time;
+}
+
+AudioStreamingVoice::~AudioStreamingVoice()
+{
+    CloseChunk();
+    for (Block& block : _blocks)
+    {
+        if (block.BufferId != AUDIO_BUFFER_ID_INVALID)
+            AudioBackend::Buffer::Delete(block.BufferId);
+    }
+}
+
+AudioStreamingVoice* AudioStreamingVoice::Create(AudioClip* clip, float time, bool loop)
+{
+    ASSERT(clip && clip->IsLoaded() && clip->IsStreamable());
+    auto voice = New<AudioStreamingVoice>(clip, time, loop);
+    Platform::AtomicStore(&voice->_deadline, GetDeadline(0.0f));
+
+    ScopeLock lock(VoicesLocker);
+    Voices.Add(voice);
+    if (!DecodingThread)
+    {
+        Platform::AtomicStore(&DecodingThreadActive, 1);
+        DecodingThread = ThreadSpawner::Start(AudioStreamingService::Run, TEXT("Audio Streaming"), ThreadPriority::AboveNormal);
+    }
+    VoicesSignal.NotifyOne();
+    return voice;
+}
+
+void AudioStreamingVoice::Destroy(AudioStreamingVoice* voice)
+{
+    if (!voice)
+        return;
+    ScopeLock lock(VoicesLocker);
+    Voices.Remove(voice);
+    if (voice->_decoding)
+        voice->_released = true; // Deleted by the decoding thread
+    else
+        Delete(voice);
+}
+
+void AudioStreamingVoice::OnClipUnloading(AudioClip* clip)
+{
+    VoicesLocker.Lock();
+    for (int32 i = 0; i < Voices.Count(); i++)
+    {
+        AudioStreamingVoice* voice = Voices[i];
+        if (voice->_clip != clip)
+            continue;
+
+        // Wait for the decoding to end
+        while (voice->_decoding)
+        {
+            VoicesLocker.Unlock();
+            Platform::Sleep(1);
+            VoicesLocker.Lock();
+        }
+        voice->CloseChunk();
+        voice->_clip = nullptr;
+    }
+    VoicesLocker.Unlock();
+}
+
+int32 AudioStreamingVoice::GetQueuedBlocksCount() const
+{
+    int32 count = 0;
+    for (int32 i = 0; i < AUDIO_STREAMING_VOICE_BLOCKS; i++)
+    {
+        if (GetState(_blocks[(_playBlock + i) % AUDIO_STREAMING_VOICE_BLOCKS].State) != BlockQueued)
+            break;
+        count++;
+    }
+    return count;
+}
+
+float AudioStreamingVoice::GetQueuedBlockStartTime(int32 index) const
+{
+    return _blocks[(_playBlock + index) % AUDIO_STREAMING_VOICE_BLOCKS].StartTime;
+}
+
+bool AudioStreamingVoice::IsFinished() const
+{
+    if (_clip && !GetState(_finished))
+        return false;
+    for (const Block& block : _blocks)
+    {
+        if (GetState(block.State) != BlockFree)
+            return false;
+    }
+    return true;
+}
+
+int32 AudioStreamingVoice::QueueBlocks(AudioSource* source)
+{
+    int32 count = 0;
+    while (GetState(_blocks[_queueBlock].State) == BlockReady)
+    {
+        Block& block = _blocks[_queueBlock];
+        AudioBackend::Source::QueueBuffer(source, block.BufferId);
+        Platform::AtomicStore(&block.State, BlockQueued);
+        _queueBlock = (_queueBlock + 1) % AUDIO_STREAMING_VOICE_BLOCKS;
+        count++;
+    }
+
+    // Update the decoding deadline (the queued audio duration, roughly including the already played part of the current block)
+    const float blockDuration = (float)AUDIO_STREAMING_VOICE_BLOCK_SAMPLES / (float)Math::Max(_info.SampleRate, 1u);
+    const int32 bufferedBlocks = GetQueuedBlocksCount();
+    Platform::AtomicStore(&_deadline, GetDeadline(Math::Max(bufferedBlocks - 1, 0) * blockDuration));
+    if (bufferedBlocks < AUDIO_STREAMING_VOICE_BLOCKS)
+        VoicesSignal.NotifyOne();
+
+    return count;
+}
+
+void AudioStreamingVoice::ReleaseBlocks(int32 count)
+{
+    for (int32 i = 0; i < count && GetState(_blocks[_playBlock].State) == BlockQueued; i++)
+    {
+        Platform::AtomicStore(&_blocks[_playBlock].State, BlockFree);
+        _playBlock = (_playBlock + 1) % AUDIO_STREAMING_VOICE_BLOCKS;
+    }
+    VoicesSignal.NotifyOne();
+}
+
+void AudioStreamingVoice::ReleaseAllBlocks()
+{
+    ReleaseBlocks(AUDIO_STREAMING_VOICE_BLOCKS);
+}
+
+bool AudioStreamingVoice::CanDecode() const
+{
+    return _clip && !GetState(_finished) && GetState(_blocks[_writeBlock].State) == BlockFree;
+}
+
+void AudioStreamingVoice::Decode(byte* data)
+{
+    PROFILE_CPU();
+    auto clip = _clip;
+    auto dataLock = clip->Storage->Lock();
+    const auto& header = clip->AudioHeader;
+    const uint32 bytesPerSample = _info.BitDepth / 8;
+    const uint32 capacity = AUDIO_STREAMING_VOICE_BLOCK_SAMPLES * _info.NumChannels;
+    Block& block = _blocks[_writeBlock];
+    block.StartTime = _decodeTime;
+    uint32 written = 0;
+    while (written < capacity)
+    {
+        const uint32 chunkSamples = header.SamplesPerChunk[_chunkIndex];
+        if (_chunkPosition >= chunkSamples)
+        {
+            // Move to the next chunk
+            CloseChunk();
+            _chunkPosition = 0;
+            _chunkIndex++;
+            if (_chunkIndex >= clip->Buffers.Count())
+            {
+                if (!_loop)
+                {
+                    Platform::AtomicStore(&_finished, 1);
+                    break;
+                }
+                _chunkIndex = 0;
+                _decodeTime = 0.0f;
+                if (written == 0)
+                    block.StartTime = 0.0f;
+            }
+            continue;
+        }
+        if (OpenChunk())
+        {
+            Platform::AtomicStore(&_finished, 1);
+            break;
+        }
+
+        // Decode samples from the current chunk
+        const uint32 count = Math::Min(chunkSamples - _chunkPosition, capacity - written);
+        byte* dst = data + written * bytesPerSample;
+        if (_decoder)
+            _decoder->Read(dst, count);
+        else
+            Platform::MemoryCopy(dst, _chunkData + _chunkPosition * bytesPerSample, count * bytesPerSample);
+        _chunkPosition += count;
+        written += count;
+    }
+    if (written == 0)
+        return;
+    _decodeTime += (float)(written / _info.NumChannels) / (float)_info.SampleRate;
+
+    // Prefetch the next chunk data before the playback reaches it
+    const int32 nextChunk = _chunkIndex + 1 < clip->Buffers.Count() ? _chunkIndex + 1 : (_loop ? 0 : -1);
+    if (nextChunk != -1 && nextChunk != _chunkIndex && nextChunk != _prefetchChunk && clip->GetBufferStartTime(_chunkIndex + 1) - _decodeTime <= PrefetchTime)
+    {
+        _prefetchChunk = nextChunk;
+        auto task = clip->RequestChunkDataAsync(nextChunk);
+        if (task)
+        {
+            task->SetPriority(ContentLoadTask::Priority::High);
+            task->Start();
+        }
+    }
+
+    // Upload samples to the voice buffer (queued by the audio source on the main thread)
+    AudioDataInfo info = _info;
+    info.NumSamples = written;
+    AudioBackend::Buffer::Write(block.BufferId, data, info);
+    Platform::AtomicStore(&block.State, BlockReady);
+    _writeBlock = (_writeBlock + 1) % AUDIO_STREAMING_VOICE_BLOCKS;
+}
+
+bool AudioStreamingVoice::OpenChunk()
+{
+    auto chunk = _clip->GetChunk(_chunkIndex);
+    if (chunk && chunk->IsMissing())
+    {
+        // Not prefetched in time
+        PROFILE_CPU_NAMED("LoadChunk");
+        _clip->LoadChunk(_chunkIndex);
+    }
+    if (chunk == nullptr || chunk->IsMissing())
+    {
+        LOG(Warning, "Missing audio streaming data chunk.");
+        return true;
+    }
+    if (_chunkData == chunk->Get())
+        return false;
+
+    // Chunk data has been reloaded so decoder has to read it from the new location
+    if (_chunkData)
+    {
+        const uint32 position = _stream.GetPosition();
+        _stream.Init(chunk->Get(), chunk->Size());
+        _stream.SetPosition(position);
+        _chunkData = chunk->Get();
+        return false;
+    }
+
+    _chunkData = chunk->Get();
+    _stream.Init(chunk->Get(), chunk->Size());
+    if (_clip->Format() == AudioFormat::Vorbis)
+    {
+#if COMPILE_WITH_OGG_VORBIS
+        auto decoder = New<OggVorbisDecoder>();
+        _decoder = decoder;
+        AudioDataInfo info;
+        if (!decoder->Open(&_stream, info))
+        {
+            LOG(Warning, "Audio data decode failed (OggVorbisDecoder).");
+            CloseChunk();
+            return true;
+        }
+        if (_chunkPosition != 0)
+            decoder->Seek(_chunkPosition);
+#else
+        LOG(Warning, "OggVorbisDecoder is disabled.");
+        CloseChunk();
+        return true;
+#endif
+    }
+    return false;
+}
+
+void AudioStreamingVoice::CloseChunk()
+{
+    if (_decoder)
+    {
+        Delete(_decoder);
+        _decoder = nullptr;
+    }
+    _chunkData = nullptr;
+}
@@ -0,0 +1,144 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Types.h"
+#include "Config.h"
+
+class AudioClip;
+class AudioSource;
+class AudioDecoder;
+
+/// <summary>
+/// The audio streaming voice used by the audio source to play the streamable audio clip. Decodes the clip data incrementally on a dedicated audio thread into a small ring of fixed-size PCM blocks so the memory used by the playback is constant (regardless of the clip length and chunks size).
+/// </summary>
+/// <remarks>
+/// Voice blocks are filled in order by the audio decoding thread (voices closest to run out of the decoded audio go first) and then queued to the audio backend source by the main thread (see QueueBlocks and ReleaseBlocks). The compressed clip data chunks are loaded on demand and prefetched before the playback reaches them.
+/// </remarks>
+class FLAXENGINE_API AudioStreamingVoice
+{
+    friend class AudioStreamingService;
+public:
+    /// <summary>
+    /// True if use streaming voices for the audio sources playing streamable audio clips, otherwise clip chunks are streamed and decoded as a whole into the audio clip buffers. Set from AudioSettings.
+    /// </summary>
+    static bool Enabled;
+
+    /// <summary>
+    /// The time (in seconds) before reaching the next clip data chunk to start prefetching it.
+    /// </summary>
+    static float PrefetchTime;
+
+private:
+    enum BlockStates
+    {
+        BlockFree = 0,
+        BlockReady = 1,
+        BlockQueued = 2,
+    };
+
+    struct Block
+    {
+        volatile int32 State;
+        float StartTime;
+        AUDIO_BUFFER_ID_TYPE BufferId;
+    };
+
+    AudioClip* _clip;
+    AudioDataInfo _info;
+    Block _blocks[AUDIO_STREAMING_VOICE_BLOCKS];
+    int32 _writeBlock = 0;
+    int32 _queueBlock = 0;
+    int32 _playBlock = 0;
+    volatile int64 _deadline = 0;
+    volatile int32 _finished = 0;
+    volatile bool _loop;
+    bool _decoding = false;
+    bool _released = false;
+
+    // Decoding state (accessed only by the decoding thread)
+    int32 _chunkIndex;
+    uint32 _chunkPosition;
+    int32 _prefetchChunk = -1;
+    float _decodeTime;
+    AudioDecoder* _decoder = nullptr;
+    MemoryReadStream _stream;
+    const byte* _chunkData = nullptr;
+
+public:
+    AudioStreamingVoice(AudioClip* clip, float time, bool loop);
+    ~AudioStreamingVoice();
+
+public:
+    /// <summary>
+    /// Creates the streaming voice for the given audio clip. Must be called from the main thread.
+    /// </summary>
+    /// <param name="clip">The streamable audio clip (loaded).</param>
+    /// <param name="time">The playback start time (in seconds).</param>
+    /// <param name="loop">True if loop the playback.</param>
+    /// <returns>The created voice.</returns>
+    static AudioStreamingVoice* Create(AudioClip* clip, float time, bool loop);
+
+    /// <summary>
+    /// Releases the streaming voice including its audio backend buffers. The voice blocks must not be queued in any audio source. Must be called from the main thread.
+    /// </summary>
+    /// <param name="voice">The voice.</param>
+    static void Destroy(AudioStreamingVoice* voice);
+
+    /// <summary>
+    /// Stops all the voices decoding the given audio clip. Called before clip data unload.
+    /// </summary>
+    /// <param name="clip">The audio clip.</param>
+    static void OnClipUnloading(AudioClip* clip);
+
+public:
+    /// <summary>
+    /// Sets the playback looping. Voice continues decoding from the clip start once it reaches the end.
+    /// </summary>
+    void SetLooping(bool value)
+    {
+        _loop = value;
+    }
+
+    /// <summary>
+    /// Gets the amount of the blocks queued in the audio source (not yet released).
+    /// </summary>
+    int32 GetQueuedBlocksCount() const;
+
+    /// <summary>
+    /// Gets the playback start time of the queued block (in seconds).
+    /// </summary>
+    /// <param name="index">The index of the queued block (0 is the oldest one).</param>
+    float GetQueuedBlockStartTime(int32 index) const;
+
+    /// <summary>
+    /// Returns true if voice decoded whole clip data (when not looping) and all its blocks have been played and released.
+    /// </summary>
+    bool IsFinished() const;
+
+    /// <summary>
+    /// Queues the decoded blocks into the audio source (in playback order). Updates the decoding deadline based on the buffered audio duration.
+    /// </summary>
+    /// <param name="source">The audio source.</param>
+    /// <returns>The amount of queued blocks.</returns>
+    int32 QueueBlocks(AudioSource* source);
+
+    /// <summary>
+    /// Releases the played blocks so they can be decoded again. Dequeuing them from the audio source has to be done by the caller.
+    /// </summary>
+    /// <param name="count">The amount of processed buffers (the oldest queued blocks).</param>
+    void ReleaseBlocks(int32 count);
+
+    /// <summary>
+    /// Releases all the queued blocks. Used after audio source stop that removes all the queued buffers.
+    /// </summary>
+    void ReleaseAllBlocks();
+
+private:
+    bool CanDecode() const;
+    void Decode(byte* data);
+    bool OpenChunk();
+    void CloseChunk();
+};
@@ -18,3 +18,9 @@
 
 // The buffer ID that is invalid (unused)
 #define AUDIO_BUFFER_ID_INVALID 0
+
+// The amount of PCM blocks in the ring buffer of the streaming audio voice
+#define AUDIO_STREAMING_VOICE_BLOCKS 3
+
+// The size of a single PCM block of the streaming audio voice (in samples per channel)
+#define AUDIO_STREAMING_VOICE_BLOCK_SAMPLES 16384
@@ -0,0 +1,1254 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if AUDIO_API_MIXER
+
+#include "AudioBackendMixer.h"
+#include "AudioMixerDSP.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Audio/Audio.h"
+#include "Engine/Audio/AudioListener.h"
+#include "Engine/Audio/AudioSource.h"
+#include "Engine/Audio/AudioSettings.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/ThreadSpawner.h"
+#include "Engine/Threading/ConcurrentQueue.h"
+#include "Engine/Tools/AudioTool/AudioTool.h"
+#if AUDIO_API_OPENAL
+#include <OpenAL/al.h>
+#include <OpenAL/alc.h>
+#endif
+
+// The amount of output frames mixed at once (also the playback state update granularity)
+#define MIXER_BLOCK_FRAMES 512
+// The maximum amount of audio buffers
+#define MIXER_MAX_BUFFERS 8192
+// The maximum amount of voices (audio sources)
+#define MIXER_MAX_VOICES 1024
+// The maximum amount of mixer buses (including master bus)
+#define MIXER_MAX_BUSES 32
+// The speed of sound used for the doppler effect (in cm/s)
+#define MIXER_SPEED_OF_SOUND 34330.0f
+
+namespace Mixer
+{
+    struct BufferData
+    {
+        float* Samples;
+        int32 Frames;
+        int32 Channels;
+        int32 SampleRate;
+        int32 Refs; // Used only by the mixer thread
+    };
+
+    struct BufferSlot
+    {
+        // The latest data written to the buffer (from any thread), picked by the mixer thread when buffer gets used
+        volatile int64 Pending;
+        // The buffer data used by the mixer thread
+        BufferData* Current;
+    };
+
+    enum class CommandTypes : byte
+    {
+        VoiceAdd,
+        VoiceRemove,
+        VoiceParams,
+        VoiceTransform,
+        VoicePlay,
+        VoicePause,
+        VoiceStop,
+        VoiceSetTime,
+        VoiceSetBuffer,
+        VoiceQueueBuffer,
+        VoiceDequeue,
+        BufferDelete,
+        Listener,
+        Volume,
+        DopplerFactor,
+    };
+
+    struct Command
+    {
+        CommandTypes Type;
+        uint32 Id;
+        uint32 Value;
+        float Params[10];
+    };
+
+    // Voice playback state published by the mixer thread
+    struct VoiceState
+    {
+        volatile int64 Processed;
+        volatile int64 Time; // In microseconds
+        volatile int64 Generation;
+    };
+
+    // Voice state tracked by the game thread
+    struct GameVoice
+    {
+        int64 Queued;
+        int64 Dequeued;
+        int64 Generation;
+    };
+
+    // Voice mixed by the mixer thread
+    struct Voice
+    {
+        bool Active;
+        bool Playing;
+        bool Loop;
+        bool Is3D;
+        bool HasGains;
+        int32 Bus;
+        float Volume;
+        float Pitch;
+        float MinDistance;
+        float Attenuation;
+        Float3 Position;
+        Float3 Velocity;
+        BufferData* StaticBuffer;
+        Array<BufferData*, FixedAllocation<AUDIO_MAX_SOURCE_BUFFERS>> Queue;
+        int32 Current;
+        double PlaybackPosition;
+        float GainL, GainR;
+        int64 Processed;
+        int64 Generation;
+    };
+
+    struct Bus
+    {
+        int32 Parent;
+        float Volume;
+        float LowPass;
+        float ReverbSend;
+        float LowPassState[2];
+        bool HasInput;
+        float L[MIXER_BLOCK_FRAMES];
+        float R[MIXER_BLOCK_FRAMES];
+    };
+
+    /// <summary>
+    /// Simple stereo reverb (Schroeder-Moorer design with parallel damped comb filters followed by series all-pass filters).
+    /// </summary>
+    class Reverb
+    {
+    private:
+        struct Line
+        {
+            Array<float> Buffer;
+            int32 Index = 0;
+            float Filter = 0.0f;
+
+            void Init(int32 length)
+            {
+                Buffer.Resize(Math::Max(length, 1));
+                Buffer.SetAll(0.0f);
+                Index = 0;
+                Filter = 0.0f;
+            }
+        };
+
+        Line _combs[2][4];
+        Line _allPasses[2][2];
+
+    public:
+        float Decay = 0.7f;
+        float Damping = 0.25f;
+
+        void Init(int32 sampleRate)
+        {
+            // Delay lengths tuned for 44.1kHz with the stereo spread
+            const int32 combLengths[4] = { 1116, 1188, 1277, 1356 };
+            const int32 allPassLengths[2] = { 556, 441 };
+            const float scale = (float)sampleRate / 44100.0f;
+            for (int32 channel = 0; channel < 2; channel++)
+            {
+                const int32 spread = channel * 23;
+                for (int32 i = 0; i < 4; i++)
+                    _combs[channel][i].Init((int32)((combLengths[i] + spread) * scale));
+                for (int32 i = 0; i < 2; i++)
+                    _allPasses[channel][i].Init((int32)((allPassLengths[i] + spread) * scale));
+            }
+        }
+
+        void Process(const float* input, float* output, int32 channel, int32 count)
+        {
+            const float decay = Decay;
+            const float damping = Damping;
+            for (int32 n = 0; n < count; n++)
+            {
+                const float x = input[n] * 0.25f;
+                float y = 0.0f;
+                for (Line& comb : _combs[channel])
+                {
+                    float& sample = comb.Buffer[comb.Index];
+                    comb.Filter = sample + (comb.Filter - sample) * damping;
+                    y += sample;
+                    sample = x + comb.Filter * decay;
+                    if (++comb.Index == comb.Buffer.Count())
+                        comb.Index = 0;
+                }
+                for (Line& allPass : _allPasses[channel])
+                {
+                    float& sample = allPass.Buffer[allPass.Index];
+                    const float delayed = sample;
+                    sample = y + delayed * 0.5f;
+                    y = delayed - y;
+                    if (++allPass.Index == allPass.Buffer.Count())
+                        allPass.Index = 0;
+                }
+                output[n] += y;
+            }
+        }
+    };
+
+    /// <summary>
+    /// The mixer output to the audio device.
+    /// </summary>
+    class Output
+    {
+    public:
+        virtual ~Output()
+        {
+        }
+
+        virtual const Char* GetName() const = 0;
+        virtual bool Init(int32 sampleRate) = 0;
+        // Submits the mixed audio (interleaved stereo). Blocks the mixer thread until the device can accept the data.
+        virtual void Submit(const int16* samples, int32 frames) = 0;
+        virtual void Dispose() = 0;
+    };
+
+    /// <summary>
+    /// The mixer output that drops the audio but paces the mixer in real-time (used when no audio device is available).
+    /// </summary>
+    class OutputNull : public Output
+    {
+    private:
+        int32 _sampleRate = 0;
+        double _time = 0.0;
+
+    public:
+        const Char* GetName() const override
+        {
+            return TEXT("Null");
+        }
+
+        bool Init(int32 sampleRate) override
+        {
+            _sampleRate = sampleRate;
+            _time = Platform::GetTimeSeconds();
+            return false;
+        }
+
+        void Submit(const int16* samples, int32 frames) override
+        {
+            const double now = Platform::GetTimeSeconds();
+            if (_time < now - 0.1)
+                _time = now;
+            _time += (double)frames / _sampleRate;
+            const int32 wait = (int32)((_time - now) * 1000.0) - 10;
+            if (wait > 0)
+                Platform::Sleep(wait);
+        }
+
+        void Dispose() override
+        {
+        }
+    };
+
+    CriticalSection BuffersLocker;
+    Array<uint32> FreeBufferIds;
+    uint32 NextBufferId = 1;
+    BufferSlot* Buffers = nullptr;
+    ConcurrentQueue<Command> Commands;
+    ConcurrentQueue<BufferData*> ReleasedData;
+    ConcurrentQueue<uint32> ReleasedBufferIds;
+
+    Array<uint32> FreeVoiceIds;
+    uint32 NextVoiceId = 1;
+    GameVoice* GameVoices = nullptr;
+    VoiceState* VoiceStates = nullptr;
+    Voice* Voices = nullptr;
+    int32 VoicesCount = 0;
+
+    Array<Bus*> Buses;
+    Reverb ReverbEffect;
+    Output* Device = nullptr;
+    Thread* MixerThread = nullptr;
+    volatile int64 MixerThreadActive = 0;
+    int32 SampleRate = 48000;
+    float MasterVolume = 1.0f;
+    float DopplerFactor = 1.0f;
+    bool HasListener = false;
+    Float3 ListenerPosition;
+    Float3 ListenerVelocity;
+    Quaternion ListenerOrientation;
+
+#if AUDIO_API_OPENAL
+    /// <summary>
+    /// The mixer output that submits the final mix to the OpenAL device via a single streaming source.
+    /// </summary>
+    class OutputOpenAL : public Output
+    {
+    private:
+        ALCdevice* _device = nullptr;
+        ALCcontext* _context = nullptr;
+        ALuint _source = 0;
+        ALuint _buffers[4];
+        int32 _unusedBuffers = 0;
+        int32 _sampleRate = 0;
+
+    public:
+        const Char* GetName() const override
+        {
+            return TEXT("OpenAL");
+        }
+
+        bool Init(int32 sampleRate) override
+        {
+            _sampleRate = sampleRate;
+            _device = alcOpenDevice(nullptr);
+            if (!_device)
+                return true;
+            _context = alcCreateContext(_device, nullptr);
+            if (!_context || !alcMakeContextCurrent(_context))
+            {
+                Dispose();
+                return true;
+            }
+            alGenSources(1, &_source);
+            alSourcei(_source, AL_SOURCE_RELATIVE, AL_TRUE);
+            alGenBuffers(ARRAY_COUNT(_buffers), _buffers);
+            _unusedBuffers = ARRAY_COUNT(_buffers);
+            return alGetError() != AL_NO_ERROR;
+        }
+
+        void Submit(const int16* samples, int32 frames) override
+        {
+            ALuint buffer;
+            if (_unusedBuffers > 0)
+            {
+                buffer = _buffers[--_unusedBuffers];
+            }
+            else
+            {
+                // Wait for the device to consume the queued audio (paces the mixer thread)
+                ALint processed = 0;
+                while (true)
+                {
+                    alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+                    if (processed > 0 || !Platform::AtomicRead(&MixerThreadActive))
+                        break;
+                    Platform::Sleep(1);
+                }
+                if (processed <= 0)
+                    return;
+                alSourceUnqueueBuffers(_source, 1, &buffer);
+            }
+            alBufferData(buffer, AL_FORMAT_STEREO16, samples, frames * 2 * sizeof(int16), _sampleRate);
+            alSourceQueueBuffers(_source, 1, &buffer);
+
+            // Start playback (or resume after the buffers underrun)
+            ALint state;
+            alGetSourcei(_source, AL_SOURCE_STATE, &state);
+            if (state != AL_PLAYING)
+                alSourcePlay(_source);
+        }
+
+        void Dispose() override
+        {
+            if (_source)
+            {
+                alSourceStop(_source);
+                alSourcei(_source, AL_BUFFER, 0);
+                alDeleteSources(1, &_source);
+                alDeleteBuffers(ARRAY_COUNT(_buffers), _buffers);
+                _source = 0;
+            }
+            if (_context)
+            {
+                alcMakeContextCurrent(nullptr);
+                alcDestroyContext(_context);
+                _context = nullptr;
+            }
+            if (_device)
+            {
+                alcCloseDevice(_device);
+                _device = nullptr;
+            }
+        }
+    };
+#endif
+
+    void PostCommand(CommandTypes type, uint32 id = 0, uint32 value = 0)
+    {
+        Command cmd;
+        cmd.Type = type;
+        cmd.Id = id;
+        cmd.Value = value;
+        Commands.Add(cmd);
+    }
+
+    void PostVoiceParams(const AudioSource* source)
+    {
+        if (source->SourceIDs.IsEmpty())
+            return;
+        Command cmd;
+        cmd.Type = CommandTypes::VoiceParams;
+        cmd.Id = source->SourceIDs[0];
+        cmd.Value = 0;
+        // Streaming sources handle looping by the buffers submission
+        if (source->GetIsLooping() && !source->UseStreaming())
+            cmd.Value |= 1;
+        if (source->Is3D())
+            cmd.Value |= 2;
+        cmd.Params[0] = source->GetVolume();
+        cmd.Params[1] = source->GetPitch();
+        cmd.Params[2] = source->GetMinDistance();
+        cmd.Params[3] = source->GetAttenuation();
+        cmd.Params[4] = (float)(source->MixerBus + 1);
+        Commands.Add(cmd);
+    }
+
+    void PostVoiceTransform(const AudioSource* source)
+    {
+        if (source->SourceIDs.IsEmpty())
+            return;
+        Command cmd;
+        cmd.Type = CommandTypes::VoiceTransform;
+        cmd.Id = source->SourceIDs[0];
+        cmd.Value = 0;
+        const Float3 position = source->GetPosition();
+        const Float3 velocity = source->GetVelocity();
+        cmd.Params[0] = position.X;
+        cmd.Params[1] = position.Y;
+        cmd.Params[2] = position.Z;
+        cmd.Params[3] = velocity.X;
+        cmd.Params[4] = velocity.Y;
+        cmd.Params[5] = velocity.Z;
+        Commands.Add(cmd);
+    }
+
+    void PostListener(const AudioListener* listener)
+    {
+        Command cmd;
+        cmd.Type = CommandTypes::Listener;
+        cmd.Id = 0;
+        cmd.Value = listener ? 1 : 0;
+        if (listener)
+        {
+            const Float3 position = listener->GetPosition();
+            const Float3 velocity = listener->GetVelocity();
+            const Quaternion orientation = listener->GetOrientation();
+            cmd.Params[0] = position.X;
+            cmd.Params[1] = position.Y;
+            cmd.Params[2] = position.Z;
+            cmd.Params[3] = velocity.X;
+            cmd.Params[4] = velocity.Y;
+            cmd.Params[5] = velocity.Z;
+            cmd.Params[6] = orientation.X;
+            cmd.Params[7] = orientation.Y;
+            cmd.Params[8] = orientation.Z;
+            cmd.Params[9] = orientation.W;
+        }
+        Commands.Add(cmd);
+    }
+
+    FORCE_INLINE GameVoice* GetGameVoice(const AudioSource* source)
+    {
+        return source->SourceIDs.HasItems() ? &GameVoices[source->SourceIDs[0] - 1] : nullptr;
+    }
+
+    FORCE_INLINE bool IsStateValid(uint32 id)
+    {
+        return Platform::AtomicRead(&VoiceStates[id - 1].Generation) == GameVoices[id - 1].Generation;
+    }
+
+    void ReleaseData(BufferData* data)
+    {
+        if (data && --data->Refs == 0)
+            ReleasedData.Add(data);
+    }
+
+    BufferData* GetBuffer(uint32 bufferId)
+    {
+        if (bufferId == AUDIO_BUFFER_ID_INVALID || bufferId > MIXER_MAX_BUFFERS)
+            return nullptr;
+        BufferSlot& slot = Buffers[bufferId - 1];
+        BufferData* pending = (BufferData*)Platform::InterlockedExchange(&slot.Pending, 0);
+        if (pending)
+        {
+            ReleaseData(slot.Current);
+            pending->Refs = 1;
+            slot.Current = pending;
+        }
+        return slot.Current;
+    }
+
+    void ClearQueue(Voice& voice)
+    {
+        for (BufferData* data : voice.Queue)
+            ReleaseData(data);
+        voice.Queue.Clear();
+        voice.Current = 0;
+    }
+
+    void Publish(uint32 id, const Voice& voice)
+    {
+        VoiceState& state = VoiceStates[id - 1];
+        const BufferData* data = voice.StaticBuffer ? voice.StaticBuffer : (voice.Current < voice.Queue.Count() ? voice.Queue[voice.Current] : nullptr);
+        const double time = data && data->SampleRate > 0 ? voice.PlaybackPosition / data->SampleRate : 0.0;
+        Platform::AtomicStore(&state.Processed, voice.Processed);
+        Platform::AtomicStore(&state.Time, (int64)(time * 1000000.0));
+        Platform::AtomicStore(&state.Generation, voice.Generation);
+    }
+
+    void ProcessCommands()
+    {
+        PROFILE_CPU();
+        Command cmd;
+        while (Commands.try_dequeue(cmd))
+        {
+            Voice& voice = Voices[cmd.Id > 0 && cmd.Id <= MIXER_MAX_VOICES ? cmd.Id - 1 : 0];
+            switch (cmd.Type)
+            {
+            case CommandTypes::VoiceAdd:
+                voice.Active = true;
+                voice.Playing = false;
+                voice.HasGains = false;
+                voice.StaticBuffer = nullptr;
+                voice.PlaybackPosition = 0.0;
+                voice.Processed = 0;
+                voice.Generation = cmd.Value;
+                ClearQueue(voice);
+                VoicesCount = Math::Max(VoicesCount, (int32)cmd.Id);
+                Publish(cmd.Id, voice);
+                break;
+            case CommandTypes::VoiceRemove:
+                voice.Active = false;
+                voice.Playing = false;
+                ReleaseData(voice.StaticBuffer);
+                voice.StaticBuffer = nullptr;
+                ClearQueue(voice);
+                break;
+            case CommandTypes::VoiceParams:
+                voice.Loop = (cmd.Value & 1) != 0;
+                voice.Is3D = (cmd.Value & 2) != 0;
+                voice.Volume = cmd.Params[0];
+                voice.Pitch = cmd.Params[1];
+                voice.MinDistance = cmd.Params[2];
+                voice.Attenuation = cmd.Params[3];
+                voice.Bus = Math::Clamp((int32)cmd.Params[4], 0, Buses.Count() - 1);
+                break;
+            case CommandTypes::VoiceTransform:
+                voice.Position = Float3(cmd.Params[0], cmd.Params[1], cmd.Params[2]);
+                voice.Velocity = Float3(cmd.Params[3], cmd.Params[4], cmd.Params[5]);
+                break;
+            case CommandTypes::VoicePlay:
+                if (!voice.Playing)
+                    voice.HasGains = false;
+                voice.Playing = true;
+                break;
+            case CommandTypes::VoicePause:
+                voice.Playing = false;
+                break;
+            case CommandTypes::VoiceStop:
+                voice.Playing = false;
+                voice.PlaybackPosition = 0.0;
+                voice.Processed = 0;
+                voice.Generation = cmd.Value;
+                ClearQueue(voice);
+                Publish(cmd.Id, voice);
+                break;
+            case CommandTypes::VoiceSetTime:
+            {
+                const BufferData* data = voice.StaticBuffer ? voice.StaticBuffer : (voice.Current < voice.Queue.Count() ? voice.Queue[voice.Current] : nullptr);
+                voice.PlaybackPosition = data ? Math::Clamp<double>(cmd.Params[0] * data->SampleRate, 0.0, data->Frames) : 0.0;
+                Publish(cmd.Id, voice);
+                break;
+            }
+            case CommandTypes::VoiceSetBuffer:
+            {
+                BufferData* data = GetBuffer(cmd.Value);
+                if (data)
+                    data->Refs++;
+                ReleaseData(voice.StaticBuffer);
+                voice.StaticBuffer = data;
+                voice.PlaybackPosition = 0.0;
+                break;
+            }
+            case CommandTypes::VoiceQueueBuffer:
+            {
+                BufferData* data = GetBuffer(cmd.Value);
+                if (voice.Queue.Count() == AUDIO_MAX_SOURCE_BUFFERS)
+                {
+                    // Keep the buffers count in sync with the game thread (drop the oldest processed buffer)
+                    ReleaseData(voice.Queue[0]);
+                    voice.Queue.RemoveAtKeepOrder(0);
+                    voice.Current = Math::Max(voice.Current - 1, 0);
+                }
+                if (data)
+                    data->Refs++;
+                voice.Queue.Add(data);
+                break;
+            }
+            case CommandTypes::VoiceDequeue:
+            {
+                const int32 count = Math::Min((int32)cmd.Value, voice.Current);
+                for (int32 i = 0; i < count; i++)
+                {
+                    ReleaseData(voice.Queue[0]);
+                    voice.Queue.RemoveAtKeepOrder(0);
+                }
+                voice.Current -= count;
+                break;
+            }
+            case CommandTypes::BufferDelete:
+            {
+                BufferSlot& slot = Buffers[cmd.Value - 1];
+                BufferData* pending = (BufferData*)Platform::InterlockedExchange(&slot.Pending, 0);
+                if (pending)
+                    ReleasedData.Add(pending);
+                ReleaseData(slot.Current);
+                slot.Current = nullptr;
+                ReleasedBufferIds.Add(cmd.Value);
+                break;
+            }
+            case CommandTypes::Listener:
+                HasListener = cmd.Value != 0;
+                ListenerPosition = Float3(cmd.Params[0], cmd.Params[1], cmd.Params[2]);
+                ListenerVelocity = Float3(cmd.Params[3], cmd.Params[4], cmd.Params[5]);
+                ListenerOrientation = Quaternion(cmd.Params[6], cmd.Params[7], cmd.Params[8], cmd.Params[9]);
+                break;
+            case CommandTypes::Volume:
+                MasterVolume = cmd.Params[0];
+                break;
+            case CommandTypes::DopplerFactor:
+                DopplerFactor = cmd.Params[0];
+                break;
+            }
+        }
+    }
+
+    void MixVoice(uint32 id, Voice& voice)
+    {
+        // Calculate the target gains and pitch
+        float gainL, gainR, pitch = voice.Pitch;
+        const bool downmix = voice.Is3D;
+        const BufferData* first = voice.StaticBuffer ? voice.StaticBuffer : (voice.Current < voice.Queue.Count() ? voice.Queue[voice.Current] : nullptr);
+        if (voice.Is3D && HasListener)
+        {
+            const Float3 toSource = voice.Position - ListenerPosition;
+            const float distance = toSource.Length();
+            const float minDistance = Math::Max(voice.MinDistance, ZeroTolerance);
+            const float attenuation = distance <= minDistance ? 1.0f : minDistance / (minDistance + voice.Attenuation * (distance - minDistance));
+
+            // Constant-power panning based on the source direction in the listener space
+            float pan = 0.0f;
+            if (distance > ZeroTolerance)
+            {
+                const Float3 local = ListenerOrientation.Conjugated() * toSource;
+                pan = Math::Clamp(local.X / distance, -1.0f, 1.0f);
+            }
+            const float angle = (pan + 1.0f) * (PI * 0.25f);
+            gainL = Math::Cos(angle) * attenuation;
+            gainR = Math::Sin(angle) * attenuation;
+
+            // Doppler effect
+            if (DopplerFactor > ZeroTolerance && distance > ZeroTolerance)
+            {
+                const Float3 dir = toSource / -distance;
+                const float maxSpeed = MIXER_SPEED_OF_SOUND / DopplerFactor * 0.99f;
+                const float listenerSpeed = Math::Min(Float3::Dot(dir, ListenerVelocity), maxSpeed);
+                const float sourceSpeed = Math::Min(Float3::Dot(dir, voice.Velocity), maxSpeed);
+                pitch *= Math::Clamp((MIXER_SPEED_OF_SOUND - DopplerFactor * listenerSpeed) / (MIXER_SPEED_OF_SOUND - DopplerFactor * sourceSpeed), 0.5f, 2.0f);
+            }
+        }
+        else
+        {
+            // Mono source is centered, stereo source is mixed per-channel
+            gainL = gainR = first && first->Channels == 1 ? 0.7071f : 1.0f;
+        }
+        gainL *= voice.Volume;
+        gainR *= voice.Volume;
+        if (!voice.HasGains)
+        {
+            voice.HasGains = true;
+            voice.GainL = gainL;
+            voice.GainR = gainR;
+        }
+        const float gainStepL = (gainL - voice.GainL) / MIXER_BLOCK_FRAMES;
+        const float gainStepR = (gainR - voice.GainR) / MIXER_BLOCK_FRAMES;
+
+        // Mix the voice buffers into the bus
+        Bus& bus = *Buses[voice.Bus];
+        int32 offset = 0;
+        float currentL = voice.GainL, currentR = voice.GainR;
+        while (offset < MIXER_BLOCK_FRAMES)
+        {
+            const BufferData* data = voice.StaticBuffer ? voice.StaticBuffer : (voice.Current < voice.Queue.Count() ? voice.Queue[voice.Current] : nullptr);
+            if (!data)
+            {
+                // Starving (wait for more buffers)
+                break;
+            }
+            if (data->Frames > 0)
+            {
+                const float step = (float)data->SampleRate / (float)SampleRate * pitch;
+                const int32 mixed = AudioMixerDSP::MixResampled(bus.L + offset, bus.R + offset, MIXER_BLOCK_FRAMES - offset, data->Samples, data->Frames, data->Channels, downmix, voice.PlaybackPosition, step, currentL, currentR, gainStepL, gainStepR);
+                currentL += gainStepL * (float)mixed;
+                currentR += gainStepR * (float)mixed;
+                offset += mixed;
+                bus.HasInput |= mixed != 0;
+                if (voice.PlaybackPosition < data->Frames)
+                    continue;
+            }
+
+            // Reached the buffer end
+            voice.PlaybackPosition = Math::Max(voice.PlaybackPosition - data->Frames, 0.0);
+            if (voice.StaticBuffer)
+            {
+                if (!voice.Loop)
+                {
+                    voice.Playing = false;
+                    voice.PlaybackPosition = 0.0;
+                    break;
+                }
+            }
+            else
+            {
+                voice.Current++;
+                voice.Processed++;
+            }
+        }
+        voice.GainL = gainL;
+        voice.GainR = gainR;
+        Publish(id, voice);
+    }
+
+    void Mix(int16* output)
+    {
+        PROFILE_CPU_NAMED("Audio.Mix");
+        for (Bus* bus : Buses)
+        {
+            if (bus->HasInput)
+            {
+                Platform::MemoryClear(bus->L, sizeof(bus->L));
+                Platform::MemoryClear(bus->R, sizeof(bus->R));
+                bus->HasInput = false;
+            }
+        }
+
+        // Mix voices
+        for (int32 i = 0; i < VoicesCount; i++)
+        {
+            Voice& voice = Voices[i];
+            if (voice.Active && voice.Playing)
+                MixVoice(i + 1, voice);
+        }
+
+        // Process buses (children are placed after their parents)
+        float reverbL[MIXER_BLOCK_FRAMES], reverbR[MIXER_BLOCK_FRAMES];
+        bool hasReverb = false;
+        for (int32 i = Buses.Count() - 1; i > 0; i--)
+        {
+            Bus& bus = *Buses[i];
+            if (!bus.HasInput)
+                continue;
+            if (bus.LowPass < 1.0f)
+            {
+                AudioMixerDSP::LowPass(bus.L, MIXER_BLOCK_FRAMES, bus.LowPass, bus.LowPassState[0]);
+                AudioMixerDSP::LowPass(bus.R, MIXER_BLOCK_FRAMES, bus.LowPass, bus.LowPassState[1]);
+            }
+            if (bus.ReverbSend > 0.0f)
+            {
+                if (!hasReverb)
+                {
+                    hasReverb = true;
+                    Platform::MemoryClear(reverbL, sizeof(reverbL));
+                    Platform::MemoryClear(reverbR, sizeof(reverbR));
+                }
+                AudioMixerDSP::MixAdd(reverbL, bus.L, bus.ReverbSend * bus.Volume, MIXER_BLOCK_FRAMES);
+                AudioMixerDSP::MixAdd(reverbR, bus.R, bus.ReverbSend * bus.Volume, MIXER_BLOCK_FRAMES);
+            }
+            Bus& parent = *Buses[bus.Parent];
+            if (!parent.HasInput)
+            {
+                parent.HasInput = true;
+                Platform::MemoryClear(parent.L, sizeof(parent.L));
+                Platform::MemoryClear(parent.R, sizeof(parent.R));
+            }
+            AudioMixerDSP::MixAdd(parent.L, bus.L, bus.Volume, MIXER_BLOCK_FRAMES);
+            AudioMixerDSP::MixAdd(parent.R, bus.R, bus.Volume, MIXER_BLOCK_FRAMES);
+        }
+
+        // Master bus
+        Bus& master = *Buses[0];
+        if (hasReverb)
+        {
+            {
+                PROFILE_CPU_NAMED("Reverb");
+                if (!master.HasInput)
+                {
+                    Platform::MemoryClear(master.L, sizeof(master.L));
+                    Platform::MemoryClear(master.R, sizeof(master.R));
+                }
+                ReverbEffect.Process(reverbL, master.L, 0, MIXER_BLOCK_FRAMES);
+                ReverbEffect.Process(reverbR, master.R, 1, MIXER_BLOCK_FRAMES);
+            }
+            master.HasInput = true;
+        }
+        if (master.HasInput)
+        {
+            AudioMixerDSP::Scale(master.L, MasterVolume, MIXER_BLOCK_FRAMES);
+            AudioMixerDSP::Scale(master.R, MasterVolume, MIXER_BLOCK_FRAMES);
+            AudioMixerDSP::ConvertToInt16(master.L, master.R, output, MIXER_BLOCK_FRAMES);
+        }
+        else
+        {
+            Platform::MemoryClear(output, MIXER_BLOCK_FRAMES * 2 * sizeof(int16));
+        }
+    }
+
+    int32 Run()
+    {
+        Array<int16> output;
+        output.Resize(MIXER_BLOCK_FRAMES * 2);
+        while (Platform::AtomicRead(&MixerThreadActive))
+        {
+            ProcessCommands();
+            Mix(output.Get());
+            Device->Submit(output.Get(), MIXER_BLOCK_FRAMES);
+        }
+        return 0;
+    }
+
+    void FreeData(BufferData* data)
+    {
+        Allocator::Free(data->Samples);
+        Delete(data);
+    }
+}
+
+using namespace Mixer;
+
+void AudioBackendMixer::Listener_OnAdd(AudioListener* listener)
+{
+    if (Audio::Listeners.HasItems() && Audio::Listeners[0] == listener)
+        PostListener(listener);
+}
+
+void AudioBackendMixer::Listener_OnRemove(AudioListener* listener)
+{
+    // Mixer uses the first listener for spatial audio
+    PostListener(Audio::Listeners.HasItems() && Audio::Listeners[0] != listener ? Audio::Listeners[0] : nullptr);
+}
+
+void AudioBackendMixer::Listener_VelocityChanged(AudioListener* listener)
+{
+    Listener_OnAdd(listener);
+}
+
+void AudioBackendMixer::Listener_TransformChanged(AudioListener* listener)
+{
+    Listener_OnAdd(listener);
+}
+
+void AudioBackendMixer::Source_OnAdd(AudioSource* source)
+{
+    uint32 id;
+    if (FreeVoiceIds.HasItems())
+    {
+        id = FreeVoiceIds.Pop();
+    }
+    else if (NextVoiceId <= MIXER_MAX_VOICES)
+    {
+        id = NextVoiceId++;
+    }
+    else
+    {
+        LOG(Warning, "Audio mixer voices limit reached ({0}).", MIXER_MAX_VOICES);
+        return;
+    }
+    GameVoice& gameVoice = GameVoices[id - 1];
+    gameVoice.Queued = 0;
+    gameVoice.Dequeued = 0;
+    gameVoice.Generation++;
+    source->SourceIDs.Add(id);
+    PostCommand(CommandTypes::VoiceAdd, id, (uint32)gameVoice.Generation);
+    PostVoiceParams(source);
+    PostVoiceTransform(source);
+}
+
+void AudioBackendMixer::Source_OnRemove(AudioSource* source)
+{
+    source->Cleanup();
+}
+
+void AudioBackendMixer::Source_VelocityChanged(AudioSource* source)
+{
+    PostVoiceTransform(source);
+}
+
+void AudioBackendMixer::Source_TransformChanged(AudioSource* source)
+{
+    PostVoiceTransform(source);
+}
+
+void AudioBackendMixer::Source_VolumeChanged(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_PitchChanged(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_IsLoopingChanged(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_MinDistanceChanged(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_AttenuationChanged(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_ClipLoaded(AudioSource* source)
+{
+    PostVoiceParams(source);
+}
+
+void AudioBackendMixer::Source_Cleanup(AudioSource* source)
+{
+    for (const uint32 id : source->SourceIDs)
+    {
+        PostCommand(CommandTypes::VoiceRemove, id);
+        FreeVoiceIds.Add(id);
+    }
+}
+
+void AudioBackendMixer::Source_Play(AudioSource* source)
+{
+    // Update the bus routing and looping state (could be changed)
+    PostVoiceParams(source);
+    if (source->SourceIDs.HasItems())
+        PostCommand(CommandTypes::VoicePlay, source->SourceIDs[0]);
+}
+
+void AudioBackendMixer::Source_Pause(AudioSource* source)
+{
+    if (source->SourceIDs.HasItems())
+        PostCommand(CommandTypes::VoicePause, source->SourceIDs[0]);
+}
+
+void AudioBackendMixer::Source_Stop(AudioSource* source)
+{
+    GameVoice* gameVoice = GetGameVoice(source);
+    if (!gameVoice)
+        return;
+
+    // Ignore the voice playback state published by the mixer until it processes the stop
+    gameVoice->Queued = 0;
+    gameVoice->Dequeued = 0;
+    gameVoice->Generation++;
+    PostCommand(CommandTypes::VoiceStop, source->SourceIDs[0], (uint32)gameVoice->Generation);
+}
+
+void AudioBackendMixer::Source_SetCurrentBufferTime(AudioSource* source, float value)
+{
+    if (source->SourceIDs.IsEmpty())
+        return;
+    Command cmd;
+    cmd.Type = CommandTypes::VoiceSetTime;
+    cmd.Id = source->SourceIDs[0];
+    cmd.Value = 0;
+    cmd.Params[0] = value;
+    Commands.Add(cmd);
+}
+
+float AudioBackendMixer::Source_GetCurrentBufferTime(const AudioSource* source)
+{
+    if (source->SourceIDs.IsEmpty() || !IsStateValid(source->SourceIDs[0]))
+        return 0.0f;
+    const int64 time = Platform::AtomicRead(&VoiceStates[source->SourceIDs[0] - 1].Time);
+    return (float)((double)time / 1000000.0);
+}
+
+void AudioBackendMixer::Source_SetNonStreamingBuffer(AudioSource* source)
+{
+    if (source->SourceIDs.HasItems())
+        PostCommand(CommandTypes::VoiceSetBuffer, source->SourceIDs[0], source->Clip->Buffers[0]);
+}
+
+void AudioBackendMixer::Source_GetProcessedBuffersCount(AudioSource* source, int32& processedBuffersCount)
+{
+    processedBuffersCount = 0;
+    GameVoice* gameVoice = GetGameVoice(source);
+    if (!gameVoice || !IsStateValid(source->SourceIDs[0]))
+        return;
+    const int64 processed = Platform::AtomicRead(&VoiceStates[source->SourceIDs[0] - 1].Processed);
+    processedBuffersCount = (int32)Math::Clamp<int64>(processed - gameVoice->Dequeued, 0, gameVoice->Queued - gameVoice->Dequeued);
+}
+
+void AudioBackendMixer::Source_GetQueuedBuffersCount(AudioSource* source, int32& queuedBuffersCount)
+{
+    GameVoice* gameVoice = GetGameVoice(source);
+    queuedBuffersCount = gameVoice ? (int32)(gameVoice->Queued - gameVoice->Dequeued) : 0;
+}
+
+void AudioBackendMixer::Source_QueueBuffer(AudioSource* source, uint32 bufferId)
+{
+    GameVoice* gameVoice = GetGameVoice(source);
+    if (!gameVoice)
+        return;
+    gameVoice->Queued++;
+    PostCommand(CommandTypes::VoiceQueueBuffer, source->SourceIDs[0], bufferId);
+}
+
+void AudioBackendMixer::Source_DequeueProcessedBuffers(AudioSource* source)
+{
+    int32 count;
+    Source_GetProcessedBuffersCount(source, count);
+    if (count <= 0)
+        return;
+    GameVoice* gameVoice = GetGameVoice(source);
+    gameVoice->Dequeued += count;
+    PostCommand(CommandTypes::VoiceDequeue, source->SourceIDs[0], count);
+}
+
+void AudioBackendMixer::Buffer_Create(uint32& bufferId)
+{
+    ScopeLock lock(BuffersLocker);
+    if (FreeBufferIds.HasItems())
+    {
+        bufferId = FreeBufferIds.Pop();
+    }
+    else if (NextBufferId <= MIXER_MAX_BUFFERS)
+    {
+        bufferId = NextBufferId++;
+    }
+    else
+    {
+        LOG(Warning, "Audio mixer buffers limit reached ({0}).", MIXER_MAX_BUFFERS);
+        bufferId = AUDIO_BUFFER_ID_INVALID;
+    }
+}
+
+void AudioBackendMixer::Buffer_Delete(uint32& bufferId)
+{
+    // Buffer id gets released once mixer stops using it
+    if (bufferId != AUDIO_BUFFER_ID_INVALID)
+        PostCommand(CommandTypes::BufferDelete, 0, bufferId);
+    bufferId = AUDIO_BUFFER_ID_INVALID;
+}
+
+void AudioBackendMixer::Buffer_Write(uint32 bufferId, byte* samples, const AudioDataInfo& info)
+{
+    PROFILE_CPU();
+    if (bufferId == AUDIO_BUFFER_ID_INVALID)
+        return;
+
+    // Convert data to float samples
+    auto data = New<BufferData>();
+    data->Channels = Math::Max<int32>(info.NumChannels, 1);
+    data->Frames = info.NumSamples / data->Channels;
+    data->SampleRate = info.SampleRate;
+    data->Refs = 0;
+    data->Samples = (float*)Allocator::Allocate(Math::Max<uint64>(info.NumSamples, 1) * sizeof(float));
+    AudioTool::ConvertToFloat(samples, info.BitDepth, data->Samples, info.NumSamples);
+
+    // Publish data to the mixer (discard the previous data if it was not used)
+    BufferData* prev = (BufferData*)Platform::InterlockedExchange(&Buffers[bufferId - 1].Pending, (int64)data);
+    if (prev)
+        FreeData(prev);
+}
+
+const Char* AudioBackendMixer::Base_Name()
+{
+    return TEXT("Mixer");
+}
+
+void AudioBackendMixer::Base_OnActiveDeviceChanged()
+{
+}
+
+void AudioBackendMixer::Base_SetDopplerFactor(float value)
+{
+    Command cmd;
+    cmd.Type = CommandTypes::DopplerFactor;
+    cmd.Id = 0;
+    cmd.Value = 0;
+    cmd.Params[0] = value;
+    Commands.Add(cmd);
+}
+
+void AudioBackendMixer::Base_SetVolume(float value)
+{
+    Command cmd;
+    cmd.Type = CommandTypes::Volume;
+    cmd.Id = 0;
+    cmd.Value = 0;
+    cmd.Params[0] = value;
+    Commands.Add(cmd);
+}
+
+bool AudioBackendMixer::Base_Init()
+{
+    const auto settings = AudioSettings::Get();
+    SampleRate = Math::Clamp(settings->MixerSampleRate, 8000, 192000);
+
+    // Allocate resources
+    Buffers = (BufferSlot*)Allocator::Allocate(sizeof(BufferSlot) * MIXER_MAX_BUFFERS);
+    Platform::MemoryClear(Buffers, sizeof(BufferSlot) * MIXER_MAX_BUFFERS);
+    GameVoices = (GameVoice*)Allocator::Allocate(sizeof(GameVoice) * MIXER_MAX_VOICES);
+    Platform::MemoryClear(GameVoices, sizeof(GameVoice) * MIXER_MAX_VOICES);
+    VoiceStates = (VoiceState*)Allocator::Allocate(sizeof(VoiceState) * MIXER_MAX_VOICES);
+    Platform::MemoryClear(VoiceStates, sizeof(VoiceState) * MIXER_MAX_VOICES);
+    Voices = NewArray<Voice>(MIXER_MAX_VOICES);
+    for (int32 i = 0; i < MIXER_MAX_VOICES; i++)
+    {
+        Voice& voice = Voices[i];
+        voice.Active = voice.Playing = voice.Loop = voice.Is3D = voice.HasGains = false;
+        voice.Bus = 0;
+        voice.Volume = voice.Pitch = voice.MinDistance = voice.Attenuation = 1.0f;
+        voice.Position = voice.Velocity = Float3::Zero;
+        voice.StaticBuffer = nullptr;
+        voice.Current = 0;
+        voice.PlaybackPosition = 0.0;
+        voice.GainL = voice.GainR = 0.0f;
+        voice.Processed = voice.Generation = 0;
+    }
+    VoicesCount = 0;
+
+    // Setup buses
+    const int32 busesCount = Math::Min(settings->MixerBuses.Count() + 1, MIXER_MAX_BUSES);
+    if (busesCount <= settings->MixerBuses.Count())
+        LOG(Warning, "Audio mixer buses limit reached ({0}).", MIXER_MAX_BUSES);
+    for (int32 i = 0; i < busesCount; i++)
+    {
+        auto bus = New<Bus>();
+        Platform::MemoryClear(bus, sizeof(Bus));
+        bus->Volume = 1.0f;
+        bus->LowPass = 1.0f;
+        if (i != 0)
+        {
+            const AudioMixerBus& desc = settings->MixerBuses[i - 1];
+            bus->Parent = desc.Parent + 1;
+            if (bus->Parent < 0 || bus->Parent >= i)
+            {
+                if (desc.Parent != -1)
+                    LOG(Warning, "Invalid parent of the audio mixer bus {0}. Parent bus has to be placed before its children.", desc.Name);
+                bus->Parent = 0;
+            }
+            bus->Volume = Math::Saturate(desc.Volume);
+            bus->LowPass = desc.LowPassFrequency > 0.0f ? AudioMixerDSP::GetLowPassCoefficient(desc.LowPassFrequency, (float)SampleRate) : 1.0f;
+            bus->ReverbSend = Math::Saturate(desc.ReverbSend);
+        }
+        Buses.Add(bus);
+    }
+    ReverbEffect.Decay = Math::Clamp(settings->MixerReverbDecay, 0.0f, 0.98f);
+    ReverbEffect.Init(SampleRate);
+
+    // Open the output device
+#if AUDIO_API_OPENAL
+    Device = New<OutputOpenAL>();
+    if (Device->Init(SampleRate))
+    {
+        LOG(Warning, "Failed to open audio device for the mixer output.");
+        Device->Dispose();
+        Delete(Device);
+        Device = nullptr;
+    }
+#endif
+    if (!Device)
+    {
+        Device = New<OutputNull>();
+        Device->Init(SampleRate);
+    }
+    LOG(Info, "Audio mixer output: {0}, {1} Hz, {2} buses", Device->GetName(), SampleRate, Buses.Count());
+    auto& devices = Audio::Devices;
+    devices.Resize(1);
+    devices[0].Name = TEXT("Default device");
+    Audio::SetActiveDeviceIndex(0);
+
+    // Start mixing
+    Platform::AtomicStore(&MixerThreadActive, 1);
+    MixerThread = ThreadSpawner::Start(Run, TEXT("Audio Mixer"), ThreadPriority::Highest);
+    return false;
+}
+
+void AudioBackendMixer::Base_Update()
+{
+    // Release data no longer used by the mixer
+    BufferData* data;
+    while (ReleasedData.try_dequeue(data))
+        FreeData(data);
+    uint32 bufferId;
+    if (ReleasedBufferIds.Count() != 0)
+    {
+        ScopeLock lock(BuffersLocker);
+        while (ReleasedBufferIds.try_dequeue(bufferId))
+            FreeBufferIds.Add(bufferId);
+    }
+}
+
+void AudioBackendMixer::Base_Dispose()
+{
+    if (MixerThread)
+    {
+        Platform::AtomicStore(&MixerThreadActive, 0);
+        MixerThread->Join();
+        Delete(MixerThread);
+        MixerThread = nullptr;
+    }
+    if (Device)
+    {
+        Device->Dispose();
+        Delete(Device);
+        Device = nullptr;
+    }
+
+    // Release resources
+    ProcessCommands();
+    for (int32 i = 0; i < MIXER_MAX_VOICES; i++)
+    {
+        Voice& voice = Voices[i];
+        ReleaseData(voice.StaticBuffer);
+        ClearQueue(voice);
+    }
+    for (int32 i = 0; i < MIXER_MAX_BUFFERS; i++)
+    {
+        BufferSlot& slot = Buffers[i];
+        if (slot.Pending)
+            FreeData((BufferData*)slot.Pending);
+        ReleaseData(slot.Current);
+    }
+    Base_Update();
+    DeleteArray(Voices, MIXER_MAX_VOICES);
+    Voices = nullptr;
+    Allocator::Free(VoiceStates);
+    VoiceStates = nullptr;
+    Allocator::Free(GameVoices);
+    GameVoices = nullptr;
+    Allocator::Free(Buffers);
+    Buffers = nullptr;
+    Buses.ClearDelete();
+    FreeBufferIds.Clear();
+    FreeVoiceIds.Clear();
+    NextBufferId = 1;
+    NextVoiceId = 1;
+}
+
+#endif
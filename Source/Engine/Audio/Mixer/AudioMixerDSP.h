@@ -0,0 +1,191 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Math/Mathd.h"
+#include "Engine/Core/SIMD.h"
+
+/// <summary>
+/// The vectorized DSP kernels used by the native audio mixer. Operate on the planar float streams (separate left and right channel) and process 4 frames at once.
+/// </summary>
+namespace AudioMixerDSP
+{
+    /// <summary>
+    /// Resamples the source audio (linear interpolation) and mixes it into the planar stereo output with a linear gain ramp over the mixed frames.
+    /// </summary>
+    /// <param name="outL">The output left channel samples (mixed into).</param>
+    /// <param name="outR">The output right channel samples (mixed into).</param>
+    /// <param name="frames">The amount of output frames to mix.</param>
+    /// <param name="src">The source samples (interleaved channels).</param>
+    /// <param name="srcFrames">The amount of source frames.</param>
+    /// <param name="srcChannels">The amount of source channels. Mono source is mixed into both output channels, stereo source is mixed per-channel (or downmixed to mono if <paramref name="downmix"/> is set). Other channels are ignored.</param>
+    /// <param name="downmix">True if downmix the stereo source into mono (eg. for spatial panning).</param>
+    /// <param name="position">The source playback position (in source frames, fractional). Advanced by the mixed frames.</param>
+    /// <param name="step">The source frames step per output frame (resampling ratio including pitch).</param>
+    /// <param name="gainL">The left channel gain at the first frame.</param>
+    /// <param name="gainR">The right channel gain at the first frame.</param>
+    /// <param name="gainStepL">The left channel gain change per output frame.</param>
+    /// <param name="gainStepR">The right channel gain change per output frame.</param>
+    /// <returns>The amount of mixed frames. Less than <paramref name="frames"/> if reached the end of the source.</returns>
+    inline int32 MixResampled(float* outL, float* outR, int32 frames, const float* src, int32 srcFrames, int32 srcChannels, bool downmix, double& position, float step, float gainL, float gainR, float gainStepL, float gainStepR)
+    {
+        // Limit mixed frames to the source data (last frame is interpolated with itself)
+        const double remaining = (double)srcFrames - position;
+        if (remaining <= 0.0)
+            return 0;
+        frames = (int32)Math::Min<double>(frames, Math::Ceil(remaining / step));
+        const int32 last = srcFrames - 1;
+        const bool stereo = srcChannels >= 2 && !downmix;
+        const float channelScale = srcChannels >= 2 && downmix ? 0.5f : 1.0f;
+        const SimdVector4 rampL = SIMD::Load(0.0f, gainStepL, gainStepL * 2.0f, gainStepL * 3.0f);
+        const SimdVector4 rampR = SIMD::Load(0.0f, gainStepR, gainStepR * 2.0f, gainStepR * 3.0f);
+        float a0[4], b0[4], a1[4], b1[4], t[4];
+        for (int32 i = 0; i < frames; i += 4)
+        {
+            // Gather source samples for 4 frames (scalar due to the fractional positions)
+            const int32 count = Math::Min(frames - i, 4);
+            for (int32 k = 0; k < 4; k++)
+            {
+                const double p = position + step * (double)Math::Min(k, count - 1);
+                const int32 i0 = Math::Min((int32)p, last);
+                const int32 i1 = Math::Min(i0 + 1, last);
+                const float* s0 = src + i0 * srcChannels;
+                const float* s1 = src + i1 * srcChannels;
+                t[k] = (float)(p - (double)i0);
+                if (stereo)
+                {
+                    a0[k] = s0[0];
+                    b0[k] = s1[0];
+                    a1[k] = s0[1];
+                    b1[k] = s1[1];
+                }
+                else if (srcChannels >= 2)
+                {
+                    a0[k] = s0[0] + s0[1];
+                    b0[k] = s1[0] + s1[1];
+                }
+                else
+                {
+                    a0[k] = s0[0];
+                    b0[k] = s1[0];
+                }
+            }
+
+            // Interpolate (a + (b - a) * t) and apply gain ramp
+            const SimdVector4 frac = SIMD::LoadUnaligned(t);
+            const SimdVector4 gL = SIMD::Add(SIMD::Splat((gainL + gainStepL * (float)i) * channelScale), SIMD::Mul(rampL, SIMD::Splat(channelScale)));
+            const SimdVector4 gR = SIMD::Add(SIMD::Splat((gainR + gainStepR * (float)i) * channelScale), SIMD::Mul(rampR, SIMD::Splat(channelScale)));
+            SimdVector4 a = SIMD::LoadUnaligned(a0);
+            const SimdVector4 sampleL = SIMD::Add(a, SIMD::Mul(SIMD::Sub(SIMD::LoadUnaligned(b0), a), frac));
+            SimdVector4 sampleR = sampleL;
+            if (stereo)
+            {
+                a = SIMD::LoadUnaligned(a1);
+                sampleR = SIMD::Add(a, SIMD::Mul(SIMD::Sub(SIMD::LoadUnaligned(b1), a), frac));
+            }
+            const SimdVector4 mixL = SIMD::Mul(sampleL, gL);
+            const SimdVector4 mixR = SIMD::Mul(sampleR, gR);
+            if (count == 4)
+            {
+                SIMD::StoreUnaligned(outL + i, SIMD::Add(SIMD::LoadUnaligned(outL + i), mixL));
+                SIMD::StoreUnaligned(outR + i, SIMD::Add(SIMD::LoadUnaligned(outR + i), mixR));
+            }
+            else
+            {
+                SIMD::StoreUnaligned(a0, mixL);
+                SIMD::StoreUnaligned(a1, mixR);
+                for (int32 k = 0; k < count; k++)
+                {
+                    outL[i + k] += a0[k];
+                    outR[i + k] += a1[k];
+                }
+            }
+            position += step * (double)count;
+        }
+        return frames;
+    }
+
+    /// <summary>
+    /// Mixes the scaled stream into the other stream (dst[i] += src[i] * gain).
+    /// </summary>
+    inline void MixAdd(float* dst, const float* src, float gain, int32 count)
+    {
+        const SimdVector4 g = SIMD::Splat(gain);
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+            SIMD::StoreUnaligned(dst + i, SIMD::Add(SIMD::LoadUnaligned(dst + i), SIMD::Mul(SIMD::LoadUnaligned(src + i), g)));
+        for (; i < count; i++)
+            dst[i] += src[i] * gain;
+    }
+
+    /// <summary>
+    /// Scales the stream (data[i] *= gain).
+    /// </summary>
+    inline void Scale(float* data, float gain, int32 count)
+    {
+        const SimdVector4 g = SIMD::Splat(gain);
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+            SIMD::StoreUnaligned(data + i, SIMD::Mul(SIMD::LoadUnaligned(data + i), g));
+        for (; i < count; i++)
+            data[i] *= gain;
+    }
+
+    /// <summary>
+    /// Gets the one-pole low-pass filter coefficient for the given cutoff frequency.
+    /// </summary>
+    /// <param name="cutoff">The cutoff frequency (in Hz).</param>
+    /// <param name="sampleRate">The sample rate (in Hz).</param>
+    /// <returns>The filter coefficient (1 passes the signal unchanged).</returns>
+    inline float GetLowPassCoefficient(float cutoff, float sampleRate)
+    {
+        return Math::Saturate(1.0f - Math::Exp(-2.0f * PI * cutoff / sampleRate));
+    }
+
+    /// <summary>
+    /// Applies the one-pole low-pass filter to the stream (state[n] = state[n - 1] + (data[n] - state[n - 1]) * coefficient).
+    /// </summary>
+    /// <param name="data">The samples stream.</param>
+    /// <param name="count">The samples count.</param>
+    /// <param name="coefficient">The filter coefficient (see GetLowPassCoefficient).</param>
+    /// <param name="state">The filter state (last output sample), preserved between the calls.</param>
+    inline void LowPass(float* data, int32 count, float coefficient, float& state)
+    {
+        // Recursive filter so run it in scalar
+        float y = state;
+        for (int32 i = 0; i < count; i++)
+        {
+            y += (data[i] - y) * coefficient;
+            data[i] = y;
+        }
+        state = y;
+    }
+
+    /// <summary>
+    /// Converts the planar stereo stream into the interleaved 16-bit PCM stream (with clipping).
+    /// </summary>
+    inline void ConvertToInt16(const float* srcL, const float* srcR, int16* dst, int32 frames)
+    {
+        const SimdVector4 minValue = SIMD::Splat(-1.0f);
+        const SimdVector4 maxValue = SIMD::Splat(1.0f);
+        const SimdVector4 scale = SIMD::Splat(32767.0f);
+        float l[4], r[4];
+        int32 i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            SIMD::StoreUnaligned(l, SIMD::Mul(SIMD::Min(SIMD::Max(SIMD::LoadUnaligned(srcL + i), minValue), maxValue), scale));
+            SIMD::StoreUnaligned(r, SIMD::Mul(SIMD::Min(SIMD::Max(SIMD::LoadUnaligned(srcR + i), minValue), maxValue), scale));
+            for (int32 k = 0; k < 4; k++)
+            {
+                dst[(i + k) * 2 + 0] = (int16)l[k];
+                dst[(i + k) * 2 + 1] = (int16)r[k];
+            }
+        }
+        for (; i < frames; i++)
+        {
+            dst[i * 2 + 0] = (int16)(Math::Clamp(srcL[i], -1.0f, 1.0f) * 32767.0f);
+            dst[i * 2 + 1] = (int16)(Math::Clamp(srcR[i], -1.0f, 1.0f) * 32767.0f);
+        }
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Types/DateTime.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "FlaxEngine.Gen.h"
+
+namespace
+{
+    struct BenchmarkEntry
+    {
+        const Char* Name;
+        BenchmarkFunction Function;
+    };
+
+    Array<BenchmarkEntry>& GetRegistry()
+    {
+        static Array<BenchmarkEntry> registry;
+        return registry;
+    }
+}
+
+int32 Benchmark::WarmupSamples = 3;
+int32 Benchmark::Samples = 20;
+double Benchmark::MinSampleTime = 0.005;
+const void* volatile Benchmark::Sink = nullptr;
+
+void BenchmarkState::Pause()
+{
+    _pauseStart = Platform::GetTimeSeconds();
+}
+
+void BenchmarkState::Resume()
+{
+    _pausedTime += Platform::GetTimeSeconds() - _pauseStart;
+}
+
+double Benchmark::RunSample(BenchmarkFunction function, BenchmarkState& state)
+{
+    state._pausedTime = 0.0;
+    const double startTime = Platform::GetTimeSeconds();
+    function(state);
+    const double endTime = Platform::GetTimeSeconds();
+    return Math::Max(endTime - startTime - state._pausedTime, 0.0);
+}
+
+Benchmark::Registration::Registration(const Char* name, BenchmarkFunction function)
+{
+    GetRegistry().Add({ name, function });
+}
+
+void Benchmark::Run(const StringView& filter, Array<Result>& results)
+{
+    auto& registry = GetRegistry();
+    const String filterText(filter);
+    Array<double> samples;
+    for (const BenchmarkEntry& e : registry)
+    {
+        const String name(e.Name);
+        if (filterText.HasChars() && !name.Contains(filterText, StringSearchCase::IgnoreCase))
+            continue;
+
+        // Pick the amount of iterations so the single sample takes enough time to be measured accurately
+        BenchmarkState state;
+        state.Iterations = 1;
+        double time = RunSample(e.Function, state);
+        while (time < MinSampleTime && state.Iterations < (1 << 28))
+        {
+            const double scale = time > ZeroTolerance ? MinSampleTime / time * 1.2 : 10.0;
+            state.Iterations = (int32)Math::Min<int64>((int64)(state.Iterations * Math::Clamp(scale, 2.0, 10.0)), 1 << 28);
+            time = RunSample(e.Function, state);
+        }
+
+        // Warmup
+        for (int32 i = 0; i < WarmupSamples; i++)
+            RunSample(e.Function, state);
+
+        // Measure
+        samples.Clear();
+        for (int32 i = 0; i < Samples; i++)
+            samples.Add(RunSample(e.Function, state) * 1000000000.0 / state.Iterations);
+        Sorting::QuickSort(samples.Get(), samples.Count());
+
+        // Calculate statistics
+        Result& result = results.AddOne();
+        result.Name = name;
+        result.Samples = samples.Count();
+        result.Iterations = state.Iterations;
+        result.Min = samples.First();
+        result.Max = samples.Last();
+        result.Median = samples.Count() % 2 == 0 ? (samples[samples.Count() / 2 - 1] + samples[samples.Count() / 2]) * 0.5 : samples[samples.Count() / 2];
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+        result.Mean = sum / samples.Count();
+        double variance = 0.0;
+        for (double sample : samples)
+            variance += (sample - result.Mean) * (sample - result.Mean);
+        result.StdDev = sqrt(variance / Math::Max(samples.Count() - 1, 1));
+
+        LOG(Info, "{0}: {1} ns/op (median: {2} ns, min: {3} ns, max: {4} ns, stddev: {5} ns, {6} iterations x {7} samples)", result.Name, result.Mean, result.Median, result.Min, result.Max, result.StdDev, result.Iterations, result.Samples);
+    }
+}
+
+bool Benchmark::SaveResults(const StringView& path, const Array<Result>& results)
+{
+    rapidjson_flax::StringBuffer buffer;
+    PrettyJsonWriter writerObj(buffer);
+    JsonWriter& writer = writerObj;
+    writer.StartObject();
+    {
+        writer.JKEY("EngineVersion");
+        writer.String(FLAXENGINE_VERSION_TEXT);
+        writer.JKEY("Date");
+        writer.DateTime(DateTime::NowUTC());
+        writer.JKEY("Benchmarks");
+        writer.StartArray();
+        for (const Result& result : results)
+        {
+            writer.StartObject();
+            writer.JKEY("Name");
+            writer.String(result.Name);
+            writer.JKEY("Samples");
+            writer.Int(result.Samples);
+            writer.JKEY("Iterations");
+            writer.Int(result.Iterations);
+            writer.JKEY("Min");
+            writer.Double(result.Min);
+            writer.JKEY("Max");
+            writer.Double(result.Max);
+            writer.JKEY("Mean");
+            writer.Double(result.Mean);
+            writer.JKEY("Median");
+            writer.Double(result.Median);
+            writer.JKEY("StdDev");
+            writer.Double(result.StdDev);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+    return File::WriteAllBytes(path, (const byte*)buffer.GetString(), (int32)buffer.GetSize());
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Array.h"
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// The state of the running benchmark passed to the benchmark function.
+/// </summary>
+struct BenchmarkState
+{
+    friend class Benchmark;
+private:
+    double _pausedTime = 0.0;
+    double _pauseStart = 0.0;
+
+public:
+    /// <summary>
+    /// The amount of operations to execute by the benchmark function (within a single measured sample). Picked by the harness so the sample takes enough time to be measured accurately.
+    /// </summary>
+    int32 Iterations = 1;
+
+public:
+    /// <summary>
+    /// Pauses the time measurement (eg. to exclude the data setup from the results).
+    /// </summary>
+    void Pause();
+
+    /// <summary>
+    /// Resumes the time measurement after Pause.
+    /// </summary>
+    void Resume();
+};
+
+/// <summary>
+/// The benchmark function. Executes the measured operation state.Iterations times.
+/// </summary>
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+/// <summary>
+/// Microbenchmarks harness. Runs the registered benchmarks with warmup and multiple measured samples and reports the statistics of the operation time.
+/// </summary>
+class Benchmark
+{
+public:
+    /// <summary>
+    /// The benchmark registration utility (used by BENCHMARK macro).
+    /// </summary>
+    struct Registration
+    {
+        Registration(const Char* name, BenchmarkFunction function);
+    };
+
+    /// <summary>
+    /// The benchmark results (times are per single operation, in nanoseconds).
+    /// </summary>
+    struct Result
+    {
+        String Name;
+        int32 Samples;
+        int32 Iterations;
+        double Min;
+        double Max;
+        double Mean;
+        double Median;
+        double StdDev;
+    };
+
+public:
+    /// <summary>
+    /// The amount of not measured samples executed before the measurement (eg. to warmup caches and memory allocators).
+    /// </summary>
+    static int32 WarmupSamples;
+
+    /// <summary>
+    /// The amount of measured samples per benchmark.
+    /// </summary>
+    static int32 Samples;
+
+    /// <summary>
+    /// The minimum duration of the single sample (in seconds). Used to pick the amount of iterations per sample.
+    /// </summary>
+    static double MinSampleTime;
+
+    /// <summary>
+    /// Runs the registered benchmarks.
+    /// </summary>
+    /// <param name="filter">The benchmarks name filter (only benchmarks which name contains this text are executed). Empty to run all.</param>
+    /// <param name="results">The output results.</param>
+    static void Run(const StringView& filter, Array<Result>& results);
+
+    /// <summary>
+    /// Saves the benchmarks results to the JSON file.
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <param name="results">The results.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool SaveResults(const StringView& path, const Array<Result>& results);
+
+    /// <summary>
+    /// Prevents the compiler from optimizing away the value computed by the benchmark.
+    /// </summary>
+    /// <param name="value">The value.</param>
+    template<typename T>
+    FORCE_INLINE static void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        Sink = &value;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+private:
+    static const void* volatile Sink;
+
+    static double RunSample(BenchmarkFunction function, BenchmarkState& state);
+};
+
+#define _BENCHMARK_INTERNAL(function, name) \
+    static void function(BenchmarkState& state); \
+    static Benchmark::Registration CONCAT_MACROS(function, _Registration)(TEXT(name), function); \
+    static void function(BenchmarkState& state)
+
+/// <summary>
+/// Defines the benchmark function with the given name (eg. BENCHMARK("Array.Add") { for (int32 i = 0; i < state.Iterations; i++) ... }).
+/// </summary>
+#define BENCHMARK(name) _BENCHMARK_INTERNAL(CONCAT_MACROS(Benchmark_, __LINE__), name)
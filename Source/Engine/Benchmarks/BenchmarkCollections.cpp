@@ -0,0 +1,352 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
+
+// The amount of items used by the collections benchmarks (single operation processes all items)
+#define COLLECTION_ITEMS 1000
+
+namespace
+{
+    void InitRandomKeys(Array<int32>& keys)
+    {
+        RandomStream rand(100);
+        keys.Resize(COLLECTION_ITEMS);
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            keys[i] = rand.RandRange(0, MAX_int32 - 1);
+    }
+}
+
+BENCHMARK("Array.Add (1000 items)")
+{
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        Array<int32> array;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            array.Add(i);
+        Benchmark::DoNotOptimize(array.Get());
+    }
+}
+
+BENCHMARK("Array.Iterate (1000 items)")
+{
+    Array<int32> array;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        array.Add(i);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 sum = 0;
+        for (int32 value : array)
+            sum += value;
+        Benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK("Array.Find (1000 items)")
+{
+    Array<int32> array;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        array.Add(i);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        const int32 index = array.Find(iteration % COLLECTION_ITEMS);
+        Benchmark::DoNotOptimize(index);
+    }
+}
+
+BENCHMARK("Array.RemoveAtKeepOrder (1000 items)")
+{
+    Array<int32> array;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        state.Pause();
+        array.Clear();
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            array.Add(i);
+        state.Resume();
+        while (array.HasItems())
+            array.RemoveAtKeepOrder(0);
+        Benchmark::DoNotOptimize(array.Get());
+    }
+}
+
+BENCHMARK("Dictionary.Add (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        Dictionary<int32, int32> dictionary;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            dictionary[keys[i]] = i;
+        Benchmark::DoNotOptimize(dictionary.Count());
+    }
+}
+
+BENCHMARK("Dictionary.TryGet (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    Dictionary<int32, int32> dictionary;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        dictionary[keys[i]] = i;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 sum = 0, value;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        {
+            if (dictionary.TryGet(keys[i], value))
+                sum += value;
+        }
+        Benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK("FlatDictionary.TryGet (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    FlatDictionary<int32, int32> dictionary;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        dictionary[keys[i]] = i;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 sum = 0, value;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        {
+            if (dictionary.TryGet(keys[i], value))
+                sum += value;
+        }
+        Benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK("Dictionary.Remove (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    Dictionary<int32, int32> dictionary;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        state.Pause();
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            dictionary[keys[i]] = i;
+        state.Resume();
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            dictionary.Remove(keys[i]);
+        Benchmark::DoNotOptimize(dictionary.Count());
+    }
+}
+
+BENCHMARK("HashSet.Add (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        HashSet<int32> set;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            set.Add(keys[i]);
+        Benchmark::DoNotOptimize(set.Count());
+    }
+}
+
+BENCHMARK("HashSet.Contains (1000 items)")
+{
+    Array<int32> keys;
+    InitRandomKeys(keys);
+    HashSet<int32> set;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        set.Add(keys[i]);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 count = 0;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            count += set.Contains(keys[i]) ? 1 : 0;
+        Benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK("ChunkedArray.Add (1000 items)")
+{
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        ChunkedArray<int32, 256> array;
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            array.Add(i);
+        Benchmark::DoNotOptimize(array.Count());
+    }
+}
+
+BENCHMARK("ChunkedArray.Iterate (1000 items)")
+{
+    ChunkedArray<int32, 256> array;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        array.Add(i);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 sum = 0;
+        for (int32 i = 0; i < array.Count(); i++)
+            sum += array[i];
+        Benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK("Sorting.QuickSort (1000 items)")
+{
+    Array<int32> keys, array;
+    InitRandomKeys(keys);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        state.Pause();
+        array = keys;
+        state.Resume();
+        Sorting::QuickSort(array.Get(), array.Count());
+        Benchmark::DoNotOptimize(array.Get());
+    }
+}
+
+BENCHMARK("Sorting.QuickSort Sorted (1000 items)")
+{
+    Array<int32> array;
+    for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+        array.Add(i);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        Sorting::QuickSort(array.Get(), array.Count());
+        Benchmark::DoNotOptimize(array.Get());
+    }
+}
+
+namespace
+{
+    // Non-POD item similar to the render list batched draw call (payload with heap-allocated instances list)
+    struct RelocatableItem
+    {
+        int32 Payload[16];
+        Array<int32> Instances;
+    };
+
+    // The same item but without trivial relocation (moved via move constructor and destructor)
+    struct NonRelocatableItem
+    {
+        int32 Payload[16];
+        Array<int32> Instances;
+    };
+}
+
+template<>
+struct TIsTriviallyRelocatable<RelocatableItem>
+{
+    enum { Value = true };
+};
+
+namespace
+{
+    template<typename T>
+    void InitItems(Array<T>& array)
+    {
+        array.Resize(COLLECTION_ITEMS);
+        for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+            array[i].Instances.Add(i);
+    }
+
+    template<typename T>
+    void BenchmarkArrayGrow(BenchmarkState& state)
+    {
+        for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        {
+            Array<T> array;
+            for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+                array.AddOne().Instances.Add(i);
+            Benchmark::DoNotOptimize(array.Get());
+        }
+    }
+
+    template<typename T>
+    void BenchmarkArrayInsert(BenchmarkState& state)
+    {
+        const T item = {};
+        for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        {
+            Array<T> array;
+            array.EnsureCapacity(COLLECTION_ITEMS);
+            for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+                array.Insert(0, item);
+            Benchmark::DoNotOptimize(array.Get());
+        }
+    }
+
+    template<typename T>
+    void BenchmarkArrayRemoveAtKeepOrder(BenchmarkState& state)
+    {
+        Array<T> array;
+        for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        {
+            state.Pause();
+            InitItems(array);
+            state.Resume();
+            while (array.HasItems())
+                array.RemoveAtKeepOrder(0);
+            Benchmark::DoNotOptimize(array.Get());
+        }
+    }
+
+    template<typename T>
+    void BenchmarkDictionaryGrow(BenchmarkState& state)
+    {
+        for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        {
+            Dictionary<int32, T> dictionary;
+            for (int32 i = 0; i < COLLECTION_ITEMS; i++)
+                dictionary[i].Instances.Add(i);
+            Benchmark::DoNotOptimize(&dictionary);
+        }
+    }
+}
+
+BENCHMARK("Array.Grow NonRelocatable (1000 items)")
+{
+    BenchmarkArrayGrow<NonRelocatableItem>(state);
+}
+
+BENCHMARK("Array.Grow Relocatable (1000 items)")
+{
+    BenchmarkArrayGrow<RelocatableItem>(state);
+}
+
+BENCHMARK("Array.Insert NonRelocatable (1000 items)")
+{
+    BenchmarkArrayInsert<NonRelocatableItem>(state);
+}
+
+BENCHMARK("Array.Insert Relocatable (1000 items)")
+{
+    BenchmarkArrayInsert<RelocatableItem>(state);
+}
+
+BENCHMARK("Array.RemoveAtKeepOrder NonRelocatable (1000 items)")
+{
+    BenchmarkArrayRemoveAtKeepOrder<NonRelocatableItem>(state);
+}
+
+BENCHMARK("Array.RemoveAtKeepOrder Relocatable (1000 items)")
+{
+    BenchmarkArrayRemoveAtKeepOrder<RelocatableItem>(state);
+}
+
+BENCHMARK("Dictionary.Grow NonRelocatable (1000 items)")
+{
+    BenchmarkDictionaryGrow<NonRelocatableItem>(state);
+}
+
+BENCHMARK("Dictionary.Grow Relocatable (1000 items)")
+{
+    BenchmarkDictionaryGrow<RelocatableItem>(state);
+}
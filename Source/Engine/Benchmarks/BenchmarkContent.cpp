@@ -0,0 +1,85 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Content/Cache/AssetsCache.h"
+#include "Engine/Content/Cache/AssetsCacheIndex.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/FileSystem.h"
+
+// The amount of assets used by the assets cache benchmarks (single operation looks up all assets)
+#define CONTENT_ASSETS 1000
+
+namespace
+{
+    void InitRegistry(AssetsCache::Registry& registry, Array<Guid>& ids)
+    {
+        ids.Resize(CONTENT_ASSETS);
+        for (int32 i = 0; i < CONTENT_ASSETS; i++)
+        {
+            const Guid id(i + 1, i * 7, i * 13, 1);
+            registry.Add(id, AssetsCache::Entry(id, TEXT("FlaxEngine.Texture"), String::Format(TEXT("Content/Textures/Texture{0}.flax"), i)));
+            ids[i] = id;
+        }
+    }
+}
+
+BENCHMARK("Content.GetAssetInfo (project assets)")
+{
+    const Array<Guid, HeapAllocation> ids = Content::GetAllAssets();
+    AssetInfo info;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 found = 0;
+        for (const Guid& id : ids)
+        {
+            if (Content::GetAssetInfo(id, info))
+                found++;
+        }
+        Benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK("AssetsCacheIndex.Load (1000 assets)")
+{
+    AssetsCache::Registry registry;
+    AssetsCache::PathsMapping pathsMapping;
+    Array<Guid> ids;
+    InitRegistry(registry, ids);
+    const String path = Globals::TemporaryFolder / TEXT("BenchmarkAssetsCache.idx");
+    if (AssetsCache::SaveIndex(path, registry, pathsMapping))
+        return;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        AssetsCacheIndex index;
+        index.Load(path);
+        Benchmark::DoNotOptimize(index.Count());
+        index.Unload();
+    }
+    FileSystem::DeleteFile(path);
+}
+
+BENCHMARK("AssetsCacheIndex.FindAsset (1000 assets)")
+{
+    AssetsCache::Registry registry;
+    AssetsCache::PathsMapping pathsMapping;
+    Array<Guid> ids;
+    InitRegistry(registry, ids);
+    const String path = Globals::TemporaryFolder / TEXT("BenchmarkAssetsCache.idx");
+    AssetsCacheIndex index;
+    if (AssetsCache::SaveIndex(path, registry, pathsMapping) || index.Load(path))
+        return;
+    AssetInfo info;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 found = 0;
+        for (const Guid& id : ids)
+        {
+            if (index.FindAsset(id, info))
+                found++;
+        }
+        Benchmark::DoNotOptimize(found);
+    }
+    index.Unload();
+    FileSystem::DeleteFile(path);
+}
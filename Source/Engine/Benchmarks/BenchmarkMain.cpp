@@ -0,0 +1,65 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC
+
+#include "Benchmark.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Scripting/Scripting.h"
+#include "Editor/Scripting/ScriptsBuilder.h"
+
+class BenchmarksRunnerService : public EngineService
+{
+public:
+    BenchmarksRunnerService()
+        : EngineService(TEXT("BenchmarksRunnerService"), 10000)
+    {
+    }
+
+    void Update() override;
+};
+
+BenchmarksRunnerService BenchmarksRunnerServiceInstance;
+
+void BenchmarksRunnerService::Update()
+{
+    // End if failed to perform a startup
+    if (ScriptsBuilder::LastCompilationFailed())
+    {
+        Engine::RequestExit(-1);
+        return;
+    }
+
+    // Wait for Editor to be ready for running benchmarks (eg. scripting loaded)
+    if (!ScriptsBuilder::IsReady() ||
+        !Scripting::IsEveryAssemblyLoaded() ||
+        !Scripting::HasGameModulesLoaded())
+        return;
+
+    // Run benchmarks
+    Log::Logger::WriteFloor();
+    LOG(Info, "Running Flax Benchmarks...");
+    Array<Benchmark::Result> results;
+    Benchmark::Run(CommandLine::Options.Benchmark.HasValue() ? CommandLine::Options.Benchmark.GetValue() : String::Empty, results);
+    int32 result = 0;
+    if (CommandLine::Options.BenchmarkOut.HasValue())
+    {
+        const String& path = CommandLine::Options.BenchmarkOut.GetValue();
+        if (Benchmark::SaveResults(path, results))
+        {
+            LOG(Error, "Failed to save benchmarks results to {0}", path);
+            result = -1;
+        }
+        else
+        {
+            LOG(Info, "Saved benchmarks results to {0}", path);
+        }
+    }
+    LOG(Info, "Result: {0} benchmark(s) executed", results.Count());
+    Log::Logger::WriteFloor();
+    Engine::RequestExit(result);
+}
+
+#endif
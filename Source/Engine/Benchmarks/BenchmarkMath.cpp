@@ -0,0 +1,167 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+
+// The amount of values used by the math benchmarks (single operation processes all values)
+#define MATH_ITEMS 1000
+
+namespace
+{
+    void InitRandomTransforms(Array<Matrix>& matrices, Array<Quaternion>& rotations)
+    {
+        RandomStream rand(100);
+        matrices.Resize(MATH_ITEMS);
+        rotations.Resize(MATH_ITEMS);
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+        {
+            rotations[i] = Quaternion::Euler(rand.RandRange(-180.0f, 180.0f), rand.RandRange(-180.0f, 180.0f), rand.RandRange(-180.0f, 180.0f));
+            const Float3 translation(rand.RandRange(-1000.0f, 1000.0f), rand.RandRange(-1000.0f, 1000.0f), rand.RandRange(-1000.0f, 1000.0f));
+            const Float3 scale(rand.RandRange(0.5f, 2.0f), rand.RandRange(0.5f, 2.0f), rand.RandRange(0.5f, 2.0f));
+            Matrix::Transformation(scale, rotations[i], translation, matrices[i]);
+        }
+    }
+
+    BoundingFrustum GetTestFrustum()
+    {
+        Matrix view, projection, viewProjection;
+        Matrix::LookAt(Float3(0, 100, -500), Float3::Zero, Float3::Up, view);
+        Matrix::PerspectiveFov(PI_OVER_2, 16.0f / 9.0f, 10.0f, 10000.0f, projection);
+        Matrix::Multiply(view, projection, viewProjection);
+        return BoundingFrustum(viewProjection);
+    }
+}
+
+BENCHMARK("Matrix.Multiply (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        Matrix result = Matrix::Identity;
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+            Matrix::Multiply(result, matrices[i], result);
+        Benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK("Matrix.Invert (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    Matrix result;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+        {
+            Matrix::Invert(matrices[i], result);
+            Benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK("Matrix.Transformation (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    Matrix result;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+        {
+            Matrix::Transformation(Float3::One, rotations[i], Float3(100.0f, 0.0f, (float)i), result);
+            Benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK("Quaternion.Multiply (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        Quaternion result = Quaternion::Identity;
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+            Quaternion::Multiply(result, rotations[i], result);
+        Benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK("Quaternion.Slerp (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    Quaternion result;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int32 i = 1; i < MATH_ITEMS; i++)
+        {
+            Quaternion::Slerp(rotations[i - 1], rotations[i], 0.3f, result);
+            Benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK("BoundingFrustum.SetMatrix (1000 values)")
+{
+    Array<Matrix> matrices;
+    Array<Quaternion> rotations;
+    InitRandomTransforms(matrices, rotations);
+    BoundingFrustum frustum;
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+        {
+            frustum.SetMatrix(matrices[i]);
+            Benchmark::DoNotOptimize(frustum);
+        }
+    }
+}
+
+BENCHMARK("BoundingFrustum.Intersects Box (1000 values)")
+{
+    const BoundingFrustum frustum = GetTestFrustum();
+    RandomStream rand(100);
+    Array<BoundingBox> boxes;
+    boxes.Resize(MATH_ITEMS);
+    for (int32 i = 0; i < MATH_ITEMS; i++)
+    {
+        const Vector3 center(rand.RandRange(-5000.0f, 5000.0f), rand.RandRange(-5000.0f, 5000.0f), rand.RandRange(-5000.0f, 5000.0f));
+        boxes[i] = BoundingBox(center - 50.0f, center + 50.0f);
+    }
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 count = 0;
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+            count += frustum.Intersects(boxes[i]) ? 1 : 0;
+        Benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK("BoundingFrustum.Intersects Sphere (1000 values)")
+{
+    const BoundingFrustum frustum = GetTestFrustum();
+    RandomStream rand(100);
+    Array<BoundingSphere> spheres;
+    spheres.Resize(MATH_ITEMS);
+    for (int32 i = 0; i < MATH_ITEMS; i++)
+        spheres[i] = BoundingSphere(Vector3(rand.RandRange(-5000.0f, 5000.0f), rand.RandRange(-5000.0f, 5000.0f), rand.RandRange(-5000.0f, 5000.0f)), 50.0f);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        int32 count = 0;
+        for (int32 i = 0; i < MATH_ITEMS; i++)
+            count += frustum.Intersects(spheres[i]) ? 1 : 0;
+        Benchmark::DoNotOptimize(count);
+    }
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/Memory/CrtAllocator.h"
+#include "Engine/Core/Memory/ThreadCacheAllocator.h"
+#include "Engine/Threading/JobSystem.h"
+
+namespace
+{
+    // Allocations throughput under the job system load (memory allocated and released by many threads at once)
+    template<typename AllocatorType>
+    void RunAllocations(BenchmarkState& state)
+    {
+        const int32 jobCount = JobSystem::GetThreadsCount() * 4;
+        const Function<void(int32)> job = [](int32 jobIndex)
+        {
+            void* ptrs[64];
+            for (int32 i = 0; i < 100; i++)
+            {
+                for (int32 j = 0; j < ARRAY_COUNT(ptrs); j++)
+                    ptrs[j] = AllocatorType::Allocate(16 + ((i + j + jobIndex) % 32) * 24);
+                for (int32 j = 0; j < ARRAY_COUNT(ptrs); j++)
+                    AllocatorType::Free(ptrs[j]);
+            }
+        };
+        for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+            JobSystem::Execute(job, jobCount);
+    }
+}
+
+BENCHMARK("CrtAllocator.Allocate+Free (all job threads)")
+{
+    RunAllocations<CrtAllocator>(state);
+}
+
+BENCHMARK("ThreadCacheAllocator.Allocate+Free (all job threads)")
+{
+    RunAllocations<ThreadCacheAllocator>(state);
+}
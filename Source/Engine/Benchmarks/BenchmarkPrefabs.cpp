@@ -0,0 +1,45 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Content/AssetReference.h"
+#include "Engine/Level/Actor.h"
+#include "Engine/Level/Prefabs/Prefab.h"
+#include "Engine/Level/Prefabs/PrefabManager.h"
+
+// The amount of prefab instances spawned by the single benchmark operation
+#define PREFAB_INSTANCES 100
+
+BENCHMARK("PrefabManager.SpawnPrefab (2 actors, 100 instances)")
+{
+    AssetReference<Prefab> prefab = Content::CreateVirtualAsset<Prefab>();
+    if (!prefab || prefab->Init(Prefab::TypeName,
+                                "["
+                                "{"
+                                "\"ID\": \"9a1c3c2f4f2a3e5a8b4d1e6f7a8b9c0d\","
+                                "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                "\"Name\": \"Bullet\""
+                                "},"
+                                "{"
+                                "\"ID\": \"1b2c3d4e5f60718293a4b5c6d7e8f901\","
+                                "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                "\"ParentID\": \"9a1c3c2f4f2a3e5a8b4d1e6f7a8b9c0d\","
+                                "\"Name\": \"Bullet.Trail\""
+                                "}"
+                                "]"))
+        return;
+    Actor* instances[PREFAB_INSTANCES];
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int32 i = 0; i < PREFAB_INSTANCES; i++)
+            instances[i] = PrefabManager::SpawnPrefab(prefab, nullptr, nullptr);
+        state.Pause();
+        for (Actor* instance : instances)
+        {
+            if (instance)
+                instance->DeleteObject();
+        }
+        state.Resume();
+    }
+    Content::DeleteAsset(prefab);
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Networking/NetworkStream.h"
+#include <ThirdParty/LZ4/lz4.h>
+
+// The amount of values written by the network stream benchmarks (single operation processes all values)
+#define STREAM_ITEMS 1000
+
+// The size of the data chunk used by the compression benchmarks (in bytes)
+#define LZ4_CHUNK_SIZE (256 * 1024)
+
+namespace
+{
+    struct NetworkTransform
+    {
+        Vector3 Position;
+        Quaternion Orientation;
+        int32 Id;
+        bool Active;
+    };
+
+    void InitTransforms(Array<NetworkTransform>& transforms)
+    {
+        RandomStream rand(100);
+        transforms.Resize(STREAM_ITEMS);
+        for (int32 i = 0; i < STREAM_ITEMS; i++)
+        {
+            auto& e = transforms[i];
+            e.Position = Vector3(rand.RandRange(-1000.0f, 1000.0f), rand.RandRange(-1000.0f, 1000.0f), rand.RandRange(-1000.0f, 1000.0f));
+            e.Orientation = Quaternion::Euler(rand.RandRange(-180.0f, 180.0f), rand.RandRange(-180.0f, 180.0f), rand.RandRange(-180.0f, 180.0f));
+            e.Id = rand.RandRange(0, 100000);
+            e.Active = (i % 3) != 0;
+        }
+    }
+
+    void WriteTransforms(NetworkStream* stream, const Array<NetworkTransform>& transforms)
+    {
+        for (const auto& e : transforms)
+        {
+            stream->WriteBit(e.Active);
+            stream->WriteVarUInt32((uint32)e.Id);
+            stream->WriteQuantized(e.Position, 0.01f);
+            stream->WriteQuantized(e.Orientation);
+        }
+    }
+
+    void InitCompressedChunk(Array<byte>& data, Array<byte>& compressed)
+    {
+        // Semi-compressible data (repetitive patterns with noise, similar to the assets data)
+        RandomStream rand(100);
+        data.Resize(LZ4_CHUNK_SIZE);
+        for (int32 i = 0; i < LZ4_CHUNK_SIZE; i++)
+            data[i] = (byte)((i / 64) % 16 + (rand.RandRange(0, 7) == 0 ? rand.RandRange(0, 255) : 0));
+        compressed.Resize(LZ4_compressBound(LZ4_CHUNK_SIZE));
+        const int32 compressedSize = LZ4_compress_default((const char*)data.Get(), (char*)compressed.Get(), LZ4_CHUNK_SIZE, compressed.Count());
+        compressed.Resize(compressedSize);
+    }
+}
+
+BENCHMARK("NetworkStream.Write (1000 values)")
+{
+    Array<NetworkTransform> transforms;
+    InitTransforms(transforms);
+    NetworkStream* stream = New<NetworkStream>();
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        stream->Initialize();
+        WriteTransforms(stream, transforms);
+        Benchmark::DoNotOptimize(stream->GetBuffer());
+    }
+    Delete(stream);
+}
+
+BENCHMARK("NetworkStream.Read (1000 values)")
+{
+    Array<NetworkTransform> transforms;
+    InitTransforms(transforms);
+    NetworkStream* writer = New<NetworkStream>();
+    writer->Initialize();
+    WriteTransforms(writer, transforms);
+    const uint32 size = writer->GetPosition();
+    NetworkStream* reader = New<NetworkStream>();
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        reader->Initialize(writer->GetBuffer(), size);
+        for (int32 i = 0; i < STREAM_ITEMS; i++)
+        {
+            NetworkTransform e;
+            e.Active = reader->ReadBit();
+            e.Id = (int32)reader->ReadVarUInt32();
+            e.Position = reader->ReadQuantizedVector3(0.01f);
+            e.Orientation = reader->ReadQuantizedQuaternion();
+            Benchmark::DoNotOptimize(e);
+        }
+    }
+    Delete(reader);
+    Delete(writer);
+}
+
+BENCHMARK("LZ4.Decompress (256kB chunk)")
+{
+    Array<byte> data, compressed;
+    InitCompressedChunk(data, compressed);
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        const int32 result = LZ4_decompress_safe((const char*)compressed.Get(), (char*)data.Get(), compressed.Count(), LZ4_CHUNK_SIZE);
+        Benchmark::DoNotOptimize(result);
+        Benchmark::DoNotOptimize(data.Get());
+    }
+}
+
+BENCHMARK("LZ4.Compress (256kB chunk)")
+{
+    Array<byte> data, compressed;
+    InitCompressedChunk(data, compressed);
+    compressed.Resize(LZ4_compressBound(LZ4_CHUNK_SIZE));
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        const int32 result = LZ4_compress_default((const char*)data.Get(), (char*)compressed.Get(), LZ4_CHUNK_SIZE, compressed.Count());
+        Benchmark::DoNotOptimize(result);
+    }
+}
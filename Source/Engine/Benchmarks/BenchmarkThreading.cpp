@@ -0,0 +1,47 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Threading/JobSystem.h"
+
+BENCHMARK("JobSystem.Execute (1 job)")
+{
+    int64 counter = 0;
+    const Function<void(int32)> job = [&counter](int32 jobIndex)
+    {
+        Platform::InterlockedIncrement(&counter);
+    };
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        JobSystem::Execute(job, 1);
+    Benchmark::DoNotOptimize(counter);
+}
+
+BENCHMARK("JobSystem.Execute (64 jobs)")
+{
+    int64 counter = 0;
+    const Function<void(int32)> job = [&counter](int32 jobIndex)
+    {
+        Platform::InterlockedIncrement(&counter);
+    };
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+        JobSystem::Execute(job, 64);
+    Benchmark::DoNotOptimize(counter);
+}
+
+BENCHMARK("JobSystem.Dispatch+Wait (16 labels)")
+{
+    int64 counter = 0;
+    const Function<void(int32)> job = [&counter](int32 jobIndex)
+    {
+        Platform::InterlockedIncrement(&counter);
+    };
+    int64 labels[16];
+    for (int32 iteration = 0; iteration < state.Iterations; iteration++)
+    {
+        for (int64& label : labels)
+            label = JobSystem::Dispatch(job, 4);
+        for (const int64 label : labels)
+            JobSystem::Wait(label);
+    }
+    Benchmark::DoNotOptimize(counter);
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+using System.Collections.Generic;
+using Flax.Build;
+using Flax.Build.NativeCpp;
+
+/// <summary>
+/// Engine benchmarks module.
+/// </summary>
+public class Benchmarks : EngineModule
+{
+    /// <inheritdoc />
+    public Benchmarks()
+    {
+        Deploy = false;
+    }
+
+    /// <inheritdoc />
+    public override void Setup(BuildOptions options)
+    {
+        base.Setup(options);
+
+        options.PrivateDependencies.Add("lz4");
+    }
+
+    /// <inheritdoc />
+    public override void GetFilesToDeploy(List<string> files)
+    {
+    }
+}
@@ -18,6 +18,7 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
@@ -29,12 +30,23 @@ using namespace CSG;
 // Enable/disable locking scene during building CSG brushes nodes
 #define CSG_USE_SCENE_LOCKS 0
 
+// The size of the CSG grid cell (in world units). Brushes are combined per-cell so editing a brush rebuilds only the cells overlapping its old and new bounds.
+#define CSG_CELL_SIZE 2000.0f
+
 struct BuildData;
 
 namespace CSGBuilderImpl
 {
+    struct Cell
+    {
+        uint32 Hash;
+        RawData* Data;
+    };
+
     Array<Scene*> ScenesToRebuild;
+    Dictionary<Scene*, Dictionary<uint64, Cell>> ScenesCells;
 
+    void clearCells(Scene* scene);
     void onSceneUnloading(Scene* scene, const Guid& sceneId);
     bool buildInner(Scene* scene, BuildData& data);
     void build(Scene* scene);
@@ -53,16 +65,29 @@ class CSGBuilderService : public EngineService
 
     bool Init() override;
     void Update() override;
+    void Dispose() override;
 };
 
 CSGBuilderService CSGBuilderServiceInstance;
 
 Delegate<Brush*> Builder::OnBrushModified;
 
+void CSGBuilderImpl::clearCells(Scene* scene)
+{
+    Dictionary<uint64, Cell>* cells = ScenesCells.TryGet(scene);
+    if (cells)
+    {
+        for (auto i = cells->Begin(); i.IsNotEnd(); ++i)
+            Delete(i->Value.Data);
+        ScenesCells.Remove(scene);
+    }
+}
+
 void CSGBuilderImpl::onSceneUnloading(Scene* scene, const Guid& sceneId)
 {
     // Ensure to remove scene (prevent crashes)
     ScenesToRebuild.Remove(scene);
+    clearCells(scene);
 }
 
 bool CSGBuilderService::Init()
@@ -92,6 +117,13 @@ void CSGBuilderService::Update()
     }
 }
 
+void CSGBuilderService::Dispose()
+{
+    ScenesToRebuild.Clear();
+    while (ScenesCells.HasItems())
+        clearCells(ScenesCells.Begin()->Key);
+}
+
 bool Builder::IsActive()
 {
     return ScenesToRebuild.HasItems();
@@ -119,8 +151,30 @@ void Builder::Build(Scene* scene, float timeoutMs)
 namespace CSG
 {
     typedef Dictionary<Actor*, Mesh*> MeshesLookup;
+}
+
+struct BuildData
+{
+    Scene* scene;
+    MeshesArray meshes;
+    Array<Actor*> actors;
+    int32 cellsCount = 0;
+    int32 cellsRebuilt = 0;
+    Guid outputModelAssetId = Guid::Empty;
+    Guid outputRawDataAssetId = Guid::Empty;
+    Guid outputCollisionDataAssetId = Guid::Empty;
+
+    BuildData(Scene* scene, int32 meshesCapacity = 32)
+        : scene(scene)
+        , meshes(meshesCapacity)
+        , actors(meshesCapacity)
+    {
+    }
+};
 
-    bool walkTree(Actor* actor, MeshesArray& meshes, MeshesLookup& cache)
+namespace CSG
+{
+    bool walkTree(Actor* actor, BuildData& data)
     {
         // Check if actor is a brush
         auto brush = dynamic_cast<Brush*>(actor);
@@ -130,15 +184,15 @@ namespace CSG
             if (brush->CanUseCSG())
             {
                 // Skip subtract/common meshes from the beginning (they have no effect)
-                if (meshes.Count() > 0 || brush->GetBrushMode() == Mode::Additive)
+                if (data.meshes.Count() > 0 || brush->GetBrushMode() == Mode::Additive)
                 {
                     // Create new mesh and build for given brush
                     auto mesh = New<CSG::Mesh>();
                     mesh->Build(brush);
 
                     // Save results
-                    meshes.Add(mesh);
-                    cache.Add(actor, mesh);
+                    data.meshes.Add(mesh);
+                    data.actors.Add(actor);
                 }
                 else
                 {
@@ -151,6 +205,31 @@ namespace CSG
         return true;
     }
 
+    uint32 getBrushHash(Actor* actor, const Mesh* mesh)
+    {
+        // Hash all brush properties that affect the CSG geometry
+        auto brush = dynamic_cast<Brush*>(actor);
+        uint32 hash = GetHash(brush->GetBrushID());
+        CombineHash(hash, (uint32)brush->GetBrushMode());
+        const Array<Surface>& surfaces = *mesh->GetSurfaces();
+        for (int32 i = 0; i < surfaces.Count(); i++)
+        {
+            const Surface& surface = surfaces[i];
+            CombineHash(hash, GetHash((float)surface.Normal.X));
+            CombineHash(hash, GetHash((float)surface.Normal.Y));
+            CombineHash(hash, GetHash((float)surface.Normal.Z));
+            CombineHash(hash, GetHash((float)surface.D));
+            CombineHash(hash, GetHash(surface.Material));
+            CombineHash(hash, GetHash(surface.TexCoordScale.X));
+            CombineHash(hash, GetHash(surface.TexCoordScale.Y));
+            CombineHash(hash, GetHash(surface.TexCoordOffset.X));
+            CombineHash(hash, GetHash(surface.TexCoordOffset.Y));
+            CombineHash(hash, GetHash(surface.TexCoordRotation));
+            CombineHash(hash, GetHash(surface.ScaleInLightmap));
+        }
+        return hash;
+    }
+
     Mesh* Combine(Actor* actor, MeshesLookup& cache, Mesh* combineParent)
     {
         ASSERT(actor);
@@ -235,46 +314,142 @@ namespace CSG
     }
 }
 
-struct BuildData
-{
-    MeshesArray meshes;
-    MeshesLookup cache;
-    Guid outputModelAssetId = Guid::Empty;
-    Guid outputRawDataAssetId = Guid::Empty;
-    Guid outputCollisionDataAssetId = Guid::Empty;
-
-    BuildData(int32 meshesCapacity = 32)
-        : meshes(meshesCapacity * 32)
-        , cache(meshesCapacity * 4)
-    {
-    }
-};
-
 bool CSGBuilderImpl::buildInner(Scene* scene, BuildData& data)
 {
     // Setup CSG meshes list and build them
     {
-        Function<bool(Actor*, MeshesArray&, MeshesLookup&)> treeWalkFunction(walkTree);
-        SceneQuery::TreeExecute<Array<CSG::Mesh*>&, MeshesLookup&>(treeWalkFunction, data.meshes, data.cache);
+        Function<bool(Actor*, BuildData&)> treeWalkFunction(walkTree);
+        scene->TreeExecute<BuildData&>(treeWalkFunction, data);
     }
     if (data.meshes.IsEmpty())
+    {
+        clearCells(scene);
         return false;
+    }
 
-    // Process all meshes (performs actual CSG opterations on geometry in tree structure)
-    CSG::Mesh* combinedMesh = Combine(scene, data.cache);
-    if (combinedMesh == nullptr)
-        return false;
+    // Split meshes into the grid cells (combined separately so only the cells with modified brushes need to be rebuilt)
+    struct CellBuild
+    {
+        uint64 Key;
+        Int3 Coord;
+        uint32 Hash;
+        Array<int32> Meshes;
+        RawData* Data;
+    };
+    Array<CellBuild> cells;
+    {
+        Dictionary<uint64, int32> keyToCell;
+        for (int32 meshIndex = 0; meshIndex < data.meshes.Count(); meshIndex++)
+        {
+            const AABB bounds = data.meshes[meshIndex]->GetBounds();
+            if (bounds.MinX > bounds.MaxX)
+                continue;
+            const uint32 brushHash = getBrushHash(data.actors[meshIndex], data.meshes[meshIndex]);
+            const Int3 cellMin(Math::FloorToInt((float)(bounds.MinX - 1) / CSG_CELL_SIZE), Math::FloorToInt((float)(bounds.MinY - 1) / CSG_CELL_SIZE), Math::FloorToInt((float)(bounds.MinZ - 1) / CSG_CELL_SIZE));
+            const Int3 cellMax(Math::FloorToInt((float)(bounds.MaxX + 1) / CSG_CELL_SIZE), Math::FloorToInt((float)(bounds.MaxY + 1) / CSG_CELL_SIZE), Math::FloorToInt((float)(bounds.MaxZ + 1) / CSG_CELL_SIZE));
+            for (int32 z = cellMin.Z; z <= cellMax.Z; z++)
+            {
+                for (int32 y = cellMin.Y; y <= cellMax.Y; y++)
+                {
+                    for (int32 x = cellMin.X; x <= cellMax.X; x++)
+                    {
+                        const uint64 key = ((uint64)(x & 0x1fffff) << 42) | ((uint64)(y & 0x1fffff) << 21) | (uint64)(z & 0x1fffff);
+                        int32 cellIndex;
+                        if (!keyToCell.TryGet(key, cellIndex))
+                        {
+                            cellIndex = cells.Count();
+                            keyToCell.Add(key, cellIndex);
+                            auto& cell = cells.AddOne();
+                            cell.Key = key;
+                            cell.Coord = Int3(x, y, z);
+                            cell.Hash = 0;
+                            cell.Data = nullptr;
+                        }
+                        auto& cell = cells[cellIndex];
+                        cell.Meshes.Add(meshIndex);
+                        CombineHash(cell.Hash, brushHash);
+                    }
+                }
+            }
+        }
+    }
+    data.cellsCount = cells.Count();
 
-    // TODO: split too big meshes (too many verts, to far parts, etc.)
+    // Reuse cached results of the unmodified cells
+    Dictionary<uint64, Cell>& cachedCells = ScenesCells[scene];
+    Array<int32> dirtyCells;
+    for (int32 cellIndex = 0; cellIndex < cells.Count(); cellIndex++)
+    {
+        auto& cell = cells[cellIndex];
+        Cell* cached = cachedCells.TryGet(cell.Key);
+        if (cached && cached->Hash == cell.Hash)
+        {
+            cell.Data = cached->Data;
+            cached->Data = nullptr;
+        }
+        else
+        {
+            dirtyCells.Add(cellIndex);
+        }
+    }
+    for (auto i = cachedCells.Begin(); i.IsNotEnd(); ++i)
+        Delete(i->Value.Data);
+    cachedCells.Clear();
+    data.cellsRebuilt = dirtyCells.Count();
 
-    // Triangulate meshes
+    // Process modified cells (performs actual CSG operations on geometry in tree structure limited to the brushes overlapping the cell)
     {
-        // TODO: setup valid loop for splited meshes
+        Function<void(int32)> job = [&](int32 jobIndex)
+        {
+            auto& cell = cells[dirtyCells[jobIndex]];
+            cell.Data = New<RawData>();
+            MeshesArray cellMeshes(cell.Meshes.Count());
+            MeshesLookup cellCache(cell.Meshes.Count() * 4);
+            for (int32 i = 0; i < cell.Meshes.Count(); i++)
+            {
+                const int32 meshIndex = cell.Meshes[i];
+                const CSG::Mesh* mesh = data.meshes[meshIndex];
+
+                // Skip subtract/common meshes from the beginning (they have no effect)
+                if (cellMeshes.IsEmpty() && !mesh->HasMode(Mode::Additive))
+                    continue;
+
+                auto cellMesh = New<CSG::Mesh>(*mesh);
+                cellMeshes.Add(cellMesh);
+                cellCache.Add(data.actors[meshIndex], cellMesh);
+            }
+            if (cellMeshes.HasItems())
+            {
+                CSG::Mesh* combinedMesh = Combine(scene, cellCache);
+                if (combinedMesh && combinedMesh->HasMode(Mode::Additive))
+                {
+                    const Vector3 cellMin = Vector3(cell.Coord) * CSG_CELL_SIZE;
+                    combinedMesh->Clip(cellMin, cellMin + CSG_CELL_SIZE);
 
-        // Convert CSG meshes into raw triangles data
+                    // Convert CSG meshes into raw triangles data
+                    Array<RawModelVertex> vertexBuffer;
+                    combinedMesh->Triangulate(*cell.Data, vertexBuffer);
+                }
+            }
+            cellMeshes.ClearDelete();
+        };
+        JobSystem::Execute(job, dirtyCells.Count());
+    }
+
+    // Cache the cells results for the next build
+    for (int32 cellIndex = 0; cellIndex < cells.Count(); cellIndex++)
+    {
+        const auto& cell = cells[cellIndex];
+        cachedCells.Add(cell.Key, { cell.Hash, cell.Data });
+    }
+
+    // TODO: split too big meshes (too many verts, to far parts, etc.)
+
+    // Merge cells into a single mesh
+    {
         RawData meshData;
-        Array<RawModelVertex> vertexBuffer;
-        combinedMesh->Triangulate(meshData, vertexBuffer);
+        for (int32 cellIndex = 0; cellIndex < cells.Count(); cellIndex++)
+            meshData.Append(*cells[cellIndex].Data);
         meshData.RemoveEmptySlots();
         if (meshData.Slots.HasItems())
         {
@@ -372,7 +547,7 @@ void CSGBuilderImpl::build(Scene* scene)
     LOG(Info, "Start building CSG...");
 
     // Build
-    BuildData data;
+    BuildData data(scene);
     bool failed = buildInner(scene, data);
 
     // Link new (or empty) CSG mesh
@@ -383,9 +558,10 @@ void CSGBuilderImpl::build(Scene* scene)
     scene->CSGData.PostCSGBuild();
 
     // End
+    const int32 brushesCount = data.meshes.Count();
     data.meshes.ClearDelete();
     auto endTime = DateTime::Now();
-    LOG(Info, "CSG build in {0} ms! {1} brush(es)", (endTime - startTime).GetTotalMilliseconds(), data.meshes.Count());
+    LOG(Info, "CSG build in {0} ms! {1} brush(es), {2}/{3} cell(s) rebuilt", (endTime - startTime).GetTotalMilliseconds(), brushesCount, data.cellsRebuilt, data.cellsCount);
 }
 
 bool CSGBuilderImpl::generateRawDataAsset(Scene* scene, RawData& meshData, Guid& assetId, const String& assetPath)
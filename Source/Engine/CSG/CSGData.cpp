@@ -94,6 +94,28 @@ void RawData::AddSurface(Brush* brush, int32 brushSurfaceIndex, const Guid& surf
     }
 }
 
+void RawData::Append(const RawData& other)
+{
+    // Merge slots surfaces
+    for (int32 slotIndex = 0; slotIndex < other.Slots.Count(); slotIndex++)
+    {
+        const auto otherSlot = other.Slots[slotIndex];
+        auto slot = GetOrAddSlot(otherSlot->Material);
+        slot->Surfaces.Add(otherSlot->Surfaces);
+    }
+
+    // Merge brushes triangles
+    for (auto i = other.Brushes.Begin(); i.IsNotEnd(); ++i)
+    {
+        auto& brushData = Brushes[i->Key];
+        const auto& otherSurfaces = i->Value.Surfaces;
+        if (brushData.Surfaces.Count() < otherSurfaces.Count())
+            brushData.Surfaces.Resize(otherSurfaces.Count());
+        for (int32 surfaceIndex = 0; surfaceIndex < otherSurfaces.Count(); surfaceIndex++)
+            brushData.Surfaces[surfaceIndex].Triangles.Add(otherSurfaces[surfaceIndex].Triangles);
+    }
+}
+
 void RawData::ToModelData(ModelData& modelData) const
 {
     // Generate lightmap UVs (single chart for the whole mesh)
@@ -120,6 +120,12 @@ namespace CSG
     public:
         void AddSurface(Brush* brush, int32 brushSurfaceIndex, const Guid& surfaceMaterial, float scaleInLightmap, const Rectangle& lightmapUVsBox, const RawModelVertex* firstVertex, int32 vertexCount);
 
+        /// <summary>
+        /// Appends the other mesh data (surfaces and brushes triangles) to this container.
+        /// </summary>
+        /// <param name="other">The other data to merge with.</param>
+        void Append(const RawData& other);
+
         /// <summary>
         /// Removes the empty slots.
         /// </summary>
@@ -374,4 +374,48 @@ PolygonSplitResult CSG::Mesh::polygonSplit(const Surface& cuttingPlane, int32 in
     }
 }
 
+void CSG::Mesh::Clip(const Vector3& min, const Vector3& max)
+{
+    // Box planes facing outside (maximum planes go first)
+    const Surface planes[6] =
+    {
+        Surface(Vector3::UnitX, (float)max.X),
+        Surface(Vector3::UnitY, (float)max.Y),
+        Surface(Vector3::UnitZ, (float)max.Z),
+        Surface(-Vector3::UnitX, (float)-min.X),
+        Surface(-Vector3::UnitY, (float)-min.Y),
+        Surface(-Vector3::UnitZ, (float)-min.Z),
+    };
+
+    // Check every polygon (iterate from end since split adds the outside parts which are hidden anyway)
+    for (int32 i = _polygons.Count() - 1; i >= 0; i--)
+    {
+        if (!_polygons[i].Visible || _polygons[i].FirstEdgeIndex == INVALID_INDEX)
+            continue;
+
+        for (int32 planeIndex = 0; planeIndex < ARRAY_COUNT(planes); planeIndex++)
+        {
+            const Surface& plane = planes[planeIndex];
+            const auto side = plane.OnSide(_polygons[i].Bounds);
+            if (side == PlaneIntersectionType::Back)
+                continue;
+
+            Polygon* outsidePolygon;
+            const PolygonSplitResult result = side == PlaneIntersectionType::Front ? CompletelyOutside : polygonSplit(plane, i, &outsidePolygon);
+            if (result == Split)
+            {
+                outsidePolygon->Visible = false;
+            }
+            else if (result == CompletelyOutside || (result != CompletelyInside && planeIndex < 3))
+            {
+                _polygons[i].Visible = false;
+                break;
+            }
+        }
+    }
+
+    // Update bounds
+    updateBounds();
+}
+
 #endif
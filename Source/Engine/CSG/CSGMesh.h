@@ -135,6 +135,13 @@ namespace CSG
         /// <param name="other">Other mesh to merge with</param>
         void Add(const Mesh* other);
 
+        /// <summary>
+        /// Clip mesh polygons to the given box (hides parts outside it). Polygons lying on the box minimum planes are kept and the ones on the maximum planes are hidden so the adjacent boxes don't produce overlapping polygons.
+        /// </summary>
+        /// <param name="min">The box minimum.</param>
+        /// <param name="max">The box maximum.</param>
+        void Clip(const Vector3& min, const Vector3& max);
+
     private:
 
         void intersect(const Mesh* other, PolygonOperation insideOp, PolygonOperation outsideOp);
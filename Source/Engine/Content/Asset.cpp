@@ -11,7 +11,6 @@
 #include "Engine/Threading/Threading.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/MainThreadTask.h"
-#include "Engine/Threading/ConcurrentTaskQueue.h"
 #if USE_MONO
 #include <ThirdParty/mono-2.0/mono/metadata/mono-gc.h>
 #endif
@@ -179,6 +178,11 @@ int32 Asset::GetReferencesCount() const
     return (int32)Platform::AtomicRead(const_cast<int64 volatile*>(&_refCount));
 }
 
+void Asset::onReferencesEmpty()
+{
+    Content::onAssetUnreferenced(this);
+}
+
 String Asset::ToString() const
 {
     return String::Format(TEXT("{0}, {1}, {2}"), GetTypeName(), GetID(), GetPath());
@@ -362,11 +366,6 @@ void Asset::Reload()
     }
 }
 
-namespace ContentLoadingManagerImpl
-{
-    extern ConcurrentTaskQueue<ContentLoadTask> Tasks;
-};
-
 bool Asset::WaitForLoaded(double timeoutInMilliseconds) const
 {
     // This function is used many time when some parts of the engine need to wait for asset loading end (it may fail but has to end).
@@ -426,14 +425,15 @@ bool Asset::WaitForLoaded(double timeoutInMilliseconds) const
             {
                 // Dequeue task from the loading queue
                 ContentLoadTask* tmp;
-                if (ContentLoadingManagerImpl::Tasks.try_dequeue(tmp))
+                if (ContentLoadingManager::TryDequeueTask(tmp))
                 {
                     if (tmp == task)
                     {
                         if (localQueue.Count() != 0)
                         {
                             // Put back queued tasks
-                            ContentLoadingManagerImpl::Tasks.enqueue_bulk(localQueue.Get(), localQueue.Count());
+                            for (ContentLoadTask* localTask : localQueue)
+                                ContentLoadingManager::EnqueueTask(localTask);
                             localQueue.Clear();
                         }
 
@@ -453,7 +453,8 @@ bool Asset::WaitForLoaded(double timeoutInMilliseconds) const
             if (localQueue.Count() != 0)
             {
                 // Put back queued tasks
-                ContentLoadingManagerImpl::Tasks.enqueue_bulk(localQueue.Get(), localQueue.Count());
+                for (ContentLoadTask* localTask : localQueue)
+                    ContentLoadingManager::EnqueueTask(localTask);
                 localQueue.Clear();
             }
 
@@ -569,6 +570,7 @@ bool Asset::onLoad(LoadAssetTask* task)
     LoadResult result;
     {
         PROFILE_CPU_ASSET(this);
+        ContentLoadingManager::AssetLoadScope loadScope(this, ContentLoadingManager::AssetLoadStage::Load, task->GetEnqueueTime());
         result = loadAsset();
     }
     const bool isLoaded = result == LoadResult::Ok;
@@ -88,11 +88,12 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API Asset : public ManagedScriptin
     }
 
     /// <summary>
-    /// Removes reference from that asset.
+    /// Removes reference from that asset. When the last reference gets removed, the asset is queued for the unload check.
     /// </summary>
     FORCE_INLINE void RemoveReference()
     {
-        Platform::InterlockedDecrement(&_refCount);
+        if (Platform::InterlockedDecrement(&_refCount) == 0)
+            onReferencesEmpty();
     }
 
 public:
@@ -229,6 +230,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API Asset : public ManagedScriptin
     void onLoaded();
     void onLoaded_MainThread();
     virtual void onUnload_MainThread();
+    void onReferencesEmpty();
 #if USE_EDITOR
     virtual void onRename(const StringView& newPath) = 0;
 #endif
@@ -57,6 +57,7 @@ Animation::InfoData Animation::GetInfo() const
             info.MemoryUsage += e.Rotation.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Quaternion>);
             info.MemoryUsage += e.Scale.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Float3>);
         }
+        info.MemoryUsage += CompressedData.GetMemoryUsage();
     }
     else
     {
@@ -575,6 +576,7 @@ uint64 Animation::GetMemoryUsage() const
     uint64 result = BinaryAsset::GetMemoryUsage();
     result += sizeof(Animation) - sizeof(BinaryAsset);
     result += Data.GetMemoryUsage();
+    result += CompressedData.GetMemoryUsage();
     result += Events.Capacity() * sizeof(Pair<String, StepCurve<AnimEventData>>);
     for (const auto& e : Events)
         result += e.First.Length() * sizeof(Char) + e.Second.GetMemoryUsage();
@@ -658,6 +660,20 @@ Asset::LoadResult Animation::load()
         }
     }
 
+    // Compress animation for the fast sampling of all channels at once
+    if (!CompressedData.Init(Data))
+    {
+#if !USE_EDITOR
+        // Release source keyframes (memory is used only by the compressed data)
+        for (auto& anim : Data.Channels)
+        {
+            anim.Position.Clear();
+            anim.Rotation.Clear();
+            anim.Scale.Clear();
+        }
+#endif
+    }
+
     // Animation events
     if (headerVersion >= 101)
     {
@@ -740,6 +756,7 @@ void Animation::unload(bool isReloading)
 #endif
     ClearCache();
     Data.Dispose();
+    CompressedData.Release();
     for (const auto& e : Events)
     {
         for (const auto& k : e.Second.GetKeyframes())
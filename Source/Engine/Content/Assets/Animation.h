@@ -5,6 +5,7 @@
 #include "../BinaryAsset.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Animations/AnimationData.h"
+#include "Engine/Animations/CompressedAnimationData.h"
 #include "Engine/Content/AssetReference.h"
 
 class SkinnedModel;
@@ -88,6 +89,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Animation : public BinaryAsset
     /// </summary>
     AnimationData Data;
 
+    /// <summary>
+    /// The compressed animation data used for the fast sampling of all animation channels. Invalid if the animation cannot be compressed within the error bounds. In game builds the source channels keyframes are released after compression (only node names are kept).
+    /// </summary>
+    CompressedAnimationData CompressedData;
+
     /// <summary>
     /// The animation events (keyframes per named track).
     /// </summary>
@@ -71,6 +71,11 @@ bool Material::CanUseLightmap() const
     return _materialShader && _materialShader->CanUseLightmap();
 }
 
+bool Material::CanUseSkinning() const
+{
+    return _materialShader && _materialShader->CanUseSkinning();
+}
+
 bool Material::CanUseInstancing(InstancingHandler& handler) const
 {
     return _materialShader && _materialShader->CanUseInstancing(handler);
@@ -486,6 +491,7 @@ void Material::InitCompilationOptions(ShaderCompilationOptions& options)
     }
 
     // Helper macros (used by the parser)
+    options.Macros.Add({ "USE_SKINNING_PERMUTATIONS", Numbers[options.StripSkinning ? 0 : 1] });
     options.Macros.Add({ "IS_SURFACE", Numbers[info.Domain == MaterialDomain::Surface ? 1 : 0] });
     options.Macros.Add({ "IS_POST_FX", Numbers[info.Domain == MaterialDomain::PostProcess ? 1 : 0] });
     options.Macros.Add({ "IS_GUI", Numbers[info.Domain == MaterialDomain::GUI ? 1 : 0] });
@@ -165,6 +165,11 @@ bool MaterialInstance::CanUseLightmap() const
     return _baseMaterial && _baseMaterial->CanUseLightmap();
 }
 
+bool MaterialInstance::CanUseSkinning() const
+{
+    return _baseMaterial && _baseMaterial->CanUseSkinning();
+}
+
 bool MaterialInstance::CanUseInstancing(InstancingHandler& handler) const
 {
     return _baseMaterial && _baseMaterial->CanUseInstancing(handler);
@@ -2,17 +2,21 @@
 
 #include "Model.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Color32.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Content/WeakAssetReference.h"
+#include "Engine/Content/Loading/ContentLoadingManager.h"
 #include "Engine/Content/Upgraders/ModelAssetUpgrader.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
 #include "Engine/Debug/DebugDraw.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Models/ModelInstanceEntry.h"
+#include "Engine/Streaming/Streaming.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Debug/Exceptions/ArgumentOutOfRangeException.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/Async/GPUTask.h"
 #include "Engine/Graphics/Async/Tasks/GPUUploadTextureMipTask.h"
@@ -20,6 +24,7 @@
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/DrawCall.h"
+#include "Engine/Renderer/RenderList.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Tools/ModelTool/ModelTool.h"
 #include "Engine/Tools/ModelTool/MeshAccelerationStructure.h"
@@ -69,6 +74,7 @@ class StreamModelLODTask : public STREAM_TASK_BASE
         AssetReference<Model> model = _asset.Get();
         if (model == nullptr)
             return true;
+        ContentLoadingManager::AssetLoadScope loadScope(model.Get(), ContentLoadingManager::AssetLoadStage::Upload);
 
         // Get data
         BytesContainer data;
@@ -112,14 +118,14 @@ class StreamModelLODTask : public STREAM_TASK_BASE
     }
 };
 
-class StreamModelSDFTask : public GPUUploadTextureMipTask
+class StreamModelTextureTask : public GPUUploadTextureMipTask
 {
 private:
     WeakAssetReference<Model> _asset;
     FlaxStorage::LockData _dataLock;
 
 public:
-    StreamModelSDFTask(Model* model, GPUTexture* texture, const Span<byte>& data, int32 mipIndex, int32 rowPitch, int32 slicePitch)
+    StreamModelTextureTask(Model* model, GPUTexture* texture, const Span<byte>& data, int32 mipIndex, int32 rowPitch, int32 slicePitch)
         : GPUUploadTextureMipTask(texture, mipIndex, data, rowPitch, slicePitch, false)
         , _asset(model)
         , _dataLock(model->Storage->Lock())
@@ -206,6 +212,19 @@ void Model::Draw(const RenderContext& renderContext, MaterialBase* material, con
     LODs[lodIndex].Draw(renderContext, material, world, flags, receiveDecals, DrawPass::Default, 0, sortOrder);
 }
 
+FORCE_INLINE int32 GetShadowsLODBias(const RenderContext& renderContext)
+{
+    return 0;
+}
+
+FORCE_INLINE int32 GetShadowsLODBias(const RenderContextBatch& renderContextBatch)
+{
+    // Shadow projections (contexts after the main one) share the same LOD bias offset relative to the main view
+    if (renderContextBatch.Contexts.Count() > 1)
+        return renderContextBatch.Contexts.Get()[1].View.ModelLODBias - renderContextBatch.Contexts.Get()[0].View.ModelLODBias;
+    return 0;
+}
+
 template<typename ContextType>
 FORCE_INLINE void ModelDraw(Model* model, const RenderContext& renderContext, const ContextType& context, const Mesh::DrawInfo& info)
 {
@@ -217,7 +236,7 @@ FORCE_INLINE void ModelDraw(Model* model, const RenderContext& renderContext, co
     CHECK_INVALID_BUFFER(model, info.Buffer);
 
     // Select a proper LOD index (model may be culled)
-    int32 lodIndex;
+    int32 lodIndex, predictedLodIndex = -1;
     if (info.ForcedLOD != -1)
     {
         lodIndex = info.ForcedLOD;
@@ -253,11 +272,21 @@ FORCE_INLINE void ModelDraw(Model* model, const RenderContext& renderContext, co
 
             return;
         }
+
+        // Predict the LOD for the main view position ahead of its movement (to prefetch it in advance)
+        const Float3 predictionOffset = Streaming::GetViewPredictionOffset();
+        if (renderContext.Task == MainRenderTask::Instance && !predictionOffset.IsZero())
+            predictedLodIndex = RenderTools::ComputeModelLOD(model, info.Bounds.Center - predictionOffset, (float)info.Bounds.Radius, renderContext);
     }
-    lodIndex += info.LODBias + renderContext.View.ModelLODBias;
+    const int32 lodBias = info.LODBias + renderContext.View.ModelLODBias;
+    lodIndex += lodBias;
+    if (!renderContext.View.IsOfflinePass)
+        model->RequestLOD(lodIndex, predictedLodIndex != -1 ? predictedLodIndex + lodBias : lodIndex);
     lodIndex = model->ClampLODIndex(lodIndex);
 
-    if (renderContext.View.IsSingleFrame)
+    // Skip LOD transitions state update for views that use a different LOD bias than the view that drives the LOD selection (eg. shadow projections)
+    const bool directLOD = renderContext.View.IsSingleFrame || (renderContext.LodProxyView && renderContext.View.ModelLODBias != renderContext.LodProxyView->ModelLODBias);
+    if (directLOD)
     {
     }
     // Check if it's the new frame and could update the drawing state (note: model instance could be rendered many times per frame to different viewports)
@@ -285,25 +314,77 @@ FORCE_INLINE void ModelDraw(Model* model, const RenderContext& renderContext, co
         info.DrawState->LODTransition = 255;
     }
 
+    // Use impostor instead of the meshes in GBuffer when model is small enough on the screen (other passes such as shadows still use meshes)
+    const Mesh::DrawInfo* drawInfo = &info;
+    Mesh::DrawInfo impostorInfo;
+    if (info.ForcedLOD == -1 && EnumHasAnyFlags(info.DrawModes, DrawPass::GBuffer) && model->DrawImpostor(renderContext, *info.World))
+    {
+        impostorInfo = info;
+        impostorInfo.DrawModes = info.DrawModes & ~(DrawPass::GBuffer | DrawPass::MotionVectors);
+        drawInfo = &impostorInfo;
+    }
+
+    // Draw shadow projections with a separate LOD when they use a different LOD bias (eg. lower-quality LOD as a shadow proxy)
+    Mesh::DrawInfo mainInfo;
+    const int32 shadowsLodIndex = model->ClampLODIndex(lodIndex + GetShadowsLODBias(context));
+    if (shadowsLodIndex != lodIndex)
+    {
+        Mesh::DrawInfo shadowsInfo = info;
+        shadowsInfo.ShadowsOnly = true;
+        model->LODs.Get()[shadowsLodIndex].Draw(context, shadowsInfo, 0.0f);
+        mainInfo = *drawInfo;
+        mainInfo.SkipShadows = true;
+        drawInfo = &mainInfo;
+    }
+
     // Draw
-    if (info.DrawState->PrevLOD == lodIndex || renderContext.View.IsSingleFrame)
+    if (info.DrawState->PrevLOD == lodIndex || directLOD)
     {
-        model->LODs.Get()[lodIndex].Draw(context, info, 0.0f);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, 0.0f);
     }
     else if (info.DrawState->PrevLOD == -1)
     {
         const float normalizedProgress = static_cast<float>(info.DrawState->LODTransition) * (1.0f / 255.0f);
-        model->LODs.Get()[lodIndex].Draw(context, info, 1.0f - normalizedProgress);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, 1.0f - normalizedProgress);
     }
     else
     {
         const auto prevLOD = model->ClampLODIndex(info.DrawState->PrevLOD);
         const float normalizedProgress = static_cast<float>(info.DrawState->LODTransition) * (1.0f / 255.0f);
-        model->LODs.Get()[prevLOD].Draw(context, info, normalizedProgress);
-        model->LODs.Get()[lodIndex].Draw(context, info, normalizedProgress - 1.0f);
+        model->LODs.Get()[prevLOD].Draw(context, *drawInfo, normalizedProgress);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, normalizedProgress - 1.0f);
     }
 }
 
+bool Model::HasImpostor() const
+{
+    return Impostor.Texture && Impostor.Texture->ResidentMipLevels() > 0;
+}
+
+bool Model::DrawImpostor(const RenderContext& renderContext, const Matrix& world) const
+{
+    if (!HasImpostor() || !EnumHasAnyFlags(renderContext.View.Pass, DrawPass::GBuffer) || renderContext.View.IsOfflinePass)
+        return false;
+
+    // Check if impostor is small enough on the screen
+    Float3 scale, translation;
+    Quaternion rotation;
+    world.Decompose(scale, rotation, translation);
+    ImpostorDrawCall drawCall;
+    drawCall.Texture = Impostor.Texture;
+    drawCall.Frames = Impostor.Frames;
+    drawCall.Position = Float3::Transform(Impostor.Center, world);
+    drawCall.Radius = Impostor.Radius * scale.MaxValue();
+    drawCall.Rotation = rotation;
+    const auto lodView = renderContext.LodProxyView ? renderContext.LodProxyView : &renderContext.View;
+    const float screenRadiusSquared = RenderTools::ComputeBoundsScreenRadiusSquared(drawCall.Position, drawCall.Radius, *lodView) * renderContext.View.ModelLODDistanceFactorSqrt;
+    if (Math::Square(Impostor.ScreenSize * 0.5f) < screenRadiusSquared)
+        return false;
+
+    renderContext.List->Impostors.Add(drawCall);
+    return true;
+}
+
 void Model::Draw(const RenderContext& renderContext, const Mesh::DrawInfo& info)
 {
     ModelDraw(this, renderContext, renderContext, info);
@@ -572,6 +653,21 @@ bool Model::Save(bool withMeshDataFromGpu, const StringView& path)
                     }
                 }
 
+                // Meshes clusters
+                bool hasClusters = false;
+                for (int32 meshIndex = 0; meshIndex < meshesCount; meshIndex++)
+                    hasClusters |= lod.Meshes[meshIndex].GetClusters().HasItems();
+                if (hasClusters)
+                {
+                    meshesStream.WriteInt32(1); // Version
+                    for (int32 meshIndex = 0; meshIndex < meshesCount; meshIndex++)
+                    {
+                        const auto& clusters = lod.Meshes[meshIndex].GetClusters();
+                        meshesStream.WriteUint32(clusters.Count());
+                        meshesStream.WriteBytes(clusters.Get(), clusters.Count() * sizeof(MeshCluster));
+                    }
+                }
+
                 // Override LOD data chunk with the fetched GPU meshes memory
                 auto lodChunk = GET_CHUNK(MODEL_LOD_TO_CHUNK_INDEX(lodIndex));
                 if (lodChunk == nullptr)
@@ -625,6 +721,20 @@ bool Model::Save(bool withMeshDataFromGpu, const StringView& path)
         }
     }
 
+    // Impostor data is baked during import so keep it from file
+    if (!IsVirtual())
+    {
+        if (Impostor.Texture)
+        {
+            if (LoadChunk(14))
+                return true;
+        }
+        else
+        {
+            ReleaseChunk(14);
+        }
+    }
+
     // Set mesh header data
     auto headerChunk = GET_CHUNK(0);
     ASSERT(headerChunk != nullptr);
@@ -711,6 +821,7 @@ bool Model::Init(const Span<int32>& meshesCountPerLod)
     MaterialSlots.Resize(1);
     MinScreenSize = 0.0f;
     SAFE_DELETE_GPU_RESOURCE(SDF.Texture);
+    SAFE_DELETE_GPU_RESOURCE(Impostor.Texture);
 
     // Setup LODs
     for (int32 lodIndex = 0; lodIndex < LODs.Count(); lodIndex++)
@@ -816,6 +927,25 @@ int32 Model::GetAllocatedResidency() const
     return LODs.Count();
 }
 
+uint64 Model::GetMemoryUsage() const
+{
+    uint64 result = 0;
+    for (int32 lodIndex = HighestResidentLODIndex(); lodIndex < LODs.Count(); lodIndex++)
+    {
+        for (const Mesh& mesh : LODs[lodIndex].Meshes)
+        {
+            for (int32 i = 0; i < 3; i++)
+            {
+                if (const GPUBuffer* vb = mesh.GetVertexBuffer(i))
+                    result += vb->GetMemoryUsage();
+            }
+            if (const GPUBuffer* ib = mesh.GetIndexBuffer())
+                result += ib->GetMemoryUsage();
+        }
+    }
+    return result;
+}
+
 bool Model::CanBeUpdated() const
 {
     // Check if is ready and has no streaming tasks running
@@ -985,6 +1115,7 @@ Asset::LoadResult Model::load()
                 name = GetPath() + TEXT(".SDF");
 #endif
                 SDF.Texture = GPUDevice::Instance->CreateTexture(name);
+                SDF.Texture->SetCategory(GPUResourceCategory::Models);
             }
             if (SDF.Texture->Init(GPUTextureDescription::New3D(data.Width, data.Height, data.Depth, data.Format, GPUTextureFlags::ShaderResource, data.MipLevels)))
                 return LoadResult::Failed;
@@ -1001,7 +1132,7 @@ Asset::LoadResult Model::load()
                 ModelSDFMip mipData;
                 sdfStream.ReadBytes(&mipData, sizeof(mipData));
                 void* mipBytes = sdfStream.Move(mipData.SlicePitch);
-                auto task = ::New<StreamModelSDFTask>(this, SDF.Texture, Span<byte>((byte*)mipBytes, mipData.SlicePitch), mipData.MipIndex, mipData.RowPitch, mipData.SlicePitch);
+                auto task = ::New<StreamModelTextureTask>(this, SDF.Texture, Span<byte>((byte*)mipBytes, mipData.SlicePitch), mipData.MipIndex, mipData.RowPitch, mipData.SlicePitch);
                 task->Start();
             }
             break;
@@ -1012,6 +1143,58 @@ Asset::LoadResult Model::load()
         }
     }
 
+    // Load impostor
+    auto chunk14 = GetChunk(14);
+    if (chunk14 && chunk14->IsLoaded())
+    {
+        MemoryReadStream impostorStream(chunk14->Get(), chunk14->Size());
+        int32 version;
+        impostorStream.ReadInt32(&version);
+        switch (version)
+        {
+        case 1:
+        {
+            ModelImpostorHeader data;
+            impostorStream.ReadBytes(&data, sizeof(data));
+            if (!Impostor.Texture)
+            {
+                String name;
+#if !BUILD_RELEASE
+                name = GetPath() + TEXT(".Impostor");
+#endif
+                Impostor.Texture = GPUDevice::Instance->CreateTexture(name);
+                Impostor.Texture->SetCategory(GPUResourceCategory::Models);
+            }
+            if (Impostor.Texture->Init(GPUTextureDescription::New2D(data.Resolution, data.Resolution, data.MipLevels, PixelFormat::R8G8B8A8_UNorm, GPUTextureFlags::ShaderResource, 2)))
+                return LoadResult::Failed;
+            Impostor.Center = data.Center;
+            Impostor.Radius = data.Radius;
+            Impostor.Frames = data.Frames;
+            Impostor.ScreenSize = data.ScreenSize;
+            byte* mipsBytes[GPU_MAX_TEXTURE_MIP_LEVELS];
+            for (int32 mipLevel = 0; mipLevel < data.MipLevels; mipLevel++)
+            {
+                // Each mip contains data for both array slices
+                const int32 mipSize = Math::Max(data.Resolution >> mipLevel, 1);
+                mipsBytes[mipLevel] = (byte*)impostorStream.Move(mipSize * mipSize * sizeof(Color32) * 2);
+            }
+            for (int32 mipLevel = data.MipLevels - 1; mipLevel >= 0; mipLevel--)
+            {
+                // Upload from the lowest mip to keep the resident mips range valid
+                const int32 mipSize = Math::Max(data.Resolution >> mipLevel, 1);
+                const int32 rowPitch = mipSize * sizeof(Color32);
+                const int32 slicePitch = rowPitch * mipSize;
+                auto task = ::New<StreamModelTextureTask>(this, Impostor.Texture, Span<byte>(mipsBytes[mipLevel], slicePitch * 2), mipLevel, rowPitch, slicePitch);
+                task->Start();
+            }
+            break;
+        }
+        default:
+            LOG(Warning, "Unknown impostor data version {0} in {1}", version, ToString());
+            break;
+        }
+    }
+
 #if BUILD_DEBUG || BUILD_DEVELOPMENT
     // Validate LODs
     for (int32 lodIndex = 1; lodIndex < LODs.Count(); lodIndex++)
@@ -1043,6 +1226,7 @@ void Model::unload(bool isReloading)
 
     // Cleanup
     SAFE_DELETE_GPU_RESOURCE(SDF.Texture);
+    SAFE_DELETE_GPU_RESOURCE(Impostor.Texture);
     MaterialSlots.Resize(0);
     for (int32 i = 0; i < LODs.Count(); i++)
         LODs[i].Dispose();
@@ -1065,7 +1249,52 @@ bool Model::init(AssetInitData& initData)
 AssetChunksFlag Model::getChunksToPreload() const
 {
     // Note: we don't preload any LODs here because it's done by the Streaming Manager
-    return GET_CHUNK_FLAG(0) | GET_CHUNK_FLAG(15);
+    return GET_CHUNK_FLAG(0) | GET_CHUNK_FLAG(14) | GET_CHUNK_FLAG(15);
+}
+
+void ModelBase::RequestLOD(int32 lodIndex, int32 predictedLodIndex) const
+{
+    const int32 lodsCount = GetLODsCount();
+    if (lodsCount == 0)
+        return;
+    const int64 residency = lodsCount - Math::Clamp(lodIndex, 0, lodsCount - 1);
+    for (int64 current = Platform::AtomicRead(&_requestedResidency); residency > current;)
+    {
+        const int64 prev = Platform::InterlockedCompareExchange(&_requestedResidency, residency, current);
+        if (prev == current)
+            break;
+        current = prev;
+    }
+    PrefetchLOD(Math::Min(lodIndex, predictedLodIndex));
+}
+
+void ModelBase::PrefetchLOD(int32 lodIndex) const
+{
+    const int32 lodsCount = GetLODsCount();
+    if (lodsCount == 0)
+        return;
+    const int64 predictedResidency = lodsCount - Math::Clamp(lodIndex, 0, lodsCount - 1);
+    for (int64 current = Platform::AtomicRead(&_requestedPredictedResidency); predictedResidency > current;)
+    {
+        const int64 prev = Platform::InterlockedCompareExchange(&_requestedPredictedResidency, predictedResidency, current);
+        if (prev == current)
+            break;
+        current = prev;
+    }
+}
+
+uint64 ModelBase::GetStreamingSize(int32 residency) const
+{
+    // Sum the size of the LODs data chunks to load
+    const int32 lodsCount = GetLODsCount();
+    uint64 result = 0;
+    for (int32 i = GetCurrentResidency(); i < residency && i < lodsCount; i++)
+    {
+        const FlaxChunk* chunk = GetChunk(MODEL_LOD_TO_CHUNK_INDEX(lodsCount - i - 1));
+        if (chunk)
+            result += chunk->LocationInFile.Size;
+    }
+    return result;
 }
 
 void ModelBase::SetupMaterialSlots(int32 slotsCount)
@@ -31,6 +31,42 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
     /// </summary>
     API_FIELD(ReadOnly) SDFData SDF;
 
+    /// <summary>
+    /// The model impostor data (octahedral atlas of the model views used to draw it as a single quad at far distances).
+    /// </summary>
+    struct ImpostorData
+    {
+        /// <summary>
+        /// The atlas texture array (slice 0: albedo with coverage, slice 1: local-space normal with depth). Null if model has no impostor.
+        /// </summary>
+        GPUTexture* Texture = nullptr;
+
+        /// <summary>
+        /// The local-space center of the bounding sphere used to capture the views.
+        /// </summary>
+        Float3 Center = Float3::Zero;
+
+        /// <summary>
+        /// The local-space radius of the bounding sphere used to capture the views.
+        /// </summary>
+        float Radius = 0.0f;
+
+        /// <summary>
+        /// The amount of views per atlas side.
+        /// </summary>
+        int32 Frames = 0;
+
+        /// <summary>
+        /// The model screen size below which the impostor is used instead of the meshes.
+        /// </summary>
+        float ScreenSize = 0.0f;
+    };
+
+    /// <summary>
+    /// The impostor baked for this model during import (see GenerateImpostor import option).
+    /// </summary>
+    ImpostorData Impostor;
+
 public:
     /// <summary>
     /// Finalizes an instance of the <see cref="Model"/> class.
@@ -54,6 +90,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
         return _loadedLODs;
     }
 
+    /// <summary>
+    /// Determines whether this model has the impostor ready for rendering.
+    /// </summary>
+    bool HasImpostor() const;
+
     /// <summary>
     /// Clamps the index of the LOD to be valid for rendering (only loaded LODs).
     /// </summary>
@@ -198,6 +239,14 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
     /// <param name="info">The packed drawing info data.</param>
     void Draw(const RenderContextBatch& renderContextBatch, const Mesh::DrawInfo& info);
 
+    /// <summary>
+    /// Draws the model impostor into the GBuffer if the model is small enough on the screen (below the impostor screen size). Meshes don't need to be drawn into the GBuffer when the impostor is used.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="world">The world transformation of the model.</param>
+    /// <returns>True if impostor has been drawn, otherwise false.</returns>
+    bool DrawImpostor(const RenderContext& renderContext, const Matrix& world) const;
+
 public:
     /// <summary>
     /// Setups the model LODs collection including meshes creation.
@@ -258,6 +307,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
     int32 GetMaxResidency() const override;
     int32 GetCurrentResidency() const override;
     int32 GetAllocatedResidency() const override;
+    uint64 GetMemoryUsage() const override;
     bool CanBeUpdated() const override;
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
@@ -81,6 +81,12 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API ModelBase : public BinaryAsset
     };
 
 protected:
+    friend class ModelsStreamingHandler;
+    mutable volatile int64 _requestedResidency = 0;
+    mutable volatile int64 _requestedPredictedResidency = 0;
+    int32 _drawResidency = 0;
+    int32 _predictedResidency = 0;
+
     explicit ModelBase(const SpawnParams& params, const AssetInfo* info, StreamingGroup* group)
         : BinaryAsset(params, info)
         , StreamableResource(group)
@@ -127,4 +133,20 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API ModelBase : public BinaryAsset
     /// Gets the meshes for a particular LOD index.
     /// </summary>
     virtual void GetMeshes(Array<MeshBase*>& meshes, int32 lodIndex = 0) = 0;
+
+    // [StreamableResource]
+    uint64 GetStreamingSize(int32 residency) const override;
+
+    /// <summary>
+    /// Requests the LOD needed to draw the model. The highest quality LOD requested between the streaming updates is used to pick the LODs to load. Thread-safe.
+    /// </summary>
+    /// <param name="lodIndex">The LOD index used to draw the model.</param>
+    /// <param name="predictedLodIndex">The LOD index for the predicted view position (used to prefetch LODs ahead of the view movement).</param>
+    void RequestLOD(int32 lodIndex, int32 predictedLodIndex) const;
+
+    /// <summary>
+    /// Requests the LOD to prefetch for the predicted view position without drawing the model (eg. model culled now but visible from the predicted view). Thread-safe.
+    /// </summary>
+    /// <param name="lodIndex">The LOD index for the predicted view position.</param>
+    void PrefetchLOD(int32 lodIndex) const;
 };
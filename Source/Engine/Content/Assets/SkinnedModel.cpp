@@ -4,9 +4,11 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Streaming/Streaming.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Threading/ThreadPoolTask.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Models/ModelInstanceEntry.h"
@@ -16,6 +18,12 @@
 #include "Engine/Content/Upgraders/SkinnedModelAssetUpgrader.h"
 #include "Engine/Debug/Exceptions/ArgumentOutOfRangeException.h"
 #include "Engine/Renderer/DrawCall.h"
+#if USE_EDITOR
+#include "Engine/Graphics/Models/ModelData.h"
+#include "Engine/Graphics/Textures/TextureData.h"
+#include "Engine/Tools/ModelTool/ModelTool.h"
+#include "Engine/ContentImporters/AssetsImportingManager.h"
+#endif
 
 #define CHECK_INVALID_BUFFER(model, buffer) \
     if (buffer->IsValidFor(model) == false) \
@@ -172,6 +180,19 @@ BoundingBox SkinnedModel::GetBox(int32 lodIndex) const
     return LODs[lodIndex].GetBox();
 }
 
+FORCE_INLINE int32 GetShadowsLODBias(const RenderContext& renderContext)
+{
+    return 0;
+}
+
+FORCE_INLINE int32 GetShadowsLODBias(const RenderContextBatch& renderContextBatch)
+{
+    // Shadow projections (contexts after the main one) share the same LOD bias offset relative to the main view
+    if (renderContextBatch.Contexts.Count() > 1)
+        return renderContextBatch.Contexts.Get()[1].View.ModelLODBias - renderContextBatch.Contexts.Get()[0].View.ModelLODBias;
+    return 0;
+}
+
 template<typename ContextType>
 FORCE_INLINE void SkinnedModelDraw(SkinnedModel* model, const RenderContext& renderContext, const ContextType& context, const SkinnedMesh::DrawInfo& info)
 {
@@ -183,7 +204,7 @@ FORCE_INLINE void SkinnedModelDraw(SkinnedModel* model, const RenderContext& ren
     CHECK_INVALID_BUFFER(model, info.Buffer);
 
     // Select a proper LOD index (model may be culled)
-    int32 lodIndex;
+    int32 lodIndex, predictedLodIndex = -1;
     if (info.ForcedLOD != -1)
     {
         lodIndex = info.ForcedLOD;
@@ -219,11 +240,21 @@ FORCE_INLINE void SkinnedModelDraw(SkinnedModel* model, const RenderContext& ren
 
             return;
         }
+
+        // Predict the LOD for the main view position ahead of its movement (to prefetch it in advance)
+        const Float3 predictionOffset = Streaming::GetViewPredictionOffset();
+        if (renderContext.Task == MainRenderTask::Instance && !predictionOffset.IsZero())
+            predictedLodIndex = RenderTools::ComputeSkinnedModelLOD(model, info.Bounds.Center - predictionOffset, (float)info.Bounds.Radius, renderContext);
     }
-    lodIndex += info.LODBias + renderContext.View.ModelLODBias;
+    const int32 lodBias = info.LODBias + renderContext.View.ModelLODBias;
+    lodIndex += lodBias;
+    if (!renderContext.View.IsOfflinePass)
+        model->RequestLOD(lodIndex, predictedLodIndex != -1 ? predictedLodIndex + lodBias : lodIndex);
     lodIndex = model->ClampLODIndex(lodIndex);
 
-    if (renderContext.View.IsSingleFrame)
+    // Skip LOD transitions state update for views that use a different LOD bias than the view that drives the LOD selection (eg. shadow projections)
+    const bool directLOD = renderContext.View.IsSingleFrame || (renderContext.LodProxyView && renderContext.View.ModelLODBias != renderContext.LodProxyView->ModelLODBias);
+    if (directLOD)
     {
     }
     // Check if it's the new frame and could update the drawing state (note: model instance could be rendered many times per frame to different viewports)
@@ -251,22 +282,36 @@ FORCE_INLINE void SkinnedModelDraw(SkinnedModel* model, const RenderContext& ren
         info.DrawState->LODTransition = 255;
     }
 
+    // Draw shadow projections with a separate LOD when they use a different LOD bias (eg. lower-quality LOD as a shadow proxy)
+    const SkinnedMesh::DrawInfo* drawInfo = &info;
+    SkinnedMesh::DrawInfo mainInfo;
+    const int32 shadowsLodIndex = model->ClampLODIndex(lodIndex + GetShadowsLODBias(context));
+    if (shadowsLodIndex != lodIndex)
+    {
+        SkinnedMesh::DrawInfo shadowsInfo = info;
+        shadowsInfo.ShadowsOnly = true;
+        model->LODs.Get()[shadowsLodIndex].Draw(context, shadowsInfo, 0.0f);
+        mainInfo = info;
+        mainInfo.SkipShadows = true;
+        drawInfo = &mainInfo;
+    }
+
     // Draw
-    if (info.DrawState->PrevLOD == lodIndex || renderContext.View.IsSingleFrame)
+    if (info.DrawState->PrevLOD == lodIndex || directLOD)
     {
-        model->LODs.Get()[lodIndex].Draw(context, info, 0.0f);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, 0.0f);
     }
     else if (info.DrawState->PrevLOD == -1)
     {
         const float normalizedProgress = static_cast<float>(info.DrawState->LODTransition) * (1.0f / 255.0f);
-        model->LODs.Get()[lodIndex].Draw(context, info, 1.0f - normalizedProgress);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, 1.0f - normalizedProgress);
     }
     else
     {
         const auto prevLOD = model->ClampLODIndex(info.DrawState->PrevLOD);
         const float normalizedProgress = static_cast<float>(info.DrawState->LODTransition) * (1.0f / 255.0f);
-        model->LODs.Get()[prevLOD].Draw(context, info, normalizedProgress);
-        model->LODs.Get()[lodIndex].Draw(context, info, normalizedProgress - 1.0f);
+        model->LODs.Get()[prevLOD].Draw(context, *drawInfo, normalizedProgress);
+        model->LODs.Get()[lodIndex].Draw(context, *drawInfo, normalizedProgress - 1.0f);
     }
 }
 
@@ -674,6 +719,24 @@ bool SkinnedModel::Save(bool withMeshDataFromGpu, const StringView& path)
     return false;
 }
 
+bool SkinnedModel::BakeVertexAnimation(Animation* animation, const StringView& modelPath, const StringView& texturePath, float framesPerSecond)
+{
+    ModelData modelData;
+    TextureData textureData;
+    if (ModelTool::BakeVertexAnimation(this, animation, framesPerSecond, modelData, textureData))
+    {
+        LOG(Error, "Failed to bake vertex animation of \'{0}\'", ToString());
+        return true;
+    }
+    if (AssetsImportingManager::Create(AssetsImportingManager::CreateTextureAsTextureDataTag, texturePath, &textureData) ||
+        AssetsImportingManager::Create(AssetsImportingManager::CreateModelTag, modelPath, &modelData))
+    {
+        LOG(Error, "Cannot save baked vertex animation of \'{0}\'", ToString());
+        return true;
+    }
+    return false;
+}
+
 #endif
 
 bool SkinnedModel::Init(const Span<int32>& meshesCountPerLod)
@@ -806,6 +869,22 @@ int32 SkinnedModel::GetAllocatedResidency() const
     return LODs.Count();
 }
 
+uint64 SkinnedModel::GetMemoryUsage() const
+{
+    uint64 result = 0;
+    for (int32 lodIndex = HighestResidentLODIndex(); lodIndex < LODs.Count(); lodIndex++)
+    {
+        for (const SkinnedMesh& mesh : LODs[lodIndex].Meshes)
+        {
+            if (const GPUBuffer* vb = mesh.GetVertexBuffer())
+                result += vb->GetMemoryUsage();
+            if (const GPUBuffer* ib = mesh.GetIndexBuffer())
+                result += ib->GetMemoryUsage();
+        }
+    }
+    return result;
+}
+
 bool SkinnedModel::CanBeUpdated() const
 {
     // Check if is ready and has no streaming tasks running
@@ -8,6 +8,7 @@
 #include "Engine/Graphics/Models/SkinnedModelLOD.h"
 
 class StreamSkinnedModelLODTask;
+class Animation;
 
 /// <summary>
 /// Skinned model asset that contains model object made of meshes that can be rendered on the GPU using skeleton bones skinning.
@@ -254,6 +255,17 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedModel : public ModelBase
     /// <returns>True if cannot save data, otherwise false.</returns>
     API_FUNCTION() bool Save(bool withMeshDataFromGpu = false, const StringView& path = StringView::Empty);
 
+    /// <summary>
+    /// Bakes the animation into the vertex animation texture (VAT) and creates the static model that plays it on the GPU. Supported only in Editor.
+    /// </summary>
+    /// <remarks>Use the Vertex Animation Texture material node (connected to the Position Offset) to animate the static model with the baked texture. Such model can be drawn with instancing (eg. via foliage) without any animation cost on a CPU. The model bounds are computed from the bind pose so use the bounds scale of the actor if animation moves vertices outside of it.</remarks>
+    /// <param name="animation">The animation to bake.</param>
+    /// <param name="modelPath">The output static model asset path.</param>
+    /// <param name="texturePath">The output vertex animation texture asset path.</param>
+    /// <param name="framesPerSecond">The amount of the baked frames per second of the animation.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() bool BakeVertexAnimation(Animation* animation, const StringView& modelPath, const StringView& texturePath, float framesPerSecond = 30.0f);
+
 #endif
 
 private:
@@ -279,6 +291,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedModel : public ModelBase
     int32 GetMaxResidency() const override;
     int32 GetCurrentResidency() const override;
     int32 GetAllocatedResidency() const override;
+    uint64 GetMemoryUsage() const override;
     bool CanBeUpdated() const override;
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
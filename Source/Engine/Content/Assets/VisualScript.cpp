@@ -952,7 +952,7 @@ void VisualScriptExecutor::ProcessGroupFlow(Box* boxBase, Node* node, Value& val
     // If
     case 1:
     {
-        const bool condition = (bool)tryGetValue(node->GetBox(1), Value::Zero);
+        const bool condition = tryGetValue<bool>(node->GetBox(1), Value::Zero);
         boxBase = node->GetBox(condition ? 2 : 3);
         if (boxBase->HasConnection())
             eatBox(node, boxBase->FirstConnection());
@@ -979,8 +979,8 @@ void VisualScriptExecutor::ProcessGroupFlow(Box* boxBase, Node* node, Value& val
             auto& iteratorValue = scope->ReturnedValues[iteratorIndex];
             iteratorValue.NodeId = node->ID;
             iteratorValue.BoxId = 0;
-            iteratorValue.Value = (int32)tryGetValue(node->GetBox(1), 0, Value::Zero);
-            const int32 count = (int32)tryGetValue(node->GetBox(2), 1, Value::Zero);
+            iteratorValue.Value = tryGetValue<int32>(node->GetBox(1), 0, Value::Zero);
+            const int32 count = tryGetValue<int32>(node->GetBox(2), 1, Value::Zero);
             for (; iteratorValue.Value.AsInt < count; iteratorValue.Value.AsInt++)
             {
                 boxBase = node->GetBox(4);
@@ -1028,7 +1028,7 @@ void VisualScriptExecutor::ProcessGroupFlow(Box* boxBase, Node* node, Value& val
             iteratorValue.NodeId = node->ID;
             iteratorValue.BoxId = 0;
             iteratorValue.Value = 0;
-            for (; (bool)tryGetValue(node->GetBox(1), 1, Value::Zero) && iteratorValue.Value.AsInt != -1; iteratorValue.Value.AsInt++)
+            for (; tryGetValue<bool>(node->GetBox(1), 1, Value::Zero) && iteratorValue.Value.AsInt != -1; iteratorValue.Value.AsInt++)
             {
                 boxBase = node->GetBox(3);
                 if (boxBase->HasConnection())
@@ -1093,7 +1093,7 @@ void VisualScriptExecutor::ProcessGroupFlow(Box* boxBase, Node* node, Value& val
         boxBase = node->GetBox(2);
         if (!boxBase->HasConnection())
             break;
-        const float duration = (float)tryGetValue(node->GetBox(1), node->Values[0]);
+        const float duration = tryGetValue<float>(node->GetBox(1), node->Values[0]);
         if (duration > ZeroTolerance)
         {
             class DelayTask : public MainThreadTask
@@ -242,8 +242,11 @@ ContentLoadTask* BinaryAsset::RequestChunkDataAsync(int32 index)
         return nullptr;
     }
 
-    // Spawn loading task
-    return New<LoadAssetDataTask>(this, GET_CHUNK_FLAG(index));
+    // Spawn loading task (chunk data requests come from resources streaming so don't block regular assets loading)
+    auto task = New<LoadAssetDataTask>(this, GET_CHUNK_FLAG(index));
+    if (task->GetPriority() == ContentLoadTask::Priority::Normal)
+        task->SetPriority(ContentLoadTask::Priority::Low);
+    return task;
 }
 
 void BinaryAsset::GetChunkData(int32 index, BytesContainer& data) const
@@ -288,6 +291,8 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks)
         return false;
 
     // Load all missing marked chunks
+    FlaxChunk* toLoad[ASSET_FILE_DATA_CHUNKS];
+    int32 toLoadCount = 0;
     for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
     {
         auto chunk = _header.Chunks[i];
@@ -296,12 +301,11 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks)
             && chunk->IsMissing()
             && chunk->ExistsInFile())
         {
-            if (Storage->LoadAssetChunk(chunk))
-                return true;
+            toLoad[toLoadCount++] = chunk;
         }
     }
 
-    return false;
+    return Storage->LoadAssetChunks(Span<FlaxChunk*>(toLoad, toLoadCount));
 }
 
 #if USE_EDITOR
@@ -31,6 +31,16 @@ void AssetsCache::Init()
     _path = Globals::ProjectCacheFolder / TEXT("AssetsCache.dat");
 #else
     _path = Globals::ProjectContentFolder / TEXT("AssetsCache.dat");
+
+    // Use the binary index from the cooked game if available (queried in-place without building registry dictionaries)
+    const String indexPath = Globals::ProjectContentFolder / TEXT("AssetsCache.idx");
+    if (FileSystem::FileExists(indexPath) && !_index.Load(indexPath))
+    {
+        _isDirty = false;
+        const int32 loadTimeInMs = static_cast<int32>((DateTime::Now() - loadStartTime).GetTotalMilliseconds());
+        LOG(Info, "Asset Cache index loaded {0} entries in {1} ms", _index.Count(), loadTimeInMs);
+        return;
+    }
 #endif
 
     LOG(Info, "Loading Asset Cache {0}...", _path);
@@ -233,6 +243,15 @@ bool AssetsCache::Save(const StringView& path, const Registry& entries, const Pa
     return false;
 }
 
+bool AssetsCache::SaveIndex(const StringView& path, const Registry& entries, const PathsMapping& pathsMapping, const Dependencies* dependencies, const AssetsCacheFlags flags)
+{
+    Array<AssetInfo> infos;
+    infos.EnsureCapacity(entries.Count());
+    for (auto i = entries.Begin(); i.IsNotEnd(); ++i)
+        infos.Add(i->Value.Info);
+    return AssetsCacheIndex::Save(path, infos, pathsMapping, dependencies, EnumHasAnyFlags(flags, AssetsCacheFlags::RelativePaths));
+}
+
 const String& AssetsCache::GetEditorAssetPath(const Guid& id) const
 {
     ScopeLock lock(_locker);
@@ -245,7 +264,8 @@ const String& AssetsCache::GetEditorAssetPath(const Guid& id) const
         if (e.Value == id)
             return e.Key;
     }
-    return String::Empty;
+    const String* mappedPath = _index.FindMappedPath(id);
+    return mappedPath ? *mappedPath : String::Empty;
 #endif
 }
 
@@ -264,10 +284,11 @@ bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
         return FindAsset(id, info);
     }
 #if !USE_EDITOR
+    String absolutePath;
     if (FileSystem::IsRelative(path))
     {
         // Additional check if user provides path relative to the project folder (eg. Content/SomeAssets/MyFile.json)
-        const String absolutePath = Globals::ProjectFolder / *path;
+        absolutePath = Globals::ProjectFolder / *path;
         if (_pathsMapping.TryGet(absolutePath, id))
         {
             return FindAsset(id, info);
@@ -297,6 +318,21 @@ bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
         }
     }
 
+    // Fallback to the cooked assets index (registry has priority as it contains runtime-registered assets)
+    if (!result)
+    {
+        if (_index.FindAsset(path, id))
+        {
+            return FindAsset(id, info);
+        }
+#if !USE_EDITOR
+        if (absolutePath.HasChars() && _index.FindAsset(absolutePath, id))
+        {
+            return FindAsset(id, info);
+        }
+#endif
+    }
+
     return result;
 }
 
@@ -320,14 +356,25 @@ bool AssetsCache::FindAsset(const Guid& id, AssetInfo& info)
             info = e->Info;
         }
     }
+    else
+    {
+        result = _index.FindAsset(id, info);
+    }
     return result;
 }
 
+bool AssetsCache::GetDependencies(const Guid& id, Array<Guid>& result) const
+{
+    ScopeLock lock(_locker);
+    return _index.GetDependencies(id, result);
+}
+
 void AssetsCache::GetAll(Array<Guid>& result) const
 {
     PROFILE_CPU();
     ScopeLock lock(_locker);
     _registry.GetKeys(result);
+    _index.GetAll(result);
 }
 
 void AssetsCache::GetAllByTypeName(const StringView& typeName, Array<Guid>& result) const
@@ -339,6 +386,7 @@ void AssetsCache::GetAllByTypeName(const StringView& typeName, Array<Guid>& resu
         if (i->Value.Info.TypeName == typeName)
             result.Add(i->Key);
     }
+    _index.GetAllByTypeName(typeName, result);
 }
 
 void AssetsCache::RegisterAssets(FlaxStorage* storage)
@@ -370,8 +418,8 @@ void AssetsCache::RegisterAssets(FlaxStorage* storage)
         auto& e = entries[i];
         ASSERT(e.ID.IsValid());
 
-        // Check if storage contains ID which has been already registered
-        if (FindAsset(e.ID, info))
+        // Check if storage contains ID which has been already registered (skip read-only index entries from the same location)
+        if (FindAsset(e.ID, info) && info.Path != storagePath)
         {
 #if PLATFORM_WINDOWS
             // On Windows - if you start your project using a shortcut/VS commandline -project, and using a upper/lower drive letter, it could the cache (case doesn't matter on OS)
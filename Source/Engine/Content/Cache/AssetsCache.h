@@ -4,6 +4,7 @@
 
 #include "../AssetInfo.h"
 #include "../Config.h"
+#include "AssetsCacheIndex.h"
 #include "Engine/Core/Types/Guid.h"
 #if ENABLE_ASSETS_DISCOVERY
 #include "Engine/Core/Types/DateTime.h"
@@ -72,12 +73,14 @@ class FLAXENGINE_API AssetsCache
 
     typedef Dictionary<Guid, Entry> Registry;
     typedef Dictionary<String, Guid> PathsMapping;
+    typedef Dictionary<Guid, Array<Guid>> Dependencies;
 
 private:
     bool _isDirty;
     CriticalSection _locker;
     Registry _registry;
     PathsMapping _pathsMapping;
+    mutable AssetsCacheIndex _index;
     String _path;
 
 public:
@@ -94,7 +97,7 @@ class FLAXENGINE_API AssetsCache
     int32 Size() const
     {
         _locker.Lock();
-        const int32 result = _registry.Count();
+        const int32 result = _registry.Count() + _index.Count();
         _locker.Unlock();
         return result;
     }
@@ -121,6 +124,17 @@ class FLAXENGINE_API AssetsCache
     /// <returns>True if failed, otherwise false.</returns>
     static bool Save(const StringView& path, const Registry& entries, const PathsMapping& pathsMapping, const AssetsCacheFlags flags = AssetsCacheFlags::None);
 
+    /// <summary>
+    /// Saves the registry to the given file using the binary index format that can be memory-mapped at runtime (see <see cref="AssetsCacheIndex"/>).
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <param name="entries">The registry entries.</param>
+    /// <param name="pathsMapping">The assets paths mapping table.</param>
+    /// <param name="dependencies">The assets dependencies table (optional).</param>
+    /// <param name="flags">The custom flags.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool SaveIndex(const StringView& path, const Registry& entries, const PathsMapping& pathsMapping, const Dependencies* dependencies = nullptr, const AssetsCacheFlags flags = AssetsCacheFlags::None);
+
 public:
     /// <summary>
     /// Finds the asset path by id. In editor it returns the actual asset path, at runtime it returns the mapped asset path.
@@ -167,6 +181,14 @@ class FLAXENGINE_API AssetsCache
         return FindAsset(id, info);
     }
 
+    /// <summary>
+    /// Gets the direct dependencies of the asset (other assets referenced by it). Available only in cooked games (recorded during game cooking).
+    /// </summary>
+    /// <param name="id">The asset id.</param>
+    /// <param name="result">The result array to append dependencies to.</param>
+    /// <returns>True if found asset dependencies, otherwise false.</returns>
+    bool GetDependencies(const Guid& id, Array<Guid, HeapAllocation>& result) const;
+
     /// <summary>
     /// Gets the asset ids.
     /// </summary>
@@ -0,0 +1,326 @@
+// Copyright (c) 2012-2022 Wojciech Figat. All rights reserved.
+
+#include "AssetsCacheIndex.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Engine/Globals.h"
+#include "FlaxEngine.Gen.h"
+
+#define ASSETS_CACHE_INDEX_MAGIC 0x49434146 // 'FACI'
+
+namespace
+{
+    bool CompareGuid(const Guid& a, const Guid& b)
+    {
+        if (a.A != b.A)
+            return a.A < b.A;
+        if (a.B != b.B)
+            return a.B < b.B;
+        if (a.C != b.C)
+            return a.C < b.C;
+        return a.D < b.D;
+    }
+
+    bool SortEntries(const AssetsCacheIndex::FileEntry& a, const AssetsCacheIndex::FileEntry& b)
+    {
+        return CompareGuid(a.ID, b.ID);
+    }
+
+    bool SortPaths(const AssetsCacheIndex::FilePath& a, const AssetsCacheIndex::FilePath& b)
+    {
+        // Keep insertion order for the same hash (paths mapping has priority over assets paths)
+        return a.Hash < b.Hash || (a.Hash == b.Hash && a.Path < b.Path);
+    }
+
+    uint32 AddString(Array<Char>& strings, const StringView& str)
+    {
+        const uint32 offset = strings.Count();
+        strings.Add(str.Get(), str.Length());
+        return offset;
+    }
+}
+
+AssetsCacheIndex::~AssetsCacheIndex()
+{
+    Unload();
+}
+
+bool AssetsCacheIndex::Load(const StringView& path)
+{
+    PROFILE_CPU();
+    Unload();
+
+    // Map the file or read it as a fallback
+    _file = File::Open(path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+    if (!_file)
+        return true;
+    _mappedData = _file->MapView(_mappedSize);
+    const byte* data = _mappedData;
+    uint32 size = _mappedSize;
+    if (!_mappedData)
+    {
+        Delete(_file);
+        _file = nullptr;
+        if (File::ReadAllBytes(path, _data))
+            return true;
+        data = _data.Get();
+        size = _data.Count();
+    }
+
+    // Validate data
+    const auto header = (const FileHeader*)data;
+    if (size < sizeof(FileHeader) ||
+        header->Magic != ASSETS_CACHE_INDEX_MAGIC ||
+        header->Version != FLAXENGINE_VERSION_BUILD ||
+        sizeof(FileHeader) + (uint64)header->EntriesCount * sizeof(FileEntry) + (uint64)header->PathsCount * sizeof(FilePath) + (uint64)header->DependenciesCount * sizeof(Guid) + (uint64)header->StringsLength * sizeof(Char) != size)
+    {
+        LOG(Warning, "Corrupted or not supported Asset Cache index file.");
+        Unload();
+        return true;
+    }
+    _header = header;
+    _entries = (const FileEntry*)(data + sizeof(FileHeader));
+    _paths = (const FilePath*)(_entries + header->EntriesCount);
+    _dependencies = (const Guid*)(_paths + header->PathsCount);
+    _strings = (const Char*)(_dependencies + header->DependenciesCount);
+    return false;
+}
+
+void AssetsCacheIndex::Unload()
+{
+    if (_mappedData)
+    {
+        _file->UnmapView(_mappedData, _mappedSize);
+        _mappedData = nullptr;
+        _mappedSize = 0;
+    }
+    if (_file)
+    {
+        Delete(_file);
+        _file = nullptr;
+    }
+    _data.Resize(0);
+    _header = nullptr;
+    _entries = nullptr;
+    _paths = nullptr;
+    _dependencies = nullptr;
+    _strings = nullptr;
+    _mappedPaths.ClearDelete();
+}
+
+bool AssetsCacheIndex::FindAsset(const Guid& id, AssetInfo& info) const
+{
+    const FileEntry* e = FindEntry(id);
+    if (!e)
+        return false;
+    info.ID = id;
+    info.TypeName = GetString(e->TypeName, e->TypeNameLength);
+    info.Path = GetFullPath(GetString(e->Path, e->PathLength));
+    return true;
+}
+
+bool AssetsCacheIndex::FindAsset(const StringView& path, Guid& id) const
+{
+    if (!_header)
+        return false;
+    const StringView queryPath = GetQueryPath(path);
+    const uint32 hash = GetHash(queryPath);
+
+    // Find the first path with that hash and check all collisions
+    int32 min = 0, max = _header->PathsCount;
+    while (min < max)
+    {
+        const int32 mid = (min + max) / 2;
+        if (_paths[mid].Hash < hash)
+            min = mid + 1;
+        else
+            max = mid;
+    }
+    for (int32 i = min; i < _header->PathsCount && _paths[i].Hash == hash; i++)
+    {
+        const FilePath& e = _paths[i];
+        if (GetString(e.Path, e.PathLength) == queryPath)
+        {
+            id = e.ID;
+            return true;
+        }
+    }
+    return false;
+}
+
+const String* AssetsCacheIndex::FindMappedPath(const Guid& id)
+{
+    if (!_header)
+        return nullptr;
+    String* result;
+    if (_mappedPaths.TryGet(id, result))
+        return result;
+    result = nullptr;
+    AssetInfo info;
+    const bool hasAsset = FindAsset(id, info);
+    for (int32 i = 0; i < _header->PathsCount; i++)
+    {
+        const FilePath& e = _paths[i];
+        if (e.ID != id)
+            continue;
+
+        // Skip the asset path itself (paths mapping contains the original project paths)
+        const String path = GetFullPath(GetString(e.Path, e.PathLength));
+        if (hasAsset && path == info.Path)
+            continue;
+        result = New<String>(path);
+        break;
+    }
+    _mappedPaths.Add(id, result);
+    return result;
+}
+
+bool AssetsCacheIndex::GetDependencies(const Guid& id, Array<Guid>& result) const
+{
+    const FileEntry* e = FindEntry(id);
+    if (!e)
+        return false;
+    result.Add(_dependencies + e->Dependencies, (int32)e->DependenciesCount);
+    return true;
+}
+
+void AssetsCacheIndex::GetAll(Array<Guid, HeapAllocation>& result) const
+{
+    if (!_header)
+        return;
+    result.EnsureCapacity(result.Count() + _header->EntriesCount);
+    for (int32 i = 0; i < _header->EntriesCount; i++)
+        result.Add(_entries[i].ID);
+}
+
+void AssetsCacheIndex::GetAllByTypeName(const StringView& typeName, Array<Guid, HeapAllocation>& result) const
+{
+    if (!_header)
+        return;
+    for (int32 i = 0; i < _header->EntriesCount; i++)
+    {
+        const FileEntry& e = _entries[i];
+        if (GetString(e.TypeName, e.TypeNameLength) == typeName)
+            result.Add(e.ID);
+    }
+}
+
+bool AssetsCacheIndex::Save(const StringView& path, const Array<AssetInfo>& entries, const Dictionary<String, Guid>& pathsMapping, const Dictionary<Guid, Array<Guid>>* dependencies, bool relativePaths)
+{
+    PROFILE_CPU();
+    LOG(Info, "Saving assets cache index to \'{0}\', entries: {1}", path, entries.Count());
+
+    // Build tables
+    Array<FileEntry> fileEntries;
+    Array<FilePath> filePaths;
+    Array<Guid> fileDependencies;
+    Array<Char> strings;
+    Dictionary<StringView, uint32> stringsMap;
+    HashSet<StringView> pathsAdded;
+    fileEntries.EnsureCapacity(entries.Count());
+    filePaths.EnsureCapacity(entries.Count() + pathsMapping.Count());
+    for (auto i = pathsMapping.Begin(); i.IsNotEnd(); ++i)
+    {
+        pathsAdded.Add(i->Key);
+        auto& e = filePaths.AddOne();
+        e.Hash = GetHash(StringView(i->Key));
+        e.Path = AddString(strings, i->Key);
+        e.PathLength = i->Key.Length();
+        e.ID = i->Value;
+    }
+    for (const AssetInfo& info : entries)
+    {
+        if (info.Path.IsEmpty())
+            continue;
+        auto& e = fileEntries.AddOne();
+        e.ID = info.ID;
+        if (!stringsMap.TryGet(info.TypeName, e.TypeName))
+        {
+            e.TypeName = AddString(strings, info.TypeName);
+            stringsMap.Add(info.TypeName, e.TypeName);
+        }
+        e.TypeNameLength = info.TypeName.Length();
+        e.Path = AddString(strings, info.Path);
+        e.PathLength = info.Path.Length();
+        e.Dependencies = fileDependencies.Count();
+        e.DependenciesCount = 0;
+        const Array<Guid>* assetDependencies = dependencies ? dependencies->TryGet(info.ID) : nullptr;
+        if (assetDependencies)
+        {
+            fileDependencies.Add(*assetDependencies);
+            e.DependenciesCount = assetDependencies->Count();
+        }
+
+        // Multiple assets can share the same path (eg. package file) so index only the first one
+        if (!pathsAdded.Add(info.Path))
+            continue;
+        auto& p = filePaths.AddOne();
+        p.Hash = GetHash(StringView(info.Path));
+        p.Path = e.Path;
+        p.PathLength = e.PathLength;
+        p.ID = info.ID;
+    }
+    Sorting::QuickSort(fileEntries.Get(), fileEntries.Count(), &SortEntries);
+    Sorting::QuickSort(filePaths.Get(), filePaths.Count(), &SortPaths);
+
+    // Write file
+    FileHeader header;
+    header.Magic = ASSETS_CACHE_INDEX_MAGIC;
+    header.Version = FLAXENGINE_VERSION_BUILD;
+    header.RelativePaths = relativePaths ? 1 : 0;
+    header.EntriesCount = fileEntries.Count();
+    header.PathsCount = filePaths.Count();
+    header.DependenciesCount = fileDependencies.Count();
+    header.StringsLength = strings.Count();
+    Array<byte> data;
+    data.Resize(sizeof(FileHeader) + fileEntries.Count() * sizeof(FileEntry) + filePaths.Count() * sizeof(FilePath) + fileDependencies.Count() * sizeof(Guid) + strings.Count() * sizeof(Char));
+    byte* ptr = data.Get();
+    Platform::MemoryCopy(ptr, &header, sizeof(FileHeader));
+    ptr += sizeof(FileHeader);
+    Platform::MemoryCopy(ptr, fileEntries.Get(), fileEntries.Count() * sizeof(FileEntry));
+    ptr += fileEntries.Count() * sizeof(FileEntry);
+    Platform::MemoryCopy(ptr, filePaths.Get(), filePaths.Count() * sizeof(FilePath));
+    ptr += filePaths.Count() * sizeof(FilePath);
+    Platform::MemoryCopy(ptr, fileDependencies.Get(), fileDependencies.Count() * sizeof(Guid));
+    ptr += fileDependencies.Count() * sizeof(Guid);
+    Platform::MemoryCopy(ptr, strings.Get(), strings.Count() * sizeof(Char));
+    return File::WriteAllBytes(path, data);
+}
+
+const AssetsCacheIndex::FileEntry* AssetsCacheIndex::FindEntry(const Guid& id) const
+{
+    if (!_header)
+        return nullptr;
+    int32 min = 0, max = _header->EntriesCount - 1;
+    while (min <= max)
+    {
+        const int32 mid = (min + max) / 2;
+        const FileEntry& e = _entries[mid];
+        if (e.ID == id)
+            return &e;
+        if (CompareGuid(e.ID, id))
+            min = mid + 1;
+        else
+            max = mid - 1;
+    }
+    return nullptr;
+}
+
+String AssetsCacheIndex::GetFullPath(const StringView& path) const
+{
+    if (_header->RelativePaths && path.HasChars())
+        return Globals::StartupFolder / path;
+    return String(path);
+}
+
+StringView AssetsCacheIndex::GetQueryPath(const StringView& path) const
+{
+    // Convert absolute path into relative to the startup folder
+    const String& root = Globals::StartupFolder;
+    if (_header->RelativePaths && path.Length() > root.Length() && path[root.Length()] == '/' && path.StartsWith(StringView(root), StringSearchCase::CaseSensitive))
+        return StringView(path.Get() + root.Length() + 1, path.Length() - root.Length() - 1);
+    return path;
+}
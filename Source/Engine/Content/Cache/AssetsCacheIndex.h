@@ -0,0 +1,172 @@
+// Copyright (c) 2012-2022 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../AssetInfo.h"
+#include "Engine/Core/Types/Guid.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/Types/StringView.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/NonCopyable.h"
+#include "Engine/Platform/Types.h"
+
+/// <summary>
+/// Read-only assets registry in a sorted, pointer-free binary format that can be memory-mapped and queried in place (without building registry dictionaries).
+/// Contains the assets sorted by ID and the paths hash index (assets paths and paths mapping). Used by the cooked games for fast startup.
+/// </summary>
+class FLAXENGINE_API AssetsCacheIndex : public NonCopyable
+{
+public:
+    /// <summary>
+    /// The index file header.
+    /// </summary>
+    struct FileHeader
+    {
+        uint32 Magic;
+        int32 Version;
+        int32 RelativePaths;
+        int32 EntriesCount;
+        int32 PathsCount;
+        int32 DependenciesCount;
+        int32 StringsLength;
+    };
+
+    /// <summary>
+    /// The asset entry (sorted by ID). Strings are stored as offset and length (in characters) within the strings table. Dependencies are stored as offset and count within the dependencies table.
+    /// </summary>
+    struct FileEntry
+    {
+        Guid ID;
+        uint32 TypeName;
+        uint32 TypeNameLength;
+        uint32 Path;
+        uint32 PathLength;
+        uint32 Dependencies;
+        uint32 DependenciesCount;
+    };
+
+    /// <summary>
+    /// The path index entry (sorted by path hash).
+    /// </summary>
+    struct FilePath
+    {
+        uint32 Hash;
+        uint32 Path;
+        uint32 PathLength;
+        Guid ID;
+    };
+
+private:
+    File* _file = nullptr;
+    byte* _mappedData = nullptr;
+    uint32 _mappedSize = 0;
+    Array<byte> _data;
+    const FileHeader* _header = nullptr;
+    const FileEntry* _entries = nullptr;
+    const FilePath* _paths = nullptr;
+    const Guid* _dependencies = nullptr;
+    const Char* _strings = nullptr;
+    Dictionary<Guid, String*> _mappedPaths;
+
+public:
+    /// <summary>
+    /// Finalizes an instance of the <see cref="AssetsCacheIndex"/> class.
+    /// </summary>
+    ~AssetsCacheIndex();
+
+public:
+    /// <summary>
+    /// Checks if index is loaded.
+    /// </summary>
+    FORCE_INLINE bool IsLoaded() const
+    {
+        return _header != nullptr;
+    }
+
+    /// <summary>
+    /// Gets the amount of assets in the index.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return _header ? _header->EntriesCount : 0;
+    }
+
+    /// <summary>
+    /// Loads the index from the file (memory-mapped if platform supports it).
+    /// </summary>
+    /// <param name="path">The file path.</param>
+    /// <returns>True if failed to load it, otherwise false.</returns>
+    bool Load(const StringView& path);
+
+    /// <summary>
+    /// Unloads the index.
+    /// </summary>
+    void Unload();
+
+    /// <summary>
+    /// Finds the asset info by id.
+    /// </summary>
+    /// <param name="id">The asset id.</param>
+    /// <param name="info">The output asset info. Filled with valid values if method returns true.</param>
+    /// <returns>True if found asset, otherwise false.</returns>
+    bool FindAsset(const Guid& id, AssetInfo& info) const;
+
+    /// <summary>
+    /// Finds the asset id by path (asset path or mapped path).
+    /// </summary>
+    /// <param name="path">The asset path.</param>
+    /// <param name="id">The output asset id. Filled with valid value if method returns true.</param>
+    /// <returns>True if found asset, otherwise false.</returns>
+    bool FindAsset(const StringView& path, Guid& id) const;
+
+    /// <summary>
+    /// Finds the mapped path of the asset (the original asset path in the project). Result string is cached and valid until index gets unloaded.
+    /// </summary>
+    /// <param name="id">The asset id.</param>
+    /// <returns>The mapped path or null if missing.</returns>
+    const String* FindMappedPath(const Guid& id);
+
+    /// <summary>
+    /// Gets the direct dependencies of the asset (other assets referenced by it), recorded during game cooking.
+    /// </summary>
+    /// <param name="id">The asset id.</param>
+    /// <param name="result">The result array to append dependencies to.</param>
+    /// <returns>True if found asset, otherwise false.</returns>
+    bool GetDependencies(const Guid& id, Array<Guid, HeapAllocation>& result) const;
+
+    /// <summary>
+    /// Gets the asset ids.
+    /// </summary>
+    /// <param name="result">The result array.</param>
+    void GetAll(Array<Guid, HeapAllocation>& result) const;
+
+    /// <summary>
+    /// Gets the asset ids that match the given typename.
+    /// </summary>
+    /// <param name="typeName">The asset typename.</param>
+    /// <param name="result">The result array.</param>
+    void GetAllByTypeName(const StringView& typeName, Array<Guid, HeapAllocation>& result) const;
+
+    /// <summary>
+    /// Saves the index to the given file.
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <param name="entries">The assets.</param>
+    /// <param name="pathsMapping">The assets paths mapping table.</param>
+    /// <param name="dependencies">The assets dependencies table (optional).</param>
+    /// <param name="relativePaths">True if the paths are relative to the startup folder (should be converted to absolute on load).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool Save(const StringView& path, const Array<AssetInfo>& entries, const Dictionary<String, Guid>& pathsMapping, const Dictionary<Guid, Array<Guid>>* dependencies, bool relativePaths);
+
+private:
+    const FileEntry* FindEntry(const Guid& id) const;
+
+    StringView GetString(uint32 offset, uint32 length) const
+    {
+        return StringView(_strings + offset, (int32)length);
+    }
+
+    String GetFullPath(const StringView& path) const;
+    StringView GetQueryPath(const StringView& path) const;
+};
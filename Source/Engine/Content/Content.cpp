@@ -5,15 +5,18 @@
 #include "SceneReference.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Cache/AssetsCache.h"
+#include "Loading/ContentLoadingManager.h"
 #include "Storage/ContentStorageManager.h"
 #include "Storage/JsonStorageProxy.h"
 #include "Factories/IAssetFactory.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/ObjectsRemovalService.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ConcurrentQueue.h"
 #include "Engine/Graphics/Graphics.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/Globals.h"
@@ -27,12 +30,10 @@
 #include "Editor/Editor.h"
 #include "Editor/ProjectInfo.h"
 #endif
-#if ENABLE_ASSETS_DISCOVERY
-#include "Engine/Core/Collections/HashSet.h"
-#endif
 
 TimeSpan Content::AssetsUpdateInterval = TimeSpan::FromMilliseconds(500);
 TimeSpan Content::AssetsUnloadInterval = TimeSpan::FromSeconds(10);
+bool Content::PrefetchDependencies = true;
 Delegate<Asset*> Content::AssetDisposing;
 Delegate<Asset*> Content::AssetReloading;
 
@@ -66,10 +67,15 @@ namespace
     AssetsCache Cache;
 
     // Unloading assets
+    ConcurrentQueue<Guid> UnreferencedAssets;
+    Array<Guid> UnreferencedAssetsToCheck;
     Dictionary<Asset*, TimeSpan> UnloadQueue;
     TimeSpan LastUnloadCheckTime(0);
     bool IsExiting = false;
 
+    // Prefetching dependencies
+    THREADLOCAL bool IsPrefetching = false;
+
 #if ENABLE_ASSETS_DISCOVERY
     DateTime LastWorkspaceDiscovery;
     CriticalSection WorkspaceDiscoveryLocker;
@@ -114,6 +120,7 @@ void ContentService::Update()
     while (LoadedAssetsToInvoke.HasItems())
     {
         auto asset = LoadedAssetsToInvoke.Dequeue();
+        ContentLoadingManager::AssetLoadScope loadScope(asset, ContentLoadingManager::AssetLoadStage::Finalize);
         asset->onLoaded_MainThread();
     }
 }
@@ -128,18 +135,20 @@ void ContentService::LateUpdate()
         return;
     LastUnloadCheckTime = timeNow;
 
+    // Pick assets that lost all references since the last check (queue holds ids so assets deleted in the meantime are skipped)
+    UnreferencedAssetsToCheck.Clear();
+    Guid id;
+    while (UnreferencedAssets.try_dequeue(id))
+        UnreferencedAssetsToCheck.Add(id);
+
     Asset* asset;
     ScopeLock lock(AssetsLocker);
 
-    // TODO: maybe it would be better to link for asset remove ref event and cache only assets with no references - test it with millions of assets?
-
-    // Verify all assets
-    for (auto i = Assets.Begin(); i.IsNotEnd(); ++i)
+    // Verify unreferenced assets
+    for (const Guid& assetId : UnreferencedAssetsToCheck)
     {
-        asset = i->Value;
-
-        // Check if has no references and is not during unloading
-        if (asset->GetReferencesCount() <= 0 && !UnloadQueue.ContainsKey(asset))
+        // Check if still has no references and is not during unloading
+        if (Assets.TryGet(assetId, asset) && asset->GetReferencesCount() <= 0 && !UnloadQueue.ContainsKey(asset))
         {
             // Add to removes
             UnloadQueue.Add(asset, timeNow);
@@ -855,6 +864,7 @@ Asset* Content::CreateVirtualAsset(const ScriptingTypeHandle& type)
     ASSERT(!Assets.ContainsKey(asset->GetID()));
     Assets.Add(asset->GetID(), asset);
     AssetsLocker.Unlock();
+    UnreferencedAssets.Add(asset->GetID());
 
     return asset;
 }
@@ -891,11 +901,20 @@ void Content::onAssetUnload(Asset* asset)
     LoadedAssetsToInvoke.Remove(asset);
 }
 
+void Content::onAssetUnreferenced(Asset* asset)
+{
+    // This is called by the asset when the last reference gets removed (from any thread)
+    if (!IsExiting)
+        UnreferencedAssets.Add(asset->GetID());
+}
+
 void Content::onAssetChangeId(Asset* asset, const Guid& oldId, const Guid& newId)
 {
     ScopeLock locker(AssetsLocker);
     Assets.Remove(oldId);
     Assets.Add(newId, asset);
+    if (asset->GetReferencesCount() <= 0)
+        UnreferencedAssets.Add(newId);
 }
 
 bool Content::IsAssetTypeIdInvalid(const ScriptingTypeHandle& type, const ScriptingTypeHandle& assetType)
@@ -989,9 +1008,34 @@ Asset* Content::LoadAsync(const Guid& id, const ScriptingTypeHandle& type)
     LoadCallAssets.Remove(id);
     LoadCallAssetsLocker.Unlock();
 
+    // Start loading the whole dependencies closure at once (instead of discovering it level by level during assets loading)
+    if (result && PrefetchDependencies && !IsPrefetching)
+        prefetchDependencies(id);
+
     return result;
 }
 
+void Content::prefetchDependencies(const Guid& id)
+{
+    Array<Guid> queue;
+    if (!Cache.GetDependencies(id, queue) || queue.IsEmpty())
+        return;
+    PROFILE_CPU();
+    IsPrefetching = true;
+    HashSet<Guid> visited;
+    visited.Add(id);
+    for (int32 i = 0; i < queue.Count(); i++)
+    {
+        const Guid dependency = queue[i];
+        // Skip already loaded assets (their dependencies are already being loaded)
+        if (!visited.Add(dependency) || GetAsset(dependency))
+            continue;
+        if (LoadAsync(dependency, Asset::TypeInitializer))
+            Cache.GetDependencies(dependency, queue);
+    }
+    IsPrefetching = false;
+}
+
 Asset* Content::load(const Guid& id, const ScriptingTypeHandle& type, AssetInfo& assetInfo)
 {
     // Get cached asset info (from registry)
@@ -1055,6 +1099,7 @@ Asset* Content::load(const Guid& id, const ScriptingTypeHandle& type, AssetInfo&
 #endif
     Assets.Add(id, result);
     AssetsLocker.Unlock();
+    UnreferencedAssets.Add(id);
 
     // Start asset loading
     result->startLoading();
@@ -46,6 +46,11 @@ API_CLASS(Static) class FLAXENGINE_API Content
     /// </summary>
     static TimeSpan AssetsUnloadInterval;
 
+    /// <summary>
+    /// True if loading the asset should start loading all of its dependencies (recursively) at once, using the dependencies recorded during game cooking. Makes loading time scale with I/O bandwidth rather than with the dependency chain depth. Prefetched assets with no references are unloaded after <see cref="AssetsUnloadInterval"/>.
+    /// </summary>
+    static bool PrefetchDependencies;
+
 public:
     /// <summary>
     /// Gets the assets registry.
@@ -365,8 +370,10 @@ API_CLASS(Static) class FLAXENGINE_API Content
     static void tryCallOnLoaded(Asset* asset);
     static void onAssetLoaded(Asset* asset);
     static void onAssetUnload(Asset* asset);
+    static void onAssetUnreferenced(Asset* asset);
     static void onAssetChangeId(Asset* asset, const Guid& oldId, const Guid& newId);
     static Asset* load(const Guid& id, const ScriptingTypeHandle& type, AssetInfo& assetInfo);
+    static void prefetchDependencies(const Guid& id);
 
 private:
     static void deleteFileSafety(const StringView& path, const Guid& id);
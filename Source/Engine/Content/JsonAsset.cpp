@@ -3,7 +3,6 @@
 #include "JsonAsset.h"
 #if USE_EDITOR
 #include "Engine/Platform/File.h"
-#include "Engine/Core/Types/DataContainer.h"
 #include "Engine/Level/Level.h"
 #else
 #include "Storage/ContentStorageManager.h"
@@ -100,6 +99,7 @@ uint64 JsonAssetBase::GetMemoryUsage() const
     result += sizeof(JsonAssetBase) - sizeof(Asset);
     if (Data)
         result += Document.GetAllocator().Capacity();
+    result += _source.Capacity();
     Locker.Unlock();
     return result;
 }
@@ -168,13 +168,12 @@ Asset::LoadResult JsonAssetBase::loadAsset()
 
     // Load data (raw json file in editor, cooked asset in build game)
 #if USE_EDITOR
-    BytesContainer data;
-    if (File::ReadAllBytes(_path, data))
+    if (File::ReadAllBytes(_path, _source))
     {
         LOG(Warning, "Filed to load json asset data. {0}", ToString());
         return LoadResult::CannotLoadData;
     }
-    if (data.Length() == 0)
+    if (_source.Count() == 0)
     {
         return LoadResult::MissingDataChunk;
     }
@@ -195,13 +194,14 @@ Asset::LoadResult JsonAssetBase::loadAsset()
         return LoadResult::MissingDataChunk;
     if (storage->LoadAssetChunk(chunk))
         return LoadResult::CannotLoadData;
-    auto& data = chunk->Data;
+    _source.Set(chunk->Data.Get(), chunk->Data.Length());
 #endif
 
-    // Parse json document
+    // Parse json document in-situ (strings are decoded within the source buffer instead of being copied into the document allocator)
+    _source.Add(0);
     {
         PROFILE_CPU_NAMED("Json.Parse");
-        Document.Parse(data.Get<char>(), data.Length());
+        Document.ParseInsitu((char*)_source.Get());
     }
     if (Document.HasParseError())
     {
@@ -233,6 +233,7 @@ void JsonAssetBase::unload(bool isReloading)
 {
     ISerializable::SerializeDocument tmp;
     Document.Swap(tmp);
+    _source.SetCapacity(0, false);
     Data = nullptr;
     DataTypeName.Clear();
     DataEngineBuild = 0;
@@ -16,6 +16,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API JsonAssetBase : public Asset
 protected:
     String _path;
     bool _isVirtualDocument = false;
+    Array<byte> _source; // Null-terminated json text parsed in-situ (Document strings point into it so it lives as long as the document)
 
 protected:
     /// <summary>
@@ -13,6 +13,7 @@ class LoadingThread;
 class ContentLoadTask : public Task
 {
     friend LoadingThread;
+    friend class ContentLoadingManager;
 
 public:
     /// <summary>
@@ -25,21 +26,27 @@ class ContentLoadTask : public Task
     /// </summary>
     DECLARE_ENUM_5(Result, Ok, AssetLoadError, MissingReferences, LoadDataError, TaskFailed);
 
+    /// <summary>
+    /// Describes work priority. Loading threads pick higher priority tasks first.
+    /// </summary>
+    DECLARE_ENUM_4(Priority, Low, Normal, High, Critical);
+
 private:
     /// <summary>
     /// Task type
     /// </summary>
     Type _type;
 
+    Priority _priority;
+    double _deadline;
+    double _enqueueTime;
+
 protected:
     /// <summary>
-    /// Initializes a new instance of the <see cref="ContentLoadTask"/> class.
+    /// Initializes a new instance of the <see cref="ContentLoadTask"/> class. Uses the priority and deadline of the current thread (see ContentLoadingManager::PriorityScope).
     /// </summary>
     /// <param name="type">The task type.</param>
-    ContentLoadTask(const Type type)
-        : _type(type)
-    {
-    }
+    ContentLoadTask(const Type type);
 
 public:
     /// <summary>
@@ -50,6 +57,48 @@ class ContentLoadTask : public Task
         return _type;
     }
 
+    /// <summary>
+    /// Gets the task priority.
+    /// </summary>
+    FORCE_INLINE Priority GetPriority() const
+    {
+        return _priority;
+    }
+
+    /// <summary>
+    /// Sets the task priority. Has to be called before the task is started.
+    /// </summary>
+    /// <param name="priority">The priority.</param>
+    FORCE_INLINE void SetPriority(Priority priority)
+    {
+        _priority = priority;
+    }
+
+    /// <summary>
+    /// Gets the time when task was enqueued for the execution (in seconds, as Platform::GetTimeSeconds). The value of 0 means task was not enqueued.
+    /// </summary>
+    FORCE_INLINE double GetEnqueueTime() const
+    {
+        return _enqueueTime;
+    }
+
+    /// <summary>
+    /// Gets the task deadline (in seconds, as Platform::GetTimeSeconds). The value of 0 means no deadline.
+    /// </summary>
+    FORCE_INLINE double GetDeadline() const
+    {
+        return _deadline;
+    }
+
+    /// <summary>
+    /// Sets the task deadline (in seconds, as Platform::GetTimeSeconds). Tasks with a deadline are executed before any other tasks (earliest deadline first). Has to be called before the task is started.
+    /// </summary>
+    /// <param name="deadline">The deadline time or 0 to disable it.</param>
+    FORCE_INLINE void SetDeadline(double deadline)
+    {
+        _deadline = deadline;
+    }
+
 public:
     /// <summary>
     /// Checks if async task is loading given asset resource
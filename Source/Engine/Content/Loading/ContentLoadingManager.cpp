@@ -2,6 +2,7 @@
 
 #include "ContentLoadingManager.h"
 #include "ContentLoadTask.h"
+#include "Engine/Content/Asset.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/CPUInfo.h"
@@ -11,6 +12,7 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ConcurrentTaskQueue.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #if USE_EDITOR && PLATFORM_WINDOWS
 #include "Engine/Platform/Win32/IncludeWindowsHeaders.h"
 #include <propidlbase.h>
@@ -21,11 +23,24 @@ namespace ContentLoadingManagerImpl
     THREADLOCAL LoadingThread* ThisThread = nullptr;
     LoadingThread* MainThread = nullptr;
     Array<LoadingThread*> Threads;
-    ConcurrentTaskQueue<ContentLoadTask> Tasks;
+    ConcurrentTaskQueue<ContentLoadTask> Tasks[ContentLoadTask::Priority_Count];
+    CriticalSection DeadlineTasksLocker;
+    Array<ContentLoadTask*> DeadlineTasks; // Sorted by deadline (the earliest is the last one)
+    volatile int64 DeadlineTasksCount = 0;
     ConditionVariable TasksSignal;
     CriticalSection TasksMutex;
+    volatile int64 ThreadsAffinityMask = 0;
+    THREADLOCAL ContentLoadTask::Priority ThisPriority = ContentLoadTask::Priority::Normal;
+    THREADLOCAL double ThisDeadline = 0.0;
+    CriticalSection StatsLocker;
+    ContentLoadingManager::QueueStats Stats[ContentLoadTask::Priority_Count] = {};
+    Array<ContentLoadingManager::AssetLoadInfo> AssetLoads;
+    THREADLOCAL ContentLoadingManager::AssetLoadScope* ThisLoadScope = nullptr;
 };
 
+// The maximum amount of the asset loads records kept between the reads
+#define MAX_ASSET_LOADS 1024
+
 using namespace ContentLoadingManagerImpl;
 
 class ContentLoadingManagerService : public EngineService
@@ -95,7 +110,22 @@ bool LoadingThread::Start(const String& name)
 void LoadingThread::Run(ContentLoadTask* job)
 {
     ASSERT(job);
-
+    PROFILE_MEM(Content);
+
+    // Update queue stats
+    const double time = Platform::GetTimeSeconds();
+    const double waitTime = time - job->_enqueueTime;
+    StatsLocker.Lock();
+    auto& stats = Stats[(int32)job->GetPriority()];
+    stats.TasksCount++;
+    if (job->GetDeadline() > 0.0 && time > job->GetDeadline())
+        stats.MissedDeadlines++;
+    stats.TotalWaitTime += waitTime;
+    stats.MaxWaitTime = Math::Max(stats.MaxWaitTime, waitTime);
+    StatsLocker.Unlock();
+
+    // Tasks started by this one inherit its priority
+    ContentLoadingManager::PriorityScope priorityScope(job->GetPriority(), job->GetDeadline());
     job->Execute();
     _totalTasksDoneCount++;
 }
@@ -122,18 +152,30 @@ int32 LoadingThread::Run()
 
     ContentLoadTask* task;
     ThisThread = this;
+    int64 affinityMask = 0;
 
     while (HasExitFlagClear())
     {
-        if (Tasks.try_dequeue(task))
+        // Update the thread affinity if it has been changed
+        if (Platform::AtomicRead(&ThreadsAffinityMask) != affinityMask)
+        {
+            affinityMask = Platform::AtomicRead(&ThreadsAffinityMask);
+            Platform::SetThreadAffinityMask(affinityMask != 0 ? (uint64)affinityMask : Platform::GetCPUInfo().GetAllProcessorsMask());
+        }
+
+        if (ContentLoadingManager::TryDequeueTask(task))
         {
+            const double startTime = Platform::GetTimeSeconds();
             Run(task);
+            _stats.OnJob(startTime, Platform::GetTimeSeconds());
         }
         else
         {
+            const double startTime = Platform::GetTimeSeconds();
             TasksMutex.Lock();
             TasksSignal.Wait(TasksMutex);
             TasksMutex.Unlock();
+            _stats.OnIdle(startTime, Platform::GetTimeSeconds());
         }
     }
 
@@ -155,7 +197,168 @@ LoadingThread* ContentLoadingManager::GetCurrentLoadThread()
 
 int32 ContentLoadingManager::GetTasksCount()
 {
-    return Tasks.Count();
+    int32 result = (int32)Platform::AtomicRead(&DeadlineTasksCount);
+    for (auto& tasks : Tasks)
+        result += tasks.Count();
+    return result;
+}
+
+void ContentLoadingManager::SetThreadsAffinityMask(uint64 affinityMask)
+{
+    Platform::AtomicStore(&ThreadsAffinityMask, (int64)affinityMask);
+    TasksSignal.NotifyAll();
+}
+
+ContentLoadingManager::PriorityScope::PriorityScope(ContentLoadTask::Priority priority, double deadline)
+{
+    PrevPriority = ThisPriority;
+    PrevDeadline = ThisDeadline;
+    ThisPriority = priority;
+    ThisDeadline = deadline;
+}
+
+ContentLoadingManager::PriorityScope::~PriorityScope()
+{
+    ThisPriority = PrevPriority;
+    ThisDeadline = PrevDeadline;
+}
+
+ContentLoadTask::Priority ContentLoadingManager::GetCurrentPriority()
+{
+    return ThisPriority;
+}
+
+double ContentLoadingManager::GetCurrentDeadline()
+{
+    return ThisDeadline;
+}
+
+ContentLoadingManager::QueueStats ContentLoadingManager::GetQueueStats(ContentLoadTask::Priority priority, bool reset)
+{
+    ScopeLock lock(StatsLocker);
+    auto& stats = Stats[(int32)priority];
+    const QueueStats result = stats;
+    if (reset)
+        stats = {};
+    return result;
+}
+
+void ContentLoadingManager::GetThreadsStats(Array<WorkerStats>& result, bool reset)
+{
+    result.Resize(Threads.Count());
+    for (int32 i = 0; i < Threads.Count(); i++)
+        Threads[i]->GetStats(result[i], reset);
+}
+
+bool ContentLoadingManager::TrackAssetLoads = false;
+
+void ContentLoadingManager::GetAssetLoads(Array<AssetLoadInfo>& result)
+{
+    ScopeLock lock(StatsLocker);
+    result.Clear();
+    result.Swap(AssetLoads);
+}
+
+void ContentLoadingManager::OnDataRead(uint64 bytes, double seconds)
+{
+    if (const auto scope = ThisLoadScope)
+    {
+        scope->Info.IOBytes += bytes;
+        scope->Info.IOTime += seconds;
+    }
+}
+
+void ContentLoadingManager::OnDataDecompressed(double seconds)
+{
+    if (const auto scope = ThisLoadScope)
+        scope->Info.DecompressTime += seconds;
+}
+
+ContentLoadingManager::AssetLoadScope::AssetLoadScope(const Asset* asset, AssetLoadStage stage, double requestTime)
+{
+    Active = TrackAssetLoads;
+    if (!Active)
+        return;
+    Info.Name = asset->GetPath();
+    const String& typeName = asset->GetTypeName();
+    const int32 namespaceEnd = typeName.FindLast(TEXT('.'));
+    Info.TypeName = namespaceEnd != -1 ? typeName.Substring(namespaceEnd + 1) : typeName;
+    Begin(stage, requestTime);
+}
+
+ContentLoadingManager::AssetLoadScope::AssetLoadScope(const StringView& name, const StringView& typeName, AssetLoadStage stage, double requestTime)
+{
+    Active = TrackAssetLoads;
+    if (!Active)
+        return;
+    Info.Name = name;
+    Info.TypeName = typeName;
+    Begin(stage, requestTime);
+}
+
+void ContentLoadingManager::AssetLoadScope::Begin(AssetLoadStage stage, double requestTime)
+{
+    Info.Stage = stage;
+    Info.StartTime = Platform::GetTimeSeconds();
+    Info.RequestTime = requestTime > 0.0 ? requestTime : Info.StartTime;
+    Info.Duration = 0.0;
+    Info.IOBytes = 0;
+    Info.IOTime = 0.0;
+    Info.DecompressTime = 0.0;
+    Info.ThreadID = Platform::GetCurrentThreadID();
+    Prev = ThisLoadScope;
+    ThisLoadScope = this;
+}
+
+ContentLoadingManager::AssetLoadScope::~AssetLoadScope()
+{
+    if (!Active)
+        return;
+    ThisLoadScope = Prev;
+    Info.Duration = Platform::GetTimeSeconds() - Info.StartTime;
+    ScopeLock lock(StatsLocker);
+    if (AssetLoads.Count() < MAX_ASSET_LOADS)
+        AssetLoads.Add(MoveTemp(Info));
+}
+
+void ContentLoadingManager::EnqueueTask(ContentLoadTask* task)
+{
+    if (task->GetDeadline() > 0.0)
+    {
+        ScopeLock lock(DeadlineTasksLocker);
+        int32 index = DeadlineTasks.Count();
+        while (index > 0 && DeadlineTasks[index - 1]->GetDeadline() < task->GetDeadline())
+            index--;
+        DeadlineTasks.Insert(index, task);
+        Platform::AtomicStore(&DeadlineTasksCount, DeadlineTasks.Count());
+    }
+    else
+    {
+        Tasks[(int32)task->GetPriority()].Add(task);
+    }
+}
+
+bool ContentLoadingManager::TryDequeueTask(ContentLoadTask*& task)
+{
+    // Tasks with deadline go first
+    if (Platform::AtomicRead(&DeadlineTasksCount) != 0)
+    {
+        ScopeLock lock(DeadlineTasksLocker);
+        if (DeadlineTasks.HasItems())
+        {
+            task = DeadlineTasks.Pop();
+            Platform::AtomicStore(&DeadlineTasksCount, DeadlineTasks.Count());
+            return true;
+        }
+    }
+
+    // Pick the highest priority task
+    for (int32 i = ContentLoadTask::Priority_Count - 1; i >= 0; i--)
+    {
+        if (Tasks[i].try_dequeue(task))
+            return true;
+    }
+    return false;
 }
 
 bool ContentLoadingManagerService::Init()
@@ -208,7 +411,22 @@ void ContentLoadingManagerService::Dispose()
     ThisThread = nullptr;
 
     // Cancel all remaining tasks (no chance to execute them)
-    Tasks.CancelAll();
+    for (auto& tasks : Tasks)
+        tasks.CancelAll();
+    DeadlineTasksLocker.Lock();
+    for (ContentLoadTask* task : DeadlineTasks)
+        task->Cancel();
+    DeadlineTasks.Clear();
+    Platform::AtomicStore(&DeadlineTasksCount, 0);
+    DeadlineTasksLocker.Unlock();
+}
+
+ContentLoadTask::ContentLoadTask(const Type type)
+    : _type(type)
+    , _priority(ThisPriority)
+    , _deadline(ThisDeadline)
+    , _enqueueTime(0.0)
+{
 }
 
 String ContentLoadTask::ToString() const
@@ -218,7 +436,8 @@ String ContentLoadTask::ToString() const
 
 void ContentLoadTask::Enqueue()
 {
-    Tasks.Add(this);
+    _enqueueTime = Platform::GetTimeSeconds();
+    ContentLoadingManager::EnqueueTask(this);
     TasksSignal.NotifyOne();
 }
 
@@ -3,10 +3,13 @@
 #pragma once
 
 #include "Engine/Threading/IRunnable.h"
+#include "Engine/Threading/WorkerStats.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Array.h"
+#include "ContentLoadTask.h"
 
 class Asset;
 class LoadingThread;
-class ContentLoadTask;
 
 /// <summary>
 /// Resources loading thread
@@ -17,6 +20,7 @@ class LoadingThread : public IRunnable
     volatile int64 _exitFlag;
     Thread* _thread;
     int32 _totalTasksDoneCount;
+    WorkerCounters _stats;
 
 public:
     /// <summary>
@@ -51,6 +55,16 @@ class LoadingThread : public IRunnable
     /// </summary>
     void NotifyExit();
 
+    /// <summary>
+    /// Gets the thread activity stats.
+    /// </summary>
+    /// <param name="result">The output stats.</param>
+    /// <param name="reset">True if reset the counters after reading, otherwise false.</param>
+    void GetStats(WorkerStats& result, bool reset)
+    {
+        _stats.Get(result, reset);
+    }
+
     /// <summary>
     /// Stops the calling thread execution until the loading thread ends its execution.
     /// </summary>
@@ -86,6 +100,138 @@ class ContentLoadingManager
     friend LoadingThread;
     friend Asset;
 
+public:
+    /// <summary>
+    /// Helper structure used to scope the priority (and optional deadline) of the content loading tasks created on the current thread (eg. for gameplay-critical Content::LoadAsync calls).
+    /// </summary>
+    struct FLAXENGINE_API PriorityScope
+    {
+        ContentLoadTask::Priority PrevPriority;
+        double PrevDeadline;
+
+        PriorityScope(ContentLoadTask::Priority priority, double deadline = 0.0);
+        ~PriorityScope();
+    };
+
+    /// <summary>
+    /// The loading queue stats for a single priority.
+    /// </summary>
+    struct QueueStats
+    {
+        /// <summary>
+        /// The amount of the executed tasks.
+        /// </summary>
+        int32 TasksCount;
+
+        /// <summary>
+        /// The amount of the tasks that started after their deadline.
+        /// </summary>
+        int32 MissedDeadlines;
+
+        /// <summary>
+        /// The total time tasks waited in the queue before execution (in seconds).
+        /// </summary>
+        double TotalWaitTime;
+
+        /// <summary>
+        /// The maximum time a task waited in the queue before execution (in seconds).
+        /// </summary>
+        double MaxWaitTime;
+    };
+
+    /// <summary>
+    /// The asset loading stages recorded by the loads tracing.
+    /// </summary>
+    enum class AssetLoadStage : uint8
+    {
+        // Asset data loading (and deserialization) on a content loading thread.
+        Load,
+        // Asset data chunks streaming (eg. texture mips or model LODs data).
+        Stream,
+        // Streamed data upload to the GPU (resources creation and update).
+        Upload,
+        // Loaded asset finalization on the main thread (OnLoaded event).
+        Finalize,
+    };
+
+    /// <summary>
+    /// The single asset load record (see TrackAssetLoads).
+    /// </summary>
+    struct AssetLoadInfo
+    {
+        /// <summary>
+        /// The asset path.
+        /// </summary>
+        String Name;
+
+        /// <summary>
+        /// The asset type name (without a namespace).
+        /// </summary>
+        String TypeName;
+
+        /// <summary>
+        /// The loading stage.
+        /// </summary>
+        AssetLoadStage Stage;
+
+        /// <summary>
+        /// The time when the load was requested (in seconds, see Platform::GetTimeSeconds). Equal to StartTime for the not queued work.
+        /// </summary>
+        double RequestTime;
+
+        /// <summary>
+        /// The start time (in seconds, see Platform::GetTimeSeconds).
+        /// </summary>
+        double StartTime;
+
+        /// <summary>
+        /// The duration (in seconds).
+        /// </summary>
+        double Duration;
+
+        /// <summary>
+        /// The amount of bytes read from the storage.
+        /// </summary>
+        uint64 IOBytes;
+
+        /// <summary>
+        /// The time spent on reading data from the storage (in seconds).
+        /// </summary>
+        double IOTime;
+
+        /// <summary>
+        /// The time spent on data decompression (in seconds).
+        /// </summary>
+        double DecompressTime;
+
+        /// <summary>
+        /// The ID of the thread that executed the work.
+        /// </summary>
+        uint64 ThreadID;
+    };
+
+    /// <summary>
+    /// Helper structure used to record the asset loading stage within a single code block (data reads and decompression executed within the scope are accumulated into the record). Does nothing if TrackAssetLoads is disabled.
+    /// </summary>
+    struct FLAXENGINE_API AssetLoadScope
+    {
+        AssetLoadInfo Info;
+        AssetLoadScope* Prev;
+        bool Active;
+
+        AssetLoadScope(const Asset* asset, AssetLoadStage stage, double requestTime = 0.0);
+        AssetLoadScope(const StringView& name, const StringView& typeName, AssetLoadStage stage, double requestTime = 0.0);
+        ~AssetLoadScope();
+
+    private:
+        void Begin(AssetLoadStage stage, double requestTime);
+    };
+
+    /// <summary>
+    /// True if record the assets loads (for the profiling tools), otherwise false. Use GetAssetLoads to read them.
+    /// </summary>
+    static bool TrackAssetLoads;
+
 public:
     /// <summary>
     /// Checks if current execution context is thread used to load assets.
@@ -108,4 +254,58 @@ class ContentLoadingManager
     /// </summary>
     /// <returns>The tasks count.</returns>
     static int32 GetTasksCount();
+
+    /// <summary>
+    /// Sets the processors affinity mask used by the content loading threads. Use 0 to use all processors.
+    /// </summary>
+    /// <param name="affinityMask">The affinity mask.</param>
+    static void SetThreadsAffinityMask(uint64 affinityMask);
+
+    /// <summary>
+    /// Gets the priority used by the content loading tasks created on the current thread.
+    /// </summary>
+    static ContentLoadTask::Priority GetCurrentPriority();
+
+    /// <summary>
+    /// Gets the deadline used by the content loading tasks created on the current thread (0 if unused).
+    /// </summary>
+    static double GetCurrentDeadline();
+
+    /// <summary>
+    /// Gets the loading queue stats for a given priority.
+    /// </summary>
+    /// <param name="priority">The tasks priority.</param>
+    /// <param name="reset">True if reset stats after reading them (eg. to gather them per-frame).</param>
+    /// <returns>The stats.</returns>
+    static QueueStats GetQueueStats(ContentLoadTask::Priority priority, bool reset = false);
+
+    /// <summary>
+    /// Gets the activity stats of the content loading threads.
+    /// </summary>
+    /// <param name="result">The output stats (one per thread).</param>
+    /// <param name="reset">True if reset the counters after reading (eg. to gather stats per frame), otherwise false.</param>
+    static void GetThreadsStats(Array<WorkerStats>& result, bool reset = false);
+
+    /// <summary>
+    /// Gets the assets loads recorded since the last call (requires TrackAssetLoads to be enabled).
+    /// </summary>
+    /// <param name="result">The output records.</param>
+    static void GetAssetLoads(Array<AssetLoadInfo>& result);
+
+    /// <summary>
+    /// Called when asset data was read from the storage. Accumulated into the current thread asset load record (if any).
+    /// </summary>
+    /// <param name="bytes">The amount of bytes read.</param>
+    /// <param name="seconds">The read time (in seconds).</param>
+    static void OnDataRead(uint64 bytes, double seconds);
+
+    /// <summary>
+    /// Called when asset data was decompressed. Accumulated into the current thread asset load record (if any).
+    /// </summary>
+    /// <param name="seconds">The decompression time (in seconds).</param>
+    static void OnDataDecompressed(double seconds);
+
+private:
+    static void EnqueueTask(ContentLoadTask* task);
+    static bool TryDequeueTask(ContentLoadTask*& task);
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "../ContentLoadTask.h"
+#include "../ContentLoadingManager.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Content/BinaryAsset.h"
@@ -53,33 +54,35 @@ class LoadAssetDataTask : public ContentLoadTask
         AssetReference<BinaryAsset> ref = _asset.Get();
         if (ref == nullptr)
             return Result::MissingReferences;
+        ContentLoadingManager::AssetLoadScope loadScope(ref.Get(), ContentLoadingManager::AssetLoadStage::Stream, GetEnqueueTime());
 #if TRACY_ENABLE
         const StringView name(ref->GetPath());
 #endif
 
-        // Load chunks
+        // Gather chunks
+        FlaxChunk* chunks[ASSET_FILE_DATA_CHUNKS];
+        int32 chunksCount = 0;
         for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
         {
             if (GET_CHUNK_FLAG(i) & _chunks)
             {
                 const auto chunk = ref->GetChunk(i);
                 if (chunk != nullptr)
-                {
-                    if (IsCancelRequested())
-                        return Result::Ok;
+                    chunks[chunksCount++] = chunk;
+            }
+        }
+        if (IsCancelRequested())
+            return Result::Ok;
 
-                    // Load it
+        // Load them in a single batch
 #if TRACY_ENABLE
-                    ZoneScoped;
-                    ZoneName(*name, name.Length());
+        ZoneScoped;
+        ZoneName(*name, name.Length());
 #endif
-                    if (ref->Storage->LoadAssetChunk(chunk))
-                    {
-                        LOG(Warning, "Cannot load asset \'{0}\' chunk {1}.", ref->ToString(), i);
-                        return Result::LoadDataError;
-                    }
-                }
-            }
+        if (ref->Storage->LoadAssetChunks(Span<FlaxChunk*>(chunks, chunksCount)))
+        {
+            LOG(Warning, "Cannot load asset \'{0}\' chunks.", ref->ToString());
+            return Result::LoadDataError;
         }
 
         return Result::Ok;
@@ -4,8 +4,12 @@
 #include "FlaxFile.h"
 #include "FlaxPackage.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Engine/CommandLine.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Platform/File.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/TaskGraph.h"
@@ -22,6 +26,30 @@ namespace
     Array<FlaxPackage*> Packages(64);
 #endif
     Dictionary<String, FlaxStorage*> StorageMap(2048);
+
+    // Scratch buffers pool (size classes from 64kB to 64MB, larger ones are not cached)
+    constexpr int32 ScratchMinSizeLog2 = 16;
+    constexpr int32 ScratchClassesCount = 11;
+    constexpr int32 ScratchMaxCachedPerClass = 4;
+    CriticalSection ScratchLocker;
+    volatile int64 DecompressedInputBytes = 0;
+    volatile int64 DecompressedOutputBytes = 0;
+    volatile int64 DecompressionTicks = 0;
+
+    // Assets load order trace
+    bool LoadOrderTraceEnabled = false;
+    CriticalSection LoadOrderTraceLocker;
+    HashSet<Guid> LoadOrderTraceAssets;
+    Array<Guid> LoadOrderTrace;
+    Array<byte*, FixedAllocation<ScratchMaxCachedPerClass>> ScratchBuffers[ScratchClassesCount];
+
+    int32 GetScratchClass(uint32 size)
+    {
+        int32 sizeClass = 0;
+        while (sizeClass < ScratchClassesCount && (1u << (ScratchMinSizeLog2 + sizeClass)) < size)
+            sizeClass++;
+        return sizeClass;
+    }
 }
 
 class ContentStorageService : public EngineService
@@ -52,6 +80,45 @@ ContentStorageService ContentStorageServiceInstance;
 
 TimeSpan ContentStorageManager::UnusedDataChunksLifetime = TimeSpan::FromSeconds(10);
 
+ContentStorageManager::ScratchBuffer::ScratchBuffer(uint32 size)
+{
+    const int32 sizeClass = GetScratchClass(size);
+    if (sizeClass == ScratchClassesCount)
+    {
+        // Too big to be pooled
+        Size = size;
+        Data = (byte*)Allocator::Allocate(size);
+        return;
+    }
+    Size = 1u << (ScratchMinSizeLog2 + sizeClass);
+    Data = nullptr;
+    ScratchLocker.Lock();
+    auto& buffers = ScratchBuffers[sizeClass];
+    if (buffers.HasItems())
+        Data = buffers.Pop();
+    ScratchLocker.Unlock();
+    if (!Data)
+        Data = (byte*)Allocator::Allocate(Size);
+}
+
+ContentStorageManager::ScratchBuffer::~ScratchBuffer()
+{
+    const int32 sizeClass = GetScratchClass(Size);
+    if (sizeClass != ScratchClassesCount && (1u << (ScratchMinSizeLog2 + sizeClass)) == Size)
+    {
+        ScratchLocker.Lock();
+        auto& buffers = ScratchBuffers[sizeClass];
+        if (buffers.Count() < ScratchMaxCachedPerClass)
+        {
+            buffers.Add(Data);
+            Data = nullptr;
+        }
+        ScratchLocker.Unlock();
+    }
+    if (Data)
+        Allocator::Free(Data);
+}
+
 FlaxStorageReference ContentStorageManager::GetStorage(const StringView& path, bool loadIt)
 {
     Locker.Lock();
@@ -215,15 +282,77 @@ void ContentStorageManager::GetStorage(Array<FlaxStorage*>& result)
         result.Add(Files[i]);
 }
 
+void ContentStorageManager::GetDecompressionStats(uint64& compressedBytes, uint64& decompressedBytes, double& seconds)
+{
+    compressedBytes = (uint64)Platform::AtomicRead(&DecompressedInputBytes);
+    decompressedBytes = (uint64)Platform::AtomicRead(&DecompressedOutputBytes);
+    seconds = (double)Platform::AtomicRead(&DecompressionTicks) / 1000000.0;
+}
+
+void ContentStorageManager::OnChunkDecompressed(uint32 compressedSize, uint32 decompressedSize, double seconds)
+{
+    Platform::InterlockedAdd(&DecompressedInputBytes, (int64)compressedSize);
+    Platform::InterlockedAdd(&DecompressedOutputBytes, (int64)decompressedSize);
+    Platform::InterlockedAdd(&DecompressionTicks, (int64)(seconds * 1000000.0));
+}
+
+void ContentStorageManager::StartLoadOrderTrace()
+{
+    ScopeLock lock(LoadOrderTraceLocker);
+    LoadOrderTraceAssets.Clear();
+    LoadOrderTrace.Clear();
+    LoadOrderTraceEnabled = true;
+}
+
+bool ContentStorageManager::StopLoadOrderTrace(const StringView& path)
+{
+    StringBuilder text;
+    {
+        ScopeLock lock(LoadOrderTraceLocker);
+        LoadOrderTraceEnabled = false;
+        for (const Guid& id : LoadOrderTrace)
+            text.Append(id.ToString(Guid::FormatType::N)).Append(TEXT('\n'));
+        LOG(Info, "Saving assets load order trace ({0} assets) to {1}", LoadOrderTrace.Count(), path);
+        LoadOrderTraceAssets.Clear();
+        LoadOrderTrace.Clear();
+    }
+    return File::WriteAllText(path, text, Encoding::ANSI);
+}
+
+void ContentStorageManager::OnAssetLoad(const Guid& id)
+{
+    if (!LoadOrderTraceEnabled)
+        return;
+    ScopeLock lock(LoadOrderTraceLocker);
+    if (LoadOrderTraceEnabled && LoadOrderTraceAssets.Add(id))
+        LoadOrderTrace.Add(id);
+}
+
+void ContentStorageManager::ReleaseScratchBuffers()
+{
+    ScopeLock lock(ScratchLocker);
+    for (auto& buffers : ScratchBuffers)
+    {
+        for (byte* buffer : buffers)
+            Allocator::Free(buffer);
+        buffers.Clear();
+    }
+}
+
 bool ContentStorageService::Init()
 {
     System = New<ContentStorageSystem>();
     Engine::UpdateGraph->AddSystem(System);
+    if (CommandLine::Options.LoadOrderTrace.HasValue())
+        ContentStorageManager::StartLoadOrderTrace();
     return false;
 }
 
 void ContentStorageService::Dispose()
 {
+    if (CommandLine::Options.LoadOrderTrace.HasValue())
+        ContentStorageManager::StopLoadOrderTrace(CommandLine::Options.LoadOrderTrace.GetValue());
+
     ScopeLock lock(Locker);
     for (auto i = StorageMap.Begin(); i.IsNotEnd(); ++i)
         i->Value->Dispose();
@@ -232,6 +361,7 @@ void ContentStorageService::Dispose()
     StorageMap.Clear();
     ASSERT(Files.IsEmpty() && Packages.IsEmpty());
     SAFE_DELETE(System);
+    ContentStorageManager::ReleaseScratchBuffers();
 }
 
 void ContentStorageSystem::Job(int32 index)
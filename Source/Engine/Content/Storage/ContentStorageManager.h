@@ -3,6 +3,7 @@
 #pragma once
 
 #include "FlaxStorageReference.h"
+#include "Engine/Core/NonCopyable.h"
 #include "Engine/Core/Types/TimeSpan.h"
 
 class FlaxFile;
@@ -19,6 +20,25 @@ class FLAXENGINE_API ContentStorageManager
     /// </summary>
     static TimeSpan UnusedDataChunksLifetime;
 
+    /// <summary>
+    /// Temporary memory buffer from the pool shared by the content loading threads (eg. for data decompression). Buffers are size-classed (power of two) and returned to the pool on scope end.
+    /// </summary>
+    struct FLAXENGINE_API ScratchBuffer : NonCopyable
+    {
+        /// <summary>
+        /// The buffer memory.
+        /// </summary>
+        byte* Data;
+
+        /// <summary>
+        /// The buffer size (in bytes). Can be larger than requested size.
+        /// </summary>
+        uint32 Size;
+
+        ScratchBuffer(uint32 size);
+        ~ScratchBuffer();
+    };
+
 public:
     /// <summary>
     /// Gets the assets data storage container.
@@ -108,4 +128,41 @@ class FLAXENGINE_API ContentStorageManager
     /// </summary>
     /// <param name="result">The result.</param>
     static void GetStorage(Array<FlaxStorage*>& result);
+
+    /// <summary>
+    /// Releases all cached scratch buffers memory.
+    /// </summary>
+    static void ReleaseScratchBuffers();
+
+    /// <summary>
+    /// Gets the chunks data decompression stats (accumulated since the engine start). Can be used to measure the decompression throughput.
+    /// </summary>
+    /// <param name="compressedBytes">The total size of the compressed data (in bytes).</param>
+    /// <param name="decompressedBytes">The total size of the decompressed data (in bytes).</param>
+    /// <param name="seconds">The total time spent on decompression (in seconds, summed over all threads).</param>
+    static void GetDecompressionStats(uint64& compressedBytes, uint64& decompressedBytes, double& seconds);
+
+    /// <summary>
+    /// Called by the storage layer when chunk data gets decompressed.
+    /// </summary>
+    static void OnChunkDecompressed(uint32 compressedSize, uint32 decompressedSize, double seconds);
+
+public:
+    /// <summary>
+    /// Starts recording the assets load order (first use of each asset data from the storage). The trace can be used by the Game Cooker to layout packages to match the load order (see BuildSettings.LoadOrderTraces).
+    /// </summary>
+    static void StartLoadOrderTrace();
+
+    /// <summary>
+    /// Stops recording the assets load order and saves the trace to the file (text file with a single asset ID per line).
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <returns>True if failed to save the trace, otherwise false.</returns>
+    static bool StopLoadOrderTrace(const StringView& path);
+
+    /// <summary>
+    /// Called by the storage layer when asset data gets loaded.
+    /// </summary>
+    /// <param name="id">The asset identifier.</param>
+    static void OnAssetLoad(const Guid& id);
 };
@@ -19,6 +19,11 @@ enum class FlaxChunkFlags
     /// Compress chunk data using LZ4 algorithm.
     /// </summary>
     CompressedLZ4 = 1,
+
+    /// <summary>
+    /// Use LZ4 high compression mode when compressing chunk data (used together with CompressedLZ4, data is decompressed the same way).
+    /// </summary>
+    HighCompression = 2,
 };
 
 DECLARE_ENUM_OPERATORS(FlaxChunkFlags);
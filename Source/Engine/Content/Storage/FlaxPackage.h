@@ -13,6 +13,12 @@ class FLAXENGINE_API FlaxPackage : public FlaxStorage
 protected:
     Dictionary<Guid, Entry> _entries;
 
+public:
+    /// <summary>
+    /// True if use memory-mapped files to access uncompressed chunks of the packages (zero-copy, lower memory usage), otherwise chunks data is read into the memory.
+    /// </summary>
+    static bool UseMemoryMapping;
+
 public:
     /// <summary>
     /// Initializes a new instance of the <see cref="FlaxPackage"/> class.
@@ -36,4 +42,5 @@ class FLAXENGINE_API FlaxPackage : public FlaxStorage
     // [FlaxStorage]
     bool GetEntry(const Guid& id, Entry& e) override;
     void AddEntry(Entry& e) override;
+    bool AllowMemoryMapping() const override;
 };
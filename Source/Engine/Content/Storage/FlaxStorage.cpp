@@ -11,7 +11,10 @@
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
+#include "Engine/Content/Loading/ContentLoadingManager.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Core/Collections/Sorting.h"
 #if USE_EDITOR
 #include "Engine/Serialization/JsonWriter.h"
 #include "Engine/Serialization/JsonWriters.h"
@@ -19,6 +22,7 @@
 #include "Engine/Engine/Globals.h"
 #endif
 #include <ThirdParty/LZ4/lz4.h>
+#include <ThirdParty/LZ4/lz4hc.h>
 
 String AssetHeader::ToString() const
 {
@@ -196,6 +200,9 @@ const Char* TypeId2TypeName(const uint32 typeId)
 FlaxStorage::FlaxStorage(const StringView& path)
     : _refCount(0)
     , _chunksLock(0)
+    , _mappedFile(nullptr)
+    , _mappedData(nullptr)
+    , _mappedSize(0)
     , _version(0)
     , _path(path)
 {
@@ -591,11 +598,83 @@ bool FlaxStorage::LoadAssetHeader(const Guid& id, AssetInitData& data)
         LOG(Error, "Cannot find asset \'{0}\' within {1}", id, ToString());
         return true;
     }
+    ContentStorageManager::OnAssetLoad(id);
 
     // Load header
     return LoadAssetHeader(e, data);
 }
 
+namespace
+{
+    // Minimal total size of the chunks batch to read it from multiple threads at once
+    constexpr uint32 ConcurrentChunksReadMinSize = 256 * 1024;
+
+    bool SortChunksByLocation(FlaxChunk* const& a, FlaxChunk* const& b)
+    {
+        return a->LocationInFile.Address < b->LocationInFile.Address;
+    }
+
+    bool DecompressChunk(FlaxChunk* chunk, const byte* data, uint32 size, const String& storage)
+    {
+        // Original size int is followed by the compressed data
+        PROFILE_CPU_NAMED("DecompressLZ4");
+        const double startTime = Platform::GetTimeSeconds();
+        const int32 originalSize = *(const int32*)data;
+        chunk->Data.Allocate(originalSize);
+        const int32 res = LZ4_decompress_safe((const char*)data + sizeof(int32), chunk->Data.Get<char>(), (int32)(size - sizeof(int32)), originalSize);
+        if (res > 0)
+        {
+            const double decompressTime = Platform::GetTimeSeconds() - startTime;
+            ContentStorageManager::OnChunkDecompressed(size, (uint32)res, decompressTime);
+            ContentLoadingManager::OnDataDecompressed(decompressTime);
+        }
+        if (res <= 0)
+        {
+            chunk->Data.Release();
+            LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", storage, res);
+            return true;
+        }
+        chunk->Data.SetLength(res);
+        return false;
+    }
+
+    bool ReadChunk(File* file, FlaxChunk* chunk, const String& storage, bool reportRead)
+    {
+        uint32 size = chunk->LocationInFile.Size;
+        uint32 bytesRead;
+        const double startTime = Platform::GetTimeSeconds();
+        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+        {
+            // Compressed
+            ContentStorageManager::ScratchBuffer tmpBuf(size);
+            if (file->ReadAt(tmpBuf.Data, size, chunk->LocationInFile.Address, &bytesRead) || bytesRead != size)
+            {
+                LOG(Warning, "Cannot read chunk from {0}.", storage);
+                return true;
+            }
+            if (reportRead)
+                ContentLoadingManager::OnDataRead(size, Platform::GetTimeSeconds() - startTime);
+            if (DecompressChunk(chunk, tmpBuf.Data, size, storage))
+                return true;
+        }
+        else
+        {
+            // Raw data
+            chunk->Data.Allocate(size);
+            if (file->ReadAt(chunk->Data.Get(), size, chunk->LocationInFile.Address, &bytesRead) || bytesRead != size)
+            {
+                chunk->Data.Release();
+                LOG(Warning, "Cannot read chunk from {0}.", storage);
+                return true;
+            }
+            if (reportRead)
+                ContentLoadingManager::OnDataRead(size, Platform::GetTimeSeconds() - startTime);
+        }
+        chunk->RegisterUsage();
+        return false;
+    }
+}
+
 bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
 {
     ASSERT(IsLoaded());
@@ -614,6 +693,13 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
 
     LockChunks();
 
+    // Use memory-mapped file data (zero-copy)
+    if (LoadMappedChunk(chunk))
+    {
+        UnlockChunks();
+        return false;
+    }
+
     // Open file
     auto stream = OpenFile();
     bool failed = stream == nullptr;
@@ -651,32 +737,24 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
 
         // Load data
         auto size = chunk->LocationInFile.Size;
+        const double startTime = Platform::GetTimeSeconds();
         if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
         {
             // Compressed
-            size -= sizeof(int32); // Don't count original size int
-            int32 originalSize;
-            stream->ReadInt32(&originalSize);
-            Array<byte> tmpBuf;
-            tmpBuf.Resize(size); // TODO: maybe use thread local or content loading pool with sharable temp buffers for the decompression?
-            stream->ReadBytes(tmpBuf.Get(), size);
-
-            // Decompress data
-            PROFILE_CPU_NAMED("DecompressLZ4");
-            chunk->Data.Allocate(originalSize);
-            const int32 res = LZ4_decompress_safe((const char*)tmpBuf.Get(), chunk->Data.Get<char>(), size, originalSize);
-            if (res <= 0)
+            ContentStorageManager::ScratchBuffer tmpBuf(size);
+            stream->ReadBytes(tmpBuf.Data, size);
+            ContentLoadingManager::OnDataRead(size, Platform::GetTimeSeconds() - startTime);
+            if (DecompressChunk(chunk, tmpBuf.Data, size, ToString()))
             {
                 UnlockChunks();
-                LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), res);
                 return true;
             }
-            chunk->Data.SetLength(res);
         }
         else
         {
             // Raw data
             chunk->Data.Read(stream, size);
+            ContentLoadingManager::OnDataRead(size, Platform::GetTimeSeconds() - startTime);
         }
         ASSERT(chunk->IsLoaded());
         chunk->RegisterUsage();
@@ -687,6 +765,78 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
     return failed;
 }
 
+bool FlaxStorage::LoadAssetChunks(const Span<FlaxChunk*>& chunks)
+{
+    ASSERT(IsLoaded());
+    PROFILE_CPU();
+
+    // Gather chunks to load
+    Array<FlaxChunk*, InlinedAllocation<ASSET_FILE_DATA_CHUNKS>> toLoad;
+    uint32 totalSize = 0;
+    LockChunks();
+    for (int32 i = 0; i < chunks.Length(); i++)
+    {
+        FlaxChunk* chunk = chunks[i];
+        ASSERT(chunk != nullptr && _chunks.Contains(chunk));
+        if (chunk->IsLoaded())
+            continue;
+        if (chunk->ExistsInFile() == false)
+        {
+            UnlockChunks();
+            LOG(Warning, "Cannot load chunk from {0}. It doesn't exist in storage.", ToString());
+            return true;
+        }
+        if (LoadMappedChunk(chunk))
+            continue;
+        toLoad.Add(chunk);
+        totalSize += chunk->LocationInFile.Size;
+    }
+    if (toLoad.Count() <= 1)
+    {
+        const bool failed = toLoad.HasItems() && LoadAssetChunk(toLoad[0]);
+        UnlockChunks();
+        return failed;
+    }
+
+    // Read in the file order
+    Sorting::QuickSort(toLoad.Get(), toLoad.Count(), &SortChunksByLocation);
+
+    auto stream = OpenFile();
+    if (stream == nullptr)
+    {
+        UnlockChunks();
+        return true;
+    }
+    File* file = stream->GetFile();
+    const String storage = ToString();
+    bool failed = false;
+    if (file->CanReadAtConcurrently() && totalSize >= ConcurrentChunksReadMinSize && JobSystem::GetThreadsCount() > 1)
+    {
+        // Issue all reads at once to keep the device queue busy (reads are overlapped so report the whole batch time)
+        volatile int64 failedCount = 0;
+        const Function<void(int32)> job = [&](int32 i)
+        {
+            if (ReadChunk(file, toLoad[i], storage, false))
+                Platform::InterlockedIncrement(&failedCount);
+        };
+        const double startTime = Platform::GetTimeSeconds();
+        JobSystem::Execute(job, toLoad.Count());
+        ContentLoadingManager::OnDataRead(totalSize, Platform::GetTimeSeconds() - startTime);
+        failed = Platform::AtomicRead(&failedCount) != 0;
+    }
+    else
+    {
+        for (int32 i = 0; i < toLoad.Count() && !failed; i++)
+            failed = ReadChunk(file, toLoad[i], storage, true);
+    }
+
+    // Positional reads could move the file pointer so reset the stream buffer
+    stream->SetPosition(0);
+    UnlockChunks();
+
+    return failed;
+}
+
 #if USE_EDITOR
 
 bool FlaxStorage::ChangeAssetID(Entry& e, const Guid& newId)
@@ -868,7 +1018,11 @@ bool FlaxStorage::Create(WriteStream* stream, const AssetInitData* data, int32 d
             const int32 maxSize = LZ4_compressBound(srcSize);
             auto& chunkCompressed = compressedChunks[i];
             chunkCompressed.Resize(maxSize);
-            const int32 dstSize = LZ4_compress_default(chunk->Data.Get<char>(), (char*)chunkCompressed.Get(), srcSize, maxSize);
+            int32 dstSize;
+            if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::HighCompression))
+                dstSize = LZ4_compress_HC(chunk->Data.Get<char>(), (char*)chunkCompressed.Get(), srcSize, maxSize, LZ4HC_CLEVEL_DEFAULT);
+            else
+                dstSize = LZ4_compress_default(chunk->Data.Get<char>(), (char*)chunkCompressed.Get(), srcSize, maxSize);
             if (dstSize <= 0)
             {
                 chunkCompressed.Resize(0);
@@ -1327,6 +1481,66 @@ void FlaxStorage::CloseFileHandles()
     ASSERT(_chunksLock == 0);
 
     _file.DeleteAll();
+    UnmapFile();
+}
+
+bool FlaxStorage::LoadMappedChunk(FlaxChunk* chunk)
+{
+    // Note: chunks have to be locked so file handles won't be closed in the meantime
+    if (!AllowMemoryMapping())
+        return false;
+    {
+        ScopeLock lock(_loadLocker);
+        if (_mappedFile == nullptr)
+        {
+            // Map the whole file once (on failure file is kept to don't retry until handles get closed)
+            PROFILE_CPU_NAMED("MapFile");
+            _mappedFile = File::Open(_path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+            if (_mappedFile == nullptr)
+                return false;
+            _mappedData = _mappedFile->MapView(_mappedSize);
+        }
+    }
+    const uint32 address = chunk->LocationInFile.Address;
+    const uint32 size = chunk->LocationInFile.Size;
+    if (_mappedData == nullptr || address + size > _mappedSize)
+        return false;
+    if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+    {
+        // Decompress directly from the mapped file without a temporary copy
+        if (size <= sizeof(int32) || DecompressChunk(chunk, _mappedData + address, size, ToString()))
+            return false;
+    }
+    else
+    {
+        chunk->Data.Link(_mappedData + address, (int32)size);
+    }
+    chunk->RegisterUsage();
+
+    // Mapped data is read on access (page faults are included in the decompression or the data usage time)
+    ContentLoadingManager::OnDataRead(size, 0.0);
+    return true;
+}
+
+void FlaxStorage::UnmapFile()
+{
+    if (_mappedData)
+    {
+        // Release chunks that are views of the mapped data
+        for (FlaxChunk* chunk : _chunks)
+        {
+            if (chunk->Data.Get() >= _mappedData && chunk->Data.Get() < _mappedData + _mappedSize)
+                chunk->Unload();
+        }
+        _mappedFile->UnmapView(_mappedData, _mappedSize);
+        _mappedData = nullptr;
+        _mappedSize = 0;
+    }
+    if (_mappedFile)
+    {
+        Delete(_mappedFile);
+        _mappedFile = nullptr;
+    }
 }
 
 void FlaxStorage::Dispose()
@@ -1451,6 +1665,8 @@ void FlaxFile::AddEntry(Entry& e)
     _asset = e;
 }
 
+bool FlaxPackage::UseMemoryMapping = true;
+
 FlaxPackage::FlaxPackage(const StringView& path)
     : FlaxStorage(path)
     , _entries(256)
@@ -1526,3 +1742,8 @@ void FlaxPackage::AddEntry(Entry& e)
     ASSERT(HasAsset(e.ID) == false);
     _entries.Add(e.ID, e);
 }
+
+bool FlaxPackage::AllowMemoryMapping() const
+{
+    return UseMemoryMapping;
+}
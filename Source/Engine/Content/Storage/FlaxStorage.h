@@ -6,6 +6,7 @@
 #include "Engine/Core/Delegate.h"
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/DateTime.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Serialization/FileReadStream.h"
@@ -96,6 +97,9 @@ class FLAXENGINE_API FlaxStorage : public Object
     // Storage
     ThreadLocalObject<FileReadStream> _file;
     Array<FlaxChunk*> _chunks;
+    File* _mappedFile;
+    byte* _mappedData;
+    uint32 _mappedSize;
 
     // Metadata
     uint32 _version;
@@ -384,6 +388,13 @@ class FLAXENGINE_API FlaxStorage : public Object
     /// <returns>True if cannot load data, otherwise false</returns>
     bool LoadAssetChunk(FlaxChunk* chunk);
 
+    /// <summary>
+    /// Loads the asset chunks in a single batch. Reads are sorted by the location in file and issued at once (from multiple threads if platform supports concurrent positional reads) to better utilize the storage device.
+    /// </summary>
+    /// <param name="chunks">The chunks to load (already loaded ones are skipped).</param>
+    /// <returns>True if cannot load data, otherwise false</returns>
+    bool LoadAssetChunks(const Span<FlaxChunk*>& chunks);
+
 #if USE_EDITOR
 
     /// <summary>
@@ -488,4 +499,16 @@ class FLAXENGINE_API FlaxStorage : public Object
     virtual void AddEntry(Entry& e) = 0;
     FileReadStream* OpenFile();
     virtual bool GetEntry(const Guid& id, Entry& e) = 0;
+
+    /// <summary>
+    /// Checks if the storage file can be memory-mapped for reading chunks (uncompressed chunk data becomes a view into the mapping instead of a copy, compressed chunks are decompressed directly from the mapping). Mapping lives until file handles get closed so it's guarded by LockChunks/UnlockChunks.
+    /// </summary>
+    virtual bool AllowMemoryMapping() const
+    {
+        return false;
+    }
+
+private:
+    bool LoadMappedChunk(FlaxChunk* chunk);
+    void UnmapFile();
 };
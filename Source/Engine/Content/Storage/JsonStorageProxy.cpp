@@ -10,16 +10,94 @@
 #include "Engine/Debug/Exceptions/JsonParseException.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include <ThirdParty/rapidjson/document.h>
+#include <ThirdParty/rapidjson/reader.h>
+#include <ThirdParty/rapidjson/memorystream.h>
 
 bool JsonStorageProxy::IsValidExtension(const StringView& extension)
 {
     return extension == DEFAULT_SCENE_EXTENSION || extension == DEFAULT_PREFAB_EXTENSION || extension == DEFAULT_JSON_EXTENSION;
 }
 
+// SAX handler that reads only the asset header (root 'ID' and 'TypeName' properties) and stops parsing once both are found
+struct JsonAssetInfoHandler : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonAssetInfoHandler>
+{
+    enum class Keys
+    {
+        None,
+        ID,
+        TypeName,
+    };
+
+    int32 Depth = 0;
+    Keys CurrentKey = Keys::None;
+    bool HasId = false;
+    bool HasTypeName = false;
+    Guid Id;
+    ::String TypeName;
+
+    bool Default()
+    {
+        CurrentKey = Keys::None;
+        return true;
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        if (CurrentKey == Keys::ID)
+            HasId = !Guid::Parse(StringAnsiView(str, (int32)length), Id);
+        else if (CurrentKey == Keys::TypeName)
+        {
+            TypeName.SetUTF8(str, (int32)length);
+            HasTypeName = true;
+        }
+        CurrentKey = Keys::None;
+        return !(HasId && HasTypeName);
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        const StringAnsiView key(str, (int32)length);
+        CurrentKey = Keys::None;
+        if (Depth == 1)
+        {
+            if (key == "ID")
+                CurrentKey = Keys::ID;
+            else if (key == "TypeName")
+                CurrentKey = Keys::TypeName;
+        }
+        return true;
+    }
+
+    bool StartObject()
+    {
+        CurrentKey = Keys::None;
+        Depth++;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount)
+    {
+        Depth--;
+        return true;
+    }
+
+    bool StartArray()
+    {
+        CurrentKey = Keys::None;
+        Depth++;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount)
+    {
+        Depth--;
+        return true;
+    }
+};
+
 bool JsonStorageProxy::GetAssetInfo(const StringView& path, Guid& resultId, String& resultDataTypeName)
 {
     PROFILE_CPU();
-    // TODO: we could just open file and start reading until we find 'ID:..' without parsing whole file - could be much more faster
 
     // Load file
     Array<byte> fileData;
@@ -28,28 +106,26 @@ bool JsonStorageProxy::GetAssetInfo(const StringView& path, Guid& resultId, Stri
         return false;
     }
 
-    // Parse data
-    rapidjson_flax::Document document;
+    // Stream the data without building the document and stop after reading the header
+    JsonAssetInfoHandler handler;
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream((const char*)fileData.Get(), fileData.Count());
+    rapidjson::ParseResult result;
     {
         PROFILE_CPU_NAMED("Json.Parse");
-        document.Parse((const char*)fileData.Get(), fileData.Count());
+        result = reader.Parse(stream, handler);
     }
-    if (document.HasParseError())
-    {
-        Log::JsonParseException(document.GetParseError(), document.GetErrorOffset(), path);
-        return false;
-    }
-
-    // Try get asset metadata
-    auto idNode = document.FindMember("ID");
-    auto typeNameNode = document.FindMember("TypeName");
-    if (idNode != document.MemberEnd() && typeNameNode != document.MemberEnd())
+    if (handler.HasId && handler.HasTypeName)
     {
         // Found
-        resultId = JsonTools::GetGuid(idNode->value);
-        resultDataTypeName = typeNameNode->value.GetText();
+        resultId = handler.Id;
+        resultDataTypeName = MoveTemp(handler.TypeName);
         return true;
     }
+    if (result.IsError())
+    {
+        Log::JsonParseException(result.Code(), result.Offset(), path);
+    }
 
     return false;
 }
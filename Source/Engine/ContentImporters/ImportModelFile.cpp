@@ -229,6 +229,21 @@ CreateAssetResult ImportModelFile::ImportModel(CreateAssetContext& context, Mode
             }
         }
 
+        // Pack meshes clusters
+        bool hasClusters = false;
+        for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++)
+            hasClusters |= meshes[meshIndex]->Clusters.HasItems();
+        if (hasClusters)
+        {
+            stream.WriteInt32(1); // Version
+            for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++)
+            {
+                const auto& clusters = meshes[meshIndex]->Clusters;
+                stream.WriteUint32(clusters.Count());
+                stream.WriteBytes(clusters.Get(), clusters.Count() * sizeof(MeshCluster));
+            }
+        }
+
         const int32 chunkIndex = lodIndex + 1;
         if (context.AllocateChunk(chunkIndex))
             return CreateAssetResult::CannotAllocateChunk;
@@ -247,6 +262,18 @@ CreateAssetResult ImportModelFile::ImportModel(CreateAssetContext& context, Mode
         }
     }
 
+    // Generate impostor
+    if (options && options->GenerateImpostor)
+    {
+        stream.SetPosition(0);
+        if (!ModelTool::GenerateModelImpostor(modelData, lodCount - 1, options->ImpostorFrames, options->ImpostorResolution, options->ImpostorScreenSize, stream, context.TargetAssetPath))
+        {
+            if (context.AllocateChunk(14))
+                return CreateAssetResult::CannotAllocateChunk;
+            context.Data.Header.Chunks[14]->Data.Copy(stream.GetHandle(), stream.GetPosition());
+        }
+    }
+
     return CreateAssetResult::Ok;
 }
 
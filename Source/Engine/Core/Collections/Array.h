@@ -560,13 +560,12 @@ API_CLASS(InBuild) class Array
     void Insert(int32 index, const T& item)
     {
         ASSERT(index >= 0 && index <= _count);
+        T copy(item); // Item can reference an element of this array which gets relocated below
         EnsureCapacity(_count + 1);
         T* data = _allocation.Get();
-        Memory::ConstructItems(data + _count, 1);
-        for (int32 i = _count - 1; i >= index; i--)
-            data[i + 1] = data[i];
+        Memory::RelocateItems(data + index + 1, data + index, _count - index);
         _count++;
-        data[index] = item;
+        Memory::MoveItems(data + index, &copy, 1);
     }
 
     /// <summary>
@@ -578,10 +577,9 @@ API_CLASS(InBuild) class Array
         ASSERT(index >= 0 && index <= _count);
         EnsureCapacity(_count + 1);
         T* data = _allocation.Get();
-        Memory::ConstructItems(data + _count, 1);
-        for (int32 i = _count - 1; i >= index; i--)
-            data[i + 1] = data[i];
+        Memory::RelocateItems(data + index + 1, data + index, _count - index);
         _count++;
+        Memory::ConstructItems(data + index, 1);
     }
 
     /// <summary>
@@ -641,15 +639,8 @@ API_CLASS(InBuild) class Array
         ASSERT(index < _count && index >= 0);
         _count--;
         T* data = _allocation.Get();
-        if (index < _count)
-        {
-            T* dst = data + index;
-            T* src = data + (index + 1);
-            const int32 count = _count - index;
-            for (int32 i = 0; i < count; i++)
-                dst[i] = MoveTemp(src[i]);
-        }
-        Memory::DestructItems(data + _count, 1);
+        Memory::DestructItems(data + index, 1);
+        Memory::RelocateItems(data + index, data + index + 1, _count - index);
     }
 
     /// <summary>
@@ -692,9 +683,9 @@ API_CLASS(InBuild) class Array
         ASSERT(index < _count && index >= 0);
         _count--;
         T* data = _allocation.Get();
-        if (_count)
-            data[index] = data[_count];
-        Memory::DestructItems(data + _count, 1);
+        Memory::DestructItems(data + index, 1);
+        if (index < _count)
+            Memory::RelocateItems(data + index, data + _count, 1);
     }
 
     /// <summary>
@@ -11,14 +11,14 @@
 /// <remarks>
 /// Array with variable capacity that does not moves elements when it grows so you can add item and use pointer to it while still keep adding new items.
 /// </remarks>
-template<typename T, int32 ChunkSize>
+template<typename T, int32 ChunkSize, typename AllocationType = HeapAllocation>
 class ChunkedArray
 {
     friend ChunkedArray;
 
 private:
     // TODO: don't use Array but small struct and don't InlinedArray or Chunk* but Chunk (less dynamic allocations)
-    typedef Array<T> Chunk;
+    typedef Array<T, AllocationType> Chunk;
 
     int32 _count = 0;
     Array<Chunk*, InlinedAllocation<32>> _chunks;
@@ -355,7 +355,7 @@ class ChunkedArray
         else
         {
             // Swap that item with the last item from the last chunk
-            (*_chunks[i._chunkIndex])[i._index] = lastChunk[lastIndex];
+            (*_chunks[i._chunkIndex])[i._index] = MoveTemp(lastChunk[lastIndex]);
             lastChunk.RemoveLast();
         }
 
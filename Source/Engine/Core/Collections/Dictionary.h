@@ -81,6 +81,14 @@ API_CLASS(InBuild) class Dictionary
             _state = Occupied;
         }
 
+        void Relocate(Bucket& other)
+        {
+            Memory::RelocateItems(&Key, &other.Key, 1);
+            Memory::RelocateItems(&Value, &other.Value, 1);
+            _state = Occupied;
+            other._state = Empty;
+        }
+
         FORCE_INLINE bool IsEmpty() const
         {
             return _state == Empty;
@@ -502,6 +510,11 @@ API_CLASS(InBuild) class Dictionary
         if (capacity == Capacity())
             return;
         ASSERT(capacity >= 0);
+        if (preserveContents && capacity <= _elementsCount && _elementsCount != 0)
+        {
+            // Keep at least one free bucket so every preserved element fits into the new table
+            capacity = _elementsCount + 1;
+        }
         AllocationData oldAllocation;
         oldAllocation.Swap(_allocation);
         const int32 oldSize = _size;
@@ -529,11 +542,19 @@ API_CLASS(InBuild) class Dictionary
         Bucket* oldData = oldAllocation.Get();
         if (oldElementsCount != 0 && preserveContents)
         {
-            // TODO; move keys and values on realloc
+            // Relocate keys and values into the new buckets (memory copy for trivially relocatable types)
+            Bucket* data = _allocation.Get();
             for (int32 i = 0; i < oldSize; i++)
             {
-                if (oldData[i].IsOccupied())
-                    Add(oldData[i].Key, MoveTemp(oldData[i].Value));
+                Bucket& oldBucket = oldData[i];
+                if (oldBucket.IsOccupied())
+                {
+                    FindPositionResult pos;
+                    FindPosition(oldBucket.Key, pos);
+                    ASSERT(pos.FreeSlotIndex != -1);
+                    data[pos.FreeSlotIndex].Relocate(oldBucket);
+                    _elementsCount++;
+                }
             }
         }
         if (oldElementsCount != 0)
@@ -0,0 +1,831 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Memory/Allocation.h"
+#include "Engine/Core/Collections/FlatHashTable.h"
+
+/// <summary>
+/// Template for unordered dictionary with mapped key with value pairs. Uses open-addressing with separate control bytes array that is probed in groups with SIMD (faster lookups than Dictionary for hot paths).
+/// </summary>
+/// <remarks>Mirrors Dictionary API. The capacity is an amount of slots (power of two, at least 16), up to 7/8 of it can be used before growing.</remarks>
+/// <typeparam name="KeyType">The type of the keys in the dictionary.</typeparam>
+/// <typeparam name="ValueType">The type of the values in the dictionary.</typeparam>
+/// <typeparam name="AllocationType">The type of memory allocator.</typeparam>
+template<typename KeyType, typename ValueType, typename AllocationType = HeapAllocation>
+class FlatDictionary
+{
+    friend FlatDictionary;
+public:
+    /// <summary>
+    /// Describes single portion of space for the key and value pair in a hash map.
+    /// </summary>
+    struct Bucket
+    {
+        /// <summary>The key.</summary>
+        KeyType Key;
+        /// <summary>The value.</summary>
+        ValueType Value;
+    };
+
+    typedef typename AllocationType::template Data<Bucket> AllocationData;
+    typedef typename AllocationType::template Data<byte> ControlData;
+
+private:
+    int32 _elementsCount = 0;
+    int32 _deletedCount = 0;
+    int32 _size = 0;
+    ControlData _control;
+    AllocationData _allocation;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    FlatDictionary()
+    {
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="capacity">The initial capacity.</param>
+    FlatDictionary(int32 capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    FlatDictionary(FlatDictionary&& other) noexcept
+        : _elementsCount(other._elementsCount)
+        , _deletedCount(other._deletedCount)
+        , _size(other._size)
+    {
+        other._elementsCount = 0;
+        other._deletedCount = 0;
+        other._size = 0;
+        _control.Swap(other._control);
+        _allocation.Swap(other._allocation);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="other">Other collection to copy</param>
+    FlatDictionary(const FlatDictionary& other)
+    {
+        Clone(other);
+    }
+
+    /// <summary>
+    /// Clones the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to copy.</param>
+    /// <returns>The reference to this.</returns>
+    FlatDictionary& operator=(const FlatDictionary& other)
+    {
+        if (this != &other)
+            Clone(other);
+        return *this;
+    }
+
+    /// <summary>
+    /// Moves the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    /// <returns>The reference to this.</returns>
+    FlatDictionary& operator=(FlatDictionary&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            _control.Free();
+            _allocation.Free();
+            _elementsCount = other._elementsCount;
+            _deletedCount = other._deletedCount;
+            _size = other._size;
+            other._elementsCount = 0;
+            other._deletedCount = 0;
+            other._size = 0;
+            _control.Swap(other._control);
+            _allocation.Swap(other._allocation);
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    ~FlatDictionary()
+    {
+        Clear();
+    }
+
+public:
+    /// <summary>
+    /// Gets the amount of the elements in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return _elementsCount;
+    }
+
+    /// <summary>
+    /// Gets the amount of the slots in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Capacity() const
+    {
+        return _size;
+    }
+
+    /// <summary>
+    /// Returns true if collection is empty.
+    /// </summary>
+    FORCE_INLINE bool IsEmpty() const
+    {
+        return _elementsCount == 0;
+    }
+
+    /// <summary>
+    /// Returns true if collection has one or more elements.
+    /// </summary>
+    FORCE_INLINE bool HasItems() const
+    {
+        return _elementsCount != 0;
+    }
+
+public:
+    /// <summary>
+    /// The FlatDictionary collection iterator.
+    /// </summary>
+    struct Iterator
+    {
+        friend FlatDictionary;
+    private:
+        FlatDictionary& _collection;
+        int32 _index;
+
+    public:
+        Iterator(FlatDictionary& collection, const int32 index)
+            : _collection(collection)
+            , _index(index)
+        {
+        }
+
+        Iterator(FlatDictionary const& collection, const int32 index)
+            : _collection((FlatDictionary&)collection)
+            , _index(index)
+        {
+        }
+
+        Iterator(const Iterator& i)
+            : _collection(i._collection)
+            , _index(i._index)
+        {
+        }
+
+        Iterator(Iterator&& i)
+            : _collection(i._collection)
+            , _index(i._index)
+        {
+        }
+
+    public:
+        FORCE_INLINE int32 Index() const
+        {
+            return _index;
+        }
+
+        FORCE_INLINE bool IsEnd() const
+        {
+            return _index == _collection._size;
+        }
+
+        FORCE_INLINE bool IsNotEnd() const
+        {
+            return _index != _collection._size;
+        }
+
+        FORCE_INLINE Bucket& operator*() const
+        {
+            return _collection._allocation.Get()[_index];
+        }
+
+        FORCE_INLINE Bucket* operator->() const
+        {
+            return &_collection._allocation.Get()[_index];
+        }
+
+        FORCE_INLINE explicit operator bool() const
+        {
+            return _index >= 0 && _index < _collection._size;
+        }
+
+        FORCE_INLINE bool operator!() const
+        {
+            return !(bool)*this;
+        }
+
+        FORCE_INLINE bool operator==(const Iterator& v) const
+        {
+            return _index == v._index && &_collection == &v._collection;
+        }
+
+        FORCE_INLINE bool operator!=(const Iterator& v) const
+        {
+            return _index != v._index || &_collection != &v._collection;
+        }
+
+        Iterator& operator=(const Iterator& v)
+        {
+            _collection = v._collection;
+            _index = v._index;
+            return *this;
+        }
+
+        Iterator& operator++()
+        {
+            const int32 capacity = _collection._size;
+            if (_index != capacity)
+            {
+                const byte* control = _collection._control.Get();
+                do
+                {
+                    _index++;
+                } while (_index != capacity && !FlatHashTable::IsFull(control[_index]));
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) const
+        {
+            Iterator i = *this;
+            ++i;
+            return i;
+        }
+
+        Iterator& operator--()
+        {
+            if (_index > 0)
+            {
+                const byte* control = _collection._control.Get();
+                do
+                {
+                    _index--;
+                } while (_index > 0 && !FlatHashTable::IsFull(control[_index]));
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) const
+        {
+            Iterator i = *this;
+            --i;
+            return i;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Gets element by the key (will add default ValueType element if key not found).
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    ValueType& At(const KeyComparableType& key)
+    {
+        const uint32 hash = FlatHashTable::MixHash(GetHash(key));
+        const int32 index = FindIndex(key, hash);
+        if (index != -1)
+            return _allocation.Get()[index].Value;
+        const int32 insertIndex = Insert(hash);
+        Bucket* bucket = _allocation.Get() + insertIndex;
+        Memory::ConstructItems(&bucket->Key, &key, 1);
+        Memory::ConstructItem(&bucket->Value);
+        return bucket->Value;
+    }
+
+    /// <summary>
+    /// Gets the element by the key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    const ValueType& At(const KeyComparableType& key) const
+    {
+        const int32 index = FindIndex(key, FlatHashTable::MixHash(GetHash(key)));
+        ASSERT(index != -1);
+        return _allocation.Get()[index].Value;
+    }
+
+    /// <summary>
+    /// Gets or sets the element by the key.
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    FORCE_INLINE ValueType& operator[](const KeyComparableType& key)
+    {
+        return At(key);
+    }
+
+    /// <summary>
+    /// Gets or sets the element by the key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    FORCE_INLINE const ValueType& operator[](const KeyComparableType& key) const
+    {
+        return At(key);
+    }
+
+    /// <summary>
+    /// Tries to get element with given key.
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <param name="result">The result value.</param>
+    /// <returns>True if element of given key has been found, otherwise false.</returns>
+    template<typename KeyComparableType>
+    bool TryGet(const KeyComparableType& key, ValueType& result) const
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindIndex(key, FlatHashTable::MixHash(GetHash(key)));
+        if (index == -1)
+            return false;
+        result = _allocation.Get()[index].Value;
+        return true;
+    }
+
+    /// <summary>
+    /// Tries to get pointer to the element with given key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>Pointer to the element value or null if cannot find it.</returns>
+    template<typename KeyComparableType>
+    ValueType* TryGet(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return nullptr;
+        const int32 index = FindIndex(key, FlatHashTable::MixHash(GetHash(key)));
+        if (index == -1)
+            return nullptr;
+        return (ValueType*)&_allocation.Get()[index].Value;
+    }
+
+public:
+    /// <summary>
+    /// Clears the collection but without changing its capacity (all inserted elements: keys and values will be removed).
+    /// </summary>
+    void Clear()
+    {
+        if (_elementsCount + _deletedCount != 0)
+        {
+            byte* control = _control.Get();
+            Bucket* data = _allocation.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (FlatHashTable::IsFull(control[i]))
+                {
+                    Memory::DestructItem(&data[i].Key);
+                    Memory::DestructItem(&data[i].Value);
+                }
+            }
+            Platform::MemorySet(control, _size, FlatHashTable::Empty);
+            _elementsCount = _deletedCount = 0;
+        }
+    }
+
+    /// <summary>
+    /// Clears the collection and delete value objects.
+    /// Note: collection must contain pointers to the objects that have public destructor and be allocated using New method.
+    /// </summary>
+#if defined(_MSC_VER)
+    template<typename = typename TEnableIf<TIsPointer<ValueType>::Value>::Type>
+#endif
+    void ClearDelete()
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value)
+                Delete(i->Value);
+        }
+        Clear();
+    }
+
+    /// <summary>
+    /// Changes the capacity of the collection.
+    /// </summary>
+    /// <param name="capacity">The new capacity (amount of slots, rounded up to the power of two).</param>
+    /// <param name="preserveContents">Enables preserving collection contents during resizing.</param>
+    void SetCapacity(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(capacity >= 0);
+        if (capacity != 0)
+        {
+            if (capacity < FlatHashTable::GroupSize)
+                capacity = FlatHashTable::GroupSize;
+            if ((capacity & (capacity - 1)) != 0)
+            {
+                // Align capacity value to the next power of two (http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2)
+                capacity--;
+                capacity |= capacity >> 1;
+                capacity |= capacity >> 2;
+                capacity |= capacity >> 4;
+                capacity |= capacity >> 8;
+                capacity |= capacity >> 16;
+                capacity++;
+            }
+        }
+        if (capacity == _size)
+            return;
+        Rehash(capacity, preserveContents);
+    }
+
+    /// <summary>
+    /// Ensures that collection can contain a given amount of elements without resizing.
+    /// </summary>
+    /// <param name="minCapacity">The minimum required amount of elements.</param>
+    /// <param name="preserveContents">True if preserve collection data when changing its size, otherwise collection after resize will be empty.</param>
+    void EnsureCapacity(int32 minCapacity, bool preserveContents = true)
+    {
+        if (FlatHashTable::GetMaxLoad(_size) >= minCapacity)
+            return;
+        SetCapacity(FlatHashTable::GetCapacityFor(minCapacity), preserveContents);
+    }
+
+    /// <summary>
+    /// Swaps the contents of collection with the other object without copy operation. Performs fast internal data exchange.
+    /// </summary>
+    /// <param name="other">The other collection.</param>
+    void Swap(FlatDictionary& other)
+    {
+        ::Swap(_elementsCount, other._elementsCount);
+        ::Swap(_deletedCount, other._deletedCount);
+        ::Swap(_size, other._size);
+        _control.Swap(other._control);
+        _allocation.Swap(other._allocation);
+    }
+
+public:
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="key">The key.</param>
+    /// <param name="value">The value.</param>
+    /// <returns>Weak reference to the stored bucket.</returns>
+    template<typename KeyComparableType>
+    Bucket* Add(const KeyComparableType& key, const ValueType& value)
+    {
+        const uint32 hash = FlatHashTable::MixHash(GetHash(key));
+        ASSERT(FindIndex(key, hash) == -1 && "That key has been already added to the dictionary.");
+        const int32 index = Insert(hash);
+        Bucket* bucket = _allocation.Get() + index;
+        Memory::ConstructItems(&bucket->Key, &key, 1);
+        Memory::ConstructItems(&bucket->Value, &value, 1);
+        return bucket;
+    }
+
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="key">The key.</param>
+    /// <param name="value">The value.</param>
+    /// <returns>Weak reference to the stored bucket.</returns>
+    template<typename KeyComparableType>
+    Bucket* Add(const KeyComparableType& key, ValueType&& value)
+    {
+        const uint32 hash = FlatHashTable::MixHash(GetHash(key));
+        ASSERT(FindIndex(key, hash) == -1 && "That key has been already added to the dictionary.");
+        const int32 index = Insert(hash);
+        Bucket* bucket = _allocation.Get() + index;
+        Memory::ConstructItems(&bucket->Key, &key, 1);
+        Memory::MoveItems(&bucket->Value, &value, 1);
+        return bucket;
+    }
+
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="i">Iterator with key and value.</param>
+    void Add(const Iterator& i)
+    {
+        ASSERT(&i._collection != this && i);
+        const Bucket& bucket = *i;
+        Add(bucket.Key, bucket.Value);
+    }
+
+    /// <summary>
+    /// Removes element with a specified key.
+    /// </summary>
+    /// <param name="key">The element key to remove.</param>
+    /// <returns>True if cannot remove item from the collection because cannot find it, otherwise false.</returns>
+    template<typename KeyComparableType>
+    bool Remove(const KeyComparableType& key)
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindIndex(key, FlatHashTable::MixHash(GetHash(key)));
+        if (index != -1)
+        {
+            RemoveAt(index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes element at specified iterator.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if cannot remove item from the collection because cannot find it, otherwise false.</returns>
+    bool Remove(const Iterator& i)
+    {
+        ASSERT(&i._collection == this);
+        if (i)
+        {
+            ASSERT(FlatHashTable::IsFull(_control.Get()[i._index]));
+            RemoveAt(i._index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes elements with a specified value
+    /// </summary>
+    /// <param name="value">Element value to remove</param>
+    /// <returns>The amount of removed items. Zero if nothing changed.</returns>
+    int32 RemoveValue(const ValueType& value)
+    {
+        int32 result = 0;
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value == value)
+            {
+                Remove(i);
+                result++;
+            }
+        }
+        return result;
+    }
+
+public:
+    /// <summary>
+    /// Finds the element with given key in the collection.
+    /// </summary>
+    /// <param name="key">The key to find.</param>
+    /// <returns>The iterator for the found element or End if cannot find it.</returns>
+    template<typename KeyComparableType>
+    Iterator Find(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return End();
+        const int32 index = FindIndex(key, FlatHashTable::MixHash(GetHash(key)));
+        return index != -1 ? Iterator(*this, index) : End();
+    }
+
+    /// <summary>
+    /// Checks if given key is in a collection.
+    /// </summary>
+    /// <param name="key">The key to find.</param>
+    /// <returns>True if key has been found in a collection, otherwise false.</returns>
+    template<typename KeyComparableType>
+    bool ContainsKey(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return false;
+        return FindIndex(key, FlatHashTable::MixHash(GetHash(key))) != -1;
+    }
+
+    /// <summary>
+    /// Checks if given value is in a collection.
+    /// </summary>
+    /// <param name="value">The value to find.</param>
+    /// <returns>True if value has been found in a collection, otherwise false.</returns>
+    bool ContainsValue(const ValueType& value) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value == value)
+                return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Searches for the specified object and returns the zero-based index of the first occurrence within the entire dictionary.
+    /// </summary>
+    /// <param name="value">The value of the key to find.</param>
+    /// <param name="key">The output key.</param>
+    /// <returns>True if value has been found, otherwise false.</returns>
+    bool KeyOf(const ValueType& value, KeyType* key) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value == value)
+            {
+                if (key)
+                    *key = i->Key;
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    /// <summary>
+    /// Clones other collection into this.
+    /// </summary>
+    /// <param name="other">The other collection to clone.</param>
+    void Clone(const FlatDictionary& other)
+    {
+        Clear();
+        SetCapacity(other.Capacity(), false);
+        for (Iterator i = other.Begin(); i != other.End(); ++i)
+            Add(i);
+        ASSERT(Count() == other.Count());
+    }
+
+    /// <summary>
+    /// Gets the keys collection to the output array (will contain unique items).
+    /// </summary>
+    /// <param name="result">The result.</param>
+    template<typename ArrayAllocation>
+    void GetKeys(Array<KeyType, ArrayAllocation>& result) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+            result.Add(i->Key);
+    }
+
+    /// <summary>
+    /// Gets the values collection to the output array (may contain duplicates).
+    /// </summary>
+    /// <param name="result">The result.</param>
+    template<typename ArrayAllocation>
+    void GetValues(Array<ValueType, ArrayAllocation>& result) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+            result.Add(i->Value);
+    }
+
+public:
+    Iterator Begin() const
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    Iterator End() const
+    {
+        return Iterator(*this, _size);
+    }
+
+    Iterator begin()
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    FORCE_INLINE Iterator end()
+    {
+        return Iterator(*this, _size);
+    }
+
+    const Iterator begin() const
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    FORCE_INLINE const Iterator end() const
+    {
+        return Iterator(*this, _size);
+    }
+
+private:
+    void Rehash(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(!preserveContents || FlatHashTable::GetMaxLoad(capacity) >= _elementsCount);
+        ControlData oldControl;
+        AllocationData oldAllocation;
+        oldControl.Swap(_control);
+        oldAllocation.Swap(_allocation);
+        const int32 oldSize = _size;
+        _deletedCount = _elementsCount = 0;
+        if (capacity)
+        {
+            _control.Allocate(capacity);
+            _allocation.Allocate(capacity);
+            Platform::MemorySet(_control.Get(), capacity, FlatHashTable::Empty);
+        }
+        _size = capacity;
+        if (oldSize)
+        {
+            const byte* oldControlData = oldControl.Get();
+            Bucket* oldData = oldAllocation.Get();
+            for (int32 i = 0; i < oldSize; i++)
+            {
+                if (!FlatHashTable::IsFull(oldControlData[i]))
+                    continue;
+                Bucket& oldBucket = oldData[i];
+                if (preserveContents)
+                {
+                    // Move element to the new table (keys are unique so skip the lookup)
+                    const int32 index = Insert(FlatHashTable::MixHash(GetHash(oldBucket.Key)));
+                    Bucket* bucket = _allocation.Get() + index;
+                    Memory::MoveItems(&bucket->Key, &oldBucket.Key, 1);
+                    Memory::MoveItems(&bucket->Value, &oldBucket.Value, 1);
+                }
+                Memory::DestructItem(&oldBucket.Key);
+                Memory::DestructItem(&oldBucket.Value);
+            }
+        }
+    }
+
+    template<typename KeyComparableType>
+    int32 FindIndex(const KeyComparableType& key, uint32 hash) const
+    {
+        if (_size == 0)
+            return -1;
+        const byte tag = FlatHashTable::GetHashTag(hash);
+        const byte* control = _control.Get();
+        const Bucket* data = _allocation.Get();
+        const int32 groupsMask = _size / FlatHashTable::GroupSize - 1;
+        int32 group = (int32)hash & groupsMask;
+        for (int32 probe = 1; probe <= groupsMask + 1; probe++)
+        {
+            const int32 groupStart = group * FlatHashTable::GroupSize;
+            uint32 match = FlatHashTable::MatchTag(control + groupStart, tag);
+            while (match)
+            {
+                const int32 index = groupStart + FlatHashTable::GetFirstBit(match);
+                if (data[index].Key == key)
+                    return index;
+                match &= match - 1;
+            }
+
+            // Any empty slot within a group ends the probing sequence
+            if (FlatHashTable::MatchEmpty(control + groupStart))
+                break;
+
+            // Triangular probing visits every group when groups count is power of two
+            group = (group + probe) & groupsMask;
+        }
+        return -1;
+    }
+
+    int32 Insert(uint32 hash)
+    {
+        // Grow table if it's too full after insertion (or rehash in-place to cleanup deleted slots)
+        if (_elementsCount + _deletedCount + 1 > FlatHashTable::GetMaxLoad(_size))
+        {
+            const int32 capacity = _elementsCount + 1 > FlatHashTable::GetMaxLoad(_size) / 2 ? _size * 2 : _size;
+            Rehash(capacity > FlatHashTable::GroupSize ? capacity : FlatHashTable::GroupSize);
+        }
+
+        // Find the first free slot in the probing sequence
+        byte* control = _control.Get();
+        const int32 groupsMask = _size / FlatHashTable::GroupSize - 1;
+        int32 group = (int32)hash & groupsMask;
+        int32 probe = 1;
+        uint32 match;
+        while (!(match = FlatHashTable::MatchFree(control + group * FlatHashTable::GroupSize)))
+            group = (group + probe++) & groupsMask;
+        const int32 index = group * FlatHashTable::GroupSize + FlatHashTable::GetFirstBit(match);
+        if (control[index] == FlatHashTable::Deleted)
+            _deletedCount--;
+        control[index] = FlatHashTable::GetHashTag(hash);
+        _elementsCount++;
+        return index;
+    }
+
+    void RemoveAt(int32 index)
+    {
+        Bucket& bucket = _allocation.Get()[index];
+        Memory::DestructItem(&bucket.Key);
+        Memory::DestructItem(&bucket.Value);
+
+        // Slot can become empty only if the group has been never full (no probing sequence goes through it)
+        byte* control = _control.Get();
+        const int32 groupStart = index & ~(FlatHashTable::GroupSize - 1);
+        if (FlatHashTable::MatchEmpty(control + groupStart))
+        {
+            control[index] = FlatHashTable::Empty;
+        }
+        else
+        {
+            control[index] = FlatHashTable::Deleted;
+            _deletedCount++;
+        }
+        _elementsCount--;
+    }
+};
@@ -0,0 +1,638 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Memory/Allocation.h"
+#include "Engine/Core/Collections/FlatHashTable.h"
+
+/// <summary>
+/// Template for unordered set of values (without duplicates with O(1) lookup access). Uses open-addressing with separate control bytes array that is probed in groups with SIMD (faster lookups than HashSet for hot paths).
+/// </summary>
+/// <remarks>Mirrors HashSet API. The capacity is an amount of slots (power of two, at least 16), up to 7/8 of it can be used before growing.</remarks>
+/// <typeparam name="T">The type of elements in the set.</typeparam>
+/// <typeparam name="AllocationType">The type of memory allocator.</typeparam>
+template<typename T, typename AllocationType = HeapAllocation>
+class FlatHashSet
+{
+    friend FlatHashSet;
+public:
+    /// <summary>
+    /// Describes single portion of space for the item in a hash map.
+    /// </summary>
+    struct Bucket
+    {
+        /// <summary>The item.</summary>
+        T Item;
+    };
+
+    typedef typename AllocationType::template Data<Bucket> AllocationData;
+    typedef typename AllocationType::template Data<byte> ControlData;
+
+private:
+    int32 _elementsCount = 0;
+    int32 _deletedCount = 0;
+    int32 _size = 0;
+    ControlData _control;
+    AllocationData _allocation;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    FlatHashSet()
+    {
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="capacity">The initial capacity.</param>
+    FlatHashSet(int32 capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    FlatHashSet(FlatHashSet&& other) noexcept
+        : _elementsCount(other._elementsCount)
+        , _deletedCount(other._deletedCount)
+        , _size(other._size)
+    {
+        other._elementsCount = 0;
+        other._deletedCount = 0;
+        other._size = 0;
+        _control.Swap(other._control);
+        _allocation.Swap(other._allocation);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="other">Other collection to copy</param>
+    FlatHashSet(const FlatHashSet& other)
+    {
+        Clone(other);
+    }
+
+    /// <summary>
+    /// Clones the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to copy.</param>
+    /// <returns>The reference to this.</returns>
+    FlatHashSet& operator=(const FlatHashSet& other)
+    {
+        if (this != &other)
+            Clone(other);
+        return *this;
+    }
+
+    /// <summary>
+    /// Moves the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    /// <returns>The reference to this.</returns>
+    FlatHashSet& operator=(FlatHashSet&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            _control.Free();
+            _allocation.Free();
+            _elementsCount = other._elementsCount;
+            _deletedCount = other._deletedCount;
+            _size = other._size;
+            other._elementsCount = 0;
+            other._deletedCount = 0;
+            other._size = 0;
+            _control.Swap(other._control);
+            _allocation.Swap(other._allocation);
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    ~FlatHashSet()
+    {
+        Clear();
+    }
+
+public:
+    /// <summary>
+    /// Gets the amount of the elements in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return _elementsCount;
+    }
+
+    /// <summary>
+    /// Gets the amount of the slots in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Capacity() const
+    {
+        return _size;
+    }
+
+    /// <summary>
+    /// Returns true if collection is empty.
+    /// </summary>
+    FORCE_INLINE bool IsEmpty() const
+    {
+        return _elementsCount == 0;
+    }
+
+    /// <summary>
+    /// Returns true if collection has one or more elements.
+    /// </summary>
+    FORCE_INLINE bool HasItems() const
+    {
+        return _elementsCount != 0;
+    }
+
+public:
+    /// <summary>
+    /// The FlatHashSet collection iterator.
+    /// </summary>
+    struct Iterator
+    {
+        friend FlatHashSet;
+    private:
+        FlatHashSet& _collection;
+        int32 _index;
+
+    public:
+        Iterator(FlatHashSet& collection, const int32 index)
+            : _collection(collection)
+            , _index(index)
+        {
+        }
+
+        Iterator(FlatHashSet const& collection, const int32 index)
+            : _collection((FlatHashSet&)collection)
+            , _index(index)
+        {
+        }
+
+        Iterator(const Iterator& i)
+            : _collection(i._collection)
+            , _index(i._index)
+        {
+        }
+
+        Iterator(Iterator&& i)
+            : _collection(i._collection)
+            , _index(i._index)
+        {
+        }
+
+    public:
+        FORCE_INLINE int32 Index() const
+        {
+            return _index;
+        }
+
+        FORCE_INLINE bool IsEnd() const
+        {
+            return _index == _collection._size;
+        }
+
+        FORCE_INLINE bool IsNotEnd() const
+        {
+            return _index != _collection._size;
+        }
+
+        FORCE_INLINE Bucket& operator*() const
+        {
+            return _collection._allocation.Get()[_index];
+        }
+
+        FORCE_INLINE Bucket* operator->() const
+        {
+            return &_collection._allocation.Get()[_index];
+        }
+
+        FORCE_INLINE explicit operator bool() const
+        {
+            return _index >= 0 && _index < _collection._size;
+        }
+
+        FORCE_INLINE bool operator!() const
+        {
+            return !(bool)*this;
+        }
+
+        FORCE_INLINE bool operator==(const Iterator& v) const
+        {
+            return _index == v._index && &_collection == &v._collection;
+        }
+
+        FORCE_INLINE bool operator!=(const Iterator& v) const
+        {
+            return _index != v._index || &_collection != &v._collection;
+        }
+
+        Iterator& operator=(const Iterator& v)
+        {
+            _collection = v._collection;
+            _index = v._index;
+            return *this;
+        }
+
+        Iterator& operator++()
+        {
+            const int32 capacity = _collection._size;
+            if (_index != capacity)
+            {
+                const byte* control = _collection._control.Get();
+                do
+                {
+                    _index++;
+                } while (_index != capacity && !FlatHashTable::IsFull(control[_index]));
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) const
+        {
+            Iterator i = *this;
+            ++i;
+            return i;
+        }
+
+        Iterator& operator--()
+        {
+            if (_index > 0)
+            {
+                const byte* control = _collection._control.Get();
+                do
+                {
+                    _index--;
+                } while (_index > 0 && !FlatHashTable::IsFull(control[_index]));
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) const
+        {
+            Iterator i = *this;
+            --i;
+            return i;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Removes all elements from the collection.
+    /// </summary>
+    void Clear()
+    {
+        if (_elementsCount + _deletedCount != 0)
+        {
+            byte* control = _control.Get();
+            Bucket* data = _allocation.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (FlatHashTable::IsFull(control[i]))
+                    Memory::DestructItem(&data[i].Item);
+            }
+            Platform::MemorySet(control, _size, FlatHashTable::Empty);
+            _elementsCount = _deletedCount = 0;
+        }
+    }
+
+    /// <summary>
+    /// Clears the collection and delete value objects.
+    /// Note: collection must contain pointers to the objects that have public destructor and be allocated using New method.
+    /// </summary>
+#if defined(_MSC_VER)
+    template<typename = typename TEnableIf<TIsPointer<T>::Value>::Type>
+#endif
+    void ClearDelete()
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Item)
+                ::Delete(i->Item);
+        }
+        Clear();
+    }
+
+    /// <summary>
+    /// Changes the capacity of the collection.
+    /// </summary>
+    /// <param name="capacity">The new capacity (amount of slots, rounded up to the power of two).</param>
+    /// <param name="preserveContents">Enables preserving collection contents during resizing.</param>
+    void SetCapacity(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(capacity >= 0);
+        if (capacity != 0)
+        {
+            if (capacity < FlatHashTable::GroupSize)
+                capacity = FlatHashTable::GroupSize;
+            if ((capacity & (capacity - 1)) != 0)
+            {
+                // Align capacity value to the next power of two (http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2)
+                capacity--;
+                capacity |= capacity >> 1;
+                capacity |= capacity >> 2;
+                capacity |= capacity >> 4;
+                capacity |= capacity >> 8;
+                capacity |= capacity >> 16;
+                capacity++;
+            }
+        }
+        if (capacity == _size)
+            return;
+        Rehash(capacity, preserveContents);
+    }
+
+    /// <summary>
+    /// Ensures that collection can contain a given amount of elements without resizing.
+    /// </summary>
+    /// <param name="minCapacity">The minimum required amount of elements.</param>
+    /// <param name="preserveContents">True if preserve collection data when changing its size, otherwise collection after resize will be empty.</param>
+    void EnsureCapacity(int32 minCapacity, bool preserveContents = true)
+    {
+        if (FlatHashTable::GetMaxLoad(_size) >= minCapacity)
+            return;
+        SetCapacity(FlatHashTable::GetCapacityFor(minCapacity), preserveContents);
+    }
+
+    /// <summary>
+    /// Swaps the contents of collection with the other object without copy operation. Performs fast internal data exchange.
+    /// </summary>
+    /// <param name="other">The other collection.</param>
+    void Swap(FlatHashSet& other)
+    {
+        ::Swap(_elementsCount, other._elementsCount);
+        ::Swap(_deletedCount, other._deletedCount);
+        ::Swap(_size, other._size);
+        _control.Swap(other._control);
+        _allocation.Swap(other._allocation);
+    }
+
+public:
+    /// <summary>
+    /// Add element to the collection.
+    /// </summary>
+    /// <param name="item">The element to add to the set.</param>
+    /// <returns>True if element has been added to the collection, otherwise false if the element is already present.</returns>
+    template<typename ItemType>
+    bool Add(const ItemType& item)
+    {
+        const uint32 hash = FlatHashTable::MixHash(GetHash(item));
+        if (FindIndex(item, hash) != -1)
+            return false;
+        const int32 index = Insert(hash);
+        Bucket* bucket = _allocation.Get() + index;
+        Memory::ConstructItems(&bucket->Item, &item, 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Add element at iterator to the collection
+    /// </summary>
+    /// <param name="i">Iterator with item to add</param>
+    void Add(const Iterator& i)
+    {
+        ASSERT(&i._collection != this && i);
+        const Bucket& bucket = *i;
+        Add(bucket.Item);
+    }
+
+    /// <summary>
+    /// Removes the specified element from the collection.
+    /// </summary>
+    /// <param name="item">The element to remove.</param>
+    /// <returns>True if cannot remove item from the collection because cannot find it, otherwise false.</returns>
+    template<typename ItemType>
+    bool Remove(const ItemType& item)
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindIndex(item, FlatHashTable::MixHash(GetHash(item)));
+        if (index != -1)
+        {
+            RemoveAt(index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes an element at specified iterator position.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if cannot remove item from the collection because cannot find it, otherwise false.</returns>
+    bool Remove(const Iterator& i)
+    {
+        ASSERT(&i._collection == this);
+        if (i)
+        {
+            ASSERT(FlatHashTable::IsFull(_control.Get()[i._index]));
+            RemoveAt(i._index);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    /// <summary>
+    /// Find element with given item in the collection
+    /// </summary>
+    /// <param name="item">Item to find</param>
+    /// <returns>Iterator for the found element or End if cannot find it</returns>
+    template<typename ItemType>
+    Iterator Find(const ItemType& item) const
+    {
+        if (IsEmpty())
+            return End();
+        const int32 index = FindIndex(item, FlatHashTable::MixHash(GetHash(item)));
+        return index != -1 ? Iterator(*this, index) : End();
+    }
+
+    /// <summary>
+    /// Determines whether a collection contains the specified element.
+    /// </summary>
+    /// <param name="item">The item to locate.</param>
+    /// <returns>True if value has been found in a collection, otherwise false</returns>
+    template<typename ItemType>
+    bool Contains(const ItemType& item) const
+    {
+        if (IsEmpty())
+            return false;
+        return FindIndex(item, FlatHashTable::MixHash(GetHash(item))) != -1;
+    }
+
+public:
+    /// <summary>
+    /// Clones other collection into this.
+    /// </summary>
+    /// <param name="other">The other collection to clone.</param>
+    void Clone(const FlatHashSet& other)
+    {
+        Clear();
+        SetCapacity(other.Capacity(), false);
+        for (Iterator i = other.Begin(); i != other.End(); ++i)
+            Add(i);
+        ASSERT(Count() == other.Count());
+    }
+
+public:
+    Iterator Begin() const
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    Iterator End() const
+    {
+        return Iterator(*this, _size);
+    }
+
+    Iterator begin()
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    FORCE_INLINE Iterator end()
+    {
+        return Iterator(*this, _size);
+    }
+
+    const Iterator begin() const
+    {
+        Iterator i(*this, -1);
+        ++i;
+        return i;
+    }
+
+    FORCE_INLINE const Iterator end() const
+    {
+        return Iterator(*this, _size);
+    }
+
+private:
+    void Rehash(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(!preserveContents || FlatHashTable::GetMaxLoad(capacity) >= _elementsCount);
+        ControlData oldControl;
+        AllocationData oldAllocation;
+        oldControl.Swap(_control);
+        oldAllocation.Swap(_allocation);
+        const int32 oldSize = _size;
+        _deletedCount = _elementsCount = 0;
+        if (capacity)
+        {
+            _control.Allocate(capacity);
+            _allocation.Allocate(capacity);
+            Platform::MemorySet(_control.Get(), capacity, FlatHashTable::Empty);
+        }
+        _size = capacity;
+        if (oldSize)
+        {
+            const byte* oldControlData = oldControl.Get();
+            Bucket* oldData = oldAllocation.Get();
+            for (int32 i = 0; i < oldSize; i++)
+            {
+                if (!FlatHashTable::IsFull(oldControlData[i]))
+                    continue;
+                Bucket& oldBucket = oldData[i];
+                if (preserveContents)
+                {
+                    // Move element to the new table (items are unique so skip the lookup)
+                    const int32 index = Insert(FlatHashTable::MixHash(GetHash(oldBucket.Item)));
+                    Bucket* bucket = _allocation.Get() + index;
+                    Memory::MoveItems(&bucket->Item, &oldBucket.Item, 1);
+                }
+                Memory::DestructItem(&oldBucket.Item);
+            }
+        }
+    }
+
+    template<typename ItemType>
+    int32 FindIndex(const ItemType& item, uint32 hash) const
+    {
+        if (_size == 0)
+            return -1;
+        const byte tag = FlatHashTable::GetHashTag(hash);
+        const byte* control = _control.Get();
+        const Bucket* data = _allocation.Get();
+        const int32 groupsMask = _size / FlatHashTable::GroupSize - 1;
+        int32 group = (int32)hash & groupsMask;
+        for (int32 probe = 1; probe <= groupsMask + 1; probe++)
+        {
+            const int32 groupStart = group * FlatHashTable::GroupSize;
+            uint32 match = FlatHashTable::MatchTag(control + groupStart, tag);
+            while (match)
+            {
+                const int32 index = groupStart + FlatHashTable::GetFirstBit(match);
+                if (data[index].Item == item)
+                    return index;
+                match &= match - 1;
+            }
+
+            // Any empty slot within a group ends the probing sequence
+            if (FlatHashTable::MatchEmpty(control + groupStart))
+                break;
+
+            // Triangular probing visits every group when groups count is power of two
+            group = (group + probe) & groupsMask;
+        }
+        return -1;
+    }
+
+    int32 Insert(uint32 hash)
+    {
+        // Grow table if it's too full after insertion (or rehash in-place to cleanup deleted slots)
+        if (_elementsCount + _deletedCount + 1 > FlatHashTable::GetMaxLoad(_size))
+        {
+            const int32 capacity = _elementsCount + 1 > FlatHashTable::GetMaxLoad(_size) / 2 ? _size * 2 : _size;
+            Rehash(capacity > FlatHashTable::GroupSize ? capacity : FlatHashTable::GroupSize);
+        }
+
+        // Find the first free slot in the probing sequence
+        byte* control = _control.Get();
+        const int32 groupsMask = _size / FlatHashTable::GroupSize - 1;
+        int32 group = (int32)hash & groupsMask;
+        int32 probe = 1;
+        uint32 match;
+        while (!(match = FlatHashTable::MatchFree(control + group * FlatHashTable::GroupSize)))
+            group = (group + probe++) & groupsMask;
+        const int32 index = group * FlatHashTable::GroupSize + FlatHashTable::GetFirstBit(match);
+        if (control[index] == FlatHashTable::Deleted)
+            _deletedCount--;
+        control[index] = FlatHashTable::GetHashTag(hash);
+        _elementsCount++;
+        return index;
+    }
+
+    void RemoveAt(int32 index)
+    {
+        Bucket& bucket = _allocation.Get()[index];
+        Memory::DestructItem(&bucket.Item);
+
+        // Slot can become empty only if the group has been never full (no probing sequence goes through it)
+        byte* control = _control.Get();
+        const int32 groupStart = index & ~(FlatHashTable::GroupSize - 1);
+        if (FlatHashTable::MatchEmpty(control + groupStart))
+        {
+            control[index] = FlatHashTable::Empty;
+        }
+        else
+        {
+            control[index] = FlatHashTable::Deleted;
+            _deletedCount++;
+        }
+        _elementsCount--;
+    }
+};
@@ -0,0 +1,112 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/Collections/HashFunctions.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Shared utilities for open-addressing hash tables with control bytes (FlatDictionary, FlatHashSet). Slots are organized in groups of 16 and every slot has a control byte with its state: empty, deleted or full (with 7 bits of the key hash). Lookup probes whole groups at once with SIMD compare of the control bytes.
+/// </summary>
+namespace FlatHashTable
+{
+    /// <summary>
+    /// The amount of slots in a single group (probed at once).
+    /// </summary>
+    constexpr int32 GroupSize = 16;
+
+    /// <summary>
+    /// The control byte of the empty slot.
+    /// </summary>
+    constexpr byte Empty = 0x80;
+
+    /// <summary>
+    /// The control byte of the deleted slot.
+    /// </summary>
+    constexpr byte Deleted = 0xFE;
+
+    /// <summary>
+    /// Gets the maximum amount of the used slots (full or deleted) for a given table capacity (load factor of 7/8).
+    /// </summary>
+    FORCE_INLINE int32 GetMaxLoad(int32 capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    /// <summary>
+    /// Gets the table capacity (power of two, at least a single group) that can contain a given amount of elements.
+    /// </summary>
+    inline int32 GetCapacityFor(int32 count)
+    {
+        int32 capacity = GroupSize;
+        while (GetMaxLoad(capacity) < count)
+            capacity *= 2;
+        return capacity;
+    }
+
+    /// <summary>
+    /// Mixes the key hash to spread entropy, the engine hash functions are often the identity for integers.
+    /// </summary>
+    FORCE_INLINE uint32 MixHash(uint32 hash)
+    {
+        hash *= 0x9E3779B1u;
+        return hash ^ (hash >> 15);
+    }
+
+    /// <summary>
+    /// Gets the 7-bit hash part stored in the control byte of the full slot.
+    /// </summary>
+    FORCE_INLINE byte GetHashTag(uint32 hash)
+    {
+        return (byte)(hash >> 25);
+    }
+
+    /// <summary>
+    /// Gets the index of the lowest set bit (mask must be non-zero).
+    /// </summary>
+    FORCE_INLINE int32 GetFirstBit(uint32 mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (int32)index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    /// <summary>
+    /// Gets the bitmask of slots in the group with full control byte matching the hash tag.
+    /// </summary>
+    FORCE_INLINE uint32 MatchTag(const byte* group, byte tag)
+    {
+        return SIMD::MatchBytes16(group, tag);
+    }
+
+    /// <summary>
+    /// Gets the bitmask of empty slots in the group.
+    /// </summary>
+    FORCE_INLINE uint32 MatchEmpty(const byte* group)
+    {
+        return SIMD::MatchBytes16(group, Empty);
+    }
+
+    /// <summary>
+    /// Gets the bitmask of empty or deleted slots in the group.
+    /// </summary>
+    FORCE_INLINE uint32 MatchFree(const byte* group)
+    {
+        return SIMD::MaskBytes16(group);
+    }
+
+    /// <summary>
+    /// Checks if the control byte represents the full slot.
+    /// </summary>
+    FORCE_INLINE bool IsFull(byte control)
+    {
+        return (control & 0x80) == 0;
+    }
+}
@@ -49,11 +49,9 @@ class RingBuffer
             AllocationData alloc;
             alloc.Allocate(capacity);
             const int32 frontCount = Math::Min(_capacity - _front, _count);
-            Memory::MoveItems(alloc.Get(), _allocation.Get() + _front, frontCount);
-            Memory::DestructItems(_allocation.Get() + _front, frontCount);
+            Memory::RelocateItems(alloc.Get(), _allocation.Get() + _front, frontCount);
             const int32 backCount = _count - frontCount;
-            Memory::MoveItems(alloc.Get() + frontCount, _allocation.Get(), backCount);
-            Memory::DestructItems(_allocation.Get(), backCount);
+            Memory::RelocateItems(alloc.Get() + frontCount, _allocation.Get(), backCount);
             _allocation.Swap(alloc);
             _front = 0;
             _back = _count;
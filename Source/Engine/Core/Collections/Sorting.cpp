@@ -2,7 +2,18 @@
 
 #include "Sorting.h"
 #include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ThreadLocal.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// The minimum amount of elements to sort using multiple threads
+#define SORTING_PARALLEL_MIN_COUNT 32768
+
+// The minimum amount of elements to process by a single job
+#define SORTING_PARALLEL_MIN_JOB_SIZE 8192
 
 // Use a cached storage for the sorting (one per thread to reduce locking)
 ThreadLocal<Sorting::SortingStack> SortingStacks;
@@ -50,3 +61,125 @@ void Sorting::SortingStack::EnsureCapacity(int32 minCapacity)
         num = minCapacity;
     SetCapacity(num);
 }
+
+namespace
+{
+    template<typename T>
+    void RadixSortParallelImpl(T*& inputKeys, int32*& inputValues, T* tmpKeys, int32* tmpValues, int32 count)
+    {
+        enum
+        {
+            RADIXSORT_BITS = 11,
+            RADIXSORT_HISTOGRAM_SIZE = 1 << RADIXSORT_BITS,
+            RADIXSORT_BIT_MASK = RADIXSORT_HISTOGRAM_SIZE - 1,
+            RADIXSORT_PASSES = (sizeof(T) * 8 + RADIXSORT_BITS - 1) / RADIXSORT_BITS,
+        };
+
+        // Only the main thread splits the sort into jobs (on job threads other workers are usually busy with the parallel work that issued the sort)
+        const int32 jobsCount = Math::Min(JobSystem::GetThreadsCount(), count / SORTING_PARALLEL_MIN_JOB_SIZE);
+        if (count < SORTING_PARALLEL_MIN_COUNT || jobsCount < 2 || !IsInMainThread())
+        {
+            Sorting::RadixSort(inputKeys, inputValues, tmpKeys, tmpValues, count);
+            return;
+        }
+        PROFILE_CPU();
+
+        T* keys = inputKeys;
+        T* tempKeys = tmpKeys;
+        int32* values = inputValues;
+        int32* tempValues = tmpValues;
+
+        // Every job processes a continuous range of elements with its own histogram (scatter offsets are ordered by job index to keep sort stable)
+        Array<uint32> histograms;
+        histograms.Resize(jobsCount * RADIXSORT_HISTOGRAM_SIZE);
+        uint32* histogramsData = histograms.Get();
+        bool unsorted[PLATFORM_THREADS_LIMIT];
+        const int32 jobSize = (count + jobsCount - 1) / jobsCount;
+        uint32 shift = 0;
+        Function<void(int32)> histogramJob = [&](int32 jobIndex)
+        {
+            uint32* histogram = histogramsData + jobIndex * RADIXSORT_HISTOGRAM_SIZE;
+            Platform::MemoryClear(histogram, sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE);
+            const int32 start = jobIndex * jobSize;
+            const int32 end = Math::Min(start + jobSize, count);
+            bool sorted = true;
+            T prevKey = keys[start > 0 ? start - 1 : 0];
+            for (int32 i = start; i < end; i++)
+            {
+                const T key = keys[i];
+                ++histogram[(key >> shift) & RADIXSORT_BIT_MASK];
+                sorted &= prevKey <= key;
+                prevKey = key;
+            }
+            unsorted[jobIndex] = !sorted;
+        };
+        Function<void(int32)> scatterJob = [&](int32 jobIndex)
+        {
+            uint32* histogram = histogramsData + jobIndex * RADIXSORT_HISTOGRAM_SIZE;
+            const int32 start = jobIndex * jobSize;
+            const int32 end = Math::Min(start + jobSize, count);
+            for (int32 i = start; i < end; i++)
+            {
+                const T key = keys[i];
+                const uint32 dest = histogram[(key >> shift) & RADIXSORT_BIT_MASK]++;
+                tempKeys[dest] = key;
+                tempValues[dest] = values[i];
+            }
+        };
+        for (int32 pass = 0; pass < RADIXSORT_PASSES; pass++)
+        {
+            shift = pass * RADIXSORT_BITS;
+            JobSystem::Execute(histogramJob, jobsCount);
+
+            bool sorted = true;
+            for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                sorted &= !unsorted[jobIndex];
+            if (sorted)
+                break;
+
+            // Convert histograms into the scatter offsets
+            uint32 offset = 0;
+            bool singleDigit = false;
+            for (int32 i = 0; i < RADIXSORT_HISTOGRAM_SIZE; i++)
+            {
+                const uint32 digitStart = offset;
+                for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                {
+                    uint32& e = histogramsData[jobIndex * RADIXSORT_HISTOGRAM_SIZE + i];
+                    const uint32 cnt = e;
+                    e = offset;
+                    offset += cnt;
+                }
+                singleDigit |= offset - digitStart == (uint32)count;
+            }
+
+            // Skip pass if all keys have the same digit (eg. unused high bits)
+            if (singleDigit)
+                continue;
+
+            JobSystem::Execute(scatterJob, jobsCount);
+
+            T* const swapKeys = tempKeys;
+            tempKeys = keys;
+            keys = swapKeys;
+
+            int32* const swapValues = tempValues;
+            tempValues = values;
+            values = swapValues;
+        }
+
+        // Output the buffers that contain the sorted data (original or temporary)
+        inputKeys = keys;
+        inputValues = values;
+    }
+}
+
+void Sorting::RadixSortParallel(uint32*& inputKeys, int32*& inputValues, uint32* tmpKeys, int32* tmpValues, int32 count)
+{
+    RadixSortParallelImpl(inputKeys, inputValues, tmpKeys, tmpValues, count);
+}
+
+void Sorting::RadixSortParallel(uint64*& inputKeys, int32*& inputValues, uint64* tmpKeys, int32* tmpValues, int32 count)
+{
+    RadixSortParallelImpl(inputKeys, inputValues, tmpKeys, tmpValues, count);
+}
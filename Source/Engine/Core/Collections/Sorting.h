@@ -269,7 +269,8 @@ class FLAXENGINE_API Sorting
         {
             RADIXSORT_BITS = 11,
             RADIXSORT_HISTOGRAM_SIZE = 1 << RADIXSORT_BITS,
-            RADIXSORT_BIT_MASK = RADIXSORT_HISTOGRAM_SIZE - 1
+            RADIXSORT_BIT_MASK = RADIXSORT_HISTOGRAM_SIZE - 1,
+            RADIXSORT_PASSES = (sizeof(T) * 8 + RADIXSORT_BITS - 1) / RADIXSORT_BITS,
         };
         if (count < 2)
             return;
@@ -280,10 +281,9 @@ class FLAXENGINE_API Sorting
         U* tempValues = tmpValues;
 
         uint32 histogram[RADIXSORT_HISTOGRAM_SIZE];
-        uint16 shift = 0;
-        int32 pass = 0;
-        for (; pass < 6; pass++)
+        for (int32 pass = 0; pass < RADIXSORT_PASSES; pass++)
         {
+            const uint32 shift = pass * RADIXSORT_BITS;
             Platform::MemoryClear(histogram, sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE);
 
             bool sorted = true;
@@ -299,9 +299,11 @@ class FLAXENGINE_API Sorting
             }
 
             if (sorted)
-            {
-                goto end;
-            }
+                break;
+
+            // Skip pass if all keys have the same digit (eg. unused high bits)
+            if (histogram[(keys[0] >> shift) & RADIXSORT_BIT_MASK] == (uint32)count)
+                continue;
 
             uint32 offset = 0;
             for (int32 i = 0; i < RADIXSORT_HISTOGRAM_SIZE; ++i)
@@ -327,16 +329,30 @@ class FLAXENGINE_API Sorting
             U* const swapValues = tempValues;
             tempValues = values;
             values = swapValues;
-
-            shift += RADIXSORT_BITS;
         }
 
-    end:
-        if (pass & 1)
-        {
-            // Use temporary keys and values as a result
-            inputKeys = tmpKeys;
-            inputValues = tmpValues;
-        }
+        // Output the buffers that contain the sorted data (original or temporary)
+        inputKeys = keys;
+        inputValues = values;
     }
+
+    /// <summary>
+    /// Sorts the linear data array using Radix Sort algorithm (uses temporary keys collection). Large arrays are sorted with passes split across the Job System threads (when called from the main thread), otherwise the single-threaded sort is used.
+    /// </summary>
+    /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="tmpKeys">The data pointer to the temporary sorting keys array.</param>
+    /// <param name="tmpValues">The data pointer to the temporary values array.</param>
+    /// <param name="count">The elements count.</param>
+    static void RadixSortParallel(uint32*& inputKeys, int32*& inputValues, uint32* tmpKeys, int32* tmpValues, int32 count);
+
+    /// <summary>
+    /// Sorts the linear data array using Radix Sort algorithm (uses temporary keys collection). Large arrays are sorted with passes split across the Job System threads (when called from the main thread), otherwise the single-threaded sort is used.
+    /// </summary>
+    /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="tmpKeys">The data pointer to the temporary sorting keys array.</param>
+    /// <param name="tmpValues">The data pointer to the temporary values array.</param>
+    /// <param name="count">The elements count.</param>
+    static void RadixSortParallel(uint64*& inputKeys, int32*& inputValues, uint64* tmpKeys, int32* tmpValues, int32 count);
 };
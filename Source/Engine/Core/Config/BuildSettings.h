@@ -8,6 +8,49 @@
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Content/SceneReference.h"
 
+/// <summary>
+/// The asset chunks data compression codec used when cooking game content.
+/// </summary>
+/// <remarks>Zstd codec is not available because ThirdParty doesn't contain its sources.</remarks>
+API_ENUM() enum class ChunksCompression
+{
+    /// <summary>
+    /// Chunks data is stored uncompressed. Fastest to load and allows zero-copy access with memory-mapped packages.
+    /// </summary>
+    None,
+
+    /// <summary>
+    /// LZ4 compression. Very fast decompression with a moderate compression ratio.
+    /// </summary>
+    LZ4,
+
+    /// <summary>
+    /// LZ4 high compression mode. Slower cooking and a better compression ratio than LZ4, with the same decompression speed (data uses the LZ4 block format).
+    /// </summary>
+    LZ4HC,
+};
+
+/// <summary>
+/// The asset chunks compression rule for a specific asset type.
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API ChunksCompressionRule : ISerializable
+{
+API_AUTO_SERIALIZATION();
+DECLARE_SCRIPTING_TYPE_MINIMAL(ChunksCompressionRule);
+
+    /// <summary>
+    /// The full name of the asset type (eg. FlaxEngine.Model).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10)")
+    String AssetType;
+
+    /// <summary>
+    /// The compression codec for the asset data chunks.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20)")
+    ChunksCompression Compression = ChunksCompression::LZ4;
+};
+
 /// <summary>
 /// The game building rendering settings.
 /// </summary>
@@ -76,6 +119,24 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(BuildSettings);
     API_FIELD(Attributes="EditorOrder(2010), DefaultValue(false), EditorDisplay(\"Content\")")
     bool ShadersGenerateDebugData = false;
 
+    /// <summary>
+    /// If checked, materials that are not used by any skinned model included in the build (or by the animated models in the cooked scenes and prefabs) won't compile skinned meshes shader permutations. Reduces shaders cache size and cooking time. Such materials fallback to the default material when assigned to the skinned mesh at runtime (eg. from script).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2015), DefaultValue(false), EditorDisplay(\"Content\")")
+    bool StripUnusedMaterialPermutations = false;
+
+    /// <summary>
+    /// The asset chunks compression rules (per asset type). Assets without a rule use the default compression (only json assets are compressed). Can be used to reduce the packages size at cost of the loading performance (eg. for install-once data).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2020), EditorDisplay(\"Content\")")
+    Array<ChunksCompressionRule> ChunksCompressionRules;
+
+    /// <summary>
+    /// The list of assets load order trace files (recorded with -loadordertrace command line option). Assets are placed in packages in the first-use order from the traces to reduce seeking during loading (important on HDD and disc-based platforms). Paths relative to the project directory (or absolute).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2030), EditorDisplay(\"Content\")")
+    Array<String> LoadOrderTraces;
+
 public:
 
     /// <summary>
@@ -95,5 +156,8 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(BuildSettings);
         DESERIALIZE(AdditionalAssetFolders);
         DESERIALIZE(ShadersNoOptimize);
         DESERIALIZE(ShadersGenerateDebugData);
+        DESERIALIZE(StripUnusedMaterialPermutations);
+        DESERIALIZE(ChunksCompressionRules);
+        DESERIALIZE(LoadOrderTraces);
     }
 };
@@ -22,6 +22,7 @@
 #include "Engine/Engine/Globals.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Streaming/StreamingSettings.h"
+#include "Engine/Threading/ThreadingSettings.h"
 #if FLAX_TESTS
 #include "Engine/Platform/FileSystem.h"
 #endif
@@ -32,6 +33,8 @@ class GameSettingsService : public EngineService
     GameSettingsService()
         : EngineService(TEXT("GameSettings"), -70)
     {
+        // Settings are applied to the localization
+        AddDependency(TEXT("Localization"));
     }
 
     bool Init() override
@@ -49,6 +52,7 @@ IMPLEMENT_ENGINE_SETTINGS_GETTER(AudioSettings, Audio);
 IMPLEMENT_ENGINE_SETTINGS_GETTER(PhysicsSettings, Physics);
 IMPLEMENT_ENGINE_SETTINGS_GETTER(InputSettings, Input);
 IMPLEMENT_ENGINE_SETTINGS_GETTER(StreamingSettings, Streaming);
+IMPLEMENT_ENGINE_SETTINGS_GETTER(ThreadingSettings, Threading);
 
 #if !USE_EDITOR
 #if PLATFORM_WINDOWS
@@ -153,6 +157,7 @@ bool GameSettings::Load()
     PRELOAD_SETTINGS(Localization);
     PRELOAD_SETTINGS(GameCooking);
     PRELOAD_SETTINGS(Streaming);
+    PRELOAD_SETTINGS(Threading);
 #undef PRELOAD_SETTINGS
 
     // Apply the game settings to the engine
@@ -181,6 +186,7 @@ void GameSettings::Apply()
     APPLY_SETTINGS(LayersAndTagsSettings);
     APPLY_SETTINGS(PhysicsSettings);
     APPLY_SETTINGS(StreamingSettings);
+    APPLY_SETTINGS(ThreadingSettings);
     APPLY_SETTINGS(InputSettings);
     APPLY_SETTINGS(GraphicsSettings);
     APPLY_SETTINGS(NetworkSettings);
@@ -229,6 +235,7 @@ void GameSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* mo
     DESERIALIZE(Localization);
     DESERIALIZE(GameCooking);
     DESERIALIZE(Streaming);
+    DESERIALIZE(Threading);
 
     // Per-platform settings containers
     DESERIALIZE(WindowsPlatform);
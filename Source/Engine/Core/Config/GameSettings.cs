@@ -105,6 +105,12 @@ partial class GameSettings
         [EditorOrder(1060), EditorDisplay("Other Settings"), AssetReference(typeof(StreamingSettings), true), Tooltip("Reference to Streaming Settings asset")]
         public JsonAsset Streaming;
 
+        /// <summary>
+        /// Reference to <see cref="ThreadingSettings"/> asset.
+        /// </summary>
+        [EditorOrder(1070), EditorDisplay("Other Settings"), AssetReference(typeof(ThreadingSettings), true), Tooltip("Reference to Threading Settings asset")]
+        public JsonAsset Threading;
+
         /// <summary>
         /// The custom settings to use with a game. Can be specified by the user to define game-specific options and be used by the external plugins (used as key-value pair).
         /// </summary>
@@ -278,6 +284,8 @@ private static SettingsBase Load(JsonAsset asset, string typename)
                 return Load<BuildSettings>(gameSettings.GameCooking) as T;
             if (type == typeof(StreamingSettings))
                 return Load<StreamingSettings>(gameSettings.Streaming) as T;
+            if (type == typeof(ThreadingSettings))
+                return Load<ThreadingSettings>(gameSettings.Threading) as T;
             if (type == typeof(InputSettings))
                 return Load<InputSettings>(gameSettings.Input) as T;
             if (type == typeof(AudioSettings))
@@ -372,6 +380,8 @@ public static JsonAsset LoadAsset(Type type)
                 return gameSettings.GameCooking;
             if (type == typeof(StreamingSettings))
                 return gameSettings.Streaming;
+            if (type == typeof(ThreadingSettings))
+                return gameSettings.Threading;
             if (type == typeof(InputSettings))
                 return gameSettings.Input;
             if (type == typeof(AudioSettings))
@@ -504,6 +514,8 @@ public static JsonAsset LoadAsset(Type type)
                 return SaveAsset(gameSettings, ref gameSettings.GameCooking, obj);
             if (type == typeof(StreamingSettings))
                 return SaveAsset(gameSettings, ref gameSettings.Streaming, obj);
+            if (type == typeof(ThreadingSettings))
+                return SaveAsset(gameSettings, ref gameSettings.Threading, obj);
             if (type == typeof(InputSettings))
                 return SaveAsset(gameSettings, ref gameSettings.Input, obj);
             if (type == typeof(WindowsPlatformSettings))
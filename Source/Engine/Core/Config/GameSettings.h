@@ -72,6 +72,7 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(GameSettings);
     Guid Localization;
     Guid GameCooking;
     Guid Streaming;
+    Guid Threading;
 
     // Per-platform settings containers
     Guid WindowsPlatform;
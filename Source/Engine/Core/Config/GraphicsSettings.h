@@ -20,6 +20,54 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(20), DefaultValue(false), EditorDisplay(\"General\", \"Use V-Sync\")")
     bool UseVSync = false;
 
+    /// <summary>
+    /// If checked, enables the occlusion culling of the objects hidden behind the other geometry. Uses the depth buffer of the previous frames read back to the CPU (objects might appear with a few frames delay on fast camera movement).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), DefaultValue(false), EditorDisplay(\"General\")")
+    bool EnableOcclusionCulling = false;
+
+    /// <summary>
+    /// If checked, enables the clustered lighting for the local lights (point and spot lights). Lights are culled on the GPU into the view frustum clusters and resolved in a single pass (lights with shadows or IES profiles are still rendered separately). Requires compute shaders support.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), DefaultValue(true), EditorDisplay(\"General\")")
+    bool EnableClusteredLighting = true;
+
+    /// <summary>
+    /// If checked, enables scheduling the Global SDF updates on the asynchronous compute queue (if supported by the graphics device) so they can overlap with the GBuffer and shadows rendering. Materials sampling Global SDF during GBuffer pass won't see it in that case.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(50), DefaultValue(false), EditorDisplay(\"General\")")
+    bool EnableAsyncCompute = false;
+
+    /// <summary>
+    /// If checked, enables executing the textures and meshes streaming uploads on the dedicated copy queue (if supported by the graphics device) so they can overlap with the frame rendering.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(55), DefaultValue(true), EditorDisplay(\"General\")")
+    bool EnableAsyncUploads = true;
+
+    /// <summary>
+    /// If checked, enables drawing the frame on a dedicated render thread while the main thread simulates the next frame. The scene rendering state (actors bounds and cameras) is extracted after the late update so the simulation doesn't affect the frame being drawn. Gameplay code that modifies the objects used by the rendering from other threads or draws from the Update event might need to be adjusted.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(56), DefaultValue(false), EditorDisplay(\"General\")")
+    bool EnablePipelinedRendering = false;
+
+    /// <summary>
+    /// If checked, enables sharing the memory between the temporary render targets that are not used at the same time within a frame (eg. post-processing targets). Reduces the GPU memory usage. Requires a graphics device with the resources aliasing support.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(60), DefaultValue(false), EditorDisplay(\"General\", \"Enable Render Targets Aliasing\")")
+    bool EnableRenderTargetsAliasing = false;
+
+    /// <summary>
+    /// If checked, enables the variable rate shading that reduces the pixel shading rate in the screen regions with low contrast or fast motion (based on the previous frame). Reduces the GBuffer and forward passes cost. Requires a graphics device with the shading rate image support (eg. D3D12 Tier 2).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(70), DefaultValue(false), EditorDisplay(\"General\", \"Enable Variable Rate Shading\")")
+    bool EnableVariableRateShading = false;
+
+    /// <summary>
+    /// If checked, enables the skinning cache that skins the animated meshes once per frame with compute shaders and reuses the skinned vertices in all passes (eg. GBuffer and every shadow map cascade). Reduces the vertex processing cost of the characters in scenes with many shadow casting lights. Requires a graphics device with the compute shaders support.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(80), DefaultValue(false), EditorDisplay(\"General\", \"Enable Skinning Cache\")")
+    bool EnableSkinningCache = false;
+
     /// <summary>
     /// Anti Aliasing quality setting.
     /// </summary>
@@ -56,12 +104,36 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(1310), DefaultValue(Quality.Medium), EditorDisplay(\"Quality\")")
     Quality ShadowMapsQuality = Quality::Medium;
 
+    /// <summary>
+    /// The model LOD bias applied to the shadow maps rendering (added to the main view LOD bias). Higher values use lower-quality LODs for shadow casters to reduce shadow pass cost.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1315), DefaultValue(0), Limit(0, 4), EditorDisplay(\"Quality\", \"Shadows Model LOD Bias\")")
+    int32 ShadowsModelLODBias = 0;
+
     /// <summary>
     /// Enables cascades splits blending for directional light shadows.
     /// </summary>
     API_FIELD(Attributes="EditorOrder(1320), DefaultValue(false), EditorDisplay(\"Quality\", \"Allow CSM Blending\")")
     bool AllowCSMBlending = false;
 
+    /// <summary>
+    /// The Bloom quality. Controls the amount of the downsampled mip levels used by the compute shaders bloom (lower quality gives smaller bloom radius).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1400), DefaultValue(Quality.High), EditorDisplay(\"Quality\")")
+    Quality BloomQuality = Quality::High;
+
+    /// <summary>
+    /// The Depth Of Field quality. Low renders the effect in quarter resolution, Medium in half resolution and High or Ultra in full resolution.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1410), DefaultValue(Quality.High), EditorDisplay(\"Quality\")")
+    Quality DepthOfFieldQuality = Quality::High;
+
+    /// <summary>
+    /// The distortion (refraction) quality. Low and Medium render the distortion vectors in half resolution, High or Ultra in full resolution.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1420), DefaultValue(Quality.High), EditorDisplay(\"Quality\")")
+    Quality DistortionQuality = Quality::High;
+
     /// <summary>
     /// Default probes cubemap resolution (use for Environment Probes, can be overriden per-actor).
     /// </summary>
@@ -86,6 +158,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(2005), DefaultValue(Quality.High), EditorDisplay(\"Global SDF\")")
     Quality GlobalSDFQuality = Quality::High;
 
+    /// <summary>
+    /// If checked, Global SDF uses 8-bit storage instead of 16-bit float. Halves the memory usage and sampling bandwidth at the cost of lower distance precision (visible in Global SDF debug view and GI quality).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2006), DefaultValue(false), EditorDisplay(\"Global SDF\", \"Global SDF Compact Storage\")")
+    bool GlobalSDFCompactStorage = false;
+
 #if USE_EDITOR
     /// <summary>
     /// If checked, the 'Generate SDF' option will be checked on model import options by default. Use it if your project uses Global SDF (eg. for Global Illumination or particles).
@@ -106,6 +184,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(2120), Limit(50, 1000), EditorDisplay(\"Global Illumination\")")
     float GIProbesSpacing = 100;
 
+    /// <summary>
+    /// The maximum amount of the Global Illumination probes to update (trace rays and blend) per frame. Active probes nearby changed geometry are updated first, probes with no nearby changes are put to sleep and refreshed less often. Use 0 to update all active probes.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2125), Limit(0, 100000), EditorDisplay(\"Global Illumination\", \"GI Probes Update Budget\")")
+    int32 GIProbesUpdateBudget = 0;
+
     /// <summary>
     /// The Global Surface Atlas resolution. Adjust it if atlas `flickers` due to overflow (eg. to 4096).
     /// </summary>
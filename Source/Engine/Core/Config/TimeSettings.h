@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Engine/Core/Config/Settings.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Level/Scene/TickGroup.h"
 
 /// <summary>
 /// Time and game simulation settings container.
@@ -42,6 +44,12 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(TimeSettings);
     API_FIELD(Attributes="EditorOrder(20), Limit(0.1f, 1000.0f, 0.01f), EditorDisplay(\"General\")")
     float MaxUpdateDeltaTime = 0.1f;
 
+    /// <summary>
+    /// The groups of scripts updated at the custom rate with time-slicing across frames (see Script.TickGroup).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(100), EditorDisplay(\"Tick Groups\", EditorDisplayAttribute.InlineStyle)")
+    Array<TickGroup> TickGroups;
+
 public:
 
     /// <summary>
@@ -8,12 +8,13 @@
 #include "Engine/Engine/Globals.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ConditionVariable.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Threading/IRunnable.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Debug/Exceptions/Exceptions.h"
-#if USE_EDITOR
-#include "Engine/Core/Collections/Array.h"
-#endif
 #include <iostream>
 
 #define LOG_ENABLE_FILE (!PLATFORM_SWITCH)
@@ -25,6 +26,98 @@ namespace
     FileWriteStream* LogFile = nullptr;
     CriticalSection LogLocker;
     DateTime LogStartTime;
+
+    // Async mode: messages are appended to the front buffer (short lock without I/O) and written by the background thread
+    Thread* LogWriter = nullptr;
+    volatile int64 LogWriterExit = 0;
+    CriticalSection LogBufferLocker;
+    ConditionVariable LogBufferSignal;
+    Array<byte> LogBuffer, LogWriteBuffer;
+}
+
+class LogWriterRunnable : public IRunnable
+{
+public:
+    // [IRunnable]
+    String ToString() const override
+    {
+        return TEXT("LogWriter");
+    }
+
+    int32 Run() override;
+};
+
+namespace
+{
+    LogWriterRunnable LogWriterRunnableInstance;
+
+    // Writes the message to the outputs, called within LogLocker
+    void WriteLogMessage(const Char* ptr, int32 length)
+    {
+        // Send message to standard process output
+        if (CommandLine::Options.Std)
+        {
+#if PLATFORM_TEXT_IS_CHAR16
+            StringAnsi ansi(StringView(ptr, length));
+            ansi += PLATFORM_LINE_TERMINATOR;
+            printf("%s", ansi.Get());
+#else
+            std::wcout.write(ptr, length);
+            std::wcout.write(TEXT(PLATFORM_LINE_TERMINATOR), ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1);
+#endif
+        }
+
+        // Send message to platform logging
+        Platform::Log(StringView(ptr, length));
+
+        // Write message to log file
+        if (LogAfterInit)
+        {
+            LogFile->WriteBytes(ptr, length * sizeof(Char));
+            LogFile->WriteBytes(TEXT(PLATFORM_LINE_TERMINATOR), (ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1) * sizeof(Char));
+        }
+    }
+
+    // Writes all the messages queued by the async mode, called within LogLocker
+    void DrainLogBuffer()
+    {
+        LogBufferLocker.Lock();
+        LogBuffer.Swap(LogWriteBuffer);
+        LogBufferLocker.Unlock();
+        if (LogWriteBuffer.IsEmpty())
+            return;
+        IsDuringLog = true;
+        const byte* ptr = LogWriteBuffer.Get();
+        const byte* end = ptr + LogWriteBuffer.Count();
+        while (ptr < end)
+        {
+            int32 length;
+            Platform::MemoryCopy(&length, ptr, sizeof(int32));
+            ptr += sizeof(int32);
+            WriteLogMessage((const Char*)ptr, length);
+            ptr += length * sizeof(Char);
+        }
+        if (LogAfterInit)
+            LogFile->Flush();
+        LogWriteBuffer.Clear();
+        IsDuringLog = false;
+    }
+}
+
+int32 LogWriterRunnable::Run()
+{
+    while (Platform::AtomicRead(&LogWriterExit) == 0)
+    {
+        LogBufferLocker.Lock();
+        if (LogBuffer.IsEmpty() && Platform::AtomicRead(&LogWriterExit) == 0)
+            LogBufferSignal.Wait(LogBufferLocker, 100);
+        LogBufferLocker.Unlock();
+
+        LogLocker.Lock();
+        DrainLogBuffer();
+        LogLocker.Unlock();
+    }
+    return 0;
 }
 
 String Log::Logger::LogFilePath;
@@ -100,49 +193,86 @@ bool Log::Logger::Init()
 #endif
     WriteFloor();
 
+    SetAsync(CommandLine::Options.LogAsync.IsTrue());
+
     return false;
 }
 
+void Log::Logger::SetAsync(bool enable)
+{
+    if (enable == (LogWriter != nullptr))
+        return;
+    if (enable)
+    {
+        Platform::AtomicStore(&LogWriterExit, 0);
+        LogWriter = Thread::Create(&LogWriterRunnableInstance, TEXT("Log Writer"), ThreadPriority::BelowNormal);
+    }
+    else
+    {
+        // Stop the writer thread (it writes all remaining messages before exit)
+        Platform::AtomicStore(&LogWriterExit, 1);
+        LogBufferSignal.NotifyAll();
+        LogWriter->Join();
+        Delete(LogWriter);
+        LogWriter = nullptr;
+        LogLocker.Lock();
+        DrainLogBuffer();
+        LogLocker.Unlock();
+    }
+}
+
+bool Log::Logger::IsAsync()
+{
+    return LogWriter != nullptr;
+}
+
 void Log::Logger::Write(const StringView& msg)
+{
+    Write(msg, false);
+}
+
+void Log::Logger::Write(const StringView& msg, bool immediate)
 {
     const auto ptr = msg.Get();
     const auto length = msg.Length();
     if (length <= 0)
         return;
 
-    LogLocker.Lock();
-    if (IsDuringLog)
+    if (LogWriter && !immediate)
     {
-        LogLocker.Unlock();
+        // Queue message for the writer thread
+        const int32 size = length * sizeof(Char);
+        LogBufferLocker.Lock();
+        const bool wasEmpty = LogBuffer.IsEmpty();
+        const int32 start = LogBuffer.Count();
+        LogBuffer.AddUninitialized(sizeof(int32) + size);
+        Platform::MemoryCopy(LogBuffer.Get() + start, &length, sizeof(int32));
+        Platform::MemoryCopy(LogBuffer.Get() + start + sizeof(int32), ptr, size);
+        LogBufferLocker.Unlock();
+        if (wasEmpty)
+            LogBufferSignal.NotifyOne();
         return;
     }
-    IsDuringLog = true;
 
-    // Send message to standard process output
-    if (CommandLine::Options.Std)
+    LogLocker.Lock();
+    if (IsDuringLog)
     {
-#if PLATFORM_TEXT_IS_CHAR16
-        StringAnsi ansi(msg);
-        ansi += PLATFORM_LINE_TERMINATOR;
-        printf("%s", ansi.Get());
-#else
-        std::wcout.write(ptr, length);
-        std::wcout.write(TEXT(PLATFORM_LINE_TERMINATOR), ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1);
-#endif
+        LogLocker.Unlock();
+        return;
     }
 
-    // Send message to platform logging
-    Platform::Log(msg);
+    // Write queued messages first to keep the order
+    DrainLogBuffer();
+    IsDuringLog = true;
 
-    // Write message to log file
-    if (LogAfterInit)
-    {
-        LogFile->WriteBytes(ptr, length * sizeof(Char));
-        LogFile->WriteBytes(TEXT(PLATFORM_LINE_TERMINATOR), (ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1) * sizeof(Char));
+    WriteLogMessage(ptr, length);
 #if LOG_ENABLE_AUTO_FLUSH
+    if (LogAfterInit)
+        LogFile->Flush();
+#else
+    if (LogAfterInit && immediate)
         LogFile->Flush();
 #endif
-    }
 
     IsDuringLog = false;
     LogLocker.Unlock();
@@ -155,6 +285,7 @@ void Log::Logger::Write(const Exception& exception)
 
 void Log::Logger::Dispose()
 {
+    SetAsync(false);
     LogLocker.Lock();
 
     // Write ending info
@@ -186,6 +317,7 @@ bool Log::Logger::IsLogEnabled()
 void Log::Logger::Flush()
 {
     LogLocker.Lock();
+    DrainLogBuffer();
     if (LogFile)
         LogFile->Flush();
     LogLocker.Unlock();
@@ -240,8 +372,8 @@ void Log::Logger::Write(LogType type, const StringView& msg)
     fmt_flax::memory_buffer w;
     ProcessLogMessage(type, msg, w);
 
-    // Log formatted message
-    Write(StringView(w.data(), (int32)w.size()));
+    // Log formatted message (errors are written and flushed immediately to not be lost on crash)
+    Write(StringView(w.data(), (int32)w.size()), isError);
 
     // Fire events
     OnMessage(type, msg);
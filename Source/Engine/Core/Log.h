@@ -115,6 +115,18 @@ namespace Log
         /// </summary>
         static void Flush();
 
+        /// <summary>
+        /// Enables or disables the async logging mode. When enabled, messages are queued and written to the outputs by the background thread so logging doesn't block the caller on I/O. Errors are still written and flushed immediately.
+        /// </summary>
+        /// <param name="enable">True if enable async mode, otherwise false.</param>
+        static void SetAsync(bool enable);
+
+        /// <summary>
+        /// Determines whether async logging mode is enabled.
+        /// </summary>
+        /// <returns><c>true</c> if log is written by the background thread; otherwise, <c>false</c>.</returns>
+        static bool IsAsync();
+
         /// <summary>
         /// Writes a series of '=' chars to the log to end a section.
         /// </summary>
@@ -174,6 +186,13 @@ namespace Log
         /// <param name="msg">The message text.</param>
         static void Write(const StringView& msg);
 
+        /// <summary>
+        /// Writes a custom message to the log.
+        /// </summary>
+        /// <param name="msg">The message text.</param>
+        /// <param name="immediate">True if write message and flush the log file immediately (skips the async mode queue).</param>
+        static void Write(const StringView& msg, bool immediate);
+
         /// <summary>
         /// Writes an exception formatted message to log file.
         /// </summary>
@@ -4,6 +4,7 @@
 #include "BoundingBox.h"
 #include "BoundingSphere.h"
 #include "../Types/String.h"
+#include "../SIMD.h"
 
 String BoundingFrustum::ToString() const
 {
@@ -189,3 +190,59 @@ bool BoundingFrustum::Intersects(const BoundingSphere& sphere) const
     }
     return true;
 }
+
+void BoundingFrustum::IntersectsSpheres(const float* x, const float* y, const float* z, const float* radius, int32 count, byte* outMask, const Vector3& origin) const
+{
+    // Bake origin into the planes distance: dot(n, c - o) + d = dot(n, c) + (d - dot(n, o))
+    float planes[6][4];
+    SimdVector4 nx[6], ny[6], nz[6], nd[6];
+    for (int32 i = 0; i < 6; i++)
+    {
+        const Plane& plane = _planes[i];
+        planes[i][0] = (float)plane.Normal.X;
+        planes[i][1] = (float)plane.Normal.Y;
+        planes[i][2] = (float)plane.Normal.Z;
+        planes[i][3] = (float)(plane.D - Vector3::Dot(plane.Normal, origin));
+        nx[i] = SIMD::Splat(planes[i][0]);
+        ny[i] = SIMD::Splat(planes[i][1]);
+        nz[i] = SIMD::Splat(planes[i][2]);
+        nd[i] = SIMD::Splat(planes[i][3]);
+    }
+
+    // Test 4 spheres at once against all planes
+    const SimdVector4 zero = SIMD::Splat(0.0f);
+    int32 index = 0;
+    for (; index + 4 <= count; index += 4)
+    {
+        const SimdVector4 cx = SIMD::LoadUnaligned(x + index);
+        const SimdVector4 cy = SIMD::LoadUnaligned(y + index);
+        const SimdVector4 cz = SIMD::LoadUnaligned(z + index);
+        const SimdVector4 r = SIMD::LoadUnaligned(radius + index);
+        int32 outside = 0;
+        for (int32 i = 0; i < 6; i++)
+        {
+            const SimdVector4 distance = SIMD::Add(SIMD::Add(SIMD::Mul(nx[i], cx), SIMD::Mul(ny[i], cy)), SIMD::Add(SIMD::Mul(nz[i], cz), nd[i]));
+            outside |= SIMD::MoveMask(SIMD::Less(SIMD::Add(distance, r), zero));
+        }
+        outMask[index + 0] = (outside & 1) == 0;
+        outMask[index + 1] = (outside & 2) == 0;
+        outMask[index + 2] = (outside & 4) == 0;
+        outMask[index + 3] = (outside & 8) == 0;
+    }
+
+    // Remaining spheres
+    for (; index < count; index++)
+    {
+        byte result = 1;
+        for (int32 i = 0; i < 6; i++)
+        {
+            const float distance = planes[i][0] * x[index] + planes[i][1] * y[index] + planes[i][2] * z[index] + planes[i][3];
+            if (distance + radius[index] < 0.0f)
+            {
+                result = 0;
+                break;
+            }
+        }
+        outMask[index] = result;
+    }
+}
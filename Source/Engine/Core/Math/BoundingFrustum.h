@@ -237,6 +237,18 @@ API_STRUCT(InBuild) struct FLAXENGINE_API BoundingFrustum
     /// <returns>True if the current BoundingFrustum intersects a BoundingSphere, otherwise false.</returns>
     bool Intersects(const BoundingSphere& sphere) const;
 
+    /// <summary>
+    /// Checks whether the current BoundingFrustum intersects a batch of spheres stored in the structure-of-arrays layout (tests 4 spheres at once with SIMD).
+    /// </summary>
+    /// <param name="x">The spheres centers X components.</param>
+    /// <param name="y">The spheres centers Y components.</param>
+    /// <param name="z">The spheres centers Z components.</param>
+    /// <param name="radius">The spheres radii.</param>
+    /// <param name="count">The amount of spheres to test.</param>
+    /// <param name="outMask">The output results (1 if the sphere intersects the frustum, otherwise 0). Must have space for count items.</param>
+    /// <param name="origin">The world origin subtracted from the spheres centers before the test (eg. view origin when using large worlds).</param>
+    void IntersectsSpheres(const float* x, const float* y, const float* z, const float* radius, int32 count, byte* outMask, const Vector3& origin = Vector3::Zero) const;
+
     /// <summary>
     /// Checks whether the current BoundingFrustum intersects a BoundingBox.
     /// </summary>
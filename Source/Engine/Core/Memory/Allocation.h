@@ -148,8 +148,8 @@ class HeapAllocation
             if (oldCount)
             {
                 if (newCount > 0)
-                    Memory::MoveItems(newData, _data, newCount);
-                Memory::DestructItems(_data, oldCount);
+                    Memory::RelocateItems(newData, _data, newCount);
+                Memory::DestructItems(_data + newCount, oldCount - newCount);
             }
 
             Allocator::Free(_data);
@@ -169,6 +169,93 @@ class HeapAllocation
     };
 };
 
+/// <summary>
+/// The memory allocation policy that uses large (huge) memory pages (falls back to the regular pages if not available). Use only for big, long-lived and frequently accessed collections of the fixed capacity as every allocation is rounded up to the page size.
+/// </summary>
+class LargePageAllocation
+{
+public:
+    template<typename T>
+    class Data
+    {
+    private:
+        T* _data = nullptr;
+
+    public:
+        FORCE_INLINE Data()
+        {
+        }
+
+        FORCE_INLINE ~Data()
+        {
+            if (_data)
+                Platform::FreeLargePages(_data);
+        }
+
+        FORCE_INLINE T* Get()
+        {
+            return _data;
+        }
+
+        FORCE_INLINE const T* Get() const
+        {
+            return _data;
+        }
+
+        FORCE_INLINE int32 CalculateCapacityGrow(int32 capacity, int32 minCapacity) const
+        {
+            // Grow by doubling (each allocation uses whole pages anyway)
+            if (capacity < minCapacity)
+                capacity = minCapacity;
+            return capacity * 2;
+        }
+
+        FORCE_INLINE void Allocate(uint64 capacity)
+        {
+#if  ENABLE_ASSERTION_LOW_LAYERS
+            ASSERT(!_data);
+#endif
+            _data = (T*)Platform::AllocateLargePages(capacity * sizeof(T));
+#if !BUILD_RELEASE
+            if (!_data)
+                OUT_OF_MEMORY;
+#endif
+        }
+
+        FORCE_INLINE void Relocate(uint64 capacity, int32 oldCount, int32 newCount)
+        {
+            T* newData = capacity != 0 ? (T*)Platform::AllocateLargePages(capacity * sizeof(T)) : nullptr;
+#if !BUILD_RELEASE
+            if (!newData && capacity != 0)
+                OUT_OF_MEMORY;
+#endif
+
+            if (oldCount)
+            {
+                if (newCount > 0)
+                    Memory::RelocateItems(newData, _data, newCount);
+                Memory::DestructItems(_data + newCount, oldCount - newCount);
+            }
+
+            if (_data)
+                Platform::FreeLargePages(_data);
+            _data = newData;
+        }
+
+        FORCE_INLINE void Free()
+        {
+            if (_data)
+                Platform::FreeLargePages(_data);
+            _data = nullptr;
+        }
+
+        FORCE_INLINE void Swap(Data& other)
+        {
+            ::Swap(_data, other._data);
+        }
+    };
+};
+
 /// <summary>
 /// The memory allocation policy that uses inlined memory of the fixed size and supports using additional allocation to increase its capacity (eg. via heap allocation).
 /// </summary>
@@ -227,10 +314,10 @@ class InlinedAllocation
                 if (_useOther)
                 {
                     // Move the items from other allocation to the inlined storage
-                    Memory::MoveItems((T*)_data, _other.Get(), newCount);
+                    Memory::RelocateItems((T*)_data, _other.Get(), newCount);
 
                     // Free the other allocation
-                    Memory::DestructItems(_other.Get(), oldCount);
+                    Memory::DestructItems(_other.Get() + newCount, oldCount - newCount);
                     _other.Free();
                     _useOther = false;
                 }
@@ -249,8 +336,8 @@ class InlinedAllocation
                     _useOther = true;
 
                     // Move the items from the inlined storage to the other allocation
-                    Memory::MoveItems(_other.Get(), (T*)_data, newCount);
-                    Memory::DestructItems((T*)_data, oldCount);
+                    Memory::RelocateItems(_other.Get(), (T*)_data, newCount);
+                    Memory::DestructItems((T*)_data + newCount, oldCount - newCount);
                 }
             }
         }
@@ -6,8 +6,19 @@
 #include "Engine/Platform/Platform.h"
 #include <new>
 
+#if USE_THREAD_CACHE_ALLOCATOR
+#include "ThreadCacheAllocator.h"
+typedef ThreadCacheAllocator BaseAllocator;
+#else
 #include "CrtAllocator.h"
-typedef CrtAllocator Allocator;
+typedef CrtAllocator BaseAllocator;
+#endif
+#if COMPILE_WITH_MEMORY_TRACKING
+#include "TrackedAllocator.h"
+typedef TrackedAllocator Allocator;
+#else
+typedef BaseAllocator Allocator;
+#endif
 
 namespace AllocatorExt
 {
@@ -259,6 +270,48 @@ namespace Memory
     {
         Platform::MemoryCopy(dst, src, count * sizeof(U));
     }
+
+    /// <summary>
+    /// Relocates the range of items in the memory (moves them into a new location and destructs the source items). Memory ranges can overlap.
+    /// </summary>
+    /// <remarks>The optimized version (for trivially relocatable types) uses low-level memory move.</remarks>
+    /// <param name="dst">The address of the first memory location to relocate to (uninitialized or overlapping with source).</param>
+    /// <param name="src">The address of the first memory location to relocate from.</param>
+    /// <param name="count">The number of element to relocate. Can be equal 0.</param>
+    template<typename T>
+    FORCE_INLINE typename TEnableIf<!TIsTriviallyRelocatable<T>::Value>::Type RelocateItems(T* dst, T* src, int32 count)
+    {
+        if (dst <= src)
+        {
+            for (int32 i = 0; i < count; i++)
+            {
+                new(dst + i) T(MoveTemp(src[i]));
+                src[i].~T();
+            }
+        }
+        else
+        {
+            for (int32 i = count - 1; i >= 0; i--)
+            {
+                new(dst + i) T(MoveTemp(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Relocates the range of items in the memory (moves them into a new location and destructs the source items). Memory ranges can overlap.
+    /// </summary>
+    /// <remarks>The optimized version (for trivially relocatable types) uses low-level memory move.</remarks>
+    /// <param name="dst">The address of the first memory location to relocate to (uninitialized or overlapping with source).</param>
+    /// <param name="src">The address of the first memory location to relocate from.</param>
+    /// <param name="count">The number of element to relocate. Can be equal 0.</param>
+    template<typename T>
+    FORCE_INLINE typename TEnableIf<TIsTriviallyRelocatable<T>::Value>::Type RelocateItems(T* dst, T* src, int32 count)
+    {
+        if (count > 0)
+            Platform::MemoryMove(dst, src, count * sizeof(T));
+    }
 }
 
 /// <summary>
@@ -0,0 +1,217 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "ThreadCacheAllocator.h"
+#include "Engine/Platform/Platform.h"
+
+// Amount of the small allocation size classes (16-byte steps up to 128 bytes, then 4 steps per power of two)
+#define THREAD_CACHE_CLASSES 40
+// The maximum size of the small block (including its header)
+#define THREAD_CACHE_SMALL_MAX (32 * 1024)
+// The size of the memory span allocated from the system to carve small blocks
+#define THREAD_CACHE_SPAN_SIZE (256 * 1024)
+// The approximate amount of memory the thread can keep cached per size class
+#define THREAD_CACHE_CLASS_BYTES (128 * 1024)
+// Size class marker used by large allocations
+#define THREAD_CACHE_LARGE MAX_uint32
+
+namespace ThreadCacheAllocatorImpl
+{
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    // Header placed before every allocated memory block
+    struct alignas(16) BlockHeader
+    {
+        uint32 SizeClass;
+        uint32 Offset;
+    };
+
+    static_assert(sizeof(BlockHeader) == 16, "Invalid allocator block header size.");
+
+    // Global free lists are guarded by spin-locks because allocator can be used during static initialization
+    struct CentralList
+    {
+        volatile int64 Lock;
+        FreeBlock* Head;
+        int32 Count;
+    };
+
+    CentralList Central[THREAD_CACHE_CLASSES];
+    volatile int64 ReservedMemory = 0;
+    THREADLOCAL FreeBlock* CacheLists[THREAD_CACHE_CLASSES];
+    THREADLOCAL int32 CacheCounts[THREAD_CACHE_CLASSES];
+
+    FORCE_INLINE uint32 GetSizeClass(uint64 size)
+    {
+        if (size <= 128)
+            return (uint32)((size + 15) >> 4) - 1;
+        uint32 log2 = 7;
+        while ((size - 1) >> (log2 + 1))
+            log2++;
+        return 8 + (log2 - 7) * 4 + (uint32)((size - 1 - (1ull << log2)) >> (log2 - 2));
+    }
+
+    FORCE_INLINE uint32 GetClassSize(uint32 sizeClass)
+    {
+        if (sizeClass < 8)
+            return (sizeClass + 1) << 4;
+        const uint32 log2 = 7 + (sizeClass - 8) / 4;
+        return (1u << log2) + ((sizeClass - 8) % 4 + 1) * (1u << (log2 - 2));
+    }
+
+    FORCE_INLINE int32 GetCacheLimit(uint32 sizeClass)
+    {
+        const int32 limit = THREAD_CACHE_CLASS_BYTES / GetClassSize(sizeClass);
+        return limit > 8 ? limit : 8;
+    }
+
+    FORCE_INLINE void LockCentral(CentralList& list)
+    {
+        while (Platform::InterlockedCompareExchange(&list.Lock, 1, 0) != 0)
+            Platform::Sleep(0);
+    }
+
+    FORCE_INLINE void UnlockCentral(CentralList& list)
+    {
+        Platform::AtomicStore(&list.Lock, 0);
+    }
+
+    void Refill(uint32 sizeClass)
+    {
+        // Take a batch of blocks from the global list
+        CentralList& central = Central[sizeClass];
+        const int32 batch = GetCacheLimit(sizeClass) / 2;
+        FreeBlock* head = nullptr;
+        int32 count = 0;
+        LockCentral(central);
+        if (central.Head)
+        {
+            head = central.Head;
+            FreeBlock* tail = head;
+            count = 1;
+            while (count < batch && tail->Next)
+            {
+                tail = tail->Next;
+                count++;
+            }
+            central.Head = tail->Next;
+            central.Count -= count;
+            tail->Next = nullptr;
+        }
+        UnlockCentral(central);
+
+        if (!head)
+        {
+            // Carve a new span into blocks
+            const uint32 blockSize = GetClassSize(sizeClass);
+            byte* span = (byte*)Platform::Allocate(THREAD_CACHE_SPAN_SIZE, 16);
+            if (!span)
+                return;
+            Platform::InterlockedAdd(&ReservedMemory, THREAD_CACHE_SPAN_SIZE);
+            count = THREAD_CACHE_SPAN_SIZE / blockSize;
+            for (int32 i = count - 1; i >= 0; i--)
+            {
+                FreeBlock* block = (FreeBlock*)(span + i * blockSize);
+                block->Next = head;
+                head = block;
+            }
+        }
+
+        CacheLists[sizeClass] = head;
+        CacheCounts[sizeClass] = count;
+    }
+
+    void Flush(uint32 sizeClass, int32 count)
+    {
+        // Move the blocks from the thread cache back to the global list
+        FreeBlock* head = CacheLists[sizeClass];
+        FreeBlock* tail = head;
+        for (int32 i = 1; i < count; i++)
+            tail = tail->Next;
+        CacheLists[sizeClass] = tail->Next;
+        CacheCounts[sizeClass] -= count;
+        CentralList& central = Central[sizeClass];
+        LockCentral(central);
+        tail->Next = central.Head;
+        central.Head = head;
+        central.Count += count;
+        UnlockCentral(central);
+    }
+}
+
+using namespace ThreadCacheAllocatorImpl;
+
+void* ThreadCacheAllocator::Allocate(uint64 size, uint64 alignment)
+{
+    // Alignment always has to be power of two
+    ASSERT_LOW_LAYER((alignment & (alignment - 1)) == 0);
+    if (size == 0)
+        return nullptr;
+
+    BlockHeader* header;
+    const uint64 sizeWithHeader = size + sizeof(BlockHeader);
+    if (sizeWithHeader <= THREAD_CACHE_SMALL_MAX && alignment <= 16)
+    {
+        const uint32 sizeClass = GetSizeClass(sizeWithHeader);
+        FreeBlock* block = CacheLists[sizeClass];
+        if (!block)
+        {
+            Refill(sizeClass);
+            block = CacheLists[sizeClass];
+            if (!block)
+                return nullptr;
+        }
+        CacheLists[sizeClass] = block->Next;
+        CacheCounts[sizeClass]--;
+        header = (BlockHeader*)block;
+        header->SizeClass = sizeClass;
+        header->Offset = 0;
+    }
+    else
+    {
+        // Large allocation with the header placed right before the aligned pointer
+        const uint64 offset = alignment > sizeof(BlockHeader) ? alignment : sizeof(BlockHeader);
+        byte* ptr = (byte*)Platform::Allocate(size + offset, offset);
+        if (!ptr)
+            return nullptr;
+        header = (BlockHeader*)(ptr + offset) - 1;
+        header->SizeClass = THREAD_CACHE_LARGE;
+        header->Offset = (uint32)offset;
+    }
+    return header + 1;
+}
+
+void ThreadCacheAllocator::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+    BlockHeader* header = (BlockHeader*)ptr - 1;
+    const uint32 sizeClass = header->SizeClass;
+    if (sizeClass == THREAD_CACHE_LARGE)
+    {
+        Platform::Free((byte*)ptr - header->Offset);
+        return;
+    }
+    ASSERT_LOW_LAYER(sizeClass < THREAD_CACHE_CLASSES);
+    FreeBlock* block = (FreeBlock*)header;
+    block->Next = CacheLists[sizeClass];
+    CacheLists[sizeClass] = block;
+    if (++CacheCounts[sizeClass] > GetCacheLimit(sizeClass))
+        Flush(sizeClass, CacheCounts[sizeClass] / 2);
+}
+
+void ThreadCacheAllocator::FlushThreadCache()
+{
+    for (uint32 sizeClass = 0; sizeClass < THREAD_CACHE_CLASSES; sizeClass++)
+    {
+        if (CacheCounts[sizeClass] > 0)
+            Flush(sizeClass, CacheCounts[sizeClass]);
+    }
+}
+
+uint64 ThreadCacheAllocator::GetReservedMemory()
+{
+    return (uint64)Platform::AtomicRead(&ReservedMemory);
+}
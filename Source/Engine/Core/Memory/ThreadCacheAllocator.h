@@ -0,0 +1,46 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+
+/// <summary>
+/// The scalable memory allocator with per-thread caches of small blocks. Small allocations are served from the size-segregated free lists local to the calling thread (no locking) which are refilled in batches from the global lists or from the new memory spans. Large or over-aligned allocations go directly to the platform allocator.
+/// </summary>
+/// <remarks>The memory allocated with this allocator has to be released by it (don't mix it with Platform::Free). Small blocks memory is not returned to the system but reused.</remarks>
+class FLAXENGINE_API ThreadCacheAllocator
+{
+public:
+    /// <summary>
+    /// Allocates memory on a specified alignment boundary.
+    /// </summary>
+    /// <param name="size">The size of the allocation (in bytes).</param>
+    /// <param name="alignment">The memory alignment (in bytes). Must be an integer power of 2.</param>
+    /// <returns>The pointer to the allocated chunk of the memory. The pointer is a multiple of alignment.</returns>
+    static void* Allocate(uint64 size, uint64 alignment = 16);
+
+    /// <summary>
+    /// Frees a block of allocated memory.
+    /// </summary>
+    /// <param name="ptr">A pointer to the memory block to deallocate.</param>
+    static void Free(void* ptr);
+
+    /// <summary>
+    /// Returns all the small blocks cached by the calling thread to the global lists. Called when the thread exits so its cache can be reused by other threads.
+    /// </summary>
+    static void FlushThreadCache();
+
+    /// <summary>
+    /// Gets the total amount of memory reserved by the allocator for the small blocks (in bytes).
+    /// </summary>
+    static uint64 GetReservedMemory();
+
+    /// <summary>
+    /// Gets the name of the allocator.
+    /// </summary>
+    /// <returns>The name.</returns>
+    static const Char* Name()
+    {
+        return TEXT("ThreadCache");
+    }
+};
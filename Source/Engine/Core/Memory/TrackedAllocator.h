@@ -0,0 +1,35 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+
+/// <summary>
+/// The memory allocator that attributes allocations to the memory groups (see ProfilerMemory) and forwards them to the base allocator. Stores a small header before every allocation.
+/// </summary>
+class FLAXENGINE_API TrackedAllocator
+{
+public:
+    /// <summary>
+    /// Allocates memory on a specified alignment boundary.
+    /// </summary>
+    /// <param name="size">The size of the allocation (in bytes).</param>
+    /// <param name="alignment">The memory alignment (in bytes). Must be an integer power of 2.</param>
+    /// <returns>The pointer to the allocated chunk of the memory. The pointer is a multiple of alignment.</returns>
+    static void* Allocate(uint64 size, uint64 alignment = 16);
+
+    /// <summary>
+    /// Frees a block of allocated memory.
+    /// </summary>
+    /// <param name="ptr">A pointer to the memory block to deallocate.</param>
+    static void Free(void* ptr);
+
+    /// <summary>
+    /// Gets the name of the allocator.
+    /// </summary>
+    /// <returns>The name.</returns>
+    static const Char* Name()
+    {
+        return TEXT("Tracked");
+    }
+};
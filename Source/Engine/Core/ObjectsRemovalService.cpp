@@ -11,13 +11,117 @@
 
 namespace ObjectsRemovalServiceImpl
 {
+    // Queue of the objects sorted by the removal time (binary min-heap). Entries are not removed when object gets dereferenced or its timeout changes, instead they are validated against the pool when popped.
+    struct RemovalQueue
+    {
+        struct Entry
+        {
+            double Time;
+            Object* Obj;
+        };
+
+        // The current time (accumulated delta time of the flushes).
+        double Time = 0;
+        Array<Entry> Heap;
+
+        void Push(Object* obj, double time)
+        {
+            int32 index = Heap.Count();
+            Heap.AddUninitialized();
+            while (index > 0)
+            {
+                const int32 parent = (index - 1) / 2;
+                if (Heap[parent].Time <= time)
+                    break;
+                Heap[index] = Heap[parent];
+                index = parent;
+            }
+            Heap[index] = { time, obj };
+        }
+
+        bool HasExpired() const
+        {
+            return Heap.HasItems() && Heap[0].Time - Time <= ZeroTolerance;
+        }
+
+        Entry Pop()
+        {
+            const Entry result = Heap[0];
+            const Entry last = Heap.Last();
+            Heap.RemoveLast();
+            const int32 count = Heap.Count();
+            if (count != 0)
+            {
+                int32 index = 0;
+                while (true)
+                {
+                    int32 child = index * 2 + 1;
+                    if (child >= count)
+                        break;
+                    if (child + 1 < count && Heap[child + 1].Time < Heap[child].Time)
+                        child++;
+                    if (last.Time <= Heap[child].Time)
+                        break;
+                    Heap[index] = Heap[child];
+                    index = child;
+                }
+                Heap[index] = last;
+            }
+            return result;
+        }
+    };
+
     bool IsReady = false;
     CriticalSection PoolLocker;
     CriticalSection NewItemsLocker;
     DateTime LastUpdate;
     float LastUpdateGameTime;
-    Dictionary<Object*, float> Pool(8192);
+    // Maps the object to its removal time (on the queue matching the object UseGameTimeForDelete flag).
+    Dictionary<Object*, double> Pool(8192);
     Dictionary<Object*, float> NewItemsPool(2048);
+    RemovalQueue Queue;
+    RemovalQueue GameQueue;
+
+    void FlushNewItems()
+    {
+        ScopeLock lock(NewItemsLocker);
+        for (auto i = NewItemsPool.Begin(); i.IsNotEnd(); ++i)
+        {
+            Object* obj = i->Key;
+            RemovalQueue& queue = (obj->Flags & ObjectFlags::UseGameTimeForDelete) != ObjectFlags::None ? GameQueue : Queue;
+            const double time = queue.Time + i->Value;
+            Pool[obj] = time;
+            queue.Push(obj, time);
+        }
+        NewItemsPool.Clear();
+    }
+
+    void DeleteExpired(RemovalQueue& queue, bool gameTime)
+    {
+        // Touch only the objects that timed out
+        while (queue.HasExpired())
+        {
+            const auto e = queue.Pop();
+            auto it = Pool.Find(e.Obj);
+            if (it.IsEnd() || it->Value != e.Time || ((e.Obj->Flags & ObjectFlags::UseGameTimeForDelete) != ObjectFlags::None) != gameTime)
+                continue; // Stale entry (object got dereferenced or timeout changed)
+            Pool.Remove(it);
+
+#if BUILD_DEBUG || BUILD_DEVELOPMENT
+            if (NewItemsPool.ContainsKey(e.Obj))
+            {
+                const auto asScriptingObj = dynamic_cast<ScriptingObject*>(e.Obj);
+                if (asScriptingObj)
+                {
+                    LOG(Warning, "Object {0} was marked to delete after delete timeout", asScriptingObj->GetID());
+                }
+            }
+#endif
+            NewItemsPool.Remove(e.Obj);
+
+            e.Obj->OnDeleteObject();
+        }
+    }
 }
 
 using namespace ObjectsRemovalServiceImpl;
@@ -96,80 +200,26 @@ void ObjectsRemovalService::Flush(float dt, float gameDelta)
     PROFILE_CPU();
 
     // Add new items
-    {
-        ScopeLock lock(NewItemsLocker);
-
-        for (auto i = NewItemsPool.Begin(); i.IsNotEnd(); ++i)
-        {
-            Pool[i->Key] = i->Value;
-        }
-        NewItemsPool.Clear();
-    }
+    FlushNewItems();
 
-    // Update timeouts and delete objects that timed out
+    // Advance time and delete objects that timed out
     {
         ScopeLock lock(PoolLocker);
-
-        for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
-        {
-            auto obj = i->Key;
-            const float ttl = i->Value - ((obj->Flags & ObjectFlags::UseGameTimeForDelete) != ObjectFlags::None ? gameDelta : dt);
-            if (ttl <= ZeroTolerance)
-            {
-                Pool.Remove(i);
-
-#if BUILD_DEBUG || BUILD_DEVELOPMENT
-                if (NewItemsPool.ContainsKey(obj))
-                {
-                    const auto asScriptingObj = dynamic_cast<ScriptingObject*>(obj);
-                    if (asScriptingObj)
-                    {
-                        LOG(Warning, "Object {0} was marked to delete after delete timeout", asScriptingObj->GetID());
-                    }
-                }
-#endif
-                NewItemsPool.Remove(obj);
-                //ASSERT(!NewItemsPool.ContainsKey(obj));
-
-                obj->OnDeleteObject();
-            }
-            else
-            {
-                i->Value = ttl;
-            }
-        }
+        Queue.Time += dt;
+        GameQueue.Time += gameDelta;
+        DeleteExpired(Queue, false);
+        DeleteExpired(GameQueue, true);
     }
 
     // Perform removing in loop
     // Note: objects during OnDeleteObject call can register new objects to remove with timeout=0, for example Actors do that to remove children and scripts
     while (HasNewItemsForFlush())
     {
-        // Add new items
-        {
-            ScopeLock lock(NewItemsLocker);
+        FlushNewItems();
 
-            for (auto i = NewItemsPool.Begin(); i.IsNotEnd(); ++i)
-            {
-                Pool[i->Key] = i->Value;
-            }
-            NewItemsPool.Clear();
-        }
-
-        // Delete objects that timed out
-        {
-            ScopeLock lock(PoolLocker);
-
-            for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
-            {
-                if (i->Value <= ZeroTolerance)
-                {
-                    auto obj = i->Key;
-                    Pool.Remove(i);
-                    ASSERT(!NewItemsPool.ContainsKey(obj));
-                    obj->OnDeleteObject();
-                }
-            }
-        }
+        ScopeLock lock(PoolLocker);
+        DeleteExpired(Queue, false);
+        DeleteExpired(GameQueue, true);
     }
 }
 
@@ -209,6 +259,8 @@ void ObjectsRemoval::Dispose()
             obj->OnDeleteObject();
         }
         Pool.Clear();
+        Queue.Heap.Clear();
+        GameQueue.Heap.Clear();
     }
 
     IsReady = false;
@@ -7,6 +7,7 @@
 #ifdef _WIN32
 #include <xmmintrin.h>
 #endif
+#include <emmintrin.h>
 #else
 #include <math.h>
 #endif
@@ -92,6 +93,53 @@ namespace SIMD
     {
         return _mm_max_ps(a, b);
     }
+
+    FORCE_INLINE SimdVector4 LoadUnaligned(const void* src)
+    {
+        return _mm_loadu_ps((const float*)(src));
+    }
+
+    FORCE_INLINE void StoreUnaligned(void* dst, SimdVector4 src)
+    {
+        _mm_storeu_ps((float*)dst, src);
+    }
+
+    // Returns +1 or -1 for every component depending on its sign (zero is treated as positive).
+    FORCE_INLINE SimdVector4 SignNonZero(SimdVector4 a)
+    {
+        return _mm_or_ps(_mm_and_ps(a, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f));
+    }
+
+    // Returns the mask with components set where a is less than b (use with Select or MoveMask).
+    FORCE_INLINE SimdVector4 Less(SimdVector4 a, SimdVector4 b)
+    {
+        return _mm_cmplt_ps(a, b);
+    }
+
+    // Picks the components from a where the mask is set, otherwise from b.
+    FORCE_INLINE SimdVector4 Select(SimdVector4 mask, SimdVector4 a, SimdVector4 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Transposes the 4x4 matrix stored in the rows (eg. converts 4 vectors into the structure-of-arrays layout with a single component per row).
+    FORCE_INLINE void Transpose(SimdVector4& a, SimdVector4& b, SimdVector4& c, SimdVector4& d)
+    {
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+    }
+
+    // Compares 16 bytes (unaligned) against the value and returns the bitmask with bit set for every matching byte.
+    FORCE_INLINE uint32 MatchBytes16(const void* src, byte value)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*)src);
+        return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8((char)value)));
+    }
+
+    // Returns the bitmask with bit set for every byte (out of 16, unaligned) that has the highest bit set.
+    FORCE_INLINE uint32 MaskBytes16(const void* src)
+    {
+        return (uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)src));
+    }
 }
 
 #else
@@ -234,6 +282,78 @@ namespace SIMD
 			a.W > b.W ? a.W : b.W
 		};
 	}
+
+	FORCE_INLINE SimdVector4 LoadUnaligned(const void* src)
+	{
+		SimdVector4 result;
+		Platform::MemoryCopy(&result, src, sizeof(SimdVector4));
+		return result;
+	}
+
+	FORCE_INLINE void StoreUnaligned(void* dst, SimdVector4 src)
+	{
+		Platform::MemoryCopy(dst, &src, sizeof(SimdVector4));
+	}
+
+	FORCE_INLINE SimdVector4 SignNonZero(SimdVector4 a)
+	{
+		return
+		{
+			a.X < 0 ? -1.0f : 1.0f,
+			a.Y < 0 ? -1.0f : 1.0f,
+			a.Z < 0 ? -1.0f : 1.0f,
+			a.W < 0 ? -1.0f : 1.0f
+		};
+	}
+
+	FORCE_INLINE SimdVector4 Less(SimdVector4 a, SimdVector4 b)
+	{
+		return
+		{
+			a.X < b.X ? -1.0f : 0.0f,
+			a.Y < b.Y ? -1.0f : 0.0f,
+			a.Z < b.Z ? -1.0f : 0.0f,
+			a.W < b.W ? -1.0f : 0.0f
+		};
+	}
+
+	FORCE_INLINE SimdVector4 Select(SimdVector4 mask, SimdVector4 a, SimdVector4 b)
+	{
+		return
+		{
+			mask.X < 0 ? a.X : b.X,
+			mask.Y < 0 ? a.Y : b.Y,
+			mask.Z < 0 ? a.Z : b.Z,
+			mask.W < 0 ? a.W : b.W
+		};
+	}
+
+	FORCE_INLINE void Transpose(SimdVector4& a, SimdVector4& b, SimdVector4& c, SimdVector4& d)
+	{
+		const SimdVector4 ta = a, tb = b, tc = c, td = d;
+		a = { ta.X, tb.X, tc.X, td.X };
+		b = { ta.Y, tb.Y, tc.Y, td.Y };
+		c = { ta.Z, tb.Z, tc.Z, td.Z };
+		d = { ta.W, tb.W, tc.W, td.W };
+	}
+
+	FORCE_INLINE uint32 MatchBytes16(const void* src, byte value)
+	{
+		const byte* data = (const byte*)src;
+		uint32 result = 0;
+		for (int32 i = 0; i < 16; i++)
+			result |= (data[i] == value ? 1u : 0u) << i;
+		return result;
+	}
+
+	FORCE_INLINE uint32 MaskBytes16(const void* src)
+	{
+		const byte* data = (const byte*)src;
+		uint32 result = 0;
+		for (int32 i = 0; i < 16; i++)
+			result |= (uint32)(data[i] >> 7) << i;
+		return result;
+	}
 }
 
 #endif
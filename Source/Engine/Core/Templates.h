@@ -294,6 +294,17 @@ struct TIsTriviallyCopyAssignable
 
 ////////////////////////////////////////////////////////////////////////////////////
 
+// Checks if a type can be relocated (moved to a new memory location with the old one discarded) using a low-level memory copy.
+// Specialize it for types that don't keep pointers to themselves (eg. types that only hold pointers to the heap or to other objects) to speed up collections resizing, insertion and removal.
+
+template<typename T>
+struct TIsTriviallyRelocatable
+{
+	enum { Value = TIsPODType<T>::Value || (TIsTriviallyCopyConstructible<T>::Value && TIsTriviallyDestructible<T>::Value) };
+};
+
+////////////////////////////////////////////////////////////////////////////////////
+
 template<typename T>                           struct TIsFunction                     { enum { Value = false }; };
 template<typename RetType, typename... Params> struct TIsFunction<RetType(Params...)> { enum { Value = true }; };
 
@@ -9,10 +9,14 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Core/Math/OrientedBoundingBox.h"
+#include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/AssetReference.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
 #include "Engine/Graphics/GPUPipelineState.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderBuffers.h"
@@ -50,6 +54,8 @@
 #define DEBUG_DRAW_ARC_RESOLUTION 32
 //
 #define DEBUG_DRAW_TRIANGLE_SPHERE_RESOLUTION 12
+//
+#define DEBUG_DRAW_INSTANCED_SPHERE_LOD 1
 
 struct DebugSphereCache
 {
@@ -125,6 +131,13 @@ PACK_STRUCT(struct Vertex {
     Color32 Color;
     });
 
+PACK_STRUCT(struct InstanceData {
+    Float4 Row0;
+    Float4 Row1;
+    Float4 Row2;
+    Color32 Color;
+    });
+
 PACK_STRUCT(struct Data {
     Matrix ViewProjection;
     Float3 Padding;
@@ -331,6 +344,50 @@ struct DebugDrawData
     }
 };
 
+struct DebugDrawCall
+{
+    int32 StartVertex;
+    int32 VertexCount;
+};
+
+struct DebugGeometry
+{
+    DebugDrawGeometryType Type = DebugDrawGeometryType::Lines;
+    DebugDrawPrimitive Primitive = DebugDrawPrimitive::MAX; // MAX if not instanced
+    bool DepthTest = true;
+    Color32 Color;
+    Transform Transform = Transform::Identity;
+    Array<Vertex> Vertices;
+    Array<InstanceData> Instances;
+    int32 DirtyStart = 0;
+    int32 DirtyEnd = 0;
+    GPUBuffer* Buffer = nullptr;
+
+    FORCE_INLINE bool IsInstanced() const
+    {
+        return Primitive != DebugDrawPrimitive::MAX;
+    }
+
+    FORCE_INLINE int32 Count() const
+    {
+        return IsInstanced() ? Instances.Count() : Vertices.Count();
+    }
+
+    FORCE_INLINE void MarkDirty(int32 start, int32 end)
+    {
+        if (DirtyStart >= DirtyEnd)
+        {
+            DirtyStart = start;
+            DirtyEnd = end;
+        }
+        else
+        {
+            DirtyStart = Math::Min(DirtyStart, start);
+            DirtyEnd = Math::Max(DirtyEnd, end);
+        }
+    }
+};
+
 struct DebugDrawContext
 {
     Vector3 Origin = Vector3::Zero;
@@ -338,6 +395,15 @@ struct DebugDrawContext
     DebugDrawData DebugDrawDepthTest;
     Float3 LastViewPos = Float3::Zero;
     Matrix LastViewProj = Matrix::Identity;
+    Dictionary<uint32, DebugGeometry> Geometry;
+    uint32 NextGeometryId = 1;
+
+    void ReleaseGeometry()
+    {
+        for (auto& e : Geometry)
+            SAFE_DELETE_GPU_RESOURCE(e.Value.Buffer);
+        Geometry.Clear();
+    }
 };
 
 namespace
@@ -352,10 +418,16 @@ namespace
     PsData DebugDrawPsWireTrianglesDepthTest;
     PsData DebugDrawPsTrianglesDefault;
     PsData DebugDrawPsTrianglesDepthTest;
+    PsData DebugDrawPsInstancedLinesDefault;
+    PsData DebugDrawPsInstancedLinesDepthTest;
+    PsData DebugDrawPsInstancedTrianglesDefault;
+    PsData DebugDrawPsInstancedTrianglesDepthTest;
     DynamicVertexBuffer* DebugDrawVB = nullptr;
+    GPUBuffer* DebugDrawPrimitivesVB = nullptr;
     Float3 CircleCache[DEBUG_DRAW_CIRCLE_VERTICES];
     Array<Float3> SphereTriangleCache;
     DebugSphereCache SphereCache[3];
+    DebugDrawCall DebugDrawPrimitivesCalls[(int32)DebugDrawPrimitive::MAX];
 };
 
 extern int32 BoxTrianglesIndicesCache[];
@@ -378,12 +450,6 @@ int32 BoxLineIndicesCache[] =
     // @formatter:on
 };
 
-struct DebugDrawCall
-{
-    int32 StartVertex;
-    int32 VertexCount;
-};
-
 DebugDrawCall WriteList(int32& vertexCounter, const Array<Vertex>& list)
 {
     DebugDrawCall drawCall;
@@ -438,6 +504,129 @@ DebugDrawCall WriteLists(int32& vertexCounter, const Array<T>& listA, const Arra
     return drawCall;
 }
 
+void WritePrimitive(Array<Vertex>& vertices, DebugDrawPrimitive primitive, const Float3* positions, int32 count, DebugDrawCall* calls)
+{
+    DebugDrawCall& drawCall = calls[(int32)primitive];
+    drawCall.StartVertex = vertices.Count();
+    drawCall.VertexCount = count;
+    for (int32 i = 0; i < count; i++)
+        vertices.Add({ positions[i], Color32::White });
+}
+
+void WriteInstance(InstanceData& dst, const DebugDrawInstance& src)
+{
+    // Transposed 3x4 matrix for the dot products in the vertex shader
+    Matrix m;
+    Matrix::Transformation(src.Scale, src.Orientation, src.Position, m);
+    dst.Row0 = Float4(m.M11, m.M21, m.M31, m.M41);
+    dst.Row1 = Float4(m.M12, m.M22, m.M32, m.M42);
+    dst.Row2 = Float4(m.M13, m.M23, m.M33, m.M43);
+    dst.Color = Color32(src.Color);
+}
+
+bool UploadGeometry(GPUContext* context, DebugGeometry& geometry)
+{
+    const int32 count = geometry.Count();
+    if (count == 0)
+        return true;
+    const uint32 stride = geometry.IsInstanced() ? sizeof(InstanceData) : sizeof(Vertex);
+    const byte* data = geometry.IsInstanced() ? (const byte*)geometry.Instances.Get() : (const byte*)geometry.Vertices.Get();
+
+    // Ensure to have enough space (allocate a bit more to reduce buffer reallocations when geometry grows)
+    if (!geometry.Buffer)
+        geometry.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("DebugDraw.Geometry"));
+    if (geometry.Buffer->GetSize() < count * stride)
+    {
+        if (geometry.Buffer->Init(GPUBufferDescription::Vertex(stride, Math::RoundUpToPowerOf2(count))))
+            return true;
+        geometry.DirtyStart = 0;
+        geometry.DirtyEnd = count;
+    }
+
+    // Upload only the modified range
+    if (geometry.DirtyStart < geometry.DirtyEnd)
+    {
+        context->UpdateBuffer(geometry.Buffer, data + geometry.DirtyStart * stride, (geometry.DirtyEnd - geometry.DirtyStart) * stride, geometry.DirtyStart * stride);
+        geometry.DirtyStart = geometry.DirtyEnd = 0;
+    }
+    return false;
+}
+
+void DrawGeometry(GPUContext* context, GPUConstantBuffer* cb, Data& data, const Matrix& vp, const Vector3& origin, bool depthTest, bool enableDepthWrite)
+{
+    const bool depthTestShader = depthTest && data.EnableDepthTest;
+    const bool canInstance = GPUDevice::Instance->Limits.HasInstancing && DebugDrawPrimitivesVB;
+    const Matrix viewProjection = data.ViewProjection;
+    bool anyDrawn = false;
+    for (auto& e : Context->Geometry)
+    {
+        DebugGeometry& geometry = e.Value;
+        if (geometry.DepthTest != depthTest || !geometry.Buffer || geometry.Count() == 0)
+            continue;
+        if (geometry.IsInstanced() && !canInstance)
+            continue;
+
+        // Update the geometry transformation (relative to the view origin)
+        Transform transform = geometry.Transform;
+        transform.Translation -= origin;
+        Matrix world, wvp;
+        transform.GetWorld(world);
+        Matrix::Multiply(world, vp, wvp);
+        Matrix::Transpose(wvp, data.ViewProjection);
+        context->UpdateCB(cb, &data);
+        anyDrawn = true;
+
+        if (geometry.IsInstanced())
+        {
+            const bool lines = geometry.Primitive != DebugDrawPrimitive::Box && geometry.Primitive != DebugDrawPrimitive::Sphere;
+            PsData* state;
+            if (lines)
+                state = depthTestShader ? &DebugDrawPsInstancedLinesDepthTest : &DebugDrawPsInstancedLinesDefault;
+            else
+                state = depthTestShader ? &DebugDrawPsInstancedTrianglesDepthTest : &DebugDrawPsInstancedTrianglesDefault;
+            context->SetState(state->Get(enableDepthWrite, depthTest));
+            GPUBuffer* vb[2] = { DebugDrawPrimitivesVB, geometry.Buffer };
+            context->BindVB(ToSpan(vb, 2));
+            const DebugDrawCall& primitive = DebugDrawPrimitivesCalls[(int32)geometry.Primitive];
+            context->DrawInstanced(primitive.VertexCount, geometry.Instances.Count(), 0, primitive.StartVertex);
+        }
+        else
+        {
+            PsData* state;
+            switch (geometry.Type)
+            {
+            case DebugDrawGeometryType::Triangles:
+                state = depthTestShader ? &DebugDrawPsTrianglesDepthTest : &DebugDrawPsTrianglesDefault;
+                break;
+            case DebugDrawGeometryType::WireTriangles:
+                state = depthTestShader ? &DebugDrawPsWireTrianglesDepthTest : &DebugDrawPsWireTrianglesDefault;
+                break;
+            default:
+                state = depthTestShader ? &DebugDrawPsLinesDepthTest : &DebugDrawPsLinesDefault;
+                break;
+            }
+            context->SetState(state->Get(enableDepthWrite, depthTest));
+            context->BindVB(ToSpan(&geometry.Buffer, 1));
+            context->Draw(0, geometry.Vertices.Count());
+        }
+    }
+
+    // Restore the default constants
+    if (anyDrawn)
+    {
+        data.ViewProjection = viewProjection;
+        context->UpdateCB(cb, &data);
+    }
+}
+
+DebugGeometry* GetGeometry(uint32 geometry)
+{
+    DebugGeometry* result = Context->Geometry.TryGet(geometry);
+    if (!result)
+        LOG(Warning, "Invalid debug geometry handle {0}.", geometry);
+    return result;
+}
+
 FORCE_INLINE DebugTriangle* AppendTriangles(int32 count, float duration, bool depthTest)
 {
     Array<DebugTriangle>* list;
@@ -650,6 +839,23 @@ void DebugDrawService::Update()
         desc.Wireframe = true;
         failed |= DebugDrawPsWireTrianglesDepthTest.Create(desc);
 
+        // Instanced
+        if (GPUDevice::Instance->Limits.HasInstancing)
+        {
+            desc.Wireframe = false;
+            desc.VS = shader->GetVS("VS_Instanced");
+            desc.PS = shader->GetPS("PS");
+            desc.PrimitiveTopologyType = PrimitiveTopologyType::Line;
+            failed |= DebugDrawPsInstancedLinesDefault.Create(desc);
+            desc.PrimitiveTopologyType = PrimitiveTopologyType::Triangle;
+            failed |= DebugDrawPsInstancedTrianglesDefault.Create(desc);
+            desc.PS = shader->GetPS("PS_DepthTest");
+            desc.PrimitiveTopologyType = PrimitiveTopologyType::Line;
+            failed |= DebugDrawPsInstancedLinesDepthTest.Create(desc);
+            desc.PrimitiveTopologyType = PrimitiveTopologyType::Triangle;
+            failed |= DebugDrawPsInstancedTrianglesDepthTest.Create(desc);
+        }
+
         if (failed)
         {
             LOG(Fatal, "Cannot setup DebugDraw service!");
@@ -657,6 +863,39 @@ void DebugDrawService::Update()
 
         // Vertex buffer
         DebugDrawVB = New<DynamicVertexBuffer>((uint32)(DEBUG_DRAW_INITIAL_VB_CAPACITY * sizeof(Vertex)), (uint32)sizeof(Vertex), TEXT("DebugDraw.VB"));
+
+        // Unit primitives for the instanced geometry
+        if (GPUDevice::Instance->Limits.HasInstancing)
+        {
+            Array<Vertex> vertices;
+            Float3 boxCorners[8], positions[36];
+            BoundingBox(Vector3(-1.0f), Vector3(1.0f)).GetCorners(boxCorners);
+            for (int32 i = 0; i < 24; i++)
+                positions[i] = boxCorners[BoxLineIndicesCache[i]];
+            WritePrimitive(vertices, DebugDrawPrimitive::WireBox, positions, 24, DebugDrawPrimitivesCalls);
+            for (int32 i = 0; i < 36; i++)
+                positions[i] = boxCorners[BoxTrianglesIndicesCache[i]];
+            WritePrimitive(vertices, DebugDrawPrimitive::Box, positions, 36, DebugDrawPrimitivesCalls);
+            const auto& sphereCache = SphereCache[DEBUG_DRAW_INSTANCED_SPHERE_LOD].Vertices;
+            WritePrimitive(vertices, DebugDrawPrimitive::WireSphere, sphereCache.Get(), sphereCache.Count(), DebugDrawPrimitivesCalls);
+            WritePrimitive(vertices, DebugDrawPrimitive::Sphere, SphereTriangleCache.Get(), SphereTriangleCache.Count(), DebugDrawPrimitivesCalls);
+            const Float3 arrowEnd = Float3::Forward, arrowCapEnd = Float3::Forward * 0.7f;
+            const Float3 arrow[] =
+            {
+                Float3::Zero, arrowEnd,
+                arrowEnd, arrowCapEnd + Float3::Up * 0.3f,
+                arrowEnd, arrowCapEnd - Float3::Up * 0.3f,
+                arrowEnd, arrowCapEnd + Float3::Right * 0.3f,
+                arrowEnd, arrowCapEnd - Float3::Right * 0.3f,
+            };
+            WritePrimitive(vertices, DebugDrawPrimitive::WireArrow, arrow, ARRAY_COUNT(arrow), DebugDrawPrimitivesCalls);
+            DebugDrawPrimitivesVB = GPUDevice::Instance->CreateBuffer(TEXT("DebugDraw.Primitives"));
+            if (DebugDrawPrimitivesVB->Init(GPUBufferDescription::Vertex(sizeof(Vertex), vertices.Count(), vertices.Get())))
+            {
+                LOG(Error, "Cannot setup DebugDraw primitives buffer!");
+                SAFE_DELETE_GPU_RESOURCE(DebugDrawPrimitivesVB);
+            }
+        }
     }
 }
 
@@ -665,6 +904,7 @@ void DebugDrawService::Dispose()
     // Clear lists
     GlobalContext.DebugDrawDefault.Release();
     GlobalContext.DebugDrawDepthTest.Release();
+    GlobalContext.ReleaseGeometry();
 
     // Release resources
     SphereTriangleCache.Resize(0);
@@ -674,7 +914,12 @@ void DebugDrawService::Dispose()
     DebugDrawPsWireTrianglesDepthTest.Release();
     DebugDrawPsTrianglesDefault.Release();
     DebugDrawPsTrianglesDepthTest.Release();
+    DebugDrawPsInstancedLinesDefault.Release();
+    DebugDrawPsInstancedLinesDepthTest.Release();
+    DebugDrawPsInstancedTrianglesDefault.Release();
+    DebugDrawPsInstancedTrianglesDepthTest.Release();
     SAFE_DELETE(DebugDrawVB);
+    SAFE_DELETE_GPU_RESOURCE(DebugDrawPrimitivesVB);
     DebugDrawShader = nullptr;
 }
 
@@ -689,6 +934,7 @@ void* DebugDraw::AllocateContext()
 
 void DebugDraw::FreeContext(void* context)
 {
+    ((DebugDrawContext*)context)->ReleaseGeometry();
     Memory::DestructItem((DebugDrawContext*)context);
     Allocator::Free(context);
 }
@@ -713,7 +959,7 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
     // Ensure to have shader loaded and any lines to render
     const int32 debugDrawDepthTestCount = Context->DebugDrawDepthTest.Count();
     const int32 debugDrawDefaultCount = Context->DebugDrawDefault.Count();
-    if (DebugDrawShader == nullptr || !DebugDrawShader->IsLoaded() || debugDrawDepthTestCount + debugDrawDefaultCount == 0)
+    if (DebugDrawShader == nullptr || !DebugDrawShader->IsLoaded() || debugDrawDepthTestCount + debugDrawDefaultCount + Context->Geometry.Count() == 0)
         return;
     if (renderContext.Buffers == nullptr || !DebugDrawVB)
         return;
@@ -752,6 +998,22 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
         }
     }
 
+    // Upload modified ranges of the retained geometry
+    int32 depthTestGeometry = 0, defaultGeometry = 0;
+    if (Context->Geometry.HasItems())
+    {
+        PROFILE_CPU_NAMED("Update Geometry");
+        for (auto& e : Context->Geometry)
+        {
+            if (UploadGeometry(context, e.Value))
+                continue;
+            if (e.Value.DepthTest)
+                depthTestGeometry++;
+            else
+                defaultGeometry++;
+        }
+    }
+
     // Update constant buffer
     const auto cb = DebugDrawShader->GetShader()->GetCB(0);
     Data data;
@@ -764,7 +1026,7 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
     auto vb = DebugDrawVB->GetBuffer();
 
     // Draw with depth test
-    if (depthTestLines.VertexCount + depthTestTriangles.VertexCount + depthTestWireTriangles.VertexCount > 0)
+    if (depthTestLines.VertexCount + depthTestTriangles.VertexCount + depthTestWireTriangles.VertexCount + depthTestGeometry > 0)
     {
         if (data.EnableDepthTest)
             context->BindSR(0, renderContext.Buffers->DepthBuffer);
@@ -799,12 +1061,16 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
             context->Draw(depthTestTriangles.StartVertex, depthTestTriangles.VertexCount);
         }
 
+        // Retained geometry
+        if (depthTestGeometry)
+            DrawGeometry(context, cb, data, vp, view.Origin, true, enableDepthWrite);
+
         if (data.EnableDepthTest)
             context->UnBindSR(0);
     }
 
     // Draw without depth
-    if (defaultLines.VertexCount + defaultTriangles.VertexCount + defaultWireTriangles.VertexCount > 0)
+    if (defaultLines.VertexCount + defaultTriangles.VertexCount + defaultWireTriangles.VertexCount + defaultGeometry > 0)
     {
         context->SetRenderTarget(target);
 
@@ -831,6 +1097,10 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
             context->BindVB(ToSpan(&vb, 1));
             context->Draw(defaultTriangles.StartVertex, defaultTriangles.VertexCount);
         }
+
+        // Retained geometry
+        if (defaultGeometry)
+            DrawGeometry(context, cb, data, vp, view.Origin, false, false);
     }
 
     // Text
@@ -2026,4 +2296,83 @@ void DebugDraw::DrawText(const StringView& text, const Transform& transform, con
     t.TimeLeft = duration;
 }
 
+uint32 DebugDraw::CreateGeometry(const Span<Float3>& vertices, const Color& color, DebugDrawGeometryType type, bool depthTest)
+{
+    if (vertices.Length() % (type == DebugDrawGeometryType::Lines ? 2 : 3) != 0)
+    {
+        DebugLog::ThrowException("Cannot create debug geometry with invalid amount of vertices");
+        return 0;
+    }
+    const uint32 id = Context->NextGeometryId++;
+    DebugGeometry& geometry = Context->Geometry[id];
+    geometry.Type = type;
+    geometry.DepthTest = depthTest;
+    geometry.Color = Color32(color);
+    geometry.Vertices.Resize(vertices.Length());
+    for (int32 i = 0; i < vertices.Length(); i++)
+        geometry.Vertices.Get()[i] = { vertices[i], geometry.Color };
+    geometry.MarkDirty(0, vertices.Length());
+    return id;
+}
+
+uint32 DebugDraw::CreateInstances(DebugDrawPrimitive primitive, const Span<DebugDrawInstance>& instances, bool depthTest)
+{
+    if ((int32)primitive < 0 || primitive >= DebugDrawPrimitive::MAX)
+    {
+        DebugLog::ThrowException("Invalid debug geometry primitive");
+        return 0;
+    }
+    const uint32 id = Context->NextGeometryId++;
+    DebugGeometry& geometry = Context->Geometry[id];
+    geometry.Primitive = primitive;
+    geometry.DepthTest = depthTest;
+    geometry.Instances.Resize(instances.Length());
+    for (int32 i = 0; i < instances.Length(); i++)
+        WriteInstance(geometry.Instances.Get()[i], instances[i]);
+    geometry.MarkDirty(0, instances.Length());
+    return id;
+}
+
+void DebugDraw::UpdateGeometry(uint32 geometry, int32 offset, const Span<Float3>& vertices)
+{
+    DebugGeometry* g = GetGeometry(geometry);
+    if (!g || g->IsInstanced() || offset < 0 || vertices.Length() == 0)
+        return;
+    const int32 end = offset + vertices.Length();
+    if (end > g->Vertices.Count())
+        g->Vertices.Resize(end);
+    for (int32 i = 0; i < vertices.Length(); i++)
+        g->Vertices.Get()[offset + i] = { vertices[i], g->Color };
+    g->MarkDirty(offset, end);
+}
+
+void DebugDraw::UpdateInstances(uint32 geometry, int32 offset, const Span<DebugDrawInstance>& instances)
+{
+    DebugGeometry* g = GetGeometry(geometry);
+    if (!g || !g->IsInstanced() || offset < 0 || instances.Length() == 0)
+        return;
+    const int32 end = offset + instances.Length();
+    if (end > g->Instances.Count())
+        g->Instances.Resize(end);
+    for (int32 i = 0; i < instances.Length(); i++)
+        WriteInstance(g->Instances.Get()[offset + i], instances[i]);
+    g->MarkDirty(offset, end);
+}
+
+void DebugDraw::SetGeometryTransform(uint32 geometry, const Transform& transform)
+{
+    DebugGeometry* g = GetGeometry(geometry);
+    if (g)
+        g->Transform = transform;
+}
+
+void DebugDraw::DestroyGeometry(uint32 geometry)
+{
+    DebugGeometry* g = GetGeometry(geometry);
+    if (!g)
+        return;
+    SAFE_DELETE_GPU_RESOURCE(g->Buffer);
+    Context->Geometry.Remove(geometry);
+}
+
 #endif
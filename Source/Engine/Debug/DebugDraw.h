@@ -6,6 +6,8 @@
 
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Core/Math/Color.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Core/Types/Span.h"
 
 struct RenderContext;
@@ -16,6 +18,89 @@ class SceneRenderTask;
 class Actor;
 struct Transform;
 
+/// <summary>
+/// The type of the retained debug geometry primitives.
+/// </summary>
+API_ENUM() enum class DebugDrawGeometryType
+{
+    /// <summary>
+    /// The list of lines (vertices are located one after another, e.g. l0.start, l0.end, l1.start, l1.end,...).
+    /// </summary>
+    Lines,
+
+    /// <summary>
+    /// The list of triangles (vertices are located one after another, e.g. t0.v0, t0.v1, t0.v2, t1.v0,...).
+    /// </summary>
+    Triangles,
+
+    /// <summary>
+    /// The list of wireframe triangles (vertices are located one after another, e.g. t0.v0, t0.v1, t0.v2, t1.v0,...).
+    /// </summary>
+    WireTriangles,
+};
+
+/// <summary>
+/// The shape used by the retained debug geometry instances. Each primitive is defined in the unit space and transformed by the instance data.
+/// </summary>
+API_ENUM() enum class DebugDrawPrimitive
+{
+    /// <summary>
+    /// The wireframe box (scale is the box half-size).
+    /// </summary>
+    WireBox,
+
+    /// <summary>
+    /// The solid box (scale is the box half-size).
+    /// </summary>
+    Box,
+
+    /// <summary>
+    /// The wireframe sphere (scale is the sphere radius).
+    /// </summary>
+    WireSphere,
+
+    /// <summary>
+    /// The solid sphere (scale is the sphere radius).
+    /// </summary>
+    Sphere,
+
+    /// <summary>
+    /// The wireframe arrow pointing forward (scale is the arrow length).
+    /// </summary>
+    WireArrow,
+
+    API_ENUM(Attributes="HideInEditor")
+    MAX
+};
+
+/// <summary>
+/// The single instance of the retained debug geometry primitive.
+/// </summary>
+API_STRUCT() struct DebugDrawInstance
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(DebugDrawInstance);
+
+    /// <summary>
+    /// The instance position (in the geometry local space).
+    /// </summary>
+    API_FIELD() Float3 Position = Float3::Zero;
+
+    /// <summary>
+    /// The instance orientation.
+    /// </summary>
+    API_FIELD() Quaternion Orientation = Quaternion::Identity;
+
+    /// <summary>
+    /// The instance scale.
+    /// </summary>
+    API_FIELD() Float3 Scale = Float3::One;
+
+    /// <summary>
+    /// The instance color.
+    /// </summary>
+    API_FIELD() Color Color = Color::White;
+};
+
 /// <summary>
 /// The debug shapes rendering service. Not available in final game. For use only in the editor.
 /// </summary>
@@ -601,6 +686,57 @@ API_CLASS(Static) class FLAXENGINE_API DebugDraw
     /// <param name="size">The font size.</param>
     /// <param name="duration">The duration (in seconds). Use 0 to draw it only once.</param>
     API_FUNCTION() static void DrawText(const StringView& text, const Transform& transform, const Color& color, int32 size = 32, float duration = 0.0f);
+
+public:
+    /// <summary>
+    /// Creates the retained debug geometry that is drawn every frame until destroyed. The vertices are kept in a persistent GPU buffer and uploaded only when modified which is much faster than drawing the large datasets every frame.
+    /// </summary>
+    /// <remarks>The geometry belongs to the current debug drawing context.</remarks>
+    /// <param name="vertices">The list of vertices (in the geometry local space).</param>
+    /// <param name="color">The color.</param>
+    /// <param name="type">The type of the primitives.</param>
+    /// <param name="depthTest">If set to <c>true</c> depth test will be performed, otherwise depth will be ignored.</param>
+    /// <returns>The geometry handle. Returns 0 if failed.</returns>
+    API_FUNCTION() static uint32 CreateGeometry(const Span<Float3>& vertices, const Color& color, DebugDrawGeometryType type = DebugDrawGeometryType::Lines, bool depthTest = true);
+
+    /// <summary>
+    /// Creates the retained debug geometry made of the instanced primitives that is drawn every frame until destroyed. The instances are kept in a persistent GPU buffer and uploaded only when modified which is much faster than drawing the large datasets every frame.
+    /// </summary>
+    /// <remarks>The geometry belongs to the current debug drawing context. Instanced geometry is not drawn on devices without instancing support.</remarks>
+    /// <param name="primitive">The primitive shape to draw for every instance.</param>
+    /// <param name="instances">The list of instances (in the geometry local space).</param>
+    /// <param name="depthTest">If set to <c>true</c> depth test will be performed, otherwise depth will be ignored.</param>
+    /// <returns>The geometry handle. Returns 0 if failed.</returns>
+    API_FUNCTION() static uint32 CreateInstances(DebugDrawPrimitive primitive, const Span<DebugDrawInstance>& instances, bool depthTest = true);
+
+    /// <summary>
+    /// Updates the range of vertices of the retained debug geometry. Only the modified range is uploaded to the GPU. Geometry grows if the range exceeds the current vertices count.
+    /// </summary>
+    /// <param name="geometry">The geometry handle (created with CreateGeometry).</param>
+    /// <param name="offset">The index of the first vertex to update.</param>
+    /// <param name="vertices">The list of vertices (in the geometry local space).</param>
+    API_FUNCTION() static void UpdateGeometry(uint32 geometry, int32 offset, const Span<Float3>& vertices);
+
+    /// <summary>
+    /// Updates the range of instances of the retained debug geometry. Only the modified range is uploaded to the GPU. Geometry grows if the range exceeds the current instances count.
+    /// </summary>
+    /// <param name="geometry">The geometry handle (created with CreateInstances).</param>
+    /// <param name="offset">The index of the first instance to update.</param>
+    /// <param name="instances">The list of instances (in the geometry local space).</param>
+    API_FUNCTION() static void UpdateInstances(uint32 geometry, int32 offset, const Span<DebugDrawInstance>& instances);
+
+    /// <summary>
+    /// Sets the world-space transformation of the retained debug geometry. Moving the whole geometry doesn't require uploading its data again.
+    /// </summary>
+    /// <param name="geometry">The geometry handle.</param>
+    /// <param name="transform">The geometry transformation (world-space).</param>
+    API_FUNCTION() static void SetGeometryTransform(uint32 geometry, const Transform& transform);
+
+    /// <summary>
+    /// Destroys the retained debug geometry and releases its GPU buffer.
+    /// </summary>
+    /// <param name="geometry">The geometry handle.</param>
+    API_FUNCTION() static void DestroyGeometry(uint32 geometry);
 };
 
 #define DEBUG_DRAW_LINE(start, end, color, duration, depthTest) DebugDraw::DrawLine(start, end, color, duration, depthTest)
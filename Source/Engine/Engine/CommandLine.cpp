@@ -125,6 +125,7 @@ bool CommandLine::Parse(const Char* cmdLine)
     PARSE_BOOL_SWITCH("-vsync ", VSync);
     PARSE_BOOL_SWITCH("-novsync ", NoVSync);
     PARSE_BOOL_SWITCH("-nolog ", NoLog);
+    PARSE_BOOL_SWITCH("-logasync ", LogAsync);
     PARSE_BOOL_SWITCH("-std ", Std);
 #if !BUILD_RELEASE
     PARSE_ARG_SWITCH("-debug ", DebuggerAddress);
@@ -132,6 +133,7 @@ bool CommandLine::Parse(const Char* cmdLine)
 #endif
 #if PLATFORM_HAS_HEADLESS_MODE
     PARSE_BOOL_SWITCH("-headless ", Headless);
+    PARSE_BOOL_SWITCH("-server ", Server);
 #endif
     PARSE_BOOL_SWITCH("-d3d12 ", D3D12);
     PARSE_BOOL_SWITCH("-d3d11 ", D3D11);
@@ -144,6 +146,15 @@ bool CommandLine::Parse(const Char* cmdLine)
     PARSE_BOOL_SWITCH("-monolog ", MonoLog);
     PARSE_BOOL_SWITCH("-mute ", Mute);
     PARSE_BOOL_SWITCH("-lowdpi ", LowDPI);
+    PARSE_BOOL_SWITCH("-gpuprofile ", GPUProfile);
+    PARSE_ARG_SWITCH("-loadordertrace ", LoadOrderTrace);
+    PARSE_ARG_SWITCH("-profiletracethreshold ", ProfileTraceThreshold);
+    PARSE_ARG_SWITCH("-profiletrace ", ProfileTrace);
+    PARSE_ARG_SWITCH("-hitchbudget ", HitchBudget);
+    PARSE_ARG_SWITCH("-replayrecord ", ReplayRecord);
+    PARSE_ARG_SWITCH("-replayreport ", ReplayReport);
+    PARSE_ARG_SWITCH("-replaybudget ", ReplayBudget);
+    PARSE_ARG_SWITCH("-replay ", Replay);
 
 #if USE_EDITOR
 
@@ -155,7 +166,12 @@ bool CommandLine::Parse(const Char* cmdLine)
     PARSE_ARG_SWITCH("-build ", Build);
     PARSE_BOOL_SWITCH("-skipcompile ", SkipCompile);
     PARSE_BOOL_SWITCH("-shaderdebug ", ShaderDebug);
+    PARSE_ARG_SWITCH("-shadercache ", ShaderCache);
     PARSE_ARG_OPT_SWITCH("-play ", Play);
+#if FLAX_BENCHMARKS
+    PARSE_ARG_SWITCH("-benchmarkout ", BenchmarkOut);
+    PARSE_ARG_SWITCH("-benchmark ", Benchmark);
+#endif
 
 #endif
 
@@ -44,6 +44,11 @@ class CommandLine
         /// </summary>
         Nullable<bool> NoLog;
 
+        /// <summary>
+        /// -logasync (writes log messages on a background thread, errors are still written and flushed immediately)
+        /// </summary>
+        Nullable<bool> LogAsync;
+
         /// <summary>
         /// -std (redirect log to standard output)
         /// </summary>
@@ -70,6 +75,11 @@ class CommandLine
         /// </summary>
         Nullable<bool> Headless;
 
+        /// <summary>
+        /// -server (Run as a dedicated server: headless mode with Null rendering backend and muted audio, skips rendering-only services and content and ticks at fixed rate)
+        /// </summary>
+        Nullable<bool> Server;
+
 #endif
 
         /// <summary>
@@ -127,6 +137,51 @@ class CommandLine
         /// </summary>
         Nullable<bool> LowDPI;
 
+        /// <summary>
+        /// -gpuprofile (enables the GPU pipeline statistics collecting and the on-screen overlay with per-pass GPU timings)
+        /// </summary>
+        Nullable<bool> GPUProfile;
+
+        /// <summary>
+        /// -loadordertrace !path! (records the assets load order during the session and saves it to the file on exit, used by the Game Cooker to optimize packages layout)
+        /// </summary>
+        Nullable<String> LoadOrderTrace;
+
+        /// <summary>
+        /// -profiletrace !path! (records the recent frames profiler events and saves the trace files to the given folder on frame time hitches, see ProfilingTools::TraceFolder)
+        /// </summary>
+        Nullable<String> ProfileTrace;
+
+        /// <summary>
+        /// -profiletracethreshold !ms! (the frame time threshold in milliseconds for the profiler trace capture, see ProfilingTools::TraceThresholdMs)
+        /// </summary>
+        Nullable<String> ProfileTraceThreshold;
+
+        /// <summary>
+        /// -hitchbudget !ms! (the frame time budget in milliseconds above which the hitch report is printed to the log, see ProfilingTools::HitchBudgetMs)
+        /// </summary>
+        Nullable<String> HitchBudget;
+
+        /// <summary>
+        /// -replayrecord !path! (records the input and the main camera path with a fixed time step for the performance replay, see PerformanceReplay::StartRecording)
+        /// </summary>
+        Nullable<String> ReplayRecord;
+
+        /// <summary>
+        /// -replay !path! (replays the recorded input, saves the performance report and exits the application, see PerformanceReplay::StartReplay)
+        /// </summary>
+        Nullable<String> Replay;
+
+        /// <summary>
+        /// -replayreport !path! (the output path for the performance replay report, defaults to the replay path with .json extension)
+        /// </summary>
+        Nullable<String> ReplayReport;
+
+        /// <summary>
+        /// -replaybudget !ms! (the frame time budget in milliseconds for the 95th percentile of the replay frame times, exits with the error code if exceeded, see PerformanceReplay::FrameBudgetMs)
+        /// </summary>
+        Nullable<String> ReplayBudget;
+
 #if USE_EDITOR
 
         /// <summary>
@@ -169,11 +224,30 @@ class CommandLine
         /// </summary>
         Nullable<bool> ShaderDebug;
 
+        /// <summary>
+        /// -shadercache !path! (shared shaders cache directory, eg. network location used by the team or build machines to reuse the compiled shaders)
+        /// </summary>
+        Nullable<String> ShaderCache;
+
         /// <summary>
         /// -play !guid! ( Scene to play, can be empty to use default )
         /// </summary>
         Nullable<String> Play;
 
+#if FLAX_BENCHMARKS
+
+        /// <summary>
+        /// -benchmark !filter! (runs only the benchmarks which name contains the given text)
+        /// </summary>
+        Nullable<String> Benchmark;
+
+        /// <summary>
+        /// -benchmarkout !path! (output file path for the benchmarks results in JSON format)
+        /// </summary>
+        Nullable<String> BenchmarkOut;
+
+#endif
+
 #endif
     };
 
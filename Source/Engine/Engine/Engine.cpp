@@ -7,6 +7,7 @@
 #include "Globals.h"
 #include "EngineService.h"
 #include "Application.h"
+#include "RenderThread.h"
 #include "FlaxEngine.Gen.h"
 #include "Engine/Core/Core.h"
 #include "Engine/Core/Log.h"
@@ -20,6 +21,7 @@
 #include "Engine/Threading/MainThreadTask.h"
 #include "Engine/Threading/ThreadRegistry.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Content/JsonAsset.h"
@@ -74,6 +76,7 @@ int32 Engine::Main(const Char* cmdLine)
 {
     EngineImpl::CommandLine = cmdLine;
     Globals::MainThreadID = Platform::GetCurrentThreadID();
+    Globals::RenderThreadID = Globals::MainThreadID;
     StartupTime = DateTime::Now();
 
     EngineService::Sort();
@@ -91,6 +94,15 @@ int32 Engine::Main(const Char* cmdLine)
     CommandLine::Options.Mute = true;
     CommandLine::Options.Std = true;
 #endif
+#if PLATFORM_HAS_HEADLESS_MODE
+    if (CommandLine::Options.Server.IsTrue())
+    {
+        // Configure engine for dedicated server (no window, rendering and audio output)
+        CommandLine::Options.Headless = true;
+        CommandLine::Options.Null = true;
+        CommandLine::Options.Mute = true;
+    }
+#endif
 
     if (Platform::Init())
     {
@@ -151,6 +163,16 @@ int32 Engine::Main(const Char* cmdLine)
 #endif
     Log::Logger::WriteFloor();
     LOG_FLUSH();
+    const bool isServer = IsServer();
+    if (isServer)
+    {
+        // Dedicated server ticks the simulation at the fixed rate (frame drawing only flushes the GPU resources tasks on Null backend)
+        if (Time::UpdateFPS <= ZeroTolerance)
+            Time::UpdateFPS = 60.0f;
+        Time::DrawFPS = Time::UpdateFPS;
+        Time::SetFixedDeltaTime(true, 1.0f / Time::UpdateFPS);
+        LOG(Info, "Running as dedicated server at {0} ticks per second.", Time::UpdateFPS);
+    }
     Time::OnBeforeRun();
     EngineImpl::IsReady = true;
 
@@ -168,7 +190,9 @@ int32 Engine::Main(const Char* cmdLine)
             if (timeToTick > 0.002)
             {
                 PROFILE_CPU_NAMED("Idle");
-                Platform::Sleep(1);
+
+                // Dedicated server sleeps until the next tick at once to reduce the CPU usage of the idle instances
+                Platform::Sleep(isServer ? (int32)((timeToTick - 0.001) * 1000.0) : 1);
             }
         }
 
@@ -190,6 +214,10 @@ int32 Engine::Main(const Char* cmdLine)
         if (Time::OnBeginUpdate())
         {
             OnUpdate();
+
+            // Wait for the previous frame drawing (when using pipelined rendering) because late update removes objects, unloads assets and changes scenes
+            RenderThread::Wait();
+
             OnLateUpdate();
             Time::OnEndUpdate();
         }
@@ -204,7 +232,12 @@ int32 Engine::Main(const Char* cmdLine)
         // Draw frame
         if (Time::OnBeginDraw())
         {
-            OnDraw();
+            // Pipelined rendering draws the frame on the render thread while the main thread simulates the next one
+            if (!Graphics::EnablePipelinedRendering || RenderThread::Kick())
+            {
+                RenderThread::Wait();
+                OnDraw();
+            }
             Time::OnEndDraw();
             FrameMark;
         }
@@ -370,6 +403,15 @@ bool Engine::IsHeadless()
 #endif
 }
 
+bool Engine::IsServer()
+{
+#if PLATFORM_HAS_HEADLESS_MODE
+    return CommandLine::Options.Server.IsTrue();
+#else
+    return false;
+#endif
+}
+
 bool Engine::IsReady()
 {
     return EngineImpl::IsReady;
@@ -434,6 +476,7 @@ bool Engine::HasGameViewportFocus()
 void Engine::OnPause()
 {
     LOG(Info, "App paused");
+    RenderThread::Wait();
     Pause();
 
     RenderTargetPool::Flush(true);
@@ -453,6 +496,7 @@ void Engine::OnExit()
 
     // Start disposing process
     EngineImpl::IsReady = false;
+    RenderThread::Dispose();
 
     // Collect physics simulation results because we cannot exit with physics running
     Physics::CollectResults();
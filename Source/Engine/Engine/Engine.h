@@ -122,6 +122,9 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Engine);
     // Returns true if engine is running without main window (aka headless mode).
     API_PROPERTY() static bool IsHeadless();
 
+    // Returns true if engine is running as a dedicated server (headless mode without rendering and audio, see -server command line switch).
+    API_PROPERTY() static bool IsServer();
+
     // True if Engine is ready to work (init and not disposing)
     static bool IsReady();
 
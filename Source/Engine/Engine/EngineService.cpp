@@ -1,9 +1,13 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "EngineService.h"
+#include "Engine.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 #include <ThirdParty/tracy/Tracy.h>
 
 static bool CompareEngineServices(EngineService* const& a, EngineService* const& b)
@@ -11,6 +15,47 @@ static bool CompareEngineServices(EngineService* const& a, EngineService* const&
     return a->Order < b->Order;
 }
 
+static bool CompareEngineServicesInitTime(EngineService* const& a, EngineService* const& b)
+{
+    return a->InitTime > b->InitTime;
+}
+
+static EngineService* FindEngineService(const Char* name)
+{
+    for (EngineService* service : EngineService::GetServices())
+    {
+        if (StringUtils::Compare(service->Name, name) == 0)
+            return service;
+    }
+    return nullptr;
+}
+
+static bool InitEngineService(EngineService* service)
+{
+    ZoneScoped;
+    const StringView name(service->Name);
+#if TRACY_ENABLE
+    Char nameBuffer[100];
+    int32 nameBufferLength = 0;
+    for (int32 j = 0; j < name.Length() && nameBufferLength < ARRAY_COUNT(nameBuffer) - 7; j++)
+        if (name[j] != ' ')
+            nameBuffer[nameBufferLength++] = name[j];
+    Platform::MemoryCopy(nameBuffer + nameBufferLength, TEXT("::Init"), 7 * sizeof(Char));
+    nameBufferLength += 7;
+    ZoneName(nameBuffer, nameBufferLength);
+#endif
+#if COMPILE_WITH_PROFILER
+    const int32 profilerEvent = ProfilerCPU::BeginEvent(ProfilerCPU::InternName(String::Format(TEXT("{0}::Init"), name)));
+#endif
+    service->InitStartTime = Platform::GetTimeSeconds();
+    const bool failed = service->Init();
+    service->InitTime = Platform::GetTimeSeconds() - service->InitStartTime;
+#if COMPILE_WITH_PROFILER
+    ProfilerCPU::EndEvent(profilerEvent);
+#endif
+    return failed;
+}
+
 #define DEFINE_ENGINE_SERVICE_EVENT(name) \
     void EngineService::name() { } \
     void EngineService::On##name() \
@@ -59,6 +104,12 @@ EngineService::EngineService(const Char* name, int32 order)
         Sort();
 }
 
+void EngineService::AddDependency(const Char* name)
+{
+    ASSERT(DependenciesCount < ARRAY_COUNT(Dependencies));
+    Dependencies[DependenciesCount++] = name;
+}
+
 bool EngineService::Init()
 {
     return false;
@@ -71,32 +122,75 @@ void EngineService::OnInit()
 
     // Init services from front to back
     auto& services = GetServices();
-#if TRACY_ENABLE
-    Char nameBuffer[100];
-#endif
+    const double startTime = Platform::GetTimeSeconds();
+    const bool isServer = Engine::IsServer();
     for (int32 i = 0; i < services.Count(); i++)
     {
         const auto service = services[i];
         const StringView name(service->Name);
-#if TRACY_ENABLE
-        ZoneScoped;
-        int32 nameBufferLength = 0;
-        for (int32 j = 0; j < name.Length(); j++)
-            if (name[j] != ' ')
-                nameBuffer[nameBufferLength++] = name[j];
-        Platform::MemoryCopy(nameBuffer + nameBufferLength, TEXT("::Init"), 7 * sizeof(Char));
-        nameBufferLength += 7;
-        ZoneName(nameBuffer, nameBufferLength);
-#endif
-        LOG(Info, "Initialize {0}...", name);
+        if (service->RenderOnly && isServer)
+        {
+            // Remove from the services to skip events
+            LOG(Info, "Skip {0} (server)", name);
+            services.RemoveAt(i--);
+            continue;
+        }
         service->IsInitialized = true;
-        if (service->Init())
+        if (service->ParallelInit && JobSystem::GetThreadsCount() > 0)
+        {
+            // Init on a job thread (after the dependencies that are still initialized in parallel)
+            int64 dependencies[ARRAY_COUNT(Dependencies)];
+            int32 dependenciesCount = 0;
+            for (int32 j = 0; j < service->DependenciesCount; j++)
+            {
+                const EngineService* dependency = FindEngineService(service->Dependencies[j]);
+                if (dependency && dependency->InitLabel != 0)
+                    dependencies[dependenciesCount++] = dependency->InitLabel;
+            }
+            LOG(Info, "Initialize {0} (parallel)...", name);
+            service->InitLabel = JobSystem::Dispatch([service](int32)
+            {
+                if (InitEngineService(service))
+                    Platform::AtomicStore(&service->InitFailed, 1);
+            }, Span<int64>(dependencies, dependenciesCount));
+        }
+        else
         {
-            Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), name));
+            for (int32 j = 0; j < service->DependenciesCount; j++)
+            {
+                const EngineService* dependency = FindEngineService(service->Dependencies[j]);
+                if (dependency && dependency->InitLabel != 0)
+                {
+                    JobSystem::Wait(dependency->InitLabel);
+                    if (Platform::AtomicRead(&dependency->InitFailed) != 0)
+                        Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), dependency->Name));
+                }
+            }
+            LOG(Info, "Initialize {0}...", name);
+            if (InitEngineService(service))
+                Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), name));
         }
     }
 
-    LOG(Info, "Engine services are ready!");
+    // Wait for the services initialized in parallel
+    for (int32 i = 0; i < services.Count(); i++)
+    {
+        const auto service = services[i];
+        if (service->InitLabel == 0)
+            continue;
+        JobSystem::Wait(service->InitLabel);
+        service->InitLabel = 0;
+        if (Platform::AtomicRead(&service->InitFailed) != 0)
+            Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), service->Name));
+    }
+
+    // Log the slowest services
+    EngineServicesArray sorted(services);
+    Sorting::QuickSort(sorted.Get(), sorted.Count(), &CompareEngineServicesInitTime);
+    StringBuilder text;
+    for (int32 i = 0; i < sorted.Count() && sorted[i]->InitTime >= 0.001; i++)
+        text.AppendFormat(TEXT("\n  {0} ms: {1}{2}"), (float)((int32)(sorted[i]->InitTime * 10000.0) / 10.0), sorted[i]->Name, sorted[i]->ParallelInit ? TEXT(" (parallel)") : TEXT(""));
+    LOG(Info, "Engine services are ready in {0} ms!{1}", (int32)((Platform::GetTimeSeconds() - startTime) * 1000.0), text.ToStringView());
 }
 
 void EngineService::Dispose()
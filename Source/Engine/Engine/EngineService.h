@@ -27,11 +27,21 @@ class EngineService
 private:
 
     bool IsInitialized = false;
+    volatile int64 InitFailed = 0;
+    int64 InitLabel = 0;
+    int32 DependenciesCount = 0;
+    const Char* Dependencies[8];
 
 protected:
 
     EngineService(const Char* name, int32 order = 0);
 
+    /// <summary>
+    /// Adds the dependency on the other service that has to be initialized before this one. Required only for the dependencies that can initialize in parallel (see ParallelInit) since other services are initialized in order.
+    /// </summary>
+    /// <param name="name">The name of the service.</param>
+    void AddDependency(const Char* name);
+
 public:
 
     virtual ~EngineService() = default;
@@ -39,6 +49,26 @@ class EngineService
     const Char* Name;
     int32 Order;
 
+    /// <summary>
+    /// True if the service can be initialized on a job system thread in parallel with the following services. The services initialized later that use it have to declare it via AddDependency. All services are initialized before the engine starts.
+    /// </summary>
+    bool ParallelInit = false;
+
+    /// <summary>
+    /// True if the service is used only for the rendering (eg. 2D rendering or resources streaming) and can be skipped on a dedicated server (see Engine::IsServer). Skipped services are not initialized and don't receive any events.
+    /// </summary>
+    bool RenderOnly = false;
+
+    /// <summary>
+    /// The service initialization start time (in seconds, see Platform::GetTimeSeconds).
+    /// </summary>
+    double InitStartTime = 0.0;
+
+    /// <summary>
+    /// The service initialization duration (in seconds).
+    /// </summary>
+    double InitTime = 0.0;
+
 #define DECLARE_ENGINE_SERVICE_EVENT(result, name) virtual result name(); static void On##name();
     DECLARE_ENGINE_SERVICE_EVENT(bool, Init);
     DECLARE_ENGINE_SERVICE_EVENT(void, FixedUpdate);
@@ -20,6 +20,7 @@ bool Globals::FatalErrorOccurred;
 bool Globals::IsRequestingExit;
 int32 Globals::ExitCode;
 uint64 Globals::MainThreadID;
+uint64 Globals::RenderThreadID;
 String Globals::EngineVersion(TEXT(FLAXENGINE_VERSION_TEXT));
 int32 Globals::EngineBuildNumber = FLAXENGINE_VERSION_BUILD;
 String Globals::ProductName;
@@ -68,6 +68,9 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Globals);
     // Main Engine thread id
     API_FIELD(ReadOnly) static uint64 MainThreadID;
 
+    // Engine thread id that draws the frames (the same as main thread id unless pipelined rendering is active)
+    API_FIELD(ReadOnly) static uint64 RenderThreadID;
+
     // Config
 
     /// <summary>
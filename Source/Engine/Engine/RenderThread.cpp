@@ -0,0 +1,138 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "RenderThread.h"
+#include "Engine.h"
+#include "Globals.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Platform/ConditionVariable.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/IRunnable.h"
+#include "Engine/Threading/Threading.h"
+#include "Engine/Scripting/ManagedCLR/MCore.h"
+#if USE_MONO
+#include "Engine/Scripting/ManagedCLR/MDomain.h"
+#include <ThirdParty/mono-2.0/mono/metadata/appdomain.h>
+#include <ThirdParty/mono-2.0/mono/metadata/threads.h>
+#endif
+
+class RenderThreadRunnable : public IRunnable
+{
+public:
+    // [IRunnable]
+    String ToString() const override
+    {
+        return TEXT("RenderThread");
+    }
+
+    int32 Run() override;
+};
+
+namespace RenderThreadImpl
+{
+    RenderThreadRunnable Runnable;
+    Thread* RenderingThread = nullptr;
+    CriticalSection Locker;
+    ConditionVariable KickSignal;
+    ConditionVariable DoneSignal;
+    bool FramePending = false;
+    bool ExitFlag = false;
+}
+
+using namespace RenderThreadImpl;
+
+int32 RenderThreadRunnable::Run()
+{
+    Locker.Lock();
+    while (true)
+    {
+        while (!FramePending && !ExitFlag)
+            KickSignal.Wait(Locker);
+        if (ExitFlag)
+            break;
+        Locker.Unlock();
+
+#if USE_MONO
+        // Ensure to have C# thread attached to this thead (frame drawing invokes scripting events)
+        if (!mono_domain_get())
+        {
+            const auto domain = MCore::GetActiveDomain();
+            mono_thread_attach(domain->GetNative());
+        }
+#endif
+
+        Engine::OnDraw();
+
+        Locker.Lock();
+        FramePending = false;
+        DoneSignal.NotifyAll();
+    }
+    Locker.Unlock();
+    return 0;
+}
+
+bool RenderThread::Kick()
+{
+    ASSERT(IsInMainThread());
+    if (!RenderingThread)
+    {
+        ExitFlag = false;
+        RenderingThread = Thread::Create(&Runnable, TEXT("Render Thread"), ThreadPriority::AboveNormal);
+        if (!RenderingThread)
+        {
+            LOG(Error, "Failed to create the render thread. Pipelined rendering will be disabled.");
+            return true;
+        }
+    }
+    Wait();
+
+    // Extract the rendering state of the simulated frame (the main thread will simulate the next frame during drawing)
+    {
+        PROFILE_CPU_NAMED("Extract");
+        for (Scene* scene : Level::Scenes)
+        {
+            if (scene->IsActiveInHierarchy())
+                scene->Rendering.FlushUpdates();
+        }
+        RenderTask::ExtractAll();
+    }
+
+    Locker.Lock();
+    Globals::RenderThreadID = RenderingThread->GetID();
+    FramePending = true;
+    KickSignal.NotifyOne();
+    Locker.Unlock();
+    return false;
+}
+
+void RenderThread::Wait()
+{
+    if (!RenderingThread)
+        return;
+    Locker.Lock();
+    if (FramePending)
+    {
+        PROFILE_CPU_NAMED("Wait For Render Thread");
+        while (FramePending)
+            DoneSignal.Wait(Locker);
+    }
+    Globals::RenderThreadID = Globals::MainThreadID;
+    Locker.Unlock();
+}
+
+void RenderThread::Dispose()
+{
+    if (!RenderingThread)
+        return;
+    Wait();
+    Locker.Lock();
+    ExitFlag = true;
+    KickSignal.NotifyAll();
+    Locker.Unlock();
+    RenderingThread->Join();
+    Delete(RenderingThread);
+    RenderingThread = nullptr;
+}
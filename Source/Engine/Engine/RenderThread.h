@@ -0,0 +1,31 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+
+/// <summary>
+/// The dedicated thread for frames drawing used by the pipelined rendering (see Graphics::EnablePipelinedRendering). The main thread simulates the next frame while the render thread draws the previous one.
+/// </summary>
+/// <remarks>
+/// The scene rendering state (pending actors bounds updates and render tasks cameras) is extracted on a main thread before the frame drawing starts. The main thread waits for the drawing end before the late update (objects removal, assets unloading and scenes loading) so the objects used by the frame stay valid.
+/// </remarks>
+class FLAXENGINE_API RenderThread
+{
+public:
+    /// <summary>
+    /// Waits for the previous frame drawing end, extracts the rendering state and starts drawing the frame on the render thread. Called on a main thread.
+    /// </summary>
+    /// <returns>True if failed (eg. the thread cannot be created) and the frame should be drawn on a main thread, otherwise false.</returns>
+    static bool Kick();
+
+    /// <summary>
+    /// Waits for the frame drawing end (if any). Called on a main thread.
+    /// </summary>
+    static void Wait();
+
+    /// <summary>
+    /// Waits for the frame drawing end and stops the render thread.
+    /// </summary>
+    static void Dispose();
+};
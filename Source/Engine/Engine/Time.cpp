@@ -5,6 +5,7 @@
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/Platform.h"
 #include "Engine/Core/Config/TimeSettings.h"
+#include "Engine/Level/Level.h"
 #include "Engine/Serialization/Serialization.h"
 
 namespace
@@ -52,6 +53,7 @@ void TimeSettings::Apply()
     Time::DrawFPS = DrawFPS;
     Time::TimeScale = TimeScale;
     ::MaxUpdateDeltaTime = MaxUpdateDeltaTime;
+    Level::TickGroups = TickGroups;
 }
 
 void TimeSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -61,6 +63,7 @@ void TimeSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* mo
     DESERIALIZE(DrawFPS);
     DESERIALIZE(TimeScale);
     DESERIALIZE(MaxUpdateDeltaTime);
+    DESERIALIZE(TickGroups);
 }
 
 void Time::TickData::OnBeforeRun(float targetFps, double currentTime)
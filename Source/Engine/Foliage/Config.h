@@ -16,6 +16,12 @@ struct FoliageInstance;
 // Enables using manual draw calls batching instead of using automated generic solution in RenderList. Boosts performance for large foliage.
 #define FOLIAGE_USE_DRAW_CALLS_BATCHING 1
 
+// Enables using GPU-driven instancing for foliage (instances culling and LOD selection on compute shaders with indirect draw calls). Used by the non-lightmapped foliage types with instanced materials, other cases use CPU draw calls batching.
+#define FOLIAGE_USE_GPU_INSTANCING (!FOLIAGE_USE_SINGLE_QUAD_TREE && FOLIAGE_USE_DRAW_CALLS_BATCHING)
+
+// The maximum amount of the visible instances of a single foliage type in a single view when using GPU-driven instancing
+#define FOLIAGE_GPU_MAX_VISIBLE_INSTANCES (1024 * 1024)
+
 // Size of the instance allocation chunks (number of instances per allocated page)
 #define FOLIAGE_INSTANCE_CHUNKS_SIZE (4096*4)
 
@@ -5,16 +5,22 @@
 #include "FoliageCluster.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Random.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Graphics/RenderTask.h"
-#if !FOLIAGE_USE_SINGLE_QUAD_TREE
 #include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/Threading.h"
+#if !FOLIAGE_USE_SINGLE_QUAD_TREE
 #if FOLIAGE_USE_DRAW_CALLS_BATCHING
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Renderer/RenderList.h"
 #endif
 #endif
+#if FOLIAGE_USE_GPU_INSTANCING
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Renderer/Utils/InstancesCulling.h"
+#endif
 #include "Engine/Level/SceneQuery.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
@@ -25,6 +31,315 @@
 #define FOLIAGE_GET_DRAW_MODES(renderContext, type) (type.DrawModes & renderContext.View.Pass & renderContext.View.GetShadowsDrawPassMask(type.ShadowsMode))
 #define FOLIAGE_CAN_DRAW(renderContext, type) (type.IsReady() && FOLIAGE_GET_DRAW_MODES(renderContext, type) != DrawPass::None && type.Model->CanBeRendered())
 
+// The maximum depth of the quad-tree built from the instances Morton codes (16 bits per axis), deeper clusters are split by the instances count
+#define FOLIAGE_CLUSTERS_BUILD_MAX_DEPTH 16
+
+// The quad-tree depth at which the clusters sub-trees are built in parallel
+#define FOLIAGE_CLUSTERS_BUILD_JOBS_DEPTH 3
+
+// The minimum amount of instances to build the clusters using Job System
+#define FOLIAGE_CLUSTERS_BUILD_JOBS_MIN_COUNT 8192
+
+namespace
+{
+    // Maps the Morton code quadrant (bit 0 for X, bit 1 for Z) to the cluster child index
+    const int32 QuadrantToChild[4] = { 0, 2, 3, 1 };
+
+    BoundingBox GetChildBounds(const BoundingBox& bounds, int32 childIndex)
+    {
+        const Vector3 min = bounds.Minimum;
+        const Vector3 max = bounds.Maximum;
+        const Vector3 size = bounds.GetSize();
+        switch (childIndex)
+        {
+        case 0:
+            return BoundingBox(min, min + size * Vector3(0.5f, 1.0f, 0.5f));
+        case 1:
+            return BoundingBox(min + size * Vector3(0.5f, 0.0f, 0.5f), max);
+        case 2:
+            return BoundingBox(min + size * Vector3(0.5f, 0.0f, 0.0f), min + size * Vector3(1.0f, 1.0f, 0.5f));
+        default:
+            return BoundingBox(min + size * Vector3(0.0f, 0.0f, 0.5f), min + size * Vector3(0.5f, 1.0f, 1.0f));
+        }
+    }
+
+    void InitChildren(FoliageCluster* cluster)
+    {
+        for (int32 i = 0; i < 4; i++)
+            cluster->Children[i]->Init(GetChildBounds(cluster->Bounds, i));
+    }
+
+    FoliageCluster* GetChildAt(FoliageCluster* cluster, const Vector3& point)
+    {
+        const Vector3 center = cluster->Children[1]->Bounds.Minimum;
+        const int32 quadrant = (point.X >= center.X ? 1 : 0) | (point.Z >= center.Z ? 2 : 0);
+        return cluster->Children[QuadrantToChild[quadrant]];
+    }
+
+    bool FindInCluster(FoliageCluster* cluster, const FoliageInstance* instance, const BoundingSphere& bounds, FoliageCluster*& result, int32& index)
+    {
+        if (cluster->Children[0])
+        {
+            for (int32 i = 0; i < 4; i++)
+            {
+                if (cluster->Children[i]->Bounds.Intersects(bounds) && FindInCluster(cluster->Children[i], instance, bounds, result, index))
+                    return true;
+            }
+            return false;
+        }
+        index = cluster->Instances.Find((FoliageInstance*)instance);
+        result = cluster;
+        return index != -1;
+    }
+
+    void UpdateFromChildren(FoliageCluster* cluster)
+    {
+        cluster->TotalBounds = cluster->Children[0]->TotalBounds;
+        cluster->MaxCullDistance = cluster->Children[0]->MaxCullDistance;
+        for (int32 i = 1; i < 4; i++)
+        {
+            BoundingBox::Merge(cluster->TotalBounds, cluster->Children[i]->TotalBounds, cluster->TotalBounds);
+            cluster->MaxCullDistance = Math::Max(cluster->MaxCullDistance, cluster->Children[i]->MaxCullDistance);
+        }
+        BoundingSphere::FromBox(cluster->TotalBounds, cluster->TotalBoundsSphere);
+    }
+
+    uint32 MortonPart1By1(uint32 x)
+    {
+        x &= 0x0000ffff;
+        x = (x | (x << 8)) & 0x00ff00ff;
+        x = (x | (x << 4)) & 0x0f0f0f0f;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        return x;
+    }
+
+    // Bulk clusters quad-tree builder. Sorts instances by the Morton code of their location (on XZ plane) so every cluster covers a continuous range of the sorted instances, then builds the sub-trees in parallel (bottom-up bounds update).
+    struct ClustersBuilder
+    {
+        struct Task
+        {
+            FoliageCluster* Cluster;
+            int32 Start;
+            int32 End;
+            int32 Depth;
+            int32 FirstIndex;
+            int32 Count;
+        };
+
+        ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_SIZE>* Clusters;
+        BoundingBox Bounds;
+        Array<FoliageInstance*> Instances;
+        Array<uint32> Codes[2];
+        Array<int32> Indices[2];
+        uint32* SortedCodes;
+        int32* SortedIndices;
+        Array<Task> Tasks;
+        Array<FoliageCluster*> TopClusters;
+
+        void Build(ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_SIZE>& clusters, FoliageCluster*& root, const BoundingBox& bounds)
+        {
+            PROFILE_CPU();
+            Clusters = &clusters;
+            Bounds = bounds;
+            clusters.Resize(1);
+            root = &clusters[0];
+            root->Init(bounds);
+            const int32 count = Instances.Count();
+            if (count == 0)
+            {
+                root->UpdateTotalBoundsAndCullDistance();
+                return;
+            }
+            const bool useJobs = count >= FOLIAGE_CLUSTERS_BUILD_JOBS_MIN_COUNT && IsInMainThread();
+            const int32 jobsCount = useJobs ? JobSystem::GetThreadsCount() : 1;
+
+            // Compute the instances Morton codes and sort them
+            for (int32 i = 0; i < 2; i++)
+            {
+                Codes[i].Resize(count);
+                Indices[i].Resize(count);
+            }
+            if (jobsCount > 1)
+            {
+                Function<void(int32)> func;
+                func.Bind<ClustersBuilder, &ClustersBuilder::CodesJob>(this);
+                JobSystem::Execute(func, jobsCount);
+            }
+            else
+            {
+                ComputeCodes(0, count);
+            }
+            SortedCodes = Codes[0].Get();
+            SortedIndices = Indices[0].Get();
+            Sorting::RadixSortParallel(SortedCodes, SortedIndices, Codes[1].Get(), Indices[1].Get(), count);
+
+            // Build the top levels of the tree
+            BuildTop(root, 0, count, 0);
+
+            // Count the clusters of all sub-trees to allocate them at once
+            if (jobsCount > 1 && Tasks.Count() > 1)
+            {
+                Function<void(int32)> func;
+                func.Bind<ClustersBuilder, &ClustersBuilder::CountJob>(this);
+                JobSystem::Execute(func, Tasks.Count());
+            }
+            else
+            {
+                for (int32 i = 0; i < Tasks.Count(); i++)
+                    CountJob(i);
+            }
+            int32 clustersCount = clusters.Count();
+            for (Task& task : Tasks)
+            {
+                task.FirstIndex = clustersCount;
+                clustersCount += task.Count;
+            }
+            clusters.Resize(clustersCount);
+
+            // Build sub-trees
+            if (jobsCount > 1 && Tasks.Count() > 1)
+            {
+                Function<void(int32)> func;
+                func.Bind<ClustersBuilder, &ClustersBuilder::BuildJob>(this);
+                JobSystem::Execute(func, Tasks.Count());
+            }
+            else
+            {
+                for (int32 i = 0; i < Tasks.Count(); i++)
+                    BuildJob(i);
+            }
+
+            // Update the top levels bounds (children are before parents)
+            for (FoliageCluster* cluster : TopClusters)
+                UpdateFromChildren(cluster);
+        }
+
+        void ComputeCodes(int32 start, int32 end)
+        {
+            const Float3 min = Bounds.Minimum;
+            const Float3 size = Bounds.GetSize();
+            const float scaleX = size.X > ZeroTolerance ? 65536.0f / size.X : 0.0f;
+            const float scaleZ = size.Z > ZeroTolerance ? 65536.0f / size.Z : 0.0f;
+            for (int32 i = start; i < end; i++)
+            {
+                const Float3 center = Instances.Get()[i]->Bounds.Center;
+                const uint32 x = (uint32)Math::Clamp((center.X - min.X) * scaleX, 0.0f, 65535.0f);
+                const uint32 z = (uint32)Math::Clamp((center.Z - min.Z) * scaleZ, 0.0f, 65535.0f);
+                Codes[0].Get()[i] = MortonPart1By1(x) | (MortonPart1By1(z) << 1);
+                Indices[0].Get()[i] = i;
+            }
+        }
+
+        void CodesJob(int32 i)
+        {
+            const int32 count = Instances.Count();
+            const int32 perJob = Math::DivideAndRoundUp(count, JobSystem::GetThreadsCount());
+            ComputeCodes(Math::Min(i * perJob, count), Math::Min((i + 1) * perJob, count));
+        }
+
+        void Split(int32 start, int32 end, int32 depth, int32 splits[5]) const
+        {
+            splits[0] = start;
+            splits[4] = end;
+            if (depth < FOLIAGE_CLUSTERS_BUILD_MAX_DEPTH)
+            {
+                // Find the ranges of the quadrants (codes within the cluster have the same prefix)
+                const uint32 shift = 2 * (FOLIAGE_CLUSTERS_BUILD_MAX_DEPTH - 1 - depth);
+                for (uint32 quadrant = 1; quadrant < 4; quadrant++)
+                {
+                    int32 low = splits[quadrant - 1], high = end;
+                    while (low < high)
+                    {
+                        const int32 mid = (low + high) / 2;
+                        if (((SortedCodes[mid] >> shift) & 3) < quadrant)
+                            low = mid + 1;
+                        else
+                            high = mid;
+                    }
+                    splits[quadrant] = low;
+                }
+            }
+            else
+            {
+                // Instances at the same location so split them by count
+                const int32 count = end - start;
+                for (int32 quadrant = 1; quadrant < 4; quadrant++)
+                    splits[quadrant] = start + count * quadrant / 4;
+            }
+        }
+
+        int32 CountClusters(int32 start, int32 end, int32 depth) const
+        {
+            if (end - start <= FOLIAGE_CLUSTER_CAPACITY)
+                return 0;
+            int32 splits[5];
+            Split(start, end, depth, splits);
+            int32 result = 4;
+            for (int32 quadrant = 0; quadrant < 4; quadrant++)
+                result += CountClusters(splits[quadrant], splits[quadrant + 1], depth + 1);
+            return result;
+        }
+
+        void BuildTop(FoliageCluster* cluster, int32 start, int32 end, int32 depth)
+        {
+            if (end - start <= FOLIAGE_CLUSTER_CAPACITY || depth == FOLIAGE_CLUSTERS_BUILD_JOBS_DEPTH)
+            {
+                auto& task = Tasks.AddOne();
+                task.Cluster = cluster;
+                task.Start = start;
+                task.End = end;
+                task.Depth = depth;
+                return;
+            }
+            const int32 index = Clusters->Count();
+            Clusters->Resize(index + 4);
+            for (int32 i = 0; i < 4; i++)
+                cluster->Children[i] = &(*Clusters)[index + i];
+            InitChildren(cluster);
+            int32 splits[5];
+            Split(start, end, depth, splits);
+            for (int32 quadrant = 0; quadrant < 4; quadrant++)
+                BuildTop(cluster->Children[QuadrantToChild[quadrant]], splits[quadrant], splits[quadrant + 1], depth + 1);
+            TopClusters.Add(cluster);
+        }
+
+        void BuildCluster(FoliageCluster* cluster, int32 start, int32 end, int32 depth, int32& nextIndex)
+        {
+            if (end - start <= FOLIAGE_CLUSTER_CAPACITY)
+            {
+                for (int32 i = start; i < end; i++)
+                    cluster->Instances.Add(Instances.Get()[SortedIndices[i]]);
+                cluster->UpdateTotalBoundsAndCullDistance();
+                return;
+            }
+            for (int32 i = 0; i < 4; i++)
+                cluster->Children[i] = &(*Clusters)[nextIndex + i];
+            nextIndex += 4;
+            InitChildren(cluster);
+            int32 splits[5];
+            Split(start, end, depth, splits);
+            for (int32 quadrant = 0; quadrant < 4; quadrant++)
+                BuildCluster(cluster->Children[QuadrantToChild[quadrant]], splits[quadrant], splits[quadrant + 1], depth + 1, nextIndex);
+            UpdateFromChildren(cluster);
+        }
+
+        void CountJob(int32 i)
+        {
+            Task& task = Tasks[i];
+            task.Count = CountClusters(task.Start, task.End, task.Depth);
+        }
+
+        void BuildJob(int32 i)
+        {
+            Task& task = Tasks[i];
+            int32 nextIndex = task.FirstIndex;
+            BuildCluster(task.Cluster, task.Start, task.End, task.Depth, nextIndex);
+            ASSERT(nextIndex == task.FirstIndex + task.Count);
+        }
+    };
+}
+
 Foliage::Foliage(const SpawnParams& params)
     : Actor(params)
 {
@@ -74,15 +389,7 @@ void Foliage::AddToCluster(ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_S
         cluster->Children[1] = &clusters[count + 1];
         cluster->Children[2] = &clusters[count + 2];
         cluster->Children[3] = &clusters[count + 3];
-
-        // Setup children
-        const Vector3 min = cluster->Bounds.Minimum;
-        const Vector3 max = cluster->Bounds.Maximum;
-        const Vector3 size = cluster->Bounds.GetSize();
-        cluster->Children[0]->Init(BoundingBox(min, min + size * Vector3(0.5f, 1.0f, 0.5f)));
-        cluster->Children[1]->Init(BoundingBox(min + size * Vector3(0.5f, 0.0f, 0.5f), max));
-        cluster->Children[2]->Init(BoundingBox(min + size * Vector3(0.5f, 0.0f, 0.0f), min + size * Vector3(1.0f, 1.0f, 0.5f)));
-        cluster->Children[3]->Init(BoundingBox(min + size * Vector3(0.0f, 0.0f, 0.5f), min + size * Vector3(0.5f, 1.0f, 1.0f)));
+        InitChildren(cluster);
 
         // Move instances to a proper cells
         for (int32 i = 0; i < cluster->Instances.Count(); i++)
@@ -94,6 +401,147 @@ void Foliage::AddToCluster(ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_S
     }
 }
 
+#if FOLIAGE_USE_SINGLE_QUAD_TREE
+#define FOLIAGE_GET_CLUSTERS(instance) auto& clusters = Clusters; FoliageCluster*& root = Root
+#else
+#define FOLIAGE_GET_CLUSTERS(instance) auto& clusters = FoliageTypes[instance.Type].Clusters; FoliageCluster*& root = FoliageTypes[instance.Type].Root
+#endif
+
+bool Foliage::InsertToClusters(FoliageInstance& instance)
+{
+    const FoliageType& type = FoliageTypes[instance.Type];
+    const float densityScale = type.UseDensityScaling ? GetGlobalDensityScale() * type.DensityScalingScale : 1.0f;
+    if (!type.IsReady() || instance.Random >= densityScale)
+        return false;
+    FOLIAGE_GET_CLUSTERS(instance);
+    if (!root)
+        return true;
+    const Vector3 center = instance.Bounds.Center;
+    const Real radius = instance.Bounds.Radius;
+
+    // Grow the clusters vertically (all clusters share the same vertical range, grow more to reduce the following updates)
+    BoundingBox rootBounds = root->Bounds;
+    if (center.Y - radius < rootBounds.Minimum.Y || center.Y + radius > rootBounds.Maximum.Y)
+    {
+        const Real margin = Math::Max(rootBounds.GetSize().Y, radius);
+        const Real minY = Math::Min(rootBounds.Minimum.Y, center.Y - radius - margin);
+        const Real maxY = Math::Max(rootBounds.Maximum.Y, center.Y + radius + margin);
+        for (auto i = clusters.Begin(); i.IsNotEnd(); ++i)
+        {
+            i->Bounds.Minimum.Y = minY;
+            i->Bounds.Maximum.Y = maxY;
+        }
+    }
+
+    // Grow the quad-tree horizontally by adding the parent cluster (current root becomes one of its children)
+    for (int32 iteration = 0; ; iteration++)
+    {
+        rootBounds = root->Bounds;
+        const bool outsideX = center.X < rootBounds.Minimum.X || center.X > rootBounds.Maximum.X;
+        const bool outsideZ = center.Z < rootBounds.Minimum.Z || center.Z > rootBounds.Maximum.Z;
+        if (!outsideX && !outsideZ)
+            break;
+        if (iteration == 32)
+            return true;
+        const Vector3 size = rootBounds.GetSize();
+        const bool negativeX = center.X < rootBounds.Minimum.X;
+        const bool negativeZ = center.Z < rootBounds.Minimum.Z;
+        BoundingBox bounds = rootBounds;
+        if (negativeX)
+            bounds.Minimum.X -= size.X;
+        else
+            bounds.Maximum.X += size.X;
+        if (negativeZ)
+            bounds.Minimum.Z -= size.Z;
+        else
+            bounds.Maximum.Z += size.Z;
+        const int32 rootChild = QuadrantToChild[(negativeX ? 1 : 0) | (negativeZ ? 2 : 0)];
+        const int32 index = clusters.Count();
+        clusters.Resize(index + 4);
+        FoliageCluster* parent = &clusters[index];
+        parent->Init(bounds);
+        for (int32 i = 0, j = 1; i < 4; i++)
+        {
+            if (i == rootChild)
+            {
+                parent->Children[i] = root;
+                continue;
+            }
+            FoliageCluster* child = &clusters[index + j++];
+            child->Init(GetChildBounds(bounds, i));
+            child->UpdateTotalBoundsAndCullDistance();
+            parent->Children[i] = child;
+        }
+        UpdateFromChildren(parent);
+        root = parent;
+    }
+
+    // Find the target cluster and update the cached bounds on the way
+    BoundingBox box;
+    BoundingBox::FromSphere(instance.Bounds, box);
+    FoliageCluster* cluster = root;
+    while (true)
+    {
+        BoundingBox::Merge(cluster->TotalBounds, box, cluster->TotalBounds);
+        BoundingSphere::FromBox(cluster->TotalBounds, cluster->TotalBoundsSphere);
+        cluster->MaxCullDistance = Math::Max(cluster->MaxCullDistance, instance.CullDistance);
+        if (!cluster->Children[0])
+            break;
+        cluster = GetChildAt(cluster, center);
+    }
+    if (cluster->Instances.Count() != FOLIAGE_CLUSTER_CAPACITY)
+    {
+        cluster->Instances.Add(&instance);
+    }
+    else
+    {
+        // Subdivide cluster
+        AddToCluster(clusters, cluster, instance);
+        cluster->UpdateTotalBoundsAndCullDistance();
+    }
+
+    // Update bounds of the foliage
+    BoundingBox::Merge(_box, box, _box);
+    BoundingSphere::FromBox(_box, _sphere);
+    if (_sceneRenderingKey != -1)
+        GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
+#if FOLIAGE_USE_GPU_INSTANCING
+    FoliageTypes[instance.Type]._gpuInstancesDirty = 1;
+#endif
+    return false;
+}
+
+void Foliage::RemoveFromClusters(FoliageInstance& instance)
+{
+    FOLIAGE_GET_CLUSTERS(instance);
+    FoliageCluster* cluster;
+    int32 index;
+    if (root && root->Bounds.Intersects(instance.Bounds) && FindInCluster(root, &instance, instance.Bounds, cluster, index))
+    {
+        // Cached bounds of the clusters are left as-is (conservative)
+        cluster->Instances.RemoveAt(index);
+#if FOLIAGE_USE_GPU_INSTANCING
+        FoliageTypes[instance.Type]._gpuInstancesDirty = 1;
+#endif
+    }
+}
+
+void Foliage::MoveInClusters(FoliageInstance& from, FoliageInstance& to)
+{
+    FOLIAGE_GET_CLUSTERS(from);
+    FoliageCluster* cluster;
+    int32 index;
+    if (root && root->Bounds.Intersects(from.Bounds) && FindInCluster(root, &from, from.Bounds, cluster, index))
+    {
+        cluster->Instances[index] = &to;
+#if FOLIAGE_USE_GPU_INSTANCING
+        FoliageTypes[from.Type]._gpuInstancesDirty = 1;
+#endif
+    }
+}
+
+#undef FOLIAGE_GET_CLUSTERS
+
 #if !FOLIAGE_USE_SINGLE_QUAD_TREE && FOLIAGE_USE_DRAW_CALLS_BATCHING
 
 void Foliage::DrawInstance(RenderContext& renderContext, FoliageInstance& instance, const FoliageType& type, Model* model, int32 lod, float lodDitherFactor, DrawCallsList* drawCallsLists, BatchedDrawCalls& result) const
@@ -154,7 +602,7 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
         box = cluster->Children[idx]->TotalBounds; \
         box.Minimum -= viewOrigin; \
         box.Maximum -= viewOrigin; \
-		if (renderContext.View.CullingFrustum.Intersects(box)) \
+		if (renderContext.View.CullingFrustum.Intersects(box) && !renderContext.List->IsOccluded(box)) \
 			DrawCluster(renderContext, cluster->Children[idx], type, drawCallsLists, result)
         DRAW_CLUSTER(0);
         DRAW_CLUSTER(1);
@@ -167,6 +615,7 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
         // Draw visible instances
         const auto frame = Engine::FrameCount;
         const auto model = type.Model.Get();
+        const bool useImpostor = EnumHasAnyFlags(type.DrawModes, DrawPass::GBuffer) && model->HasImpostor();
         for (int32 i = 0; i < cluster->Instances.Count(); i++)
         {
             auto& instance = *cluster->Instances.Get()[i];
@@ -210,6 +659,21 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
                 lodIndex += renderContext.View.ModelLODBias;
                 lodIndex = model->ClampLODIndex(lodIndex);
 
+                // Use impostor instead of the meshes when instance is small enough on the screen
+                if (useImpostor)
+                {
+                    Matrix world;
+                    const Transform transform = _transform.LocalToWorld(instance.Transform);
+                    Matrix::Transformation(transform.Scale, transform.Orientation, transform.Translation - viewOrigin, world);
+                    if (model->DrawImpostor(renderContext, world))
+                    {
+                        instance.DrawState.PrevLOD = lodIndex;
+                        instance.DrawState.LODTransition = 255;
+                        instance.DrawState.PrevFrame = frame;
+                        continue;
+                    }
+                }
+
                 // Check if it's the new frame and could update the drawing state (note: model instance could be rendered many times per frame to different viewports)
                 if (modelFrame == frame)
                 {
@@ -261,7 +725,222 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
     }
 }
 
-#else
+#endif
+
+#if FOLIAGE_USE_GPU_INSTANCING
+
+bool Foliage::UpdateGPUInstances(FoliageType& type)
+{
+    if (!type._gpuInstancesDirty)
+        return type._gpuInstances != nullptr;
+    PROFILE_CPU();
+    type._gpuInstancesDirty = 0;
+
+    // Write instances of the leaf clusters in the quad-tree order so every cluster can be culled as a single range
+    Array<InstancesCulling::CullingInstance> data;
+    Array<FoliageCluster*, InlinedAllocation<64>> stack;
+    if (type.Root)
+        stack.Add(type.Root);
+    const Vector3 origin = _transform.Translation;
+    Array<Transform, InlinedAllocation<FOLIAGE_CLUSTER_CAPACITY>> transforms;
+    while (stack.HasItems())
+    {
+        FoliageCluster* cluster = stack.Pop();
+        if (cluster->Children[0])
+        {
+            stack.Add(cluster->Children[3]);
+            stack.Add(cluster->Children[2]);
+            stack.Add(cluster->Children[1]);
+            stack.Add(cluster->Children[0]);
+            continue;
+        }
+        cluster->GPUInstancesStart = data.Count();
+        const int32 count = cluster->Instances.Count();
+        if (count == 0)
+            continue;
+
+        // Compute the bounds used to quantize positions of the cluster instances (pivot can be outside the instance bounds)
+        transforms.Resize(count);
+        Float3 min = Float3::Maximum, max = Float3::Minimum;
+        for (int32 i = 0; i < count; i++)
+        {
+            const FoliageInstance& instance = *cluster->Instances.Get()[i];
+            Transform& transform = transforms[i];
+            _transform.LocalToWorld(instance.Transform, transform);
+            const Float3 translation = transform.Translation - origin;
+            const Float3 center = instance.Bounds.Center - origin;
+            min = Float3::Min(min, Float3::Min(translation, center));
+            max = Float3::Max(max, Float3::Max(translation, center));
+        }
+        cluster->GPUInstancesBoundsMin = min;
+        cluster->GPUInstancesBoundsSize = max - min;
+
+        // Write packed instances
+        for (int32 i = 0; i < count; i++)
+        {
+            const FoliageInstance& instance = *cluster->Instances.Get()[i];
+            const Transform& transform = transforms[i];
+            data.AddOne().Pack(transform.Translation - origin, transform.Orientation, transform.Scale, instance.Bounds.Center - origin, (float)instance.Bounds.Radius, instance.Random, instance.CullDistance, min, cluster->GPUInstancesBoundsSize);
+        }
+    }
+    if (data.IsEmpty())
+    {
+        SAFE_DELETE_GPU_RESOURCE(type._gpuInstances);
+        return false;
+    }
+
+    // Upload instances to the GPU
+    if (!type._gpuInstances)
+        type._gpuInstances = GPUDevice::Instance->CreateBuffer(TEXT("Foliage.Instances"));
+    auto desc = GPUBufferDescription::Structured(data.Count(), sizeof(InstancesCulling::CullingInstance));
+    desc.InitData = data.Get();
+    if (type._gpuInstances->Init(desc))
+    {
+        SAFE_DELETE_GPU_RESOURCE(type._gpuInstances);
+        return false;
+    }
+    return true;
+}
+
+namespace
+{
+    void DrawClusterGPU(RenderContext& renderContext, FoliageCluster* cluster, Array<InstancesCulling::CullingRange, RendererAllocation>& ranges, int32& instancesCount)
+    {
+        // Skip clusters that around too far from view (instances are culled on the GPU so only cluster-level culling is done here, the same way as in DrawCluster)
+        const Vector3 viewOrigin = renderContext.View.Origin;
+        if (Float3::Distance(renderContext.View.Position, cluster->TotalBoundsSphere.Center - viewOrigin) - (float)cluster->TotalBoundsSphere.Radius > cluster->MaxCullDistance)
+            return;
+
+        if (cluster->Children[0])
+        {
+            BoundingBox box;
+#define DRAW_CLUSTER(idx) \
+            box = cluster->Children[idx]->TotalBounds; \
+            box.Minimum -= viewOrigin; \
+            box.Maximum -= viewOrigin; \
+            if (renderContext.View.CullingFrustum.Intersects(box) && !renderContext.List->IsOccluded(box)) \
+                DrawClusterGPU(renderContext, cluster->Children[idx], ranges, instancesCount)
+            DRAW_CLUSTER(0);
+            DRAW_CLUSTER(1);
+            DRAW_CLUSTER(2);
+            DRAW_CLUSTER(3);
+#undef DRAW_CLUSTER
+        }
+        else if (cluster->Instances.HasItems())
+        {
+            auto& range = ranges.AddOne();
+            range.BoundsMin = cluster->GPUInstancesBoundsMin;
+            range.Start = cluster->GPUInstancesStart;
+            range.BoundsSize = cluster->GPUInstancesBoundsSize;
+            range.Count = cluster->Instances.Count();
+            instancesCount += cluster->Instances.Count();
+        }
+    }
+}
+
+bool Foliage::DrawTypeGPU(RenderContext& renderContext, const FoliageType& type, DrawPass typeDrawModes, DrawCallsList* drawCallsLists) const
+{
+    // Validate materials (GPU instancing supports only opaque draw passes with instanced shaders)
+    const Model* model = type.Model.Get();
+    const int32 lodsCount = model->LODs.Count();
+    for (int32 lod = 0; lod < lodsCount; lod++)
+    {
+        const auto& meshes = model->LODs.Get()[lod].Meshes;
+        for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++)
+        {
+            const auto material = drawCallsLists[lod][meshIndex].DrawCall.Material;
+            IMaterial::InstancingHandler handler;
+            if (material && (!material->CanUseInstancing(handler) || EnumHasAnyFlags(material->GetDrawModes() & typeDrawModes, DrawPass::Forward | DrawPass::Distortion)))
+                return false;
+        }
+    }
+
+    // Collect visible clusters
+    InstancesCulling::Request request;
+    int32 instancesCount = 0;
+    DrawClusterGPU(renderContext, type.Root, request.Ranges, instancesCount);
+    if (instancesCount == 0)
+        return true;
+
+    // Setup culling
+    Array<DrawCall, InlinedAllocation<16>> drawCalls;
+    Array<const Mesh*, InlinedAllocation<16>> drawMeshes;
+    request.Instances = type._gpuInstances;
+    request.Origin = _transform.Translation - renderContext.View.Origin;
+    request.MaxInstances = Math::Min(instancesCount, FOLIAGE_GPU_MAX_VISIBLE_INSTANCES);
+    request.LODsCount = lodsCount;
+    request.MinScreenSize = model->MinScreenSize;
+    for (int32 lod = 0; lod < lodsCount; lod++)
+    {
+        request.LODScreenSizes[lod] = model->LODs.Get()[lod].ScreenSize;
+        const auto& meshes = model->LODs.Get()[lod].Meshes;
+        for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++)
+        {
+            const auto material = drawCallsLists[lod][meshIndex].DrawCall.Material;
+            if (!material)
+                continue;
+            const Mesh& mesh = meshes.Get()[meshIndex];
+            drawMeshes.Add(&mesh);
+            auto& drawCall = drawCalls.AddOne();
+            drawCall.Material = material;
+            mesh.GetDrawCallGeometry(drawCall);
+            auto& args = request.Draws.AddOne();
+            args.IndicesCount = drawCall.Draw.IndicesCount;
+            args.InstanceCount = 0;
+            args.StartIndex = drawCall.Draw.StartIndex;
+            args.BaseVertex = 0;
+            args.StartInstance = lod;
+            drawCall.Surface.GeometrySize = mesh.GetBox().GetSize();
+        }
+    }
+    if (drawCalls.IsEmpty())
+        return true;
+    if (InstancesCulling::Instance()->Add(renderContext, request))
+        return false;
+
+    // Submit indirect draw calls of the instances written by the GPU (no LOD transitions nor motion vectors)
+    for (int32 i = 0; i < drawCalls.Count(); i++)
+    {
+        BatchedDrawCall batch;
+        batch.DrawCall = drawCalls[i];
+        const Mesh& mesh = *drawMeshes[i];
+        const auto& entry = type.Entries[mesh.GetMaterialSlotIndex()];
+        const MaterialSlot& slot = model->MaterialSlots[mesh.GetMaterialSlotIndex()];
+        const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
+        const auto drawModes = typeDrawModes & renderContext.View.GetShadowsDrawPassMask(shadowsMode) & batch.DrawCall.Material->GetDrawModes();
+        batch.InstancesBuffer = request.OutputInstances;
+        batch.DrawCall.InstanceCount = 0;
+        batch.DrawCall.Draw.IndirectArgsBuffer = request.OutputArgs;
+        batch.DrawCall.Draw.IndirectArgsOffset = INSTANCES_CULLING_ARGS_HEADER_SIZE + i * sizeof(InstancesCulling::DrawArgs);
+        batch.DrawCall.ObjectPosition = request.Origin;
+        batch.DrawCall.PerInstanceRandom = 0.0f;
+        batch.DrawCall.Surface.Lightmap = nullptr;
+        batch.DrawCall.Surface.LightmapUVsArea = Rectangle::Empty;
+        batch.DrawCall.Surface.LODDitherFactor = 0.0f;
+        batch.DrawCall.World = Matrix::Identity;
+        batch.DrawCall.World.SetRow4(Float4(request.Origin, 1.0f));
+        batch.DrawCall.Surface.PrevWorld = batch.DrawCall.World;
+        batch.DrawCall.Surface.Skinning = nullptr;
+        batch.DrawCall.WorldDeterminantSign = 1;
+        const int32 batchIndex = renderContext.List->BatchedDrawCalls.Add(MoveTemp(batch));
+        if (EnumHasAnyFlags(drawModes, DrawPass::Depth))
+        {
+            renderContext.List->DrawCallsLists[(int32)DrawCallsListType::Depth].PreBatchedDrawCalls.Add(batchIndex);
+        }
+        if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer))
+        {
+            if (entry.ReceiveDecals)
+                renderContext.List->DrawCallsLists[(int32)DrawCallsListType::GBuffer].PreBatchedDrawCalls.Add(batchIndex);
+            else
+                renderContext.List->DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals].PreBatchedDrawCalls.Add(batchIndex);
+        }
+    }
+    return true;
+}
+
+#endif
+
+#if FOLIAGE_USE_SINGLE_QUAD_TREE || !FOLIAGE_USE_DRAW_CALLS_BATCHING
 
 void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster, Mesh::DrawInfo& draw)
 {
@@ -283,7 +962,7 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
         box = cluster->Children[idx]->TotalBounds; \
         box.Minimum -= viewOrigin; \
         box.Maximum -= viewOrigin; \
-		if (renderContext.View.CullingFrustum.Intersects(box)) \
+		if (renderContext.View.CullingFrustum.Intersects(box) && !renderContext.List->IsOccluded(box)) \
 			DrawCluster(renderContext, cluster->Children[idx], draw)
         DRAW_CLUSTER(0);
         DRAW_CLUSTER(1);
@@ -401,18 +1080,24 @@ void Foliage::DrawClusterGlobalSA(GlobalSurfaceAtlasPass* globalSA, const Vector
 void Foliage::DrawFoliageJob(int32 i)
 {
     PROFILE_CPU();
-    const FoliageType& type = FoliageTypes[i];
+    FoliageType& type = FoliageTypes[i];
     if (type.IsReady() && type.Model->CanBeRendered())
     {
         DrawCallsList drawCallsLists[MODEL_MAX_LODS];
+#if FOLIAGE_USE_GPU_INSTANCING
+        // Instances lightmaps are not supported by the GPU-driven instancing
+        const bool useGPUInstancing = !EnumHasAnyFlags(_staticFlags, StaticFlags::Lightmap) && InstancesCulling::Instance()->CanUse() && !type.Model->HasImpostor() && UpdateGPUInstances(type);
+#else
+        const bool useGPUInstancing = false;
+#endif
         for (RenderContext& renderContext : _renderContextBatch->Contexts)
-            DrawType(renderContext, type, drawCallsLists);
+            DrawType(renderContext, type, drawCallsLists, useGPUInstancing);
     }
 }
 
 #endif
 
-void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists)
+void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists, bool useGPUInstancing)
 {
     if (!type.Root || !FOLIAGE_CAN_DRAW(renderContext, type))
         return;
@@ -459,6 +1144,12 @@ void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, Dr
         }
     }
 
+#if FOLIAGE_USE_GPU_INSTANCING
+    // Draw visible instances selected on the GPU
+    if (useGPUInstancing && DrawTypeGPU(renderContext, type, typeDrawModes, drawCallsLists))
+        return;
+#endif
+
     // Draw instances of the foliage type
     BatchedDrawCalls result;
     DrawCluster(renderContext, type.Root, type, drawCallsLists, result);
@@ -680,17 +1371,32 @@ void Foliage::AddInstance(const FoliageInstance& instance)
         BoundingSphere::Merge(data->Bounds, meshBounds, data->Bounds);
     }
     data->Bounds.Radius += ZeroTolerance;
+
+    // Update clusters
+    if (InsertToClusters(*data))
+        RebuildClusters();
 }
 
-void Foliage::RemoveInstance(ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE>::Iterator i)
+void Foliage::RemoveInstance(ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE, LargePageAllocation>::Iterator i)
 {
-    Instances.Remove(i);
+    const int32 index = i.Index();
+    const int32 lastIndex = Instances.Count() - 1;
+    RemoveFromClusters(Instances[index]);
+    if (index != lastIndex)
+    {
+        // Move the last instance into the removed slot (only a single instance changes the address)
+        auto& last = Instances[lastIndex];
+        MoveInClusters(last, Instances[index]);
+        Instances[index] = last;
+    }
+    Instances.Remove(Instances.IteratorAt(lastIndex));
 }
 
 void Foliage::SetInstanceTransform(int32 index, const Transform& value)
 {
     auto& instance = Instances[index];
     auto type = &FoliageTypes[instance.Type];
+    RemoveFromClusters(instance);
 
     // Change transform
     instance.Transform = value;
@@ -717,6 +1423,10 @@ void Foliage::SetInstanceTransform(int32 index, const Transform& value)
         BoundingSphere::Merge(instance.Bounds, meshBounds, instance.Bounds);
     }
     instance.Bounds.Radius += ZeroTolerance;
+
+    // Update clusters
+    if (InsertToClusters(instance))
+        RebuildClusters();
 }
 
 void Foliage::OnFoliageTypeModelLoaded(int32 index)
@@ -779,12 +1489,19 @@ void Foliage::OnFoliageTypeModelLoaded(int32 index)
     RebuildClusters();
 #else
     {
-        PROFILE_CPU_NAMED("Setup");
+        PROFILE_CPU_NAMED("Create Clusters");
 
-        // Setup first and topmost cluster
-        type.Clusters.Resize(1);
-        type.Root = &type.Clusters[0];
-        type.Root->Init(totalBoundsType);
+        // Create clusters for foliage type quad tree
+        ClustersBuilder builder;
+        const float globalDensityScale = GetGlobalDensityScale();
+        const float densityScale = type.UseDensityScaling ? globalDensityScale * type.DensityScalingScale : 1.0f;
+        for (auto i = Instances.Begin(); i.IsNotEnd(); ++i)
+        {
+            auto& instance = *i;
+            if (instance.Type == index && instance.Random < densityScale)
+                builder.Instances.Add(&instance);
+        }
+        builder.Build(type.Clusters, type.Root, totalBoundsType);
 
         // Update bounds of the foliage
         _box = totalBoundsType;
@@ -797,25 +1514,9 @@ void Foliage::OnFoliageTypeModelLoaded(int32 index)
         if (_sceneRenderingKey != -1)
             GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
     }
-    {
-        PROFILE_CPU_NAMED("Create Clusters");
-
-        // Create clusters for foliage type quad tree
-        const float globalDensityScale = GetGlobalDensityScale();
-        for (auto i = Instances.Begin(); i.IsNotEnd(); ++i)
-        {
-            auto& instance = *i;
-            const float densityScale = type.UseDensityScaling ? globalDensityScale * type.DensityScalingScale : 1.0f;
-            if (instance.Type == index && instance.Random < densityScale)
-            {
-                AddToCluster(type.Clusters, type.Root, instance);
-            }
-        }
-    }
-    {
-        PROFILE_CPU_NAMED("Update Cache");
-        type.Root->UpdateTotalBoundsAndCullDistance();
-    }
+#if FOLIAGE_USE_GPU_INSTANCING
+    type._gpuInstancesDirty = 1;
+#endif
 #endif
 }
 
@@ -837,6 +1538,9 @@ void Foliage::RebuildClusters()
         {
             type.Root = nullptr;
             type.Clusters.Clear();
+#if FOLIAGE_USE_GPU_INSTANCING
+            type._gpuInstancesDirty = 1;
+#endif
         }
 #endif
         _box = BoundingBox(_transform.Translation, _transform.Translation);
@@ -935,10 +1639,16 @@ void Foliage::RebuildClusters()
             GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
     }
 
-    // Insert all instances to the clusters
+    // Build clusters from all instances (sorted spatially and built in parallel)
     {
         PROFILE_CPU_NAMED("Create Clusters");
         const float globalDensityScale = GetGlobalDensityScale();
+#if FOLIAGE_USE_SINGLE_QUAD_TREE
+        ClustersBuilder builder;
+#else
+        Array<ClustersBuilder> builders;
+        builders.Resize(FoliageTypes.Count());
+#endif
         for (auto i = Instances.Begin(); i.IsNotEnd(); ++i)
         {
             auto& instance = *i;
@@ -948,29 +1658,26 @@ void Foliage::RebuildClusters()
             if (type.IsReady() && instance.Random < densityScale)
             {
 #if FOLIAGE_USE_SINGLE_QUAD_TREE
-                AddToCluster(Clusters, Root, instance);
+                builder.Instances.Add(&instance);
 #else
-                AddToCluster(type.Clusters, type.Root, instance);
+                builders[instance.Type].Instances.Add(&instance);
 #endif
             }
         }
-    }
-
 #if FOLIAGE_USE_SINGLE_QUAD_TREE
-    if (Root)
-    {
-        PROFILE_CPU_NAMED("Update Cache");
-        Root->UpdateTotalBoundsAndCullDistance();
-    }
+        builder.Build(Clusters, Root, Root->Bounds);
 #else
-    for (auto& type : FoliageTypes)
-    {
-        if (type.Root)
+        for (auto& type : FoliageTypes)
         {
-            PROFILE_CPU_NAMED("Update Cache");
-            type.Root->UpdateTotalBoundsAndCullDistance();
+            if (type.Root)
+                builders[type.Index].Build(type.Clusters, type.Root, type.Root->Bounds);
         }
+#endif
     }
+
+#if FOLIAGE_USE_GPU_INSTANCING
+    for (auto& type : FoliageTypes)
+        type._gpuInstancesDirty = 1;
 #endif
 }
 
@@ -1002,6 +1709,9 @@ void Foliage::UpdateCullDistance()
             PROFILE_CPU_NAMED("Clusters");
             type.Root->UpdateCullDistance();
         }
+#if FOLIAGE_USE_GPU_INSTANCING
+        type._gpuInstancesDirty = 1;
+#endif
     }
 #endif
 }
@@ -1175,6 +1885,7 @@ void Foliage::Draw(RenderContext& renderContext)
         draw.ForcedLOD = -1;
         draw.SortOrder = 0;
         draw.VertexColors = nullptr;
+        draw.DrawCache = nullptr;
         draw.Lightmap = _scene->LightmapsData.GetReadyLightmap(instance.Lightmap.TextureIndex);
         draw.LightmapUVs = &instance.Lightmap.UVsArea;
         draw.Buffer = &type.Entries;
@@ -1195,6 +1906,7 @@ void Foliage::Draw(RenderContext& renderContext)
     draw.LODBias = 0;
     draw.ForcedLOD = -1;
     draw.VertexColors = nullptr;
+    draw.DrawCache = nullptr;
 #else
     DrawCallsList drawCallsLists[MODEL_MAX_LODS];
 #endif
@@ -1204,7 +1916,7 @@ void Foliage::Draw(RenderContext& renderContext)
 #else
     for (auto& type : FoliageTypes)
     {
-        DrawType(renderContext, type, drawCallsLists);
+        DrawType(renderContext, type, drawCallsLists, false);
     }
 #endif
 }
@@ -23,7 +23,7 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     /// <summary>
     /// The allocated foliage instances. It's read-only.
     /// </summary>
-    ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE> Instances;
+    ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE, LargePageAllocation> Instances;
 
 #if FOLIAGE_USE_SINGLE_QUAD_TREE
     /// <summary>
@@ -90,14 +90,14 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     API_FUNCTION() int32 GetFoliageTypeInstancesCount(int32 index) const;
 
     /// <summary>
-    /// Adds the new foliage instance. Ensure to always call <see cref="RebuildClusters"/> after editing foliage to sync cached data (call it once after editing one or more instances).
+    /// Adds the new foliage instance. Updates the cached clusters incrementally (call <see cref="RebuildClusters"/> after editing many instances to rebuild the optimal quad-tree).
     /// </summary>
     /// <remarks>Input instance bounds, instance random and world matrix are ignored (recalculated).</remarks>
     /// <param name="instance">The instance.</param>
     API_FUNCTION() void AddInstance(API_PARAM(Ref) const FoliageInstance& instance);
 
     /// <summary>
-    /// Removes the foliage instance. Ensure to always call <see cref="RebuildClusters"/> after editing foliage to sync cached data (call it once after editing one or more instances).
+    /// Removes the foliage instance. Updates the cached clusters incrementally (call <see cref="RebuildClusters"/> after editing many instances to rebuild the optimal quad-tree).
     /// </summary>
     /// <param name="index">The zero-based index of the instance to remove.</param>
     API_FUNCTION() void RemoveInstance(int32 index)
@@ -106,13 +106,13 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     }
 
     /// <summary>
-    /// Removes the foliage instance. Ensure to always call <see cref="RebuildClusters"/> after editing foliage to sync cached data (call it once after editing one or more instances).
+    /// Removes the foliage instance. Updates the cached clusters incrementally (call <see cref="RebuildClusters"/> after editing many instances to rebuild the optimal quad-tree).
     /// </summary>
     /// <param name="i">The iterator from foliage instances that points to the instance to remove.</param>
-    void RemoveInstance(ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE>::Iterator i);
+    void RemoveInstance(ChunkedArray<FoliageInstance, FOLIAGE_INSTANCE_CHUNKS_SIZE, LargePageAllocation>::Iterator i);
 
     /// <summary>
-    /// Sets the foliage instance transformation. Ensure to always call <see cref="RebuildClusters"/> after editing foliage to sync cached data (call it once after editing one or more instances).
+    /// Sets the foliage instance transformation. Updates the cached clusters incrementally (call <see cref="RebuildClusters"/> after editing many instances to rebuild the optimal quad-tree).
     /// </summary>
     /// <param name="index">The zero-based index of the foliage instance.</param>
     /// <param name="value">The value.</param>
@@ -147,6 +147,9 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
 
 private:
     void AddToCluster(ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_SIZE>& clusters, FoliageCluster* cluster, FoliageInstance& instance);
+    bool InsertToClusters(FoliageInstance& instance);
+    void RemoveFromClusters(FoliageInstance& instance);
+    void MoveInClusters(FoliageInstance& from, FoliageInstance& to);
 #if !FOLIAGE_USE_SINGLE_QUAD_TREE && FOLIAGE_USE_DRAW_CALLS_BATCHING
     struct DrawKey
     {
@@ -181,7 +184,11 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     void DrawFoliageJob(int32 i);
     RenderContextBatch* _renderContextBatch;
 #endif
-    void DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists);
+#if FOLIAGE_USE_GPU_INSTANCING
+    bool UpdateGPUInstances(FoliageType& type);
+    bool DrawTypeGPU(RenderContext& renderContext, const FoliageType& type, DrawPass typeDrawModes, DrawCallsList* drawCallsLists) const;
+#endif
+    void DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists, bool useGPUInstancing);
 
 public:
     /// <summary>
@@ -9,6 +9,10 @@ void FoliageCluster::Init(const BoundingBox& bounds)
     Bounds = bounds;
     TotalBounds = bounds;
     MaxCullDistance = 0.0f;
+#if FOLIAGE_USE_GPU_INSTANCING
+    GPUInstancesStart = 0;
+    GPUInstancesBoundsMin = GPUInstancesBoundsSize = Float3::Zero;
+#endif
 
     Children[0] = nullptr;
     Children[1] = nullptr;
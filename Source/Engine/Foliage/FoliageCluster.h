@@ -43,6 +43,18 @@ class FLAXENGINE_API FoliageCluster
     /// </summary>
     Array<FoliageInstance*, FixedAllocation<FOLIAGE_CLUSTER_CAPACITY>> Instances;
 
+#if FOLIAGE_USE_GPU_INSTANCING
+    /// <summary>
+    /// The index of the first instance of this cluster in the foliage type GPU instances buffer (valid for leaf clusters only).
+    /// </summary>
+    int32 GPUInstancesStart;
+
+    /// <summary>
+    /// The bounds used to quantize the positions of the instances of this cluster in the foliage type GPU instances buffer (relative to the foliage actor location, valid for leaf clusters only).
+    /// </summary>
+    Float3 GPUInstancesBoundsMin, GPUInstancesBoundsSize;
+#endif
+
 public:
     /// <summary>
     /// Initializes this instance.
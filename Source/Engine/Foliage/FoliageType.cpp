@@ -4,6 +4,9 @@
 #include "Engine/Core/Collections/ArrayExtensions.h"
 #include "Engine/Core/Random.h"
 #include "Engine/Serialization/Serialization.h"
+#if FOLIAGE_USE_GPU_INSTANCING
+#include "Engine/Graphics/GPUBuffer.h"
+#endif
 #include "Foliage.h"
 
 FoliageType::FoliageType()
@@ -12,6 +15,9 @@ FoliageType::FoliageType()
     , Index(-1)
 {
     _isReady = 0;
+#if FOLIAGE_USE_GPU_INSTANCING
+    _gpuInstancesDirty = 1;
+#endif
 
     ReceiveDecals = true;
     UseDensityScaling = false;
@@ -48,9 +54,19 @@ FoliageType& FoliageType::operator=(const FoliageType& other)
     UseDensityScaling = other.UseDensityScaling;
     PlacementAlignToNormal = other.PlacementAlignToNormal;
     PlacementRandomYaw = other.PlacementRandomYaw;
+#if FOLIAGE_USE_GPU_INSTANCING
+    _gpuInstancesDirty = 1;
+#endif
     return *this;
 }
 
+FoliageType::~FoliageType()
+{
+#if FOLIAGE_USE_GPU_INSTANCING
+    SAFE_DELETE_GPU_RESOURCE(_gpuInstances);
+#endif
+}
+
 Array<MaterialBase*> FoliageType::GetMaterials() const
 {
     Array<MaterialBase*> result;
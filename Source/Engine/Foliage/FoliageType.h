@@ -47,6 +47,10 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
     friend Foliage;
 private:
     int8 _isReady : 1;
+#if FOLIAGE_USE_GPU_INSTANCING
+    int8 _gpuInstancesDirty : 1;
+    GPUBuffer* _gpuInstances = nullptr;
+#endif
 
 public:
     /// <summary>
@@ -62,6 +66,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
 
     FoliageType& operator=(const FoliageType& other);
 
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FoliageType"/> class.
+    /// </summary>
+    ~FoliageType();
+
 public:
     /// <summary>
     /// The parent foliage actor.
@@ -0,0 +1,89 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "CopyQueueGPUTasksExecutor.h"
+#include "GPUTasksContext.h"
+#include "GPUTask.h"
+#include "GPUTasksManager.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+CopyQueueGPUTasksExecutor::CopyQueueGPUTasksExecutor()
+    : _copyContext(nullptr)
+    , _copySyncPoint(0)
+{
+}
+
+String CopyQueueGPUTasksExecutor::ToString() const
+{
+    return TEXT("Copy Queue GPU Async Executor");
+}
+
+void CopyQueueGPUTasksExecutor::FrameBegin()
+{
+    // Ensure to have valid async contexts
+    if (_context == nullptr)
+        _context = createContext();
+    if (_copyContext == nullptr)
+    {
+        _copyContext = New<GPUTasksContext>(GPUDevice::Instance, GPUDevice::Instance->GetCopyContext());
+        _contextList.Add(_copyContext);
+    }
+
+    // Rendering waits for the uploads submitted during the previous frame end (before any resource used by them can be accessed by the graphics queue)
+    if (_copySyncPoint != 0)
+    {
+        _context->GPU->Wait(_copyContext->GPU, _copySyncPoint);
+        _copySyncPoint = 0;
+    }
+
+    _context->OnFrameBegin();
+    _copyContext->OnFrameBegin();
+}
+
+void CopyQueueGPUTasksExecutor::FrameEnd()
+{
+    ASSERT(_context != nullptr && _copyContext != nullptr);
+    PROFILE_CPU();
+
+    GPUTask* buffer[32];
+    const int32 count = GPUDevice::Instance->GetTasksManager()->RequestWork(buffer, 32);
+
+    // Record uploads and copies on the copy queue (custom tasks can use any GPU features so they stay on the main context)
+    const bool useCopyQueue = Graphics::EnableAsyncUploads;
+    bool anyCopy = false, anyCustom = false;
+    for (int32 i = 0; i < count; i++)
+    {
+        GPUTask* task = buffer[i];
+        if (useCopyQueue && task->GetType() != GPUTask::Type::Custom)
+        {
+            _copyContext->Run(task);
+            anyCopy = true;
+        }
+        else
+            anyCustom = true;
+    }
+    if (anyCopy)
+    {
+        const GPUSyncPoint syncPoint = _copyContext->GPU->Submit();
+        if (anyCustom)
+        {
+            // Custom tasks may use the uploaded resources so wait for them right away
+            _context->GPU->Wait(_copyContext->GPU, syncPoint);
+        }
+        else
+            _copySyncPoint = syncPoint;
+    }
+    if (anyCustom)
+    {
+        for (int32 i = 0; i < count; i++)
+        {
+            GPUTask* task = buffer[i];
+            if (!useCopyQueue || task->GetType() == GPUTask::Type::Custom)
+                _context->Run(task);
+        }
+    }
+
+    _copyContext->OnFrameEnd();
+    _context->OnFrameEnd();
+}
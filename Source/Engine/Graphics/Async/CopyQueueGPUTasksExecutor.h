@@ -0,0 +1,27 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "DefaultGPUTasksExecutor.h"
+
+/// <summary>
+/// GPU async job executor that performs the resources uploads and copies on the dedicated copy queue (see GPUDevice::GetCopyContext) so they can overlap with the frame rendering.
+/// </summary>
+class CopyQueueGPUTasksExecutor : public DefaultGPUTasksExecutor
+{
+protected:
+    GPUTasksContext* _copyContext;
+    GPUSyncPoint _copySyncPoint;
+
+public:
+    /// <summary>
+    /// Init
+    /// </summary>
+    CopyQueueGPUTasksExecutor();
+
+public:
+    // [DefaultGPUTasksExecutor]
+    String ToString() const override;
+    void FrameBegin() override;
+    void FrameEnd() override;
+};
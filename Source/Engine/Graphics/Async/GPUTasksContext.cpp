@@ -8,7 +8,7 @@
 
 #define GPU_TASKS_USE_DEDICATED_CONTEXT 0
 
-GPUTasksContext::GPUTasksContext(GPUDevice* device)
+GPUTasksContext::GPUTasksContext(GPUDevice* device, GPUContext* context)
     : _tasksDone(64)
     , _totalTasksDoneCount(0)
 {
@@ -20,7 +20,7 @@ GPUTasksContext::GPUTasksContext(GPUDevice* device)
 	GPU = device->CreateContext(true);
 #else
     // Reuse Graphics Device context
-    GPU = device->GetMainContext();
+    GPU = context ? context : device->GetMainContext();
 #endif
 }
 
@@ -25,7 +25,8 @@ class GPUTasksContext
     /// Initializes a new instance of the <see cref="GPUTasksContext"/> class.
     /// </summary>
     /// <param name="device">The graphics device.</param>
-    GPUTasksContext(GPUDevice* device);
+    /// <param name="context">The GPU commands context to use for the tasks execution. Null to use the main context of the device.</param>
+    GPUTasksContext(GPUDevice* device, GPUContext* context = nullptr);
 
     /// <summary>
     /// Finalizes an instance of the <see cref="GPUTasksContext"/> class.
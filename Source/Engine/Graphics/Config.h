@@ -11,6 +11,12 @@
 // Maximum amount of binded constant buffers at the same time
 #define GPU_MAX_CB_BINDED 4
 
+// Maximum size (in bytes) of the push constants data (small data set directly on the command list, eg. per-dispatch parameters)
+#define GPU_MAX_PUSH_CONSTANTS_SIZE 64
+
+// Constant buffer slot used by the shaders for the push constants (must match META_PUSH_CONSTANTS_BEGIN in Common.hlsl)
+#define GPU_PUSH_CONSTANTS_SLOT GPU_MAX_CB_BINDED
+
 // Maximum amount of binded unordered access resources at the same time
 #define GPU_MAX_UA_BINDED 4
 
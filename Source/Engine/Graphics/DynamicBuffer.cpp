@@ -46,7 +46,7 @@ void DynamicBuffer::Flush()
         }
 
         // Upload data to the buffer
-        if (IsInMainThread() && GPUDevice::Instance->IsRendering())
+        if (IsInRenderThread() && GPUDevice::Instance->IsRendering())
         {
             GPUDevice::Instance->GetMainContext()->UpdateBuffer(_buffer, Data.Get(), size);
         }
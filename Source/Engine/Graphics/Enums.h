@@ -556,6 +556,27 @@ API_ENUM() enum class ComparisonFunc : byte
     API_ENUM(Attributes="HideInEditor") MAX
 };
 
+/// <summary>
+/// The variable rate shading rates (size of the pixels block shaded by a single pixel shader invocation). Values are encoded as (log2(width) << 2) | log2(height) which matches the shading rate image texel values.
+/// </summary>
+API_ENUM() enum class GPUShadingRate : byte
+{
+    // Full rate shading (every pixel is shaded).
+    Rate1x1 = 0,
+    // Single pixel shader invocation per 1x2 pixels block.
+    Rate1x2 = 1,
+    // Single pixel shader invocation per 2x1 pixels block.
+    Rate2x1 = 4,
+    // Single pixel shader invocation per 2x2 pixels block.
+    Rate2x2 = 5,
+    // Single pixel shader invocation per 2x4 pixels block. Requires GPULimits::HasVariableRateShadingLargeRates.
+    Rate2x4 = 6,
+    // Single pixel shader invocation per 4x2 pixels block. Requires GPULimits::HasVariableRateShadingLargeRates.
+    Rate4x2 = 9,
+    // Single pixel shader invocation per 4x4 pixels block. Requires GPULimits::HasVariableRateShadingLargeRates.
+    Rate4x4 = 10,
+};
+
 /// <summary>
 /// Rendering quality levels.
 /// </summary>
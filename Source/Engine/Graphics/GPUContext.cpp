@@ -64,6 +64,19 @@ void GPUContext::Draw(GPUTextureView* rt)
     DrawFullscreenTriangle();
 }
 
+GPUSyncPoint GPUContext::Submit()
+{
+    return 0;
+}
+
+void GPUContext::Wait(GPUContext* other, GPUSyncPoint syncPoint)
+{
+}
+
+void GPUContext::AliasTexture(GPUTexture* texture)
+{
+}
+
 void GPUContext::SetResourceState(GPUResource* resource, uint64 state, int32 subresource)
 {
 }
@@ -7,7 +7,9 @@
 #include "Engine/Core/Math/Rectangle.h"
 #include "Engine/Core/Math/Viewport.h"
 #include "PixelFormat.h"
+#include "Enums.h"
 #include "Config.h"
+#include "Async/GPUSyncPoint.h"
 
 class GPUConstantBuffer;
 class GPUShaderProgramCS;
@@ -420,6 +422,13 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="data">The pointer to the data.</param>
     API_FUNCTION() virtual void UpdateCB(GPUConstantBuffer* cb, const void* data) = 0;
 
+    /// <summary>
+    /// Sets the push constants data accessed by the shaders within META_PUSH_CONSTANTS_BEGIN block. Used for the small data that changes between draws or dispatches (eg. a few indices or offsets) to skip the constant buffer update. Maps to root constants on D3D12 and push constants on Vulkan, other backends emulate it with an internal constant buffer. Data persists until the next call.
+    /// </summary>
+    /// <param name="data">The pointer to the data.</param>
+    /// <param name="size">The data size (in bytes). Must be multiple of 4 and not larger than GPU_MAX_PUSH_CONSTANTS_SIZE.</param>
+    API_FUNCTION() virtual void SetPushConstants(const void* data, uint32 size) = 0;
+
 public:
     /// <summary>
     /// Executes a command list from a thread group.
@@ -438,6 +447,15 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="offsetForArgs">The aligned byte offset for arguments.</param>
     API_FUNCTION() virtual void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) = 0;
 
+    /// <summary>
+    /// Begins or ends the unordered access resources overlap region. Compute dispatches within the region are not separated with the UAV barrier, so they can run simultaneously on the GPU (eg. when subsequent dispatches write to the different parts of the same resource). A single barrier is inserted when the region ends.
+    /// </summary>
+    /// <remarks>Used by the graphics backends that synchronize the unordered access resources between dispatches (eg. D3D12 and Vulkan).</remarks>
+    /// <param name="end">False to begin the overlap region, true to end it.</param>
+    API_FUNCTION() virtual void OverlapUA(bool end)
+    {
+    }
+
     /// <summary>
     /// Resolves the multisampled texture by performing a copy of the resource into a non-multisampled resource.
     /// </summary>
@@ -575,6 +593,19 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="scissorRect">The scissor rectangle (in pixels).</param>
     API_FUNCTION() virtual void SetScissor(API_PARAM(Ref) const Rectangle& scissorRect) = 0;
 
+    /// <summary>
+    /// Sets the variable rate shading rate used by the following draw calls. When shading rate image is set, the coarser rate of both is used. Ignored if not supported by the device (see GPULimits::HasVariableRateShading).
+    /// </summary>
+    /// <param name="rate">The shading rate.</param>
+    API_FUNCTION() virtual void SetShadingRate(GPUShadingRate rate) = 0;
+
+    /// <summary>
+    /// Sets the screen-space shading rate image used by the following draw calls. Ignored if not supported by the device (see GPULimits::HasVariableRateShadingImage).
+    /// </summary>
+    /// <remarks>The image has to use R8_UInt format with GPUShadingRate values (one texel per GPULimits::VariableRateShadingTileSize screen tile). It cannot be written while being set.</remarks>
+    /// <param name="image">The shading rate image or null to disable it.</param>
+    API_FUNCTION() virtual void SetShadingRateImage(GPUTexture* image) = 0;
+
 public:
     /// <summary>
     /// Sets the graphics pipeline state.
@@ -603,6 +634,25 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// </summary>
     API_FUNCTION() virtual void Flush() = 0;
 
+    /// <summary>
+    /// Submits the recorded commands for the execution on the GPU (without waiting for them). Used to synchronize the work between contexts executed on different GPU queues (eg. with the async compute context). Resets the context state.
+    /// </summary>
+    /// <returns>The sync point signaled once the submitted work gets executed (0 if not used).</returns>
+    virtual GPUSyncPoint Submit();
+
+    /// <summary>
+    /// Inserts the GPU-side wait for the work submitted by the other context (up to the given sync point). Doesn't block the CPU. Commands recorded so far are flushed first so only the later work waits. Resets the context state so call it only between the rendering passes.
+    /// </summary>
+    /// <param name="other">The other context to wait for.</param>
+    /// <param name="syncPoint">The sync point returned from the other context submission.</param>
+    virtual void Wait(GPUContext* other, GPUSyncPoint syncPoint);
+
+    /// <summary>
+    /// Activates the texture that shares the memory with other textures (see GPUTexture::InitAliased). Has to be called before using the texture if any other texture placed in the same memory has been used since its last usage. Waits for the previous usage of the memory and discards the texture contents.
+    /// </summary>
+    /// <param name="texture">The aliased texture to activate.</param>
+    virtual void AliasTexture(GPUTexture* texture);
+
     /// <summary>
     /// Sets the state of the resource (or subresource).
     /// </summary>
@@ -9,6 +9,7 @@
 #include "Graphics.h"
 #include "Shaders/GPUShader.h"
 #include "Async/DefaultGPUTasksExecutor.h"
+#include "Async/CopyQueueGPUTasksExecutor.h"
 #include "Async/GPUTasksManager.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Utilities.h"
@@ -22,6 +23,7 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/Profiler.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Scripting/Enums.h"
 
@@ -52,12 +54,15 @@ bool GPUPipelineState::Init(const Description& desc)
     _meta.UsedCBsMask = 0;
     _meta.UsedSRsMask = 0;
     _meta.UsedUAsMask = 0;
+    _descHash = 0;
 #define CHECK_STAGE(stage) \
 	if (desc.stage) { \
 		_meta.UsedCBsMask |= desc.stage->GetBindings().UsedCBsMask; \
 		_meta.UsedSRsMask |= desc.stage->GetBindings().UsedSRsMask; \
 		_meta.UsedUAsMask |= desc.stage->GetBindings().UsedUAsMask; \
-	}
+		CombineHash(_descHash, desc.stage->GetBytecodeHash()); \
+	} \
+	CombineHash(_descHash, (uint32)(desc.stage != nullptr));
     CHECK_STAGE(VS);
     CHECK_STAGE(HS);
     CHECK_STAGE(DS);
@@ -65,6 +70,13 @@ bool GPUPipelineState::Init(const Description& desc)
     CHECK_STAGE(PS);
 #undef CHECK_STAGE
 
+    // Compute description hash (used by the persistent pipeline caches)
+    CombineHash(_descHash, (uint32)desc.DepthEnable | (uint32)desc.DepthWriteEnable << 1 | (uint32)desc.DepthClipEnable << 2 | (uint32)desc.Wireframe << 3);
+    CombineHash(_descHash, (uint32)desc.DepthFunc);
+    CombineHash(_descHash, (uint32)desc.PrimitiveTopologyType);
+    CombineHash(_descHash, (uint32)desc.CullMode);
+    CombineHash(_descHash, GetHash(desc.BlendMode));
+
 #if USE_EDITOR
     // Estimate somehow performance cost of this pipeline state for the content profiling
     const int32 textureLookupCost = 20;
@@ -208,6 +220,33 @@ uint64 GPUResource::GetMemoryUsage() const
     return _memoryUsage;
 }
 
+GPUResourceCategory GPUResource::GetCategory() const
+{
+    if (_category != GPUResourceCategory::Default)
+        return _category;
+    switch (GetResourceType())
+    {
+    case GPUResourceType::RenderTarget:
+        return GPUResourceCategory::RenderTargets;
+    case GPUResourceType::Texture:
+    case GPUResourceType::CubeTexture:
+    case GPUResourceType::VolumeTexture:
+        return GPUResourceCategory::Textures;
+    case GPUResourceType::Buffer:
+        return GPUResourceCategory::Buffers;
+    case GPUResourceType::Shader:
+    case GPUResourceType::PipelineState:
+        return GPUResourceCategory::Shaders;
+    default:
+        return GPUResourceCategory::Other;
+    }
+}
+
+void GPUResource::SetCategory(GPUResourceCategory value)
+{
+    _category = value;
+}
+
 static_assert((GPU_ENABLE_RESOURCE_NAMING) == (!BUILD_RELEASE), "Update build condition on around GPUResource Name property getter/setter.");
 
 #if GPU_ENABLE_RESOURCE_NAMING
@@ -573,11 +612,14 @@ GPUTasksContext* GPUDevice::CreateTasksContext()
 
 GPUTasksExecutor* GPUDevice::CreateTasksExecutor()
 {
+    if (Limits.HasCopyQueue)
+        return New<CopyQueueGPUTasksExecutor>();
     return New<DefaultGPUTasksExecutor>();
 }
 
 void GPUDevice::Draw()
 {
+    PROFILE_MEM(Graphics);
     DrawBegin();
 
     auto context = GetMainContext();
@@ -597,6 +639,7 @@ void GPUDevice::Draw()
     Render2D::EndFrame();
     _res->TasksManager.FrameEnd();
     RenderEnd();
+    RendererAllocation::ResetFrame();
     context->FrameEnd();
 
     DrawEnd();
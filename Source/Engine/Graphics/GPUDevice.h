@@ -18,6 +18,7 @@ class GPUResource;
 class GPUContext;
 class GPUShader;
 class GPUTimerQuery;
+class GPUPipelineStatsQuery;
 class GPUTexture;
 class GPUBuffer;
 class GPUSampler;
@@ -210,6 +211,22 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUDevice : public ScriptingObje
     /// </summary>
     API_PROPERTY() virtual GPUContext* GetMainContext() = 0;
 
+    /// <summary>
+    /// Gets the GPU context that executes compute work on the asynchronous compute queue (see GPULimits::HasAsyncCompute). Returns the main context if async compute is not supported. The recorded work is executed after the main context work recorded before its submission and the main context has to wait for it before using the results (see GPUContext::Submit and GPUContext::Wait).
+    /// </summary>
+    API_PROPERTY() virtual GPUContext* GetComputeContext()
+    {
+        return GetMainContext();
+    }
+
+    /// <summary>
+    /// Gets the GPU context that executes copy and upload work on the dedicated copy queue (see GPULimits::HasCopyQueue). Returns the main context if copy queue is not supported. Supports only resources updates and copies. The main context has to wait for the submitted work before using the results (see GPUContext::Submit and GPUContext::Wait).
+    /// </summary>
+    API_PROPERTY() virtual GPUContext* GetCopyContext()
+    {
+        return GetMainContext();
+    }
+
     /// <summary>
     /// Gets the adapter device.
     /// </summary>
@@ -230,6 +247,19 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUDevice : public ScriptingObje
     /// </summary>
     API_PROPERTY() Array<GPUResource*> GetResources() const;
 
+    /// <summary>
+    /// Calls the action for every active GPU resource. Resources list is locked during the call so resources are valid only within the action.
+    /// </summary>
+    /// <param name="action">The action to call (receives GPUResource* argument).</param>
+    template<typename ActionType>
+    void ForEachResource(const ActionType& action) const
+    {
+        _resourcesLock.Lock();
+        for (int32 i = 0; i < _resources.Count(); i++)
+            action(_resources[i]);
+        _resourcesLock.Unlock();
+    }
+
     /// <summary>
     /// Gets the GPU asynchronous work manager.
     /// </summary>
@@ -368,6 +398,15 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUDevice : public ScriptingObje
     /// <returns>The timer query.</returns>
     virtual GPUTimerQuery* CreateTimerQuery() = 0;
 
+    /// <summary>
+    /// Creates the pipeline statistics query object. Returns null if the graphics backend doesn't support pipeline statistics queries.
+    /// </summary>
+    /// <returns>The pipeline statistics query or null if unsupported.</returns>
+    virtual GPUPipelineStatsQuery* CreatePipelineStatsQuery()
+    {
+        return nullptr;
+    }
+
     /// <summary>
     /// Creates the buffer.
     /// </summary>
@@ -274,6 +274,41 @@ API_STRUCT() struct GPULimits
     /// </summary>
     API_FIELD() bool HasTypedUAVLoad;
 
+    /// <summary>
+    /// True if device supports asynchronous compute queue that can execute compute work in parallel to the graphics queue (see GPUDevice::GetComputeContext).
+    /// </summary>
+    API_FIELD() bool HasAsyncCompute;
+
+    /// <summary>
+    /// True if device supports dedicated copy queue that can execute resources uploads in parallel to the graphics queue (see GPUDevice::GetCopyContext).
+    /// </summary>
+    API_FIELD() bool HasCopyQueue;
+
+    /// <summary>
+    /// True if device supports placing multiple render targets in the same memory (aliasing) to reduce memory usage by the transient resources that are not used at the same time (see GPUTexture::InitAliased).
+    /// </summary>
+    API_FIELD() bool HasResourceAliasing;
+
+    /// <summary>
+    /// True if device supports variable rate shading with the per-draw shading rate (see GPUContext::SetShadingRate).
+    /// </summary>
+    API_FIELD() bool HasVariableRateShading;
+
+    /// <summary>
+    /// True if device supports variable rate shading with the screen-space shading rate image (see GPUContext::SetShadingRateImage).
+    /// </summary>
+    API_FIELD() bool HasVariableRateShadingImage;
+
+    /// <summary>
+    /// True if device supports the coarse shading rates with 4 pixels in any dimension (2x4, 4x2, 4x4).
+    /// </summary>
+    API_FIELD() bool HasVariableRateShadingLargeRates;
+
+    /// <summary>
+    /// The size (in pixels) of the screen tile that maps to a single texel of the shading rate image. Zero if shading rate image is not supported.
+    /// </summary>
+    API_FIELD() int32 VariableRateShadingTileSize;
+
     /// <summary>
     /// The maximum amount of texture mip levels.
     /// </summary>
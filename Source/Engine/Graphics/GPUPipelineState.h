@@ -108,6 +108,7 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUPipelineState : public GPUResource
 
 protected:
     ShaderBindings _meta;
+    uint32 _descHash = 0;
 
     GPUPipelineState();
 
@@ -147,6 +148,14 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUPipelineState : public GPUResource
         return _meta.UsedUAsMask;
     }
 
+    /// <summary>
+    /// Gets the hash of the pipeline state description (shader programs bytecode and fixed-function state). Stays the same across the application runs so it can be used to identify pipeline state in persistent caches.
+    /// </summary>
+    FORCE_INLINE uint32 GetDescriptionHash() const
+    {
+        return _descHash;
+    }
+
 public:
     /// <summary>
     /// Returns true if pipeline state is valid and ready to use
@@ -0,0 +1,123 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Types/StringView.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Threading/Threading.h"
+
+/// <summary>
+/// The cache of the pipeline state objects variants (eg. render targets formats) used at runtime by the graphics backend. Persisted to file so the next launch can precompile the used variants when pipeline state gets initialized (eg. on shader or material load) instead of hitching on the first draw.
+/// </summary>
+/// <remarks>The key type has to be a plain-old-data structure (it's saved to file as raw memory).</remarks>
+template<typename KeyType>
+class GPUPipelineStateUsageCache
+{
+private:
+    CriticalSection _locker;
+    Dictionary<uint32, Array<KeyType>> _usage;
+    bool _isDirty = false;
+
+    struct Header
+    {
+        int32 Version;
+        int32 KeySize;
+        int32 Count;
+    };
+
+    static constexpr int32 Version = 1;
+
+public:
+    /// <summary>
+    /// Loads the cache from the file. Invalid or outdated file is ignored.
+    /// </summary>
+    /// <param name="path">The cache file path.</param>
+    void Load(const StringView& path)
+    {
+        ScopeLock lock(_locker);
+        _usage.Clear();
+        _isDirty = false;
+        Array<byte> data;
+        if (!FileSystem::FileExists(path) || File::ReadAllBytes(path, data) || data.Count() < (int32)sizeof(Header))
+            return;
+        const Header& header = *(const Header*)data.Get();
+        if (header.Version != Version || header.KeySize != sizeof(KeyType))
+            return;
+        int32 pos = (int32)sizeof(Header);
+        for (int32 i = 0; i < header.Count; i++)
+        {
+            if (pos + (int32)(sizeof(uint32) + sizeof(int32)) > data.Count())
+                break;
+            const uint32 descHash = *(const uint32*)(data.Get() + pos);
+            const int32 keysCount = *(const int32*)(data.Get() + pos + sizeof(uint32));
+            pos += sizeof(uint32) + sizeof(int32);
+            if (keysCount < 0 || pos + keysCount * (int32)sizeof(KeyType) > data.Count())
+                break;
+            _usage[descHash].Add((const KeyType*)(data.Get() + pos), keysCount);
+            pos += keysCount * (int32)sizeof(KeyType);
+        }
+    }
+
+    /// <summary>
+    /// Saves the cache to the file (if it was modified).
+    /// </summary>
+    /// <param name="path">The cache file path.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Save(const StringView& path)
+    {
+        ScopeLock lock(_locker);
+        if (!_isDirty)
+            return false;
+        Array<byte> data;
+        Header header;
+        header.Version = Version;
+        header.KeySize = sizeof(KeyType);
+        header.Count = _usage.Count();
+        data.Add((const byte*)&header, sizeof(Header));
+        for (auto& e : _usage)
+        {
+            const int32 keysCount = e.Value.Count();
+            data.Add((const byte*)&e.Key, sizeof(uint32));
+            data.Add((const byte*)&keysCount, sizeof(int32));
+            data.Add((const byte*)e.Value.Get(), keysCount * sizeof(KeyType));
+        }
+        if (File::WriteAllBytes(path, data))
+            return true;
+        _isDirty = false;
+        return false;
+    }
+
+    /// <summary>
+    /// Records the usage of the pipeline state variant.
+    /// </summary>
+    /// <param name="descHash">The hash of the pipeline state description (shaders and fixed-function state).</param>
+    /// <param name="key">The pipeline state variant key.</param>
+    void Add(uint32 descHash, const KeyType& key)
+    {
+        ScopeLock lock(_locker);
+        auto& keys = _usage[descHash];
+        if (!keys.Contains(key))
+        {
+            keys.Add(key);
+            _isDirty = true;
+        }
+    }
+
+    /// <summary>
+    /// Gets the pipeline state variants recorded for the given description.
+    /// </summary>
+    /// <param name="descHash">The hash of the pipeline state description (shaders and fixed-function state).</param>
+    /// <param name="keys">The output variant keys.</param>
+    /// <returns>True if found any variants, otherwise false.</returns>
+    bool TryGet(uint32 descHash, Array<KeyType>& keys)
+    {
+        ScopeLock lock(_locker);
+        const Array<KeyType>* e = _usage.TryGet(descHash);
+        if (e)
+            keys = *e;
+        return e != nullptr && e->HasItems();
+    }
+};
@@ -0,0 +1,64 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+/// <summary>
+/// The GPU pipeline statistics collected by the graphics hardware (amount of the processed vertices, primitives and shader invocations).
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API GPUPipelineStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(GPUPipelineStats);
+
+    /// <summary>
+    /// The amount of vertices read by the input assembler.
+    /// </summary>
+    API_FIELD() uint64 InputVertices;
+
+    /// <summary>
+    /// The amount of primitives read by the input assembler.
+    /// </summary>
+    API_FIELD() uint64 InputPrimitives;
+
+    /// <summary>
+    /// The amount of vertex shader invocations.
+    /// </summary>
+    API_FIELD() uint64 VertexShaderInvocations;
+
+    /// <summary>
+    /// The amount of pixel shader invocations.
+    /// </summary>
+    API_FIELD() uint64 PixelShaderInvocations;
+
+    /// <summary>
+    /// The amount of compute shader invocations.
+    /// </summary>
+    API_FIELD() uint64 ComputeShaderInvocations;
+
+    /// <summary>
+    /// The amount of primitives sent to the rasterizer (clipping stage input).
+    /// </summary>
+    API_FIELD() uint64 ClippingInvocations;
+
+    /// <summary>
+    /// The amount of primitives rendered after clipping (clipping stage output).
+    /// </summary>
+    API_FIELD() uint64 ClippingPrimitives;
+
+    /// <summary>
+    /// Accumulates the other statistics into this one.
+    /// </summary>
+    /// <param name="other">The other statistics.</param>
+    void Add(const GPUPipelineStats& other)
+    {
+        InputVertices += other.InputVertices;
+        InputPrimitives += other.InputPrimitives;
+        VertexShaderInvocations += other.VertexShaderInvocations;
+        PixelShaderInvocations += other.PixelShaderInvocations;
+        ComputeShaderInvocations += other.ComputeShaderInvocations;
+        ClippingInvocations += other.ClippingInvocations;
+        ClippingPrimitives += other.ClippingPrimitives;
+    }
+};
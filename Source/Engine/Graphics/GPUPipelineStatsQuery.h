@@ -0,0 +1,56 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "GPUResource.h"
+#include "GPUPipelineStats.h"
+
+/// <summary>
+/// Represents a GPU query that collects pipeline statistics of GPU operations.
+/// The query will count any GPU operations that take place between its Begin() and End() calls. Queries must not overlap (only a single query can be active at once).
+/// </summary>
+/// <seealso cref="GPUResource" />
+class FLAXENGINE_API GPUPipelineStatsQuery : public GPUResource
+{
+public:
+    /// <summary>
+    /// Finalizes an instance of the <see cref="GPUPipelineStatsQuery"/> class.
+    /// </summary>
+    virtual ~GPUPipelineStatsQuery()
+    {
+    }
+
+public:
+    /// <summary>
+    /// Starts the counter.
+    /// </summary>
+    virtual void Begin() = 0;
+
+    /// <summary>
+    /// Stops the counter. Can be called more than once without failing.
+    /// </summary>
+    virtual void End() = 0;
+
+    /// <summary>
+    /// Determines whether this query has been completed and has valid result to gather.
+    /// </summary>
+    /// <returns><c>true</c> if this query has result; otherwise, <c>false</c>.</returns>
+    virtual bool HasResult() = 0;
+
+    /// <summary>
+    /// Gets the query result with the pipeline statistics of the GPU commands executed between Begin/End calls.
+    /// </summary>
+    /// <param name="result">The result statistics.</param>
+    virtual void GetResult(GPUPipelineStats& result) = 0;
+
+public:
+    // [GPUResource]
+    String ToString() const override
+    {
+        return TEXT("PipelineStatsQuery");
+    }
+    GPUResourceType GetResourceType() const final override
+    {
+        return GPUResourceType::Query;
+    }
+};
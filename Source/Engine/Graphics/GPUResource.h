@@ -40,6 +40,35 @@ API_ENUM() enum class GPUResourceType
     MAX
 };
 
+/// <summary>
+/// GPU resources categories used for the memory usage accounting (eg. VRAM budgets).
+/// </summary>
+API_ENUM() enum class GPUResourceCategory : byte
+{
+    // Not specified category (resource gets categorized by its type).
+    Default = 0,
+    // Textures (not streamed).
+    Textures,
+    // Streamed textures (eg. texture assets).
+    StreamingTextures,
+    // Render targets (eg. temporary pooled render targets).
+    RenderTargets,
+    // Models data (eg. meshes vertex and index buffers, SDF textures).
+    Models,
+    // Particles simulation and rendering data.
+    Particles,
+    // Global Illumination data (eg. DDGI probes, Global SDF and Global Surface Atlas).
+    GlobalIllumination,
+    // Buffers.
+    Buffers,
+    // Shaders and pipeline states.
+    Shaders,
+    // Other resources.
+    Other,
+
+    MAX
+};
+
 /// <summary>
 /// The base class for all GPU resources.
 /// </summary>
@@ -48,6 +77,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API GPUResource : public Scripting
     DECLARE_SCRIPTING_TYPE_NO_SPAWN(GPUResource);
 protected:
     uint64 _memoryUsage = 0;
+    GPUResourceCategory _category = GPUResourceCategory::Default;
 #if GPU_ENABLE_RESOURCE_NAMING
     Char* _namePtr = nullptr;
     int32 _nameSize = 0, _nameCapacity = 0;
@@ -92,6 +122,16 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API GPUResource : public Scripting
     /// </summary>
     API_PROPERTY() uint64 GetMemoryUsage() const;
 
+    /// <summary>
+    /// Gets the resource category used for the memory usage accounting. If not specified, the category is picked based on the resource type.
+    /// </summary>
+    API_PROPERTY() GPUResourceCategory GetCategory() const;
+
+    /// <summary>
+    /// Sets the resource category used for the memory usage accounting. Use Default to categorize the resource by its type.
+    /// </summary>
+    API_PROPERTY() void SetCategory(GPUResourceCategory value);
+
 #if !BUILD_RELEASE
     /// <summary>
     /// Gets the resource name.
@@ -17,8 +17,21 @@ Quality Graphics::VolumetricFogQuality = Quality::High;
 Quality Graphics::ShadowsQuality = Quality::Medium;
 Quality Graphics::ShadowMapsQuality = Quality::Medium;
 bool Graphics::AllowCSMBlending = false;
+int32 Graphics::ShadowsModelLODBias = 0;
 Quality Graphics::GlobalSDFQuality = Quality::High;
+bool Graphics::GlobalSDFCompactStorage = false;
 Quality Graphics::GIQuality = Quality::High;
+Quality Graphics::BloomQuality = Quality::High;
+Quality Graphics::DepthOfFieldQuality = Quality::High;
+Quality Graphics::DistortionQuality = Quality::High;
+bool Graphics::EnableOcclusionCulling = false;
+bool Graphics::EnableClusteredLighting = true;
+bool Graphics::EnableAsyncCompute = false;
+bool Graphics::EnableAsyncUploads = true;
+bool Graphics::EnablePipelinedRendering = false;
+bool Graphics::EnableRenderTargetsAliasing = false;
+bool Graphics::EnableVariableRateShading = false;
+bool Graphics::EnableSkinningCache = false;
 PostProcessSettings Graphics::PostProcessSettings;
 
 #if GRAPHICS_API_NULL
@@ -65,8 +78,21 @@ void GraphicsSettings::Apply()
     Graphics::ShadowsQuality = ShadowsQuality;
     Graphics::ShadowMapsQuality = ShadowMapsQuality;
     Graphics::AllowCSMBlending = AllowCSMBlending;
+    Graphics::ShadowsModelLODBias = ShadowsModelLODBias;
     Graphics::GlobalSDFQuality = GlobalSDFQuality;
+    Graphics::GlobalSDFCompactStorage = GlobalSDFCompactStorage;
     Graphics::GIQuality = GIQuality;
+    Graphics::BloomQuality = BloomQuality;
+    Graphics::DepthOfFieldQuality = DepthOfFieldQuality;
+    Graphics::DistortionQuality = DistortionQuality;
+    Graphics::EnableOcclusionCulling = EnableOcclusionCulling;
+    Graphics::EnableClusteredLighting = EnableClusteredLighting;
+    Graphics::EnableAsyncCompute = EnableAsyncCompute;
+    Graphics::EnableAsyncUploads = EnableAsyncUploads;
+    Graphics::EnablePipelinedRendering = EnablePipelinedRendering;
+    Graphics::EnableRenderTargetsAliasing = EnableRenderTargetsAliasing;
+    Graphics::EnableVariableRateShading = EnableVariableRateShading;
+    Graphics::EnableSkinningCache = EnableSkinningCache;
     Graphics::PostProcessSettings = PostProcessSettings;
 }
 
@@ -53,16 +53,81 @@ API_CLASS(Static) class FLAXENGINE_API Graphics
     /// </summary>
     API_FIELD() static bool AllowCSMBlending;
 
+    /// <summary>
+    /// The model LOD bias applied to the shadow maps rendering (added to the main view LOD bias). Higher values use lower-quality LODs for shadow casters to reduce shadow pass cost.
+    /// </summary>
+    API_FIELD() static int32 ShadowsModelLODBias;
+
     /// <summary>
     /// The Global SDF quality. Controls the volume texture resolution and amount of cascades to use.
     /// </summary>
     API_FIELD() static Quality GlobalSDFQuality;
 
+    /// <summary>
+    /// Enables 8-bit storage for Global SDF (instead of 16-bit float). Halves the memory usage and sampling bandwidth at the cost of lower distance precision.
+    /// </summary>
+    API_FIELD() static bool GlobalSDFCompactStorage;
+
     /// <summary>
     /// The Global Illumination quality. Controls the quality of the GI effect.
     /// </summary>
     API_FIELD() static Quality GIQuality;
 
+    /// <summary>
+    /// The Bloom quality. Controls the amount of the downsampled mip levels used by the compute shaders bloom (lower quality gives smaller bloom radius).
+    /// </summary>
+    API_FIELD() static Quality BloomQuality;
+
+    /// <summary>
+    /// The Depth Of Field quality. Low renders the effect in quarter resolution, Medium in half resolution and High or Ultra in full resolution.
+    /// </summary>
+    API_FIELD() static Quality DepthOfFieldQuality;
+
+    /// <summary>
+    /// The distortion (refraction) quality. Low and Medium render the distortion vectors in half resolution, High or Ultra in full resolution.
+    /// </summary>
+    API_FIELD() static Quality DistortionQuality;
+
+    /// <summary>
+    /// Enables the occlusion culling of the objects hidden behind the other geometry (uses the depth buffer from the previous frames).
+    /// </summary>
+    API_FIELD() static bool EnableOcclusionCulling;
+
+    /// <summary>
+    /// Enables the clustered lighting for the local lights (lights are culled into the view frustum clusters on the GPU and resolved in a single pass).
+    /// </summary>
+    API_FIELD() static bool EnableClusteredLighting;
+
+    /// <summary>
+    /// Enables scheduling the GI compute work (eg. Global SDF updates) on the asynchronous compute queue (if supported by the graphics device).
+    /// </summary>
+    API_FIELD() static bool EnableAsyncCompute;
+
+    /// <summary>
+    /// Enables executing the GPU resources uploads (eg. textures and meshes streaming) on the dedicated copy queue (if supported by the graphics device).
+    /// </summary>
+    API_FIELD() static bool EnableAsyncUploads;
+
+    /// <summary>
+    /// Enables drawing the frame on a dedicated render thread in parallel to the simulation of the next frame on the main thread.
+    /// </summary>
+    API_FIELD() static bool EnablePipelinedRendering;
+
+    /// <summary>
+    /// Enables sharing the memory between the temporary render targets from the RenderTargetPool that are not used at the same time (if supported by the graphics device).
+    /// </summary>
+    API_FIELD() static bool EnableRenderTargetsAliasing;
+
+    /// <summary>
+    /// Enables the variable rate shading with the shading rate image generated from the scene contrast and motion (if supported by the graphics device).
+    /// </summary>
+    API_FIELD() static bool EnableVariableRateShading;
+
+    /// <summary>
+    /// Enables the skinning cache that skins the animated meshes once per frame with compute shaders and draws them as static geometry in all passes (if supported by the graphics device).
+    /// </summary>
+    API_FIELD() static bool EnableSkinningCache;
+
     /// <summary>
     /// The default Post Process settings. Can be overriden by PostFxVolume on a level locally, per camera or for a whole map.
     /// </summary>
@@ -14,11 +14,22 @@
 #include "Engine/Renderer/DrawCall.h"
 
 PACK_STRUCT(struct DecalMaterialShaderData {
-    Matrix WorldMatrix;
-    Matrix InvWorld;
     Matrix SVPositionToWorld;
     });
 
+void DecalInstanceData::Set(const Matrix& world, float perInstanceRandom)
+{
+    Matrix invWorld;
+    Matrix::Invert(world, invWorld);
+    World[0] = world.GetColumn1();
+    World[1] = world.GetColumn2();
+    World[2] = world.GetColumn3();
+    InvWorld[0] = invWorld.GetColumn1();
+    InvWorld[1] = invWorld.GetColumn2();
+    InvWorld[2] = invWorld.GetColumn3();
+    PerInstanceRandom = perInstanceRandom;
+}
+
 DrawPass DecalMaterialShader::GetDrawModes() const
 {
     return DrawPass::GBuffer;
@@ -29,7 +40,6 @@ void DecalMaterialShader::Bind(BindParameters& params)
     // Prepare
     auto context = params.GPUContext;
     auto& view = params.RenderContext.View;
-    auto& drawCall = *params.FirstDrawCall;
     Span<byte> cb(_cbData.Get(), _cbData.Count());
     ASSERT_LOW_LAYER(cb.Length() >= sizeof(DecalMaterialShaderData));
     auto materialData = reinterpret_cast<DecalMaterialShaderData*>(cb.Get());
@@ -50,15 +60,8 @@ void DecalMaterialShader::Bind(BindParameters& params)
     // Decals use depth buffer to draw on top of the objects
     context->BindSR(0, GET_TEXTURE_VIEW_SAFE(params.RenderContext.Buffers->DepthBuffer));
 
-    // Setup material constants
+    // Setup material constants (decal transformation is provided via per-instance data, see DecalInstanceData)
     {
-        Matrix::Transpose(drawCall.World, materialData->WorldMatrix);
-
-        // Matrix for transformation from world space to decal object space
-        Matrix invWorld;
-        Matrix::Invert(drawCall.World, invWorld);
-        Matrix::Transpose(invWorld, materialData->InvWorld);
-
         // Matrix for transformation from SV Position space to world space
         const Matrix offsetMatrix(
             2.0f * view.ScreenSize.Z, 0, 0, 0,
@@ -3,6 +3,23 @@
 #pragma once
 
 #include "MaterialShader.h"
+#include "Engine/Core/Math/Vector4.h"
+
+/// <summary>
+/// The per-instance data of the decal used for instanced decals rendering (see DecalInstance in Decal.shader material template).
+/// </summary>
+PACK_STRUCT(struct FLAXENGINE_API DecalInstanceData {
+    Float4 World[3]; // Transposed world matrix (3x4)
+    Float4 InvWorld[3]; // Transposed inverse world matrix (3x4)
+    float PerInstanceRandom;
+
+    /// <summary>
+    /// Sets the instance data from the decal world matrix.
+    /// </summary>
+    /// <param name="world">The decal world matrix (box of size 1 centered around the origin).</param>
+    /// <param name="perInstanceRandom">The per-instance random value.</param>
+    void Set(const Matrix& world, float perInstanceRandom);
+    });
 
 /// <summary>
 /// Represents material that can be used to render decals.
@@ -36,6 +36,11 @@ bool DeferredMaterialShader::CanUseLightmap() const
     return true;
 }
 
+bool DeferredMaterialShader::CanUseSkinning() const
+{
+    return _useSkinning;
+}
+
 bool DeferredMaterialShader::CanUseInstancing(InstancingHandler& handler) const
 {
     handler = { SurfaceDrawCallHandler::GetHash, SurfaceDrawCallHandler::CanBatch, SurfaceDrawCallHandler::WriteDrawCall, };
@@ -153,6 +158,10 @@ bool DeferredMaterialShader::Load()
         psDesc.DS = _shader->GetDS("DS");
     }
 
+    // Skinned meshes permutations are stripped from the cooked game if material is not used by any skinned model
+    _useSkinning = _shader->HasShader("VS_Skinned");
+    GPUShaderProgramVS* skinnedVS = _useSkinning ? _shader->GetVS("VS_Skinned") : nullptr;
+
     // GBuffer Pass
     psDesc.VS = _shader->GetVS("VS");
     psDesc.PS = _shader->GetPS("PS_GBuffer");
@@ -168,7 +177,7 @@ bool DeferredMaterialShader::Load()
     _cacheInstanced.DefaultLightmap.Init(psDesc);
 
     // GBuffer Pass with skinning
-    psDesc.VS = _shader->GetVS("VS_Skinned");
+    psDesc.VS = skinnedVS;
     psDesc.PS = _shader->GetPS("PS_GBuffer");
     _cache.DefaultSkinned.Init(psDesc);
 
@@ -181,7 +190,7 @@ bool DeferredMaterialShader::Load()
         _cache.QuadOverdraw.Init(psDesc);
         psDesc.VS = _shader->GetVS("VS", 1);
         _cacheInstanced.Depth.Init(psDesc);
-        psDesc.VS = _shader->GetVS("VS_Skinned");
+        psDesc.VS = skinnedVS;
         _cache.QuadOverdrawSkinned.Init(psDesc);
     }
 #endif
@@ -195,11 +204,11 @@ bool DeferredMaterialShader::Load()
     _cache.MotionVectors.Init(psDesc);
 
     // Motion Vectors pass with skinning
-    psDesc.VS = _shader->GetVS("VS_Skinned");
+    psDesc.VS = skinnedVS;
     _cache.MotionVectorsSkinned.Init(psDesc);
 
     // Motion Vectors pass with skinning (with per-bone motion blur)
-    psDesc.VS = _shader->GetVS("VS_Skinned", 1);
+    psDesc.VS = _useSkinning ? _shader->GetVS("VS_Skinned", 1) : nullptr;
     _cache.MotionVectorsSkinnedPerBone.Init(psDesc);
 
     // Depth Pass
@@ -230,7 +239,7 @@ bool DeferredMaterialShader::Load()
     _cacheInstanced.Depth.Init(psDesc);
 
     // Depth Pass with skinning
-    psDesc.VS = _shader->GetVS("VS_Skinned");
+    psDesc.VS = skinnedVS;
     _cache.DepthSkinned.Init(psDesc);
 
     return false;
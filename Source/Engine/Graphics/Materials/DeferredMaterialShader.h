@@ -65,6 +65,7 @@ class DeferredMaterialShader : public MaterialShader
 private:
     Cache _cache;
     Cache _cacheInstanced;
+    bool _useSkinning = false;
 
 public:
     DeferredMaterialShader(const StringView& name)
@@ -76,6 +77,7 @@ class DeferredMaterialShader : public MaterialShader
     // [MaterialShader]
     DrawPass GetDrawModes() const override;
     bool CanUseLightmap() const override;
+    bool CanUseSkinning() const override;
     bool CanUseInstancing(InstancingHandler& handler) const override;
     void Bind(BindParameters& params) override;
     void Unload() override;
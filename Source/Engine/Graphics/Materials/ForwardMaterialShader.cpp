@@ -32,6 +32,11 @@ DrawPass ForwardMaterialShader::GetDrawModes() const
     return _drawModes;
 }
 
+bool ForwardMaterialShader::CanUseSkinning() const
+{
+    return _useSkinning;
+}
+
 bool ForwardMaterialShader::CanUseInstancing(InstancingHandler& handler) const
 {
     handler = { SurfaceDrawCallHandler::GetHash, SurfaceDrawCallHandler::CanBatch, SurfaceDrawCallHandler::WriteDrawCall, };
@@ -141,6 +146,10 @@ bool ForwardMaterialShader::Load()
         psDesc.DS = _shader->GetDS("DS");
     }
 
+    // Skinned meshes permutations are stripped from the cooked game if material is not used by any skinned model
+    _useSkinning = _shader->HasShader("VS_Skinned");
+    GPUShaderProgramVS* skinnedVS = _useSkinning ? _shader->GetVS("VS_Skinned") : nullptr;
+
 #if USE_EDITOR
     if (_shader->HasShader("PS_QuadOverdraw"))
     {
@@ -150,7 +159,7 @@ bool ForwardMaterialShader::Load()
         _cache.QuadOverdraw.Init(psDesc);
         psDesc.VS = _shader->GetVS("VS", 1);
         _cacheInstanced.Depth.Init(psDesc);
-        psDesc.VS = _shader->GetVS("VS_Skinned");
+        psDesc.VS = skinnedVS;
         _cache.QuadOverdrawSkinned.Init(psDesc);
     }
 #endif
@@ -168,7 +177,7 @@ bool ForwardMaterialShader::Load()
         _cache.Distortion.Init(psDesc);
         //psDesc.VS = _shader->GetVS("VS", 1);
         //_cacheInstanced.Distortion.Init(psDesc);
-        psDesc.VS = _shader->GetVS("VS_Skinned");
+        psDesc.VS = skinnedVS;
         _cache.DistortionSkinned.Init(psDesc);
     }
 
@@ -192,7 +201,7 @@ bool ForwardMaterialShader::Load()
     _cache.Default.Init(psDesc);
     //psDesc.VS = _shader->GetVS("VS", 1);
     //_cacheInstanced.Default.Init(psDesc);
-    psDesc.VS = _shader->GetVS("VS_Skinned");
+    psDesc.VS = skinnedVS;
     _cache.DefaultSkinned.Init(psDesc);
 
     // Depth Pass
@@ -209,7 +218,7 @@ bool ForwardMaterialShader::Load()
     _cache.Depth.Init(psDesc);
     psDesc.VS = _shader->GetVS("VS", 1);
     _cacheInstanced.Depth.Init(psDesc);
-    psDesc.VS = _shader->GetVS("VS_Skinned");
+    psDesc.VS = skinnedVS;
     _cache.DepthSkinned.Init(psDesc);
 
     return false;
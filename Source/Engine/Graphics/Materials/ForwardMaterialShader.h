@@ -57,6 +57,7 @@ class ForwardMaterialShader : public MaterialShader
     Cache _cache;
     Cache _cacheInstanced;
     DrawPass _drawModes = DrawPass::None;
+    bool _useSkinning = false;
 
 public:
     /// <summary>
@@ -71,6 +72,7 @@ class ForwardMaterialShader : public MaterialShader
 public:
     // [MaterialShader]
     DrawPass GetDrawModes() const override;
+    bool CanUseSkinning() const override;
     bool CanUseInstancing(InstancingHandler& handler) const override;
     void Bind(BindParameters& params) override;
     void Unload() override;
@@ -113,6 +113,15 @@ class FLAXENGINE_API IMaterial
         return false;
     }
 
+    /// <summary>
+    /// Returns true if material can be used to draw skinned meshes (skinned permutations might be stripped from the cooked game for materials not used by any skinned model).
+    /// </summary>
+    /// <returns>True if can use skinning, otherwise false</returns>
+    virtual bool CanUseSkinning() const
+    {
+        return false;
+    }
+
     /// <summary>
     /// The instancing handling used to hash, batch and write draw calls.
     /// </summary>
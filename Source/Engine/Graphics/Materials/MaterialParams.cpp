@@ -1143,6 +1143,25 @@ bool MaterialParams::HasContentLoaded() const
     return result;
 }
 
+void MaterialParams::RequestTexturesResolution(int32 resolution) const
+{
+    for (int32 i = 0; i < Count(); i++)
+    {
+        const MaterialParameter& param = At(i);
+        switch (param._type)
+        {
+        case MaterialParameterType::Texture:
+        case MaterialParameterType::NormalMap:
+        case MaterialParameterType::CubeTexture:
+            if (const auto texture = (TextureBase*)param._asAsset.Get())
+                texture->StreamingTexture()->RequestResolution(resolution);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 void MaterialParams::UpdateHash()
 {
     _versionHash = rand();
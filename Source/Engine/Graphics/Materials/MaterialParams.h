@@ -430,6 +430,12 @@ class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
 
     bool HasContentLoaded() const;
 
+    /// <summary>
+    /// Requests the resolution needed to draw the textures used by the parameters (see StreamingTexture.RequestResolution). Used by the textures streaming to load only the mip levels needed on screen.
+    /// </summary>
+    /// <param name="resolution">The requested resolution (in texels).</param>
+    void RequestTexturesResolution(int32 resolution) const;
+
 private:
     void UpdateHash();
 };
@@ -10,7 +10,7 @@
 /// <summary>
 /// Current materials shader version.
 /// </summary>
-#define MATERIAL_GRAPH_VERSION 161
+#define MATERIAL_GRAPH_VERSION 167
 
 class Material;
 class GPUShader;
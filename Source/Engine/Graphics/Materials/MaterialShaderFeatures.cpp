@@ -3,6 +3,7 @@
 #include "MaterialShaderFeatures.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Renderer/ShadowsPass.h"
 #if USE_EDITOR
@@ -22,6 +23,7 @@ void ForwardShadingFeature::Bind(MaterialShader::BindParameters& params, Span<by
     const int32 envProbeShaderRegisterIndex = srv + 0;
     const int32 skyLightShaderRegisterIndex = srv + 1;
     const int32 dirLightShaderRegisterIndex = srv + 2;
+    const int32 lightClustersShaderRegisterIndex = srv + 3;
     const bool canUseShadow = view.Pass != DrawPass::Depth;
 
     // Set fog input
@@ -97,24 +99,36 @@ void ForwardShadingFeature::Bind(MaterialShader::BindParameters& params, Span<by
         params.GPUContext->UnBindSR(envProbeShaderRegisterIndex);
     }
 
-    // Set local lights
+    // Set local lights (use clusters if available)
     data.LocalLightsCount = 0;
-    for (int32 i = 0; i < cache->PointLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+    if (cache->LightClusters)
     {
-        const auto& light = cache->PointLights[i];
-        if (BoundingSphere(light.Position, light.Radius).Contains(drawCall.ObjectPosition) != ContainmentType::Disjoint)
-        {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
-        }
+        data.LightClusters = cache->LightClustersConstants;
+        params.GPUContext->BindSR(lightClustersShaderRegisterIndex, cache->LightClusters->View());
+        params.GPUContext->BindSR(lightClustersShaderRegisterIndex + 1, cache->LightClustersLights->View());
     }
-    for (int32 i = 0; i < cache->SpotLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+    else
     {
-        const auto& light = cache->SpotLights[i];
-        if (BoundingSphere(light.Position, light.Radius).Contains(drawCall.ObjectPosition) != ContainmentType::Disjoint)
+        data.LightClusters.LightsCount = 0;
+        params.GPUContext->UnBindSR(lightClustersShaderRegisterIndex);
+        params.GPUContext->UnBindSR(lightClustersShaderRegisterIndex + 1);
+        for (int32 i = 0; i < cache->PointLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
         {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
+            const auto& light = cache->PointLights[i];
+            if (BoundingSphere(light.Position, light.Radius).Contains(drawCall.ObjectPosition) != ContainmentType::Disjoint)
+            {
+                light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
+                data.LocalLightsCount++;
+            }
+        }
+        for (int32 i = 0; i < cache->SpotLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+        {
+            const auto& light = cache->SpotLights[i];
+            if (BoundingSphere(light.Position, light.Radius).Contains(drawCall.ObjectPosition) != ContainmentType::Disjoint)
+            {
+                light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
+                data.LocalLightsCount++;
+            }
         }
     }
 
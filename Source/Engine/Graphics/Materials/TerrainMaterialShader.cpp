@@ -13,6 +13,8 @@
 #include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
 #include "Engine/Level/Scene/Lightmap.h"
 #include "Engine/Renderer/DrawCall.h"
+#include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Terrain/TerrainPatch.h"
 
 PACK_STRUCT(struct TerrainMaterialShaderData {
@@ -26,9 +28,53 @@ PACK_STRUCT(struct TerrainMaterialShaderData {
     Float4 HeightmapUVScaleBias; // xy-scale, zw-offset for chunk geometry UVs into heightmap UVs (as single MAD instruction)
     Float4 NeighborLOD; // Per component LOD index for chunk neighbors ordered: top, left, right, bottom
     Float2 OffsetUV; // Offset applied to the texture coordinates (used to implement seamless UVs based on chunk location relative to terrain root)
-    Float2 Dummy0;
+    float HeightmapMipOffset; // Amount of the heightmap mips not resident on the GPU (streamed out), subtracted from the sampled LOD
+    float SplatmapMipOffset; // Amount of the splatmaps mips not resident on the GPU (streamed out), subtracted from the sampled LOD
+    Float4 VirtualTextureUVScaleBias; // xy-scale, zw-offset for chunk UVs into the baked virtual texture page UVs (zero if not used)
     });
 
+// Per-chunk data used by the instanced terrain rendering (chunks of the same patch and LOD drawn with a single draw call), written over the InstanceData
+PACK_STRUCT(struct TerrainInstanceData {
+    Float3 InstanceOrigin; // Chunk location (the rotation and scale are shared by all chunks of the terrain)
+    float PerInstanceRandom;
+    Float4 HeightmapUVScaleBias;
+    Float4 NeighborLOD;
+    Float2 OffsetUV;
+    Float2 Padding;
+    });
+
+static_assert(sizeof(TerrainInstanceData) == sizeof(InstanceData), "Invalid terrain instance data size.");
+
+namespace
+{
+    void GetTerrainHash(const DrawCall& drawCall, uint32& batchKey)
+    {
+        batchKey = (batchKey * 397) ^ ::GetHash(drawCall.Terrain.Patch);
+    }
+
+    bool CanBatchTerrain(const DrawCall& a, const DrawCall& b)
+    {
+        // Chunks need to share the heightmap and splatmaps (the same patch) and can't use per-chunk lightmap or virtual texture page
+        return a.Terrain.Patch == b.Terrain.Patch &&
+                a.Terrain.CurrentLOD == b.Terrain.CurrentLOD &&
+                a.Terrain.Lightmap == nullptr &&
+                b.Terrain.Lightmap == nullptr &&
+                a.Terrain.VirtualTextureUVScaleBias.X == 0.0f &&
+                b.Terrain.VirtualTextureUVScaleBias.X == 0.0f;
+    }
+
+    void WriteTerrainDrawCall(InstanceData* instanceData, const DrawCall& drawCall)
+    {
+        auto data = (TerrainInstanceData*)instanceData;
+        data->InstanceOrigin = Float3(drawCall.World.M41, drawCall.World.M42, drawCall.World.M43);
+        data->PerInstanceRandom = drawCall.PerInstanceRandom;
+        data->HeightmapUVScaleBias = drawCall.Terrain.HeightmapUVScaleBias;
+        data->NeighborLOD = drawCall.Terrain.NeighborLOD;
+        data->OffsetUV = drawCall.Terrain.OffsetUV;
+        data->Padding = Float2::Zero;
+    }
+}
+
 DrawPass TerrainMaterialShader::GetDrawModes() const
 {
     return DrawPass::Depth | DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas;
@@ -39,6 +85,12 @@ bool TerrainMaterialShader::CanUseLightmap() const
     return true;
 }
 
+bool TerrainMaterialShader::CanUseInstancing(InstancingHandler& handler) const
+{
+    handler = { GetTerrainHash, CanBatchTerrain, WriteTerrainDrawCall, };
+    return true;
+}
+
 void TerrainMaterialShader::Bind(BindParameters& params)
 {
     // Prepare
@@ -49,7 +101,7 @@ void TerrainMaterialShader::Bind(BindParameters& params)
     ASSERT_LOW_LAYER(cb.Length() >= sizeof(TerrainMaterialShaderData));
     auto materialData = reinterpret_cast<TerrainMaterialShaderData*>(cb.Get());
     cb = Span<byte>(cb.Get() + sizeof(TerrainMaterialShaderData), cb.Length() - sizeof(TerrainMaterialShaderData));
-    int32 srv = 3;
+    int32 srv = 6;
 
     // Setup features
     const bool useLightmap = LightmapFeature::Bind(params, cb, srv);
@@ -82,15 +134,26 @@ void TerrainMaterialShader::Bind(BindParameters& params)
         materialData->HeightmapUVScaleBias = drawCall.Terrain.HeightmapUVScaleBias;
         materialData->NeighborLOD = drawCall.Terrain.NeighborLOD;
         materialData->OffsetUV = drawCall.Terrain.OffsetUV;
+        materialData->VirtualTextureUVScaleBias = drawCall.Terrain.VirtualTextureUVScaleBias;
     }
 
     // Bind terrain textures
     const auto heightmap = drawCall.Terrain.Patch->Heightmap->GetTexture();
     const auto splatmap0 = drawCall.Terrain.Patch->Splatmap[0] ? drawCall.Terrain.Patch->Splatmap[0]->GetTexture() : nullptr;
     const auto splatmap1 = drawCall.Terrain.Patch->Splatmap[1] ? drawCall.Terrain.Patch->Splatmap[1]->GetTexture() : nullptr;
+    materialData->HeightmapMipOffset = (float)(drawCall.Terrain.Patch->Heightmap->StreamingTexture()->TotalMipLevels() - heightmap->ResidentMipLevels());
+    materialData->SplatmapMipOffset = 0.0f;
+    for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+    {
+        const auto splatmap = drawCall.Terrain.Patch->Splatmap[i].Get();
+        if (splatmap)
+            materialData->SplatmapMipOffset = Math::Max(materialData->SplatmapMipOffset, (float)(splatmap->StreamingTexture()->TotalMipLevels() - splatmap->GetTexture()->ResidentMipLevels()));
+    }
     context->BindSR(0, heightmap);
     context->BindSR(1, splatmap0);
     context->BindSR(2, splatmap1);
+    if (drawCall.Terrain.VirtualTextureUVScaleBias.X != 0.0f)
+        TerrainVirtualTexturePass::Instance()->Bind(context, 3);
 
     // Bind constants
     if (_cb)
@@ -114,7 +177,8 @@ void TerrainMaterialShader::Bind(BindParameters& params)
         else
             cullMode = CullMode::Normal;
     }
-    const PipelineStateCache* psCache = _cache.GetPS(view.Pass, useLightmap);
+    const auto cache = params.DrawCallsCount == 1 ? &_cache : &_cacheInstanced;
+    const PipelineStateCache* psCache = cache->GetPS(view.Pass, useLightmap);
     ASSERT(psCache);
     GPUPipelineState* state = ((PipelineStateCache*)psCache)->GetPS(cullMode, wireframe);
 
@@ -128,6 +192,7 @@ void TerrainMaterialShader::Unload()
     MaterialShader::Unload();
 
     _cache.Release();
+    _cacheInstanced.Release();
 }
 
 bool TerrainMaterialShader::Load()
@@ -159,21 +224,31 @@ bool TerrainMaterialShader::Load()
     default: ;
     }
 
-    // GBuffer Pass
-    psDesc.VS = _shader->GetVS("VS");
+    // GBuffer Pass (instanced variants use vertex shader permutation for USE_INSTANCING=1)
+    auto defaultVS = _shader->GetVS("VS", 0);
+    auto instancedVS = _shader->GetVS("VS", 1);
+    psDesc.VS = defaultVS;
     psDesc.PS = _shader->GetPS("PS_GBuffer");
     _cache.Default.Init(psDesc);
+    psDesc.VS = instancedVS;
+    _cacheInstanced.Default.Init(psDesc);
 
     // GBuffer Pass with lightmap (use pixel shader permutation for USE_LIGHTMAP=1)
+    psDesc.VS = defaultVS;
     psDesc.PS = _shader->GetPS("PS_GBuffer", 1);
     _cache.DefaultLightmap.Init(psDesc);
+    psDesc.VS = instancedVS;
+    _cacheInstanced.DefaultLightmap.Init(psDesc);
 
 #if USE_EDITOR
     if (_shader->HasShader("PS_QuadOverdraw"))
     {
         // Quad Overdraw
+        psDesc.VS = defaultVS;
         psDesc.PS = _shader->GetPS("PS_QuadOverdraw");
         _cache.QuadOverdraw.Init(psDesc);
+        psDesc.VS = instancedVS;
+        _cacheInstanced.QuadOverdraw.Init(psDesc);
     }
 #endif
 
@@ -188,7 +263,10 @@ bool TerrainMaterialShader::Load()
     psDesc.DS = nullptr;
     // TODO: masked terrain materials (depth pass should clip holes)
     psDesc.PS = nullptr;
+    psDesc.VS = defaultVS;
     _cache.Depth.Init(psDesc);
+    psDesc.VS = instancedVS;
+    _cacheInstanced.Depth.Init(psDesc);
 
     return false;
 }
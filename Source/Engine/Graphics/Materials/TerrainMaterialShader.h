@@ -51,6 +51,7 @@ class TerrainMaterialShader : public MaterialShader
 
 private:
     Cache _cache;
+    Cache _cacheInstanced;
 
 public:
     /// <summary>
@@ -66,6 +67,7 @@ class TerrainMaterialShader : public MaterialShader
     // [MaterialShader]
     DrawPass GetDrawModes() const override;
     bool CanUseLightmap() const override;
+    bool CanUseInstancing(InstancingHandler& handler) const override;
     void Bind(BindParameters& params) override;
     void Unload() override;
 
@@ -2,8 +2,105 @@
 
 #include "BlendShape.h"
 #include "Engine/Content/Assets/SkinnedModel.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Renderer/Utils/BlendShapesPass.h"
+
+PACK_STRUCT(struct BlendShapeDeltaGPU {
+    Float3 PositionDelta;
+    uint32 BlendShapeIndex;
+    Float3 NormalDelta;
+    float Padding;
+    });
+
+BlendShapesMeshData::~BlendShapesMeshData()
+{
+    Release();
+}
+
+bool BlendShapesMeshData::Init(const SkinnedMesh* mesh)
+{
+    Release();
+    PROFILE_CPU_NAMED("Init Blend Shapes Data");
+    const int32 vertexCount = mesh->GetVertexCount();
+    if (mesh->BlendShapes.IsEmpty() || vertexCount == 0)
+        return true;
+
+    // Get the range of vertices modified by any blend shape
+    MinVertexIndex = MAX_uint32;
+    MaxVertexIndex = 0;
+    UseNormals = false;
+    int32 deltasCount = 0;
+    for (const BlendShape& blendShape : mesh->BlendShapes)
+    {
+        MinVertexIndex = Math::Min(MinVertexIndex, blendShape.MinVertexIndex);
+        MaxVertexIndex = Math::Max(MaxVertexIndex, blendShape.MaxVertexIndex);
+        UseNormals |= blendShape.UseNormals;
+        deltasCount += blendShape.Vertices.Count();
+    }
+    if (deltasCount == 0 || MaxVertexIndex >= (uint32)vertexCount || MinVertexIndex > MaxVertexIndex)
+        return true;
+    const int32 rangesCount = (int32)(MaxVertexIndex - MinVertexIndex + 1);
+
+    // Group deltas per vertex so every vertex is blended by a single thread
+    Array<Int2> ranges;
+    ranges.Resize(rangesCount);
+    Platform::MemoryClear(ranges.Get(), ranges.Count() * sizeof(Int2));
+    for (const BlendShape& blendShape : mesh->BlendShapes)
+    {
+        for (const BlendShapeVertex& v : blendShape.Vertices)
+            ranges[v.VertexIndex - MinVertexIndex].Y++;
+    }
+    for (int32 i = 1; i < rangesCount; i++)
+        ranges[i].X = ranges[i - 1].X + ranges[i - 1].Y;
+    Array<BlendShapeDeltaGPU> deltas;
+    deltas.Resize(deltasCount);
+    Array<int32> counters;
+    counters.Resize(rangesCount);
+    Platform::MemoryClear(counters.Get(), counters.Count() * sizeof(int32));
+    for (int32 blendShapeIndex = 0; blendShapeIndex < mesh->BlendShapes.Count(); blendShapeIndex++)
+    {
+        const BlendShape& blendShape = mesh->BlendShapes[blendShapeIndex];
+        for (const BlendShapeVertex& v : blendShape.Vertices)
+        {
+            const int32 rangeIndex = v.VertexIndex - MinVertexIndex;
+            BlendShapeDeltaGPU& delta = deltas[ranges[rangeIndex].X + counters[rangeIndex]++];
+            delta.PositionDelta = v.PositionDelta;
+            delta.BlendShapeIndex = blendShapeIndex;
+            delta.NormalDelta = blendShape.UseNormals ? v.NormalDelta : Float3::Zero;
+            delta.Padding = 0.0f;
+        }
+    }
+
+    // Upload data
+    auto desc = GPUBufferDescription::Structured(rangesCount, sizeof(Int2));
+    desc.InitData = ranges.Get();
+    Ranges = GPUDevice::Instance->CreateBuffer(TEXT("BlendShapes.Ranges"));
+    Ranges->SetCategory(GPUResourceCategory::Models);
+    if (Ranges->Init(desc))
+    {
+        Release();
+        return true;
+    }
+    desc = GPUBufferDescription::Structured(deltasCount, sizeof(BlendShapeDeltaGPU));
+    desc.InitData = deltas.Get();
+    Deltas = GPUDevice::Instance->CreateBuffer(TEXT("BlendShapes.Deltas"));
+    Deltas->SetCategory(GPUResourceCategory::Models);
+    if (Deltas->Init(desc))
+    {
+        Release();
+        return true;
+    }
+
+    return false;
+}
+
+void BlendShapesMeshData::Release()
+{
+    SAFE_DELETE_GPU_RESOURCE(Ranges);
+    SAFE_DELETE_GPU_RESOURCE(Deltas);
+}
 
 BlendShapesInstance::MeshInstance::MeshInstance()
     : IsUsed(false)
@@ -11,11 +108,59 @@ BlendShapesInstance::MeshInstance::MeshInstance()
     , DirtyMinVertexIndex(0)
     , DirtyMaxVertexIndex(MAX_uint32 - 1)
     , VertexBuffer(0, sizeof(VB0SkinnedElementType), TEXT("Skinned Mesh Blend Shape"))
+    , UseGPU(false)
+    , UseNormals(false)
+    , GPUMinVertexIndex(0)
+    , GPUMaxVertexIndex(MAX_uint32 - 1)
+    , GPUWeightsBuffer(nullptr)
+    , GPUVertexBuffer(nullptr)
 {
 }
 
 BlendShapesInstance::MeshInstance::~MeshInstance()
 {
+    if (UseGPU)
+        BlendShapesPass::Instance()->Remove(this);
+    SAFE_DELETE_GPU_RESOURCE(GPUWeightsBuffer);
+    SAFE_DELETE_GPU_RESOURCE(GPUVertexBuffer);
+}
+
+void BlendShapesInstance::MeshInstance::Flush(const SkinnedMesh* mesh)
+{
+    IsDirty = false;
+    if (!UseGPU)
+    {
+        VertexBuffer.Flush();
+        return;
+    }
+
+    // Ensure to have the output buffer created (it's used by the draw call before the blending gets executed)
+    const uint32 size = mesh->GetVertexCount() * sizeof(VB0SkinnedElementType);
+    if (!GPUVertexBuffer)
+    {
+        GPUVertexBuffer = GPUDevice::Instance->CreateBuffer(TEXT("Skinned Mesh Blend Shape"));
+        GPUVertexBuffer->SetCategory(GPUResourceCategory::Models);
+    }
+    if (GPUVertexBuffer->GetSize() != size)
+    {
+        auto desc = GPUBufferDescription::Raw(size, GPUBufferFlags::VertexBuffer | GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess);
+        desc.Stride = sizeof(VB0SkinnedElementType);
+        if (GPUVertexBuffer->Init(desc))
+        {
+            SAFE_DELETE_GPU_RESOURCE(GPUVertexBuffer);
+            return;
+        }
+        GPUMinVertexIndex = 0;
+        GPUMaxVertexIndex = MAX_uint32 - 1;
+    }
+
+    // Blending is executed by the renderer (drawing can happen on worker threads)
+    BlendShapesPass::Instance()->Add(this, mesh);
+}
+
+GPUBuffer* BlendShapesInstance::MeshInstance::GetVertexBuffer() const
+{
+    return UseGPU ? GPUVertexBuffer : VertexBuffer.GetBuffer();
 }
 
 BlendShapesInstance::~BlendShapesInstance()
@@ -35,6 +180,7 @@ void BlendShapesInstance::Update(SkinnedModel* skinnedModel)
         return;
     }
     PROFILE_CPU_NAMED("Update Blend Shapes");
+    const bool useGPU = BlendShapesPass::Instance()->CanUse();
 
     // Collect used meshes
     for (auto& e : Meshes)
@@ -79,6 +225,45 @@ void BlendShapesInstance::Update(SkinnedModel* skinnedModel)
             continue;
         const SkinnedMesh* mesh = e.Key;
 
+        if (useGPU)
+        {
+            // Collect only the weights of the mesh blend shapes (vertices are blended by the compute shader)
+            uint32 minVertexIndex = MAX_uint32, maxVertexIndex = 0;
+            bool useNormals = false;
+            instance.GPUWeights.Resize(mesh->BlendShapes.Count());
+            for (int32 blendShapeIndex = 0; blendShapeIndex < mesh->BlendShapes.Count(); blendShapeIndex++)
+            {
+                const BlendShape& blendShape = mesh->BlendShapes[blendShapeIndex];
+                float weight = 0.0f;
+                for (auto& q : Weights)
+                {
+                    if (q.First == blendShape.Name)
+                    {
+                        weight = q.Second * blendShape.Weight;
+                        minVertexIndex = Math::Min(minVertexIndex, blendShape.MinVertexIndex);
+                        maxVertexIndex = Math::Max(maxVertexIndex, blendShape.MaxVertexIndex);
+                        useNormals |= blendShape.UseNormals;
+                        break;
+                    }
+                }
+                instance.GPUWeights[blendShapeIndex] = weight;
+            }
+            instance.UseGPU = true;
+            instance.UseNormals = useNormals;
+            instance.IsDirty = true;
+            instance.DirtyMinVertexIndex = minVertexIndex;
+            instance.DirtyMaxVertexIndex = maxVertexIndex;
+            continue;
+        }
+        if (instance.UseGPU)
+        {
+            // Switch back to CPU blending (initialize the whole vertex buffer)
+            BlendShapesPass::Instance()->Remove(&instance);
+            instance.UseGPU = false;
+            instance.DirtyMinVertexIndex = 0;
+            instance.DirtyMaxVertexIndex = MAX_uint32 - 1;
+        }
+
         // Get skinned mesh vertex buffer data (original, cached on CPU)
         BytesContainer vertexBuffer;
         int32 vertexCount;
@@ -128,7 +313,7 @@ void BlendShapesInstance::Update(SkinnedModel* skinnedModel)
                     ASSERT_LOW_LAYER(blendShapeVertex.VertexIndex < (uint32)vertexCount);
                     VB0SkinnedElementType& vertex = *(data + blendShapeVertex.VertexIndex);
                     vertex.Position = vertex.Position + blendShapeVertex.PositionDelta * q.Second;
-                    Float3 normal = (vertex.Normal.ToFloat3() * 2.0f - 1.0f) + blendShapeVertex.NormalDelta;
+                    Float3 normal = (vertex.Normal.ToFloat3() * 2.0f - 1.0f) + blendShapeVertex.NormalDelta * q.Second;
                     vertex.Normal = normal * 0.5f + 0.5f;
                 }
             }
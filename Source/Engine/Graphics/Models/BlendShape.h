@@ -77,6 +77,61 @@ class BlendShape
     Array<BlendShapeVertex> Vertices;
 };
 
+/// <summary>
+/// The blend shapes data of the mesh resident on the GPU (vertex deltas grouped per vertex and shared by all instances of the mesh). Used by the compute shader blending.
+/// </summary>
+class BlendShapesMeshData
+{
+public:
+    /// <summary>
+    /// The deltas range of each vertex in the blended range (offset and count of the deltas). Structured buffer with uint2 elements.
+    /// </summary>
+    GPUBuffer* Ranges = nullptr;
+
+    /// <summary>
+    /// The vertex deltas of all blend shapes of the mesh. Structured buffer with the position delta, blend shape index and normal delta.
+    /// </summary>
+    GPUBuffer* Deltas = nullptr;
+
+    /// <summary>
+    /// The minimum index of the vertex in all blend shapes of the mesh.
+    /// </summary>
+    uint32 MinVertexIndex = 0;
+
+    /// <summary>
+    /// The maximum index of the vertex in all blend shapes of the mesh.
+    /// </summary>
+    uint32 MaxVertexIndex = 0;
+
+    /// <summary>
+    /// True if any blend shape contains deltas for normal vectors of the mesh.
+    /// </summary>
+    bool UseNormals = false;
+
+public:
+    ~BlendShapesMeshData();
+
+    /// <summary>
+    /// Determines whether the GPU data has been created.
+    /// </summary>
+    FORCE_INLINE bool IsReady() const
+    {
+        return Deltas != nullptr;
+    }
+
+    /// <summary>
+    /// Creates the GPU buffers with the blend shapes of the mesh.
+    /// </summary>
+    /// <param name="mesh">The mesh.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Init(const SkinnedMesh* mesh);
+
+    /// <summary>
+    /// Releases the GPU buffers.
+    /// </summary>
+    void Release();
+};
+
 /// <summary>
 /// The blend shapes runtime instance data. Handles blend shapes updating, blending and preparing for skinned mesh rendering.
 /// </summary>
@@ -95,8 +150,28 @@ class BlendShapesInstance
         uint32 DirtyMaxVertexIndex;
         DynamicVertexBuffer VertexBuffer;
 
+        // GPU blending (only the weights are uploaded, deltas are resident in the mesh data)
+        bool UseGPU;
+        bool UseNormals;
+        uint32 GPUMinVertexIndex;
+        uint32 GPUMaxVertexIndex;
+        Array<float> GPUWeights;
+        GPUBuffer* GPUWeightsBuffer;
+        GPUBuffer* GPUVertexBuffer;
+
         MeshInstance();
         ~MeshInstance();
+
+        /// <summary>
+        /// Flushes the blended vertices before rendering the mesh (uploads the vertex buffer or queues the compute shader blending).
+        /// </summary>
+        /// <param name="mesh">The mesh.</param>
+        void Flush(const SkinnedMesh* mesh);
+
+        /// <summary>
+        /// Gets the vertex buffer with the blended vertices. Returns null if not ready.
+        /// </summary>
+        GPUBuffer* GetVertexBuffer() const;
     };
 
 public:
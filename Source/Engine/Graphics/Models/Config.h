@@ -16,6 +16,16 @@
 // Enable/disable precise mesh collision testing (with in-build vertex buffer caching, this will increase memory usage)
 #define USE_PRECISE_MESH_INTERSECTS (USE_EDITOR)
 
+// The minimum amount of triangles of the model mesh to split it into clusters during import (used for the per-cluster culling of the high-poly meshes)
+#define MODEL_MESH_CLUSTERS_MIN_TRIANGLES 8192
+
+// The maximum amount of vertices and triangles in a single mesh cluster
+#define MODEL_MESH_CLUSTER_MAX_VERTICES 64
+#define MODEL_MESH_CLUSTER_MAX_TRIANGLES 124
+
+// The maximum amount of index buffer ranges drawn for a single mesh after the clusters culling (more fragmented visibility draws the whole mesh at once)
+#define MODEL_MESH_CLUSTERS_MAX_RANGES 16
+
 // Defines the maximum amount of bones affecting every vertex of the skinned mesh
 #define MAX_BONES_PER_VERTEX 4
 
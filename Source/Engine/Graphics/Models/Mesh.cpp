@@ -2,6 +2,7 @@
 
 #include "Mesh.h"
 #include "ModelInstanceEntry.h"
+#include "MeshDrawCache.h"
 #include "Engine/Content/Assets/Material.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Core/Log.h"
@@ -23,6 +24,70 @@
 
 namespace
 {
+    typedef Array<Int2, FixedAllocation<MODEL_MESH_CLUSTERS_MAX_RANGES>> MeshClusterRanges;
+
+    // Performs the per-cluster culling of the mesh (frustum, normals cone and occlusion) and gathers the index buffer ranges of the visible clusters (contiguous clusters are merged)
+    // Returns false if the whole mesh should be drawn (all clusters are visible or the visibility is too fragmented)
+    bool CullClusters(const RenderContext& renderContext, const Array<MeshCluster>& clusters, const MaterialBase* material, const Matrix& world, MeshClusterRanges& ranges)
+    {
+        const MaterialInfo& materialInfo = material->GetInfo();
+        if (EnumHasAnyFlags(materialInfo.UsageFlags, MaterialUsageFlags::UsePositionOffset | MaterialUsageFlags::UseDisplacement))
+            return false;
+        const RenderView& view = renderContext.View;
+        const Float3 scale = world.GetScaleVector();
+        const float maxScale = scale.MaxValue();
+
+        // Normals cone is valid only for the single-sided geometry with uniform scale (and not mirrored), skip it for the depth-only passes (eg. shadow maps)
+        const bool coneCulling = materialInfo.CullMode == CullMode::Normal &&
+                EnumHasAnyFlags(view.Pass, DrawPass::GBuffer | DrawPass::Forward) &&
+                world.RotDeterminant() > 0.0f &&
+                Math::NearEqual(scale.X, scale.Y, maxScale * 0.01f) &&
+                Math::NearEqual(scale.X, scale.Z, maxScale * 0.01f);
+        const bool isOrthographic = view.IsOrthographicProjection();
+
+        bool anyCulled = false;
+        for (const MeshCluster& cluster : clusters)
+        {
+            BoundingSphere sphere;
+            Vector3::Transform(Vector3(cluster.Center), world, sphere.Center);
+            sphere.Radius = cluster.Radius * maxScale;
+            bool visible = view.CullingFrustum.Intersects(sphere);
+            if (visible && coneCulling && cluster.ConeCutoff < 1.0f)
+            {
+                Float3 coneAxis;
+                Float3::TransformNormal(cluster.ConeAxis, world, coneAxis);
+                coneAxis.Normalize();
+                if (isOrthographic)
+                {
+                    visible = Float3::Dot(view.Direction, coneAxis) < cluster.ConeCutoff;
+                }
+                else
+                {
+                    const Float3 toCenter = Float3(sphere.Center) - view.Position;
+                    visible = Float3::Dot(toCenter, coneAxis) < cluster.ConeCutoff * toCenter.Length() + (float)sphere.Radius;
+                }
+            }
+            if (visible && renderContext.List->IsOccluded(sphere))
+                visible = false;
+            if (!visible)
+            {
+                anyCulled = true;
+                continue;
+            }
+            if (ranges.HasItems() && (uint32)(ranges.Last().X + ranges.Last().Y) == cluster.StartIndex)
+            {
+                ranges.Last().Y += (int32)cluster.IndicesCount;
+            }
+            else
+            {
+                if (ranges.Count() == MODEL_MESH_CLUSTERS_MAX_RANGES)
+                    return false;
+                ranges.Add(Int2((int32)cluster.StartIndex, (int32)cluster.IndicesCount));
+            }
+        }
+        return anyCulled;
+    }
+
     template<typename IndexType>
     bool UpdateMesh(Mesh* mesh, uint32 vertexCount, uint32 triangleCount, Float3* vertices, IndexType* triangles, Float3* normals, Float3* tangents, Float2* uvs, Color32* colors)
     {
@@ -194,6 +259,7 @@ bool Mesh::UpdateTriangles(uint32 triangleCount, void* ib, bool use16BitIndices)
 
     // Create index buffer
     GPUBuffer* indexBuffer = GPUDevice::Instance->CreateBuffer(String::Empty);
+    indexBuffer->SetCategory(GPUResourceCategory::Models);
     if (indexBuffer->Init(GPUBufferDescription::Index(ibStride, indicesCount, ib)))
     {
         Delete(indexBuffer);
@@ -207,6 +273,7 @@ bool Mesh::UpdateTriangles(uint32 triangleCount, void* ib, bool use16BitIndices)
     _indexBuffer = indexBuffer;
     _triangles = triangleCount;
     _use16BitIndexBuffer = use16BitIndices;
+    _clusters.Resize(0);
 
     return false;
 }
@@ -256,18 +323,22 @@ bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* v
 #define MESH_BUFFER_NAME(postfix) String::Empty
 #endif
     vertexBuffer0 = GPUDevice::Instance->CreateBuffer(MESH_BUFFER_NAME(".VB0"));
+    vertexBuffer0->SetCategory(GPUResourceCategory::Models);
     if (vertexBuffer0->Init(GPUBufferDescription::Vertex(sizeof(VB0ElementType), vertices, vb0)))
         goto ERROR_LOAD_END;
     vertexBuffer1 = GPUDevice::Instance->CreateBuffer(MESH_BUFFER_NAME(".VB1"));
+    vertexBuffer1->SetCategory(GPUResourceCategory::Models);
     if (vertexBuffer1->Init(GPUBufferDescription::Vertex(sizeof(VB1ElementType), vertices, vb1)))
         goto ERROR_LOAD_END;
     if (vb2)
     {
         vertexBuffer2 = GPUDevice::Instance->CreateBuffer(MESH_BUFFER_NAME(".VB2"));
+        vertexBuffer2->SetCategory(GPUResourceCategory::Models);
         if (vertexBuffer2->Init(GPUBufferDescription::Vertex(sizeof(VB2ElementType), vertices, vb2)))
             goto ERROR_LOAD_END;
     }
     indexBuffer = GPUDevice::Instance->CreateBuffer(MESH_BUFFER_NAME(".IB"));
+    indexBuffer->SetCategory(GPUResourceCategory::Models);
     if (indexBuffer->Init(GPUBufferDescription::Index(ibStride, indicesCount, ib)))
         goto ERROR_LOAD_END;
 
@@ -290,6 +361,7 @@ bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* v
     _triangles = triangles;
     _vertices = vertices;
     _use16BitIndexBuffer = use16BitIndexBuffer;
+    _texCoordsRange = ComputeTexCoordsRange((const VB1ElementType*)vb1, vertices);
     _cachedVertexBuffer[0].Clear();
     _cachedVertexBuffer[1].Clear();
     _cachedVertexBuffer[2].Clear();
@@ -315,6 +387,7 @@ void Mesh::Unload()
     _triangles = 0;
     _vertices = 0;
     _use16BitIndexBuffer = false;
+    _clusters.Resize(0);
     _cachedIndexBuffer.Resize(0);
     _cachedVertexBuffer[0].Clear();
     _cachedVertexBuffer[1].Clear();
@@ -511,6 +584,23 @@ void Mesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float
         GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, &((Model*)_model)->LODs[_lodIndex]);
 #endif
 
+    // Request the textures resolution needed on screen for the streaming
+    if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer | DrawPass::Forward) && !renderContext.View.IsOfflinePass)
+        RequestTexturesResolution(renderContext.View, material, *info.World);
+
+    // Draw only the visible clusters of the high-poly mesh
+    MeshClusterRanges ranges;
+    if (_clusters.HasItems() && CullClusters(renderContext, _clusters, material, *info.World, ranges))
+    {
+        for (const Int2& range : ranges)
+        {
+            drawCall.Draw.StartIndex = range.X;
+            drawCall.Draw.IndicesCount = range.Y;
+            renderContext.List->AddDrawCall(renderContext, drawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
+        }
+        return;
+    }
+
     // Push draw call to the render list
     renderContext.List->AddDrawCall(renderContext, drawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
 }
@@ -521,50 +611,91 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
     if (!entry.Visible || !IsInitialized())
         return;
     const MaterialSlot& slot = _model->MaterialSlots[_materialSlotIndex];
+    const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
 
-    // Select material
+    // Try to reuse the draw call prebuilt in one of the previous frames
+    DrawCall drawCall;
+    DrawPass drawModes;
     MaterialBase* material;
-    if (entry.Material && entry.Material->IsLoaded())
-        material = entry.Material;
-    else if (slot.Material && slot.Material->IsLoaded())
-        material = slot.Material;
+    MeshDrawCache::Entry* cacheEntry = nullptr;
+    if (info.DrawCache)
+    {
+        auto& lodCache = info.DrawCache->LODs[_lodIndex];
+        if (lodCache.Count() <= _index)
+            lodCache.Resize(_index + 1);
+        cacheEntry = &lodCache.Get()[_index];
+    }
+    if (cacheEntry &&
+        cacheEntry->Valid &&
+        cacheEntry->EntryMaterial == entry.Material.Get() &&
+        cacheEntry->SlotMaterial == slot.Material.Get() &&
+        cacheEntry->ShadowsMode == shadowsMode &&
+        cacheEntry->ReceiveDecals == entry.ReceiveDecals &&
+        cacheEntry->Call.Geometry.IndexBuffer == _indexBuffer &&
+        cacheEntry->Material->IsLoaded())
+    {
+        drawCall = cacheEntry->Call;
+        material = cacheEntry->Material;
+        drawModes = cacheEntry->DrawModes;
+    }
     else
-        material = GPUDevice::Instance->GetDefaultMaterial();
-    if (!material || !material->IsSurface())
-        return;
-
-    // Setup draw call
-    DrawCall drawCall;
-    drawCall.Geometry.IndexBuffer = _indexBuffer;
-    drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
-    drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
-    drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
-    drawCall.Geometry.VertexBuffersOffsets[0] = 0;
-    drawCall.Geometry.VertexBuffersOffsets[1] = 0;
-    drawCall.Geometry.VertexBuffersOffsets[2] = 0;
-    if (info.VertexColors && info.VertexColors[_lodIndex])
     {
-        // TODO: cache vertexOffset within the model LOD per-mesh
-        uint32 vertexOffset = 0;
-        for (int32 meshIndex = 0; meshIndex < _index; meshIndex++)
-            vertexOffset += ((Model*)_model)->LODs[_lodIndex].Meshes[meshIndex].GetVertexCount();
-        drawCall.Geometry.VertexBuffers[2] = info.VertexColors[_lodIndex];
-        drawCall.Geometry.VertexBuffersOffsets[2] = vertexOffset * sizeof(VB2ElementType);
+        // Select material
+        if (entry.Material && entry.Material->IsLoaded())
+            material = entry.Material;
+        else if (slot.Material && slot.Material->IsLoaded())
+            material = slot.Material;
+        else
+            material = GPUDevice::Instance->GetDefaultMaterial();
+        if (!material || !material->IsSurface())
+            return;
+
+        // Setup draw call
+        drawCall.Geometry.IndexBuffer = _indexBuffer;
+        drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
+        drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
+        drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
+        drawCall.Geometry.VertexBuffersOffsets[0] = 0;
+        drawCall.Geometry.VertexBuffersOffsets[1] = 0;
+        drawCall.Geometry.VertexBuffersOffsets[2] = 0;
+        if (info.VertexColors && info.VertexColors[_lodIndex])
+        {
+            // TODO: cache vertexOffset within the model LOD per-mesh
+            uint32 vertexOffset = 0;
+            for (int32 meshIndex = 0; meshIndex < _index; meshIndex++)
+                vertexOffset += ((Model*)_model)->LODs[_lodIndex].Meshes[meshIndex].GetVertexCount();
+            drawCall.Geometry.VertexBuffers[2] = info.VertexColors[_lodIndex];
+            drawCall.Geometry.VertexBuffersOffsets[2] = vertexOffset * sizeof(VB2ElementType);
+        }
+        drawCall.Draw.StartIndex = 0;
+        drawCall.Draw.IndicesCount = _triangles * 3;
+        drawCall.InstanceCount = 1;
+        drawCall.Material = material;
+        drawCall.World = *info.World;
+        drawCall.ObjectPosition = drawCall.World.GetTranslation();
+        drawCall.Surface.GeometrySize = _box.GetSize();
+        drawCall.Surface.Lightmap = (info.Flags & StaticFlags::Lightmap) != StaticFlags::None ? info.Lightmap : nullptr;
+        drawCall.Surface.LightmapUVsArea = info.LightmapUVs ? *info.LightmapUVs : Rectangle::Empty;
+        drawCall.Surface.Skinning = nullptr;
+        drawCall.WorldDeterminantSign = Math::FloatSelect(drawCall.World.RotDeterminant(), 1, -1);
+        drawCall.PerInstanceRandom = info.PerInstanceRandom;
+        drawModes = info.DrawModes & material->GetDrawModes();
+
+        // Cache the draw call (skip the default material used as a fallback while the assigned one is loading)
+        if (cacheEntry)
+        {
+            cacheEntry->Call = drawCall;
+            cacheEntry->Material = material;
+            cacheEntry->EntryMaterial = entry.Material.Get();
+            cacheEntry->SlotMaterial = slot.Material.Get();
+            cacheEntry->DrawModes = drawModes;
+            cacheEntry->ShadowsMode = shadowsMode;
+            cacheEntry->ReceiveDecals = entry.ReceiveDecals;
+            cacheEntry->Valid = material == entry.Material.Get() || material == slot.Material.Get();
+        }
     }
-    drawCall.Draw.StartIndex = 0;
-    drawCall.Draw.IndicesCount = _triangles * 3;
-    drawCall.InstanceCount = 1;
-    drawCall.Material = material;
-    drawCall.World = *info.World;
-    drawCall.ObjectPosition = drawCall.World.GetTranslation();
-    drawCall.Surface.GeometrySize = _box.GetSize();
     drawCall.Surface.PrevWorld = info.DrawState->PrevWorld;
-    drawCall.Surface.Lightmap = (info.Flags & StaticFlags::Lightmap) != StaticFlags::None ? info.Lightmap : nullptr;
-    drawCall.Surface.LightmapUVsArea = info.LightmapUVs ? *info.LightmapUVs : Rectangle::Empty;
-    drawCall.Surface.Skinning = nullptr;
     drawCall.Surface.LODDitherFactor = lodDitherFactor;
-    drawCall.WorldDeterminantSign = Math::FloatSelect(drawCall.World.RotDeterminant(), 1, -1);
-    drawCall.PerInstanceRandom = info.PerInstanceRandom;
 #if USE_EDITOR
     const ViewMode viewMode = renderContextBatch.GetMainContext().View.Mode;
     if (viewMode == ViewMode::LightmapUVsDensity || viewMode == ViewMode::LODPreview)
@@ -572,10 +703,45 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
 #endif
 
     // Push draw call to the render lists
-    const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
-    const auto drawModes = info.DrawModes & material->GetDrawModes();
+    const RenderContext& mainRenderContext = renderContextBatch.GetMainContext();
+    if (info.ShadowsOnly)
+    {
+        // Shadow projections use a different LOD than the main view
+        if (drawModes != DrawPass::None)
+            mainRenderContext.List->AddShadowsDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, info.SortOrder);
+        return;
+    }
     if (drawModes != DrawPass::None)
-        renderContextBatch.GetMainContext().List->AddDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
+    {
+        const DrawPass mainDrawModes = drawModes & mainRenderContext.View.Pass & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
+        MeshClusterRanges ranges;
+        if (_clusters.HasItems() && mainDrawModes != DrawPass::None && CullClusters(mainRenderContext, _clusters, material, *info.World, ranges))
+        {
+            // Draw only the visible clusters of the high-poly mesh in the main view (shadow projections use the whole mesh)
+            DrawCall rangeDrawCall = drawCall;
+            for (const Int2& range : ranges)
+            {
+                rangeDrawCall.Draw.StartIndex = range.X;
+                rangeDrawCall.Draw.IndicesCount = range.Y;
+                mainRenderContext.List->AddDrawCall(mainRenderContext, mainDrawModes, info.Flags, rangeDrawCall, entry.ReceiveDecals, info.SortOrder);
+            }
+            if (!info.SkipShadows)
+                mainRenderContext.List->AddShadowsDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, info.SortOrder);
+        }
+        else if (info.SkipShadows)
+        {
+            if (mainDrawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(info.Bounds))
+                mainRenderContext.List->AddDrawCall(mainRenderContext, mainDrawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
+        }
+        else
+        {
+            mainRenderContext.List->AddDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
+        }
+    }
+
+    // Request the textures resolution needed on screen for the streaming
+    if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer | DrawPass::Forward) && !renderContextBatch.GetMainContext().View.IsOfflinePass)
+        RequestTexturesResolution(renderContextBatch.GetMainContext().View, material, *info.World);
 }
 
 bool Mesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) const
@@ -18,10 +18,12 @@ class Lightmap;
 API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
 {
     DECLARE_SCRIPTING_TYPE_WITH_CONSTRUCTOR_IMPL(Mesh, MeshBase);
+    friend class ModelLOD;
 protected:
     bool _hasLightmapUVs;
     GPUBuffer* _vertexBuffers[3] = {};
     GPUBuffer* _indexBuffer = nullptr;
+    Array<MeshCluster> _clusters;
 #if USE_PRECISE_MESH_INTERSECTS
     CollisionProxy _collisionProxy;
 #endif
@@ -83,6 +85,14 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
     /// </summary>
     API_PROPERTY() bool HasVertexColors() const;
 
+    /// <summary>
+    /// Gets the mesh clusters (contiguous ranges of the index buffer with bounds) used for the per-cluster culling. Empty if mesh doesn't use clusters.
+    /// </summary>
+    FORCE_INLINE const Array<MeshCluster>& GetClusters() const
+    {
+        return _clusters;
+    }
+
     /// <summary>
     /// Determines whether this mesh contains valid lightmap texture coordinates data.
     /// </summary>
@@ -13,12 +13,15 @@
 struct GeometryDrawStateData;
 struct RenderContext;
 struct RenderContextBatch;
+struct RenderView;
+class MaterialBase;
 class Task;
 class ModelBase;
 class Lightmap;
 class GPUBuffer;
 class SkinnedMeshDrawData;
 class BlendShapesInstance;
+struct MeshDrawCache;
 
 /// <summary>
 /// Base class for model resources meshes.
@@ -36,12 +39,29 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
     uint32 _triangles;
     int32 _materialSlotIndex;
     bool _use16BitIndexBuffer;
+    float _texCoordsRange = 1.0f;
 
     explicit MeshBase(const SpawnParams& params)
         : ScriptingObject(params)
     {
     }
 
+    template<typename VertexType>
+    static float ComputeTexCoordsRange(const VertexType* vertices, uint32 count)
+    {
+        if (!vertices || count == 0)
+            return 1.0f;
+        Float2 min = vertices[0].TexCoord.ToFloat2(), max = min;
+        for (uint32 i = 1; i < count; i++)
+        {
+            const Float2 uv = vertices[i].TexCoord.ToFloat2();
+            Float2::Min(min, uv, min);
+            Float2::Max(max, uv, max);
+        }
+        const Float2 size = max - min;
+        return Math::Max(Math::Max(size.X, size.Y), 0.01f);
+    }
+
 public:
     /// <summary>
     /// Gets the model owning this mesh.
@@ -120,12 +140,28 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
     /// </summary>
     API_PROPERTY() void SetMaterialSlotIndex(int32 value);
 
+    /// <summary>
+    /// Gets the range of the texture coordinates used by the mesh vertices (size of the UVs bounds along the longer axis). Values above 1 mean that textures are tiled over the mesh.
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE float GetTexCoordsRange() const
+    {
+        return _texCoordsRange;
+    }
+
     /// <summary>
     /// Sets the mesh bounds.
     /// </summary>
     /// <param name="box">The bounding box.</param>
     void SetBounds(const BoundingBox& box);
 
+    /// <summary>
+    /// Requests the resolution of the material textures needed to draw this mesh in the view. Estimated from the mesh projected size and texture coordinates range. Used by the textures streaming to load only the mip levels needed on screen.
+    /// </summary>
+    /// <param name="view">The rendering view.</param>
+    /// <param name="material">The material used to draw the mesh.</param>
+    /// <param name="world">The mesh world matrix (relative to the view origin).</param>
+    void RequestTexturesResolution(const RenderView& view, const MaterialBase* material, const Matrix& world) const;
+
 public:
     /// <summary>
     /// Extract mesh buffer data from GPU. Cannot be called from the main thread.
@@ -207,6 +243,11 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
         /// </summary>
         GPUBuffer** VertexColors;
 
+        /// <summary>
+        /// The cache of the draw calls prebuilt for the static object (reused across frames). Optional, can be null.
+        /// </summary>
+        MeshDrawCache* DrawCache;
+
         /// <summary>
         /// The object static flags.
         /// </summary>
@@ -241,5 +282,15 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
         /// The object sorting key.
         /// </summary>
         int16 SortOrder;
+
+        /// <summary>
+        /// True if skip drawing into the shadow projections (they use a different LOD).
+        /// </summary>
+        bool SkipShadows = false;
+
+        /// <summary>
+        /// True if draw only into the shadow projections (skips the main render context).
+        /// </summary>
+        bool ShadowsOnly = false;
     };
 };
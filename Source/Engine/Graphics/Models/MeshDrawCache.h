@@ -0,0 +1,106 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Config.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Renderer/DrawCall.h"
+
+/// <summary>
+/// The cache of the mesh draw calls prebuilt for the static object (with static transform) that are reused across frames.
+/// Per-frame data (LOD selection, culling, sorting, previous world matrix and LOD transition) is still evaluated during every draw.
+/// </summary>
+struct FLAXENGINE_API MeshDrawCache
+{
+    /// <summary>
+    /// The cached mesh draw call.
+    /// </summary>
+    struct Entry
+    {
+        /// <summary>
+        /// The prebuilt draw call.
+        /// </summary>
+        DrawCall Call;
+
+        /// <summary>
+        /// The material used by the draw call.
+        /// </summary>
+        MaterialBase* Material;
+
+        /// <summary>
+        /// The model instance entry material used to build the draw call (used to detect material changes).
+        /// </summary>
+        MaterialBase* EntryMaterial;
+
+        /// <summary>
+        /// The model material slot material used to build the draw call (used to detect material changes).
+        /// </summary>
+        MaterialBase* SlotMaterial;
+
+        /// <summary>
+        /// The draw passes to use for the draw call.
+        /// </summary>
+        DrawPass DrawModes;
+
+        /// <summary>
+        /// The shadows casting mode.
+        /// </summary>
+        ShadowsCastingMode ShadowsMode;
+
+        /// <summary>
+        /// The value indicating whether the draw call receives decals.
+        /// </summary>
+        bool ReceiveDecals;
+
+        /// <summary>
+        /// The value indicating whether the entry contains a valid draw call.
+        /// </summary>
+        bool Valid = false;
+    };
+
+    /// <summary>
+    /// The rendering origin of the view used to build the cache.
+    /// </summary>
+    Vector3 Origin;
+
+    /// <summary>
+    /// The world transformation matrix of the object (relative to the rendering origin).
+    /// </summary>
+    Matrix World;
+
+    /// <summary>
+    /// The lightmap used to build the cache.
+    /// </summary>
+    const Lightmap* Lightmap;
+
+    /// <summary>
+    /// The object draw modes used to build the cache.
+    /// </summary>
+    DrawPass DrawModes;
+
+    /// <summary>
+    /// The object static flags used to build the cache.
+    /// </summary>
+    StaticFlags Flags;
+
+    /// <summary>
+    /// The value indicating whether the cache is valid.
+    /// </summary>
+    bool Valid = false;
+
+    /// <summary>
+    /// The cached draw calls for every model LOD (indexed by mesh index within the LOD).
+    /// </summary>
+    Array<Entry> LODs[MODEL_MAX_LODS];
+
+public:
+    /// <summary>
+    /// Invalidates the cache (eg. after object transformation, model or materials change).
+    /// </summary>
+    void Invalidate()
+    {
+        Valid = false;
+        for (int32 lodIndex = 0; lodIndex < MODEL_MAX_LODS; lodIndex++)
+            LODs[lodIndex].Clear();
+    }
+};
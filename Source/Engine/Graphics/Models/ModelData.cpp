@@ -23,6 +23,7 @@ void MeshData::Clear()
     BlendIndices.Clear();
     BlendWeights.Clear();
     BlendShapes.Clear();
+    Clusters.Clear();
 }
 
 void MeshData::EnsureCapacity(int32 vertices, int32 indices, bool preserveContents, bool withColors, bool withSkin)
@@ -51,6 +52,7 @@ void MeshData::SwapBuffers(MeshData& other)
     BlendIndices.Swap(other.BlendIndices);
     BlendWeights.Swap(other.BlendWeights);
     BlendShapes.Swap(other.BlendShapes);
+    Clusters.Swap(other.Clusters);
 }
 
 void MeshData::Release()
@@ -67,6 +69,7 @@ void MeshData::Release()
     BlendIndices.Resize(0);
     BlendWeights.Resize(0);
     BlendShapes.Resize(0);
+    Clusters.Resize(0);
 }
 
 void MeshData::InitFromModelVertices(ModelVertex19* vertices, uint32 verticesCount)
@@ -556,6 +559,9 @@ void MeshData::NormalizeBlendWeights()
 
 void MeshData::Merge(MeshData& other)
 {
+    // Clusters are built after merging (index buffer ranges would be invalid)
+    Clusters.Clear();
+
     // Merge index buffer (and remap indices)
     const uint32 vertexIndexOffset = Positions.Count();
     const int32 indicesStart = Indices.Count();
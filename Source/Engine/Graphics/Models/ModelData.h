@@ -90,6 +90,11 @@ class FLAXENGINE_API MeshData
     /// </summary>
     Array<BlendShape> BlendShapes;
 
+    /// <summary>
+    /// The mesh clusters (contiguous ranges of the index buffer with bounds). Built during import for the high-poly meshes to perform the per-cluster culling. Empty if unused.
+    /// </summary>
+    Array<MeshCluster> Clusters;
+
 public:
     /// <summary>
     /// Determines whether this instance has any mesh data.
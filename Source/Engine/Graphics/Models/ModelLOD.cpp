@@ -41,6 +41,22 @@ bool ModelLOD::Load(MemoryReadStream& stream)
         }
     }
 
+    // Load meshes clusters (optional, stored after the meshes data)
+    if (stream.GetLength() - stream.GetPosition() >= sizeof(int32))
+    {
+        int32 version;
+        stream.ReadInt32(&version);
+        if (version == 1)
+        {
+            for (int32 i = 0; i < Meshes.Count(); i++)
+            {
+                uint32 clustersCount;
+                stream.ReadUint32(&clustersCount);
+                Meshes[i]._clusters.Set(stream.Move<MeshCluster>(clustersCount), (int32)clustersCount);
+            }
+        }
+    }
+
     return false;
 }
 
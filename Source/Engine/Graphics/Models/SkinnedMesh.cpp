@@ -10,6 +10,7 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/Utils/SkinningCache.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/Task.h"
@@ -57,8 +58,14 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
 #else
 	vertexBuffer = GPUDevice::Instance->CreateBuffer(String::Empty);
 #endif
-    if (vertexBuffer->Init(GPUBufferDescription::Vertex(sizeof(VB0SkinnedElementType), vertices, vb0)))
-        goto ERROR_LOAD_END;
+    vertexBuffer->SetCategory(GPUResourceCategory::Models);
+    {
+        // Raw view is used by the compute shaders skinning
+        auto desc = GPUBufferDescription::Raw(vb0, vertices * sizeof(VB0SkinnedElementType), GPUBufferFlags::VertexBuffer | GPUBufferFlags::ShaderResource);
+        desc.Stride = sizeof(VB0SkinnedElementType);
+        if (vertexBuffer->Init(desc))
+            goto ERROR_LOAD_END;
+    }
 
     // Create index buffer
 #if GPU_ENABLE_RESOURCE_NAMING
@@ -66,15 +73,18 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
 #else
 	indexBuffer = GPUDevice::Instance->CreateBuffer(String::Empty);
 #endif
+    indexBuffer->SetCategory(GPUResourceCategory::Models);
     if (indexBuffer->Init(GPUBufferDescription::Index(ibStride, indicesCount, ib)))
         goto ERROR_LOAD_END;
 
     // Initialize
+    _blendShapesData.Release();
     _vertexBuffer = vertexBuffer;
     _indexBuffer = indexBuffer;
     _triangles = triangles;
     _vertices = vertices;
     _use16BitIndexBuffer = use16BitIndexBuffer;
+    _texCoordsRange = ComputeTexCoordsRange((const VB0SkinnedElementType*)vb0, vertices);
 
     return false;
 
@@ -87,6 +97,7 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
 
 void SkinnedMesh::Unload()
 {
+    _blendShapesData.Release();
     SAFE_DELETE_GPU_RESOURCE(_vertexBuffer);
     SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
     _cachedIndexBuffer.Clear();
@@ -164,6 +175,13 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
         material = GPUDevice::Instance->GetDefaultMaterial();
     if (!material || !material->IsSurface())
         return;
+    if (!material->CanUseSkinning())
+    {
+        // Material skinned permutations were stripped from the cooked game
+        material = GPUDevice::Instance->GetDefaultMaterial();
+        if (!material)
+            return;
+    }
 
     // Check if skip rendering
     const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
@@ -179,11 +197,10 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
     {
         // Use modified vertex buffer from the blend shapes
         if (blendShapeMeshInstance->IsDirty)
-        {
-            blendShapeMeshInstance->VertexBuffer.Flush();
-            blendShapeMeshInstance->IsDirty = false;
-        }
-        drawCall.Geometry.VertexBuffers[0] = blendShapeMeshInstance->VertexBuffer.GetBuffer();
+            blendShapeMeshInstance->Flush(this);
+        drawCall.Geometry.VertexBuffers[0] = blendShapeMeshInstance->GetVertexBuffer();
+        if (!drawCall.Geometry.VertexBuffers[0])
+            drawCall.Geometry.VertexBuffers[0] = _vertexBuffer;
     }
     else
     {
@@ -209,8 +226,50 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
     drawCall.WorldDeterminantSign = Math::FloatSelect(drawCall.World.RotDeterminant(), 1, -1);
     drawCall.PerInstanceRandom = info.PerInstanceRandom;
 
+    // Draw the geometry skinned by the skinning cache as a static mesh (motion vectors pass uses the skinned draw call to access the previous frame bones)
+    DrawPass skinnedDrawModes = drawModes;
+    GPUBuffer* skinnedVertexBuffers[3];
+    const DrawPass cachedDrawModes = drawModes & ~DrawPass::MotionVectors;
+    if (info.Skinning && cachedDrawModes != DrawPass::None && SkinningCache::Instance()->CanUse() && !SkinningCache::Instance()->Get(info.Skinning, this, drawCall.Geometry.VertexBuffers[0], skinnedVertexBuffers))
+    {
+        DrawCall cachedDrawCall = drawCall;
+        for (int32 i = 0; i < 3; i++)
+            cachedDrawCall.Geometry.VertexBuffers[i] = skinnedVertexBuffers[i];
+        cachedDrawCall.Surface.Skinning = nullptr;
+        renderContext.List->AddDrawCall(renderContext, cachedDrawModes, StaticFlags::None, cachedDrawCall, entry.ReceiveDecals, info.SortOrder);
+        skinnedDrawModes &= DrawPass::MotionVectors;
+    }
+
     // Push draw call to the render list
-    renderContext.List->AddDrawCall(renderContext, drawModes, StaticFlags::None, drawCall, entry.ReceiveDecals, info.SortOrder);
+    if (skinnedDrawModes != DrawPass::None)
+        renderContext.List->AddDrawCall(renderContext, skinnedDrawModes, StaticFlags::None, drawCall, entry.ReceiveDecals, info.SortOrder);
+
+    // Request the textures resolution needed on screen for the streaming
+    if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer | DrawPass::Forward) && !renderContext.View.IsOfflinePass)
+        RequestTexturesResolution(renderContext.View, material, *info.World);
+}
+
+namespace
+{
+    void AddDrawCall(const RenderContextBatch& renderContextBatch, const SkinnedMesh::DrawInfo& info, DrawPass drawModes, ShadowsCastingMode shadowsMode, DrawCall& drawCall, bool receiveDecals)
+    {
+        const RenderContext& mainRenderContext = renderContextBatch.GetMainContext();
+        if (info.ShadowsOnly)
+        {
+            // Shadow projections use a different LOD than the main view
+            mainRenderContext.List->AddShadowsDrawCall(renderContextBatch, drawModes, StaticFlags::None, shadowsMode, info.Bounds, drawCall, info.SortOrder);
+        }
+        else if (info.SkipShadows)
+        {
+            const DrawPass mainDrawModes = drawModes & mainRenderContext.View.Pass & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
+            if (mainDrawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(info.Bounds))
+                mainRenderContext.List->AddDrawCall(mainRenderContext, mainDrawModes, StaticFlags::None, drawCall, receiveDecals, info.SortOrder);
+        }
+        else
+        {
+            mainRenderContext.List->AddDrawCall(renderContextBatch, drawModes, StaticFlags::None, shadowsMode, info.Bounds, drawCall, receiveDecals, info.SortOrder);
+        }
+    }
 }
 
 void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& info, float lodDitherFactor) const
@@ -230,6 +289,13 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
         material = GPUDevice::Instance->GetDefaultMaterial();
     if (!material || !material->IsSurface())
         return;
+    if (!material->CanUseSkinning())
+    {
+        // Material skinned permutations were stripped from the cooked game
+        material = GPUDevice::Instance->GetDefaultMaterial();
+        if (!material)
+            return;
+    }
 
     // Setup draw call
     DrawCall drawCall;
@@ -239,11 +305,10 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
     {
         // Use modified vertex buffer from the blend shapes
         if (blendShapeMeshInstance->IsDirty)
-        {
-            blendShapeMeshInstance->VertexBuffer.Flush();
-            blendShapeMeshInstance->IsDirty = false;
-        }
-        drawCall.Geometry.VertexBuffers[0] = blendShapeMeshInstance->VertexBuffer.GetBuffer();
+            blendShapeMeshInstance->Flush(this);
+        drawCall.Geometry.VertexBuffers[0] = blendShapeMeshInstance->GetVertexBuffer();
+        if (!drawCall.Geometry.VertexBuffers[0])
+            drawCall.Geometry.VertexBuffers[0] = _vertexBuffer;
     }
     else
     {
@@ -272,8 +337,27 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
     // Push draw call to the render lists
     const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
     const auto drawModes = info.DrawModes & material->GetDrawModes();
-    if (drawModes != DrawPass::None)
-        renderContextBatch.GetMainContext().List->AddDrawCall(renderContextBatch, drawModes, StaticFlags::None, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
+    DrawPass skinnedDrawModes = drawModes;
+    GPUBuffer* skinnedVertexBuffers[3];
+    const DrawPass cachedDrawModes = drawModes & ~DrawPass::MotionVectors;
+    if (info.Skinning && cachedDrawModes != DrawPass::None && SkinningCache::Instance()->CanUse() && !SkinningCache::Instance()->Get(info.Skinning, this, drawCall.Geometry.VertexBuffers[0], skinnedVertexBuffers))
+    {
+        // Draw the geometry skinned by the skinning cache as a static mesh (motion vectors pass uses the skinned draw call to access the previous frame bones)
+        DrawCall cachedDrawCall = drawCall;
+        for (int32 i = 0; i < 3; i++)
+            cachedDrawCall.Geometry.VertexBuffers[i] = skinnedVertexBuffers[i];
+        cachedDrawCall.Surface.Skinning = nullptr;
+        AddDrawCall(renderContextBatch, info, cachedDrawModes, shadowsMode, cachedDrawCall, entry.ReceiveDecals);
+        skinnedDrawModes &= DrawPass::MotionVectors;
+    }
+    if (skinnedDrawModes != DrawPass::None)
+        AddDrawCall(renderContextBatch, info, skinnedDrawModes, shadowsMode, drawCall, entry.ReceiveDecals);
+    if (info.ShadowsOnly)
+        return;
+
+    // Request the textures resolution needed on screen for the streaming
+    if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer | DrawPass::Forward) && !renderContextBatch.GetMainContext().View.IsOfflinePass)
+        RequestTexturesResolution(renderContextBatch.GetMainContext().View, material, *info.World);
 }
 
 bool SkinnedMesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) const
@@ -18,6 +18,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedMesh : public MeshBase
     mutable Array<byte> _cachedIndexBuffer;
     mutable Array<byte> _cachedVertexBuffer;
     mutable int32 _cachedIndexBufferCount;
+    mutable BlendShapesMeshData _blendShapesData;
 
 public:
     SkinnedMesh(const SkinnedMesh& other)
@@ -42,6 +43,22 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedMesh : public MeshBase
         return (SkinnedModel*)_model;
     }
 
+    /// <summary>
+    /// Gets the index buffer.
+    /// </summary>
+    FORCE_INLINE GPUBuffer* GetIndexBuffer() const
+    {
+        return _indexBuffer;
+    }
+
+    /// <summary>
+    /// Gets the vertex buffer.
+    /// </summary>
+    FORCE_INLINE GPUBuffer* GetVertexBuffer() const
+    {
+        return _vertexBuffer;
+    }
+
     /// <summary>
     /// Determines whether this mesh is initialized (has vertex and index buffers initialized).
     /// </summary>
@@ -55,6 +72,14 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedMesh : public MeshBase
     /// </summary>
     Array<BlendShape> BlendShapes;
 
+    /// <summary>
+    /// Gets the blend shapes data resident on the GPU (created on demand by the compute shader blending).
+    /// </summary>
+    FORCE_INLINE BlendShapesMeshData& GetBlendShapesData() const
+    {
+        return _blendShapesData;
+    }
+
 public:
     /// <summary>
     /// Initializes a new instance of the <see cref="SkinnedMesh"/> class.
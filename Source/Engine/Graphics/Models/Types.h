@@ -100,6 +100,42 @@ struct RawModelVertex
     Color Color;
 };
 
+/// <summary>
+/// The mesh cluster (meshlet) - a small group of the mesh triangles with bounds used for the fine-grained culling of the high-poly meshes.
+/// </summary>
+PACK_STRUCT(struct MeshCluster
+    {
+    /// <summary>
+    /// The bounding sphere center (in mesh local-space).
+    /// </summary>
+    Float3 Center;
+
+    /// <summary>
+    /// The bounding sphere radius (in mesh local-space).
+    /// </summary>
+    float Radius;
+
+    /// <summary>
+    /// The normals cone axis (in mesh local-space). Used for the backface culling of the whole cluster.
+    /// </summary>
+    Float3 ConeAxis;
+
+    /// <summary>
+    /// The normals cone cutoff (cosine of the cone half-angle). Value 1 or higher disables the cone culling.
+    /// </summary>
+    float ConeCutoff;
+
+    /// <summary>
+    /// The first index of the cluster triangles in the mesh index buffer.
+    /// </summary>
+    uint32 StartIndex;
+
+    /// <summary>
+    /// The amount of indices of the cluster triangles.
+    /// </summary>
+    uint32 IndicesCount;
+    });
+
 // For vertex data we use three buffers: one with positions, one with other attributes, and one with colors
 PACK_STRUCT(struct VB0ElementType15
     {
@@ -63,6 +63,7 @@ void RenderBuffers::Prepare()
     UPDATE_LAZY_KEEP_RT(TemporalAA);
     UPDATE_LAZY_KEEP_RT(HalfResDepth);
     UPDATE_LAZY_KEEP_RT(LuminanceMap);
+    UPDATE_LAZY_KEEP_RT(ShadingRateImage);
 #undef UPDATE_LAZY_KEEP_RT
     for (int32 i = CustomBuffers.Count() - 1; i >= 0; i--)
     {
@@ -219,6 +220,7 @@ void RenderBuffers::Release()
     UPDATE_LAZY_KEEP_RT(TemporalAA);
     UPDATE_LAZY_KEEP_RT(HalfResDepth);
     UPDATE_LAZY_KEEP_RT(LuminanceMap);
+    UPDATE_LAZY_KEEP_RT(ShadingRateImage);
 #undef UPDATE_LAZY_KEEP_RT
     CustomBuffers.ClearDelete();
 }
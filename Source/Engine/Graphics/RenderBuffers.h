@@ -89,6 +89,11 @@ API_CLASS() class FLAXENGINE_API RenderBuffers : public ScriptingObject
     GPUTexture* TemporalAA = nullptr;
     uint64 LastFrameTemporalAA = 0;
 
+    // Helper target with the variable rate shading image generated from the previous frame (one texel per shading rate tile).
+    // Should be released if not used for a few frames.
+    GPUTexture* ShadingRateImage = nullptr;
+    uint64 LastFrameShadingRateImage = 0;
+
     // Maps the custom buffer type into the object that holds the state.
     Array<CustomBuffer*, HeapAllocation> CustomBuffers;
 
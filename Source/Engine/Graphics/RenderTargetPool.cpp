@@ -2,13 +2,19 @@
 
 #include "RenderTargetPool.h"
 #include "GPUDevice.h"
+#include "GPUContext.h"
+#include "Graphics.h"
+#include "RenderTools.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Engine/Engine.h"
 
 struct Entry
 {
     bool IsOccupied;
     GPUTexture* RT;
+    GPUTexture* Memory; // The render target that owns the memory used by this entry (itself if owns it, null if not aliasable)
+    GPUTexture* MemoryUser; // The last render target that used the memory (valid only for memory owners)
     uint64 LastFrameTaken;
     uint64 LastFrameReleased;
     uint32 DescriptionHash;
@@ -17,6 +23,66 @@ struct Entry
 namespace
 {
     Array<Entry> TemporaryRTs(64);
+
+    bool CanAlias(const GPUTextureDescription& desc)
+    {
+        return Graphics::EnableRenderTargetsAliasing &&
+                GPUDevice::Instance->Limits.HasResourceAliasing &&
+                desc.Dimensions == TextureDimensions::Texture &&
+                (desc.IsRenderTarget() || desc.IsDepthStencil());
+    }
+
+    Entry* FindEntry(const GPUTexture* rt)
+    {
+        for (auto& e : TemporaryRTs)
+        {
+            if (e.RT == rt)
+                return &e;
+        }
+        return nullptr;
+    }
+
+    bool IsMemoryInUse(const GPUTexture* memory)
+    {
+        // Memory is in use if any of the render targets placed in it is occupied (lifetimes cannot overlap)
+        for (const auto& e : TemporaryRTs)
+        {
+            if (e.Memory == memory && e.IsOccupied)
+                return true;
+        }
+        return false;
+    }
+
+    bool IsMemoryReferenced(const GPUTexture* memory)
+    {
+        for (const auto& e : TemporaryRTs)
+        {
+            if (e.Memory == memory && e.RT != memory)
+                return true;
+        }
+        return false;
+    }
+
+    bool SortByMemoryUsage(GPUTexture* const& a, GPUTexture* const& b)
+    {
+        return a->GetMemoryUsage() < b->GetMemoryUsage();
+    }
+
+    void Take(Entry& e)
+    {
+        e.IsOccupied = true;
+        e.LastFrameTaken = Engine::FrameCount;
+        if (e.Memory)
+        {
+            // Switch the shared memory to this render target
+            Entry* owner = FindEntry(e.Memory);
+            if (owner->MemoryUser != e.RT)
+            {
+                owner->MemoryUser = e.RT;
+                GPUDevice::Instance->GetMainContext()->AliasTexture(e.RT);
+            }
+        }
+    }
 }
 
 void RenderTargetPool::Flush(bool force)
@@ -29,12 +95,19 @@ void RenderTargetPool::Flush(bool force)
     {
         auto& tmp = TemporaryRTs[i];
 
-        if (!tmp.IsOccupied && (force || (tmp.LastFrameReleased < maxReleaseFrame)))
+        // Skip render targets that own the memory used by other render targets (release them after all aliases)
+        if (!tmp.IsOccupied && (force || (tmp.LastFrameReleased < maxReleaseFrame)) && !(tmp.Memory == tmp.RT && IsMemoryReferenced(tmp.RT)))
         {
             // Release
+            if (tmp.Memory && tmp.Memory != tmp.RT)
+            {
+                Entry* owner = FindEntry(tmp.Memory);
+                if (owner->MemoryUser == tmp.RT)
+                    owner->MemoryUser = nullptr;
+            }
             tmp.RT->DeleteObjectNow();
             TemporaryRTs.RemoveAt(i);
-            i--;
+            i = -1; // Restart as memory owners could be released now
 
             if (TemporaryRTs.IsEmpty())
                 break;
@@ -50,16 +123,16 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
     {
         auto& tmp = TemporaryRTs[i];
 
-        if (!tmp.IsOccupied && tmp.DescriptionHash == descHash)
+        if (!tmp.IsOccupied && tmp.DescriptionHash == descHash && !(tmp.Memory && IsMemoryInUse(tmp.Memory)))
         {
             ASSERT(tmp.RT);
 
             // Mark as used
-            tmp.IsOccupied = true;
-            tmp.LastFrameTaken = Engine::FrameCount;
+            Take(tmp);
             return tmp.RT;
         }
     }
+    const bool canAlias = CanAlias(desc);
 
 #if !BUILD_RELEASE
     if (TemporaryRTs.Count() > 2000)
@@ -72,7 +145,32 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
     // Create new rt
     const String name = TEXT("TemporaryRT_") + StringUtils::ToString(TemporaryRTs.Count());
     auto newRenderTarget = GPUDevice::Instance->CreateTexture(name);
-    if (newRenderTarget->Init(desc))
+    GPUTexture* memory = nullptr;
+    if (canAlias)
+    {
+        // Try to place the render target in the memory of other render target that is not used now (pick the smallest one that fits)
+        const uint64 memoryUsage = RenderTools::CalculateTextureMemoryUsage(desc.Format, desc.Width, desc.Height, desc.MipLevels) * desc.ArraySize;
+        Array<GPUTexture*, InlinedAllocation<16>> candidates;
+        for (const auto& e : TemporaryRTs)
+        {
+            if (e.Memory == e.RT && e.RT->GetMemoryUsage() >= memoryUsage && !IsMemoryInUse(e.RT))
+                candidates.Add(e.RT);
+        }
+        Sorting::QuickSort(candidates.Get(), candidates.Count(), &SortByMemoryUsage);
+        for (GPUTexture* candidate : candidates)
+        {
+            if (!newRenderTarget->InitAliased(desc, candidate))
+            {
+                memory = candidate;
+                break;
+            }
+        }
+
+        // Allocate the new memory that can be aliased later
+        if (!memory && !newRenderTarget->InitAliased(desc))
+            memory = newRenderTarget;
+    }
+    if (!memory && newRenderTarget->Init(desc))
     {
         Delete(newRenderTarget);
         LOG(Error, "Cannot create temporary render target. Description: {0}", desc.ToString());
@@ -81,12 +179,14 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
 
     // Create temporary rt entry
     Entry entry;
-    entry.IsOccupied = true;
+    entry.IsOccupied = false;
     entry.LastFrameReleased = 0;
-    entry.LastFrameTaken = Engine::FrameCount;
     entry.RT = newRenderTarget;
+    entry.Memory = memory;
+    entry.MemoryUser = memory == newRenderTarget ? newRenderTarget : nullptr;
     entry.DescriptionHash = descHash;
     TemporaryRTs.Add(entry);
+    Take(TemporaryRTs.Last());
 
     return newRenderTarget;
 }
@@ -105,6 +205,7 @@ void RenderTargetPool::Release(GPUTexture* rt)
             // Mark as free
             ASSERT(tmp.IsOccupied);
             tmp.IsOccupied = false;
+            rt->SetCategory(GPUResourceCategory::Default);
             tmp.LastFrameReleased = Engine::FrameCount;
             return;
         }
@@ -4,6 +4,7 @@
 #include "RenderBuffers.h"
 #include "GPUDevice.h"
 #include "GPUSwapChain.h"
+#include "GPUTimerQuery.h"
 #include "PostProcessEffect.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Debug/DebugLog.h"
@@ -51,6 +52,16 @@ void RenderTask::DrawAll()
     }
 }
 
+void RenderTask::ExtractAll()
+{
+    ScopeLock lock(TasksLocker);
+    for (auto task : Tasks)
+    {
+        if (task->Enabled)
+            task->OnExtract();
+    }
+}
+
 RenderTask::RenderTask(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -145,6 +156,8 @@ SceneRenderTask::~SceneRenderTask()
         Buffers->DeleteObjectNow();
     if (_customActorsScene)
         Delete(_customActorsScene);
+    for (auto& query : _dynamicResolutionQueries)
+        SAFE_DELETE_GPU_RESOURCE(query);
 }
 
 void SceneRenderTask::CameraCut()
@@ -340,16 +353,69 @@ GPUTextureView* SceneRenderTask::GetOutputView() const
     return nullptr;
 }
 
+void SceneRenderTask::UpdateDynamicResolution()
+{
+    if (!DynamicResolution || _dynamicResolutionFrame == Engine::FrameCount)
+        return;
+    _dynamicResolutionFrame = Engine::FrameCount;
+
+    // Get the latest resolved GPU time of the scene rendering (queries are read with a few frames latency to prevent stalls)
+    float gpuTime = -1.0f;
+    for (int32 i = 0; i < RENDER_TASK_DYNAMIC_RESOLUTION_QUERIES; i++)
+    {
+        const int32 index = (_dynamicResolutionQueryIndex + i) % RENDER_TASK_DYNAMIC_RESOLUTION_QUERIES;
+        GPUTimerQuery* query = _dynamicResolutionQueries[index];
+        if (_dynamicResolutionQueriesPending & (1u << index) && query->HasResult())
+        {
+            gpuTime = query->GetResult();
+            _dynamicResolutionQueriesPending &= ~(1u << index);
+        }
+    }
+    if (_dynamicResolutionScale <= 0.0f)
+        _dynamicResolutionScale = RenderingPercentage;
+    if (gpuTime <= 0.0f)
+        return;
+
+    // Scale resolution toward the target time (pixels count is proportional to the square of the scale), react quickly when over the budget and slowly raise it back only when there is enough headroom (hysteresis)
+    const float minScale = Math::Clamp(DynamicResolutionMin, 0.1f, 1.0f);
+    const float maxScale = Math::Clamp(DynamicResolutionMax, minScale, 1.0f);
+    const float timeRatio = gpuTime / Math::Max(DynamicResolutionTargetTime, 0.1f);
+    float scale = _dynamicResolutionScale;
+    if (timeRatio > 1.0f)
+        scale *= Math::Lerp(1.0f, Math::Sqrt(1.0f / timeRatio), 0.7f);
+    else if (timeRatio < 0.85f)
+        scale *= Math::Lerp(1.0f, Math::Sqrt(1.0f / timeRatio), 0.05f);
+    scale = Math::Clamp(scale, minScale, maxScale);
+    _dynamicResolutionScale = scale;
+
+    // Quantize rendering percentage to prevent reallocating render buffers on every small change
+    const float step = 0.05f;
+    RenderingPercentage = Math::Clamp(Math::Floor(scale / step + 0.001f) * step, minScale, maxScale);
+}
+
+void SceneRenderTask::OnExtract()
+{
+    // Snapshot the camera view so the simulation of the next frame doesn't affect the frame being drawn
+    if (Camera)
+    {
+        auto viewport = GetViewport();
+        View.CopyFrom(Camera, &viewport);
+    }
+    _viewExtractedCamera = Camera;
+}
+
 void SceneRenderTask::OnBegin(GPUContext* context)
 {
     RenderTask::OnBegin(context);
+    UpdateDynamicResolution();
 
-    // Copy view info if camera is specified
-    if (Camera)
+    // Copy view info if camera is specified (unless it has been already extracted and not overriden in Begin event)
+    if (Camera && Camera != _viewExtractedCamera)
     {
         auto viewport = GetViewport();
         View.CopyFrom(Camera, &viewport);
     }
+    _viewExtractedCamera = nullptr;
 
     // Setup render buffers for the output rendering resolution
     if (Output)
@@ -365,8 +431,26 @@ void SceneRenderTask::OnBegin(GPUContext* context)
 void SceneRenderTask::OnRender(GPUContext* context)
 {
     if (!IsCustomRendering && Buffers && Buffers->GetWidth() > 0)
+    {
+        // Measure the scene rendering time on a GPU for the dynamic resolution (skip if all queries are still in-flight)
+        GPUTimerQuery* query = nullptr;
+        const uint32 queryMask = 1u << _dynamicResolutionQueryIndex;
+        if (DynamicResolution && (_dynamicResolutionQueriesPending & queryMask) == 0)
+        {
+            query = _dynamicResolutionQueries[_dynamicResolutionQueryIndex];
+            if (!query)
+                query = _dynamicResolutionQueries[_dynamicResolutionQueryIndex] = GPUDevice::Instance->CreateTimerQuery();
+            _dynamicResolutionQueriesPending |= queryMask;
+            _dynamicResolutionQueryIndex = (_dynamicResolutionQueryIndex + 1) % RENDER_TASK_DYNAMIC_RESOLUTION_QUERIES;
+            query->Begin();
+        }
+
         Renderer::Render(this);
 
+        if (query)
+            query->End();
+    }
+
     RenderTask::OnRender(context);
 }
 
@@ -418,13 +502,22 @@ MainRenderTask::~MainRenderTask()
     }
 }
 
+void MainRenderTask::OnExtract()
+{
+    Camera = Camera::GetMainCamera();
+
+    SceneRenderTask::OnExtract();
+}
+
 void MainRenderTask::OnBegin(GPUContext* context)
 {
     // Use the main camera for the game (can be later overriden in Begin event by external code)
-    Camera = Camera::GetMainCamera();
+    if (!_viewExtractedCamera)
+        Camera = Camera::GetMainCamera();
 
 #if !USE_EDITOR
     // Sync render buffers size with the backbuffer
+    UpdateDynamicResolution();
     const auto size = Screen::GetSize();
     Buffers->Init((int32)(size.X * RenderingPercentage), (int32)(size.Y * RenderingPercentage));
 #endif
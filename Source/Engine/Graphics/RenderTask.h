@@ -2,6 +2,9 @@
 
 #pragma once
 
+// The amount of GPU timer queries used by the dynamic resolution to read the GPU time of the scene rendering with a few frames latency
+#define RENDER_TASK_DYNAMIC_RESOLUTION_QUERIES 4
+
 #include "Engine/Core/Delegate.h"
 #include "Engine/Core/Math/Viewport.h"
 #include "Engine/Core/Collections/Array.h"
@@ -16,6 +19,7 @@ class GPUContext;
 class GPUTexture;
 class GPUTextureView;
 class GPUSwapChain;
+class GPUTimerQuery;
 class RenderBuffers;
 class PostProcessEffect;
 struct RenderContext;
@@ -49,6 +53,11 @@ API_CLASS() class FLAXENGINE_API RenderTask : public ScriptingObject
     /// </summary>
     static void DrawAll();
 
+    /// <summary>
+    /// Extracts the simulation state used by all tasks (eg. camera view). Called on a main thread before drawing the frame on the render thread when using pipelined rendering.
+    /// </summary>
+    static void ExtractAll();
+
 private:
     RenderTask* _prevTask = nullptr;
 
@@ -115,6 +124,13 @@ API_CLASS() class FLAXENGINE_API RenderTask : public ScriptingObject
     /// </summary>
     API_FUNCTION() virtual void OnDraw();
 
+    /// <summary>
+    /// Called on a main thread to capture the simulation state used by the task before the frame gets drawn on the render thread (pipelined rendering only).
+    /// </summary>
+    virtual void OnExtract()
+    {
+    }
+
     /// <summary>
     /// Called on task rendering begin.
     /// </summary>
@@ -207,6 +223,12 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     DECLARE_SCRIPTING_TYPE(SceneRenderTask);
 protected:
     class SceneRendering* _customActorsScene = nullptr;
+    GPUTimerQuery* _dynamicResolutionQueries[RENDER_TASK_DYNAMIC_RESOLUTION_QUERIES] = {};
+    uint32 _dynamicResolutionQueriesPending = 0;
+    int32 _dynamicResolutionQueryIndex = 0;
+    uint64 _dynamicResolutionFrame = 0;
+    float _dynamicResolutionScale = 0.0f;
+    class Camera* _viewExtractedCamera = nullptr;
 
 public:
     /// <summary>
@@ -265,6 +287,26 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     /// </summary>
     API_FIELD() RenderingUpscaleLocation UpscaleLocation = RenderingUpscaleLocation::AfterAntiAliasingPass;
 
+    /// <summary>
+    /// Enables the dynamic resolution. RenderingPercentage is adjusted automatically (within the DynamicResolutionMin and DynamicResolutionMax range) based on the GPU time of the scene rendering to reach the target time.
+    /// </summary>
+    API_FIELD() bool DynamicResolution = false;
+
+    /// <summary>
+    /// The target GPU time (in milliseconds) of the scene rendering used by the dynamic resolution. Should be lower than the frame time budget to leave headroom for the UI and presentation (eg. 14ms for 60 FPS).
+    /// </summary>
+    API_FIELD() float DynamicResolutionTargetTime = 14.0f;
+
+    /// <summary>
+    /// The minimum rendering percentage used by the dynamic resolution.
+    /// </summary>
+    API_FIELD() float DynamicResolutionMin = 0.5f;
+
+    /// <summary>
+    /// The maximum rendering percentage used by the dynamic resolution.
+    /// </summary>
+    API_FIELD() float DynamicResolutionMax = 1.0f;
+
 public:
     /// <summary>
     /// The custom set of actors to render.
@@ -392,10 +434,17 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     /// </summary>
     API_PROPERTY() GPUTextureView* GetOutputView() const;
 
+protected:
+    /// <summary>
+    /// Updates the rendering percentage using the dynamic resolution (if enabled). Called once per frame before the render buffers setup.
+    /// </summary>
+    void UpdateDynamicResolution();
+
 public:
     // [RenderTask]
     bool Resize(int32 width, int32 height) override;
     bool CanDraw() const override;
+    void OnExtract() override;
     void OnBegin(GPUContext* context) override;
     void OnRender(GPUContext* context) override;
     void OnEnd(GPUContext* context) override;
@@ -427,6 +476,7 @@ API_CLASS() class FLAXENGINE_API MainRenderTask : public SceneRenderTask
 
 public:
     // [SceneRenderTask]
+    void OnExtract() override;
     void OnBegin(GPUContext* context) override;
 };
 
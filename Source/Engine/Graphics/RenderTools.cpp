@@ -7,6 +7,7 @@
 #include "RenderView.h"
 #include "GPUDevice.h"
 #include "RenderTask.h"
+#include "Engine/Content/Assets/MaterialBase.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Content/Assets/SkinnedModel.h"
 #include "Engine/Core/Log.h"
@@ -627,3 +628,15 @@ void MeshBase::SetBounds(const BoundingBox& box)
     _box = box;
     BoundingSphere::FromBox(box, _sphere);
 }
+
+void MeshBase::RequestTexturesResolution(const RenderView& view, const MaterialBase* material, const Matrix& world) const
+{
+    // Texture resolution that maps texels 1:1 to the screen pixels over the mesh projected size (tiled textures need proportionally less)
+    BoundingSphere sphere;
+    BoundingSphere::Transform(_sphere, world, sphere);
+    const float screenRadius = Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(sphere.Center, (float)sphere.Radius, view));
+    const float screenSize = 2.0f * screenRadius * Math::Max(view.ScreenSize.X, view.ScreenSize.Y);
+    const int32 resolution = (int32)Math::Min(screenSize / _texCoordsRange, (float)GPU_MAX_TEXTURE_SIZE);
+    if (resolution > 0)
+        material->Params.RequestTexturesResolution(resolution);
+}
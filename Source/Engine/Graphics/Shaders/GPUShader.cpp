@@ -6,6 +6,9 @@
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Utilities/Crc.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Threading.h"
 
 GPUShaderProgramsContainer::GPUShaderProgramsContainer()
     : _shaders(64)
@@ -16,7 +19,7 @@ GPUShaderProgramsContainer::GPUShaderProgramsContainer()
 GPUShaderProgramsContainer::~GPUShaderProgramsContainer()
 {
     // Remember to delete all programs
-    _shaders.ClearDelete();
+    Clear();
 }
 
 void GPUShaderProgramsContainer::Add(GPUShaderProgram* shader, int32 permutationIndex)
@@ -24,7 +27,7 @@ void GPUShaderProgramsContainer::Add(GPUShaderProgram* shader, int32 permutation
     // Validate input
     ASSERT(shader && Math::IsInRange(permutationIndex, 0, SHADER_PERMUTATIONS_MAX_COUNT - 1));
 #if ENABLE_ASSERTION
-    if ((Get(shader->GetName(), permutationIndex) != nullptr))
+    if ((Find(shader->GetName(), permutationIndex) != nullptr))
     {
         CRASH;
     }
@@ -32,25 +35,49 @@ void GPUShaderProgramsContainer::Add(GPUShaderProgram* shader, int32 permutation
 
     // Store shader
     const int32 hash = CalculateHash(shader->GetName(), permutationIndex);
-    _shaders.Add(hash, shader);
+    _shaders.Add(hash, { shader, -1, -1 });
 }
 
-GPUShaderProgram* GPUShaderProgramsContainer::Get(const StringAnsiView& name, int32 permutationIndex) const
+void GPUShaderProgramsContainer::Add(const StringAnsiView& name, int32 permutationIndex, int32 headerOffset, int32 dataOffset)
+{
+    // Validate input
+    ASSERT(name.Length() > 0 && Math::IsInRange(permutationIndex, 0, SHADER_PERMUTATIONS_MAX_COUNT - 1));
+#if ENABLE_ASSERTION
+    if ((Find(name, permutationIndex) != nullptr))
+    {
+        CRASH;
+    }
+#endif
+
+    // Store shader location (program is created on the first use)
+    const int32 hash = CalculateHash(name, permutationIndex);
+    _shaders.Add(hash, { nullptr, headerOffset, dataOffset });
+}
+
+GPUShaderProgramsContainer::Entry* GPUShaderProgramsContainer::Find(const StringAnsiView& name, int32 permutationIndex) const
 {
     // Validate input
     ASSERT(name.Length() > 0 && Math::IsInRange(permutationIndex, 0, SHADER_PERMUTATIONS_MAX_COUNT - 1));
 
     // Find shader
-    GPUShaderProgram* result = nullptr;
     const int32 hash = CalculateHash(name, permutationIndex);
-    _shaders.TryGet(hash, result);
+    return const_cast<Entry*>(_shaders.TryGet(hash));
+}
 
-    return result;
+GPUShaderProgram* GPUShaderProgramsContainer::Get(const StringAnsiView& name, int32 permutationIndex) const
+{
+    const Entry* entry = Find(name, permutationIndex);
+    return entry ? entry->Shader : nullptr;
 }
 
 void GPUShaderProgramsContainer::Clear()
 {
-    _shaders.ClearDelete();
+    for (auto& e : _shaders)
+    {
+        if (e.Value.Shader)
+            Delete(e.Value.Shader);
+    }
+    _shaders.Clear();
 }
 
 uint32 GPUShaderProgramsContainer::CalculateHash(const StringAnsiView& name, int32 permutationIndex)
@@ -84,26 +111,27 @@ bool GPUShader::Create(MemoryReadStream& stream)
     // Shaders count
     int32 shadersCount;
     stream.ReadInt32(&shadersCount);
-    GPUShaderProgramInitializer initializer;
-#if !BUILD_RELEASE
-    initializer.Owner = this;
-#endif
+    const byte* cacheStart = stream.GetPositionHandle();
+    StringAnsi name;
     for (int32 i = 0; i < shadersCount; i++)
     {
+        const int32 headerOffset = (int32)(stream.GetPositionHandle() - cacheStart);
         const ShaderStage type = static_cast<ShaderStage>(stream.ReadByte());
         const int32 permutationsCount = stream.ReadByte();
         ASSERT(Math::IsInRange(permutationsCount, 1, SHADER_PERMUTATIONS_MAX_COUNT));
 
         // Load shader name
-        stream.ReadStringAnsi(&initializer.Name, 11);
-        ASSERT(initializer.Name.HasChars());
+        stream.ReadStringAnsi(&name, 11);
+        ASSERT(name.HasChars());
 
-        // Load shader flags
-        stream.ReadUint32((uint32*)&initializer.Flags);
+        // Skip shader flags
+        stream.Move<uint32>();
 
         for (int32 permutationIndex = 0; permutationIndex < permutationsCount; permutationIndex++)
         {
-            // Load cache
+            const int32 dataOffset = (int32)(stream.GetPositionHandle() - cacheStart);
+
+            // Skip cache
             uint32 cacheSize;
             stream.ReadUint32(&cacheSize);
             if (cacheSize > stream.GetLength() - stream.GetPosition())
@@ -111,24 +139,30 @@ bool GPUShader::Create(MemoryReadStream& stream)
                 LOG(Warning, "Invalid shader cache size.");
                 return true;
             }
-            byte* cache = stream.Move<byte>(cacheSize);
+            stream.Move<byte>(cacheSize);
 
-            // Read bindings
-            stream.ReadBytes(&initializer.Bindings, sizeof(ShaderBindings));
+            // Skip bindings
+            stream.Move<ShaderBindings>();
 
-            // Create shader program
-            GPUShaderProgram* shader = CreateGPUShaderProgram(type, initializer, cache, cacheSize, stream);
-            if (shader == nullptr)
+            // Skip custom data (see ShaderCompiler::WriteCustomDataVS and ShaderCompiler::WriteCustomDataHS)
+            if (type == ShaderStage::Vertex)
             {
-                LOG(Warning, "Failed to create shader program.");
-                return true;
+                const byte inputLayoutSize = stream.ReadByte();
+                stream.Move<byte>(inputLayoutSize * 13);
+            }
+            else if (type == ShaderStage::Hull)
+            {
+                stream.Move<int32>();
             }
 
-            // Add to collection
-            _shaders.Add(shader, permutationIndex);
+            // Add to collection (program is created on the first use, most of the permutations are never used)
+            _shaders.Add(name, permutationIndex, headerOffset, dataOffset);
         }
     }
 
+    // Keep the shader programs data to create them later
+    _cache.Set(cacheStart, (int32)(stream.GetPositionHandle() - cacheStart));
+
     // Constant Buffers
     const byte constantBuffersCount = stream.ReadByte();
     const byte maximumConstantBufferSlot = stream.ReadByte();
@@ -166,9 +200,58 @@ bool GPUShader::Create(MemoryReadStream& stream)
     return false;
 }
 
+bool GPUShader::Prewarm(const StringAnsiView& name, int32 permutationIndex)
+{
+    const auto entry = _shaders.Find(name, permutationIndex);
+    return entry == nullptr || (entry->Shader == nullptr && CreateShader(*entry) == nullptr);
+}
+
+GPUShaderProgram* GPUShader::CreateShader(GPUShaderProgramsContainer::Entry& entry)
+{
+    ScopeLock lock(_locker);
+    if (entry.Shader)
+        return entry.Shader;
+    PROFILE_CPU();
+    MemoryReadStream stream(_cache.Get(), _cache.Count());
+
+    // Load shader header
+    stream.SetPosition(entry.HeaderOffset);
+    const ShaderStage type = static_cast<ShaderStage>(stream.ReadByte());
+    stream.ReadByte();
+    GPUShaderProgramInitializer initializer;
+#if !BUILD_RELEASE
+    initializer.Owner = this;
+#endif
+    stream.ReadStringAnsi(&initializer.Name, 11);
+    stream.ReadUint32((uint32*)&initializer.Flags);
+
+    // Load cache
+    stream.SetPosition(entry.DataOffset);
+    uint32 cacheSize;
+    stream.ReadUint32(&cacheSize);
+    byte* cache = stream.Move<byte>(cacheSize);
+    initializer.BytecodeHash = Crc::MemCrc32(cache, (int32)cacheSize);
+
+    // Read bindings
+    stream.ReadBytes(&initializer.Bindings, sizeof(ShaderBindings));
+
+    // Create shader program
+    GPUShaderProgram* shader = CreateGPUShaderProgram(type, initializer, cache, cacheSize, stream);
+    if (shader == nullptr)
+    {
+        LOG(Warning, "Failed to create shader program \'{0}\'. Object: {1}.", String(initializer.Name), ToString());
+        return nullptr;
+    }
+    entry.Shader = shader;
+    return shader;
+}
+
 GPUShaderProgram* GPUShader::GetShader(ShaderStage stage, const StringAnsiView& name, int32 permutationIndex) const
 {
-    const auto shader = _shaders.Get(name, permutationIndex);
+    const auto entry = _shaders.Find(name, permutationIndex);
+    GPUShaderProgram* shader = entry ? entry->Shader : nullptr;
+    if (entry && shader == nullptr)
+        shader = const_cast<GPUShader*>(this)->CreateShader(*entry);
 
 #if BUILD_RELEASE
 
@@ -208,4 +291,5 @@ void GPUShader::OnReleaseGPU()
     }
     _memoryUsage = 0;
     _shaders.Clear();
+    _cache.Resize(0);
 }
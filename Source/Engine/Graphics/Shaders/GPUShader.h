@@ -5,6 +5,7 @@
 #include "GPUShaderProgram.h"
 #include "Engine/Graphics/GPUResource.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Platform/CriticalSection.h"
 
 class GPUConstantBuffer;
 class GPUShaderProgram;
@@ -19,8 +20,30 @@ class GPUShaderProgram;
 /// </summary>
 class GPUShaderProgramsContainer
 {
+public:
+    /// <summary>
+    /// The shader program entry. Programs are created on the first use from the data located in the shader cache.
+    /// </summary>
+    struct Entry
+    {
+        /// <summary>
+        /// The shader program or null if not created yet.
+        /// </summary>
+        GPUShaderProgram* Shader;
+
+        /// <summary>
+        /// The offset of the shader function header in the shader cache.
+        /// </summary>
+        int32 HeaderOffset;
+
+        /// <summary>
+        /// The offset of the shader permutation data in the shader cache.
+        /// </summary>
+        int32 DataOffset;
+    };
+
 private:
-    Dictionary<int32, GPUShaderProgram*> _shaders;
+    Dictionary<int32, Entry> _shaders;
 
 public:
     /// <summary>
@@ -41,12 +64,29 @@ class GPUShaderProgramsContainer
     /// <param name="permutationIndex">The shader permutation index.</param>
     void Add(GPUShaderProgram* shader, int32 permutationIndex);
 
+    /// <summary>
+    /// Adds a new shader program entry to the collection. Program will be created later on the first use.
+    /// </summary>
+    /// <param name="name">The shader program name.</param>
+    /// <param name="permutationIndex">The shader permutation index.</param>
+    /// <param name="headerOffset">The offset of the shader function header in the shader cache.</param>
+    /// <param name="dataOffset">The offset of the shader permutation data in the shader cache.</param>
+    void Add(const StringAnsiView& name, int32 permutationIndex, int32 headerOffset, int32 dataOffset);
+
+    /// <summary>
+    /// Finds a shader entry of given name and permutation index.
+    /// </summary>
+    /// <param name="name">The shader program name.</param>
+    /// <param name="permutationIndex">The shader permutation index.</param>
+    /// <returns>Stored shader entry or null if cannot find it.</returns>
+    Entry* Find(const StringAnsiView& name, int32 permutationIndex) const;
+
     /// <summary>
     /// Gets a shader of given name and permutation index.
     /// </summary>
     /// <param name="name">The shader program name.</param>
     /// <param name="permutationIndex">The shader permutation index.</param>
-    /// <returns>Stored shader program or null if cannot find it.</returns>
+    /// <returns>Stored shader program or null if cannot find it (or it's not created yet).</returns>
     GPUShaderProgram* Get(const StringAnsiView& name, int32 permutationIndex) const;
 
     /// <summary>
@@ -73,6 +113,8 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUShader : public GPUResource
 protected:
     GPUShaderProgramsContainer _shaders;
     GPUConstantBuffer* _constantBuffers[MAX_CONSTANT_BUFFER_SLOTS];
+    Array<byte> _cache;
+    CriticalSection _locker;
 
     GPUShader();
 
@@ -170,11 +212,20 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUShader : public GPUResource
     /// <returns><c>true</c> if the shader is valid; otherwise, <c>false</c>.</returns>
     FORCE_INLINE bool HasShader(const StringAnsiView& name, int32 permutationIndex = 0) const
     {
-        return _shaders.Get(name, permutationIndex) != nullptr;
+        return _shaders.Find(name, permutationIndex) != nullptr;
     }
 
+    /// <summary>
+    /// Creates the shader program if it's not created yet. Shader programs are created on the first use so this can be used to prewarm shaders before rendering.
+    /// </summary>
+    /// <param name="name">The shader program name.</param>
+    /// <param name="permutationIndex">The shader permutation index.</param>
+    /// <returns>True if failed to create shader program, otherwise false.</returns>
+    bool Prewarm(const StringAnsiView& name, int32 permutationIndex = 0);
+
 protected:
     GPUShaderProgram* GetShader(ShaderStage stage, const StringAnsiView& name, int32 permutationIndex) const;
+    GPUShaderProgram* CreateShader(GPUShaderProgramsContainer::Entry& entry);
     virtual GPUShaderProgram* CreateGPUShaderProgram(ShaderStage type, const GPUShaderProgramInitializer& initializer, byte* cacheBytes, uint32 cacheSize, MemoryReadStream& stream) = 0;
 
 public:
@@ -39,6 +39,7 @@ struct GPUShaderProgramInitializer
     StringAnsi Name;
     ShaderBindings Bindings;
     ShaderFlags Flags;
+    uint32 BytecodeHash;
 #if !BUILD_RELEASE
     GPUShader* Owner;
 #endif
@@ -53,6 +54,7 @@ class FLAXENGINE_API GPUShaderProgram
     StringAnsi _name;
     ShaderBindings _bindings;
     ShaderFlags _flags;
+    uint32 _bytecodeHash;
 #if !BUILD_RELEASE
     GPUShader* _owner;
 #endif
@@ -62,6 +64,7 @@ class FLAXENGINE_API GPUShaderProgram
         _name = initializer.Name;
         _bindings = initializer.Bindings;
         _flags = initializer.Flags;
+        _bytecodeHash = initializer.BytecodeHash;
 #if !BUILD_RELEASE
         _owner = initializer.Owner;
 #endif
@@ -100,6 +103,14 @@ class FLAXENGINE_API GPUShaderProgram
         return _flags;
     }
 
+    /// <summary>
+    /// Gets the hash of the shader program bytecode. Can be used to identify the same shader program across the application runs.
+    /// </summary>
+    FORCE_INLINE uint32 GetBytecodeHash() const
+    {
+        return _bytecodeHash;
+    }
+
 public:
     /// <summary>
     /// Gets shader program stage type.
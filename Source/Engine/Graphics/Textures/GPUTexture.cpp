@@ -359,6 +359,12 @@ int32 GPUTexture::ComputeRowPitch(int32 mipLevel, int32 rowAlign) const
 }
 
 bool GPUTexture::Init(const GPUTextureDescription& desc)
+{
+    _isAliasable = false;
+    return init(desc);
+}
+
+bool GPUTexture::init(const GPUTextureDescription& desc)
 {
     ASSERT(Math::IsInRange(desc.Width, 1, GPU_MAX_TEXTURE_SIZE)
         && Math::IsInRange(desc.Height, 1, GPU_MAX_TEXTURE_SIZE)
@@ -492,7 +498,8 @@ bool GPUTexture::Init(const GPUTextureDescription& desc)
         ReleaseGPU();
         _desc.Clear();
         _residentMipLevels = 0;
-        LOG(Warning, "Cannot initialize texture. Description: {0}", desc.ToString());
+        if (!_aliasingSource) // Aliasing might fail if texture doesn't fit into the source memory (caller should fallback to a regular allocation)
+            LOG(Warning, "Cannot initialize texture. Description: {0}", desc.ToString());
         return true;
     }
 
@@ -505,6 +512,21 @@ bool GPUTexture::Init(const GPUTextureDescription& desc)
     return false;
 }
 
+bool GPUTexture::InitAliased(const GPUTextureDescription& desc, GPUTexture* aliasingSource)
+{
+    if (!GPUDevice::Instance->Limits.HasResourceAliasing || desc.Dimensions != TextureDimensions::Texture || !(desc.IsRenderTarget() || desc.IsDepthStencil()))
+        return true;
+    if (aliasingSource && (aliasingSource == this || !aliasingSource->IsAliasable()))
+        return true;
+    _isAliasable = true;
+    _aliasingSource = aliasingSource;
+    const bool failed = init(desc);
+    _aliasingSource = nullptr;
+    if (failed)
+        _isAliasable = false;
+    return failed;
+}
+
 GPUTexture* GPUTexture::ToStagingReadback() const
 {
     const auto desc = _desc.ToStagingReadback();
@@ -602,7 +624,7 @@ GPUTask* GPUTexture::UploadMipMapAsync(const BytesContainer& data, int32 mipInde
     ASSERT(data.Length() >= slicePitch);
 
     // Optimize texture upload invoked during rendering
-    if (IsInMainThread() && GPUDevice::Instance->IsRendering())
+    if (IsInRenderThread() && GPUDevice::Instance->IsRendering())
     {
         // Update all array slices
         const byte* dataSource = data.Get();
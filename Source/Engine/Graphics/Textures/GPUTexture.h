@@ -77,6 +77,8 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
 protected:
     int32 _residentMipLevels;
     bool _sRGB, _isBlockCompressed;
+    bool _isAliasable = false;
+    GPUTexture* _aliasingSource = nullptr;
     GPUTextureDescription _desc;
 
     GPUTexture();
@@ -90,6 +92,14 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
         return _residentMipLevels != 0;
     }
 
+    /// <summary>
+    /// Gets a value indicating whether this texture has been created with a memory that can be shared with other textures (see InitAliased).
+    /// </summary>
+    FORCE_INLINE bool IsAliasable() const
+    {
+        return _isAliasable;
+    }
+
     /// <summary>
     /// Gets a value indicating whether this texture has been allocated.
     /// </summary>
@@ -466,6 +476,14 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
     /// <returns>True if cannot create texture, otherwise false.</returns>
     API_FUNCTION() bool Init(API_PARAM(Ref) const GPUTextureDescription& desc);
 
+    /// <summary>
+    /// Initializes a texture resource that can share the GPU memory with other textures (memory aliasing). Aliased textures cannot be used at the same time and the memory contents are undefined after switching between them (see GPUContext::AliasTexture). Requires GPULimits::HasResourceAliasing.
+    /// </summary>
+    /// <param name="desc">The texture description. Only 2D render target or depth buffer textures are supported.</param>
+    /// <param name="aliasingSource">The aliasable texture to place this texture in its memory (has to be large enough to fit it), or null to allocate the new memory that can be aliased by other textures later.</param>
+    /// <returns>True if cannot create texture (eg. it doesn't fit in the memory of the source texture), otherwise false.</returns>
+    bool InitAliased(const GPUTextureDescription& desc, GPUTexture* aliasingSource = nullptr);
+
     /// <summary>
     /// Creates new staging readback texture with the same dimensions and properties as a source texture (but without a data transferred; warning: caller must delete object).
     /// </summary>
@@ -562,6 +580,9 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
     /// </summary>
     Delegate<GPUTexture*> ResidentMipsChanged;
 
+private:
+    bool init(const GPUTextureDescription& desc);
+
 protected:
     virtual bool OnInit() = 0;
     uint64 calculateMemoryUsage() const;
@@ -54,6 +54,7 @@ StreamingTexture::StreamingTexture(ITextureOwner* parent, const String& name)
     ASSERT(GPUDevice::Instance);
     _texture = GPUDevice::Instance->CreateTexture(name);
     ASSERT(_texture != nullptr);
+    _texture->SetCategory(GPUResourceCategory::StreamingTextures);
 
     _header.MipLevels = 0;
 }
@@ -137,6 +138,8 @@ void StreamingTexture::UnloadTexture()
     // Release
     _texture->ReleaseGPU();
     _header.MipLevels = 0;
+    _requestedResolution = 0;
+    _onScreenResolution = 0;
 
     ASSERT(_streamingTasks.Count() == 0);
 }
@@ -167,6 +170,40 @@ int32 StreamingTexture::GetAllocatedResidency() const
     return _texture->MipLevels();
 }
 
+uint64 StreamingTexture::GetMemoryUsage() const
+{
+    return _texture ? _texture->GetMemoryUsage() : 0;
+}
+
+uint64 StreamingTexture::GetStreamingSize(int32 residency) const
+{
+    const int32 currentResidency = GetCurrentResidency();
+    if (residency <= currentResidency || !IsInitialized())
+        return 0;
+
+    // Size of the mips to stream (from the highest mip up to the currently resident ones)
+    const int32 totalMipLevels = TotalMipLevels();
+    const int32 startMipIndex = totalMipLevels - Math::Min(residency, totalMipLevels);
+    const int32 endMipIndex = totalMipLevels - currentResidency;
+    const uint64 arraySize = _header.IsCubeMap ? 6 : 1;
+    uint64 result = 0;
+    for (int32 mipIndex = startMipIndex; mipIndex < endMipIndex; mipIndex++)
+        result += RenderTools::CalculateTextureMemoryUsage(_header.Format, Math::Max(_header.Width >> mipIndex, 1), Math::Max(_header.Height >> mipIndex, 1), 1);
+    return result * arraySize;
+}
+
+void StreamingTexture::RequestResolution(int32 resolution) const
+{
+    int64 current = Platform::AtomicRead(&_requestedResolution);
+    while (resolution > current)
+    {
+        const int64 prev = Platform::InterlockedCompareExchange(&_requestedResolution, resolution, current);
+        if (prev == current)
+            break;
+        current = prev;
+    }
+}
+
 bool StreamingTexture::CanBeUpdated() const
 {
     // Streaming Texture cannot be updated if:
@@ -278,6 +315,7 @@ Task* StreamingTexture::UpdateAllocation(int32 residency)
 #else
             texture = GPUDevice::Instance->CreateTexture();
 #endif
+            texture->SetCategory(GPUResourceCategory::StreamingTextures);
         }
 
         // Create texture description
@@ -350,6 +388,11 @@ class StreamTextureMipTask : public GPUUploadTextureMipTask
         const auto texture = _texture.Get();
         if (texture == nullptr)
             return Result::MissingResources;
+#if BUILD_RELEASE
+        ContentLoadingManager::AssetLoadScope loadScope(StringView::Empty, TEXT("Texture"), ContentLoadingManager::AssetLoadStage::Upload);
+#else
+        ContentLoadingManager::AssetLoadScope loadScope(texture->GetName(), TEXT("Texture"), ContentLoadingManager::AssetLoadStage::Upload);
+#endif
 
         // Ensure that texture has been allocated before this task and has proper format
         if (!texture->IsAllocated() || texture->Format() != _streamingTexture->GetHeader()->Format)
@@ -22,6 +22,8 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     int32 _minMipCountBlockCompressed;
     bool _isBlockCompressed;
     Array<Task*, FixedAllocation<16>> _streamingTasks;
+    mutable volatile int64 _requestedResolution = 0;
+    int32 _onScreenResolution = 0;
 
 public:
     StreamingTexture(ITextureOwner* owner, const String& name);
@@ -49,6 +51,12 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     /// </summary>
     Float2 Size() const;
 
+    /// <summary>
+    /// Requests the texture resolution needed to draw it on screen (eg. based on the projected size of the mesh using it). The highest requested resolution between the streaming updates is used to pick the mip levels to load. Thread-safe.
+    /// </summary>
+    /// <param name="resolution">The requested resolution (in texels, along the texture largest dimension).</param>
+    void RequestResolution(int32 resolution) const;
+
     /// <summary>
     /// Gets a value indicating whether this instance is initialized. 
     /// </summary>
@@ -170,6 +178,8 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     int32 GetMaxResidency() const override;
     int32 GetCurrentResidency() const override;
     int32 GetAllocatedResidency() const override;
+    uint64 GetMemoryUsage() const override;
+    uint64 GetStreamingSize(int32 residency) const override;
     bool CanBeUpdated() const override;
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
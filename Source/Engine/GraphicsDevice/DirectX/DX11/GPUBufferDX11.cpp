@@ -19,7 +19,7 @@ GPUBufferView* GPUBufferDX11::View() const
 
 void* GPUBufferDX11::Map(GPUResourceMapMode mode)
 {
-    if (!IsInMainThread())
+    if (!IsInRenderThread())
         _device->Locker.Lock();
     ASSERT(!_mapped);
 
@@ -59,7 +59,7 @@ void GPUBufferDX11::Unmap()
         _device->GetIM()->Unmap(_resource, 0);
     }
     
-    if (!IsInMainThread())
+    if (!IsInRenderThread())
         _device->Locker.Unlock();
 }
 
@@ -108,7 +108,8 @@ bool GPUBufferDX11::OnInit()
     // Set state
     DX_SET_DEBUG_NAME(_resource, GetName());
     _memoryUsage = _desc.Size;
-    int32 numElements = _desc.GetElementsCount();
+    // Raw buffer views are addressed in 32-bit elements (stride can be used as vertex buffer stride)
+    int32 numElements = EnumHasAnyFlags(_desc.Flags, GPUBufferFlags::RawBuffer) ? _desc.Size / sizeof(uint32) : _desc.GetElementsCount();
 
     // Create views
     if (useSRV)
@@ -52,6 +52,7 @@ GPUContextDX11::GPUContextDX11(GPUDeviceDX11* device, ID3D11DeviceContext* conte
     , _srDirtyFlag(false)
     , _uaDirtyFlag(false)
     , _cbDirtyFlag(false)
+    , _pushConstantsCB(nullptr)
     , _currentState(nullptr)
 {
     ASSERT(_context);
@@ -67,6 +68,7 @@ GPUContextDX11::GPUContextDX11(GPUDeviceDX11* device, ID3D11DeviceContext* conte
 
 GPUContextDX11::~GPUContextDX11()
 {
+    SAFE_DELETE_GPU_RESOURCE(_pushConstantsCB);
 #if GPU_ALLOW_PROFILE_EVENTS
     SAFE_RELEASE(_userDefinedAnnotations);
 #endif
@@ -300,14 +302,14 @@ void GPUContextDX11::ResetUA()
 void GPUContextDX11::ResetCB()
 {
     _cbDirtyFlag = false;
-    Platform::MemoryClear(_cbHandles, sizeof(_cbHandles));
+    Platform::MemoryClear(_cbHandles, sizeof(ID3D11Buffer*) * GPU_MAX_CB_BINDED);
 
-    _context->VSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
-    _context->HSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
-    _context->DSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
-    _context->GSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
-    _context->PSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
-    _context->CSSetConstantBuffers(0, ARRAY_COUNT(_cbHandles), _cbHandles);
+    _context->VSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
+    _context->HSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
+    _context->DSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
+    _context->GSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
+    _context->PSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
+    _context->CSSetConstantBuffers(0, GPU_MAX_CB_BINDED, _cbHandles);
 }
 
 void GPUContextDX11::BindCB(int32 slot, GPUConstantBuffer* cb)
@@ -408,6 +410,27 @@ void GPUContextDX11::UpdateCB(GPUConstantBuffer* cb, const void* data)
     _context->UpdateSubresource(cbDX11->GetBuffer(), 0, nullptr, data, size, 1);
 }
 
+void GPUContextDX11::SetPushConstants(const void* data, uint32 size)
+{
+    ASSERT(data && size <= GPU_MAX_PUSH_CONSTANTS_SIZE && size % sizeof(uint32) == 0);
+    if (size == 0)
+        return;
+    if (!_pushConstantsCB)
+        _pushConstantsCB = _device->CreateConstantBuffer(GPU_MAX_PUSH_CONSTANTS_SIZE, TEXT("PushConstants"));
+
+    // Emulate push constants with a constant buffer bound to the dedicated slot
+    byte buffer[GPU_MAX_PUSH_CONSTANTS_SIZE];
+    Platform::MemoryCopy(buffer, data, size);
+    Platform::MemoryClear(buffer + size, GPU_MAX_PUSH_CONSTANTS_SIZE - size);
+    auto cbDX11 = static_cast<GPUConstantBufferDX11*>(_pushConstantsCB);
+    _context->UpdateSubresource(cbDX11->GetBuffer(), 0, nullptr, buffer, GPU_MAX_PUSH_CONSTANTS_SIZE, 1);
+    if (_cbHandles[GPU_PUSH_CONSTANTS_SLOT] != cbDX11->GetBuffer())
+    {
+        _cbDirtyFlag = true;
+        _cbHandles[GPU_PUSH_CONSTANTS_SLOT] = cbDX11->GetBuffer();
+    }
+}
+
 void GPUContextDX11::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ)
 {
     CurrentCS = (GPUShaderProgramCSDX11*)shader;
@@ -515,6 +538,16 @@ void GPUContextDX11::SetScissor(const Rectangle& scissorRect)
     _context->RSSetScissorRects(1, &rect);
 }
 
+void GPUContextDX11::SetShadingRate(GPUShadingRate rate)
+{
+    // Not supported by D3D11
+}
+
+void GPUContextDX11::SetShadingRateImage(GPUTexture* image)
+{
+    // Not supported by D3D11
+}
+
 GPUPipelineState* GPUContextDX11::GetState() const
 {
     return _currentState;
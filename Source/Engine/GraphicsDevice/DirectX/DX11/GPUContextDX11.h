@@ -41,7 +41,10 @@ class GPUContextDX11 : public GPUContext
 
     // Constant Buffers
     bool _cbDirtyFlag;
-    ID3D11Buffer* _cbHandles[GPU_MAX_CB_BINDED];
+    ID3D11Buffer* _cbHandles[GPU_MAX_CB_BINDED + 1]; // Last slot is used by the push constants
+
+    // Push Constants (emulated with constant buffer)
+    GPUConstantBuffer* _pushConstantsCB;
 
     // Vertex Buffers
     GPUBufferDX11* _ibHandle;
@@ -127,6 +130,7 @@ class GPUContextDX11 : public GPUContext
     void BindIB(GPUBuffer* indexBuffer) override;
     void BindSampler(int32 slot, GPUSampler* sampler) override;
     void UpdateCB(GPUConstantBuffer* cb, const void* data) override;
+    void SetPushConstants(const void* data, uint32 size) override;
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override;
     void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
     void ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format) override;
@@ -136,6 +140,8 @@ class GPUContextDX11 : public GPUContext
     void DrawIndexedInstancedIndirect(GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
     void SetViewport(const Viewport& viewport) override;
     void SetScissor(const Rectangle& scissorRect) override;
+    void SetShadingRate(GPUShadingRate rate) override;
+    void SetShadingRateImage(GPUTexture* image) override;
     GPUPipelineState* GetState() const override;
     void SetState(GPUPipelineState* state) override;
     void ClearState() override;
@@ -8,6 +8,7 @@
 #include "GPUPipelineStateDX11.h"
 #include "GPUTextureDX11.h"
 #include "GPUTimerQueryDX11.h"
+#include "GPUPipelineStatsQueryDX11.h"
 #include "GPUBufferDX11.h"
 #include "GPUSamplerDX11.h"
 #include "GPUSwapChainDX11.h"
@@ -321,6 +322,13 @@ bool GPUDeviceDX11::Init()
             limits.HasReadOnlyDepth = true;
             limits.HasMultisampleDepthAsSRV = true;
             limits.HasTypedUAVLoad = featureDataD3D11Options2.TypedUAVLoadAdditionalFormats != 0;
+            limits.HasAsyncCompute = false;
+            limits.HasCopyQueue = false;
+            limits.HasResourceAliasing = false;
+            limits.HasVariableRateShading = false;
+            limits.HasVariableRateShadingImage = false;
+            limits.HasVariableRateShadingLargeRates = false;
+            limits.VariableRateShadingTileSize = 0;
             limits.MaximumMipLevelsCount = D3D11_REQ_MIP_LEVELS;
             limits.MaximumTexture1DSize = D3D11_REQ_TEXTURE1D_U_DIMENSION;
             limits.MaximumTexture1DArraySize = D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
@@ -344,6 +352,13 @@ bool GPUDeviceDX11::Init()
             limits.HasReadOnlyDepth = createdFeatureLevel == D3D_FEATURE_LEVEL_10_1;
             limits.HasMultisampleDepthAsSRV = false;
             limits.HasTypedUAVLoad = false;
+            limits.HasAsyncCompute = false;
+            limits.HasCopyQueue = false;
+            limits.HasResourceAliasing = false;
+            limits.HasVariableRateShading = false;
+            limits.HasVariableRateShadingImage = false;
+            limits.HasVariableRateShadingLargeRates = false;
+            limits.VariableRateShadingTileSize = 0;
             limits.MaximumMipLevelsCount = D3D10_REQ_MIP_LEVELS;
             limits.MaximumTexture1DSize = D3D10_REQ_TEXTURE1D_U_DIMENSION;
             limits.MaximumTexture1DArraySize = D3D10_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
@@ -686,6 +701,11 @@ GPUTimerQuery* GPUDeviceDX11::CreateTimerQuery()
     return New<GPUTimerQueryDX11>(this);
 }
 
+GPUPipelineStatsQuery* GPUDeviceDX11::CreatePipelineStatsQuery()
+{
+    return New<GPUPipelineStatsQueryDX11>(this);
+}
+
 GPUBuffer* GPUDeviceDX11::CreateBuffer(const StringView& name)
 {
     return New<GPUBufferDX11>(this, name);
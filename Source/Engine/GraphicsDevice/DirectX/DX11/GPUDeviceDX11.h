@@ -95,6 +95,7 @@ class GPUDeviceDX11 : public GPUDeviceDX
     GPUShader* CreateShader(const StringView& name) override;
     GPUPipelineState* CreatePipelineState() override;
     GPUTimerQuery* CreateTimerQuery() override;
+    GPUPipelineStatsQuery* CreatePipelineStatsQuery() override;
     GPUBuffer* CreateBuffer(const StringView& name) override;
     GPUSampler* CreateSampler() override;
     GPUSwapChain* CreateSwapChain(Window* window) override;
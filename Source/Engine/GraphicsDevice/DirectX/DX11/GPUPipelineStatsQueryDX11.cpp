@@ -0,0 +1,97 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if GRAPHICS_API_DIRECTX11
+
+#include "GPUPipelineStatsQueryDX11.h"
+
+GPUPipelineStatsQueryDX11::GPUPipelineStatsQueryDX11(GPUDeviceDX11* device)
+    : GPUResourceDX11<GPUPipelineStatsQuery>(device, String::Empty)
+{
+    Platform::MemoryClear(&_stats, sizeof(_stats));
+
+    D3D11_QUERY_DESC queryDesc;
+    queryDesc.Query = D3D11_QUERY_PIPELINE_STATISTICS;
+    queryDesc.MiscFlags = 0;
+    const HRESULT hr = device->GetDevice()->CreateQuery(&queryDesc, &_query);
+    if (hr != S_OK)
+    {
+        LOG(Fatal, "Failed to create a pipeline statistics query.");
+    }
+
+    // Set non-zero mem usage (fake)
+    _memoryUsage = sizeof(D3D11_QUERY_DATA_PIPELINE_STATISTICS);
+}
+
+GPUPipelineStatsQueryDX11::~GPUPipelineStatsQueryDX11()
+{
+    if (_query)
+        _query->Release();
+}
+
+void GPUPipelineStatsQueryDX11::OnReleaseGPU()
+{
+    SAFE_RELEASE(_query);
+}
+
+ID3D11Resource* GPUPipelineStatsQueryDX11::GetResource()
+{
+    return nullptr;
+}
+
+void GPUPipelineStatsQueryDX11::Begin()
+{
+    _device->GetIM()->Begin(_query);
+
+    _endCalled = false;
+}
+
+void GPUPipelineStatsQueryDX11::End()
+{
+    if (_endCalled)
+        return;
+
+    _device->GetIM()->End(_query);
+
+    _endCalled = true;
+    _finalized = false;
+}
+
+bool GPUPipelineStatsQueryDX11::HasResult()
+{
+    if (!_endCalled)
+        return false;
+
+    D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
+    return _device->GetIM()->GetData(_query, &data, sizeof(data), 0) == S_OK;
+}
+
+void GPUPipelineStatsQueryDX11::GetResult(GPUPipelineStats& result)
+{
+    if (!_finalized)
+    {
+#if BUILD_DEBUG
+        ASSERT(HasResult());
+#endif
+
+        D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
+        if (_device->GetIM()->GetData(_query, &data, sizeof(data), 0) == S_OK)
+        {
+            _stats.InputVertices = data.IAVertices;
+            _stats.InputPrimitives = data.IAPrimitives;
+            _stats.VertexShaderInvocations = data.VSInvocations;
+            _stats.PixelShaderInvocations = data.PSInvocations;
+            _stats.ComputeShaderInvocations = data.CSInvocations;
+            _stats.ClippingInvocations = data.CInvocations;
+            _stats.ClippingPrimitives = data.CPrimitives;
+        }
+        else
+        {
+            Platform::MemoryClear(&_stats, sizeof(_stats));
+        }
+
+        _finalized = true;
+    }
+    result = _stats;
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Graphics/GPUPipelineStatsQuery.h"
+#include "GPUDeviceDX11.h"
+
+#if GRAPHICS_API_DIRECTX11
+
+/// <summary>
+/// GPU pipeline statistics query object for DirectX 11 backend.
+/// </summary>
+class GPUPipelineStatsQueryDX11 : public GPUResourceDX11<GPUPipelineStatsQuery>
+{
+private:
+    bool _finalized = false;
+    bool _endCalled = false;
+    GPUPipelineStats _stats;
+    ID3D11Query* _query = nullptr;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="GPUPipelineStatsQueryDX11"/> class.
+    /// </summary>
+    /// <param name="device">The graphics device.</param>
+    GPUPipelineStatsQueryDX11(GPUDeviceDX11* device);
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="GPUPipelineStatsQueryDX11"/> class.
+    /// </summary>
+    ~GPUPipelineStatsQueryDX11();
+
+public:
+    // [GPUResourceDX11]
+    ID3D11Resource* GetResource() final override;
+
+    // [GPUPipelineStatsQuery]
+    void Begin() override;
+    void End() override;
+    bool HasResult() override;
+    void GetResult(GPUPipelineStats& result) override;
+
+protected:
+    // [GPUResource]
+    void OnReleaseGPU() override;
+};
+
+#endif
@@ -23,6 +23,7 @@ void DescriptorHeapWithSlotsDX12::Slot::CreateSRV(GPUDeviceDX12* device, ID3D12R
     if (Heap == nullptr)
         device->Heap_CBV_SRV_UAV.AllocateSlot(Heap, Index);
     device->GetDevice()->CreateShaderResourceView(resource, desc, CPU());
+    Platform::InterlockedIncrement(&device->DescriptorsVersion);
 }
 
 void DescriptorHeapWithSlotsDX12::Slot::CreateRTV(GPUDeviceDX12* device, ID3D12Resource* resource, D3D12_RENDER_TARGET_VIEW_DESC* desc)
@@ -51,6 +52,7 @@ void DescriptorHeapWithSlotsDX12::Slot::Release()
     if (Heap)
     {
         Heap->ReleaseSlot(Index);
+        Platform::InterlockedIncrement(&Heap->_device->DescriptorsVersion);
         Heap = nullptr;
     }
 }
@@ -183,6 +185,8 @@ DescriptorHeapRingBufferDX12::DescriptorHeapRingBufferDX12(GPUDeviceDX12* device
     , _heap(nullptr)
     , _type(type)
     , _descriptorsCount(descriptorsCount)
+    , _firstFree(0)
+    , _generation(0)
     , _shaderVisible(shaderVisible)
 {
 }
@@ -225,6 +229,7 @@ DescriptorHeapRingBufferDX12::Allocation DescriptorHeapRingBufferDX12::AllocateT
         // Move to the begin
         index = 0;
         _firstFree = numDesc;
+        _generation++;
     }
 
     // Set pointers
@@ -238,6 +243,7 @@ void DescriptorHeapRingBufferDX12::OnReleaseGPU()
 {
     DX_SAFE_RELEASE_CHECK(_heap, 0);
     _firstFree = 0;
+    _generation++;
 }
 
 #endif
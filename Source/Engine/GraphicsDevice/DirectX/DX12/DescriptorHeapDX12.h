@@ -151,6 +151,7 @@ class DescriptorHeapRingBufferDX12 : public GPUResource
     uint32 _incrementSize;
     uint32 _descriptorsCount;
     uint32 _firstFree;
+    uint32 _generation;
     bool _shaderVisible;
 
 public:
@@ -164,6 +165,14 @@ class DescriptorHeapRingBufferDX12 : public GPUResource
         return _heap;
     }
 
+    /// <summary>
+    /// Gets the ring buffer generation (incremented every time the allocations wrap around the heap). Tables allocated within the current generation are not overwritten.
+    /// </summary>
+    FORCE_INLINE uint32 GetGeneration() const
+    {
+        return _generation;
+    }
+
     bool Init();
     Allocation AllocateTable(uint32 numDesc);
 
@@ -136,13 +136,19 @@ bool GPUBufferDX12::OnInit()
     // Create resource
     ID3D12Resource* resource;
     D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COPY_DEST;
+    if (heapProperties.Type == D3D12_HEAP_TYPE_DEFAULT && _device->GetCopyQueue())
+    {
+        // Buffers are always created in the common state so initial data upload can be done on the copy queue without the handoff from the graphics queue
+        initialState = D3D12_RESOURCE_STATE_COMMON;
+    }
     VALIDATE_DIRECTX_RESULT(_device->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, nullptr, IID_PPV_ARGS(&resource)));
 
     // Set state
     initResource(resource, initialState, 1);
     DX_SET_DEBUG_NAME(_resource, GetName());
     _memoryUsage = _desc.Size;
-    int32 numElements = _desc.GetElementsCount();
+    // Raw buffer views are addressed in 32-bit elements (stride can be used as vertex buffer stride)
+    int32 numElements = EnumHasAnyFlags(_desc.Flags, GPUBufferFlags::RawBuffer) ? _desc.Size / sizeof(uint32) : _desc.GetElementsCount();
 
     // Check if set initial data
     if (_desc.InitData)
@@ -157,7 +163,7 @@ bool GPUBufferDX12::OnInit()
             // Modify staging resource data now
             SetData(_desc.InitData, _desc.Size);
         }
-        else if (_device->IsRendering() && IsInMainThread())
+        else if (_device->IsRendering() && IsInRenderThread())
         {
             // Upload resource data now
             _device->GetMainContext()->UpdateBuffer(this, _desc.InitData, _desc.Size);
@@ -4,6 +4,7 @@
 
 #include "GPUContextDX12.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/HashFunctions.h"
 #include "Engine/Core/Math/Viewport.h"
 #include "Engine/Core/Math/Rectangle.h"
 #include "GPUShaderDX12.h"
@@ -58,10 +59,16 @@ static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartIndex) == OFFSET_OF(D3D
 static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartVertex) == OFFSET_OF(D3D12_DRAW_INDEXED_ARGUMENTS, BaseVertexLocation), "Wrong offset for GPUDrawIndexedIndirectArgs::StartVertex");
 static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartInstance) == OFFSET_OF(D3D12_DRAW_INDEXED_ARGUMENTS, StartInstanceLocation), "Wrong offset for GPUDrawIndexedIndirectArgs::StartInstance");
 
+// Combines the per-draw shading rate with the shading rate image by picking the coarser rate (per-primitive rate is not used)
+static const D3D12_SHADING_RATE_COMBINER ShadingRateCombiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] = { D3D12_SHADING_RATE_COMBINER_PASSTHROUGH, D3D12_SHADING_RATE_COMBINER_MAX };
+
 GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE type)
     : GPUContext(device)
     , _device(device)
+    , _queue(type == D3D12_COMMAND_LIST_TYPE_COMPUTE ? device->GetComputeQueue() : type == D3D12_COMMAND_LIST_TYPE_COPY ? device->GetCopyQueue() : device->GetCommandQueue())
+    , _type(type)
     , _commandList(nullptr)
+    , _commandList5(nullptr)
     , _currentAllocator(nullptr)
     , _currentState(nullptr)
     , _currentCompute(nullptr)
@@ -69,6 +76,9 @@ GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE ty
     , _vbCount(0)
     , _rtCount(0)
     , _rbBufferSize(0)
+    , _pushConstantsSize(0)
+    , _shadingRate(GPUShadingRate::Rate1x1)
+    , _shadingRateImage(nullptr)
     , _srMaskDirtyGraphics(0)
     , _srMaskDirtyCompute(0)
     , _isCompute(0)
@@ -77,25 +87,57 @@ GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE ty
     , _cbGraphicsDirtyFlag(0)
     , _cbComputeDirtyFlag(0)
     , _samplersDirtyFlag(0)
+    , _isOverlapUA(0)
+    , _pushConstantsGraphicsDirtyFlag(0)
+    , _pushConstantsComputeDirtyFlag(0)
     , _rtDepth(nullptr)
     , _ibHandle(nullptr)
 {
     FrameFenceValues[0] = 0;
     FrameFenceValues[1] = 0;
-    _currentAllocator = _device->GetCommandQueue()->RequestAllocator();
+    _currentAllocator = _queue->RequestAllocator();
     VALIDATE_DIRECTX_RESULT(device->GetDevice()->CreateCommandList(0, type, _currentAllocator, nullptr, IID_PPV_ARGS(&_commandList)));
 #if GPU_ENABLE_RESOURCE_NAMING
     _commandList->SetName(TEXT("GPUContextDX12::CommandList"));
 #endif
+    if (type == D3D12_COMMAND_LIST_TYPE_DIRECT && device->Limits.HasVariableRateShading)
+        _commandList->QueryInterface(IID_PPV_ARGS(&_commandList5));
 }
 
 GPUContextDX12::~GPUContextDX12()
 {
+    if (_commandList5)
+        _commandList5->Release();
     DX_SAFE_RELEASE_CHECK(_commandList, 0);
 }
 
 void GPUContextDX12::AddTransitionBarrier(ResourceOwnerDX12* resource, const D3D12_RESOURCE_STATES before, const D3D12_RESOURCE_STATES after, const int32 subresourceIndex)
 {
+#if DX12_ENABLE_RESOURCE_BARRIERS_BATCHING
+    // Merge with the pending transition of the same subresource (eg. A->B followed by B->C becomes A->C, and A->B followed by B->A is removed)
+    for (int32 i = _rbBufferSize - 1; i >= 0; i--)
+    {
+        D3D12_RESOURCE_BARRIER& e = _rbBuffer[i];
+        if (e.Type != D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+            break;
+        if (e.Transition.pResource == resource->GetResource())
+        {
+            if (e.Transition.Subresource != (UINT)subresourceIndex || e.Transition.StateAfter != before)
+                break;
+            if (e.Transition.StateBefore == after)
+            {
+                _rbBufferSize--;
+                for (int32 j = i; j < _rbBufferSize; j++)
+                    _rbBuffer[j] = _rbBuffer[j + 1];
+            }
+            else
+            {
+                e.Transition.StateAfter = after;
+            }
+            return;
+        }
+    }
+#endif
     if (_rbBufferSize == DX12_RB_BUFFER_SIZE)
         flushRBs();
 
@@ -126,6 +168,11 @@ void GPUContextDX12::AddTransitionBarrier(ResourceOwnerDX12* resource, const D3D
 
 void GPUContextDX12::AddUAVBarrier()
 {
+#if DX12_ENABLE_RESOURCE_BARRIERS_BATCHING
+    // Skip redundant barrier if the global UAV barrier is already pending
+    if (_rbBufferSize != 0 && _rbBuffer[_rbBufferSize - 1].Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && _rbBuffer[_rbBufferSize - 1].UAV.pResource == nullptr)
+        return;
+#endif
     if (_rbBufferSize == DX12_RB_BUFFER_SIZE)
         flushRBs();
 
@@ -151,6 +198,22 @@ void GPUContextDX12::SetResourceState(ResourceOwnerDX12* resource, D3D12_RESOURC
     if (nativeResource == nullptr)
         return;
     auto& state = resource->State;
+    if (_type == D3D12_COMMAND_LIST_TYPE_COMPUTE)
+    {
+        // Compute command lists support only a subset of the resource states
+        after &= DX12_COMPUTE_RESOURCE_STATES;
+        handoffResource(resource, subresourceIndex, DX12_COMPUTE_RESOURCE_STATES);
+    }
+    else if (_type == D3D12_COMMAND_LIST_TYPE_COPY)
+    {
+        // Copy command lists support only the copy states and get the resources from the graphics queue in the common state (on the first use within the submitted work)
+        after &= DX12_COPY_RESOURCE_STATES;
+        if (!_queueResources.Contains(resource))
+        {
+            handoffResource(resource, -1, D3D12_RESOURCE_STATE_COMMON);
+            _queueResources.Add(resource);
+        }
+    }
     if (subresourceIndex == -1)
     {
         if (state.AreAllSubresourcesSame())
@@ -202,13 +265,40 @@ void GPUContextDX12::SetResourceState(ResourceOwnerDX12* resource, D3D12_RESOURC
     }
 }
 
+void GPUContextDX12::handoffResource(ResourceOwnerDX12* resource, int32 subresourceIndex, D3D12_RESOURCE_STATES supportedStates)
+{
+    // Resources used by the graphics queue can be in the states not supported by the compute or copy queue so transition them into the common state (on the main context, before the work submission)
+    auto& state = resource->State;
+    if (state.AreAllSubresourcesSame())
+    {
+        const D3D12_RESOURCE_STATES before = state.GetSubresourceState(-1);
+        if (before & ~supportedStates)
+        {
+            _queueHandoffs.Add({ resource, before, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES });
+            state.SetResourceState(D3D12_RESOURCE_STATE_COMMON);
+        }
+        return;
+    }
+    const int32 start = subresourceIndex == -1 ? 0 : subresourceIndex;
+    const int32 end = subresourceIndex == -1 ? state.GetSubresourcesCount() : subresourceIndex + 1;
+    for (int32 i = start; i < end; i++)
+    {
+        const D3D12_RESOURCE_STATES before = state.GetSubresourceState(i);
+        if (before & ~supportedStates)
+        {
+            _queueHandoffs.Add({ resource, before, i });
+            state.SetSubresourceState(i, D3D12_RESOURCE_STATE_COMMON);
+        }
+    }
+}
+
 void GPUContextDX12::Reset()
 {
     // The command list persists, but we must request a new allocator
     ASSERT(_commandList != nullptr);
     if (_currentAllocator == nullptr)
     {
-        _currentAllocator = _device->GetCommandQueue()->RequestAllocator();
+        _currentAllocator = _queue->RequestAllocator();
         _commandList->Reset(_currentAllocator, nullptr);
     }
 
@@ -225,7 +315,15 @@ void GPUContextDX12::Reset()
     _psDirtyFlag = false;
     _isCompute = false;
     _currentCompute = nullptr;
+    _isOverlapUA = false;
     _rbBufferSize = 0;
+    _pushConstantsSize = 0;
+    _pushConstantsGraphicsDirtyFlag = false;
+    _pushConstantsComputeDirtyFlag = false;
+    _shadingRate = GPUShadingRate::Rate1x1;
+    _shadingRateImage = nullptr;
+    if (_commandList5 && _device->Limits.HasVariableRateShadingImage)
+        _commandList5->RSSetShadingRate(D3D12_SHADING_RATE_1X1, ShadingRateCombiners);
     _vbCount = 0;
     Platform::MemoryClear(_rtHandles, sizeof(_rtHandles));
     Platform::MemoryClear(_srHandles, sizeof(_srHandles));
@@ -234,6 +332,7 @@ void GPUContextDX12::Reset()
     _ibHandle = nullptr;
     Platform::MemoryClear(&_cbHandles, sizeof(_cbHandles));
     Platform::MemoryClear(&_samplers, sizeof(_samplers));
+    Platform::MemoryClear(&_srTableCache, sizeof(_srTableCache));
     _swapChainsUsed = 0;
 
     ForceRebindDescriptors();
@@ -242,7 +341,7 @@ void GPUContextDX12::Reset()
 uint64 GPUContextDX12::Execute(bool waitForCompletion)
 {
     ASSERT(_currentAllocator != nullptr);
-    auto queue = _device->GetCommandQueue();
+    auto queue = _queue;
 
     // Flush remaining and buffered commands
     FlushState();
@@ -332,17 +431,43 @@ void GPUContextDX12::flushSRVs()
         }
     }
 
-    // Allocate data for the table
-    auto allocation = _device->RingHeap_CBV_SRV_UAV.AllocateTable(srCount);
-
-    // Copy descriptors
-    _device->GetDevice()->CopyDescriptors(1, &allocation.CPU, &srCount, srCount, srcDescriptorRangeStarts, nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    // Reuse the table copied before if the same descriptors are bound (eg. draw calls using the same material textures)
+    uint32 hash = srCount;
+    for (uint32 i = 0; i < srCount; i++)
+        CombineHash(hash, (uint32)(srcDescriptorRangeStarts[i].ptr >> 4));
+    SrTableCacheEntry& cache = _srTableCache[hash % DX12_SR_TABLE_CACHE_SIZE];
+    const uint32 generation = _device->RingHeap_CBV_SRV_UAV.GetGeneration();
+    const int64 descriptorsVersion = _device->DescriptorsVersion;
+    D3D12_GPU_DESCRIPTOR_HANDLE table;
+    if (cache.Count == srCount &&
+        cache.Generation == generation &&
+        cache.DescriptorsVersion == descriptorsVersion &&
+        Platform::MemoryCompare(cache.Descriptors, srcDescriptorRangeStarts, srCount * sizeof(D3D12_CPU_DESCRIPTOR_HANDLE)) == 0)
+    {
+        table = cache.GPU;
+    }
+    else
+    {
+        // Allocate data for the table
+        auto allocation = _device->RingHeap_CBV_SRV_UAV.AllocateTable(srCount);
+
+        // Copy descriptors
+        _device->GetDevice()->CopyDescriptors(1, &allocation.CPU, &srCount, srCount, srcDescriptorRangeStarts, nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        table = allocation.GPU;
+
+        // Cache the table (allocation could wrap the ring buffer so read the generation again)
+        cache.Count = srCount;
+        cache.Generation = _device->RingHeap_CBV_SRV_UAV.GetGeneration();
+        cache.DescriptorsVersion = descriptorsVersion;
+        cache.GPU = table;
+        Platform::MemoryCopy(cache.Descriptors, srcDescriptorRangeStarts, srCount * sizeof(D3D12_CPU_DESCRIPTOR_HANDLE));
+    }
 
     // Flush SRV descriptors table
     if (_isCompute)
-        _commandList->SetComputeRootDescriptorTable(DX12_ROOT_SIGNATURE_SR, allocation.GPU);
+        _commandList->SetComputeRootDescriptorTable(DX12_ROOT_SIGNATURE_SR, table);
     else
-        _commandList->SetGraphicsRootDescriptorTable(DX12_ROOT_SIGNATURE_SR, allocation.GPU);
+        _commandList->SetGraphicsRootDescriptorTable(DX12_ROOT_SIGNATURE_SR, table);
 }
 
 void GPUContextDX12::flushRTVs()
@@ -475,6 +600,18 @@ void GPUContextDX12::flushCBs()
             }
         }
     }
+
+    // Push constants
+    if (_pushConstantsGraphicsDirtyFlag && !_isCompute)
+    {
+        _pushConstantsGraphicsDirtyFlag = false;
+        _commandList->SetGraphicsRoot32BitConstants(DX12_ROOT_SIGNATURE_PUSH_CONSTANTS, _pushConstantsSize / sizeof(uint32), _pushConstants, 0);
+    }
+    else if (_pushConstantsComputeDirtyFlag && _isCompute)
+    {
+        _pushConstantsComputeDirtyFlag = false;
+        _commandList->SetComputeRoot32BitConstants(DX12_ROOT_SIGNATURE_PUSH_CONSTANTS, _pushConstantsSize / sizeof(uint32), _pushConstants, 0);
+    }
 }
 
 void GPUContextDX12::flushSamplers()
@@ -1009,6 +1146,19 @@ void GPUContextDX12::UpdateCB(GPUConstantBuffer* cb, const void* data)
     }
 }
 
+void GPUContextDX12::SetPushConstants(const void* data, uint32 size)
+{
+    ASSERT(data && size <= GPU_MAX_PUSH_CONSTANTS_SIZE && size % sizeof(uint32) == 0);
+    if (size == 0)
+        return;
+
+    // Set as root constants on the next draw/dispatch (no upload buffer allocation)
+    Platform::MemoryCopy(_pushConstants, data, size);
+    _pushConstantsSize = size;
+    _pushConstantsGraphicsDirtyFlag = true;
+    _pushConstantsComputeDirtyFlag = true;
+}
+
 void GPUContextDX12::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ)
 {
     _isCompute = 1;
@@ -1035,8 +1185,9 @@ void GPUContextDX12::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCoun
     // Restore previous state on next draw call
     _psDirtyFlag = true;
 
-    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches
-    AddUAVBarrier();
+    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches (skipped within overlap region or if shader doesn't write to any UAV)
+    if (!_isOverlapUA && shader->GetBindings().UsedUAsMask != 0)
+        AddUAVBarrier();
 }
 
 void GPUContextDX12::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs)
@@ -1069,8 +1220,19 @@ void GPUContextDX12::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* buf
     // Restore previous state on next draw call
     _psDirtyFlag = true;
 
-    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches
-    AddUAVBarrier();
+    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches (skipped within overlap region or if shader doesn't write to any UAV)
+    if (!_isOverlapUA && shader->GetBindings().UsedUAsMask != 0)
+        AddUAVBarrier();
+}
+
+void GPUContextDX12::OverlapUA(bool end)
+{
+    _isOverlapUA = !end;
+    if (end)
+    {
+        // Synchronize all dispatches from the overlap region
+        AddUAVBarrier();
+    }
 }
 
 void GPUContextDX12::ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format)
@@ -1144,6 +1306,29 @@ void GPUContextDX12::SetScissor(const Rectangle& scissorRect)
     _commandList->RSSetScissorRects(1, &rect);
 }
 
+void GPUContextDX12::SetShadingRate(GPUShadingRate rate)
+{
+    if (!_commandList5 || _shadingRate == rate)
+        return;
+    _shadingRate = rate;
+    _commandList5->RSSetShadingRate((D3D12_SHADING_RATE)rate, _device->Limits.HasVariableRateShadingImage ? ShadingRateCombiners : nullptr);
+}
+
+void GPUContextDX12::SetShadingRateImage(GPUTexture* image)
+{
+    auto imageDX12 = static_cast<GPUTextureDX12*>(image);
+    if (!_commandList5 || !_device->Limits.HasVariableRateShadingImage || _shadingRateImage == imageDX12)
+        return;
+    _shadingRateImage = imageDX12;
+    if (imageDX12)
+    {
+        ASSERT(imageDX12->Format() == PixelFormat::R8_UInt);
+        SetResourceState(imageDX12, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+        flushRBs();
+    }
+    _commandList5->RSSetShadingRateImage(imageDX12 ? imageDX12->GetResource() : nullptr);
+}
+
 GPUPipelineState* GPUContextDX12::GetState() const
 {
     return _currentState;
@@ -1195,6 +1380,78 @@ void GPUContextDX12::Flush()
     Reset();
 }
 
+UploadBufferDX12* GPUContextDX12::getUploadBuffer() const
+{
+    return _type == D3D12_COMMAND_LIST_TYPE_COPY ? _device->CopyUploadBuffer : _device->UploadBuffer;
+}
+
+GPUSyncPoint GPUContextDX12::Submit()
+{
+    if (_type == D3D12_COMMAND_LIST_TYPE_COPY)
+    {
+        // Return the used resources into the common state (graphics queue waits for the copy work before using them)
+        for (ResourceOwnerDX12* resource : _queueResources)
+            SetResourceState(resource, D3D12_RESOURCE_STATE_COMMON);
+        _queueResources.Clear();
+    }
+    if (_type == D3D12_COMMAND_LIST_TYPE_COMPUTE || _queueHandoffs.HasItems())
+    {
+        // Transition the resources used by the compute or copy work out of the graphics-only states and make it execute after the main context work recorded so far (copy work waits only if it uses resources from the graphics queue)
+        GPUContextDX12* mainContext = _device->GetMainContextDX12();
+        for (const QueueHandoff& e : _queueHandoffs)
+            mainContext->AddTransitionBarrier(e.Resource, e.Before, D3D12_RESOURCE_STATE_COMMON, e.SubresourceIndex);
+        _queueHandoffs.Clear();
+        const uint64 mainFenceValue = mainContext->Execute(false);
+        mainContext->Reset();
+        mainContext->_queue->_fence.WaitGPU(_queue, mainFenceValue);
+    }
+
+    // Execute commands (but don't wait for them)
+    const uint64 fenceValue = Execute(false);
+    Reset();
+    if (_type != D3D12_COMMAND_LIST_TYPE_DIRECT)
+        FrameFenceValues[0] = fenceValue;
+    return fenceValue;
+}
+
+void GPUContextDX12::Wait(GPUContext* other, GPUSyncPoint syncPoint)
+{
+    const auto otherDX12 = static_cast<GPUContextDX12*>(other);
+    if (otherDX12->_queue == _queue || syncPoint == 0)
+        return;
+
+    // Flush commands recorded so far to don't wait with them for the other queue
+    Execute(false);
+    Reset();
+    otherDX12->_queue->_fence.WaitGPU(_queue, syncPoint);
+}
+
+void GPUContextDX12::AliasTexture(GPUTexture* texture)
+{
+    auto textureDX12 = static_cast<GPUTextureDX12*>(texture);
+    if (!textureDX12 || !textureDX12->GetResource())
+        return;
+
+    // Wait for the previous usage of the heap memory by other resources
+    if (_rbBufferSize == DX12_RB_BUFFER_SIZE)
+        flushRBs();
+    D3D12_RESOURCE_BARRIER barrier;
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Aliasing.pResourceBefore = nullptr;
+    barrier.Aliasing.pResourceAfter = textureDX12->GetResource();
+#if DX12_ENABLE_RESOURCE_BARRIERS_BATCHING
+    _rbBuffer[_rbBufferSize++] = barrier;
+#else
+    _commandList->ResourceBarrier(1, &barrier);
+#endif
+
+    // Initialize the resource metadata (placed render targets and depth buffers have to be cleared, discarded or copied before the first use)
+    SetResourceState(textureDX12, texture->IsDepthStencil() ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_RENDER_TARGET);
+    flushRBs();
+    _commandList->DiscardResource(textureDX12->GetResource(), nullptr);
+}
+
 void GPUContextDX12::UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset)
 {
     ASSERT(data);
@@ -1205,7 +1462,7 @@ void GPUContextDX12::UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 si
     SetResourceState(bufferDX12, D3D12_RESOURCE_STATE_COPY_DEST);
     flushRBs();
 
-    _device->UploadBuffer->UploadBuffer(this, bufferDX12->GetResource(), offset, data, size);
+    getUploadBuffer()->UploadBuffer(this, bufferDX12->GetResource(), offset, data, size);
 }
 
 void GPUContextDX12::CopyBuffer(GPUBuffer* dstBuffer, GPUBuffer* srcBuffer, uint32 size, uint32 dstOffset, uint32 srcOffset)
@@ -1231,7 +1488,7 @@ void GPUContextDX12::UpdateTexture(GPUTexture* texture, int32 arrayIndex, int32
     SetResourceState(textureDX12, D3D12_RESOURCE_STATE_COPY_DEST);
     flushRBs();
 
-    _device->UploadBuffer->UploadTexture(this, textureDX12->GetResource(), data, rowPitch, slicePitch, mipIndex, arrayIndex);
+    getUploadBuffer()->UploadTexture(this, textureDX12->GetResource(), data, rowPitch, slicePitch, mipIndex, arrayIndex);
 }
 
 void GPUContextDX12::CopyTexture(GPUTexture* dstResource, uint32 dstSubresource, uint32 dstX, uint32 dstY, uint32 dstZ, GPUTexture* srcResource, uint32 srcSubresource)
@@ -1437,9 +1694,20 @@ void GPUContextDX12::SetResourceState(GPUResource* resource, uint64 state, int32
 
 void GPUContextDX12::ForceRebindDescriptors()
 {
+    // Copy command lists don't use descriptors
+    if (_type == D3D12_COMMAND_LIST_TYPE_COPY)
+        return;
+
     // Bind Root Signature
-    _commandList->SetGraphicsRootSignature(_device->GetRootSignature());
+    if (_type != D3D12_COMMAND_LIST_TYPE_COMPUTE)
+        _commandList->SetGraphicsRootSignature(_device->GetRootSignature());
     _commandList->SetComputeRootSignature(_device->GetRootSignature());
+    if (_pushConstantsSize)
+    {
+        // Root arguments get reset with the root signature
+        _pushConstantsGraphicsDirtyFlag = true;
+        _pushConstantsComputeDirtyFlag = true;
+    }
 
     // Bind heaps
     ID3D12DescriptorHeap* ppHeaps[] = {_device->RingHeap_CBV_SRV_UAV.GetHeap(), _device->RingHeap_Sampler.GetHeap()};
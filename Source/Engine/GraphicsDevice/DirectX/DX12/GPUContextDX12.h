@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Graphics/GPUContext.h"
+#include "Engine/Core/Collections/Array.h"
 #include "IShaderResourceDX12.h"
 #include "DescriptorHeapDX12.h"
 #include "../IncludeDirectXHeaders.h"
@@ -14,13 +15,31 @@ class GPUPipelineStateDX12;
 class GPUBufferDX12;
 class GPUSamplerDX12;
 class GPUConstantBufferDX12;
+class GPUTextureDX12;
 class GPUTextureViewDX12;
+class CommandQueueDX12;
+class UploadBufferDX12;
 
 /// <summary>
 /// Size of the resource barriers buffer size (will be flushed on overflow)
 /// </summary>
 #define DX12_RB_BUFFER_SIZE 16
 
+/// <summary>
+/// Size of the shader resources descriptor tables cache (used to reuse tables already copied into the GPU-visible heap)
+/// </summary>
+#define DX12_SR_TABLE_CACHE_SIZE 64
+
+/// <summary>
+/// The resource states supported by the compute command lists (other states can be used only on the graphics queue)
+/// </summary>
+#define DX12_COMPUTE_RESOURCE_STATES (D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_UNORDERED_ACCESS | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT | D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_COPY_SOURCE)
+
+/// <summary>
+/// The resource states supported by the copy command lists
+/// </summary>
+#define DX12_COPY_RESOURCE_STATES (D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_COPY_SOURCE)
+
 /// <summary>
 /// GPU Commands Context implementation for DirectX 12
 /// </summary>
@@ -34,8 +53,27 @@ class GPUContextDX12 : public GPUContext
 
 private:
 
+    struct SrTableCacheEntry
+    {
+        uint32 Count;
+        uint32 Generation;
+        int64 DescriptorsVersion;
+        D3D12_GPU_DESCRIPTOR_HANDLE GPU;
+        D3D12_CPU_DESCRIPTOR_HANDLE Descriptors[GPU_MAX_SR_BINDED];
+    };
+
+    struct QueueHandoff
+    {
+        ResourceOwnerDX12* Resource;
+        D3D12_RESOURCE_STATES Before;
+        int32 SubresourceIndex;
+    };
+
     GPUDeviceDX12* _device;
+    CommandQueueDX12* _queue;
+    D3D12_COMMAND_LIST_TYPE _type;
     ID3D12GraphicsCommandList* _commandList;
+    ID3D12GraphicsCommandList5* _commandList5;
     ID3D12CommandAllocator* _currentAllocator;
     GPUPipelineStateDX12* _currentState;
     GPUShaderProgramCS* _currentCompute;
@@ -44,6 +82,9 @@ class GPUContextDX12 : public GPUContext
     int32 _vbCount;
     int32 _rtCount;
     int32 _rbBufferSize;
+    uint32 _pushConstantsSize;
+    GPUShadingRate _shadingRate;
+    GPUTextureDX12* _shadingRateImage;
 
     uint32 _srMaskDirtyGraphics;
     uint32 _srMaskDirtyCompute;
@@ -54,6 +95,9 @@ class GPUContextDX12 : public GPUContext
     int32 _cbGraphicsDirtyFlag : 1;
     int32 _cbComputeDirtyFlag : 1;
     int32 _samplersDirtyFlag : 1;
+    int32 _isOverlapUA : 1;
+    int32 _pushConstantsGraphicsDirtyFlag : 1;
+    int32 _pushConstantsComputeDirtyFlag : 1;
 
     GPUTextureViewDX12* _rtDepth;
     GPUTextureViewDX12* _rtHandles[GPU_MAX_RT_BINDED];
@@ -65,7 +109,11 @@ class GPUContextDX12 : public GPUContext
     D3D12_VERTEX_BUFFER_VIEW _vbViews[GPU_MAX_VB_BINDED];
     D3D12_RESOURCE_BARRIER _rbBuffer[DX12_RB_BUFFER_SIZE];
     GPUConstantBufferDX12* _cbHandles[GPU_MAX_CB_BINDED];
+    uint32 _pushConstants[GPU_MAX_PUSH_CONSTANTS_SIZE / sizeof(uint32)];
     GPUSamplerDX12* _samplers[GPU_MAX_SAMPLER_BINDED - GPU_STATIC_SAMPLERS_COUNT];
+    SrTableCacheEntry _srTableCache[DX12_SR_TABLE_CACHE_SIZE];
+    Array<QueueHandoff> _queueHandoffs;
+    Array<ResourceOwnerDX12*> _queueResources;
 
 public:
 
@@ -93,7 +141,7 @@ class GPUContextDX12 : public GPUContext
     void AddTransitionBarrier(ResourceOwnerDX12* resource, const D3D12_RESOURCE_STATES before, const D3D12_RESOURCE_STATES after, const int32 subresourceIndex);
 
     /// <summary>
-    /// Adds the UAV barrier. Supports batching barriers.
+    /// Adds the UAV barrier. Supports batching barriers (subsequent UAV barriers are merged into a single one).
     /// </summary>
     void AddUAVBarrier();
 
@@ -143,6 +191,8 @@ class GPUContextDX12 : public GPUContext
     void flushSamplers();
     void flushRBs();
     void flushPS();
+    void handoffResource(ResourceOwnerDX12* resource, int32 subresourceIndex, D3D12_RESOURCE_STATES supportedStates);
+    UploadBufferDX12* getUploadBuffer() const;
     void OnDrawCall();
 
 public:
@@ -177,8 +227,10 @@ class GPUContextDX12 : public GPUContext
     void BindIB(GPUBuffer* indexBuffer) override;
     void BindSampler(int32 slot, GPUSampler* sampler) override;
     void UpdateCB(GPUConstantBuffer* cb, const void* data) override;
+    void SetPushConstants(const void* data, uint32 size) override;
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override;
     void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
+    void OverlapUA(bool end) override;
     void ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format) override;
     void DrawInstanced(uint32 verticesCount, uint32 instanceCount, int32 startInstance, int32 startVertex) override;
     void DrawIndexedInstanced(uint32 indicesCount, uint32 instanceCount, int32 startInstance, int32 startVertex, int32 startIndex) override;
@@ -186,11 +238,16 @@ class GPUContextDX12 : public GPUContext
     void DrawIndexedInstancedIndirect(GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
     void SetViewport(const Viewport& viewport) override;
     void SetScissor(const Rectangle& scissorRect) override;
+    void SetShadingRate(GPUShadingRate rate) override;
+    void SetShadingRateImage(GPUTexture* image) override;
     GPUPipelineState* GetState() const override;
     void SetState(GPUPipelineState* state) override;
     void ClearState() override;
     void FlushState() override;
     void Flush() override;
+    GPUSyncPoint Submit() override;
+    void Wait(GPUContext* other, GPUSyncPoint syncPoint) override;
+    void AliasTexture(GPUTexture* texture) override;
     void UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset) override;
     void CopyBuffer(GPUBuffer* dstBuffer, GPUBuffer* srcBuffer, uint32 size, uint32 dstOffset, uint32 srcOffset) override;
     void UpdateTexture(GPUTexture* texture, int32 arrayIndex, int32 mipIndex, const void* data, uint32 rowPitch, uint32 slicePitch) override;
@@ -8,11 +8,14 @@
 #include "GPUPipelineStateDX12.h"
 #include "GPUTextureDX12.h"
 #include "GPUTimerQueryDX12.h"
+#include "GPUPipelineStatsQueryDX12.h"
 #include "GPUBufferDX12.h"
 #include "GPUSamplerDX12.h"
 #include "GPUSwapChainDX12.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/CommandLine.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Graphics/GPUPipelineStateUsageCache.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/GraphicsDevice/DirectX/RenderToolsDX.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -178,6 +181,18 @@ static MSAALevel GetMaximumMultisampleCount(ID3D12Device* device, DXGI_FORMAT dx
     return static_cast<MSAALevel>(maxCount);
 }
 
+namespace
+{
+    String GetPipelineCachePath(const Char* fileName)
+    {
+#if USE_EDITOR
+        return Globals::ProjectCacheFolder / fileName;
+#else
+        return Globals::ProductLocalFolder / fileName;
+#endif
+    }
+}
+
 GPUDeviceDX12::GPUDeviceDX12(IDXGIFactory4* dxgiFactory, GPUAdapterDX* adapter)
     : GPUDeviceDX(RendererType::DirectX12, ShaderProfile::DirectX_SM6, adapter)
     , _device(nullptr)
@@ -185,9 +200,15 @@ GPUDeviceDX12::GPUDeviceDX12(IDXGIFactory4* dxgiFactory, GPUAdapterDX* adapter)
     , _res2Dispose(256)
     , _rootSignature(nullptr)
     , _commandQueue(nullptr)
+    , _computeQueue(nullptr)
+    , _copyQueue(nullptr)
     , _mainContext(nullptr)
+    , _computeContext(nullptr)
+    , _copyContext(nullptr)
     , UploadBuffer(nullptr)
+    , CopyUploadBuffer(nullptr)
     , TimestampQueryHeap(this, D3D12_QUERY_HEAP_TYPE_TIMESTAMP, DX12_BACK_BUFFER_COUNT * 1024)
+    , PipelineStatsQueryHeap(this, D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS, DX12_BACK_BUFFER_COUNT * 1024)
     , Heap_CBV_SRV_UAV(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 4 * 1024, false)
     , Heap_RTV(this, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1 * 1024, false)
     , Heap_DSV(this, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 64, false)
@@ -328,6 +349,10 @@ bool GPUDeviceDX12::Init()
     LOG(Info, "Resource Binding Tier: {0}", options.ResourceBindingTier);
     LOG(Info, "Conservative Rasterization Tier: {0}", options.ConservativeRasterizationTier);
     LOG(Info, "Resource Heap Tier: {0}", options.ResourceHeapTier);
+    D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+    if (FAILED(_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
+        options6.VariableShadingRateTier = D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED;
+    LOG(Info, "Variable Shading Rate Tier: {0}", (int32)options6.VariableShadingRateTier);
 
     // Init device limits
     {
@@ -344,6 +369,13 @@ bool GPUDeviceDX12::Init()
         limits.HasReadOnlyDepth = true;
         limits.HasMultisampleDepthAsSRV = true;
         limits.HasTypedUAVLoad = options.TypedUAVLoadAdditionalFormats != 0;
+        limits.HasAsyncCompute = true;
+        limits.HasCopyQueue = true;
+        limits.HasResourceAliasing = true;
+        limits.HasVariableRateShading = options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_1;
+        limits.HasVariableRateShadingImage = options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2;
+        limits.HasVariableRateShadingLargeRates = limits.HasVariableRateShading && options6.AdditionalShadingRatesSupported;
+        limits.VariableRateShadingTileSize = limits.HasVariableRateShadingImage ? (int32)options6.ShadingRateImageTileSize : 0;
         limits.MaximumMipLevelsCount = D3D12_REQ_MIP_LEVELS;
         limits.MaximumTexture1DSize = D3D12_REQ_TEXTURE1D_U_DIMENSION;
         limits.MaximumTexture1DArraySize = D3D12_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
@@ -378,7 +410,15 @@ bool GPUDeviceDX12::Init()
     _commandQueue = New<CommandQueueDX12>(this, D3D12_COMMAND_LIST_TYPE_DIRECT);
     if (_commandQueue->Init())
         return true;
+    _computeQueue = New<CommandQueueDX12>(this, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+    if (_computeQueue->Init())
+        return true;
+    _copyQueue = New<CommandQueueDX12>(this, D3D12_COMMAND_LIST_TYPE_COPY);
+    if (_copyQueue->Init())
+        return true;
     _mainContext = New<GPUContextDX12>(this, D3D12_COMMAND_LIST_TYPE_DIRECT);
+    _computeContext = New<GPUContextDX12>(this, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+    _copyContext = New<GPUContextDX12>(this, D3D12_COMMAND_LIST_TYPE_COPY);
     if (RingHeap_CBV_SRV_UAV.Init())
         return true;
     if (RingHeap_Sampler.Init())
@@ -489,7 +529,7 @@ bool GPUDeviceDX12::Init()
         }
 
         // Root parameters
-        D3D12_ROOT_PARAMETER rootParameters[GPU_MAX_CB_BINDED + 3];
+        D3D12_ROOT_PARAMETER rootParameters[GPU_MAX_CB_BINDED + 4];
         for (int32 i = 0; i < GPU_MAX_CB_BINDED; i++)
         {
             // CB
@@ -523,6 +563,15 @@ bool GPUDeviceDX12::Init()
             rootParam.DescriptorTable.NumDescriptorRanges = 1;
             rootParam.DescriptorTable.pDescriptorRanges = &r[2];
         }
+        {
+            // Push Constants
+            D3D12_ROOT_PARAMETER& rootParam = rootParameters[DX12_ROOT_SIGNATURE_PUSH_CONSTANTS];
+            rootParam.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+            rootParam.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            rootParam.Constants.ShaderRegister = GPU_PUSH_CONSTANTS_SLOT;
+            rootParam.Constants.RegisterSpace = 0;
+            rootParam.Constants.Num32BitValues = GPU_MAX_PUSH_CONSTANTS_SIZE / sizeof(uint32);
+        }
 
         // Static samplers
         D3D12_STATIC_SAMPLER_DESC staticSamplers[6];
@@ -628,10 +677,43 @@ bool GPUDeviceDX12::Init()
         VALIDATE_DIRECTX_RESULT(_device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&_rootSignature)));
     }
 
+    // Pipeline states cache
+    PipelineStateUsage = New<GPUPipelineStateUsageCache<GPUPipelineStateKeyDX12>>();
+    PipelineStateUsage->Load(GetPipelineCachePath(TEXT("DX12PipelineUsage.cache")));
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    {
+        ComPtr<ID3D12Device1> device1;
+        if (SUCCEEDED(_device->QueryInterface(IID_PPV_ARGS(&device1))))
+        {
+            const String path = GetPipelineCachePath(TEXT("DX12Pipeline.cache"));
+            if (FileSystem::FileExists(path))
+            {
+                LOG(Info, "Trying to load DirectX 12 pipeline library file {0}", path);
+                File::ReadAllBytes(path, _pipelineLibraryData);
+            }
+            HRESULT result = E_FAIL;
+            if (_pipelineLibraryData.HasItems())
+                result = device1->CreatePipelineLibrary(_pipelineLibraryData.Get(), _pipelineLibraryData.Count(), IID_PPV_ARGS(&_pipelineLibrary));
+            if (FAILED(result))
+            {
+                // Start with an empty library if the cached one cannot be used (eg. after driver update)
+                _pipelineLibraryData.Resize(0);
+                result = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&_pipelineLibrary));
+                if (FAILED(result))
+                {
+                    LOG(Warning, "DirectX 12 pipeline library is not supported.");
+                    _pipelineLibrary = nullptr;
+                }
+            }
+        }
+    }
+#endif
+
     // Upload buffer
     UploadBuffer = New<UploadBufferDX12>(this);
+    CopyUploadBuffer = New<UploadBufferDX12>(this);
 
-    if (TimestampQueryHeap.Init())
+    if (TimestampQueryHeap.Init() || PipelineStatsQueryHeap.Init())
         return true;
 
     // Cached command signatures
@@ -651,6 +733,10 @@ bool GPUDeviceDX12::Init()
         DispatchIndirectCommandSignature->Finalize();
     }
 
+    // Prepare async compute and copy contexts for the commands recording
+    _computeContext->Reset();
+    _copyContext->Reset();
+
     _state = DeviceState::Ready;
     return GPUDeviceDX::Init();
 }
@@ -661,6 +747,10 @@ void GPUDeviceDX12::DrawBegin()
         PROFILE_CPU_NAMED("Wait For GPU");
         //_commandQueue->WaitForGPU();
         _commandQueue->WaitForFence(_mainContext->FrameFenceValues[1]);
+        _computeQueue->WaitForFence(_computeContext->FrameFenceValues[1]);
+        _computeContext->FrameFenceValues[1] = _computeContext->FrameFenceValues[0];
+        _copyQueue->WaitForFence(_copyContext->FrameFenceValues[1]);
+        _copyContext->FrameFenceValues[1] = _copyContext->FrameFenceValues[0];
     }
 
     // Base
@@ -668,6 +758,7 @@ void GPUDeviceDX12::DrawBegin()
 
     updateRes2Dispose();
     UploadBuffer->BeginGeneration(Engine::FrameCount);
+    CopyUploadBuffer->BeginGeneration(Engine::FrameCount);
 }
 
 void GPUDeviceDX12::RenderEnd()
@@ -675,8 +766,9 @@ void GPUDeviceDX12::RenderEnd()
     // Base
     GPUDeviceDX::RenderEnd();
 
-    // Resolve the timestamp queries
+    // Resolve the timestamp and pipeline statistics queries
     TimestampQueryHeap.EndQueryBatchAndResolveQueryData(_mainContext);
+    PipelineStatsQueryHeap.EndQueryBatchAndResolveQueryData(_mainContext);
 }
 
 GPUDeviceDX12::~GPUDeviceDX12()
@@ -725,11 +817,34 @@ void GPUDeviceDX12::Dispose()
     // Release all late dispose resources (if state is Disposing all are released)
     updateRes2Dispose();
 
+    // Save pipeline states cache
+    if (PipelineStateUsage)
+    {
+        PipelineStateUsage->Save(GetPipelineCachePath(TEXT("DX12PipelineUsage.cache")));
+        SAFE_DELETE(PipelineStateUsage);
+    }
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    if (_pipelineLibrary)
+    {
+        if (_pipelineLibraryDirty)
+        {
+            Array<byte> data;
+            data.Resize((int32)_pipelineLibrary->GetSerializedSize());
+            if (SUCCEEDED(_pipelineLibrary->Serialize(data.Get(), data.Count())))
+                File::WriteAllBytes(GetPipelineCachePath(TEXT("DX12Pipeline.cache")), data);
+            _pipelineLibraryDirty = false;
+        }
+        SAFE_RELEASE(_pipelineLibrary);
+    }
+    _pipelineLibraryData.Resize(0);
+#endif
+
     // Clear pipeline objects
     for (auto& srv : _nullSrv)
         srv.Release();
     _nullUav.Release();
     TimestampQueryHeap.Destroy();
+    PipelineStatsQueryHeap.Destroy();
     DX_SAFE_RELEASE_CHECK(_rootSignature, 0);
     Heap_CBV_SRV_UAV.ReleaseGPU();
     Heap_RTV.ReleaseGPU();
@@ -738,8 +853,13 @@ void GPUDeviceDX12::Dispose()
     RingHeap_CBV_SRV_UAV.ReleaseGPU();
     RingHeap_Sampler.ReleaseGPU();
     SAFE_DELETE(UploadBuffer);
+    SAFE_DELETE(CopyUploadBuffer);
     SAFE_DELETE(DrawIndirectCommandSignature);
+    SAFE_DELETE(_copyContext);
+    SAFE_DELETE(_computeContext);
     SAFE_DELETE(_mainContext);
+    SAFE_DELETE(_copyQueue);
+    SAFE_DELETE(_computeQueue);
     SAFE_DELETE(_commandQueue);
 
     // Clear DirectX stuff
@@ -754,9 +874,35 @@ void GPUDeviceDX12::Dispose()
     _state = DeviceState::Disposed;
 }
 
+ID3D12PipelineState* GPUDeviceDX12::CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint32 descHash, uint32 keyHash)
+{
+    ID3D12PipelineState* state = nullptr;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    const String name = String::Format(TEXT("{0:x}_{1:x}"), descHash, keyHash);
+    if (_pipelineLibrary && SUCCEEDED(_pipelineLibrary->LoadGraphicsPipeline(*name, &desc, IID_PPV_ARGS(&state))))
+        return state;
+#endif
+
+    const HRESULT result = _device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&state));
+    LOG_DIRECTX_RESULT(result);
+    if (FAILED(result))
+        return nullptr;
+
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    // Store in the library for the next runs (fails if pipeline with the same name already exists, eg. description hash collision)
+    if (_pipelineLibrary && SUCCEEDED(_pipelineLibrary->StorePipeline(*name, state)))
+        _pipelineLibraryDirty = true;
+#endif
+    return state;
+}
+
 void GPUDeviceDX12::WaitForGPU()
 {
     _commandQueue->WaitForGPU();
+    if (_computeQueue)
+        _computeQueue->WaitForGPU();
+    if (_copyQueue)
+        _copyQueue->WaitForGPU();
 }
 
 GPUTexture* GPUDeviceDX12::CreateTexture(const StringView& name)
@@ -779,6 +925,11 @@ GPUTimerQuery* GPUDeviceDX12::CreateTimerQuery()
     return New<GPUTimerQueryDX12>(this);
 }
 
+GPUPipelineStatsQuery* GPUDeviceDX12::CreatePipelineStatsQuery()
+{
+    return New<GPUPipelineStatsQueryDX12>(this);
+}
+
 GPUBuffer* GPUDeviceDX12::CreateBuffer(const StringView& name)
 {
     return New<GPUBufferDX12>(this, name);
@@ -17,10 +17,17 @@
 #define DX12_BACK_BUFFER_COUNT 2
 #endif
 
+#if PLATFORM_WINDOWS
+#define DX12_ENABLE_PIPELINE_LIBRARY 1
+#else
+#define DX12_ENABLE_PIPELINE_LIBRARY 0
+#endif
+
 #define DX12_ROOT_SIGNATURE_CB 0
 #define DX12_ROOT_SIGNATURE_SR (GPU_MAX_CB_BINDED+0)
 #define DX12_ROOT_SIGNATURE_UA (GPU_MAX_CB_BINDED+1)
 #define DX12_ROOT_SIGNATURE_SAMPLER (GPU_MAX_CB_BINDED+2)
+#define DX12_ROOT_SIGNATURE_PUSH_CONSTANTS (GPU_MAX_CB_BINDED+3)
 
 class Engine;
 class WindowsWindow;
@@ -29,6 +36,9 @@ class GPUSwapChainDX12;
 class UploadBufferDX12;
 class CommandQueueDX12;
 class CommandSignatureDX12;
+struct GPUPipelineStateKeyDX12;
+template<typename KeyType>
+class GPUPipelineStateUsageCache;
 
 /// <summary>
 /// Implementation of Graphics Device for DirectX 12 rendering system
@@ -57,7 +67,16 @@ class GPUDeviceDX12 : public GPUDeviceDX
     // Pipeline
     ID3D12RootSignature* _rootSignature;
     CommandQueueDX12* _commandQueue;
+    CommandQueueDX12* _computeQueue;
+    CommandQueueDX12* _copyQueue;
     GPUContextDX12* _mainContext;
+    GPUContextDX12* _computeContext;
+    GPUContextDX12* _copyContext;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    ID3D12PipelineLibrary* _pipelineLibrary = nullptr;
+    Array<byte> _pipelineLibraryData;
+    bool _pipelineLibraryDirty = false;
+#endif
 
     // Heaps
     DescriptorHeapWithSlotsDX12::Slot _nullSrv[D3D12_SRV_DIMENSION_TEXTURECUBEARRAY + 1];
@@ -76,16 +95,31 @@ class GPUDeviceDX12 : public GPUDeviceDX
     /// </summary>
     UploadBufferDX12* UploadBuffer;
 
+    /// <summary>
+    /// Upload buffer for the copy queue work (separate staging ring so the copy command lists don't share pages with the graphics queue)
+    /// </summary>
+    UploadBufferDX12* CopyUploadBuffer;
+
     /// <summary>
     /// The timestamp queries heap.
     /// </summary>
     QueryHeapDX12 TimestampQueryHeap;
 
+    /// <summary>
+    /// The pipeline statistics queries heap.
+    /// </summary>
+    QueryHeapDX12 PipelineStatsQueryHeap;
+
     bool AllowTearing = false;
     CommandSignatureDX12* DispatchIndirectCommandSignature = nullptr;
     CommandSignatureDX12* DrawIndexedIndirectCommandSignature = nullptr;
     CommandSignatureDX12* DrawIndirectCommandSignature = nullptr;
 
+    /// <summary>
+    /// The pipeline state variants used by the application (persistent across runs). Used to precompile pipeline states on load.
+    /// </summary>
+    GPUPipelineStateUsageCache<GPUPipelineStateKeyDX12>* PipelineStateUsage = nullptr;
+
     D3D12_CPU_DESCRIPTOR_HANDLE NullSRV(D3D12_SRV_DIMENSION dimension) const;
     D3D12_CPU_DESCRIPTOR_HANDLE NullUAV() const;
 
@@ -120,6 +154,22 @@ class GPUDeviceDX12 : public GPUDeviceDX
         return _commandQueue;
     }
 
+    /// <summary>
+    /// Gets async compute command queue.
+    /// </summary>
+    FORCE_INLINE CommandQueueDX12* GetComputeQueue() const
+    {
+        return _computeQueue;
+    }
+
+    /// <summary>
+    /// Gets copy command queue.
+    /// </summary>
+    FORCE_INLINE CommandQueueDX12* GetCopyQueue() const
+    {
+        return _copyQueue;
+    }
+
     /// <summary>
     /// Gets DirectX 12 command queue object.
     /// </summary>
@@ -150,8 +200,20 @@ class GPUDeviceDX12 : public GPUDeviceDX
     DescriptorHeapRingBufferDX12 RingHeap_CBV_SRV_UAV;
     DescriptorHeapRingBufferDX12 RingHeap_Sampler;
 
+    // The version of the shader resource descriptors (incremented on every SRV descriptor create or release). Used to invalidate cached descriptor tables.
+    volatile int64 DescriptorsVersion = 0;
+
 public:
 
+    /// <summary>
+    /// Creates the graphics pipeline state object. Uses the persistent pipeline library (if supported) to skip the shaders compilation by the driver for pipelines created in the previous runs.
+    /// </summary>
+    /// <param name="desc">The pipeline state description.</param>
+    /// <param name="descHash">The pipeline state description hash (stable across runs).</param>
+    /// <param name="keyHash">The pipeline state variant key hash (stable across runs).</param>
+    /// <returns>The created pipeline state object or null if failed.</returns>
+    ID3D12PipelineState* CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint32 descHash, uint32 keyHash);
+
     // Add resource to late release service (will be released after 'safeFrameCount' frames)
     void AddResourceToLateRelease(IGraphicsUnknown* resource, uint32 safeFrameCount = DX12_RESOURCE_DELETE_SAFE_FRAMES_COUNT);
 
@@ -181,6 +243,14 @@ class GPUDeviceDX12 : public GPUDeviceDX
     {
         return reinterpret_cast<GPUContext*>(_mainContext);
     }
+    GPUContext* GetComputeContext() override
+    {
+        return reinterpret_cast<GPUContext*>(_computeContext);
+    }
+    GPUContext* GetCopyContext() override
+    {
+        return reinterpret_cast<GPUContext*>(_copyContext);
+    }
     void* GetNativePtr() const override
     {
         return _device;
@@ -194,6 +264,7 @@ class GPUDeviceDX12 : public GPUDeviceDX
     GPUShader* CreateShader(const StringView& name) override;
     GPUPipelineState* CreatePipelineState() override;
     GPUTimerQuery* CreateTimerQuery() override;
+    GPUPipelineStatsQuery* CreatePipelineStatsQuery() override;
     GPUBuffer* CreateBuffer(const StringView& name) override;
     GPUSampler* CreateSampler() override;
     GPUSwapChain* CreateSwapChain(Window* window) override;
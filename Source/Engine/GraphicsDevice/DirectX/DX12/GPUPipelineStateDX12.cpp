@@ -8,6 +8,7 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/GraphicsDevice/DirectX/RenderToolsDX.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
+#include "Engine/Graphics/GPUPipelineStateUsageCache.h"
 
 GPUPipelineStateDX12::GPUPipelineStateDX12(GPUDeviceDX12* device)
     : GPUResourceDX12(device, StringView::Empty)
@@ -35,6 +36,11 @@ ID3D12PipelineState* GPUPipelineStateDX12::GetState(GPUTextureViewDX12* depth, i
     for (int32 i = rtCount; i < GPU_MAX_RT_BINDED; i++)
         key.RTVsFormats[i] = PixelFormat::Unknown;
 
+    return GetState(key);
+}
+
+ID3D12PipelineState* GPUPipelineStateDX12::GetState(const GPUPipelineStateKeyDX12& key)
+{
     // Try reuse cached version
     ID3D12PipelineState* state = nullptr;
     if (_states.TryGet(key, state))
@@ -60,9 +66,8 @@ ID3D12PipelineState* GPUPipelineStateDX12::GetState(GPUTextureViewDX12* depth, i
     _desc.DSVFormat = RenderToolsDX::ToDxgiFormat(PixelFormatExtensions::FindDepthStencilFormat(key.DepthFormat));
 
     // Create object
-    const HRESULT result = _device->GetDevice()->CreateGraphicsPipelineState(&_desc, IID_PPV_ARGS(&state));
-    LOG_DIRECTX_RESULT(result);
-    if (FAILED(result))
+    state = _device->CreateGraphicsPipelineState(_desc, _descHash, GetHash(key));
+    if (state == nullptr)
         return nullptr;
 #if GPU_ENABLE_RESOURCE_NAMING && BUILD_DEBUG
     char name[200];
@@ -105,6 +110,7 @@ ID3D12PipelineState* GPUPipelineStateDX12::GetState(GPUTextureViewDX12* depth, i
 
     // Cache it
     _states.Add(key, state);
+    _device->PipelineStateUsage->Add(_descHash, key);
 
     return state;
 }
@@ -230,7 +236,19 @@ bool GPUPipelineStateDX12::Init(const Description& desc)
     // Set non-zero memory usage
     _memoryUsage = sizeof(D3D12_GRAPHICS_PIPELINE_STATE_DESC);
 
-    return GPUPipelineState::Init(desc);
+    if (GPUPipelineState::Init(desc))
+        return true;
+
+    // Precompile the pipeline state variants used in the previous runs (to prevent hitches on the first draw)
+    Array<GPUPipelineStateKeyDX12> keys;
+    if (_device->PipelineStateUsage->TryGet(_descHash, keys))
+    {
+        PROFILE_CPU_NAMED("Precompile Pipeline State");
+        for (const GPUPipelineStateKeyDX12& key : keys)
+            GetState(key);
+    }
+
+    return false;
 }
 
 #endif
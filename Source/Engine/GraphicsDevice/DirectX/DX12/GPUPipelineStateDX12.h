@@ -67,6 +67,10 @@ class GPUPipelineStateDX12 : public GPUResourceDX12<GPUPipelineState>
     /// <returns>DirectX 12 graphics pipeline state object</returns>
     ID3D12PipelineState* GetState(GPUTextureViewDX12* depth, int32 rtCount, GPUTextureViewDX12** rtHandles);
 
+private:
+
+    ID3D12PipelineState* GetState(const GPUPipelineStateKeyDX12& key);
+
 public:
 
     // [GPUPipelineState]
@@ -0,0 +1,70 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if GRAPHICS_API_DIRECTX12
+
+#include "GPUPipelineStatsQueryDX12.h"
+#include "GPUContextDX12.h"
+
+GPUPipelineStatsQueryDX12::GPUPipelineStatsQueryDX12(GPUDeviceDX12* device)
+    : GPUResourceDX12<GPUPipelineStatsQuery>(device, String::Empty)
+    , _handle(0)
+{
+    Platform::MemoryClear(&_stats, sizeof(_stats));
+}
+
+void GPUPipelineStatsQueryDX12::OnReleaseGPU()
+{
+    _hasResult = false;
+    _endCalled = false;
+}
+
+void GPUPipelineStatsQueryDX12::Begin()
+{
+    const auto context = _device->GetMainContextDX12();
+    auto& heap = _device->PipelineStatsQueryHeap;
+    heap.BeginQuery(context, _handle);
+
+    _hasResult = false;
+    _endCalled = false;
+}
+
+void GPUPipelineStatsQueryDX12::End()
+{
+    if (_endCalled)
+        return;
+
+    const auto context = _device->GetMainContextDX12();
+    auto& heap = _device->PipelineStatsQueryHeap;
+    heap.EndBeganQuery(context, _handle);
+
+    _endCalled = true;
+}
+
+bool GPUPipelineStatsQueryDX12::HasResult()
+{
+    if (!_endCalled)
+        return false;
+    if (_hasResult)
+        return true;
+
+    return _device->PipelineStatsQueryHeap.IsReady(_handle);
+}
+
+void GPUPipelineStatsQueryDX12::GetResult(GPUPipelineStats& result)
+{
+    if (!_hasResult)
+    {
+        const auto& data = *(D3D12_QUERY_DATA_PIPELINE_STATISTICS*)_device->PipelineStatsQueryHeap.ResolveQuery(_handle);
+        _stats.InputVertices = data.IAVertices;
+        _stats.InputPrimitives = data.IAPrimitives;
+        _stats.VertexShaderInvocations = data.VSInvocations;
+        _stats.PixelShaderInvocations = data.PSInvocations;
+        _stats.ComputeShaderInvocations = data.CSInvocations;
+        _stats.ClippingInvocations = data.CInvocations;
+        _stats.ClippingPrimitives = data.CPrimitives;
+        _hasResult = true;
+    }
+    result = _stats;
+}
+
+#endif
@@ -0,0 +1,40 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if GRAPHICS_API_DIRECTX12
+
+#include "Engine/Graphics/GPUPipelineStatsQuery.h"
+#include "GPUDeviceDX12.h"
+
+/// <summary>
+/// GPU pipeline statistics query object for DirectX 12 backend.
+/// </summary>
+class GPUPipelineStatsQueryDX12 : public GPUResourceDX12<GPUPipelineStatsQuery>
+{
+private:
+    bool _hasResult = false;
+    bool _endCalled = false;
+    GPUPipelineStats _stats;
+    QueryHeapDX12::ElementHandle _handle;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="GPUPipelineStatsQueryDX12"/> class.
+    /// </summary>
+    /// <param name="device">The graphics device.</param>
+    GPUPipelineStatsQueryDX12(GPUDeviceDX12* device);
+
+public:
+    // [GPUPipelineStatsQuery]
+    void Begin() override;
+    void End() override;
+    bool HasResult() override;
+    void GetResult(GPUPipelineStats& result) override;
+
+protected:
+    // [GPUResourceDX12]
+    void OnReleaseGPU() override;
+};
+
+#endif
@@ -180,10 +180,48 @@ bool GPUTextureDX12::OnInit()
     }
 
     if (IsRegularTexture())
-        initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    {
+        // Streamed textures are uploaded on the copy queue which requires the common state
+        initialState = _device->GetCopyQueue() ? D3D12_RESOURCE_STATE_COMMON : D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    }
 
     // Create texture
-    auto result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
+    HRESULT result;
+    if (_isAliasable)
+    {
+        // Place texture in the heap that can be shared with other render targets (memory aliasing)
+        const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+        if (_aliasingSource)
+        {
+            _heap = ((GPUTextureDX12*)_aliasingSource)->GetHeap();
+            if (!_heap || _heap->GetDesc().SizeInBytes < allocationInfo.SizeInBytes)
+            {
+                _heap = nullptr;
+                return true;
+            }
+            _heap->AddRef();
+        }
+        else
+        {
+            D3D12_HEAP_DESC heapDesc;
+            heapDesc.SizeInBytes = allocationInfo.SizeInBytes;
+            heapDesc.Properties = heapProperties;
+            heapDesc.Alignment = allocationInfo.Alignment;
+            heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+            result = device->CreateHeap(&heapDesc, IID_PPV_ARGS(&_heap));
+            LOG_DIRECTX_RESULT_WITH_RETURN(result);
+        }
+        result = device->CreatePlacedResource(_heap, 0, &resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
+        if (FAILED(result))
+        {
+            _heap->Release();
+            _heap = nullptr;
+        }
+    }
+    else
+    {
+        result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
+    }
     LOG_DIRECTX_RESULT_WITH_RETURN(result);
 
     // Set state
@@ -191,7 +229,12 @@ bool GPUTextureDX12::OnInit()
     bool isWrite = useDSV || useRTV || useUAV;
     initResource(resource, initialState, resourceDesc, isRead && isWrite);
     DX_SET_DEBUG_NAME(_resource, GetName());
-    _memoryUsage = calculateMemoryUsage();
+    if (_aliasingSource)
+        _memoryUsage = 0; // Memory is owned by the aliasing source
+    else if (_heap)
+        _memoryUsage = _heap->GetDesc().SizeInBytes;
+    else
+        _memoryUsage = calculateMemoryUsage();
 
     // Initialize handles to the resource
     if (IsRegularTexture())
@@ -252,6 +295,11 @@ void GPUTextureDX12::OnReleaseGPU()
     _srv.Release();
     _uav.Release();
     releaseResource();
+    if (_heap)
+    {
+        _device->AddResourceToLateRelease(_heap);
+        _heap = nullptr;
+    }
 
     // Base
     GPUTexture::OnReleaseGPU();
@@ -139,6 +139,7 @@ class GPUTextureDX12 : public GPUResourceDX12<GPUTexture>, public ResourceOwnerD
 
     DescriptorHeapWithSlotsDX12::Slot _srv;
     DescriptorHeapWithSlotsDX12::Slot _uav;
+    ID3D12Heap* _heap = nullptr;
 
     DXGI_FORMAT _dxgiFormatDSV;
     DXGI_FORMAT _dxgiFormatSRV;
@@ -156,6 +157,16 @@ class GPUTextureDX12 : public GPUResourceDX12<GPUTexture>, public ResourceOwnerD
 
     void initHandles();
 
+public:
+
+    /// <summary>
+    /// Gets the memory heap used by the aliasable texture (null if texture uses committed resource).
+    /// </summary>
+    FORCE_INLINE ID3D12Heap* GetHeap() const
+    {
+        return _heap;
+    }
+
 public:
 
     // [GPUTexture]
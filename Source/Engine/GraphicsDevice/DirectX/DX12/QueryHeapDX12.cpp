@@ -25,6 +25,11 @@ QueryHeapDX12::QueryHeapDX12(GPUDeviceDX12* device, const D3D12_QUERY_HEAP_TYPE&
         _resultSize = sizeof(uint64);
         _queryType = D3D12_QUERY_TYPE_TIMESTAMP;
     }
+    else if (queryHeapType == D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS)
+    {
+        _resultSize = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+        _queryType = D3D12_QUERY_TYPE_PIPELINE_STATISTICS;
+    }
     else
     {
         MISSING_CODE("Not support D3D12 query heap type.");
@@ -131,6 +136,11 @@ void QueryHeapDX12::EndQuery(GPUContextDX12* context, ElementHandle& handle)
     context->GetCommandList()->EndQuery(_queryHeap, _queryType, handle);
 }
 
+void QueryHeapDX12::EndBeganQuery(GPUContextDX12* context, const ElementHandle& handle)
+{
+    context->GetCommandList()->EndQuery(_queryHeap, _queryType, handle);
+}
+
 bool QueryHeapDX12::IsReady(ElementHandle& handle)
 {
     // Current batch is not ready (not ended)
@@ -164,6 +164,13 @@ class QueryHeapDX12
     /// <param name="handle">The query handle.</param>
     void EndQuery(GPUContextDX12* context, ElementHandle& handle);
 
+    /// <summary>
+    /// Calls EndQuery on command list for the query heap slot allocated by BeginQuery (used by the queries that measure the range of commands, eg. pipeline statistics).
+    /// </summary>
+    /// <param name="context">The context.</param>
+    /// <param name="handle">The query handle returned by BeginQuery.</param>
+    void EndBeganQuery(GPUContextDX12* context, const ElementHandle& handle);
+
     /// <summary>
     /// Determines whether the specified query handle is ready to read data (command list has been executed by the GPU).
     /// </summary>
@@ -128,6 +128,10 @@ class GPUContextNull : public GPUContext
     {
     }
 
+    void SetPushConstants(const void* data, uint32 size) override
+    {
+    }
+
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override
     {
     }
@@ -164,6 +168,14 @@ class GPUContextNull : public GPUContext
     {
     }
 
+    void SetShadingRate(GPUShadingRate rate) override
+    {
+    }
+
+    void SetShadingRateImage(GPUTexture* image) override
+    {
+    }
+
     GPUPipelineState* GetState() const override
     {
         return nullptr;
@@ -62,6 +62,13 @@ bool GPUDeviceNull::Init()
         limits.HasReadOnlyDepth = false;
         limits.HasMultisampleDepthAsSRV = false;
         limits.HasTypedUAVLoad = false;
+        limits.HasAsyncCompute = false;
+        limits.HasCopyQueue = false;
+        limits.HasResourceAliasing = false;
+        limits.HasVariableRateShading = false;
+        limits.HasVariableRateShadingImage = false;
+        limits.HasVariableRateShadingLargeRates = false;
+        limits.VariableRateShadingTileSize = 0;
         limits.MaximumMipLevelsCount = 14;
         limits.MaximumTexture1DSize = 8192;
         limits.MaximumTexture1DArraySize = 512;
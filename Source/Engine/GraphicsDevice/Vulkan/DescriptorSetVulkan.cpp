@@ -291,6 +291,7 @@ TypedDescriptorPoolSetVulkan* DescriptorPoolSetContainerVulkan::AcquireTypedPool
 
 void DescriptorPoolSetContainerVulkan::Reset()
 {
+    _resetCount++;
     for (auto i = _typedDescriptorPools.Begin(); i.IsNotEnd(); ++i)
     {
         TypedDescriptorPoolSetVulkan* typedPool = i->Value;
@@ -363,10 +364,18 @@ PipelineLayoutVulkan::PipelineLayoutVulkan(GPUDeviceVulkan* device, const Descri
 
     const auto& layoutHandles = _descriptorSetLayout.GetHandles();
 
+    // All layouts use the same push constants range so the data stays valid when switching between pipelines
+    VkPushConstantRange pushConstantRange;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_ALL;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = GPU_MAX_PUSH_CONSTANTS_SIZE;
+
     VkPipelineLayoutCreateInfo createInfo;
     RenderToolsVulkan::ZeroStruct(createInfo, VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO);
     createInfo.setLayoutCount = layoutHandles.Count();
     createInfo.pSetLayouts = layoutHandles.Get();
+    createInfo.pushConstantRangeCount = 1;
+    createInfo.pPushConstantRanges = &pushConstantRange;
     VALIDATE_VULKAN_RESULT(vkCreatePipelineLayout(_device->Device, &createInfo, nullptr, &_handle));
 }
 
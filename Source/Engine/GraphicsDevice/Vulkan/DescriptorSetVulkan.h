@@ -309,6 +309,7 @@ class DescriptorPoolSetContainerVulkan
     GPUDeviceVulkan* _device;
     Dictionary<uint32, TypedDescriptorPoolSetVulkan*> _typedDescriptorPools;
     uint64 _lastFrameUsed;
+    uint32 _resetCount = 0;
     bool _used;
 
 public:
@@ -332,6 +333,12 @@ class DescriptorPoolSetContainerVulkan
     {
         return _lastFrameUsed;
     }
+
+    // Gets the amount of the pools resets (descriptor sets allocated before the last reset are invalid).
+    uint32 GetResetCount() const
+    {
+        return _resetCount;
+    }
 };
 
 class DescriptorPoolsManagerVulkan
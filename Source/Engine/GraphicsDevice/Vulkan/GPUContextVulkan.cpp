@@ -128,6 +128,7 @@ GPUContextVulkan::GPUContextVulkan(GPUDeviceVulkan* device, QueueVulkan* queue)
     , _device(device)
     , _queue(queue)
     , _cmdBufferManager(New<CmdBufferManagerVulkan>(device, this))
+    , _pushConstantsSize(0)
 {
     // Setup descriptor handles tables lookup cache
     _handles[(int32)SpirvShaderResourceBindingType::INVALID] = nullptr;
@@ -589,8 +590,8 @@ void GPUContextVulkan::UpdateDescriptorSets(GPUPipelineStateVulkan* pipelineStat
         remainingHasDescriptorsPerStageMask >>= 1;
     }
 
-    // Allocate sets if need to
-    //if (needsWrite) // TODO: write on change only?
+    // Allocate sets only if any descriptor has changed (otherwise reuse the sets written before within the current pool set)
+    if (needsWrite)
     {
         if (!pipelineState->AllocateDescriptorSets())
         {
@@ -629,8 +630,8 @@ void GPUContextVulkan::UpdateDescriptorSets(ComputePipelineStateVulkan* pipeline
     // Update descriptors
     UpdateDescriptorSets(*pipelineState->DescriptorInfo, pipelineState->DSWriter, needsWrite);
 
-    // Allocate sets if need to
-    //if (needsWrite) // TODO: write on change only?f
+    // Allocate sets only if any descriptor has changed (otherwise reuse the sets written before within the current pool set)
+    if (needsWrite)
     {
         if (!pipelineState->AllocateDescriptorSets())
         {
@@ -659,6 +660,13 @@ void GPUContextVulkan::BindPipeline()
     }
 }
 
+void GPUContextVulkan::BindPushConstants(CmdBufferVulkan* cmdBuffer, PipelineLayoutVulkan* layout)
+{
+    // Push constants are small inline data so record them with every draw/dispatch once set (all pipeline layouts use the same range)
+    if (_pushConstantsSize)
+        vkCmdPushConstants(cmdBuffer->GetHandle(), layout->GetHandle(), VK_SHADER_STAGE_ALL, 0, _pushConstantsSize, _pushConstants);
+}
+
 void GPUContextVulkan::OnDrawCall()
 {
     GPUPipelineStateVulkan* pipelineState = _currentState;
@@ -699,6 +707,7 @@ void GPUContextVulkan::OnDrawCall()
     }
 
     BindPipeline();
+    BindPushConstants(cmdBuffer, pipelineLayout);
 
     //UpdateDynamicStates();
 
@@ -725,8 +734,10 @@ void GPUContextVulkan::FrameBegin()
     _psDirtyFlag = 0;
     _rtDirtyFlag = 0;
     _cbDirtyFlag = 0;
+    _isOverlapUA = 0;
     _rtCount = 0;
     _vbCount = 0;
+    _pushConstantsSize = 0;
     _renderPass = nullptr;
     _currentState = nullptr;
     _rtDepth = nullptr;
@@ -1087,6 +1098,13 @@ void GPUContextVulkan::UpdateCB(GPUConstantBuffer* cb, const void* data)
     }
 }
 
+void GPUContextVulkan::SetPushConstants(const void* data, uint32 size)
+{
+    ASSERT(data && size <= GPU_MAX_PUSH_CONSTANTS_SIZE && size % sizeof(uint32) == 0);
+    Platform::MemoryCopy(_pushConstants, data, size);
+    _pushConstantsSize = size;
+}
+
 void GPUContextVulkan::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ)
 {
     ASSERT(shader);
@@ -1109,14 +1127,15 @@ void GPUContextVulkan::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCo
 
     // Bind descriptors sets to the compute pipeline
     pipelineState->Bind(cmdBuffer);
+    BindPushConstants(cmdBuffer, pipelineState->GetLayout());
 
     // Dispatch
     vkCmdDispatch(cmdBuffer->GetHandle(), threadGroupCountX, threadGroupCountY, threadGroupCountZ);
     RENDER_STAT_DISPATCH_CALL();
 
-    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes
-    // TODO: optimize it by moving inputs/outputs into higher-layer so eg. Global SDF can manually optimize it
-    vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes (skipped within overlap region or if shader doesn't write to any UAV)
+    if (!_isOverlapUA && shader->GetBindings().UsedUAsMask != 0)
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
 
 #if VK_ENABLE_BARRIERS_DEBUG
     LOG(Warning, "Dispatch");
@@ -1147,20 +1166,34 @@ void GPUContextVulkan::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* b
 
     // Bind descriptors sets to the compute pipeline
     pipelineState->Bind(cmdBuffer);
+    BindPushConstants(cmdBuffer, pipelineState->GetLayout());
 
     // Dispatch
     vkCmdDispatchIndirect(cmdBuffer->GetHandle(), bufferForArgsVulkan->GetHandle(), offsetForArgs);
     RENDER_STAT_DISPATCH_CALL();
 
-    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes
-    // TODO: optimize it by moving inputs/outputs into higher-layer so eg. Global SDF can manually optimize it
-    vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes (skipped within overlap region or if shader doesn't write to any UAV)
+    if (!_isOverlapUA && shader->GetBindings().UsedUAsMask != 0)
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
 
 #if VK_ENABLE_BARRIERS_DEBUG
     LOG(Warning, "DispatchIndirect");
 #endif
 }
 
+void GPUContextVulkan::OverlapUA(bool end)
+{
+    _isOverlapUA = !end;
+    if (end)
+    {
+        // Synchronize all dispatches from the overlap region
+        const auto cmdBuffer = _cmdBufferManager->GetCmdBuffer();
+        if (cmdBuffer->IsInsideRenderPass())
+            EndRenderPass();
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    }
+}
+
 void GPUContextVulkan::ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format)
 {
     ASSERT(sourceMultisampleTexture && sourceMultisampleTexture->IsMultiSample());
@@ -1256,6 +1289,16 @@ void GPUContextVulkan::SetScissor(const Rectangle& scissorRect)
     vkCmdSetScissor(_cmdBufferManager->GetCmdBuffer()->GetHandle(), 0, 1, &rect);
 }
 
+void GPUContextVulkan::SetShadingRate(GPUShadingRate rate)
+{
+    // Not supported by Vulkan backend (VK_KHR_fragment_shading_rate is not used so GPULimits::HasVariableRateShading is false)
+}
+
+void GPUContextVulkan::SetShadingRateImage(GPUTexture* image)
+{
+    // Not supported by Vulkan backend (render passes don't use fragment shading rate attachment so GPULimits::HasVariableRateShadingImage is false)
+}
+
 GPUPipelineState* GPUContextVulkan::GetState() const
 {
     return _currentState;
@@ -1304,6 +1347,27 @@ void GPUContextVulkan::Flush()
     ASSERT(_cmdBufferManager->HasPendingActiveCmdBuffer() && _cmdBufferManager->GetActiveCmdBuffer()->GetState() == CmdBufferVulkan::State::IsInsideBegin);
 }
 
+void GPUContextVulkan::AliasTexture(GPUTexture* texture)
+{
+    const auto textureVulkan = static_cast<GPUTextureVulkan*>(texture);
+    if (!textureVulkan || textureVulkan->GetHandle() == VK_NULL_HANDLE)
+        return;
+    const auto cmdBuffer = _cmdBufferManager->GetCmdBuffer();
+    if (cmdBuffer->IsInsideRenderPass())
+        EndRenderPass();
+    FlushBarriers();
+
+    // Wait for the previous usage of the memory by other images
+    VkMemoryBarrier barrier;
+    RenderToolsVulkan::ZeroStruct(barrier, VK_STRUCTURE_TYPE_MEMORY_BARRIER);
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    // Discard contents (the next layout transition starts from the undefined layout)
+    textureVulkan->State.SetResourceState(VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
 void GPUContextVulkan::UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset)
 {
     ASSERT(data);
@@ -1445,11 +1509,11 @@ void GPUContextVulkan::CopyTexture(GPUTexture* dstResource, uint32 dstSubresourc
     region.srcSubresource.baseArrayLayer = srcArrayIndex;
     region.srcSubresource.layerCount = 1;
     region.srcSubresource.mipLevel = srcMipIndex;
-    region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.srcSubresource.aspectMask = srcTextureVulkan->DefaultAspectMask;
     region.dstSubresource.baseArrayLayer = dstArrayIndex;
     region.dstSubresource.layerCount = 1;
     region.dstSubresource.mipLevel = dstMipIndex;
-    region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.dstSubresource.aspectMask = dstTextureVulkan->DefaultAspectMask;
     vkCmdCopyImage(cmdBuffer->GetHandle(), srcTextureVulkan->GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstTextureVulkan->GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
@@ -1602,12 +1666,12 @@ void GPUContextVulkan::CopyResource(GPUResource* dstResource, GPUResource* srcRe
                 region.srcSubresource.baseArrayLayer = 0;
                 region.srcSubresource.layerCount = arraySize;
                 region.srcSubresource.mipLevel = mipLevel;
-                region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.srcSubresource.aspectMask = srcTextureVulkan->DefaultAspectMask;
                 region.dstOffset = { 0, 0, 0 };
                 region.dstSubresource.baseArrayLayer = 0;
                 region.dstSubresource.layerCount = arraySize;
                 region.dstSubresource.mipLevel = mipLevel;
-                region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.dstSubresource.aspectMask = dstTextureVulkan->DefaultAspectMask;
 
                 if (mipWidth != 1)
                     mipWidth >>= 1;
@@ -94,9 +94,11 @@ class GPUContextVulkan : public GPUContext
     int32 _psDirtyFlag : 1;
     int32 _rtDirtyFlag : 1;
     int32 _cbDirtyFlag : 1;
+    int32 _isOverlapUA : 1;
 
     int32 _rtCount;
     int32 _vbCount;
+    uint32 _pushConstantsSize;
 
     RenderPassVulkan* _renderPass;
     GPUPipelineStateVulkan* _currentState;
@@ -106,6 +108,7 @@ class GPUContextVulkan : public GPUContext
     DescriptorOwnerResourceVulkan* _srHandles[GPU_MAX_SR_BINDED];
     DescriptorOwnerResourceVulkan* _uaHandles[GPU_MAX_UA_BINDED];
     VkSampler _samplerHandles[GPU_MAX_SAMPLER_BINDED];
+    uint32 _pushConstants[GPU_MAX_PUSH_CONSTANTS_SIZE / sizeof(uint32)];
     DescriptorOwnerResourceVulkan** _handles[(int32)SpirvShaderResourceBindingType::MAX];
 #if ENABLE_ASSERTION
     uint32 _handlesSizes[(int32)SpirvShaderResourceBindingType::MAX];
@@ -161,6 +164,7 @@ class GPUContextVulkan : public GPUContext
     void UpdateDescriptorSets(GPUPipelineStateVulkan* pipelineState);
     void UpdateDescriptorSets(ComputePipelineStateVulkan* pipelineState);
     void BindPipeline();
+    void BindPushConstants(CmdBufferVulkan* cmdBuffer, PipelineLayoutVulkan* layout);
     void OnDrawCall();
 
 public:
@@ -195,8 +199,10 @@ class GPUContextVulkan : public GPUContext
     void BindIB(GPUBuffer* indexBuffer) override;
     void BindSampler(int32 slot, GPUSampler* sampler) override;
     void UpdateCB(GPUConstantBuffer* cb, const void* data) override;
+    void SetPushConstants(const void* data, uint32 size) override;
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override;
     void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
+    void OverlapUA(bool end) override;
     void ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format) override;
     void DrawInstanced(uint32 verticesCount, uint32 instanceCount, int32 startInstance, int32 startVertex) override;
     void DrawIndexedInstanced(uint32 indicesCount, uint32 instanceCount, int32 startInstance, int32 startVertex, int32 startIndex) override;
@@ -204,11 +210,14 @@ class GPUContextVulkan : public GPUContext
     void DrawIndexedInstancedIndirect(GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
     void SetViewport(const Viewport& viewport) override;
     void SetScissor(const Rectangle& scissorRect) override;
+    void SetShadingRate(GPUShadingRate rate) override;
+    void SetShadingRateImage(GPUTexture* image) override;
     GPUPipelineState* GetState() const override;
     void SetState(GPUPipelineState* state) override;
     void ClearState() override;
     void FlushState() override;
     void Flush() override;
+    void AliasTexture(GPUTexture* texture) override;
     void UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset) override;
     void CopyBuffer(GPUBuffer* dstBuffer, GPUBuffer* srcBuffer, uint32 size, uint32 dstOffset, uint32 srcOffset) override;
     void UpdateTexture(GPUTexture* texture, int32 arrayIndex, int32 mipIndex, const void* data, uint32 rowPitch, uint32 slicePitch) override;
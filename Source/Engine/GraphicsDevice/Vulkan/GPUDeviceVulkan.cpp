@@ -1243,6 +1243,7 @@ GPUDeviceVulkan::~GPUDeviceVulkan()
 
 RenderPassVulkan* GPUDeviceVulkan::GetOrCreateRenderPass(RenderTargetLayoutVulkan& layout)
 {
+    ScopeLock lock(_cacheLocker);
     RenderPassVulkan* renderPass;
     if (_renderPasses.TryGet(layout, renderPass))
         return renderPass;
@@ -1267,6 +1268,7 @@ FramebufferVulkan* GPUDeviceVulkan::GetOrCreateFramebuffer(FramebufferVulkan::Ke
 
 PipelineLayoutVulkan* GPUDeviceVulkan::GetOrCreateLayout(DescriptorSetLayoutInfoVulkan& key)
 {
+    ScopeLock lock(_cacheLocker);
     PipelineLayoutVulkan* layout;
     if (_layouts.TryGet(key, layout))
         return layout;
@@ -1399,6 +1401,15 @@ void GetPipelineCachePath(String& path)
 #endif
 }
 
+void GetPipelineUsageCachePath(String& path)
+{
+#if USE_EDITOR
+    path = Globals::ProjectCacheFolder / TEXT("VulkanPipelineUsage.cache");
+#else
+    path = Globals::ProductLocalFolder / TEXT("VulkanPipelineUsage.cache");
+#endif
+}
+
 bool GPUDeviceVulkan::SavePipelineCache()
 {
     if (PipelineCache == VK_NULL_HANDLE || !vkGetPipelineCacheData)
@@ -1687,6 +1698,13 @@ bool GPUDeviceVulkan::Init()
         limits.HasReadOnlyDepth = true;
         limits.HasMultisampleDepthAsSRV = !!PhysicalDeviceFeatures.sampleRateShading;
         limits.HasTypedUAVLoad = true;
+        limits.HasAsyncCompute = false; // Not supported: all work goes to the graphics queue (resources use exclusive sharing mode so a compute queue would need queue family ownership transfers), GetComputeContext returns the main context
+        limits.HasCopyQueue = false; // Not supported: uploads go to the graphics queue (a transfer queue would need queue family ownership transfers for exclusive resources), GetCopyContext returns the main context
+        limits.HasResourceAliasing = true;
+        limits.HasVariableRateShading = false; // Not supported: VK_KHR_fragment_shading_rate is not enabled and GPUContextVulkan ignores the shading rate
+        limits.HasVariableRateShadingImage = false;
+        limits.HasVariableRateShadingLargeRates = false;
+        limits.VariableRateShadingTileSize = 0;
         limits.MaximumMipLevelsCount = Math::Min(static_cast<int32>(log2(PhysicalDeviceLimits.maxImageDimension2D)), GPU_MAX_TEXTURE_MIP_LEVELS);
         limits.MaximumTexture1DSize = PhysicalDeviceLimits.maxImageDimension1D;
         limits.MaximumTexture1DArraySize = PhysicalDeviceLimits.maxImageArrayLayers;
@@ -1859,6 +1877,11 @@ bool GPUDeviceVulkan::Init()
     UniformBufferUploader = New<UniformBufferUploaderVulkan>(this);
     DescriptorPoolsManager = New<DescriptorPoolsManagerVulkan>(this);
     MainContext = New<GPUContextVulkan>(this, GraphicsQueue);
+    {
+        String path;
+        GetPipelineUsageCachePath(path);
+        PipelineStateUsage.Load(path);
+    }
     if (vkCreatePipelineCache)
     {
         Array<uint8> data;
@@ -1978,6 +2001,12 @@ void GPUDeviceVulkan::Dispose()
         vkDestroyPipelineCache(Device, PipelineCache, nullptr);
         PipelineCache = VK_NULL_HANDLE;
     }
+    {
+        String path;
+        GetPipelineUsageCachePath(path);
+        if (PipelineStateUsage.Save(path))
+            LOG(Warning, "Failed to save Vulkan pipeline usage cache");
+    }
 #if VK_EXT_validation_cache
     if (ValidationCache != VK_NULL_HANDLE)
     {
@@ -6,6 +6,7 @@
 
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPUResource.h"
+#include "Engine/Graphics/GPUPipelineStateUsageCache.h"
 #include "DescriptorSetVulkan.h"
 #include "IncludeVulkanHeaders.h"
 #include "Config.h"
@@ -464,6 +465,7 @@ class GPUDeviceVulkan : public GPUDevice
     Dictionary<RenderTargetLayoutVulkan, RenderPassVulkan*> _renderPasses;
     Dictionary<FramebufferVulkan::Key, FramebufferVulkan*> _framebuffers;
     Dictionary<DescriptorSetLayoutInfoVulkan, PipelineLayoutVulkan*> _layouts;
+    CriticalSection _cacheLocker; // Protects render passes and layouts caches (pipeline states can be precompiled from content loading threads)
     // TODO: use mutex to protect those collections BUT use 2 pools per cache: one lock-free with lookup only and second protected with mutex synced on frame end!
 
 public:
@@ -589,6 +591,11 @@ class GPUDeviceVulkan : public GPUDevice
     /// </summary>
     VkPipelineCache PipelineCache = VK_NULL_HANDLE;
 
+    /// <summary>
+    /// The pipeline state variants (render pass layouts) used by the application (persistent across runs). Used to precompile pipeline states on load.
+    /// </summary>
+    GPUPipelineStateUsageCache<RenderTargetLayoutVulkan> PipelineStateUsage;
+
 #if VK_EXT_validation_cache
 
     /// <summary>
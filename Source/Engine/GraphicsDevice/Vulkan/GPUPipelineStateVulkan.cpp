@@ -174,6 +174,7 @@ VkPipeline GPUPipelineStateVulkan::GetState(RenderPassVulkan* renderPass)
 
     // Cache it
     _pipelines.Add(renderPass, pipeline);
+    _device->PipelineStateUsage.Add(_descHash, renderPass->Layout);
 
     return pipeline;
 }
@@ -386,7 +387,19 @@ bool GPUPipelineStateVulkan::Init(const Description& desc)
     // Set non-zero memory usage
     _memoryUsage = sizeof(VkGraphicsPipelineCreateInfo);
 
-    return GPUPipelineState::Init(desc);
+    if (GPUPipelineState::Init(desc))
+        return true;
+
+    // Precompile the pipeline state variants used in the previous runs (to prevent hitches on the first draw)
+    Array<RenderTargetLayoutVulkan> layouts;
+    if (_device->PipelineStateUsage.TryGet(_descHash, layouts))
+    {
+        PROFILE_CPU_NAMED("Precompile Pipeline State");
+        for (RenderTargetLayoutVulkan& layout : layouts)
+            GetState(_device->GetOrCreateRenderPass(layout));
+    }
+
+    return false;
 }
 
 #endif
@@ -46,16 +46,18 @@ class ComputePipelineStateVulkan
 
     const DescriptorSetLayoutVulkan* DescriptorSetsLayout = nullptr;
     TypedDescriptorPoolSetVulkan* CurrentTypedDescriptorPoolSet = nullptr;
+    uint32 CurrentTypedDescriptorPoolSetResetCount = 0;
     Array<VkDescriptorSet> DescriptorSetHandles;
 
     inline bool AcquirePoolSet(CmdBufferVulkan* cmdBuffer)
     {
         // Pipeline state has no current descriptor pools set or set owner is not current - acquire a new pool set
         DescriptorPoolSetContainerVulkan* cmdBufferPoolSet = cmdBuffer->GetDescriptorPoolSet();
-        if (CurrentTypedDescriptorPoolSet == nullptr || CurrentTypedDescriptorPoolSet->GetOwner() != cmdBufferPoolSet)
+        if (CurrentTypedDescriptorPoolSet == nullptr || CurrentTypedDescriptorPoolSet->GetOwner() != cmdBufferPoolSet || CurrentTypedDescriptorPoolSetResetCount != cmdBufferPoolSet->GetResetCount())
         {
             ASSERT(cmdBufferPoolSet);
             CurrentTypedDescriptorPoolSet = cmdBufferPoolSet->AcquireTypedPoolSet(*DescriptorSetsLayout);
+            CurrentTypedDescriptorPoolSetResetCount = cmdBufferPoolSet->GetResetCount();
             return true;
         }
 
@@ -162,16 +164,18 @@ class GPUPipelineStateVulkan : public GPUResourceVulkan<GPUPipelineState>
 
     const DescriptorSetLayoutVulkan* DescriptorSetsLayout = nullptr;
     TypedDescriptorPoolSetVulkan* CurrentTypedDescriptorPoolSet = nullptr;
+    uint32 CurrentTypedDescriptorPoolSetResetCount = 0;
     Array<VkDescriptorSet> DescriptorSetHandles;
 
     inline bool AcquirePoolSet(CmdBufferVulkan* cmdBuffer)
     {
         // Pipeline state has no current descriptor pools set or set owner is not current - acquire a new pool set
         DescriptorPoolSetContainerVulkan* cmdBufferPoolSet = cmdBuffer->GetDescriptorPoolSet();
-        if (CurrentTypedDescriptorPoolSet == nullptr || CurrentTypedDescriptorPoolSet->GetOwner() != cmdBufferPoolSet)
+        if (CurrentTypedDescriptorPoolSet == nullptr || CurrentTypedDescriptorPoolSet->GetOwner() != cmdBufferPoolSet || CurrentTypedDescriptorPoolSetResetCount != cmdBufferPoolSet->GetResetCount())
         {
             ASSERT(cmdBufferPoolSet);
             CurrentTypedDescriptorPoolSet = cmdBufferPoolSet->AcquireTypedPoolSet(*DescriptorSetsLayout);
+            CurrentTypedDescriptorPoolSetResetCount = cmdBufferPoolSet->GetResetCount();
             return true;
         }
 
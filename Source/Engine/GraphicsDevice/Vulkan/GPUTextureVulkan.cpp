@@ -281,10 +281,41 @@ bool GPUTextureVulkan::OnInit()
     // TODO: set initialLayout to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for IsRegularTexture() ???
 
     // Create texture
-    VmaAllocationCreateInfo allocInfo = {};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    const VkResult result = vmaCreateImage(_device->Allocator, &imageInfo, &allocInfo, &_image, &_allocation, nullptr);
-    LOG_VULKAN_RESULT_WITH_RETURN(result);
+    if (_aliasingSource)
+    {
+        // Place texture in the memory of the other render target (memory aliasing)
+        VmaAllocation sourceAllocation = ((GPUTextureVulkan*)_aliasingSource)->GetAllocation();
+        if (sourceAllocation == VK_NULL_HANDLE)
+            return true;
+        VmaAllocationInfo sourceAllocationInfo;
+        vmaGetAllocationInfo(_device->Allocator, sourceAllocation, &sourceAllocationInfo);
+        VkResult result = vkCreateImage(_device->Device, &imageInfo, nullptr, &_image);
+        LOG_VULKAN_RESULT_WITH_RETURN(result);
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(_device->Device, _image, &memoryRequirements);
+        if (memoryRequirements.size > sourceAllocationInfo.size ||
+            (memoryRequirements.memoryTypeBits & (1u << sourceAllocationInfo.memoryType)) == 0 ||
+            sourceAllocationInfo.offset % memoryRequirements.alignment != 0)
+        {
+            vkDestroyImage(_device->Device, _image, nullptr);
+            _image = VK_NULL_HANDLE;
+            return true;
+        }
+        result = vmaBindImageMemory(_device->Allocator, sourceAllocation, _image);
+        if (result != VK_SUCCESS)
+        {
+            vkDestroyImage(_device->Device, _image, nullptr);
+            _image = VK_NULL_HANDLE;
+        }
+        LOG_VULKAN_RESULT_WITH_RETURN(result);
+    }
+    else
+    {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        const VkResult result = vmaCreateImage(_device->Allocator, &imageInfo, &allocInfo, &_image, &_allocation, nullptr);
+        LOG_VULKAN_RESULT_WITH_RETURN(result);
+    }
 #if GPU_ENABLE_RESOURCE_NAMING
     VK_SET_DEBUG_NAME(_device, _image, VK_OBJECT_TYPE_IMAGE, GetName());
 #endif
@@ -292,7 +323,20 @@ bool GPUTextureVulkan::OnInit()
 
     // Set state
     initResource(VK_IMAGE_LAYOUT_UNDEFINED, _desc.MipLevels, _desc.ArraySize, true);
-    _memoryUsage = calculateMemoryUsage();
+    if (_aliasingSource)
+    {
+        _memoryUsage = 0; // Memory is owned by the aliasing source
+    }
+    else if (_isAliasable)
+    {
+        VmaAllocationInfo allocationInfo;
+        vmaGetAllocationInfo(_device->Allocator, _allocation, &allocationInfo);
+        _memoryUsage = allocationInfo.size;
+    }
+    else
+    {
+        _memoryUsage = calculateMemoryUsage();
+    }
     if (PixelFormatExtensions::IsDepthStencil(format))
     {
         DefaultAspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
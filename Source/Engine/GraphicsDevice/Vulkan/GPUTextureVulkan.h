@@ -116,6 +116,14 @@ class GPUTextureVulkan : public GPUResourceVulkan<GPUTexture>, public ResourceOw
         return _image;
     }
 
+    /// <summary>
+    /// Gets the memory allocation of the image (null if image is placed in the memory of the other texture).
+    /// </summary>
+    FORCE_INLINE VmaAllocation GetAllocation() const
+    {
+        return _allocation;
+    }
+
     /// <summary>
     /// The Vulkan staging buffer (used by the staging textures for memory transfers).
     /// </summary>
@@ -443,19 +443,47 @@ const String& Actor::GetLayerName() const
     return Level::Layers[_layer];
 }
 
+void Actor::SetTags(const Array<Tag>& tags)
+{
+    if (_tags == tags)
+        return;
+    if (IsDuringPlay())
+        Level::unregisterActorTags(this);
+    _tags = tags;
+    if (IsDuringPlay())
+        Level::registerActorTags(this);
+}
+
+void Actor::AddTag(const Tag& tag)
+{
+    if (!tag || _tags.Contains(tag))
+        return;
+    _tags.Add(tag);
+    if (IsDuringPlay())
+        Level::registerActorTag(this, tag);
+}
+
+void Actor::RemoveTag(const Tag& tag)
+{
+    if (!_tags.Remove(tag))
+        return;
+    if (IsDuringPlay())
+        Level::unregisterActorTag(this, tag);
+}
+
 bool Actor::HasTag() const
 {
-    return Tags.Count() != 0;
+    return _tags.Count() != 0;
 }
 
 bool Actor::HasTag(const Tag& tag) const
 {
-    return Tags.Contains(tag);
+    return _tags.Contains(tag);
 }
 
 bool Actor::HasTag(const StringView& tag) const
 {
-    return Tags.Contains(tag);
+    return _tags.Contains(tag);
 }
 
 void Actor::SetLayer(int32 layerIndex)
@@ -764,6 +792,7 @@ void Actor::BeginPlay(SceneBeginData* data)
 
     // Set flag
     Flags |= ObjectFlags::IsDuringPlay;
+    Level::registerActor(this);
 
     OnBeginPlay();
 
@@ -814,6 +843,7 @@ void Actor::EndPlay()
 
     // Clear flag
     Flags &= ~ObjectFlags::IsDuringPlay;
+    Level::unregisterActor(this);
 
     // Call event deeper
     for (int32 i = 0; i < Children.Count(); i++)
@@ -856,18 +886,18 @@ void Actor::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(StaticFlags, _staticFlags);
     SERIALIZE(HideFlags);
     SERIALIZE_MEMBER(Layer, _layer);
-    if (!other || Tags != other->Tags)
+    if (!other || _tags != other->_tags)
     {
-        if (Tags.Count() == 1)
+        if (_tags.Count() == 1)
         {
             stream.JKEY("Tag");
-            stream.String(Tags.Get()->ToString());
+            stream.String(_tags.Get()->ToString());
         }
         else
         {
             stream.JKEY("Tags");
             stream.StartArray();
-            for (auto& tag : Tags)
+            for (auto& tag : _tags)
                 stream.String(tag.ToString());
             stream.EndArray();
         }
@@ -971,8 +1001,9 @@ void Actor::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
     {
         if (tag->value.IsString() && tag->value.GetStringLength())
         {
-            Tags.Clear();
-            Tags.Add(Tags::Get(tag->value.GetText()));
+            Array<Tag> tags;
+            tags.Add(Tags::Get(tag->value.GetText()));
+            SetTags(tags);
         }
     }
     else
@@ -980,13 +1011,14 @@ void Actor::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
         const auto tags = stream.FindMember("Tags");
         if (tags != stream.MemberEnd() && tags->value.IsArray())
         {
-            Tags.Clear();
+            Array<Tag> tagsValue;
             for (rapidjson::SizeType i = 0; i < tags->value.Size(); i++)
             {
                 auto& e = tags->value[i];
                 if (e.IsString() && e.GetStringLength())
-                    Tags.Add(Tags::Get(e.GetText()));
+                    tagsValue.Add(Tags::Get(e.GetText()));
             }
+            SetTags(tagsValue);
         }
     }
 
@@ -32,6 +32,7 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     friend SceneRendering;
     friend Prefab;
     friend PrefabInstanceData;
+    friend class SceneObjectsFactory;
 protected:
     int16 _isActive : 1;
     int16 _isActiveInHierarchy : 1;
@@ -46,6 +47,7 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     BoundingSphere _sphere;
     BoundingBox _box;
     String _name;
+    Array<Tag> _tags;
     Scene* _scene;
     PhysicsScene* _physicsScene;
 
@@ -73,11 +75,6 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     API_FIELD(Attributes="HideInEditor, NoSerialize")
     HideFlags HideFlags;
 
-    /// <summary>
-    /// Actor tags collection.
-    /// </summary>
-    API_FIELD(Attributes="NoAnimate, EditorDisplay(\"General\"), EditorOrder(-68)") Array<Tag> Tags;
-
 public:
     /// <summary>
     /// Gets the object layer (index). Can be used for selective rendering or ignoring raycasts.
@@ -107,6 +104,32 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     /// </summary>
     API_PROPERTY() const String& GetLayerName() const;
 
+    /// <summary>
+    /// Gets the actor tags collection.
+    /// </summary>
+    API_PROPERTY(Attributes="NoAnimate, EditorDisplay(\"General\"), EditorOrder(-68)")
+    FORCE_INLINE const Array<Tag>& GetTags() const
+    {
+        return _tags;
+    }
+
+    /// <summary>
+    /// Sets the actor tags collection.
+    /// </summary>
+    API_PROPERTY() void SetTags(const Array<Tag>& tags);
+
+    /// <summary>
+    /// Adds the tag to the actor (if not assigned yet).
+    /// </summary>
+    /// <param name="tag">The tag to add.</param>
+    API_FUNCTION() void AddTag(const Tag& tag);
+
+    /// <summary>
+    /// Removes the tag from the actor (if assigned).
+    /// </summary>
+    /// <param name="tag">The tag to remove.</param>
+    API_FUNCTION() void RemoveTag(const Tag& tag);
+
     /// <summary>
     /// Determines whether this actor has any tag assigned.
     /// </summary>
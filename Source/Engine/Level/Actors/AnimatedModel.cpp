@@ -76,6 +76,15 @@ void AnimatedModel::SetupSkinningData()
     }
 }
 
+SkinnedMeshDrawData& AnimatedModel::GetDrawSkinningData()
+{
+    // Use the bones buffer of the model that evaluated the shared pose (all models in the group draw with the same bones)
+    AnimatedModel* sharedPose = _sharedPose.Get();
+    if (sharedPose && sharedPose->SkinnedModel == SkinnedModel && sharedPose->_skinningData.IsReady())
+        return sharedPose->_skinningData;
+    return _skinningData;
+}
+
 void AnimatedModel::PreInitSkinningData()
 {
     if (!SkinnedModel || !SkinnedModel->IsLoaded())
@@ -585,6 +594,19 @@ void AnimatedModel::OnAnimationUpdated_Async()
         GraphInstance.RootMotion = masterInstance.RootMotion;
     }
 
+    // Copy pose from the model that evaluated the same animation (bones buffer is shared for drawing)
+    if (_sharedPose)
+    {
+        ANIM_GRAPH_PROFILE_EVENT("Copy Shared Pose");
+        const auto& sharedInstance = _sharedPose->GraphInstance;
+        GraphInstance.NodesPose = sharedInstance.NodesPose;
+        GraphInstance.RootTransform = sharedInstance.RootTransform;
+        GraphInstance.RootMotion = sharedInstance.RootMotion;
+        UpdateBounds();
+        _blendShapes.Update(SkinnedModel.Get());
+        return;
+    }
+
     // Calculate the final bones transformations and update skinning
     {
         ANIM_GRAPH_PROFILE_EVENT("Final Pose");
@@ -713,19 +735,20 @@ void AnimatedModel::Draw(RenderContext& renderContext)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.Position + renderContext.View.Origin));
-    if (_skinningData.IsReady())
+    SkinnedMeshDrawData& skinningData = GetDrawSkinningData();
+    if (skinningData.IsReady())
     {
         // Flush skinning data with GPU
-        if (_skinningData.IsDirty())
+        if (skinningData.IsDirty())
         {
             RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
+            GPUDevice::Instance->GetMainContext()->UpdateBuffer(skinningData.BoneMatrices, skinningData.Data.Get(), skinningData.Data.Count());
             RenderContext::GPULocker.Unlock();
         }
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
-        draw.Skinning = &_skinningData;
+        draw.Skinning = &skinningData;
         draw.BlendShapes = &_blendShapes;
         draw.World = &world;
         draw.DrawState = &_drawState;
@@ -756,19 +779,20 @@ void AnimatedModel::Draw(RenderContextBatch& renderContextBatch)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.Position + renderContext.View.Origin));
-    if (_skinningData.IsReady())
+    SkinnedMeshDrawData& skinningData = GetDrawSkinningData();
+    if (skinningData.IsReady())
     {
         // Flush skinning data with GPU
-        if (_skinningData.IsDirty())
+        if (skinningData.IsDirty())
         {
             RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
+            GPUDevice::Instance->GetMainContext()->UpdateBuffer(skinningData.BoneMatrices, skinningData.Data.Get(), skinningData.Data.Count());
             RenderContext::GPULocker.Unlock();
         }
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
-        draw.Skinning = &_skinningData;
+        draw.Skinning = &skinningData;
         draw.BlendShapes = &_blendShapes;
         draw.World = &world;
         draw.DrawState = &_drawState;
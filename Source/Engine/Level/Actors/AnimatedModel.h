@@ -17,6 +17,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
 {
     DECLARE_SCENE_OBJECT(AnimatedModel);
     friend class AnimationsSystem;
+    friend class Ragdoll;
 public:
     /// <summary>
     /// Describes the animation graph updates frequency for the animated model.
@@ -64,6 +65,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     uint64 _lastUpdateFrame;
     BlendShapesInstance _blendShapes;
     ScriptingObjectReference<AnimatedModel> _masterPose;
+    ScriptingObjectReference<AnimatedModel> _sharedPose;
 
 public:
     /// <summary>
@@ -102,6 +104,12 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     API_FIELD(Attributes="EditorOrder(45), EditorDisplay(\"Skinned Model\")")
     float UpdateSpeed = 1.0f;
 
+    /// <summary>
+    /// If checked, the animation pose will be shared with other animated models that use the same skinned model, animation graph and parameter values (eg. crowd characters playing the same idle or walk). Only one model from such group evaluates the animation graph during an update, the other models reuse its pose and bones buffer. Animation graph state of the models that reuse the pose is not updated.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(47), DefaultValue(false), EditorDisplay(\"Skinned Model\")")
+    bool SharePose = false;
+
     /// <summary>
     /// The animation update mode. Can be used to optimize the performance.
     /// </summary>
@@ -352,6 +360,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     void UpdateLocalBounds();
     void UpdateBounds();
     void UpdateSockets();
+    SkinnedMeshDrawData& GetDrawSkinningData();
     void OnAnimationUpdated_Async();
     void OnAnimationUpdated_Sync();
     void OnAnimationUpdated();
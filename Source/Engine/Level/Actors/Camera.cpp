@@ -299,6 +299,7 @@ void Camera::Draw(RenderContext& renderContext)
         draw.ForcedLOD = -1;
         draw.SortOrder = 0;
         draw.VertexColors = nullptr;
+        draw.DrawCache = nullptr;
         if (draw.DrawModes != DrawPass::None)
         {
             _previewModel->Draw(renderContext, draw);
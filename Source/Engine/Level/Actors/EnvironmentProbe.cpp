@@ -223,6 +223,7 @@ void EnvironmentProbe::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(Brightness);
     SERIALIZE(UpdateMode);
     SERIALIZE(CaptureNearPlane);
+    SERIALIZE(UpdatePriority);
     SERIALIZE_MEMBER(IsCustomProbe, _isUsingCustomProbe);
     SERIALIZE_MEMBER(ProbeID, _probe);
 }
@@ -237,6 +238,7 @@ void EnvironmentProbe::Deserialize(DeserializeStream& stream, ISerializeModifier
     DESERIALIZE(Brightness);
     DESERIALIZE(UpdateMode);
     DESERIALIZE(CaptureNearPlane);
+    DESERIALIZE(UpdatePriority);
     DESERIALIZE_MEMBER(IsCustomProbe, _isUsingCustomProbe);
     DESERIALIZE_MEMBER(ProbeID, _probe);
 
@@ -63,6 +63,12 @@ class FLAXENGINE_API EnvironmentProbe : public Actor
     API_FIELD(Attributes="EditorOrder(30), Limit(0, float.MaxValue, 0.01f), EditorDisplay(\"Probe\")")
     float CaptureNearPlane = 10.0f;
 
+    /// <summary>
+    /// The real-time probe update priority. Probes with higher priority are updated more often (real-time probes are updated one by one, also based on the distance to the camera).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(35), DefaultValue(0), Limit(0, 100), EditorDisplay(\"Probe\")")
+    int32 UpdatePriority = 0;
+
 public:
     /// <summary>
     /// Gets the probe radius.
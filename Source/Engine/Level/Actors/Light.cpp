@@ -92,6 +92,8 @@ void LightWithShadow::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(ShadowsDepthBias);
     SERIALIZE(ShadowsNormalOffsetScale);
     SERIALIZE(ContactShadowsLength);
+    SERIALIZE(ShadowsUpdateRate);
+    SERIALIZE(ShadowsUpdateRateAtDistance);
 }
 
 void LightWithShadow::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -108,4 +110,6 @@ void LightWithShadow::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(ShadowsDepthBias);
     DESERIALIZE(ShadowsNormalOffsetScale);
     DESERIALIZE(ContactShadowsLength);
+    DESERIALIZE(ShadowsUpdateRate);
+    DESERIALIZE(ShadowsUpdateRateAtDistance);
 }
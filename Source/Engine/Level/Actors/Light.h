@@ -132,6 +132,18 @@ API_CLASS(Abstract) class FLAXENGINE_API LightWithShadow : public Light
     API_FIELD(Attributes="EditorOrder(60), EditorDisplay(\"Shadow\", \"Mode\")")
     ShadowsCastingMode ShadowsMode = ShadowsCastingMode::All;
 
+    /// <summary>
+    /// The rate of the shadow map updates for the dynamic shadow casters (used by static lights that cache the shadow map of the static objects). Value 1 updates shadow every frame, 0.5 every second frame, value 0 updates it only when static objects change.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(100), EditorDisplay(\"Shadow\", \"Update Rate\"), Limit(0.0f, 1.0f, 0.01f)")
+    float ShadowsUpdateRate = 1.0f;
+
+    /// <summary>
+    /// The rate of the shadow map updates used at the light shadows distance from view (blended with Update Rate based on the light distance). Can be used to update shadows of the distant lights less frequently.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(101), EditorDisplay(\"Shadow\", \"Update Rate At Distance\"), Limit(0.0f, 1.0f, 0.01f)")
+    float ShadowsUpdateRateAtDistance = 1.0f;
+
 public:
     // [Light]
     void Serialize(SerializeStream& stream, const void* otherObj) override;
@@ -110,6 +110,8 @@ void PointLight::Draw(RenderContext& renderContext)
         data.SourceRadius = SourceRadius;
         data.SourceLength = SourceLength;
         data.ContactShadowsLength = ContactShadowsLength;
+        data.ShadowsUpdateRate = ShadowsUpdateRate;
+        data.ShadowsUpdateRateAtDistance = ShadowsUpdateRateAtDistance;
         data.IndirectLightingIntensity = IndirectLightingIntensity;
         data.IESTexture = IESTexture ? IESTexture->GetTexture() : nullptr;
         data.StaticFlags = GetStaticFlags();
@@ -51,10 +51,10 @@ void Ragdoll::SetAngularVelocity(const Vector3& value) const
 
 float Ragdoll::InitBone(RigidBody* rigidBody, int32& nodeIndex, Transform& localOffset)
 {
-    // Bones with 0 weight are non-simulated (kinematic)
+    // Bones with 0 weight are non-simulated (kinematic), frozen ragdoll keeps all bones kinematic
     float weight = BonesWeight;
     BonesWeights.TryGet(rigidBody->GetName(), weight);
-    rigidBody->SetIsKinematic(weight < ANIM_GRAPH_BLEND_THRESHOLD);
+    rigidBody->SetIsKinematic(_lod == 2 || weight < ANIM_GRAPH_BLEND_THRESHOLD);
     nodeIndex = _animatedModel->SkinnedModel->FindNode(rigidBody->GetName());
     if (nodeIndex != -1 && !_bonesOffsets.TryGet(rigidBody, localOffset))
     {
@@ -66,7 +66,10 @@ float Ragdoll::InitBone(RigidBody* rigidBody, int32& nodeIndex, Transform& local
         _bonesOffsets[rigidBody] = localOffset;
 
         // Initialize body
-        rigidBody->SetSolverIterationCounts(PositionSolverIterations, VelocitySolverIterations);
+        if (_lod == 0)
+            rigidBody->SetSolverIterationCounts(PositionSolverIterations, VelocitySolverIterations);
+        else
+            rigidBody->SetSolverIterationCounts(LODPositionSolverIterations, LODVelocitySolverIterations);
         rigidBody->SetMaxDepenetrationVelocity(MaxDepenetrationVelocity);
 
 #if USE_EDITOR
@@ -83,12 +86,75 @@ float Ragdoll::InitBone(RigidBody* rigidBody, int32& nodeIndex, Transform& local
     return weight;
 }
 
+void Ragdoll::UpdateLOD()
+{
+    // Pick the simulation LOD based on the distance to the closest view that rendered the model (invisible model uses the lowest quality)
+    int32 lod = 0;
+    if (LODDistance > 0.0f)
+    {
+        const Real distanceSqr = _animatedModel->_lastMinDstSqr;
+        const float distance = _lod == 0 ? LODDistance : LODDistance * 0.9f; // Hysteresis to prevent switching back and forth
+        if (distanceSqr >= distance * distance)
+        {
+            lod = _lod == 2 ? 2 : 1;
+            if (lod == 1 && FreezeWhenSettled)
+            {
+                // Freeze once all simulated bodies went to sleep
+                lod = 2;
+                for (auto child : Children)
+                {
+                    const auto rigidBody = Cast<RigidBody>(child);
+                    if (rigidBody && rigidBody->IsActiveInHierarchy() && !rigidBody->GetIsKinematic() && !rigidBody->IsSleeping())
+                    {
+                        lod = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if (lod == _lod)
+        return;
+    const int32 prevLod = _lod;
+    _lod = lod;
+
+    // Update bodies
+    for (auto child : Children)
+    {
+        const auto rigidBody = Cast<RigidBody>(child);
+        if (!rigidBody || !rigidBody->IsActiveInHierarchy())
+            continue;
+        if (lod == 0)
+            rigidBody->SetSolverIterationCounts(PositionSolverIterations, VelocitySolverIterations);
+        else if (prevLod == 0)
+            rigidBody->SetSolverIterationCounts(LODPositionSolverIterations, LODVelocitySolverIterations);
+        if (prevLod == 2)
+        {
+            // Restore simulation
+            float weight = BonesWeight;
+            BonesWeights.TryGet(rigidBody->GetName(), weight);
+            if (weight >= ANIM_GRAPH_BLEND_THRESHOLD)
+            {
+                rigidBody->SetIsKinematic(false);
+                rigidBody->WakeUp();
+            }
+        }
+        else if (lod == 2)
+        {
+            // Freeze in the current pose
+            rigidBody->SetIsKinematic(true);
+        }
+    }
+}
+
 void Ragdoll::OnFixedUpdate()
 {
     if (!_animatedModel || !_animatedModel->SkinnedModel)
         return;
     PROFILE_CPU();
 
+    UpdateLOD();
+
     // Synchronize non-simulated bones
     for (auto child : Children)
     {
@@ -244,6 +310,7 @@ void Ragdoll::OnDisable()
     Actor::OnDisable();
 
     _bonesOffsets.Clear();
+    _lod = 0;
     GetScene()->Ticking.FixedUpdate.RemoveTick(this);
 }
 
@@ -15,6 +15,7 @@ API_CLASS() class FLAXENGINE_API Ragdoll : public Actor
 private:
     AnimatedModel* _animatedModel = nullptr;
     Dictionary<RigidBody*, Transform> _bonesOffsets;
+    int32 _lod = 0;
 
 public:
     /// <summary>
@@ -50,6 +51,30 @@ API_CLASS() class FLAXENGINE_API Ragdoll : public Actor
     API_FIELD(Attributes="EditorOrder(120), EditorDisplay(\"Ragdoll\"), Limit(0)")
     float MaxDepenetrationVelocity = MAX_float;
 
+    /// <summary>
+    /// The distance from the view at which the ragdoll switches to the reduced simulation quality (physics LOD). Ragdolls not visible in any view are simulated with the reduced quality too. Use 0 to always simulate with full quality.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(200), EditorDisplay(\"Simulation LOD\", \"LOD Distance\"), Limit(0)")
+    float LODDistance = 0.0f;
+
+    /// <summary>
+    /// The minimum number of position iterations the physics solver should perform for bodies in this ragdoll when it's beyond the LOD distance.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(210), EditorDisplay(\"Simulation LOD\", \"LOD Position Solver Iterations\"), Limit(1, 255)")
+    uint8 LODPositionSolverIterations = 2;
+
+    /// <summary>
+    /// The minimum number of velocity iterations the physics solver should perform for bodies in this ragdoll when it's beyond the LOD distance.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(220), EditorDisplay(\"Simulation LOD\", \"LOD Velocity Solver Iterations\"), Limit(1, 255)")
+    uint8 LODVelocitySolverIterations = 1;
+
+    /// <summary>
+    /// If checked, the ragdoll bodies beyond the LOD distance get frozen in the current pose (switched to kinematic) once all of them settle down (fall asleep). Simulation is restored when the ragdoll gets closer to the view than the LOD distance.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(230), EditorDisplay(\"Simulation LOD\")")
+    bool FreezeWhenSettled = true;
+
 public:
     /// <summary>
     /// Calculates the total mass of all ragdoll bodies.
@@ -66,8 +91,17 @@ API_CLASS() class FLAXENGINE_API Ragdoll : public Actor
     /// </summary>
     API_FUNCTION() void SetAngularVelocity(const Vector3& value) const;
 
+    /// <summary>
+    /// Gets the current simulation LOD: 0 for full quality, 1 for reduced solver iterations, 2 for frozen bodies (kinematic).
+    /// </summary>
+    API_PROPERTY() int32 GetSimulationLOD() const
+    {
+        return _lod;
+    }
+
 private:
     float InitBone(RigidBody* rigidBody, int32& nodeIndex, Transform& localPose);
+    void UpdateLOD();
     void OnFixedUpdate();
     void OnAnimationUpdating(struct AnimGraphImpulse* localPose);
 
@@ -217,6 +217,7 @@ void StaticModel::RemoveVertexColors()
         SAFE_DELETE_GPU_RESOURCE(_vertexColorsBuffer[lodIndex]);
     _vertexColorsCount = 0;
     _vertexColorsDirty = false;
+    _drawCache.Invalidate();
 }
 
 void StaticModel::OnModelChanged()
@@ -228,6 +229,7 @@ void StaticModel::OnModelChanged()
     }
     RemoveVertexColors();
     Entries.Release();
+    _drawCache.Invalidate();
     if (Model && !Model->IsLoaded())
         UpdateBounds();
     else if (!Model && _sceneRenderingKey != -1)
@@ -237,6 +239,7 @@ void StaticModel::OnModelChanged()
 void StaticModel::OnModelLoaded()
 {
     Entries.SetupIfInvalid(Model);
+    _drawCache.Invalidate();
     UpdateBounds();
     if (_sceneRenderingKey == -1 && _scene && _isActiveInHierarchy && _isEnabled && !_residencyChangedModel)
     {
@@ -282,6 +285,7 @@ void StaticModel::UpdateBounds()
 
 void StaticModel::FlushVertexColors()
 {
+    _drawCache.Invalidate();
     RenderContext::GPULocker.Lock();
     for (int32 lodIndex = 0; lodIndex < _vertexColorsCount; lodIndex++)
     {
@@ -350,6 +354,7 @@ void StaticModel::Draw(RenderContext& renderContext)
     draw.ForcedLOD = _forcedLod;
     draw.SortOrder = _sortOrder;
     draw.VertexColors = _vertexColorsCount ? _vertexColorsBuffer : nullptr;
+    draw.DrawCache = nullptr;
 
     Model->Draw(renderContext, draw);
 
@@ -361,18 +366,44 @@ void StaticModel::Draw(RenderContextBatch& renderContextBatch)
     if (!Model || !Model->IsLoaded())
         return;
     const RenderContext& renderContext = renderContextBatch.GetMainContext();
-    Matrix world;
-    const Float3 translation = _transform.Translation - renderContext.View.Origin;
-    Matrix::Transformation(_transform.Scale, _transform.Orientation, translation, world);
-    GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
     if (_vertexColorsDirty)
         FlushVertexColors();
+    const auto lightmap = _scene->LightmapsData.GetReadyLightmap(Lightmap.TextureIndex);
+
+    // Static objects reuse the world matrix and the draw calls built in the previous frames
+    Matrix worldLocal;
+    Matrix* worldPtr = &worldLocal;
+    MeshDrawCache* drawCache = nullptr;
+    if (EnumHasAnyFlags(_staticFlags, StaticFlags::Transform))
+    {
+        drawCache = &_drawCache;
+        if (drawCache->Valid && (drawCache->Origin != renderContext.View.Origin || drawCache->Lightmap != lightmap || drawCache->DrawModes != DrawModes || drawCache->Flags != _staticFlags))
+            drawCache->Invalidate();
+        if (!drawCache->Valid)
+        {
+            const Float3 translation = _transform.Translation - renderContext.View.Origin;
+            Matrix::Transformation(_transform.Scale, _transform.Orientation, translation, drawCache->World);
+            drawCache->Origin = renderContext.View.Origin;
+            drawCache->Lightmap = lightmap;
+            drawCache->DrawModes = DrawModes;
+            drawCache->Flags = _staticFlags;
+            drawCache->Valid = true;
+        }
+        worldPtr = &drawCache->World;
+    }
+    else
+    {
+        const Float3 translation = _transform.Translation - renderContext.View.Origin;
+        Matrix::Transformation(_transform.Scale, _transform.Orientation, translation, worldLocal);
+    }
+    const Matrix& world = *worldPtr;
+    GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     Mesh::DrawInfo draw;
     draw.Buffer = &Entries;
-    draw.World = &world;
+    draw.World = worldPtr;
     draw.DrawState = &_drawState;
-    draw.Lightmap = _scene->LightmapsData.GetReadyLightmap(Lightmap.TextureIndex);
+    draw.Lightmap = lightmap;
     draw.LightmapUVs = &Lightmap.UVsArea;
     draw.Flags = _staticFlags;
     draw.DrawModes = DrawModes;
@@ -383,6 +414,7 @@ void StaticModel::Draw(RenderContextBatch& renderContextBatch)
     draw.ForcedLOD = _forcedLod;
     draw.SortOrder = _sortOrder;
     draw.VertexColors = _vertexColorsCount ? _vertexColorsBuffer : nullptr;
+    draw.DrawCache = drawCache;
 
     Model->Draw(renderContextBatch, draw);
 
@@ -593,6 +625,7 @@ void StaticModel::OnTransformChanged()
     // Base
     ModelInstanceActor::OnTransformChanged();
 
+    _drawCache.Invalidate();
     UpdateBounds();
 }
 
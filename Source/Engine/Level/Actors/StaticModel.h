@@ -4,6 +4,7 @@
 
 #include "ModelInstanceActor.h"
 #include "Engine/Content/Assets/Model.h"
+#include "Engine/Graphics/Models/MeshDrawCache.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/Lightmaps.h"
 
@@ -25,6 +26,7 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Model\")") class FLAXENGINE_API Sta
     Array<Color32> _vertexColorsData[MODEL_MAX_LODS];
     GPUBuffer* _vertexColorsBuffer[MODEL_MAX_LODS];
     Model* _residencyChangedModel = nullptr;
+    MeshDrawCache _drawCache;
 
 public:
     /// <summary>
@@ -6,9 +6,17 @@
 #include "SceneQuery.h"
 #include "SceneObjectsFactory.h"
 #include "Scene/Scene.h"
+#include "Tags.h"
+#include "Actors/EmptyActor.h"
+#include "Actors/StaticModel.h"
+#include "Actors/PointLight.h"
+#include "Actors/SpotLight.h"
+#include "Actors/DirectionalLight.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Core/Cache.h"
 #include "Engine/Core/Collections/CollectionPoolCache.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/ObjectsRemovalService.h"
 #include "Engine/Core/Config/LayersTagsSettings.h"
 #include "Engine/Core/Types/LayersMask.h"
@@ -18,9 +26,11 @@
 #include "Engine/Debug/Exceptions/JsonParseException.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Platform/File.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Scripting/Script.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Scripting/ManagedCLR/MAssembly.h"
@@ -41,6 +51,9 @@
 #include "Editor/Scripting/ScriptsBuilder.h"
 #endif
 
+// The minimum amount of objects in the scene to deserialize them on multiple threads
+#define LEVEL_ASYNC_DESERIALIZE_MIN_OBJECTS 256
+
 #if USE_LARGE_WORLDS
 bool LargeWorlds::Enable = true;
 #else
@@ -127,6 +140,12 @@ namespace LevelImpl
 
 using namespace LevelImpl;
 
+namespace
+{
+    void OnScriptsReloading();
+    void OnScriptsReloaded();
+}
+
 class LevelService : public EngineService
 {
 public:
@@ -135,6 +154,7 @@ class LevelService : public EngineService
     {
     }
 
+    bool Init() override;
     void Update() override;
     void LateUpdate() override;
     void FixedUpdate() override;
@@ -146,6 +166,8 @@ LevelService LevelServiceInstanceService;
 CriticalSection Level::ScenesLock;
 Array<Scene*> Level::Scenes;
 bool Level::TickEnabled = true;
+Array<TickGroup> Level::TickGroups;
+bool Level::BatchManagedScriptsUpdate = false;
 Delegate<Actor*> Level::ActorSpawned;
 Delegate<Actor*> Level::ActorDeleted;
 Delegate<Actor*, Actor*> Level::ActorParentChanged;
@@ -245,6 +267,7 @@ void LayersAndTagsSettings::Apply()
 void LevelService::Update()
 {
     PROFILE_CPU_NAMED("Level::Update");
+    PROFILE_MEM(Level);
 
     ScopeLock lock(Level::ScenesLock);
     auto& scenes = Level::Scenes;
@@ -255,7 +278,11 @@ void LevelService::Update()
         for (int32 i = 0; i < scenes.Count(); i++)
         {
             if (scenes[i]->GetIsActive())
+            {
+                scenes[i]->Ticking.Update.TickScriptsParallel();
                 scenes[i]->Ticking.Update.Tick();
+                scenes[i]->Ticking.Update.TickScriptsGroups();
+            }
         }
     }
 #if USE_EDITOR
@@ -334,6 +361,8 @@ void LevelService::FixedUpdate()
 
 void LevelService::Dispose()
 {
+    Scripting::ScriptsReloading.Unbind<OnScriptsReloading>();
+    Scripting::ScriptsReloaded.Unbind<OnScriptsReloaded>();
     ScopeLock lock(_sceneActionsLocker);
 
     // Unload scenes
@@ -518,6 +547,23 @@ class SaveSceneAction : public SceneAction
 
 #if USE_EDITOR
 
+bool HasObjectsFromModules(const Actor* actor, const Array<BinaryModule*>& modules)
+{
+    if (modules.Contains(actor->GetTypeHandle().Module))
+        return true;
+    for (const Script* script : actor->Scripts)
+    {
+        if (modules.Contains(script->GetTypeHandle().Module))
+            return true;
+    }
+    for (const Actor* child : actor->Children)
+    {
+        if (HasObjectsFromModules(child, modules))
+            return true;
+    }
+    return false;
+}
+
 class ReloadScriptsAction : public SceneAction
 {
 public:
@@ -534,6 +580,7 @@ class ReloadScriptsAction : public SceneAction
         // - load user assemblies
         // - load scenes (from temporary files)
         // Note: we don't want to override original scene files
+        // Note: scenes are kept loaded if they don't use any types from the reloaded assemblies
 
         PROFILE_CPU_NAMED("Level.ReloadScripts");
         LOG(Info, "Scripts reloading start");
@@ -565,7 +612,12 @@ class ReloadScriptsAction : public SceneAction
                 Name = scene->GetName();
             }
         };
-        const int32 scenesCount = Level::Scenes.Count();
+        Array<BinaryModule*> modulesToReload;
+        Scripting::GetModulesToReload(modulesToReload);
+        bool reloadScenes = false;
+        for (int32 i = 0; i < Level::Scenes.Count() && !reloadScenes; i++)
+            reloadScenes = HasObjectsFromModules(Level::Scenes[i], modulesToReload);
+        const int32 scenesCount = reloadScenes ? Level::Scenes.Count() : 0;
         Array<SceneData> scenes;
         scenes.Resize(scenesCount);
         for (int32 i = 0; i < scenesCount; i++)
@@ -591,11 +643,14 @@ class ReloadScriptsAction : public SceneAction
         }
 
         // Unload scenes
-        unloadScenes();
+        if (reloadScenes)
+            unloadScenes();
+        else
+            LOG(Info, "Keeping scenes loaded (not using types from the reloaded modules)");
 
         // Reload scripting
         Level::ScriptsReload();
-        Scripting::Reload();
+        Scripting::ReloadModules();
         Level::ScriptsReloaded();
 
         // Restore objects
@@ -761,6 +816,270 @@ int32 Level::GetLayerIndex(const StringView& layer)
     return result;
 }
 
+namespace
+{
+    // Index of the actors and scripts during play (type buckets include only the exact type, queries check the derived types per-bucket)
+    CriticalSection ObjectsIndexLocker;
+    Dictionary<ScriptingTypeHandle, HashSet<Actor*>> ActorsByType;
+    Dictionary<ScriptingTypeHandle, HashSet<Script*>> ScriptsByType;
+    Dictionary<Tag, HashSet<Actor*>> ActorsByTag;
+
+    bool IsInLevel(const Actor* a)
+    {
+        // Skip objects that are during play but not in the loaded scenes (eg. removed from the hierarchy or in the editor preview scenes)
+        Scene* scene = a ? a->GetScene() : nullptr;
+        return scene && Level::Scenes.Contains(scene);
+    }
+
+    bool IsTypeOf(const ScriptingTypeHandle& typeHandle, const MClass* type)
+    {
+        const MClass* klass = typeHandle.GetType().ManagedClass;
+        return klass && klass->IsSubClassOf(type);
+    }
+
+    template<typename KeyType, typename T>
+    void RemoveFromIndex(Dictionary<KeyType, HashSet<T*>>& index, const KeyType& key, T* obj)
+    {
+        auto it = index.Find(key);
+        if (it.IsNotEnd())
+        {
+            it->Value.Remove(obj);
+            if (it->Value.IsEmpty())
+                index.Remove(it);
+        }
+    }
+
+    void OnScriptsReloading()
+    {
+        // Type handles used as keys can point to the modules that are going to be unloaded
+        ScopeLock lock(ObjectsIndexLocker);
+        ActorsByType.Clear();
+        ScriptsByType.Clear();
+    }
+
+    void RegisterTypesRecursive(Actor* a)
+    {
+        if (!a->IsDuringPlay())
+            return;
+        ActorsByType[a->GetTypeHandle()].Add(a);
+        for (Script* script : a->Scripts)
+        {
+            if (script->IsDuringPlay())
+                ScriptsByType[script->GetTypeHandle()].Add(script);
+        }
+        for (Actor* child : a->Children)
+            RegisterTypesRecursive(child);
+    }
+
+    void OnScriptsReloaded()
+    {
+        // Restore the index for the scenes that were kept loaded during scripts reload
+        ScopeLock lock(Level::ScenesLock);
+        ScopeLock indexLock(ObjectsIndexLocker);
+        for (Scene* scene : Level::Scenes)
+            RegisterTypesRecursive(scene);
+    }
+
+    typedef Array<int32, InlinedAllocation<16>> HierarchyKey;
+
+    // Helper used to return the query results in the hierarchy order (the same as walking the loaded scenes depth-first) rather than the index order
+    struct HierarchyOrder
+    {
+        Dictionary<const Actor*, int32> ChildrenOrder;
+
+        int32 GetOrderInParent(const Actor* a)
+        {
+            const Actor* parent = a->GetParent();
+            if (!parent)
+                return Level::Scenes.Find((Scene*)a);
+            int32 result;
+            if (!ChildrenOrder.TryGet(a, result))
+            {
+                // Cache the order of all siblings at once
+                for (int32 i = 0; i < parent->Children.Count(); i++)
+                    ChildrenOrder[parent->Children[i]] = i;
+                result = ChildrenOrder[a];
+            }
+            return result;
+        }
+
+        void GetKey(const Actor* a, HierarchyKey& key)
+        {
+            key.Clear();
+            for (; a; a = a->GetParent())
+                key.Add(GetOrderInParent(a));
+            key.Reverse();
+        }
+
+        void GetKey(const Script* s, HierarchyKey& key)
+        {
+            // Scripts go before the children of their actor
+            GetKey(s->GetParent(), key);
+            key.Add(-1);
+            key.Add(s->GetOrderInParent());
+        }
+
+        static bool IsBefore(const HierarchyKey& a, const HierarchyKey& b)
+        {
+            const int32 count = Math::Min(a.Count(), b.Count());
+            for (int32 i = 0; i < count; i++)
+            {
+                if (a[i] != b[i])
+                    return a[i] < b[i];
+            }
+            return a.Count() < b.Count();
+        }
+
+        static bool CompareKeys(const int32& a, const int32& b, Array<HierarchyKey>* keys)
+        {
+            return IsBefore(keys->At(a), keys->At(b));
+        }
+
+        template<typename T>
+        T* GetFirst(const Array<T*>& objects)
+        {
+            if (objects.Count() <= 1)
+                return objects.HasItems() ? objects[0] : nullptr;
+            HierarchyKey key, bestKey;
+            int32 best = 0;
+            GetKey(objects[0], bestKey);
+            for (int32 i = 1; i < objects.Count(); i++)
+            {
+                GetKey(objects[i], key);
+                if (IsBefore(key, bestKey))
+                {
+                    best = i;
+                    bestKey = key;
+                }
+            }
+            return objects[best];
+        }
+
+        template<typename T>
+        void Sort(Array<T*>& objects)
+        {
+            if (objects.Count() <= 1)
+                return;
+            Array<HierarchyKey> keys;
+            keys.Resize(objects.Count());
+            Array<int32> indices;
+            indices.Resize(objects.Count());
+            for (int32 i = 0; i < objects.Count(); i++)
+            {
+                GetKey(objects[i], keys[i]);
+                indices[i] = i;
+            }
+            Sorting::SortArray(indices.Get(), indices.Count(), &CompareKeys, &keys);
+            const Array<T*> unsorted = objects;
+            for (int32 i = 0; i < objects.Count(); i++)
+                objects[i] = unsorted[indices[i]];
+        }
+    };
+
+    void GetIndexedActors(const Tag& tag, Array<Actor*>& result)
+    {
+        const HashSet<Actor*>* actors = ActorsByTag.TryGet(tag);
+        if (actors)
+        {
+            result.EnsureCapacity(actors->Count());
+            for (const auto& e : *actors)
+            {
+                if (IsInLevel(e.Item))
+                    result.Add(e.Item);
+            }
+        }
+    }
+
+    void GetIndexedActors(const MClass* type, Array<Actor*>& result)
+    {
+        for (const auto& bucket : ActorsByType)
+        {
+            if (!IsTypeOf(bucket.Key, type))
+                continue;
+            for (const auto& e : bucket.Value)
+            {
+                if (IsInLevel(e.Item))
+                    result.Add(e.Item);
+            }
+        }
+    }
+
+    void GetIndexedScripts(const MClass* type, Array<Script*>& result)
+    {
+        for (const auto& bucket : ScriptsByType)
+        {
+            if (!IsTypeOf(bucket.Key, type))
+                continue;
+            for (const auto& e : bucket.Value)
+            {
+                if (IsInLevel(e.Item->GetParent()))
+                    result.Add(e.Item);
+            }
+        }
+    }
+}
+
+bool LevelService::Init()
+{
+    Scripting::ScriptsReloading.Bind<OnScriptsReloading>();
+    Scripting::ScriptsReloaded.Bind<OnScriptsReloaded>();
+    return false;
+}
+
+void Level::registerActor(Actor* a)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    ActorsByType[a->GetTypeHandle()].Add(a);
+    for (const Tag& tag : a->_tags)
+        ActorsByTag[tag].Add(a);
+}
+
+void Level::unregisterActor(Actor* a)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    RemoveFromIndex(ActorsByType, a->GetTypeHandle(), a);
+    for (const Tag& tag : a->_tags)
+        RemoveFromIndex(ActorsByTag, tag, a);
+}
+
+void Level::registerActorTags(Actor* a)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    for (const Tag& tag : a->_tags)
+        ActorsByTag[tag].Add(a);
+}
+
+void Level::unregisterActorTags(Actor* a)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    for (const Tag& tag : a->_tags)
+        RemoveFromIndex(ActorsByTag, tag, a);
+}
+
+void Level::registerActorTag(Actor* a, const Tag& tag)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    ActorsByTag[tag].Add(a);
+}
+
+void Level::unregisterActorTag(Actor* a, const Tag& tag)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    RemoveFromIndex(ActorsByTag, tag, a);
+}
+
+void Level::registerScript(Script* s)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    ScriptsByType[s->GetTypeHandle()].Add(s);
+}
+
+void Level::unregisterScript(Script* s)
+{
+    ScopeLock lock(ObjectsIndexLocker);
+    RemoveFromIndex(ScriptsByType, s->GetTypeHandle(), s);
+}
+
 Actor* FindActorRecursive(Actor* node, const Tag& tag)
 {
     if (node->HasTag(tag))
@@ -780,14 +1099,11 @@ Actor* Level::FindActor(const Tag& tag, Actor* root)
     PROFILE_CPU();
     if (root)
         return FindActorRecursive(root, tag);
-    Actor* result = nullptr;
-    for (Scene* scene : Scenes)
-    {
-        result = FindActorRecursive(scene, tag);
-        if (result)
-            break;
-    }
-    return result;
+    ScopeLock lock(ScenesLock);
+    ScopeLock indexLock(ObjectsIndexLocker);
+    Array<Actor*> actors;
+    GetIndexedActors(tag, actors);
+    return HierarchyOrder().GetFirst(actors);
 }
 
 void FindActorRecursive(Actor* node, const Tag& tag, Array<Actor*>& result)
@@ -804,12 +1120,14 @@ Array<Actor*> Level::FindActors(const Tag& tag, Actor* root)
     Array<Actor*> result;
     if (root)
     {
-        FindActorRecursive(root, tag);
+        FindActorRecursive(root, tag, result);
     }
     else
     {
-        for (Scene* scene : Scenes)
-            FindActorRecursive(scene, tag);
+        ScopeLock lock(ScenesLock);
+        ScopeLock indexLock(ObjectsIndexLocker);
+        GetIndexedActors(tag, result);
+        HierarchyOrder().Sort(result);
     }
     return result;
 }
@@ -982,6 +1300,44 @@ bool Level::loadScene(rapidjson_flax::Document& document, Scene** outScene)
     return loadScene(data->value, saveEngineBuild, outScene);
 }
 
+namespace
+{
+    // Checks if the scene object can be deserialized on a job thread. Only the native types with audited Deserialize are allowed. Their Deserialize modifies only the object itself and the thread-safe global state:
+    // - Actor: tags (Tags::Get, resolved upfront by ResolveTags), parent (linked upfront so it's not modified), prefab link (Content::LoadAsync and locked PrefabManager::PrefabsReferences)
+    // - EmptyActor, PointLight, SpotLight, DirectionalLight: plain properties and asset references (Content::LoadAsync)
+    // - StaticModel: plain properties, asset references and material slots (waits for the model asset to load vertex colors)
+    // Other types (eg. physics, audio, scripts or managed objects) can register in the global systems on deserialization so they use the main loading thread.
+    bool CanDeserializeAsync(const SceneObject* obj)
+    {
+        if (EnumHasAnyFlags(obj->Flags, ObjectFlags::IsManagedType | ObjectFlags::IsCustomScriptingType))
+            return false;
+        const ScriptingTypeHandle type = obj->GetTypeHandle();
+        return type == EmptyActor::TypeInitializer ||
+               type == StaticModel::TypeInitializer ||
+               type == PointLight::TypeInitializer ||
+               type == SpotLight::TypeInitializer ||
+               type == DirectionalLight::TypeInitializer;
+    }
+
+    // Adds the tags used by the serialized actor to the global tags list so deserialization on job threads only finds them (doesn't reallocate the list)
+    void ResolveTags(const ISerializable::DeserializeStream& stream)
+    {
+        const auto tag = stream.FindMember("Tag");
+        if (tag != stream.MemberEnd() && tag->value.IsString() && tag->value.GetStringLength())
+            Tags::Get(tag->value.GetText());
+        const auto tags = stream.FindMember("Tags");
+        if (tags != stream.MemberEnd() && tags->value.IsArray())
+        {
+            for (rapidjson::SizeType i = 0; i < tags->value.Size(); i++)
+            {
+                auto& e = tags->value[i];
+                if (e.IsString() && e.GetStringLength())
+                    Tags::Get(e.GetText());
+            }
+        }
+    }
+}
+
 bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** outScene)
 {
     PROFILE_CPU_NAMED("Level.LoadScene");
@@ -1081,23 +1437,76 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
     SceneObjectsFactory::SynchronizeNewPrefabInstances(context, prefabSyncData);
 
     // /\ all above this has to be done on an any thread
-    // \/ all below this has to be done on multiple threads at once
+    // \/ all below this is done on multiple threads at once (for big scenes)
 
     {
         PROFILE_CPU_NAMED("Deserialize");
 
-        // TODO: at this point we would probably spawn a few thread pool tasks which will load deserialize scene object but only if scene is big enough
+        if (objectsCount >= LEVEL_ASYNC_DESERIALIZE_MIN_OBJECTS && JobSystem::GetThreadsCount() > 1)
+        {
+            // Link objects hierarchy upfront so deserialization on job threads doesn't modify the shared children/scripts lists (order stays the same as in the data)
+            Array<bool> parentLinked;
+            parentLinked.Resize(objectsCount);
+            for (int32 i = 1; i < objectsCount; i++)
+            {
+                auto obj = sceneObjects->At(i);
+                parentLinked[i] = obj && SceneObjectsFactory::SetupParent(context, obj, data[i]);
+                if (obj && CanDeserializeAsync(obj))
+                    ResolveTags(data[i]);
+            }
 
-        // Load all scene objects
-        Scripting::ObjectsLookupIdMapping.Set(&modifier.Value->IdsMapping);
-        for (int32 i = 1; i < objectsCount; i++) // start from 1. at index [0] was scene
+            // Load audited native scene objects on job threads (each job uses own copy of the ids mapping since prefab instances modify it)
+            const int32 chunkSize = 64;
+            const int32 jobsCount = Math::DivideAndRoundUp(objectsCount - 1, chunkSize);
+            JobSystem::Execute([&](int32 jobIndex)
+            {
+                PROFILE_CPU_NAMED("Deserialize Job");
+                auto jobModifier = Cache::ISerializeModifier.Get();
+                jobModifier->EngineBuild = modifier->EngineBuild;
+                jobModifier->IdsMapping = modifier->IdsMapping;
+                SceneObjectsFactory::Context jobContext(jobModifier.Value, context);
+                Scripting::ObjectsLookupIdMapping.Set(&jobModifier->IdsMapping);
+                const int32 start = 1 + jobIndex * chunkSize;
+                const int32 end = Math::Min(start + chunkSize, objectsCount);
+                for (int32 i = start; i < end; i++)
+                {
+                    auto obj = sceneObjects->At(i);
+                    if (obj && CanDeserializeAsync(obj))
+                        SceneObjectsFactory::Deserialize(jobContext, obj, data[i]);
+                }
+                Scripting::ObjectsLookupIdMapping.Set(nullptr);
+            }, jobsCount);
+
+            // Load other objects on the loading thread and finish the hierarchy setup
+            Scripting::ObjectsLookupIdMapping.Set(&modifier.Value->IdsMapping);
+            for (int32 i = 1; i < objectsCount; i++)
+            {
+                auto obj = sceneObjects->At(i);
+                if (!obj)
+                    continue;
+                if (!CanDeserializeAsync(obj))
+                    SceneObjectsFactory::Deserialize(context, obj, data[i]);
+                if (parentLinked[i])
+                {
+                    if (const auto actor = dynamic_cast<Actor*>(obj))
+                        actor->OnParentChanged();
+                }
+            }
+            Scripting::ObjectsLookupIdMapping.Set(nullptr);
+        }
+        else
         {
-            auto& objData = data[i];
-            auto obj = sceneObjects->At(i);
-            if (obj)
-                SceneObjectsFactory::Deserialize(context, obj, objData);
+            // Load all scene objects
+            Scripting::ObjectsLookupIdMapping.Set(&modifier.Value->IdsMapping);
+            for (int32 i = 1; i < objectsCount; i++) // start from 1. at index [0] was scene
+            {
+                auto& objData = data[i];
+                auto obj = sceneObjects->At(i);
+                if (obj)
+                    SceneObjectsFactory::Deserialize(context, obj, objData);
+            }
+            Scripting::ObjectsLookupIdMapping.Set(nullptr);
         }
-        Scripting::ObjectsLookupIdMapping.Set(nullptr);
     }
 
     // /\ all above this has to be done on multiple threads at once
@@ -1463,41 +1872,21 @@ Actor* Level::FindActor(const StringView& name)
 Actor* Level::FindActor(const MClass* type)
 {
     CHECK_RETURN(type, nullptr);
-    Actor* result = nullptr;
     ScopeLock lock(ScenesLock);
-    for (int32 i = 0; result == nullptr && i < Scenes.Count(); i++)
-        result = Scenes[i]->FindActor(type);
-    return result;
+    ScopeLock indexLock(ObjectsIndexLocker);
+    Array<Actor*> actors;
+    GetIndexedActors(type, actors);
+    return HierarchyOrder().GetFirst(actors);
 }
 
 Script* Level::FindScript(const MClass* type)
 {
     CHECK_RETURN(type, nullptr);
-    Script* result = nullptr;
     ScopeLock lock(ScenesLock);
-    for (int32 i = 0; result == nullptr && i < Scenes.Count(); i++)
-        result = Scenes[i]->FindScript(type);
-    return result;
-}
-
-namespace
-{
-    void GetActors(const MClass* type, Actor* actor, Array<Actor*>& result)
-    {
-        if (actor->GetClass()->IsSubClassOf(type))
-            result.Add(actor);
-        for (auto child : actor->Children)
-            GetActors(type, child, result);
-    }
-
-    void GetScripts(const MClass* type, Actor* actor, Array<Script*>& result)
-    {
-        for (auto script : actor->Scripts)
-            if (script->GetClass()->IsSubClassOf(type))
-                result.Add(script);
-        for (auto child : actor->Children)
-            GetScripts(type, child, result);
-    }
+    ScopeLock indexLock(ObjectsIndexLocker);
+    Array<Script*> scripts;
+    GetIndexedScripts(type, scripts);
+    return HierarchyOrder().GetFirst(scripts);
 }
 
 Array<Actor*> Level::GetActors(const MClass* type)
@@ -1505,8 +1894,9 @@ Array<Actor*> Level::GetActors(const MClass* type)
     Array<Actor*> result;
     CHECK_RETURN(type, result);
     ScopeLock lock(ScenesLock);
-    for (int32 i = 0; i < Scenes.Count(); i++)
-        ::GetActors(type, Scenes[i], result);
+    ScopeLock indexLock(ObjectsIndexLocker);
+    GetIndexedActors(type, result);
+    HierarchyOrder().Sort(result);
     return result;
 }
 
@@ -1515,8 +1905,9 @@ Array<Script*> Level::GetScripts(const MClass* type)
     Array<Script*> result;
     CHECK_RETURN(type, result);
     ScopeLock lock(ScenesLock);
-    for (int32 i = 0; i < Scenes.Count(); i++)
-        ::GetScripts(type, Scenes[i], result);
+    ScopeLock indexLock(ObjectsIndexLocker);
+    GetIndexedScripts(type, result);
+    HierarchyOrder().Sort(result);
     return result;
 }
 
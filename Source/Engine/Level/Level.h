@@ -10,6 +10,7 @@
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Serialization/JsonFwd.h"
 #include "Types.h"
+#include "Scene/TickGroup.h"
 
 class JsonWriter;
 class Engine;
@@ -26,6 +27,7 @@ API_CLASS(Static) class FLAXENGINE_API Level
     DECLARE_SCRIPTING_TYPE_NO_SPAWN(Level);
     friend Engine;
     friend Actor;
+    friend Script;
     friend PrefabManager;
     friend Prefab;
     friend PrefabInstanceData;
@@ -50,6 +52,16 @@ API_CLASS(Static) class FLAXENGINE_API Level
     /// </summary>
     API_FIELD() static bool TickEnabled;
 
+    /// <summary>
+    /// The groups of scripts updated at the custom rate with time-slicing across frames (see Script.TickGroup). Initialized from TimeSettings.
+    /// </summary>
+    API_FIELD() static Array<TickGroup> TickGroups;
+
+    /// <summary>
+    /// True if update C# scripts in batches (single call into managed code for the consecutive managed scripts instead of a call per script). Reduces the native to managed transitions overhead. Scripts updated in batches should not call base.OnUpdate.
+    /// </summary>
+    API_FIELD() static bool BatchManagedScriptsUpdate;
+
 public:
     /// <summary>
     /// Occurs when new actor gets spawned to the game.
@@ -492,6 +504,16 @@ API_CLASS(Static) class FLAXENGINE_API Level
     };
 
     static void callActorEvent(ActorEventType eventType, Actor* a, Actor* b);
+
+    // Objects indexing (actors and scripts during play by type and tag) used by the queries
+    static void registerActor(Actor* a);
+    static void unregisterActor(Actor* a);
+    static void registerActorTags(Actor* a);
+    static void unregisterActorTags(Actor* a);
+    static void registerActorTag(Actor* a, const Tag& tag);
+    static void unregisterActorTag(Actor* a, const Tag& tag);
+    static void registerScript(Script* s);
+    static void unregisterScript(Script* s);
     static bool loadScene(const Guid& sceneId);
     static bool loadScene(const String& scenePath);
     static bool loadScene(JsonAsset* sceneAsset);
@@ -7,9 +7,7 @@
 #include "Engine/Level/Prefabs/PrefabManager.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Threading/Threading.h"
-#if USE_EDITOR
 #include "Engine/Scripting/Scripting.h"
-#endif
 
 REGISTER_JSON_ASSET(Prefab, "FlaxEngine.Prefab", true);
 
@@ -70,10 +68,31 @@ SceneObject* Prefab::GetDefaultInstance(const Guid& objectId)
     return result;
 }
 
+const Array<ScriptingTypeHandle>& Prefab::GetObjectsTypes()
+{
+    ScopeLock lock(Locker);
+    if (_objectsTypes.Count() != ObjectsCount)
+    {
+        _objectsTypes.Resize(ObjectsCount);
+        const auto& data = *Data;
+        for (int32 i = 0; i < ObjectsCount; i++)
+        {
+            auto& objData = data[i];
+            ScriptingTypeHandle type;
+            const auto typeNameMember = objData.FindMember("TypeName");
+            if (typeNameMember != objData.MemberEnd() && typeNameMember->value.IsString() && !objData.HasMember("PrefabObjectID"))
+                type = Scripting::FindScriptingType(typeNameMember->value.GetStringAnsiView());
+            _objectsTypes[i] = type;
+        }
+    }
+    return _objectsTypes;
+}
+
 void Prefab::DeleteDefaultInstance()
 {
     ScopeLock lock(Locker);
     ObjectsCache.Clear();
+    _objectsTypes.Clear(); // Types might be reloaded
     if (_defaultInstance)
     {
         _defaultInstance->DeleteObject();
@@ -166,6 +185,7 @@ void Prefab::unload(bool isReloading)
     ObjectsDataCache.SetCapacity(0);
     ObjectsCache.Clear();
     ObjectsCache.SetCapacity(0);
+    _objectsTypes.Resize(0);
     if (_defaultInstance)
     {
         _defaultInstance->DeleteObject();
@@ -5,6 +5,7 @@
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Scripting/ScriptingType.h"
 
 class Actor;
 class SceneObject;
@@ -19,6 +20,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
 private:
     bool _isCreatingDefaultInstance;
     Actor* _defaultInstance;
+    Array<ScriptingTypeHandle> _objectsTypes;
 
 public:
     /// <summary>
@@ -69,6 +71,12 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
     /// <returns>The object of the prefab loaded from the prefab. Contains the default values. It's not added to gameplay but deserialized with postLoad and init event fired.</returns>
     API_FUNCTION() SceneObject* GetDefaultInstance(API_PARAM(Ref) const Guid& objectId);
 
+    /// <summary>
+    /// Gets the scripting types of the objects contained within the prefab asset (in the same order as ObjectsIds). Invalid type is used for objects that need to be spawned from data (eg. nested prefabs). Used to spawn prefab instances without resolving types by name. Asset must be loaded.
+    /// </summary>
+    /// <returns>The objects types list. Cached after the first call.</returns>
+    const Array<ScriptingTypeHandle>& GetObjectsTypes();
+
 #if USE_EDITOR
     /// <summary>
     /// Applies the difference from the prefab object instance, saves the changes and synchronizes them with the active instances of the prefab asset.
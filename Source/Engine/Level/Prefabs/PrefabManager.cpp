@@ -18,6 +18,8 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
+#include "Engine/Threading/Threading.h"
 
 #if USE_EDITOR
 bool PrefabManager::IsCreatingPrefab = false;
@@ -26,6 +28,22 @@ Dictionary<Guid, Array<Actor*>> PrefabManager::PrefabsReferences;
 CriticalSection PrefabManager::PrefabsReferencesLocker;
 #endif
 
+int32 PrefabManager::PoolCapacity = 64;
+
+namespace
+{
+    CriticalSection PoolLocker;
+    Dictionary<Guid, Array<ScriptingObjectReference<Actor>>> Pool;
+
+    void OnPoolReuse(Actor* actor)
+    {
+        for (Script* script : actor->Scripts)
+            script->OnPoolReuse();
+        for (Actor* child : actor->Children)
+            OnPoolReuse(child);
+    }
+}
+
 class PrefabManagerService : public EngineService
 {
 public:
@@ -33,6 +51,12 @@ class PrefabManagerService : public EngineService
         : EngineService(TEXT("Prefab Manager"), 110)
     {
     }
+
+    void Dispose() override
+    {
+        ScopeLock lock(PoolLocker);
+        Pool.Clear();
+    }
 };
 
 PrefabManagerService PrefabManagerServiceInstance;
@@ -90,6 +114,88 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform)
     return instance;
 }
 
+Actor* PrefabManager::SpawnPooled(Prefab* prefab, Actor* parent, const Transform& transform)
+{
+    if (prefab == nullptr)
+    {
+        Log::ArgumentNullException();
+        return nullptr;
+    }
+
+    // Pick the dormant instance (skip objects deleted in the meantime)
+    Actor* instance = nullptr;
+    PoolLocker.Lock();
+    auto pool = Pool.TryGet(prefab->GetID());
+    while (pool && pool->HasItems() && !instance)
+        instance = pool->Pop().Get();
+    PoolLocker.Unlock();
+    if (!instance)
+    {
+        instance = SpawnPrefab(prefab, parent, nullptr);
+        if (instance)
+            instance->SetTransform(transform);
+        return instance;
+    }
+
+    // Reuse instance
+    PROFILE_CPU_NAMED("Prefab.SpawnPooled");
+    if (instance->GetParent() != parent)
+        instance->SetParent(parent, false, false);
+    instance->SetTransform(transform);
+    OnPoolReuse(instance);
+    instance->SetIsActive(true);
+    return instance;
+}
+
+void PrefabManager::ReleasePooled(Actor* instance)
+{
+    if (instance == nullptr)
+        return;
+    if (!instance->HasPrefabLink() || !instance->IsPrefabRoot())
+    {
+        instance->DeleteObject();
+        return;
+    }
+    bool pooled = false;
+    PoolLocker.Lock();
+    auto& pool = Pool[instance->GetPrefabID()];
+    if (pool.Count() < PoolCapacity && !pool.Contains(instance))
+    {
+        pool.Add(instance);
+        pooled = true;
+    }
+    PoolLocker.Unlock();
+    if (pooled)
+        instance->SetIsActive(false);
+    else
+        instance->DeleteObject();
+}
+
+void PrefabManager::ClearPool(Prefab* prefab)
+{
+    Array<ScriptingObjectReference<Actor>> instances;
+    PoolLocker.Lock();
+    if (prefab)
+    {
+        auto pool = Pool.TryGet(prefab->GetID());
+        if (pool)
+            instances.Add(*pool);
+        Pool.Remove(prefab->GetID());
+    }
+    else
+    {
+        for (auto& e : Pool)
+            instances.Add(e.Value);
+        Pool.Clear();
+    }
+    PoolLocker.Unlock();
+    for (auto& instance : instances)
+    {
+        if (instance)
+            instance->DeleteObject();
+    }
+}
+
 Actor* PrefabManager::SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid, const void*>* objectsCache, bool withSynchronization)
 {
     PROFILE_CPU_NAMED("Prefab.Spawn");
@@ -132,6 +238,7 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid
         objectsCache->SetCapacity(prefab->ObjectsDataCache.Capacity());
     }
     auto& data = *prefab->Data;
+    const auto& objectsTypes = prefab->GetObjectsTypes();
     SceneObjectsFactory::Context context(modifier.Value);
 
     // Deserialize prefab objects
@@ -140,7 +247,18 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid
     for (int32 i = 0; i < objectsCount; i++)
     {
         auto& stream = data[i];
-        auto obj = SceneObjectsFactory::Spawn(context, stream);
+        SceneObject* obj;
+        const ScriptingTypeHandle type = objectsTypes[i];
+        if (type)
+        {
+            // Fast-path for objects with a cached type (skips type lookup by name)
+            const ScriptingObjectSpawnParams params(modifier->IdsMapping[prefab->ObjectsIds[i]], type);
+            obj = (SceneObject*)type.GetType().Script.Spawn(params);
+        }
+        else
+        {
+            obj = SceneObjectsFactory::Spawn(context, stream);
+        }
         sceneObjects->At(i) = obj;
         if (obj)
             obj->RegisterObject();
@@ -148,6 +266,7 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid
             SceneObjectsFactory::HandleObjectDeserializationError(stream);
     }
     SceneObjectsFactory::PrefabSyncData prefabSyncData(*sceneObjects.Value, data, modifier.Value);
+    withSynchronization &= prefab->NestedPrefabs.HasItems(); // Synchronization applies only to the nested prefab instances
     if (withSynchronization)
     {
         // Synchronize new prefab instances (prefab may have new objects added so deserialized instances need to synchronize with it)
@@ -251,12 +370,11 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid
     // Link objects to prefab (only deserialized from prefab data)
     for (int32 i = 0; i < objectsCount; i++)
     {
-        auto& stream = data[i];
         SceneObject* obj = sceneObjects->At(i);
         if (!obj)
             continue;
 
-        const auto prefabObjectId = JsonTools::GetGuid(stream, "ID");
+        const Guid prefabObjectId = prefab->ObjectsIds[i];
 
         if (objectsCache)
             objectsCache->Add(prefabObjectId, obj);
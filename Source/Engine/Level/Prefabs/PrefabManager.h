@@ -85,6 +85,33 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(PrefabManager);
     /// <returns>The created actor (root) or null if failed.</returns>
     static Actor* SpawnPrefab(Prefab* prefab, Actor* parent, Dictionary<Guid, const void*, HeapAllocation>* objectsCache, bool withSynchronization = false);
 
+public:
+    /// <summary>
+    /// The maximum amount of the dormant prefab instances kept in the pool (per prefab).
+    /// </summary>
+    API_FIELD() static int32 PoolCapacity;
+
+    /// <summary>
+    /// Spawns the instance of the prefab objects by reusing the instance from the pool (see ReleasePooled) or spawns a new one if pool is empty. Reused instances stay registered in the engine (scripting, rendering, physics) so it's faster than spawning a new object. Scripts get OnPoolReuse called to reset the state.
+    /// </summary>
+    /// <param name="prefab">The prefab asset.</param>
+    /// <param name="parent">The parent actor to add spawned object instance.</param>
+    /// <param name="transform">The spawn transformation in the world space.</param>
+    /// <returns>The created actor (root) or null if failed.</returns>
+    API_FUNCTION() static Actor* SpawnPooled(Prefab* prefab, Actor* parent, const Transform& transform);
+
+    /// <summary>
+    /// Returns the prefab instance to the pool. Instance gets deactivated and stays dormant until reused by SpawnPooled. Deletes the object if it's not a root of the prefab instance or the pool is full.
+    /// </summary>
+    /// <param name="instance">The prefab instance root actor.</param>
+    API_FUNCTION() static void ReleasePooled(Actor* instance);
+
+    /// <summary>
+    /// Deletes the dormant instances from the pool.
+    /// </summary>
+    /// <param name="prefab">The prefab to clear its pool. Null to clear the pool for all prefabs.</param>
+    API_FUNCTION() static void ClearPool(Prefab* prefab = nullptr);
+
 #if USE_EDITOR
 
     /// <summary>
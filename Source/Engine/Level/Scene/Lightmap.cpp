@@ -27,6 +27,7 @@ void LightmapSettings::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(CompressLightmaps);
     SERIALIZE(UseGeometryWithNoMaterials);
     SERIALIZE(Quality);
+    SERIALIZE(BakeMode);
 }
 
 void LightmapSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -39,6 +40,7 @@ void LightmapSettings::Deserialize(DeserializeStream& stream, ISerializeModifier
     DESERIALIZE(CompressLightmaps);
     DESERIALIZE(UseGeometryWithNoMaterials);
     DESERIALIZE(Quality);
+    DESERIALIZE(BakeMode);
 }
 
 Lightmap::Lightmap(SceneLightmapsData* manager, int32 index, const SavedLightmapInfo& info)
@@ -1,13 +1,22 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #define SCENE_RENDERING_USE_PROFILER_PER_ACTOR 0
+#define SCENE_RENDERING_STATIC_CELL_SIZE 5000.0f
+#define SCENE_RENDERING_STATIC_REGION_SIZE (SCENE_RENDERING_STATIC_CELL_SIZE * 4)
+#define SCENE_RENDERING_STATIC_CELL_PARTIAL 1
+#define SCENE_RENDERING_STATIC_CELL_INSIDE 2
 
 #include "SceneRendering.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderView.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Level/Actors/StaticModel.h"
+#include "Engine/Level/Actors/AnimatedModel.h"
+#include "Engine/Streaming/Streaming.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Engine/Globals.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
 ISceneRenderingListener::~ISceneRenderingListener()
@@ -27,16 +36,27 @@ void ISceneRenderingListener::ListenSceneRendering(SceneRendering* scene)
     }
 }
 
-FORCE_INLINE bool FrustumsListCull(const BoundingSphere& bounds, const Array<BoundingFrustum>& frustums)
+FORCE_INLINE uint64 GetStaticCellKey(const Vector3& position, Real cellSize = SCENE_RENDERING_STATIC_CELL_SIZE)
 {
-    const int32 count = frustums.Count();
-    const BoundingFrustum* data = frustums.Get();
-    for (int32 i = 0; i < count; i++)
+    const int32 x = (int32)Math::Floor(position.X / cellSize);
+    const int32 y = (int32)Math::Floor(position.Y / cellSize);
+    const int32 z = (int32)Math::Floor(position.Z / cellSize);
+    return (uint64)(x & 0x1fffff) | ((uint64)(y & 0x1fffff) << 21) | ((uint64)(z & 0x1fffff) << 42);
+}
+
+FORCE_INLINE ContainmentType FrustumsListContains(const BoundingSphere& bounds, const BoundingFrustum* frustums, int32 frustumsCount)
+{
+    // Actors are drawn if intersect with any frustum so bounds fully inside a single frustum don't need per-actor culling
+    ContainmentType result = ContainmentType::Disjoint;
+    for (int32 i = 0; i < frustumsCount; i++)
     {
-        if (data[i].Intersects(bounds))
-            return true;
+        const ContainmentType containment = frustums[i].Contains(bounds);
+        if (containment == ContainmentType::Contains)
+            return ContainmentType::Contains;
+        if (containment == ContainmentType::Intersects)
+            result = ContainmentType::Intersects;
     }
-    return false;
+    return result;
 }
 
 void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory category)
@@ -44,6 +64,11 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     ScopeLock lock(Locker);
     if (category == PreRender)
     {
+        // Apply pending actors updates before drawing the scene (once per frame to not modify bounds used by the async drawing)
+        // Pipelined rendering flushes them on a main thread when extracting the frame so the simulation of the next frame is not visible here
+        if (Globals::RenderThreadID == Globals::MainThreadID)
+            FlushUpdates();
+
         // Register scene
         for (const auto& renderContext : renderContextBatch.Contexts)
             renderContext.List->Scenes.Add(this);
@@ -58,8 +83,10 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     }
     auto& view = renderContextBatch.GetMainContext().View;
     auto& list = Actors[(int32)category];
+    const int32 listSize = list.Count();
     _drawListData = list.Get();
-    _drawListSize = list.Count();
+    _drawListSize = listSize;
+    _drawKeysData = nullptr;
     _drawBatch = &renderContextBatch;
 
     // Setup frustum data
@@ -70,17 +97,46 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
 
     // Draw all visual components
     _drawListIndex = -1;
-    if (_drawListSize >= 64 && category == SceneDrawAsync && renderContextBatch.EnableAsync)
+    if (category == SceneDrawAsync)
     {
-        // Run in async via Job System
-        Function<void(int32)> func;
-        func.Bind<SceneRendering, &SceneRendering::DrawActorsJob>(this);
-        const uint64 waitLabel = JobSystem::Dispatch(func, JobSystem::GetThreadsCount());
-        renderContextBatch.WaitLabels.Add(waitLabel);
+        // Cull static cells hierarchy first to draw only the actors from the visible cells (and the unclustered ones)
+        _drawListSize = 0;
+        Function<void(int32)> cullFunc;
+        cullFunc.Bind<SceneRendering, &SceneRendering::CullStaticCellsJob>(this);
+        if (listSize >= 64 && renderContextBatch.EnableAsync)
+        {
+            // Run in async via Job System (culling job followed by drawing jobs)
+            Function<void(int32)> func;
+            func.Bind<SceneRendering, &SceneRendering::DrawActorsJob>(this);
+            const int64 cullLabel = JobSystem::Dispatch(cullFunc);
+            const int64 waitLabel = JobSystem::Dispatch(func, ToSpan(&cullLabel, 1), JobSystem::GetThreadsCount());
+            renderContextBatch.WaitLabels.Add(waitLabel);
+        }
+        else
+        {
+            // Scene is small so draw on a main-thread
+            CullStaticCellsJob(0);
+            DrawActorsJob(0);
+        }
+
+        // Prefetch models visible from the predicted main view position (including the ones culled now, not only the drawn ones)
+        if (renderContextBatch.GetMainContext().Task == MainRenderTask::Instance && EnumHasAnyFlags(view.Pass, DrawPass::GBuffer) && !view.IsOfflinePass && !Streaming::GetViewPredictionOffset().IsZero())
+        {
+            if (listSize >= 64 && renderContextBatch.EnableAsync)
+            {
+                Function<void(int32)> prefetchFunc;
+                prefetchFunc.Bind<SceneRendering, &SceneRendering::PrefetchActorsJob>(this);
+                renderContextBatch.WaitLabels.Add(JobSystem::Dispatch(prefetchFunc));
+            }
+            else
+            {
+                PrefetchActorsJob(0);
+            }
+        }
     }
     else
     {
-        // Scene is small so draw on a main-thread
+        CullActors(category);
         DrawActorsJob(0);
     }
 
@@ -122,6 +178,23 @@ void SceneRendering::Clear()
     _listeners.Clear();
     for (auto& e : Actors)
         e.Clear();
+    for (auto& e : _actorsBounds)
+    {
+        e.X.Clear();
+        e.Y.Clear();
+        e.Z.Clear();
+        e.Radius.Clear();
+    }
+    _pendingLocker.Lock();
+    for (auto& e : _pendingUpdates)
+        e.Clear();
+    _pendingLocker.Unlock();
+    _staticCells.Clear();
+    _staticCellsMap.Clear();
+    _staticRegions.Clear();
+    _staticRegionsMap.Clear();
+    _unclusteredActors.Clear();
+    _drawKeys.Clear();
 #if USE_EDITOR
     PhysicsDebug.Clear();
 #endif
@@ -142,35 +215,82 @@ void SceneRendering::AddActor(Actor* a, int32& key)
             break;
     }
     if (key == list.Count())
+    {
         list.AddOne();
+        auto& bounds = _actorsBounds[category];
+        bounds.X.AddOne();
+        bounds.Y.AddOne();
+        bounds.Z.AddOne();
+        bounds.Radius.AddOne();
+    }
     auto& e = list[key];
     e.Actor = a;
     e.LayerMask = a->GetLayerMask();
     e.Bounds = a->GetSphere();
+    SetActorBounds(category, key, e.Bounds);
     e.NoCulling = a->_drawNoCulling;
+    e.Updated = 0;
+    e.Cell = -1;
+    e.CellItem = -1;
+    if (category == SceneDrawAsync)
+        UpdateStaticCell(a, e, key);
     for (auto* listener : _listeners)
         listener->OnSceneRenderingAddActor(a);
 }
 
 void SceneRendering::UpdateActor(Actor* a, int32 key)
 {
+    if (key == -1)
+        return;
     const int32 category = a->_drawCategory;
+    ScopeLock lock(_pendingLocker);
+    _pendingUpdates[category].Add(key);
+}
+
+void SceneRendering::FlushUpdates()
+{
     ScopeLock lock(Locker);
-    auto& list = Actors[category];
-    if (list.IsEmpty())
-        return;
-    auto& e = list[key];
-    ASSERT_LOW_LAYER(a == e.Actor);
-    for (auto* listener : _listeners)
-        listener->OnSceneRenderingUpdateActor(a, e.Bounds);
-    e.LayerMask = a->GetLayerMask();
-    e.Bounds = a->GetSphere();
+    for (int32 category = 0; category < MAX; category++)
+    {
+        auto& pending = _flushUpdates;
+        _pendingLocker.Lock();
+        Swap(pending, _pendingUpdates[category]);
+        _pendingLocker.Unlock();
+        if (pending.IsEmpty())
+            continue;
+        PROFILE_CPU_NAMED("UpdateActors");
+        auto& list = Actors[category];
+        for (const int32 key : pending)
+        {
+            if (key >= list.Count())
+                continue;
+            auto& e = list.Get()[key];
+            Actor* a = e.Actor;
+            if (!a || e.Updated)
+                continue; // Skip removed or already updated actors (multiple updates of the same actor get merged)
+            e.Updated = 1;
+            for (auto* listener : _listeners)
+                listener->OnSceneRenderingUpdateActor(a, e.Bounds);
+            e.LayerMask = a->GetLayerMask();
+            e.Bounds = a->GetSphere();
+            SetActorBounds(category, key, e.Bounds);
+            if (category == SceneDrawAsync)
+                UpdateStaticCell(a, e, key);
+        }
+        for (const int32 key : pending)
+        {
+            if (key < list.Count())
+                list.Get()[key].Updated = 0;
+        }
+        pending.Clear();
+    }
 }
 
 void SceneRendering::RemoveActor(Actor* a, int32& key)
 {
     const int32 category = a->_drawCategory;
     ScopeLock lock(Locker);
+    FlushUpdates(); // Apply pending bounds changes before the removal (listeners use the last bounds)
     auto& list = Actors[category];
     if (list.HasItems())
     {
@@ -178,15 +298,253 @@ void SceneRendering::RemoveActor(Actor* a, int32& key)
         ASSERT_LOW_LAYER(a == e.Actor);
         for (auto* listener : _listeners)
             listener->OnSceneRenderingRemoveActor(a);
+        if (e.CellItem != -1)
+            UnlinkStaticCell(e);
         e.Actor = nullptr;
         e.LayerMask = 0;
     }
     key = -1;
 }
 
-#define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; auto e = _drawListData[index];
-#define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, _drawFrustumsData)))
-#define CHECK_ACTOR_SINGLE_FRUSTUM ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || view.CullingFrustum.Intersects(e.Bounds)))
+void SceneRendering::UpdateStaticCell(Actor* a, DrawActor& e, int32 key)
+{
+    // Only static actors (that rarely change bounds) of a reasonable size can be clustered
+    int32 cellIndex = -1;
+    if (!e.NoCulling && EnumHasAllFlags(a->GetStaticFlags(), StaticFlags::Transform) && e.Bounds.Radius <= SCENE_RENDERING_STATIC_CELL_SIZE)
+    {
+        const uint64 cellKey = GetStaticCellKey(e.Bounds.Center);
+        if (!_staticCellsMap.TryGet(cellKey, cellIndex))
+        {
+            const uint64 regionKey = GetStaticCellKey(e.Bounds.Center, SCENE_RENDERING_STATIC_REGION_SIZE);
+            int32 regionIndex;
+            if (!_staticRegionsMap.TryGet(regionKey, regionIndex))
+            {
+                regionIndex = _staticRegions.Count();
+                auto& region = _staticRegions.AddOne();
+                region.Cells.Clear();
+                region.Dirty = true;
+                region.Empty = true;
+                _staticRegionsMap.Add(regionKey, regionIndex);
+            }
+            cellIndex = _staticCells.Count();
+            auto& cell = _staticCells.AddOne();
+            cell.Actors.Clear();
+            cell.Region = regionIndex;
+            cell.Dirty = true;
+            _staticCellsMap.Add(cellKey, cellIndex);
+            _staticRegions[regionIndex].Cells.Add(cellIndex);
+        }
+    }
+    if (e.Cell != cellIndex || e.CellItem == -1)
+    {
+        if (e.CellItem != -1)
+            UnlinkStaticCell(e);
+        LinkStaticCell(e, key, cellIndex);
+    }
+    else if (cellIndex != -1)
+    {
+        // Bounds changed within the same cell
+        auto& cell = _staticCells[cellIndex];
+        cell.Dirty = true;
+        _staticRegions[cell.Region].Dirty = true;
+    }
+}
+
+void SceneRendering::LinkStaticCell(DrawActor& e, int32 key, int32 cellIndex)
+{
+    Array<int32>* list = &_unclusteredActors;
+    if (cellIndex != -1)
+    {
+        auto& cell = _staticCells[cellIndex];
+        cell.Dirty = true;
+        _staticRegions[cell.Region].Dirty = true;
+        list = &cell.Actors;
+    }
+    e.Cell = cellIndex;
+    e.CellItem = list->Count();
+    list->Add(key);
+}
+
+void SceneRendering::UnlinkStaticCell(DrawActor& e)
+{
+    Array<int32>* list = &_unclusteredActors;
+    if (e.Cell != -1)
+    {
+        auto& cell = _staticCells[e.Cell];
+        cell.Dirty = true;
+        _staticRegions[cell.Region].Dirty = true;
+        list = &cell.Actors;
+    }
+
+    // Swap-remove and fix the index of the moved actor
+    const int32 lastItem = list->Count() - 1;
+    if (e.CellItem != lastItem)
+    {
+        const int32 movedKey = list->Get()[lastItem];
+        list->Get()[e.CellItem] = movedKey;
+        Actors[SceneDrawAsync].Get()[movedKey].CellItem = e.CellItem;
+    }
+    list->RemoveLast();
+    e.Cell = -1;
+    e.CellItem = -1;
+}
+
+void SceneRendering::SetActorBounds(int32 category, int32 key, const BoundingSphere& bounds)
+{
+    auto& e = _actorsBounds[category];
+    e.X.Get()[key] = (float)bounds.Center.X;
+    e.Y.Get()[key] = (float)bounds.Center.Y;
+    e.Z.Get()[key] = (float)bounds.Center.Z;
+    e.Radius.Get()[key] = (float)bounds.Radius;
+}
+
+void SceneRendering::CullActors(int32 category)
+{
+    PROFILE_CPU();
+    const auto& view = _drawBatch->GetMainContext().View;
+    const auto& bounds = _actorsBounds[category];
+    const int32 count = bounds.Radius.Count();
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const BoundingFrustum* frustums = _drawFrustumsData.Get();
+    _actorsVisibility.Resize(count, false);
+    if (count == 0 || frustumsCount == 0)
+        return;
+
+    // Test all actors bounds against the frustums in batches (actor is visible if intersects any frustum)
+    byte* visibility = _actorsVisibility.Get();
+    frustums[0].IntersectsSpheres(bounds.X.Get(), bounds.Y.Get(), bounds.Z.Get(), bounds.Radius.Get(), count, visibility, view.Origin);
+    if (frustumsCount > 1)
+    {
+        _actorsVisibilityTemp.Resize(count, false);
+        byte* temp = _actorsVisibilityTemp.Get();
+        for (int32 i = 1; i < frustumsCount; i++)
+        {
+            frustums[i].IntersectsSpheres(bounds.X.Get(), bounds.Y.Get(), bounds.Z.Get(), bounds.Radius.Get(), count, temp, view.Origin);
+            for (int32 j = 0; j < count; j++)
+                visibility[j] |= temp[j];
+        }
+    }
+}
+
+void SceneRendering::CullStaticCellsJob(int32)
+{
+    PROFILE_CPU();
+    CullActors(SceneDrawAsync);
+    const auto& view = _drawBatch->GetMainContext().View;
+    const int32 cellsCount = _staticCells.Count();
+    _staticCellsVisibility.Resize(cellsCount, false);
+    const DrawActor* actors = Actors[SceneDrawAsync].Get();
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const BoundingFrustum* frustums = _drawFrustumsData.Get();
+    byte* cellsVisibility = _staticCellsVisibility.Get();
+
+    // Unclustered actors are always tested individually
+    _drawKeys.Clear();
+    _drawKeys.Add(_unclusteredActors);
+
+    for (int32 regionIndex = 0; regionIndex < _staticRegions.Count(); regionIndex++)
+    {
+        auto& region = _staticRegions.Get()[regionIndex];
+        if (region.Dirty)
+        {
+            // Rebuild dirty cells bounds from the actors and then the region bounds from the cells
+            region.Dirty = false;
+            region.Empty = true;
+            for (const int32 cellIndex : region.Cells)
+            {
+                auto& cell = _staticCells.Get()[cellIndex];
+                if (cell.Actors.IsEmpty())
+                    continue;
+                if (cell.Dirty)
+                {
+                    cell.Dirty = false;
+                    cell.Bounds = actors[cell.Actors.Get()[0]].Bounds;
+                    for (int32 i = 1; i < cell.Actors.Count(); i++)
+                        BoundingSphere::Merge(cell.Bounds, actors[cell.Actors.Get()[i]].Bounds, cell.Bounds);
+                }
+                if (region.Empty)
+                    region.Bounds = cell.Bounds;
+                else
+                    BoundingSphere::Merge(region.Bounds, cell.Bounds, region.Bounds);
+                region.Empty = false;
+            }
+        }
+
+        // Cull the whole region
+        ContainmentType regionContainment = ContainmentType::Disjoint;
+        if (!region.Empty)
+        {
+            BoundingSphere bounds = region.Bounds;
+            bounds.Center -= view.Origin;
+            regionContainment = FrustumsListContains(bounds, frustums, frustumsCount);
+        }
+        if (regionContainment == ContainmentType::Disjoint)
+            continue; // Visibility of the culled cells is not used (their actors are not drawn)
+        for (const int32 cellIndex : region.Cells)
+        {
+            auto& cell = _staticCells.Get()[cellIndex];
+            ContainmentType containment = regionContainment;
+            if (containment == ContainmentType::Intersects && cell.Actors.HasItems())
+            {
+                BoundingSphere bounds = cell.Bounds;
+                bounds.Center -= view.Origin;
+                containment = FrustumsListContains(bounds, frustums, frustumsCount);
+            }
+            if (containment == ContainmentType::Disjoint || cell.Actors.IsEmpty())
+                continue;
+            cellsVisibility[cellIndex] = containment == ContainmentType::Contains ? SCENE_RENDERING_STATIC_CELL_INSIDE : SCENE_RENDERING_STATIC_CELL_PARTIAL;
+            _drawKeys.Add(cell.Actors);
+        }
+    }
+
+    _drawKeysData = _drawKeys.Get();
+    _drawListSize = _drawKeys.Count();
+}
+
+void SceneRendering::PrefetchActorsJob(int32)
+{
+    PROFILE_CPU();
+    const auto& mainContext = _drawBatch->GetMainContext();
+    const auto& view = mainContext.View;
+
+    // Test actors against the view frustum moved by the prediction offset (equal to moving the bounds back by it)
+    const Vector3 origin = view.Origin + Streaming::GetViewPredictionOffset();
+    const DrawActor* actors = Actors[SceneDrawAsync].Get();
+    const int32 actorsCount = Actors[SceneDrawAsync].Count();
+    for (int32 i = 0; i < actorsCount; i++)
+    {
+        const DrawActor& e = actors[i];
+        if ((view.RenderLayersMask.Mask & e.LayerMask) == 0)
+            continue;
+        const BoundingSphere bounds(e.Bounds.Center - origin, e.Bounds.Radius);
+        if (!e.NoCulling && !view.CullingFrustum.Intersects(bounds))
+            continue;
+        if (const auto staticModel = dynamic_cast<StaticModel*>(e.Actor))
+        {
+            const Model* model = staticModel->Model.Get();
+            if (model && model->IsLoaded() && staticModel->GetForcedLOD() == -1)
+            {
+                const int32 lodIndex = RenderTools::ComputeModelLOD(model, bounds.Center, (float)bounds.Radius, mainContext);
+                if (lodIndex != -1)
+                    model->PrefetchLOD(lodIndex + staticModel->GetLODBias() + view.ModelLODBias);
+            }
+        }
+        else if (const auto animatedModel = dynamic_cast<AnimatedModel*>(e.Actor))
+        {
+            const SkinnedModel* model = animatedModel->SkinnedModel.Get();
+            if (model && model->IsLoaded() && animatedModel->ForcedLOD == -1)
+            {
+                const int32 lodIndex = RenderTools::ComputeSkinnedModelLOD(model, bounds.Center, (float)bounds.Radius, mainContext);
+                if (lodIndex != -1)
+                    model->PrefetchLOD(lodIndex + animatedModel->LODBias + view.ModelLODBias);
+            }
+        }
+    }
+}
+
+#define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; const int32 key = _drawKeysData ? _drawKeysData[index] : (int32)index; auto e = _drawListData[key];
+#define CHECK_CELL(test) (e.Cell == -1 ? (test) : (cells[e.Cell] == SCENE_RENDERING_STATIC_CELL_INSIDE || (cells[e.Cell] == SCENE_RENDERING_STATIC_CELL_PARTIAL && (test))))
+#define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || CHECK_CELL(visibility[key])))
 #if SCENE_RENDERING_USE_PROFILER_PER_ACTOR
 #define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(e.Actor); e.Actor->Draw(mode)
 #else
@@ -198,11 +556,12 @@ void SceneRendering::DrawActorsJob(int32)
     PROFILE_CPU();
     auto& mainContext = _drawBatch->GetMainContext();
     const auto& view = mainContext.View;
+    const byte* cells = _staticCellsVisibility.Get();
+    const byte* visibility = _actorsVisibility.Get(); // Frustum culling results from CullActors
     if (view.IsOfflinePass)
     {
         // Offline pass with additional static flags culling
         FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
             if (CHECK_ACTOR && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) != StaticFlags::None)
             {
                 DRAW_ACTOR(*_drawBatch);
@@ -211,29 +570,18 @@ void SceneRendering::DrawActorsJob(int32)
     }
     else if (view.Origin.IsZero() && _drawFrustumsData.Count() == 1)
     {
-        // Fast path for no origin shifting with a single context
+        // Fast path for no origin shifting with a single context (can use occlusion culling of the whole actor)
         FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR_SINGLE_FRUSTUM)
+            if (CHECK_ACTOR && (e.NoCulling || !mainContext.List->IsOccluded(e.Bounds)))
             {
                 DRAW_ACTOR(mainContext);
             }
         }
     }
-    else if (view.Origin.IsZero())
-    {
-        // Fast path for no origin shifting
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR)
-            {
-                DRAW_ACTOR(*_drawBatch);
-            }
-        }
-    }
     else
     {
-        // Generic case
+        // Generic case (origin shifting is already applied by the batched culling)
         FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
             if (CHECK_ACTOR)
             {
                 DRAW_ACTOR(*_drawBatch);
@@ -243,5 +591,6 @@ void SceneRendering::DrawActorsJob(int32)
 }
 
 #undef FOR_EACH_BATCH_ACTOR
+#undef CHECK_CELL
 #undef CHECK_ACTOR
 #undef DRAW_ACTOR
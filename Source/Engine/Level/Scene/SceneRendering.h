@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Delegate.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Math/BoundingSphere.h"
 #include "Engine/Core/Math/BoundingFrustum.h"
 #include "Engine/Level/Actor.h"
@@ -73,6 +74,9 @@ class FLAXENGINE_API SceneRendering
         Actor* Actor;
         uint32 LayerMask;
         int8 NoCulling : 1;
+        int8 Updated : 1; // Used internally during pending updates flush
+        int32 Cell; // Index of the static actors cell or -1 if not clustered
+        int32 CellItem; // Index of the actor in the cell actors list (or in the unclustered actors list if not clustered), -1 if not linked (categories other than SceneDrawAsync)
         BoundingSphere Bounds;
     };
 
@@ -102,6 +106,11 @@ class FLAXENGINE_API SceneRendering
     friend ISceneRenderingListener;
     Array<ISceneRenderingListener*, InlinedAllocation<8>> _listeners;
 
+    // Actors updates queued to be applied in a single batch
+    CriticalSection _pendingLocker;
+    Array<int32> _pendingUpdates[MAX];
+    Array<int32> _flushUpdates;
+
 public:
     /// <summary>
     /// Draws the scene. Performs the optimized actors culling and draw calls submission for the current render pass (defined by the render view).
@@ -121,11 +130,22 @@ class FLAXENGINE_API SceneRendering
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Applies the pending actors updates (bounds and layer changes queued by UpdateActor). Called automatically before drawing the scene.
+    /// </summary>
+    void FlushUpdates();
+
 public:
     void AddActor(Actor* a, int32& key);
-    void UpdateActor(Actor* a, int32 key);
     void RemoveActor(Actor* a, int32& key);
 
+    /// <summary>
+    /// Queues the actor bounds and layer update. The update is deferred until the next scene drawing (or FlushUpdates call) which batches multiple changes of the same actor (eg. hierarchy of moving actors) and doesn't block on the scene rendering lock.
+    /// </summary>
+    /// <param name="a">The actor.</param>
+    /// <param name="key">The actor key in the scene rendering.</param>
+    void UpdateActor(Actor* a, int32 key);
+
     FORCE_INLINE void AddPostFxProvider(IPostFxSettingsProvider* obj)
     {
         PostFxProviders.Add(obj);
@@ -165,11 +185,55 @@ class FLAXENGINE_API SceneRendering
 #endif
 
 private:
+    // Static actors (from SceneDrawAsync category) are clustered into spatial grid cells to cull whole groups of them at once before the per-actor test
+    struct StaticCell
+    {
+        BoundingSphere Bounds;
+        Array<int32> Actors;
+        int32 Region;
+        bool Dirty;
+    };
+
+    // Cells are grouped into larger regions for hierarchical culling (regions outside the view skip testing their cells)
+    struct StaticRegion
+    {
+        BoundingSphere Bounds;
+        Array<int32> Cells;
+        bool Dirty;
+        bool Empty;
+    };
+
+    // Actors bounds in the structure-of-arrays layout (indexed by the Actors list keys) for the batched frustum culling
+    struct ActorsBounds
+    {
+        Array<float> X, Y, Z, Radius;
+    };
+
+    ActorsBounds _actorsBounds[MAX];
+    Array<byte> _actorsVisibility;
+    Array<byte> _actorsVisibilityTemp;
+
+    Array<StaticCell> _staticCells;
+    Dictionary<uint64, int32> _staticCellsMap;
+    Array<byte> _staticCellsVisibility;
+    Array<StaticRegion> _staticRegions;
+    Dictionary<uint64, int32> _staticRegionsMap;
+    Array<int32> _unclusteredActors;
+
     Array<BoundingFrustum> _drawFrustumsData;
+    Array<int32> _drawKeys;
     DrawActor* _drawListData;
+    const int32* _drawKeysData;
     int64 _drawListSize;
     volatile int64 _drawListIndex;
     RenderContextBatch* _drawBatch;
 
+    void UpdateStaticCell(Actor* a, DrawActor& e, int32 key);
+    void LinkStaticCell(DrawActor& e, int32 key, int32 cellIndex);
+    void UnlinkStaticCell(DrawActor& e);
+    void SetActorBounds(int32 category, int32 key, const BoundingSphere& bounds);
+    void CullActors(int32 category);
+    void CullStaticCellsJob(int32);
     void DrawActorsJob(int32);
+    void PrefetchActorsJob(int32);
 };
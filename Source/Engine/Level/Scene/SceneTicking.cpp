@@ -3,16 +3,84 @@
 #include "SceneTicking.h"
 #include "Scene.h"
 #include "Engine/Scripting/Script.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Engine/Time.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
+#if USE_MONO
+#include "Engine/Debug/DebugLog.h"
+#include "Engine/Scripting/Scripting.h"
+#include "Engine/Scripting/ManagedCLR/MClass.h"
+#include "Engine/Scripting/ManagedCLR/MMethod.h"
+#include <ThirdParty/mono-2.0/mono/metadata/appdomain.h>
+#include <ThirdParty/mono-2.0/mono/metadata/object.h>
 
-SceneTicking::TickData::TickData(int32 capacity)
+namespace
+{
+    // The managed scripts update batching state (used only from the main thread)
+    bool BatchBound = false;
+    MMethod* BatchMethod = nullptr;
+    MonoArray* BatchArray = nullptr;
+    uint32 BatchArrayHandle = 0;
+    int32 BatchArrayCapacity = 0;
+    Array<MonoObject*> BatchObjects;
+
+    void OnBatchScriptsUnload()
+    {
+        if (BatchArrayHandle)
+            mono_gchandle_free(BatchArrayHandle);
+        BatchMethod = nullptr;
+        BatchArray = nullptr;
+        BatchArrayHandle = 0;
+        BatchArrayCapacity = 0;
+    }
+
+    void FlushBatch()
+    {
+        const int32 count = BatchObjects.Count();
+        if (count == 0)
+            return;
+        PROFILE_CPU_NAMED("Managed Scripts Batch");
+        if (BatchArrayCapacity < count)
+        {
+            // Use persistent array to prevent managed allocations every frame
+            OnBatchScriptsUnload();
+            BatchArrayCapacity = Math::RoundUpToPowerOf2(Math::Max(count, 64));
+            BatchArray = mono_array_new(mono_domain_get(), Script::GetStaticClass()->GetNative(), BatchArrayCapacity);
+            BatchArrayHandle = mono_gchandle_new((MonoObject*)BatchArray, true);
+        }
+        if (!BatchMethod)
+            BatchMethod = Script::GetStaticClass()->GetMethod("Internal_UpdateBatch", 2);
+        for (int32 i = 0; i < count; i++)
+            mono_array_setref(BatchArray, i, BatchObjects.Get()[i]);
+        MObject* exception = nullptr;
+        BatchMethod->InvokeThunk<void>(&exception, (MObject*)BatchArray, count);
+        DebugLog::LogException(exception);
+
+        // Release references to let GC collect removed scripts
+        for (int32 i = 0; i < count; i++)
+            mono_array_setref(BatchArray, i, nullptr);
+        BatchObjects.Clear();
+    }
+}
+#endif
+
+// Amount of parallel scripts updated by a single job
+#define SCENE_TICKING_PARALLEL_BATCH 32
+
+SceneTicking::TickData::TickData(int32 capacity, int32 slot)
     : Scripts(capacity)
     , Ticks(capacity)
+    , _slot(slot)
+    , _ticksLookup(capacity)
 {
 }
 
 void SceneTicking::TickData::AddScript(Script* script)
 {
-    Scripts.Add(script);
+    AddScriptToList(Scripts, _removedScripts, script);
 #if USE_EDITOR
     if (script->_executeInEditor)
         ScriptsExecuteInEditor.Add(script);
@@ -21,7 +89,7 @@ void SceneTicking::TickData::AddScript(Script* script)
 
 void SceneTicking::TickData::RemoveScript(Script* script)
 {
-    Scripts.Remove(script);
+    RemoveScriptFromList(Scripts, _removedScripts, script);
 #if USE_EDITOR
     if (script->_executeInEditor)
         ScriptsExecuteInEditor.Remove(script);
@@ -30,22 +98,30 @@ void SceneTicking::TickData::RemoveScript(Script* script)
 
 void SceneTicking::TickData::RemoveTick(void* callee)
 {
-    for (int32 i = 0; i < Ticks.Count(); i++)
+    int32 index;
+    if (_ticksLookup.TryGet(callee, index))
     {
-        if (Ticks[i].Callee == callee)
-        {
-            Ticks.RemoveAt(i);
-            break;
-        }
+        _ticksLookup.Remove(callee);
+        Ticks[index] = {};
+        _removedTicks++;
     }
 }
 
 void SceneTicking::TickData::Tick()
 {
+    CompactScripts(Scripts, _removedScripts);
+    CompactTicks();
+
+    _isTicking = true;
     TickScripts(Scripts);
 
     for (int32 i = 0; i < Ticks.Count(); i++)
-        Ticks[i].Call();
+    {
+        const auto& tick = Ticks.Get()[i];
+        if (tick.FunctionObj)
+            tick.Call();
+    }
+    _isTicking = false;
 }
 
 #if USE_EDITOR
@@ -64,6 +140,9 @@ void SceneTicking::TickData::RemoveTickExecuteInEditor(void* callee)
 
 void SceneTicking::TickData::TickExecuteInEditor()
 {
+    CompactScripts(Scripts, _removedScripts);
+    CompactTicks();
+
     TickScripts(ScriptsExecuteInEditor);
 
     for (int32 i = 0; i < TicksExecuteInEditor.Count(); i++)
@@ -80,44 +159,293 @@ void SceneTicking::TickData::Clear()
     ScriptsExecuteInEditor.Clear();
     TicksExecuteInEditor.Clear();
 #endif
+    _removedScripts = 0;
+    _removedTicks = 0;
+    _ticksLookup.Clear();
+}
+
+void SceneTicking::TickData::AddScriptToList(Array<Script*>& scripts, int32& removed, Script* script)
+{
+    // Compact the list if it gets too fragmented while not ticking (eg. when game is paused)
+    if (!_isTicking && removed > 64 && removed * 2 > scripts.Count())
+        CompactScripts(scripts, removed);
+
+    script->_tickIndex[_slot] = scripts.Count();
+    scripts.Add(script);
+}
+
+void SceneTicking::TickData::RemoveScriptFromList(Array<Script*>& scripts, int32& removed, Script* script)
+{
+    const int32 index = script->_tickIndex[_slot];
+    if (index >= 0 && index < scripts.Count() && scripts.Get()[index] == script)
+    {
+        scripts.Get()[index] = nullptr;
+        removed++;
+    }
+    script->_tickIndex[_slot] = -1;
+}
+
+void SceneTicking::TickData::CompactScripts(Array<Script*>& scripts, int32& removed)
+{
+    if (removed == 0)
+        return;
+    Script** data = scripts.Get();
+    int32 count = 0;
+    for (int32 i = 0; i < scripts.Count(); i++)
+    {
+        Script* script = data[i];
+        if (script)
+        {
+            script->_tickIndex[_slot] = count;
+            data[count++] = script;
+        }
+    }
+    scripts.Resize(count);
+    removed = 0;
+}
+
+void SceneTicking::TickData::CompactTicks()
+{
+    if (_removedTicks == 0)
+        return;
+    SceneTicking::Tick* data = Ticks.Get();
+    int32 count = 0;
+    for (int32 i = 0; i < Ticks.Count(); i++)
+    {
+        const SceneTicking::Tick& tick = data[i];
+        if (tick.FunctionObj)
+        {
+            if (count != i)
+                _ticksLookup[tick.Callee] = count;
+            data[count++] = tick;
+        }
+    }
+    Ticks.Resize(count);
+    _removedTicks = 0;
 }
 
 SceneTicking::FixedUpdateTickData::FixedUpdateTickData()
-    : TickData(512)
+    : TickData(512, 0)
 {
 }
 
 void SceneTicking::FixedUpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
-    for (auto* script : scripts)
+    for (int32 i = 0; i < scripts.Count(); i++)
     {
-        script->OnFixedUpdate();
+        // Skip scripts removed during ticking
+        Script* script = scripts.Get()[i];
+        if (script)
+            script->OnFixedUpdate();
     }
 }
 
 SceneTicking::UpdateTickData::UpdateTickData()
-    : TickData(1024)
+    : TickData(1024, 1)
 {
 }
 
 void SceneTicking::UpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
-    for (auto* script : scripts)
+#if USE_MONO
+    if (Level::BatchManagedScriptsUpdate && Script::GetStaticClass())
+    {
+        if (!BatchBound)
+        {
+            BatchBound = true;
+            Scripting::ScriptsUnload.Bind(&OnBatchScriptsUnload);
+        }
+
+        // Gather consecutive managed scripts into a batch (flush it before updating native script to keep the update order)
+        for (int32 i = 0; i < scripts.Count(); i++)
+        {
+            Script* script = scripts.Get()[i];
+            if (!script)
+                continue;
+            MonoObject* managed = EnumHasAnyFlags(script->Flags, ObjectFlags::IsManagedType) ? script->GetManagedInstance() : nullptr;
+            if (managed)
+            {
+                BatchObjects.Add(managed);
+            }
+            else
+            {
+                FlushBatch();
+                script->OnUpdate();
+            }
+        }
+        FlushBatch();
+        return;
+    }
+#endif
+    for (int32 i = 0; i < scripts.Count(); i++)
+    {
+        // Skip scripts removed during ticking
+        Script* script = scripts.Get()[i];
+        if (script)
+            script->OnUpdate();
+    }
+}
+
+void SceneTicking::UpdateTickData::AddScriptParallel(Script* script)
+{
+    AddScriptToList(ScriptsParallel, _removedScriptsParallel, script);
+#if USE_EDITOR
+    if (script->_executeInEditor)
+        ScriptsExecuteInEditor.Add(script);
+#endif
+}
+
+void SceneTicking::UpdateTickData::RemoveScriptParallel(Script* script)
+{
+    RemoveScriptFromList(ScriptsParallel, _removedScriptsParallel, script);
+#if USE_EDITOR
+    if (script->_executeInEditor)
+        ScriptsExecuteInEditor.Remove(script);
+#endif
+}
+
+void SceneTicking::UpdateTickData::TickScriptsParallel()
+{
+    CompactScripts(ScriptsParallel, _removedScriptsParallel);
+    const int32 count = ScriptsParallel.Count();
+    if (count == 0)
+        return;
+    PROFILE_CPU();
+    const int32 jobsCount = Math::DivideAndRoundUp(count, SCENE_TICKING_PARALLEL_BATCH);
+    if (jobsCount > 1)
+    {
+        Function<void(int32)> job;
+        job.Bind<UpdateTickData, &UpdateTickData::TickScriptsParallelJob>(this);
+        JobSystem::Execute(job, jobsCount);
+    }
+    else
+    {
+        TickScripts(ScriptsParallel);
+    }
+}
+
+void SceneTicking::UpdateTickData::TickScriptsParallelJob(int32 index)
+{
+    const int32 start = index * SCENE_TICKING_PARALLEL_BATCH;
+    const int32 end = Math::Min(start + SCENE_TICKING_PARALLEL_BATCH, ScriptsParallel.Count());
+    for (int32 i = start; i < end; i++)
+    {
+        Script* script = ScriptsParallel.Get()[i];
+        if (script)
+            script->OnUpdate();
+    }
+}
+
+void SceneTicking::UpdateTickData::AddScriptGroup(Script* script)
+{
+    const int32 groupIndex = script->_tickGroup;
+    if (Groups.Count() <= groupIndex)
+        Groups.Resize(groupIndex + 1);
+    auto& group = Groups[groupIndex];
+    AddScriptToList(group.Scripts, group.Removed, script);
+#if USE_EDITOR
+    if (script->_executeInEditor)
+        ScriptsExecuteInEditor.Add(script);
+#endif
+}
+
+void SceneTicking::UpdateTickData::RemoveScriptGroup(Script* script)
+{
+    const int32 groupIndex = script->_tickGroup;
+    if (groupIndex < Groups.Count())
     {
-        script->OnUpdate();
+        auto& group = Groups[groupIndex];
+        RemoveScriptFromList(group.Scripts, group.Removed, script);
     }
+#if USE_EDITOR
+    if (script->_executeInEditor)
+        ScriptsExecuteInEditor.Remove(script);
+#endif
+}
+
+void SceneTicking::UpdateTickData::TickScriptsGroups()
+{
+    if (Groups.IsEmpty())
+        return;
+    PROFILE_CPU();
+    const float deltaTime = Time::Update.UnscaledDeltaTime.GetTotalSeconds();
+    for (int32 groupIndex = 0; groupIndex < Groups.Count(); groupIndex++)
+    {
+        // Remove holes from the list (keep the cursor at the same script)
+        GroupData* group = &Groups[groupIndex];
+        if (group->Removed != 0)
+        {
+            int32 cursor = group->Cursor;
+            for (int32 i = 0; i < group->Cursor && i < group->Scripts.Count(); i++)
+            {
+                if (group->Scripts.Get()[i] == nullptr)
+                    cursor--;
+            }
+            CompactScripts(group->Scripts, group->Removed);
+            group->Cursor = cursor;
+        }
+        const int32 count = group->Scripts.Count();
+        if (count == 0)
+            continue;
+        if (group->Cursor >= count)
+            group->Cursor = 0;
+
+        // Calculate the amount of scripts to update this frame (missing group settings or zero rate update all scripts)
+        const TickGroup* settings = groupIndex < Level::TickGroups.Count() ? &Level::TickGroups[groupIndex] : nullptr;
+        int32 updatesCount = count;
+        if (settings && settings->UpdateFPS > ZeroTolerance)
+        {
+            group->Accumulator = Math::Min(group->Accumulator + (float)count * settings->UpdateFPS * deltaTime, (float)count);
+            updatesCount = (int32)group->Accumulator;
+        }
+        const double budgetEnd = settings && settings->Budget > ZeroTolerance ? Platform::GetTimeSeconds() + settings->Budget * 0.001 : 0.0;
+
+        // Update scripts in round-robin manner
+        _isTicking = true;
+        int32 updated = 0;
+        while (updated < updatesCount)
+        {
+            group = &Groups[groupIndex];
+            int32& cursor = group->Cursor;
+            if (cursor >= group->Scripts.Count())
+                cursor = 0;
+            Script* script = group->Scripts.Get()[cursor++];
+            updated++;
+            if (script)
+            {
+                script->OnUpdate();
+                if (budgetEnd > 0.0 && Platform::GetTimeSeconds() >= budgetEnd)
+                    break;
+            }
+        }
+        _isTicking = false;
+        group = &Groups[groupIndex];
+        if (settings && settings->UpdateFPS > ZeroTolerance)
+            group->Accumulator -= (float)updated;
+    }
+}
+
+void SceneTicking::UpdateTickData::Clear()
+{
+    TickData::Clear();
+    ScriptsParallel.Clear();
+    _removedScriptsParallel = 0;
+    Groups.Clear();
 }
 
 SceneTicking::LateUpdateTickData::LateUpdateTickData()
-    : TickData(64)
+    : TickData(64, 2)
 {
 }
 
 void SceneTicking::LateUpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
-    for (auto* script : scripts)
+    for (int32 i = 0; i < scripts.Count(); i++)
     {
-        script->OnLateUpdate();
+        // Skip scripts removed during ticking
+        Script* script = scripts.Get()[i];
+        if (script)
+            script->OnLateUpdate();
     }
 }
 
@@ -127,7 +455,14 @@ void SceneTicking::AddScript(Script* obj)
     if (obj->_tickFixedUpdate)
         FixedUpdate.AddScript(obj);
     if (obj->_tickUpdate)
-        Update.AddScript(obj);
+    {
+        if (obj->_tickParallelUpdate)
+            Update.AddScriptParallel(obj);
+        else if (obj->_tickGroup >= 0)
+            Update.AddScriptGroup(obj);
+        else
+            Update.AddScript(obj);
+    }
     if (obj->_tickLateUpdate)
         LateUpdate.AddScript(obj);
 }
@@ -138,7 +473,14 @@ void SceneTicking::RemoveScript(Script* obj)
     if (obj->_tickFixedUpdate)
         FixedUpdate.RemoveScript(obj);
     if (obj->_tickUpdate)
-        Update.RemoveScript(obj);
+    {
+        if (obj->_tickParallelUpdate)
+            Update.RemoveScriptParallel(obj);
+        else if (obj->_tickGroup >= 0)
+            Update.RemoveScriptGroup(obj);
+        else
+            Update.RemoveScript(obj);
+    }
     if (obj->_tickLateUpdate)
         LateUpdate.RemoveScript(obj);
 }
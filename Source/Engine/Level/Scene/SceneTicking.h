@@ -4,6 +4,7 @@
 
 #include "Engine/Level/Types.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
 
 /// <summary>
 /// Scene gameplay updating helper subsystem that boosts the level ticking by providing efficient objects cache.
@@ -44,6 +45,9 @@ class FLAXENGINE_API SceneTicking
     /// <summary>
     /// Ticking data container.
     /// </summary>
+    /// <remarks>
+    /// Scripts and ticks are removed in O(1) by clearing their entry (scripts keep their index in the list, ticks are indexed by the callee). Removed entries are skipped when ticking and the lists are compacted (preserving the order) before the next tick.
+    /// </remarks>
     class FLAXENGINE_API TickData
     {
     public:
@@ -54,7 +58,7 @@ class FLAXENGINE_API SceneTicking
         Array<Tick> TicksExecuteInEditor;
 #endif
 
-        TickData(int32 capacity);
+        TickData(int32 capacity, int32 slot);
 
         virtual void TickScripts(const Array<Script*>& scripts) = 0;
 
@@ -66,6 +70,7 @@ class FLAXENGINE_API SceneTicking
         {
             SceneTicking::Tick tick;
             tick.Bind<T, Method>(callee);
+            _ticksLookup[callee] = Ticks.Count();
             Ticks.Add(tick);
         }
 
@@ -86,6 +91,19 @@ class FLAXENGINE_API SceneTicking
 #endif
 
         void Clear();
+
+    protected:
+        // Index of the entry in Script::_tickIndex used by this container
+        int32 _slot;
+        int32 _removedScripts = 0;
+        int32 _removedTicks = 0;
+        bool _isTicking = false;
+        Dictionary<void*, int32> _ticksLookup;
+
+        void AddScriptToList(Array<Script*>& scripts, int32& removed, Script* script);
+        void RemoveScriptFromList(Array<Script*>& scripts, int32& removed, Script* script);
+        void CompactScripts(Array<Script*>& scripts, int32& removed);
+        void CompactTicks();
     };
 
     class FLAXENGINE_API FixedUpdateTickData : public TickData
@@ -98,8 +116,41 @@ class FLAXENGINE_API SceneTicking
     class FLAXENGINE_API UpdateTickData : public TickData
     {
     public:
+        /// <summary>
+        /// The scripts marked with ParallelUpdate attribute that are updated from the Job System before the other scripts and ticks (which act as the main-thread sync phase).
+        /// </summary>
+        Array<Script*> ScriptsParallel;
+
+        /// <summary>
+        /// The scripts tick group data (see Level::TickGroups).
+        /// </summary>
+        struct GroupData
+        {
+            Array<Script*> Scripts;
+            int32 Removed = 0;
+            int32 Cursor = 0;
+            float Accumulator = 0.0f;
+        };
+
+        /// <summary>
+        /// The scripts assigned to the tick groups (indexed by the group index) that are updated at the custom rate with time-slicing across frames (after the other scripts and ticks).
+        /// </summary>
+        Array<GroupData> Groups;
+
         UpdateTickData();
         void TickScripts(const Array<Script*>& scripts) override;
+        void AddScriptParallel(Script* script);
+        void RemoveScriptParallel(Script* script);
+        void TickScriptsParallel();
+        void AddScriptGroup(Script* script);
+        void RemoveScriptGroup(Script* script);
+        void TickScriptsGroups();
+        void Clear();
+
+    private:
+        int32 _removedScriptsParallel = 0;
+
+        void TickScriptsParallelJob(int32 index);
     };
 
     class FLAXENGINE_API LateUpdateTickData : public TickData
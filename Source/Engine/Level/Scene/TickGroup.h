@@ -0,0 +1,33 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/ISerializable.h"
+
+/// <summary>
+/// Settings container for a group of scripts updated at the custom rate. Scripts in the group get their OnUpdate called in a round-robin manner spread across the frames (time-slicing) which is useful for a lot of the low-priority logic (eg. AI).
+/// </summary>
+API_STRUCT() struct TickGroup : ISerializable
+{
+API_AUTO_SERIALIZATION();
+DECLARE_SCRIPTING_TYPE_MINIMAL(TickGroup);
+
+    /// <summary>
+    /// The name of the group.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10)")
+    String Name;
+
+    /// <summary>
+    /// The target amount of updates per second of each script in the group. Scripts updates are spread evenly across the frames. Value 0 means that all scripts are updated every frame.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(0, 1000)")
+    float UpdateFPS = 10.0f;
+
+    /// <summary>
+    /// The maximum time (in milliseconds) that can be spent on updating scripts in the group within a single frame (per scene). The remaining scripts are updated in the next frames. Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0, 1000, 0.01f)")
+    float Budget = 0.0f;
+};
@@ -61,6 +61,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API SceneObject : public Scripting
     friend Actor;
     friend Level;
     friend ScriptsFactory;
+    friend class SceneObjectsFactory;
     friend SceneTicking;
 public:
     typedef ScriptingObject Base;
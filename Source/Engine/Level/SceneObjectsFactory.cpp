@@ -5,10 +5,11 @@
 #include "Engine/Level/Prefabs/Prefab.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Serialization/JsonTools.h"
 #include "Engine/Serialization/ISerializeModifier.h"
-#include "Engine/Serialization/SerializationFwd.h"
+#include "Engine/Serialization/Serialization.h"
 #include "Engine/Serialization/JsonWriters.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/ThreadLocal.h"
@@ -18,14 +19,21 @@ SceneObjectsFactory::Context::Context(ISerializeModifier* modifier)
 {
 }
 
+SceneObjectsFactory::Context::Context(ISerializeModifier* modifier, const Context& source)
+    : Modifier(modifier)
+    , Source(source.Source ? source.Source : &source)
+{
+}
+
 void SceneObjectsFactory::Context::SetupIdsMapping(const SceneObject* obj)
 {
+    const Context& tables = Source ? *Source : *this;
     int32 instanceIndex;
-    if (ObjectToInstance.TryGet(obj->GetID(), instanceIndex) && instanceIndex != CurrentInstance)
+    if (tables.ObjectToInstance.TryGet(obj->GetID(), instanceIndex) && instanceIndex != CurrentInstance)
     {
         // Apply the current prefab instance objects ids table to resolve references inside a prefab properly
         CurrentInstance = instanceIndex;
-        auto& instance = Instances[instanceIndex];
+        auto& instance = tables.Instances[instanceIndex];
         for (auto& e : instance.IdsMapping)
             Modifier->IdsMapping[e.Key] = e.Value;
     }
@@ -197,20 +205,45 @@ void SceneObjectsFactory::Deserialize(Context& context, SceneObject* obj, ISeria
         Deserialize(context, obj, *(ISerializable::DeserializeStream*)prefabData);
     }
 
-    int32 instanceIndex;
-    if (context.ObjectToInstance.TryGet(obj->GetID(), instanceIndex) && instanceIndex != context.CurrentInstance)
-    {
-        // Apply the current prefab instance objects ids table to resolve references inside a prefab properly
-        context.CurrentInstance = instanceIndex;
-        auto& instance = context.Instances[instanceIndex];
-        for (auto& e : instance.IdsMapping)
-            context.Modifier->IdsMapping[e.Key] = e.Value;
-    }
+    context.SetupIdsMapping(obj);
 
     // Load data
     obj->Deserialize(stream, context.Modifier);
 }
 
+bool SceneObjectsFactory::SetupParent(Context& context, SceneObject* obj, ISerializable::DeserializeStream& stream)
+{
+    const auto member = stream.FindMember("ParentID");
+    if (member == stream.MemberEnd())
+        return false;
+    Guid parentId;
+    Serialization::Deserialize(member->value, parentId, context.Modifier);
+    const auto parent = Scripting::FindObject<Actor>(parentId);
+    if (!parent || obj->_parent == parent)
+        return false;
+
+    // Link object the same way as deserialization does for objects that are not during play (see Actor::Deserialize and Script::Deserialize)
+    if (const auto actor = dynamic_cast<Actor*>(obj))
+    {
+        if (actor->_parent)
+            actor->_parent->Children.RemoveKeepOrder(actor);
+        actor->_parent = parent;
+        parent->Children.Add(actor);
+    }
+    else if (const auto script = dynamic_cast<Script*>(obj))
+    {
+        if (script->_parent)
+            script->_parent->Scripts.RemoveKeepOrder(script);
+        script->_parent = parent;
+        parent->Scripts.Add(script);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
 void SceneObjectsFactory::HandleObjectDeserializationError(const ISerializable::DeserializeStream& value)
 {
     // Print invalid object data contents
@@ -24,8 +24,11 @@ class FLAXENGINE_API SceneObjectsFactory
         int32 CurrentInstance = -1;
         Array<PrefabInstance> Instances;
         Dictionary<Guid, int32> ObjectToInstance;
+        // The context that owns the prefab instances tables (used by the contexts that deserialize objects on job threads). Null if this context owns them.
+        const Context* Source = nullptr;
 
         Context(ISerializeModifier* modifier);
+        Context(ISerializeModifier* modifier, const Context& source);
 
         void SetupIdsMapping(const SceneObject* obj);
     };
@@ -45,6 +48,15 @@ class FLAXENGINE_API SceneObjectsFactory
     /// <param name="stream">The serialized data stream.</param>
     static void Deserialize(Context& context, SceneObject* obj, ISerializable::DeserializeStream& stream);
 
+    /// <summary>
+    /// Links the scene object with its parent actor (from the serialized data) without deserializing it. Used to build the objects hierarchy before deserializing objects on multiple threads. Doesn't call OnParentChanged for actors.
+    /// </summary>
+    /// <param name="context">The serialization context.</param>
+    /// <param name="obj">The instance to link.</param>
+    /// <param name="stream">The serialized data stream.</param>
+    /// <returns>True if object has been linked to the new parent, otherwise false.</returns>
+    static bool SetupParent(Context& context, SceneObject* obj, ISerializable::DeserializeStream& stream);
+
     /// <summary>
     /// Handles the object deserialization error.
     /// </summary>
@@ -86,8 +86,9 @@ API_CLASS(Static) class FLAXENGINE_API Tags
     API_FIELD(ReadOnly) static Array<String> List;
 
     /// <summary>
-    /// Gets or adds the tag.
+    /// Gets or adds the tag. Thread-safe (eg. used by actors deserialization on job threads).
     /// </summary>
+    /// <remarks>Adding a new tag can reallocate the tags list so the tag names read from the other threads (Tag::ToString) are safe only if no tags are added at the same time.</remarks>
     /// <param name="tagName">The tag name.</param>
     /// <returns>The tag.</returns>
     API_FUNCTION() static Tag Get(const StringView& tagName);
@@ -0,0 +1,221 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "WorldPartition.h"
+#include "Level.h"
+#include "Scene/Scene.h"
+#include "Actors/Camera.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
+#if USE_EDITOR
+#include "Editor/Editor.h"
+#endif
+
+bool WorldPartition::Enabled = false;
+float WorldPartition::LoadDistance = 50000.0f;
+float WorldPartition::UnloadDistance = 60000.0f;
+int32 WorldPartition::MaxLoadingCells = 2;
+int32 WorldPartition::MaxLoadedCells = 64;
+
+namespace WorldPartitionImpl
+{
+    struct CellCandidate
+    {
+        int32 Index;
+        int32 Priority;
+        Real Distance;
+
+        static bool Compare(const CellCandidate& a, const CellCandidate& b)
+        {
+            if (a.Priority != b.Priority)
+                return a.Priority > b.Priority;
+            return a.Distance < b.Distance;
+        }
+    };
+
+    Array<WorldPartitionCell> Cells;
+    Array<ScriptingObjectReference<Actor>> Sources;
+    HashSet<Guid> Loading;
+    HashSet<Guid> Loaded;
+    Array<Vector3> SourcesPositions;
+    Array<CellCandidate> Candidates;
+
+    void OnSceneLoaded(Scene* scene, const Guid& id)
+    {
+        if (Loading.Remove(id))
+            Loaded.Add(id);
+    }
+
+    void OnSceneLoadError(Scene* scene, const Guid& id)
+    {
+        Loading.Remove(id);
+    }
+
+    void OnSceneUnloaded(Scene* scene, const Guid& id)
+    {
+        Loaded.Remove(id);
+    }
+
+    Real GetDistance(const WorldPartitionCell& cell)
+    {
+        Real result = MAX_Real;
+        for (const Vector3& position : SourcesPositions)
+            result = Math::Min(result, cell.Bounds.Distance(position));
+        return result;
+    }
+}
+
+using namespace WorldPartitionImpl;
+
+class WorldPartitionService : public EngineService
+{
+public:
+    WorldPartitionService()
+        : EngineService(TEXT("World Partition"), 35)
+    {
+    }
+
+    bool Init() override;
+    void Update() override;
+    void Dispose() override;
+};
+
+WorldPartitionService WorldPartitionServiceInstance;
+
+const Array<WorldPartitionCell>& WorldPartition::GetCells()
+{
+    return Cells;
+}
+
+void WorldPartition::SetCells(const Array<WorldPartitionCell>& value)
+{
+    // Unload cells that are not used anymore
+    for (const WorldPartitionCell& cell : Cells)
+    {
+        bool used = false;
+        for (const WorldPartitionCell& e : value)
+        {
+            if (e.Scene == cell.Scene)
+            {
+                used = true;
+                break;
+            }
+        }
+        if (!used && Loaded.Remove(cell.Scene))
+        {
+            if (Scene* scene = Level::FindScene(cell.Scene))
+                Level::UnloadSceneAsync(scene);
+        }
+    }
+    Cells = value;
+}
+
+void WorldPartition::AddSource(Actor* actor)
+{
+    if (actor && !Sources.Contains(actor))
+        Sources.Add(actor);
+}
+
+void WorldPartition::RemoveSource(Actor* actor)
+{
+    Sources.Remove(actor);
+}
+
+bool WorldPartition::IsCellLoaded(int32 cellIndex)
+{
+    return cellIndex >= 0 && cellIndex < Cells.Count() && Loaded.Contains(Cells[cellIndex].Scene);
+}
+
+void WorldPartition::GetSourcesPositions(Array<Vector3>& result)
+{
+    result.Clear();
+    for (int32 i = Sources.Count() - 1; i >= 0; i--)
+    {
+        if (Actor* source = Sources[i].Get())
+            result.Add(source->GetPosition());
+        else
+            Sources.RemoveAt(i);
+    }
+    if (result.IsEmpty())
+    {
+        if (Camera* camera = Camera::GetMainCamera())
+            result.Add(camera->GetPosition());
+    }
+}
+
+bool WorldPartitionService::Init()
+{
+    Level::SceneLoaded.Bind(&OnSceneLoaded);
+    Level::SceneLoadError.Bind(&OnSceneLoadError);
+    Level::SceneUnloaded.Bind(&OnSceneUnloaded);
+    return false;
+}
+
+void WorldPartitionService::Update()
+{
+    if (!WorldPartition::Enabled || Cells.IsEmpty())
+        return;
+#if USE_EDITOR
+    if (!Editor::IsPlayMode)
+        return;
+#endif
+    PROFILE_CPU_NAMED("WorldPartition.Update");
+
+    // Gather streaming sources
+    WorldPartition::GetSourcesPositions(SourcesPositions);
+    if (SourcesPositions.IsEmpty())
+        return;
+
+    // Unload far cells and collect the cells to load
+    Candidates.Clear();
+    for (int32 i = 0; i < Cells.Count(); i++)
+    {
+        const WorldPartitionCell& cell = Cells[i];
+        const Real distance = GetDistance(cell);
+        if (Loaded.Contains(cell.Scene))
+        {
+            if (distance > WorldPartition::UnloadDistance)
+            {
+                Loaded.Remove(cell.Scene);
+                if (Scene* scene = Level::FindScene(cell.Scene))
+                    Level::UnloadSceneAsync(scene);
+            }
+        }
+        else if (distance <= WorldPartition::LoadDistance && !Loading.Contains(cell.Scene))
+        {
+            Candidates.Add({ i, cell.Priority, distance });
+        }
+    }
+    if (Candidates.IsEmpty())
+        return;
+
+    // Load the most important cells within the budget
+    Sorting::QuickSort(Candidates.Get(), Candidates.Count(), &CellCandidate::Compare);
+    for (const CellCandidate& e : Candidates)
+    {
+        if (Loading.Count() >= WorldPartition::MaxLoadingCells || Loading.Count() + Loaded.Count() >= WorldPartition::MaxLoadedCells)
+            break;
+        const Guid& sceneId = Cells[e.Index].Scene;
+        if (Level::FindScene(sceneId))
+        {
+            // Scene loaded manually
+            Loaded.Add(sceneId);
+            continue;
+        }
+        if (!Level::LoadSceneAsync(sceneId))
+            Loading.Add(sceneId);
+    }
+}
+
+void WorldPartitionService::Dispose()
+{
+    Level::SceneLoaded.Unbind(&OnSceneLoaded);
+    Level::SceneLoadError.Unbind(&OnSceneLoadError);
+    Level::SceneUnloaded.Unbind(&OnSceneUnloaded);
+    Cells.Resize(0);
+    Sources.Resize(0);
+    Loading.Clear();
+    Loaded.Clear();
+}
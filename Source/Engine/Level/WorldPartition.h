@@ -0,0 +1,108 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/Guid.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+class Actor;
+
+/// <summary>
+/// The world partition cell descriptor. Cell is a scene asset that covers the part of the world and can be streamed in and out at runtime.
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API WorldPartitionCell
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(WorldPartitionCell);
+
+    /// <summary>
+    /// The scene asset identifier.
+    /// </summary>
+    API_FIELD() Guid Scene;
+
+    /// <summary>
+    /// The world-space bounds of the cell contents.
+    /// </summary>
+    API_FIELD() BoundingBox Bounds = BoundingBox::Zero;
+
+    /// <summary>
+    /// The streaming priority. Cells with higher priority are loaded first.
+    /// </summary>
+    API_FIELD() int32 Priority = 0;
+};
+
+template<>
+struct TIsPODType<WorldPartitionCell>
+{
+    enum { Value = true };
+};
+
+/// <summary>
+/// The world partition system for large levels. Loads and unloads the grid cells (scenes) asynchronously around the streaming sources.
+/// </summary>
+API_CLASS(Static) class FLAXENGINE_API WorldPartition
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(WorldPartition);
+
+    /// <summary>
+    /// Enables the cells streaming.
+    /// </summary>
+    API_FIELD() static bool Enabled;
+
+    /// <summary>
+    /// The distance from the streaming source to the cell bounds at which the cell gets loaded.
+    /// </summary>
+    API_FIELD() static float LoadDistance;
+
+    /// <summary>
+    /// The distance from the streaming source to the cell bounds at which the cell gets unloaded. Should be higher than LoadDistance to prevent loading and unloading the same cell when moving around its border.
+    /// </summary>
+    API_FIELD() static float UnloadDistance;
+
+    /// <summary>
+    /// The maximum amount of the cells loaded at once. Used to limit the scene loading time spent per frame.
+    /// </summary>
+    API_FIELD() static int32 MaxLoadingCells;
+
+    /// <summary>
+    /// The maximum amount of the loaded cells (memory budget). The most important cells (by priority and distance) are loaded first.
+    /// </summary>
+    API_FIELD() static int32 MaxLoadedCells;
+
+public:
+    /// <summary>
+    /// Gets the world partition cells.
+    /// </summary>
+    API_PROPERTY() static const Array<WorldPartitionCell>& GetCells();
+
+    /// <summary>
+    /// Sets the world partition cells. The cells that are not used anymore get unloaded by the streaming.
+    /// </summary>
+    API_PROPERTY() static void SetCells(const Array<WorldPartitionCell>& value);
+
+    /// <summary>
+    /// Adds the streaming source actor. Cells are streamed around the sources (eg. player). Main camera is used if there are no sources.
+    /// </summary>
+    /// <param name="actor">The source actor.</param>
+    API_FUNCTION() static void AddSource(Actor* actor);
+
+    /// <summary>
+    /// Removes the streaming source actor.
+    /// </summary>
+    /// <param name="actor">The source actor.</param>
+    API_FUNCTION() static void RemoveSource(Actor* actor);
+
+    /// <summary>
+    /// Checks if the cell scene is loaded.
+    /// </summary>
+    /// <param name="cellIndex">The cell index.</param>
+    /// <returns>True if cell scene is loaded, otherwise false.</returns>
+    API_FUNCTION() static bool IsCellLoaded(int32 cellIndex);
+
+    /// <summary>
+    /// Gets the positions of the streaming sources (or the main camera if there are no sources). Can be used by other systems to stream their data around the same locations.
+    /// </summary>
+    /// <param name="result">The output positions list.</param>
+    static void GetSourcesPositions(Array<Vector3>& result);
+};
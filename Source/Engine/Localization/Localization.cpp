@@ -10,6 +10,8 @@
 #include "Engine/Content/Content.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Threading/Threading.h"
 #include <locale>
 
 class LocalizationService : public EngineService
@@ -25,44 +27,80 @@ class LocalizationService : public EngineService
         , CurrentCulture(0)
         , CurrentLanguage(0)
     {
+        ParallelInit = true;
     }
 
+    // Flat lookup table of all messages for the current language (merged from current and fallback tables) sorted by the id hash
+    struct HashedEntry
+    {
+        uint64 IdHash;
+        int32 Start;
+        int32 Count;
+
+        bool operator<(const HashedEntry& other) const
+        {
+            return IdHash < other.IdHash;
+        }
+    };
+
+    Array<HashedEntry> HashedEntries;
+    Array<String> HashedMessages;
+    uint32 Generation = 0;
+    bool Dirty = true;
+    CriticalSection Locker;
+
     void OnLocalizationChanged();
+    void BuildHashedEntries();
 
-    const String& Get(const String& id, int32 index, const String& fallback) const
+    static uint64 GetIdHash(const StringView& id)
     {
-        if (id.IsEmpty())
-            return fallback;
-
-        // Try current tables
-        for (auto& e : LocalizedStringTables)
+        // FNV-1a
+        uint64 hash = 14695981039346656037ull;
+        for (int32 i = 0; i < id.Length(); i++)
         {
-            const auto table = e.Get();
-            const auto messages = table ? table->Entries.TryGet(id) : nullptr;
-            if (messages && messages->Count() > index)
-                return messages->At(index);
+            hash ^= (uint64)id.Get()[i];
+            hash *= 1099511628211ull;
         }
+        return hash;
+    }
 
-        // Try fallback tables for current tables
-        for (auto& e : LocalizedStringTables)
+    uint32 GetGeneration()
+    {
+        if (Dirty)
         {
-            const auto table = e.Get();
-            const auto fallbackTable = table ? table->FallbackTable.Get() : nullptr;
-            const auto messages = fallbackTable ? fallbackTable->Entries.TryGet(id) : nullptr;
-            if (messages && messages->Count() > index)
-                return messages->At(index);
+            ScopeLock lock(Locker);
+            if (Dirty)
+                BuildHashedEntries();
         }
+        return Generation;
+    }
 
-        // Try fallback language tables
-        for (auto& e : FallbackStringTables)
+    const String* Find(const StringView& id, int32 index)
+    {
+        GetGeneration();
+        const uint64 idHash = GetIdHash(id);
+        const HashedEntry* entries = HashedEntries.Get();
+        int32 left = 0, right = HashedEntries.Count() - 1;
+        while (left <= right)
         {
-            const auto table = e.Get();
-            const auto messages = table ? table->Entries.TryGet(id) : nullptr;
-            if (messages && messages->Count() > index)
-                return messages->At(index);
+            const int32 middle = (left + right) / 2;
+            const HashedEntry& e = entries[middle];
+            if (e.IdHash == idHash)
+                return index < e.Count ? &HashedMessages.Get()[e.Start + index] : nullptr;
+            if (e.IdHash < idHash)
+                left = middle + 1;
+            else
+                right = middle - 1;
         }
+        return nullptr;
+    }
 
-        return fallback;
+    const String& Get(const String& id, int32 index, const String& fallback)
+    {
+        if (id.IsEmpty())
+            return fallback;
+        const String* result = Find(id, index);
+        return result ? *result : fallback;
     }
 
     bool Init() override;
@@ -144,7 +182,17 @@ LocalizedString& LocalizedString::operator=(String&& value) noexcept
 
 String LocalizedString::ToString() const
 {
-    return Localization::GetString(Id, Value);
+    if (Id.IsEmpty())
+        return Value;
+    const uint32 generation = Instance.GetGeneration();
+    if (_cachedGeneration != generation || _cachedId != Id.Get() || _cachedIdLength != Id.Length())
+    {
+        _cachedText = Instance.Find(Id, 0);
+        _cachedId = Id.Get();
+        _cachedIdLength = Id.Length();
+        _cachedGeneration = generation;
+    }
+    return _cachedText ? *_cachedText : Value;
 }
 
 String LocalizedString::ToStringPlural(int32 n) const
@@ -152,6 +200,57 @@ String LocalizedString::ToStringPlural(int32 n) const
     return Localization::GetPluralString(Id, n, Value);
 }
 
+void LocalizationService::BuildHashedEntries()
+{
+    PROFILE_CPU();
+    Generation++;
+    if (Generation == 0)
+        Generation = 1; // 0 is used as invalid generation by LocalizedString cache
+    HashedEntries.Clear();
+    HashedMessages.Clear();
+
+    // Merge tables in the lookup order (current tables, their fallback tables and fallback language tables), per message index the first table that has it wins
+    Array<const LocalizedStringTable*, InlinedAllocation<32>> tables;
+    for (auto& e : LocalizedStringTables)
+    {
+        if (e.Get())
+            tables.Add(e.Get());
+    }
+    for (auto& e : LocalizedStringTables)
+    {
+        const auto table = e.Get();
+        const auto fallbackTable = table ? table->FallbackTable.Get() : nullptr;
+        if (fallbackTable)
+            tables.Add(fallbackTable);
+    }
+    for (auto& e : FallbackStringTables)
+    {
+        if (e.Get())
+            tables.Add(e.Get());
+    }
+    Dictionary<uint64, Array<String>> merged;
+    for (const LocalizedStringTable* table : tables)
+    {
+        for (auto& e : table->Entries)
+        {
+            auto& messages = merged[GetIdHash(e.Key)];
+            for (int32 i = messages.Count(); i < e.Value.Count(); i++)
+                messages.Add(e.Value.Get()[i]);
+        }
+    }
+
+    // Flatten into the sorted table
+    HashedEntries.EnsureCapacity(merged.Count());
+    for (auto& e : merged)
+    {
+        HashedEntries.Add({ e.Key, HashedMessages.Count(), e.Value.Count() });
+        for (auto& message : e.Value)
+            HashedMessages.Add(MoveTemp(message));
+    }
+    Sorting::QuickSort(HashedEntries.Get(), HashedEntries.Count());
+    Dirty = false;
+}
+
 void LocalizationService::OnLocalizationChanged()
 {
     PROFILE_CPU();
@@ -257,6 +356,12 @@ void LocalizationService::OnLocalizationChanged()
     }
 #endif
 
+    // Rebuild lookup table
+    {
+        ScopeLock lock(Locker);
+        BuildHashedEntries();
+    }
+
     // Send event
     Localization::LocalizationChanged();
 }
@@ -326,3 +431,8 @@ String Localization::GetPluralString(const String& id, int32 n, const String& fa
     const String& format = Instance.Get(id, n - 1, fallback);
     return String::Format(format.GetText(), n);
 }
+
+void Localization::Invalidate()
+{
+    Instance.Dirty = true;
+}
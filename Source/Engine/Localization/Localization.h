@@ -59,4 +59,9 @@ API_CLASS(Static) class FLAXENGINE_API Localization
     /// <param name="fallback">The optional fallback string value to use if localized string is missing.</param>
     /// <returns>The localized text.</returns>
     API_FUNCTION() static String GetPluralString(const String& id, int32 n, const String& fallback = String::Empty);
+
+    /// <summary>
+    /// Invalidates the cached lookup table of the localized strings (rebuilt on the next use). Called when the string tables get modified or reloaded.
+    /// </summary>
+    static void Invalidate();
 };
@@ -22,6 +22,13 @@ API_CLASS(Sealed) class FLAXENGINE_API LocalizedString
     /// </summary>
     API_FIELD() String Value;
 
+private:
+    // Cached localized text for the Id (valid for the current localization generation), null if not found (uses Value)
+    mutable const String* _cachedText = nullptr;
+    mutable const Char* _cachedId = nullptr;
+    mutable int32 _cachedIdLength = 0;
+    mutable uint32 _cachedGeneration = 0;
+
 public:
     LocalizedString() = default;
     LocalizedString(const LocalizedString& other);
@@ -57,6 +64,14 @@ API_CLASS(Sealed) class FLAXENGINE_API LocalizedString
 public:
     String ToString() const;
     String ToStringPlural(int32 n) const;
+
+    /// <summary>
+    /// Clears the cached localized text so it will be resolved again on the next use. Required after modifying Id contents in-place.
+    /// </summary>
+    void ClearCache() const
+    {
+        _cachedGeneration = 0;
+    }
 };
 
 inline uint32 GetHash(const LocalizedString& key)
@@ -103,6 +118,7 @@ namespace Serialization
             auto e = SERIALIZE_FIND_MEMBER(stream, "Id");
             if (e != stream.MemberEnd())
                 v.Id.SetUTF8(e->value.GetString(), e->value.GetStringLength());
+            v.ClearCache();
             e = SERIALIZE_FIND_MEMBER(stream, "Value");
             if (e != stream.MemberEnd())
                 v.Value.SetUTF8(e->value.GetString(), e->value.GetStringLength());
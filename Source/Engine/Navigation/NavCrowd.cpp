@@ -3,9 +3,49 @@
 #include "NavCrowd.h"
 #include "NavMesh.h"
 #include "NavMeshRuntime.h"
+#include "Engine/Core/Log.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/recastnavigation/DetourCrowd.h>
 
+namespace
+{
+#if COMPILE_WITH_PROFILER
+    static const SourceLocationData NavCrowdPhasesSrcLoc[DT_CROWD_PHASE_COUNT] =
+    {
+        { "NavCrowd.Neighbourhood", __FUNCTION__, __FILE__, __LINE__, 0 },
+        { "NavCrowd.Corners", __FUNCTION__, __FILE__, __LINE__, 0 },
+        { "NavCrowd.Steering", __FUNCTION__, __FILE__, __LINE__, 0 },
+        { "NavCrowd.Avoidance", __FUNCTION__, __FILE__, __LINE__, 0 },
+        { "NavCrowd.Integrate", __FUNCTION__, __FILE__, __LINE__, 0 },
+        { "NavCrowd.Move", __FUNCTION__, __FILE__, __LINE__, 0 },
+    };
+#endif
+
+    class NavCrowdJobScheduler : public dtCrowdJobScheduler
+    {
+    public:
+        void run(const int phase, void (*job)(void* context, const int index), void* context, const int count) override
+        {
+#if COMPILE_WITH_PROFILER
+            PROFILE_CPU_SRC_LOC(NavCrowdPhasesSrcLoc[phase]);
+#endif
+            if (count == 1)
+            {
+                job(context, 0);
+                return;
+            }
+            const int64 label = JobSystem::Dispatch([job, context](int32 index)
+            {
+                job(context, index);
+            }, count);
+            JobSystem::Wait(label);
+        }
+    };
+
+    NavCrowdJobScheduler JobScheduler;
+}
+
 NavCrowd::NavCrowd(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -103,6 +143,21 @@ void NavCrowd::RemoveAgent(int32 id)
 void NavCrowd::Update(float dt)
 {
     PROFILE_CPU();
+
+    // Sync simulation settings
+    const int32 workersCount = UseJobSystem ? Math::Clamp(JobSystem::GetThreadsCount(), 1, DT_CROWD_MAX_WORKERS) : 1;
+    if (_workersCount != workersCount)
+    {
+        _workersCount = workersCount;
+        if (!_crowd->setJobScheduler(workersCount > 1 ? &JobScheduler : nullptr, workersCount))
+        {
+            LOG(Warning, "Failed to initialize crowd workers.");
+            _crowd->setJobScheduler(nullptr, 1);
+        }
+    }
+    const Float3 lodOrigin = LODOrigin;
+    _crowd->setLOD(lodOrigin.Raw, LODDistance, LODUpdateInterval);
+
     _crowd->update(Math::Max(dt, ZeroTolerance), nullptr);
 }
 
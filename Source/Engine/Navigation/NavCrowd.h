@@ -18,10 +18,31 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     DECLARE_SCRIPTING_TYPE(NavCrowd);
 private:
     dtCrowd* _crowd;
+    int32 _workersCount = 0;
 
 public:
     ~NavCrowd();
 
+    /// <summary>
+    /// If checked, the crowd update will be performed on multiple threads using Job System (parallel steering, avoidance and movement of the agents). Recommended for large crowds.
+    /// </summary>
+    API_FIELD() bool UseJobSystem = true;
+
+    /// <summary>
+    /// The origin of the crowd simulation level of detail (eg. camera or player position). Agents further than LODDistance from it use the simplified simulation.
+    /// </summary>
+    API_FIELD() Vector3 LODOrigin = Vector3::Zero;
+
+    /// <summary>
+    /// The distance from the LODOrigin (on XZ plane) at which the agents use the simplified simulation: skip obstacle avoidance sampling (RVO) and update the local neighbourhood at lower rate. Use 0 to disable level of detail.
+    /// </summary>
+    API_FIELD() float LODDistance = 0.0f;
+
+    /// <summary>
+    /// The interval (in updates) of the local neighbourhood and path optimization updates for the agents using the simplified simulation.
+    /// </summary>
+    API_FIELD() int32 LODUpdateInterval = 4;
+
     /// <summary>
     /// Initializes the crowd.
     /// </summary>
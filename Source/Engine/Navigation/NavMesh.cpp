@@ -4,13 +4,15 @@
 #include "NavMeshRuntime.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Task.h"
+#if USE_EDITOR
+#include "Editor/Editor.h"
+#endif
 #if COMPILE_WITH_ASSETS_IMPORTER
 #include "Engine/Core/Log.h"
 #include "Engine/ContentImporters/AssetsImportingManager.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
-#if USE_EDITOR
-#include "Editor/Editor.h"
-#endif
 #endif
 
 NavMesh::NavMesh(const SpawnParams& params)
@@ -73,6 +75,7 @@ void NavMesh::SaveNavMesh()
 
 void NavMesh::ClearData()
 {
+    WaitForStreaming();
     if (Data.Tiles.HasItems())
     {
         IsDataDirty = true;
@@ -86,17 +89,128 @@ NavMeshRuntime* NavMesh::GetRuntime(bool createIfMissing) const
     return NavMeshRuntime::Get(Properties, createIfMissing);
 }
 
+void NavMesh::UpdateStreaming(const Array<Vector3>& sources)
+{
+    // Skip if tiles are not streamed or the data has been modified at runtime (eg. dynamic navmesh building)
+    if (!IsStreamingTiles() || sources.IsEmpty() || _tilesResident.Count() != Data.Tiles.Count() || Data.TileSize <= 0.0f)
+        return;
+    if (_streamingTask)
+    {
+        if (!_streamingTask->IsEnded())
+            return;
+        _streamingTask = nullptr;
+    }
+    PROFILE_CPU();
+
+    // Tiles are placed on XZ plane in navmesh space
+    Array<Float2, InlinedAllocation<8>> sourcesNavMesh;
+    sourcesNavMesh.Resize(sources.Count());
+    for (int32 i = 0; i < sources.Count(); i++)
+    {
+        Vector3 position;
+        Vector3::Transform(sources[i], Properties.Rotation, position);
+        sourcesNavMesh[i] = Float2((float)position.X, (float)position.Z);
+    }
+    const float tileSize = Data.TileSize;
+    const float loadDistanceSq = StreamingLoadDistance * StreamingLoadDistance;
+    const float unloadDistanceSq = Math::Max(StreamingUnloadDistance, StreamingLoadDistance) * Math::Max(StreamingUnloadDistance, StreamingLoadDistance);
+    _tilesToAdd.Clear();
+    _tilesToRemove.Clear();
+    for (int32 i = 0; i < Data.Tiles.Count(); i++)
+    {
+        const NavMeshTileData& tile = Data.Tiles[i];
+        const Float2 tileMin(tile.PosX * tileSize, tile.PosY * tileSize);
+        const Float2 tileMax = tileMin + tileSize;
+        float distanceSq = MAX_float;
+        for (const Float2& source : sourcesNavMesh)
+        {
+            const Float2 nearest = Float2::Clamp(source, tileMin, tileMax);
+            distanceSq = Math::Min(distanceSq, Float2::DistanceSquared(source, nearest));
+        }
+        if (_tilesResident[i])
+        {
+            if (distanceSq > unloadDistanceSq)
+                _tilesToRemove.Add(i);
+        }
+        else if (distanceSq <= loadDistanceSq)
+        {
+            _tilesToAdd.Add(i);
+        }
+    }
+    if (_tilesToAdd.IsEmpty() && _tilesToRemove.IsEmpty())
+        return;
+
+    // Update runtime navmesh in the background
+    Function<void()> action;
+    action.Bind<NavMesh, &NavMesh::StreamTilesJob>(this);
+    _streamingTask = Task::StartNew(action, this);
+}
+
+bool NavMesh::IsStreamingTiles() const
+{
+#if USE_EDITOR
+    if (!Editor::IsPlayMode)
+        return false;
+#endif
+    return StreamTiles && !IsDataDirty;
+}
+
 void NavMesh::AddTiles()
 {
+    _tilesResident.Resize(Data.Tiles.Count());
+    if (IsStreamingTiles())
+    {
+        // Tiles will be loaded by the streaming
+        _tilesResident.SetAll(false);
+        return;
+    }
     auto navMesh = NavMeshRuntime::Get(Properties, true);
     navMesh->AddTiles(this);
+    _tilesResident.SetAll(true);
 }
 
 void NavMesh::RemoveTiles()
 {
+    WaitForStreaming();
     auto navMesh = NavMeshRuntime::Get(Properties, false);
     if (navMesh)
         navMesh->RemoveTiles(this);
+    _tilesResident.SetAll(false);
+}
+
+void NavMesh::WaitForStreaming()
+{
+    if (_streamingTask)
+    {
+        if (!_streamingTask->IsEnded())
+            _streamingTask->Wait();
+        _streamingTask = nullptr;
+    }
+}
+
+void NavMesh::StreamTilesJob()
+{
+    PROFILE_CPU();
+    auto navMesh = NavMeshRuntime::Get(Properties, true);
+    for (const int32 i : _tilesToRemove)
+    {
+        const NavMeshTileData& tile = Data.Tiles[i];
+        navMesh->RemoveTile(tile.PosX, tile.PosY, tile.Layer);
+        _tilesResident[i] = false;
+    }
+    if (_tilesToAdd.HasItems())
+    {
+        // Grow the navmesh once for all new tiles
+        if (navMesh->GetTileSize() == 0.0f)
+            navMesh->SetTileSize(Data.TileSize);
+        if (Math::NearEqual(navMesh->GetTileSize(), Data.TileSize))
+            navMesh->EnsureCapacity(_tilesToAdd.Count());
+        for (const int32 i : _tilesToAdd)
+        {
+            navMesh->AddTile(this, Data.Tiles[i]);
+            _tilesResident[i] = true;
+        }
+    }
 }
 
 void NavMesh::OnDataAssetLoaded()
@@ -140,6 +254,9 @@ void NavMesh::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_GET_OTHER_OBJ(NavMesh);
     SERIALIZE(DataAsset);
     SERIALIZE(Properties);
+    SERIALIZE(StreamTiles);
+    SERIALIZE(StreamingLoadDistance);
+    SERIALIZE(StreamingUnloadDistance);
 }
 
 void NavMesh::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -149,6 +266,9 @@ void NavMesh::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
 
     DESERIALIZE(DataAsset);
     DESERIALIZE(Properties);
+    DESERIALIZE(StreamTiles);
+    DESERIALIZE(StreamingLoadDistance);
+    DESERIALIZE(StreamingUnloadDistance);
 }
 
 void NavMesh::OnEnable()
@@ -10,6 +10,7 @@
 
 class NavMeshBoundsVolume;
 class NavMeshRuntime;
+class Task;
 
 /// <summary>
 /// The navigation mesh actor that holds a navigation data for a scene.
@@ -17,6 +18,12 @@ class NavMeshRuntime;
 API_CLASS() class FLAXENGINE_API NavMesh : public Actor
 {
     DECLARE_SCENE_OBJECT(NavMesh);
+private:
+    Array<bool> _tilesResident;
+    Array<int32> _tilesToAdd;
+    Array<int32> _tilesToRemove;
+    Task* _streamingTask = nullptr;
+
 public:
     /// <summary>
     /// The flag used to mark that navigation data has been modified since load. Used to save runtime data to the file on scene serialization.
@@ -47,6 +54,21 @@ API_CLASS() class FLAXENGINE_API NavMesh : public Actor
     /// </summary>
     API_FIELD(Attributes="EditorOrder(10), EditorDisplay(\"Nav Mesh\")") NavMeshProperties Properties;
 
+    /// <summary>
+    /// If checked, the navmesh tiles will be streamed in and out of the runtime navmesh around the world partition streaming sources (or main camera) during gameplay. Reduces memory usage for large worlds.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), EditorDisplay(\"Nav Mesh\")") bool StreamTiles = false;
+
+    /// <summary>
+    /// The distance from the streaming source to the tile at which the tile gets loaded.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(21), EditorDisplay(\"Nav Mesh\"), VisibleIf(nameof(StreamTiles)), Limit(0)") float StreamingLoadDistance = 20000.0f;
+
+    /// <summary>
+    /// The distance from the streaming source to the tile at which the tile gets unloaded. Should be higher than StreamingLoadDistance to prevent loading and unloading the same tile when moving around its border.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(22), EditorDisplay(\"Nav Mesh\"), VisibleIf(nameof(StreamTiles)), Limit(0)") float StreamingUnloadDistance = 25000.0f;
+
 public:
     /// <summary>
     /// Saves the nav mesh tiles data to the asset. Supported only in builds with assets saving enabled (eg. editor) and not during gameplay (eg. design time).
@@ -63,9 +85,18 @@ API_CLASS() class FLAXENGINE_API NavMesh : public Actor
     /// </summary>
     NavMeshRuntime* GetRuntime(bool createIfMissing = true) const;
 
+    /// <summary>
+    /// Updates the tiles streaming. Loads and unloads tiles in the background based on the distance to the streaming sources. Called by the navigation system.
+    /// </summary>
+    /// <param name="sources">The world-space positions of the streaming sources.</param>
+    void UpdateStreaming(const Array<Vector3>& sources);
+
 private:
+    bool IsStreamingTiles() const;
     void AddTiles();
     void RemoveTiles();
+    void WaitForStreaming();
+    void StreamTilesJob();
     void OnDataAssetLoaded();
 
 public:
@@ -18,6 +18,7 @@
 #include "Engine/Physics/Colliders/MeshCollider.h"
 #include "Engine/Physics/Colliders/SplineCollider.h"
 #include "Engine/Threading/ThreadPoolTask.h"
+#include "Engine/Platform/CPUInfo.h"
 #include "Engine/Terrain/TerrainPatch.h"
 #include "Engine/Terrain/Terrain.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -25,6 +26,7 @@
 #include "Engine/Level/Level.h"
 #include "Engine/Level/SceneQuery.h"
 #include <ThirdParty/recastnavigation/Recast.h>
+#include <ThirdParty/recastnavigation/RecastAlloc.h>
 #include <ThirdParty/recastnavigation/DetourNavMeshBuilder.h>
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
 
@@ -47,6 +49,7 @@ int32 BoxTrianglesIndicesCache[] =
 };
 
 #define NAV_MESH_TILE_MAX_EXTENT 100000000
+#define NAV_MESH_TILE_CACHE_MAX_SIZE (128 * 1024 * 1024)
 #define NAV_MESH_BUILD_DEBUG_DRAW_GEOMETRY 0
 
 #if NAV_MESH_BUILD_DEBUG_DRAW_GEOMETRY
@@ -225,6 +228,10 @@ struct NavigationSceneRasterization
         if (!actorBoxNavMesh.Intersects(e.TileBoundsNavMesh))
             return true;
 
+        // Skip geometry when using cached tile heightfield (collect only modifiers and links)
+        if (!e.Heightfield && !dynamic_cast<NavLink*>(actor) && !dynamic_cast<NavModifierVolume*>(actor))
+            return true;
+
         // Prepare buffers (for triangles)
         auto& vb = e.VertexBuffer;
         auto& ib = e.IndexBuffer;
@@ -428,7 +435,132 @@ void RemoveTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, int
     runtime->RemoveTile(x, y, layer);
 }
 
-bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, rcConfig& config)
+// Cache of the tiles compact heightfields (rasterized scene geometry eroded by the agent radius, before marking areas) which allows to skip geometry rasterization when only the navigation modifiers or links were changed
+struct NavMeshTileCacheEntry
+{
+    Guid NavMeshId;
+    Scene* Scene;
+    int32 X;
+    int32 Y;
+    rcConfig Config;
+    rcCompactHeightfield* Heightfield;
+    uint64 Size;
+};
+
+CriticalSection NavTileCacheLocker;
+Array<NavMeshTileCacheEntry> NavTileCache; // Sorted from the least recently used
+uint64 NavTileCacheSize = 0;
+
+rcCompactHeightfield* CloneCompactHeightfield(const rcCompactHeightfield& src, uint64& size)
+{
+    rcCompactHeightfield* dst = rcAllocCompactHeightfield();
+    if (!dst)
+        return nullptr;
+    dst->width = src.width;
+    dst->height = src.height;
+    dst->spanCount = src.spanCount;
+    dst->walkableHeight = src.walkableHeight;
+    dst->walkableClimb = src.walkableClimb;
+    dst->borderSize = src.borderSize;
+    dst->maxDistance = src.maxDistance;
+    dst->maxRegions = src.maxRegions;
+    rcVcopy(dst->bmin, src.bmin);
+    rcVcopy(dst->bmax, src.bmax);
+    dst->cs = src.cs;
+    dst->ch = src.ch;
+    const int32 cellsCount = src.width * src.height;
+    dst->cells = (rcCompactCell*)rcAlloc(sizeof(rcCompactCell) * cellsCount, RC_ALLOC_PERM);
+    dst->spans = (rcCompactSpan*)rcAlloc(sizeof(rcCompactSpan) * src.spanCount, RC_ALLOC_PERM);
+    dst->areas = (unsigned char*)rcAlloc(sizeof(unsigned char) * src.spanCount, RC_ALLOC_PERM);
+    if (!dst->cells || !dst->spans || !dst->areas)
+    {
+        rcFreeCompactHeightfield(dst);
+        return nullptr;
+    }
+    Platform::MemoryCopy(dst->cells, src.cells, sizeof(rcCompactCell) * cellsCount);
+    Platform::MemoryCopy(dst->spans, src.spans, sizeof(rcCompactSpan) * src.spanCount);
+    Platform::MemoryCopy(dst->areas, src.areas, sizeof(unsigned char) * src.spanCount);
+    size = sizeof(rcCompactHeightfield) + sizeof(rcCompactCell) * cellsCount + (sizeof(rcCompactSpan) + sizeof(unsigned char)) * src.spanCount;
+    return dst;
+}
+
+void RemoveCachedTile(int32 index)
+{
+    auto& e = NavTileCache[index];
+    NavTileCacheSize -= e.Size;
+    rcFreeCompactHeightfield(e.Heightfield);
+    NavTileCache.RemoveAtKeepOrder(index);
+}
+
+rcCompactHeightfield* GetCachedTile(NavMesh* navMesh, int32 x, int32 y, const rcConfig& config)
+{
+    PROFILE_CPU();
+    ScopeLock lock(NavTileCacheLocker);
+    const Guid navMeshId = navMesh->GetID();
+    for (int32 i = NavTileCache.Count() - 1; i >= 0; i--)
+    {
+        auto e = NavTileCache[i];
+        if (e.X != x || e.Y != y || e.NavMeshId != navMeshId)
+            continue;
+        if (Platform::MemoryCompare(&e.Config, &config, sizeof(rcConfig)) != 0)
+        {
+            // Outdated (eg. different tile bounds or agent properties)
+            RemoveCachedTile(i);
+            return nullptr;
+        }
+
+        // Mark as the most recently used
+        NavTileCache.RemoveAtKeepOrder(i);
+        NavTileCache.Add(e);
+        uint64 size;
+        return CloneCompactHeightfield(*e.Heightfield, size);
+    }
+    return nullptr;
+}
+
+void CacheTile(NavMesh* navMesh, int32 x, int32 y, const rcConfig& config, const rcCompactHeightfield& heightfield)
+{
+    PROFILE_CPU();
+    NavMeshTileCacheEntry entry;
+    entry.Heightfield = CloneCompactHeightfield(heightfield, entry.Size);
+    if (!entry.Heightfield)
+        return;
+    entry.NavMeshId = navMesh->GetID();
+    entry.Scene = navMesh->GetScene();
+    entry.X = x;
+    entry.Y = y;
+    entry.Config = config;
+    ScopeLock lock(NavTileCacheLocker);
+    for (int32 i = 0; i < NavTileCache.Count(); i++)
+    {
+        const auto& e = NavTileCache[i];
+        if (e.X == x && e.Y == y && e.NavMeshId == entry.NavMeshId)
+        {
+            RemoveCachedTile(i);
+            break;
+        }
+    }
+    NavTileCache.Add(entry);
+    NavTileCacheSize += entry.Size;
+
+    // Evict the least recently used tiles to fit into the memory budget
+    while (NavTileCacheSize > NAV_MESH_TILE_CACHE_MAX_SIZE && NavTileCache.Count() > 1)
+        RemoveCachedTile(0);
+}
+
+void ClearCachedTiles(const Scene* scene, const NavMesh* navMesh)
+{
+    ScopeLock lock(NavTileCacheLocker);
+    const Guid navMeshId = navMesh ? navMesh->GetID() : Guid::Empty;
+    for (int32 i = NavTileCache.Count() - 1; i >= 0; i--)
+    {
+        const auto& e = NavTileCache[i];
+        if (e.Scene == scene && (!navMesh || e.NavMeshId == navMeshId))
+            RemoveCachedTile(i);
+    }
+}
+
+bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, rcConfig& config, bool rebuildGeometry)
 {
     rcContext context;
     int32 layer = 0;
@@ -441,44 +573,55 @@ bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, B
     *(Float3*)&config.bmin = tileBoundsNavMesh.Minimum;
     *(Float3*)&config.bmax = tileBoundsNavMesh.Maximum;
 
-    rcHeightfield* heightfield = rcAllocHeightfield();
-    if (!heightfield)
+    Array<OffMeshLink> offMeshLinks;
+    Array<Modifier> modifiers;
+    rcCompactHeightfield* compactHeightfield = rebuildGeometry ? nullptr : GetCachedTile(navMesh, x, y, config);
+    if (compactHeightfield)
     {
-        LOG(Warning, "Could not generate navmesh: Out of memory for heightfield.");
-        return true;
+        // Reuse cached geometry (collect only modifiers and links)
+        RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, nullptr, &offMeshLinks, &modifiers);
     }
-    if (!rcCreateHeightfield(&context, *heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
+    else
     {
-        LOG(Warning, "Could not generate navmesh: Could not create solid heightfield.");
-        return true;
-    }
+        rcHeightfield* heightfield = rcAllocHeightfield();
+        if (!heightfield)
+        {
+            LOG(Warning, "Could not generate navmesh: Out of memory for heightfield.");
+            return true;
+        }
+        if (!rcCreateHeightfield(&context, *heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
+        {
+            LOG(Warning, "Could not generate navmesh: Could not create solid heightfield.");
+            return true;
+        }
 
-    Array<OffMeshLink> offMeshLinks;
-    Array<Modifier> modifiers;
-    RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, heightfield, &offMeshLinks, &modifiers);
+        RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, heightfield, &offMeshLinks, &modifiers);
 
-    rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *heightfield);
-    rcFilterLedgeSpans(&context, config.walkableHeight, config.walkableClimb, *heightfield);
-    rcFilterWalkableLowHeightSpans(&context, config.walkableHeight, *heightfield);
+        rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *heightfield);
+        rcFilterLedgeSpans(&context, config.walkableHeight, config.walkableClimb, *heightfield);
+        rcFilterWalkableLowHeightSpans(&context, config.walkableHeight, *heightfield);
 
-    rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
-    if (!compactHeightfield)
-    {
-        LOG(Warning, "Could not generate navmesh: Out of memory compact heightfield.");
-        return true;
-    }
-    if (!rcBuildCompactHeightfield(&context, config.walkableHeight, config.walkableClimb, *heightfield, *compactHeightfield))
-    {
-        LOG(Warning, "Could not generate navmesh: Could not build compact data.");
-        return true;
-    }
+        compactHeightfield = rcAllocCompactHeightfield();
+        if (!compactHeightfield)
+        {
+            LOG(Warning, "Could not generate navmesh: Out of memory compact heightfield.");
+            return true;
+        }
+        if (!rcBuildCompactHeightfield(&context, config.walkableHeight, config.walkableClimb, *heightfield, *compactHeightfield))
+        {
+            LOG(Warning, "Could not generate navmesh: Could not build compact data.");
+            return true;
+        }
 
-    rcFreeHeightField(heightfield);
+        rcFreeHeightField(heightfield);
 
-    if (!rcErodeWalkableArea(&context, config.walkableRadius, *compactHeightfield))
-    {
-        LOG(Warning, "Could not generate navmesh: Could not erode.");
-        return true;
+        if (!rcErodeWalkableArea(&context, config.walkableRadius, *compactHeightfield))
+        {
+            LOG(Warning, "Could not generate navmesh: Could not erode.");
+            return true;
+        }
+
+        CacheTile(navMesh, x, y, config, *compactHeightfield);
     }
 
     // Mark areas
@@ -701,6 +844,7 @@ struct BuildRequest
     ScriptingObjectReference<Scene> Scene;
     DateTime Time;
     BoundingBox DirtyBounds;
+    bool RebuildGeometry;
 };
 
 CriticalSection NavBuildQueueLocker;
@@ -709,6 +853,7 @@ Array<BuildRequest> NavBuildQueue;
 CriticalSection NavBuildTasksLocker;
 int32 NavBuildTasksMaxCount = 0;
 Array<class NavMeshTileBuildTask*> NavBuildTasks;
+Array<class NavMeshTileBuildTask*> NavBuildTasksPending; // Tasks not yet started (limited amount of tiles is built at once to not saturate the thread pool used by the other systems)
 
 class NavMeshTileBuildTask : public ThreadPoolTask
 {
@@ -722,6 +867,13 @@ class NavMeshTileBuildTask : public ThreadPoolTask
     int32 Y;
     float TileSize;
     rcConfig Config;
+    bool RebuildGeometry;
+
+public:
+    NavMeshTileBuildTask()
+        : ThreadPoolTask(ThreadPoolTaskPriority::Background)
+    {
+    }
 
 public:
     // [ThreadPoolTask]
@@ -734,7 +886,7 @@ class NavMeshTileBuildTask : public ThreadPoolTask
         {
             return false;
         }
-        if (GenerateTile(NavMesh, Runtime, X, Y, TileBoundsNavMesh, WorldToNavMesh, TileSize, Config))
+        if (GenerateTile(NavMesh, Runtime, X, Y, TileBoundsNavMesh, WorldToNavMesh, TileSize, Config, RebuildGeometry))
         {
             LOG(Warning, "Failed to generate navmesh tile at {0}x{1}.", X, Y);
         }
@@ -747,6 +899,7 @@ class NavMeshTileBuildTask : public ThreadPoolTask
         // Remove from tasks list
         ScopeLock lock(NavBuildTasksLocker);
         NavBuildTasks.Remove(this);
+        NavBuildTasksPending.Remove(this);
         if (NavBuildTasks.IsEmpty())
             NavBuildTasksMaxCount = 0;
     }
@@ -785,6 +938,9 @@ void OnSceneUnloading(Scene* scene, const Guid& sceneId)
         }
     }
     NavBuildTasksLocker.Unlock();
+
+    // Release cached tiles
+    ClearCachedTiles(scene, nullptr);
 }
 
 void NavMeshBuilder::Init()
@@ -814,7 +970,7 @@ float NavMeshBuilder::GetNavMeshBuildingProgress()
     return result;
 }
 
-void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize)
+void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, bool rebuildGeometry)
 {
     NavMeshRuntime* runtime = navMesh->GetRuntime();
     NavBuildTasksLocker.Lock();
@@ -825,6 +981,7 @@ void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const
         const auto task = NavBuildTasks[i];
         if (task->X == x && task->Y == y && task->Runtime == runtime)
         {
+            task->RebuildGeometry |= rebuildGeometry;
             NavBuildTasksLocker.Unlock();
             return;
         }
@@ -841,16 +998,27 @@ void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const
     task->WorldToNavMesh = worldToNavMesh;
     task->TileSize = tileSize;
     task->Config = config;
+    task->RebuildGeometry = rebuildGeometry;
     NavBuildTasks.Add(task);
+    NavBuildTasksPending.Add(task);
     NavBuildTasksMaxCount++;
 
     NavBuildTasksLocker.Unlock();
+}
 
-    // Invoke job
-    task->Start();
+void StartPendingTileBuilds()
+{
+    ScopeLock lock(NavBuildTasksLocker);
+    const int32 maxActiveTasks = Math::Max((int32)Platform::GetCPUInfo().ProcessorCoreCount / 2, 1);
+    while (NavBuildTasksPending.HasItems() && NavBuildTasks.Count() - NavBuildTasksPending.Count() < maxActiveTasks)
+    {
+        auto task = NavBuildTasksPending[0];
+        NavBuildTasksPending.RemoveAtKeepOrder(0);
+        task->Start();
+    }
 }
 
-void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBounds, bool rebuild)
+void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBounds, bool rebuild, bool rebuildGeometry)
 {
     const float tileSize = GetTileSize();
     NavMeshRuntime* runtime = navMesh->GetRuntime();
@@ -878,6 +1046,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
         if (rebuild)
         {
             // Remove all tiles from navmesh runtime
+            ClearCachedTiles(scene, navMesh);
             runtime->RemoveTiles(navMesh);
             runtime->SetTileSize(tileSize);
             runtime->EnsureCapacity(tilesX * tilesY);
@@ -911,7 +1080,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
                 BoundingBox tileBoundsNavMesh;
                 if (GetNavMeshTileBounds(scene, navMesh, x, y, tileSize, tileBoundsNavMesh, worldToNavMesh))
                 {
-                    BuildTileAsync(navMesh, x, y, config, tileBoundsNavMesh, worldToNavMesh, tileSize);
+                    BuildTileAsync(navMesh, x, y, config, tileBoundsNavMesh, worldToNavMesh, tileSize, rebuildGeometry);
                 }
                 else
                 {
@@ -922,7 +1091,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
     }
 }
 
-void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild)
+void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild, bool rebuildGeometry)
 {
     auto settings = NavigationSettings::Get();
 
@@ -981,7 +1150,7 @@ void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild
     // Build all navmeshes on the scene
     for (NavMesh* navMesh : scene->Navigation.Meshes)
     {
-        BuildDirtyBounds(scene, navMesh, dirtyBounds, rebuild);
+        BuildDirtyBounds(scene, navMesh, dirtyBounds, rebuild, rebuildGeometry);
     }
 
     // Remove unused navmeshes
@@ -1015,12 +1184,13 @@ void BuildWholeScene(Scene* scene)
     // Compute total navigation area bounds
     const BoundingBox worldBounds = scene->Navigation.GetNavigationBounds();
 
-    BuildDirtyBounds(scene, worldBounds, true);
+    BuildDirtyBounds(scene, worldBounds, true, true);
 }
 
 void ClearNavigation(Scene* scene)
 {
     const bool autoRemoveMissingNavMeshes = NavigationSettings::Get()->AutoRemoveMissingNavMeshes;
+    ClearCachedTiles(scene, nullptr);
     for (NavMesh* navMesh : scene->Navigation.Meshes)
     {
         navMesh->ClearData();
@@ -1059,10 +1229,12 @@ void NavMeshBuilder::Update()
             }
             else
             {
-                BuildDirtyBounds(scene, req.DirtyBounds, false);
+                BuildDirtyBounds(scene, req.DirtyBounds, false, req.RebuildGeometry);
             }
         }
     }
+
+    StartPendingTileBuilds();
 }
 
 void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
@@ -1082,6 +1254,7 @@ void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
     req.Scene = scene;
     req.Time = DateTime::NowUTC() + TimeSpan::FromMilliseconds(timeoutMs);
     req.DirtyBounds = BoundingBox::Empty;
+    req.RebuildGeometry = true;
 
     for (int32 i = 0; i < NavBuildQueue.Count(); i++)
     {
@@ -1096,7 +1269,7 @@ void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
     NavBuildQueue.Add(req);
 }
 
-void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs)
+void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs, bool rebuildGeometry)
 {
     // Early out if scene is not using navigation
     if (scene->Navigation.Volumes.IsEmpty())
@@ -1113,6 +1286,7 @@ void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float t
     req.Scene = scene;
     req.Time = DateTime::NowUTC() + TimeSpan::FromMilliseconds(timeoutMs);
     req.DirtyBounds = dirtyBounds;
+    req.RebuildGeometry = rebuildGeometry;
 
     NavBuildQueue.Add(req);
 }
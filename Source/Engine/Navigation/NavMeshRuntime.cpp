@@ -22,6 +22,39 @@ namespace
     {
         Platform::MemoryCopy(filter.m_areaCost, NavMeshRuntime::NavAreasCosts, sizeof(NavMeshRuntime::NavAreasCosts));
     }
+
+    bool GetPathPoints(const NavMeshRuntime* runtime, const dtNavMeshQuery* query, const Vector3& startPosition, const Float3& startPositionNavMesh, Float3 endPositionNavMesh, const dtPolyRef* path, int32 pathSize, bool partial, Array<Vector3, HeapAllocation>& resultPath)
+    {
+        Quaternion invRotation;
+        Quaternion::Invert(runtime->Properties.Rotation, invRotation);
+
+        if (pathSize == 1 && partial)
+        {
+            // TODO: skip adding 2nd end point if it's not reachable (use navmesh raycast check? or physics check? or local Z distance check?)
+            resultPath.Resize(2);
+            resultPath[0] = startPosition;
+            query->closestPointOnPolyBoundary(path[0], &endPositionNavMesh.X, &endPositionNavMesh.X);
+            resultPath[1] = endPositionNavMesh;
+            Vector3::Transform(resultPath[1], invRotation, resultPath[1]);
+        }
+        else
+        {
+            int pathPointsCount = 0;
+            Float3 pathPoints[NAV_MESH_PATH_MAX_SIZE];
+            const auto findStraightPathStatus = query->findStraightPath(&startPositionNavMesh.X, &endPositionNavMesh.X, path, pathSize, (float*)&pathPoints, nullptr, nullptr, &pathPointsCount, NAV_MESH_PATH_MAX_SIZE, DT_STRAIGHTPATH_AREA_CROSSINGS);
+            if (dtStatusFailed(findStraightPathStatus))
+            {
+                return false;
+            }
+            resultPath.Resize(pathPointsCount);
+            for (int32 i = 0; i < pathPointsCount; i++)
+            {
+                Vector3::Transform(pathPoints[i], invRotation, resultPath[i]);
+            }
+        }
+
+        return true;
+    }
 }
 
 NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
@@ -115,35 +148,56 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
         return false;
     }
 
-    Quaternion invRotation;
-    Quaternion::Invert(Properties.Rotation, invRotation);
+    return GetPathPoints(this, query, startPosition, startPositionNavMesh, endPositionNavMesh, path, pathSize, dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT), resultPath);
+}
 
-    if (pathSize == 1 && dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT))
-    {
-        // TODO: skip adding 2nd end point if it's not reachable (use navmesh raycast check? or physics check? or local Z distance check?)
-        resultPath.Resize(2);
-        resultPath[0] = startPosition;
-        query->closestPointOnPolyBoundary(startPoly, &endPositionNavMesh.X, &endPositionNavMesh.X);
-        resultPath[1] = endPositionNavMesh;
-        Vector3::Transform(resultPath[1], invRotation, resultPath[1]);
-    }
-    else
-    {
-        int pathPointsCount = 0;
-        Float3 pathPoints[NAV_MESH_PATH_MAX_SIZE];
-        const auto findStraightPathStatus = query->findStraightPath(&startPositionNavMesh.X, &endPositionNavMesh.X, path, pathSize, (float*)&pathPoints, nullptr, nullptr, &pathPointsCount, NAV_MESH_PATH_MAX_SIZE, DT_STRAIGHTPATH_AREA_CROSSINGS);
-        if (dtStatusFailed(findStraightPathStatus))
-        {
-            return false;
-        }
-        resultPath.Resize(pathPointsCount);
-        for (int32 i = 0; i < pathPointsCount; i++)
-        {
-            Vector3::Transform(pathPoints[i], invRotation, resultPath[i]);
-        }
-    }
+bool NavMeshRuntime::InitSlicedFindPath(dtNavMeshQuery* query, dtQueryFilter& filter, const Vector3& startPosition, const Vector3& endPosition) const
+{
+    if (!_navMesh)
+        return false;
+    if (query->getAttachedNavMesh() != _navMesh && dtStatusFailed(query->init(_navMesh, MAX_NODES)))
+        return false;
 
-    return true;
+    InitFilter(filter);
+    Float3 extent = Properties.DefaultQueryExtent;
+
+    Float3 startPositionNavMesh, endPositionNavMesh;
+    Float3::Transform(startPosition, Properties.Rotation, startPositionNavMesh);
+    Float3::Transform(endPosition, Properties.Rotation, endPositionNavMesh);
+
+    dtPolyRef startPoly = 0;
+    query->findNearestPoly(&startPositionNavMesh.X, &extent.X, &filter, &startPoly, nullptr);
+    if (!startPoly)
+        return false;
+    dtPolyRef endPoly = 0;
+    query->findNearestPoly(&endPositionNavMesh.X, &extent.X, &filter, &endPoly, nullptr);
+    if (!endPoly)
+        return false;
+
+    return !dtStatusFailed(query->initSlicedFindPath(startPoly, endPoly, &startPositionNavMesh.X, &endPositionNavMesh.X, &filter));
+}
+
+bool NavMeshRuntime::FinalizeSlicedFindPath(dtNavMeshQuery* query, const Vector3& startPosition, const Vector3& endPosition, Array<Vector3, HeapAllocation>& resultPath) const
+{
+    resultPath.Clear();
+    if (query->getAttachedNavMesh() != _navMesh)
+        return false;
+
+    dtPolyRef path[NAV_MESH_PATH_MAX_SIZE];
+    int32 pathSize;
+    const auto findPathStatus = query->finalizeSlicedFindPath(path, &pathSize, NAV_MESH_PATH_MAX_SIZE);
+    if (dtStatusFailed(findPathStatus) || pathSize == 0)
+        return false;
+
+    Float3 startPositionNavMesh, endPositionNavMesh;
+    Float3::Transform(startPosition, Properties.Rotation, startPositionNavMesh);
+    Float3::Transform(endPosition, Properties.Rotation, endPositionNavMesh);
+
+    // Sliced query clamps the positions to the start and end polygons
+    query->closestPointOnPoly(path[0], &startPositionNavMesh.X, &startPositionNavMesh.X, nullptr);
+    query->closestPointOnPoly(path[pathSize - 1], &endPositionNavMesh.X, &endPositionNavMesh.X, nullptr);
+
+    return GetPathPoints(this, query, startPosition, startPositionNavMesh, endPositionNavMesh, path, pathSize, dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT), resultPath);
 }
 
 bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPosition) const
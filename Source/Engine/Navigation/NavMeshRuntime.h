@@ -9,6 +9,7 @@
 
 class dtNavMesh;
 class dtNavMeshQuery;
+class dtQueryFilter;
 class NavMesh;
 
 /// <summary>
@@ -149,6 +150,27 @@ class FLAXENGINE_API NavMeshRuntime
     /// <returns>True if ray hits an matching object, otherwise false.</returns>
     bool RayCast(const Vector3& startPosition, const Vector3& endPosition, NavMeshHit& hitInfo) const;
 
+public:
+    /// <summary>
+    /// Starts the sliced path query between the two positions (path search is performed over multiple updates via dtNavMeshQuery::updateSlicedFindPath). Caller has to hold the Locker.
+    /// </summary>
+    /// <param name="query">The query object to use (owned by the caller, gets initialized for this navmesh if needed).</param>
+    /// <param name="filter">The query filter (has to be valid until query end).</param>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <returns>True if started the query, otherwise false if failed (eg. start or end position is outside the navmesh).</returns>
+    bool InitSlicedFindPath(dtNavMeshQuery* query, dtQueryFilter& filter, const Vector3& startPosition, const Vector3& endPosition) const;
+
+    /// <summary>
+    /// Finishes the sliced path query and builds the path waypoints. Caller has to hold the Locker.
+    /// </summary>
+    /// <param name="query">The query object used to perform the search.</param>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <param name="resultPath">The result path.</param>
+    /// <returns>True if found valid path between given two points (it may be partial), otherwise false if failed.</returns>
+    bool FinalizeSlicedFindPath(dtNavMeshQuery* query, const Vector3& startPosition, const Vector3& endPosition, Array<Vector3, HeapAllocation>& resultPath) const;
+
 public:
     /// <summary>
     /// Sets the size of the tile (if not assigned). Disposes the mesh if added tiles have different size.
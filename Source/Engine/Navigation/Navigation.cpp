@@ -8,21 +8,248 @@
 #include "Engine/Content/Content.h"
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Threading/Threading.h"
-#if USE_EDITOR
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Level/Level.h"
 #include "Engine/Level/Scene/Scene.h"
-#endif
+#include "Engine/Level/WorldPartition.h"
 #include "NavMesh.h"
 
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Serialization/Serialization.h"
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
+#include <ThirdParty/recastnavigation/DetourNavMeshQuery.h>
 #include <ThirdParty/recastnavigation/RecastAlloc.h>
 
+// The maximum distance between start/end positions of the path requests to merge them into a single search
+#define NAV_MESH_PATH_REQUESTS_MERGE_DISTANCE 10.0f
+// The maximum amount of the concurrent path searches
+#define NAV_MESH_PATH_REQUESTS_MAX_WORKERS 4
+
 namespace
 {
+    struct PathQuery
+    {
+        NavMeshRuntime* NavMesh;
+        Vector3 StartPosition;
+        Vector3 EndPosition;
+        Array<uint32, InlinedAllocation<4>> Requests;
+        bool Started = false;
+        bool Initialized = false;
+        bool Done = false;
+        bool Success = false;
+        Array<Vector3, HeapAllocation> Path;
+    };
+
+    struct PathRequest
+    {
+        NavPathRequestState State = NavPathRequestState::Pending;
+        Array<Vector3, HeapAllocation> Path;
+        Navigation::PathRequestCallback Callback;
+    };
+
+    struct PathWorker
+    {
+        dtNavMeshQuery* Query = nullptr;
+        dtQueryFilter Filter;
+        PathQuery* Current = nullptr;
+    };
+
     Array<NavMeshRuntime*, InlinedAllocation<16>> NavMeshes;
+    CriticalSection PathRequestsLocker;
+    Array<PathQuery*> PathQueries;
+    Dictionary<uint32, PathRequest> PathRequests;
+    uint32 PathRequestsNextId = 1;
+    PathWorker PathWorkers[NAV_MESH_PATH_REQUESTS_MAX_WORKERS];
+    int32 PathWorkersIterations = 0;
+    int64 PathWorkersLabel = 0;
+
+    PathQuery* GetNextPathQuery()
+    {
+        ScopeLock lock(PathRequestsLocker);
+        for (PathQuery* query : PathQueries)
+        {
+            if (!query->Started)
+            {
+                query->Started = true;
+                return query;
+            }
+        }
+        return nullptr;
+    }
+
+    void ProcessPathWorker(int32 index)
+    {
+        PROFILE_CPU();
+        PathWorker& worker = PathWorkers[index];
+        int32 budget = PathWorkersIterations;
+        while (budget > 0)
+        {
+            if (!worker.Current)
+            {
+                worker.Current = GetNextPathQuery();
+                if (!worker.Current)
+                    break;
+            }
+            PathQuery* query = worker.Current;
+            NavMeshRuntime* navMesh = query->NavMesh;
+            ScopeLock lock(navMesh->Locker);
+
+            // Restart the search if navmesh has been reallocated in the meantime
+            if (query->Initialized && worker.Query->getAttachedNavMesh() != navMesh->GetNavMesh())
+                query->Initialized = false;
+            if (!query->Initialized)
+            {
+                budget--;
+                if (!navMesh->InitSlicedFindPath(worker.Query, worker.Filter, query->StartPosition, query->EndPosition))
+                {
+                    query->Done = true;
+                    worker.Current = nullptr;
+                    continue;
+                }
+                query->Initialized = true;
+            }
+
+            int32 iterations = 0;
+            const dtStatus status = worker.Query->updateSlicedFindPath(budget, &iterations);
+            budget -= Math::Max(iterations, 1);
+            if (dtStatusInProgress(status))
+                continue;
+            query->Success = navMesh->FinalizeSlicedFindPath(worker.Query, query->StartPosition, query->EndPosition, query->Path);
+            query->Done = true;
+            worker.Current = nullptr;
+        }
+    }
+
+    uint32 AddPathRequest(const Vector3& startPosition, const Vector3& endPosition, const Navigation::PathRequestCallback& callback)
+    {
+        if (NavMeshes.IsEmpty())
+            return 0;
+        NavMeshRuntime* navMesh = NavMeshes.First();
+        ScopeLock lock(PathRequestsLocker);
+        uint32 id = PathRequestsNextId++;
+        if (id == 0)
+            id = PathRequestsNextId++;
+        PathRequests[id].Callback = callback;
+
+        // Merge with the similar query that has not been started yet
+        const Real mergeDistanceSq = NAV_MESH_PATH_REQUESTS_MERGE_DISTANCE * NAV_MESH_PATH_REQUESTS_MERGE_DISTANCE;
+        for (PathQuery* query : PathQueries)
+        {
+            if (!query->Started &&
+                query->NavMesh == navMesh &&
+                Vector3::DistanceSquared(query->StartPosition, startPosition) <= mergeDistanceSq &&
+                Vector3::DistanceSquared(query->EndPosition, endPosition) <= mergeDistanceSq)
+            {
+                query->Requests.Add(id);
+                return id;
+            }
+        }
+
+        auto query = New<PathQuery>();
+        query->NavMesh = navMesh;
+        query->StartPosition = startPosition;
+        query->EndPosition = endPosition;
+        query->Requests.Add(id);
+        PathQueries.Add(query);
+        return id;
+    }
+
+    void UpdatePathRequests()
+    {
+        if (PathWorkersLabel == 0 && PathQueries.IsEmpty())
+            return;
+        PROFILE_CPU();
+
+        // Wait for the jobs from the previous frame (each of them performs only a limited amount of iterations)
+        if (PathWorkersLabel != 0)
+        {
+            JobSystem::Wait(PathWorkersLabel);
+            PathWorkersLabel = 0;
+        }
+
+        // Complete the finished queries
+        struct Callback
+        {
+            uint32 Id;
+            NavPathRequestState State;
+            Navigation::PathRequestCallback Callback;
+            Array<Vector3, HeapAllocation> Path;
+        };
+        Array<Callback> callbacks;
+        int32 activeQueries = 0;
+        PathRequestsLocker.Lock();
+        for (int32 i = 0; i < PathQueries.Count(); i++)
+        {
+            PathQuery* query = PathQueries[i];
+            if (!query->Done)
+            {
+                activeQueries++;
+                continue;
+            }
+            const NavPathRequestState state = query->Success ? NavPathRequestState::Succeeded : NavPathRequestState::Failed;
+            for (uint32 id : query->Requests)
+            {
+                PathRequest* request = PathRequests.TryGet(id);
+                if (!request)
+                    continue;
+                if (request->Callback.IsBinded())
+                {
+                    auto& callback = callbacks.AddOne();
+                    callback.Id = id;
+                    callback.State = state;
+                    callback.Callback = request->Callback;
+                    callback.Path = query->Path;
+                    PathRequests.Remove(id);
+                }
+                else
+                {
+                    request->State = state;
+                    request->Path = query->Path;
+                }
+            }
+            PathQueries.RemoveAtKeepOrder(i--);
+            Delete(query);
+        }
+        PathRequestsLocker.Unlock();
+        for (auto& callback : callbacks)
+            callback.Callback(callback.Id, callback.State, callback.Path);
+
+        // Kick off the path searches (each worker continues its sliced query from the previous frame)
+        if (activeQueries != 0)
+        {
+            const int32 workersCount = Math::Min(activeQueries, Math::Clamp(JobSystem::GetThreadsCount(), 1, NAV_MESH_PATH_REQUESTS_MAX_WORKERS));
+            for (int32 i = 0; i < workersCount; i++)
+            {
+                if (!PathWorkers[i].Query)
+                    PathWorkers[i].Query = dtAllocNavMeshQuery();
+            }
+            PathWorkersIterations = Math::Max(Navigation::PathRequestsIterationsPerFrame / workersCount, 1);
+            PathWorkersLabel = JobSystem::Dispatch(ProcessPathWorker, workersCount);
+        }
+    }
+
+    void DisposePathRequests()
+    {
+        if (PathWorkersLabel != 0)
+        {
+            JobSystem::Wait(PathWorkersLabel);
+            PathWorkersLabel = 0;
+        }
+        for (auto& worker : PathWorkers)
+        {
+            if (worker.Query)
+            {
+                dtFreeNavMeshQuery(worker.Query);
+                worker.Query = nullptr;
+            }
+            worker.Current = nullptr;
+        }
+        PathQueries.ClearDelete();
+        PathRequests.Clear();
+    }
 }
 
 NavMeshRuntime* NavMeshRuntime::Get()
@@ -166,9 +393,7 @@ class NavigationService : public EngineService
     }
 
     bool Init() override;
-#if COMPILE_WITH_NAV_MESH_BUILDER
     void Update() override;
-#endif
     void Dispose() override;
 };
 
@@ -270,17 +495,33 @@ bool NavigationService::Init()
     return false;
 }
 
-#if COMPILE_WITH_NAV_MESH_BUILDER
-
 void NavigationService::Update()
 {
+    PROFILE_MEM(Navigation);
+#if COMPILE_WITH_NAV_MESH_BUILDER
     NavMeshBuilder::Update();
-}
-
 #endif
+    UpdatePathRequests();
+
+    // Stream navmesh tiles around the world streaming sources
+    Array<Vector3> sources;
+    for (Scene* scene : Level::Scenes)
+    {
+        for (NavMesh* navMesh : scene->Navigation.Meshes)
+        {
+            if (!navMesh->StreamTiles)
+                continue;
+            if (sources.IsEmpty())
+                WorldPartition::GetSourcesPositions(sources);
+            navMesh->UpdateStreaming(sources);
+        }
+    }
+}
 
 void NavigationService::Dispose()
 {
+    DisposePathRequests();
+
     // Release nav meshes
     for (auto navMesh : NavMeshes)
     {
@@ -340,6 +581,62 @@ bool Navigation::RayCast(const Vector3& startPosition, const Vector3& endPositio
     return NavMeshes.First()->RayCast(startPosition, endPosition, hitInfo);
 }
 
+int32 Navigation::PathRequestsIterationsPerFrame = 2000;
+
+uint32 Navigation::FindPathAsync(const Vector3& startPosition, const Vector3& endPosition)
+{
+    return AddPathRequest(startPosition, endPosition, PathRequestCallback());
+}
+
+uint32 Navigation::FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, const PathRequestCallback& callback)
+{
+    return AddPathRequest(startPosition, endPosition, callback);
+}
+
+NavPathRequestState Navigation::GetPathRequestState(uint32 requestId)
+{
+    ScopeLock lock(PathRequestsLocker);
+    const PathRequest* request = PathRequests.TryGet(requestId);
+    return request ? request->State : NavPathRequestState::Invalid;
+}
+
+NavPathRequestState Navigation::GetPathRequestResult(uint32 requestId, Array<Vector3, HeapAllocation>& resultPath)
+{
+    resultPath.Clear();
+    ScopeLock lock(PathRequestsLocker);
+    PathRequest* request = PathRequests.TryGet(requestId);
+    if (!request)
+        return NavPathRequestState::Invalid;
+    const NavPathRequestState state = request->State;
+    if (state != NavPathRequestState::Pending)
+    {
+        resultPath = MoveTemp(request->Path);
+        PathRequests.Remove(requestId);
+    }
+    return state;
+}
+
+void Navigation::CancelPathRequest(uint32 requestId)
+{
+    ScopeLock lock(PathRequestsLocker);
+    if (!PathRequests.Remove(requestId))
+        return;
+    for (int32 i = 0; i < PathQueries.Count(); i++)
+    {
+        PathQuery* query = PathQueries[i];
+        if (query->Requests.Remove(requestId))
+        {
+            // Drop the query if nobody waits for it (running queries are released after they end)
+            if (query->Requests.IsEmpty() && !query->Started)
+            {
+                PathQueries.RemoveAtKeepOrder(i);
+                Delete(query);
+            }
+            break;
+        }
+    }
+}
+
 #if COMPILE_WITH_NAV_MESH_BUILDER
 
 bool Navigation::IsBuildingNavMesh()
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "NavigationTypes.h"
+#include "Engine/Core/Delegate.h"
 
 class Scene;
 
@@ -72,6 +73,55 @@ API_CLASS(Static) class FLAXENGINE_API Navigation
     /// <returns>True if ray hits an matching object, otherwise false.</returns>
     API_FUNCTION() static bool RayCast(const Vector3& startPosition, const Vector3& endPosition, API_PARAM(Out) NavMeshHit& hitInfo);
 
+public:
+    /// <summary>
+    /// The callback for the asynchronous path request completion (called on a main thread during engine update). Parameters: request id, result state and path.
+    /// </summary>
+    typedef Function<void(uint32, NavPathRequestState, const Array<Vector3, HeapAllocation>&)> PathRequestCallback;
+
+    /// <summary>
+    /// The total limit of the path search iterations (nodes visited by the A* search) performed during a single frame by all asynchronous path requests. Used to limit the per-frame cost of the pathfinding.
+    /// </summary>
+    API_FIELD() static int32 PathRequestsIterationsPerFrame;
+
+    /// <summary>
+    /// Enqueues the asynchronous path search between the two positions. Requests are processed over multiple frames by the Job System (similar requests are merged into a single search). Use GetPathRequestResult to poll the result.
+    /// </summary>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <returns>The path request identifier, or 0 if failed to create the request.</returns>
+    API_FUNCTION() static uint32 FindPathAsync(const Vector3& startPosition, const Vector3& endPosition);
+
+    /// <summary>
+    /// Enqueues the asynchronous path search between the two positions. Requests are processed over multiple frames by the Job System (similar requests are merged into a single search). The callback is called (on a main thread) once the request ends and the request gets released.
+    /// </summary>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <param name="callback">The request completion callback.</param>
+    /// <returns>The path request identifier, or 0 if failed to create the request.</returns>
+    static uint32 FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, const PathRequestCallback& callback);
+
+    /// <summary>
+    /// Gets the state of the asynchronous path request.
+    /// </summary>
+    /// <param name="requestId">The path request identifier.</param>
+    /// <returns>The request state.</returns>
+    API_FUNCTION() static NavPathRequestState GetPathRequestState(uint32 requestId);
+
+    /// <summary>
+    /// Gets the result of the asynchronous path request. Releases the request if it has ended (the identifier becomes invalid).
+    /// </summary>
+    /// <param name="requestId">The path request identifier.</param>
+    /// <param name="resultPath">The result path. Valid only if request succeeded.</param>
+    /// <returns>The request state.</returns>
+    API_FUNCTION() static NavPathRequestState GetPathRequestResult(uint32 requestId, API_PARAM(Out) Array<Vector3, HeapAllocation>& resultPath);
+
+    /// <summary>
+    /// Cancels the asynchronous path request and releases it.
+    /// </summary>
+    /// <param name="requestId">The path request identifier.</param>
+    API_FUNCTION() static void CancelPathRequest(uint32 requestId);
+
 public:
 #if COMPILE_WITH_NAV_MESH_BUILDER
 
@@ -14,14 +14,15 @@
 #include "Engine/Networking/INetworkDriver.h"
 #include "Engine/Networking/NetworkRpc.h"
 
-PACK_STRUCT(struct Data
-    {
-    uint8 LocalSpace : 1;
-    uint8 HasSequenceIndex : 1;
-    NetworkTransform::ReplicationComponents Components : 9;
-    });
+struct Data
+{
+    bool LocalSpace;
+    bool HasSequenceIndex;
+    bool Quantized;
+    NetworkTransform::ReplicationComponents Components;
+};
 
-static_assert((int32)NetworkTransform::ReplicationComponents::All + 1 == 512, "Invalid ReplicationComponents bit count for Data.");
+static_assert((int32)NetworkTransform::ReplicationComponents::All + 1 == 512, "Invalid ReplicationComponents bit count for serialization.");
 
 namespace
 {
@@ -155,14 +156,47 @@ void NetworkTransform::Serialize(NetworkStream* stream)
     else
         transform = Transform::Identity;
 
-    // Encode data
-    const NetworkObjectRole role = NetworkReplicator::GetObjectRole(this);
+    // Encode data (bit-packed)
     Data data;
     data.LocalSpace = LocalSpace;
     data.HasSequenceIndex = Mode == ReplicationModes::Prediction;
+    data.Quantized = PositionPrecision > 0.0f && ScalePrecision > 0.0f && RotationBits > 0;
     data.Components = Components;
-    stream->Write(data);
-    if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
+    stream->WriteBit(data.LocalSpace);
+    stream->WriteBit(data.HasSequenceIndex);
+    stream->WriteBit(data.Quantized);
+    stream->WriteBits((uint32)data.Components, 9);
+    if (data.Quantized)
+    {
+        const int32 rotationBits = Math::Clamp(RotationBits, 2, 30);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
+            stream->WriteQuantized((float)transform.Translation.X, PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
+            stream->WriteQuantized((float)transform.Translation.Y, PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
+            stream->WriteQuantized((float)transform.Translation.Z, PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleX))
+            stream->WriteQuantized(transform.Scale.X, ScalePrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleY))
+            stream->WriteQuantized(transform.Scale.Y, ScalePrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleZ))
+            stream->WriteQuantized(transform.Scale.Z, ScalePrecision);
+        if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
+        {
+            stream->WriteQuantized(transform.Orientation, rotationBits);
+        }
+        else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Rotation))
+        {
+            const Float3 rotation = transform.Orientation.GetEuler();
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationX))
+                stream->WriteQuantized(rotation.X, -180.0f, 180.0f, rotationBits + 2);
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationY))
+                stream->WriteQuantized(rotation.Y, -180.0f, 180.0f, rotationBits + 2);
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationZ))
+                stream->WriteQuantized(rotation.Z, -180.0f, 180.0f, rotationBits + 2);
+        }
+    }
+    else if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
     {
         stream->Write(transform);
     }
@@ -177,9 +211,9 @@ void NetworkTransform::Serialize(NetworkStream* stream)
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
                 stream->Write(transform.Translation.X);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
-                stream->Write(transform.Translation.X);
+                stream->Write(transform.Translation.Y);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
-                stream->Write(transform.Translation.X);
+                stream->Write(transform.Translation.Z);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Scale))
         {
@@ -190,9 +224,9 @@ void NetworkTransform::Serialize(NetworkStream* stream)
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleX))
                 stream->Write(transform.Scale.X);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleY))
-                stream->Write(transform.Scale.X);
+                stream->Write(transform.Scale.Y);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleZ))
-                stream->Write(transform.Scale.X);
+                stream->Write(transform.Scale.Z);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
         {
@@ -211,7 +245,7 @@ void NetworkTransform::Serialize(NetworkStream* stream)
         }
     }
     if (data.HasSequenceIndex)
-        stream->Write(_currentSequenceIndex);
+        stream->WriteBits(_currentSequenceIndex, 16);
 }
 
 void NetworkTransform::Deserialize(NetworkStream* stream)
@@ -224,10 +258,44 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
         transform = Transform::Identity;
     Transform transformLocal = transform;
 
-    // Decode data
+    // Decode data (bit-packed)
     Data data;
-    stream->Read(data);
-    if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
+    data.LocalSpace = stream->ReadBit();
+    data.HasSequenceIndex = stream->ReadBit();
+    data.Quantized = stream->ReadBit();
+    data.Components = (ReplicationComponents)stream->ReadBits(9);
+    if (data.Quantized)
+    {
+        const int32 rotationBits = Math::Clamp(RotationBits, 2, 30);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
+            transform.Translation.X = stream->ReadQuantized(PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
+            transform.Translation.Y = stream->ReadQuantized(PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
+            transform.Translation.Z = stream->ReadQuantized(PositionPrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleX))
+            transform.Scale.X = stream->ReadQuantized(ScalePrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleY))
+            transform.Scale.Y = stream->ReadQuantized(ScalePrecision);
+        if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleZ))
+            transform.Scale.Z = stream->ReadQuantized(ScalePrecision);
+        if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
+        {
+            transform.Orientation = stream->ReadQuantizedQuaternion(rotationBits);
+        }
+        else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Rotation))
+        {
+            Float3 rotation = transform.Orientation.GetEuler();
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationX))
+                rotation.X = stream->ReadQuantized(-180.0f, 180.0f, rotationBits + 2);
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationY))
+                rotation.Y = stream->ReadQuantized(-180.0f, 180.0f, rotationBits + 2);
+            if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationZ))
+                rotation.Z = stream->ReadQuantized(-180.0f, 180.0f, rotationBits + 2);
+            transform.Orientation = Quaternion::Euler(rotation);
+        }
+    }
+    else if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
     {
         stream->Read(transform);
     }
@@ -242,9 +310,9 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
                 stream->Read(transform.Translation.X);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
-                stream->Read(transform.Translation.X);
+                stream->Read(transform.Translation.Y);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
-                stream->Read(transform.Translation.X);
+                stream->Read(transform.Translation.Z);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Scale))
         {
@@ -255,9 +323,9 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleX))
                 stream->Read(transform.Scale.X);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleY))
-                stream->Read(transform.Scale.X);
+                stream->Read(transform.Scale.Y);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::ScaleZ))
-                stream->Read(transform.Scale.X);
+                stream->Read(transform.Scale.Z);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
         {
@@ -279,7 +347,7 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
     }
     uint16 sequenceIndex = 0;
     if (data.HasSequenceIndex)
-        stream->Read(sequenceIndex);
+        sequenceIndex = (uint16)stream->ReadBits(16);
     if (data.LocalSpace != LocalSpace)
         return; // TODO: convert transform space if server-client have different values set
 
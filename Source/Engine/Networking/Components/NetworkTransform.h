@@ -99,6 +99,24 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkTransfo
     API_FIELD(Attributes="EditorOrder(30)")
     ReplicationModes Mode = ReplicationModes::Default;
 
+    /// <summary>
+    /// The quantization step of the synchronized position components (eg. 0.1 results in millimeter precision). Quantized transform uses a bit-packed data to reduce the network bandwidth. Use 0 to disable quantization. Must match on all peers.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0)")
+    float PositionPrecision = 0.1f;
+
+    /// <summary>
+    /// The quantization step of the synchronized scale components. Use 0 to disable quantization. Must match on all peers.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(50), Limit(0)")
+    float ScalePrecision = 0.001f;
+
+    /// <summary>
+    /// The amount of bits per component of the synchronized rotation (smallest-three quaternion encoding, eg. 10 bits results in ~0.1 degree precision). Use 0 to disable quantization. Must match on all peers.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(60), Limit(0, 30)")
+    int32 RotationBits = 10;
+
 private:
     API_FUNCTION(Hidden, NetworkRpc=Server) void SetSequenceIndex(uint16 value);
     
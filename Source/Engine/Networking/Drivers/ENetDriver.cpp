@@ -33,21 +33,24 @@ ENetPacketFlag ChannelTypeToPacketFlag(const NetworkChannelType channel)
     return static_cast<ENetPacketFlag>(flag);
 }
 
-void SendPacketToPeer(ENetPeer* peer, const NetworkChannelType channelType, const NetworkMessage& message)
+uint32 GetPacketSizeLimit(const ENetPeer* peer)
+{
+    // Fit coalesced messages into a single datagram to prevent fragmentation
+    return peer->mtu - sizeof(ENetProtocolHeader) - sizeof(ENetProtocolSendFragment);
+}
+
+void SendPacketToPeer(ENetPeer* peer, const NetworkChannelType channelType, const Array<byte>& data)
 {
     // Covert our channel type to the internal ENet packet flags
     const ENetPacketFlag flag = ChannelTypeToPacketFlag(channelType);
 
     // This will copy the data into the packet when ENET_PACKET_FLAG_NO_ALLOCATE is not set.
-    // Tho, we cannot use it, because we're releasing the message right after the send - and the packet might not
-    // be sent, yet. To avoid data corruption, we're just using the copy method. We might fix that later, but I'll take
-    // the smaller risk.
-    ENetPacket* packet = enet_packet_create(message.Buffer, message.Length, flag);
-
-    // And send it!
-    enet_peer_send(peer, 0, packet);
+    // The queued data buffer is reused for the next messages so we need to copy it.
+    ENetPacket* packet = enet_packet_create(data.Get(), data.Count(), flag);
 
-    // TODO: To reduce latency, we can use `enet_host_flush` to flush all packets. Maybe some API, like NetworkManager::FlushQueues()?
+    // And send it! (each channel type uses a separate ENet channel to prevent blocking unreliable traffic behind reliable one)
+    if (enet_peer_send(peer, (enet_uint8)channelType, packet) != 0)
+        enet_packet_destroy(packet);
 }
 
 ENetDriver::ENetDriver(const SpawnParams& params)
@@ -60,6 +63,8 @@ bool ENetDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
     _networkHost = host;
     _config = config;
     _peerMap.Clear();
+    _queues.Clear();
+    _events.Clear();
 
     if (enet_initialize() != 0)
     {
@@ -80,6 +85,8 @@ void ENetDriver::Dispose()
     enet_deinitialize();
 
     _peerMap.Clear();
+    _queues.Clear();
+    _events.Clear();
 
     _peer = nullptr;
     _host = nullptr;
@@ -98,7 +105,7 @@ bool ENetDriver::Listen()
         enet_address_set_host(&address, _config.Address.ToStringAnsi().GetText());
 
     // Create ENet host
-    _host = enet_host_create(&address, _config.ConnectionsLimit, 1, 0, 0);
+    _host = enet_host_create(&address, _config.ConnectionsLimit, ChannelsCount, 0, 0);
     if (_host == nullptr)
     {
         LOG(Error, "Failed to initialize ENet host!");
@@ -118,7 +125,7 @@ bool ENetDriver::Connect()
     enet_address_set_host(&address, _config.Address.ToStringAnsi().GetText());
 
     // Create ENet host
-    _host = enet_host_create(nullptr, 1, 1, 0, 0);
+    _host = enet_host_create(nullptr, 1, ChannelsCount, 0, 0);
     if (_host == nullptr)
     {
         LOG(Error, "Failed to initialize ENet host!");
@@ -126,7 +133,7 @@ bool ENetDriver::Connect()
     }
 
     // Create ENet peer/connect to the server
-    _peer = enet_host_connect(_host, &address, 1, 0);
+    _peer = enet_host_connect(_host, &address, ChannelsCount, 0);
     if (_peer == nullptr)
     {
         LOG(Error, "Failed to create ENet host!");
@@ -142,6 +149,7 @@ void ENetDriver::Disconnect()
     if (_peer)
     {
         enet_peer_disconnect_now(_peer, 0);
+        _queues.Remove(_peer);
         _peer = nullptr;
         LOG(Info, "Disconnected");
     }
@@ -155,6 +163,7 @@ void ENetDriver::Disconnect(const NetworkConnection& connection)
     {
         enet_peer_disconnect_now(peer, 0);
         _peerMap.Remove(connectionId);
+        _queues.Remove(peer);
     }
     else
     {
@@ -164,6 +173,17 @@ void ENetDriver::Disconnect(const NetworkConnection& connection)
 
 bool ENetDriver::PopEvent(NetworkEvent* eventPtr)
 {
+    // Send any pending messages (in case of manual peer usage without flush)
+    SendQueues();
+
+    // Pop the remaining messages from the last received packet
+    if (_events.HasItems())
+    {
+        *eventPtr = _events[0];
+        _events.RemoveAtKeepOrder(0);
+        return true;
+    }
+
     ENetEvent event;
     const int result = enet_host_service(_host, &event, 0);
     if (result < 0)
@@ -185,18 +205,44 @@ bool ENetDriver::PopEvent(NetworkEvent* eventPtr)
             eventPtr->EventType = NetworkEventType::Disconnected;
             if (IsServer())
                 _peerMap.Remove(connectionId);
+            _queues.Remove(event.peer);
             break;
         case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT:
             eventPtr->EventType = NetworkEventType::Timeout;
             if (IsServer())
                 _peerMap.Remove(connectionId);
+            _queues.Remove(event.peer);
             break;
         case ENET_EVENT_TYPE_RECEIVE:
-            eventPtr->EventType = NetworkEventType::Message;
-            eventPtr->Message = _networkHost->CreateMessage();
-            eventPtr->Message.Length = event.packet->dataLength;
-            Platform::MemoryCopy(eventPtr->Message.Buffer, event.packet->data, event.packet->dataLength);
+        {
+            // Split packet into messages (each prefixed with 16-bit size)
+            const byte* data = event.packet->data;
+            const byte* dataEnd = data + event.packet->dataLength;
+            bool first = true;
+            while (data + sizeof(uint16) <= dataEnd)
+            {
+                uint16 length;
+                Platform::MemoryCopy(&length, data, sizeof(uint16));
+                data += sizeof(uint16);
+                if (data + length > dataEnd || length > _config.MessageSize)
+                {
+                    LOG(Warning, "Invalid network packet received from connection {0}", connectionId);
+                    break;
+                }
+                NetworkEvent& e = first ? *eventPtr : _events.AddOne();
+                e.EventType = NetworkEventType::Message;
+                e.Sender.ConnectionId = connectionId;
+                e.Message = _networkHost->CreateMessage();
+                e.Message.Length = length;
+                Platform::MemoryCopy(e.Message.Buffer, data, length);
+                data += length;
+                first = false;
+            }
+            enet_packet_destroy(event.packet);
+            if (first)
+                return false;
             break;
+        }
         default:
             break;
         }
@@ -212,7 +258,7 @@ bool ENetDriver::PopEvent(NetworkEvent* eventPtr)
 void ENetDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
 {
     ASSERT(!IsServer());
-    SendPacketToPeer(_peer, channelType, message);
+    QueueMessage(_peer, channelType, message);
 }
 
 void ENetDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
@@ -221,7 +267,7 @@ void ENetDriver::SendMessage(NetworkChannelType channelType, const NetworkMessag
     ENetPeer* peer;
     if (_peerMap.TryGet(target.ConnectionId, peer) && peer && peer->state == ENET_PEER_STATE_CONNECTED)
     {
-        SendPacketToPeer(peer, channelType, message);
+        QueueMessage(peer, channelType, message);
     }
 }
 
@@ -233,7 +279,7 @@ void ENetDriver::SendMessage(const NetworkChannelType channelType, const Network
     {
         if (_peerMap.TryGet(target.ConnectionId, peer) && peer && peer->state == ENET_PEER_STATE_CONNECTED)
         {
-            SendPacketToPeer(peer, channelType, message);
+            QueueMessage(peer, channelType, message);
         }
     }
 }
@@ -259,3 +305,45 @@ NetworkDriverStats ENetDriver::GetStats(NetworkConnection target)
     }
     return stats;
 }
+
+void ENetDriver::Flush()
+{
+    if (!_host)
+        return;
+    SendQueues();
+    enet_host_flush(_host);
+}
+
+void ENetDriver::QueueMessage(ENetPeer* peer, NetworkChannelType channelType, const NetworkMessage& message)
+{
+    ASSERT(message.Length <= MAX_uint16);
+    Array<byte>& packet = _queues[peer].Packets[(int32)channelType];
+
+    // Send the current packet if the message doesn't fit into it (bigger messages are fragmented by ENet)
+    const uint32 size = sizeof(uint16) + message.Length;
+    if (packet.HasItems() && packet.Count() + size > GetPacketSizeLimit(peer))
+    {
+        SendPacketToPeer(peer, channelType, packet);
+        packet.Clear();
+    }
+
+    const uint16 length = (uint16)message.Length;
+    packet.Add((const byte*)&length, sizeof(uint16));
+    packet.Add(message.Buffer, (int32)message.Length);
+}
+
+void ENetDriver::SendQueues()
+{
+    for (auto& e : _queues)
+    {
+        for (int32 channel = 0; channel < ChannelsCount; channel++)
+        {
+            Array<byte>& packet = e.Value.Packets[channel];
+            if (packet.HasItems())
+            {
+                SendPacketToPeer(e.Key, (NetworkChannelType)channel, packet);
+                packet.Clear();
+            }
+        }
+    }
+}
@@ -6,6 +6,9 @@
 #include "Engine/Networking/INetworkDriver.h"
 #include "Engine/Networking/NetworkConnection.h"
 #include "Engine/Networking/NetworkConfig.h"
+#include "Engine/Networking/NetworkChannelType.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Scripting/ScriptingType.h"
@@ -13,6 +16,7 @@
 /// <summary>
 /// Low-level network transport interface implementation based on ENet library.
 /// </summary>
+/// <remarks>Small messages sent to the same peer over the same channel are coalesced into MTU-sized packets (sent on flush or when the packet gets full). Each channel type uses a separate ENet channel.</remarks>
 API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API ENetDriver : public ScriptingObject, public INetworkDriver
 {
     DECLARE_SCRIPTING_TYPE(ENetDriver);
@@ -35,17 +39,31 @@ API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API ENetDr
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
     NetworkDriverStats GetStats() override;
     NetworkDriverStats GetStats(NetworkConnection target) override;
+    void Flush() override;
 
 private:
+    // Amount of ENet channels used by the driver (one per channel type)
+    static constexpr int32 ChannelsCount = (int32)NetworkChannelType::ReliableOrdered + 1;
+
+    struct PeerQueue
+    {
+        Array<byte> Packets[ChannelsCount];
+    };
+
     bool IsServer() const
     {
         return _host != nullptr && _peer == nullptr;
     }
 
+    void QueueMessage(struct _ENetPeer* peer, NetworkChannelType channelType, const NetworkMessage& message);
+    void SendQueues();
+
 private:
     NetworkConfig _config;
     NetworkPeer* _networkHost;
     struct _ENetHost* _host = nullptr;
     struct _ENetPeer* _peer = nullptr;
     Dictionary<uint32, struct _ENetPeer*> _peerMap;
+    Dictionary<struct _ENetPeer*, PeerQueue> _queues;
+    Array<NetworkEvent> _events;
 };
@@ -123,6 +123,7 @@ void NetworkLagDriver::SendMessage(const NetworkChannelType channelType, const N
 {
     auto& msg = _messages.AddOne();
     msg.Lag = (double)Lag;
+    msg.ChannelType = channelType;
     msg.Type = 0;
     msg.Message = message;
     msg.MessageData.Set(message.Buffer, message.Length);
@@ -132,6 +133,7 @@ void NetworkLagDriver::SendMessage(NetworkChannelType channelType, const Network
 {
     auto& msg = _messages.AddOne();
     msg.Lag = (double)Lag;
+    msg.ChannelType = channelType;
     msg.Type = 1;
     msg.Message = message;
     msg.Target = target;
@@ -142,6 +144,7 @@ void NetworkLagDriver::SendMessage(const NetworkChannelType channelType, const N
 {
     auto& msg = _messages.AddOne();
     msg.Lag = (double)Lag;
+    msg.ChannelType = channelType;
     msg.Type = 2;
     msg.Message = message;
     msg.Targets = targets;
@@ -162,6 +165,13 @@ NetworkDriverStats NetworkLagDriver::GetStats(NetworkConnection target)
     return _driver->GetStats(target);
 }
 
+void NetworkLagDriver::Flush()
+{
+    if (!_driver)
+        return;
+    _driver->Flush();
+}
+
 void NetworkLagDriver::OnUpdate()
 {
     if (!_driver)
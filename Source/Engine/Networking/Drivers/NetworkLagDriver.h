@@ -74,6 +74,7 @@ API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API Networ
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
     NetworkDriverStats GetStats() override;
     NetworkDriverStats GetStats(NetworkConnection target) override;
+    void Flush() override;
 
 private:
     void OnUpdate();
@@ -0,0 +1,200 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "NetworkLoopbackDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Networking/NetworkPeer.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    CriticalSection LoopbackLocker;
+    Dictionary<uint16, NetworkLoopbackDriver*> LoopbackServers;
+}
+
+NetworkLoopbackDriver::NetworkLoopbackDriver(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+String NetworkLoopbackDriver::DriverName()
+{
+    return String("Loopback");
+}
+
+bool NetworkLoopbackDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
+{
+    _host = host;
+    _config = config;
+    return false;
+}
+
+void NetworkLoopbackDriver::Dispose()
+{
+    ScopeLock lock(LoopbackLocker);
+    if (_isServer)
+    {
+        // Kick all connected clients
+        LoopbackServers.Remove(_config.Port);
+        for (auto& e : _connections)
+        {
+            NetworkLoopbackDriver* client = e.Value.Driver;
+            client->_server = nullptr;
+            client->PushEvent(NetworkEventType::Disconnected, client->_serverConnection);
+        }
+        _connections.Clear();
+        _isServer = false;
+    }
+    else
+    {
+        Disconnect();
+    }
+    _events.Clear();
+}
+
+bool NetworkLoopbackDriver::Listen()
+{
+    ScopeLock lock(LoopbackLocker);
+    if (LoopbackServers.ContainsKey(_config.Port))
+    {
+        LOG(Error, "Loopback server on port {0} already exists.", _config.Port);
+        return false;
+    }
+    LoopbackServers.Add(_config.Port, this);
+    _isServer = true;
+    LOG(Info, "Created loopback server on port {0}!", _config.Port);
+    return true;
+}
+
+bool NetworkLoopbackDriver::Connect()
+{
+    ScopeLock lock(LoopbackLocker);
+    NetworkLoopbackDriver* server = nullptr;
+    if (!LoopbackServers.TryGet(_config.Port, server))
+    {
+        LOG(Error, "Missing loopback server on port {0}.", _config.Port);
+        return false;
+    }
+    if (server->_connections.Count() >= server->_config.ConnectionsLimit)
+    {
+        LOG(Error, "Loopback server on port {0} reached the connections limit.", _config.Port);
+        return false;
+    }
+
+    // Register connection on a server and notify both sides
+    const uint32 connectionId = server->_nextConnectionId++;
+    auto& connection = server->_connections[connectionId];
+    connection.Driver = this;
+    connection.Stats = NetworkDriverStats();
+    _server = server;
+    _serverConnection.ConnectionId = connectionId;
+    server->PushEvent(NetworkEventType::Connected, _serverConnection);
+    PushEvent(NetworkEventType::Connected, _serverConnection);
+    return true;
+}
+
+void NetworkLoopbackDriver::Disconnect()
+{
+    ScopeLock lock(LoopbackLocker);
+    if (!_server)
+        return;
+    _server->_connections.Remove(_serverConnection.ConnectionId);
+    _server->PushEvent(NetworkEventType::Disconnected, _serverConnection);
+    _server = nullptr;
+}
+
+void NetworkLoopbackDriver::Disconnect(const NetworkConnection& connection)
+{
+    ScopeLock lock(LoopbackLocker);
+    LoopbackConnection* e = _connections.TryGet(connection.ConnectionId);
+    if (!e)
+        return;
+    NetworkLoopbackDriver* client = e->Driver;
+    client->_server = nullptr;
+    client->PushEvent(NetworkEventType::Disconnected, client->_serverConnection);
+    _connections.Remove(connection.ConnectionId);
+    PushEvent(NetworkEventType::Disconnected, connection);
+}
+
+bool NetworkLoopbackDriver::PopEvent(NetworkEvent* eventPtr)
+{
+    ScopeLock lock(LoopbackLocker);
+    if (_events.IsEmpty())
+        return false;
+    const LoopbackEvent& e = _events[0];
+    eventPtr->EventType = e.Type;
+    eventPtr->Sender = e.Sender;
+    if (e.Type == NetworkEventType::Message)
+    {
+        // Copy message data into the receiver peer message buffer
+        NetworkMessage message = _host->CreateMessage();
+        message.Length = Math::Min((uint32)e.MessageData.Count(), message.BufferSize);
+        Platform::MemoryCopy(message.Buffer, e.MessageData.Get(), message.Length);
+        eventPtr->Message = message;
+    }
+    _events.RemoveAtKeepOrder(0);
+    return true;
+}
+
+void NetworkLoopbackDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
+{
+    ScopeLock lock(LoopbackLocker);
+    if (!_server)
+        return;
+    if (LoopbackConnection* connection = _server->_connections.TryGet(_serverConnection.ConnectionId))
+        connection->Stats.TotalDataReceived += message.Length;
+    _stats.TotalDataSent += message.Length;
+    _server->_stats.TotalDataReceived += message.Length;
+    _server->PushEvent(NetworkEventType::Message, _serverConnection, &message);
+}
+
+void NetworkLoopbackDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
+{
+    ScopeLock lock(LoopbackLocker);
+    SendToClient(message, target);
+}
+
+void NetworkLoopbackDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets)
+{
+    ScopeLock lock(LoopbackLocker);
+    for (const NetworkConnection& target : targets)
+        SendToClient(message, target);
+}
+
+NetworkDriverStats NetworkLoopbackDriver::GetStats()
+{
+    ScopeLock lock(LoopbackLocker);
+    return _stats;
+}
+
+NetworkDriverStats NetworkLoopbackDriver::GetStats(NetworkConnection target)
+{
+    ScopeLock lock(LoopbackLocker);
+    if (const LoopbackConnection* connection = _connections.TryGet(target.ConnectionId))
+        return connection->Stats;
+    return _stats;
+}
+
+void NetworkLoopbackDriver::PushEvent(NetworkEventType type, const NetworkConnection& sender, const NetworkMessage* message)
+{
+    auto& e = _events.AddOne();
+    e.Type = type;
+    e.Sender = sender;
+    if (message)
+        e.MessageData.Set(message->Buffer, message->Length);
+    else
+        e.MessageData.Clear();
+}
+
+void NetworkLoopbackDriver::SendToClient(const NetworkMessage& message, const NetworkConnection& target)
+{
+    LoopbackConnection* connection = _connections.TryGet(target.ConnectionId);
+    if (!connection)
+        return;
+    NetworkLoopbackDriver* client = connection->Driver;
+    connection->Stats.TotalDataSent += message.Length;
+    _stats.TotalDataSent += message.Length;
+    client->_stats.TotalDataReceived += message.Length;
+    client->PushEvent(NetworkEventType::Message, client->_serverConnection, &message);
+}
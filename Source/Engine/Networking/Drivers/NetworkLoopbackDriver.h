@@ -0,0 +1,64 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Networking/INetworkDriver.h"
+#include "Engine/Networking/NetworkConfig.h"
+#include "Engine/Networking/NetworkConnection.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+
+/// <summary>
+/// Low-level network transport interface implementation that passes messages between peers within the same process (in-memory, without sockets). Peers are matched by the port from the network config. Can be used to run many simulated clients against a local server (eg. for load testing).
+/// </summary>
+API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API NetworkLoopbackDriver : public ScriptingObject, public INetworkDriver
+{
+    DECLARE_SCRIPTING_TYPE(NetworkLoopbackDriver);
+
+private:
+    struct LoopbackEvent
+    {
+        NetworkEventType Type;
+        NetworkConnection Sender;
+        Array<byte> MessageData;
+    };
+
+    struct LoopbackConnection
+    {
+        NetworkLoopbackDriver* Driver;
+        NetworkDriverStats Stats;
+    };
+
+    NetworkPeer* _host = nullptr;
+    NetworkConfig _config;
+    bool _isServer = false;
+    NetworkLoopbackDriver* _server = nullptr;
+    NetworkConnection _serverConnection = { 0 };
+    uint32 _nextConnectionId = 1;
+    Dictionary<uint32, LoopbackConnection> _connections;
+    NetworkDriverStats _stats;
+    Array<LoopbackEvent> _events;
+
+public:
+    // [INetworkDriver]
+    String DriverName() override;
+    bool Initialize(NetworkPeer* host, const NetworkConfig& config) override;
+    void Dispose() override;
+    bool Listen() override;
+    bool Connect() override;
+    void Disconnect() override;
+    void Disconnect(const NetworkConnection& connection) override;
+    bool PopEvent(NetworkEvent* eventPtr) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
+    NetworkDriverStats GetStats() override;
+    NetworkDriverStats GetStats(NetworkConnection target) override;
+
+private:
+    void PushEvent(NetworkEventType type, const NetworkConnection& sender, const NetworkMessage* message = nullptr);
+    void SendToClient(const NetworkMessage& message, const NetworkConnection& target);
+};
@@ -111,4 +111,11 @@ API_INTERFACE(Namespace="FlaxEngine.Networking") class FLAXENGINE_API INetworkDr
     /// <param name="target">The client connection to retrieve statistics for.</param>
     /// <returns>Network transport statistics data for a given connection.</returns>
     API_FUNCTION() virtual NetworkDriverStats GetStats(NetworkConnection target) = 0;
+
+    /// <summary>
+    /// Flushes all the pending (queued) messages to be sent immediately.
+    /// </summary>
+    API_FUNCTION() virtual void Flush()
+    {
+    }
 };
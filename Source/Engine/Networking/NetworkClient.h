@@ -5,6 +5,7 @@
 #include "Types.h"
 #include "NetworkConnection.h"
 #include "NetworkConnectionState.h"
+#include "Engine/Core/Math/Vector3.h"
 #include "Engine/Scripting/ScriptingObject.h"
 
 /// <summary>
@@ -32,6 +33,11 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     /// </summary>
     API_FIELD(ReadOnly) NetworkConnectionState State;
 
+    /// <summary>
+    /// Client view location (eg. player position) used on server by the network replication relevancy (see NetworkReplicator::RelevancyDistance).
+    /// </summary>
+    API_FIELD() Vector3 ViewPosition = Vector3::Zero;
+
 public:
     String ToString() const override
     {
@@ -4,6 +4,8 @@
 
 #include "Types.h"
 
+struct NetworkClientConnectionData;
+
 enum class NetworkMessageIDs : uint8
 {
     None = 0,
@@ -15,6 +17,8 @@ enum class NetworkMessageIDs : uint8
     ObjectDespawn,
     ObjectRole,
     ObjectRpc,
+    ObjectReplicateAck,
+    ObjectsSynced,
 
     MAX,
 };
@@ -22,6 +26,8 @@ enum class NetworkMessageIDs : uint8
 class NetworkInternal
 {
 public:
+    static void SendHandshake(NetworkPeer* peer, const NetworkClientConnectionData& connectionData);
+    static bool ReadHandshakeReply(NetworkEvent& event, uint32& clientId);
     static void NetworkReplicatorClientConnected(NetworkClient* client);
     static void NetworkReplicatorClientDisconnected(NetworkClient* client);
     static void NetworkReplicatorClear();
@@ -33,4 +39,6 @@ class NetworkInternal
     static void OnNetworkMessageObjectDespawn(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRole(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectsSynced(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
 };
@@ -0,0 +1,228 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "NetworkLoadTest.h"
+#include "NetworkManager.h"
+#include "NetworkPeer.h"
+#include "NetworkConfig.h"
+#include "NetworkConnectionState.h"
+#include "NetworkEvent.h"
+#include "NetworkSettings.h"
+#include "NetworkStats.h"
+#include "NetworkInternal.h"
+#include "INetworkDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Scripting/Scripting.h"
+
+Delegate<NetworkPeer*, int32> NetworkLoadTest::ClientUpdate;
+
+namespace
+{
+    struct SimulatedClient
+    {
+        NetworkPeer* Peer;
+        uint32 ClientId;
+        NetworkConnectionState State;
+    };
+
+    Array<SimulatedClient> Clients;
+    double StartTime = 0;
+    uint64 StartMemory = 0;
+    uint32 LastServerFrame = 0;
+    int32 ServerUpdates = 0;
+    double ServerUpdateTimeSum = 0;
+    float ServerUpdateTimeMax = 0;
+}
+
+class NetworkLoadTestService : public EngineService
+{
+public:
+    NetworkLoadTestService()
+        : EngineService(TEXT("Network Load Test"), 1001)
+    {
+    }
+
+    void Update() override;
+
+    void Dispose() override
+    {
+        NetworkLoadTest::Stop();
+    }
+};
+
+NetworkLoadTestService NetworkLoadTestServiceInstance;
+
+void NetworkLoadTestService::Update()
+{
+    if (Clients.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Gather server update timings
+    if (NetworkManager::Frame != LastServerFrame && NetworkManager::IsServer())
+    {
+        LastServerFrame = NetworkManager::Frame;
+        ServerUpdates++;
+        ServerUpdateTimeSum += NetworkManager::UpdateTime;
+        ServerUpdateTimeMax = Math::Max(ServerUpdateTimeMax, NetworkManager::UpdateTime);
+    }
+
+    for (int32 i = 0; i < Clients.Count(); i++)
+    {
+        SimulatedClient& client = Clients[i];
+        if (!client.Peer)
+            continue;
+
+        // Process incoming events (replicated data is dropped)
+        NetworkEvent event;
+        while (client.Peer->PopEvent(event))
+        {
+            switch (event.EventType)
+            {
+            case NetworkEventType::Connected:
+            {
+                NetworkClientConnectionData connectionData;
+                connectionData.Client = nullptr;
+                connectionData.Result = 0;
+                connectionData.Platform = PLATFORM_TYPE;
+                connectionData.Architecture = PLATFORM_ARCH;
+                NetworkInternal::SendHandshake(client.Peer, connectionData);
+                break;
+            }
+            case NetworkEventType::Disconnected:
+            case NetworkEventType::Timeout:
+                client.State = NetworkConnectionState::Disconnected;
+                break;
+            case NetworkEventType::Message:
+                if (*event.Message.Buffer == (uint8)NetworkMessageIDs::HandshakeReply)
+                {
+                    if (NetworkInternal::ReadHandshakeReply(event, client.ClientId))
+                    {
+                        LOG(Warning, "Simulated client {0} connection blocked.", i);
+                        client.State = NetworkConnectionState::Disconnected;
+                    }
+                    else
+                    {
+                        client.State = NetworkConnectionState::Connected;
+                    }
+                }
+                client.Peer->RecycleMessage(event.Message);
+                break;
+            }
+        }
+
+        // Replay scripted inputs and RPCs
+        if (client.State == NetworkConnectionState::Connected)
+            NetworkLoadTest::ClientUpdate(client.Peer, i);
+
+        client.Peer->Flush();
+    }
+}
+
+int32 NetworkLoadTest::GetClientsCount()
+{
+    return Clients.Count();
+}
+
+NetworkPeer* NetworkLoadTest::GetClientPeer(int32 index)
+{
+    return index >= 0 && index < Clients.Count() ? Clients[index].Peer : nullptr;
+}
+
+uint32 NetworkLoadTest::GetClientId(int32 index)
+{
+    return index >= 0 && index < Clients.Count() && Clients[index].State == NetworkConnectionState::Connected ? Clients[index].ClientId : 0;
+}
+
+bool NetworkLoadTest::Start(int32 clientsCount, const StringAnsiView& networkDriver)
+{
+    PROFILE_CPU();
+    Stop();
+    const auto& settings = *NetworkSettings::Get();
+    const StringAnsiView driverTypeName = networkDriver.HasChars() ? networkDriver : StringAnsiView(settings.NetworkDriver);
+    const ScriptingTypeHandle networkDriverType = Scripting::FindScriptingType(driverTypeName);
+    if (!networkDriverType)
+    {
+        LOG(Error, "Unknown Network Driver type {0}", String(driverTypeName));
+        return true;
+    }
+    LOG(Info, "Starting network load test with {0} simulated clients", clientsCount);
+
+    StartTime = Platform::GetTimeSeconds();
+    StartMemory = Platform::GetProcessMemoryStats().UsedPhysicalMemory;
+    LastServerFrame = NetworkManager::Frame;
+    ServerUpdates = 0;
+    ServerUpdateTimeSum = 0;
+    ServerUpdateTimeMax = 0;
+
+    // Spawn simulated clients
+    NetworkConfig networkConfig;
+    networkConfig.Address = settings.Address;
+    networkConfig.Port = settings.Port;
+    networkConfig.ConnectionsLimit = 1;
+    networkConfig.MessagePoolSize = 256; // Incoming messages are recycled right away so use a small pool to keep clients lightweight
+    Clients.EnsureCapacity(clientsCount);
+    for (int32 i = 0; i < clientsCount; i++)
+    {
+        networkConfig.NetworkDriver = ScriptingObject::NewObject(networkDriverType);
+        NetworkPeer* peer = NetworkPeer::CreatePeer(networkConfig);
+        if (!peer || !peer->Connect())
+        {
+            LOG(Error, "Failed to connect simulated client {0} to {1}:{2}", i, networkConfig.Address, networkConfig.Port);
+            NetworkPeer::ShutdownPeer(peer);
+            Stop();
+            return true;
+        }
+        auto& client = Clients.AddOne();
+        client.Peer = peer;
+        client.ClientId = 0;
+        client.State = NetworkConnectionState::Connecting;
+    }
+
+    return false;
+}
+
+void NetworkLoadTest::Stop()
+{
+    if (Clients.IsEmpty())
+        return;
+    PROFILE_CPU();
+    LOG(Info, "Stopping network load test");
+    for (auto& client : Clients)
+    {
+        if (client.State != NetworkConnectionState::Disconnected)
+            client.Peer->Disconnect();
+        NetworkPeer::ShutdownPeer(client.Peer);
+    }
+    Clients.Clear();
+}
+
+NetworkLoadTestResults NetworkLoadTest::GetResults()
+{
+    NetworkLoadTestResults results;
+    uint64 totalSent = 0, totalReceived = 0;
+    for (const auto& client : Clients)
+    {
+        if (client.State == NetworkConnectionState::Connected)
+            results.ConnectedClients++;
+        const NetworkDriverStats stats = client.Peer->NetworkDriver->GetStats();
+        totalSent += stats.TotalDataSent;
+        totalReceived += stats.TotalDataReceived;
+    }
+    if (ServerUpdates > 0)
+        results.ServerUpdateTimeAvg = (float)(ServerUpdateTimeSum / ServerUpdates);
+    results.ServerUpdateTimeMax = ServerUpdateTimeMax;
+    results.UsedPhysicalMemory = Platform::GetProcessMemoryStats().UsedPhysicalMemory;
+    results.UsedPhysicalMemoryDelta = (int64)results.UsedPhysicalMemory - (int64)StartMemory;
+    const double duration = Platform::GetTimeSeconds() - StartTime;
+    if (Clients.HasItems() && duration > 0.0)
+    {
+        results.ReceivedBytesPerClient = (float)(totalReceived / duration / Clients.Count());
+        results.SentBytesPerClient = (float)(totalSent / duration / Clients.Count());
+    }
+    return results;
+}
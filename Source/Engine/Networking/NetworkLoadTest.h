@@ -0,0 +1,109 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Types.h"
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Types/StringView.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+/// <summary>
+/// The network load test results container.
+/// </summary>
+API_STRUCT(Namespace="FlaxEngine.Networking") struct FLAXENGINE_API NetworkLoadTestResults
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(NetworkLoadTestResults);
+
+    /// <summary>
+    /// The amount of simulated clients that are connected to the server (completed the handshake).
+    /// </summary>
+    API_FIELD() int32 ConnectedClients = 0;
+
+    /// <summary>
+    /// The average time (in milliseconds) of the server network update (since the test start).
+    /// </summary>
+    API_FIELD() float ServerUpdateTimeAvg = 0.0f;
+
+    /// <summary>
+    /// The maximum time (in milliseconds) of the server network update (since the test start).
+    /// </summary>
+    API_FIELD() float ServerUpdateTimeMax = 0.0f;
+
+    /// <summary>
+    /// The amount of physical memory (in bytes) used by the process.
+    /// </summary>
+    API_FIELD() uint64 UsedPhysicalMemory = 0;
+
+    /// <summary>
+    /// The difference of physical memory (in bytes) used by the process since the test start.
+    /// </summary>
+    API_FIELD() int64 UsedPhysicalMemoryDelta = 0;
+
+    /// <summary>
+    /// The average amount of data bytes per second received by a single simulated client (server upload per client).
+    /// </summary>
+    API_FIELD() float ReceivedBytesPerClient = 0.0f;
+
+    /// <summary>
+    /// The average amount of data bytes per second sent by a single simulated client (server download per client).
+    /// </summary>
+    API_FIELD() float SentBytesPerClient = 0.0f;
+};
+
+template<>
+struct TIsPODType<NetworkLoadTestResults>
+{
+    enum { Value = true };
+};
+
+/// <summary>
+/// Network load testing utility. Runs many lightweight simulated clients within the same process that connect to the local server (started via NetworkManager) and can replay scripted inputs and RPCs to measure server tick time, memory and bandwidth per clients count.
+/// </summary>
+/// <remarks>Simulated clients perform the connection handshake but don't process replicated data (messages are received and dropped, without acknowledgements), thus measured bandwidth is the worst case.</remarks>
+API_CLASS(static, Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkLoadTest
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(NetworkLoadTest);
+
+public:
+    /// <summary>
+    /// Event called on update for every simulated client that is connected to the server. Can be used to send scripted inputs or RPCs via the client peer. Arguments: client peer and client index.
+    /// </summary>
+    API_EVENT() static Delegate<NetworkPeer*, int32> ClientUpdate;
+
+    /// <summary>
+    /// Gets the amount of the simulated clients.
+    /// </summary>
+    API_PROPERTY() static int32 GetClientsCount();
+
+    /// <summary>
+    /// Gets the simulated client peer.
+    /// </summary>
+    /// <param name="index">The client index.</param>
+    /// <returns>The peer or null if invalid index.</returns>
+    API_FUNCTION() static NetworkPeer* GetClientPeer(int32 index);
+
+    /// <summary>
+    /// Gets the simulated client identifier assigned by the server.
+    /// </summary>
+    /// <param name="index">The client index.</param>
+    /// <returns>The client identifier or 0 if not connected.</returns>
+    API_FUNCTION() static uint32 GetClientId(int32 index);
+
+    /// <summary>
+    /// Starts the load test by connecting the simulated clients to the server. Uses address and port from the network settings.
+    /// </summary>
+    /// <param name="clientsCount">The amount of simulated clients to spawn.</param>
+    /// <param name="networkDriver">The type name of the network driver to use by simulated clients (eg. FlaxEngine.Networking.NetworkLoopbackDriver for in-memory transport). Empty to use the driver from the network settings.</param>
+    /// <returns>True if failed to start, otherwise false.</returns>
+    API_FUNCTION() static bool Start(int32 clientsCount, const StringAnsiView& networkDriver = StringAnsiView::Empty);
+
+    /// <summary>
+    /// Stops the load test and disconnects all the simulated clients.
+    /// </summary>
+    API_FUNCTION() static void Stop();
+
+    /// <summary>
+    /// Gets the current load test results.
+    /// </summary>
+    API_FUNCTION() static NetworkLoadTestResults GetResults();
+};
@@ -3,6 +3,7 @@
 #include "NetworkManager.h"
 #include "NetworkClient.h"
 #include "NetworkPeer.h"
+#include "NetworkReplicator.h"
 #include "NetworkEvent.h"
 #include "NetworkChannelType.h"
 #include "NetworkSettings.h"
@@ -12,16 +13,19 @@
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Engine/Time.h"
+#include "Engine/Platform/Platform.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Scripting/Scripting.h"
 
-#define NETWORK_PROTOCOL_VERSION 1
+#define NETWORK_PROTOCOL_VERSION 5
 
 float NetworkManager::NetworkFPS = 60.0f;
 NetworkPeer* NetworkManager::Peer = nullptr;
 NetworkManagerMode NetworkManager::Mode = NetworkManagerMode::Offline;
 NetworkConnectionState NetworkManager::State = NetworkConnectionState::Offline;
 uint32 NetworkManager::Frame = 0;
+float NetworkManager::UpdateTime = 0.0f;
 uint32 NetworkManager::LocalClientId = 0;
 NetworkClient* NetworkManager::LocalClient = nullptr;
 Array<NetworkClient*> NetworkManager::Clients;
@@ -55,6 +59,29 @@ PACK_STRUCT(struct NetworkMessageHandshakeReply
     int32 Result;
     });
 
+void NetworkInternal::SendHandshake(NetworkPeer* peer, const NetworkClientConnectionData& connectionData)
+{
+    NetworkMessageHandshake msgData;
+    msgData.EngineBuild = FLAXENGINE_VERSION_BUILD;
+    msgData.EngineProtocolVersion = NETWORK_PROTOCOL_VERSION;
+    msgData.GameProtocolVersion = GameProtocolVersion;
+    msgData.Platform = (byte)connectionData.Platform;
+    msgData.Architecture = (byte)connectionData.Architecture;
+    msgData.PayloadDataSize = (uint16)connectionData.PayloadData.Count();
+    NetworkMessage msg = peer->BeginSendMessage();
+    msg.WriteStructure(msgData);
+    msg.WriteBytes(connectionData.PayloadData.Get(), connectionData.PayloadData.Count());
+    peer->EndSendMessage(NetworkChannelType::ReliableOrdered, msg);
+}
+
+bool NetworkInternal::ReadHandshakeReply(NetworkEvent& event, uint32& clientId)
+{
+    NetworkMessageHandshakeReply msgData;
+    event.Message.ReadStructure(msgData);
+    clientId = msgData.ClientId;
+    return msgData.Result != 0;
+}
+
 void OnNetworkMessageHandshake(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
     // Read client connection data
@@ -134,6 +161,8 @@ namespace
         NetworkInternal::OnNetworkMessageObjectDespawn,
         NetworkInternal::OnNetworkMessageObjectRole,
         NetworkInternal::OnNetworkMessageObjectRpc,
+        NetworkInternal::OnNetworkMessageObjectReplicateAck,
+        NetworkInternal::OnNetworkMessageObjectsSynced,
     };
 }
 
@@ -203,6 +232,7 @@ void StopPeer()
     if (!NetworkManager::Peer)
         return;
     PROFILE_CPU();
+    PROFILE_MEM(Networking);
     if (NetworkManager::Mode == NetworkManagerMode::Client)
         NetworkManager::Peer->Disconnect();
     NetworkPeer::ShutdownPeer(NetworkManager::Peer);
@@ -212,6 +242,9 @@ void StopPeer()
 void NetworkSettings::Apply()
 {
     NetworkManager::NetworkFPS = NetworkFPS;
+    NetworkReplicator::ClientBandwidth = ClientBandwidth;
+    NetworkReplicator::PriorityDistance = PriorityDistance;
+    NetworkReplicator::LateJoinBudget = LateJoinBudget;
     GameProtocolVersion = ProtocolVersion;
 }
 
@@ -342,6 +375,13 @@ void NetworkManager::Stop()
     StateChanged();
 }
 
+void NetworkManager::Flush()
+{
+    PROFILE_CPU();
+    if (Peer)
+        Peer->Flush();
+}
+
 void NetworkManagerService::Update()
 {
     const double currentTime = Time::Update.UnscaledTime.GetTotalSeconds();
@@ -350,6 +390,7 @@ void NetworkManagerService::Update()
     if (NetworkManager::Mode == NetworkManagerMode::Offline || (float)(currentTime - LastUpdateTime) < minDeltaTime || !peer)
         return;
     PROFILE_CPU();
+    const double updateStartTime = Platform::GetTimeSeconds();
     LastUpdateTime = currentTime;
     NetworkManager::Frame++;
     NetworkInternal::NetworkReplicatorPreUpdate();
@@ -380,17 +421,7 @@ void NetworkManagerService::Update()
                 }
 
                 // Send initial handshake message from client to server
-                NetworkMessageHandshake msgData;
-                msgData.EngineBuild = FLAXENGINE_VERSION_BUILD;
-                msgData.EngineProtocolVersion = NETWORK_PROTOCOL_VERSION;
-                msgData.GameProtocolVersion = GameProtocolVersion;
-                msgData.Platform = (byte)connectionData.Platform;
-                msgData.Architecture = (byte)connectionData.Architecture;
-                msgData.PayloadDataSize = (uint16)connectionData.PayloadData.Count();
-                NetworkMessage msg = peer->BeginSendMessage();
-                msg.WriteStructure(msgData);
-                msg.WriteBytes(connectionData.PayloadData.Get(), connectionData.PayloadData.Count());
-                peer->EndSendMessage(NetworkChannelType::ReliableOrdered, msg);
+                NetworkInternal::SendHandshake(peer, connectionData);
             }
             else
             {
@@ -452,4 +483,8 @@ void NetworkManagerService::Update()
 
     // Update replication
     NetworkInternal::NetworkReplicatorUpdate();
+
+    // Send all queued messages
+    NetworkManager::Flush();
+    NetworkManager::UpdateTime = (float)((Platform::GetTimeSeconds() - updateStartTime) * 1000.0);
 }
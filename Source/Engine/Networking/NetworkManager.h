@@ -74,6 +74,11 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     /// </summary>
     API_FIELD(ReadOnly) static uint32 Frame;
 
+    /// <summary>
+    /// The time (in milliseconds) spent on the last network update (messages processing, replication and sending). Can be used to measure server tick cost.
+    /// </summary>
+    API_FIELD(ReadOnly) static float UpdateTime;
+
     /// <summary>
     /// Server client identifier. Constant value of 0.
     /// </summary>
@@ -167,4 +172,9 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     /// Stops the network.
     /// </summary>
     API_FUNCTION() static void Stop();
+
+    /// <summary>
+    /// Flushes all the pending network messages to be sent immediately. Called automatically at the end of the network update.
+    /// </summary>
+    API_FUNCTION() static void Flush();
 };
@@ -134,6 +134,11 @@ bool NetworkPeer::PopEvent(NetworkEvent& eventRef)
     return NetworkDriver->PopEvent(&eventRef);
 }
 
+void NetworkPeer::Flush()
+{
+    NetworkDriver->Flush();
+}
+
 NetworkMessage NetworkPeer::CreateMessage()
 {
     const uint32 messageId = MessagePool.Pop();
@@ -68,6 +68,12 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     API_FUNCTION()
     bool PopEvent(API_PARAM(out) NetworkEvent& eventRef);
 
+    /// <summary>
+    /// Flushes all the pending messages to be sent immediately (driver can coalesce multiple messages into a single packet).
+    /// </summary>
+    API_FUNCTION()
+    void Flush();
+
     /// <summary>
     /// Acquires new message from the pool.
     /// Cannot acquire more messages than the limit specified in the <seealso cref="NetworkConfig"/> structure.
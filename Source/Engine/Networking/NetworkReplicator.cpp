@@ -15,6 +15,7 @@
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Types/DataContainer.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Engine/EngineService.h"
@@ -23,9 +24,11 @@
 #include "Engine/Level/Prefabs/Prefab.h"
 #include "Engine/Level/Prefabs/PrefabManager.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ThreadLocal.h"
 
@@ -39,13 +42,26 @@
 #define NETWORK_REPLICATOR_LOG(messageType, format, ...)
 #endif
 
+// Minimum amount of objects to serialize per job (smaller amounts are serialized on the main thread)
+#define NETWORK_REPLICATOR_SERIALIZE_BATCH 64
+
+// Amount of the recent object states kept (on both server and client) as baselines for delta-compressed replication
+#define NETWORK_REPLICATOR_BASELINES 8
+
+// Time (in seconds) after which the incomplete multi-part replication data gets dropped (eg. some part was lost)
+#define NETWORK_REPLICATOR_PARTS_TIMEOUT 2.0
+
+// Maximum amount of the multi-part replication data buffers kept for reuse
+#define NETWORK_REPLICATOR_PARTS_POOL 32
+
 PACK_STRUCT(struct NetworkMessageObjectReplicate
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicate;
     uint32 OwnerFrame;
+    uint32 BaselineFrame; // Frame of the object state that data is delta-encoded against (0 for full state)
     Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
     Guid ParentId;
-    char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 ObjectTypeId; // Stable network identifier of the object type (see GetNetworkId)
     uint16 DataSize;
     uint16 PartsCount;
     });
@@ -61,6 +77,23 @@ PACK_STRUCT(struct NetworkMessageObjectReplicatePart
     Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
     });
 
+PACK_STRUCT(struct NetworkMessageObjectReplicateAck
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicateAck;
+    uint16 ItemsCount;
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectReplicateAckItem
+    {
+    Guid ObjectId;
+    uint32 Frame;
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectsSynced
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectsSynced;
+    });
+
 PACK_STRUCT(struct NetworkMessageObjectSpawn
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectSpawn;
@@ -74,7 +107,7 @@ PACK_STRUCT(struct NetworkMessageObjectSpawnItem
     Guid ObjectId;
     Guid ParentId;
     Guid PrefabObjectID;
-    char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 ObjectTypeId; // Stable network identifier of the object type (see GetNetworkId)
     });
 
 PACK_STRUCT(struct NetworkMessageObjectDespawn
@@ -94,11 +127,34 @@ PACK_STRUCT(struct NetworkMessageObjectRpc
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectRpc;
     Guid ObjectId;
-    char RpcTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
-    char RpcName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 RpcId; // Stable network identifier of the RPC type and method name (see GetNetworkId)
     uint16 ArgsSize;
     });
 
+struct ReplicationBaseline
+{
+    uint32 Frame;
+    Array<byte> Data;
+};
+
+template<>
+struct TIsTriviallyRelocatable<ReplicationBaseline>
+{
+    enum { Value = true };
+};
+
+struct ReplicationAck
+{
+    uint32 ConnectionId;
+    uint32 Frame;
+};
+
+struct ReplicationPending
+{
+    uint32 ClientId;
+    float Priority;
+};
+
 struct NetworkReplicatedObject
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -108,7 +164,17 @@ struct NetworkReplicatedObject
     uint32 LastOwnerFrame = 0;
     NetworkObjectRole Role;
     uint8 Spawned = false;
+    uint8 Dirty = true;
+    float ReplicationFPS = 0.0f;
+    double LastReplicationTime = 0.0;
     DataContainer<uint32> TargetClientIds;
+    Array<uint32> HiddenClientIds;
+    Array<ReplicationBaseline> Baselines;
+    Array<ReplicationAck> Acks;
+    Array<ReplicationPending> Pending;
+    Array<NetworkConnection> PendingTargets;
+    uint16 LastSize = 0;
+    uint8 NextBaseline = 0;
     INetworkObject* AsNetworkObject;
 
     bool operator==(const NetworkReplicatedObject& other) const
@@ -146,9 +212,9 @@ struct Serializer
 struct ReplicateItem
 {
     ScriptingObjectReference<ScriptingObject> Object;
-    Guid ObjectId;
     uint16 PartsLeft;
-    uint32 OwnerFrame;
+    uint32 BaselineFrame;
+    double Time;
     Array<byte> Data;
 };
 
@@ -173,6 +239,45 @@ struct DespawnItem
     DataContainer<uint32> Targets;
 };
 
+struct RelevancySpawn
+{
+    NetworkClient* Client;
+    Array<SpawnGroup, InlinedAllocation<8>> Groups;
+};
+
+struct LateJoinObject
+{
+    float Priority;
+    int32 Root;
+    Guid ObjectId;
+};
+
+struct LateJoinSync
+{
+    NetworkClient* Client;
+    int32 Cursor;
+    Array<LateJoinObject> Objects;
+};
+
+struct SerializeItem
+{
+    NetworkReplicatedObject* Item;
+    int32 StreamIndex;
+    uint32 Offset;
+    uint32 Size;
+    uint64 Time;
+    bool Failed;
+};
+
+struct ReplicationStats
+{
+    uint64 BytesSent = 0;
+    uint64 BytesReceived = 0;
+    uint32 MessagesSent = 0;
+    uint32 MessagesReceived = 0;
+    uint64 TimeCycles = 0;
+};
+
 struct RpcItem
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -185,7 +290,8 @@ namespace
 {
     CriticalSection ObjectsLock;
     HashSet<NetworkReplicatedObject> Objects;
-    Array<ReplicateItem> ReplicationParts;
+    Dictionary<Pair<Guid, uint32>, ReplicateItem> ReplicationParts;
+    Array<Array<byte>> ReplicationPartsPool;
     Array<SpawnItem> SpawnQueue;
     Array<DespawnItem> DespawnQueue;
     Array<RpcItem> RpcQueue;
@@ -193,14 +299,38 @@ namespace
     NetworkStream* CachedWriteStream = nullptr;
     NetworkStream* CachedReadStream = nullptr;
     Array<NetworkClient*> NewClients;
+    Array<LateJoinSync> LateJoins;
     Array<NetworkConnection> CachedTargets;
+    Array<NetworkConnection> CachedDeltaTargets;
+    Array<byte> CachedDeltaData;
+    Array<NetworkMessageObjectReplicateAckItem> AcksQueue;
     Dictionary<ScriptingTypeHandle, Serializer> SerializersTable;
+    Dictionary<ScriptingTypeHandle, float> ReplicationFPSTable;
 #if !COMPILE_WITHOUT_CSHARP
     Dictionary<StringAnsiView, StringAnsi*> CSharpCachedNames;
 #endif
     Array<Guid> DespawnedObjects;
+    Dictionary<uint64, Array<NetworkClient*, InlinedAllocation<4>>> RelevancyGrid;
+    Dictionary<uint32, ScriptingTypeHandle> NetworkTypesTable;
+    Dictionary<uint32, NetworkRpcName> NetworkRpcsTable;
+    int32 NetworkTypesTableSize = 0;
+    int32 NetworkRpcsTableSize = 0;
+    double LastBudgetTime = 0.0;
+    Array<SerializeItem> SerializeQueue;
+    Array<NetworkStream*> CachedJobStreams;
+    THREADLOCAL bool IsSerializeJob = false;
+    Dictionary<ScriptingTypeHandle, ReplicationStats> TypesStats;
+    Dictionary<NetworkRpcName, ReplicationStats> RpcsStats;
 }
 
+bool NetworkReplicator::EnableDeltaCompression = true;
+float NetworkReplicator::RelevancyDistance = 0.0f;
+int32 NetworkReplicator::ClientBandwidth = 0;
+float NetworkReplicator::PriorityDistance = 5000.0f;
+int32 NetworkReplicator::LateJoinBudget = 256;
+Action NetworkReplicator::WorldReady;
+Function<bool(ScriptingObject*, NetworkClient*)> NetworkReplicator::RelevancyCallback;
+
 class NetworkReplicationService : public EngineService
 {
 public:
@@ -209,12 +339,31 @@ class NetworkReplicationService : public EngineService
     {
     }
 
+    bool Init() override;
     void Dispose() override;
 };
 
+static void OnScriptsReloading()
+{
+    // Lookup tables reference types and RPC names from the modules that are going to be unloaded
+    NetworkTypesTable.Clear();
+    NetworkRpcsTable.Clear();
+    NetworkTypesTableSize = 0;
+    NetworkRpcsTableSize = 0;
+}
+
+bool NetworkReplicationService::Init()
+{
+    Scripting::ScriptsReloading.Bind<OnScriptsReloading>();
+    return false;
+}
+
 void NetworkReplicationService::Dispose()
 {
+    Scripting::ScriptsReloading.Unbind<OnScriptsReloading>();
     NetworkInternal::NetworkReplicatorClear();
+    TypesStats.Clear();
+    RpcsStats.Clear();
 #if !COMPILE_WITHOUT_CSHARP
     CSharpCachedNames.ClearDelete();
 #endif
@@ -234,6 +383,106 @@ void INetworkSerializable_Deserialize(void* instance, NetworkStream* stream, voi
     ((INetworkSerializable*)((byte*)instance + vtableOffset))->Deserialize(stream);
 }
 
+static uint32 GetNetworkId(const StringAnsiView& name, uint32 hash = 2166136261u)
+{
+    // FNV-1a hash to get the same identifier of the type or RPC name on all peers (without sending strings over network)
+    for (int32 i = 0; i < name.Length(); i++)
+        hash = (hash ^ (uint8)name.Get()[i]) * 16777619u;
+    return hash;
+}
+
+FORCE_INLINE static uint32 GetNetworkId(const NetworkRpcName& name)
+{
+    return GetNetworkId(name.Second, GetNetworkId(name.First.GetType().Fullname));
+}
+
+// Gets the type for the network identifier (returns invalid handle for unknown or colliding identifiers).
+static ScriptingTypeHandle FindNetworkType(uint32 typeId)
+{
+    ScriptingTypeHandle type;
+    if (NetworkTypesTable.TryGet(typeId, type))
+        return type;
+
+    // Rebuild the lookup table when scripting types changed (eg. new binary module got loaded)
+    const auto& modules = BinaryModule::GetModules();
+    int32 typesCount = 0;
+    for (const BinaryModule* module : modules)
+        typesCount += module->Types.Count();
+    if (typesCount == NetworkTypesTableSize)
+        return type;
+    PROFILE_CPU();
+    NetworkTypesTableSize = typesCount;
+    NetworkTypesTable.Clear();
+    for (BinaryModule* module : modules)
+    {
+        for (int32 typeIndex = 0; typeIndex < module->Types.Count(); typeIndex++)
+        {
+            const ScriptingType& e = module->Types[typeIndex];
+            const uint32 id = GetNetworkId(e.Fullname);
+            ScriptingTypeHandle* other = NetworkTypesTable.TryGet(id);
+            if (other)
+            {
+                // Neither of the colliding types can be used over network (objects of these types are rejected when added to the replication)
+                if (*other)
+                    LOG(Error, "[NetworkReplicator] Network identifier collision of types {0} and {1}", String(e.Fullname), other->ToString());
+                else
+                    LOG(Error, "[NetworkReplicator] Network identifier collision of type {0}", String(e.Fullname));
+                *other = ScriptingTypeHandle();
+                continue;
+            }
+            NetworkTypesTable.Add(id, ScriptingTypeHandle(module, typeIndex));
+        }
+    }
+    NetworkTypesTable.TryGet(typeId, type);
+    return type;
+}
+
+// Gets the RPC name for the network identifier (returns null for unknown or colliding identifiers).
+static const NetworkRpcName* FindNetworkRpc(uint32 rpcId)
+{
+    const NetworkRpcName* name = NetworkRpcsTable.TryGet(rpcId);
+    if (!name && NetworkRpcsTableSize != NetworkRpcInfo::RPCsTable.Count())
+    {
+        // Rebuild the lookup table when RPCs changed (eg. registered by the newly loaded scripts)
+        NetworkRpcsTableSize = NetworkRpcInfo::RPCsTable.Count();
+        NetworkRpcsTable.Clear();
+        for (const auto& e : NetworkRpcInfo::RPCsTable)
+        {
+            const uint32 id = GetNetworkId(e.Key);
+            NetworkRpcName* other = NetworkRpcsTable.TryGet(id);
+            if (other)
+            {
+                // Neither of the colliding RPCs can be invoked (rather than dispatching to the wrong method)
+                LOG(Error, "[NetworkReplicator] Network identifier collision of RPC {0}::{1}", e.Key.First.ToString(), String(e.Key.Second));
+                *other = NetworkRpcName();
+                continue;
+            }
+            NetworkRpcsTable.Add(id, e.Key);
+        }
+        name = NetworkRpcsTable.TryGet(rpcId);
+    }
+    return name && name->First ? name : nullptr;
+}
+
+// Lock for the read-only objects lookup that is skipped within the serialization jobs (update holds the lock and objects don't change until all jobs end)
+struct ObjectsLookupLock
+{
+    const bool Locked;
+
+    ObjectsLookupLock()
+        : Locked(!IsSerializeJob)
+    {
+        if (Locked)
+            ObjectsLock.Lock();
+    }
+
+    ~ObjectsLookupLock()
+    {
+        if (Locked)
+            ObjectsLock.Unlock();
+    }
+};
+
 NetworkReplicatedObject* ResolveObject(Guid objectId)
 {
     auto it = Objects.Find(objectId);
@@ -244,7 +493,7 @@ NetworkReplicatedObject* ResolveObject(Guid objectId)
     return it != Objects.End() ? &it->Item : nullptr;
 }
 
-NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, char objectTypeName[128])
+NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, uint32 objectTypeId)
 {
     // Lookup object
     NetworkReplicatedObject* obj = ResolveObject(objectId);
@@ -253,7 +502,7 @@ NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, char object
 
     // Try to find the object within the same parent (eg. spawned locally on both client and server)
     IdsRemappingTable.TryGet(parentId, parentId);
-    const ScriptingTypeHandle objectType = Scripting::FindScriptingType(StringAnsiView(objectTypeName));
+    const ScriptingTypeHandle objectType = FindNetworkType(objectTypeId);
     if (!objectType)
         return nullptr;
     for (auto& e : Objects)
@@ -336,10 +585,86 @@ FORCE_INLINE void BuildCachedTargets(const NetworkReplicatedObject& item)
     BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, item.OwnerClientId);
 }
 
-FORCE_INLINE void GetNetworkName(char buffer[128], const StringAnsiView& name)
+void RemoveHiddenTargets(const NetworkReplicatedObject& item)
+{
+    for (const uint32 clientId : item.HiddenClientIds)
+    {
+        for (const NetworkClient* client : NetworkManager::Clients)
+        {
+            if (client->ClientId == clientId)
+            {
+                CachedTargets.Remove(client->Connection);
+                break;
+            }
+        }
+    }
+}
+
+FORCE_INLINE bool IsTargetClient(const DataContainer<uint32>& clientIds, uint32 clientId)
+{
+    if (!clientIds.IsValid())
+        return true;
+    for (int32 i = 0; i < clientIds.Length(); i++)
+    {
+        if (clientIds[i] == clientId)
+            return true;
+    }
+    return false;
+}
+
+FORCE_INLINE uint64 GetRelevancyCell(const Vector3& position, float cellSize)
+{
+    // Pack cell coordinates into a single key (21 bits per axis)
+    const uint64 x = (uint64)(Math::FloorToInt((float)position.X / cellSize) & 0x1fffff);
+    const uint64 y = (uint64)(Math::FloorToInt((float)position.Y / cellSize) & 0x1fffff);
+    const uint64 z = (uint64)(Math::FloorToInt((float)position.Z / cellSize) & 0x1fffff);
+    return x | (y << 21) | (z << 42);
+}
+
+void BuildRelevancyGrid()
+{
+    // Bucket connected clients into the interest grid (cell size matches the relevancy distance so only neighbour cells need to be checked)
+    RelevancyGrid.Clear();
+    const float cellSize = NetworkReplicator::RelevancyDistance;
+    if (cellSize <= 0.0f || NetworkReplicator::RelevancyCallback.IsBinded())
+        return;
+    for (NetworkClient* client : NetworkManager::Clients)
+    {
+        if (client->State == NetworkConnectionState::Connected)
+            RelevancyGrid[GetRelevancyCell(client->ViewPosition, cellSize)].Add(client);
+    }
+}
+
+const NetworkReplicatedObject& GetRelevancyRoot(const NetworkReplicatedObject& item)
+{
+    const NetworkReplicatedObject* root = &item;
+    for (int32 depth = 0; depth < 64 && root->ParentId.IsValid(); depth++)
+    {
+        auto it = Objects.Find(root->ParentId);
+        if (it == Objects.End() || !it->Item.Object)
+            break;
+        root = &it->Item;
+    }
+    return *root;
+}
+
+Actor* GetRelevancyActor(ScriptingObject* obj)
+{
+    if (auto* actor = ScriptingObject::Cast<Actor>(obj))
+        return actor;
+    if (auto* script = ScriptingObject::Cast<Script>(obj))
+        return script->GetParent();
+    return nullptr;
+}
+
+FORCE_INLINE bool IsRelevancyManaged(const NetworkReplicatedObject& item)
 {
-    Platform::MemoryCopy(buffer, name.Get(), name.Length());
-    buffer[name.Length()] = 0;
+    // Only objects replicated from server with a location (or when using custom relevancy logic)
+    if (item.Role != NetworkObjectRole::OwnedAuthoritative || !NetworkManager::IsServer())
+        return false;
+    if (NetworkReplicator::RelevancyCallback.IsBinded())
+        return true;
+    return NetworkReplicator::RelevancyDistance > 0.0f && GetRelevancyActor(GetRelevancyRoot(item).Object.Get()) != nullptr;
 }
 
 void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>& clients)
@@ -383,7 +708,7 @@ void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>
         auto* objScene = ScriptingObject::Cast<SceneObject>(obj);
         if (objScene && objScene->HasPrefabLink())
             msgDataItem.PrefabObjectID = objScene->GetPrefabObjectID();
-        GetNetworkName(msgDataItem.ObjectTypeName, obj->GetType().Fullname);
+        msgDataItem.ObjectTypeId = GetNetworkId(obj->GetType().Fullname);
         msg.WriteStructure(msgDataItem);
     }
     if (isClient)
@@ -392,6 +717,191 @@ void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>
         peer->EndSendMessage(NetworkChannelType::Reliable, msg, CachedTargets);
 }
 
+const ReplicationBaseline* GetReplicationBaseline(const NetworkReplicatedObject& item, uint32 frame)
+{
+    if (frame == 0)
+        return nullptr;
+    for (const ReplicationBaseline& baseline : item.Baselines)
+    {
+        if (baseline.Frame == frame)
+            return &baseline;
+    }
+    return nullptr;
+}
+
+void AddReplicationBaseline(NetworkReplicatedObject& item, uint32 frame, const byte* data, uint32 size)
+{
+    // Overwrite the oldest state once the ring buffer is full
+    ReplicationBaseline* baseline;
+    if (item.Baselines.Count() < NETWORK_REPLICATOR_BASELINES)
+    {
+        baseline = &item.Baselines.AddOne();
+    }
+    else
+    {
+        baseline = &item.Baselines[item.NextBaseline];
+        item.NextBaseline = (item.NextBaseline + 1) % NETWORK_REPLICATOR_BASELINES;
+    }
+    baseline->Frame = frame;
+    baseline->Data.Set(data, (int32)size);
+}
+
+uint32 GetReplicationAck(const NetworkReplicatedObject& item, const NetworkConnection& connection)
+{
+    // Returns the last object state frame acknowledged by the client (0 if unknown or no longer buffered on server)
+    for (const ReplicationAck& ack : item.Acks)
+    {
+        if (ack.ConnectionId == connection.ConnectionId)
+            return GetReplicationBaseline(item, ack.Frame) ? ack.Frame : 0;
+    }
+    return 0;
+}
+
+void RemoveReplicationAck(NetworkReplicatedObject& item, uint32 connectionId)
+{
+    for (int32 i = 0; i < item.Acks.Count(); i++)
+    {
+        if (item.Acks[i].ConnectionId == connectionId)
+        {
+            item.Acks.RemoveAt(i);
+            break;
+        }
+    }
+}
+
+void RemoveReplicationPending(NetworkReplicatedObject& item, uint32 clientId)
+{
+    for (int32 i = 0; i < item.Pending.Count(); i++)
+    {
+        if (item.Pending[i].ClientId == clientId)
+        {
+            item.Pending.RemoveAt(i);
+            break;
+        }
+    }
+}
+
+bool EncodeDelta(const byte* baseline, uint32 baselineSize, const byte* data, uint32 size, Array<byte>& output)
+{
+    // Encode as a sequence of blocks: [uint8 unchanged bytes count][uint8 changed bytes count][changed bytes]
+    output.Clear();
+    uint32 pos = 0;
+    while (pos < size)
+    {
+        uint32 skip = 0;
+        while (skip < MAX_uint8 && pos + skip < size && pos + skip < baselineSize && data[pos + skip] == baseline[pos + skip])
+            skip++;
+        pos += skip;
+        uint32 count = 0;
+        while (count < MAX_uint8 && pos + count < size)
+        {
+            // End changed bytes at the span of unchanged bytes longer than the block header
+            const uint32 i = pos + count;
+            if (i + 2 < size && i + 2 < baselineSize && data[i] == baseline[i] && data[i + 1] == baseline[i + 1] && data[i + 2] == baseline[i + 2])
+                break;
+            count++;
+        }
+        output.Add((byte)skip);
+        output.Add((byte)count);
+        output.Add(data + pos, (int32)count);
+        pos += count;
+        if ((uint32)output.Count() >= size)
+            return true; // Delta is not smaller than the full state
+    }
+    return false;
+}
+
+bool DecodeDelta(const byte* baseline, uint32 baselineSize, const byte* data, uint32 size, Array<byte>& output)
+{
+    output.Clear();
+    uint32 pos = 0;
+    while (pos + 2 <= size)
+    {
+        const uint32 skip = data[pos];
+        const uint32 count = data[pos + 1];
+        pos += 2;
+        if ((uint32)output.Count() + skip > baselineSize || pos + count > size)
+            return true;
+        output.Add(baseline + output.Count(), (int32)skip);
+        output.Add(data + pos, (int32)count);
+        pos += count;
+    }
+    return pos != size;
+}
+
+void SendObjectReplicateMessage(const NetworkReplicatedObject& item, ScriptingObject* obj, const byte* data, uint32 size, uint32 baselineFrame)
+{
+    const bool isClient = NetworkManager::IsClient();
+    auto* peer = NetworkManager::Peer;
+    NetworkMessageObjectReplicate msgData;
+    msgData.OwnerFrame = NetworkManager::Frame;
+    msgData.BaselineFrame = baselineFrame;
+    msgData.ObjectId = item.ObjectId;
+    msgData.ParentId = item.ParentId;
+    if (isClient)
+    {
+        // Remap local client object ids into server ids
+        IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
+        IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
+    }
+    msgData.ObjectTypeId = GetNetworkId(obj->GetType().Fullname);
+    msgData.DataSize = size;
+    const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
+    const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
+    uint32 partsCount = 1;
+    uint32 dataStart = 0;
+    uint32 msgDataSize = size;
+    if (size > msgMaxData)
+    {
+        // Send msgMaxData within first message
+        msgDataSize = msgMaxData;
+        dataStart += msgMaxData;
+
+        // Send rest of the data in separate parts
+        partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
+    }
+    else
+        dataStart += size;
+    ASSERT(partsCount <= MAX_uint8)
+    msgData.PartsCount = partsCount;
+    NetworkMessage msg = peer->BeginSendMessage();
+    msg.WriteStructure(msgData);
+    msg.WriteBytes(data, msgDataSize);
+    uint32 bytesSent = msg.Position;
+    if (isClient)
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+    else
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+
+    // Send all other parts
+    for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
+    {
+        NetworkMessageObjectReplicatePart msgDataPart;
+        msgDataPart.OwnerFrame = msgData.OwnerFrame;
+        msgDataPart.ObjectId = msgData.ObjectId;
+        msgDataPart.DataSize = msgData.DataSize;
+        msgDataPart.PartsCount = msgData.PartsCount;
+        msgDataPart.PartStart = dataStart;
+        msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
+        msg = peer->BeginSendMessage();
+        msg.WriteStructure(msgDataPart);
+        msg.WriteBytes(data + msgDataPart.PartStart, msgDataPart.PartSize);
+        bytesSent += msg.Position;
+        dataStart += msgDataPart.PartSize;
+        if (isClient)
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+        else
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+    }
+    ASSERT_LOW_LAYER(dataStart == size);
+
+    // Update stats
+    const uint32 targetsCount = isClient ? 1 : CachedTargets.Count();
+    ReplicationStats& stats = TypesStats[obj->GetTypeHandle()];
+    stats.BytesSent += (uint64)bytesSent * targetsCount;
+    stats.MessagesSent += partsCount * targetsCount;
+}
+
 void SendObjectRoleMessage(const NetworkReplicatedObject& item, const NetworkClient* excludedClient = nullptr)
 {
     NetworkMessageObjectRole msgData;
@@ -484,37 +994,188 @@ void SetupObjectSpawnGroupItem(ScriptingObject* obj, Array<SpawnGroup, InlinedAl
     group->Items.Add(&spawnItem);
 }
 
-void DirtyObjectImpl(NetworkReplicatedObject& item, ScriptingObject* obj)
+float GetReplicationPriority(const NetworkReplicatedObject& item, const NetworkClient* client)
 {
-    // TODO: implement objects state replication frequency and dirtying
+    // Closer objects are more important (staleness comes from accumulating priority over the updates object was pending)
+    float priority = 1.0f;
+    if (NetworkReplicator::PriorityDistance > 0.0f)
+    {
+        if (const Actor* actor = GetRelevancyActor(GetRelevancyRoot(item).Object.Get()))
+        {
+            const float distance = (float)Vector3::Distance(actor->GetPosition(), client->ViewPosition);
+            priority /= 1.0f + distance / NetworkReplicator::PriorityDistance;
+        }
+    }
+    return priority;
 }
 
-template<typename MessageType>
-ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& msgData, uint16 partStart, uint16 partSize)
+bool SortReplicationPriority(const Pair<float, NetworkReplicatedObject*>& a, const Pair<float, NetworkReplicatedObject*>& b)
+{
+    return a.First > b.First;
+}
+
+bool SortLateJoinObject(const LateJoinObject& a, const LateJoinObject& b)
+{
+    // Keep objects from the same hierarchy next to each other to spawn them within a single group
+    if (a.Priority != b.Priority)
+        return a.Priority < b.Priority;
+    return a.Root < b.Root;
+}
+
+void BuildRelevantTargets(NetworkReplicatedObject& item, ScriptingObject* obj, Array<RelevancySpawn>& spawns, ChunkedArray<SpawnItem, 256>& spawnItems)
 {
-    // Reuse or add part item
-    ReplicateItem* replicateItem = nullptr;
-    for (auto& e : ReplicationParts)
+    const NetworkReplicatedObject& root = GetRelevancyRoot(item);
+    ScriptingObject* rootObj = root.Object.Get();
+    const bool useCallback = NetworkReplicator::RelevancyCallback.IsBinded();
+    Actor* rootActor = useCallback ? nullptr : GetRelevancyActor(rootObj);
+    if (!useCallback && !rootActor)
     {
-        if (e.OwnerFrame == msgData.OwnerFrame && e.Data.Count() == msgData.DataSize && e.ObjectId == msgData.ObjectId)
+        // Objects without location are always relevant
+        BuildCachedTargets(item);
+        return;
+    }
+
+    // Query the nearby clients from the interest grid
+    Array<NetworkClient*, InlinedAllocation<32>> nearbyClients;
+    if (rootActor)
+    {
+        const float distance = NetworkReplicator::RelevancyDistance;
+        const Vector3 position = rootActor->GetPosition();
+        const Int3 cell(Math::FloorToInt((float)position.X / distance), Math::FloorToInt((float)position.Y / distance), Math::FloorToInt((float)position.Z / distance));
+        for (int32 x = -1; x <= 1; x++)
         {
-            // Reuse
-            replicateItem = &e;
-            break;
+            for (int32 y = -1; y <= 1; y++)
+            {
+                for (int32 z = -1; z <= 1; z++)
+                {
+                    const Vector3 cellPosition((float)(cell.X + x) * distance, (float)(cell.Y + y) * distance, (float)(cell.Z + z) * distance);
+                    const auto cellClients = RelevancyGrid.TryGet(GetRelevancyCell(cellPosition, distance));
+                    if (!cellClients)
+                        continue;
+                    for (NetworkClient* client : *cellClients)
+                    {
+                        if (Vector3::DistanceSquared(client->ViewPosition, position) <= (Real)distance * distance)
+                            nearbyClients.Add(client);
+                    }
+                }
+            }
+        }
+    }
+
+    CachedTargets.Clear();
+    for (NetworkClient* client : NetworkManager::Clients)
+    {
+        if (client->State != NetworkConnectionState::Connected || client->ClientId == item.OwnerClientId || !IsTargetClient(item.TargetClientIds, client->ClientId))
+            continue;
+        const bool relevant = useCallback ? NetworkReplicator::RelevancyCallback(rootObj, client) : nearbyClients.Contains(client);
+        const int32 hiddenIndex = item.HiddenClientIds.Find(client->ClientId);
+        if (relevant)
+        {
+            if (hiddenIndex != -1)
+            {
+                // Object became relevant for the client so replicate the current state to it
+                item.HiddenClientIds.RemoveAtKeepOrder(hiddenIndex);
+                item.Dirty = true;
+                if (item.Spawned)
+                {
+                    // Spawn object back on that client (state gets replicated in the next update)
+                    RelevancySpawn* spawn = nullptr;
+                    for (RelevancySpawn& e : spawns)
+                    {
+                        if (e.Client == client)
+                        {
+                            spawn = &e;
+                            break;
+                        }
+                    }
+                    if (!spawn)
+                    {
+                        spawn = &spawns.AddOne();
+                        spawn->Client = client;
+                    }
+                    auto& spawnItem = spawnItems.AddOne();
+                    spawnItem.Object = obj;
+                    spawnItem.Targets.Link(item.TargetClientIds);
+                    spawnItem.OwnerClientId = item.OwnerClientId;
+                    spawnItem.Role = item.Role;
+                    SetupObjectSpawnGroupItem(obj, spawn->Groups, spawnItem);
+                    continue;
+                }
+            }
+            CachedTargets.Add(client->Connection);
+        }
+        else if (hiddenIndex == -1)
+        {
+            // Object is no longer relevant for the client
+            item.HiddenClientIds.Add(client->ClientId);
+            RemoveReplicationAck(item, client->Connection.ConnectionId);
+            RemoveReplicationPending(item, client->ClientId);
+            if (item.Spawned && &root == &item)
+            {
+                // Despawn object on that client (child objects are despawned together with the root)
+                auto& despawn = DespawnQueue.AddOne();
+                despawn.Id = item.ObjectId;
+                despawn.Targets.Copy(&client->ClientId, 1);
+            }
         }
     }
+}
+
+void DirtyObjectImpl(NetworkReplicatedObject& item, ScriptingObject* obj)
+{
+    // Replicate object on the next network update (regardless of the replication frequency)
+    item.Dirty = true;
+}
+
+float GetTypeReplicationFPS(ScriptingTypeHandle typeHandle)
+{
+    // Use the frequency of the closest type from the hierarchy
+    float replicationFPS;
+    while (typeHandle)
+    {
+        if (ReplicationFPSTable.TryGet(typeHandle, replicationFPS))
+            return replicationFPS;
+        typeHandle = typeHandle.GetType().GetBaseType();
+    }
+    return 0.0f;
+}
+
+void RemoveReplicateItem(const Dictionary<Pair<Guid, uint32>, ReplicateItem>::Iterator& it)
+{
+    // Recycle data buffer
+    if (ReplicationPartsPool.Count() < NETWORK_REPLICATOR_PARTS_POOL)
+        ReplicationPartsPool.Add(MoveTemp(it->Value.Data));
+    ReplicationParts.Remove(it);
+}
+
+template<typename MessageType>
+ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& msgData, uint16 partStart, uint16 partSize)
+{
+    // Reuse or add part item (parts are matched by the object and the frame it was sent at)
+    const Pair<Guid, uint32> key(msgData.ObjectId, msgData.OwnerFrame);
+    ReplicateItem* replicateItem = ReplicationParts.TryGet(key);
     if (!replicateItem)
     {
         // Add
-        replicateItem = &ReplicationParts.AddOne();
-        replicateItem->ObjectId = msgData.ObjectId;
+        replicateItem = &ReplicationParts[key];
         replicateItem->PartsLeft = msgData.PartsCount;
-        replicateItem->OwnerFrame = msgData.OwnerFrame;
-        replicateItem->Data.Resize(msgData.DataSize);
+        replicateItem->BaselineFrame = 0;
+        replicateItem->Time = Platform::GetTimeSeconds();
+        if (ReplicationPartsPool.HasItems())
+        {
+            // Reuse data buffer
+            replicateItem->Data = MoveTemp(ReplicationPartsPool.Last());
+            ReplicationPartsPool.RemoveLast();
+        }
+        replicateItem->Data.Resize(msgData.DataSize, false);
+    }
+    else if (replicateItem->Data.Count() != msgData.DataSize || replicateItem->PartsLeft == 0)
+    {
+        // Invalid or duplicated part
+        return nullptr;
     }
 
     // Copy part data
-    ASSERT(replicateItem->PartsLeft > 0);
     replicateItem->PartsLeft--;
     ASSERT(partStart + partSize <= replicateItem->Data.Count());
     const void* partData = event.Message.SkipBytes(partSize);
@@ -523,7 +1184,7 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
     return replicateItem;
 }
 
-void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, byte* data, uint32 dataSize)
+void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, uint32 baselineFrame, byte* data, uint32 dataSize)
 {
     ScriptingObject* obj = item.Object.Get();
     if (!obj)
@@ -536,7 +1197,28 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
     // Drop object replication if it has old data (eg. newer message was already processed due to unordered channel usage)
     if (item.LastOwnerFrame >= ownerFrame)
         return;
+    if (baselineFrame != 0)
+    {
+        // Reconstruct the object state from the delta against the previously received state
+        const ReplicationBaseline* baseline = GetReplicationBaseline(item, baselineFrame);
+        if (!baseline || DecodeDelta(baseline->Data.Get(), baseline->Data.Count(), data, dataSize, CachedDeltaData))
+        {
+            // Missing baseline (eg. object got respawned) so server will fallback to the full state once acknowledges expire
+            NETWORK_REPLICATOR_LOG(Warning, "[NetworkReplicator] Cannot decode object {} delta against frame {}", item.ToString(), baselineFrame);
+            return;
+        }
+        data = CachedDeltaData.Get();
+        dataSize = CachedDeltaData.Count();
+    }
     item.LastOwnerFrame = ownerFrame;
+    if (NetworkManager::IsClient())
+    {
+        // Keep received state as a baseline for the next deltas and acknowledge it to the server
+        AddReplicationBaseline(item, ownerFrame, data, dataSize);
+        auto& ack = AcksQueue.AddOne();
+        ack.ObjectId = item.ObjectId;
+        ack.Frame = ownerFrame;
+    }
 
     // Setup message reading stream
     if (CachedReadStream == nullptr)
@@ -545,6 +1227,7 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
     stream->Initialize(data, dataSize);
 
     // Deserialize object
+    const uint64 startTime = Platform::GetTimeCycles();
     const bool failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, false);
     if (failed)
     {
@@ -553,12 +1236,124 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
 
     if (item.AsNetworkObject)
         item.AsNetworkObject->OnNetworkDeserialize();
+    TypesStats[obj->GetTypeHandle()].TimeCycles += Platform::GetTimeCycles() - startTime;
 
     // Speed up replication of client-owned objects to other clients from server to reduce lag (data has to go from client to server and then to other clients)
     if (NetworkManager::IsServer())
         DirtyObjectImpl(item, obj);
 }
 
+void SerializeObject(SerializeItem& e, NetworkStream* stream)
+{
+    NetworkReplicatedObject& item = *e.Item;
+    ScriptingObject* obj = item.Object.Get();
+    const uint64 startTime = Platform::GetTimeCycles();
+    if (item.AsNetworkObject)
+        item.AsNetworkObject->OnNetworkSerialize();
+
+    // Serialize object (start from the full byte in case of bit-packed data of the previous object)
+    stream->SetPosition(stream->GetPosition());
+    e.Offset = stream->GetPosition();
+    e.Failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
+    e.Size = stream->GetPosition() - e.Offset;
+    e.Time = Platform::GetTimeCycles() - startTime;
+    if (e.Failed)
+    {
+        //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
+    }
+}
+
+void SendObject(NetworkReplicatedObject& item, ScriptingObject* obj, const byte* data, uint32 size)
+{
+    ASSERT(size <= MAX_uint16)
+    item.LastSize = (uint16)size;
+    if (NetworkManager::IsClient() || !NetworkReplicator::EnableDeltaCompression)
+    {
+        SendObjectReplicateMessage(item, obj, data, size, 0);
+        return;
+    }
+
+    // Delta-encode object state against the last state acknowledged by each client (clients with the same baseline share the message)
+    CachedDeltaTargets = CachedTargets;
+    while (CachedDeltaTargets.HasItems())
+    {
+        const uint32 baselineFrame = GetReplicationAck(item, CachedDeltaTargets.Last());
+        CachedTargets.Clear();
+        for (int32 i = CachedDeltaTargets.Count() - 1; i >= 0; i--)
+        {
+            if (GetReplicationAck(item, CachedDeltaTargets[i]) == baselineFrame)
+            {
+                CachedTargets.Add(CachedDeltaTargets[i]);
+                CachedDeltaTargets.RemoveAt(i);
+            }
+        }
+        const ReplicationBaseline* baseline = GetReplicationBaseline(item, baselineFrame);
+        if (baseline && !EncodeDelta(baseline->Data.Get(), baseline->Data.Count(), data, size, CachedDeltaData))
+            SendObjectReplicateMessage(item, obj, CachedDeltaData.Get(), CachedDeltaData.Count(), baselineFrame);
+        else
+            SendObjectReplicateMessage(item, obj, data, size, 0);
+    }
+    AddReplicationBaseline(item, NetworkManager::Frame, data, size);
+}
+
+void ReplicateObjects(NetworkStream* stream)
+{
+    if (SerializeQueue.IsEmpty())
+        return;
+
+    // Serialize objects (in parallel for a large amount of objects, each job uses a separate stream)
+    const int32 jobCount = Math::Min(JobSystem::GetThreadsCount(), SerializeQueue.Count() / NETWORK_REPLICATOR_SERIALIZE_BATCH);
+    if (jobCount > 1)
+    {
+        PROFILE_CPU_NAMED("SerializeJobs");
+        while (CachedJobStreams.Count() < jobCount)
+            CachedJobStreams.Add(New<NetworkStream>());
+        JobSystem::Execute([jobCount](int32 jobIndex)
+        {
+            PROFILE_CPU_NAMED("NetworkReplicator.Serialize");
+            IsSerializeJob = true;
+            NetworkStream* jobStream = CachedJobStreams[jobIndex];
+            jobStream->Initialize();
+            const int32 count = SerializeQueue.Count();
+            const int32 start = count * jobIndex / jobCount;
+            const int32 end = count * (jobIndex + 1) / jobCount;
+            for (int32 i = start; i < end; i++)
+            {
+                SerializeItem& e = SerializeQueue[i];
+                e.StreamIndex = jobIndex;
+                SerializeObject(e, jobStream);
+            }
+            IsSerializeJob = false;
+        }, jobCount);
+    }
+    else
+    {
+        PROFILE_CPU_NAMED("Serialize");
+        stream->Initialize();
+        for (SerializeItem& e : SerializeQueue)
+        {
+            e.StreamIndex = -1;
+            SerializeObject(e, stream);
+        }
+    }
+
+    // Send objects in the original order (deterministic messages order for clients)
+    PROFILE_CPU_NAMED("Send");
+    for (const SerializeItem& e : SerializeQueue)
+    {
+        NetworkReplicatedObject& item = *e.Item;
+        ScriptingObject* obj = item.Object.Get();
+        Swap(CachedTargets, item.PendingTargets);
+        item.PendingTargets.Clear();
+        TypesStats[obj->GetTypeHandle()].TimeCycles += e.Time;
+        if (e.Failed)
+            continue;
+        const NetworkStream* dataStream = e.StreamIndex != -1 ? CachedJobStreams[e.StreamIndex] : stream;
+        SendObject(item, obj, dataStream->GetBuffer() + e.Offset, e.Size);
+    }
+    SerializeQueue.Clear();
+}
+
 #if !COMPILE_WITHOUT_CSHARP
 
 #include "Engine/Scripting/ManagedCLR/MUtils.h"
@@ -668,6 +1463,11 @@ void NetworkReplicator::AddObject(ScriptingObject* obj, ScriptingObject* parent)
     ScopeLock lock(ObjectsLock);
     if (Objects.Contains(obj))
         return;
+    if (FindNetworkType(GetNetworkId(obj->GetType().Fullname)) != obj->GetTypeHandle())
+    {
+        LOG(Error, "[NetworkReplicator] Cannot replicate object of type {0} due to the network identifier collision", obj->GetType().ToString());
+        return;
+    }
 
     // Automatic parenting for scene objects
     if (!parent)
@@ -689,6 +1489,8 @@ void NetworkReplicator::AddObject(ScriptingObject* obj, ScriptingObject* parent)
     item.ParentId = parent ? parent->GetID() : Guid::Empty;
     item.OwnerClientId = NetworkManager::ServerClientId; // Server owns objects by default
     item.Role = NetworkManager::IsClient() ? NetworkObjectRole::Replicated : NetworkObjectRole::OwnedAuthoritative;
+    if (ReplicationFPSTable.HasItems())
+        item.ReplicationFPS = GetTypeReplicationFPS(obj->GetTypeHandle());
     NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Add new object {}:{}, parent {}:{}", item.ToString(), obj->GetType().ToString(), item.ParentId.ToString(), parent ? parent->GetType().ToString() : String::Empty);
     Objects.Add(MoveTemp(item));
 }
@@ -782,7 +1584,7 @@ uint32 NetworkReplicator::GetObjectOwnerClientId(ScriptingObject* obj)
     uint32 id = NetworkManager::ServerClientId;
     if (obj)
     {
-        ScopeLock lock(ObjectsLock);
+        ObjectsLookupLock lock;
         const auto it = Objects.Find(obj->GetID());
         if (it != Objects.End())
             id = it->Item.OwnerClientId;
@@ -795,7 +1597,7 @@ NetworkObjectRole NetworkReplicator::GetObjectRole(ScriptingObject* obj)
     NetworkObjectRole role = NetworkObjectRole::None;
     if (obj)
     {
-        ScopeLock lock(ObjectsLock);
+        ObjectsLookupLock lock;
         const auto it = Objects.Find(obj->GetID());
         if (it != Objects.End())
             role = it->Item.Role;
@@ -874,6 +1676,30 @@ void NetworkReplicator::DirtyObject(ScriptingObject* obj)
     DirtyObjectImpl(item, obj);
 }
 
+float NetworkReplicator::GetObjectReplicationFPS(ScriptingObject* obj)
+{
+    ScopeLock lock(ObjectsLock);
+    const auto it = Objects.Find(obj->GetID());
+    if (it == Objects.End())
+        return 0.0f;
+    return it->Item.ReplicationFPS;
+}
+
+void NetworkReplicator::SetObjectReplicationFPS(ScriptingObject* obj, float replicationFPS)
+{
+    ScopeLock lock(ObjectsLock);
+    const auto it = Objects.Find(obj->GetID());
+    if (it == Objects.End())
+        return;
+    it->Item.ReplicationFPS = replicationFPS;
+}
+
+void NetworkReplicator::SetTypeReplicationFPS(const ScriptingTypeHandle& typeHandle, float replicationFPS)
+{
+    ScopeLock lock(ObjectsLock);
+    ReplicationFPSTable[typeHandle] = replicationFPS;
+}
+
 Dictionary<NetworkRpcName, NetworkRpcInfo> NetworkRpcInfo::RPCsTable;
 
 NetworkStream* NetworkReplicator::BeginInvokeRPC()
@@ -884,6 +1710,59 @@ NetworkStream* NetworkReplicator::BeginInvokeRPC()
     return CachedWriteStream;
 }
 
+void GetReplicationStats(NetworkReplicationStats& result, const ReplicationStats& stats)
+{
+    result.BytesSent = stats.BytesSent;
+    result.BytesReceived = stats.BytesReceived;
+    result.MessagesSent = stats.MessagesSent;
+    result.MessagesReceived = stats.MessagesReceived;
+    result.TimeMs = (float)((double)stats.TimeCycles * 1000.0 / (double)Platform::GetClockFrequency());
+}
+
+bool SortReplicationStats(const NetworkReplicationStats& a, const NetworkReplicationStats& b)
+{
+    return a.BytesSent > b.BytesSent;
+}
+
+Array<NetworkReplicationStats> NetworkReplicator::GetTypesStats()
+{
+    ScopeLock lock(ObjectsLock);
+    Array<NetworkReplicationStats> result;
+    result.Resize(TypesStats.Count());
+    int32 i = 0;
+    for (const auto& e : TypesStats)
+    {
+        NetworkReplicationStats& stats = result[i++];
+        stats.Name = e.Key.ToString();
+        GetReplicationStats(stats, e.Value);
+    }
+    Sorting::QuickSort(result.Get(), result.Count(), &SortReplicationStats);
+    return result;
+}
+
+Array<NetworkReplicationStats> NetworkReplicator::GetRpcsStats()
+{
+    ScopeLock lock(ObjectsLock);
+    Array<NetworkReplicationStats> result;
+    result.Resize(RpcsStats.Count());
+    int32 i = 0;
+    for (const auto& e : RpcsStats)
+    {
+        NetworkReplicationStats& stats = result[i++];
+        stats.Name = e.Key.First.ToString() + TEXT("::") + String(e.Key.Second);
+        GetReplicationStats(stats, e.Value);
+    }
+    Sorting::QuickSort(result.Get(), result.Count(), &SortReplicationStats);
+    return result;
+}
+
+void NetworkReplicator::ResetStats()
+{
+    ScopeLock lock(ObjectsLock);
+    TypesStats.Clear();
+    RpcsStats.Clear();
+}
+
 void NetworkReplicator::EndInvokeRPC(ScriptingObject* obj, const ScriptingTypeHandle& type, const StringAnsiView& name, NetworkStream* argsStream)
 {
     const NetworkRpcInfo* info = NetworkRpcInfo::RPCsTable.TryGet(NetworkRpcName(type, name));
@@ -917,12 +1796,23 @@ void NetworkInternal::NetworkReplicatorClientDisconnected(NetworkClient* client)
 {
     ScopeLock lock(ObjectsLock);
     NewClients.Remove(client);
+    for (int32 i = 0; i < LateJoins.Count(); i++)
+    {
+        if (LateJoins[i].Client == client)
+        {
+            LateJoins.RemoveAtKeepOrder(i);
+            break;
+        }
+    }
 
     // Remove any objects owned by that client
     const uint32 clientId = client->ClientId;
     for (auto it = Objects.Begin(); it.IsNotEnd(); ++it)
     {
         auto& item = it->Item;
+        item.HiddenClientIds.Remove(clientId);
+        RemoveReplicationAck(item, client->Connection.ConnectionId);
+        RemoveReplicationPending(item, clientId);
         ScriptingObject* obj = item.Object.Get();
         if (obj && item.Spawned && item.OwnerClientId == clientId)
         {
@@ -965,10 +1855,26 @@ void NetworkInternal::NetworkReplicatorClear()
     DespawnQueue.Clear();
     IdsRemappingTable.Clear();
     SAFE_DELETE(CachedWriteStream);
+    for (NetworkStream* e : CachedJobStreams)
+        Delete(e);
+    CachedJobStreams.Clear();
+    SerializeQueue.Clear();
     SAFE_DELETE(CachedReadStream);
     NewClients.Clear();
+    LateJoins.Clear();
+    ReplicationParts.Clear();
+    ReplicationPartsPool.Clear();
     CachedTargets.Clear();
     DespawnedObjects.Clear();
+    RelevancyGrid.Clear();
+    CachedDeltaTargets.Clear();
+    CachedDeltaData.Clear();
+    AcksQueue.Clear();
+    LastBudgetTime = 0.0;
+    NetworkTypesTable.Clear();
+    NetworkRpcsTable.Clear();
+    NetworkTypesTableSize = 0;
+    NetworkRpcsTableSize = 0;
 }
 
 void NetworkInternal::NetworkReplicatorPreUpdate()
@@ -981,7 +1887,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
 {
     PROFILE_CPU();
     ScopeLock lock(ObjectsLock);
-    if (Objects.Count() == 0)
+    if (Objects.Count() == 0 && NewClients.Count() == 0 && LateJoins.Count() == 0)
         return;
     if (CachedWriteStream == nullptr)
         CachedWriteStream = New<NetworkStream>();
@@ -993,11 +1899,16 @@ void NetworkInternal::NetworkReplicatorUpdate()
 
     if (!isClient && NewClients.Count() != 0)
     {
-        // Sync any previously spawned objects with late-joining clients
+        // Queue any previously spawned objects to be synced with late-joining clients over the next updates
         PROFILE_CPU_NAMED("NewClients");
-        // TODO: try iterative loop over several frames to reduce both server and client perf-spikes in case of large amount of spawned objects
-        ChunkedArray<SpawnItem, 256> spawnItems;
-        Array<SpawnGroup, InlinedAllocation<8>> spawnGroups;
+        const int32 syncStart = LateJoins.Count();
+        for (NetworkClient* client : NewClients)
+        {
+            auto& sync = LateJoins.AddOne();
+            sync.Client = client;
+            sync.Cursor = 0;
+        }
+        Dictionary<Guid, int32> roots;
         for (auto it = Objects.Begin(); it.IsNotEnd(); ++it)
         {
             auto& item = it->Item;
@@ -1005,24 +1916,101 @@ void NetworkInternal::NetworkReplicatorUpdate()
             if (!obj || !item.Spawned)
                 continue;
 
-            // Setup spawn item for this object
-            auto& spawnItem = spawnItems.AddOne();
-            spawnItem.Object = obj;
-            spawnItem.Targets.Link(item.TargetClientIds);
-            spawnItem.OwnerClientId = item.OwnerClientId;
-            spawnItem.Role = item.Role;
-
-            SetupObjectSpawnGroupItem(obj, spawnGroups, spawnItem);
+            // Send the current state to the new clients (once object gets spawned on them)
+            item.Dirty = true;
+            for (const NetworkClient* client : NewClients)
+                item.HiddenClientIds.Add(client->ClientId);
+            if (IsRelevancyManaged(item))
+                continue; // Spawn object later when it becomes relevant for the new client
+
+            // Spawn objects closer to the client first (objects without location go first)
+            const NetworkReplicatedObject& root = GetRelevancyRoot(item);
+            const Actor* rootActor = GetRelevancyActor(root.Object.Get());
+            int32 rootIndex;
+            if (!roots.TryGet(root.ObjectId, rootIndex))
+            {
+                rootIndex = roots.Count();
+                roots.Add(root.ObjectId, rootIndex);
+            }
+            for (int32 i = syncStart; i < LateJoins.Count(); i++)
+            {
+                LateJoinSync& sync = LateJoins[i];
+                auto& e = sync.Objects.AddOne();
+                e.Priority = rootActor ? (float)Vector3::Distance(rootActor->GetPosition(), sync.Client->ViewPosition) : 0.0f;
+                e.Root = rootIndex;
+                e.ObjectId = item.ObjectId;
+            }
         }
-
-        // Groups of objects to spawn
-        for (SpawnGroup& g : spawnGroups)
+        for (int32 i = syncStart; i < LateJoins.Count(); i++)
         {
-            SendObjectSpawnMessage(g, NewClients);
+            LateJoinSync& sync = LateJoins[i];
+            Sorting::QuickSort(sync.Objects.Get(), sync.Objects.Count(), &SortLateJoinObject);
         }
         NewClients.Clear();
     }
 
+    if (!isClient && LateJoins.Count() != 0)
+    {
+        // Spawn previously spawned objects on late-joining clients within a budget to reduce both server and client perf-spikes in case of large amount of objects
+        PROFILE_CPU_NAMED("LateJoin");
+        const int32 budget = NetworkReplicator::LateJoinBudget > 0 ? NetworkReplicator::LateJoinBudget : MAX_int32;
+        Array<NetworkClient*> spawnClients;
+        for (int32 syncIndex = 0; syncIndex < LateJoins.Count(); syncIndex++)
+        {
+            LateJoinSync& sync = LateJoins[syncIndex];
+            NetworkClient* client = sync.Client;
+            ChunkedArray<SpawnItem, 256> spawnItems;
+            Array<SpawnGroup, InlinedAllocation<8>> spawnGroups;
+            int32 count = 0;
+            while (sync.Cursor < sync.Objects.Count())
+            {
+                const LateJoinObject& e = sync.Objects[sync.Cursor];
+                if (count >= budget && e.Root != sync.Objects[sync.Cursor - 1].Root)
+                    break; // Don't split the hierarchy of objects into separate spawn groups
+                sync.Cursor++;
+                auto it = Objects.Find(e.ObjectId);
+                if (it == Objects.End())
+                    continue;
+                auto& item = it->Item;
+                ScriptingObject* obj = item.Object.Get();
+                const int32 hiddenIndex = item.HiddenClientIds.Find(client->ClientId);
+                if (!obj || !item.Spawned || hiddenIndex == -1)
+                    continue; // Skip deleted objects or the ones already spawned for that client (eg. by relevancy)
+                item.HiddenClientIds.RemoveAtKeepOrder(hiddenIndex);
+                item.Dirty = true;
+                count++;
+
+                // Setup spawn item for this object
+                auto& spawnItem = spawnItems.AddOne();
+                spawnItem.Object = obj;
+                spawnItem.Targets.Link(item.TargetClientIds);
+                spawnItem.OwnerClientId = item.OwnerClientId;
+                spawnItem.Role = item.Role;
+
+                SetupObjectSpawnGroupItem(obj, spawnGroups, spawnItem);
+            }
+
+            // Groups of objects to spawn
+            spawnClients.Clear();
+            spawnClients.Add(client);
+            for (SpawnGroup& g : spawnGroups)
+            {
+                SendObjectSpawnMessage(g, spawnClients);
+            }
+
+            if (sync.Cursor >= sync.Objects.Count())
+            {
+                // Notify client that all objects got spawned (sent over the same channel as spawn messages)
+                NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] World synced for client {}", client->ClientId);
+                NetworkMessageObjectsSynced msgData;
+                NetworkMessage msg = peer->BeginSendMessage();
+                msg.WriteStructure(msgData);
+                peer->EndSendMessage(NetworkChannelType::Reliable, msg, client->Connection);
+                LateJoins.RemoveAtKeepOrder(syncIndex--);
+            }
+        }
+    }
+
     // Collect clients for replication (from server)
     BuildCachedTargets(NetworkManager::Clients);
     if (!isClient && CachedTargets.Count() == 0)
@@ -1058,6 +2046,29 @@ void NetworkInternal::NetworkReplicatorUpdate()
         DespawnQueue.Clear();
     }
 
+    // Acknowledge received objects states to the server (used as baselines for delta-compressed replication)
+    if (isClient && AcksQueue.Count() != 0)
+    {
+        PROFILE_CPU_NAMED("AcksQueue");
+        const int32 msgMaxItems = (int32)((peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicateAck)) / sizeof(NetworkMessageObjectReplicateAckItem));
+        for (int32 i = 0; i < AcksQueue.Count(); i += msgMaxItems)
+        {
+            NetworkMessageObjectReplicateAck msgData;
+            msgData.ItemsCount = (uint16)Math::Min(AcksQueue.Count() - i, msgMaxItems);
+            NetworkMessage msg = peer->BeginSendMessage();
+            msg.WriteStructure(msgData);
+            for (int32 j = 0; j < msgData.ItemsCount; j++)
+            {
+                // Remap local client object ids into server ids
+                NetworkMessageObjectReplicateAckItem msgDataItem = AcksQueue[i + j];
+                IdsRemappingTable.KeyOf(msgDataItem.ObjectId, &msgDataItem.ObjectId);
+                msg.WriteStructure(msgDataItem);
+            }
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+        }
+        AcksQueue.Clear();
+    }
+
     // Spawn
     if (SpawnQueue.Count() != 0)
     {
@@ -1131,33 +2142,47 @@ void NetworkInternal::NetworkReplicatorUpdate()
     }
 
     // Apply parts replication
-    for (int32 i = ReplicationParts.Count() - 1; i >= 0; i--)
+    if (ReplicationParts.HasItems())
     {
-        auto& e = ReplicationParts[i];
-        if (e.PartsLeft > 0)
+        PROFILE_CPU_NAMED("ReplicationParts");
+        const double partsTime = Platform::GetTimeSeconds();
+        for (auto i = ReplicationParts.Begin(); i.IsNotEnd(); ++i)
         {
-            // TODO: remove replication items after some TTL to prevent memory leaks
-            continue;
-        }
-        ScriptingObject* obj = e.Object.Get();
-        if (obj)
-        {
-            auto it = Objects.Find(obj->GetID());
-            if (it != Objects.End())
+            auto& e = i->Value;
+            if (e.PartsLeft > 0)
             {
-                auto& item = it->Item;
+                // Drop stale data to prevent memory leaks (eg. lost part message)
+                if (partsTime - e.Time > NETWORK_REPLICATOR_PARTS_TIMEOUT)
+                    RemoveReplicateItem(i);
+                continue;
+            }
+            ScriptingObject* obj = e.Object.Get();
+            if (obj)
+            {
+                auto it = Objects.Find(obj->GetID());
+                if (it != Objects.End())
+                {
+                    auto& item = it->Item;
 
-                // Replicate from all collected parts data
-                InvokeObjectReplication(item, e.OwnerFrame, e.Data.Get(), e.Data.Count());
+                    // Replicate from all collected parts data
+                    InvokeObjectReplication(item, i->Key.Second, e.BaselineFrame, e.Data.Get(), e.Data.Count());
+                }
             }
-        }
 
-        ReplicationParts.RemoveAt(i);
+            RemoveReplicateItem(i);
+        }
     }
 
-    // Brute force synchronize all networked objects with clients
-    // TODO: introduce NetworkReplicationHierarchy to optimize objects replication in large worlds (eg. batched culling networked scene objects that are too far from certain client to be relevant)
-    // TODO: per-object sync interval (in frames) - could be scaled by hierarchy (eg. game could slow down sync rate for objects far from player)
+    // Synchronize networked objects with clients (dirty ones or at their replication frequency)
+    const double time = Platform::GetTimeSeconds();
+    const bool useRelevancy = !isClient && (NetworkReplicator::RelevancyDistance > 0.0f || NetworkReplicator::RelevancyCallback.IsBinded());
+    Array<RelevancySpawn> relevancySpawns;
+    ChunkedArray<SpawnItem, 256> relevancySpawnItems;
+    if (useRelevancy)
+        BuildRelevancyGrid();
+    const double timeTolerance = NetworkManager::NetworkFPS > 0.0f ? 0.5 / NetworkManager::NetworkFPS : 0.0;
+    const bool useBudget = !isClient && NetworkReplicator::ClientBandwidth > 0;
+    Array<NetworkReplicatedObject*> budgetObjects;
     for (auto it = Objects.Begin(); it.IsNotEnd(); ++it)
     {
         auto& item = it->Item;
@@ -1171,87 +2196,118 @@ void NetworkInternal::NetworkReplicatorUpdate()
         }
         if (item.Role != NetworkObjectRole::OwnedAuthoritative && (!isClient && item.OwnerClientId != NetworkManager::LocalClientId))
             continue; // Send replication messages of only owned objects or from other client objects
-
-        if (item.AsNetworkObject)
-            item.AsNetworkObject->OnNetworkSerialize();
-
-        // Serialize object
-        stream->Initialize();
-        const bool failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
-        if (failed)
+        if (!isClient)
         {
-            //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
-            continue;
+            // Collect clients to send object to (skip the ones that object is not relevant for)
+            if (useRelevancy && item.Role == NetworkObjectRole::OwnedAuthoritative)
+                BuildRelevantTargets(item, obj, relevancySpawns, relevancySpawnItems);
+            else
+                BuildCachedTargets(item);
+            if (item.HiddenClientIds.HasItems())
+                RemoveHiddenTargets(item); // Skip clients that object is not spawned for yet (eg. late-joining client)
+            if (CachedTargets.Count() == 0)
+                continue;
+        }
+        bool due = true;
+        if (!item.Dirty)
+        {
+            // Skip serializing clean objects that are replicated only when dirty or with lower frequency
+            if (item.ReplicationFPS < 0.0f)
+                due = false;
+            else if (item.ReplicationFPS > 0.0f && time + timeTolerance < item.LastReplicationTime + 1.0 / item.ReplicationFPS)
+                due = false;
+        }
+        if (due)
+        {
+            item.Dirty = false;
+            item.LastReplicationTime = time;
         }
 
-        // Send object to clients
+        if (useBudget)
         {
-            const uint32 size = stream->GetPosition();
-            ASSERT(size <= MAX_uint16)
-            NetworkMessageObjectReplicate msgData;
-            msgData.OwnerFrame = NetworkManager::Frame;
-            msgData.ObjectId = item.ObjectId;
-            msgData.ParentId = item.ParentId;
-            if (isClient)
+            // Queue object for the clients and send the most important ones within the bandwidth budget (below)
+            if (due)
             {
-                // Remap local client object ids into server ids
-                IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
-                IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
+                for (const NetworkConnection& target : CachedTargets)
+                {
+                    const NetworkClient* client = NetworkManager::GetClient(target);
+                    bool found = false;
+                    for (const ReplicationPending& e : item.Pending)
+                        found |= e.ClientId == client->ClientId;
+                    if (!found)
+                        item.Pending.Add({ client->ClientId, 0.0f });
+                }
             }
-            GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
-            msgData.DataSize = size;
-            const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
-            const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
-            uint32 partsCount = 1;
-            uint32 dataStart = 0;
-            uint32 msgDataSize = size;
-            if (size > msgMaxData)
-            {
-                // Send msgMaxData within first message
-                msgDataSize = msgMaxData;
-                dataStart += msgMaxData;
+            if (item.Pending.HasItems())
+                budgetObjects.Add(&item);
+            continue;
+        }
+        if (due)
+        {
+            item.PendingTargets = CachedTargets;
+            SerializeQueue.Add({ &item });
+        }
+    }
 
-                // Send rest of the data in separate parts
-                partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
+    // Send the most important pending objects to each client within its bandwidth budget (the rest carries over with increased priority)
+    if (useBudget)
+    {
+        PROFILE_CPU_NAMED("BandwidthBudget");
+        const float budgetTime = (float)Math::Clamp(time - LastBudgetTime, 0.0, 0.25);
+        LastBudgetTime = time;
+        const float budget = (float)NetworkReplicator::ClientBandwidth * budgetTime;
+        Array<Pair<float, NetworkReplicatedObject*>> clientObjects;
+        for (NetworkClient* client : NetworkManager::Clients)
+        {
+            if (client->State != NetworkConnectionState::Connected)
+                continue;
+            clientObjects.Clear();
+            for (NetworkReplicatedObject* item : budgetObjects)
+            {
+                for (ReplicationPending& e : item->Pending)
+                {
+                    if (e.ClientId == client->ClientId)
+                    {
+                        e.Priority += GetReplicationPriority(*item, client);
+                        clientObjects.Add(ToPair(e.Priority, item));
+                        break;
+                    }
+                }
             }
-            else
-                dataStart += size;
-            ASSERT(partsCount <= MAX_uint8)
-            msgData.PartsCount = partsCount;
-            NetworkMessage msg = peer->BeginSendMessage();
-            msg.WriteStructure(msgData);
-            msg.WriteBytes(stream->GetBuffer(), msgDataSize);
-            if (isClient)
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-            else
+            Sorting::QuickSort(clientObjects.Get(), clientObjects.Count(), &SortReplicationPriority);
+            float used = 0.0f;
+            for (const auto& e : clientObjects)
             {
-                // TODO: per-object relevancy for connected clients (eg. skip replicating actor to far players)
-                BuildCachedTargets(item);
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+                NetworkReplicatedObject* item = e.Second;
+                const float size = (float)(item->LastSize + sizeof(NetworkMessageObjectReplicate));
+                if (used > 0.0f && used + size > budget)
+                    continue; // Always send at least one object to prevent starvation of the large objects
+                used += size;
+                item->PendingTargets.Add(client->Connection);
+                RemoveReplicationPending(*item, client->ClientId);
             }
+        }
+        for (NetworkReplicatedObject* item : budgetObjects)
+        {
+            if (item->PendingTargets.HasItems())
+                SerializeQueue.Add({ item });
+        }
+    }
+    ReplicateObjects(stream);
 
-            // Send all other parts
-            for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
+    // Spawn objects that became relevant for clients
+    if (relevancySpawns.Count() != 0)
+    {
+        PROFILE_CPU_NAMED("RelevancySpawns");
+        Array<NetworkClient*> spawnClients;
+        for (RelevancySpawn& e : relevancySpawns)
+        {
+            spawnClients.Clear();
+            spawnClients.Add(e.Client);
+            for (SpawnGroup& g : e.Groups)
             {
-                NetworkMessageObjectReplicatePart msgDataPart;
-                msgDataPart.OwnerFrame = msgData.OwnerFrame;
-                msgDataPart.ObjectId = msgData.ObjectId;
-                msgDataPart.DataSize = msgData.DataSize;
-                msgDataPart.PartsCount = msgData.PartsCount;
-                msgDataPart.PartStart = dataStart;
-                msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
-                msg = peer->BeginSendMessage();
-                msg.WriteStructure(msgDataPart);
-                msg.WriteBytes(stream->GetBuffer() + msgDataPart.PartStart, msgDataPart.PartSize);
-                dataStart += msgDataPart.PartSize;
-                if (isClient)
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-                else
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+                SendObjectSpawnMessage(g, spawnClients);
             }
-            ASSERT_LOW_LAYER(dataStart == size);
-
-            // TODO: stats for bytes send per object type
         }
     }
 
@@ -1275,24 +2331,36 @@ void NetworkInternal::NetworkReplicatorUpdate()
             // Remap local client object ids into server ids
             IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
         }
-        GetNetworkName(msgData.RpcTypeName, e.Name.First.GetType().Fullname);
-        GetNetworkName(msgData.RpcName, e.Name.Second);
+        msgData.RpcId = GetNetworkId(e.Name);
+        if (!FindNetworkRpc(msgData.RpcId))
+        {
+            LOG(Error, "[NetworkReplicator] Cannot invoke RPC {0}::{1} due to the network identifier collision", e.Name.First.ToString(), String(e.Name.Second));
+            continue;
+        }
         msgData.ArgsSize = (uint16)e.ArgsData.Length();
         NetworkMessage msg = peer->BeginSendMessage();
         msg.WriteStructure(msgData);
         msg.WriteBytes(e.ArgsData.Get(), e.ArgsData.Length());
         NetworkChannelType channel = (NetworkChannelType)e.Info.Channel;
+        const uint32 msgSize = msg.Position;
+        uint32 targetsCount = 0;
         if (e.Info.Server && isClient)
         {
             // Client -> Server
             peer->EndSendMessage(channel, msg);
+            targetsCount = 1;
         }
         else if (e.Info.Client && (isServer || isHost))
         {
             // Server -> Client(s)
             BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, NetworkManager::LocalClientId);
+            RemoveHiddenTargets(item);
             peer->EndSendMessage(channel, msg, CachedTargets);
+            targetsCount = CachedTargets.Count();
         }
+        ReplicationStats& stats = RpcsStats[e.Name];
+        stats.BytesSent += (uint64)msgSize * targetsCount;
+        stats.MessagesSent += targetsCount;
     }
     RpcQueue.Clear();
 
@@ -1307,7 +2375,7 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     ScopeLock lock(ObjectsLock);
     if (DespawnedObjects.Contains(msgData.ObjectId))
         return; // Skip replicating not-existing objects
-    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId, msgData.ParentId, msgData.ObjectTypeName);
+    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId, msgData.ParentId, msgData.ObjectTypeId);
     if (!e)
         return;
     auto& item = *e;
@@ -1315,18 +2383,28 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     // Reject event from someone who is not an object owner
     if (client && item.OwnerClientId != client->ClientId)
         return;
+    if (ScriptingObject* obj = item.Object.Get())
+    {
+        ReplicationStats& stats = TypesStats[obj->GetTypeHandle()];
+        stats.BytesReceived += event.Message.Length;
+        stats.MessagesReceived++;
+    }
 
     if (msgData.PartsCount == 1)
     {
         // Replicate
-        InvokeObjectReplication(item, msgData.OwnerFrame, event.Message.Buffer + event.Message.Position, msgData.DataSize);
+        InvokeObjectReplication(item, msgData.OwnerFrame, msgData.BaselineFrame, event.Message.Buffer + event.Message.Position, msgData.DataSize);
     }
     else
     {
         // Add to replication from multiple parts
         const uint16 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
         ReplicateItem* replicateItem = AddObjectReplicateItem(event, msgData, 0, msgMaxData);
-        replicateItem->Object = e->Object;
+        if (replicateItem)
+        {
+            replicateItem->Object = e->Object;
+            replicateItem->BaselineFrame = msgData.BaselineFrame;
+        }
     }
 }
 
@@ -1337,10 +2415,63 @@ void NetworkInternal::OnNetworkMessageObjectReplicatePart(NetworkEvent& event, N
     ScopeLock lock(ObjectsLock);
     if (DespawnedObjects.Contains(msgData.ObjectId))
         return; // Skip replicating not-existing objects
+    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId);
+    if (ScriptingObject* obj = e ? e->Object.Get() : nullptr)
+    {
+        ReplicationStats& stats = TypesStats[obj->GetTypeHandle()];
+        stats.BytesReceived += event.Message.Length;
+        stats.MessagesReceived++;
+    }
 
     AddObjectReplicateItem(event, msgData, msgData.PartStart, msgData.PartSize);
 }
 
+void NetworkInternal::OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    NetworkMessageObjectReplicateAck msgData;
+    event.Message.ReadStructure(msgData);
+    auto* msgDataItems = (NetworkMessageObjectReplicateAckItem*)event.Message.SkipBytes(msgData.ItemsCount * sizeof(NetworkMessageObjectReplicateAckItem));
+    if (!client)
+        return;
+    ScopeLock lock(ObjectsLock);
+    const uint32 connectionId = client->Connection.ConnectionId;
+    for (int32 i = 0; i < msgData.ItemsCount; i++)
+    {
+        const auto& msgDataItem = msgDataItems[i];
+        auto it = Objects.Find(msgDataItem.ObjectId);
+        if (it == Objects.End())
+            continue;
+        auto& item = it->Item;
+
+        // Update the last state acknowledged by that client (acks can arrive out of order)
+        ReplicationAck* ack = nullptr;
+        for (ReplicationAck& e : item.Acks)
+        {
+            if (e.ConnectionId == connectionId)
+            {
+                ack = &e;
+                break;
+            }
+        }
+        if (!ack)
+        {
+            ack = &item.Acks.AddOne();
+            ack->ConnectionId = connectionId;
+            ack->Frame = 0;
+        }
+        if (msgDataItem.Frame > ack->Frame)
+            ack->Frame = msgDataItem.Frame;
+    }
+}
+
+void NetworkInternal::OnNetworkMessageObjectsSynced(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    if (!NetworkManager::IsClient())
+        return;
+    NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] World synced");
+    NetworkReplicator::WorldReady();
+}
+
 void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
     NetworkMessageObjectSpawn msgData;
@@ -1350,16 +2481,20 @@ void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkCl
         return;
     ScopeLock lock(ObjectsLock);
 
+    // Allow replication of objects that were despawned before (eg. object became relevant again for this client)
+    for (int32 i = 0; i < msgData.ItemsCount; i++)
+        DespawnedObjects.Remove(msgDataItems[i].ObjectId);
+
     // Check if that object has been already spawned
     auto& rootItem = msgDataItems[0];
-    NetworkReplicatedObject* root = ResolveObject(rootItem.ObjectId, rootItem.ParentId, rootItem.ObjectTypeName);
+    NetworkReplicatedObject* root = ResolveObject(rootItem.ObjectId, rootItem.ParentId, rootItem.ObjectTypeId);
     if (root)
     {
         // Object already exists locally so just synchronize the ownership (and mark as spawned)
         for (int32 i = 0; i < msgData.ItemsCount; i++)
         {
             auto& msgDataItem = msgDataItems[i];
-            NetworkReplicatedObject* e = ResolveObject(msgDataItem.ObjectId, msgDataItem.ParentId, msgDataItem.ObjectTypeName);
+            NetworkReplicatedObject* e = ResolveObject(msgDataItem.ObjectId, msgDataItem.ParentId, msgDataItem.ObjectTypeId);
             auto& item = *e;
             item.Spawned = true;
             if (NetworkManager::IsClient())
@@ -1445,14 +2580,14 @@ void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkCl
         // Spawn object
         if (msgData.ItemsCount != 1)
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Only prefab object spawning can contain more than one object (for type {})", String(rootItem.ObjectTypeName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Only prefab object spawning can contain more than one object (for type {})", FindNetworkType(rootItem.ObjectTypeId).ToString());
             return;
         }
-        const ScriptingTypeHandle objectType = Scripting::FindScriptingType(rootItem.ObjectTypeName);
+        const ScriptingTypeHandle objectType = FindNetworkType(rootItem.ObjectTypeId);
         obj = ScriptingObject::NewObject(objectType);
         if (!obj)
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object type {}", String(rootItem.ObjectTypeName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object type {}", objectType.ToString());
             return;
         }
     }
@@ -1601,25 +2736,23 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
             return;
 
         // Find RPC info
-        NetworkRpcName name;
-        name.First = Scripting::FindScriptingType(msgData.RpcTypeName);
-        name.Second = msgData.RpcName;
-        const NetworkRpcInfo* info = NetworkRpcInfo::RPCsTable.TryGet(name);
+        const NetworkRpcName* name = FindNetworkRpc(msgData.RpcId);
+        const NetworkRpcInfo* info = name ? NetworkRpcInfo::RPCsTable.TryGet(*name) : nullptr;
         if (!info)
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}::{}", msgData.ObjectId, String(msgData.RpcTypeName), String(msgData.RpcName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}", msgData.ObjectId, msgData.RpcId);
             return;
         }
 
         // Validate RPC
         if (info->Server && NetworkManager::IsClient())
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke server RPC {}::{} on client", String(msgData.RpcTypeName), String(msgData.RpcName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke server RPC {}::{} on client", name->First.ToString(), String(name->Second));
             return;
         }
         if (info->Client && NetworkManager::IsServer())
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke client RPC {}::{} on server", String(msgData.RpcTypeName), String(msgData.RpcName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke client RPC {}::{} on server", name->First.ToString(), String(name->Second));
             return;
         }
 
@@ -1630,10 +2763,15 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
         stream->Initialize(event.Message.Buffer + event.Message.Position, msgData.ArgsSize);
 
         // Execute RPC
+        const uint64 startTime = Platform::GetTimeCycles();
         info->Execute(obj, stream, info->Tag);
+        ReplicationStats& stats = RpcsStats[*name];
+        stats.BytesReceived += event.Message.Length;
+        stats.MessagesReceived++;
+        stats.TimeCycles += Platform::GetTimeCycles() - startTime;
     }
     else
     {
-        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}::{}", msgData.ObjectId, String(msgData.RpcTypeName), String(msgData.RpcName));
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}", msgData.ObjectId, msgData.RpcId);
     }
 }
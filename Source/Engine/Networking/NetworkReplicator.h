@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Types.h"
+#include "NetworkStats.h"
+#include "Engine/Core/Delegate.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Scripting/ScriptingType.h"
 
@@ -33,10 +35,47 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     friend class NetworkReplicatorInternal;
     typedef void (*SerializeFunc)(void* instance, NetworkStream* stream, void* tag);
 
+public:
+    /// <summary>
+    /// Enables delta-compression of the replicated objects state. Server encodes only the bytes that changed since the last state acknowledged by each client which greatly reduces bandwidth for slow-changing objects. Enabled by default.
+    /// </summary>
+    API_FIELD() static bool EnableDeltaCompression;
+
+    /// <summary>
+    /// The maximum distance between the object and the client view position (see NetworkClient::ViewPosition) at which the object is relevant for that client. Irrelevant objects are not replicated to that client and spawned objects get despawned on it (and spawned back once they become relevant). Evaluated on server for the root objects of the replication hierarchy (child objects share the relevancy of their root). Use 0 to disable distance-based relevancy (default).
+    /// </summary>
+    API_FIELD() static float RelevancyDistance;
+
+    /// <summary>
+    /// The custom object relevancy callback that overrides the distance-based relevancy. Called on server with the root object of the replication hierarchy and the connected client (excluding the object owner). Returns true if object is relevant for the client, otherwise false. Objects without location (eg. not an actor or script) are relevant for all clients unless the callback decides otherwise.
+    /// </summary>
+    static Function<bool(ScriptingObject*, NetworkClient*)> RelevancyCallback;
+
+    /// <summary>
+    /// The maximum bandwidth (in bytes per second) of the objects replication data sent to a single client. Pending objects are sorted by priority (accumulated over time and higher for objects closer to the client view position) and the most important ones fill the budget while the rest carries over to the next updates. Use 0 to disable the bandwidth budget (default). See NetworkSettings.
+    /// </summary>
+    API_FIELD() static int32 ClientBandwidth;
+
+    /// <summary>
+    /// The distance from the client view position (see NetworkClient::ViewPosition) at which the object replication priority halves. Used when bandwidth budget is enabled (see ClientBandwidth). Use 0 to ignore distance in prioritization. See NetworkSettings.
+    /// </summary>
+    API_FIELD() static float PriorityDistance;
+
+    /// <summary>
+    /// The maximum amount of the previously spawned objects to spawn on a late-joining client within a single network update. Objects closer to the client view position are spawned first and the client gets WorldReady event once all of them got spawned. Use 0 to spawn all objects at once. See NetworkSettings.
+    /// </summary>
+    API_FIELD() static int32 LateJoinBudget;
+
+    /// <summary>
+    /// Event called on client once all the objects spawned on server before the client connected got spawned locally (late-join world sync). Objects managed by relevancy are spawned once they become relevant so they might come later.
+    /// </summary>
+    API_EVENT() static Action WorldReady;
+
 public:
     /// <summary>
     /// Adds the network replication serializer for a given type.
     /// </summary>
+    /// <remarks>Serialization of many objects can run in parallel on job system threads so serialize callback should only read the object state (and must not modify replication state such as role or ownership).</remarks>
     /// <param name="typeHandle">The scripting type to serialize.</param>
     /// <param name="serialize">Serialization callback method.</param>
     /// <param name="deserialize">Deserialization callback method.</param>
@@ -149,11 +188,32 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     API_FUNCTION() static void SetObjectOwnership(ScriptingObject* obj, uint32 ownerClientId, NetworkObjectRole localRole = NetworkObjectRole::Replicated, bool hierarchical = true);
 
     /// <summary>
-    /// Marks the object dirty to perform immediate replication to the other clients.
+    /// Marks the object dirty to perform immediate replication to the other clients (on the next network update, regardless of the object replication frequency).
     /// </summary>
     /// <param name="obj">The network object.</param>
     API_FUNCTION() static void DirtyObject(ScriptingObject* obj);
 
+    /// <summary>
+    /// Gets the object replication frequency (updates per second). Value 0 means the object is replicated on every network update and negative value means it's replicated only when marked as dirty (see DirtyObject).
+    /// </summary>
+    /// <param name="obj">The network object.</param>
+    /// <returns>The replication frequency.</returns>
+    API_FUNCTION() static float GetObjectReplicationFPS(ScriptingObject* obj);
+
+    /// <summary>
+    /// Sets the object replication frequency (updates per second). Use 0 to replicate the object on every network update (default) or negative value to replicate it only when marked as dirty (see DirtyObject). Clean objects are not serialized.
+    /// </summary>
+    /// <param name="obj">The network object.</param>
+    /// <param name="replicationFPS">The replication frequency.</param>
+    API_FUNCTION() static void SetObjectReplicationFPS(ScriptingObject* obj, float replicationFPS);
+
+    /// <summary>
+    /// Sets the default replication frequency (updates per second) for objects of the given type (including the types that inherit from it). Applied to the objects added to the replication after this call. See SetObjectReplicationFPS.
+    /// </summary>
+    /// <param name="typeHandle">The object type.</param>
+    /// <param name="replicationFPS">The replication frequency.</param>
+    API_FUNCTION() static void SetTypeReplicationFPS(const ScriptingTypeHandle& typeHandle, float replicationFPS);
+
 public:
     /// <summary>
     /// Begins invoking the RPC and returns the Network Stream to serialize parameters to.
@@ -170,6 +230,24 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     /// <param name="argsStream">The RPC serialized arguments stream returned from BeginInvokeRPC.</param>
     static void EndInvokeRPC(ScriptingObject* obj, const ScriptingTypeHandle& type, const StringAnsiView& name, NetworkStream* argsStream);
 
+public:
+    /// <summary>
+    /// Gets the replication statistics for each replicated object type (sorted by the amount of bytes sent). Can be used to find which objects use most of the network bandwidth.
+    /// </summary>
+    /// <returns>The statistics list.</returns>
+    API_FUNCTION() static Array<NetworkReplicationStats, HeapAllocation> GetTypesStats();
+
+    /// <summary>
+    /// Gets the replication statistics for each RPC (sorted by the amount of bytes sent).
+    /// </summary>
+    /// <returns>The statistics list.</returns>
+    API_FUNCTION() static Array<NetworkReplicationStats, HeapAllocation> GetRpcsStats();
+
+    /// <summary>
+    /// Resets the accumulated replication statistics of the object types and RPCs.
+    /// </summary>
+    API_FUNCTION() static void ResetStats();
+
 private:
 #if !COMPILE_WITHOUT_CSHARP
     API_FUNCTION(NoProxy) static void AddSerializer(const ScriptingTypeHandle& typeHandle, const Function<void(void*, void*)>& serialize, const Function<void(void*, void*)>& deserialize);
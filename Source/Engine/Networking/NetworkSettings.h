@@ -31,6 +31,24 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings") class FLAXENGINE_API
     API_FIELD(Attributes="EditorOrder(100), Limit(0, 1000), EditorDisplay(\"General\", \"Network FPS\")")
     float NetworkFPS = 60.0f;
 
+    /// <summary>
+    /// The maximum bandwidth (in bytes per second) of the objects replication data sent to a single client. The most important pending objects fill the budget and the rest is sent in the next updates (prioritized by distance to the client view and by their staleness). Use 0 for unlimited bandwidth.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(200), Limit(0), EditorDisplay(\"Replication\")")
+    int32 ClientBandwidth = 0;
+
+    /// <summary>
+    /// The distance from the client view position at which the object replication priority halves (closer objects are replicated more often when using bandwidth budget). Use 0 to ignore distance in prioritization.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(210), Limit(0), EditorDisplay(\"Replication\")")
+    float PriorityDistance = 5000.0f;
+
+    /// <summary>
+    /// The maximum amount of the previously spawned objects to spawn on a late-joining client within a single network update (the world sync is spread over several updates to reduce perf-spikes on both server and client). Objects closer to the client view are spawned first. Use 0 to spawn all objects at once.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(220), Limit(0), EditorDisplay(\"Replication\")")
+    int32 LateJoinBudget = 256;
+
     /// <summary>
     /// Address of the server (server/host always runs on localhost). Only IPv4 is supported.
     /// </summary>
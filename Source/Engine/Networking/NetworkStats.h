@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Compiler.h"
 #include "Engine/Core/Config.h"
+#include "Engine/Core/Types/String.h"
 
 /// <summary>
 /// The network transport driver statistics container. Contains information about INetworkDriver usage and performance.
@@ -33,3 +34,41 @@ struct TIsPODType<NetworkDriverStats>
 {
     enum { Value = true };
 };
+
+/// <summary>
+/// The network replication statistics container for a single replicated object type or RPC. Contains the data accumulated since the start (or the last stats reset).
+/// </summary>
+API_STRUCT(Namespace="FlaxEngine.Networking") struct FLAXENGINE_API NetworkReplicationStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(NetworkReplicationStats);
+
+    /// <summary>
+    /// The name of the replicated object type or RPC (in format Type::Method).
+    /// </summary>
+    API_FIELD() String Name;
+
+    /// <summary>
+    /// Total amount of data bytes sent (including messages headers, counted per each target connection).
+    /// </summary>
+    API_FIELD() uint64 BytesSent = 0;
+
+    /// <summary>
+    /// Total amount of data bytes received (including messages headers).
+    /// </summary>
+    API_FIELD() uint64 BytesReceived = 0;
+
+    /// <summary>
+    /// Total amount of messages sent (counted per each target connection).
+    /// </summary>
+    API_FIELD() uint32 MessagesSent = 0;
+
+    /// <summary>
+    /// Total amount of messages received.
+    /// </summary>
+    API_FIELD() uint32 MessagesReceived = 0;
+
+    /// <summary>
+    /// Total time spent on serialization and deserialization of the replicated objects or on the execution of the received RPCs (in milliseconds).
+    /// </summary>
+    API_FIELD() float TimeMs = 0.0f;
+};
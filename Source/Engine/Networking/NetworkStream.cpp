@@ -36,6 +36,7 @@ void NetworkStream::Initialize(uint32 minCapacity)
 
     // Reset pointer to the start
     _position = _buffer;
+    _bitOffset = 0;
 }
 
 void NetworkStream::Initialize(byte* buffer, uint32 length)
@@ -45,6 +46,7 @@ void NetworkStream::Initialize(byte* buffer, uint32 length)
     _position = _buffer = buffer;
     _length = length;
     _allocated = false;
+    _bitOffset = 0;
 }
 
 void NetworkStream::Flush()
@@ -59,6 +61,7 @@ void NetworkStream::Close()
     _position = _buffer = nullptr;
     _length = 0;
     _allocated = false;
+    _bitOffset = 0;
 }
 
 uint32 NetworkStream::GetLength()
@@ -75,6 +78,7 @@ void NetworkStream::SetPosition(uint32 seek)
 {
     ASSERT(_length > 0);
     _position = _buffer + seek;
+    _bitOffset = 0;
 }
 
 void NetworkStream::ReadBytes(void* data, uint32 bytes)
@@ -85,6 +89,7 @@ void NetworkStream::ReadBytes(void* data, uint32 bytes)
         Platform::MemoryCopy(data, _position, bytes);
         _position += bytes;
     }
+    _bitOffset = 0;
 }
 
 void NetworkStream::WriteBytes(const void* data, uint32 bytes)
@@ -119,4 +124,175 @@ void NetworkStream::WriteBytes(const void* data, uint32 bytes)
     // Copy data
     Platform::MemoryCopy(_position, data, bytes);
     _position += bytes;
+    _bitOffset = 0;
+}
+
+void NetworkStream::WriteBits(uint32 value, int32 bits)
+{
+    ASSERT(bits > 0 && bits <= 32);
+    while (bits > 0)
+    {
+        if (_bitOffset == 0)
+        {
+            // Start the next byte (stays as the last written byte until filled)
+            const byte zero = 0;
+            WriteBytes(&zero, 1);
+        }
+        const int32 count = Math::Min(bits, 8 - (int32)_bitOffset);
+        _position[-1] |= (byte)((value & ((1u << count) - 1)) << _bitOffset);
+        value = count < 32 ? value >> count : 0;
+        bits -= count;
+        _bitOffset = (_bitOffset + count) & 7;
+    }
+}
+
+uint32 NetworkStream::ReadBits(int32 bits)
+{
+    ASSERT(bits > 0 && bits <= 32);
+    uint32 value = 0;
+    int32 shift = 0;
+    while (bits > 0)
+    {
+        if (_bitOffset == 0)
+        {
+            // Move to the next byte
+            ASSERT(GetLength() - GetPosition() >= 1);
+            _position++;
+        }
+        const int32 count = Math::Min(bits, 8 - (int32)_bitOffset);
+        value |= (uint32)((_position[-1] >> _bitOffset) & ((1u << count) - 1)) << shift;
+        shift += count;
+        bits -= count;
+        _bitOffset = (_bitOffset + count) & 7;
+    }
+    return value;
+}
+
+void NetworkStream::WriteVarUInt32(uint32 value)
+{
+    do
+    {
+        const uint32 part = value & 0x7f;
+        value >>= 7;
+        WriteBits(part | (value != 0 ? 0x80 : 0), 8);
+    } while (value != 0);
+}
+
+uint32 NetworkStream::ReadVarUInt32()
+{
+    uint32 value = 0;
+    for (int32 shift = 0; shift < 35; shift += 7)
+    {
+        const uint32 part = ReadBits(8);
+        value |= (part & 0x7f) << shift;
+        if ((part & 0x80) == 0)
+            break;
+    }
+    return value;
+}
+
+namespace
+{
+    // Range of the quaternion components (other than the largest one) in smallest-three encoding (1 / sqrt(2))
+    constexpr float SmallestThreeRange = 0.70710678f;
+
+    FORCE_INLINE int32 GetRangeBits(uint32 range)
+    {
+        int32 bits = 1;
+        while (bits < 32 && (range >> bits) != 0)
+            bits++;
+        return bits;
+    }
+
+    FORCE_INLINE uint32 GetBitsMask(int32 bits)
+    {
+        return bits >= 32 ? MAX_uint32 : (1u << bits) - 1;
+    }
+}
+
+void NetworkStream::WriteRangedInt32(int32 value, int32 min, int32 max)
+{
+    ASSERT(min < max);
+    value = Math::Clamp(value, min, max);
+    WriteBits((uint32)((int64)value - min), GetRangeBits((uint32)((int64)max - min)));
+}
+
+int32 NetworkStream::ReadRangedInt32(int32 min, int32 max)
+{
+    ASSERT(min < max);
+    const uint32 value = ReadBits(GetRangeBits((uint32)((int64)max - min)));
+    return (int32)Math::Min((int64)min + value, (int64)max);
+}
+
+void NetworkStream::WriteQuantized(float value, float min, float max, int32 bits)
+{
+    ASSERT(min < max);
+    const float alpha = Math::Saturate((value - min) / (max - min));
+    WriteBits((uint32)((double)alpha * GetBitsMask(bits) + 0.5), bits);
+}
+
+float NetworkStream::ReadQuantized(float min, float max, int32 bits)
+{
+    ASSERT(min < max);
+    const double alpha = (double)ReadBits(bits) / GetBitsMask(bits);
+    return (float)(min + alpha * (max - min));
+}
+
+void NetworkStream::WriteQuantized(const Vector3& value, float precision)
+{
+    WriteQuantized((float)value.X, precision);
+    WriteQuantized((float)value.Y, precision);
+    WriteQuantized((float)value.Z, precision);
+}
+
+Vector3 NetworkStream::ReadQuantizedVector3(float precision)
+{
+    Vector3 value;
+    value.X = ReadQuantized(precision);
+    value.Y = ReadQuantized(precision);
+    value.Z = ReadQuantized(precision);
+    return value;
+}
+
+void NetworkStream::WriteQuantized(const Quaternion& value, int32 bits)
+{
+    ASSERT(bits >= 2 && bits <= 30);
+    Quaternion q = value;
+    q.Normalize();
+
+    // Find the largest component that is skipped (can be reconstructed from the other ones)
+    int32 largest = 0;
+    for (int32 i = 1; i < 4; i++)
+    {
+        if (Math::Abs(q.Raw[i]) > Math::Abs(q.Raw[largest]))
+            largest = i;
+    }
+
+    // Ensure the largest component is positive (q and -q represent the same rotation)
+    const float sign = q.Raw[largest] < 0.0f ? -1.0f : 1.0f;
+    WriteBits(largest, 2);
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+            WriteQuantized(q.Raw[i] * sign, -SmallestThreeRange, SmallestThreeRange, bits);
+    }
+}
+
+Quaternion NetworkStream::ReadQuantizedQuaternion(int32 bits)
+{
+    ASSERT(bits >= 2 && bits <= 30);
+    Quaternion q;
+    const int32 largest = (int32)ReadBits(2);
+    float sum = 0.0f;
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+        {
+            q.Raw[i] = ReadQuantized(-SmallestThreeRange, SmallestThreeRange, bits);
+            sum += q.Raw[i] * q.Raw[i];
+        }
+    }
+    q.Raw[largest] = Math::Sqrt(Math::Max(1.0f - sum, 0.0f));
+    q.Normalize();
+    return q;
 }
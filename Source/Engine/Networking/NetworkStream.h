@@ -3,12 +3,15 @@
 #pragma once
 
 #include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Serialization/ReadStream.h"
 #include "Engine/Serialization/WriteStream.h"
 
 /// <summary>
 /// Objects and values serialization stream for sending data over network. Uses memory buffer for both read and write operations.
 /// </summary>
+/// <remarks>Supports bit-level packing (eg. flags, varints, ranged integers and quantized math types). Bits are packed into bytes and the byte-level reads/writes start from the next full byte.</remarks>
 API_CLASS(sealed, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkStream final : public ScriptingObject, public ReadStream, public WriteStream
 {
     DECLARE_SCRIPTING_TYPE(NetworkStream);
@@ -17,6 +20,7 @@ API_CLASS(sealed, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     byte* _position = nullptr;
     uint32 _length = 0;
     bool _allocated = false;
+    uint8 _bitOffset = 0;
 
 public:
     ~NetworkStream();
@@ -62,6 +66,146 @@ API_CLASS(sealed, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
         ReadBytes(data, bytes);
     }
 
+public:
+    /// <summary>
+    /// Writes the bits to the stream.
+    /// </summary>
+    /// <param name="value">The value to write (lowest bits are used).</param>
+    /// <param name="bits">The amount of bits to write (in range 1-32).</param>
+    API_FUNCTION() void WriteBits(uint32 value, int32 bits);
+
+    /// <summary>
+    /// Reads the bits from the stream.
+    /// </summary>
+    /// <param name="bits">The amount of bits to read (in range 1-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() uint32 ReadBits(int32 bits);
+
+    /// <summary>
+    /// Writes the single bit to the stream (eg. flag).
+    /// </summary>
+    API_FUNCTION() FORCE_INLINE void WriteBit(bool value)
+    {
+        WriteBits(value ? 1 : 0, 1);
+    }
+
+    /// <summary>
+    /// Reads the single bit from the stream (eg. flag).
+    /// </summary>
+    API_FUNCTION() FORCE_INLINE bool ReadBit()
+    {
+        return ReadBits(1) != 0;
+    }
+
+    /// <summary>
+    /// Writes the unsigned integer using variable-length encoding (7 bits per byte, small values use less data).
+    /// </summary>
+    API_FUNCTION() void WriteVarUInt32(uint32 value);
+
+    /// <summary>
+    /// Reads the unsigned integer using variable-length encoding.
+    /// </summary>
+    API_FUNCTION() uint32 ReadVarUInt32();
+
+    /// <summary>
+    /// Writes the signed integer using variable-length encoding (zig-zag encoded so small negative values use less data too).
+    /// </summary>
+    API_FUNCTION() FORCE_INLINE void WriteVarInt32(int32 value)
+    {
+        WriteVarUInt32(((uint32)value << 1) ^ (uint32)(value >> 31));
+    }
+
+    /// <summary>
+    /// Reads the signed integer using variable-length encoding.
+    /// </summary>
+    API_FUNCTION() FORCE_INLINE int32 ReadVarInt32()
+    {
+        const uint32 value = ReadVarUInt32();
+        return (int32)(value >> 1) ^ -(int32)(value & 1);
+    }
+
+    /// <summary>
+    /// Writes the integer from the given range using the minimal amount of bits.
+    /// </summary>
+    /// <param name="value">The value to write (clamped to the range).</param>
+    /// <param name="min">The minimum value (inclusive).</param>
+    /// <param name="max">The maximum value (inclusive).</param>
+    API_FUNCTION() void WriteRangedInt32(int32 value, int32 min, int32 max);
+
+    /// <summary>
+    /// Reads the integer from the given range.
+    /// </summary>
+    /// <param name="min">The minimum value (inclusive).</param>
+    /// <param name="max">The maximum value (inclusive).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() int32 ReadRangedInt32(int32 min, int32 max);
+
+    /// <summary>
+    /// Writes the float from the given range quantized to the given amount of bits.
+    /// </summary>
+    /// <param name="value">The value to write (clamped to the range).</param>
+    /// <param name="min">The minimum value.</param>
+    /// <param name="max">The maximum value.</param>
+    /// <param name="bits">The amount of bits to use (in range 1-32).</param>
+    API_FUNCTION() void WriteQuantized(float value, float min, float max, int32 bits);
+
+    /// <summary>
+    /// Reads the float from the given range quantized to the given amount of bits.
+    /// </summary>
+    /// <param name="min">The minimum value.</param>
+    /// <param name="max">The maximum value.</param>
+    /// <param name="bits">The amount of bits to use (in range 1-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() float ReadQuantized(float min, float max, int32 bits);
+
+    /// <summary>
+    /// Writes the float quantized with the given precision (eg. 0.1 for millimeter precision of the distance in centimeters). Unbounded values are supported (the value is sent as variable-length integer of precision steps).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="precision">The quantization step.</param>
+    API_FUNCTION() FORCE_INLINE void WriteQuantized(float value, float precision)
+    {
+        WriteVarInt32(Math::RoundToInt(value / precision));
+    }
+
+    /// <summary>
+    /// Reads the float quantized with the given precision.
+    /// </summary>
+    /// <param name="precision">The quantization step.</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() FORCE_INLINE float ReadQuantized(float precision)
+    {
+        return (float)ReadVarInt32() * precision;
+    }
+
+    /// <summary>
+    /// Writes the vector quantized with the given precision (eg. 0.1 for millimeter precision of the location in centimeters).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="precision">The quantization step.</param>
+    API_FUNCTION() void WriteQuantized(const Vector3& value, float precision);
+
+    /// <summary>
+    /// Reads the vector quantized with the given precision.
+    /// </summary>
+    /// <param name="precision">The quantization step.</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Vector3 ReadQuantizedVector3(float precision);
+
+    /// <summary>
+    /// Writes the normalized rotation quantized using smallest-three encoding (index of the largest component and the other 3 components in range [-1/sqrt(2), 1/sqrt(2)]).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="bits">The amount of bits per component (in range 2-30). The default 10 bits results in ~0.1 degree precision and 4 bytes of data.</param>
+    API_FUNCTION() void WriteQuantized(const Quaternion& value, int32 bits = 10);
+
+    /// <summary>
+    /// Reads the normalized rotation quantized using smallest-three encoding.
+    /// </summary>
+    /// <param name="bits">The amount of bits per component (in range 2-30).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Quaternion ReadQuantizedQuaternion(int32 bits = 10);
+
 public:
     // [Stream]
     void Flush() override;
@@ -0,0 +1,133 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/SIMD.h"
+
+/// <summary>
+/// The vectorized kernels used by the CPU particles simulation modules. Operate on the particle attribute streams (see ParticleBuffer::CPU) and process 4 particles at once.
+/// </summary>
+namespace ParticleKernels
+{
+    /// <summary>
+    /// Adds the value to the stream of floats (data[i] += value).
+    /// </summary>
+    inline void Add(float* data, float value, int32 count)
+    {
+        const SimdVector4 v = SIMD::Splat(value);
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+            SIMD::StoreUnaligned(data + i, SIMD::Add(SIMD::LoadUnaligned(data + i), v));
+        for (; i < count; i++)
+            data[i] += value;
+    }
+
+    /// <summary>
+    /// Adds the value to the stream of vectors (data[i] += value).
+    /// </summary>
+    inline void Add(Float3* data, const Float3& value, int32 count)
+    {
+        // Every 4 vectors are 12 floats so use the 3 rotated versions of the value
+        float* ptr = (float*)data;
+        const SimdVector4 v0 = SIMD::Load(value.X, value.Y, value.Z, value.X);
+        const SimdVector4 v1 = SIMD::Load(value.Y, value.Z, value.X, value.Y);
+        const SimdVector4 v2 = SIMD::Load(value.Z, value.X, value.Y, value.Z);
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            SIMD::StoreUnaligned(ptr + 0, SIMD::Add(SIMD::LoadUnaligned(ptr + 0), v0));
+            SIMD::StoreUnaligned(ptr + 4, SIMD::Add(SIMD::LoadUnaligned(ptr + 4), v1));
+            SIMD::StoreUnaligned(ptr + 8, SIMD::Add(SIMD::LoadUnaligned(ptr + 8), v2));
+            ptr += 12;
+        }
+        for (; i < count; i++)
+            data[i] += value;
+    }
+
+    /// <summary>
+    /// Adds the scaled stream of vectors to the other stream of vectors (data[i] += src[i] * scale). Used for velocity integration.
+    /// </summary>
+    inline void MultiplyAdd(Float3* data, const Float3* src, float scale, int32 count)
+    {
+        float* dst = (float*)data;
+        const float* ptr = (const float*)src;
+        const int32 size = count * 3;
+        const SimdVector4 s = SIMD::Splat(scale);
+        int32 i = 0;
+        for (; i + 4 <= size; i += 4)
+            SIMD::StoreUnaligned(dst + i, SIMD::Add(SIMD::LoadUnaligned(dst + i), SIMD::Mul(SIMD::LoadUnaligned(ptr + i), s)));
+        for (; i < size; i++)
+            dst[i] += ptr[i] * scale;
+    }
+
+    /// <summary>
+    /// Applies the linear drag to the velocities (velocity[i] *= Max(0, 1 - drag * spriteSize[i].X * spriteSize[i].Y * dt / Max(mass[i], ZeroTolerance))).
+    /// </summary>
+    /// <param name="velocity">The velocities stream.</param>
+    /// <param name="mass">The mass stream.</param>
+    /// <param name="spriteSize">The sprite sizes stream. Optional, can be null to skip scaling drag by the particle size.</param>
+    /// <param name="drag">The drag value.</param>
+    /// <param name="dt">The simulation delta time.</param>
+    /// <param name="count">The particles count.</param>
+    inline void LinearDrag(Float3* velocity, const float* mass, const Float2* spriteSize, float drag, float dt, int32 count)
+    {
+        float* ptr = (float*)velocity;
+        const SimdVector4 zero = SIMD::Splat(0.0f);
+        const SimdVector4 one = SIMD::Splat(1.0f);
+        const SimdVector4 minMass = SIMD::Splat(ZeroTolerance);
+        const SimdVector4 dragV = SIMD::Splat(drag);
+        const SimdVector4 dtV = SIMD::Splat(dt);
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            SimdVector4 particleDrag = dragV;
+            if (spriteSize)
+            {
+                const Float2* size = spriteSize + i;
+                particleDrag = SIMD::Mul(particleDrag, SIMD::Load(size[0].MulValues(), size[1].MulValues(), size[2].MulValues(), size[3].MulValues()));
+            }
+            const SimdVector4 scale = SIMD::Max(zero, SIMD::Sub(one, SIMD::Div(SIMD::Mul(particleDrag, dtV), SIMD::Max(SIMD::LoadUnaligned(mass + i), minMass))));
+
+            // Expand per-particle scale into the layout of 4 vectors (12 floats)
+            float s[4];
+            SIMD::StoreUnaligned(s, scale);
+            SIMD::StoreUnaligned(ptr + 0, SIMD::Mul(SIMD::LoadUnaligned(ptr + 0), SIMD::Load(s[0], s[0], s[0], s[1])));
+            SIMD::StoreUnaligned(ptr + 4, SIMD::Mul(SIMD::LoadUnaligned(ptr + 4), SIMD::Load(s[1], s[1], s[2], s[2])));
+            SIMD::StoreUnaligned(ptr + 8, SIMD::Mul(SIMD::LoadUnaligned(ptr + 8), SIMD::Load(s[2], s[3], s[3], s[3])));
+            ptr += 12;
+        }
+        for (; i < count; i++)
+        {
+            float particleDrag = drag;
+            if (spriteSize)
+                particleDrag *= spriteSize[i].MulValues();
+            velocity[i] *= Math::Max(0.0f, 1.0f - (particleDrag * dt) / Math::Max(mass[i], ZeroTolerance));
+        }
+    }
+
+    /// <summary>
+    /// Tests 4 particles against the plane (at the next simulation step position). Used as an early-out for collision modules (the result is conservative: particles close to the plane are reported as colliding).
+    /// </summary>
+    /// <param name="position">The positions of 4 particles.</param>
+    /// <param name="velocity">The velocities of 4 particles.</param>
+    /// <param name="dt">The simulation delta time.</param>
+    /// <param name="planeNormal">The plane normal.</param>
+    /// <param name="planeDistance">The plane distance (dot product of the plane normal and position, including the particle radius).</param>
+    /// <returns>True if any particle might collide with the plane, otherwise false.</returns>
+    FORCE_INLINE bool OverlapsPlane4(const Float3* position, const Float3* velocity, float dt, const Float3& planeNormal, float planeDistance)
+    {
+        const SimdVector4 dtV = SIMD::Splat(dt);
+        const SimdVector4 x = SIMD::Add(SIMD::Load(position[0].X, position[1].X, position[2].X, position[3].X), SIMD::Mul(SIMD::Load(velocity[0].X, velocity[1].X, velocity[2].X, velocity[3].X), dtV));
+        const SimdVector4 y = SIMD::Add(SIMD::Load(position[0].Y, position[1].Y, position[2].Y, position[3].Y), SIMD::Mul(SIMD::Load(velocity[0].Y, velocity[1].Y, velocity[2].Y, velocity[3].Y), dtV));
+        const SimdVector4 z = SIMD::Add(SIMD::Load(position[0].Z, position[1].Z, position[2].Z, position[3].Z), SIMD::Mul(SIMD::Load(velocity[0].Z, velocity[1].Z, velocity[2].Z, velocity[3].Z), dtV));
+        SimdVector4 distance = SIMD::Mul(x, SIMD::Splat(planeNormal.X));
+        distance = SIMD::Add(distance, SIMD::Mul(y, SIMD::Splat(planeNormal.Y)));
+        distance = SIMD::Add(distance, SIMD::Mul(z, SIMD::Splat(planeNormal.Z)));
+        distance = SIMD::Sub(distance, SIMD::Splat(planeDistance));
+
+        // Use a small margin to cover the precision differences with the scalar collision code
+        return SIMD::MoveMask(SIMD::Less(distance, SIMD::Splat(1.0f))) != 0;
+    }
+}
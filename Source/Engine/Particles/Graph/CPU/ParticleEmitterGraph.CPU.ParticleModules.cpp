@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "ParticleEmitterGraph.CPU.h"
+#include "ParticleEmitterGraph.CPU.Kernels.h"
 #include "Engine/Core/Random.h"
 #include "Engine/Utilities/Noise.h"
 
@@ -10,6 +11,20 @@
 // ReSharper disable CppClangTidyCppcoreguidelinesMacroUsage
 // ReSharper disable CppClangTidyClangDiagnosticOldStyleCast
 
+// Removes the particle from the simulation (swaps with the last particle) or defers it when particle ranges are updated in parallel
+#define KILL_PARTICLE() \
+	if (context.KilledParticles) \
+	{ \
+		context.KilledParticles->Add(particleIndex); \
+	} \
+	else \
+	{ \
+		particlesEnd--; \
+		context.Data->Buffer->CPU.Count--; \
+		context.Data->Buffer->CopyParticleCPU(particleIndex, context.Data->Buffer->CPU.Count); \
+		particleIndex--; \
+	}
+
 #define RAND Random::Rand()
 #define RAND2 Float2(RAND, RAND)
 #define RAND3 Float3(RAND, RAND, RAND)
@@ -63,7 +78,7 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
     // Constant Spawn Rate
     case 100:
     {
-        const float rate = Math::Max((float)TryGetValue(node->GetBox(0), node->Values[2]), 0.0f);
+        const float rate = Math::Max(TryGetValue<float>(node->GetBox(0), node->Values[2]), 0.0f);
         spawnCount += rate * context.DeltaTime;
         break;
     }
@@ -73,7 +88,7 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
         const bool isFirstUpdate = (context.Data->Time - context.DeltaTime) <= 0.0f;
         if (isFirstUpdate)
         {
-            const float count = Math::Max((float)TryGetValue(node->GetBox(0), node->Values[2]), 0.0f);
+            const float count = Math::Max(TryGetValue<float>(node->GetBox(0), node->Values[2]), 0.0f);
             spawnCount += count;
         }
         break;
@@ -84,8 +99,8 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
         float& nextSpawnTime = data.NextSpawnTime;
         if (nextSpawnTime - context.Data->Time <= 0.0f)
         {
-            const float count = Math::Max((float)TryGetValue(node->GetBox(0), node->Values[2]), 0.0f);
-            const float delay = Math::Max((float)TryGetValue(node->GetBox(1), node->Values[3]), 0.0f);
+            const float count = Math::Max(TryGetValue<float>(node->GetBox(0), node->Values[2]), 0.0f);
+            const float delay = Math::Max(TryGetValue<float>(node->GetBox(1), node->Values[3]), 0.0f);
             nextSpawnTime = context.Data->Time + delay;
             spawnCount += count;
         }
@@ -97,8 +112,8 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
         float& nextSpawnTime = data.NextSpawnTime;
         if (nextSpawnTime - context.Data->Time <= 0.0f)
         {
-            const Float2 countMinMax = (Float2)TryGetValue(node->GetBox(0), node->Values[2]);
-            const Float2 delayMinMax = (Float2)TryGetValue(node->GetBox(1), node->Values[3]);
+            const Float2 countMinMax = TryGetValue<Float2>(node->GetBox(0), node->Values[2]);
+            const Float2 delayMinMax = TryGetValue<Float2>(node->GetBox(1), node->Values[3]);
             const float count = Math::Max(countMinMax.X + RAND * (countMinMax.Y - countMinMax.X), 0.0f);
             const float delay = Math::Max(delayMinMax.X + RAND * (delayMinMax.Y - delayMinMax.X), 0.0f);
             nextSpawnTime = context.Data->Time + delay;
@@ -120,8 +135,7 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
 void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd)
 {
     auto& context = Context.Get();
-    auto stride = context.Data->Buffer->Stride;
-    auto start = context.Data->Buffer->GetParticleCPU(particlesStart);
+    auto buffer = context.Data->Buffer;
 
     switch (node->TypeID)
     {
@@ -133,36 +147,38 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto spriteFacingMode = node->Values[2].AsInt;
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-            byte* spriteFacingModePtr = start + attribute.Offset;
+            byte* spriteFacingModePtr = buffer->GetAttributeCPU(attribute, particlesStart);
+            const int32 spriteFacingModeStride = attribute.GetSize();
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 *((int32*)spriteFacingModePtr) = spriteFacingMode;
-                spriteFacingModePtr += stride;
+                spriteFacingModePtr += spriteFacingModeStride;
             }
         }
         if ((ParticleSpriteFacingMode)spriteFacingMode == ParticleSpriteFacingMode::CustomFacingVector ||
             (ParticleSpriteFacingMode)spriteFacingMode == ParticleSpriteFacingMode::FixedAxis)
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
-            byte* customFacingVectorPtr = start + attribute.Offset;
+            byte* customFacingVectorPtr = buffer->GetAttributeCPU(attribute, particlesStart);
+            const int32 customFacingVectorStride = attribute.GetSize();
             auto box = node->GetBox(0);
             if (node->UsePerParticleDataResolve())
             {
                 for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
                 {
                     context.ParticleIndex = particleIndex;
-                    const Float3 vector = (Float3)GetValue(box, 3);
+                    const Float3 vector = GetValue<Float3>(box, 3);
                     *((Float3*)customFacingVectorPtr) = vector;
-                    customFacingVectorPtr += stride;
+                    customFacingVectorPtr += customFacingVectorStride;
                 }
             }
             else
             {
-                const Float3 vector = (Float3)GetValue(box, 3);
+                const Float3 vector = GetValue<Float3>(box, 3);
                 for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
                 {
                     *((Float3*)customFacingVectorPtr) = vector;
-                    customFacingVectorPtr += stride;
+                    customFacingVectorPtr += customFacingVectorStride;
                 }
             }
         }
@@ -176,11 +192,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto modelFacingMode = node->Values[2].AsInt;
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-            byte* modelFacingModePtr = start + attribute.Offset;
+            byte* modelFacingModePtr = buffer->GetAttributeCPU(attribute, particlesStart);
+            const int32 modelFacingModeStride = attribute.GetSize();
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 *((int32*)modelFacingModePtr) = modelFacingMode;
-                modelFacingModePtr += stride;
+                modelFacingModePtr += modelFacingModeStride;
             }
         }
         break;
@@ -190,12 +207,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Update Age");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* agePtr = start + attribute.Offset;
-        for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
-        {
-            *((float*)agePtr) += context.DeltaTime;
-            agePtr += stride;
-        }
+        float* agePtr = (float*)buffer->GetAttributeCPU(attribute, particlesStart);
+        ParticleKernels::Add(agePtr, context.DeltaTime, particlesEnd - particlesStart);
         break;
     }
     // Gravity/Force
@@ -204,26 +217,23 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Gravity/Force");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* velocityPtr = start + attribute.Offset;
+        byte* velocityPtr = buffer->GetAttributeCPU(attribute, particlesStart);
+        const int32 velocityStride = attribute.GetSize();
         auto box = node->GetBox(0);
         if (node->UsePerParticleDataResolve())
         {
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 context.ParticleIndex = particleIndex;
-                const Float3 force = (Float3)GetValue(box, 2);
+                const Float3 force = GetValue<Float3>(box, 2);
                 *((Float3*)velocityPtr) += force * context.DeltaTime;
-                velocityPtr += stride;
+                velocityPtr += velocityStride;
             }
         }
         else
         {
-            const Float3 force = (Float3)GetValue(box, 2);
-            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
-            {
-                *((Float3*)velocityPtr) += force * context.DeltaTime;
-                velocityPtr += stride;
-            }
+            const Float3 force = GetValue<Float3>(box, 2);
+            ParticleKernels::Add((Float3*)velocityPtr, force * context.DeltaTime, particlesEnd - particlesStart);
         }
         break;
     }
@@ -235,9 +245,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
 
-        byte* positionPtr = start + position.Offset;
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(position, particlesStart);
+        const int32 positionStride = position.GetSize();
+        byte* velocityPtr = buffer->GetAttributeCPU(velocity, particlesStart);
+        const int32 velocityStride = velocity.GetSize();
+        byte* massPtr = buffer->GetAttributeCPU(mass, particlesStart);
+        const int32 massStride = mass.GetSize();
 
         auto sphereCenterBox = node->GetBox(0);
         auto sphereRadiusBox = node->GetBox(1);
@@ -247,12 +260,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto stickForceBox = node->GetBox(5);
 
 #define INPUTS_FETCH() \
-	const Float3 sphereCenter = (Float3)GetValue(sphereCenterBox, 2); \
-	const float sphereRadius = (float)GetValue(sphereRadiusBox, 3); \
-	const float attractionSpeed = (float)GetValue(attractionSpeedBox, 4); \
-	const float attractionForce = (float)GetValue(attractionForceBox, 5); \
-	const float stickDistance = (float)GetValue(stickDistanceBox, 6); \
-	const float stickForce = (float)GetValue(stickForceBox, 7)
+	const Float3 sphereCenter = GetValue<Float3>(sphereCenterBox, 2); \
+	const float sphereRadius = GetValue<float>(sphereRadiusBox, 3); \
+	const float attractionSpeed = GetValue<float>(attractionSpeedBox, 4); \
+	const float attractionForce = GetValue<float>(attractionForceBox, 5); \
+	const float stickDistance = GetValue<float>(stickDistanceBox, 6); \
+	const float stickForce = GetValue<float>(stickForceBox, 7)
 #define LOGIC() \
 	Float3 dir = sphereCenter - *(Float3*)positionPtr; \
 	float distToCenter = dir.Length(); \
@@ -265,9 +278,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	float deltaSpeed = tgtSpeed - spdNormal; \
 	Float3 deltaVelocity = dir * (Math::Sign(deltaSpeed) * Math::Min(Math::Abs(deltaSpeed), context.DeltaTime * Math::Lerp(stickForce, attractionForce, ratio)) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
 	*(Float3*)velocityPtr = velocity + deltaVelocity; \
-	positionPtr += stride; \
-	velocityPtr += stride; \
-	massPtr += stride
+	positionPtr += positionStride; \
+	velocityPtr += velocityStride; \
+	massPtr += massStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -296,27 +309,25 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Kill");
         auto& position = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + position.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(position, particlesStart);
+        const int32 positionStride = position.GetSize();
 
         auto sphereCenterBox = node->GetBox(0);
         auto sphereRadiusBox = node->GetBox(1);
         auto sign = (bool)node->Values[4] ? -1.0f : 1.0f;
 
 #define INPUTS_FETCH() \
-	const Float3 sphereCenter = (Float3)GetValue(sphereCenterBox, 2); \
-	const float sphereRadius = (float)GetValue(sphereRadiusBox, 3); \
+	const Float3 sphereCenter = GetValue<Float3>(sphereCenterBox, 2); \
+	const float sphereRadius = GetValue<float>(sphereRadiusBox, 3); \
 	const float sphereRadiusSqr = sphereRadius * sphereRadius
 #define LOGIC() \
 	Float3 dir = *(Float3*)positionPtr - sphereCenter; \
 	float lengthSqr = Float3::Dot(dir, dir); \
 	if (sign * lengthSqr <= sign * sphereRadiusSqr) \
 	{ \
-		particlesEnd--; \
-		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
-		particleIndex--; \
+		KILL_PARTICLE(); \
 	} \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -345,15 +356,16 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Kill");
         auto& position = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + position.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(position, particlesStart);
+        const int32 positionStride = position.GetSize();
 
         auto boxCenterBox = node->GetBox(0);
         auto boxSizeBox = node->GetBox(1);
         auto invert = (bool)node->Values[4];
 
 #define INPUTS_FETCH() \
-	const Float3 boxCenter = (Float3)GetValue(boxCenterBox, 2); \
-	const Float3 boxSize = (Float3)GetValue(boxSizeBox, 3)
+	const Float3 boxCenter = GetValue<Float3>(boxCenterBox, 2); \
+	const Float3 boxSize = GetValue<Float3>(boxSizeBox, 3)
 #define LOGIC() \
 	Float3 dir = *(Float3*)positionPtr - boxCenter; \
 	Float3 absDir = Float3::Abs(dir); \
@@ -365,12 +377,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 		collision = absDir.X <= size.X && absDir.Y <= size.Y && absDir.Z <= size.Z; \
 	if (collision) \
 	{ \
-		particlesEnd--; \
-		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
-		particleIndex--; \
+		KILL_PARTICLE(); \
 	} \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -400,14 +409,11 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto killBox = node->GetBox(0);
 
 #define INPUTS_FETCH() \
-	const bool kill = (bool)TryGetValue(killBox, Value::False)
+	const bool kill = TryGetValue<bool>(killBox, Value::False)
 #define LOGIC() \
 	if (kill) \
 	{ \
-		particlesEnd--; \
-		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
-		particleIndex--; \
+		KILL_PARTICLE(); \
 	}
 
         if (node->UsePerParticleDataResolve())
@@ -440,21 +446,25 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
-        byte* spriteSizePtr = useSpriteSize ? start + context.Data->Buffer->Layout->Attributes[node->Attributes[2]].Offset : nullptr;
+        auto& spriteSize = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
+        byte* spriteSizePtr = useSpriteSize ? buffer->GetAttributeCPU(spriteSize, particlesStart) : nullptr;
+        const int32 spriteSizeStride = useSpriteSize ? spriteSize.GetSize() : 0;
 
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* velocityPtr = buffer->GetAttributeCPU(velocity, particlesStart);
+        const int32 velocityStride = velocity.GetSize();
+        byte* massPtr = buffer->GetAttributeCPU(mass, particlesStart);
+        const int32 massStride = mass.GetSize();
 
 #define INPUTS_FETCH() \
-	const float drag = (float)GetValue(box, 2)
+	const float drag = GetValue<float>(box, 2)
 #define LOGIC() \
 	float particleDrag = drag; \
     if (useSpriteSize) \
         particleDrag *= ((Float2*)spriteSizePtr)->MulValues(); \
     *((Float3*)velocityPtr) *= Math::Max(0.0f, 1.0f - (particleDrag * context.DeltaTime) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
-    velocityPtr += stride; \
-    massPtr += stride; \
-    spriteSizePtr += stride
+    velocityPtr += velocityStride; \
+    massPtr += massStride; \
+    spriteSizePtr += spriteSizeStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -468,10 +478,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         else
         {
             INPUTS_FETCH();
-            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
-            {
-                LOGIC();
-            }
+            ParticleKernels::LinearDrag((Float3*)velocityPtr, (const float*)massPtr, (const Float2*)spriteSizePtr, drag, context.DeltaTime, particlesEnd - particlesStart);
         }
 #undef INPUTS_FETCH
 #undef LOGIC
@@ -485,17 +492,20 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
 
-        byte* positionPtr = start + position.Offset;
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(position, particlesStart);
+        const int32 positionStride = position.GetSize();
+        byte* velocityPtr = buffer->GetAttributeCPU(velocity, particlesStart);
+        const int32 velocityStride = velocity.GetSize();
+        byte* massPtr = buffer->GetAttributeCPU(mass, particlesStart);
+        const int32 massStride = mass.GetSize();
 
         auto roughnessBox = node->GetBox(3);
         auto intensityBox = node->GetBox(4);
         auto octavesCountBox = node->GetBox(5);
 
-        const Float3 fieldPosition = (Float3)GetValue(node->GetBox(0), 2);
-        const Float3 fieldRotation = (Float3)GetValue(node->GetBox(1), 3);
-        const Float3 fieldScale = (Float3)GetValue(node->GetBox(2), 4);
+        const Float3 fieldPosition = GetValue<Float3>(node->GetBox(0), 2);
+        const Float3 fieldRotation = GetValue<Float3>(node->GetBox(1), 3);
+        const Float3 fieldScale = GetValue<Float3>(node->GetBox(2), 4);
 
         // Note: no support for per-particle transformation
         Matrix fieldTransformMatrix, invFieldTransformMatrix;
@@ -504,17 +514,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         Matrix::Invert(fieldTransformMatrix, invFieldTransformMatrix);
 
 #define INPUTS_FETCH() \
-	const float roughness = (float)GetValue(roughnessBox, 5); \
-	const float intensity = (float)GetValue(intensityBox, 6); \
+	const float roughness = GetValue<float>(roughnessBox, 5); \
+	const float intensity = GetValue<float>(intensityBox, 6); \
 	const int32 octavesCount = (int)GetValue(octavesCountBox, 7)
 #define LOGIC() \
 	Float3 vectorFieldUVW = Float3::Transform(*((Float3*)positionPtr), invFieldTransformMatrix); \
 	Float3 force = Noise::CustomNoise3D(vectorFieldUVW + 0.5f, octavesCount, roughness); \
     force = Float3::Transform(force, fieldTransformMatrix) * intensity; \
     *((Float3*)velocityPtr) += force * (context.DeltaTime / Math::Max(*(float*)massPtr, ZeroTolerance)); \
-    positionPtr += stride; \
-    velocityPtr += stride; \
-    massPtr += stride
+    positionPtr += positionStride; \
+    velocityPtr += velocityStride; \
+    massPtr += massStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -543,7 +553,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Set Attribute");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* dataPtr = start + attribute.Offset;
+        byte* dataPtr = buffer->GetAttributeCPU(attribute, particlesStart);
         int32 dataSize = attribute.GetSize();
         auto box = node->GetBox(0);
         ValueType type(GetVariantType(attribute.ValueType));
@@ -555,7 +565,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 4).Cast(type);
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataSize;
             }
         }
         else
@@ -564,7 +574,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataSize;
             }
         }
         break;
@@ -601,7 +611,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Set");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* dataPtr = start + attribute.Offset;
+        byte* dataPtr = buffer->GetAttributeCPU(attribute, particlesStart);
         int32 dataSize = attribute.GetSize();
         auto box = node->GetBox(0);
         ValueType type(GetVariantType(attribute.ValueType));
@@ -613,7 +623,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 2).Cast(type);
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataSize;
             }
         }
         else
@@ -622,7 +632,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataSize;
             }
         }
         break;
@@ -633,16 +643,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
         auto arcBox = node->GetBox(2);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float arc = (float)GetValue(arcBox, 4) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float arc = GetValue<float>(arcBox, 4) * DegreesToRadians
 #define LOGIC() \
 	float cosPhi = 2.0f * RAND - 1.0f; \
 	float theta = arc * RAND; \
@@ -650,7 +661,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	sincosTheta *= Math::Sqrt(1.0f - cosPhi * cosPhi); \
 	*(Float3*)positionPtr = Float3(sincosTheta, cosPhi) * radius + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -679,17 +690,18 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const Float2 size = (Float2)GetValue(sizeBox, 3);
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const Float2 size = GetValue<Float2>(sizeBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = Float3((RAND - 0.5f) * size.X, 0.0f, (RAND - 0.5f) * size.Y) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -718,22 +730,23 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
         auto arcBox = node->GetBox(2);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float arc = (float)GetValue(arcBox, 4) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float arc = GetValue<float>(arcBox, 4) * DegreesToRadians
 #define LOGIC() \
 	float theta = arc * RAND; \
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta, 0.0f) * radius + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -762,22 +775,23 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
         auto arcBox = node->GetBox(2);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float arc = (float)GetValue(arcBox, 4) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float arc = GetValue<float>(arcBox, 4) * DegreesToRadians
 #define LOGIC() \
 	float theta = arc * RAND; \
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta, 0.0f) * (radius * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -806,14 +820,15 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const Float3 size = (Float3)GetValue(sizeBox, 3);
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const Float3 size = GetValue<Float3>(sizeBox, 3);
 #define LOGIC() \
 	float areaXY = Math::Max(size.X * size.Y, ZeroTolerance); \
 	float areaXZ = Math::Max(size.X * size.Z, ZeroTolerance); \
@@ -828,7 +843,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	else \
 		cube = Float3(cube.Z, cube.X, cube.Y); \
 	*(Float3*)positionPtr = cube * size + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -857,17 +872,18 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const Float3 size = (Float3)GetValue(sizeBox, 3);
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const Float3 size = GetValue<Float3>(sizeBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = size * (RAND3 - 0.5f) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -896,7 +912,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -904,16 +921,16 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto arcBox = node->GetBox(3);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float height = (float)GetValue(heightBox, 4); \
-	const float arc = (float)GetValue(arcBox, 5) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float height = GetValue<float>(heightBox, 4); \
+	const float arc = GetValue<float>(arcBox, 5) * DegreesToRadians
 #define LOGIC() \
 	float theta = arc * RAND; \
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta * radius, height * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -942,17 +959,18 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto startBox = node->GetBox(0);
         auto endBox = node->GetBox(1);
 
 #define INPUTS_FETCH() \
-	const Float3 start = (Float3)GetValue(startBox, 2); \
-	const Float3 end = (Float3)GetValue(endBox, 3);
+	const Float3 start = GetValue<Float3>(startBox, 2); \
+	const Float3 end = GetValue<Float3>(endBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = Math::Lerp(start, end, RAND); \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -981,7 +999,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -989,10 +1008,10 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto arcBox = node->GetBox(3);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = Math::Max((float)GetValue(radiusBox, 3), ZeroTolerance); \
-	const float thickness = (float)GetValue(thicknessBox, 4); \
-	const float arc = (float)GetValue(arcBox, 5) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = Math::Max(GetValue<float>(radiusBox, 3), ZeroTolerance); \
+	const float thickness = GetValue<float>(thicknessBox, 4); \
+	const float arc = GetValue<float>(arcBox, 5) * DegreesToRadians
 #define LOGIC() \
 	Float3 u = RAND3; \
 	float sinTheta, cosTheta; \
@@ -1017,7 +1036,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(phi, c, s); \
 	Float3 t2 = Float3(c * t.X - s * t.Y, c * t.Y + s * t.X, t.Z); \
 	*(Float3*)positionPtr = center + radius * t2; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1046,16 +1065,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
         auto arcBox = node->GetBox(2);
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float arc = (float)GetValue(arcBox, 4) * DegreesToRadians
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float arc = GetValue<float>(arcBox, 4) * DegreesToRadians
 #define LOGIC() \
 	float cosPhi = 2.0f * RAND - 1.0f; \
 	float theta = arc * RAND; \
@@ -1063,7 +1083,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	sincosTheta *= Math::Sqrt(1.0f - cosPhi * cosPhi); \
 	*(Float3*)positionPtr = Float3(sincosTheta, cosPhi) * (radius * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1099,8 +1119,10 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         auto& velocityAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
 
-        byte* positionPtr = start + positionAttr.Offset;
-        byte* velocityPtr = start + velocityAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart);
+        const int32 positionStride = positionAttr.GetSize();
+        byte* velocityPtr = buffer->GetAttributeCPU(velocityAttr, particlesStart);
+        const int32 velocityStride = velocityAttr.GetSize();
 
         auto centerBox = node->GetBox(0);
         auto rotationSpeedBox = node->GetBox(1);
@@ -1109,9 +1131,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& arc = *(float*)&context.Data->CustomData[node->CustomDataOffset];
 
 #define INPUTS_FETCH() \
-	const Float3 center = (Float3)GetValue(centerBox, 2); \
-	const float rotationSpeed = (float)GetValue(rotationSpeedBox, 3); \
-	const float velocityScale = (float)GetValue(velocityScaleBox, 4); \
+	const Float3 center = GetValue<Float3>(centerBox, 2); \
+	const float rotationSpeed = GetValue<float>(rotationSpeedBox, 3); \
+	const float velocityScale = GetValue<float>(velocityScaleBox, 4); \
 	const float arcStep = rotationSpeed / (360.0f * DegreesToRadians)
 #define LOGIC() \
 	Float2 sincosTheta; \
@@ -1119,8 +1141,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	arc += arcStep; \
 	*(Float3*)velocityPtr = Float3(sincosTheta * velocityScale, 0.0f); \
 	*(Float3*)positionPtr = center; \
-	velocityPtr += stride; \
-	positionPtr += stride
+	velocityPtr += velocityStride; \
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1156,9 +1178,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]]; \
 	auto& velocityAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[1]]; \
 	auto& ageAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[2]]; \
-	byte* positionPtr = start + positionAttr.Offset; \
-	byte* velocityPtr = start + velocityAttr.Offset; \
-	byte* agePtr = start + ageAttr.Offset; \
+	byte* positionPtr = buffer->GetAttributeCPU(positionAttr, particlesStart); \
+	const int32 positionStride = positionAttr.GetSize(); \
+	byte* velocityPtr = buffer->GetAttributeCPU(velocityAttr, particlesStart); \
+	const int32 velocityStride = velocityAttr.GetSize(); \
+	byte* agePtr = buffer->GetAttributeCPU(ageAttr, particlesStart); \
+	const int32 ageStride = ageAttr.GetSize(); \
 	auto invert = (bool)node->Values[2]; \
 	auto sign = invert ? -1.0f : 1.0f; \
 	auto radiusBox = node->GetBox(0); \
@@ -1167,11 +1192,11 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	auto frictionBox = node->GetBox(3); \
 	auto lifetimeLossBox = node->GetBox(4)
 #define COLLISION_INPUTS_FETCH() \
-	const float radius = (float)GetValue(radiusBox, 3); \
-	const float roughness = (float)GetValue(roughnessBox, 4); \
-	const float elasticity = (float)GetValue(elasticityBox, 5); \
-	const float friction = (float)GetValue(frictionBox, 6); \
-	const float lifetimeLoss = (float)GetValue(lifetimeLossBox, 7)
+	const float radius = GetValue<float>(radiusBox, 3); \
+	const float roughness = GetValue<float>(roughnessBox, 4); \
+	const float elasticity = GetValue<float>(elasticityBox, 5); \
+	const float friction = GetValue<float>(frictionBox, 6); \
+	const float lifetimeLoss = GetValue<float>(lifetimeLossBox, 7)
 #define COLLISION_LOGIC() \
 		Float3 randomNormal = Float3::Normalize(RAND3 * 2.0f - 1.0f); \
 		randomNormal = (Float3::Dot(randomNormal, n) < 0.0f) ? -randomNormal : randomNormal; \
@@ -1186,9 +1211,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 		*(Float3*)velocityPtr = velocity; \
 		*(float*)agePtr += lifetimeLoss; \
 	} \
-	positionPtr += stride; \
-	velocityPtr += stride; \
-	agePtr += stride
+	positionPtr += positionStride; \
+	velocityPtr += velocityStride; \
+	agePtr += ageStride
 
     // Collision (plane)
     case 330:
@@ -1198,8 +1223,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto planeNormalBox = node->GetBox(6);
 #define INPUTS_FETCH() \
 	COLLISION_INPUTS_FETCH(); \
-	const Float3 planePosition = (Float3)GetValue(planePositionBox, 8); \
-	const Float3 planeNormal = (Float3)GetValue(planeNormalBox, 9) * sign
+	const Float3 planePosition = GetValue<Float3>(planePositionBox, 8); \
+	const Float3 planeNormal = GetValue<Float3>(planeNormalBox, 9) * sign
 #define LOGIC() \
 	Float3 position = *(Float3*)positionPtr; \
 	Float3 velocity = *(Float3*)velocityPtr; \
@@ -1223,8 +1248,18 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         else
         {
             INPUTS_FETCH();
+            const float planeDistance = Float3::Dot(planePosition, planeNormal) + radius;
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
+                // Skip blocks of particles that are far from the plane
+                if (particleIndex + 4 <= particlesEnd && !ParticleKernels::OverlapsPlane4((const Float3*)positionPtr, (const Float3*)velocityPtr, context.DeltaTime, planeNormal, planeDistance))
+                {
+                    positionPtr += positionStride * 4;
+                    velocityPtr += velocityStride * 4;
+                    agePtr += ageStride * 4;
+                    particleIndex += 3;
+                    continue;
+                }
                 LOGIC();
             }
         }
@@ -1240,8 +1275,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto sphereRadiusBox = node->GetBox(6);
 #define INPUTS_FETCH() \
 	COLLISION_INPUTS_FETCH(); \
-	const Float3 spherePosition = (Float3)GetValue(spherePositionBox, 8); \
-	const float sphereRadius = (float)GetValue(sphereRadiusBox, 9)
+	const Float3 spherePosition = GetValue<Float3>(spherePositionBox, 8); \
+	const float sphereRadius = GetValue<float>(sphereRadiusBox, 9)
 #define LOGIC() \
 	Float3 position = *(Float3*)positionPtr; \
 	Float3 velocity = *(Float3*)velocityPtr; \
@@ -1285,8 +1320,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto boxSizeBox = node->GetBox(6);
 #define INPUTS_FETCH() \
 	COLLISION_INPUTS_FETCH(); \
-	const Float3 boxPosition = (Float3)GetValue(boxPositionBox, 8); \
-	const Float3 boxSize = (Float3)GetValue(boxSizeBox, 9)
+	const Float3 boxPosition = GetValue<Float3>(boxPositionBox, 8); \
+	const Float3 boxSize = GetValue<Float3>(boxSizeBox, 9)
 #define LOGIC() \
 	Float3 position = *(Float3*)positionPtr; \
 	Float3 velocity = *(Float3*)velocityPtr; \
@@ -1346,9 +1381,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto cylinderRadiusBox = node->GetBox(7);
 #define INPUTS_FETCH() \
 	COLLISION_INPUTS_FETCH(); \
-	const Float3 cylinderPosition = (Float3)GetValue(cylinderPositionBox, 8); \
-	const float cylinderHeight = (float)GetValue(cylinderHeightBox, 9); \
-	const float cylinderRadius = (float)GetValue(cylinderRadiusBox, 10)
+	const Float3 cylinderPosition = GetValue<Float3>(cylinderPositionBox, 8); \
+	const float cylinderHeight = GetValue<float>(cylinderHeightBox, 9); \
+	const float cylinderRadius = GetValue<float>(cylinderRadiusBox, 10)
 #define LOGIC() \
 	Float3 position = *(Float3*)positionPtr; \
 	Float3 velocity = *(Float3*)velocityPtr; \
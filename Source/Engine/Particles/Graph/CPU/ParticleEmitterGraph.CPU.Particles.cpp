@@ -7,7 +7,7 @@
 #include "Engine/Graphics/RenderTask.h"
 
 #define GET_VIEW() auto mainViewTask = MainRenderTask::Instance && MainRenderTask::Instance->LastUsedFrame != 0 ? MainRenderTask::Instance : nullptr
-#define ACCESS_PARTICLE_ATTRIBUTE(index) (context.Data->Buffer->GetParticleCPU(context.ParticleIndex) + context.Data->Buffer->Layout->Attributes[node->Attributes[index]].Offset)
+#define ACCESS_PARTICLE_ATTRIBUTE(index) (context.Data->Buffer->GetAttributeCPU(context.Data->Buffer->Layout->Attributes[node->Attributes[index]], context.ParticleIndex))
 #define GET_PARTICLE_ATTRIBUTE(index, type) *(type*)ACCESS_PARTICLE_ATTRIBUTE(index)
 
 void ParticleEmitterGraphCPUExecutor::ProcessGroupParameters(Box* box, Node* node, Value& value)
@@ -187,7 +187,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupTools(Box* box, Node* node, Va
     {
         GET_VIEW();
         const Matrix viewProjection = context.ViewTask ? context.ViewTask->View.PrevViewProjection : Matrix::Identity;
-        const Float3 position = (Float3)TryGetValue(node->GetBox(0), Value::Zero);
+        const Float3 position = TryGetValue<Float3>(node->GetBox(0), Value::Zero);
         Float4 projPos;
         Float3::Transform(position, viewProjection);
         projPos /= projPos.W;
@@ -238,7 +238,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
     case 303:
     {
         const auto particleIndex = tryGetValue(node->GetBox(1), context.ParticleIndex);
-        byte* ptr = (context.Data->Buffer->GetParticleCPU((uint32)particleIndex) + context.Data->Buffer->Layout->Attributes[node->Attributes[0]].Offset);
+        byte* ptr = context.Data->Buffer->GetAttributeCPU(context.Data->Buffer->Layout->Attributes[node->Attributes[0]], (int32)particleIndex);
         switch ((ParticleAttribute::ValueTypes)node->Attributes[1])
         {
         case ParticleAttribute::ValueTypes::Float:
@@ -1,12 +1,14 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "ParticleEmitterGraph.CPU.h"
+#include "ParticleEmitterGraph.CPU.Kernels.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Particles/ParticleEffect.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 
 ThreadLocal<ParticleEmitterGraphCPUContext> ParticleEmitterGraphCPUExecutor::Context;
 
@@ -16,6 +18,27 @@ namespace
     {
         return data->Get(a) < data->Get(b);
     }
+
+    // Shared state of the emitter update split into particle ranges (executed by the calling thread and the helper jobs)
+    struct ParticlesUpdateJob
+    {
+        int64 RefCount;
+        int64 NextRange;
+        int64 RangesDone;
+        int32 RangesCount;
+        int32 ParticlesCount;
+        float DeltaTime;
+        ParticleEmitter* Emitter;
+        ParticleEffect* Effect;
+        ParticleEmitterInstance* Data;
+        Array<Array<int32>> KilledParticles;
+
+        void Release()
+        {
+            if (Platform::InterlockedDecrement(&RefCount) == 0)
+                Delete(this);
+        }
+    };
 }
 
 void ParticleEmitterGraphCPU::CreateDefault()
@@ -146,18 +169,15 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
         _graph._attrPosition != -1)
     {
         const int32 count = data.Buffer->CPU.Count;
-        byte* bufferPtr = data.Buffer->CPU.Buffer.Get();
         auto layout = data.Buffer->Layout;
-        const int32 stride = data.Buffer->Stride;
 
         // Build sphere bounds out of all living particles positions
-        byte* positionPtr = bufferPtr + layout->Attributes[_graph._attrPosition].Offset;
+        const Float3* positionPtr = (const Float3*)data.Buffer->GetAttributeStreamCPU(layout->Attributes[_graph._attrPosition].Offset);
 #if 0
-        BoundingSphere sphere(*((Float3*)positionPtr), 0.0f);
+        BoundingSphere sphere(positionPtr[0], 0.0f);
         for (int32 particleIndex = 0; particleIndex < count; particleIndex++)
         {
-            BoundingSphere::Merge(sphere, *((Float3*)positionPtr), &sphere);
-            positionPtr += stride;
+            BoundingSphere::Merge(sphere, positionPtr[particleIndex], &sphere);
         }
 #endif
 #if 0
@@ -167,19 +187,16 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
             Vector3 center = Vector3::Zero;
             for (int32 i = 0; i < count; i++)
             {
-                Vector3::Add(*((Float3*)positionPtr), center, &center);
-                positionPtr += stride;
+                Vector3::Add(positionPtr[i], center, &center);
             }
             center /= static_cast<float>(count);
 
             // Find the radius of the sphere
             float radius = 0.0f;
-            positionPtr = bufferPtr + layout->Attributes[_attrPosition].Offset;
             for (int32 i = 0; i < count; i++)
             {
                 // We are doing a relative distance comparison to find the maximum distance from the center of our sphere
-                const float distance = Float3::DistanceSquared(center, *(Float3*)positionPtr);
-                positionPtr += stride;
+                const float distance = Float3::DistanceSquared(center, positionPtr[i]);
 
                 if (distance > radius)
                     radius = distance;
@@ -197,7 +214,7 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
             BoundingBox box = BoundingBox::Empty;
             for (int32 particleIndex = 0; particleIndex < count; particleIndex++)
             {
-                Float3 position = *(Float3*)positionPtr;
+                Float3 position = positionPtr[particleIndex];
 #if ENABLE_ASSERTION
                 if (!position.IsNanOrInfinity())
 #endif
@@ -205,7 +222,6 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                     Vector3::Min(box.Minimum, position, box.Minimum);
                     Vector3::Max(box.Maximum, position, box.Maximum);
                 }
-                positionPtr += stride;
             }
             BoundingSphere::FromBox(box, sphere);
 #if ENABLE_ASSERTION
@@ -233,11 +249,10 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum local bounds of the particle sprite
                     Vector2 maxSpriteSize = Vector2::Zero;
-                    byte* spriteSize = bufferPtr + layout->Attributes[_graph._attrSpriteSize].Offset;
+                    const Float2* spriteSize = (const Float2*)data.Buffer->GetAttributeStreamCPU(layout->Attributes[_graph._attrSpriteSize].Offset);
                     for (int32 i = 0; i < count; i++)
                     {
-                        Vector2::Max(*((Vector2*)spriteSize), maxSpriteSize, maxSpriteSize);
-                        spriteSize += stride;
+                        Vector2::Max(spriteSize[i], maxSpriteSize, maxSpriteSize);
                     }
                     ASSERT(!maxSpriteSize.IsNanOrInfinity());
 
@@ -258,7 +273,7 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 for (int32 particleIndex = 0; particleIndex < count; particleIndex++)
                 {
                     context.ParticleIndex = particleIndex;
-                    const float radius = (float)GetValue(module->GetBox(1), 3);
+                    const float radius = GetValue<float>(module->GetBox(1), 3);
                     if (radius > maxRadius)
                         maxRadius = radius;
                 }
@@ -282,11 +297,10 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum local bounds of the particle model
                     Float3 maxScale = Float3::Zero;
-                    byte* scale = bufferPtr + layout->Attributes[_graph._attrScale].Offset;
+                    const Float3* scale = (const Float3*)data.Buffer->GetAttributeStreamCPU(layout->Attributes[_graph._attrScale].Offset);
                     for (int32 i = 0; i < count; i++)
                     {
-                        Float3::Max(*((Float3*)scale), maxScale, maxScale);
-                        scale += stride;
+                        Float3::Max(scale[i], maxScale, maxScale);
                     }
 
                     // Enlarge the emitter bounds sphere
@@ -304,11 +318,10 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum ribbon width of the particle
                     float maxRibbonWidth = 0.0f;
-                    byte* ribbonWidth = bufferPtr + layout->Attributes[_graph._attrRibbonWidth].Offset;
+                    const float* ribbonWidth = (const float*)data.Buffer->GetAttributeStreamCPU(layout->Attributes[_graph._attrRibbonWidth].Offset);
                     for (int32 i = 0; i < count; i++)
                     {
-                        maxRibbonWidth = Math::Max(*((float*)ribbonWidth), maxRibbonWidth);
-                        ribbonWidth += stride;
+                        maxRibbonWidth = Math::Max(ribbonWidth[i], maxRibbonWidth);
                     }
                     ASSERT(!isnan(maxRibbonWidth) && !isinf(maxRibbonWidth));
 
@@ -324,11 +337,10 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 float maxRadius = 0.0f;
                 if (_graph._attrRadius != -1)
                 {
-                    byte* radius = bufferPtr + layout->Attributes[_graph._attrRadius].Offset;
+                    const float* radius = (const float*)data.Buffer->GetAttributeStreamCPU(layout->Attributes[_graph._attrRadius].Offset);
                     for (int32 i = 0; i < count; i++)
                     {
-                        maxRadius = Math::Max(*((float*)radius), maxRadius);
-                        radius += stride;
+                        maxRadius = Math::Max(radius[i], maxRadius);
                     }
                     ASSERT(!isnan(maxRadius) && !isinf(maxRadius));
                 }
@@ -369,9 +381,8 @@ void ParticleEmitterGraphCPUExecutor::Draw(ParticleEmitter* emitter, ParticleEff
 
     // Prepare particles buffer access
     auto buffer = data.Buffer;
-    byte* positionPtr = buffer->CPU.Buffer.Get() + buffer->Layout->Attributes[_graph._attrPosition].Offset;
+    const Float3* positionPtr = (const Float3*)buffer->GetAttributeStreamCPU(buffer->Layout->Attributes[_graph._attrPosition].Offset);
     const int32 count = buffer->CPU.Count;
-    const int32 stride = buffer->Stride;
 
     // Prepare graph data
     Init(emitter, effect, data);
@@ -397,6 +408,8 @@ void ParticleEmitterGraphCPUExecutor::Draw(ParticleEmitter* emitter, ParticleEff
         lightData.CastVolumetricShadow = false;
         lightData.RenderedVolumetricFog = 0;
         lightData.ShadowsMode = ShadowsCastingMode::None;
+        lightData.ShadowsUpdateRate = 1.0f;
+        lightData.ShadowsUpdateRateAtDistance = 1.0f;
         lightData.SourceRadius = 0.0f;
         lightData.SourceLength = 0.0f;
         lightData.IESTexture = nullptr;
@@ -406,18 +419,16 @@ void ParticleEmitterGraphCPUExecutor::Draw(ParticleEmitter* emitter, ParticleEff
             context.ParticleIndex = particleIndex;
 
             const Vector4 color = (Vector4)GetValue(module->GetBox(0), 2);
-            const float radius = (float)GetValue(module->GetBox(1), 3);
-            const float fallOffExponent = (float)GetValue(module->GetBox(2), 4);
+            const float radius = GetValue<float>(module->GetBox(1), 3);
+            const float fallOffExponent = GetValue<float>(module->GetBox(2), 4);
 
             lightData.Color = Float3(color) * color.W;
             lightData.Radius = radius;
             lightData.FallOffExponent = fallOffExponent;
 
-            Float3::Transform(*(Float3*)positionPtr, transform, lightData.Position);
+            Float3::Transform(positionPtr[particleIndex], transform, lightData.Position);
 
             renderContext.List->PointLights.Add(lightData);
-
-            positionPtr += stride;
         }
     }
 }
@@ -430,7 +441,12 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     auto& cpu = data.Buffer->CPU;
 
     // Update particles
-    if (cpu.Count > 0)
+    if (cpu.Count >= PARTICLE_EMITTER_PARALLEL_UPDATE_MIN_PARTICLES && _graph.UpdateModules.HasItems() && JobSystem::GetThreadsCount() > 1)
+    {
+        PROFILE_CPU_NAMED("Update");
+        UpdateParallel(emitter, effect, data, dt);
+    }
+    else if (cpu.Count > 0)
     {
         PROFILE_CPU_NAMED("Update");
         for (int32 i = 0; i < _graph.UpdateModules.Count(); i++)
@@ -443,21 +459,16 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (_graph._attrAge != -1 && _graph._attrLifetime != -1)
     {
         PROFILE_CPU_NAMED("Age kill");
-        byte* agePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAge].Offset;
-        byte* lifetimePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrLifetime].Offset;
+        const float* agePtr = (const float*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrAge].Offset);
+        const float* lifetimePtr = (const float*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrLifetime].Offset);
         for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
         {
-            if (*(float*)agePtr >= *(float*)lifetimePtr)
+            if (agePtr[particleIndex] >= lifetimePtr[particleIndex])
             {
                 cpu.Count--;
-                Platform::MemoryCopy(data.Buffer->GetParticleCPU(particleIndex), data.Buffer->GetParticleCPU(cpu.Count), data.Buffer->Stride);
+                data.Buffer->CopyParticleCPU(particleIndex, cpu.Count);
                 particleIndex--;
             }
-            else
-            {
-                agePtr += data.Buffer->Stride;
-                lifetimePtr += data.Buffer->Stride;
-            }
         }
     }
 
@@ -465,12 +476,10 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     // Debug validation for NANs in data
     if (_graph._attrPosition != -1)
     {
-        byte* positionPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrPosition].Offset;
+        const Float3* positionPtr = (const Float3*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrPosition].Offset);
         for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
         {
-            Float3 pos = *((Float3*)positionPtr);
-            ASSERT(!pos.IsNanOrInfinity());
-            positionPtr += data.Buffer->Stride;
+            ASSERT(!positionPtr[particleIndex].IsNanOrInfinity());
         }
     }
 #endif
@@ -479,28 +488,18 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (_graph._attrPosition != -1 && _graph._attrVelocity != -1)
     {
         PROFILE_CPU_NAMED("Euler Integration");
-        byte* positionPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrPosition].Offset;
-        byte* velocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
-        {
-            *((Float3*)positionPtr) += *((Float3*)velocityPtr) * dt;
-            positionPtr += data.Buffer->Stride;
-            velocityPtr += data.Buffer->Stride;
-        }
+        Float3* positionPtr = (Float3*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrPosition].Offset);
+        const Float3* velocityPtr = (const Float3*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrVelocity].Offset);
+        ParticleKernels::MultiplyAdd(positionPtr, velocityPtr, dt, cpu.Count);
     }
 
     // Angular Euler Integration
     if (_graph._attrRotation != -1 && _graph._attrAngularVelocity != -1)
     {
         PROFILE_CPU_NAMED("Angular Euler Integration");
-        byte* rotationPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrRotation].Offset;
-        byte* angularVelocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAngularVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
-        {
-            *((Float3*)rotationPtr) += *((Float3*)angularVelocityPtr) * dt;
-            rotationPtr += data.Buffer->Stride;
-            angularVelocityPtr += data.Buffer->Stride;
-        }
+        Float3* rotationPtr = (Float3*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrRotation].Offset);
+        const Float3* angularVelocityPtr = (const Float3*)data.Buffer->GetAttributeStreamCPU(data.Buffer->Layout->Attributes[_graph._attrAngularVelocity].Offset);
+        ParticleKernels::MultiplyAdd(rotationPtr, angularVelocityPtr, dt, cpu.Count);
     }
 
     // Spawn particles
@@ -524,9 +523,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
             data.Buffer->CPU.Count = countAfter;
 
             // Initialize particles data
-            //Platform::MemoryClear(data.Buffer->GetParticleCPU(countBefore), spawnCount * data.Buffer->Stride);
-            for (int32 i = 0; i < spawnCount; i++)
-                Platform::MemoryCopy(data.Buffer->GetParticleCPU(countBefore + i), _graph._defaultParticleData.Get(), data.Buffer->Stride);
+            data.Buffer->SetParticlesCPU(countBefore, spawnCount, _graph._defaultParticleData.Get());
 
             // Initialize particles
             for (int32 i = 0; i < _graph.InitModules.Count(); i++)
@@ -564,6 +561,78 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     }
 }
 
+void ParticleEmitterGraphCPUExecutor::UpdateParallel(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt)
+{
+    auto& cpu = data.Buffer->CPU;
+    auto job = New<ParticlesUpdateJob>();
+    job->NextRange = 0;
+    job->RangesDone = 0;
+    job->ParticlesCount = cpu.Count;
+    job->RangesCount = (cpu.Count + PARTICLE_EMITTER_PARALLEL_UPDATE_RANGE - 1) / PARTICLE_EMITTER_PARALLEL_UPDATE_RANGE;
+    job->DeltaTime = dt;
+    job->Emitter = emitter;
+    job->Effect = effect;
+    job->Data = &data;
+    job->KilledParticles.Resize(job->RangesCount);
+    const int32 helpersCount = Math::Min(job->RangesCount, JobSystem::GetThreadsCount()) - 1;
+    job->RefCount = helpersCount + 1;
+
+    // Update particle ranges on this thread and in the helper jobs (ranges are claimed by any thread that is free so it never waits for the job to start)
+    const auto processRanges = [this](ParticlesUpdateJob* job)
+    {
+        auto& context = Context.Get();
+        bool initialized = false;
+        int64 range;
+        while ((range = Platform::InterlockedIncrement(&job->NextRange) - 1) < job->RangesCount)
+        {
+            if (!initialized)
+            {
+                initialized = true;
+                Init(job->Emitter, job->Effect, *job->Data, job->DeltaTime);
+            }
+            const int32 particlesStart = (int32)range * PARTICLE_EMITTER_PARALLEL_UPDATE_RANGE;
+            const int32 particlesEnd = Math::Min(particlesStart + PARTICLE_EMITTER_PARALLEL_UPDATE_RANGE, job->ParticlesCount);
+            context.KilledParticles = &job->KilledParticles[(int32)range];
+            for (int32 i = 0; i < _graph.UpdateModules.Count(); i++)
+            {
+                ProcessModule(_graph.UpdateModules[i], particlesStart, particlesEnd);
+            }
+            Platform::InterlockedIncrement(&job->RangesDone);
+        }
+        context.KilledParticles = nullptr;
+    };
+    if (helpersCount > 0)
+    {
+        JobSystem::Dispatch([processRanges, job](int32)
+        {
+            processRanges(job);
+            job->Release();
+        }, helpersCount);
+    }
+    processRanges(job);
+    while (Platform::AtomicRead(&job->RangesDone) < job->RangesCount)
+        Platform::Sleep(0);
+
+    // Remove killed particles (from the last one to keep the order deterministic, particle might be killed by multiple modules)
+    for (int32 range = job->RangesCount - 1; range >= 0; range--)
+    {
+        auto& killed = job->KilledParticles[range];
+        Sorting::QuickSort(killed.Get(), killed.Count());
+        for (int32 i = killed.Count() - 1; i >= 0; i--)
+        {
+            const int32 particleIndex = killed[i];
+            if (i + 1 < killed.Count() && killed[i + 1] == particleIndex)
+                continue;
+            cpu.Count--;
+            data.Buffer->CopyParticleCPU(particleIndex, cpu.Count);
+        }
+    }
+    job->Release();
+
+    // Restore the context state for this thread
+    Init(emitter, effect, data, dt);
+}
+
 int32 ParticleEmitterGraphCPUExecutor::UpdateSpawn(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt)
 {
     PROFILE_CPU_NAMED("Spawn");
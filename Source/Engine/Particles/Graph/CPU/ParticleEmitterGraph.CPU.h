@@ -30,6 +30,12 @@ class ParticleEmitterGraphCPUExecutor;
 
 #define PARTICLE_EMITTER_MAX_CALL_STACK 100
 
+// The minimum amount of CPU particles to split the emitter update into multiple jobs (particle ranges updated in parallel)
+#define PARTICLE_EMITTER_PARALLEL_UPDATE_MIN_PARTICLES 8192
+
+// The amount of CPU particles updated by a single job when updating the emitter in parallel
+#define PARTICLE_EMITTER_PARALLEL_UPDATE_RANGE 2048
+
 class ParticleEmitterGraphCPUBox : public VisjectGraphBox
 {
 };
@@ -121,6 +127,8 @@ struct ParticleEmitterGraphCPUContext
     Dictionary<VisjectExecutor::Node*, ParticleEmitterGraphCPU*> Functions;
     int32 CallStackSize = 0;
     VisjectExecutor::Node* CallStack[PARTICLE_EMITTER_MAX_CALL_STACK];
+    // The output list for particles killed by the modules. Used when updating particle ranges in parallel to defer the buffer compaction (otherwise particles are removed in-place).
+    Array<int32>* KilledParticles = nullptr;
 };
 
 /// <summary>
@@ -194,6 +202,7 @@ class ParticleEmitterGraphCPUExecutor : public VisjectExecutor
 
     int32 ProcessSpawnModule(int32 index);
     void ProcessModule(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd);
+    void UpdateParallel(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt);
 
     FORCE_INLINE Value GetValue(Box* box, int32 defaultValueBoxIndex)
     {
@@ -207,4 +216,19 @@ class ParticleEmitterGraphCPUExecutor : public VisjectExecutor
     {
         return box && box->HasConnection() ? eatBox(box->GetParent<Node>(), box->FirstConnection()) : defaultValue;
     }
+
+    template<typename T>
+    FORCE_INLINE T GetValue(Box* box, int32 defaultValueBoxIndex)
+    {
+        const auto parentNode = box->GetParent<Node>();
+        if (box->HasConnection())
+            return getTypedValue<T>(parentNode, box->FirstConnection());
+        return (T)parentNode->Values[defaultValueBoxIndex];
+    }
+
+    template<typename T>
+    FORCE_INLINE T TryGetValue(Box* box, const Value& defaultValue)
+    {
+        return box && box->HasConnection() ? getTypedValue<T>(box->GetParent<Node>(), box->FirstConnection()) : (T)defaultValue;
+    }
 };
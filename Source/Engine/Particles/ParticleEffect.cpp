@@ -12,7 +12,9 @@
 ParticleEffect::ParticleEffect(const SpawnParams& params)
     : Actor(params)
     , _lastUpdateFrame(0)
+    , _lastDrawFrame(0)
     , _lastMinDstSqr(MAX_Real)
+    , _isOffscreen(false)
 {
     _box = BoundingBox(_transform.Translation);
     BoundingSphere::FromBox(_box, _sphere);
@@ -395,9 +397,32 @@ void ParticleEffect::SetParametersOverrides(const Array<ParameterOverride>& valu
 
 void ParticleEffect::Update()
 {
-    // Skip if off-screen
-    if (!UpdateWhenOffscreen && _lastMinDstSqr >= MAX_Real)
-        return;
+    // Check if effect was not rendered for a few frames
+    const bool isOffscreen = Engine::FrameCount - _lastDrawFrame > (uint64)Math::Max(OffscreenFrames, 1);
+    if (isOffscreen)
+    {
+        // Skip or throttle updates if off-screen
+        _isOffscreen = true;
+        if (!UpdateWhenOffscreen)
+            return;
+        if (OffscreenUpdateInterval > 0.0f && Instance.LastUpdateTime >= 0)
+        {
+            const float time = (UseTimeScale ? Time::Update.Time : Time::Update.UnscaledTime).GetTotalSeconds();
+            if (time - Instance.LastUpdateTime < OffscreenUpdateInterval)
+                return;
+        }
+    }
+    else if (_isOffscreen)
+    {
+        // Fast-forward the time skipped while off-screen (limited) in smaller steps
+        _isOffscreen = false;
+        if (Instance.LastUpdateTime >= 0)
+        {
+            const float time = (UseTimeScale ? Time::Update.Time : Time::Update.UnscaledTime).GetTotalSeconds();
+            Instance.LastUpdateTime = Math::Max(Instance.LastUpdateTime, time - OffscreenCatchUpTime);
+            Instance.UseSubSteps = true;
+        }
+    }
 
     if (UpdateMode == SimulationUpdateMode::FixedTimestep)
     {
@@ -499,6 +524,7 @@ void ParticleEffect::Draw(RenderContext& renderContext)
     if (renderContext.View.Pass == DrawPass::GlobalSDF || renderContext.View.Pass == DrawPass::GlobalSurfaceAtlas)
         return;
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(GetPosition(), renderContext.View.Position));
+    _lastDrawFrame = Engine::FrameCount;
     Particles::DrawParticles(renderContext, this);
 }
 
@@ -577,6 +603,9 @@ void ParticleEffect::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(UseTimeScale);
     SERIALIZE(IsLooping);
     SERIALIZE(UpdateWhenOffscreen);
+    SERIALIZE(OffscreenFrames);
+    SERIALIZE(OffscreenUpdateInterval);
+    SERIALIZE(OffscreenCatchUpTime);
     SERIALIZE(DrawModes);
     SERIALIZE(SortOrder);
 }
@@ -676,6 +705,9 @@ void ParticleEffect::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(UseTimeScale);
     DESERIALIZE(IsLooping);
     DESERIALIZE(UpdateWhenOffscreen);
+    DESERIALIZE(OffscreenFrames);
+    DESERIALIZE(OffscreenUpdateInterval);
+    DESERIALIZE(OffscreenCatchUpTime);
     DESERIALIZE(DrawModes);
     DESERIALIZE(SortOrder);
 
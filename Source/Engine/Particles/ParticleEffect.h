@@ -179,7 +179,9 @@ class FLAXENGINE_API ParticleEffect : public Actor
 
 private:
     uint64 _lastUpdateFrame;
+    uint64 _lastDrawFrame;
     Real _lastMinDstSqr;
+    bool _isOffscreen;
     int32 _sceneRenderingKey = -1;
     uint32 _parametersVersion = 0; // Version number for _parameters to be in sync with Instance.ParametersVersion
     Array<ParticleEffectParameter> _parameters; // Cached for scripting API
@@ -240,6 +242,24 @@ class FLAXENGINE_API ParticleEffect : public Actor
     API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(true), EditorOrder(60)")
     bool UpdateWhenOffscreen = true;
 
+    /// <summary>
+    /// The amount of frames the effect has to be not rendered to be considered as off-screen.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(1), Limit(1), EditorOrder(61)")
+    int32 OffscreenFrames = 1;
+
+    /// <summary>
+    /// The minimum time (in seconds) between the simulation updates of the off-screen effect. Can be used to reduce the cost of ambient effects that are not visible by running them at a lower tick rate. Use 0 to update every frame. Used only if UpdateWhenOffscreen is enabled.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(0.0f), Limit(0), EditorOrder(62), VisibleIf(nameof(UpdateWhenOffscreen))")
+    float OffscreenUpdateInterval = 0.0f;
+
+    /// <summary>
+    /// The maximum time (in seconds) to fast-forward when the effect becomes visible again after being off-screen. The skipped time is simulated in a few smaller steps to keep the effect visually correct. Time skipped above that limit is dropped (the effect continues from the last simulated state). Use 0 to disable catch-up.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(1.0f), Limit(0), EditorOrder(63)")
+    float OffscreenCatchUpTime = 1.0f;
+
     /// <summary>
     /// The draw passes to use for rendering this object.
     /// </summary>
@@ -15,6 +15,7 @@
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Threading/TaskGraph.h"
@@ -28,6 +29,12 @@
 #include "Editor/Editor.h"
 #endif
 
+// The maximum delta time of the single simulation step when splitting longer updates into sub-steps (eg. when effect becomes visible after being off-screen).
+#define PARTICLES_SUB_STEP_TIME (1.0f / 30.0f)
+
+// The maximum amount of simulation sub-steps per update.
+#define PARTICLES_MAX_SUB_STEPS 30
+
 PACK_STRUCT(struct SpriteParticleVertex
     {
     float X;
@@ -51,6 +58,8 @@ class SpriteParticleRenderer
             return false;
         VB = GPUDevice::Instance->CreateBuffer(TEXT("SpriteParticleRenderer,VB"));
         IB = GPUDevice::Instance->CreateBuffer(TEXT("SpriteParticleRenderer.IB"));
+        VB->SetCategory(GPUResourceCategory::Particles);
+        IB->SetCategory(GPUResourceCategory::Particles);
         static SpriteParticleVertex vertexBuffer[] =
         {
             { -0.5f, -0.5f, 0.0f, 0.0f },
@@ -100,6 +109,9 @@ namespace ParticleManagerImpl
 {
     CriticalSection PoolLocker;
     Dictionary<ParticleEmitter*, Array<EmitterCache>> Pool;
+    Dictionary<ParticleEmitter*, int32> PoolReserve;
+    int32 PoolHits = 0;
+    int32 PoolMisses = 0;
     Array<ParticleEffect*> UpdateList;
 #if COMPILE_WITH_GPU_PARTICLES
     CriticalSection GpuUpdateListLocker;
@@ -121,6 +133,7 @@ namespace ParticlesDrawCPU
     Array<uint32> SortingKeys[2];
     Array<int32> SortingIndices;
     Array<int32> SortedIndices;
+    Array<byte> ParticlesData;
 }
 
 class ParticleManagerService : public EngineService
@@ -129,6 +142,7 @@ class ParticleManagerService : public EngineService
     ParticleManagerService()
         : EngineService(TEXT("Particle Manager"), 65)
     {
+        RenderOnly = true;
     }
 
     bool Init() override;
@@ -182,7 +196,6 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             auto module = emitter->Graph.SortModules[moduleIndex];
             const int32 sortedIndicesOffset = module->SortedIndicesOffset;
             const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
-            const int32 stride = buffer->Stride;
             const int32 listSize = buffer->CPU.Count;
 #define PREPARE_CACHE(list) (ParticlesDrawCPU::list).Clear(); (ParticlesDrawCPU::list).Resize(listSize)
             PREPARE_CACHE(SortingKeys[0]);
@@ -196,22 +209,20 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             case ParticleSortMode::ViewDepth:
             {
                 const Matrix viewProjection = renderContext.View.ViewProjection();
-                byte* positionPtr = buffer->CPU.Buffer.Get() + emitter->Graph.GetPositionAttributeOffset();
+                const Float3* positionPtr = (const Float3*)buffer->GetAttributeStreamCPU(emitter->Graph.GetPositionAttributeOffset());
                 if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
                 {
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, Matrix::TransformPosition(drawCall.World, *(Float3*)positionPtr)).W) ^ sortKeyXor;
-                        positionPtr += stride;
+                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, Matrix::TransformPosition(drawCall.World, positionPtr[i])).W) ^ sortKeyXor;
                     }
                 }
                 else
                 {
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, *(Float3*)positionPtr).W) ^ sortKeyXor;
-                        positionPtr += stride;
+                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, positionPtr[i]).W) ^ sortKeyXor;
                     }
                 }
                 break;
@@ -219,14 +230,13 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             case ParticleSortMode::ViewDistance:
             {
                 const Float3 viewPosition = renderContext.View.Position;
-                byte* positionPtr = buffer->CPU.Buffer.Get() + emitter->Graph.GetPositionAttributeOffset();
+                const Float3* positionPtr = (const Float3*)buffer->GetAttributeStreamCPU(emitter->Graph.GetPositionAttributeOffset());
                 if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
                 {
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - Float3::Transform(*(Float3*)positionPtr, drawCall.World)).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
+                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - Float3::Transform(positionPtr[i], drawCall.World)).LengthSquared()) ^ sortKeyXor;
                     }
                 }
                 else
@@ -234,8 +244,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - *(Float3*)positionPtr).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
+                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - positionPtr[i]).LengthSquared()) ^ sortKeyXor;
                     }
                 }
                 break;
@@ -246,11 +255,10 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
                 int32 attributeIdx = module->Attributes[0];
                 if (attributeIdx == -1)
                     break;
-                byte* attributePtr = buffer->CPU.Buffer.Get() + emitter->Graph.Layout.Attributes[attributeIdx].Offset;
+                const float* attributePtr = (const float*)buffer->GetAttributeStreamCPU(emitter->Graph.Layout.Attributes[attributeIdx].Offset);
                 for (int32 i = 0; i < buffer->CPU.Count; i++)
                 {
-                    sortedKeys[i] = RenderTools::ComputeDistanceSortKey(*(float*)attributePtr) ^ sortKeyXor;
-                    attributePtr += stride;
+                    sortedKeys[i] = RenderTools::ComputeDistanceSortKey(attributePtr[i]) ^ sortKeyXor;
                 }
                 break;
             }
@@ -271,7 +279,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
 
             // Sort keys with indices
             {
-                Sorting::RadixSort(sortedKeys, sortedIndices, ParticlesDrawCPU::SortingKeys[1].Get(), ParticlesDrawCPU::SortingIndices.Get(), listSize);
+                Sorting::RadixSortParallel(sortedKeys, sortedIndices, ParticlesDrawCPU::SortingKeys[1].Get(), ParticlesDrawCPU::SortingIndices.Get(), listSize);
             }
 
             // Upload CPU particles indices
@@ -281,9 +289,12 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         }
     }
 
-    // Upload CPU particles data to GPU
+    // Upload CPU particles data to GPU (convert attribute streams into the interleaved layout used by shaders)
     {
-        context->UpdateBuffer(buffer->GPU.Buffer, buffer->CPU.Buffer.Get(), buffer->CPU.Count * buffer->Stride);
+        const int32 size = buffer->CPU.Count * buffer->Stride;
+        ParticlesDrawCPU::ParticlesData.Resize(size, false);
+        buffer->GetParticlesCPU(ParticlesDrawCPU::ParticlesData.Get(), buffer->CPU.Count);
+        context->UpdateBuffer(buffer->GPU.Buffer, ParticlesDrawCPU::ParticlesData.Get(), size);
     }
 
     // Check if need to setup ribbon modules
@@ -577,17 +588,22 @@ PACK_STRUCT(struct GPUParticlesSortingData {
     uint32 PositionOffset;
     uint32 CustomOffset;
     Matrix PositionTransform;
+    uint32 DrawArgsCount;
+    uint32 DispatchArgsOffset;
+    Float2 Dummy0;
     });
 
 AssetReference<Shader> GPUParticlesSorting;
 GPUConstantBuffer* GPUParticlesSortingCB;
 GPUShaderProgramCS* GPUParticlesSortingCS[3];
+GPUShaderProgramCS* GPUParticlesIndirectArgsCS;
 
 #if COMPILE_WITH_DEV_ENV
 
 void OnShaderReloading(Asset* obj)
 {
     GPUParticlesSortingCB = nullptr;
+    GPUParticlesIndirectArgsCS = nullptr;
     Platform::MemoryClear(GPUParticlesSortingCS, sizeof(GPUParticlesSortingCS));
 }
 
@@ -598,37 +614,131 @@ void CleanupGPUParticlesSorting()
     GPUParticlesSorting = nullptr;
 }
 
+bool InitGPUParticlesSorting()
+{
+    if (GPUParticlesSorting == nullptr)
+    {
+        // TODO: preload shader if platform supports GPU particles
+        GPUParticlesSorting = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/GPUParticlesSorting"));
+        if (GPUParticlesSorting == nullptr || GPUParticlesSorting->WaitForLoaded())
+            return true;
+#if COMPILE_WITH_DEV_ENV
+        GPUParticlesSorting.Get()->OnReloading.Bind<OnShaderReloading>();
+#endif
+    }
+    if (!GPUParticlesSortingCB)
+    {
+        const auto shader = GPUParticlesSorting->GetShader();
+        const StringAnsiView CS_Sort("CS_Sort");
+        GPUParticlesSortingCS[0] = shader->GetCS(CS_Sort, 0);
+        GPUParticlesSortingCS[1] = shader->GetCS(CS_Sort, 1);
+        GPUParticlesSortingCS[2] = shader->GetCS(CS_Sort, 2);
+        GPUParticlesIndirectArgsCS = shader->GetCS("CS_IndirectArgs");
+        GPUParticlesSortingCB = shader->GetCB(0);
+        ASSERT(GPUParticlesSortingCB);
+    }
+    return false;
+}
+
 void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCall& drawCall, DrawPass drawModes, StaticFlags staticFlags, ParticleEmitterInstance& emitterData, const RenderModulesIndices& renderModulesIndices, int16 sortOrder)
 {
     const auto context = GPUDevice::Instance->GetMainContext();
     auto emitter = buffer->Emitter;
 
-    // Check if need to perform any particles sorting
-    if (emitter->Graph.SortModules.HasItems() && renderContext.View.Pass != DrawPass::Depth)
+    // Skip emitters that were not simulated yet or got cleared (particles counter in the buffer is not valid)
+    if (!buffer->GPU.HasValidCount || buffer->GPU.ParticlesCountMax == 0)
+        return;
+
+    // Collect indirect draw arguments for all draw calls to perform during this emitter rendering
+    Array<GPUDrawIndexedIndirectArgs, InlinedAllocation<8>> indirectArgs;
+    for (int32 index = 0; index < renderModulesIndices.Count(); index++)
     {
-        PROFILE_GPU_CPU_NAMED("Sort Particles");
+        int32 moduleIndex = renderModulesIndices[index];
+        auto module = emitter->Graph.RenderModules[moduleIndex];
+        switch (module->TypeID)
+        {
+        // Sprite Rendering
+        case 400:
+        {
+            indirectArgs.Add({ SpriteParticleRenderer::IndexCount, 0, 0, 0, 0 });
+            break;
+        }
+        // Model Rendering
+        case 403:
+        {
+            const auto model = (Model*)module->Assets[0].Get();
 
-        // Prepare pipeline
-        if (GPUParticlesSorting == nullptr)
+            // TODO: model LOD picking for particles?
+            int32 lodIndex = 0;
+            ModelLOD& lod = model->LODs[lodIndex];
+            for (int32 meshIndex = 0; meshIndex < lod.Meshes.Count(); meshIndex++)
+            {
+                Mesh& mesh = lod.Meshes[meshIndex];
+                if (!mesh.IsInitialized())
+                    continue;
+
+                indirectArgs.Add({ (uint32)mesh.GetTriangleCount() * 3, 0, 0, 0, 0 });
+            }
+
+            break;
+        }
+        // Ribbon Rendering
+        case 404:
         {
-            // TODO: preload shader if platform supports GPU particles
-            GPUParticlesSorting = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/GPUParticlesSorting"));
-            if (GPUParticlesSorting == nullptr || GPUParticlesSorting->WaitForLoaded())
-                return;
-#if COMPILE_WITH_DEV_ENV
-            GPUParticlesSorting.Get()->OnReloading.Bind<OnShaderReloading>();
-#endif
+            // Not supported
+            break;
         }
-        if (!GPUParticlesSortingCB)
+        // Volumetric Fog Rendering
+        case 405:
         {
-            const auto shader = GPUParticlesSorting->GetShader();
-            const StringAnsiView CS_Sort("CS_Sort");
-            GPUParticlesSortingCS[0] = shader->GetCS(CS_Sort, 0);
-            GPUParticlesSortingCS[1] = shader->GetCS(CS_Sort, 1);
-            GPUParticlesSortingCS[2] = shader->GetCS(CS_Sort, 2);
-            GPUParticlesSortingCB = shader->GetCB(0);
-            ASSERT(GPUParticlesSortingCB);
+            // Not supported
+            break;
+        }
         }
+    }
+    if (indirectArgs.IsEmpty())
+        return;
+    const bool useSorting = emitter->Graph.SortModules.HasItems() && renderContext.View.Pass != DrawPass::Depth;
+    const bool useIndirectArgsCS = !InitGPUParticlesSorting() && GPUParticlesIndirectArgsCS;
+    if (useSorting && !useIndirectArgsCS)
+        return;
+
+    // Ensure to have enough space for indirect draw arguments (followed by the sorting keys generation dispatch arguments)
+    const uint32 dispatchArgsOffset = indirectArgs.Count() * sizeof(GPUDrawIndexedIndirectArgs);
+    const uint32 minSize = dispatchArgsOffset + sizeof(GPUDispatchIndirectArgs);
+    if (buffer->GPU.IndirectDrawArgsBuffer->GetSize() < minSize)
+    {
+        buffer->GPU.IndirectDrawArgsBuffer->Init(GPUBufferDescription::Raw(minSize, GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess));
+    }
+
+    // Initialize indirect draw arguments contents (do it before drawing to reduce memory barriers amount when updating arguments buffer)
+    context->UpdateBuffer(buffer->GPU.IndirectDrawArgsBuffer, indirectArgs.Get(), dispatchArgsOffset);
+    GPUParticlesSortingData data;
+    data.ParticleCounterOffset = buffer->GPU.ParticleCounterOffset;
+    data.ParticleStride = buffer->Stride;
+    data.ParticleCapacity = buffer->Capacity;
+    data.DrawArgsCount = indirectArgs.Count();
+    data.DispatchArgsOffset = dispatchArgsOffset;
+    if (useIndirectArgsCS)
+    {
+        // Write particles count into all arguments at once on GPU (empty emitters get zero instances and zero sorting thread groups)
+        context->UpdateCB(GPUParticlesSortingCB, &data);
+        context->BindCB(0, GPUParticlesSortingCB);
+        context->BindSR(0, buffer->GPU.Buffer->View());
+        context->BindUA(0, buffer->GPU.IndirectDrawArgsBuffer->View());
+        context->Dispatch(GPUParticlesIndirectArgsCS, 1, 1, 1);
+        context->ResetUA();
+    }
+    else
+    {
+        for (int32 i = 0; i < indirectArgs.Count(); i++)
+            context->CopyBuffer(buffer->GPU.IndirectDrawArgsBuffer, buffer->GPU.Buffer, 4, i * sizeof(GPUDrawIndexedIndirectArgs) + 4, data.ParticleCounterOffset);
+    }
+
+    // Check if need to perform any particles sorting
+    if (useSorting)
+    {
+        PROFILE_GPU_CPU_NAMED("Sort Particles");
 
         // Prepare sorting data
         if (!buffer->GPU.SortedIndices)
@@ -642,10 +752,6 @@ void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
 
             // Generate sorting keys based on sorting mode
-            GPUParticlesSortingData data;
-            data.ParticleCounterOffset = buffer->GPU.ParticleCounterOffset;
-            data.ParticleStride = buffer->Stride;
-            data.ParticleCapacity = buffer->Capacity;
             int32 permutationIndex;
             bool sortAscending;
             switch (sortMode)
@@ -705,132 +811,15 @@ void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             context->BindCB(0, GPUParticlesSortingCB);
             context->BindSR(0, buffer->GPU.Buffer->View());
             context->BindUA(0, buffer->GPU.SortingKeysBuffer->View());
-            // TODO: optimize it by using DispatchIndirect with shared invoke args generated after particles update
-            const int32 threadGroupSize = 1024;
-            context->Dispatch(GPUParticlesSortingCS[permutationIndex], Math::DivideAndRoundUp(buffer->GPU.ParticlesCountMax, threadGroupSize), 1, 1);
+            context->DispatchIndirect(GPUParticlesSortingCS[permutationIndex], buffer->GPU.IndirectDrawArgsBuffer, dispatchArgsOffset);
 
             // Perform sorting
             BitonicSort::Instance()->Sort(context, buffer->GPU.SortingKeysBuffer, buffer->GPU.Buffer, data.ParticleCounterOffset, sortAscending, buffer->GPU.SortedIndices);
         }
     }
 
-    // Count draw calls to perform during this emitter rendering
-    int32 drawCalls = 0;
-    for (int32 index = 0; index < renderModulesIndices.Count(); index++)
-    {
-        int32 moduleIndex = renderModulesIndices[index];
-        auto module = emitter->Graph.RenderModules[moduleIndex];
-        switch (module->TypeID)
-        {
-        // Sprite Rendering
-        case 400:
-        {
-            drawCalls++;
-            break;
-        }
-        // Model Rendering
-        case 403:
-        {
-            const auto model = (Model*)module->Assets[0].Get();
-
-            // TODO: model LOD picking for particles?
-            int32 lodIndex = 0;
-            ModelLOD& lod = model->LODs[lodIndex];
-            for (int32 meshIndex = 0; meshIndex < lod.Meshes.Count(); meshIndex++)
-            {
-                Mesh& mesh = lod.Meshes[meshIndex];
-                if (!mesh.IsInitialized())
-                    continue;
-
-                drawCalls++;
-            }
-
-            break;
-        }
-        // Ribbon Rendering
-        case 404:
-        {
-            // Not supported
-            break;
-        }
-        // Volumetric Fog Rendering
-        case 405:
-        {
-            // Not supported
-            break;
-        }
-        }
-    }
-    if (drawCalls == 0)
-        return;
-
-    // Ensure to have enough space for indirect draw arguments
-    const uint32 minSize = drawCalls * sizeof(GPUDrawIndexedIndirectArgs);
-    if (buffer->GPU.IndirectDrawArgsBuffer->GetSize() < minSize)
-    {
-        buffer->GPU.IndirectDrawArgsBuffer->Init(GPUBufferDescription::Argument(minSize));
-    }
-
-    // Initialize indirect draw arguments contents (do it before drawing to reduce memory barriers amount when updating arguments buffer)
-    int32 indirectDrawCallIndex = 0;
-    for (int32 index = 0; index < renderModulesIndices.Count(); index++)
-    {
-        int32 moduleIndex = renderModulesIndices[index];
-        auto module = emitter->Graph.RenderModules[moduleIndex];
-        switch (module->TypeID)
-        {
-        // Sprite Rendering
-        case 400:
-        {
-            GPUDrawIndexedIndirectArgs indirectArgsBufferInitData{ SpriteParticleRenderer::IndexCount, 1, 0, 0, 0 };
-            const uint32 offset = indirectDrawCallIndex * sizeof(GPUDrawIndexedIndirectArgs);
-            context->UpdateBuffer(buffer->GPU.IndirectDrawArgsBuffer, &indirectArgsBufferInitData, sizeof(indirectArgsBufferInitData), offset);
-            const uint32 counterOffset = buffer->GPU.ParticleCounterOffset;
-            context->CopyBuffer(buffer->GPU.IndirectDrawArgsBuffer, buffer->GPU.Buffer, 4, offset + 4, counterOffset);
-            indirectDrawCallIndex++;
-            break;
-        }
-        // Model Rendering
-        case 403:
-        {
-            const auto model = (Model*)module->Assets[0].Get();
-
-            // TODO: model LOD picking for particles?
-            int32 lodIndex = 0;
-            ModelLOD& lod = model->LODs[lodIndex];
-            for (int32 meshIndex = 0; meshIndex < lod.Meshes.Count(); meshIndex++)
-            {
-                Mesh& mesh = lod.Meshes[meshIndex];
-                if (!mesh.IsInitialized())
-                    continue;
-
-                GPUDrawIndexedIndirectArgs indirectArgsBufferInitData = { (uint32)mesh.GetTriangleCount() * 3, 1, 0, 0, 0 };
-                const uint32 offset = indirectDrawCallIndex * sizeof(GPUDrawIndexedIndirectArgs);
-                context->UpdateBuffer(buffer->GPU.IndirectDrawArgsBuffer, &indirectArgsBufferInitData, sizeof(indirectArgsBufferInitData), offset);
-                const uint32 counterOffset = buffer->GPU.ParticleCounterOffset;
-                context->CopyBuffer(buffer->GPU.IndirectDrawArgsBuffer, buffer->GPU.Buffer, 4, offset + 4, counterOffset);
-                indirectDrawCallIndex++;
-            }
-
-            break;
-        }
-        // Ribbon Rendering
-        case 404:
-        {
-            // Not supported
-            break;
-        }
-        // Volumetric Fog Rendering
-        case 405:
-        {
-            // Not supported
-            break;
-        }
-        }
-    }
-
     // Execute all rendering modules
-    indirectDrawCallIndex = 0;
+    int32 indirectDrawCallIndex = 0;
     for (int32 index = 0; index < renderModulesIndices.Count(); index++)
     {
         int32 moduleIndex = renderModulesIndices[index];
@@ -1114,8 +1103,16 @@ ParticleBuffer* Particles::AcquireParticleBuffer(ParticleEmitter* emitter)
                         break;
                     }
                 }
+                else
+                {
+                    break;
+                }
             }
         }
+        if (result)
+            PoolHits++;
+        else
+            PoolMisses++;
         PoolLocker.Unlock();
     }
 
@@ -1172,6 +1169,7 @@ void Particles::OnEmitterUnload(ParticleEmitter* emitter)
         entries->Clear();
         Pool.Remove(emitter);
     }
+    PoolReserve.Remove(emitter);
     PoolLocker.Unlock();
 
 #if COMPILE_WITH_GPU_PARTICLES
@@ -1185,6 +1183,66 @@ void Particles::OnEmitterUnload(ParticleEmitter* emitter)
 #endif
 }
 
+void Particles::PrewarmParticleBuffers(ParticleEmitter* emitter, int32 count)
+{
+    if (!emitter || count <= 0 || !emitter->EnablePooling || !EnableParticleBufferPooling || emitter->WaitForLoaded())
+        return;
+    PROFILE_CPU();
+
+    PoolLocker.Lock();
+    int32& reserve = PoolReserve[emitter];
+    reserve = Math::Max(reserve, count);
+    const auto entries = Pool.TryGet(emitter);
+    int32 toCreate = count - (entries ? entries->Count() : 0);
+    PoolLocker.Unlock();
+
+    // Create buffers outside the lock to not block the simulation (pool might be used from the other threads)
+    const double timeSeconds = Platform::GetTimeSeconds();
+    for (; toCreate > 0; toCreate--)
+    {
+        auto buffer = New<ParticleBuffer>();
+        if (buffer->Init(emitter) || (emitter->Graph.SortModules.HasItems() && buffer->AllocateSortBuffer()))
+        {
+            LOG(Error, "Failed to create particle buffer for emitter {0}", emitter->ToString());
+            Delete(buffer);
+            break;
+        }
+        EmitterCache c;
+        c.LastTimeUsed = timeSeconds;
+        c.Buffer = buffer;
+
+        PoolLocker.Lock();
+        Pool[emitter].Add(c);
+        PoolLocker.Unlock();
+    }
+}
+
+void Particles::PrewarmParticleBuffers(ParticleSystem* system, int32 count)
+{
+    if (!system || system->WaitForLoaded())
+        return;
+    for (const auto& emitter : system->Emitters)
+        PrewarmParticleBuffers(emitter.Get(), count);
+}
+
+void Particles::GetBufferPoolStats(int32& hits, int32& misses, int32& pooledBuffers, uint64& pooledMemory, bool reset)
+{
+    pooledBuffers = 0;
+    pooledMemory = 0;
+    PoolLocker.Lock();
+    hits = PoolHits;
+    misses = PoolMisses;
+    if (reset)
+        PoolHits = PoolMisses = 0;
+    for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
+    {
+        for (const EmitterCache& e : i->Value)
+            pooledMemory += e.Buffer->GetMemoryUsage();
+        pooledBuffers += i->Value.Count();
+    }
+    PoolLocker.Unlock();
+}
+
 bool ParticleManagerService::Init()
 {
     Particles::System = New<ParticlesSystem>();
@@ -1211,6 +1269,7 @@ void ParticleManagerService::Dispose()
     ParticlesDrawCPU::SortingKeys[1].SetCapacity(0);
     ParticlesDrawCPU::SortingIndices.SetCapacity(0);
     ParticlesDrawCPU::SortedIndices.SetCapacity(0);
+    ParticlesDrawCPU::ParticlesData.SetCapacity(0);
 
     PoolLocker.Lock();
     for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
@@ -1223,6 +1282,7 @@ void ParticleManagerService::Dispose()
         entries.Clear();
     }
     Pool.Clear();
+    PoolReserve.Clear();
     PoolLocker.Unlock();
 
     SpriteRenderer.Dispose();
@@ -1232,6 +1292,7 @@ void ParticleManagerService::Dispose()
 void ParticlesSystem::Job(int32 index)
 {
     PROFILE_CPU_NAMED("Particles.Job");
+    PROFILE_MEM(Particles);
     auto effect = UpdateList[index];
     auto& instance = effect->Instance;
     const auto particleSystem = effect->ParticleSystem.Get();
@@ -1284,84 +1345,97 @@ void ParticlesSystem::Job(int32 index)
     // TODO: if using fixed timestep quantize the dt and accumulate remaining part for the next update?
     if (dt <= 1.0f / 240.0f)
         return;
+
+    // Split longer updates into smaller steps (eg. to fast-forward the time skipped while the effect was off-screen)
+    int32 steps = 1;
+    if (instance.UseSubSteps)
+    {
+        instance.UseSubSteps = false;
+        steps = Math::Clamp(Math::CeilToInt(dt / PARTICLES_SUB_STEP_TIME), 1, PARTICLES_MAX_SUB_STEPS);
+        dt /= (float)steps;
+    }
+    const float stepTime = dt;
     dt *= effect->SimulationSpeed;
-    instance.Time += dt;
-    const float fps = particleSystem->FramesPerSecond;
-    const float duration = (float)particleSystem->DurationFrames / fps;
-    if (instance.Time > duration)
+    for (int32 step = 0; step < steps; step++)
     {
-        if (effect->IsLooping)
+        instance.Time += dt;
+        const float fps = particleSystem->FramesPerSecond;
+        const float duration = (float)particleSystem->DurationFrames / fps;
+        if (instance.Time > duration)
         {
-            // Loop
-            // TODO: accumulate (duration - instance.Time) into next update dt
-            instance.Time = 0;
-            for (int32 j = 0; j < instance.Emitters.Count(); j++)
+            if (effect->IsLooping)
             {
-                auto& e = instance.Emitters[j];
-                e.Time = 0;
-                for (auto& s : e.SpawnModulesData)
+                // Loop
+                // TODO: accumulate (duration - instance.Time) into next update dt
+                instance.Time = 0;
+                for (int32 j = 0; j < instance.Emitters.Count(); j++)
                 {
-                    s.NextSpawnTime = 0.0f;
+                    auto& e = instance.Emitters[j];
+                    e.Time = 0;
+                    for (auto& s : e.SpawnModulesData)
+                    {
+                        s.NextSpawnTime = 0.0f;
+                    }
                 }
             }
-        }
-        else
-        {
-            // End
-            instance.Time = duration;
-            for (auto& emitterInstance : instance.Emitters)
+            else
             {
-                if (emitterInstance.Buffer)
+                // End
+                instance.Time = duration;
+                for (auto& emitterInstance : instance.Emitters)
                 {
-                    Particles::RecycleParticleBuffer(emitterInstance.Buffer);
-                    emitterInstance.Buffer = nullptr;
+                    if (emitterInstance.Buffer)
+                    {
+                        Particles::RecycleParticleBuffer(emitterInstance.Buffer);
+                        emitterInstance.Buffer = nullptr;
+                    }
                 }
+                return;
             }
-            return;
         }
-    }
-    instance.LastUpdateTime = t;
+        instance.LastUpdateTime = t - stepTime * (float)(steps - step - 1);
 
-    // Update all emitter tracks
-    for (int32 j = 0; j < particleSystem->Tracks.Count(); j++)
-    {
-        const auto& track = particleSystem->Tracks[j];
-        if (track.Type != ParticleSystem::Track::Types::Emitter || track.Disabled)
-            continue;
-        auto emitter = particleSystem->Emitters[track.AsEmitter.Index].Get();
-        auto& data = instance.Emitters[track.AsEmitter.Index];
-        ASSERT(emitter && emitter->IsLoaded());
-        ASSERT(emitter->Capacity != 0 && emitter->Graph.Layout.Size != 0);
-        PROFILE_CPU_ASSET(emitter);
-
-        // Calculate new time position
-        const float startTime = (float)track.AsEmitter.StartFrame / fps;
-        const float durationTime = (float)track.AsEmitter.DurationFrames / fps;
-        const bool canSpawn = startTime <= instance.Time && instance.Time <= startTime + durationTime;
-
-        // Update instance data
-        data.Sync(effect->Instance, particleSystem, track.AsEmitter.Index);
-        if (!data.Buffer)
+        // Update all emitter tracks
+        for (int32 j = 0; j < particleSystem->Tracks.Count(); j++)
         {
-            data.Buffer = Particles::AcquireParticleBuffer(emitter);
-        }
-        data.Time += dt;
+            const auto& track = particleSystem->Tracks[j];
+            if (track.Type != ParticleSystem::Track::Types::Emitter || track.Disabled)
+                continue;
+            auto emitter = particleSystem->Emitters[track.AsEmitter.Index].Get();
+            auto& data = instance.Emitters[track.AsEmitter.Index];
+            ASSERT(emitter && emitter->IsLoaded());
+            ASSERT(emitter->Capacity != 0 && emitter->Graph.Layout.Size != 0);
+            PROFILE_CPU_ASSET(emitter);
 
-        // Update particles simulation
-        switch (emitter->SimulationMode)
-        {
-        case ParticlesSimulationMode::CPU:
-            emitter->GraphExecutorCPU.Update(emitter, effect, data, dt, canSpawn);
-            updateBounds |= emitter->UseAutoBounds;
-            break;
+            // Calculate new time position
+            const float startTime = (float)track.AsEmitter.StartFrame / fps;
+            const float durationTime = (float)track.AsEmitter.DurationFrames / fps;
+            const bool canSpawn = startTime <= instance.Time && instance.Time <= startTime + durationTime;
+
+            // Update instance data
+            data.Sync(effect->Instance, particleSystem, track.AsEmitter.Index);
+            if (!data.Buffer)
+            {
+                data.Buffer = Particles::AcquireParticleBuffer(emitter);
+            }
+            data.Time += dt;
+
+            // Update particles simulation
+            switch (emitter->SimulationMode)
+            {
+            case ParticlesSimulationMode::CPU:
+                emitter->GraphExecutorCPU.Update(emitter, effect, data, dt, canSpawn);
+                updateBounds |= emitter->UseAutoBounds;
+                break;
 #if COMPILE_WITH_GPU_PARTICLES
-        case ParticlesSimulationMode::GPU:
-            emitter->GPU.Update(emitter, effect, data, dt, canSpawn);
-            updateGpu = true;
-            break;
+            case ParticlesSimulationMode::GPU:
+                emitter->GPU.Update(emitter, effect, data, dt, canSpawn);
+                updateGpu = true;
+                break;
 #endif
-        default:
-            break;
+            default:
+                break;
+            }
         }
     }
 
@@ -1428,7 +1502,9 @@ void ParticlesSystem::PostExecute(TaskGraph* graph)
     for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
     {
         auto& entries = i->Value;
-        for (int32 j = 0; j < entries.Count(); j++)
+        const int32* reserve = PoolReserve.TryGet(i->Key);
+        const int32 keepCount = reserve ? *reserve : 0;
+        for (int32 j = 0; j < entries.Count() && entries.Count() > keepCount; j++)
         {
             auto& e = entries[j];
             if (timeSeconds - e.LastTimeUsed >= Particles::ParticleBufferRecycleTimeout)
@@ -77,4 +77,29 @@ API_CLASS(Static) class FLAXENGINE_API Particles
     /// </summary>
     /// <param name="emitter">The emitter.</param>
     static void OnEmitterUnload(ParticleEmitter* emitter);
+
+    /// <summary>
+    /// Pre-warms the particle buffers pool for the emitter. Allocates the buffers up front (eg. during level loading) to prevent hitches caused by GPU resources creation when effect gets spawned. Reserved buffers are not released by the pool recycling timeout.
+    /// </summary>
+    /// <remarks>Requires particle buffers pooling enabled on the emitter and globally (see EnableParticleBufferPooling).</remarks>
+    /// <param name="emitter">The emitter.</param>
+    /// <param name="count">The amount of free buffers to keep in the pool for this emitter (the amount of the emitter instances that can be spawned without allocating buffers).</param>
+    API_FUNCTION() static void PrewarmParticleBuffers(ParticleEmitter* emitter, int32 count);
+
+    /// <summary>
+    /// Pre-warms the particle buffers pool for all emitters used by the particle system.
+    /// </summary>
+    /// <param name="system">The particle system.</param>
+    /// <param name="count">The amount of free buffers to keep in the pool for each emitter (the amount of the effect instances that can be spawned without allocating buffers).</param>
+    API_FUNCTION() static void PrewarmParticleBuffers(ParticleSystem* system, int32 count);
+
+    /// <summary>
+    /// Gets the particle buffers pool stats.
+    /// </summary>
+    /// <param name="hits">The amount of buffers reused from the pool.</param>
+    /// <param name="misses">The amount of buffers created because the pool had no free buffer for the emitter.</param>
+    /// <param name="pooledBuffers">The amount of free buffers in the pool.</param>
+    /// <param name="pooledMemory">The memory used by free buffers in the pool (in bytes).</param>
+    /// <param name="reset">True if reset the hits and misses counters.</param>
+    static void GetBufferPoolStats(int32& hits, int32& misses, int32& pooledBuffers, uint64& pooledMemory, bool reset);
 };
@@ -41,6 +41,7 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
         CPU.Buffer.Resize(size);
         CPU.RibbonOrder.Resize(0);
         GPU.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer"));
+        GPU.Buffer->SetCategory(GPUResourceCategory::Particles);
         if (GPU.Buffer->Init(GPUBufferDescription::Raw(size, GPUBufferFlags::ShaderResource, GPUResourceUsage::Dynamic)))
             return true;
         break;
@@ -56,12 +57,15 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
 
         // Particle data buffer: attributes + counter + custom data
         GPU.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer A"));
+        GPU.Buffer->SetCategory(GPUResourceCategory::Particles);
         if (GPU.Buffer->Init(GPUBufferDescription::Raw(size + sizeof(uint32) + emitter->GPU.CustomDataSize, GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess)))
             return true;
         GPU.BufferSecondary = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer B"));
+        GPU.BufferSecondary->SetCategory(GPUResourceCategory::Particles);
         if (GPU.BufferSecondary->Init(GPU.Buffer->GetDescription()))
             return true;
         GPU.IndirectDrawArgsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleIndirectDrawArgsBuffer"));
+        GPU.IndirectDrawArgsBuffer->SetCategory(GPUResourceCategory::Particles);
         GPU.PendingClear = true;
         GPU.HasValidCount = false;
         GPU.ParticleCounterOffset = size;
@@ -88,6 +92,7 @@ bool ParticleBuffer::AllocateSortBuffer()
     {
         const int32 sortedIndicesSize = Capacity * sizeof(uint32) * Emitter->Graph.SortModules.Count();
         GPU.SortedIndices = GPUDevice::Instance->CreateBuffer(TEXT("SortedIndices"));
+        GPU.SortedIndices->SetCategory(GPUResourceCategory::Particles);
         if (GPU.SortedIndices->Init(GPUBufferDescription::Buffer(sortedIndicesSize, GPUBufferFlags::ShaderResource, PixelFormat::R32_UInt, nullptr, sizeof(uint32), GPUResourceUsage::Dynamic)))
             return true;
         break;
@@ -97,9 +102,11 @@ bool ParticleBuffer::AllocateSortBuffer()
     {
         const int32 sortedIndicesSize = Capacity * sizeof(uint32) * Emitter->Graph.SortModules.Count();
         GPU.SortingKeysBuffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleSortingKeysBuffer"));
+        GPU.SortingKeysBuffer->SetCategory(GPUResourceCategory::Particles);
         if (GPU.SortingKeysBuffer->Init(GPUBufferDescription::Structured(Capacity, sizeof(float) + sizeof(uint32), true)))
             return true;
         GPU.SortedIndices = GPUDevice::Instance->CreateBuffer(TEXT("SortedIndices"));
+        GPU.SortedIndices->SetCategory(GPUResourceCategory::Particles);
         if (GPU.SortedIndices->Init(GPUBufferDescription::Buffer(sortedIndicesSize, GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess, PixelFormat::R32_UInt, nullptr, sizeof(uint32))))
             return true;
         break;
@@ -135,3 +142,77 @@ void ParticleBuffer::Clear()
         CRASH;
     }
 }
+
+uint64 ParticleBuffer::GetMemoryUsage() const
+{
+    uint64 result = CPU.Buffer.Capacity() + CPU.RibbonOrder.Capacity() * sizeof(int32);
+    const GPUBuffer* buffers[] = { GPU.Buffer, GPU.BufferSecondary, GPU.IndirectDrawArgsBuffer, GPU.SortingKeysBuffer, GPU.SortedIndices };
+    for (const GPUBuffer* buffer : buffers)
+    {
+        if (buffer)
+            result += buffer->GetMemoryUsage();
+    }
+    if (GPU.RibbonIndexBufferDynamic && GPU.RibbonIndexBufferDynamic->GetBuffer())
+        result += GPU.RibbonIndexBufferDynamic->GetBuffer()->GetMemoryUsage();
+    if (GPU.RibbonVertexBufferDynamic && GPU.RibbonVertexBufferDynamic->GetBuffer())
+        result += GPU.RibbonVertexBufferDynamic->GetBuffer()->GetMemoryUsage();
+    return result;
+}
+
+void ParticleBuffer::CopyParticleCPU(int32 dstIndex, int32 srcIndex)
+{
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        const int32 size = attribute.GetSize();
+        byte* stream = GetAttributeStreamCPU(attribute.Offset);
+        Platform::MemoryCopy(stream + dstIndex * size, stream + srcIndex * size, size);
+    }
+}
+
+void ParticleBuffer::SetParticlesCPU(int32 particlesStart, int32 particlesCount, const byte* data)
+{
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        const int32 size = attribute.GetSize();
+        const byte* src = data + attribute.Offset;
+        byte* dst = GetAttributeStreamCPU(attribute.Offset) + particlesStart * size;
+        for (int32 i = 0; i < particlesCount; i++)
+        {
+            Platform::MemoryCopy(dst, src, size);
+            dst += size;
+        }
+    }
+}
+
+void ParticleBuffer::GetParticlesCPU(byte* output, int32 particlesCount) const
+{
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        const int32 size = attribute.GetSize();
+        const byte* src = GetAttributeStreamCPU(attribute.Offset);
+        byte* dst = output + attribute.Offset;
+        switch (size)
+        {
+#define COPY_STREAM(type) \
+            for (int32 i = 0; i < particlesCount; i++) \
+            { \
+                *(type*)dst = ((const type*)src)[i]; \
+                dst += Stride; \
+            } \
+            break
+        case 4:
+            COPY_STREAM(uint32);
+        case 8:
+            COPY_STREAM(uint64);
+        default:
+            for (int32 i = 0; i < particlesCount; i++)
+            {
+                Platform::MemoryCopy(dst, src, size);
+                src += size;
+                dst += Stride;
+            }
+            break;
+#undef COPY_STREAM
+        }
+    }
+}
@@ -256,6 +256,9 @@ class FLAXENGINE_API ParticleBuffer
         /// <summary>
         /// The particles data buffer (CPU side).
         /// </summary>
+        /// <remarks>
+        /// Uses structure-of-arrays layout: every attribute is stored in a separate contiguous stream of Capacity elements (located at attribute Offset * Capacity). This allows the simulation to process the attributes data of many particles at once (eg. with SIMD). GPU buffer uses the interleaved layout (see GetParticlesCPU).
+        /// </remarks>
         Array<byte> Buffer;
 
         /// <summary>
@@ -358,24 +361,62 @@ class FLAXENGINE_API ParticleBuffer
     void Clear();
 
     /// <summary>
-    /// Gets the pointer to the particle data.
+    /// Gets the memory used by this buffer (CPU and GPU resources, in bytes).
     /// </summary>
-    /// <param name="particleIndex">Index of the particle.</param>
-    /// <returns>The particle data start address.</returns>
-    FORCE_INLINE byte* GetParticleCPU(int32 particleIndex)
+    uint64 GetMemoryUsage() const;
+
+    /// <summary>
+    /// Gets the pointer to the attribute data stream (the first particle value).
+    /// </summary>
+    /// <param name="attributeOffset">The attribute offset (in the particle layout).</param>
+    /// <returns>The attribute data stream start address.</returns>
+    FORCE_INLINE byte* GetAttributeStreamCPU(int32 attributeOffset)
+    {
+        return CPU.Buffer.Get() + attributeOffset * Capacity;
+    }
+
+    /// <summary>
+    /// Gets the pointer to the attribute data stream (the first particle value).
+    /// </summary>
+    /// <param name="attributeOffset">The attribute offset (in the particle layout).</param>
+    /// <returns>The attribute data stream start address.</returns>
+    FORCE_INLINE const byte* GetAttributeStreamCPU(int32 attributeOffset) const
     {
-        return CPU.Buffer.Get() + particleIndex * Stride;
+        return CPU.Buffer.Get() + attributeOffset * Capacity;
     }
 
     /// <summary>
-    /// Gets the pointer to the particle data.
+    /// Gets the pointer to the particle attribute data. Values of the following particles are located every attribute.GetSize() bytes.
     /// </summary>
+    /// <param name="attribute">The attribute.</param>
     /// <param name="particleIndex">Index of the particle.</param>
-    /// <returns>The particle data start address.</returns>
-    FORCE_INLINE const byte* GetParticleCPU(int32 particleIndex) const
+    /// <returns>The particle attribute data address.</returns>
+    FORCE_INLINE byte* GetAttributeCPU(const ParticleAttribute& attribute, int32 particleIndex)
     {
-        return CPU.Buffer.Get() + particleIndex * Stride;
+        return GetAttributeStreamCPU(attribute.Offset) + particleIndex * attribute.GetSize();
     }
+
+    /// <summary>
+    /// Copies the particle data (all attributes) to the other particle.
+    /// </summary>
+    /// <param name="dstIndex">Index of the destination particle.</param>
+    /// <param name="srcIndex">Index of the source particle.</param>
+    void CopyParticleCPU(int32 dstIndex, int32 srcIndex);
+
+    /// <summary>
+    /// Sets the particles data (all attributes) from the single particle data.
+    /// </summary>
+    /// <param name="particlesStart">Index of the first particle to set.</param>
+    /// <param name="particlesCount">The amount of particles to set.</param>
+    /// <param name="data">The particle data (in the interleaved layout, Stride bytes).</param>
+    void SetParticlesCPU(int32 particlesStart, int32 particlesCount, const byte* data);
+
+    /// <summary>
+    /// Copies the particles data into the interleaved layout (particle structures one after another, as used by GPU buffers and shaders).
+    /// </summary>
+    /// <param name="output">The output data (allocated for particlesCount * Stride bytes).</param>
+    /// <param name="particlesCount">The amount of particles to copy (from the start).</param>
+    void GetParticlesCPU(byte* output, int32 particlesCount) const;
 };
 
 struct ParticleBufferCPUDataAccessorBase
@@ -427,7 +468,7 @@ struct ParticleBufferCPUDataAccessor : ParticleBufferCPUDataAccessorBase
     {
         ASSERT(IsValid());
         ASSERT(index >= 0 && index < _buffer->CPU.Count);
-        return *(T*)(_buffer->CPU.Buffer.Get() + _offset + index * _buffer->Stride);
+        return *((const T*)_buffer->GetAttributeStreamCPU(_offset) + index);
     }
 
     FORCE_INLINE T Get(int32 index, const T& defaultValue) const
@@ -134,6 +134,7 @@ void ParticleSystemInstance::ClearState()
     Version = 0;
     Time = 0;
     LastUpdateTime = -1;
+    UseSubSteps = false;
     Emitters.Resize(0);
     if (GPUParticlesCountReadback)
         GPUParticlesCountReadback->ReleaseGPU();
@@ -154,6 +154,11 @@ class FLAXENGINE_API ParticleSystemInstance
     /// </summary>
     float LastUpdateTime = -1;
 
+    /// <summary>
+    /// True if the next simulation update should be split into smaller steps (eg. to fast-forward the time skipped while the effect was off-screen).
+    /// </summary>
+    bool UseSubSteps = false;
+
     /// <summary>
     /// The particle system emitters data (one per emitter instance).
     /// </summary>
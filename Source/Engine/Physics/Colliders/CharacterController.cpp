@@ -7,6 +7,9 @@
 #include "Engine/Physics/PhysicsScene.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Engine/Time.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 
 CharacterController::CharacterController(const SpawnParams& params)
     : Collider(params)
@@ -167,6 +170,120 @@ CharacterController::CollisionFlags CharacterController::Move(const Vector3& dis
     return result;
 }
 
+void CharacterController::SimpleMoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& speeds, bool parallel)
+{
+    MoveMany(controllers, speeds, parallel, true);
+}
+
+void CharacterController::MoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& displacements, bool parallel)
+{
+    MoveMany(controllers, displacements, parallel, false);
+}
+
+namespace
+{
+    struct MoveManyItem
+    {
+        CharacterController* Controller;
+        Vector3 Displacement;
+        Guid ID;
+    };
+
+    struct MoveManySceneGroup
+    {
+        PhysicsScene* Scene;
+        int32 Start;
+        int32 Count;
+    };
+
+    bool SortMoveManyItems(const MoveManyItem& a, const MoveManyItem& b)
+    {
+        // Sort by scene to group controllers and then by ID for deterministic order of the movement
+        if (a.Controller->GetPhysicsScene() != b.Controller->GetPhysicsScene())
+            return (uintptr)a.Controller->GetPhysicsScene() < (uintptr)b.Controller->GetPhysicsScene();
+        if (a.ID.A != b.ID.A)
+            return a.ID.A < b.ID.A;
+        if (a.ID.B != b.ID.B)
+            return a.ID.B < b.ID.B;
+        if (a.ID.C != b.ID.C)
+            return a.ID.C < b.ID.C;
+        return a.ID.D < b.ID.D;
+    }
+}
+
+void CharacterController::MoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& vectors, bool parallel, bool simple)
+{
+    PROFILE_CPU();
+    CHECK(controllers.Count() == vectors.Count());
+    const float deltaTime = Time::GetCurrentSafe()->DeltaTime.GetTotalSeconds();
+
+    // Collect characters to move
+    Array<MoveManyItem> items;
+    items.Resize(controllers.Count());
+    int32 itemsCount = 0;
+    for (int32 i = 0; i < controllers.Count(); i++)
+    {
+        CharacterController* controller = controllers.Get()[i];
+        if (!controller || !controller->_controller)
+            continue;
+        auto& item = items.Get()[itemsCount++];
+        item.Controller = controller;
+        item.Displacement = vectors.Get()[i];
+        item.ID = controller->GetID();
+        if (simple)
+        {
+            item.Displacement += controller->GetPhysicsScene()->GetGravity() * deltaTime;
+            item.Displacement *= deltaTime;
+        }
+    }
+    if (itemsCount == 0)
+        return;
+    Sorting::QuickSort(items.Get(), itemsCount, &SortMoveManyItems);
+
+    // Split characters into groups per-scene (each scene has a separate controllers manager)
+    Array<MoveManySceneGroup, InlinedAllocation<8>> groups;
+    for (int32 i = 0; i < itemsCount; i++)
+    {
+        PhysicsScene* scene = items.Get()[i].Controller->GetPhysicsScene();
+        if (groups.IsEmpty() || groups.Last().Scene != scene)
+            groups.Add({ scene, i, 0 });
+        groups.Last().Count++;
+    }
+
+    // Move characters
+    MoveManyItem* itemsPtr = items.Get();
+    const MoveManySceneGroup* groupsPtr = groups.Get();
+    const auto moveGroup = [itemsPtr, groupsPtr, deltaTime](int32 groupIndex)
+    {
+        PROFILE_CPU_NAMED("CharacterController.MoveMany");
+        const MoveManySceneGroup& group = groupsPtr[groupIndex];
+        for (int32 i = group.Start; i < group.Start + group.Count; i++)
+        {
+            const MoveManyItem& item = itemsPtr[i];
+            CharacterController* controller = item.Controller;
+            controller->_lastFlags = (CollisionFlags)PhysicsBackend::MoveController(controller->_controller, controller->_shape, item.Displacement, controller->_minMoveDistance, deltaTime);
+        }
+    };
+    if (parallel && groups.Count() > 1)
+    {
+        Function<void(int32)> job;
+        job.Bind(moveGroup);
+        JobSystem::Wait(JobSystem::Dispatch(job, groups.Count()));
+    }
+    else
+    {
+        for (int32 groupIndex = 0; groupIndex < groups.Count(); groupIndex++)
+            moveGroup(groupIndex);
+    }
+
+    // Sync actors transformation (on the calling thread)
+    for (int32 i = 0; i < itemsCount; i++)
+    {
+        CharacterController* controller = itemsPtr[i].Controller;
+        controller->SetPosition(PhysicsBackend::GetControllerPosition(controller->_controller));
+    }
+}
+
 #if USE_EDITOR
 
 #include "Engine/Debug/DebugDraw.h"
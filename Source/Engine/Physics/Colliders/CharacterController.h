@@ -177,6 +177,29 @@ class FLAXENGINE_API CharacterController : public Collider, public IPhysicsActor
     /// <returns>The collision flags. It can be used to trigger various character animations.</returns>
     API_FUNCTION() CollisionFlags Move(const Vector3& displacement);
 
+    /// <summary>
+    /// Moves the multiple characters with the given speeds (see SimpleMove) in a single call. Gravity is automatically applied. The result collision flags can be read from each character (see Flags).
+    /// </summary>
+    /// <remarks>Characters are moved in a deterministic order (sorted by the object ID) so the interactions between them don't depend on the order of the input.</remarks>
+    /// <param name="controllers">The characters to move.</param>
+    /// <param name="speeds">The movement speed (in units/s) for each character.</param>
+    /// <param name="parallel">True if move characters from different physics scenes in parallel on the Job System threads. Characters from a single scene are always moved one after another as they interact with each other.</param>
+    API_FUNCTION() static void SimpleMoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& speeds, bool parallel = false);
+
+    /// <summary>
+    /// Moves the multiple characters using a 'collide-and-slide' algorithm (see Move) in a single call. This function does not apply any gravity. The result collision flags can be read from each character (see Flags).
+    /// </summary>
+    /// <remarks>Characters are moved in a deterministic order (sorted by the object ID) so the interactions between them don't depend on the order of the input.</remarks>
+    /// <param name="controllers">The characters to move.</param>
+    /// <param name="displacements">The displacement vector (in world units) for each character.</param>
+    /// <param name="parallel">True if move characters from different physics scenes in parallel on the Job System threads. Characters from a single scene are always moved one after another as they interact with each other.</param>
+    API_FUNCTION() static void MoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& displacements, bool parallel = false);
+
+private:
+    static void MoveMany(const Array<CharacterController*>& controllers, const Array<Vector3>& vectors, bool parallel, bool simple);
+
+public:
+
 protected:
     /// <summary>
     /// Creates the physics actor.
@@ -7,7 +7,285 @@
 #include "Engine/Graphics/Async/GPUTask.h"
 #include "Engine/Graphics/Models/MeshBase.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ThreadPoolTask.h"
+#include "Engine/Threading/MainThreadTask.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Utilities/Crc.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// The maximum size of the in-memory cooked data cache (in bytes). Cache is flushed when it gets exceeded.
+#define COLLISION_COOKING_CACHE_MAX_MEMORY (32 * 1024 * 1024)
+
+// The version of the persistent cooked data cache files format (increment to invalidate the existing cache files).
+#define COLLISION_COOKING_CACHE_VERSION 1
+
+namespace
+{
+    struct CacheFileHeader
+    {
+        uint32 Version;
+        uint32 Size;
+        uint64 Key;
+    };
+
+    CriticalSection CacheLocker;
+    Dictionary<uint64, BytesContainer> CacheMemory;
+    int32 CacheMemorySize = 0;
+
+    String GetCacheFolder()
+    {
+#if USE_EDITOR
+        return Globals::ProjectCacheFolder / TEXT("CookedCollision");
+#else
+        return Globals::ProductLocalFolder / TEXT("Cache/CookedCollision");
+#endif
+    }
+
+    String GetCacheFile(uint64 key)
+    {
+        return GetCacheFolder() / String::Format(TEXT("{0:x}.bin"), key);
+    }
+
+    void AddToMemoryCache(uint64 key, const byte* data, int32 size)
+    {
+        if (size > COLLISION_COOKING_CACHE_MAX_MEMORY)
+            return;
+        if (CacheMemorySize + size > COLLISION_COOKING_CACHE_MAX_MEMORY)
+        {
+            CacheMemory.Clear();
+            CacheMemorySize = 0;
+        }
+        auto& entry = CacheMemory[key];
+        CacheMemorySize += size - entry.Length();
+        entry.Copy(data, size);
+    }
+}
+
+/// <summary>
+/// Async collision cooking task that gets the results to the main thread. Runs as a continuation of the thread pool task that performs the cooking.
+/// </summary>
+class CollisionCookingTask : public MainThreadTask
+{
+public:
+    enum class Modes
+    {
+        ConvexMesh,
+        TriangleMesh,
+        HeightField,
+        Collision,
+    };
+
+    Modes Mode;
+    CollisionCooking::CookingInput Input;
+    CollisionCooking::Argument Arg;
+    Array<byte> InputVertices;
+    Array<byte> InputIndices;
+    int32 HeightFieldCols = 0;
+    int32 HeightFieldRows = 0;
+    CollisionCooking::CookCallback Callback;
+    CollisionCooking::CookCollisionCallback CollisionCallback;
+    bool Failed = true;
+    CollisionData::SerializedOptions Options;
+    BytesContainer Output;
+
+    CollisionCookingTask(Modes mode)
+        : Mode(mode)
+    {
+        Platform::MemoryClear(&Options, sizeof(Options));
+    }
+
+    void CopyInput(const CollisionCooking::CookingInput& input)
+    {
+        Input = input;
+        InputVertices.Set((const byte*)input.VertexData, input.VertexCount * sizeof(Float3));
+        InputIndices.Set((const byte*)input.IndexData, input.IndexCount * (input.Is16bitIndexData ? sizeof(uint16) : sizeof(uint32)));
+        Input.VertexData = (Float3*)InputVertices.Get();
+        Input.IndexData = InputIndices.Get();
+    }
+
+    // Called on a thread pool
+    void Cook()
+    {
+        switch (Mode)
+        {
+        case Modes::ConvexMesh:
+            Failed = CollisionCooking::CookConvexMesh(Input, Output);
+            break;
+        case Modes::TriangleMesh:
+            Failed = CollisionCooking::CookTriangleMesh(Input, Output);
+            break;
+        case Modes::HeightField:
+        {
+            MemoryWriteStream stream;
+            Failed = CollisionCooking::CookHeightField(HeightFieldCols, HeightFieldRows, (const PhysicsBackend::HeightFieldSample*)InputVertices.Get(), stream);
+            if (!Failed)
+                Output.Copy(stream.GetHandle(), stream.GetPosition());
+            break;
+        }
+        case Modes::Collision:
+            Failed = CollisionCooking::CookCollision(Arg, Options, Output);
+            break;
+        }
+    }
+
+    // [MainThreadTask]
+    String ToString() const override
+    {
+        return TEXT("Collision cooking");
+    }
+
+protected:
+    // [MainThreadTask]
+    bool Run() override
+    {
+        if (Callback.IsBinded())
+            Callback(Failed, Output);
+        if (CollisionCallback.IsBinded())
+            CollisionCallback(Failed, Options, Output);
+        return false;
+    }
+};
+
+namespace
+{
+    Task* StartCookingTask(CollisionCookingTask* task)
+    {
+        // Cook on a thread pool and send the results to the main thread (cooking task always succeeds to keep the continuation running)
+        Function<void()> action;
+        action.Bind([task]
+        {
+            PROFILE_CPU_NAMED("CollisionCooking");
+            task->Cook();
+        });
+        auto cookTask = New<ThreadPoolActionTask>(action);
+        cookTask->ContinueWith(task);
+        cookTask->Start();
+        return cookTask;
+    }
+}
+
+bool CollisionCooking::UseCache = true;
+bool CollisionCooking::UsePersistentCache = true;
+
+Task* CollisionCooking::CookConvexMeshAsync(const CookingInput& input, const CookCallback& callback)
+{
+    auto task = New<CollisionCookingTask>(CollisionCookingTask::Modes::ConvexMesh);
+    task->CopyInput(input);
+    task->Callback = callback;
+    return StartCookingTask(task);
+}
+
+Task* CollisionCooking::CookTriangleMeshAsync(const CookingInput& input, const CookCallback& callback)
+{
+    auto task = New<CollisionCookingTask>(CollisionCookingTask::Modes::TriangleMesh);
+    task->CopyInput(input);
+    task->Callback = callback;
+    return StartCookingTask(task);
+}
+
+Task* CollisionCooking::CookHeightFieldAsync(int32 cols, int32 rows, const PhysicsBackend::HeightFieldSample* data, const CookCallback& callback)
+{
+    auto task = New<CollisionCookingTask>(CollisionCookingTask::Modes::HeightField);
+    task->HeightFieldCols = cols;
+    task->HeightFieldRows = rows;
+    task->InputVertices.Set((const byte*)data, cols * rows * sizeof(PhysicsBackend::HeightFieldSample));
+    task->Callback = callback;
+    return StartCookingTask(task);
+}
+
+Task* CollisionCooking::CookCollisionAsync(const Argument& arg, const CookCollisionCallback& callback)
+{
+    auto task = New<CollisionCookingTask>(CollisionCookingTask::Modes::Collision);
+    task->Arg = arg;
+    task->CollisionCallback = callback;
+    return StartCookingTask(task);
+}
+
+void CollisionCooking::ClearCache(bool persistent)
+{
+    ScopeLock lock(CacheLocker);
+    CacheMemory.Clear();
+    CacheMemorySize = 0;
+    if (persistent)
+    {
+        const String folder = GetCacheFolder();
+        if (FileSystem::DirectoryExists(folder))
+            FileSystem::DeleteDirectory(folder);
+    }
+}
+
+uint64 CollisionCooking::GetCacheKey(uint32 options, const void* data0, int32 size0, const void* data1, int32 size1)
+{
+    // Use two separate hashes to reduce the chance of collisions (data sizes are included too)
+    const uint32 hash0 = Crc::MemCrc32(data1, size1, Crc::MemCrc32(data0, size0, options));
+    const uint32 hash1 = Crc::MemCrc32(data0, size0, Crc::MemCrc32(&size1, sizeof(size1), (uint32)size0 ^ ~options));
+    return ((uint64)hash0 << 32) | hash1;
+}
+
+bool CollisionCooking::GetCache(uint64 key, BytesContainer& output)
+{
+    if (!UseCache)
+        return false;
+    {
+        ScopeLock lock(CacheLocker);
+        const BytesContainer* cached = CacheMemory.TryGet(key);
+        if (cached)
+        {
+            output.Copy(*cached);
+            return true;
+        }
+    }
+    if (UsePersistentCache)
+    {
+        const String path = GetCacheFile(key);
+        BytesContainer data;
+        if (FileSystem::FileExists(path) && !File::ReadAllBytes(path, data) && data.Length() >= sizeof(CacheFileHeader))
+        {
+            const auto header = (const CacheFileHeader*)data.Get();
+            if (header->Version == COLLISION_COOKING_CACHE_VERSION && header->Key == key && header->Size == data.Length() - sizeof(CacheFileHeader))
+            {
+                output.Copy(data.Get() + sizeof(CacheFileHeader), header->Size);
+                ScopeLock lock(CacheLocker);
+                AddToMemoryCache(key, output.Get(), output.Length());
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void CollisionCooking::SetCache(uint64 key, const byte* data, int32 size)
+{
+    if (!UseCache)
+        return;
+    {
+        ScopeLock lock(CacheLocker);
+        AddToMemoryCache(key, data, size);
+    }
+    if (UsePersistentCache)
+    {
+        const String folder = GetCacheFolder();
+        if (!FileSystem::DirectoryExists(folder) && FileSystem::CreateDirectory(folder))
+            return;
+        Array<byte> file;
+        file.Resize(sizeof(CacheFileHeader) + size);
+        const auto header = (CacheFileHeader*)file.Get();
+        header->Version = COLLISION_COOKING_CACHE_VERSION;
+        header->Size = size;
+        header->Key = key;
+        Platform::MemoryCopy(file.Get() + sizeof(CacheFileHeader), data, size);
+        if (File::WriteAllBytes(GetCacheFile(key), file))
+        {
+            LOG(Warning, "Failed to save cooked collision cache file.");
+        }
+    }
+}
 
 bool CollisionCooking::CookCollision(const Argument& arg, CollisionData::SerializedOptions& outputOptions, BytesContainer& outputData)
 {
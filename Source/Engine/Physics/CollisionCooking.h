@@ -5,6 +5,7 @@
 #if COMPILE_WITH_PHYSICS_COOKING
 
 #include "Engine/Core/Types/DataContainer.h"
+#include "Engine/Core/Delegate.h"
 #include "Engine/Physics/CollisionData.h"
 #include "Engine/Graphics/Models/ModelData.h"
 #include "Engine/Content/Assets/ModelBase.h"
@@ -13,6 +14,8 @@
 #define CONVEX_VERTEX_MIN 8
 #define CONVEX_VERTEX_MAX 255
 
+class Task;
+
 /// <summary>
 /// Physical collision data cooking tools. Allows to bake heightfield, convex and triangle mesh colliders data.
 /// </summary>
@@ -44,6 +47,28 @@ class CollisionCooking
         int32 ConvexVertexLimit = 255;
     };
 
+    /// <summary>
+    /// The async cooking completion callback. Called on the main thread with the failure state (true if cooking failed) and the cooked data.
+    /// </summary>
+    typedef Function<void(bool, BytesContainer&)> CookCallback;
+
+    /// <summary>
+    /// The async collision cooking completion callback. Called on the main thread with the failure state (true if cooking failed), the output options and the cooked data.
+    /// </summary>
+    typedef Function<void(bool, const CollisionData::SerializedOptions&, BytesContainer&)> CookCollisionCallback;
+
+public:
+    /// <summary>
+    /// True if reuse the results of cooking the same input data (eg. procedural geometry or terrain regenerated with the same settings). Cached data is kept in memory (with limited budget).
+    /// </summary>
+    static bool UseCache;
+
+    /// <summary>
+    /// True if store the cooked data cache in files (project cache in Editor, product local folder in game) so it's reused between the application runs. Used only if UseCache is enabled.
+    /// </summary>
+    static bool UsePersistentCache;
+
+public:
     /// <summary>
     /// Attempts to cook a convex mesh from the provided mesh data. Assumes the input data is valid and contains vertex
     /// positions. If the method returns false the resulting convex mesh will be in the output parameter.
@@ -80,6 +105,75 @@ class CollisionCooking
     /// <param name="outputData">The output data container.</param>
     /// <returns>True if failed, otherwise false.</returns>
     static bool CookCollision(const Argument& arg, CollisionData::SerializedOptions& outputOptions, BytesContainer& outputData);
+
+public:
+    /// <summary>
+    /// Starts the async cooking of a convex mesh on a thread pool. Input data is copied so it can be released after this call.
+    /// </summary>
+    /// <param name="input">The input.</param>
+    /// <param name="callback">The completion callback (called on the main thread).</param>
+    /// <returns>The started task or null if failed.</returns>
+    static Task* CookConvexMeshAsync(const CookingInput& input, const CookCallback& callback);
+
+    /// <summary>
+    /// Starts the async cooking of a triangle mesh on a thread pool. Input data is copied so it can be released after this call.
+    /// </summary>
+    /// <param name="input">The input.</param>
+    /// <param name="callback">The completion callback (called on the main thread).</param>
+    /// <returns>The started task or null if failed.</returns>
+    static Task* CookTriangleMeshAsync(const CookingInput& input, const CookCallback& callback);
+
+    /// <summary>
+    /// Starts the async cooking of a heightfield on a thread pool. Input data is copied so it can be released after this call.
+    /// </summary>
+    /// <param name="cols">The heightfield columns count.</param>
+    /// <param name="rows">The heightfield rows count.</param>
+    /// <param name="data">The heightfield data.</param>
+    /// <param name="callback">The completion callback (called on the main thread).</param>
+    /// <returns>The started task or null if failed.</returns>
+    static Task* CookHeightFieldAsync(int32 cols, int32 rows, const PhysicsBackend::HeightFieldSample* data, const CookCallback& callback);
+
+    /// <summary>
+    /// Starts the async cooking of the collision from the model on a thread pool.
+    /// </summary>
+    /// <param name="arg">The input argument descriptor. If OverrideModelData is used, then it has to be valid until the callback is called.</param>
+    /// <param name="callback">The completion callback (called on the main thread).</param>
+    /// <returns>The started task or null if failed.</returns>
+    static Task* CookCollisionAsync(const Argument& arg, const CookCollisionCallback& callback);
+
+public:
+    /// <summary>
+    /// Clears the cooked data cache.
+    /// </summary>
+    /// <param name="persistent">True if delete the cache files too, otherwise only in-memory cache will be cleared.</param>
+    static void ClearCache(bool persistent = false);
+
+    /// <summary>
+    /// Calculates the cooked data cache key for the given input data. Used by the physics backend cooking implementation.
+    /// </summary>
+    /// <param name="options">The cooking options (type and flags) hash.</param>
+    /// <param name="data0">The first input data.</param>
+    /// <param name="size0">The first input data size (in bytes).</param>
+    /// <param name="data1">The second input data (optional).</param>
+    /// <param name="size1">The second input data size (in bytes).</param>
+    /// <returns>The cache key.</returns>
+    static uint64 GetCacheKey(uint32 options, const void* data0, int32 size0, const void* data1 = nullptr, int32 size1 = 0);
+
+    /// <summary>
+    /// Tries to get the cooked data from the cache. Used by the physics backend cooking implementation.
+    /// </summary>
+    /// <param name="key">The cache key.</param>
+    /// <param name="output">The output data.</param>
+    /// <returns>True if found cached data, otherwise false.</returns>
+    static bool GetCache(uint64 key, BytesContainer& output);
+
+    /// <summary>
+    /// Stores the cooked data in the cache. Used by the physics backend cooking implementation.
+    /// </summary>
+    /// <param name="key">The cache key.</param>
+    /// <param name="data">The cooked data.</param>
+    /// <param name="size">The cooked data size (in bytes).</param>
+    static void SetCache(uint64 key, const byte* data, int32 size);
 };
 
 #endif
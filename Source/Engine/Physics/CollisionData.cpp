@@ -9,6 +9,7 @@
 #include "Engine/Physics/PhysicsBackend.h"
 #include "Engine/Physics/CollisionCooking.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Content/AssetReference.h"
 
 REGISTER_BINARY_ASSET(CollisionData, "FlaxEngine.CollisionData", true);
 
@@ -127,6 +128,48 @@ bool CollisionData::CookCollision(CollisionDataType type, ModelData* modelData,
     return false;
 }
 
+bool CollisionData::CookCollisionAsync(CollisionDataType type, const Span<Float3>& vertices, const Span<uint32>& triangles, ConvexMeshGenerationFlags convexFlags, int32 convexVertexLimit)
+{
+    CHECK_RETURN(vertices.Length() != 0, true);
+    CHECK_RETURN(triangles.Length() != 0 && triangles.Length() % 3 == 0, true);
+    if (!IsVirtual())
+    {
+        LOG(Warning, "Only virtual assets can be modified at runtime.");
+        return true;
+    }
+
+    // Copy geometry (owned by the cooking callback)
+    auto modelData = New<ModelData>();
+    modelData->LODs.Resize(1);
+    auto meshData = New<MeshData>();
+    modelData->LODs[0].Meshes.Add(meshData);
+    meshData->Positions.Set(vertices.Get(), vertices.Length());
+    meshData->Indices.Set(triangles.Get(), triangles.Length());
+
+    // Prepare
+    CollisionCooking::Argument arg;
+    arg.Type = type;
+    arg.OverrideModelData = modelData;
+    arg.ConvexFlags = convexFlags;
+    arg.ConvexVertexLimit = convexVertexLimit;
+
+    // Cook collision on a thread pool and load it on a main thread
+    AssetReference<CollisionData> asset(this);
+    CollisionCooking::CookCollisionCallback callback;
+    callback.Bind([asset, modelData](bool failed, const SerializedOptions& options, BytesContainer& outputData)
+    {
+        Delete(modelData);
+        CollisionData* collisionData = asset.Get();
+        if (failed || !collisionData)
+            return;
+        collisionData->unload(true);
+        if (collisionData->load(&options, outputData.Get(), outputData.Length()) != LoadResult::Ok)
+            return;
+        collisionData->onLoaded();
+    });
+    return CollisionCooking::CookCollisionAsync(arg, callback) == nullptr;
+}
+
 #endif
 
 bool CollisionData::GetModelTriangle(uint32 faceIndex, MeshBase*& mesh, uint32& meshTriangleIndex) const
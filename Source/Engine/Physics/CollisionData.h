@@ -244,6 +244,20 @@ API_CLASS(NoSpawn) class FLAXENGINE_API CollisionData : public BinaryAsset
     /// <returns>True if failed, otherwise false.</returns>
     bool CookCollision(CollisionDataType type, ModelData* modelData, ConvexMeshGenerationFlags convexFlags, int32 convexVertexLimit);
 
+    /// <summary>
+    /// Cooks the mesh collision data and updates the virtual asset asynchronously. Cooking runs on a thread pool and the asset is updated on the main thread once it's done (see Loaded event). Can be called from the main thread.
+    /// </summary>
+    /// <remarks>
+    /// Can be used only for virtual assets (see <see cref="Asset.IsVirtual"/> and <see cref="Content.CreateVirtualAsset{T}"/>).
+    /// </remarks>
+    /// <param name="type">The collision data type.</param>
+    /// <param name="vertices">The source geometry vertex buffer with vertices positions. Cannot be empty. Data is copied so it can be released after this call.</param>
+    /// <param name="triangles">The source data index buffer (triangles list). Uses 32-bit stride buffer. Cannot be empty. Length must be multiple of 3 (as 3 vertices build a triangle). Data is copied so it can be released after this call.</param>
+    /// <param name="convexFlags">The convex mesh generation flags.</param>
+    /// <param name="convexVertexLimit">The convex mesh vertex limit. Use values in range [8;255]</param>
+    /// <returns>True if failed to start cooking, otherwise false.</returns>
+    API_FUNCTION() bool CookCollisionAsync(CollisionDataType type, const Span<Float3>& vertices, const Span<uint32>& triangles, ConvexMeshGenerationFlags convexFlags = ConvexMeshGenerationFlags::None, int32 convexVertexLimit = 255);
+
 #endif
 
     /// <summary>
@@ -104,3 +104,22 @@ API_STRUCT() struct FLAXENGINE_API Collision
         Swap(ThisVelocity, OtherVelocity);
     }
 };
+
+/// <summary>
+/// Contains a trigger event data (the pair of the trigger and the collider that entered or exited it).
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API TriggerEvent
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(TriggerEvent);
+
+    /// <summary>
+    /// The trigger collider.
+    /// </summary>
+    API_FIELD() PhysicsColliderActor* Trigger;
+
+    /// <summary>
+    /// The other collider.
+    /// </summary>
+    API_FIELD() PhysicsColliderActor* Other;
+};
+
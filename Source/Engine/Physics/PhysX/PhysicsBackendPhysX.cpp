@@ -22,6 +22,7 @@
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Serialization/WriteStream.h"
 #include <ThirdParty/PhysX/PxPhysicsAPI.h>
 #include <ThirdParty/PhysX/PxQueryFiltering.h>
@@ -53,6 +54,9 @@
 // Temporary result buffer size
 #define PHYSX_HIT_BUFFER_SIZE	128
 
+// The amount of scene queries executed by a single job in the batched scene queries
+#define PHYSX_BATCH_QUERY_SIZE 64
+
 struct ActionDataPhysX
 {
     PhysicsBackend::ActionType Type;
@@ -92,6 +96,80 @@ class AllocatorPhysX : public PxAllocatorCallback
     }
 };
 
+class CpuDispatcherPhysX : public PxCpuDispatcher
+{
+private:
+    CriticalSection _locker;
+    Array<PxBaseTask*> _tasks;
+    int32 _workersRunning = 0;
+
+public:
+    uint32 WorkerCount;
+
+    explicit CpuDispatcherPhysX(uint32 workerCount)
+        : WorkerCount(workerCount)
+    {
+    }
+
+    ~CpuDispatcherPhysX()
+    {
+        // Wait for the workers to exit (they leave after the last task is done)
+        while (true)
+        {
+            _locker.Lock();
+            const bool running = _workersRunning != 0;
+            _locker.Unlock();
+            if (!running)
+                break;
+            Platform::Sleep(0);
+        }
+    }
+
+    void submitTask(PxBaseTask& task) override
+    {
+        // Run PhysX tasks on engine Job System to share the worker threads with other engine systems
+        // Tasks are queued and executed by up to WorkerCount jobs at once so physics never occupies more job threads than configured
+        _locker.Lock();
+        _tasks.Add(&task);
+        const bool startWorker = _workersRunning < (int32)WorkerCount;
+        if (startWorker)
+            _workersRunning++;
+        _locker.Unlock();
+        if (startWorker)
+        {
+            Function<void(int32)> func;
+            func.Bind<CpuDispatcherPhysX, &CpuDispatcherPhysX::Worker>(this);
+            JobSystem::Dispatch(func);
+        }
+    }
+
+    uint32_t getWorkerCount() const override
+    {
+        return WorkerCount;
+    }
+
+private:
+    void Worker(int32)
+    {
+        PROFILE_CPU_NAMED("PhysX.Worker");
+        while (true)
+        {
+            // Worker leaves only when the queue is empty (checked under the lock so any task submitted later starts a new worker)
+            PxBaseTask* task = nullptr;
+            _locker.Lock();
+            if (_tasks.HasItems())
+                task = _tasks.Pop();
+            else
+                _workersRunning--;
+            _locker.Unlock();
+            if (!task)
+                break;
+            task->run();
+            task->release();
+        }
+    }
+};
+
 class ErrorPhysX : public PxErrorCallback
 {
     void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
@@ -200,18 +278,6 @@ class CharacterControllerFilterPhysX : public PxControllerFilterCallback
     }
 };
 
-class WriteStreamPhysX : public PxOutputStream
-{
-public:
-    WriteStream* Stream;
-
-    uint32_t write(const void* src, uint32_t count) override
-    {
-        Stream->WriteBytes(src, (int32)count);
-        return count;
-    }
-};
-
 template<typename HitType>
 class DynamicHitBuffer : public PxHitCallback<HitType>
 {
@@ -343,6 +409,7 @@ namespace
 #endif
 #if COMPILE_WITH_PHYSICS_COOKING
     PxCooking* Cooking = nullptr;
+    PxCooking* CookingNoRemap = nullptr; // Uses suppressTriangleMeshRemapTable (separate instance to not modify cooking params while other threads cook)
 #endif
     PxMaterial* DefaultMaterial = nullptr;
     AllocatorPhysX AllocatorCallback;
@@ -545,8 +612,8 @@ void PhysicalMaterial::UpdatePhysicsMaterial()
 
 #if COMPILE_WITH_PHYSICS_COOKING
 
-#define ENSURE_CAN_COOK \
-    auto cooking = Cooking; \
+#define ENSURE_CAN_COOK(suppressRemapTable) \
+    auto cooking = suppressRemapTable ? CookingNoRemap : Cooking; \
     if (cooking == nullptr) \
 	{ \
 		LOG(Warning, "Physics collisions cooking is disabled at runtime. Enable Physics Settings option SupportCookingAtRuntime to use collision generation at runtime."); \
@@ -555,9 +622,12 @@ void PhysicalMaterial::UpdatePhysicsMaterial()
 
 bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& output)
 {
-    ENSURE_CAN_COOK;
+    ENSURE_CAN_COOK(EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable));
     if (input.VertexCount == 0)
         LOG(Warning, "Empty mesh data for collision cooking.");
+    const uint64 cacheKey = GetCacheKey((uint32)CollisionDataType::ConvexMesh | ((uint32)input.ConvexFlags << 8) | ((uint32)input.ConvexVertexLimit << 16), input.VertexData, input.VertexCount * sizeof(Float3));
+    if (GetCache(cacheKey, output))
+        return false;
 
     // Init options
     PxConvexMeshDesc desc;
@@ -577,9 +647,6 @@ bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& outpu
         desc.flags |= PxConvexFlag::Enum::eFAST_INERTIA_COMPUTATION;
     if (EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::ShiftVertices))
         desc.flags |= PxConvexFlag::Enum::eSHIFT_VERTICES;
-    PxCookingParams cookingParams = cooking->getParams();
-    cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
@@ -592,15 +659,20 @@ bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& outpu
 
     // Copy result
     output.Copy(outputStream.getData(), outputStream.getSize());
+    SetCache(cacheKey, output.Get(), output.Length());
 
     return false;
 }
 
 bool CollisionCooking::CookTriangleMesh(CookingInput& input, BytesContainer& output)
 {
-    ENSURE_CAN_COOK;
+    ENSURE_CAN_COOK(EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable));
     if (input.VertexCount == 0 || input.IndexCount == 0)
         LOG(Warning, "Empty mesh data for collision cooking.");
+    const int32 indexStride = input.Is16bitIndexData ? sizeof(uint16) : sizeof(uint32);
+    const uint64 cacheKey = GetCacheKey((uint32)CollisionDataType::TriangleMesh | ((uint32)input.ConvexFlags << 8) | ((uint32)indexStride << 16), input.VertexData, input.VertexCount * sizeof(Float3), input.IndexData, input.IndexCount * indexStride);
+    if (GetCache(cacheKey, output))
+        return false;
 
     // Init options
     PxTriangleMeshDesc desc;
@@ -608,12 +680,9 @@ bool CollisionCooking::CookTriangleMesh(CookingInput& input, BytesContainer& out
     desc.points.stride = sizeof(Float3);
     desc.points.data = input.VertexData;
     desc.triangles.count = input.IndexCount / 3;
-    desc.triangles.stride = 3 * (input.Is16bitIndexData ? sizeof(uint16) : sizeof(uint32));
+    desc.triangles.stride = 3 * indexStride;
     desc.triangles.data = input.IndexData;
     desc.flags = input.Is16bitIndexData ? PxMeshFlag::e16_BIT_INDICES : (PxMeshFlag::Enum)0;
-    PxCookingParams cookingParams = cooking->getParams();
-    cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
@@ -626,13 +695,21 @@ bool CollisionCooking::CookTriangleMesh(CookingInput& input, BytesContainer& out
 
     // Copy result
     output.Copy(outputStream.getData(), outputStream.getSize());
+    SetCache(cacheKey, output.Get(), output.Length());
 
     return false;
 }
 
 bool CollisionCooking::CookHeightField(int32 cols, int32 rows, const PhysicsBackend::HeightFieldSample* data, WriteStream& stream)
 {
-    ENSURE_CAN_COOK;
+    ENSURE_CAN_COOK(false);
+    const uint64 cacheKey = GetCacheKey(((uint32)cols << 16) | (uint32)rows, data, cols * rows * sizeof(PhysicsBackend::HeightFieldSample));
+    BytesContainer cached;
+    if (GetCache(cacheKey, cached))
+    {
+        stream.WriteBytes(cached.Get(), cached.Length());
+        return false;
+    }
 
     PxHeightFieldDesc heightFieldDesc;
     heightFieldDesc.format = PxHeightFieldFormat::eS16_TM;
@@ -642,13 +719,14 @@ bool CollisionCooking::CookHeightField(int32 cols, int32 rows, const PhysicsBack
     heightFieldDesc.samples.data = data;
     heightFieldDesc.samples.stride = sizeof(PhysicsBackend::HeightFieldSample);
 
-    WriteStreamPhysX outputStream;
-    outputStream.Stream = &stream;
-    if (!Cooking->cookHeightField(heightFieldDesc, outputStream))
+    PxDefaultMemoryOutputStream outputStream;
+    if (!cooking->cookHeightField(heightFieldDesc, outputStream))
     {
         LOG(Warning, "Height Field collision cooking failed.");
         return true;
     }
+    stream.WriteBytes(outputStream.getData(), outputStream.getSize());
+    SetCache(cacheKey, outputStream.getData(), outputStream.getSize());
     return false;
 }
 
@@ -725,6 +803,9 @@ bool PhysicsBackend::Init()
         cookingParams.meshPreprocessParams = PxMeshPreprocessingFlags(PxMeshPreprocessingFlag::eWELD_VERTICES);
         Cooking = PxCreateCooking(PX_PHYSICS_VERSION, *Foundation, cookingParams);
         CHECK_INIT(Cooking, "PxCreateCooking failed!");
+        cookingParams.suppressTriangleMeshRemapTable = true;
+        CookingNoRemap = PxCreateCooking(PX_PHYSICS_VERSION, *Foundation, cookingParams);
+        CHECK_INIT(CookingNoRemap, "PxCreateCooking failed!");
     }
 #endif
 
@@ -773,6 +854,7 @@ void PhysicsBackend::Shutdown()
     }
 #endif
 #if COMPILE_WITH_PHYSICS_COOKING
+    RELEASE_PHYSX(CookingNoRemap);
     RELEASE_PHYSX(Cooking);
 #endif
     if (PhysX)
@@ -831,8 +913,17 @@ void* PhysicsBackend::CreateScene(const PhysicsSettings& settings)
     sceneDesc.bounceThresholdVelocity = settings.BounceThresholdVelocity;
     if (sceneDesc.cpuDispatcher == nullptr)
     {
-        scenePhysX->CpuDispatcher = PxDefaultCpuDispatcherCreate(Math::Clamp<uint32>(Platform::GetCPUInfo().ProcessorCoreCount - 1, 1, 4));
-        CHECK_INIT(scenePhysX->CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
+        const int32 jobThreadsCount = JobSystem::GetThreadsCount();
+        if (jobThreadsCount > 0)
+        {
+            int32 workerCount = settings.WorkerThreadsCount > 0 ? Math::Min(settings.WorkerThreadsCount, jobThreadsCount) : jobThreadsCount;
+            scenePhysX->CpuDispatcher = New<CpuDispatcherPhysX>((uint32)workerCount);
+        }
+        else
+        {
+            scenePhysX->CpuDispatcher = PxDefaultCpuDispatcherCreate(Math::Clamp<uint32>(Platform::GetCPUInfo().ProcessorCoreCount - 1, 1, 4));
+            CHECK_INIT(scenePhysX->CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
+        }
         sceneDesc.cpuDispatcher = scenePhysX->CpuDispatcher;
     }
 
@@ -913,6 +1004,18 @@ void PhysicsBackend::StartSimulateScene(void* scene, float dt)
     scenePhysX->Stepper.renderDone();
 }
 
+void PhysicsBackend::LockSceneQueries(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->Stepper.lockQueries();
+}
+
+void PhysicsBackend::UnlockSceneQueries(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->Stepper.unlockQueries();
+}
+
 void PhysicsBackend::EndSimulateScene(void* scene)
 {
     auto scenePhysX = (ScenePhysX*)scene;
@@ -1248,8 +1351,12 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         PROFILE_CPU_NAMED("Physics.SendEvents");
 
         scenePhysX->EventsCallback.CollectResults();
-        scenePhysX->EventsCallback.SendTriggerEvents();
-        scenePhysX->EventsCallback.SendCollisionEvents();
+        scenePhysX->EventsCallback.CollectBatchedEvents();
+        if (scenePhysX->EventsCallback.ColliderEvents)
+        {
+            scenePhysX->EventsCallback.SendTriggerEvents();
+            scenePhysX->EventsCallback.SendCollisionEvents();
+        }
         scenePhysX->EventsCallback.SendJointEvents();
     }
 }
@@ -1290,6 +1397,40 @@ void PhysicsBackend::SetSceneBounceThresholdVelocity(void* scene, float value)
     scenePhysX->Scene->setBounceThresholdVelocity(value);
 }
 
+bool PhysicsBackend::GetSceneColliderEvents(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    return scenePhysX->EventsCallback.ColliderEvents;
+}
+
+void PhysicsBackend::SetSceneColliderEvents(void* scene, bool value)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->EventsCallback.ColliderEvents = value;
+}
+
+uint32 PhysicsBackend::GetSceneBatchedEventsLayerMask(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    return scenePhysX->EventsCallback.BatchedEventsLayerMask;
+}
+
+void PhysicsBackend::SetSceneBatchedEventsLayerMask(void* scene, uint32 value)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->EventsCallback.BatchedEventsLayerMask = value;
+}
+
+void PhysicsBackend::GetSceneBatchedEvents(void* scene, Span<Collision>& collisionEnter, Span<Collision>& collisionExit, Span<TriggerEvent>& triggerEnter, Span<TriggerEvent>& triggerExit)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    const auto& events = scenePhysX->EventsCallback;
+    collisionEnter = ToSpan(events.BatchedCollisionEnter.Get(), events.BatchedCollisionEnter.Count());
+    collisionExit = ToSpan(events.BatchedCollisionExit.Get(), events.BatchedCollisionExit.Count());
+    triggerEnter = ToSpan(events.BatchedTriggerEnter.Get(), events.BatchedTriggerEnter.Count());
+    triggerExit = ToSpan(events.BatchedTriggerExit.Get(), events.BatchedTriggerExit.Count());
+}
+
 void PhysicsBackend::SetSceneOrigin(void* scene, const Vector3& oldOrigin, const Vector3& newOrigin)
 {
     auto scenePhysX = (ScenePhysX*)scene;
@@ -1609,6 +1750,187 @@ bool PhysicsBackend::OverlapConvex(void* scene, const Vector3& center, const Col
     return true;
 }
 
+namespace
+{
+    // Shared state of the batched scene query split into ranges (executed by the calling thread and the helper jobs)
+    struct BatchQueryJob
+    {
+        int64 RefCount;
+        int64 NextRange;
+        int64 RangesDone;
+        int64 Hits;
+        int32 RangesCount;
+        int32 QueriesCount;
+        Function<int32(int32, int32)> Process;
+
+        void Release()
+        {
+            if (Platform::InterlockedDecrement(&RefCount) == 0)
+                Delete(this);
+        }
+    };
+
+    void ProcessBatchQueryRanges(BatchQueryJob* job)
+    {
+        int64 range;
+        while ((range = Platform::InterlockedIncrement(&job->NextRange) - 1) < job->RangesCount)
+        {
+            const int32 start = (int32)range * PHYSX_BATCH_QUERY_SIZE;
+            const int32 end = Math::Min(start + PHYSX_BATCH_QUERY_SIZE, job->QueriesCount);
+            const int32 hits = job->Process(start, end);
+            Platform::InterlockedAdd(&job->Hits, hits);
+            Platform::InterlockedIncrement(&job->RangesDone);
+        }
+    }
+
+    template<typename ProcessFunc>
+    int32 ExecuteBatchQuery(int32 count, const ProcessFunc& process)
+    {
+        const int32 rangesCount = (count + PHYSX_BATCH_QUERY_SIZE - 1) / PHYSX_BATCH_QUERY_SIZE;
+        const int32 helpersCount = Math::Min(rangesCount, JobSystem::GetThreadsCount()) - 1;
+        if (helpersCount <= 0)
+            return process(0, count);
+
+        // Process ranges on this thread and in the helper jobs (ranges are claimed by any thread that is free so it never waits for the job to start, eg. when called from the other job)
+        auto job = New<BatchQueryJob>();
+        job->RefCount = helpersCount + 1;
+        job->NextRange = 0;
+        job->RangesDone = 0;
+        job->Hits = 0;
+        job->RangesCount = rangesCount;
+        job->QueriesCount = count;
+        job->Process.Bind(process);
+        JobSystem::Dispatch([job](int32)
+        {
+            ProcessBatchQueryRanges(job);
+            job->Release();
+        }, helpersCount);
+        ProcessBatchQueryRanges(job);
+        while (Platform::AtomicRead(&job->RangesDone) < rangesCount)
+            Platform::Sleep(0);
+        const int32 result = (int32)Platform::AtomicRead(&job->Hits);
+        job->Release();
+        return result;
+    }
+}
+
+int32 PhysicsBackend::RayCastBatch(void* scene, const Span<RayCastQuery>& queries, Span<RayCastHit> results)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    if (scene == nullptr || queries.Length() == 0)
+        return 0;
+    ASSERT(results.Length() >= queries.Length());
+    PROFILE_CPU();
+    RayCastHit* hitsInfo = results.Get();
+    return ExecuteBatchQuery(queries.Length(), [scenePhysX, &queries, hitsInfo](int32 start, int32 end)
+    {
+        const PxHitFlags hitFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL | PxHitFlag::eUV;
+        PxQueryFilterData filterData;
+        filterData.flags |= PxQueryFlag::ePREFILTER;
+        filterData.data.word1 = 1;
+        int32 hits = 0;
+        for (int32 i = start; i < end; i++)
+        {
+            const RayCastQuery& query = queries[i];
+            RayCastHit& hitInfo = hitsInfo[i];
+            filterData.data.word0 = query.LayerMask;
+            filterData.data.word2 = query.HitTriggers ? 1 : 0;
+            PxRaycastBuffer buffer;
+            if (scenePhysX->Scene->raycast(C2P(query.Origin - scenePhysX->Origin), C2P(query.Direction), query.MaxDistance, buffer, hitFlags, filterData, &QueryFilter))
+            {
+                SCENE_QUERY_COLLECT_SINGLE();
+                hits++;
+            }
+            else
+            {
+                hitInfo = RayCastHit();
+            }
+        }
+        return hits;
+    });
+}
+
+int32 PhysicsBackend::SphereCastBatch(void* scene, const Span<SphereCastQuery>& queries, Span<RayCastHit> results)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    if (scene == nullptr || queries.Length() == 0)
+        return 0;
+    ASSERT(results.Length() >= queries.Length());
+    PROFILE_CPU();
+    RayCastHit* hitsInfo = results.Get();
+    return ExecuteBatchQuery(queries.Length(), [scenePhysX, &queries, hitsInfo](int32 start, int32 end)
+    {
+        const PxHitFlags hitFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL | PxHitFlag::eUV;
+        PxQueryFilterData filterData;
+        filterData.flags |= PxQueryFlag::ePREFILTER;
+        filterData.data.word1 = 1;
+        int32 hits = 0;
+        for (int32 i = start; i < end; i++)
+        {
+            const SphereCastQuery& query = queries[i];
+            RayCastHit& hitInfo = hitsInfo[i];
+            filterData.data.word0 = query.LayerMask;
+            filterData.data.word2 = query.HitTriggers ? 1 : 0;
+            PxSweepBufferN<1> buffer;
+            const PxTransform pose(C2P(query.Center - scenePhysX->Origin));
+            const PxSphereGeometry geometry(query.Radius);
+            if (scenePhysX->Scene->sweep(geometry, pose, C2P(query.Direction), query.MaxDistance, buffer, hitFlags, filterData, &QueryFilter))
+            {
+                SCENE_QUERY_COLLECT_SINGLE();
+                hits++;
+            }
+            else
+            {
+                hitInfo = RayCastHit();
+            }
+        }
+        return hits;
+    });
+}
+
+int32 PhysicsBackend::OverlapSphereBatch(void* scene, const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    if (scene == nullptr || queries.Length() == 0 || maxResultsPerQuery <= 0)
+        return 0;
+    ASSERT(results.Length() >= queries.Length() * maxResultsPerQuery && resultsCounts.Length() >= queries.Length());
+    PROFILE_CPU();
+    PhysicsColliderActor** resultsPtr = results.Get();
+    int32* resultsCountsPtr = resultsCounts.Get();
+    return ExecuteBatchQuery(queries.Length(), [scenePhysX, &queries, resultsPtr, resultsCountsPtr, maxResultsPerQuery](int32 start, int32 end)
+    {
+        PxQueryFilterData filterData;
+        filterData.flags |= PxQueryFlag::ePREFILTER;
+        filterData.data.word1 = 0;
+        PxOverlapHit touches[PHYSX_HIT_BUFFER_SIZE];
+        const PxU32 touchesCount = Math::Min(maxResultsPerQuery, PHYSX_HIT_BUFFER_SIZE);
+        int32 hits = 0;
+        for (int32 i = start; i < end; i++)
+        {
+            const OverlapSphereQuery& query = queries[i];
+            PhysicsColliderActor** queryResults = resultsPtr + i * maxResultsPerQuery;
+            filterData.data.word0 = query.LayerMask;
+            filterData.data.word2 = query.HitTriggers ? 1 : 0;
+            PxOverlapBuffer buffer(touches, touchesCount);
+            const PxTransform pose(C2P(query.Center - scenePhysX->Origin));
+            const PxSphereGeometry geometry(query.Radius);
+            int32 count = 0;
+            if (scenePhysX->Scene->overlap(geometry, pose, buffer, filterData, &QueryFilter))
+            {
+                count = (int32)buffer.getNbTouches();
+                for (int32 j = 0; j < count; j++)
+                {
+                    const auto& hit = buffer.getTouch(j);
+                    queryResults[j] = hit.shape ? static_cast<PhysicsColliderActor*>(hit.shape->userData) : nullptr;
+                }
+            }
+            resultsCountsPtr[i] = count;
+            hits += count;
+        }
+        return hits;
+    });
+}
+
 PhysicsBackend::ActorFlags PhysicsBackend::GetActorFlags(void* actor)
 {
     auto actorPhysX = (PxActor*)actor;
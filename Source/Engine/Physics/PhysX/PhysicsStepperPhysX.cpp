@@ -5,6 +5,7 @@
 #include "PhysicsStepperPhysX.h"
 #include "Engine/Physics/Physics.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Platform/Platform.h"
 #include <ThirdParty/PhysX/foundation/PxMath.h>
 #include <ThirdParty/PhysX/PxSceneLock.h>
 
@@ -59,10 +60,15 @@ void MultiThreadStepper::substepDone(StepperTask* ownerTask)
     // -> OnSubstepPreFetchResult
 
     {
+        // Wait for the scene queries executed from the other threads (fetching results updates the scene query structures)
+        Platform::AtomicStore(&mQueryFetching, 1);
+        while (Platform::AtomicRead(&mQueryReaders) != 0)
+            Platform::Sleep(0);
 #ifndef PX_PROFILE
 		PxSceneWriteLock writeLock(*mScene);
 #endif
         mScene->fetchResults(true);
+        Platform::AtomicStore(&mQueryFetching, 0);
     }
 
     // -> OnSubstep
@@ -85,6 +91,24 @@ void MultiThreadStepper::substepDone(StepperTask* ownerTask)
     }
 }
 
+void MultiThreadStepper::lockQueries()
+{
+    while (true)
+    {
+        while (Platform::AtomicRead(&mQueryFetching) != 0)
+            Platform::Sleep(0);
+        Platform::InterlockedIncrement(&mQueryReaders);
+        if (Platform::AtomicRead(&mQueryFetching) == 0)
+            break;
+        Platform::InterlockedDecrement(&mQueryReaders);
+    }
+}
+
+void MultiThreadStepper::unlockQueries()
+{
+    Platform::InterlockedDecrement(&mQueryReaders);
+}
+
 void MultiThreadStepper::renderDone()
 {
     if (mFirstCompletionPending)
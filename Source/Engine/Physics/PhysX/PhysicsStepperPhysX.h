@@ -126,6 +126,10 @@ class MultiThreadStepper : public PhysicsStepper
         return mSubStepSize;
     }
 
+    // Locks the scene for the queries executed from the other threads during the simulation (substeps wait with the results fetching until queries end)
+    void lockQueries();
+    void unlockQueries();
+
 protected:
     void substep(StepperTask& completionTask);
 
@@ -142,6 +146,9 @@ class MultiThreadStepper : public PhysicsStepper
     PxReal mSubStepSize;
     void* mScratchBlock;
     PxU32 mScratchBlockSize;
+
+    volatile int64 mQueryReaders = 0;
+    volatile int64 mQueryFetching = 0;
 };
 
 // The way this should be called is:
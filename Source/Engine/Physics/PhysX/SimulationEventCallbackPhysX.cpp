@@ -36,6 +36,29 @@ namespace
             }
         }
     }
+
+    void ClearColliderFromCollection(PhysicsColliderActor* collider, Array<Collision>& collection)
+    {
+        for (int32 i = 0; i < collection.Count(); i++)
+        {
+            if (collection[i].ThisActor == collider || collection[i].OtherActor == collider)
+                collection.RemoveAt(i--);
+        }
+    }
+
+    void ClearColliderFromCollection(PhysicsColliderActor* collider, Array<TriggerEvent>& collection)
+    {
+        for (int32 i = 0; i < collection.Count(); i++)
+        {
+            if (collection[i].Trigger == collider || collection[i].Other == collider)
+                collection.RemoveAt(i--);
+        }
+    }
+
+    FORCE_INLINE bool IsBatchedEvent(const SimulationEventCallback::CollidersPair& pair, uint32 layerMask)
+    {
+        return ((uint32)pair.First->GetLayerMask() & layerMask) != 0 || ((uint32)pair.Second->GetLayerMask() & layerMask) != 0;
+    }
 }
 
 void SimulationEventCallback::Clear()
@@ -110,6 +133,43 @@ void SimulationEventCallback::SendTriggerEvents()
     }
 }
 
+void SimulationEventCallback::CollectBatchedEvents()
+{
+    // Batched events stay valid until the next simulation results are collected (they are not cleared when simulation starts)
+    BatchedCollisionEnter.Clear();
+    BatchedCollisionExit.Clear();
+    BatchedTriggerEnter.Clear();
+    BatchedTriggerExit.Clear();
+    const uint32 layerMask = BatchedEventsLayerMask;
+    if (layerMask == 0)
+        return;
+
+    for (int32 i = 0; i < RemovedCollisions.Count(); i++)
+    {
+        const auto pair = RemovedCollisions[i];
+        if (IsBatchedEvent(pair, layerMask))
+            BatchedCollisionExit.Add(PrevCollisions[pair]);
+    }
+    for (int32 i = 0; i < NewCollisions.Count(); i++)
+    {
+        const auto pair = NewCollisions[i];
+        if (IsBatchedEvent(pair, layerMask))
+            BatchedCollisionEnter.Add(Collisions[pair]);
+    }
+    for (int32 i = 0; i < LostTriggerPairs.Count(); i++)
+    {
+        const auto pair = LostTriggerPairs[i];
+        if (IsBatchedEvent(pair, layerMask))
+            BatchedTriggerExit.Add({ pair.First, pair.Second });
+    }
+    for (int32 i = 0; i < NewTriggerPairs.Count(); i++)
+    {
+        const auto pair = NewTriggerPairs[i];
+        if (IsBatchedEvent(pair, layerMask))
+            BatchedTriggerEnter.Add({ pair.First, pair.Second });
+    }
+}
+
 void SimulationEventCallback::SendJointEvents()
 {
     for (auto* actor : BrokenJoints)
@@ -125,6 +185,10 @@ void SimulationEventCallback::OnColliderRemoved(PhysicsColliderActor* collider)
     ClearColliderFromCollection(collider, RemovedCollisions);
     ClearColliderFromCollection(collider, NewTriggerPairs);
     ClearColliderFromCollection(collider, LostTriggerPairs);
+    ClearColliderFromCollection(collider, BatchedCollisionEnter);
+    ClearColliderFromCollection(collider, BatchedCollisionExit);
+    ClearColliderFromCollection(collider, BatchedTriggerEnter);
+    ClearColliderFromCollection(collider, BatchedTriggerExit);
 }
 
 void SimulationEventCallback::OnJointRemoved(Joint* joint)
@@ -55,6 +55,36 @@ class SimulationEventCallback : public PxSimulationEventCallback
     /// </summary>
     Array<Joint*> BrokenJoints;
 
+    /// <summary>
+    /// The batched collision enter events (filtered with BatchedEventsLayerMask).
+    /// </summary>
+    Array<Collision> BatchedCollisionEnter;
+
+    /// <summary>
+    /// The batched collision exit events (filtered with BatchedEventsLayerMask).
+    /// </summary>
+    Array<Collision> BatchedCollisionExit;
+
+    /// <summary>
+    /// The batched trigger enter events (filtered with BatchedEventsLayerMask).
+    /// </summary>
+    Array<TriggerEvent> BatchedTriggerEnter;
+
+    /// <summary>
+    /// The batched trigger exit events (filtered with BatchedEventsLayerMask).
+    /// </summary>
+    Array<TriggerEvent> BatchedTriggerExit;
+
+    /// <summary>
+    /// The layer mask used to filter the batched events. Batched events are not collected if it's 0.
+    /// </summary>
+    uint32 BatchedEventsLayerMask = 0;
+
+    /// <summary>
+    /// True if send collision and trigger events to the colliders.
+    /// </summary>
+    bool ColliderEvents = true;
+
 public:
     /// <summary>
     /// Clears the data.
@@ -81,6 +111,11 @@ class SimulationEventCallback : public PxSimulationEventCallback
     /// </summary>
     void SendJointEvents();
 
+    /// <summary>
+    /// Generates the batched events from the collisions and trigger pairs.
+    /// </summary>
+    void CollectBatchedEvents();
+
     /// <summary>
     /// Called when collider gets removed so all cached events should be removed for this object.
     /// Prevents sending events and using deleted objects.
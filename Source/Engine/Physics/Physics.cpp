@@ -8,8 +8,10 @@
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 
 PhysicsScene* Physics::DefaultScene = nullptr;
 Array<PhysicsScene*> Physics::Scenes;
@@ -21,6 +23,7 @@ class PhysicsService : public EngineService
     PhysicsService()
         : EngineService(TEXT("Physics"), 0)
     {
+        ParallelInit = true;
         for (int32 i = 0; i < 32; i++)
             Physics::LayerMasks[i] = MAX_uint32;
     }
@@ -57,6 +60,7 @@ void PhysicsSettings::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(RestitutionCombineMode);
     DESERIALIZE(DisableCCD);
     DESERIALIZE(EnableAdaptiveForce);
+    DESERIALIZE(WorkerThreadsCount);
     DESERIALIZE(MaxDeltaTime);
     DESERIALIZE(EnableSubstepping);
     DESERIALIZE(SubstepDeltaTime);
@@ -192,6 +196,9 @@ void Physics::SetBounceThresholdVelocity(const float value)
 
 void Physics::Simulate(float dt)
 {
+    PROFILE_MEM(Physics);
+
+    // Start all scenes first so they simulate in parallel on the Job System (results are collected later in CollectResults)
     for (PhysicsScene* scene : Scenes)
     {
         if (scene->GetAutoSimulation())
@@ -201,8 +208,14 @@ void Physics::Simulate(float dt)
 
 void Physics::CollectResults()
 {
-    if (DefaultScene)
-        DefaultScene->CollectResults();
+    PROFILE_MEM(Physics);
+
+    // Collect results of all automatically simulated scenes (scenes simulated from code need to collect results manually)
+    for (PhysicsScene* scene : Scenes)
+    {
+        if (scene == DefaultScene || scene->GetAutoSimulation())
+            scene->CollectResults();
+    }
 }
 
 bool Physics::IsDuringSimulation()
@@ -210,6 +223,12 @@ bool Physics::IsDuringSimulation()
     return DefaultScene && DefaultScene->IsDuringSimulation();
 }
 
+void Physics::DispatchQueries(const Function<void(int32)>& job, int32 jobCount)
+{
+    if (DefaultScene)
+        DefaultScene->DispatchQueries(job, jobCount);
+}
+
 void Physics::FlushRequests()
 {
     PROFILE_CPU_NAMED("Physics.FlushRequests");
@@ -323,6 +342,24 @@ bool Physics::OverlapSphere(const Vector3& center, const float radius, Array<Col
     return DefaultScene->OverlapSphere(center, radius, results, layerMask, hitTriggers);
 }
 
+int32 Physics::OverlapBox(const Vector3& center, const Vector3& halfExtents, Span<Collider*> results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers)
+{
+    Array<Collider*> hits;
+    DefaultScene->OverlapBox(center, halfExtents, hits, rotation, layerMask, hitTriggers);
+    const int32 count = Math::Min(hits.Count(), results.Length());
+    Platform::MemoryCopy(results.Get(), hits.Get(), count * sizeof(Collider*));
+    return count;
+}
+
+int32 Physics::OverlapSphere(const Vector3& center, const float radius, Span<Collider*> results, uint32 layerMask, bool hitTriggers)
+{
+    Array<Collider*> hits;
+    DefaultScene->OverlapSphere(center, radius, hits, layerMask, hitTriggers);
+    const int32 count = Math::Min(hits.Count(), results.Length());
+    Platform::MemoryCopy(results.Get(), hits.Get(), count * sizeof(Collider*));
+    return count;
+}
+
 bool Physics::OverlapCapsule(const Vector3& center, const float radius, const float height, Array<Collider*>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers)
 {
     return DefaultScene->OverlapCapsule(center, radius, height, results, rotation, layerMask, hitTriggers);
@@ -353,6 +390,21 @@ bool Physics::OverlapConvex(const Vector3& center, const CollisionData* convexMe
     return DefaultScene->OverlapConvex(center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
 
+int32 Physics::RayCastBatch(const Span<RayCastQuery>& queries, Span<RayCastHit> results)
+{
+    return DefaultScene->RayCastBatch(queries, results);
+}
+
+int32 Physics::SphereCastBatch(const Span<SphereCastQuery>& queries, Span<RayCastHit> results)
+{
+    return DefaultScene->SphereCastBatch(queries, results);
+}
+
+int32 Physics::OverlapSphereBatch(const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery)
+{
+    return DefaultScene->OverlapSphereBatch(queries, results, resultsCounts, maxResultsPerQuery);
+}
+
 PhysicsScene::PhysicsScene(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -409,6 +461,42 @@ void PhysicsScene::SetBounceThresholdVelocity(float value)
     PhysicsBackend::SetSceneBounceThresholdVelocity(_scene, value);
 }
 
+bool PhysicsScene::GetColliderEvents() const
+{
+    return PhysicsBackend::GetSceneColliderEvents(_scene);
+}
+
+void PhysicsScene::SetColliderEvents(bool value)
+{
+    PhysicsBackend::SetSceneColliderEvents(_scene, value);
+}
+
+uint32 PhysicsScene::GetBatchedEventsLayerMask() const
+{
+    return PhysicsBackend::GetSceneBatchedEventsLayerMask(_scene);
+}
+
+void PhysicsScene::SetBatchedEventsLayerMask(uint32 value)
+{
+    PhysicsBackend::SetSceneBatchedEventsLayerMask(_scene, value);
+}
+
+void PhysicsScene::GetBatchedEvents(Span<Collision>& collisionEnter, Span<Collision>& collisionExit, Span<TriggerEvent>& triggerEnter, Span<TriggerEvent>& triggerExit) const
+{
+    PhysicsBackend::GetSceneBatchedEvents(_scene, collisionEnter, collisionExit, triggerEnter, triggerExit);
+}
+
+void PhysicsScene::GetBatchedEvents(Array<Collision>& collisionEnter, Array<Collision>& collisionExit, Array<TriggerEvent>& triggerEnter, Array<TriggerEvent>& triggerExit) const
+{
+    Span<Collision> collisionEnterSpan, collisionExitSpan;
+    Span<TriggerEvent> triggerEnterSpan, triggerExitSpan;
+    PhysicsBackend::GetSceneBatchedEvents(_scene, collisionEnterSpan, collisionExitSpan, triggerEnterSpan, triggerExitSpan);
+    collisionEnter.Set(collisionEnterSpan.Get(), collisionEnterSpan.Length());
+    collisionExit.Set(collisionExitSpan.Get(), collisionExitSpan.Length());
+    triggerEnter.Set(triggerEnterSpan.Get(), triggerEnterSpan.Length());
+    triggerExit.Set(triggerExitSpan.Get(), triggerExitSpan.Length());
+}
+
 void PhysicsScene::SetOrigin(const Vector3& value)
 {
     if (_origin != value)
@@ -434,6 +522,13 @@ void PhysicsScene::Simulate(float dt)
     ASSERT(IsInMainThread() && !_isDuringSimulation);
     _isDuringSimulation = true;
     PhysicsBackend::StartSimulateScene(_scene, dt);
+
+    // Start the pending scene query jobs (gameplay code doesn't modify physics objects until simulation results are collected)
+    ScopeLock lock(_queryJobsLocker);
+    _queryJobsRunning = true;
+    for (const QueryJob& job : _queryJobs)
+        DispatchQueryJob(job);
+    _queryJobs.Clear();
 }
 
 bool PhysicsScene::IsDuringSimulation() const
@@ -443,6 +538,7 @@ bool PhysicsScene::IsDuringSimulation() const
 
 void PhysicsScene::CollectResults()
 {
+    FlushQueryJobs();
     if (!_isDuringSimulation)
         return;
     ASSERT(IsInMainThread());
@@ -450,6 +546,53 @@ void PhysicsScene::CollectResults()
     _isDuringSimulation = false;
 }
 
+void PhysicsScene::DispatchQueries(const Function<void(int32)>& job, int32 jobCount)
+{
+    if (jobCount <= 0 || !job.IsBinded())
+        return;
+    QueryJob queryJob;
+    queryJob.Job = job;
+    queryJob.JobCount = jobCount;
+    ScopeLock lock(_queryJobsLocker);
+    if (_queryJobsRunning)
+        DispatchQueryJob(queryJob);
+    else
+        _queryJobs.Add(queryJob);
+}
+
+void PhysicsScene::DispatchQueryJob(const QueryJob& job)
+{
+    void* scene = _scene;
+    const Function<void(int32)> func = job.Job;
+    _queryJobsLabel = JobSystem::Dispatch([scene, func](int32 index)
+    {
+        PROFILE_CPU_NAMED("Physics.Queries");
+        PhysicsBackend::LockSceneQueries(scene);
+        func(index);
+        PhysicsBackend::UnlockSceneQueries(scene);
+    }, job.JobCount);
+}
+
+void PhysicsScene::FlushQueryJobs()
+{
+    // Start the jobs that were not executed during simulation (eg. scene was not simulated this frame)
+    _queryJobsLocker.Lock();
+    for (const QueryJob& job : _queryJobs)
+        DispatchQueryJob(job);
+    _queryJobs.Clear();
+    _queryJobsRunning = false;
+    const int64 label = _queryJobsLabel;
+    _queryJobsLabel = 0;
+    _queryJobsLocker.Unlock();
+
+    // Wait for the queries to end before scene gets modified
+    if (label != 0)
+    {
+        PROFILE_CPU_NAMED("Physics.WaitForQueries");
+        JobSystem::Wait(label);
+    }
+}
+
 bool PhysicsScene::RayCast(const Vector3& origin, const Vector3& direction, const float maxDistance, uint32 layerMask, bool hitTriggers)
 {
     return PhysicsBackend::RayCast(_scene, origin, direction, maxDistance, layerMask, hitTriggers);
@@ -584,3 +727,18 @@ bool PhysicsScene::OverlapConvex(const Vector3& center, const CollisionData* con
 {
     return PhysicsBackend::OverlapConvex(_scene, center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
+
+int32 PhysicsScene::RayCastBatch(const Span<RayCastQuery>& queries, Span<RayCastHit> results)
+{
+    return PhysicsBackend::RayCastBatch(_scene, queries, results);
+}
+
+int32 PhysicsScene::SphereCastBatch(const Span<SphereCastQuery>& queries, Span<RayCastHit> results)
+{
+    return PhysicsBackend::SphereCastBatch(_scene, queries, results);
+}
+
+int32 PhysicsScene::OverlapSphereBatch(const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery)
+{
+    return PhysicsBackend::OverlapSphereBatch(_scene, queries, results, resultsCounts, maxResultsPerQuery);
+}
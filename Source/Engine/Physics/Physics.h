@@ -74,13 +74,13 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     static uint32 LayerMasks[32];
 public:
     /// <summary>
-    /// Called during main engine loop to start physic simulation. Use CollectResults after.
+    /// Called during main engine loop to start physic simulation of all scenes with auto simulation enabled. Scenes simulate in parallel. Use CollectResults after.
     /// </summary>
     /// <param name="dt">The delta time (in seconds).</param>
     API_FUNCTION() static void Simulate(float dt);
 
     /// <summary>
-    /// Called during main engine loop to collect physic simulation results and apply them as well as fire collision events.
+    /// Called during main engine loop to collect physic simulation results (of the default scene and all scenes with auto simulation enabled) and apply them as well as fire collision events.
     /// </summary>
     API_FUNCTION() static void CollectResults();
 
@@ -89,6 +89,13 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// </summary>
     API_PROPERTY() static bool IsDuringSimulation();
 
+    /// <summary>
+    /// Dispatches the job that performs scene queries (eg. raycasts or overlaps) on the Job System threads in parallel to the physics simulation of the default scene. Queries are performed against the state of the last completed simulation step (or substep). See PhysicsScene.DispatchQueries for more info.
+    /// </summary>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    API_FUNCTION() static void DispatchQueries(const Function<void(int32)>& job, int32 jobCount = 1);
+
     /// <summary>
     /// Flushes any latent physics actions (eg. object destroy, actor add/remove to the scene, etc.).
     /// </summary>
@@ -365,6 +372,29 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// <returns>True if sphere overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() static bool OverlapSphere(const Vector3& center, float radius, API_PARAM(Out) Array<Collider*, HeapAllocation>& results, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
 
+    /// <summary>
+    /// Finds all colliders touching or inside of the given box. Writes the results into the caller-provided buffer (can be reused to avoid allocating the results array every call).
+    /// </summary>
+    /// <param name="center">The box center.</param>
+    /// <param name="halfExtents">The half size of the box in each direction.</param>
+    /// <param name="results">The output buffer for the colliders that overlap with the given box. Results that don't fit into the buffer are skipped.</param>
+    /// <param name="rotation">The box rotation.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of colliders written to the results buffer.</returns>
+    API_FUNCTION() static int32 OverlapBox(const Vector3& center, const Vector3& halfExtents, Span<Collider*> results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Finds all colliders touching or inside of the given sphere. Writes the results into the caller-provided buffer (can be reused to avoid allocating the results array every call).
+    /// </summary>
+    /// <param name="center">The sphere center.</param>
+    /// <param name="radius">The radius of the sphere.</param>
+    /// <param name="results">The output buffer for the colliders that overlap with the given sphere. Results that don't fit into the buffer are skipped.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of colliders written to the results buffer.</returns>
+    API_FUNCTION() static int32 OverlapSphere(const Vector3& center, float radius, Span<Collider*> results, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
     /// <summary>
     /// Finds all colliders touching or inside of the given capsule.
     /// </summary>
@@ -439,4 +469,31 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
     /// <returns>True if convex mesh overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() static bool OverlapConvex(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+public:
+    /// <summary>
+    /// Performs multiple raycasts against objects in the scene at once (queries are split into the batches executed in parallel on the Job System). Returns the closest hit of every ray. Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The raycast queries.</param>
+    /// <param name="results">The output hits buffer (must be at least the size of queries). Hit of the query is written at the same index. Queries that didn't hit anything have the hit Collider set to null.</param>
+    /// <returns>The amount of queries that hit any matching object.</returns>
+    static int32 RayCastBatch(const Span<RayCastQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Performs multiple sphere sweeps against objects in the scene at once (queries are split into the batches executed in parallel on the Job System). Returns the closest hit of every sweep. Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The sphere sweep queries.</param>
+    /// <param name="results">The output hits buffer (must be at least the size of queries). Hit of the query is written at the same index. Queries that didn't hit anything have the hit Collider set to null.</param>
+    /// <returns>The amount of queries that hit any matching object.</returns>
+    static int32 SphereCastBatch(const Span<SphereCastQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Finds colliders touching or inside of the multiple spheres at once (queries are split into the batches executed in parallel on the Job System). Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The sphere overlap queries.</param>
+    /// <param name="results">The output colliders buffer (must be at least the size of queries multiplied by maxResultsPerQuery). Results of the query are written at the index of the query multiplied by maxResultsPerQuery.</param>
+    /// <param name="resultsCounts">The output amount of the colliders found by every query (must be at least the size of queries).</param>
+    /// <param name="maxResultsPerQuery">The maximum amount of the colliders to report per query (the other overlaps are skipped).</param>
+    /// <returns>The total amount of the colliders found by all queries.</returns>
+    static int32 OverlapSphereBatch(const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery);
 };
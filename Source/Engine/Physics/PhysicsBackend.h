@@ -6,6 +6,8 @@
 #include "PhysicsSettings.h"
 
 struct HingeJointDrive;
+struct Collision;
+struct TriggerEvent;
 struct SpringParameters;
 struct LimitLinearRange;
 struct LimitAngularRange;
@@ -88,12 +90,19 @@ class FLAXENGINE_API PhysicsBackend
     static void DestroyScene(void* scene);
     static void StartSimulateScene(void* scene, float dt);
     static void EndSimulateScene(void* scene);
+    static void LockSceneQueries(void* scene);
+    static void UnlockSceneQueries(void* scene);
     static Vector3 GetSceneGravity(void* scene);
     static void SetSceneGravity(void* scene, const Vector3& value);
     static bool GetSceneEnableCCD(void* scene);
     static void SetSceneEnableCCD(void* scene, bool value);
     static float GetSceneBounceThresholdVelocity(void* scene);
     static void SetSceneBounceThresholdVelocity(void* scene, float value);
+    static bool GetSceneColliderEvents(void* scene);
+    static void SetSceneColliderEvents(void* scene, bool value);
+    static uint32 GetSceneBatchedEventsLayerMask(void* scene);
+    static void SetSceneBatchedEventsLayerMask(void* scene, uint32 value);
+    static void GetSceneBatchedEvents(void* scene, Span<Collision>& collisionEnter, Span<Collision>& collisionExit, Span<TriggerEvent>& triggerEnter, Span<TriggerEvent>& triggerExit);
     static void SetSceneOrigin(void* scene, const Vector3& oldOrigin, const Vector3& newOrigin);
     static void AddSceneActor(void* scene, void* actor);
     static void RemoveSceneActor(void* scene, void* actor);
@@ -127,6 +136,9 @@ class FLAXENGINE_API PhysicsBackend
     static bool OverlapSphere(void* scene, const Vector3& center, float radius, Array<PhysicsColliderActor*, HeapAllocation>& results, uint32 layerMask, bool hitTriggers);
     static bool OverlapCapsule(void* scene, const Vector3& center, float radius, float height, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
     static bool OverlapConvex(void* scene, const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
+    static int32 RayCastBatch(void* scene, const Span<RayCastQuery>& queries, Span<RayCastHit> results);
+    static int32 SphereCastBatch(void* scene, const Span<SphereCastQuery>& queries, Span<RayCastHit> results);
+    static int32 OverlapSphereBatch(void* scene, const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery);
 
     // Actors
     static ActorFlags GetActorFlags(void* actor);
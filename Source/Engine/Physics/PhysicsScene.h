@@ -4,8 +4,12 @@
 
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Types.h"
+#include "Collisions.h"
 
 struct ActionData;
 struct RayCastHit;
@@ -31,6 +35,20 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     Vector3 _origin = Vector3::Zero;
     void* _scene = nullptr;
 
+    struct QueryJob
+    {
+        Function<void(int32)> Job;
+        int32 JobCount;
+    };
+
+    CriticalSection _queryJobsLocker;
+    Array<QueryJob> _queryJobs;
+    bool _queryJobsRunning = false;
+    int64 _queryJobsLabel = 0;
+
+    void DispatchQueryJob(const QueryJob& job);
+    void FlushQueryJobs();
+
 public:
     ~PhysicsScene();
 
@@ -87,6 +105,44 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// </summary>
     API_PROPERTY() void SetBounceThresholdVelocity(float value);
 
+    /// <summary>
+    /// Gets the value indicating whether send collision and trigger events to the colliders (eg. OnCollisionEnter or OnTriggerEnter). Can be disabled when events are processed in batch (see GetBatchedEvents).
+    /// </summary>
+    API_PROPERTY() bool GetColliderEvents() const;
+
+    /// <summary>
+    /// Sets the value indicating whether send collision and trigger events to the colliders (eg. OnCollisionEnter or OnTriggerEnter). Can be disabled when events are processed in batch (see GetBatchedEvents).
+    /// </summary>
+    API_PROPERTY() void SetColliderEvents(bool value);
+
+    /// <summary>
+    /// Gets the layer mask used to filter the batched collision and trigger events (event is collected if any of the colliders is on the layer from the mask). Use 0 to disable batched events (default).
+    /// </summary>
+    API_PROPERTY() uint32 GetBatchedEventsLayerMask() const;
+
+    /// <summary>
+    /// Sets the layer mask used to filter the batched collision and trigger events (event is collected if any of the colliders is on the layer from the mask). Use 0 to disable batched events (default).
+    /// </summary>
+    API_PROPERTY() void SetBatchedEventsLayerMask(uint32 value);
+
+    /// <summary>
+    /// Gets the collision and trigger events generated by the last simulation step (see BatchedEventsLayerMask). Events are stored in contiguous memory that is valid until the next simulation step ends. Every colliders pair is reported once.
+    /// </summary>
+    /// <param name="collisionEnter">The collisions that begun.</param>
+    /// <param name="collisionExit">The collisions that ended.</param>
+    /// <param name="triggerEnter">The colliders that entered the triggers.</param>
+    /// <param name="triggerExit">The colliders that exited the triggers.</param>
+    void GetBatchedEvents(Span<Collision>& collisionEnter, Span<Collision>& collisionExit, Span<TriggerEvent>& triggerEnter, Span<TriggerEvent>& triggerExit) const;
+
+    /// <summary>
+    /// Gets the collision and trigger events generated by the last simulation step (see BatchedEventsLayerMask). Every colliders pair is reported once.
+    /// </summary>
+    /// <param name="collisionEnter">The collisions that begun.</param>
+    /// <param name="collisionExit">The collisions that ended.</param>
+    /// <param name="triggerEnter">The colliders that entered the triggers.</param>
+    /// <param name="triggerExit">The colliders that exited the triggers.</param>
+    API_FUNCTION() void GetBatchedEvents(API_PARAM(Out) Array<Collision>& collisionEnter, API_PARAM(Out) Array<Collision>& collisionExit, API_PARAM(Out) Array<TriggerEvent>& triggerEnter, API_PARAM(Out) Array<TriggerEvent>& triggerExit) const;
+
     /// <summary>
     /// Gets the current scene origin that defines the center of the simulation (in world). Can be used to run physics simulation relative to the camera.
     /// </summary>
@@ -125,6 +181,16 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// </summary>
     API_FUNCTION() void CollectResults();
 
+    /// <summary>
+    /// Dispatches the job that performs scene queries (eg. raycasts or overlaps) on the Job System threads in parallel to the physics simulation. Queries are performed against the state of the last completed simulation step (or substep).
+    /// </summary>
+    /// <remarks>
+    /// The job is started when the scene simulation begins (or right away if it's already running) so it doesn't race with the gameplay code that modifies physics objects during update. Simulation results are collected after all the query jobs end. If the scene is not simulated during the frame (eg. game is paused) the jobs are executed when collecting the simulation results. The job must not modify any physics objects.
+    /// </remarks>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    API_FUNCTION() void DispatchQueries(const Function<void(int32)>& job, int32 jobCount = 1);
+
 public:
     /// <summary>
     /// Performs a raycast against objects in the scene.
@@ -470,4 +536,31 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
     /// <returns>True if convex mesh overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() bool OverlapConvex(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+public:
+    /// <summary>
+    /// Performs multiple raycasts against objects in the scene at once (queries are split into the batches executed in parallel on the Job System). Returns the closest hit of every ray. Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The raycast queries.</param>
+    /// <param name="results">The output hits buffer (must be at least the size of queries). Hit of the query is written at the same index. Queries that didn't hit anything have the hit Collider set to null.</param>
+    /// <returns>The amount of queries that hit any matching object.</returns>
+    int32 RayCastBatch(const Span<RayCastQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Performs multiple sphere sweeps against objects in the scene at once (queries are split into the batches executed in parallel on the Job System). Returns the closest hit of every sweep. Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The sphere sweep queries.</param>
+    /// <param name="results">The output hits buffer (must be at least the size of queries). Hit of the query is written at the same index. Queries that didn't hit anything have the hit Collider set to null.</param>
+    /// <returns>The amount of queries that hit any matching object.</returns>
+    int32 SphereCastBatch(const Span<SphereCastQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Finds colliders touching or inside of the multiple spheres at once (queries are split into the batches executed in parallel on the Job System). Doesn't allocate any memory.
+    /// </summary>
+    /// <param name="queries">The sphere overlap queries.</param>
+    /// <param name="results">The output colliders buffer (must be at least the size of queries multiplied by maxResultsPerQuery). Results of the query are written at the index of the query multiplied by maxResultsPerQuery.</param>
+    /// <param name="resultsCounts">The output amount of the colliders found by every query (must be at least the size of queries).</param>
+    /// <param name="maxResultsPerQuery">The maximum amount of the colliders to report per query (the other overlaps are skipped).</param>
+    /// <returns>The total amount of the colliders found by all queries.</returns>
+    int32 OverlapSphereBatch(const Span<OverlapSphereQuery>& queries, Span<PhysicsColliderActor*> results, Span<int32> resultsCounts, int32 maxResultsPerQuery);
 };
@@ -49,6 +49,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(80), EditorDisplay(\"Simulation\")")
     bool EnableAdaptiveForce = false;
 
+    /// <summary>
+    /// The maximum amount of Job System threads that execute the physics simulation tasks at once. Use 0 to use all Job System threads. Applied when creating the physics scene.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(90), Limit(0, 256), EditorDisplay(\"Simulation\")")
+    int32 WorkerThreadsCount = 0;
+
     /// <summary>
     /// The maximum allowed delta time (in seconds) for the physics simulation step.
     /// </summary>
@@ -5,6 +5,7 @@
 #include "Engine/Core/Config.h"
 #include "Engine/Core/Math/Vector2.h"
 #include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Scripting/ScriptingType.h"
 
 class PhysicsColliderActor;
@@ -167,6 +168,105 @@ API_STRUCT() struct RayCastHit
     API_FIELD() Float2 UV;
 };
 
+/// <summary>
+/// The raycast query descriptor used by the batched scene queries.
+/// </summary>
+API_STRUCT() struct RayCastQuery
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(RayCastQuery);
+
+    /// <summary>
+    /// The origin of the ray.
+    /// </summary>
+    API_FIELD() Vector3 Origin;
+
+    /// <summary>
+    /// The normalized direction of the ray.
+    /// </summary>
+    API_FIELD() Vector3 Direction;
+
+    /// <summary>
+    /// The maximum distance the ray should check for collisions.
+    /// </summary>
+    API_FIELD() float MaxDistance = MAX_float;
+
+    /// <summary>
+    /// The layer mask used to filter the results.
+    /// </summary>
+    API_FIELD() uint32 LayerMask = MAX_uint32;
+
+    /// <summary>
+    /// If set to true triggers will be hit, otherwise will skip them.
+    /// </summary>
+    API_FIELD() bool HitTriggers = true;
+};
+
+/// <summary>
+/// The sphere sweep query descriptor used by the batched scene queries.
+/// </summary>
+API_STRUCT() struct SphereCastQuery
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(SphereCastQuery);
+
+    /// <summary>
+    /// The sphere center.
+    /// </summary>
+    API_FIELD() Vector3 Center;
+
+    /// <summary>
+    /// The radius of the sphere.
+    /// </summary>
+    API_FIELD() float Radius;
+
+    /// <summary>
+    /// The normalized direction in which cast a sphere.
+    /// </summary>
+    API_FIELD() Vector3 Direction;
+
+    /// <summary>
+    /// The maximum distance the sphere should check for collisions.
+    /// </summary>
+    API_FIELD() float MaxDistance = MAX_float;
+
+    /// <summary>
+    /// The layer mask used to filter the results.
+    /// </summary>
+    API_FIELD() uint32 LayerMask = MAX_uint32;
+
+    /// <summary>
+    /// If set to true triggers will be hit, otherwise will skip them.
+    /// </summary>
+    API_FIELD() bool HitTriggers = true;
+};
+
+/// <summary>
+/// The sphere overlap query descriptor used by the batched scene queries.
+/// </summary>
+API_STRUCT() struct OverlapSphereQuery
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(OverlapSphereQuery);
+
+    /// <summary>
+    /// The sphere center.
+    /// </summary>
+    API_FIELD() Vector3 Center;
+
+    /// <summary>
+    /// The radius of the sphere.
+    /// </summary>
+    API_FIELD() float Radius;
+
+    /// <summary>
+    /// The layer mask used to filter the results.
+    /// </summary>
+    API_FIELD() uint32 LayerMask = MAX_uint32;
+
+    /// <summary>
+    /// If set to true triggers will be hit, otherwise will skip them.
+    /// </summary>
+    API_FIELD() bool HitTriggers = true;
+};
+
 /// <summary>
 /// Physics collision shape variant for different shapes such as box, sphere, capsule.
 /// </summary>
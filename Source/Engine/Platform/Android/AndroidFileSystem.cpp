@@ -577,6 +577,26 @@ bool AndroidAssetFile::Write(const void* buffer, uint32 bytesToWrite, uint32* by
     return true;
 }
 
+bool AndroidAssetFile::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    // Assets have no positional reads so seek and read
+    return FileBase::ReadAt(buffer, bytesToRead, position, bytesRead);
+}
+
+bool AndroidAssetFile::CanReadAtConcurrently() const
+{
+    return false;
+}
+
+byte* AndroidAssetFile::MapView(uint32& size)
+{
+    return FileBase::MapView(size);
+}
+
+void AndroidAssetFile::UnmapView(byte* data, uint32 size)
+{
+}
+
 void AndroidAssetFile::Close()
 {
     if (_asset)
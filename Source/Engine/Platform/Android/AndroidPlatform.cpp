@@ -810,6 +810,9 @@ bool AndroidPlatform::Init()
         AndroidCpu.ProcessorCoreCount = AndroidCpu.LogicalProcessorCount = 1;
     }
     AndroidCpu.ProcessorPackageCount = 1;
+    AndroidCpu.NumaNodeCount = 1;
+    AndroidCpu.PerformanceCoresMask = AndroidCpu.EfficiencyCoresMask = 0;
+    AndroidCpu.PrimaryNumaNodeMask = AndroidCpu.GetAllProcessorsMask();
     AndroidCpu.L1CacheSize = 0;
     AndroidCpu.L2CacheSize = 0;
     AndroidCpu.L3CacheSize = 0;
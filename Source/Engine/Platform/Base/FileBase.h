@@ -62,6 +62,49 @@ class FLAXENGINE_API FileBase : public NonCopyable
     /// <returns>True if cannot write data, otherwise false.</returns>
     virtual bool Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten = nullptr) = 0;
 
+    /// <summary>
+    /// Reads data from a file at the given position. The file position after the read is undefined.
+    /// </summary>
+    /// <param name="buffer">Output buffer to read data to it.</param>
+    /// <param name="bytesToRead">The maximum amount bytes to read.</param>
+    /// <param name="position">The position in the file to read from (in bytes).</param>
+    /// <param name="bytesRead">A pointer to the variable that receives the number of bytes read.</param>
+    /// <returns>True if cannot read data, otherwise false.</returns>
+    virtual bool ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead = nullptr)
+    {
+        SetPosition(position);
+        return Read(buffer, bytesToRead, bytesRead);
+    }
+
+    /// <summary>
+    /// Checks if ReadAt can be called from multiple threads at once (platform supports positional reads on the same file handle).
+    /// </summary>
+    /// <returns>True if ReadAt is thread-safe, otherwise false.</returns>
+    virtual bool CanReadAtConcurrently() const
+    {
+        return false;
+    }
+
+    /// <summary>
+    /// Maps the whole file contents into the process address space. The view is copy-on-write so any modifications to it are private and never written to the file.
+    /// </summary>
+    /// <param name="size">The result mapped data size (in bytes).</param>
+    /// <returns>The mapped data or null if platform doesn't support file mapping or it failed.</returns>
+    virtual byte* MapView(uint32& size)
+    {
+        size = 0;
+        return nullptr;
+    }
+
+    /// <summary>
+    /// Unmaps the file view created with MapView.
+    /// </summary>
+    /// <param name="data">The mapped data.</param>
+    /// <param name="size">The mapped data size (in bytes).</param>
+    virtual void UnmapView(byte* data, uint32 size)
+    {
+    }
+
     /// <summary>
     /// Close file handle
     /// </summary>
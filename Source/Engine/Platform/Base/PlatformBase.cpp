@@ -238,6 +238,23 @@ void PlatformBase::FreePages(void* ptr)
     Platform::Free(ptr);
 }
 
+uint64 PlatformBase::GetLargePageSize()
+{
+    return 0;
+}
+
+void* PlatformBase::AllocateLargePages(uint64 size)
+{
+    // Fallback to the regular pages
+    const uint64 pageSize = Platform::GetCPUInfo().PageSize;
+    return Platform::AllocatePages((size + pageSize - 1) / pageSize, pageSize);
+}
+
+void PlatformBase::FreeLargePages(void* ptr)
+{
+    Platform::FreePages(ptr);
+}
+
 PlatformType PlatformBase::GetPlatformType()
 {
     return PLATFORM_TYPE;
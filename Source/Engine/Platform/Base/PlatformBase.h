@@ -178,6 +178,17 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(PlatformBase);
         memcpy(dst, src, static_cast<size_t>(size));
     }
 
+    /// <summary>
+    /// Move memory region (memory regions can overlap)
+    /// </summary>
+    /// <param name="dst">Destination memory address. Must not be null, even if size is zero.</param>
+    /// <param name="src">Source memory address. Must not be null, even if size is zero.</param>
+    /// <param name="size">Size of the memory to move in bytes</param>
+    FORCE_INLINE static void MemoryMove(void* dst, const void* src, uint64 size)
+    {
+        memmove(dst, src, static_cast<size_t>(size));
+    }
+
     /// <summary>
     /// Set memory region with given value
     /// </summary>
@@ -332,6 +343,25 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(PlatformBase);
     /// <param name="ptr">The pointer to the pages to deallocate.</param>
     static void FreePages(void* ptr);
 
+    /// <summary>
+    /// Gets the size of the large (huge) memory page. Returns 0 if large pages are not supported or not available (eg. missing privileges).
+    /// </summary>
+    /// <returns>The large page size (in bytes).</returns>
+    static uint64 GetLargePageSize();
+
+    /// <summary>
+    /// Allocates memory block backed by the large (huge) pages to reduce TLB misses when accessing big, long-lived data. Falls back to the regular pages if large pages cannot be used.
+    /// </summary>
+    /// <param name="size">The size of the allocation (in bytes). Rounded up to the page size.</param>
+    /// <returns>The pointer to the allocated memory (aligned to the page size).</returns>
+    static void* AllocateLargePages(uint64 size);
+
+    /// <summary>
+    /// Frees memory block allocated with AllocateLargePages.
+    /// </summary>
+    /// <param name="ptr">The pointer to the memory to deallocate.</param>
+    static void FreeLargePages(void* ptr);
+
 public:
 
     /// <summary>
@@ -4,6 +4,7 @@
 #include "Engine/Threading/IRunnable.h"
 #include "Engine/Threading/ThreadRegistry.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Memory/ThreadCacheAllocator.h"
 #include "Engine/Scripting/ManagedCLR/MCore.h"
 #if TRACY_ENABLE
 #include "Engine/Core/Math/Math.h"
@@ -109,6 +110,7 @@ int32 ThreadBase::Run()
     _isRunning = false;
     ThreadExiting(thread, exitCode);
     ThreadRegistry::Remove(thread);
+    ThreadCacheAllocator::FlushThreadCache(); // Return cached small blocks to the global lists (thread-local cache would leak otherwise)
     MCore::ExitThread(); // TODO: use mono_thread_detach instead of ext and unlink mono runtime from thread in ThreadExiting delegate
     // mono terminates the native thread..
 
@@ -6,6 +6,7 @@
 #include "Engine/Platform/WindowsManager.h"
 #include "Engine/Graphics/GPUSwapChain.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Threading/Threading.h"
 #include "Engine/Input/Input.h"
 #include "Engine/Platform/IGuiData.h"
 #include "Engine/Scripting/ScriptingType.h"
@@ -403,7 +404,11 @@ void WindowBase::OnResize(int32 width, int32 height)
 {
     PROFILE_CPU_NAMED("GUI.OnResize");
     if (_swapChain)
+    {
+        // Wait for the frame drawing on the render thread (pipelined rendering) to not resize the swapchain in use
+        ScopeLock gpuLock(GPUDevice::Instance->Locker);
         _swapChain->Resize(width, height);
+    }
     if (RenderTask)
         RenderTask->Resize(width, height);
     INVOKE_EVENT_PARAMS_2(OnResize, &width, &height);
@@ -55,4 +55,33 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(CPUInfo);
     /// The CPU cache line size (in bytes).
     /// </summary>
     API_FIELD() uint32 CacheLineSize;
+
+    /// <summary>
+    /// The number of NUMA (Non-Uniform Memory Access) nodes.
+    /// </summary>
+    API_FIELD() uint32 NumaNodeCount;
+
+    /// <summary>
+    /// The affinity mask of the logical processors located on the performance cores (eg. P-cores on hybrid CPUs). Contains all processors if CPU doesn't have different core types. Zero if unknown.
+    /// </summary>
+    API_FIELD() uint64 PerformanceCoresMask;
+
+    /// <summary>
+    /// The affinity mask of the logical processors located on the efficiency cores (eg. E-cores on hybrid CPUs). Zero if CPU doesn't have different core types or if unknown.
+    /// </summary>
+    API_FIELD() uint64 EfficiencyCoresMask;
+
+    /// <summary>
+    /// The affinity mask of the logical processors located on the primary NUMA node (the one with the first processor). Zero if unknown.
+    /// </summary>
+    API_FIELD() uint64 PrimaryNumaNodeMask;
+
+public:
+    /// <summary>
+    /// Gets the affinity mask with all the logical processors.
+    /// </summary>
+    uint64 GetAllProcessorsMask() const
+    {
+        return LogicalProcessorCount >= 64 ? MAX_uint64 : (1ull << LogicalProcessorCount) - 1;
+    }
 };
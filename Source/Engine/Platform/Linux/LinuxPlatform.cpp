@@ -49,6 +49,7 @@
 #include <pwd.h>
 #include <inttypes.h>
 #include <dlfcn.h>
+#include <sys/mman.h>
 
 CPUInfo UnixCpu;
 int ClockSource;
@@ -1014,6 +1015,41 @@ void UnixGetMacAddress(byte result[6])
     Platform::MemoryCopy(result, ifr.ifr_hwaddr.sa_data, 6);
 }
 
+// Parses the sysfs processors list (eg. '0-7,16-23') into the affinity mask
+static uint64 ReadCpuListMask(const char* path)
+{
+    uint64 mask = 0;
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return 0;
+    char buffer[1024];
+    const int32 count = (int32)fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    buffer[Math::Max(count, 0)] = 0;
+    const char* str = buffer;
+    while (*str)
+    {
+        char* end;
+        const long first = strtol(str, &end, 10);
+        if (end == str)
+            break;
+        long last = first;
+        str = end;
+        if (*str == '-')
+        {
+            last = strtol(str + 1, &end, 10);
+            str = end;
+        }
+        for (long i = first; i <= last && i < 64; i++)
+            mask |= 1ull << i;
+        if (*str == ',')
+            str++;
+        else
+            break;
+    }
+    return mask;
+}
+
 static int do_scale_by_power(uintmax_t* x, int base, int power)
 {
     // Reference: https://github.com/karelzak/util-linux/blob/master/lib/strutils.c
@@ -1751,6 +1787,79 @@ bool LinuxPlatform::Is64BitPlatform()
 #endif
 }
 
+// Header stored right before the memory returned by AllocateLargePages
+struct LargePagesHeader
+{
+    void* Base;
+    uint64 Size;
+};
+
+uint64 LinuxPlatform::GetLargePageSize()
+{
+    static uint64 LargePageSize = MAX_uint64;
+    if (LargePageSize == MAX_uint64)
+    {
+        // Transparent huge pages can be used unless disabled in the system ('[never]' mode)
+        LargePageSize = 0;
+        char buffer[128];
+        FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+        if (file)
+        {
+            if (fgets(buffer, sizeof(buffer), file) && !strstr(buffer, "[never]"))
+            {
+                // Read the huge page size from the system (default to 2MB)
+                LargePageSize = 2 * 1024 * 1024;
+                FILE* sizeFile = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+                if (sizeFile)
+                {
+                    unsigned long long size;
+                    if (fscanf(sizeFile, "%llu", &size) == 1 && size != 0)
+                        LargePageSize = (uint64)size;
+                    fclose(sizeFile);
+                }
+            }
+            fclose(file);
+        }
+    }
+    return LargePageSize;
+}
+
+void* LinuxPlatform::AllocateLargePages(uint64 size)
+{
+    const uint64 largePageSize = GetLargePageSize();
+    if (largePageSize == 0)
+        return UnixPlatform::AllocateLargePages(size);
+
+    // Reserve additional space to align the memory to the huge page size and to fit the header in the regular page before it
+    const uint64 pageSize = UnixCpu.PageSize;
+    const uint64 numBytes = (size + largePageSize - 1) / largePageSize * largePageSize;
+    const uint64 totalSize = numBytes + largePageSize + pageSize;
+    void* base = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return nullptr;
+    byte* ptr = (byte*)(((uintptr)base + pageSize + largePageSize - 1) & ~(uintptr)(largePageSize - 1));
+    LargePagesHeader* header = (LargePagesHeader*)ptr - 1;
+    header->Base = base;
+    header->Size = totalSize;
+
+    // Ask kernel to back this range with transparent huge pages (ignored if not possible)
+    madvise(ptr, numBytes, MADV_HUGEPAGE);
+    return ptr;
+}
+
+void LinuxPlatform::FreeLargePages(void* ptr)
+{
+    if (!ptr)
+        return;
+    if (GetLargePageSize() == 0)
+    {
+        UnixPlatform::FreeLargePages(ptr);
+        return;
+    }
+    const LargePagesHeader* header = (const LargePagesHeader*)ptr - 1;
+    munmap(header->Base, header->Size);
+}
+
 CPUInfo LinuxPlatform::GetCPUInfo()
 {
     return UnixCpu;
@@ -1799,7 +1908,14 @@ void LinuxPlatform::SetThreadPriority(ThreadPriority priority)
 
 void LinuxPlatform::SetThreadAffinityMask(uint64 affinityMask)
 {
-    // TODO: impl this
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int32 i = 0; i < 64; i++)
+    {
+        if (affinityMask & (1ull << i))
+            CPU_SET(i, &cpus);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
 }
 
 void LinuxPlatform::Sleep(int32 milliseconds)
@@ -1968,6 +2084,53 @@ bool LinuxPlatform::Init()
         UnixCpu.LogicalProcessorCount = 1;
     }
 
+    // Get cores topology (hybrid CPUs expose separate PMU devices per core type, otherwise use the cores capacity if supported, eg. on ARM)
+    const uint64 allCoresMask = UnixCpu.GetAllProcessorsMask();
+    UnixCpu.PerformanceCoresMask = ReadCpuListMask("/sys/devices/cpu_core/cpus");
+    UnixCpu.EfficiencyCoresMask = ReadCpuListMask("/sys/devices/cpu_atom/cpus");
+    if (UnixCpu.PerformanceCoresMask == 0 || UnixCpu.EfficiencyCoresMask == 0)
+    {
+        UnixCpu.PerformanceCoresMask = UnixCpu.EfficiencyCoresMask = 0;
+        int32 maxCapacity = 0, capacities[64];
+        for (int32 cpuIdx = 0; cpuIdx < 64; cpuIdx++)
+        {
+            capacities[cpuIdx] = 0;
+            sprintf(fileNameBuffer, "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpuIdx);
+            if (FILE* file = fopen(fileNameBuffer, "r"))
+            {
+                if (fscanf(file, "%d", &capacities[cpuIdx]) != 1)
+                    capacities[cpuIdx] = 0;
+                fclose(file);
+            }
+            maxCapacity = Math::Max(maxCapacity, capacities[cpuIdx]);
+        }
+        for (int32 cpuIdx = 0; cpuIdx < 64 && maxCapacity != 0; cpuIdx++)
+        {
+            if (capacities[cpuIdx] == maxCapacity)
+                UnixCpu.PerformanceCoresMask |= 1ull << cpuIdx;
+            else if (capacities[cpuIdx] != 0)
+                UnixCpu.EfficiencyCoresMask |= 1ull << cpuIdx;
+        }
+        if (UnixCpu.PerformanceCoresMask == 0)
+            UnixCpu.PerformanceCoresMask = allCoresMask;
+    }
+    UnixCpu.NumaNodeCount = 0;
+    for (int32 nodeIdx = 0; nodeIdx < 64; nodeIdx++)
+    {
+        sprintf(fileNameBuffer, "/sys/devices/system/node/node%d/cpulist", nodeIdx);
+        const uint64 nodeMask = ReadCpuListMask(fileNameBuffer);
+        if (nodeMask == 0)
+            break;
+        if (nodeIdx == 0)
+            UnixCpu.PrimaryNumaNodeMask = nodeMask;
+        UnixCpu.NumaNodeCount++;
+    }
+    if (UnixCpu.NumaNodeCount == 0)
+    {
+        UnixCpu.NumaNodeCount = 1;
+        UnixCpu.PrimaryNumaNodeMask = allCoresMask;
+    }
+
     // Get cache sizes
     UnixCpu.L1CacheSize = 0;
     UnixCpu.L2CacheSize = 0;
@@ -89,6 +89,9 @@ class FLAXENGINE_API LinuxPlatform : public UnixPlatform
         __builtin_prefetch(static_cast<char const*>(ptr));
     }
     static bool Is64BitPlatform();
+    static uint64 GetLargePageSize();
+    static void* AllocateLargePages(uint64 size);
+    static void FreeLargePages(void* ptr);
     static CPUInfo GetCPUInfo();
     static int32 GetCacheLineSize();
     static MemoryStats GetMemoryStats();
@@ -366,6 +366,9 @@ bool MacPlatform::Init()
     if (sysctlbyname("hw.logicalcpu", &value32, &value32Size, nullptr, 0) != 0)
         value32 = 1;
     MacCpu.LogicalProcessorCount = value32;
+    MacCpu.NumaNodeCount = 1;
+    MacCpu.PerformanceCoresMask = MacCpu.PrimaryNumaNodeMask = MacCpu.GetAllProcessorsMask();
+    MacCpu.EfficiencyCoresMask = 0;
     if (sysctlbyname("hw.l1icachesize", &value32, &value32Size, nullptr, 0) != 0)
         value32 = 0;
     MacCpu.L1CacheSize = value32;
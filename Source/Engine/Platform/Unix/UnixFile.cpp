@@ -17,6 +17,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <cerrno>
 
 UnixFile::UnixFile(int32 handle)
@@ -99,6 +100,48 @@ bool UnixFile::Read(void* buffer, uint32 bytesToRead, uint32* bytesRead)
     return true;
 }
 
+bool UnixFile::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    const ssize_t tmp = pread(_handle, buffer, bytesToRead, (off_t)position);
+    if (tmp != -1)
+    {
+        if (bytesRead)
+            *bytesRead = tmp;
+        return false;
+    }
+    if (bytesRead)
+        *bytesRead = 0;
+    LOG_UNIX_LAST_ERROR;
+    return true;
+}
+
+bool UnixFile::CanReadAtConcurrently() const
+{
+    return true;
+}
+
+byte* UnixFile::MapView(uint32& size)
+{
+    size = 0;
+    const uint32 fileSize = GetSize();
+    if (fileSize == 0)
+        return nullptr;
+    void* data = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, _handle, 0);
+    if (data == MAP_FAILED)
+    {
+        LOG_UNIX_LAST_ERROR;
+        return nullptr;
+    }
+    size = fileSize;
+    return (byte*)data;
+}
+
+void UnixFile::UnmapView(byte* data, uint32 size)
+{
+    if (data)
+        munmap(data, size);
+}
+
 bool UnixFile::Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten)
 {
     const ssize_t tmp = write(_handle, buffer, bytesToWrite);
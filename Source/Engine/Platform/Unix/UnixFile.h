@@ -45,6 +45,10 @@ class UnixFile : public FileBase
     // [FileBase]
     bool Read(void* buffer, uint32 bytesToRead, uint32* bytesRead = nullptr) override;
     bool Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten = nullptr) override;
+    bool ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead = nullptr) override;
+    bool CanReadAtConcurrently() const override;
+    byte* MapView(uint32& size) override;
+    void UnmapView(byte* data, uint32 size) override;
     void Close() override;
     uint32 GetSize() const override;
     DateTime GetLastWriteTime() const override;
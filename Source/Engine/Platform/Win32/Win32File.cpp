@@ -50,6 +50,61 @@ bool Win32File::Read(void* buffer, uint32 bytesToRead, uint32* bytesRead)
     return true;
 }
 
+bool Win32File::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    // Read data at the given offset (file handle is synchronous so the call blocks)
+    OVERLAPPED overlapped;
+    Platform::MemoryClear(&overlapped, sizeof(overlapped));
+    overlapped.Offset = position;
+    DWORD tmp;
+    if (ReadFile(_handle, buffer, bytesToRead, &tmp, &overlapped))
+    {
+        if (bytesRead)
+            *bytesRead = tmp;
+        return false;
+    }
+
+    if (bytesRead)
+        *bytesRead = 0;
+    return true;
+}
+
+bool Win32File::CanReadAtConcurrently() const
+{
+    return true;
+}
+
+byte* Win32File::MapView(uint32& size)
+{
+    size = 0;
+#if PLATFORM_WINDOWS
+    const uint32 fileSize = GetSize();
+    if (fileSize == 0)
+        return nullptr;
+    const HANDLE mapping = CreateFileMappingW(_handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping == nullptr)
+        return nullptr;
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+    // View keeps the mapping object alive
+    CloseHandle(mapping);
+    if (data == nullptr)
+        return nullptr;
+    size = fileSize;
+    return (byte*)data;
+#else
+    return nullptr;
+#endif
+}
+
+void Win32File::UnmapView(byte* data, uint32 size)
+{
+#if PLATFORM_WINDOWS
+    if (data)
+        UnmapViewOfFile(data);
+#endif
+}
+
 bool Win32File::Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten)
 {
     // Try to write data
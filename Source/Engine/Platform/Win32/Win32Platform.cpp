@@ -83,6 +83,8 @@ bool Win32Platform::Init()
     DWORD processorL2CacheSize = 0;
     DWORD processorL3CacheSize = 0;
     DWORD processorPackageCount = 0;
+    DWORD numaNodeCount = 0;
+    ULONG_PTR primaryNumaNodeMask = 0;
     DWORD byteOffset = 0;
     PCACHE_DESCRIPTOR cache;
     while (!done)
@@ -139,6 +141,11 @@ bool Win32Platform::Init()
         case RelationProcessorPackage:
             processorPackageCount++;
             break;
+        case RelationNumaNode:
+            numaNodeCount++;
+            if (ptr->NumaNode.NodeNumber == 0)
+                primaryNumaNodeMask = ptr->ProcessorMask;
+            break;
         }
         byteOffset += sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
         ptr++;
@@ -152,6 +159,47 @@ bool Win32Platform::Init()
     CpuInfo.L1CacheSize = processorL1CacheSize;
     CpuInfo.L2CacheSize = processorL2CacheSize;
     CpuInfo.L3CacheSize = processorL3CacheSize;
+    const uint64 allCoresMask = CpuInfo.GetAllProcessorsMask();
+    CpuInfo.NumaNodeCount = Math::Max<uint32>(numaNodeCount, 1);
+    CpuInfo.PrimaryNumaNodeMask = primaryNumaNodeMask != 0 ? (uint64)primaryNumaNodeMask : allCoresMask;
+    CpuInfo.PerformanceCoresMask = allCoresMask;
+    CpuInfo.EfficiencyCoresMask = 0;
+#if PLATFORM_WINDOWS
+    {
+        // Get cores efficiency class (hybrid CPUs have cores with different efficiency, higher value means better performance)
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+        auto bufferEx = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)malloc(length);
+        if (bufferEx && GetLogicalProcessorInformationEx(RelationProcessorCore, bufferEx, &length))
+        {
+            BYTE maxEfficiencyClass = 0, minEfficiencyClass = MAX_uint8;
+            for (DWORD offset = 0; offset < length;)
+            {
+                auto info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)((byte*)bufferEx + offset);
+                maxEfficiencyClass = Math::Max(maxEfficiencyClass, info->Processor.EfficiencyClass);
+                minEfficiencyClass = Math::Min(minEfficiencyClass, info->Processor.EfficiencyClass);
+                offset += info->Size;
+            }
+            if (maxEfficiencyClass != minEfficiencyClass)
+            {
+                CpuInfo.PerformanceCoresMask = 0;
+                for (DWORD offset = 0; offset < length;)
+                {
+                    auto info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)((byte*)bufferEx + offset);
+                    if (info->Processor.GroupCount != 0 && info->Processor.GroupMask[0].Group == 0)
+                    {
+                        if (info->Processor.EfficiencyClass == maxEfficiencyClass)
+                            CpuInfo.PerformanceCoresMask |= (uint64)info->Processor.GroupMask[0].Mask;
+                        else
+                            CpuInfo.EfficiencyCoresMask |= (uint64)info->Processor.GroupMask[0].Mask;
+                    }
+                    offset += info->Size;
+                }
+            }
+        }
+        free(bufferEx);
+    }
+#endif
     SYSTEM_INFO siSysInfo;
     GetSystemInfo(&siSysInfo);
     CpuInfo.PageSize = siSysInfo.dwPageSize;
@@ -278,6 +326,56 @@ void Win32Platform::FreePages(void* ptr)
     VirtualFree(ptr, 0, MEM_RELEASE);
 }
 
+uint64 Win32Platform::GetLargePageSize()
+{
+#if PLATFORM_UWP
+    return 0;
+#else
+    static uint64 LargePageSize = MAX_uint64;
+    if (LargePageSize == MAX_uint64)
+    {
+        // Large pages require SeLockMemoryPrivilege to be granted to the user (Lock pages in memory policy)
+        LargePageSize = 0;
+        HANDLE token;
+        if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        {
+            TOKEN_PRIVILEGES privileges;
+            privileges.PrivilegeCount = 1;
+            privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+            if (LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                GetLastError() == ERROR_SUCCESS)
+            {
+                LargePageSize = (uint64)GetLargePageMinimum();
+            }
+            CloseHandle(token);
+        }
+    }
+    return LargePageSize;
+#endif
+}
+
+void* Win32Platform::AllocateLargePages(uint64 size)
+{
+    const uint64 largePageSize = GetLargePageSize();
+    if (largePageSize != 0)
+    {
+        const uint64 numBytes = (size + largePageSize - 1) / largePageSize * largePageSize;
+        void* ptr = VirtualAlloc(nullptr, (SIZE_T)numBytes, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (ptr)
+            return ptr;
+    }
+
+    // Fallback to the regular pages (eg. physical memory is too fragmented to find contiguous large pages)
+    const uint64 pageSize = GetCPUInfo().PageSize;
+    return AllocatePages((size + pageSize - 1) / pageSize, pageSize);
+}
+
+void Win32Platform::FreeLargePages(void* ptr)
+{
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
 bool Win32Platform::Is64BitPlatform()
 {
 #ifdef PLATFORM_64BITS
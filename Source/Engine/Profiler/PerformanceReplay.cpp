@@ -0,0 +1,627 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if COMPILE_WITH_PROFILER
+
+#include "PerformanceReplay.h"
+#include "ProfilingTools.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/Time.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Types/DateTime.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Input/Input.h"
+#include "Engine/Input/Mouse.h"
+#include "Engine/Input/Keyboard.h"
+#include "Engine/Level/Actors/Camera.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "FlaxEngine.Gen.h"
+
+#define REPLAY_FILE_MAGIC 0x52504c46
+#define REPLAY_FILE_VERSION 1
+
+namespace
+{
+    enum class ReplayEventType : int32
+    {
+        Char,
+        KeyDown,
+        KeyUp,
+        MouseDown,
+        MouseUp,
+        MouseDoubleClick,
+        MouseWheel,
+        MouseMove,
+        MouseLeave,
+    };
+
+    struct ReplayEvent
+    {
+        ReplayEventType Type;
+        int32 Data;
+        Float2 Position;
+        float WheelDelta;
+    };
+
+    struct ReplayFrame
+    {
+        Double3 CameraPosition;
+        Quaternion CameraOrientation;
+        int32 EventsCount;
+        int32 HasCamera;
+    };
+
+    struct ReplayFileHeader
+    {
+        int32 Magic;
+        int32 Version;
+        int32 Seed;
+        float DeltaTime;
+        int32 FramesCount;
+        int32 EventsCount;
+    };
+
+    struct ReplayFrameStats
+    {
+        float FrameTimeMs;
+        float UpdateTimeMs;
+        float PhysicsTimeMs;
+        float DrawCPUTimeMs;
+        float DrawGPUTimeMs;
+        RenderStatsData DrawStats;
+    };
+
+    struct ReplaySummary
+    {
+        double Mean;
+        double Median;
+        double P95;
+        double Max;
+    };
+
+    enum class ReplayMode
+    {
+        None,
+        Recording,
+        Replaying,
+    };
+
+    ReplayMode Mode = ReplayMode::None;
+    bool ExitOnEnd = false;
+    int32 ActiveSeed = 0;
+    int32 CurrentFrame = 0;
+    int32 CurrentEvent = 0;
+    double LastFrameTime = 0.0;
+    String FilePath;
+    String ReportPath;
+    Array<ReplayFrame> Frames;
+    Array<ReplayEvent> Events;
+    Array<ReplayFrameStats> FramesStats;
+
+    void RecordEvent(ReplayEventType type, int32 data = 0, const Float2& position = Float2::Zero, float wheelDelta = 0.0f)
+    {
+        if (Frames.IsEmpty())
+            return;
+        ReplayEvent& e = Events.AddOne();
+        e.Type = type;
+        e.Data = data;
+        e.Position = position;
+        e.WheelDelta = wheelDelta;
+        Frames.Last().EventsCount++;
+    }
+
+    void OnCharInput(Char c)
+    {
+        RecordEvent(ReplayEventType::Char, (int32)c);
+    }
+
+    void OnKeyDown(KeyboardKeys key)
+    {
+        RecordEvent(ReplayEventType::KeyDown, (int32)key);
+    }
+
+    void OnKeyUp(KeyboardKeys key)
+    {
+        RecordEvent(ReplayEventType::KeyUp, (int32)key);
+    }
+
+    void OnMouseDown(const Float2& position, MouseButton button)
+    {
+        RecordEvent(ReplayEventType::MouseDown, (int32)button, position);
+    }
+
+    void OnMouseUp(const Float2& position, MouseButton button)
+    {
+        RecordEvent(ReplayEventType::MouseUp, (int32)button, position);
+    }
+
+    void OnMouseDoubleClick(const Float2& position, MouseButton button)
+    {
+        RecordEvent(ReplayEventType::MouseDoubleClick, (int32)button, position);
+    }
+
+    void OnMouseWheel(const Float2& position, float delta)
+    {
+        RecordEvent(ReplayEventType::MouseWheel, 0, position, delta);
+    }
+
+    void OnMouseMove(const Float2& position)
+    {
+        RecordEvent(ReplayEventType::MouseMove, 0, position);
+    }
+
+    void OnMouseLeave()
+    {
+        RecordEvent(ReplayEventType::MouseLeave);
+    }
+
+    void BindInput(bool bind)
+    {
+        if (bind)
+        {
+            Input::CharInput.Bind<OnCharInput>();
+            Input::KeyDown.Bind<OnKeyDown>();
+            Input::KeyUp.Bind<OnKeyUp>();
+            Input::MouseDown.Bind<OnMouseDown>();
+            Input::MouseUp.Bind<OnMouseUp>();
+            Input::MouseDoubleClick.Bind<OnMouseDoubleClick>();
+            Input::MouseWheel.Bind<OnMouseWheel>();
+            Input::MouseMove.Bind<OnMouseMove>();
+            Input::MouseLeave.Bind<OnMouseLeave>();
+        }
+        else
+        {
+            Input::CharInput.Unbind<OnCharInput>();
+            Input::KeyDown.Unbind<OnKeyDown>();
+            Input::KeyUp.Unbind<OnKeyUp>();
+            Input::MouseDown.Unbind<OnMouseDown>();
+            Input::MouseUp.Unbind<OnMouseUp>();
+            Input::MouseDoubleClick.Unbind<OnMouseDoubleClick>();
+            Input::MouseWheel.Unbind<OnMouseWheel>();
+            Input::MouseMove.Unbind<OnMouseMove>();
+            Input::MouseLeave.Unbind<OnMouseLeave>();
+        }
+    }
+
+    void InjectEvent(const ReplayEvent& e)
+    {
+        const auto keyboard = Input::Keyboard;
+        const auto mouse = Input::Mouse;
+        switch (e.Type)
+        {
+        case ReplayEventType::Char:
+            if (keyboard)
+                keyboard->OnCharInput((Char)e.Data);
+            break;
+        case ReplayEventType::KeyDown:
+            if (keyboard)
+                keyboard->OnKeyDown((KeyboardKeys)e.Data);
+            break;
+        case ReplayEventType::KeyUp:
+            if (keyboard)
+                keyboard->OnKeyUp((KeyboardKeys)e.Data);
+            break;
+        case ReplayEventType::MouseDown:
+            if (mouse)
+                mouse->OnMouseDown(e.Position, (MouseButton)e.Data);
+            break;
+        case ReplayEventType::MouseUp:
+            if (mouse)
+                mouse->OnMouseUp(e.Position, (MouseButton)e.Data);
+            break;
+        case ReplayEventType::MouseDoubleClick:
+            if (mouse)
+                mouse->OnMouseDoubleClick(e.Position, (MouseButton)e.Data);
+            break;
+        case ReplayEventType::MouseWheel:
+            if (mouse)
+                mouse->OnMouseWheel(e.Position, e.WheelDelta);
+            break;
+        case ReplayEventType::MouseMove:
+            if (mouse)
+                mouse->OnMouseMove(e.Position);
+            break;
+        case ReplayEventType::MouseLeave:
+            if (mouse)
+                mouse->OnMouseLeave();
+            break;
+        }
+    }
+
+    void BeginSimulation(int32 seed, float deltaTime)
+    {
+        ActiveSeed = seed;
+        CurrentFrame = 0;
+        CurrentEvent = 0;
+        LastFrameTime = 0.0;
+        Time::SetFixedDeltaTime(true, deltaTime);
+        srand((uint32)seed);
+    }
+
+    void EndSimulation()
+    {
+        Mode = ReplayMode::None;
+        Time::SetFixedDeltaTime(false, 0.0f);
+    }
+
+    ReplaySummary GetSummary(Array<double>& values)
+    {
+        ReplaySummary result;
+        Platform::MemoryClear(&result, sizeof(result));
+        if (values.IsEmpty())
+            return result;
+        Sorting::QuickSort(values.Get(), values.Count());
+        double sum = 0.0;
+        for (double value : values)
+            sum += value;
+        result.Mean = sum / values.Count();
+        result.Median = values[values.Count() / 2];
+        result.P95 = values[Math::Min((int32)(values.Count() * 0.95f), values.Count() - 1)];
+        result.Max = values.Last();
+        return result;
+    }
+
+    void WriteSummary(JsonWriter& writer, const char* name, Array<double>& values)
+    {
+        const ReplaySummary summary = GetSummary(values);
+        writer.Key(name);
+        writer.StartObject();
+        writer.JKEY("Mean");
+        writer.Double(summary.Mean);
+        writer.JKEY("Median");
+        writer.Double(summary.Median);
+        writer.JKEY("P95");
+        writer.Double(summary.P95);
+        writer.JKEY("Max");
+        writer.Double(summary.Max);
+        writer.EndObject();
+    }
+
+    // Saves the replay report, returns true if failed to save it or the frame budget was exceeded
+    bool SaveReport()
+    {
+        const int32 warmupFrames = Math::Clamp(PerformanceReplay::WarmupFrames, 0, FramesStats.Count());
+        Array<double> frameTimes, updateTimes, physicsTimes, drawCpuTimes, drawGpuTimes, drawCalls, triangles;
+        for (int32 i = warmupFrames; i < FramesStats.Count(); i++)
+        {
+            const ReplayFrameStats& e = FramesStats[i];
+            frameTimes.Add(e.FrameTimeMs);
+            updateTimes.Add(e.UpdateTimeMs);
+            physicsTimes.Add(e.PhysicsTimeMs);
+            drawCpuTimes.Add(e.DrawCPUTimeMs);
+            drawGpuTimes.Add(e.DrawGPUTimeMs);
+            drawCalls.Add((double)e.DrawStats.DrawCalls);
+            triangles.Add((double)e.DrawStats.Triangles);
+        }
+        const double frameTimeP95 = GetSummary(frameTimes).P95;
+        const bool overBudget = PerformanceReplay::FrameBudgetMs > 0.0f && frameTimeP95 > PerformanceReplay::FrameBudgetMs;
+
+        rapidjson_flax::StringBuffer buffer;
+        PrettyJsonWriter writerObj(buffer);
+        JsonWriter& writer = writerObj;
+        writer.StartObject();
+        {
+            writer.JKEY("EngineVersion");
+            writer.String(FLAXENGINE_VERSION_TEXT);
+            writer.JKEY("Date");
+            writer.DateTime(DateTime::NowUTC());
+            writer.JKEY("Replay");
+            writer.String(FilePath);
+            writer.JKEY("Seed");
+            writer.Int(ActiveSeed);
+            writer.JKEY("Frames");
+            writer.Int(FramesStats.Count());
+            writer.JKEY("WarmupFrames");
+            writer.Int(warmupFrames);
+            writer.JKEY("FrameBudgetMs");
+            writer.Float(PerformanceReplay::FrameBudgetMs);
+            writer.JKEY("Passed");
+            writer.Bool(!overBudget);
+
+            writer.JKEY("Summary");
+            writer.StartObject();
+            WriteSummary(writer, "FrameTimeMs", frameTimes);
+            WriteSummary(writer, "UpdateTimeMs", updateTimes);
+            WriteSummary(writer, "PhysicsTimeMs", physicsTimes);
+            WriteSummary(writer, "DrawCPUTimeMs", drawCpuTimes);
+            WriteSummary(writer, "DrawGPUTimeMs", drawGpuTimes);
+            WriteSummary(writer, "DrawCalls", drawCalls);
+            WriteSummary(writer, "Triangles", triangles);
+            writer.EndObject();
+
+            writer.JKEY("FramesStats");
+            writer.StartArray();
+            for (const ReplayFrameStats& e : FramesStats)
+            {
+                writer.StartObject();
+                writer.JKEY("FrameTimeMs");
+                writer.Float(e.FrameTimeMs);
+                writer.JKEY("UpdateTimeMs");
+                writer.Float(e.UpdateTimeMs);
+                writer.JKEY("PhysicsTimeMs");
+                writer.Float(e.PhysicsTimeMs);
+                writer.JKEY("DrawCPUTimeMs");
+                writer.Float(e.DrawCPUTimeMs);
+                writer.JKEY("DrawGPUTimeMs");
+                writer.Float(e.DrawGPUTimeMs);
+                writer.JKEY("DrawCalls");
+                writer.Int64(e.DrawStats.DrawCalls);
+                writer.JKEY("DispatchCalls");
+                writer.Int64(e.DrawStats.DispatchCalls);
+                writer.JKEY("Triangles");
+                writer.Int64(e.DrawStats.Triangles);
+                writer.JKEY("Vertices");
+                writer.Int64(e.DrawStats.Vertices);
+                writer.JKEY("PipelineStateChanges");
+                writer.Int64(e.DrawStats.PipelineStateChanges);
+                writer.EndObject();
+            }
+            writer.EndArray();
+        }
+        writer.EndObject();
+
+        LOG(Info, "Replay finished after {0} frames, frame time: {1} ms (p95), budget: {2} ms", FramesStats.Count(), (float)frameTimeP95, PerformanceReplay::FrameBudgetMs);
+        if (overBudget)
+            LOG(Error, "Replay frame time is over the budget ({0} ms > {1} ms)", (float)frameTimeP95, PerformanceReplay::FrameBudgetMs);
+        if (ReportPath.HasChars() && File::WriteAllBytes(ReportPath, (const byte*)buffer.GetString(), (int32)buffer.GetSize()))
+        {
+            LOG(Error, "Failed to save replay report to '{0}'", ReportPath);
+            return true;
+        }
+        return overBudget;
+    }
+}
+
+class PerformanceReplayService : public EngineService
+{
+public:
+    PerformanceReplayService()
+        : EngineService(TEXT("Performance Replay"), -70)
+    {
+    }
+
+    bool Init() override;
+    void Update() override;
+    void LateUpdate() override;
+    void Dispose() override;
+};
+
+PerformanceReplayService PerformanceReplayServiceInstance;
+
+float PerformanceReplay::DeltaTime = 1.0f / 60.0f;
+int32 PerformanceReplay::Seed = 0;
+int32 PerformanceReplay::WarmupFrames = 30;
+float PerformanceReplay::FrameBudgetMs = 0.0f;
+
+int32 PerformanceReplay::GetActiveSeed()
+{
+    return ActiveSeed;
+}
+
+bool PerformanceReplay::IsRecording()
+{
+    return Mode == ReplayMode::Recording;
+}
+
+bool PerformanceReplay::IsReplaying()
+{
+    return Mode == ReplayMode::Replaying;
+}
+
+void PerformanceReplay::StartRecording(const StringView& path)
+{
+    if (Mode != ReplayMode::None)
+    {
+        LOG(Warning, "Cannot start the input recording while other recording or replay is active.");
+        return;
+    }
+    LOG(Info, "Starting input recording to '{0}'", path);
+    Mode = ReplayMode::Recording;
+    FilePath = path;
+    Frames.Clear();
+    Events.Clear();
+    BeginSimulation(Seed != 0 ? Seed : (int32)(DateTime::Now().Ticks & MAX_int32), DeltaTime);
+    BindInput(true);
+}
+
+bool PerformanceReplay::StopRecording()
+{
+    if (Mode != ReplayMode::Recording)
+        return true;
+    BindInput(false);
+    EndSimulation();
+
+    ReplayFileHeader header;
+    header.Magic = REPLAY_FILE_MAGIC;
+    header.Version = REPLAY_FILE_VERSION;
+    header.Seed = ActiveSeed;
+    header.DeltaTime = DeltaTime;
+    header.FramesCount = Frames.Count();
+    header.EventsCount = Events.Count();
+    MemoryWriteStream stream(sizeof(header) + Frames.Count() * sizeof(ReplayFrame) + Events.Count() * sizeof(ReplayEvent));
+    stream.WriteBytes(&header, sizeof(header));
+    stream.WriteBytes(Frames.Get(), Frames.Count() * sizeof(ReplayFrame));
+    stream.WriteBytes(Events.Get(), Events.Count() * sizeof(ReplayEvent));
+    LOG(Info, "Saving input recording with {0} frames and {1} events to '{2}'", Frames.Count(), Events.Count(), FilePath);
+    Frames.Resize(0);
+    Events.Resize(0);
+    if (File::WriteAllBytes(FilePath, stream.GetHandle(), (int32)stream.GetPosition()))
+    {
+        LOG(Error, "Failed to save input recording to '{0}'", FilePath);
+        return true;
+    }
+    return false;
+}
+
+bool PerformanceReplay::StartReplay(const StringView& path, const StringView& reportPath)
+{
+    if (Mode != ReplayMode::None)
+    {
+        LOG(Warning, "Cannot start the replay while other recording or replay is active.");
+        return true;
+    }
+
+    // Load recording
+    Array<byte> data;
+    if (File::ReadAllBytes(path, data))
+    {
+        LOG(Error, "Failed to load replay '{0}'", path);
+        return true;
+    }
+    MemoryReadStream stream(data);
+    ReplayFileHeader header;
+    if (data.Count() < (int32)sizeof(header))
+    {
+        LOG(Error, "Invalid replay file '{0}'", path);
+        return true;
+    }
+    stream.ReadBytes(&header, sizeof(header));
+    if (header.Magic != REPLAY_FILE_MAGIC || header.Version != REPLAY_FILE_VERSION || header.FramesCount < 0 || header.EventsCount < 0 ||
+        stream.GetLength() - stream.GetPosition() != header.FramesCount * sizeof(ReplayFrame) + header.EventsCount * sizeof(ReplayEvent))
+    {
+        LOG(Error, "Invalid or unsupported replay file '{0}'", path);
+        return true;
+    }
+    Frames.Resize(header.FramesCount, false);
+    Events.Resize(header.EventsCount, false);
+    stream.ReadBytes(Frames.Get(), Frames.Count() * sizeof(ReplayFrame));
+    stream.ReadBytes(Events.Get(), Events.Count() * sizeof(ReplayEvent));
+
+    LOG(Info, "Starting replay of '{0}' ({1} frames, seed: {2})", path, header.FramesCount, header.Seed);
+    Mode = ReplayMode::Replaying;
+    FilePath = path;
+    ReportPath = reportPath;
+    FramesStats.Clear();
+    FramesStats.EnsureCapacity(header.FramesCount);
+    BeginSimulation(header.Seed, header.DeltaTime);
+    return false;
+}
+
+void PerformanceReplay::StopReplay()
+{
+    if (Mode != ReplayMode::Replaying)
+        return;
+    EndSimulation();
+    const bool failed = SaveReport();
+    Frames.Resize(0);
+    Events.Resize(0);
+    FramesStats.Resize(0);
+    if (ExitOnEnd)
+    {
+        ExitOnEnd = false;
+        Engine::RequestExit(failed ? 1 : 0);
+    }
+}
+
+bool PerformanceReplayService::Init()
+{
+    if (CommandLine::Options.ReplayBudget.HasValue())
+    {
+        float budget;
+        if (StringUtils::Parse(CommandLine::Options.ReplayBudget.GetValue().Get(), &budget))
+            LOG(Warning, "Invalid replay budget '{0}'.", CommandLine::Options.ReplayBudget.GetValue());
+        else
+            PerformanceReplay::FrameBudgetMs = budget;
+    }
+    if (CommandLine::Options.Replay.HasValue())
+    {
+        const String reportPath = CommandLine::Options.ReplayReport.HasValue() ? CommandLine::Options.ReplayReport.GetValue() : CommandLine::Options.Replay.GetValue() + TEXT(".json");
+        ExitOnEnd = !PerformanceReplay::StartReplay(CommandLine::Options.Replay.GetValue(), reportPath);
+    }
+    else if (CommandLine::Options.ReplayRecord.HasValue())
+    {
+        PerformanceReplay::StartRecording(CommandLine::Options.ReplayRecord.GetValue());
+    }
+    return false;
+}
+
+void PerformanceReplayService::Update()
+{
+    if (Mode == ReplayMode::Recording)
+    {
+        // Begin a new frame (events are recorded by the input service that updates after this service)
+        ReplayFrame& frame = Frames.AddOne();
+        Platform::MemoryClear(&frame, sizeof(frame));
+    }
+    else if (Mode == ReplayMode::Replaying)
+    {
+        if (CurrentFrame >= Frames.Count())
+        {
+            PerformanceReplay::StopReplay();
+            return;
+        }
+        PROFILE_CPU();
+
+        // Replay ignores the window focus to simulate the same input on headless or background runs
+        Engine::HasFocus = true;
+
+        // Inject the recorded input events for this frame
+        const ReplayFrame& frame = Frames[CurrentFrame];
+        const int32 eventsEnd = Math::Min(CurrentEvent + frame.EventsCount, Events.Count());
+        for (; CurrentEvent < eventsEnd; CurrentEvent++)
+            InjectEvent(Events[CurrentEvent]);
+    }
+}
+
+void PerformanceReplayService::LateUpdate()
+{
+    if (Mode == ReplayMode::Recording)
+    {
+        Camera* camera = Camera::GetMainCamera();
+        ReplayFrame& frame = Frames.Last();
+        if (camera)
+        {
+            const Vector3 position = camera->GetPosition();
+            frame.CameraPosition = Double3(position.X, position.Y, position.Z);
+            frame.CameraOrientation = camera->GetOrientation();
+            frame.HasCamera = 1;
+        }
+    }
+    else if (Mode == ReplayMode::Replaying && CurrentFrame < Frames.Count())
+    {
+        // Override the camera with the recorded path (gameplay code can still move it but the rendered view stays the same)
+        const ReplayFrame& frame = Frames[CurrentFrame];
+        Camera* camera = Camera::GetMainCamera();
+        if (camera && frame.HasCamera)
+        {
+            camera->SetPosition(Vector3((Real)frame.CameraPosition.X, (Real)frame.CameraPosition.Y, (Real)frame.CameraPosition.Z));
+            camera->SetOrientation(frame.CameraOrientation);
+        }
+
+        // Gather the frame stats (timings of the last frame)
+        const double time = Platform::GetTimeSeconds();
+        const auto& stats = ProfilingTools::Stats;
+        ReplayFrameStats& e = FramesStats.AddOne();
+        e.FrameTimeMs = LastFrameTime > 0.0 ? (float)((time - LastFrameTime) * 1000.0) : 0.0f;
+        e.UpdateTimeMs = stats.UpdateTimeMs;
+        e.PhysicsTimeMs = stats.PhysicsTimeMs;
+        e.DrawCPUTimeMs = stats.DrawCPUTimeMs;
+        e.DrawGPUTimeMs = stats.DrawGPUTimeMs;
+        e.DrawStats = stats.DrawStats;
+        LastFrameTime = time;
+        CurrentFrame++;
+    }
+}
+
+void PerformanceReplayService::Dispose()
+{
+    if (Mode == ReplayMode::Recording)
+        PerformanceReplay::StopRecording();
+    else if (Mode == ReplayMode::Replaying)
+    {
+        ExitOnEnd = false;
+        PerformanceReplay::StopReplay();
+    }
+}
+
+#endif
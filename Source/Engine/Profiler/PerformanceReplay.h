@@ -0,0 +1,79 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if COMPILE_WITH_PROFILER
+
+#include "Engine/Core/Types/String.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+/// <summary>
+/// Deterministic input replay for the performance regression testing. Records the user input, the main camera path and the simulation setup (fixed time step and random seed) of the gameplay session and replays it later to gather the comparable per-frame timings and rendering stats.
+/// </summary>
+API_CLASS(Static) class FLAXENGINE_API PerformanceReplay
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(PerformanceReplay);
+public:
+    /// <summary>
+    /// The fixed time step (in seconds) used by the simulation during recording and replay. The same frames sequence is simulated regardless of the actual frame rate.
+    /// </summary>
+    API_FIELD() static float DeltaTime;
+
+    /// <summary>
+    /// The seed for the random numbers generator used when starting the recording (0 to pick it from the current time). The replay uses the seed stored in the recording.
+    /// </summary>
+    API_FIELD() static int32 Seed;
+
+    /// <summary>
+    /// The amount of the initial replay frames excluded from the report summary (eg. to skip shaders compilation and content loading after the level start).
+    /// </summary>
+    API_FIELD() static int32 WarmupFrames;
+
+    /// <summary>
+    /// The frame time budget (in milliseconds) for the 95th percentile of the replay frame times. If exceeded, the report is marked as failed and the application exits with the error code (when replay was started from the command line). Use 0 to disable it.
+    /// </summary>
+    API_FIELD() static float FrameBudgetMs;
+
+public:
+    /// <summary>
+    /// Gets the random seed used by the active recording or replay. Gameplay code can use it to initialize the RandomStream to get the same random numbers during the replay.
+    /// </summary>
+    API_PROPERTY() static int32 GetActiveSeed();
+
+    /// <summary>
+    /// Returns true if the input recording is active.
+    /// </summary>
+    API_PROPERTY() static bool IsRecording();
+
+    /// <summary>
+    /// Returns true if the replay is active.
+    /// </summary>
+    API_PROPERTY() static bool IsReplaying();
+
+    /// <summary>
+    /// Starts the input recording. Enables the fixed time step simulation and initializes the random numbers generator with the seed.
+    /// </summary>
+    /// <param name="path">The output file path for the recording (saved on stop).</param>
+    API_FUNCTION() static void StartRecording(const StringView& path);
+
+    /// <summary>
+    /// Stops the input recording and saves it to the file.
+    /// </summary>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool StopRecording();
+
+    /// <summary>
+    /// Starts the replay of the recording. The report is saved after the last recorded frame.
+    /// </summary>
+    /// <param name="path">The recording file path.</param>
+    /// <param name="reportPath">The output report file path (JSON).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool StartReplay(const StringView& path, const StringView& reportPath);
+
+    /// <summary>
+    /// Stops the replay and saves the report for the frames replayed so far.
+    /// </summary>
+    API_FUNCTION() static void StopReplay();
+};
+
+#endif
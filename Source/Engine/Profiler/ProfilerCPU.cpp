@@ -4,7 +4,100 @@
 
 #include "ProfilerCPU.h"
 #include "Engine/Engine/Globals.h"
+#include "Engine/Platform/CriticalSection.h"
 #include "Engine/Threading/ThreadRegistry.h"
+#include "Engine/Threading/Threading.h"
+
+// The maximum amount of the dynamic event names interned by the profiler (names above the limit are replaced with a placeholder to keep memory bounded)
+#define PROFILER_CPU_MAX_DYNAMIC_NAMES 16384
+// The maximum amount of the entries in the per-thread dynamic names cache (cache gets cleared when it's full)
+#define PROFILER_CPU_MAX_NAMES_CACHE 1024
+
+namespace
+{
+    struct NamesTable
+    {
+        CriticalSection Locker;
+        Dictionary<StringView, const Char*> Names;
+        int32 DynamicNamesCount = 0;
+    };
+
+    // Used via function to be valid during static data initialization (eg. static ProfilerSrcLoc in code executed from other static constructors)
+    NamesTable& GetNamesTable()
+    {
+        static NamesTable table;
+        return table;
+    }
+
+    bool NameEquals(const Char* interned, const Char* name)
+    {
+        return StringUtils::Compare(interned, name) == 0;
+    }
+
+    bool NameEquals(const Char* interned, const char* name)
+    {
+        while (*interned && *interned == (Char)*name)
+        {
+            interned++;
+            name++;
+        }
+        return *interned == (Char)*name;
+    }
+
+    const Char* AddName(NamesTable& table, const StringView& name)
+    {
+        // Interned names are never released (static locations and recorded events keep pointers to them)
+        const int32 length = name.Length();
+        Char* copy = (Char*)Platform::Allocate((length + 1) * sizeof(Char), 16);
+        Platform::MemoryCopy(copy, name.Get(), length * sizeof(Char));
+        copy[length] = 0;
+        table.Names.Add(StringView(copy, length), copy);
+        return copy;
+    }
+
+    const Char* InternDynamicName(const StringView& name)
+    {
+        auto& table = GetNamesTable();
+        ScopeLock lock(table.Locker);
+        const Char* result;
+        if (!table.Names.TryGet(name, result))
+        {
+            // Limit the names table growth when events use the generated names (eg. with object names or counters)
+            if (table.DynamicNamesCount >= PROFILER_CPU_MAX_DYNAMIC_NAMES)
+                return TEXT("<Dynamic Event>");
+            table.DynamicNamesCount++;
+            result = AddName(table, name);
+        }
+        return result;
+    }
+
+    template<typename CharType>
+    const Char* GetInternedName(ProfilerCPU::Thread* thread, const CharType* name)
+    {
+        if (!name)
+            return TEXT("");
+
+        // Dynamic names are mostly string literals or long-living strings so cache the interned name by the text pointer (validate the contents in case memory got reused)
+        const Char* result;
+        if (thread->NamesCache.TryGet(name, result) && NameEquals(result, name))
+            return result;
+        result = InternDynamicName(String(name));
+        if (thread->NamesCache.Count() >= PROFILER_CPU_MAX_NAMES_CACHE)
+            thread->NamesCache.Clear();
+        thread->NamesCache[name] = result;
+        return result;
+    }
+}
+
+ProfilerSrcLoc::ProfilerSrcLoc(const Char* name)
+{
+    Name = ProfilerCPU::InternName(name ? StringView(name) : StringView::Empty);
+}
+
+ProfilerSrcLoc::ProfilerSrcLoc(const char* name)
+{
+    Name = ProfilerCPU::InternName(String(name ? name : ""));
+}
 
 THREADLOCAL ProfilerCPU::Thread* ProfilerCPU::Thread::Current = nullptr;
 Array<ProfilerCPU::Thread*, InlinedAllocation<64>> ProfilerCPU::Threads;
@@ -111,6 +204,16 @@ int32 ProfilerCPU::Thread::BeginEvent()
     e.Depth = _depth++;
     e.NativeMemoryAllocation = 0;
     e.ManagedMemoryAllocation = 0;
+    e.Name = TEXT("");
+    if (e.Depth < MaxActiveEvents)
+        _activeEvents[e.Depth] = index;
+    return index;
+}
+
+int32 ProfilerCPU::Thread::BeginEvent(const Char* name)
+{
+    const auto index = BeginEvent();
+    Buffer.Get(index).Name = name;
     return index;
 }
 
@@ -130,6 +233,15 @@ void ProfilerCPU::Thread::EndEvent()
     e.End = time;
 }
 
+int32 ProfilerCPU::Thread::GetActiveEvents(const Char** names, int32 maxCount)
+{
+    const int32 depth = Math::Min(_depth, MaxActiveEvents);
+    const int32 start = Math::Max(depth - maxCount, 0);
+    for (int32 i = start; i < depth; i++)
+        names[i - start] = Buffer.Get(_activeEvents[i]).Name;
+    return depth - start;
+}
+
 bool ProfilerCPU::IsProfilingCurrentThread()
 {
     return Enabled && Thread::Current != nullptr;
@@ -168,16 +280,7 @@ int32 ProfilerCPU::BeginEvent(const Char* name)
         return -1;
     const auto index = BeginEvent();
     const auto thread = Thread::Current;
-    auto& e = thread->Buffer.Get(index);
-    auto dst = e.Name;
-    auto src = name;
-    if (src)
-    {
-        const auto end = dst + ARRAY_COUNT(e.Name) - 1;
-        while (*src && dst != end)
-            *dst++ = *src++;
-    }
-    *dst = 0;
+    thread->Buffer.Get(index).Name = GetInternedName(thread, name);
     return index;
 }
 
@@ -187,16 +290,16 @@ int32 ProfilerCPU::BeginEvent(const char* name)
         return -1;
     const auto index = BeginEvent();
     const auto thread = Thread::Current;
-    auto& e = thread->Buffer.Get(index);
-    auto dst = e.Name;
-    auto src = name;
-    if (src)
-    {
-        const auto end = dst + ARRAY_COUNT(e.Name) - 1;
-        while (*src && dst != end)
-            *dst++ = *src++;
-    }
-    *dst = 0;
+    thread->Buffer.Get(index).Name = GetInternedName(thread, name);
+    return index;
+}
+
+int32 ProfilerCPU::BeginEvent(const ProfilerSrcLoc& srcLoc)
+{
+    if (!Enabled)
+        return -1;
+    const auto index = BeginEvent();
+    Thread::Current->Buffer.Get(index).Name = srcLoc.Name;
     return index;
 }
 
@@ -212,6 +315,26 @@ void ProfilerCPU::EndEvent()
         Thread::Current->EndEvent();
 }
 
+const Char* ProfilerCPU::InternName(const StringView& name)
+{
+    auto& table = GetNamesTable();
+    ScopeLock lock(table.Locker);
+    const Char* result;
+    if (!table.Names.TryGet(name, result))
+        result = AddName(table, name);
+    return result;
+}
+
+void ProfilerCPU::OnThreadExit()
+{
+    // Recorded events are kept (thread data is released on dispose) but the names cache is not used anymore
+    if (const auto thread = Thread::Current)
+    {
+        thread->NamesCache.Clear();
+        thread->NamesCache.SetCapacity(0);
+    }
+}
+
 void ProfilerCPU::Dispose()
 {
     Enabled = false;
@@ -7,11 +7,14 @@
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include <ThirdParty/tracy/Tracy.h>
 
 #if COMPILE_WITH_PROFILER
 
+#include "ProfilerSrcLoc.h"
+
 /// <summary>
 /// Provides CPU performance measuring methods.
 /// </summary>
@@ -51,7 +54,10 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// </summary>
         API_FIELD() int32 ManagedMemoryAllocation;
 
-        API_FIELD(Private, NoArray) Char Name[100];
+        /// <summary>
+        /// The event name. Points to the interned text (see ProfilerCPU::InternName) that is valid for the whole program lifetime.
+        /// </summary>
+        API_FIELD() const Char* Name;
     };
 
     /// <summary>
@@ -218,9 +224,16 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     /// </summary>
     class Thread
     {
+    public:
+        /// <summary>
+        /// The maximum depth of the active events tracked by the thread (see GetActiveEvents).
+        /// </summary>
+        static constexpr int32 MaxActiveEvents = 32;
+
     private:
         String _name;
         int32 _depth = 0;
+        int32 _activeEvents[MaxActiveEvents];
 
     public:
         Thread(const Char* name)
@@ -253,6 +266,16 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// </summary>
         EventBuffer Buffer;
 
+        /// <summary>
+        /// The net amount of the native memory allocated by this thread (in bytes). Memory freed by this thread is subtracted. Updated only when memory tracking is enabled.
+        /// </summary>
+        int64 MemoryAllocated = 0;
+
+        /// <summary>
+        /// The cache of the interned names for the dynamic event names used on this thread (key is the source text pointer). Used to skip the global names table lookup (and locking) for the repeated events. Limited in size and released when the thread exits.
+        /// </summary>
+        Dictionary<const void*, const Char*> NamesCache;
+
     public:
         /// <summary>
         /// Begins the event running on a this thread. Call EndEvent with index parameter equal to the returned value by BeginEvent function.
@@ -260,6 +283,13 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// <returns>The event token.</returns>
         int32 BeginEvent();
 
+        /// <summary>
+        /// Begins the event running on a this thread. Call EndEvent with index parameter equal to the returned value by BeginEvent function.
+        /// </summary>
+        /// <param name="name">The event name (interned).</param>
+        /// <returns>The event token.</returns>
+        int32 BeginEvent(const Char* name);
+
         /// <summary>
         /// Ends the event running on a this thread.
         /// </summary>
@@ -270,6 +300,14 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// Ends the last event running on a this thread.
         /// </summary>
         void EndEvent();
+
+        /// <summary>
+        /// Gets the names of the events that are currently active (not ended) on this thread. Can be called only from this thread.
+        /// </summary>
+        /// <param name="names">The output names buffer (ordered from the outermost event).</param>
+        /// <param name="maxCount">The size of the output buffer. If the events depth is larger, only the innermost events are returned.</param>
+        /// <returns>The amount of names written to the buffer.</returns>
+        int32 GetActiveEvents(const Char** names, int32 maxCount);
     };
 
 public:
@@ -314,6 +352,13 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     /// <returns>The event token.</returns>
     static int32 BeginEvent(const char* name);
 
+    /// <summary>
+    /// Begins the event. Call EndEvent with index parameter equal to the returned value by BeginEvent function.
+    /// </summary>
+    /// <param name="srcLoc">The event location (with the interned name).</param>
+    /// <returns>The event token.</returns>
+    static int32 BeginEvent(const ProfilerSrcLoc& srcLoc);
+
     /// <summary>
     /// Ends the event.
     /// </summary>
@@ -325,6 +370,18 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     /// </summary>
     static void EndEvent();
 
+    /// <summary>
+    /// Interns the event name. Returns the pointer to the name copy that is valid for the whole program lifetime (the same text always gives the same pointer).
+    /// </summary>
+    /// <param name="name">The event name.</param>
+    /// <returns>The interned name.</returns>
+    static const Char* InternName(const StringView& name);
+
+    /// <summary>
+    /// Releases the profiler caches of the calling thread. Called when the thread exits.
+    /// </summary>
+    static void OnThreadExit();
+
     /// <summary>
     /// Releases resources. Calls to the profiling API after Dispose are not valid.
     /// </summary>
@@ -348,6 +405,11 @@ struct ScopeProfileBlockCPU
         Index = ProfilerCPU::BeginEvent(name);
     }
 
+    FORCE_INLINE ScopeProfileBlockCPU(const ProfilerSrcLoc& srcLoc)
+    {
+        Index = ProfilerCPU::BeginEvent(srcLoc);
+    }
+
     FORCE_INLINE ~ScopeProfileBlockCPU()
     {
         ProfilerCPU::EndEvent(Index);
@@ -360,8 +422,6 @@ struct TIsPODType<ProfilerCPU::Event>
     enum { Value = true };
 };
 
-#include "ProfilerSrcLoc.h"
-
 // Shortcut macros for profiling a single code block execution on CPU
 // Use ZoneTransient for Tracy for code that can be hot-reloaded (eg. in Editor) or if name can be a variable
 #define PROFILE_CPU_USE_TRANSIENT_DATA 0
@@ -370,8 +430,9 @@ struct TIsPODType<ProfilerCPU::Event>
 #define PROFILE_CPU() ZoneTransient(___tracy_scoped_zone, true); ScopeProfileBlockCPU ProfileBlockCPU(__FUNCTION__)
 #define PROFILE_CPU_NAMED(name) ZoneTransientN(___tracy_scoped_zone, name, true); ScopeProfileBlockCPU ProfileBlockCPU(name)
 #else
-#define PROFILE_CPU() ZoneNamed(___tracy_scoped_zone, true); ScopeProfileBlockCPU ProfileBlockCPU(__FUNCTION__)
-#define PROFILE_CPU_NAMED(name) ZoneNamedN(___tracy_scoped_zone, name, true); ScopeProfileBlockCPU ProfileBlockCPU(name)
+// Event name is interned once per code block (static location) so the event only references it
+#define PROFILE_CPU() ZoneNamed(___tracy_scoped_zone, true); static const ProfilerSrcLoc ProfileSrcLocCPU(__FUNCTION__); ScopeProfileBlockCPU ProfileBlockCPU(ProfileSrcLocCPU)
+#define PROFILE_CPU_NAMED(name) ZoneNamedN(___tracy_scoped_zone, name, true); static const ProfilerSrcLoc ProfileSrcLocCPU(name); ScopeProfileBlockCPU ProfileBlockCPU(ProfileSrcLocCPU)
 #endif
 
 #ifdef TRACY_ENABLE
@@ -7,6 +7,7 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPUTimerQuery.h"
+#include "Engine/Graphics/GPUPipelineStatsQuery.h"
 #include "Engine/Graphics/GPUContext.h"
 
 RenderStatsData RenderStatsData::Counter;
@@ -14,7 +15,12 @@ RenderStatsData RenderStatsData::Counter;
 int32 ProfilerGPU::_depth = 0;
 Array<GPUTimerQuery*> ProfilerGPU::_timerQueriesPool;
 Array<GPUTimerQuery*> ProfilerGPU::_timerQueriesFree;
+Array<GPUPipelineStatsQuery*> ProfilerGPU::_statsQueriesPool;
+Array<GPUPipelineStatsQuery*> ProfilerGPU::_statsQueriesFree;
+Array<int32> ProfilerGPU::_eventsStack;
+int32 ProfilerGPU::_activeStatsSegment = -1;
 bool ProfilerGPU::Enabled = true;
+bool ProfilerGPU::PipelineStatsEnabled = false;
 int32 ProfilerGPU::CurrentBuffer = 0;
 ProfilerGPU::EventBuffer ProfilerGPU::Buffers[PROFILER_GPU_EVENTS_FRAMES];
 
@@ -29,6 +35,10 @@ void ProfilerGPU::EventBuffer::EndAll()
     {
         _data[i].Timer->End();
     }
+    for (int32 i = 0; i < _statsSegments.Count(); i++)
+    {
+        _statsSegments[i].Query->End();
+    }
 }
 
 void ProfilerGPU::EventBuffer::TryResolve()
@@ -42,6 +52,11 @@ void ProfilerGPU::EventBuffer::TryResolve()
         if (!_data[i].Timer->HasResult())
             return;
     }
+    for (int32 i = _statsSegments.Count() - 1; i >= 0; i--)
+    {
+        if (!_statsSegments[i].Query->HasResult())
+            return;
+    }
 
     // Collect queries results and free them
     for (int32 i = 0; i < _data.Count(); i++)
@@ -52,6 +67,32 @@ void ProfilerGPU::EventBuffer::TryResolve()
         e.Timer = nullptr;
     }
 
+    // Collect pipeline statistics of the events segments and sum them into parent events (children are always after their parent)
+    if (_statsSegments.HasItems())
+    {
+        for (int32 i = 0; i < _statsSegments.Count(); i++)
+        {
+            auto& segment = _statsSegments[i];
+            GPUPipelineStats stats;
+            segment.Query->GetResult(stats);
+            _data[segment.EventIndex].PipelineStats.Add(stats);
+            _statsQueriesFree.Add(segment.Query);
+        }
+        _statsSegments.Clear();
+        for (int32 i = _data.Count() - 1; i > 0; i--)
+        {
+            const auto& e = _data[i];
+            for (int32 j = i - 1; j >= 0; j--)
+            {
+                if (_data[j].Depth < e.Depth)
+                {
+                    _data[j].PipelineStats.Add(e.PipelineStats);
+                    break;
+                }
+            }
+        }
+    }
+
     _isResolved = true;
 }
 
@@ -72,6 +113,9 @@ void ProfilerGPU::EventBuffer::Extract(Array<Event>& data) const
 void ProfilerGPU::EventBuffer::Clear()
 {
     _data.Clear();
+    for (auto& segment : _statsSegments)
+        _statsQueriesFree.Add(segment.Query);
+    _statsSegments.Clear();
     _isResolved = false;
     FrameIndex = 0;
 }
@@ -92,6 +136,45 @@ GPUTimerQuery* ProfilerGPU::GetTimerQuery()
     return result;
 }
 
+GPUPipelineStatsQuery* ProfilerGPU::GetStatsQuery()
+{
+    GPUPipelineStatsQuery* result;
+    if (_statsQueriesFree.HasItems())
+    {
+        result = _statsQueriesFree.Last();
+        _statsQueriesFree.RemoveLast();
+    }
+    else
+    {
+        result = GPUDevice::Instance->CreatePipelineStatsQuery();
+        if (result)
+            _statsQueriesPool.Add(result);
+    }
+    return result;
+}
+
+void ProfilerGPU::BeginStatsSegment()
+{
+    if (!PipelineStatsEnabled || _eventsStack.IsEmpty())
+        return;
+    GPUPipelineStatsQuery* query = GetStatsQuery();
+    if (!query)
+        return;
+    query->Begin();
+    auto& buffer = Buffers[CurrentBuffer];
+    _activeStatsSegment = buffer._statsSegments.Count();
+    buffer._statsSegments.Add({ query, _eventsStack.Last() });
+}
+
+void ProfilerGPU::EndStatsSegment()
+{
+    if (_activeStatsSegment == -1)
+        return;
+    auto& buffer = Buffers[CurrentBuffer];
+    buffer._statsSegments[_activeStatsSegment].Query->End();
+    _activeStatsSegment = -1;
+}
+
 int32 ProfilerGPU::BeginEvent(const Char* name)
 {
     if (!Enabled)
@@ -103,12 +186,19 @@ int32 ProfilerGPU::BeginEvent(const Char* name)
     Event e;
     e.Name = name;
     e.Stats = RenderStatsData::Counter;
+    Platform::MemoryClear(&e.PipelineStats, sizeof(e.PipelineStats));
     e.Timer = GetTimerQuery();
     e.Timer->Begin();
     e.Depth = _depth++;
 
     auto& buffer = Buffers[CurrentBuffer];
     const auto index = buffer.Add(e);
+
+    // Start a new pipeline statistics segment for this event (queries cannot be nested)
+    EndStatsSegment();
+    _eventsStack.Add(index);
+    BeginStatsSegment();
+
     return index;
 }
 
@@ -123,6 +213,12 @@ void ProfilerGPU::EndEvent(int32 index)
     e->Stats.Mix(RenderStatsData::Counter);
     e->Timer->End();
 
+    // Continue the pipeline statistics of the parent event
+    EndStatsSegment();
+    if (_eventsStack.HasItems())
+        _eventsStack.RemoveLast();
+    BeginStatsSegment();
+
 #if GPU_ALLOW_PROFILE_EVENTS
     GPUDevice::Instance->GetMainContext()->EventEnd();
 #endif
@@ -133,6 +229,8 @@ void ProfilerGPU::BeginFrame()
     // Clear stats
     RenderStatsData::Counter = RenderStatsData();
     _depth = 0;
+    _eventsStack.Clear();
+    _activeStatsSegment = -1;
     Buffers[CurrentBuffer].FrameIndex = Engine::FrameCount;
 
     // Try to resolve previous frames
@@ -147,6 +245,7 @@ void ProfilerGPU::OnPresent()
     // End all current frame queries to prevent invalid event duration values
     auto& buffer = Buffers[CurrentBuffer];
     buffer.EndAll();
+    _activeStatsSegment = -1;
 }
 
 void ProfilerGPU::EndFrame()
@@ -157,6 +256,8 @@ void ProfilerGPU::EndFrame()
     }
 
     // Move frame
+    EndStatsSegment();
+    _eventsStack.Clear();
     CurrentBuffer = (CurrentBuffer + 1) % PROFILER_GPU_EVENTS_FRAMES;
 
     // Prepare current frame buffer
@@ -196,6 +297,9 @@ void ProfilerGPU::Dispose()
 {
     _timerQueriesPool.ClearDelete();
     _timerQueriesFree.Clear();
+    _statsQueriesPool.ClearDelete();
+    _statsQueriesFree.Clear();
+    _eventsStack.Resize(0);
 }
 
 #endif
@@ -5,9 +5,11 @@
 #include "Engine/Core/NonCopyable.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Scripting/ScriptingType.h"
+#include "Engine/Graphics/GPUPipelineStats.h"
 #include "RenderStats.h"
 
 class GPUTimerQuery;
+class GPUPipelineStatsQuery;
 
 #if COMPILE_WITH_PROFILER
 
@@ -43,6 +45,11 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
         /// </summary>
         API_FIELD() RenderStatsData Stats;
 
+        /// <summary>
+        /// The GPU pipeline statistics for this event (including the child events). Valid only if pipeline statistics collecting was enabled and supported by the graphics backend.
+        /// </summary>
+        API_FIELD() GPUPipelineStats PipelineStats;
+
         /// <summary>
         /// The event execution time on a GPU (in milliseconds).
         /// </summary>
@@ -59,9 +66,17 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
     /// </summary>
     class EventBuffer : public NonCopyable
     {
+        friend ProfilerGPU;
     private:
+        struct StatsSegment
+        {
+            GPUPipelineStatsQuery* Query;
+            int32 EventIndex;
+        };
+
         bool _isResolved = true;
         Array<Event> _data;
+        Array<StatsSegment> _statsSegments;
 
     public:
         /// <summary>
@@ -75,7 +90,7 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
         bool HasData() const;
 
         /// <summary>
-        /// Ends all used timer queries.
+        /// Ends all used timer and pipeline statistics queries.
         /// </summary>
         void EndAll();
 
@@ -119,7 +134,15 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
     static Array<GPUTimerQuery*> _timerQueriesPool;
     static Array<GPUTimerQuery*> _timerQueriesFree;
 
+    static Array<GPUPipelineStatsQuery*> _statsQueriesPool;
+    static Array<GPUPipelineStatsQuery*> _statsQueriesFree;
+    static Array<int32> _eventsStack;
+    static int32 _activeStatsSegment;
+
     static GPUTimerQuery* GetTimerQuery();
+    static GPUPipelineStatsQuery* GetStatsQuery();
+    static void BeginStatsSegment();
+    static void EndStatsSegment();
 
 public:
     /// <summary>
@@ -127,6 +150,11 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
     /// </summary>
     static bool Enabled;
 
+    /// <summary>
+    /// True if collect the GPU pipeline statistics (shader invocations, primitives count) per profiler event, otherwise false. Pipeline statistics queries are measured per non-overlapping GPU work segment between the events boundaries so they are not nested. Ignored if graphics backend doesn't support pipeline statistics queries.
+    /// </summary>
+    static bool PipelineStatsEnabled;
+
     /// <summary>
     /// The current frame buffer to collect events.
     /// </summary>
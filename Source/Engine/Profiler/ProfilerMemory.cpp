@@ -0,0 +1,262 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#if COMPILE_WITH_PROFILER
+
+#include "ProfilerMemory.h"
+#include "ProfilerCPU.h"
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/HashFunctions.h"
+#include "Engine/Scripting/Enums.h"
+
+bool ProfilerMemory::Enabled = true;
+bool ProfilerMemory::SampleAllocations = false;
+int32 ProfilerMemory::SampleRate = 100;
+int32 ProfilerMemory::SampleBytes = 0;
+
+#if COMPILE_WITH_MEMORY_TRACKING
+
+namespace
+{
+    // Header placed before every tracked allocation
+    struct alignas(16) AllocationHeader
+    {
+        uint64 Size;
+        uint32 Offset;
+        ProfilerMemory::Groups Group;
+    };
+
+    static_assert(sizeof(AllocationHeader) == 16, "Invalid tracked allocation header size.");
+
+    volatile int64 GroupCurrent[(int32)ProfilerMemory::Groups::MAX];
+    volatile int64 GroupPeak[(int32)ProfilerMemory::Groups::MAX];
+    volatile int64 GroupCount[(int32)ProfilerMemory::Groups::MAX];
+    THREADLOCAL ProfilerMemory::Groups CurrentGroup = ProfilerMemory::Groups::Default;
+
+// The capacity of the allocation call sites table (power of two)
+#define ALLOCATION_SITES_MAX 1024
+
+// The maximum amount of the profiler events used to identify the call site (innermost ones)
+#define ALLOCATION_SITE_DEPTH 8
+
+    // Allocation call site (stored in a static table that doesn't allocate memory to be usable from within the allocator)
+    struct AllocationSite
+    {
+        uint32 Hash;
+        ProfilerMemory::Groups Group;
+        int32 Depth;
+        const Char* Events[ALLOCATION_SITE_DEPTH];
+        int32 Samples;
+        int64 Bytes;
+    };
+
+    volatile int64 SitesLock = 0;
+    AllocationSite Sites[ALLOCATION_SITES_MAX];
+    AllocationSite SitesCopy[ALLOCATION_SITES_MAX];
+    THREADLOCAL int32 SampleAllocationsLeft = 0;
+    THREADLOCAL int64 SampleBytesLeft = 0;
+    THREADLOCAL bool IsSampling = false;
+
+    FORCE_INLINE bool TryLockSites()
+    {
+        return Platform::InterlockedCompareExchange(&SitesLock, 1, 0) == 0;
+    }
+
+    FORCE_INLINE void LockSites()
+    {
+        while (!TryLockSites())
+            Platform::Sleep(0);
+    }
+
+    FORCE_INLINE void UnlockSites()
+    {
+        Platform::AtomicStore(&SitesLock, 0);
+    }
+
+    void SampleAllocation(ProfilerMemory::Groups group, uint64 size)
+    {
+        // Check if sample this allocation
+        bool sample = false;
+        if (ProfilerMemory::SampleRate > 0 && --SampleAllocationsLeft <= 0)
+        {
+            SampleAllocationsLeft = ProfilerMemory::SampleRate;
+            sample = true;
+        }
+        if (ProfilerMemory::SampleBytes > 0 && (SampleBytesLeft -= (int64)size) <= 0)
+        {
+            SampleBytesLeft = ProfilerMemory::SampleBytes;
+            sample = true;
+        }
+        if (!sample || IsSampling)
+            return;
+        IsSampling = true;
+
+        // Identify the call site by the active profiler events
+        AllocationSite site;
+        site.Group = group;
+        site.Depth = 0;
+        if (ProfilerCPU::Thread* thread = ProfilerCPU::Thread::Current)
+            site.Depth = thread->GetActiveEvents(site.Events, ALLOCATION_SITE_DEPTH);
+        site.Hash = (uint32)group + 1;
+        for (int32 i = 0; i < site.Depth; i++)
+            CombineHash(site.Hash, site.Events[i]);
+        if (site.Hash == 0)
+            site.Hash = 1;
+
+        // Accumulate the sample (linear probing, samples are dropped when table is full or when other thread holds the lock to not stall the allocation)
+        if (!TryLockSites())
+        {
+            IsSampling = false;
+            return;
+        }
+        for (int32 probe = 0; probe < ALLOCATION_SITES_MAX; probe++)
+        {
+            AllocationSite& e = Sites[(site.Hash + probe) & (ALLOCATION_SITES_MAX - 1)];
+            if (e.Hash == 0)
+            {
+                e = site;
+                e.Samples = 1;
+                e.Bytes = (int64)size;
+                break;
+            }
+            if (e.Hash == site.Hash && e.Group == site.Group && e.Depth == site.Depth && Platform::MemoryCompare(e.Events, site.Events, site.Depth * sizeof(const Char*)) == 0)
+            {
+                e.Samples++;
+                e.Bytes += (int64)size;
+                break;
+            }
+        }
+        UnlockSites();
+
+        IsSampling = false;
+    }
+}
+
+void* TrackedAllocator::Allocate(uint64 size, uint64 alignment)
+{
+    const uint64 offset = alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+    byte* ptr = (byte*)BaseAllocator::Allocate(size + offset, offset);
+    if (!ptr)
+        return nullptr;
+    AllocationHeader* header = (AllocationHeader*)(ptr + offset) - 1;
+    header->Size = size;
+    header->Offset = (uint32)offset;
+    header->Group = ProfilerMemory::Enabled ? CurrentGroup : ProfilerMemory::Groups::MAX;
+    if (header->Group != ProfilerMemory::Groups::MAX)
+    {
+        ProfilerMemory::OnAllocate(header->Group, size);
+        if (ProfilerMemory::SampleAllocations)
+            SampleAllocation(header->Group, size);
+    }
+    return header + 1;
+}
+
+void TrackedAllocator::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+    const AllocationHeader* header = (AllocationHeader*)ptr - 1;
+    if (header->Group != ProfilerMemory::Groups::MAX)
+        ProfilerMemory::OnFree(header->Group, header->Size);
+    BaseAllocator::Free((byte*)ptr - header->Offset);
+}
+
+#endif
+
+bool ProfilerMemory::IsAvailable()
+{
+#if COMPILE_WITH_MEMORY_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProfilerMemory::GroupStats ProfilerMemory::GetGroupStats(Groups group)
+{
+    GroupStats result;
+#if COMPILE_WITH_MEMORY_TRACKING
+    if (group < Groups::MAX)
+    {
+        result.Current = Platform::AtomicRead(&GroupCurrent[(int32)group]);
+        result.Peak = Platform::AtomicRead(&GroupPeak[(int32)group]);
+        result.Count = Platform::AtomicRead(&GroupCount[(int32)group]);
+        return result;
+    }
+#endif
+    result.Current = result.Peak = result.Count = 0;
+    return result;
+}
+
+void ProfilerMemory::GetAllocationSites(Array<AllocationSiteStats>& result, bool reset)
+{
+    result.Clear();
+#if COMPILE_WITH_MEMORY_TRACKING
+    // Copy the sites to prevent allocating memory while holding the lock
+    LockSites();
+    Platform::MemoryCopy(SitesCopy, Sites, sizeof(Sites));
+    if (reset)
+        Platform::MemoryClear(Sites, sizeof(Sites));
+    UnlockSites();
+
+    for (const AllocationSite& site : SitesCopy)
+    {
+        if (site.Hash == 0)
+            continue;
+        AllocationSiteStats& e = result.AddOne();
+        e.Group = site.Group;
+        e.Samples = site.Samples;
+        e.Bytes = site.Bytes;
+        e.Name = ScriptingEnum::ToString(site.Group);
+        for (int32 i = 0; i < site.Depth; i++)
+        {
+            e.Name += i == 0 ? TEXT(": ") : TEXT(" > ");
+            e.Name += site.Events[i];
+        }
+    }
+#endif
+}
+
+ProfilerMemory::Groups ProfilerMemory::GetCurrentGroup()
+{
+#if COMPILE_WITH_MEMORY_TRACKING
+    return CurrentGroup;
+#else
+    return Groups::Default;
+#endif
+}
+
+void ProfilerMemory::SetCurrentGroup(Groups group)
+{
+#if COMPILE_WITH_MEMORY_TRACKING
+    CurrentGroup = group;
+#endif
+}
+
+void ProfilerMemory::OnAllocate(Groups group, uint64 size)
+{
+#if COMPILE_WITH_MEMORY_TRACKING
+    const int32 index = (int32)group;
+    const int64 current = Platform::InterlockedAdd(&GroupCurrent[index], (int64)size) + (int64)size;
+    Platform::InterlockedIncrement(&GroupCount[index]);
+    if (current > Platform::AtomicRead(&GroupPeak[index]))
+        Platform::AtomicStore(&GroupPeak[index], current);
+
+    // Track memory per-thread
+    if (ProfilerCPU::Thread* thread = ProfilerCPU::Thread::Current)
+        thread->MemoryAllocated += (int64)size;
+#endif
+}
+
+void ProfilerMemory::OnFree(Groups group, uint64 size)
+{
+#if COMPILE_WITH_MEMORY_TRACKING
+    const int32 index = (int32)group;
+    Platform::InterlockedAdd(&GroupCurrent[index], -(int64)size);
+    Platform::InterlockedDecrement(&GroupCount[index]);
+    if (ProfilerCPU::Thread* thread = ProfilerCPU::Thread::Current)
+        thread->MemoryAllocated -= (int64)size;
+#endif
+}
+
+#endif
@@ -0,0 +1,230 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+#if COMPILE_WITH_PROFILER
+
+/// <summary>
+/// Native memory allocations tracking per engine subsystem. Allocations done via the engine Allocator are attributed to the memory group that is active on the calling thread (see PROFILE_MEM).
+/// </summary>
+/// <remarks>Requires engine built with memory tracking enabled (COMPILE_WITH_MEMORY_TRACKING=1), otherwise all stats are empty.</remarks>
+API_CLASS(Static) class FLAXENGINE_API ProfilerMemory
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(ProfilerMemory);
+public:
+    /// <summary>
+    /// The memory groups used to attribute allocations.
+    /// </summary>
+    API_ENUM() enum class Groups : uint8
+    {
+        /// <summary>
+        /// Allocations outside any memory group scope.
+        /// </summary>
+        Default,
+
+        /// <summary>
+        /// Content assets loading and data.
+        /// </summary>
+        Content,
+
+        /// <summary>
+        /// Graphics and rendering.
+        /// </summary>
+        Graphics,
+
+        /// <summary>
+        /// Physics simulation.
+        /// </summary>
+        Physics,
+
+        /// <summary>
+        /// Audio playback.
+        /// </summary>
+        Audio,
+
+        /// <summary>
+        /// Animations.
+        /// </summary>
+        Animations,
+
+        /// <summary>
+        /// Scripting and managed runtime interop.
+        /// </summary>
+        Scripting,
+
+        /// <summary>
+        /// Networking and replication.
+        /// </summary>
+        Networking,
+
+        /// <summary>
+        /// Level and scene objects.
+        /// </summary>
+        Level,
+
+        /// <summary>
+        /// Navigation.
+        /// </summary>
+        Navigation,
+
+        /// <summary>
+        /// Particles simulation.
+        /// </summary>
+        Particles,
+
+        /// <summary>
+        /// User interface.
+        /// </summary>
+        UI,
+
+        API_ENUM(Attributes="HideInEditor")
+        MAX
+    };
+
+    /// <summary>
+    /// The memory group stats.
+    /// </summary>
+    API_STRUCT(NoDefault) struct GroupStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(GroupStats);
+
+        /// <summary>
+        /// The currently allocated memory (in bytes).
+        /// </summary>
+        API_FIELD() int64 Current;
+
+        /// <summary>
+        /// The peak allocated memory (in bytes).
+        /// </summary>
+        API_FIELD() int64 Peak;
+
+        /// <summary>
+        /// The amount of the alive allocations.
+        /// </summary>
+        API_FIELD() int64 Count;
+    };
+
+    /// <summary>
+    /// The sampled allocations stats of a single call site (see SampleAllocations).
+    /// </summary>
+    API_STRUCT(NoDefault) struct AllocationSiteStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(AllocationSiteStats);
+
+        /// <summary>
+        /// The call site name (active memory group and the profiler events stack at the allocation, from the outermost event).
+        /// </summary>
+        API_FIELD() String Name;
+
+        /// <summary>
+        /// The memory group of the allocations.
+        /// </summary>
+        API_FIELD() Groups Group;
+
+        /// <summary>
+        /// The amount of the sampled allocations.
+        /// </summary>
+        API_FIELD() int32 Samples;
+
+        /// <summary>
+        /// The total size of the sampled allocations (in bytes).
+        /// </summary>
+        API_FIELD() int64 Bytes;
+    };
+
+    /// <summary>
+    /// Helper structure used to scope the memory group on the current thread.
+    /// </summary>
+    struct GroupScope
+    {
+        Groups Prev;
+
+        FORCE_INLINE GroupScope(Groups group)
+        {
+            Prev = GetCurrentGroup();
+            SetCurrentGroup(group);
+        }
+
+        FORCE_INLINE ~GroupScope()
+        {
+            SetCurrentGroup(Prev);
+        }
+    };
+
+public:
+    /// <summary>
+    /// True if tracking is enabled, otherwise new allocations are not being attributed to any group.
+    /// </summary>
+    API_FIELD() static bool Enabled;
+
+    /// <summary>
+    /// True if sample the allocations call sites (see SampleRate and SampleBytes). The call site is identified by the memory group and the profiler events active on the allocating thread.
+    /// </summary>
+    API_FIELD() static bool SampleAllocations;
+
+    /// <summary>
+    /// The allocations sampling interval: every Nth allocation on the thread is sampled. Use 0 to disable it.
+    /// </summary>
+    API_FIELD() static int32 SampleRate;
+
+    /// <summary>
+    /// The allocations sampling interval in bytes: an allocation is sampled every time the thread allocates this amount of memory. Use 0 to disable it.
+    /// </summary>
+    API_FIELD() static int32 SampleBytes;
+
+    /// <summary>
+    /// Checks if the memory tracking is available in this build.
+    /// </summary>
+    API_PROPERTY() static bool IsAvailable();
+
+    /// <summary>
+    /// Gets the memory group stats.
+    /// </summary>
+    /// <param name="group">The memory group.</param>
+    /// <returns>The stats.</returns>
+    API_FUNCTION() static GroupStats GetGroupStats(Groups group);
+
+    /// <summary>
+    /// Gets the sampled allocations call sites (see SampleAllocations).
+    /// </summary>
+    /// <param name="result">The output call sites stats.</param>
+    /// <param name="reset">True if reset the samples after reading them (eg. to gather them per-frame).</param>
+    static void GetAllocationSites(Array<AllocationSiteStats, HeapAllocation>& result, bool reset = false);
+
+    /// <summary>
+    /// Gets the memory group that is active on the current thread.
+    /// </summary>
+    static Groups GetCurrentGroup();
+
+    /// <summary>
+    /// Sets the memory group that is active on the current thread.
+    /// </summary>
+    static void SetCurrentGroup(Groups group);
+
+    /// <summary>
+    /// Called by the engine allocator on memory allocation.
+    /// </summary>
+    static void OnAllocate(Groups group, uint64 size);
+
+    /// <summary>
+    /// Called by the engine allocator on memory free.
+    /// </summary>
+    static void OnFree(Groups group, uint64 size);
+};
+
+#endif
+
+#if COMPILE_WITH_MEMORY_TRACKING
+
+// Attributes the native memory allocations in the current scope to the given memory group
+#define PROFILE_MEM(group) ProfilerMemory::GroupScope ProfileMem(ProfilerMemory::Groups::group)
+
+#else
+
+#define PROFILE_MEM(group)
+
+#endif
@@ -15,4 +15,18 @@ struct FLAXENGINE_API SourceLocationData
     uint32 color;
 };
 
+/// <summary>
+/// Static location of the profiler event (declared once per profiled code block). Holds the interned event name so events can reference it without copying the text.
+/// </summary>
+struct FLAXENGINE_API ProfilerSrcLoc
+{
+    /// <summary>
+    /// The event name (interned, valid for the whole program lifetime).
+    /// </summary>
+    const Char* Name;
+
+    ProfilerSrcLoc(const Char* name);
+    ProfilerSrcLoc(const char* name);
+};
+
 #endif
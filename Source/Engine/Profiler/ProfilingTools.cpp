@@ -6,11 +6,60 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Types/DateTime.h"
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Color.h"
+#include "Engine/Debug/DebugDraw.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Renderer/RendererAllocation.h"
+#include "Engine/Particles/Particles.h"
+#include "Engine/Content/Loading/ContentLoadingManager.h"
+#include "Engine/Networking/NetworkManager.h"
+#include "Engine/Networking/NetworkReplicator.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Scripting/ManagedCLR/MCore.h"
+#include "Engine/Threading/ThreadRegistry.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/ThreadPool.h"
+#include "Engine/Threading/WorkerStats.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "Engine/Scripting/Enums.h"
+#include "Engine/Streaming/Streaming.h"
 
 ProfilingTools::MainStats ProfilingTools::Stats;
 Array<ProfilingTools::ThreadStats, InlinedAllocation<64>> ProfilingTools::EventsCPU;
 Array<ProfilerGPU::Event> ProfilingTools::EventsGPU;
+Array<ProfilingTools::PassStatsGPU> ProfilingTools::PassesGPU;
+bool ProfilingTools::ShowGPUOverlay = false;
+Array<ProfilerMemory::GroupStats> ProfilingTools::MemoryGroups;
+int32 ProfilingTools::AllocationSitesCount = 100;
+Array<ProfilerMemory::AllocationSiteStats> ProfilingTools::AllocationSites;
+Array<ProfilingTools::ContentQueueStats> ProfilingTools::ContentQueues;
+Array<ProfilingTools::WorkerThreadStats> ProfilingTools::WorkerThreads;
+Array<ProfilingTools::WorkerPoolStats> ProfilingTools::WorkerPools;
+bool ProfilingTools::TrackMemoryGPU = false;
+int32 ProfilingTools::MemoryResourcesCountGPU = 32;
+Array<ProfilingTools::MemoryGroupStatsGPU> ProfilingTools::MemoryCategoriesGPU;
+Array<ProfilingTools::MemoryGroupStatsGPU> ProfilingTools::MemoryTextureGroupsGPU;
+Array<ProfilingTools::MemoryResourceStatsGPU> ProfilingTools::MemoryResourcesGPU;
+bool ProfilingTools::TrackContentLoads = false;
+Array<ProfilingTools::ContentLoadEvent> ProfilingTools::ContentLoads;
+Array<ProfilingTools::ContentLoadTypeStats> ProfilingTools::ContentLoadTypes;
+Array<NetworkReplicationStats> ProfilingTools::NetworkTypes;
+Array<NetworkReplicationStats> ProfilingTools::NetworkRpcs;
+String ProfilingTools::TraceFolder;
+float ProfilingTools::TraceThresholdMs = 50.0f;
+int32 ProfilingTools::TraceFrames = 120;
+int32 ProfilingTools::TraceMaxFiles = 20;
+float ProfilingTools::HitchBudgetMs = 0.0f;
+String ProfilingTools::LastHitchReport;
 
 class ProfilingToolsService : public EngineService
 {
@@ -21,12 +70,861 @@ class ProfilingToolsService : public EngineService
         Platform::MemoryClear(&ProfilingTools::Stats, sizeof(ProfilingTools::MainStats));
     }
 
+    bool Init() override;
     void Update() override;
     void Dispose() override;
 };
 
 ProfilingToolsService ProfilingToolsServiceInstance;
 
+bool ProfilingTools::GetPipelineStatsEnabled()
+{
+    return ProfilerGPU::PipelineStatsEnabled;
+}
+
+void ProfilingTools::SetPipelineStatsEnabled(bool value)
+{
+    ProfilerGPU::PipelineStatsEnabled = value;
+}
+
+namespace
+{
+    struct TraceEventGPU
+    {
+        const Char* Name;
+        float Time;
+        int32 Depth;
+    };
+
+    struct TraceFrame
+    {
+        uint64 FrameIndex;
+        double Time;
+        float FrameTimeMs;
+        ProcessMemoryStats ProcessMemory;
+        uint64 MemoryGPU;
+        // Indexed like ProfilingTools::EventsCPU (threads list only grows)
+        Array<Array<ProfilerCPU::Event>> EventsCPU;
+        Array<TraceEventGPU> EventsGPU;
+        Array<ProfilingTools::ContentLoadEvent> AssetLoads;
+        int32 GCCollections;
+    };
+
+    struct HitchContributor
+    {
+        const Char* Name;
+        int32 Thread;
+        double Time;
+    };
+
+    // Ring-buffer with the recent frames recorded for the trace capture
+    Array<TraceFrame> TraceRing;
+    int32 TraceRingHead = 0;
+    int32 TraceRingCount = 0;
+    double TraceLastUpdateTime = 0.0;
+    int32 TraceCooldown = 0;
+    int32 TraceSaveDelay = 0;
+    int32 TraceGCCount = -1;
+
+    // The recorded content loading events (for the CSV export)
+    Array<ProfilingTools::ContentLoadEvent> ContentLoadsHistory;
+    Array<ContentLoadingManager::AssetLoadInfo> ContentLoadsBuffer;
+    Array<WorkerStats> WorkerStatsBuffer;
+    double WorkerStatsLastTime = 0.0;
+
+    // The maximum amount of the content loading events kept in the history
+#define CONTENT_LOADS_HISTORY_MAX 100000
+
+    // The detected hitch waiting for the report (time range in milliseconds)
+    int32 HitchDelay = 0;
+    uint64 HitchFrame;
+    float HitchTimeMs;
+    double HitchStart, HitchEnd;
+
+    // The amount of frames to wait after the hitch before saving the trace (to include the events that ended later)
+#define TRACE_SAVE_DELAY 3
+
+    bool SortPassByTime(const ProfilingTools::PassStatsGPU& a, const ProfilingTools::PassStatsGPU& b)
+    {
+        return a.TimeMs > b.TimeMs;
+    }
+
+    bool SortHitchContributor(const HitchContributor& a, const HitchContributor& b)
+    {
+        return a.Time > b.Time;
+    }
+
+    bool SortAssetLoad(const ProfilingTools::ContentLoadEvent* const& a, const ProfilingTools::ContentLoadEvent* const& b)
+    {
+        return a->DurationMs > b->DurationMs;
+    }
+
+    bool SortContentLoadType(const ProfilingTools::ContentLoadTypeStats& a, const ProfilingTools::ContentLoadTypeStats& b)
+    {
+        return a.TypeName.Compare(b.TypeName) < 0;
+    }
+
+    FORCE_INLINE const TraceFrame& GetTraceFrame(int32 index)
+    {
+        return TraceRing[(TraceRingHead - TraceRingCount + index + TraceRing.Count()) % TraceRing.Count()];
+    }
+
+    void UpdatePassesGPU()
+    {
+        auto& passes = ProfilingTools::PassesGPU;
+        passes.Clear();
+        const auto& events = ProfilingTools::EventsGPU;
+        for (int32 i = 0; i < events.Count(); i++)
+        {
+            const auto& e = events[i];
+
+            // Skip events nested in the event with the same name (eg. recursive passes) to prevent counting them twice
+            bool nested = false;
+            for (int32 j = i - 1, depth = e.Depth; j >= 0 && depth > 0; j--)
+            {
+                if (events[j].Depth < depth)
+                {
+                    depth = events[j].Depth;
+                    if (StringUtils::Compare(events[j].Name, e.Name) == 0)
+                    {
+                        nested = true;
+                        break;
+                    }
+                }
+            }
+            if (nested)
+                continue;
+
+            ProfilingTools::PassStatsGPU* pass = nullptr;
+            for (auto& p : passes)
+            {
+                if (StringUtils::Compare(p.Name, e.Name) == 0)
+                {
+                    pass = &p;
+                    break;
+                }
+            }
+            if (!pass)
+            {
+                pass = &passes.AddOne();
+                Platform::MemoryClear(pass, sizeof(ProfilingTools::PassStatsGPU));
+                pass->Name = e.Name;
+            }
+            pass->Count++;
+            pass->TimeMs += e.Time;
+            pass->Stats.DrawCalls += e.Stats.DrawCalls;
+            pass->Stats.DispatchCalls += e.Stats.DispatchCalls;
+            pass->Stats.Vertices += e.Stats.Vertices;
+            pass->Stats.Triangles += e.Stats.Triangles;
+            pass->Stats.PipelineStateChanges += e.Stats.PipelineStateChanges;
+            pass->PipelineStats.Add(e.PipelineStats);
+        }
+        Sorting::QuickSort(passes.Get(), passes.Count(), &SortPassByTime);
+    }
+
+    void SaveTraceCapture(float frameTimeMs)
+    {
+        const String& folder = ProfilingTools::TraceFolder;
+        if (!FileSystem::DirectoryExists(folder) && FileSystem::CreateDirectory(folder))
+        {
+            LOG(Warning, "Failed to create profiler trace folder '{0}'.", folder);
+            return;
+        }
+        const String path = folder / String::Format(TEXT("Trace_{0}_{1}.json"), DateTime::Now().ToFileNameString(), Engine::FrameCount);
+        if (ProfilingTools::SaveTrace(path))
+        {
+            LOG(Warning, "Failed to save profiler trace to '{0}'.", path);
+            return;
+        }
+        LOG(Info, "Frame time hitch ({0} ms), saved profiler trace to '{1}'", frameTimeMs, path);
+
+        // Delete the oldest traces
+        Array<String> files;
+        if (!FileSystem::DirectoryGetFiles(files, folder, TEXT("Trace_*.json"), DirectorySearchOption::TopDirectoryOnly))
+        {
+            int32 remaining = files.Count() - Math::Max(ProfilingTools::TraceMaxFiles, 1);
+            if (remaining > 0)
+            {
+                Sorting::QuickSort(files.Get(), files.Count());
+                for (int32 i = 0; i < remaining; i++)
+                    FileSystem::DeleteFile(files[i]);
+            }
+        }
+    }
+
+    // Gathers the thread events overlapping the given time range from the recorded frames (events can be extracted in more than one frame so skip the events of the root events already gathered)
+    void GatherEventsCPU(int32 threadIndex, double start, double end, Array<ProfilerCPU::Event>& result)
+    {
+        result.Clear();
+        double threadEnd = 0.0;
+        for (int32 frameIndex = 0; frameIndex < TraceRingCount; frameIndex++)
+        {
+            const TraceFrame& frame = GetTraceFrame(frameIndex);
+            if (threadIndex >= frame.EventsCPU.Count())
+                continue;
+            double rootEnd = threadEnd;
+            for (const ProfilerCPU::Event& e : frame.EventsCPU[threadIndex])
+            {
+                if (e.End <= 0.0 || e.Start < threadEnd)
+                    continue;
+                if (e.Depth == 0)
+                    rootEnd = Math::Max(rootEnd, e.End);
+                if (e.Start < end && e.End > start)
+                    result.Add(e);
+            }
+            threadEnd = rootEnd;
+        }
+    }
+
+    String GetThreadName(uint64 id)
+    {
+        if (id == Globals::MainThreadID)
+            return TEXT("Main");
+        const auto thread = ThreadRegistry::GetThread(id);
+        return thread ? thread->GetName() : String::Format(TEXT("0x{0:x}"), id);
+    }
+
+    void ReportHitch()
+    {
+        PROFILE_CPU();
+        const double start = HitchStart, end = HitchEnd;
+
+        // Sum the self time of the CPU events (within the hitch frame) per event name and thread
+        Array<ProfilerCPU::Event> events;
+        Array<HitchContributor> contributors;
+        Dictionary<const Char*, double> times;
+        for (int32 threadIndex = 0; threadIndex < ProfilingTools::EventsCPU.Count(); threadIndex++)
+        {
+            GatherEventsCPU(threadIndex, start, end, events);
+            times.Clear();
+            for (int32 i = 0; i < events.Count(); i++)
+            {
+                const ProfilerCPU::Event& e = events[i];
+                double time = Math::Min(e.End, end) - Math::Max(e.Start, start);
+                for (int32 j = i + 1; j < events.Count() && events[j].Depth > e.Depth; j++)
+                {
+                    if (events[j].Depth == e.Depth + 1)
+                        time -= Math::Min(events[j].End, end) - Math::Max(events[j].Start, start);
+                }
+                if (time <= 0.0)
+                    continue;
+                double* total = times.TryGet(e.Name);
+                if (total)
+                    *total += time;
+                else
+                    times.Add(e.Name, time);
+            }
+            for (const auto& e : times)
+                contributors.Add({ e.Key, threadIndex, e.Value });
+        }
+        Sorting::QuickSort(contributors.Get(), contributors.Count(), &SortHitchContributor);
+
+        // Find the assets loaded during the hitch frame and the garbage collections
+        Array<const ProfilingTools::ContentLoadEvent*> assetLoads;
+        int32 gcCollections = 0;
+        for (int32 frameIndex = 0; frameIndex < TraceRingCount; frameIndex++)
+        {
+            const TraceFrame& frame = GetTraceFrame(frameIndex);
+            if (frame.Time > start && frame.Time <= end)
+                gcCollections += frame.GCCollections;
+            for (const auto& e : frame.AssetLoads)
+            {
+                if (e.StartTime < end && e.StartTime + e.DurationMs > start)
+                    assetLoads.Add(&e);
+            }
+        }
+        Sorting::QuickSort(assetLoads.Get(), assetLoads.Count(), &SortAssetLoad);
+
+        StringBuilder text;
+        text.AppendFormat(TEXT("Hitch on frame {0}: {1} ms (budget: {2} ms)"), HitchFrame, (int32)HitchTimeMs, ProfilingTools::HitchBudgetMs);
+        for (int32 i = 0; i < contributors.Count() && i < 8; i++)
+        {
+            const HitchContributor& e = contributors[i];
+            text.AppendFormat(TEXT("\n  {0} ms: {1} ({2})"), (float)((int32)(e.Time * 10.0) / 10.0), e.Name, ProfilingTools::EventsCPU[e.Thread].Name);
+        }
+        for (int32 i = 0; i < assetLoads.Count() && i < 4; i++)
+        {
+            const auto& e = *assetLoads[i];
+            text.AppendFormat(TEXT("\n  {0} ms: {1} {2} {3} ({4})"), (float)((int32)(e.DurationMs * 10.0f) / 10.0f), ScriptingEnum::ToString(e.Stage), e.TypeName, e.Name, e.Thread);
+        }
+        if (assetLoads.Count() > 4)
+            text.AppendFormat(TEXT("\n  ... and {0} more assets loaded"), assetLoads.Count() - 4);
+        if (gcCollections != 0)
+            text.AppendFormat(TEXT("\n  {0} garbage collection(s)"), gcCollections);
+        ProfilingTools::LastHitchReport = text.ToString();
+        LOG_STR(Warning, ProfilingTools::LastHitchReport);
+    }
+
+    void UpdateWorkerThreads()
+    {
+        const double time = Platform::GetTimeSeconds();
+        const double frameTime = WorkerStatsLastTime > 0.0 ? time - WorkerStatsLastTime : 0.0;
+        WorkerStatsLastTime = time;
+        ProfilingTools::WorkerThreads.Clear();
+        ProfilingTools::WorkerPools.Resize((int32)ProfilingTools::WorkerPoolType::MAX);
+        for (int32 poolIndex = 0; poolIndex < (int32)ProfilingTools::WorkerPoolType::MAX; poolIndex++)
+        {
+            const auto poolType = (ProfilingTools::WorkerPoolType)poolIndex;
+            auto& pool = ProfilingTools::WorkerPools[poolIndex];
+            Platform::MemoryClear(&pool, sizeof(pool));
+            pool.Pool = poolType;
+            switch (poolType)
+            {
+            case ProfilingTools::WorkerPoolType::JobSystem:
+            {
+                JobSystem::GetThreadsStats(WorkerStatsBuffer, true);
+                double waitTime;
+                JobSystem::GetWaitStats(waitTime, pool.WaitsCount, true);
+                pool.WaitTimeMs = (float)(waitTime * 1000.0);
+                pool.QueueSize = JobSystem::GetQueueSize();
+                break;
+            }
+            case ProfilingTools::WorkerPoolType::ThreadPool:
+                ThreadPool::GetThreadsStats(WorkerStatsBuffer, true);
+                pool.QueueSize = ThreadPool::GetQueueSize();
+                break;
+            case ProfilingTools::WorkerPoolType::ContentLoading:
+                ContentLoadingManager::GetThreadsStats(WorkerStatsBuffer, true);
+                pool.QueueSize = ContentLoadingManager::GetTasksCount();
+                break;
+            default:
+                WorkerStatsBuffer.Clear();
+                break;
+            }
+            pool.ThreadsCount = WorkerStatsBuffer.Count();
+            for (int32 i = 0; i < WorkerStatsBuffer.Count(); i++)
+            {
+                const WorkerStats& stats = WorkerStatsBuffer[i];
+                auto& e = ProfilingTools::WorkerThreads.AddOne();
+                e.Pool = poolType;
+                e.Index = i;
+                e.BusyTimeMs = (float)(stats.BusyTime * 1000.0);
+                e.IdleTimeMs = (float)(stats.IdleTime * 1000.0);
+                e.LongestJobMs = (float)(stats.LongestJobTime * 1000.0);
+                e.JobsCount = stats.JobsCount;
+                e.StealsCount = stats.StealsCount;
+                e.Utilization = frameTime > 0.0 ? Math::Saturate((float)(stats.BusyTime / frameTime)) : 0.0f;
+                pool.JobsCount += e.JobsCount;
+                pool.StealsCount += e.StealsCount;
+                pool.LongestJobMs = Math::Max(pool.LongestJobMs, e.LongestJobMs);
+                pool.Utilization += e.Utilization;
+            }
+            if (pool.ThreadsCount != 0)
+                pool.Utilization /= (float)pool.ThreadsCount;
+        }
+    }
+
+    bool SortAllocationSite(const ProfilerMemory::AllocationSiteStats& a, const ProfilerMemory::AllocationSiteStats& b)
+    {
+        return a.Bytes > b.Bytes;
+    }
+
+    FORCE_INLINE bool IsTraceEnabled()
+    {
+        return (ProfilingTools::TraceFolder.HasChars() || ProfilingTools::HitchBudgetMs > 0.0f) && ProfilingTools::TraceFrames > 0;
+    }
+
+    void UpdateContentLoads()
+    {
+        const bool enabled = ProfilingTools::TrackContentLoads || IsTraceEnabled();
+        ContentLoadingManager::TrackAssetLoads = enabled;
+        ProfilingTools::ContentLoads.Clear();
+        if (!enabled)
+            return;
+        PROFILE_CPU();
+        ContentLoadingManager::GetAssetLoads(ContentLoadsBuffer);
+        if (ContentLoadsBuffer.IsEmpty())
+            return;
+        bool newType = false;
+        for (const auto& info : ContentLoadsBuffer)
+        {
+            ProfilingTools::ContentLoadEvent& e = ProfilingTools::ContentLoads.AddOne();
+            e.Name = info.Name;
+            e.TypeName = info.TypeName;
+            e.Thread = GetThreadName(info.ThreadID);
+            e.Stage = (ProfilingTools::ContentLoadStage)info.Stage;
+            e.StartTime = info.StartTime * 1000.0;
+            e.DurationMs = (float)(info.Duration * 1000.0);
+            e.QueueWaitMs = info.RequestTime > 0.0 ? (float)Math::Max((info.StartTime - info.RequestTime) * 1000.0, 0.0) : 0.0f;
+            e.IOBytes = info.IOBytes;
+            e.IOTimeMs = (float)(info.IOTime * 1000.0);
+            e.DecompressTimeMs = (float)(info.DecompressTime * 1000.0);
+
+            // Aggregate per asset type
+            ProfilingTools::ContentLoadTypeStats* type = nullptr;
+            for (auto& t : ProfilingTools::ContentLoadTypes)
+            {
+                if (t.TypeName == e.TypeName)
+                {
+                    type = &t;
+                    break;
+                }
+            }
+            if (!type)
+            {
+                type = &ProfilingTools::ContentLoadTypes.AddOne();
+                type->TypeName = e.TypeName;
+                type->Count = 0;
+                type->LoadTimeMs = type->QueueWaitMs = type->StreamTimeMs = type->UploadTimeMs = type->FinalizeTimeMs = 0.0f;
+                type->IOBytes = 0;
+                type->IOTimeMs = type->DecompressTimeMs = 0.0f;
+                newType = true;
+            }
+            switch (e.Stage)
+            {
+            case ProfilingTools::ContentLoadStage::Load:
+                type->Count++;
+                type->LoadTimeMs += e.DurationMs;
+                break;
+            case ProfilingTools::ContentLoadStage::Stream:
+                type->StreamTimeMs += e.DurationMs;
+                break;
+            case ProfilingTools::ContentLoadStage::Upload:
+                type->UploadTimeMs += e.DurationMs;
+                break;
+            case ProfilingTools::ContentLoadStage::Finalize:
+                type->FinalizeTimeMs += e.DurationMs;
+                break;
+            }
+            type->QueueWaitMs += e.QueueWaitMs;
+            type->IOBytes += e.IOBytes;
+            type->IOTimeMs += e.IOTimeMs;
+            type->DecompressTimeMs += e.DecompressTimeMs;
+        }
+        ContentLoadsBuffer.Clear();
+        if (newType)
+            Sorting::QuickSort(ProfilingTools::ContentLoadTypes.Get(), ProfilingTools::ContentLoadTypes.Count(), &SortContentLoadType);
+
+        // Keep the history for the export (drop the oldest events in batches)
+        ContentLoadsHistory.Add(ProfilingTools::ContentLoads);
+        if (ContentLoadsHistory.Count() > CONTENT_LOADS_HISTORY_MAX)
+        {
+            const int32 removeCount = ContentLoadsHistory.Count() - CONTENT_LOADS_HISTORY_MAX * 9 / 10;
+            Array<ProfilingTools::ContentLoadEvent> history(ContentLoadsHistory.Get() + removeCount, ContentLoadsHistory.Count() - removeCount);
+            ContentLoadsHistory.Swap(history);
+        }
+    }
+
+    void UpdateTrace()
+    {
+        const double time = Platform::GetTimeSeconds();
+        const int32 framesCount = ProfilingTools::TraceFrames;
+        const bool enabled = IsTraceEnabled();
+        if (!enabled)
+        {
+            if (TraceRing.HasItems())
+            {
+                TraceRing.Resize(0);
+                TraceRing.SetCapacity(0);
+            }
+            TraceRingHead = TraceRingCount = TraceCooldown = TraceSaveDelay = HitchDelay = 0;
+            TraceGCCount = -1;
+            TraceLastUpdateTime = 0.0;
+            return;
+        }
+        PROFILE_CPU();
+        if (TraceRing.Count() != framesCount)
+        {
+            TraceRing.Resize(framesCount);
+            TraceRingHead = TraceRingCount = 0;
+        }
+        const float frameTimeMs = TraceLastUpdateTime > 0.0 ? (float)((time - TraceLastUpdateTime) * 1000.0) : 0.0f;
+        TraceLastUpdateTime = time;
+
+        // Record the frame
+        TraceFrame& frame = TraceRing[TraceRingHead];
+        TraceRingHead = (TraceRingHead + 1) % framesCount;
+        TraceRingCount = Math::Min(TraceRingCount + 1, framesCount);
+        frame.FrameIndex = Engine::FrameCount;
+        frame.Time = time * 1000.0;
+        frame.FrameTimeMs = frameTimeMs;
+        frame.ProcessMemory = ProfilingTools::Stats.ProcessMemory;
+        frame.MemoryGPU = ProfilingTools::Stats.MemoryGPU.Used;
+        frame.EventsCPU.Resize(ProfilingTools::EventsCPU.Count());
+        for (int32 i = 0; i < ProfilingTools::EventsCPU.Count(); i++)
+        {
+            const auto& events = ProfilingTools::EventsCPU[i].Events;
+            frame.EventsCPU[i].Set(events.Get(), events.Count());
+        }
+        frame.EventsGPU.Clear();
+        for (const auto& e : ProfilingTools::EventsGPU)
+            frame.EventsGPU.Add({ e.Name, e.Time, e.Depth });
+        frame.AssetLoads = ProfilingTools::ContentLoads;
+        const int32 gcCount = MCore::GC::GetCollectionsCount();
+        frame.GCCollections = TraceGCCount != -1 ? gcCount - TraceGCCount : 0;
+        TraceGCCount = gcCount;
+
+        // Report the hitch after a few frames (to include the events that ended later)
+        if (HitchDelay > 0 && --HitchDelay == 0)
+            ReportHitch();
+        else if (HitchDelay == 0 && ProfilingTools::HitchBudgetMs > 0.0f && frameTimeMs > ProfilingTools::HitchBudgetMs)
+        {
+            HitchDelay = TRACE_SAVE_DELAY;
+            HitchFrame = Engine::FrameCount;
+            HitchTimeMs = frameTimeMs;
+            HitchEnd = frame.Time;
+            HitchStart = HitchEnd - frameTimeMs;
+        }
+        if (ProfilingTools::TraceFolder.IsEmpty())
+            return;
+
+        // Save the trace after the hitch (once per recorded frames range)
+        if (TraceCooldown > 0)
+            TraceCooldown--;
+        if (TraceSaveDelay > 0)
+        {
+            if (--TraceSaveDelay == 0)
+            {
+                SaveTraceCapture(TraceRing[(TraceRingHead - TRACE_SAVE_DELAY + framesCount) % framesCount].FrameTimeMs);
+                TraceCooldown = framesCount;
+
+                // Skip saving time from the next frame time
+                TraceLastUpdateTime = Platform::GetTimeSeconds();
+            }
+        }
+        else if (TraceCooldown == 0 && frameTimeMs > ProfilingTools::TraceThresholdMs)
+        {
+            TraceSaveDelay = TRACE_SAVE_DELAY;
+        }
+    }
+
+    void OnThreadExiting(Thread* thread, int32 exitCode)
+    {
+        ProfilerCPU::OnThreadExit();
+    }
+
+#if COMPILE_WITH_DEBUG_DRAW
+    void DrawOverlayGPU()
+    {
+        // Skip the root event (whole frame) and show the most expensive passes
+        const bool pipelineStats = ProfilerGPU::PipelineStatsEnabled;
+        StringBuilder text;
+        text.AppendFormat(TEXT("GPU: {0} ms"), ProfilingTools::Stats.DrawGPUTimeMs);
+        int32 line = 0;
+        for (const auto& pass : ProfilingTools::PassesGPU)
+        {
+            if (line == 0 && pass.TimeMs >= ProfilingTools::Stats.DrawGPUTimeMs)
+                continue;
+            if (line++ == 24)
+                break;
+            text.Append(TEXT('\n'));
+            text.AppendFormat(TEXT("{0}: {1} ms"), pass.Name, pass.TimeMs);
+            if (pass.Count > 1)
+                text.AppendFormat(TEXT(" (x{0})"), pass.Count);
+            text.AppendFormat(TEXT(", draws: {0}, dispatches: {1}"), pass.Stats.DrawCalls, pass.Stats.DispatchCalls);
+            if (pipelineStats)
+                text.AppendFormat(TEXT(", VS: {0}, PS: {1}, CS: {2}, prims: {3}/{4}"), pass.PipelineStats.VertexShaderInvocations, pass.PipelineStats.PixelShaderInvocations, pass.PipelineStats.ComputeShaderInvocations, pass.PipelineStats.ClippingPrimitives, pass.PipelineStats.InputPrimitives);
+        }
+        DebugDraw::DrawText(text.ToStringView(), Float2(10, 10), Color::White, 12);
+    }
+#endif
+}
+
+bool ProfilingTools::SaveTrace(const StringView& path)
+{
+    if (TraceRingCount == 0)
+        return true;
+    PROFILE_CPU();
+    ASSERT(TraceRing.HasItems());
+
+    // Chrome Trace Event format (timestamps in microseconds)
+    rapidjson_flax::StringBuffer buffer;
+    CompactJsonWriter writerObj(buffer);
+    JsonWriter& writer = writerObj;
+    const int32 threadGPU = EventsCPU.Count();
+    writer.StartObject();
+    writer.JKEY("displayTimeUnit");
+    writer.String("ms");
+    writer.JKEY("traceEvents");
+    writer.StartArray();
+    for (int32 i = 0; i <= threadGPU; i++)
+    {
+        writer.StartObject();
+        writer.JKEY("name");
+        writer.String("thread_name");
+        writer.JKEY("ph");
+        writer.String("M");
+        writer.JKEY("pid");
+        writer.Int(0);
+        writer.JKEY("tid");
+        writer.Int(i);
+        writer.JKEY("args");
+        writer.StartObject();
+        writer.JKEY("name");
+        if (i == threadGPU)
+            writer.String("GPU");
+        else
+            writer.String(EventsCPU[i].Name);
+        writer.EndObject();
+        writer.EndObject();
+    }
+    Array<double> threadsEnd, depthsStart;
+    threadsEnd.Resize(threadGPU);
+    for (double& e : threadsEnd)
+        e = 0.0;
+    const int32 framesCount = TraceRing.Count();
+    for (int32 frameIndex = 0; frameIndex < TraceRingCount; frameIndex++)
+    {
+        const TraceFrame& frame = TraceRing[(TraceRingHead - TraceRingCount + frameIndex + framesCount) % framesCount];
+
+        // Frame counters
+        writer.StartObject();
+        writer.JKEY("name");
+        writer.String("Frame");
+        writer.JKEY("ph");
+        writer.String("C");
+        writer.JKEY("pid");
+        writer.Int(0);
+        writer.JKEY("ts");
+        writer.Double(frame.Time * 1000.0);
+        writer.JKEY("args");
+        writer.StartObject();
+        writer.JKEY("TimeMs");
+        writer.Double(frame.FrameTimeMs);
+        writer.JKEY("Index");
+        writer.Uint64(frame.FrameIndex);
+        writer.EndObject();
+        writer.EndObject();
+        writer.StartObject();
+        writer.JKEY("name");
+        writer.String("Memory");
+        writer.JKEY("ph");
+        writer.String("C");
+        writer.JKEY("pid");
+        writer.Int(0);
+        writer.JKEY("ts");
+        writer.Double(frame.Time * 1000.0);
+        writer.JKEY("args");
+        writer.StartObject();
+        writer.JKEY("ProcessMB");
+        writer.Double((double)frame.ProcessMemory.UsedPhysicalMemory / (1024.0 * 1024.0));
+        writer.JKEY("GPUMB");
+        writer.Double((double)frame.MemoryGPU / (1024.0 * 1024.0));
+        writer.EndObject();
+        writer.EndObject();
+
+        // CPU events (skip the events of the root events already written by the previous frames)
+        for (int32 threadIndex = 0; threadIndex < frame.EventsCPU.Count(); threadIndex++)
+        {
+            double& threadEnd = threadsEnd[threadIndex];
+            double rootEnd = threadEnd;
+            for (const ProfilerCPU::Event& e : frame.EventsCPU[threadIndex])
+            {
+                if (e.End <= 0.0 || e.Start < threadEnd)
+                    continue;
+                if (e.Depth == 0)
+                    rootEnd = Math::Max(rootEnd, e.End);
+                writer.StartObject();
+                writer.JKEY("name");
+                writer.String(e.Name);
+                writer.JKEY("ph");
+                writer.String("X");
+                writer.JKEY("pid");
+                writer.Int(0);
+                writer.JKEY("tid");
+                writer.Int(threadIndex);
+                writer.JKEY("ts");
+                writer.Double(e.Start * 1000.0);
+                writer.JKEY("dur");
+                writer.Double((e.End - e.Start) * 1000.0);
+                if (e.NativeMemoryAllocation != 0 || e.ManagedMemoryAllocation != 0)
+                {
+                    writer.JKEY("args");
+                    writer.StartObject();
+                    writer.JKEY("NativeMemoryAllocation");
+                    writer.Int(e.NativeMemoryAllocation);
+                    writer.JKEY("ManagedMemoryAllocation");
+                    writer.Int(e.ManagedMemoryAllocation);
+                    writer.EndObject();
+                }
+                writer.EndObject();
+            }
+            threadEnd = rootEnd;
+        }
+
+        // GPU events (GPU has no timestamps synchronized with CPU so events are placed one after another from the frame start, nested by depth)
+        depthsStart.Clear();
+        depthsStart.Add(frame.Time);
+        for (const TraceEventGPU& e : frame.EventsGPU)
+        {
+            if (e.Depth + 1 > depthsStart.Count())
+                depthsStart.Resize(e.Depth + 1);
+            const double start = depthsStart[e.Depth];
+            depthsStart[e.Depth] = start + e.Time;
+            depthsStart.Resize(e.Depth + 2);
+            depthsStart[e.Depth + 1] = start;
+            writer.StartObject();
+            writer.JKEY("name");
+            writer.String(e.Name);
+            writer.JKEY("ph");
+            writer.String("X");
+            writer.JKEY("pid");
+            writer.Int(0);
+            writer.JKEY("tid");
+            writer.Int(threadGPU);
+            writer.JKEY("ts");
+            writer.Double(start * 1000.0);
+            writer.JKEY("dur");
+            writer.Double(e.Time * 1000.0);
+            writer.EndObject();
+        }
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return File::WriteAllBytes(path, (const byte*)buffer.GetString(), (int32)buffer.GetSize());
+}
+
+bool ProfilingTools::SaveContentLoads(const StringView& path, bool perType)
+{
+    StringBuilder text;
+    if (perType)
+    {
+        text.Append(TEXT("Type,Count,LoadMs,QueueWaitMs,StreamMs,UploadMs,FinalizeMs,IOBytes,IOMs,DecompressMs\n"));
+        for (const ContentLoadTypeStats& e : ContentLoadTypes)
+        {
+            text.AppendFormat(TEXT("{0},{1},{2},{3},{4},{5},{6},{7},{8},{9}\n"), e.TypeName, e.Count, e.LoadTimeMs, e.QueueWaitMs, e.StreamTimeMs,
+                              e.UploadTimeMs, e.FinalizeTimeMs, e.IOBytes, e.IOTimeMs, e.DecompressTimeMs);
+        }
+    }
+    else
+    {
+        text.Append(TEXT("Asset,Type,Stage,Thread,StartMs,QueueWaitMs,DurationMs,IOBytes,IOMs,DecompressMs\n"));
+        for (const ContentLoadEvent& e : ContentLoadsHistory)
+        {
+            text.AppendFormat(TEXT("\"{0}\",{1},{2},\"{3}\",{4},{5},{6},{7},{8},{9}\n"), e.Name, e.TypeName, ScriptingEnum::ToString(e.Stage), e.Thread,
+                              e.StartTime, e.QueueWaitMs, e.DurationMs, e.IOBytes, e.IOTimeMs, e.DecompressTimeMs);
+        }
+    }
+    return File::WriteAllText(path, text, Encoding::ANSI);
+}
+
+void ProfilingTools::ClearContentLoads()
+{
+    ContentLoads.Clear();
+    ContentLoadTypes.Clear();
+    ContentLoadsHistory.Clear();
+}
+
+void ProfilingTools::CaptureMemoryGPU()
+{
+    PROFILE_CPU();
+
+    // Categories
+    MemoryCategoriesGPU.Resize((int32)GPUResourceCategory::MAX);
+    for (int32 i = 0; i < MemoryCategoriesGPU.Count(); i++)
+    {
+        auto& e = MemoryCategoriesGPU[i];
+        e.Name = ScriptingEnum::ToString((GPUResourceCategory)i);
+        e.Count = 0;
+        e.MemoryUsage = 0;
+    }
+    const int32 resourcesCount = Math::Max(MemoryResourcesCountGPU, 0);
+    MemoryResourcesGPU.Clear();
+    if (GPUDevice::Instance)
+    {
+        GPUDevice::Instance->ForEachResource([resourcesCount](const GPUResource* resource)
+        {
+            uint64 memoryUsage = resource->GetMemoryUsage();
+            if (memoryUsage <= 1)
+                return; // Backends can fake memory usage as 1 to mark resource as allocated but not resided in the GPU memory
+            const GPUResourceCategory category = resource->GetCategory();
+            auto& e = MemoryCategoriesGPU[(int32)category];
+            e.Count++;
+            e.MemoryUsage += memoryUsage;
+
+            // Keep the largest resources sorted (from the largest)
+            auto& largest = MemoryResourcesGPU;
+            if (largest.Count() == resourcesCount && (resourcesCount == 0 || largest.Last().MemoryUsage >= memoryUsage))
+                return;
+            int32 index = largest.Count();
+            while (index > 0 && largest[index - 1].MemoryUsage < memoryUsage)
+                index--;
+            MemoryResourceStatsGPU item;
+#if GPU_ENABLE_RESOURCE_NAMING
+            item.Name = resource->GetName();
+#endif
+            item.Type = resource->GetResourceType();
+            item.Category = category;
+            item.MemoryUsage = memoryUsage;
+            largest.Insert(index, item);
+            if (largest.Count() > resourcesCount)
+                largest.RemoveLast();
+        });
+    }
+
+    // Texture groups
+    Array<uint64> groupsMemoryUsage;
+    Array<int32> groupsCounts;
+    Streaming::GetTextureGroupsMemoryUsage(groupsMemoryUsage, groupsCounts);
+    MemoryTextureGroupsGPU.Resize(groupsMemoryUsage.Count());
+    for (int32 i = 0; i < groupsMemoryUsage.Count(); i++)
+    {
+        auto& e = MemoryTextureGroupsGPU[i];
+        e.Name = i < Streaming::TextureGroups.Count() ? Streaming::TextureGroups[i].Name : String(TEXT("<none>"));
+        e.Count = groupsCounts[i];
+        e.MemoryUsage = groupsMemoryUsage[i];
+    }
+}
+
+uint64 ProfilingTools::GetMemoryUsageGPU(GPUResourceCategory category)
+{
+    const int32 index = (int32)category;
+    return index >= 0 && index < MemoryCategoriesGPU.Count() ? MemoryCategoriesGPU[index].MemoryUsage : 0;
+}
+
+Array<ProfilingTools::ServiceInitStats> ProfilingTools::GetServicesInitStats()
+{
+    Array<ServiceInitStats> result;
+    const auto& services = EngineService::GetServices();
+    double startTime = MAX_double;
+    for (const EngineService* service : services)
+    {
+        if (service->InitStartTime > 0.0)
+            startTime = Math::Min(startTime, service->InitStartTime);
+    }
+    result.Resize(services.Count());
+    for (int32 i = 0; i < services.Count(); i++)
+    {
+        const EngineService* service = services[i];
+        auto& e = result[i];
+        e.Name = service->Name;
+        e.Order = service->Order;
+        e.Parallel = service->ParallelInit;
+        e.StartTimeMs = service->InitStartTime > 0.0 ? (float)((service->InitStartTime - startTime) * 1000.0) : 0.0f;
+        e.DurationMs = (float)(service->InitTime * 1000.0);
+    }
+    return result;
+}
+
+bool ProfilingToolsService::Init()
+{
+    if (CommandLine::Options.GPUProfile.IsTrue())
+    {
+        ProfilerGPU::PipelineStatsEnabled = true;
+        ProfilingTools::ShowGPUOverlay = true;
+    }
+    if (CommandLine::Options.ProfileTrace.HasValue())
+        ProfilingTools::TraceFolder = CommandLine::Options.ProfileTrace.GetValue();
+    if (CommandLine::Options.ProfileTraceThreshold.HasValue())
+    {
+        float threshold;
+        if (StringUtils::Parse(CommandLine::Options.ProfileTraceThreshold.GetValue().Get(), &threshold))
+            LOG(Warning, "Invalid profiler trace threshold '{0}'.", CommandLine::Options.ProfileTraceThreshold.GetValue());
+        else
+            ProfilingTools::TraceThresholdMs = threshold;
+    }
+    if (CommandLine::Options.HitchBudget.HasValue())
+    {
+        float budget;
+        if (StringUtils::Parse(CommandLine::Options.HitchBudget.GetValue().Get(), &budget))
+            LOG(Warning, "Invalid hitch budget '{0}'.", CommandLine::Options.HitchBudget.GetValue());
+        else
+            ProfilingTools::HitchBudgetMs = budget;
+    }
+    Thread::ThreadExiting.Bind<OnThreadExiting>();
+    return false;
+}
+
 void ProfilingToolsService::Update()
 {
     ZoneScoped;
@@ -39,6 +937,8 @@ void ProfilingToolsService::Update()
         stats.MemoryCPU = Platform::GetMemoryStats();
         stats.MemoryGPU.Total = GPUDevice::Instance->TotalGraphicsMemory;
         stats.MemoryGPU.Used = GPUDevice::Instance->GetMemoryUsage();
+        RendererAllocation::GetStats(stats.RendererArenaPeak, stats.RendererArenaReserved);
+        Particles::GetBufferPoolStats(stats.ParticleBufferPoolHits, stats.ParticleBufferPoolMisses, stats.ParticleBufferPoolSize, stats.ParticleBufferPoolMemory, true);
         stats.FPS = Engine::GetFramesPerSecond();
 
         stats.UpdateTimeMs = static_cast<float>(Time::Update.LastLength * 1000.0);
@@ -48,6 +948,53 @@ void ProfilingToolsService::Update()
         ProfilerGPU::GetLastFrameData(stats.DrawGPUTimeMs, stats.DrawStats);
     }
 
+    // Capture memory groups stats
+    if (ProfilerMemory::IsAvailable())
+    {
+        ProfilingTools::MemoryGroups.Resize((int32)ProfilerMemory::Groups::MAX);
+        for (int32 i = 0; i < (int32)ProfilerMemory::Groups::MAX; i++)
+            ProfilingTools::MemoryGroups[i] = ProfilerMemory::GetGroupStats((ProfilerMemory::Groups)i);
+    }
+
+    // Capture allocations call sites
+    ProfilingTools::AllocationSites.Clear();
+    if (ProfilerMemory::SampleAllocations)
+    {
+        ProfilerMemory::GetAllocationSites(ProfilingTools::AllocationSites, true);
+        Sorting::QuickSort(ProfilingTools::AllocationSites.Get(), ProfilingTools::AllocationSites.Count(), &SortAllocationSite);
+        if (ProfilingTools::AllocationSites.Count() > ProfilingTools::AllocationSitesCount)
+            ProfilingTools::AllocationSites.Resize(Math::Max(ProfilingTools::AllocationSitesCount, 0));
+    }
+
+    // Capture GPU memory usage breakdown
+    if (ProfilingTools::TrackMemoryGPU)
+        ProfilingTools::CaptureMemoryGPU();
+
+    // Capture content loading queues stats
+    ProfilingTools::ContentQueues.Resize(ContentLoadTask::Priority_Count);
+    for (int32 i = 0; i < ContentLoadTask::Priority_Count; i++)
+    {
+        const auto queueStats = ContentLoadingManager::GetQueueStats((ContentLoadTask::Priority)i, true);
+        auto& e = ProfilingTools::ContentQueues[i];
+        e.TasksCount = queueStats.TasksCount;
+        e.MissedDeadlines = queueStats.MissedDeadlines;
+        e.AverageWaitTimeMs = queueStats.TasksCount != 0 ? (float)(queueStats.TotalWaitTime * 1000.0 / queueStats.TasksCount) : 0.0f;
+        e.MaxWaitTimeMs = (float)(queueStats.MaxWaitTime * 1000.0);
+    }
+
+    // Capture content loading events
+    UpdateContentLoads();
+
+    // Capture worker threads activity
+    UpdateWorkerThreads();
+
+    // Get network replication stats
+    if (NetworkManager::Mode != NetworkManagerMode::Offline)
+    {
+        ProfilingTools::NetworkTypes = NetworkReplicator::GetTypesStats();
+        ProfilingTools::NetworkRpcs = NetworkReplicator::GetRpcsStats();
+    }
+
     // Extract CPU profiler events
     Platform::MemoryBarrier();
     const auto& threads = ProfilerCPU::Threads;
@@ -76,6 +1023,7 @@ void ProfilingToolsService::Update()
         }
 
         t->Buffer.Extract(pt->Events, true);
+        pt->MemoryAllocated = t->MemoryAllocated;
     }
 
 #if 0
@@ -119,6 +1067,12 @@ void ProfilingToolsService::Update()
         auto& frame = frames[maxFrameIndex];
         frame.Extract(ProfilingTools::EventsGPU);
     }
+    UpdatePassesGPU();
+    UpdateTrace();
+#if COMPILE_WITH_DEBUG_DRAW
+    if (ProfilingTools::ShowGPUOverlay)
+        DrawOverlayGPU();
+#endif
 
 #if 0
     // Print CPU events to the log
@@ -170,9 +1124,38 @@ void ProfilingToolsService::Update()
 
 void ProfilingToolsService::Dispose()
 {
+    Thread::ThreadExiting.Unbind<OnThreadExiting>();
     ProfilingTools::EventsCPU.Clear();
     ProfilingTools::EventsCPU.SetCapacity(0);
     ProfilingTools::EventsGPU.SetCapacity(0);
+    ProfilingTools::PassesGPU.SetCapacity(0);
+    ProfilingTools::MemoryGroups.SetCapacity(0);
+    ProfilingTools::AllocationSites.Clear();
+    ProfilingTools::AllocationSites.SetCapacity(0);
+    ProfilingTools::ContentQueues.SetCapacity(0);
+    ProfilingTools::WorkerThreads.Clear();
+    ProfilingTools::WorkerThreads.SetCapacity(0);
+    ProfilingTools::WorkerPools.Clear();
+    ProfilingTools::WorkerPools.SetCapacity(0);
+    WorkerStatsBuffer.Clear();
+    WorkerStatsBuffer.SetCapacity(0);
+    ProfilingTools::MemoryCategoriesGPU.Clear();
+    ProfilingTools::MemoryCategoriesGPU.SetCapacity(0);
+    ProfilingTools::MemoryTextureGroupsGPU.Clear();
+    ProfilingTools::MemoryTextureGroupsGPU.SetCapacity(0);
+    ProfilingTools::MemoryResourcesGPU.Clear();
+    ProfilingTools::MemoryResourcesGPU.SetCapacity(0);
+    ProfilingTools::NetworkTypes.Clear();
+    ProfilingTools::NetworkTypes.SetCapacity(0);
+    ProfilingTools::NetworkRpcs.Clear();
+    ProfilingTools::NetworkRpcs.SetCapacity(0);
+    TraceRing.Resize(0);
+    TraceRing.SetCapacity(0);
+    ProfilingTools::LastHitchReport.Clear();
+    ProfilingTools::ClearContentLoads();
+    ProfilingTools::ContentLoads.SetCapacity(0);
+    ContentLoadsHistory.SetCapacity(0);
+    ContentLoadsBuffer.SetCapacity(0);
 }
 
 #endif
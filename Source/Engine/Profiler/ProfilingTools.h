@@ -8,6 +8,9 @@
 #include "Engine/Platform/MemoryStats.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Profiler/Profiler.h"
+#include "Engine/Profiler/ProfilerMemory.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Graphics/GPUResource.h"
 
 /// <summary>
 /// Profiler tools for development. Allows to gather profiling data and events from the engine.
@@ -34,6 +37,57 @@ API_CLASS(Static) class ProfilingTools
         API_FIELD() uint64 Used;
     };
 
+    /// <summary>
+    /// The GPU memory usage stats of the resources group (eg. resources category or texture group).
+    /// </summary>
+    API_STRUCT(NoDefault) struct MemoryGroupStatsGPU
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(MemoryGroupStatsGPU);
+
+        /// <summary>
+        /// The group name.
+        /// </summary>
+        API_FIELD() String Name;
+
+        /// <summary>
+        /// The amount of resources in the group.
+        /// </summary>
+        API_FIELD() int32 Count;
+
+        /// <summary>
+        /// The memory used by the group resources (in bytes).
+        /// </summary>
+        API_FIELD() uint64 MemoryUsage;
+    };
+
+    /// <summary>
+    /// The GPU resource memory usage info.
+    /// </summary>
+    API_STRUCT(NoDefault) struct MemoryResourceStatsGPU
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(MemoryResourceStatsGPU);
+
+        /// <summary>
+        /// The resource name (empty in Release builds).
+        /// </summary>
+        API_FIELD() String Name;
+
+        /// <summary>
+        /// The resource type.
+        /// </summary>
+        API_FIELD() GPUResourceType Type;
+
+        /// <summary>
+        /// The resource category.
+        /// </summary>
+        API_FIELD() GPUResourceCategory Category;
+
+        /// <summary>
+        /// The memory used by the resource (in bytes).
+        /// </summary>
+        API_FIELD() uint64 MemoryUsage;
+    };
+
     /// <summary>
     /// Engine profiling data header. Contains main info and stats.
     /// </summary>
@@ -56,6 +110,36 @@ API_CLASS(Static) class ProfilingTools
         /// </summary>
         API_FIELD() MemoryStatsGPU MemoryGPU;
 
+        /// <summary>
+        /// The high-water mark of the memory used by the renderer frame arenas within a single frame (in bytes).
+        /// </summary>
+        API_FIELD() uint64 RendererArenaPeak;
+
+        /// <summary>
+        /// The total memory reserved by the renderer frame arenas (in bytes).
+        /// </summary>
+        API_FIELD() uint64 RendererArenaReserved;
+
+        /// <summary>
+        /// The amount of particle buffers reused from the pool during the last frame.
+        /// </summary>
+        API_FIELD() int32 ParticleBufferPoolHits;
+
+        /// <summary>
+        /// The amount of particle buffers created during the last frame because the pool had no free buffer (causes GPU resources allocation when spawning effects). Use Particles.PrewarmParticleBuffers to reduce it.
+        /// </summary>
+        API_FIELD() int32 ParticleBufferPoolMisses;
+
+        /// <summary>
+        /// The amount of free particle buffers in the pool.
+        /// </summary>
+        API_FIELD() int32 ParticleBufferPoolSize;
+
+        /// <summary>
+        /// The memory used by free particle buffers in the pool (in bytes).
+        /// </summary>
+        API_FIELD() uint64 ParticleBufferPoolMemory;
+
         /// <summary>
         /// The frames per second (fps counter).
         /// </summary>
@@ -103,6 +187,371 @@ API_CLASS(Static) class ProfilingTools
         /// The events list.
         /// </summary>
         API_FIELD() Array<ProfilerCPU::Event> Events;
+
+        /// <summary>
+        /// The net amount of the native memory allocated by the thread (in bytes). Available only when memory tracking is enabled.
+        /// </summary>
+        API_FIELD() int64 MemoryAllocated;
+    };
+
+    /// <summary>
+    /// The content loading queue stats for a single tasks priority.
+    /// </summary>
+    API_STRUCT(NoDefault) struct ContentQueueStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(ContentQueueStats);
+
+        /// <summary>
+        /// The amount of the content loading tasks executed during the last frame.
+        /// </summary>
+        API_FIELD() int32 TasksCount;
+
+        /// <summary>
+        /// The amount of the content loading tasks that started after their deadline during the last frame.
+        /// </summary>
+        API_FIELD() int32 MissedDeadlines;
+
+        /// <summary>
+        /// The average time tasks waited in the queue before execution (in milliseconds).
+        /// </summary>
+        API_FIELD() float AverageWaitTimeMs;
+
+        /// <summary>
+        /// The maximum time a task waited in the queue before execution (in milliseconds).
+        /// </summary>
+        API_FIELD() float MaxWaitTimeMs;
+    };
+
+    /// <summary>
+    /// The worker threads pool types.
+    /// </summary>
+    API_ENUM() enum class WorkerPoolType : uint8
+    {
+        /// <summary>
+        /// The job system threads (see JobSystem).
+        /// </summary>
+        JobSystem,
+
+        /// <summary>
+        /// The thread pool threads (see ThreadPool).
+        /// </summary>
+        ThreadPool,
+
+        /// <summary>
+        /// The content loading threads.
+        /// </summary>
+        ContentLoading,
+
+        MAX
+    };
+
+    /// <summary>
+    /// The worker thread activity stats.
+    /// </summary>
+    API_STRUCT(NoDefault) struct WorkerThreadStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(WorkerThreadStats);
+
+        /// <summary>
+        /// The pool of the thread.
+        /// </summary>
+        API_FIELD() WorkerPoolType Pool;
+
+        /// <summary>
+        /// The index of the thread within the pool.
+        /// </summary>
+        API_FIELD() int32 Index;
+
+        /// <summary>
+        /// The time spent on executing the jobs during the last frame (in milliseconds).
+        /// </summary>
+        API_FIELD() float BusyTimeMs;
+
+        /// <summary>
+        /// The time spent on waiting for the jobs during the last frame (in milliseconds).
+        /// </summary>
+        API_FIELD() float IdleTimeMs;
+
+        /// <summary>
+        /// The longest single job execution time during the last frame (in milliseconds).
+        /// </summary>
+        API_FIELD() float LongestJobMs;
+
+        /// <summary>
+        /// The amount of the jobs executed during the last frame.
+        /// </summary>
+        API_FIELD() int32 JobsCount;
+
+        /// <summary>
+        /// The amount of the jobs stolen from the other threads during the last frame.
+        /// </summary>
+        API_FIELD() int32 StealsCount;
+
+        /// <summary>
+        /// The thread utilization during the last frame (busy time divided by the frame time, in range 0-1).
+        /// </summary>
+        API_FIELD() float Utilization;
+    };
+
+    /// <summary>
+    /// The worker threads pool activity stats.
+    /// </summary>
+    API_STRUCT(NoDefault) struct WorkerPoolStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(WorkerPoolStats);
+
+        /// <summary>
+        /// The pool type.
+        /// </summary>
+        API_FIELD() WorkerPoolType Pool;
+
+        /// <summary>
+        /// The amount of the pool threads.
+        /// </summary>
+        API_FIELD() int32 ThreadsCount;
+
+        /// <summary>
+        /// The amount of the jobs waiting in the queue for the execution (at the end of the last frame).
+        /// </summary>
+        API_FIELD() int32 QueueSize;
+
+        /// <summary>
+        /// The amount of the jobs executed during the last frame.
+        /// </summary>
+        API_FIELD() int32 JobsCount;
+
+        /// <summary>
+        /// The amount of the jobs stolen between the threads during the last frame.
+        /// </summary>
+        API_FIELD() int32 StealsCount;
+
+        /// <summary>
+        /// The longest single job execution time during the last frame (in milliseconds).
+        /// </summary>
+        API_FIELD() float LongestJobMs;
+
+        /// <summary>
+        /// The average utilization of the pool threads during the last frame (in range 0-1).
+        /// </summary>
+        API_FIELD() float Utilization;
+
+        /// <summary>
+        /// The total time spent by the threads waiting for the jobs to finish during the last frame (in milliseconds). Used only by the job system (see JobSystem::Wait).
+        /// </summary>
+        API_FIELD() float WaitTimeMs;
+
+        /// <summary>
+        /// The amount of the waits for the jobs to finish during the last frame. Used only by the job system (see JobSystem::Wait).
+        /// </summary>
+        API_FIELD() int32 WaitsCount;
+    };
+
+    /// <summary>
+    /// The engine service initialization stats.
+    /// </summary>
+    API_STRUCT(NoDefault) struct ServiceInitStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(ServiceInitStats);
+
+        /// <summary>
+        /// The service name.
+        /// </summary>
+        API_FIELD() String Name;
+
+        /// <summary>
+        /// The service initialization order.
+        /// </summary>
+        API_FIELD() int32 Order;
+
+        /// <summary>
+        /// True if service was initialized in parallel with the other services (on a job system thread).
+        /// </summary>
+        API_FIELD() bool Parallel;
+
+        /// <summary>
+        /// The initialization start time relative to the first service initialization (in milliseconds).
+        /// </summary>
+        API_FIELD() float StartTimeMs;
+
+        /// <summary>
+        /// The initialization duration (in milliseconds).
+        /// </summary>
+        API_FIELD() float DurationMs;
+    };
+
+    /// <summary>
+    /// The content loading stages (see ContentLoadEvent).
+    /// </summary>
+    API_ENUM() enum class ContentLoadStage : uint8
+    {
+        /// <summary>
+        /// Asset data loading (and deserialization) on a content loading thread.
+        /// </summary>
+        Load,
+
+        /// <summary>
+        /// Asset data chunks streaming (eg. texture mips or model LODs data).
+        /// </summary>
+        Stream,
+
+        /// <summary>
+        /// Streamed data upload to the GPU (resources creation and update).
+        /// </summary>
+        Upload,
+
+        /// <summary>
+        /// Loaded asset finalization on the main thread (OnLoaded event).
+        /// </summary>
+        Finalize,
+    };
+
+    /// <summary>
+    /// The single content loading event (asset load stage execution).
+    /// </summary>
+    API_STRUCT(NoDefault) struct ContentLoadEvent
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(ContentLoadEvent);
+
+        /// <summary>
+        /// The asset path.
+        /// </summary>
+        API_FIELD() String Name;
+
+        /// <summary>
+        /// The asset type name.
+        /// </summary>
+        API_FIELD() String TypeName;
+
+        /// <summary>
+        /// The name of the thread that executed the work.
+        /// </summary>
+        API_FIELD() String Thread;
+
+        /// <summary>
+        /// The loading stage.
+        /// </summary>
+        API_FIELD() ContentLoadStage Stage;
+
+        /// <summary>
+        /// The start time (in milliseconds, the same time base as CPU profiler events).
+        /// </summary>
+        API_FIELD() double StartTime;
+
+        /// <summary>
+        /// The duration (in milliseconds).
+        /// </summary>
+        API_FIELD() float DurationMs;
+
+        /// <summary>
+        /// The time between the request and the start of the work (in milliseconds).
+        /// </summary>
+        API_FIELD() float QueueWaitMs;
+
+        /// <summary>
+        /// The amount of bytes read from the storage.
+        /// </summary>
+        API_FIELD() uint64 IOBytes;
+
+        /// <summary>
+        /// The time spent on reading data from the storage (in milliseconds).
+        /// </summary>
+        API_FIELD() float IOTimeMs;
+
+        /// <summary>
+        /// The time spent on data decompression (in milliseconds).
+        /// </summary>
+        API_FIELD() float DecompressTimeMs;
+    };
+
+    /// <summary>
+    /// The content loading stats aggregated per asset type.
+    /// </summary>
+    API_STRUCT(NoDefault) struct ContentLoadTypeStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(ContentLoadTypeStats);
+
+        /// <summary>
+        /// The asset type name.
+        /// </summary>
+        API_FIELD() String TypeName;
+
+        /// <summary>
+        /// The amount of the loaded assets.
+        /// </summary>
+        API_FIELD() int32 Count;
+
+        /// <summary>
+        /// The total time of the assets data loading (in milliseconds).
+        /// </summary>
+        API_FIELD() float LoadTimeMs;
+
+        /// <summary>
+        /// The total time between the requests and the start of the work (in milliseconds).
+        /// </summary>
+        API_FIELD() float QueueWaitMs;
+
+        /// <summary>
+        /// The total time of the assets data streaming (in milliseconds).
+        /// </summary>
+        API_FIELD() float StreamTimeMs;
+
+        /// <summary>
+        /// The total time of the streamed data upload to the GPU (in milliseconds).
+        /// </summary>
+        API_FIELD() float UploadTimeMs;
+
+        /// <summary>
+        /// The total time of the loaded assets finalization on the main thread (in milliseconds).
+        /// </summary>
+        API_FIELD() float FinalizeTimeMs;
+
+        /// <summary>
+        /// The total amount of bytes read from the storage.
+        /// </summary>
+        API_FIELD() uint64 IOBytes;
+
+        /// <summary>
+        /// The total time spent on reading data from the storage (in milliseconds).
+        /// </summary>
+        API_FIELD() float IOTimeMs;
+
+        /// <summary>
+        /// The total time spent on data decompression (in milliseconds).
+        /// </summary>
+        API_FIELD() float DecompressTimeMs;
+    };
+
+    /// <summary>
+    /// The GPU rendering pass stats aggregated from all the GPU profiler events with the same name within a single frame.
+    /// </summary>
+    API_STRUCT(NoDefault) struct PassStatsGPU
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(PassStatsGPU);
+
+        /// <summary>
+        /// The pass name (GPU profiler event name).
+        /// </summary>
+        API_FIELD() const Char* Name;
+
+        /// <summary>
+        /// The amount of the pass events within a frame.
+        /// </summary>
+        API_FIELD() int32 Count;
+
+        /// <summary>
+        /// The total pass execution time on a GPU (in milliseconds).
+        /// </summary>
+        API_FIELD() float TimeMs;
+
+        /// <summary>
+        /// The total rendering stats of the pass.
+        /// </summary>
+        API_FIELD() RenderStatsData Stats;
+
+        /// <summary>
+        /// The total GPU pipeline statistics of the pass. Valid only if ProfilerGPU pipeline statistics are enabled and supported by the graphics backend.
+        /// </summary>
+        API_FIELD() GPUPipelineStats PipelineStats;
     };
 
 public:
@@ -120,6 +569,176 @@ API_CLASS(Static) class ProfilingTools
     /// The GPU rendering profiler events.
     /// </summary>
     API_FIELD(ReadOnly) static Array<ProfilerGPU::Event> EventsGPU;
+
+    /// <summary>
+    /// The GPU rendering passes stats from the last resolved frame (events aggregated by name, sorted by the execution time). Nested events are not counted twice when they share the name with their parent.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<PassStatsGPU> PassesGPU;
+
+    /// <summary>
+    /// True if draw the on-screen overlay with the most expensive GPU passes timings and pipeline statistics (requires debug drawing support).
+    /// </summary>
+    API_FIELD() static bool ShowGPUOverlay;
+
+    /// <summary>
+    /// The native memory stats per memory group (indexed by ProfilerMemory.Groups). Empty if memory tracking is not available.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<ProfilerMemory::GroupStats> MemoryGroups;
+
+    /// <summary>
+    /// The maximum amount of the allocation call sites reported in AllocationSites.
+    /// </summary>
+    API_FIELD() static int32 AllocationSitesCount;
+
+    /// <summary>
+    /// The sampled native memory allocation call sites from the last frame (sorted by the sampled bytes, from the largest). Updated every frame when allocations sampling is enabled (see ProfilerMemory::SampleAllocations).
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<ProfilerMemory::AllocationSiteStats> AllocationSites;
+
+    /// <summary>
+    /// True if capture the GPU memory usage breakdown (MemoryCategoriesGPU, MemoryTextureGroupsGPU and MemoryResourcesGPU) every frame. Use CaptureMemoryGPU to update it on demand.
+    /// </summary>
+    API_FIELD() static bool TrackMemoryGPU;
+
+    /// <summary>
+    /// The maximum amount of the largest GPU resources to list in MemoryResourcesGPU.
+    /// </summary>
+    API_FIELD() static int32 MemoryResourcesCountGPU;
+
+    /// <summary>
+    /// The GPU memory usage per resource category (indexed by GPUResourceCategory, Default category is never used).
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<MemoryGroupStatsGPU> MemoryCategoriesGPU;
+
+    /// <summary>
+    /// The GPU memory usage of the streamed textures per texture group (indexed like Streaming::TextureGroups with an additional last item for the textures without a valid group).
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<MemoryGroupStatsGPU> MemoryTextureGroupsGPU;
+
+    /// <summary>
+    /// The largest GPU resources (sorted by the memory usage, from the largest).
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<MemoryResourceStatsGPU> MemoryResourcesGPU;
+
+    /// <summary>
+    /// The content loading queue stats per tasks priority (Low, Normal, High, Critical). Updated every frame.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<ContentQueueStats> ContentQueues;
+
+    /// <summary>
+    /// The worker threads activity stats (job system, thread pool and content loading threads). Updated every frame.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<WorkerThreadStats> WorkerThreads;
+
+    /// <summary>
+    /// The worker threads pools activity stats (indexed by WorkerPoolType). Updated every frame.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<WorkerPoolStats> WorkerPools;
+
+    /// <summary>
+    /// True if record the content loading events (per asset request, queue wait, I/O, decompression, GPU upload and main-thread finalization time). Enabled automatically by the trace capture and hitches detection.
+    /// </summary>
+    API_FIELD() static bool TrackContentLoads;
+
+    /// <summary>
+    /// The content loading events from the last frame. Updated every frame when content loads tracking is enabled.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<ContentLoadEvent> ContentLoads;
+
+    /// <summary>
+    /// The content loading stats aggregated per asset type (sorted by the type name) since tracking started or ClearContentLoads call.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<ContentLoadTypeStats> ContentLoadTypes;
+
+    /// <summary>
+    /// The network replication stats per replicated object type (sorted by the amount of bytes sent). Updated every frame when networking is active.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<NetworkReplicationStats> NetworkTypes;
+
+    /// <summary>
+    /// The network replication stats per RPC (sorted by the amount of bytes sent). Updated every frame when networking is active.
+    /// </summary>
+    API_FIELD(ReadOnly) static Array<NetworkReplicationStats> NetworkRpcs;
+
+    /// <summary>
+    /// The output folder for the automatic profiler trace captures. Recording of the recent frames (CPU, GPU and memory events) is active only when folder is specified (or hitches detection is enabled). Can be set via command line (-profiletrace !path!) to diagnose hitches in headless builds (eg. dedicated servers or soak tests) without the profiler attached.
+    /// </summary>
+    API_FIELD() static String TraceFolder;
+
+    /// <summary>
+    /// The frame time threshold (in milliseconds) above which the trace of the recent frames is saved to the TraceFolder. Can be set via command line (-profiletracethreshold !ms!).
+    /// </summary>
+    API_FIELD() static float TraceThresholdMs;
+
+    /// <summary>
+    /// The amount of the recent frames recorded for the trace capture. Trace snapshots are saved at most once per that amount of frames.
+    /// </summary>
+    API_FIELD() static int32 TraceFrames;
+
+    /// <summary>
+    /// The maximum amount of the trace files kept in the TraceFolder (the oldest are deleted).
+    /// </summary>
+    API_FIELD() static int32 TraceMaxFiles;
+
+    /// <summary>
+    /// The frame time budget (in milliseconds) above which the hitch report with the top contributors (CPU events self time, assets loads and garbage collections) is printed to the log. Use 0 to disable hitches detection. Can be set via command line (-hitchbudget !ms!). Uses the recent frames recording (see TraceFrames).
+    /// </summary>
+    API_FIELD() static float HitchBudgetMs;
+
+    /// <summary>
+    /// The last detected hitch report (see HitchBudgetMs).
+    /// </summary>
+    API_FIELD(ReadOnly) static String LastHitchReport;
+
+public:
+    /// <summary>
+    /// Gets the value indicating whether the GPU pipeline statistics (shader invocations, primitives count) are collected per GPU profiler event.
+    /// </summary>
+    API_PROPERTY() static bool GetPipelineStatsEnabled();
+
+    /// <summary>
+    /// Sets the value indicating whether the GPU pipeline statistics (shader invocations, primitives count) are collected per GPU profiler event. Ignored if graphics backend doesn't support pipeline statistics queries.
+    /// </summary>
+    API_PROPERTY() static void SetPipelineStatsEnabled(bool value);
+
+    /// <summary>
+    /// Saves the recorded recent frames to the trace file (in Chrome Trace Event JSON format, can be opened in chrome://tracing or Perfetto). Requires the recent frames recording to be enabled (TraceFolder or HitchBudgetMs set).
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool SaveTrace(const StringView& path);
+
+    /// <summary>
+    /// Saves the recorded content loading events (since tracking started or ClearContentLoads call) to the CSV file.
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <param name="perType">True if save the stats aggregated per asset type, otherwise saves all the loading events.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool SaveContentLoads(const StringView& path, bool perType = false);
+
+    /// <summary>
+    /// Clears the recorded content loading events and stats.
+    /// </summary>
+    API_FUNCTION() static void ClearContentLoads();
+
+    /// <summary>
+    /// Captures the GPU memory usage breakdown (MemoryCategoriesGPU, MemoryTextureGroupsGPU and MemoryResourcesGPU).
+    /// </summary>
+    API_FUNCTION() static void CaptureMemoryGPU();
+
+    /// <summary>
+    /// Gets the GPU memory used by the resources of the given category (in bytes). Can be used to validate VRAM budgets (eg. in automated tests).
+    /// </summary>
+    /// <remarks>Uses the data from the last capture (see CaptureMemoryGPU and TrackMemoryGPU).</remarks>
+    /// <param name="category">The resources category.</param>
+    /// <returns>The memory usage (in bytes).</returns>
+    API_FUNCTION() static uint64 GetMemoryUsageGPU(GPUResourceCategory category);
+
+    /// <summary>
+    /// Gets the engine services initialization timings (in the initialization order). Can be used to find the startup time bottlenecks.
+    /// </summary>
+    /// <returns>The services initialization stats.</returns>
+    API_FUNCTION() static Array<ServiceInitStats> GetServicesInitStats();
 };
 
 #endif
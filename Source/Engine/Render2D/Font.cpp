@@ -3,6 +3,7 @@
 #include "Font.h"
 #include "FontAsset.h"
 #include "FontManager.h"
+#include "TextLayoutCache.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Threading/Threading.h"
 #include "IncludeFreeType.h"
@@ -14,6 +15,8 @@ Font::Font(FontAsset* parentAsset, int32 size)
     , _characters(512)
 {
     _asset->_fonts.Add(this);
+    _useSDF = EnumHasAnyFlags(parentAsset->GetOptions().Flags, FontFlags::SDF);
+    _glyphScale = _useSDF ? (float)_size * FontManager::FontScale / FontSDFSize : 1.0f;
 
     // Cache data
     FlushFaceSize();
@@ -28,6 +31,8 @@ Font::Font(FontAsset* parentAsset, int32 size)
 
 Font::~Font()
 {
+    FontManager::CancelPending(this);
+    TextLayoutCache::Invalidate(this);
     if (_asset)
         _asset->_fonts.Remove(this);
 }
@@ -41,14 +46,27 @@ void Font::GetCharacter(Char c, FontCharacterEntry& result)
         ScopeLock lock(_asset->Locker);
 
         // Handle situation when more than one thread wants to get the same character
-        if (_characters.TryGet(c, result))
-            return;
+        if (!_characters.TryGet(c, result))
+        {
+            // Create character cache
+            FontManager::AddNewEntry(this, c, result, FontManager::AsyncRasterization);
 
-        // Create character cache
-        FontManager::AddNewEntry(this, c, result);
+            // Add to the dictionary
+            _characters.Add(c, result);
+            return;
+        }
+    }
 
-        // Add to the dictionary
-        _characters.Add(c, result);
+    // Check if character has been rasterized on a worker thread (or rasterize it now if cannot wait for it)
+    if (result.IsPending)
+    {
+        ScopeLock lock(_asset->Locker);
+        _characters.TryGet(c, result);
+        if (result.IsPending)
+        {
+            FontManager::ResolveEntry(this, result, !FontManager::AsyncRasterization);
+            _characters[c] = result;
+        }
     }
 }
 
@@ -84,10 +102,18 @@ int32 Font::GetKerning(Char first, Char second) const
 
 void Font::CacheText(const StringView& text)
 {
+    ScopeLock lock(_asset->Locker);
+
+    // Queue missing characters for the asynchronous rasterization (entries are resolved on the first use)
     FontCharacterEntry entry;
     for (int32 i = 0; i < text.Length(); i++)
     {
-        GetCharacter(text[i], entry);
+        const Char c = text[i];
+        if (!_characters.ContainsKey(c))
+        {
+            FontManager::QueueEntry(this, c, entry);
+            _characters.Add(c, entry);
+        }
     }
 }
 
@@ -95,14 +121,29 @@ void Font::Invalidate()
 {
     ScopeLock lock(_asset->Locker);
 
-    for (auto i = _characters.Begin(); i.IsNotEnd(); ++i)
+    FontManager::CancelPending(this);
+    TextLayoutCache::Invalidate(this);
+    if (!_useSDF)
     {
-        FontManager::Invalidate(i->Value);
+        // Signed distance field characters are owned by the font asset
+        for (auto i = _characters.Begin(); i.IsNotEnd(); ++i)
+        {
+            FontManager::Invalidate(i->Value);
+        }
     }
     _characters.Clear();
+
+    // Font asset options could change
+    _useSDF = EnumHasAnyFlags(_asset->GetOptions().Flags, FontFlags::SDF);
+    _glyphScale = _useSDF ? (float)_size * FontManager::FontScale / FontSDFSize : 1.0f;
 }
 
 void Font::ProcessText(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout)
+{
+    TextLayoutCache::GetLines(this, text, layout, outputLines);
+}
+
+void Font::processText(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout)
 {
     float cursorX = 0;
     int32 kerning;
@@ -10,10 +10,15 @@
 #include "TextLayoutOptions.h"
 
 class FontAsset;
+class FontManager;
+class TextLayoutCache;
 
 // The default DPI that engine is using
 #define DefaultDPI 96
 
+// The size (in pixels) of the characters rasterized for the signed distance field fonts (shared by all font sizes)
+#define FontSDFSize 32
+
 /// <summary>
 /// The text range.
 /// </summary>
@@ -165,6 +170,11 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(FontCharacterEntry);
     /// </summary>
     API_FIELD() bool IsValid = false;
 
+    /// <summary>
+    /// True if the character is being rasterized asynchronously. Pending character has no texture yet (but its metrics are valid if IsValid is set).
+    /// </summary>
+    API_FIELD() bool IsPending = false;
+
     /// <summary>
     /// The index to a specific texture in the font cache.
     /// </summary>
@@ -219,6 +229,8 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API Font : public ManagedScriptingOb
 {
 DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
     friend FontAsset;
+    friend FontManager;
+    friend TextLayoutCache;
 private:
 
     FontAsset* _asset;
@@ -228,7 +240,10 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
     int32 _descender;
     int32 _lineGap;
     bool _hasKerning;
+    bool _useSDF;
+    float _glyphScale;
     Dictionary<Char, FontCharacterEntry> _characters;
+    Dictionary<Char, FontCharacterEntry> _rasterizedCharacters;
     mutable Dictionary<uint32, int32> _kerningTable;
 
 public:
@@ -295,6 +310,22 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
         return _lineGap;
     }
 
+    /// <summary>
+    /// Gets a value indicating whether font uses signed distance field characters (shared by all sizes of the font asset).
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE bool IsSDF() const
+    {
+        return _useSDF;
+    }
+
+    /// <summary>
+    /// Gets the scale of the characters textures used when rendering them (ratio between the font size and the size of the rasterized characters). Equal 1 for regular fonts.
+    /// </summary>
+    FORCE_INLINE float GetGlyphScale() const
+    {
+        return _glyphScale;
+    }
+
 public:
 
     /// <summary>
@@ -313,7 +344,7 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
     API_FUNCTION() int32 GetKerning(Char first, Char second) const;
 
     /// <summary>
-    /// Caches the given text to prepared for the rendering.
+    /// Caches the given text to prepared for the rendering. Characters are rasterized asynchronously on a worker thread so it doesn't block the caller.
     /// </summary>
     /// <param name="text">The text witch characters to cache.</param>
     API_FUNCTION() void CacheText(const StringView& text);
@@ -521,4 +552,7 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
 
     // [Object]
     String ToString() const override;
+
+private:
+    void processText(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout);
 };
@@ -46,6 +46,9 @@ Asset::LoadResult FontAsset::load()
 
 void FontAsset::unload(bool isReloading)
 {
+    // Stop the asynchronous characters rasterization and release the shared glyphs
+    FontManager::Invalidate(this);
+
     // Ensure to cleanup child font objects
     if (_fonts.HasItems())
     {
@@ -197,6 +200,7 @@ void FontAsset::Invalidate()
     {
         font->Invalidate();
     }
+    FontManager::Invalidate(this);
 }
 
 bool FontAsset::init(AssetInitData& initData)
@@ -64,6 +64,11 @@ API_ENUM(Attributes="Flags") enum class FontFlags : byte
     /// Enables slant effect, emulating italic style.
     /// </summary>
     Italic = 4,
+
+    /// <summary>
+    /// Enables signed distance field rendering. Characters are rasterized once per font asset (at the fixed size) and shared by all font sizes so the text can be scaled without re-rasterizing it.
+    /// </summary>
+    SDF = 8,
 };
 
 DECLARE_ENUM_OPERATORS(FontFlags);
@@ -93,6 +98,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API FontAsset : public BinaryAsset
 {
     DECLARE_BINARY_ASSET_HEADER(FontAsset, 3);
     friend Font;
+    friend FontManager;
 private:
     FT_Face _face;
     FontOptions _options;
@@ -4,22 +4,60 @@
 #include "FontTextureAtlas.h"
 #include "FontAsset.h"
 #include "Font.h"
+#include "TextLayoutCache.h"
 #include "Engine/Platform/Platform.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Localization/Localization.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/Task.h"
 #include "IncludeFreeType.h"
 #include <ThirdParty/freetype/ftsynth.h>
 #include <ThirdParty/freetype/ftbitmap.h>
 #include <ThirdParty/freetype/internal/ftdrv.h>
 
+// The distance range (in pixels of the rasterized characters) encoded in the signed distance field fonts glyphs
+#define FONT_SDF_SPREAD 4
+// The upsampling factor used to compute the signed distance field from the higher resolution characters coverage
+#define FONT_SDF_UPSAMPLE 4
+
 namespace FontManagerImpl
 {
+    struct GlyphRequest
+    {
+        Font* Target;
+        Char Character;
+    };
+
+    struct AssetData
+    {
+        // The FreeType face used by the worker thread (faces cannot be used by many threads at once)
+        FT_Face WorkerFace = nullptr;
+        // Signed distance field characters shared by all the sizes of the font (offsets are in units of FontSDFSize)
+        Dictionary<Char, FontCharacterEntry> SDFCharacters;
+    };
+
+    struct SDFPoint
+    {
+        int16 X, Y;
+
+        FORCE_INLINE int32 DistanceSq() const
+        {
+            return (int32)X * X + (int32)Y * Y;
+        }
+    };
+
     FT_Library Library;
     CriticalSection Locker;
     Array<AssetReference<FontTextureAtlas>> Atlases;
     Array<byte> GlyphImageData;
+    Array<byte> SDFImageData;
+    Array<SDFPoint> SDFInside, SDFOutside;
+    Array<GlyphRequest> GlyphRequests;
+    Dictionary<const FontAsset*, AssetData*> AssetsData;
+    bool IsWorkerActive = false;
+    bool IsAtlasFull = false;
 }
 
 using namespace FontManagerImpl;
@@ -40,6 +78,7 @@ class FontManagerService : public EngineService
 FontManagerService FontManagerServiceInstance;
 
 float FontManager::FontScale = 1.0f;
+bool FontManager::AsyncRasterization = false;
 
 FT_Library FontManager::GetLibrary()
 {
@@ -88,11 +127,35 @@ bool FontManagerService::Init()
     FT_Library_Version(Library, &major, &minor, &patch);
     LOG(Info, "FreeType initialized, version: {0}.{1}.{2}", major, minor, patch);
 
+    // Localized texts change with the culture so drop their layouts
+    Localization::LocalizationChanged.Bind(&TextLayoutCache::Clear);
+
     return false;
 }
 
 void FontManagerService::Dispose()
 {
+    Localization::LocalizationChanged.Unbind(&TextLayoutCache::Clear);
+    TextLayoutCache::Clear();
+
+    // Stop the asynchronous rasterization
+    Locker.Lock();
+    GlyphRequests.Clear();
+    while (IsWorkerActive)
+    {
+        Locker.Unlock();
+        Platform::Sleep(1);
+        Locker.Lock();
+    }
+    for (auto& e : AssetsData)
+    {
+        if (e.Value->WorkerFace)
+            FT_Done_Face(e.Value->WorkerFace);
+        Delete(e.Value);
+    }
+    AssetsData.Clear();
+    Locker.Unlock();
+
     // Release font atlases
     Atlases.Resize(0);
 
@@ -108,189 +171,486 @@ void FontManagerService::Dispose()
     }
 }
 
-FontTextureAtlas* FontManager::GetAtlas(int32 index)
+namespace
 {
-    return index >= 0 && index < Atlases.Count() ? Atlases.Get()[index].Get() : nullptr;
-}
-
-bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry)
-{
-    ScopeLock lock(Locker);
-
-    const FontAsset* asset = font->GetAsset();
-    const FontOptions& options = asset->GetOptions();
-    const FT_Face face = asset->GetFTFace();
-    ASSERT(face != nullptr);
-    font->FlushFaceSize();
-
-    // Set load flags
-    uint32 glyphFlags = FT_LOAD_NO_BITMAP;
-    const bool useAA = EnumHasAnyFlags(options.Flags, FontFlags::AntiAliasing);
-    if (useAA)
+    AssetData* GetAssetData(const FontAsset* asset)
     {
-        switch (options.Hinting)
+        AssetData* data;
+        if (!AssetsData.TryGet(asset, data))
         {
-        case FontHinting::Auto:
-            glyphFlags |= FT_LOAD_FORCE_AUTOHINT;
-            break;
-        case FontHinting::AutoLight:
-            glyphFlags |= FT_LOAD_TARGET_LIGHT;
-            break;
-        case FontHinting::Monochrome:
-            glyphFlags |= FT_LOAD_TARGET_MONO;
-            break;
-        case FontHinting::None:
-            glyphFlags |= FT_LOAD_NO_AUTOHINT | FT_LOAD_NO_HINTING;
-            break;
-        case FontHinting::Default:
-        default:
-            glyphFlags |= FT_LOAD_TARGET_NORMAL;
-            break;
+            data = New<AssetData>();
+            AssetsData.Add(asset, data);
         }
+        return data;
     }
-    else
+
+    void SetFaceSize(FT_Face face, float size)
     {
-        glyphFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_FORCE_AUTOHINT;
+        const FT_Error error = FT_Set_Char_Size(face, 0, ConvertPixelTo26Dot6<FT_F26Dot6>(size), DefaultDPI, DefaultDPI);
+        if (error)
+        {
+            LOG_FT_ERROR(error);
+        }
+        FT_Set_Transform(face, nullptr, nullptr);
     }
 
-    // Get the index to the glyph in the font face
-    const FT_UInt glyphIndex = FT_Get_Char_Index(face, c);
-
-    // Load the glyph
-    const FT_Error error = FT_Load_Glyph(face, glyphIndex, glyphFlags);
-    if (error)
+    bool LoadGlyph(const FontOptions& options, FT_Face face, Char c, bool useSDF)
     {
-        LOG_FT_ERROR(error);
-        return true;
+        // Set load flags
+        uint32 glyphFlags = FT_LOAD_NO_BITMAP;
+        const bool useAA = EnumHasAnyFlags(options.Flags, FontFlags::AntiAliasing);
+        if (useSDF)
+        {
+            // Distance field is scaled so use unhinted outlines
+            glyphFlags |= FT_LOAD_NO_HINTING;
+        }
+        else if (useAA)
+        {
+            switch (options.Hinting)
+            {
+            case FontHinting::Auto:
+                glyphFlags |= FT_LOAD_FORCE_AUTOHINT;
+                break;
+            case FontHinting::AutoLight:
+                glyphFlags |= FT_LOAD_TARGET_LIGHT;
+                break;
+            case FontHinting::Monochrome:
+                glyphFlags |= FT_LOAD_TARGET_MONO;
+                break;
+            case FontHinting::None:
+                glyphFlags |= FT_LOAD_NO_AUTOHINT | FT_LOAD_NO_HINTING;
+                break;
+            case FontHinting::Default:
+            default:
+                glyphFlags |= FT_LOAD_TARGET_NORMAL;
+                break;
+            }
+        }
+        else
+        {
+            glyphFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_FORCE_AUTOHINT;
+        }
+
+        // Get the index to the glyph in the font face
+        const FT_UInt glyphIndex = FT_Get_Char_Index(face, c);
+
+        // Load the glyph
+        const FT_Error error = FT_Load_Glyph(face, glyphIndex, glyphFlags);
+        if (error)
+        {
+            LOG_FT_ERROR(error);
+            return true;
+        }
+
+        // Handle special effects
+        if (EnumHasAnyFlags(options.Flags, FontFlags::Bold))
+        {
+            FT_GlyphSlot_Embolden(face->glyph);
+        }
+        if (EnumHasAnyFlags(options.Flags, FontFlags::Italic))
+        {
+            FT_GlyphSlot_Oblique(face->glyph);
+        }
+
+        return false;
     }
 
-    // Handle special effects
-    if (EnumHasAnyFlags(options.Flags, FontFlags::Bold))
+    void SetMetrics(FT_GlyphSlot glyph, Char c, FontCharacterEntry& entry)
     {
-        FT_GlyphSlot_Embolden(face->glyph);
+        Platform::MemoryClear(&entry, sizeof(entry));
+        entry.Character = c;
+        entry.AdvanceX = Convert26Dot6ToRoundedPixel<int16>(glyph->advance.x);
+        entry.OffsetY = glyph->bitmap_top;
+        entry.OffsetX = glyph->bitmap_left;
+        entry.IsValid = true;
+        entry.BearingY = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.horiBearingY);
+        entry.Height = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.height);
+        entry.TextureIndex = MAX_uint8;
     }
-    if (EnumHasAnyFlags(options.Flags, FontFlags::Italic))
+
+    bool LoadMetrics(Font* font, FT_Face face, Char c, FontCharacterEntry& entry)
     {
-        FT_GlyphSlot_Oblique(face->glyph);
+        const FontOptions& options = font->GetAsset()->GetOptions();
+        SetFaceSize(face, (float)font->GetSize() * FontManager::FontScale);
+        if (LoadGlyph(options, face, c, font->IsSDF()))
+        {
+            Platform::MemoryClear(&entry, sizeof(entry));
+            entry.Character = c;
+            entry.TextureIndex = MAX_uint8;
+            return true;
+        }
+        SetMetrics(face->glyph, c, entry);
+        return false;
     }
 
-    // Render glyph to the bitmap
-    FT_GlyphSlot glyph = face->glyph;
-    FT_Render_Glyph(glyph, useAA ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO);
+    // Renders the loaded glyph into the GlyphImageData (8bpp grayscale)
+    void RenderGlyph(FT_GlyphSlot glyph, bool useAA, int32& glyphWidth, int32& glyphHeight)
+    {
+        // Render glyph to the bitmap
+        FT_Render_Glyph(glyph, useAA ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO);
 
-    FT_Bitmap* bitmap = &glyph->bitmap;
-    FT_Bitmap tmpBitmap;
-    if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY)
+        FT_Bitmap* bitmap = &glyph->bitmap;
+        FT_Bitmap tmpBitmap;
+        if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY)
+        {
+            // Convert the bitmap to 8bpp grayscale
+            FT_Bitmap_New(&tmpBitmap);
+            FT_Bitmap_Convert(Library, bitmap, &tmpBitmap, 4);
+            bitmap = &tmpBitmap;
+        }
+        ASSERT(bitmap && bitmap->pixel_mode == FT_PIXEL_MODE_GRAY);
+
+        // Allocate memory
+        glyphWidth = bitmap->width;
+        glyphHeight = bitmap->rows;
+        GlyphImageData.Clear();
+        GlyphImageData.Resize(glyphWidth * glyphHeight);
+        if (GlyphImageData.HasItems())
+        {
+            // Copy glyph data after rasterization (row by row)
+            for (int32 row = 0; row < glyphHeight; row++)
+            {
+                Platform::MemoryCopy(&GlyphImageData[row * glyphWidth], &bitmap->buffer[row * bitmap->pitch], glyphWidth);
+            }
+
+            // Normalize gray scale images not using 256 colors
+            if (bitmap->num_grays != 256)
+            {
+                const int32 scale = 255 / (bitmap->num_grays - 1);
+                for (byte& pixel : GlyphImageData)
+                {
+                    pixel *= scale;
+                }
+            }
+        }
+
+        // Free temporary bitmap if used
+        if (bitmap == &tmpBitmap)
+        {
+            FT_Bitmap_Done(Library, bitmap);
+        }
+    }
+
+    FontTextureAtlas* CreateAtlas()
     {
-        // Convert the bitmap to 8bpp grayscale
-        FT_Bitmap_New(&tmpBitmap);
-        FT_Bitmap_Convert(Library, bitmap, &tmpBitmap, 4);
-        bitmap = &tmpBitmap;
+        auto atlas = Content::CreateVirtualAsset<FontTextureAtlas>();
+        atlas->Setup(PixelFormat::R8_UNorm, FontTextureAtlas::PaddingStyle::PadWithZero);
+
+        // Init atlas
+        const int32 fontAtlasSize = 512; // TODO: make it a configuration variable
+        atlas->Init(fontAtlasSize, fontAtlasSize);
+        return atlas;
     }
-    ASSERT(bitmap && bitmap->pixel_mode == FT_PIXEL_MODE_GRAY);
 
-    // Fill the character data
-    Platform::MemoryClear(&entry, sizeof(entry));
-    entry.Character = c;
-    entry.AdvanceX = Convert26Dot6ToRoundedPixel<int16>(glyph->advance.x);
-    entry.OffsetY = glyph->bitmap_top;
-    entry.OffsetX = glyph->bitmap_left;
-    entry.IsValid = true;
-    entry.BearingY = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.horiBearingY);
-    entry.Height = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.height);
-
-    // Allocate memory
-    const int32 glyphWidth = bitmap->width;
-    const int32 glyphHeight = bitmap->rows;
-    GlyphImageData.Clear();
-    GlyphImageData.Resize(glyphWidth * glyphHeight);
-
-    // End for empty glyphs
-    if (GlyphImageData.IsEmpty())
+    bool AddToAtlas(FT_Face face, Char c, int32 glyphWidth, int32 glyphHeight, const Array<byte>& data, FontCharacterEntry& entry, bool canCreateAtlas)
     {
-        entry.TextureIndex = MAX_uint8;
-        if (bitmap == &tmpBitmap)
+        // Find atlas for the character texture
+        int32 atlasIndex = 0;
+        const FontTextureAtlas::Slot* slot = nullptr;
+        for (; atlasIndex < Atlases.Count(); atlasIndex++)
         {
-            FT_Bitmap_Done(Library, bitmap);
-            bitmap = nullptr;
+            // Add the character to the texture
+            slot = Atlases[atlasIndex]->AddEntry(glyphWidth, glyphHeight, data);
+
+            // Check result, if not null char has been added
+            if (slot)
+            {
+                break;
+            }
+        }
+
+        // Check if there is no atlas for this character
+        if (!slot)
+        {
+            if (!canCreateAtlas)
+            {
+                // Worker thread cannot create assets (it would require content locks), new atlas is created on the main thread (see Flush)
+                IsAtlasFull = true;
+                return true;
+            }
+
+            // Create new atlas
+            auto atlas = CreateAtlas();
+            Atlases.Add(atlas);
+            IsAtlasFull = false;
+
+            // Add the character to the texture
+            slot = atlas->AddEntry(glyphWidth, glyphHeight, data);
         }
+        if (slot == nullptr)
+        {
+            LOG(Error, "Cannot find free space in texture atlases for character '{0}' from font {1} {2}. Size: {3}x{4}", c, String(face->family_name), String(face->style_name), glyphWidth, glyphHeight);
+            return true;
+        }
+
+        // Fill with atlas dependant data
+        const uint32 padding = Atlases[atlasIndex]->GetPaddingAmount();
+        entry.TextureIndex = atlasIndex;
+        entry.UV.X = static_cast<float>(slot->X + padding);
+        entry.UV.Y = static_cast<float>(slot->Y + padding);
+        entry.UVSize.X = static_cast<float>(slot->Width - 2 * padding);
+        entry.UVSize.Y = static_cast<float>(slot->Height - 2 * padding);
         return false;
     }
 
-    // Copy glyph data after rasterization (row by row)
-    for (int32 row = 0; row < glyphHeight; row++)
+    FORCE_INLINE void CompareSDFPoint(const SDFPoint* grid, SDFPoint& p, int32 x, int32 y, int32 offsetX, int32 offsetY, int32 width, int32 height)
     {
-        Platform::MemoryCopy(&GlyphImageData[row * glyphWidth], &bitmap->buffer[row * bitmap->pitch], glyphWidth);
+        x += offsetX;
+        y += offsetY;
+        if (x < 0 || y < 0 || x >= width || y >= height)
+            return;
+        SDFPoint other = grid[y * width + x];
+        other.X += offsetX;
+        other.Y += offsetY;
+        if (other.DistanceSq() < p.DistanceSq())
+            p = other;
     }
 
-    // Normalize gray scale images not using 256 colors
-    if (bitmap->num_grays != 256)
+    // Computes the distance to the closest seed point for every grid cell (8-points Sequential Euclidean Distance Transform)
+    void ComputeDistanceField(SDFPoint* grid, int32 width, int32 height)
     {
-        const int32 scale = 255 / (bitmap->num_grays - 1);
-        for (byte& pixel : GlyphImageData)
+        for (int32 y = 0; y < height; y++)
         {
-            pixel *= scale;
+            for (int32 x = 0; x < width; x++)
+            {
+                SDFPoint p = grid[y * width + x];
+                CompareSDFPoint(grid, p, x, y, -1, 0, width, height);
+                CompareSDFPoint(grid, p, x, y, 0, -1, width, height);
+                CompareSDFPoint(grid, p, x, y, -1, -1, width, height);
+                CompareSDFPoint(grid, p, x, y, 1, -1, width, height);
+                grid[y * width + x] = p;
+            }
+            for (int32 x = width - 1; x >= 0; x--)
+            {
+                SDFPoint p = grid[y * width + x];
+                CompareSDFPoint(grid, p, x, y, 1, 0, width, height);
+                grid[y * width + x] = p;
+            }
+        }
+        for (int32 y = height - 1; y >= 0; y--)
+        {
+            for (int32 x = width - 1; x >= 0; x--)
+            {
+                SDFPoint p = grid[y * width + x];
+                CompareSDFPoint(grid, p, x, y, 1, 0, width, height);
+                CompareSDFPoint(grid, p, x, y, 0, 1, width, height);
+                CompareSDFPoint(grid, p, x, y, -1, 1, width, height);
+                CompareSDFPoint(grid, p, x, y, 1, 1, width, height);
+                grid[y * width + x] = p;
+            }
+            for (int32 x = 0; x < width; x++)
+            {
+                SDFPoint p = grid[y * width + x];
+                CompareSDFPoint(grid, p, x, y, -1, 0, width, height);
+                grid[y * width + x] = p;
+            }
         }
     }
 
-    // Free temporary bitmap if used
-    if (bitmap == &tmpBitmap)
+    // Converts the high resolution glyph coverage (GlyphImageData) into the signed distance field glyph (SDFImageData) of the given size (0.5 value is the glyph edge)
+    void GenerateSDF(int32 coverageWidth, int32 coverageHeight, int32 offsetX, int32 offsetY, int32 width, int32 height)
     {
-        FT_Bitmap_Done(Library, bitmap);
-        bitmap = nullptr;
+        // Seed the distance fields with the glyph inside and outside pixels
+        const int32 gridWidth = width * FONT_SDF_UPSAMPLE;
+        const int32 gridHeight = height * FONT_SDF_UPSAMPLE;
+        const SDFPoint seed = { 0, 0 };
+        const SDFPoint empty = { 9999, 9999 };
+        SDFInside.Resize(gridWidth * gridHeight, false);
+        SDFOutside.Resize(gridWidth * gridHeight, false);
+        for (int32 y = 0; y < gridHeight; y++)
+        {
+            for (int32 x = 0; x < gridWidth; x++)
+            {
+                const int32 coverageX = x - offsetX;
+                const int32 coverageY = y - offsetY;
+                const bool inside = coverageX >= 0 && coverageY >= 0 && coverageX < coverageWidth && coverageY < coverageHeight && GlyphImageData[coverageY * coverageWidth + coverageX] >= 128;
+                SDFInside[y * gridWidth + x] = inside ? seed : empty;
+                SDFOutside[y * gridWidth + x] = inside ? empty : seed;
+            }
+        }
+        ComputeDistanceField(SDFInside.Get(), gridWidth, gridHeight);
+        ComputeDistanceField(SDFOutside.Get(), gridWidth, gridHeight);
+
+        // Downsample the signed distance (positive outside the glyph) and encode it
+        SDFImageData.Resize(width * height, false);
+        const float distanceScale = 0.5f / (float)(FONT_SDF_SPREAD * FONT_SDF_UPSAMPLE * FONT_SDF_UPSAMPLE * FONT_SDF_UPSAMPLE);
+        for (int32 y = 0; y < height; y++)
+        {
+            for (int32 x = 0; x < width; x++)
+            {
+                float distance = 0.0f;
+                for (int32 blockY = 0; blockY < FONT_SDF_UPSAMPLE; blockY++)
+                {
+                    for (int32 blockX = 0; blockX < FONT_SDF_UPSAMPLE; blockX++)
+                    {
+                        const int32 index = (y * FONT_SDF_UPSAMPLE + blockY) * gridWidth + x * FONT_SDF_UPSAMPLE + blockX;
+                        distance += Math::Sqrt((float)SDFInside[index].DistanceSq()) - Math::Sqrt((float)SDFOutside[index].DistanceSq());
+                    }
+                }
+                SDFImageData[y * width + x] = (byte)(Math::Saturate(0.5f - distance * distanceScale) * 255.0f);
+            }
+        }
     }
 
-    // Find atlas for the character texture
-    int32 atlasIndex = 0;
-    const FontTextureAtlas::Slot* slot = nullptr;
-    for (; atlasIndex < Atlases.Count(); atlasIndex++)
+    bool GetSDFGlyph(const FontAsset* asset, FT_Face face, Char c, FontCharacterEntry& result, bool canCreateAtlas)
     {
-        // Add the character to the texture
-        slot = Atlases[atlasIndex]->AddEntry(glyphWidth, glyphHeight, GlyphImageData);
+        AssetData* data = GetAssetData(asset);
+        if (data->SDFCharacters.TryGet(c, result))
+            return false;
 
-        // Check result, if not null char has been added
-        if (slot)
+        // Load and render the glyph at higher resolution
+        SetFaceSize(face, (float)(FontSDFSize * FONT_SDF_UPSAMPLE));
+        if (LoadGlyph(asset->GetOptions(), face, c, true))
+            return true;
+        FT_GlyphSlot glyph = face->glyph;
+        int32 coverageWidth, coverageHeight;
+        RenderGlyph(glyph, true, coverageWidth, coverageHeight);
+        Platform::MemoryClear(&result, sizeof(result));
+        result.Character = c;
+        result.IsValid = true;
+        result.TextureIndex = MAX_uint8;
+        if (GlyphImageData.HasItems())
         {
-            break;
+            // Align the glyph origin to the distance field pixels and add the spread margin around it
+            result.OffsetX = (int16)(Math::FloorToInt((float)glyph->bitmap_left / FONT_SDF_UPSAMPLE) - FONT_SDF_SPREAD);
+            result.OffsetY = (int16)(Math::CeilToInt((float)glyph->bitmap_top / FONT_SDF_UPSAMPLE) + FONT_SDF_SPREAD);
+            const int32 offsetX = glyph->bitmap_left - result.OffsetX * FONT_SDF_UPSAMPLE;
+            const int32 offsetY = result.OffsetY * FONT_SDF_UPSAMPLE - glyph->bitmap_top;
+            const int32 width = Math::DivideAndRoundUp(offsetX + coverageWidth, FONT_SDF_UPSAMPLE) + FONT_SDF_SPREAD;
+            const int32 height = Math::DivideAndRoundUp(offsetY + coverageHeight, FONT_SDF_UPSAMPLE) + FONT_SDF_SPREAD;
+            GenerateSDF(coverageWidth, coverageHeight, offsetX, offsetY, width, height);
+            if (AddToAtlas(face, c, width, height, SDFImageData, result, canCreateAtlas))
+                return true;
         }
+        data->SDFCharacters.Add(c, result);
+        return false;
     }
 
-    // Check if there is no atlas for this character
-    if (!slot)
+    bool RasterizeEntry(Font* font, FT_Face face, Char c, FontCharacterEntry& entry, bool canCreateAtlas = true)
     {
-        // Create new atlas
-        auto atlas = Content::CreateVirtualAsset<FontTextureAtlas>();
-        atlas->Setup(PixelFormat::R8_UNorm, FontTextureAtlas::PaddingStyle::PadWithZero);
-        Atlases.Add(atlas);
+        // Fill the character data
+        if (LoadMetrics(font, face, c, entry))
+            return true;
 
-        // Init atlas
-        const int32 fontAtlasSize = 512; // TODO: make it a configuration variable
-        atlas->Init(fontAtlasSize, fontAtlasSize);
+        if (font->IsSDF())
+        {
+            // Use the signed distance field glyph shared by all font sizes
+            FontCharacterEntry sdf;
+            if (GetSDFGlyph(font->GetAsset(), face, c, sdf, canCreateAtlas))
+                return true;
+            const float scale = font->GetGlyphScale();
+            entry.OffsetX = (int16)Math::RoundToInt(sdf.OffsetX * scale);
+            entry.OffsetY = (int16)Math::RoundToInt(sdf.OffsetY * scale);
+            entry.TextureIndex = sdf.TextureIndex;
+            entry.UV = sdf.UV;
+            entry.UVSize = sdf.UVSize;
+            return false;
+        }
+
+        // Render glyph to the bitmap
+        const bool useAA = EnumHasAnyFlags(font->GetAsset()->GetOptions().Flags, FontFlags::AntiAliasing);
+        int32 glyphWidth, glyphHeight;
+        RenderGlyph(face->glyph, useAA, glyphWidth, glyphHeight);
 
-        // Add the character to the texture
-        slot = atlas->AddEntry(glyphWidth, glyphHeight, GlyphImageData);
+        // End for empty glyphs
+        if (GlyphImageData.IsEmpty())
+            return false;
+
+        return AddToAtlas(face, c, glyphWidth, glyphHeight, GlyphImageData, entry, canCreateAtlas);
     }
-    if (slot == nullptr)
+
+}
+
+FontTextureAtlas* FontManager::GetAtlas(int32 index)
+{
+    ScopeLock lock(Locker);
+    return index >= 0 && index < Atlases.Count() ? Atlases.Get()[index].Get() : nullptr;
+}
+
+bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry, bool async)
+{
+    ScopeLock lock(Locker);
+
+    const FT_Face face = font->GetAsset()->GetFTFace();
+    ASSERT(face != nullptr);
+    if (async)
     {
-        LOG(Error, "Cannot find free space in texture atlases for character '{0}' from font {1} {2}. Size: {3}x{4}", c, String(face->family_name), String(face->style_name), glyphWidth, glyphHeight);
-        return true;
+        // Get only the metrics for the text layout and rasterize character on a worker thread
+        if (LoadMetrics(font, face, c, entry))
+            return true;
+        entry.IsPending = true;
+        if (!AddRequest(font, c))
+            return false;
+        entry.IsPending = false;
     }
+    return RasterizeEntry(font, face, c, entry);
+}
 
-    // Fill with atlas dependant data
-    const uint32 padding = Atlases[atlasIndex]->GetPaddingAmount();
-    entry.TextureIndex = atlasIndex;
-    entry.UV.X = static_cast<float>(slot->X + padding);
-    entry.UV.Y = static_cast<float>(slot->Y + padding);
-    entry.UVSize.X = static_cast<float>(slot->Width - 2 * padding);
-    entry.UVSize.Y = static_cast<float>(slot->Height - 2 * padding);
+void FontManager::QueueEntry(Font* font, Char c, FontCharacterEntry& entry)
+{
+    ScopeLock lock(Locker);
 
-    return false;
+    Platform::MemoryClear(&entry, sizeof(entry));
+    entry.Character = c;
+    entry.TextureIndex = MAX_uint8;
+    entry.IsPending = true;
+    if (AddRequest(font, c))
+    {
+        // Fallback to the synchronous rasterization
+        RasterizeEntry(font, font->GetAsset()->GetFTFace(), c, entry);
+    }
+}
+
+void FontManager::ResolveEntry(Font* font, FontCharacterEntry& entry, bool wait)
+{
+    ScopeLock lock(Locker);
+
+    const Char c = entry.Character;
+    if (font->_rasterizedCharacters.TryGet(c, entry))
+    {
+        // Rasterized on a worker thread
+        font->_rasterizedCharacters.Remove(c);
+        return;
+    }
+    const FT_Face face = font->GetAsset()->GetFTFace();
+    if (wait)
+    {
+        // Cancel the request and rasterize character right away
+        for (int32 i = 0; i < GlyphRequests.Count(); i++)
+        {
+            if (GlyphRequests[i].Target == font && GlyphRequests[i].Character == c)
+            {
+                GlyphRequests.RemoveAtKeepOrder(i);
+                break;
+            }
+        }
+        RasterizeEntry(font, face, c, entry);
+    }
+    else if (!entry.IsValid)
+    {
+        // Get the metrics for the text layout
+        LoadMetrics(font, face, c, entry);
+        entry.IsPending = true;
+    }
+}
+
+void FontManager::CancelPending(Font* font)
+{
+    ScopeLock lock(Locker);
+
+    for (int32 i = GlyphRequests.Count() - 1; i >= 0; i--)
+    {
+        if (GlyphRequests[i].Target == font)
+            GlyphRequests.RemoveAtKeepOrder(i);
+    }
+    font->_rasterizedCharacters.Clear();
 }
 
 void FontManager::Invalidate(FontCharacterEntry& entry)
 {
     if (entry.TextureIndex == MAX_uint8)
         return;
+    ScopeLock lock(Locker);
     auto atlas = Atlases[entry.TextureIndex];
     const uint32 padding = atlas->GetPaddingAmount();
     const uint32 slotX = static_cast<uint32>(entry.UV.X - padding);
@@ -300,21 +660,113 @@ void FontManager::Invalidate(FontCharacterEntry& entry)
     atlas->Invalidate(slotX, slotY, slotSizeX, slotSizeY);
 }
 
+void FontManager::Invalidate(FontAsset* asset)
+{
+    ScopeLock lock(Locker);
+
+    for (int32 i = GlyphRequests.Count() - 1; i >= 0; i--)
+    {
+        if (GlyphRequests[i].Target->GetAsset() == asset)
+            GlyphRequests.RemoveAtKeepOrder(i);
+    }
+    for (Font* font : asset->_fonts)
+        font->_rasterizedCharacters.Clear();
+    AssetData* data;
+    if (AssetsData.TryGet(asset, data))
+    {
+        for (auto& e : data->SDFCharacters)
+            Invalidate(e.Value);
+        if (data->WorkerFace)
+            FT_Done_Face(data->WorkerFace);
+        Delete(data);
+        AssetsData.Remove(asset);
+    }
+}
+
+void FontManager::ProcessGlyphRequests()
+{
+    while (true)
+    {
+        // Process characters one by one so the main thread can synchronously add them in between
+        ScopeLock lock(Locker);
+        if (GlyphRequests.IsEmpty() || IsAtlasFull)
+        {
+            IsWorkerActive = false;
+            break;
+        }
+        const GlyphRequest request = GlyphRequests[0];
+
+        FontCharacterEntry entry;
+        const AssetData* data = GetAssetData(request.Target->GetAsset());
+        if (RasterizeEntry(request.Target, data->WorkerFace, request.Character, entry, false) && IsAtlasFull)
+        {
+            // Retry once there is a new atlas
+            continue;
+        }
+        GlyphRequests.RemoveAtKeepOrder(0);
+        request.Target->_rasterizedCharacters[request.Character] = entry;
+    }
+}
+
+void FontManager::StartWorker()
+{
+    if (!IsWorkerActive && !IsAtlasFull && GlyphRequests.HasItems())
+    {
+        IsWorkerActive = true;
+        Task::StartNew(ProcessGlyphRequests);
+    }
+}
+
+bool FontManager::AddRequest(Font* font, Char c)
+{
+    // Worker thread uses the own font face
+    const FontAsset* asset = font->GetAsset();
+    AssetData* data = GetAssetData(asset);
+    if (!data->WorkerFace)
+    {
+        const FT_Error error = FT_New_Memory_Face(Library, asset->_fontFile.Get(), static_cast<FT_Long>(asset->_fontFile.Length()), 0, &data->WorkerFace);
+        if (error)
+        {
+            data->WorkerFace = nullptr;
+            LOG_FT_ERROR(error);
+            return true;
+        }
+    }
+
+    GlyphRequests.Add({ font, c });
+    StartWorker();
+    return false;
+}
+
 void FontManager::Flush()
 {
+    Locker.Lock();
+    if (IsAtlasFull)
+    {
+        // Create a new atlas for the asynchronous rasterization (outside the lock as it uses content)
+        Locker.Unlock();
+        auto atlas = CreateAtlas();
+        Locker.Lock();
+        Atlases.Add(atlas);
+        IsAtlasFull = false;
+    }
+    StartWorker();
     for (const auto& atlas : Atlases)
     {
         atlas->Flush();
     }
+    Locker.Unlock();
 }
 
 void FontManager::EnsureAtlasCreated(int32 index)
 {
+    ScopeLock lock(Locker);
     Atlases[index]->EnsureTextureCreated();
 }
 
 bool FontManager::IsDirty()
 {
+    ScopeLock lock(Locker);
     for (const auto atlas : Atlases)
     {
         if (atlas->IsDirty())
@@ -327,6 +779,7 @@ bool FontManager::IsDirty()
 
 bool FontManager::HasDataSyncWithGPU()
 {
+    ScopeLock lock(Locker);
     for (const auto atlas : Atlases)
     {
         if (atlas->HasDataSyncWithGPU() == false)
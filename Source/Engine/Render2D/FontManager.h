@@ -22,6 +22,11 @@ class FLAXENGINE_API FontManager
     /// </summary>
     static float FontScale;
 
+    /// <summary>
+    /// True if rasterize the new font characters on a worker thread. Text layout uses the characters metrics right away and characters appear once they get rasterized (the caller is not blocked). Otherwise, characters are rasterized on the first use.
+    /// </summary>
+    static bool AsyncRasterization;
+
     /// <summary>
     /// Gets the FreeType library.
     /// </summary>
@@ -41,8 +46,31 @@ class FLAXENGINE_API FontManager
     /// <param name="font">The font to create character entry for it.</param>
     /// <param name="c">The character to add.</param>
     /// <param name="entry">The created character entry.</param>
+    /// <param name="async">True if rasterize character on a worker thread. Entry gets only the character metrics and it's marked as pending (see ResolveEntry).</param>
     /// <returns>True if cannot add new character entry to the font cache, otherwise false.</returns>
-    static bool AddNewEntry(Font* font, Char c, FontCharacterEntry& entry);
+    static bool AddNewEntry(Font* font, Char c, FontCharacterEntry& entry, bool async = false);
+
+    /// <summary>
+    /// Queues the character from given font for the asynchronous rasterization. Created entry is marked as pending and has no metrics (see ResolveEntry).
+    /// </summary>
+    /// <param name="font">The font to create character entry for it.</param>
+    /// <param name="c">The character to add.</param>
+    /// <param name="entry">The created character entry.</param>
+    static void QueueEntry(Font* font, Char c, FontCharacterEntry& entry);
+
+    /// <summary>
+    /// Updates the pending character entry with the asynchronous rasterization results.
+    /// </summary>
+    /// <param name="font">The font that contains the character.</param>
+    /// <param name="entry">The pending character entry.</param>
+    /// <param name="wait">True if rasterize character right away if it's not ready yet, otherwise entry can stay pending (but gets the character metrics).</param>
+    static void ResolveEntry(Font* font, FontCharacterEntry& entry, bool wait);
+
+    /// <summary>
+    /// Cancels the asynchronous rasterization of the font characters. Called before font deletion or invalidation.
+    /// </summary>
+    /// <param name="font">The font.</param>
+    static void CancelPending(Font* font);
 
     /// <summary>
     /// Invalidates the cached dynamic font character. Can be used to reload font characters after changing font asset options.
@@ -50,6 +78,12 @@ class FLAXENGINE_API FontManager
     /// <param name="entry">The font character entry.</param>
     static void Invalidate(FontCharacterEntry& entry);
 
+    /// <summary>
+    /// Invalidates the signed distance field characters shared by the fonts of the given asset and cancels the asynchronous rasterization of its characters. Called before font asset unload or after changing its options.
+    /// </summary>
+    /// <param name="asset">The font asset.</param>
+    static void Invalidate(FontAsset* asset);
+
     /// <summary>
     /// Flushes all font atlases.
     /// </summary>
@@ -69,4 +103,9 @@ class FLAXENGINE_API FontManager
     /// </summary>
     /// <returns><c>true</c> if all atlases has been synced with the GPU memory and data is up to date; otherwise, <c>false</c>.</returns>
     static bool HasDataSyncWithGPU();
+
+private:
+    static bool AddRequest(Font* font, Char c);
+    static void StartWorker();
+    static void ProcessGlyphRequests();
 };
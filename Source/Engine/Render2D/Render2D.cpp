@@ -4,9 +4,11 @@
 #include "Font.h"
 #include "FontManager.h"
 #include "FontTextureAtlas.h"
+#include "TextLayoutCache.h"
 #include "RotatedRectangle.h"
 #include "SpriteAtlas.h"
 #include "Engine/Core/Math/Matrix3x3.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Assets/MaterialBase.h"
 #include "Engine/Content/Content.h"
@@ -24,6 +26,9 @@
 #include "Engine/Core/Math/Half.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Scripting/Enums.h"
+#include "Engine/Threading/Threading.h"
+#include "Engine/Utilities/RectPack.h"
 
 #if USE_EDITOR
 #define RENDER2D_CHECK_RENDERING_STATE \
@@ -46,6 +51,16 @@
 
 #define RENDER2D_BLUR_MAX_SAMPLES 64
 
+// The size of the texture atlas page used for the small textures
+#define RENDER2D_ATLAS_PAGE_SIZE 1024
+// The maximum size of the texture that can be placed in the texture atlas
+#define RENDER2D_ATLAS_MAX_TEXTURE_SIZE 128
+// The maximum amount of the texture atlas pages
+#define RENDER2D_ATLAS_MAX_PAGES 8
+
+// The maximum amount of batches to search for the compatible one when reordering draw calls
+#define RENDER2D_REORDER_WINDOW 32
+
 // The format for the blur effect temporary buffer
 #define PS_Blur_Format PixelFormat::R8G8B8A8_UNorm
 
@@ -72,6 +87,7 @@ enum class DrawCallType : byte
     FillTexture,
     FillTexturePoint,
     DrawChar,
+    DrawCharSDF,
     DrawCharMaterial,
     Custom,
     Material,
@@ -162,6 +178,7 @@ struct CachedPSO
     GPUPipelineState* PS_Color_NoAlpha;
 
     GPUPipelineState* PS_Font;
+    GPUPipelineState* PS_FontSDF;
 
     GPUPipelineState* PS_BlurH;
     GPUPipelineState* PS_BlurV;
@@ -180,7 +197,7 @@ struct ClipMask
     Rectangle Bounds;
 };
 
-Render2D::RenderingFeatures Render2D::Features = RenderingFeatures::VertexSnapping;
+Render2D::RenderingFeatures Render2D::Features = RenderingFeatures::VertexSnapping | RenderingFeatures::TextureAtlas | RenderingFeatures::DrawCallsReordering;
 
 namespace
 {
@@ -193,7 +210,7 @@ namespace
 
     // Drawing
     Array<Render2DDrawCall> DrawCalls;
-    Array<FontLineCache> Lines;
+    Array<TextLayoutGlyph> Glyphs;
     Array<Float2> Lines2;
     bool IsScissorsRectEmpty;
     bool IsScissorsRectEnabled;
@@ -220,6 +237,10 @@ namespace
     DynamicIndexBuffer IB(RENDER2D_INITIAL_IB_CAPACITY, sizeof(uint32), TEXT("Render2D.IB"));
     uint32 VBIndex = 0;
     uint32 IBIndex = 0;
+
+    // Draw calls reordering
+    Array<Render2DDrawCall> ReorderedDrawCalls;
+    Array<byte> ReorderedIB;
 }
 
 #define RENDER2D_WRITE_IB_QUAD(indices) \
@@ -453,6 +474,7 @@ CanDrawCallCallback CanDrawCallBatch[] =
     CanDrawCallCallbackTexture, // FillTexture,
     CanDrawCallCallbackTexture, // FillTexturePoint,
     CanDrawCallCallbackChar, // DrawChar,
+    CanDrawCallCallbackChar, // DrawCharSDF,
     CanDrawCallCallbackCharMaterial, // DrawCharMaterial,
     CanDrawCallCallbackFalse, // Custom,
     CanDrawCallCallbackMaterial, // Material,
@@ -468,6 +490,257 @@ bool CanBatchDrawCalls(const Render2DDrawCall& d1, const Render2DDrawCall& d2)
     return d1.Type == d2.Type && CanDrawCallBatch[(int32)d1.Type](d1, d2);
 }
 
+struct Render2DAtlasSlot : RectPack<Render2DAtlasSlot>
+{
+    Render2DAtlasSlot(uint32 x, uint32 y, uint32 width, uint32 height)
+        : RectPack<Render2DAtlasSlot>(x, y, width, height)
+    {
+    }
+
+    void OnInsert()
+    {
+    }
+
+    void OnFree()
+    {
+    }
+};
+
+struct Render2DAtlasPage
+{
+    GPUTexture* Texture;
+    Render2DAtlasSlot* Root;
+};
+
+struct Render2DAtlasEntry
+{
+    GPUTexture* Source;
+    Render2DAtlasPage* Page;
+    Render2DAtlasSlot* Slot;
+    // The texture area in the atlas (inset by the half of the texel to prevent bleeding with linear filtering)
+    Rectangle Area;
+    // The texture area in the atlas (exact, for point filtering)
+    Rectangle AreaPoint;
+
+    void OnReleasing();
+};
+
+namespace
+{
+    CriticalSection AtlasLocker;
+    Array<Render2DAtlasPage*> AtlasPages;
+    Dictionary<GPUTexture*, Render2DAtlasEntry*> AtlasEntries;
+}
+
+void ReleaseAtlasTexture(GPUTexture* texture);
+
+void ReleaseAtlasEntry(Render2DAtlasEntry* entry)
+{
+    entry->Source->Releasing.Unbind<Render2DAtlasEntry, &Render2DAtlasEntry::OnReleasing>(entry);
+    entry->Source->ResidentMipsChanged.Unbind<ReleaseAtlasTexture>();
+    if (entry->Slot)
+        entry->Slot->Free();
+    AtlasEntries.Remove(entry->Source);
+    Delete(entry);
+}
+
+void ReleaseAtlasTexture(GPUTexture* texture)
+{
+    ScopeLock lock(AtlasLocker);
+    Render2DAtlasEntry* entry;
+    if (AtlasEntries.TryGet(texture, entry))
+        ReleaseAtlasEntry(entry);
+}
+
+void Render2DAtlasEntry::OnReleasing()
+{
+    ReleaseAtlasTexture(Source);
+}
+
+void DisposeAtlas()
+{
+    ScopeLock lock(AtlasLocker);
+    while (AtlasEntries.HasItems())
+        ReleaseAtlasEntry(AtlasEntries.Begin()->Value);
+    for (Render2DAtlasPage* page : AtlasPages)
+    {
+        SAFE_DELETE_GPU_RESOURCE(page->Texture);
+        Delete(page->Root);
+        Delete(page);
+    }
+    AtlasPages.Clear();
+}
+
+// Gets the texture atlas entry for the small texture (places it in the atlas on the first use). Returns null if texture cannot be used via atlas.
+Render2DAtlasEntry* GetAtlasEntry(GPUTexture* t)
+{
+    if (!t || !EnumHasAnyFlags(Render2D::Features, Render2D::RenderingFeatures::TextureAtlas))
+        return nullptr;
+    const int32 width = t->Width();
+    const int32 height = t->Height();
+    if (width > RENDER2D_ATLAS_MAX_TEXTURE_SIZE || height > RENDER2D_ATLAS_MAX_TEXTURE_SIZE || !t->IsRegularTexture() || t->Dimensions() != TextureDimensions::Texture || t->ArraySize() != 1 || t->ResidentMipLevels() != t->MipLevels())
+        return nullptr;
+    const bool isBlockCompressed = t->IsBlockCompressed();
+    if (isBlockCompressed && (width % 4 != 0 || height % 4 != 0))
+        return nullptr;
+
+    ScopeLock lock(AtlasLocker);
+    Render2DAtlasEntry* entry;
+    if (AtlasEntries.TryGet(t, entry))
+        return entry->Slot ? entry : nullptr;
+
+    // Find space in the atlas pages of the matching format (block-compressed textures need to be aligned to the blocks)
+    const uint32 padding = isBlockCompressed ? 4 : 2;
+    const PixelFormat format = t->Format();
+    Render2DAtlasPage* page = nullptr;
+    Render2DAtlasSlot* slot = nullptr;
+    for (int32 i = 0; i < AtlasPages.Count() && !slot; i++)
+    {
+        page = AtlasPages[i];
+        if (page->Texture->Format() == format)
+            slot = page->Root->Insert(width, height, padding);
+    }
+    if (!slot && AtlasPages.Count() < RENDER2D_ATLAS_MAX_PAGES)
+    {
+        PROFILE_CPU_NAMED("Render2D.CreateAtlas");
+        page = New<Render2DAtlasPage>();
+        page->Texture = GPUDevice::Instance->CreateTexture(TEXT("Render2D.Atlas"));
+        page->Root = New<Render2DAtlasSlot>(0, 0, RENDER2D_ATLAS_PAGE_SIZE, RENDER2D_ATLAS_PAGE_SIZE);
+        if (page->Texture->Init(GPUTextureDescription::New2D(RENDER2D_ATLAS_PAGE_SIZE, RENDER2D_ATLAS_PAGE_SIZE, 1, format, GPUTextureFlags::ShaderResource)))
+        {
+            LOG(Warning, "Failed to create Render2D texture atlas ({0}).", ScriptingEnum::ToString(format));
+            SAFE_DELETE_GPU_RESOURCE(page->Texture);
+            Delete(page->Root);
+            Delete(page);
+            page = nullptr;
+        }
+        else
+        {
+            AtlasPages.Add(page);
+            slot = page->Root->Insert(width, height, padding);
+        }
+    }
+
+    // Register entry (also if failed to place it in atlas to skip it later)
+    entry = New<Render2DAtlasEntry>();
+    entry->Source = t;
+    entry->Page = slot ? page : nullptr;
+    entry->Slot = slot;
+    AtlasEntries.Add(t, entry);
+    t->Releasing.Bind<Render2DAtlasEntry, &Render2DAtlasEntry::OnReleasing>(entry);
+    t->ResidentMipsChanged.Bind<ReleaseAtlasTexture>();
+    if (!slot)
+        return nullptr;
+
+    // Copy the texture contents into the atlas
+    Context->CopyTexture(entry->Page->Texture, 0, slot->X, slot->Y, 0, t, 0);
+    const float invSize = 1.0f / RENDER2D_ATLAS_PAGE_SIZE;
+    entry->AreaPoint = Rectangle((float)slot->X * invSize, (float)slot->Y * invSize, (float)width * invSize, (float)height * invSize);
+    entry->Area = Rectangle(((float)slot->X + 0.5f) * invSize, ((float)slot->Y + 0.5f) * invSize, ((float)width - 1.0f) * invSize, ((float)height - 1.0f) * invSize);
+    return entry;
+}
+
+FORCE_INLINE bool IsReorderBarrier(DrawCallType type)
+{
+    // Scissors change the state of all the following draw calls and blur samples the output
+    return type == DrawCallType::ClipScissors || type == DrawCallType::Blur;
+}
+
+FORCE_INLINE bool IsOverlapping(const Float4& a, const Float4& b)
+{
+    return a.X < b.Z && b.X < a.Z && a.Y < b.W && b.Y < a.W;
+}
+
+// Reorders the draw calls to group the compatible ones (skips over the draw calls that don't overlap). Preserves the order of the overlapping elements.
+void ReorderDrawCalls()
+{
+    PROFILE_CPU_NAMED("Reorder");
+    struct Batch
+    {
+        int32 First;
+        int32 Last;
+        Float4 Bounds;
+    };
+    Array<Batch, InlinedAllocation<RENDER2D_INITIAL_DRAW_CALL_CAPACITY>> batches;
+    Array<int32, InlinedAllocation<RENDER2D_INITIAL_DRAW_CALL_CAPACITY>> next;
+    next.Resize(DrawCalls.Count());
+    const auto vertices = (const Render2DVertex*)VB.Data.Get();
+    const auto indices = (const uint32*)IB.Data.Get();
+    int32 segmentStart = 0;
+    bool anyMoved = false;
+    for (int32 i = 0; i < DrawCalls.Count(); i++)
+    {
+        const Render2DDrawCall& drawCall = DrawCalls[i];
+        next[i] = -1;
+        if (IsReorderBarrier(drawCall.Type))
+        {
+            batches.Add({ i, i, Float4::Zero });
+            segmentStart = batches.Count();
+            continue;
+        }
+
+        // Calculate the draw call bounds (extended a bit to include pixels snapping and antialiasing)
+        Float4 bounds(MAX_float, MAX_float, MIN_float, MIN_float);
+        for (uint32 j = 0; j < drawCall.CountIB; j++)
+        {
+            const Float2& position = vertices[indices[drawCall.StartIB + j]].Position;
+            bounds.X = Math::Min(bounds.X, position.X);
+            bounds.Y = Math::Min(bounds.Y, position.Y);
+            bounds.Z = Math::Max(bounds.Z, position.X);
+            bounds.W = Math::Max(bounds.W, position.Y);
+        }
+        bounds += Float4(-1.0f, -1.0f, 1.0f, 1.0f);
+
+        // Find the compatible batch that is not covered by the batches placed after it
+        int32 target = -1;
+        const int32 searchEnd = Math::Max(segmentStart, batches.Count() - RENDER2D_REORDER_WINDOW);
+        for (int32 j = batches.Count() - 1; j >= searchEnd; j--)
+        {
+            const Batch& batch = batches[j];
+            if (CanBatchDrawCalls(DrawCalls[batch.First], drawCall))
+            {
+                target = j;
+                break;
+            }
+            if (IsOverlapping(batch.Bounds, bounds))
+                break;
+        }
+        if (target == -1)
+        {
+            batches.Add({ i, i, bounds });
+            continue;
+        }
+        Batch& batch = batches[target];
+        next[batch.Last] = i;
+        batch.Last = i;
+        batch.Bounds = Float4(Math::Min(batch.Bounds.X, bounds.X), Math::Min(batch.Bounds.Y, bounds.Y), Math::Max(batch.Bounds.Z, bounds.Z), Math::Max(batch.Bounds.W, bounds.W));
+        anyMoved |= target != batches.Count() - 1;
+    }
+    if (!anyMoved)
+        return;
+
+    // Rebuild draw calls and index buffer in the new order (batched draw calls need to use continuous ranges of indices)
+    ReorderedDrawCalls.Clear();
+    ReorderedDrawCalls.EnsureCapacity(DrawCalls.Count());
+    ReorderedIB.Clear();
+    ReorderedIB.EnsureCapacity(IB.Data.Count());
+    for (const Batch& batch : batches)
+    {
+        for (int32 i = batch.First; i != -1; i = next[i])
+        {
+            Render2DDrawCall& drawCall = ReorderedDrawCalls.AddOne();
+            drawCall = DrawCalls[i];
+            if (drawCall.Type == DrawCallType::ClipScissors)
+                continue;
+            const uint32 startIB = ReorderedIB.Count() / sizeof(uint32);
+            ReorderedIB.Add((const byte*)(indices + drawCall.StartIB), drawCall.CountIB * sizeof(uint32));
+            drawCall.StartIB = startIB;
+        }
+    }
+    DrawCalls.Swap(ReorderedDrawCalls);
+    IB.Data.Swap(ReorderedIB);
+}
+
 void DrawBatch(int32 startIndex, int32 count);
 
 bool CachedPSO::Init(GPUShader* shader, bool useDepth)
@@ -515,6 +788,11 @@ bool CachedPSO::Init(GPUShader* shader, bool useDepth)
     if (PS_Font->Init(desc))
         return true;
     //
+    desc.PS = shader->GetPS("PS_FontSDF");
+    PS_FontSDF = GPUDevice::Instance->CreatePipelineState();
+    if (PS_FontSDF->Init(desc))
+        return true;
+    //
     desc.PS = shader->GetPS("PS_LineAA");
     PS_LineAA = GPUDevice::Instance->CreatePipelineState();
     if (PS_LineAA->Init(desc))
@@ -552,6 +830,7 @@ void CachedPSO::Dispose()
     SAFE_DELETE_GPU_RESOURCE(PS_Color);
     SAFE_DELETE_GPU_RESOURCE(PS_Color_NoAlpha);
     SAFE_DELETE_GPU_RESOURCE(PS_Font);
+    SAFE_DELETE_GPU_RESOURCE(PS_FontSDF);
     SAFE_DELETE_GPU_RESOURCE(PS_BlurH);
     SAFE_DELETE_GPU_RESOURCE(PS_BlurV);
     SAFE_DELETE_GPU_RESOURCE(PS_Downscale);
@@ -566,6 +845,7 @@ class Render2DService : public EngineService
     Render2DService()
         : EngineService(TEXT("Render2D"), 10)
     {
+        RenderOnly = true;
     }
 
     bool Init() override;
@@ -614,13 +894,16 @@ void Render2DService::Dispose()
     TintLayersStack.Resize(0);
     ClipLayersStack.Resize(0);
     DrawCalls.Resize(0);
-    Lines.Resize(0);
+    Glyphs.Resize(0);
     Lines2.Resize(0);
 
     GUIShader = nullptr;
 
     PsoDepth.Dispose();
     PsoNoDepth.Dispose();
+    DisposeAtlas();
+    ReorderedDrawCalls.Resize(0);
+    ReorderedIB.Resize(0);
 
     VB.Dispose();
     IB.Dispose();
@@ -715,6 +998,10 @@ void Render2D::End()
 
     PROFILE_GPU_CPU_NAMED("Render2D");
 
+    // Group draw calls to reduce the amount of batches
+    if (EnumHasAnyFlags(Features, RenderingFeatures::DrawCallsReordering) && DrawCalls.Count() > 2)
+        ReorderDrawCalls();
+
     // Prepare shader
     GPUShader* shader;
     {
@@ -981,6 +1268,10 @@ void DrawBatch(int32 startIndex, int32 count)
         Context->BindSR(0, d.AsChar.Tex);
         Context->SetState(CurrentPso->PS_Font);
         break;
+    case DrawCallType::DrawCharSDF:
+        Context->BindSR(0, d.AsChar.Tex);
+        Context->SetState(CurrentPso->PS_FontSDF);
+        break;
     case DrawCallType::DrawCharMaterial:
     {
         // Apply and bind material
@@ -1159,6 +1450,7 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
     FontCharacterEntry previous;
     int32 kerning;
     float scale = 1.0f / FontManager::FontScale;
+    const float glyphScale = font->GetGlyphScale();
 
     // Render all characters
     FontCharacterEntry entry;
@@ -1170,7 +1462,7 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
     }
     else
     {
-        drawCall.Type = DrawCallType::DrawChar;
+        drawCall.Type = font->IsSDF() ? DrawCallType::DrawCharSDF : DrawCallType::DrawChar;
         drawCall.AsChar.Mat = nullptr;
     }
     Float2 pointer = location;
@@ -1226,7 +1518,7 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
                 const float x = pointer.X + entry.OffsetX * scale;
                 const float y = pointer.Y + (font->GetHeight() + font->GetDescender() - entry.OffsetY) * scale;
 
-                Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
+                Rectangle charRect(x, y, entry.UVSize.X * glyphScale * scale, entry.UVSize.Y * glyphScale * scale);
 
                 Float2 upperLeftUV = entry.UV * invAtlasSize;
                 Float2 rightBottomUV = (entry.UV + entry.UVSize) * invAtlasSize;
@@ -1270,16 +1562,12 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
     uint32 fontAtlasIndex = 0;
     FontTextureAtlas* fontAtlas = nullptr;
     Float2 invAtlasSize = Float2::One;
-    FontCharacterEntry previous;
-    int32 kerning;
-    float scale = layout.Scale / FontManager::FontScale;
 
-    // Process text to get lines
-    Lines.Clear();
-    font->ProcessText(text, Lines, layout);
+    // Get the text glyphs (cached layout skips the lines processing and kerning for the static text)
+    Glyphs.Clear();
+    TextLayoutCache::GetGlyphs(font, text, layout, Glyphs);
 
-    // Render all lines
-    FontCharacterEntry entry;
+    // Render all glyphs
     Render2DDrawCall drawCall;
     if (customMaterial)
     {
@@ -1288,78 +1576,41 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
     }
     else
     {
-        drawCall.Type = DrawCallType::DrawChar;
+        drawCall.Type = font->IsSDF() ? DrawCallType::DrawCharSDF : DrawCallType::DrawChar;
         drawCall.AsChar.Mat = nullptr;
     }
-    for (int32 lineIndex = 0; lineIndex < Lines.Count(); lineIndex++)
+    for (const TextLayoutGlyph& glyph : Glyphs)
     {
-        const FontLineCache& line = Lines[lineIndex];
-        Float2 pointer = line.Location;
-
-        // Render all characters from the line
-        for (int32 charIndex = line.FirstCharIndex; charIndex <= line.LastCharIndex; charIndex++)
+        // Check if need to select/change font atlas (since characters even in the same font may be located in different atlases)
+        if (fontAtlas == nullptr || glyph.TextureIndex != fontAtlasIndex)
         {
-            const Char c = text[charIndex];
-            if (c != '\n')
+            // Get texture atlas that contains current character
+            fontAtlasIndex = glyph.TextureIndex;
+            fontAtlas = FontManager::GetAtlas(fontAtlasIndex);
+            if (fontAtlas)
             {
-                font->GetCharacter(c, entry);
-
-                // Check if need to select/change font atlas (since characters even in the same font may be located in different atlases)
-                if (fontAtlas == nullptr || entry.TextureIndex != fontAtlasIndex)
-                {
-                    // Get texture atlas that contains current character
-                    fontAtlasIndex = entry.TextureIndex;
-                    fontAtlas = FontManager::GetAtlas(fontAtlasIndex);
-                    if (fontAtlas)
-                    {
-                        fontAtlas->EnsureTextureCreated();
-                        invAtlasSize = 1.0f / fontAtlas->GetSize();
-                        drawCall.AsChar.Tex = fontAtlas->GetTexture();
-                    }
-                    else
-                    {
-                        invAtlasSize = 1.0f;
-                        drawCall.AsChar.Tex = nullptr;
-                    }
-                }
-
-                // Get kerning
-                const bool isWhitespace = StringUtils::IsWhitespace(c);
-                if (!isWhitespace && previous.IsValid)
-                {
-                    kerning = font->GetKerning(previous.Character, entry.Character);
-                }
-                else
-                {
-                    kerning = 0;
-                }
-                pointer.X += (float)kerning * scale;
-                previous = entry;
-
-                // Omit whitespace characters
-                if (!isWhitespace)
-                {
-                    // Calculate character size and atlas coordinates
-                    const float x = pointer.X + entry.OffsetX * scale;
-                    const float y = pointer.Y - entry.OffsetY * scale + Math::Ceil((font->GetHeight() + font->GetDescender()) * scale);
-
-                    Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
-                    charRect.Offset(layout.Bounds.Location);
-
-                    Float2 upperLeftUV = entry.UV * invAtlasSize;
-                    Float2 rightBottomUV = (entry.UV + entry.UVSize) * invAtlasSize;
-
-                    // Add draw call
-                    drawCall.StartIB = IBIndex;
-                    drawCall.CountIB = 6;
-                    DrawCalls.Add(drawCall);
-                    WriteRect(charRect, color, upperLeftUV, rightBottomUV);
-                }
-
-                // Move
-                pointer.X += entry.AdvanceX * scale;
+                fontAtlas->EnsureTextureCreated();
+                invAtlasSize = 1.0f / fontAtlas->GetSize();
+                drawCall.AsChar.Tex = fontAtlas->GetTexture();
+            }
+            else
+            {
+                invAtlasSize = 1.0f;
+                drawCall.AsChar.Tex = nullptr;
             }
         }
+
+        // Calculate character size and atlas coordinates
+        Rectangle charRect = glyph.Rect;
+        charRect.Offset(layout.Bounds.Location);
+        Float2 upperLeftUV = glyph.UV * invAtlasSize;
+        Float2 rightBottomUV = (glyph.UV + glyph.UVSize) * invAtlasSize;
+
+        // Add draw call
+        drawCall.StartIB = IBIndex;
+        drawCall.CountIB = 6;
+        DrawCalls.Add(drawCall);
+        WriteRect(charRect, color, upperLeftUV, rightBottomUV);
     }
 }
 
@@ -1588,7 +1839,15 @@ void Render2D::DrawTexture(TextureBase* t, const Rectangle& rect, const Color& c
     drawCall.Type = DrawCallType::FillTexture;
     drawCall.StartIB = IBIndex;
     drawCall.CountIB = 6;
-    drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
+    GPUTexture* texture = t ? t->GetTexture() : nullptr;
+    if (const Render2DAtlasEntry* atlas = GetAtlasEntry(texture))
+    {
+        drawCall.AsTexture.Ptr = atlas->Page->Texture;
+        DrawCalls.Add(drawCall);
+        WriteRect(rect, color, atlas->Area.GetUpperLeft(), atlas->Area.GetBottomRight());
+        return;
+    }
+    drawCall.AsTexture.Ptr = texture;
     DrawCalls.Add(drawCall);
     WriteRect(rect, color);
 }
@@ -1643,7 +1902,15 @@ void Render2D::Draw9SlicingTexture(TextureBase* t, const Rectangle& rect, const
     drawCall.Type = DrawCallType::FillTexture;
     drawCall.StartIB = IBIndex;
     drawCall.CountIB = 6 * 9;
-    drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
+    GPUTexture* texture = t ? t->GetTexture() : nullptr;
+    if (const Render2DAtlasEntry* atlas = GetAtlasEntry(texture))
+    {
+        drawCall.AsTexture.Ptr = atlas->Page->Texture;
+        DrawCalls.Add(drawCall);
+        Write9SlicingRect(rect, color, border, borderUVs, atlas->Area.Location, atlas->Area.Size);
+        return;
+    }
+    drawCall.AsTexture.Ptr = texture;
     DrawCalls.Add(drawCall);
     Write9SlicingRect(rect, color, border, borderUVs);
 }
@@ -1656,7 +1923,15 @@ void Render2D::Draw9SlicingTexturePoint(TextureBase* t, const Rectangle& rect, c
     drawCall.Type = DrawCallType::FillTexturePoint;
     drawCall.StartIB = IBIndex;
     drawCall.CountIB = 6 * 9;
-    drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
+    GPUTexture* texture = t ? t->GetTexture() : nullptr;
+    if (const Render2DAtlasEntry* atlas = GetAtlasEntry(texture))
+    {
+        drawCall.AsTexture.Ptr = atlas->Page->Texture;
+        DrawCalls.Add(drawCall);
+        Write9SlicingRect(rect, color, border, borderUVs, atlas->AreaPoint.Location, atlas->AreaPoint.Size);
+        return;
+    }
+    drawCall.AsTexture.Ptr = texture;
     DrawCalls.Add(drawCall);
     Write9SlicingRect(rect, color, border, borderUVs);
 }
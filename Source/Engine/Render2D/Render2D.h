@@ -44,6 +44,16 @@ API_CLASS(Static) class FLAXENGINE_API Render2D
         /// Enables automatic geometry vertices snapping to integer coordinates in screen space. Reduces aliasing and sampling artifacts. Might be disabled for 3D projection viewport or for complex UI transformations.
         /// </summary>
         VertexSnapping = 1,
+
+        /// <summary>
+        /// Enables automatic packing of the small textures (eg. UI icons and images) into the shared texture atlas so elements using different textures can be drawn in a single batch.
+        /// </summary>
+        TextureAtlas = 2,
+
+        /// <summary>
+        /// Enables draw calls reordering that groups the compatible draw calls (the same pipeline state and texture) which don't overlap the elements drawn in between them. Reduces the amount of batches for complex UI layouts while preserving correct overlap order.
+        /// </summary>
+        DrawCallsReordering = 4,
     };
 
     struct CustomData
@@ -452,3 +462,5 @@ API_CLASS(Static) class FLAXENGINE_API Render2D
     /// <param name="color">The color.</param>
     API_FUNCTION() static void FillTriangle(const Float2& p0, const Float2& p1, const Float2& p2, const Color& color);
 };
+
+DECLARE_ENUM_OPERATORS(Render2D::RenderingFeatures);
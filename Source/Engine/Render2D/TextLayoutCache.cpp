@@ -0,0 +1,231 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "TextLayoutCache.h"
+#include "Font.h"
+#include "FontManager.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    struct LayoutKey
+    {
+        const Font* Owner;
+        StringView Text;
+        TextLayoutOptions Layout;
+
+        bool operator==(const LayoutKey& other) const
+        {
+            return Owner == other.Owner && Layout == other.Layout && Text == other.Text;
+        }
+    };
+
+    uint32 GetHash(const LayoutKey& key)
+    {
+        uint32 hash = ::GetHash(key.Text);
+        CombineHash(hash, key.Owner);
+        return hash;
+    }
+
+    struct LayoutEntry
+    {
+        String Text;
+        LayoutKey Key;
+        Array<FontLineCache> Lines;
+        Array<TextLayoutGlyph> Glyphs;
+        bool HasGlyphs = false;
+        uint64 LastUsed = 0;
+    };
+
+    CriticalSection Locker;
+    Dictionary<LayoutKey, LayoutEntry*> Layouts;
+    Array<uint64> LastUsedTmp;
+    uint64 UseCounter = 0;
+
+    LayoutKey GetKey(const Font* font, const StringView& text, const TextLayoutOptions& layout)
+    {
+        LayoutKey key;
+        key.Owner = font;
+        key.Text = text;
+        key.Layout = layout;
+
+        // Layout is relative to the bounds location
+        key.Layout.Bounds.Location = Float2::Zero;
+        return key;
+    }
+
+    bool BuildGlyphs(Font* font, const StringView& text, const TextLayoutOptions& layout, const Array<FontLineCache>& lines, Array<TextLayoutGlyph>& glyphs)
+    {
+        bool isComplete = true;
+        FontCharacterEntry entry;
+        FontCharacterEntry previous;
+        const float scale = layout.Scale / FontManager::FontScale;
+        const float glyphScale = font->GetGlyphScale();
+        const float baseLine = Math::Ceil((font->GetHeight() + font->GetDescender()) * scale);
+        TextLayoutGlyph glyph;
+        for (const FontLineCache& line : lines)
+        {
+            Float2 pointer = line.Location;
+            for (int32 charIndex = line.FirstCharIndex; charIndex <= line.LastCharIndex; charIndex++)
+            {
+                const Char c = text[charIndex];
+                if (c == '\n')
+                    continue;
+                font->GetCharacter(c, entry);
+                isComplete &= !entry.IsPending;
+
+                // Get kerning
+                const bool isWhitespace = StringUtils::IsWhitespace(c);
+                if (!isWhitespace && previous.IsValid)
+                {
+                    pointer.X += (float)font->GetKerning(previous.Character, entry.Character) * scale;
+                }
+                previous = entry;
+
+                // Omit whitespace characters
+                if (!isWhitespace)
+                {
+                    glyph.Rect = Rectangle(pointer.X + entry.OffsetX * scale, pointer.Y - entry.OffsetY * scale + baseLine, entry.UVSize.X * glyphScale * scale, entry.UVSize.Y * glyphScale * scale);
+                    glyph.UV = entry.UV;
+                    glyph.UVSize = entry.UVSize;
+                    glyph.TextureIndex = entry.TextureIndex;
+                    glyphs.Add(glyph);
+                }
+
+                // Move
+                pointer.X += entry.AdvanceX * scale;
+            }
+        }
+        return isComplete;
+    }
+
+    void Evict()
+    {
+        if (Layouts.Count() <= TextLayoutCache::Capacity)
+            return;
+        PROFILE_CPU();
+
+        // Remove the least recently used quarter of the layouts
+        LastUsedTmp.Clear();
+        for (const auto& e : Layouts)
+            LastUsedTmp.Add(e.Value->LastUsed);
+        Sorting::QuickSort(LastUsedTmp.Get(), LastUsedTmp.Count());
+        const uint64 threshold = LastUsedTmp[LastUsedTmp.Count() / 4];
+        for (auto i = Layouts.Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value->LastUsed <= threshold)
+            {
+                LayoutEntry* entry = i->Value;
+                Layouts.Remove(i);
+                Delete(entry);
+            }
+        }
+    }
+
+    void Store(const LayoutKey& key, Array<FontLineCache>& lines, Array<TextLayoutGlyph>* glyphs, bool hasGlyphs)
+    {
+        ScopeLock lock(Locker);
+        LayoutEntry* entry;
+        if (!Layouts.TryGet(key, entry))
+        {
+            entry = New<LayoutEntry>();
+            entry->Text = key.Text;
+            entry->Key = key;
+            entry->Key.Text = entry->Text;
+            entry->Lines.Swap(lines);
+            Layouts.Add(entry->Key, entry);
+        }
+        if (glyphs && !entry->HasGlyphs)
+        {
+            entry->Glyphs.Swap(*glyphs);
+            entry->HasGlyphs = hasGlyphs;
+        }
+        entry->LastUsed = ++UseCounter;
+        Evict();
+    }
+}
+
+int32 TextLayoutCache::Capacity = 1024;
+
+void TextLayoutCache::GetLines(Font* font, const StringView& text, const TextLayoutOptions& layout, Array<FontLineCache>& outputLines)
+{
+    if (text.IsEmpty())
+        return;
+    const LayoutKey key = GetKey(font, text, layout);
+
+    // Try to use cached layout
+    {
+        ScopeLock lock(Locker);
+        LayoutEntry* entry;
+        if (Layouts.TryGet(key, entry))
+        {
+            entry->LastUsed = ++UseCounter;
+            outputLines.Add(entry->Lines);
+            return;
+        }
+    }
+
+    // Process text outside the lock (it accesses the font characters)
+    Array<FontLineCache> lines;
+    font->processText(text, lines, key.Layout);
+    outputLines.Add(lines);
+    Store(key, lines, nullptr, false);
+}
+
+void TextLayoutCache::GetGlyphs(Font* font, const StringView& text, const TextLayoutOptions& layout, Array<TextLayoutGlyph>& outputGlyphs)
+{
+    if (text.IsEmpty())
+        return;
+    const LayoutKey key = GetKey(font, text, layout);
+
+    // Try to use cached layout
+    Array<FontLineCache> lines;
+    {
+        ScopeLock lock(Locker);
+        LayoutEntry* entry;
+        if (Layouts.TryGet(key, entry))
+        {
+            entry->LastUsed = ++UseCounter;
+            if (entry->HasGlyphs)
+            {
+                outputGlyphs.Add(entry->Glyphs);
+                return;
+            }
+            lines = entry->Lines;
+        }
+    }
+
+    // Build glyphs outside the lock (it accesses the font characters)
+    PROFILE_CPU();
+    if (lines.IsEmpty())
+        font->processText(text, lines, key.Layout);
+    Array<TextLayoutGlyph> glyphs;
+    const bool isComplete = BuildGlyphs(font, text, key.Layout, lines, glyphs);
+    outputGlyphs.Add(glyphs);
+
+    // Skip caching glyphs that are still being rasterized so they get updated later
+    Store(key, lines, &glyphs, isComplete);
+}
+
+void TextLayoutCache::Invalidate(Font* font)
+{
+    ScopeLock lock(Locker);
+    for (auto i = Layouts.Begin(); i.IsNotEnd(); ++i)
+    {
+        if (i->Value->Key.Owner == font)
+        {
+            LayoutEntry* entry = i->Value;
+            Layouts.Remove(i);
+            Delete(entry);
+        }
+    }
+}
+
+void TextLayoutCache::Clear()
+{
+    ScopeLock lock(Locker);
+    Layouts.ClearDelete();
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/StringView.h"
+#include "TextLayoutOptions.h"
+
+class Font;
+struct FontLineCache;
+
+/// <summary>
+/// The glyph of the processed text layout (ready for drawing).
+/// </summary>
+struct TextLayoutGlyph
+{
+    /// <summary>
+    /// The glyph rectangle (relative to the layout bounds location).
+    /// </summary>
+    Rectangle Rect;
+
+    /// <summary>
+    /// The location of the glyph in the font atlas (in texels).
+    /// </summary>
+    Float2 UV;
+
+    /// <summary>
+    /// The size of the glyph in the font atlas (in texels).
+    /// </summary>
+    Float2 UVSize;
+
+    /// <summary>
+    /// The index of the font atlas that contains the glyph.
+    /// </summary>
+    byte TextureIndex;
+};
+
+template<>
+struct TIsPODType<TextLayoutGlyph>
+{
+    enum { Value = true };
+};
+
+/// <summary>
+/// The cache of the processed text layouts (lines and glyphs) keyed by the font, text and layout options. Skips line breaking and kerning for the texts that are drawn or measured every frame. The least recently used layouts are evicted once cache exceeds its capacity.
+/// </summary>
+/// <remarks>
+/// Layouts don't depend on the layout bounds location so the moving text still hits the cache. Layouts are invalidated when font gets invalidated or deleted and when localization changes.
+/// </remarks>
+class FLAXENGINE_API TextLayoutCache
+{
+public:
+    /// <summary>
+    /// The maximum amount of the cached text layouts.
+    /// </summary>
+    static int32 Capacity;
+
+    /// <summary>
+    /// Gets the text layout lines. Output lines are appended to the array.
+    /// </summary>
+    /// <param name="font">The font.</param>
+    /// <param name="text">The input text.</param>
+    /// <param name="layout">The layout properties.</param>
+    /// <param name="outputLines">The output lines list.</param>
+    static void GetLines(Font* font, const StringView& text, const TextLayoutOptions& layout, Array<FontLineCache>& outputLines);
+
+    /// <summary>
+    /// Gets the text layout glyphs ready for drawing (whitespace characters are skipped). Output glyphs are appended to the array.
+    /// </summary>
+    /// <param name="font">The font.</param>
+    /// <param name="text">The input text.</param>
+    /// <param name="layout">The layout properties.</param>
+    /// <param name="outputGlyphs">The output glyphs list.</param>
+    static void GetGlyphs(Font* font, const StringView& text, const TextLayoutOptions& layout, Array<TextLayoutGlyph>& outputGlyphs);
+
+    /// <summary>
+    /// Removes all the cached layouts of the given font. Called when font characters get invalidated or font gets deleted.
+    /// </summary>
+    /// <param name="font">The font.</param>
+    static void Invalidate(Font* font);
+
+    /// <summary>
+    /// Removes all the cached layouts.
+    /// </summary>
+    static void Clear();
+};
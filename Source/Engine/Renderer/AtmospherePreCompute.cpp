@@ -2,7 +2,7 @@
 
 #include "AtmospherePreCompute.h"
 #include "Engine/Engine/Engine.h"
-#include "Engine/Engine/Time.h"
+#include "Engine/Engine/Globals.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Graphics/GPUContext.h"
@@ -12,7 +12,11 @@
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Graphics/Textures/TextureData.h"
+#include "Engine/Graphics/Async/GPUTask.h"
 #include "Engine/Platform/Window.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Core/Collections/HashFunctions.h"
 #include "RendererPass.h"
 #include "Engine/Threading/ThreadPoolTask.h"
 #include "Engine/Content/Assets/Shader.h"
@@ -21,6 +25,9 @@
 // Amount of frames to wait for data from atmosphere precompute job
 #define ATMOSPHERE_PRECOMPUTE_LATENCY_FRAMES 1
 
+// Version of the atmosphere cache file (increment it after changing the precompute shader)
+#define ATMOSPHERE_PRECOMPUTE_CACHE_VERSION 1
+
 const float DensityHeight = 0.5f;
 const int32 MaxScatteringOrder = 4;
 
@@ -43,6 +50,29 @@ const static float RadiusScale = 1;
 const static float RadiusGround = 6360 * RadiusScale;
 const static float RadiusAtmosphere = 6420 * RadiusScale;
 
+// Precompute is split into steps (one per frame): single scattering, then each of the next scattering orders (and the readback for the cache in Editor)
+#if USE_EDITOR
+const int32 ComputeStepsCount = MaxScatteringOrder + 1;
+#else
+const int32 ComputeStepsCount = MaxScatteringOrder;
+#endif
+
+// Size of the texture data (R16G16B16A16_Float format)
+const int32 TransmittanceDataSize = TransmittanceTexWidth * TransmittanceTexHeight * 8;
+const int32 IrradianceDataSize = IrradianceTexWidth * IrradianceTexHeight * 8;
+const int32 InscatterDataSize = InscatterWidth * InscatterHeight * InscatterDepth * 8;
+
+PACK_STRUCT(struct CacheHeader
+    {
+    uint32 Version;
+    uint32 Key;
+    int32 TransmittanceSize;
+    int32 IrradianceSize;
+    int32 InscatterSize;
+    });
+
+#if USE_EDITOR
+
 class DownloadJob : public ThreadPoolTask
 {
 private:
@@ -55,12 +85,19 @@ class DownloadJob : public ThreadPoolTask
 
     DownloadJob(GPUTexture* transmittance, GPUTexture* irradiance, GPUTexture* inscatter);
 
+public:
+
+    // [ThreadPoolTask]
+    bool HasReference(Object* resource) const override;
+
 protected:
 
     // [ThreadPoolTask]
     bool Run() override;
 };
 
+#endif
+
 PACK_STRUCT(struct Data
     {
     float First;
@@ -72,9 +109,24 @@ PACK_STRUCT(struct Data
 
 namespace AtmospherePreComputeImpl
 {
+    enum class States
+    {
+        Idle,
+        LoadingCache,
+        UploadingCache,
+        LoadingShader,
+        Computing,
+        SavingCache,
+        Done,
+    };
+
+    States _state = States::Idle;
     bool _isUpdatePending = false;
     bool _isReadyForCompute = false;
     bool _hasDataCached = false;
+    int32 _computeStep = 0;
+    Task* _cacheTasks[3] = {};
+    Array<byte> _cacheData;
 
     AssetReference<Shader> _shader;
     GPUPipelineState* _psTransmittance = nullptr;
@@ -88,6 +140,7 @@ namespace AtmospherePreComputeImpl
     GPUPipelineState* _psCopyInscatterNAdd = nullptr;
     GPUPipelineState* _psInscatterS = nullptr;
     GPUPipelineState* _psInscatterN = nullptr;
+    GPUPipelineState* _psReadInscatter = nullptr;
     SceneRenderTask* _task = nullptr;
 
     //
@@ -99,6 +152,7 @@ namespace AtmospherePreComputeImpl
     GPUTexture* AtmosphereDeltaSR = nullptr;
     GPUTexture* AtmosphereDeltaSM = nullptr;
     GPUTexture* AtmosphereDeltaJ = nullptr;
+    GPUTexture* AtmosphereInscatterReadback = nullptr;
 
     uint64 _updateFrameNumber;
     bool _wasCancelled;
@@ -108,6 +162,22 @@ namespace AtmospherePreComputeImpl
         return _updateFrameNumber > 0 && _updateFrameNumber + ATMOSPHERE_PRECOMPUTE_LATENCY_FRAMES <= Engine::FrameCount;
     }
 
+    bool areCacheTasksEnded(bool& failed)
+    {
+        failed = false;
+        for (Task* task : _cacheTasks)
+        {
+            if (!task)
+                continue;
+            if (!task->IsEnded())
+                return false;
+            failed |= task->IsFailed() || task->IsCanceled();
+        }
+        for (Task*& task : _cacheTasks)
+            task = nullptr;
+        return true;
+    }
+
     void onRender(RenderTask* task, GPUContext* context);
 }
 
@@ -120,6 +190,7 @@ class AtmospherePreComputeService : public EngineService
     AtmospherePreComputeService()
         : EngineService(TEXT("Atmosphere Pre Compute"), 50)
     {
+        RenderOnly = true;
     }
 
     void Update() override;
@@ -139,7 +210,7 @@ bool AtmospherePreCompute::GetCache(AtmosphereCache* cache)
             cache->Inscatter = AtmosphereInscatter;
         }
     }
-    else if (_task == nullptr || !_task->Enabled)
+    else
     {
         _isUpdatePending = true;
     }
@@ -147,6 +218,91 @@ bool AtmospherePreCompute::GetCache(AtmosphereCache* cache)
     return _hasDataCached;
 }
 
+String AtmospherePreCompute::GetCachePath()
+{
+#if USE_EDITOR
+    return Globals::ProjectCacheFolder / TEXT("AtmospherePreCompute.bin");
+#else
+    return Globals::ProjectContentFolder / TEXT("AtmospherePreCompute.bin");
+#endif
+}
+
+uint32 getCacheKey()
+{
+    // Precomputed data depends only on the atmosphere parameters (planet radius, density, resolution of the textures)
+    uint32 key = GetHash(DensityHeight);
+    CombineHash(key, GetHash(RadiusGround));
+    CombineHash(key, GetHash(RadiusAtmosphere));
+    CombineHash(key, MaxScatteringOrder);
+    CombineHash(key, TransmittanceDataSize);
+    CombineHash(key, IrradianceDataSize);
+    CombineHash(key, InscatterDataSize);
+    return key;
+}
+
+void loadCacheJob()
+{
+    if (File::ReadAllBytes(AtmospherePreCompute::GetCachePath(), _cacheData))
+    {
+        _cacheData.Resize(0);
+        return;
+    }
+
+    // Validate the data
+    const CacheHeader* header = (const CacheHeader*)_cacheData.Get();
+    if (_cacheData.Count() < (int32)sizeof(CacheHeader) ||
+        header->Version != ATMOSPHERE_PRECOMPUTE_CACHE_VERSION ||
+        header->Key != getCacheKey() ||
+        header->TransmittanceSize != TransmittanceDataSize ||
+        header->IrradianceSize != IrradianceDataSize ||
+        header->InscatterSize != InscatterDataSize ||
+        _cacheData.Count() != sizeof(CacheHeader) + TransmittanceDataSize + IrradianceDataSize + InscatterDataSize)
+    {
+        LOG(Info, "Atmosphere Pre Compute cache is outdated");
+        _cacheData.Resize(0);
+    }
+}
+
+bool initCacheTextures()
+{
+    if (AtmosphereTransmittance)
+        return false;
+    AtmosphereTransmittance = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Transmittance"));
+    if (AtmosphereTransmittance->Init(GPUTextureDescription::New2D(TransmittanceTexWidth, TransmittanceTexHeight, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
+        return true;
+    AtmosphereIrradiance = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Irradiance"));
+    if (AtmosphereIrradiance->Init(GPUTextureDescription::New2D(IrradianceTexWidth, IrradianceTexHeight, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
+        return true;
+    AtmosphereInscatter = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Inscatter"));
+    if (AtmosphereInscatter->Init(GPUTextureDescription::New3D(InscatterWidth, InscatterHeight, InscatterDepth, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerSliceViews)))
+        return true;
+    return false;
+}
+
+bool uploadCache()
+{
+    if (_cacheData.IsEmpty() || initCacheTextures())
+        return true;
+
+    // Upload data to the GPU (data container is kept alive until all uploads end)
+    const byte* data = _cacheData.Get() + sizeof(CacheHeader);
+    BytesContainer transmittance, irradiance, inscatter;
+    transmittance.Link(data, TransmittanceDataSize);
+    data += TransmittanceDataSize;
+    irradiance.Link(data, IrradianceDataSize);
+    data += IrradianceDataSize;
+    inscatter.Link(data, InscatterDataSize);
+    _cacheTasks[0] = AtmosphereTransmittance->UploadMipMapAsync(transmittance, 0, TransmittanceTexWidth * 8, TransmittanceDataSize);
+    _cacheTasks[1] = AtmosphereIrradiance->UploadMipMapAsync(irradiance, 0, IrradianceTexWidth * 8, IrradianceDataSize);
+    _cacheTasks[2] = AtmosphereInscatter->UploadMipMapAsync(inscatter, 0, InscatterWidth * 8, InscatterWidth * InscatterHeight * 8);
+    for (Task* task : _cacheTasks)
+    {
+        if (task)
+            task->Start();
+    }
+    return false;
+}
+
 bool init()
 {
     if (_isReadyForCompute)
@@ -185,6 +341,9 @@ bool init()
     _psInscatterS = GPUDevice::Instance->CreatePipelineState();
     _psInscatterN = GPUDevice::Instance->CreatePipelineState();
     _psCopyInscatterNAdd = GPUDevice::Instance->CreatePipelineState();
+#if USE_EDITOR
+    _psReadInscatter = GPUDevice::Instance->CreatePipelineState();
+#endif
     GPUPipelineState::Description psDesc, psDescLayers;
     psDesc = GPUPipelineState::Description::DefaultFullscreenTriangle;
     psDescLayers = psDesc;
@@ -234,6 +393,13 @@ bool init()
         if (_psInscatterN->Init(psDescLayers))
             return true;
     }
+#if USE_EDITOR
+    {
+        psDesc.PS = shader->GetPS("PS_ReadInscatter");
+        if (_psReadInscatter->Init(psDesc))
+            return true;
+    }
+#endif
     psDescLayers.BlendMode = BlendingMode::Add;
     psDesc.BlendMode = BlendingMode::Add;
     {
@@ -254,18 +420,11 @@ bool init()
     _task->Render.Bind(onRender);
 
     // Init render targets
-    AtmosphereTransmittance = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Transmittance"));
-    if (AtmosphereTransmittance->Init(GPUTextureDescription::New2D(TransmittanceTexWidth, TransmittanceTexHeight, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
-        return true;
-    AtmosphereIrradiance = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Irradiance"));
-    if (AtmosphereIrradiance->Init(GPUTextureDescription::New2D(IrradianceTexWidth, IrradianceTexHeight, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
+    if (initCacheTextures())
         return true;
     AtmosphereDeltaE = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.DeltaE"));
     if (AtmosphereDeltaE->Init(GPUTextureDescription::New2D(IrradianceTexWidth, IrradianceTexHeight, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
         return true;
-    AtmosphereInscatter = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.Inscatter"));
-    if (AtmosphereInscatter->Init(GPUTextureDescription::New3D(InscatterWidth, InscatterHeight, InscatterDepth, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerSliceViews)))
-        return true;
     AtmosphereDeltaSR = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.DeltaSR"));
     if (AtmosphereDeltaSR->Init(GPUTextureDescription::New3D(InscatterWidth, InscatterHeight, InscatterDepth, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerSliceViews)))
         return true;
@@ -275,6 +434,12 @@ bool init()
     AtmosphereDeltaJ = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.DeltaJ"));
     if (AtmosphereDeltaJ->Init(GPUTextureDescription::New3D(InscatterWidth, InscatterHeight, InscatterDepth, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerSliceViews)))
         return true;
+#if USE_EDITOR
+    // Volume textures cannot be downloaded so inscatter slices are copied into a single 2D texture for the cache
+    AtmosphereInscatterReadback = GPUDevice::Instance->CreateTexture(TEXT("AtmospherePreCompute.InscatterReadback"));
+    if (AtmosphereInscatterReadback->Init(GPUTextureDescription::New2D(InscatterWidth, InscatterHeight * InscatterDepth, PixelFormat::R16G16B16A16_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget)))
+        return true;
+#endif
 
     // Mark as ready
     _isReadyForCompute = true;
@@ -294,7 +459,7 @@ void release()
 
     LOG(Info, "Disposing Atmosphere Pre Compute service");
 
-    // Release data
+    // Release data used only during precompute (result textures are kept)
     SAFE_DELETE_GPU_RESOURCE(_psTransmittance);
     SAFE_DELETE_GPU_RESOURCE(_psIrradiance1);
     SAFE_DELETE_GPU_RESOURCE(_psIrradianceN);
@@ -306,50 +471,70 @@ void release()
     SAFE_DELETE_GPU_RESOURCE(_psInscatterS);
     SAFE_DELETE_GPU_RESOURCE(_psInscatterN);
     SAFE_DELETE_GPU_RESOURCE(_psCopyInscatterNAdd);
+    SAFE_DELETE_GPU_RESOURCE(_psReadInscatter);
     _shader = nullptr;
     SAFE_DELETE(_task);
-    SAFE_DELETE_GPU_RESOURCE(AtmosphereTransmittance);
-    SAFE_DELETE_GPU_RESOURCE(AtmosphereIrradiance);
-    SAFE_DELETE_GPU_RESOURCE(AtmosphereInscatter);
     SAFE_DELETE_GPU_RESOURCE(AtmosphereDeltaE);
     SAFE_DELETE_GPU_RESOURCE(AtmosphereDeltaSR);
     SAFE_DELETE_GPU_RESOURCE(AtmosphereDeltaSM);
     SAFE_DELETE_GPU_RESOURCE(AtmosphereDeltaJ);
+    SAFE_DELETE_GPU_RESOURCE(AtmosphereInscatterReadback);
 
     _isReadyForCompute = false;
 }
 
 void AtmospherePreComputeService::Update()
 {
-    // Calculate time delta since last update
-    auto currentTime = Time::Update.UnscaledTime;
-
-    // Check if render job is done
-    if (isUpdateSynced())
+    bool failed;
+    switch (_state)
     {
-        // Create async job to gather data from the GPU
-        //ThreadPool::AddJob(New<DownloadJob>(AtmosphereTransmittance, AtmosphereIrradiance, AtmosphereInscatter));
-
-        // TODO: download data from generated cache textures
-        // TODO: serialize cached textures
+    case States::Idle:
+        if (!_isUpdatePending)
+            break;
 
-        // Clear flags
-        _updateFrameNumber = 0;
+        // Try to use data cached by the previous run (or deployed with the cooked game) to skip the precompute
+        if (FileSystem::FileExists(AtmospherePreCompute::GetCachePath()))
+        {
+            Function<void()> action;
+            action.Bind<&loadCacheJob>();
+            _cacheTasks[0] = Task::StartNew(action);
+            _state = States::LoadingCache;
+        }
+        else
+        {
+            _state = States::LoadingShader;
+        }
+        break;
+    case States::LoadingCache:
+        if (!areCacheTasksEnded(failed))
+            break;
+        if (failed || uploadCache())
+        {
+            _cacheData.Resize(0);
+            _state = States::LoadingShader;
+            break;
+        }
+        _state = States::UploadingCache;
+        break;
+    case States::UploadingCache:
+        if (!areCacheTasksEnded(failed))
+            break;
+        _cacheData.Resize(0);
+        if (failed)
+        {
+            _state = States::LoadingShader;
+            break;
+        }
+        _hasDataCached = true;
         _isUpdatePending = false;
-
-        // Release service
-        //release();
-        // TODO: release service data
-    }
-    else if (_isUpdatePending && (_task == nullptr || !_task->Enabled))
-    {
-        // TODO: init but without a stalls, just wait for resources loaded and then start rendering
-
-        // Init service
+        _state = States::Done;
+        break;
+    case States::LoadingShader:
+        // Wait for the shader to be loaded without stalling the main thread, then start rendering
         if (!_shader)
             _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/AtmospherePreCompute"));
         if (_shader && !_shader->IsLoaded())
-            return;
+            break;
         if (init())
         {
             LOG(Fatal, "Cannot setup Atmosphere Pre Compute!");
@@ -357,13 +542,51 @@ void AtmospherePreComputeService::Update()
 
         // Mark task to update
         _task->Enabled = true;
+        _computeStep = 0;
         _updateFrameNumber = 0;
+        _state = States::Computing;
+        break;
+    case States::Computing:
+        // Check if render job is done
+        if (!isUpdateSynced())
+            break;
+        _updateFrameNumber = 0;
+        _isUpdatePending = false;
+#if USE_EDITOR
+        // Create async job to gather data from the GPU and save it to the cache
+        _cacheTasks[0] = Task::StartNew(New<DownloadJob>(AtmosphereTransmittance, AtmosphereIrradiance, AtmosphereInscatterReadback));
+        _state = States::SavingCache;
+#else
+        release();
+        _state = States::Done;
+#endif
+        break;
+    case States::SavingCache:
+        if (!areCacheTasksEnded(failed))
+            break;
+        release();
+        _state = States::Done;
+        break;
+    default:
+        break;
     }
 }
 
 void AtmospherePreComputeService::Dispose()
 {
+    for (Task*& task : _cacheTasks)
+    {
+        if (task)
+            task->Cancel();
+        task = nullptr;
+    }
+    _cacheData.Resize(0);
     release();
+    SAFE_DELETE_GPU_RESOURCE(AtmosphereTransmittance);
+    SAFE_DELETE_GPU_RESOURCE(AtmosphereIrradiance);
+    SAFE_DELETE_GPU_RESOURCE(AtmosphereInscatter);
+    _hasDataCached = false;
+    _state = States::Idle;
 }
 
 void GetLayerValue(int32 layer, float& atmosphereR, Float4& dhdh)
@@ -379,20 +602,8 @@ void GetLayerValue(int32 layer, float& atmosphereR, Float4& dhdh)
     dhdh = Float4(dMin, dMax, dMinP, dMaxP);
 }
 
-void AtmospherePreComputeImpl::onRender(RenderTask* task, GPUContext* context)
+void renderSingleScattering(GPUContext* context, GPUConstantBuffer* cb, Data& data)
 {
-    // If job has been cancelled (eg. on window close)
-    if (_wasCancelled)
-    {
-        LOG(Warning, "AtmospherePreCompute job cancelled");
-        return;
-    }
-    ASSERT(_isUpdatePending && _updateFrameNumber == 0);
-
-    const auto shader = _shader->GetShader();
-    const auto cb = shader->GetCB(0);
-    Data data;
-
     // Compute transmittance texture T (line 1 in algorithm 4.1)
     context->SetRenderTarget(*AtmosphereTransmittance);
     context->SetViewportAndScissors((float)TransmittanceTexWidth, (float)TransmittanceTexHeight);
@@ -480,91 +691,138 @@ void AtmospherePreComputeImpl::onRender(RenderTask* task, GPUContext* context)
         context->DrawFullscreenTriangle();
     }
     context->ResetRenderTarget();
+}
 
-    // Loop for each scattering order (line 6 in algorithm 4.1)
-    for (int32 order = 2; order <= MaxScatteringOrder; order++)
-    {
-        // Compute deltaJ (line 7 in algorithm 4.1)
-        context->UnBindSR(6);
-        context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
-        context->SetState(_psInscatterS);
-        data.First = order == 2 ? 1.0f : 0.0f;
-        context->BindSR(0, AtmosphereTransmittance);
-        context->BindSR(3, AtmosphereDeltaE);
-        context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
-        context->BindSR(5, AtmosphereDeltaSM->ViewVolume());
-        for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
-        {
-            GetLayerValue(layer, data.AtmosphereR, data.dhdh);
-            data.AtmosphereLayer = layer;
-            context->UpdateCB(cb, &data);
-            context->BindCB(0, cb);
+void renderScatteringOrder(GPUContext* context, GPUConstantBuffer* cb, Data& data, int32 order)
+{
+    // Compute deltaJ (line 7 in algorithm 4.1)
+    context->UnBindSR(6);
+    context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
+    context->SetState(_psInscatterS);
+    data.First = order == 2 ? 1.0f : 0.0f;
+    context->BindSR(0, AtmosphereTransmittance);
+    context->BindSR(3, AtmosphereDeltaE);
+    context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
+    context->BindSR(5, AtmosphereDeltaSM->ViewVolume());
+    for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
+    {
+        GetLayerValue(layer, data.AtmosphereR, data.dhdh);
+        data.AtmosphereLayer = layer;
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
 
-            context->SetRenderTarget(AtmosphereDeltaJ->View(layer));
-            context->DrawFullscreenTriangle();
-        }
+        context->SetRenderTarget(AtmosphereDeltaJ->View(layer));
+        context->DrawFullscreenTriangle();
+    }
+
+    // Compute deltaE (line 8 in algorithm 4.1)
+    context->UnBindSR(3);
+    context->SetRenderTarget(AtmosphereDeltaE->View());
+    context->SetViewportAndScissors((float)IrradianceTexWidth, (float)IrradianceTexHeight);
+    context->BindSR(0, AtmosphereTransmittance);
+    context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
+    context->BindSR(5, AtmosphereDeltaSM->ViewVolume());
+    context->SetState(_psIrradianceN);
+    context->DrawFullscreenTriangle();
+
+    // Compute deltaS (line 9 in algorithm 4.1)
+    context->UnBindSR(4);
+    context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
+    context->SetState(_psInscatterN);
+    context->BindSR(0, AtmosphereTransmittance);
+    context->BindSR(6, AtmosphereDeltaJ->ViewVolume());
+    for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
+    {
+        GetLayerValue(layer, data.AtmosphereR, data.dhdh);
+        data.AtmosphereLayer = layer;
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
 
-        // Compute deltaE (line 8 in algorithm 4.1)
-        context->UnBindSR(3);
-        context->SetRenderTarget(AtmosphereDeltaE->View());
-        context->SetViewportAndScissors((float)IrradianceTexWidth, (float)IrradianceTexHeight);
-        context->BindSR(0, AtmosphereTransmittance);
-        context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
-        context->BindSR(5, AtmosphereDeltaSM->ViewVolume());
-        context->SetState(_psIrradianceN);
+        context->SetRenderTarget(AtmosphereDeltaSR->View(layer));
         context->DrawFullscreenTriangle();
+    }
 
-        // Compute deltaS (line 9 in algorithm 4.1)
-        context->UnBindSR(4);
-        context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
-        context->SetState(_psInscatterN);
-        context->BindSR(0, AtmosphereTransmittance);
-        context->BindSR(6, AtmosphereDeltaJ->ViewVolume());
-        for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
-        {
-            GetLayerValue(layer, data.AtmosphereR, data.dhdh);
-            data.AtmosphereLayer = layer;
-            context->UpdateCB(cb, &data);
-            context->BindCB(0, cb);
+    // Add deltaE into irradiance texture E (line 10 in algorithm 4.1)
+    context->SetRenderTarget(*AtmosphereIrradiance);
+    context->SetViewportAndScissors((float)IrradianceTexWidth, (float)IrradianceTexHeight);
+    context->BindSR(3, AtmosphereDeltaE);
+    context->SetState(_psCopyIrradianceAdd);
+    context->DrawFullscreenTriangle();
 
-            context->SetRenderTarget(AtmosphereDeltaSR->View(layer));
-            context->DrawFullscreenTriangle();
-        }
+    // Add deltaS into inscatter texture S (line 11 in algorithm 4.1)
+    context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
+    context->SetState(_psCopyInscatterNAdd);
+    context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
+    for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
+    {
+        GetLayerValue(layer, data.AtmosphereR, data.dhdh);
+        data.AtmosphereLayer = layer;
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
 
-        // Add deltaE into irradiance texture E (line 10 in algorithm 4.1)
-        context->SetRenderTarget(*AtmosphereIrradiance);
-        context->SetViewportAndScissors((float)IrradianceTexWidth, (float)IrradianceTexHeight);
-        context->BindSR(3, AtmosphereDeltaE);
-        context->SetState(_psCopyIrradianceAdd);
+        context->SetRenderTarget(AtmosphereInscatter->View(layer));
         context->DrawFullscreenTriangle();
+    }
+}
 
-        // Add deltaS into inscatter texture S (line 11 in algorithm 4.1)
-        context->SetViewportAndScissors((float)InscatterWidth, (float)InscatterHeight);
-        context->SetState(_psCopyInscatterNAdd);
-        context->BindSR(4, AtmosphereDeltaSR->ViewVolume());
+void AtmospherePreComputeImpl::onRender(RenderTask* task, GPUContext* context)
+{
+    // If job has been cancelled (eg. on window close)
+    if (_wasCancelled)
+    {
+        LOG(Warning, "AtmospherePreCompute job cancelled");
+        return;
+    }
+    ASSERT(_isUpdatePending && _updateFrameNumber == 0);
+
+    const auto shader = _shader->GetShader();
+    const auto cb = shader->GetCB(0);
+    Data data;
+
+    // Precompute is split into a few steps (one per frame) to reduce the GPU stall
+    if (_computeStep == 0)
+    {
+        renderSingleScattering(context, cb, data);
+    }
+    else if (_computeStep < MaxScatteringOrder)
+    {
+        // Each scattering order (line 6 in algorithm 4.1)
+        renderScatteringOrder(context, cb, data, _computeStep + 1);
+    }
+#if USE_EDITOR
+    else
+    {
+        // Copy inscatter slices into a 2D texture for the data download
+        context->SetState(_psReadInscatter);
+        context->BindSR(4, AtmosphereInscatter->ViewVolume());
+        context->SetRenderTarget(AtmosphereInscatterReadback->View());
         for (int32 layer = 0; layer < InscatterAltitudeSampleNum; layer++)
         {
-            GetLayerValue(layer, data.AtmosphereR, data.dhdh);
             data.AtmosphereLayer = layer;
             context->UpdateCB(cb, &data);
             context->BindCB(0, cb);
 
-            context->SetRenderTarget(AtmosphereInscatter->View(layer));
+            context->SetViewportAndScissors(Viewport(0.0f, (float)(layer * InscatterHeight), (float)InscatterWidth, (float)InscatterHeight));
             context->DrawFullscreenTriangle();
         }
     }
+#endif
 
     // Cleanup
     context->ResetRenderTarget();
     context->ResetSR();
+    _computeStep++;
+    if (_computeStep < ComputeStepsCount)
+        return;
 
     // Mark as rendered
     _hasDataCached = true;
-    _isUpdatePending = false;
     _updateFrameNumber = Engine::FrameCount;
     _task->Enabled = false;
 }
 
+#if USE_EDITOR
+
 DownloadJob::DownloadJob(GPUTexture* transmittance, GPUTexture* irradiance, GPUTexture* inscatter)
     : _transmittance(transmittance)
     , _irradiance(irradiance)
@@ -572,123 +830,56 @@ DownloadJob::DownloadJob(GPUTexture* transmittance, GPUTexture* irradiance, GPUT
 {
 }
 
-bool DownloadJob::Run()
+bool DownloadJob::HasReference(Object* resource) const
 {
-    TextureData textureData;
-    Array<byte> data;
-
-#if BUILD_DEBUG
-
-    // Transmittance
-    /*{
-        if (_transmittance->DownloadData(textureData))
-        {
-            LOG(Fatal, 193, "AtmospherePreCompute::DownloadJob::Transmittance");
-            return;
-        }
-
-        auto in = textureData.Get(0, 0);
-        int rowPich = 3 * TransmittanceTexWidth * sizeof(BYTE);
-        int size = rowPich * TransmittanceTexHeight;
-        data.EnsureCapacity(size, false);
-        byte* p = data.Get();
-        for (int y = 0; y < TransmittanceTexHeight; y++)
-        {
-            for (int x = 0; x < TransmittanceTexWidth; x++)
-            {
-                Float4 t = ((Half4*)&in->Data[y * in->RowPitch + x * sizeof(Half4)])->ToFloat4();
-                *p++ = Math::Saturate(t.Z) * 255;
-                *p++ = Math::Saturate(t.Y) * 255;
-                *p++ = Math::Saturate(t.X) * 255;
-            }
-        }
-
-        FileSystem::SaveBitmapToFile(data.Get(),
-                                     TransmittanceTexWidth,
-                                     TransmittanceTexHeight,
-                                     24,
-                                     0,
-                                     L"C:\\Users\\Wojtek\\Downloads\\transmittance_Flax.bmp");
-    }*/
-
-    // Irradiance
-    /*{
-        textureData.Clear();
-        if (_irradiance->DownloadData(textureData))
-        {
-            LOG(Fatal, 193, "AtmospherePreCompute::DownloadJob::Irradiance");
-            return;
-        }
-
-        auto in = textureData.Get(0, 0);
-        int rowPich = 3 * IrradianceTexWidth * sizeof(BYTE);
-        int size = rowPich * IrradianceTexHeight;
-        data.EnsureCapacity(size, false);
-        byte* p = data.Get();
-        for (int y = 0; y < IrradianceTexHeight; y++)
-        {
-            for (int x = 0; x < IrradianceTexWidth; x++)
-            {
-                Float4 t = ((Half4*)&in->Data[y * in->RowPitch + x * sizeof(Half4)])->ToFloat4();
-                *p++ = Math::Saturate(t.Z) * 255;
-                *p++ = Math::Saturate(t.Y) * 255;
-                *p++ = Math::Saturate(t.X) * 255;
-            }
-        }
-
-        FileSystem::SaveBitmapToFile(data.Get(),
-                                     IrradianceTexWidth,
-                                     IrradianceTexHeight,
-                                     24,
-                                     0,
-                                     L"C:\\Users\\Wojtek\\Downloads\\irradiance_Flax.bmp");
-    }*/
+    return _transmittance == resource || _irradiance == resource || _inscatter == resource;
+}
 
-    /*// Inscatter
+bool DownloadJob::Run()
+{
+    // Download the precomputed data from the GPU
+    TextureData transmittance, irradiance, inscatter;
+    if (_transmittance->DownloadData(transmittance) ||
+        _irradiance->DownloadData(irradiance) ||
+        _inscatter->DownloadData(inscatter))
     {
-        textureData.Clear();
-        if (_inscatter->DownloadData(textureData))
-        {
-            LOG(Fatal, 193, "AtmospherePreCompute::DownloadJob::Inscatter");
-            return;
-        }
-        auto in = textureData.Get(0, 0);
-        int rowPich = 3 * InscatterWidth * sizeof(BYTE);
-        int size = rowPich * InscatterHeight;
-        data.EnsureCapacity(size, false);
-
-        for (int32 depthSlice = 0; depthSlice < InscatterDepth; depthSlice++)
-        {
-            byte* p = data.Get();
-            byte* s = in->Data.Get() + depthSlice * in->DepthPitch;
-
-            for (int y = 0; y < InscatterHeight; y++)
-            {
-                for (int x = 0; x < InscatterWidth; x++)
-                {
-                    Float4 t = ((Half4*)&s[y * in->RowPitch + x * sizeof(Half4)])->ToFloat4();
-                    *p++ = Math::Saturate(t.Z) * 255;
-                    *p++ = Math::Saturate(t.Y) * 255;
-                    *p++ = Math::Saturate(t.X) * 255;
-                }
-            }
-
-            FileSystem::SaveBitmapToFile(data.Get(),
-                                         InscatterWidth,
-                                         InscatterHeight,
-                                         24,
-                                         0,
-                                         *String::Format(TEXT("C:\\Users\\Wojtek\\Downloads\\inscatter_{0}_Flax.bmp"), depthSlice));
-
-            break;
-        }
-    }*/
-
-#else
-
-    MISSING_CODE("download precomputed atmosphere data from the GPU!");
-
-#endif
+        LOG(Warning, "Failed to download Atmosphere Pre Compute data");
+        return true;
+    }
+    const auto& transmittanceData = transmittance.GetData(0, 0)->Data;
+    const auto& irradianceData = irradiance.GetData(0, 0)->Data;
+    const auto& inscatterData = inscatter.GetData(0, 0)->Data;
+    if (transmittanceData.Length() != TransmittanceDataSize ||
+        irradianceData.Length() != IrradianceDataSize ||
+        inscatterData.Length() != InscatterDataSize)
+    {
+        LOG(Warning, "Invalid Atmosphere Pre Compute data size");
+        return true;
+    }
 
+    // Save the cache (inscatter slices are laid out one after another the same as in the volume texture)
+    CacheHeader header;
+    header.Version = ATMOSPHERE_PRECOMPUTE_CACHE_VERSION;
+    header.Key = getCacheKey();
+    header.TransmittanceSize = TransmittanceDataSize;
+    header.IrradianceSize = IrradianceDataSize;
+    header.InscatterSize = InscatterDataSize;
+    Array<byte> data;
+    data.Resize(sizeof(CacheHeader) + TransmittanceDataSize + IrradianceDataSize + InscatterDataSize);
+    byte* ptr = data.Get();
+    Platform::MemoryCopy(ptr, &header, sizeof(CacheHeader));
+    ptr += sizeof(CacheHeader);
+    Platform::MemoryCopy(ptr, transmittanceData.Get(), TransmittanceDataSize);
+    ptr += TransmittanceDataSize;
+    Platform::MemoryCopy(ptr, irradianceData.Get(), IrradianceDataSize);
+    ptr += IrradianceDataSize;
+    Platform::MemoryCopy(ptr, inscatterData.Get(), InscatterDataSize);
+    if (File::WriteAllBytes(AtmospherePreCompute::GetCachePath(), data))
+    {
+        LOG(Warning, "Failed to save Atmosphere Pre Compute cache");
+        return true;
+    }
     return false;
 }
+
+#endif
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "FlaxEngine.Gen.h"
+#include "Engine/Core/Types/String.h"
 
 class GPUTexture;
 
@@ -29,4 +30,10 @@ class FLAXENGINE_API AtmospherePreCompute
     /// <param name="cache">Result cache</param>
     /// <returns>True if context is ready for usage.</returns>
     static bool GetCache(AtmosphereCache* cache);
+
+    /// <summary>
+    /// Gets the path of the file with the cached precomputed data (saved by the Editor and deployed with the cooked game).
+    /// </summary>
+    /// <returns>The cache file path.</returns>
+    static String GetCachePath();
 };
@@ -86,6 +86,16 @@ PACK_STRUCT(struct LightData {
     float RadiusInv;
     });
 
+/// <summary>
+/// Structure that contains information about local lights clusters for shaders.
+/// </summary>
+PACK_STRUCT(struct LightClustersData {
+    float DepthScale;
+    float DepthBias;
+    uint32 LightsCount;
+    uint32 DeferredLightsCount;
+    });
+
 /// <summary>
 /// Structure that contains information about light for shaders.
 /// </summary>
@@ -9,6 +9,7 @@
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderTargetPool.h"
 #include "Engine/Graphics/RenderBuffers.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -63,6 +64,7 @@ bool DepthOfFieldPass::Init()
     {
         _psDofDepthBlurGeneration = GPUDevice::Instance->CreatePipelineState();
         _psDoNotGenerateBokeh = GPUDevice::Instance->CreatePipelineState();
+        _psDofComposite = GPUDevice::Instance->CreatePipelineState();
         if (_platformSupportsBokeh)
         {
             _psBokehGeneration = GPUDevice::Instance->CreatePipelineState();
@@ -96,6 +98,7 @@ void DepthOfFieldPass::Dispose()
     SAFE_DELETE_GPU_RESOURCE(_psDoNotGenerateBokeh);
     SAFE_DELETE_GPU_RESOURCE(_psBokeh);
     SAFE_DELETE_GPU_RESOURCE(_psBokehComposite);
+    SAFE_DELETE_GPU_RESOURCE(_psDofComposite);
     _shader = nullptr;
     _defaultBokehHexagon = nullptr;
     _defaultBokehOctagon = nullptr;
@@ -137,6 +140,12 @@ bool DepthOfFieldPass::setupResources()
         if (_psDoNotGenerateBokeh->Init(psDesc))
             return true;
     }
+    if (!_psDofComposite->IsValid())
+    {
+        psDesc.PS = shader->GetPS("PS_DofComposite");
+        if (_psDofComposite->Init(psDesc))
+            return true;
+    }
     if (_platformSupportsBokeh)
     {
         if (!_psBokehGeneration->IsValid())
@@ -216,21 +225,25 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
 
     context->ResetSR();
 
-    // Resolution settings
-    // TODO: render depth of field in 1/4 resolution?
-    const int32 cocResolutionDivider = 1;
-    const int32 dofResolutionDivider = 1;
-    const int32 bokehResolutionDivider = 1;
-    // TODO: in low-res DoF maybe use shared HalfResDepth?
+    // Resolution settings (lower quality renders the effect in half or quarter resolution and upscales it when compositing with the full-resolution frame)
     const int32 w1 = frame->Width();
     const int32 h1 = frame->Height();
-    const int32 cocWidth = w1 / cocResolutionDivider;
-    const int32 cocHeight = h1 / cocResolutionDivider;
-    const int32 dofWidth = w1 / dofResolutionDivider;
-    const int32 dofHeight = h1 / dofResolutionDivider;
-    const int32 bokehTargetWidth = w1 / bokehResolutionDivider;
-    const int32 bokehTargetHeight = h1 / bokehResolutionDivider;
-    float textureSizeScale = (float)Math::Max(w1, h1) * (1.0f / 1920.0f); // Keep DOF blur the same no matter the image resolution is (reference FullHD res)
+    int32 resolutionDivider = 1;
+    if (Graphics::DepthOfFieldQuality == Quality::Low)
+        resolutionDivider = 4;
+    else if (Graphics::DepthOfFieldQuality == Quality::Medium)
+        resolutionDivider = 2;
+    while (resolutionDivider > 1 && (w1 < resolutionDivider * 8 || h1 < resolutionDivider * 8))
+        resolutionDivider /= 2;
+    const bool lowRes = resolutionDivider > 1;
+    GPUTexture* depthSource = lowRes ? renderContext.Buffers->RequestHalfResDepth(context) : depthBuffer; // Low-res effect uses the half-res depth shared with other passes
+    const int32 cocWidth = w1 / resolutionDivider;
+    const int32 cocHeight = h1 / resolutionDivider;
+    const int32 dofWidth = cocWidth;
+    const int32 dofHeight = cocHeight;
+    const int32 bokehTargetWidth = dofWidth;
+    const int32 bokehTargetHeight = dofHeight;
+    float textureSizeScale = (float)Math::Max(dofWidth, dofHeight) * (1.0f / 1920.0f); // Keep DOF blur the same no matter the image resolution is (reference FullHD res)
     int32 blurScalePermutationOffset = 0;
     const float sampleRadius[] = { 1.0f, 3.6f }; // This has to match CS_DepthOfField permutations
     if (textureSizeScale > sampleRadius[0])
@@ -258,7 +271,7 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
         cbData.DOFDepths.Y = nearFocusEnd;
         cbData.DOFDepths.Z = farFocusStart;
         cbData.DOFDepths.W = farFocusEnd;
-        cbData.MaxBokehSize = dofSettings.BokehSize;
+        cbData.MaxBokehSize = dofSettings.BokehSize / (float)resolutionDivider;
         cbData.BokehBrightnessThreshold = dofSettings.BokehBrightnessThreshold;
         cbData.BokehBlurThreshold = dofSettings.BokehBlurThreshold;
         cbData.BokehFalloff = dofSettings.BokehFalloff;
@@ -289,14 +302,23 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
     RENDER_TARGET_POOL_SET_NAME(depthBlurTarget, "DOF.Blur");
     context->SetViewportAndScissors((float)cocWidth, (float)cocHeight);
     context->SetRenderTarget(*depthBlurTarget);
-    context->BindSR(0, depthBuffer);
+    context->BindSR(0, depthSource);
     context->SetState(_psDofDepthBlurGeneration);
     context->DrawFullscreenTriangle();
     context->ResetRenderTarget();
 
-    // Peek temporary render target for dof pass
+    // Peek temporary render targets for dof pass (full-res effect reuses the input frame and temporary frame)
     auto dofFormat = renderContext.Buffers->GetOutputFormat();
-    tempDesc = GPUTextureDescription::New2D(dofWidth, dofHeight, dofFormat);
+    GPUTexture* dofTarget0 = tmp;
+    GPUTexture* dofTarget1 = frame;
+    if (lowRes)
+    {
+        tempDesc = GPUTextureDescription::New2D(dofWidth, dofHeight, dofFormat, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::UnorderedAccess);
+        dofTarget0 = RenderTargetPool::Get(tempDesc);
+        RENDER_TARGET_POOL_SET_NAME(dofTarget0, "DOF.Target0");
+        dofTarget1 = RenderTargetPool::Get(tempDesc);
+        RENDER_TARGET_POOL_SET_NAME(dofTarget1, "DOF.Target1");
+    }
 
     // Do the bokeh point generation, or just do a copy if disabled
     bool isBokehGenerationEnabled = dofSettings.BokehEnabled && _platformSupportsBokeh && dofSettings.BokehBrightness > 0.0f && dofSettings.BokehSize > 0.0f;
@@ -325,7 +347,7 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
         context->BindSR(0, frame);
         context->BindSR(1, depthBlurTarget);
         context->BindUA(1, _bokehBuffer->View());
-        context->SetRenderTarget(*tmp);
+        context->SetRenderTarget(*dofTarget0);
         context->SetViewportAndScissors((float)dofWidth, (float)dofHeight);
         context->SetState(_psBokehGeneration);
         context->DrawFullscreenTriangle();
@@ -335,24 +357,23 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
         // Generate bokeh points
         context->BindSR(0, frame);
         context->BindSR(1, depthBlurTarget);
-        context->SetRenderTarget(*tmp);
+        context->SetRenderTarget(*dofTarget0);
         context->SetViewportAndScissors((float)dofWidth, (float)dofHeight);
         context->SetState(_psDoNotGenerateBokeh);
         context->DrawFullscreenTriangle();
     }
-    Swap(frame, tmp);
 
-    // Do depth of field (using compute shaders in full resolution)
+    // Do depth of field (using compute shaders)
     context->ResetRenderTarget();
     context->ResetSR();
     context->ResetUA();
     context->FlushState();
     {
         // Horizontal pass
-        context->BindSR(0, frame);
+        context->BindSR(0, dofTarget0);
         context->BindSR(1, depthBlurTarget);
         //
-        context->BindUA(0, tmp->View());
+        context->BindUA(0, dofTarget1->View());
         //
         uint32 groupCountX = (dofWidth / DOF_GRID_SIZE) + ((dofWidth % DOF_GRID_SIZE) > 0 ? 1 : 0);
         uint32 groupCountY = dofHeight;
@@ -365,9 +386,9 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
         context->ResetSR();
 
         // Vertical pass
-        context->BindUA(0, frame->View());
+        context->BindUA(0, dofTarget0->View());
         //
-        context->BindSR(0, tmp);
+        context->BindSR(0, dofTarget1);
         context->BindSR(1, depthBlurTarget);
         //
         groupCountX = dofWidth;
@@ -383,6 +404,7 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
     }
 
     // Render the bokeh points
+    GPUTexture* dofResult = dofTarget0;
     if (isBokehGenerationEnabled)
     {
         tempDesc = GPUTextureDescription::New2D(bokehTargetWidth, bokehTargetHeight, dofFormat);
@@ -410,14 +432,37 @@ void DepthOfFieldPass::Render(RenderContext& renderContext, GPUTexture*& frame,
 
         // Composite the bokeh rendering results with the depth of field result
         context->BindSR(0, bokehTarget);
-        context->BindSR(1, frame);
-        context->SetRenderTarget(*tmp);
+        context->BindSR(1, dofTarget0);
+        context->SetRenderTarget(*dofTarget1);
         context->SetViewportAndScissors((float)dofWidth, (float)dofHeight);
         context->SetState(_psBokehComposite);
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
 
         RenderTargetPool::Release(bokehTarget);
+        dofResult = dofTarget1;
+    }
+
+    if (lowRes)
+    {
+        // Upscale the depth of field and composite it with the full-resolution frame
+        context->ResetSR();
+        context->BindSR(0, frame);
+        context->BindSR(1, dofResult);
+        context->BindSR(2, depthBlurTarget);
+        context->SetRenderTarget(*tmp);
+        context->SetViewportAndScissors((float)w1, (float)h1);
+        context->SetState(_psDofComposite);
+        context->DrawFullscreenTriangle();
+        context->ResetRenderTarget();
+        context->ResetSR();
+        Swap(frame, tmp);
+
+        RenderTargetPool::Release(dofTarget0);
+        RenderTargetPool::Release(dofTarget1);
+    }
+    else if (dofResult == tmp)
+    {
         Swap(frame, tmp);
     }
 
@@ -29,6 +29,7 @@ class DepthOfFieldPass : public RendererPass<DepthOfFieldPass>
     GPUPipelineState* _psDoNotGenerateBokeh = nullptr;
     GPUPipelineState* _psBokeh = nullptr;
     GPUPipelineState* _psBokehComposite = nullptr;
+    GPUPipelineState* _psDofComposite = nullptr;
     AssetReference<Texture> _defaultBokehHexagon;
     AssetReference<Texture> _defaultBokehOctagon;
     AssetReference<Texture> _defaultBokehCircle;
@@ -55,6 +56,7 @@ class DepthOfFieldPass : public RendererPass<DepthOfFieldPass>
         _psBokehGeneration->ReleaseGPU();
         _psBokeh->ReleaseGPU();
         _psBokehComposite->ReleaseGPU();
+        _psDofComposite->ReleaseGPU();
         invalidateResources();
     }
 #endif
@@ -205,6 +205,7 @@ struct DrawCall
             float ChunkSizeNextLOD;
             float TerrainChunkSizeLOD0;
             const class TerrainPatch* Patch;
+            Float4 VirtualTextureUVScaleBias; // xy-scale, zw-offset for chunk UVs into the baked virtual texture page UVs (zero if not used)
         } Terrain;
 
         struct
@@ -18,6 +18,7 @@
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Renderer/Lightmaps.h"
+#include "Engine/Renderer/GBufferPass.h"
 
 const MaterialInfo& MaterialComplexityMaterialShader::WrapperShader::GetInfo() const
 {
@@ -131,6 +132,7 @@ void MaterialComplexityMaterialShader::Draw(RenderContext& renderContext, GPUCon
         bindParams.BindViewData();
         drawCall.WorldDeterminantSign = 1.0f;
         context->SetRenderTarget(lightBuffer);
+        GBufferPass::Instance()->SetupDecalsInstances(renderContext, context);
         for (int32 i = 0; i < decals.Count(); i++)
         {
             const auto decal = decals[i];
@@ -142,7 +144,7 @@ void MaterialComplexityMaterialShader::Draw(RenderContext& renderContext, GPUCon
             drawCall.Material = decal->Material;
             drawCall.PerInstanceRandom = decal->GetPerInstanceRandom();
             decalsWrapper.Bind(bindParams);
-            boxModel->Render(context);
+            GBufferPass::Instance()->DrawDecalsInstances(context, i, 1);
         }
         context->ResetSR();
     }
@@ -2,12 +2,14 @@
 
 #include "ForwardPass.h"
 #include "RenderList.h"
+#include "VariableRateShadingPass.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderBuffers.h"
 #include "Engine/Graphics/RenderTargetPool.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -101,12 +103,19 @@ void ForwardPass::Render(RenderContext& renderContext, GPUTexture* input, GPUTex
     {
         PROFILE_GPU_CPU("Distortion");
 
-        // Peek temporary render target for the distortion pass
-        // TODO: render distortion in half-res?
+        // Peek temporary render target for the distortion pass (in half-res on lower quality, depth-tested against the shared half-res depth)
         const int32 width = renderContext.Buffers->GetWidth();
         const int32 height = renderContext.Buffers->GetHeight();
-        const int32 distortionWidth = width;
-        const int32 distortionHeight = height;
+        const bool halfRes = Graphics::DistortionQuality <= Quality::Medium && width >= 2 && height >= 2;
+        GPUTextureView* distortionDepthHandle = depthBufferHandle;
+        int32 distortionWidth = width;
+        int32 distortionHeight = height;
+        if (halfRes)
+        {
+            distortionDepthHandle = renderContext.Buffers->RequestHalfResDepth(context)->View();
+            distortionWidth = width / 2;
+            distortionHeight = height / 2;
+        }
         const auto tempDesc = GPUTextureDescription::New2D(distortionWidth, distortionHeight, PixelFormat::R8G8B8A8_UNorm);
         auto distortionRT = RenderTargetPool::Get(tempDesc);
         RENDER_TARGET_POOL_SET_NAME(distortionRT, "Forward.Distortion");
@@ -114,7 +123,7 @@ void ForwardPass::Render(RenderContext& renderContext, GPUTexture* input, GPUTex
         // Clear distortion vectors
         context->Clear(distortionRT->View(), Color::Transparent);
         context->SetViewportAndScissors((float)distortionWidth, (float)distortionHeight);
-        context->SetRenderTarget(depthBufferHandle, distortionRT->View());
+        context->SetRenderTarget(distortionDepthHandle, distortionRT->View());
 
         // Render distortion pass
         view.Pass = DrawPass::Distortion;
@@ -138,6 +147,9 @@ void ForwardPass::Render(RenderContext& renderContext, GPUTexture* input, GPUTex
         // Run forward pass
         view.Pass = DrawPass::Forward;
         context->SetRenderTarget(depthBufferHandle, output->View());
+        const bool useShadingRateImage = VariableRateShadingPass::Instance()->Bind(renderContext, context);
         mainCache->ExecuteDrawCalls(renderContext, forwardList, input->View());
+        if (useShadingRateImage)
+            context->SetShadingRateImage(nullptr);
     }
 }
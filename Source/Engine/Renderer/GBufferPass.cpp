@@ -1,6 +1,8 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "GBufferPass.h"
+#include "ImpostorsPass.h"
+#include "VariableRateShadingPass.h"
 #include "RenderList.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Editor/VertexColors.h"
@@ -11,6 +13,9 @@
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/DynamicBuffer.h"
+#include "Engine/Graphics/Materials/DecalMaterialShader.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderBuffers.h"
@@ -46,6 +51,7 @@ bool GBufferPass::Init()
     _gBufferShader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/GBuffer"));
     _skyModel = Content::LoadAsyncInternal<Model>(TEXT("Engine/Models/Sphere"));
     _boxModel = Content::LoadAsyncInternal<Model>(TEXT("Engine/Models/SimpleBox"));
+    _decalsInstanceBuffer = New<DynamicVertexBuffer>(256 * sizeof(DecalInstanceData), sizeof(DecalInstanceData), TEXT("Decals Instance Buffer"));
     if (_gBufferShader == nullptr || _skyModel == nullptr || _boxModel == nullptr)
     {
         return true;
@@ -94,6 +100,7 @@ void GBufferPass::Dispose()
 
     // Cleanup
     SAFE_DELETE_GPU_RESOURCE(_psDebug);
+    SAFE_DELETE(_decalsInstanceBuffer);
     _gBufferShader = nullptr;
     _skyModel = nullptr;
     _boxModel = nullptr;
@@ -203,6 +210,9 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
     }
 #endif
 
+    // Reduce the shading rate in low-detail regions
+    const bool useShadingRateImage = VariableRateShadingPass::Instance()->Bind(renderContext, context);
+
     // Draw objects that can get decals
     context->SetRenderTarget(*renderContext.Buffers->DepthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
     renderContext.List->ExecuteDrawCalls(renderContext, DrawCallsListType::GBuffer);
@@ -214,6 +224,9 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
     context->SetRenderTarget(*renderContext.Buffers->DepthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
     renderContext.List->ExecuteDrawCalls(renderContext, DrawCallsListType::GBufferNoDecals);
 
+    // Draw distant models impostors
+    ImpostorsPass::Instance()->Draw(renderContext, context);
+
     GPUTexture* nullTexture = nullptr;
     renderContext.List->RunCustomPostFxPass(context, renderContext, PostProcessEffectLocation::AfterGBufferPass, lightBuffer, nullTexture);
 
@@ -222,15 +235,38 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
     {
         PROFILE_GPU_CPU_NAMED("Sky");
         context->SetRenderTarget(*renderContext.Buffers->DepthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
+        if (Graphics::EnableVariableRateShading)
+            context->SetShadingRate(GPUShadingRate::Rate2x2); // Sky is smooth enough to use the coarse shading
         DrawSky(renderContext, context);
+        context->SetShadingRate(GPUShadingRate::Rate1x1);
     }
 
+    if (useShadingRateImage)
+        context->SetShadingRateImage(nullptr);
     context->ResetRenderTarget();
 }
 
 bool SortDecal(Decal* const& a, Decal* const& b)
 {
-    return a->SortOrder < b->SortOrder;
+    if (a->SortOrder != b->SortOrder)
+        return a->SortOrder < b->SortOrder;
+    const MaterialDecalBlendingMode blendingA = a->Material->GetInfo().DecalBlendingMode;
+    const MaterialDecalBlendingMode blendingB = b->Material->GetInfo().DecalBlendingMode;
+    if (blendingA != blendingB)
+        return blendingA < blendingB;
+    return a->Material.Get() < b->Material.Get();
+}
+
+FORCE_INLINE bool IsCameraInsideDecal(const DecalInstanceData& instance, const Float3& position)
+{
+    // Transform view position into the decal local space (box of size 1 centered around the origin)
+    for (int32 i = 0; i < 3; i++)
+    {
+        const Float4& row = instance.InvWorld[i];
+        if (Math::Abs(row.X * position.X + row.Y * position.Y + row.Z * position.Z + row.W) > 0.5f)
+            return false;
+    }
+    return true;
 }
 
 void GBufferPass::RenderDebug(RenderContext& renderContext)
@@ -328,6 +364,12 @@ GPUTextureView* GBufferPass::RenderSkybox(RenderContext& renderContext, GPUConte
     return result;
 }
 
+GPUTextureView* GBufferPass::GetSkybox(const RenderBuffers* buffers) const
+{
+    auto* skyboxData = buffers ? buffers->FindCustomBuffer<SkyboxCustomBuffer>(TEXT("Skybox")) : nullptr;
+    return skyboxData && skyboxData->Skybox ? skyboxData->Skybox->ViewArray() : nullptr;
+}
+
 #if USE_EDITOR
 
 void GBufferPass::PreOverrideDrawCalls(RenderContext& renderContext)
@@ -438,15 +480,14 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
     // Cache data
     auto device = GPUDevice::Instance;
     auto context = device->GetMainContext();
-    auto model = _boxModel.Get();
     auto buffers = renderContext.Buffers;
 
-    // Sort decals from the lowest order to the highest order
+    // Sort decals from the lowest order to the highest order (then by the blending mode and material within the same order to batch them)
     Sorting::QuickSort(decals.Get(), (int32)decals.Count(), &SortDecal);
 
-    // TODO: batch decals using the same material
-
-    // TODO: sort decals by the blending mode within the same order
+    // Upload decals transformations
+    SetupDecalsInstances(renderContext, context);
+    const auto instances = (const DecalInstanceData*)_decalsInstanceBuffer->Data.Get();
 
     // Prepare
     DrawCall drawCall;
@@ -455,11 +496,18 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
     drawCall.Material = nullptr;
     drawCall.WorldDeterminantSign = 1.0f;
 
-    // Draw all decals
-    for (int32 i = 0; i < decals.Count(); i++)
+    // Draw all decals (consecutive decals using the same material are drawn with a single instanced draw call)
+    for (int32 i = 0; i < decals.Count();)
     {
         const auto decal = decals[i];
         ASSERT(decal && decal->Material);
+        MaterialBase* material = decal->Material;
+        const bool isCameraInside = IsCameraInsideDecal(instances[i], renderContext.View.Position);
+        int32 batchSize = 1;
+        while (i + batchSize < decals.Count() &&
+            decals[i + batchSize]->Material.Get() == material &&
+            IsCameraInsideDecal(instances[i + batchSize], renderContext.View.Position) == isCameraInside)
+            batchSize++;
         Transform transform = decal->GetTransform();
         transform.Scale *= decal->GetSize();
         renderContext.View.GetWorldMatrix(transform, drawCall.World);
@@ -513,11 +561,41 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
         }
         }
 
-        // Draw decal
+        // Draw decals
         drawCall.PerInstanceRandom = decal->GetPerInstanceRandom();
-        decal->Material->Bind(bindParams);
-        model->Render(context);
+        material->Bind(bindParams);
+        DrawDecalsInstances(context, i, batchSize);
+        i += batchSize;
     }
 
     context->ResetSR();
 }
+
+void GBufferPass::SetupDecalsInstances(RenderContext& renderContext, GPUContext* context)
+{
+    auto& decals = renderContext.List->Decals;
+    _decalsInstanceBuffer->Clear();
+    _decalsInstanceBuffer->Data.Resize(decals.Count() * sizeof(DecalInstanceData));
+    auto instances = (DecalInstanceData*)_decalsInstanceBuffer->Data.Get();
+    for (int32 i = 0; i < decals.Count(); i++)
+    {
+        const auto decal = decals[i];
+        Transform transform = decal->GetTransform();
+        transform.Scale *= decal->GetSize();
+        Matrix world;
+        renderContext.View.GetWorldMatrix(transform, world);
+        instances[i].Set(world, decal->GetPerInstanceRandom());
+    }
+    _decalsInstanceBuffer->Flush(context);
+}
+
+void GBufferPass::DrawDecalsInstances(GPUContext* context, int32 startIndex, int32 count)
+{
+    if (_boxModel == nullptr || !_boxModel->CanBeRendered())
+        return;
+    const Mesh& mesh = _boxModel->LODs[0].Meshes[0];
+    GPUBuffer* vb[2] = { mesh.GetVertexBuffer(0), _decalsInstanceBuffer->GetBuffer() };
+    context->BindVB(ToSpan(vb, 2));
+    context->BindIB(mesh.GetIndexBuffer());
+    context->DrawIndexedInstanced(mesh.GetTriangleCount() * 3, count, startIndex);
+}
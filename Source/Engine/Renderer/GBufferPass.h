@@ -18,6 +18,7 @@ class GBufferPass : public RendererPass<GBufferPass>
     GPUPipelineState* _psDebug = nullptr;
     AssetReference<Model> _skyModel;
     AssetReference<Model> _boxModel;
+    class DynamicVertexBuffer* _decalsInstanceBuffer = nullptr;
 #if USE_EDITOR
     class LightmapUVsDensityMaterialShader* _lightmapUVsDensity = nullptr;
     class VertexColorsMaterialShader* _vertexColors = nullptr;
@@ -48,6 +49,28 @@ class GBufferPass : public RendererPass<GBufferPass>
     /// <returns>Rendered cubemap or null if not ready or failed.</returns>
     GPUTextureView* RenderSkybox(RenderContext& renderContext, GPUContext* context);
 
+    /// <summary>
+    /// Gets the sky or skybox cubemap rendered with RenderSkybox.
+    /// </summary>
+    /// <param name="buffers">The rendering context buffers.</param>
+    /// <returns>Rendered cubemap or null if not ready.</returns>
+    GPUTextureView* GetSkybox(const RenderBuffers* buffers) const;
+
+    /// <summary>
+    /// Uploads the per-instance data of the decals from the render list to the GPU. Decals are drawn with instancing where the instance index matches the decal index in the list.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void SetupDecalsInstances(RenderContext& renderContext, GPUContext* context);
+
+    /// <summary>
+    /// Draws the box geometry of the decals range from the render list using instancing (instances data has to be uploaded before with SetupDecalsInstances). Decal material has to be bound before.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="startIndex">The index of the first decal to draw.</param>
+    /// <param name="count">The amount of decals to draw.</param>
+    void DrawDecalsInstances(GPUContext* context, int32 startIndex, int32 count);
+
 #if USE_EDITOR
     // Temporary cache for faster debug previews drawing (used only during frame rendering).
     static Dictionary<GPUBuffer*, const ModelLOD*> IndexBufferToModelLOD;
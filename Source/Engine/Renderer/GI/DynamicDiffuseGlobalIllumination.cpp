@@ -57,7 +57,8 @@ PACK_STRUCT(struct Data0
 PACK_STRUCT(struct Data1
     {
     // TODO: use push constants on Vulkan or root signature data on DX12 to reduce overhead of changing single DWORD
-    Float2 Padding1;
+    uint32 UpdateIndex;
+    uint32 ProbesUpdateBudget;
     uint32 CascadeIndex;
     uint32 ProbeIndexOffset;
     });
@@ -72,9 +73,11 @@ class DDGICustomBuffer : public RenderBuffers::CustomBuffer
         Int3 ProbeScrollOffsets;
         Int3 ProbeScrollDirections;
         Int3 ProbeScrollClears;
+        uint32 UpdateIndex = 0;
 
         void Clear()
         {
+            UpdateIndex = 0;
             ProbesOrigin = Float3::Zero;
             ProbeScrollOffsets = Int3::Zero;
             ProbeScrollDirections = Int3::Zero;
@@ -88,6 +91,7 @@ class DDGICustomBuffer : public RenderBuffers::CustomBuffer
     Int3 ProbeCounts = Int3::Zero;
     GPUTexture* ProbesTrace = nullptr; // Probes ray tracing: (RGB: hit radiance, A: hit distance)
     GPUTexture* ProbesData = nullptr; // Probes data: (RGB: world-space offset, A: state/data)
+    GPUTexture* ProbesStability = nullptr; // Probes stability: (R: Global SDF distance at the last classification, G: count of classifications without nearby geometry changes)
     GPUTexture* ProbesIrradiance = nullptr; // Probes irradiance (RGB: sRGB color)
     GPUTexture* ProbesDistance = nullptr; // Probes distance (R: mean distance, G: mean distance^2)
     GPUBuffer* ActiveProbes = nullptr; // List with indices of the active probes (built during probes classification to use indirect dispatches for probes updating), counter at 0
@@ -98,6 +102,7 @@ class DDGICustomBuffer : public RenderBuffers::CustomBuffer
     {
         RenderTargetPool::Release(ProbesTrace);
         RenderTargetPool::Release(ProbesData);
+        RenderTargetPool::Release(ProbesStability);
         RenderTargetPool::Release(ProbesIrradiance);
         RenderTargetPool::Release(ProbesDistance);
         SAFE_DELETE_GPU_RESOURCE(ActiveProbes);
@@ -370,14 +375,15 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
         // Allocate probes textures
         uint64 memUsage = 0;
         auto desc = GPUTextureDescription::New2D(probesCountTotalX, probesCountTotalY, PixelFormat::Unknown);
-#define INIT_TEXTURE(texture, format, width, height) desc.Format = format; desc.Width = width; desc.Height = height; ddgiData.texture = RenderTargetPool::Get(desc); if (!ddgiData.texture) return true; memUsage += ddgiData.texture->GetMemoryUsage(); RENDER_TARGET_POOL_SET_NAME(ddgiData.texture, "DDGI." #texture)
+#define INIT_TEXTURE(texture, format, width, height) desc.Format = format; desc.Width = width; desc.Height = height; ddgiData.texture = RenderTargetPool::Get(desc); if (!ddgiData.texture) return true; memUsage += ddgiData.texture->GetMemoryUsage(); ddgiData.texture->SetCategory(GPUResourceCategory::GlobalIllumination); RENDER_TARGET_POOL_SET_NAME(ddgiData.texture, "DDGI." #texture)
         desc.Flags = GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess;
         INIT_TEXTURE(ProbesTrace, PixelFormat::R16G16B16A16_Float, probeRaysCount, Math::Min(probesCountCascade, DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT));
         INIT_TEXTURE(ProbesData, PixelFormat::R8G8B8A8_SNorm, probesCountTotalX, probesCountTotalY);
+        INIT_TEXTURE(ProbesStability, PixelFormat::R16G16_Float, probesCountTotalX, probesCountTotalY);
         INIT_TEXTURE(ProbesIrradiance, PixelFormat::R11G11B10_Float, probesCountTotalX * (DDGI_PROBE_RESOLUTION_IRRADIANCE + 2), probesCountTotalY * (DDGI_PROBE_RESOLUTION_IRRADIANCE + 2));
         INIT_TEXTURE(ProbesDistance, PixelFormat::R16G16_Float, probesCountTotalX * (DDGI_PROBE_RESOLUTION_DISTANCE + 2), probesCountTotalY * (DDGI_PROBE_RESOLUTION_DISTANCE + 2));
 #undef INIT_TEXTURE
-#define INIT_BUFFER(buffer, name) ddgiData.buffer = GPUDevice::Instance->CreateBuffer(TEXT(name)); if (!ddgiData.buffer || ddgiData.buffer->Init(desc2)) return true; memUsage += ddgiData.buffer->GetMemoryUsage();
+#define INIT_BUFFER(buffer, name) ddgiData.buffer = GPUDevice::Instance->CreateBuffer(TEXT(name)); if (!ddgiData.buffer || ddgiData.buffer->Init(desc2)) return true; ddgiData.buffer->SetCategory(GPUResourceCategory::GlobalIllumination); memUsage += ddgiData.buffer->GetMemoryUsage();
         GPUBufferDescription desc2 = GPUBufferDescription::Raw((probesCountCascade + 1) * sizeof(uint32), GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess);
         INIT_BUFFER(ActiveProbes, "DDGI.ActiveProbes");
         desc2 = GPUBufferDescription::Buffer(sizeof(GPUDispatchIndirectArgs) * Math::DivideAndRoundUp(probesCountCascade, DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess, PixelFormat::R32_UInt, nullptr, sizeof(uint32));
@@ -394,6 +400,7 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
         // Clear probes
         PROFILE_GPU("Clear");
         context->ClearUA(ddgiData.ProbesData, Float4::Zero);
+        context->ClearUA(ddgiData.ProbesStability, Float4::Zero);
         context->ClearUA(ddgiData.ProbesIrradiance, Float4::Zero);
         context->ClearUA(ddgiData.ProbesDistance, Float4::Zero);
     }
@@ -404,11 +411,20 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
     //const uint64 cascadeFrequencies[] = { 1, 2, 3, 5 };
     //const uint64 cascadeFrequencies[] = { 1, 1, 1, 1 };
     bool cascadeSkipUpdate[4];
+    int32 cascadesUpdateCount = 0;
     for (int32 cascadeIndex = 0; cascadeIndex < cascadesCount; cascadeIndex++)
     {
         cascadeSkipUpdate[cascadeIndex] = !clear && (ddgiData.LastFrameUsed % cascadeFrequencies[cascadeIndex]) != 0;
+        if (!cascadeSkipUpdate[cascadeIndex])
+            cascadesUpdateCount++;
     }
 
+    // Split the probes update budget between the cascades updated in this frame (0 if unlimited)
+    int32 probesUpdateBudget = 0;
+    if (graphicsSettings->GIProbesUpdateBudget > 0 && cascadesUpdateCount > 0)
+        probesUpdateBudget = Math::Min(Math::Max(graphicsSettings->GIProbesUpdateBudget / cascadesUpdateCount, 1), probesCountCascade);
+    const int32 probesUpdateLimit = probesUpdateBudget > 0 ? probesUpdateBudget : probesCountCascade;
+
     // Compute scrolling (probes are placed around camera but are scrolling to increase stability during movement)
     for (int32 cascadeIndex = 0; cascadeIndex < cascadesCount; cascadeIndex++)
     {
@@ -507,8 +523,9 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
             if (cascadeSkipUpdate[cascadeIndex])
                 continue;
             anyDirty = true;
+            auto& cascade = ddgiData.Cascades[cascadeIndex];
 
-            // Classify probes (activation/deactivation and relocation)
+            // Classify probes (activation/deactivation/sleeping and relocation)
             {
                 PROFILE_GPU_CPU_NAMED("Classify Probes");
                 uint32 activeProbesCount = 0;
@@ -518,8 +535,12 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
                 context->BindSR(1, bindingDataSDF.TextureMip ? bindingDataSDF.TextureMip->ViewVolume() : nullptr);
                 context->BindUA(0, ddgiData.Result.ProbesData);
                 context->BindUA(1, ddgiData.ActiveProbes->View());
+                context->BindUA(2, ddgiData.ProbesStability->View());
                 Data1 data;
+                data.UpdateIndex = cascade.UpdateIndex;
+                data.ProbesUpdateBudget = probesUpdateBudget;
                 data.CascadeIndex = cascadeIndex;
+                data.ProbeIndexOffset = 0;
                 context->UpdateCB(_cb1, &data);
                 context->BindCB(1, _cb1);
                 context->Dispatch(_csClassify, threadGroupsX, 1, 1);
@@ -538,9 +559,11 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
 
             // Update probes in batches so ProbesTrace texture can be smaller
             uint32 arg = 0;
-            for (int32 probesOffset = 0; probesOffset < probesCountCascade; probesOffset += DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT)
+            for (int32 probesOffset = 0; probesOffset < probesUpdateLimit; probesOffset += DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT)
             {
                 Data1 data;
+                data.UpdateIndex = cascade.UpdateIndex;
+                data.ProbesUpdateBudget = probesUpdateBudget;
                 data.CascadeIndex = cascadeIndex;
                 data.ProbeIndexOffset = probesOffset;
                 context->UpdateCB(_cb1, &data);
@@ -583,6 +606,7 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
 
                 arg += sizeof(GPUDispatchIndirectArgs);
             }
+            cascade.UpdateIndex++;
         }
 
         // Update probes border pixels
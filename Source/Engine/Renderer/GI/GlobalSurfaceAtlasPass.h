@@ -65,6 +65,14 @@ class FLAXENGINE_API GlobalSurfaceAtlasPass : public RendererPass<GlobalSurfaceA
     void* _currentActorObject;
 
 public:
+    /// <summary>
+    /// Gets the Global Surface Atlas (only if rendered during this frame).
+    /// </summary>
+    /// <param name="buffers">The rendering context buffers.</param>
+    /// <param name="result">The result Global Surface Atlas data for binding to the shaders.</param>
+    /// <returns>True if there is no valid Global Surface Atlas rendered during this frame, otherwise false.</returns>
+    bool Get(const RenderBuffers* buffers, BindingData& result);
+
     /// <summary>
     /// Renders the Global Surface Atlas.
     /// </summary>
@@ -4,6 +4,8 @@
 #include "RenderList.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Collections/FlatHashSet.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Graphics/GPUContext.h"
@@ -16,10 +18,11 @@
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Level/Actors/StaticModel.h"
+#include "Engine/Scripting/Enums.h"
 
 // Some of those constants must match in shader
-// TODO: try using R8 format for Global SDF
 #define GLOBAL_SDF_FORMAT PixelFormat::R16_Float
+#define GLOBAL_SDF_FORMAT_COMPACT PixelFormat::R8_UNorm // Stores normalized distance remapped into 0-1 range
 #define GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT 28 // The maximum amount of models to rasterize at once as a batch into Global SDF.
 #define GLOBAL_SDF_RASTERIZE_HEIGHTFIELD_MAX_COUNT 2 // The maximum amount of heightfields to store in a single chunk.
 #define GLOBAL_SDF_RASTERIZE_GROUP_SIZE 8
@@ -72,11 +75,17 @@ PACK_STRUCT(struct ModelsRasterizeData
     int32 CascadeMipResolution;
     int32 CascadeMipFactor;
     uint32 Objects[GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT];
+    Float2 DistanceEncode;
+    Float2 DistanceDecode;
+    });
+
+struct GenerateMipData
+{
     uint32 GenerateMipTexResolution;
     uint32 GenerateMipCoordScale;
     uint32 GenerateMipTexOffsetX;
     uint32 GenerateMipMipOffsetX;
-    });
+};
 
 struct RasterizeChunk
 {
@@ -134,8 +143,8 @@ struct CascadeData
     Float3 Position;
     float VoxelSize;
     BoundingBox Bounds;
-    HashSet<RasterizeChunkKey> NonEmptyChunks;
-    HashSet<RasterizeChunkKey> StaticChunks;
+    FlatHashSet<RasterizeChunkKey> NonEmptyChunks;
+    FlatHashSet<RasterizeChunkKey> StaticChunks;
 
     FORCE_INLINE void OnSceneRenderingDirty(const BoundingBox& objectBounds)
     {
@@ -167,6 +176,36 @@ struct CascadeData
             }
         }
     }
+
+    void Scroll(const Int3& chunksOffset, int32 chunksCount)
+    {
+        // Static chunks at the old cascade border could miss objects outside the old bounds (within the chunk margin) so redraw them
+        ScrollChunks(NonEmptyChunks, chunksOffset, chunksCount, false);
+        ScrollChunks(StaticChunks, chunksOffset, chunksCount, true);
+    }
+
+private:
+    static void ScrollChunks(FlatHashSet<RasterizeChunkKey>& chunks, const Int3& chunksOffset, int32 chunksCount, bool skipBorder)
+    {
+        Array<RasterizeChunkKey> keys;
+        keys.EnsureCapacity(chunks.Count());
+        for (const auto& e : chunks)
+            keys.Add(e.Item);
+        chunks.Clear();
+        for (RasterizeChunkKey key : keys)
+        {
+            if (skipBorder &&
+                ((chunksOffset.X != 0 && (key.Coord.X == 0 || key.Coord.X == chunksCount - 1)) ||
+                    (chunksOffset.Y != 0 && (key.Coord.Y == 0 || key.Coord.Y == chunksCount - 1)) ||
+                    (chunksOffset.Z != 0 && (key.Coord.Z == 0 || key.Coord.Z == chunksCount - 1))))
+                continue;
+            key.Coord -= chunksOffset;
+            if (key.Coord.X < 0 || key.Coord.Y < 0 || key.Coord.Z < 0 || key.Coord.X >= chunksCount || key.Coord.Y >= chunksCount || key.Coord.Z >= chunksCount)
+                continue;
+            key.Hash = key.Coord.Z * (RasterizeChunkKeyHashResolution * RasterizeChunkKeyHashResolution) + key.Coord.Y * RasterizeChunkKeyHashResolution + key.Coord.X + key.Layer * (RasterizeChunkKeyHashResolution * RasterizeChunkKeyHashResolution * RasterizeChunkKeyHashResolution);
+            chunks.Add(key);
+        }
+    }
 };
 
 class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer, public ISceneRenderingListener
@@ -181,9 +220,14 @@ class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer,
     HashSet<ScriptingTypeHandle> ObjectTypes;
     HashSet<GPUTexture*> SDFTextures;
     GlobalSignDistanceFieldPass::BindingData Result;
+    GPUContext* AsyncContext = nullptr;
+    GPUSyncPoint AsyncSyncPoint = 0;
+    Array<GPUTexture*, FixedAllocation<2>> AsyncTempTextures;
 
     ~GlobalSignDistanceFieldCustomBuffer()
     {
+        for (GPUTexture* texture : AsyncTempTextures)
+            RenderTargetPool::Release(texture);
         for (const auto& e : SDFTextures)
         {
             e.Item->Deleted.Unbind<GlobalSignDistanceFieldCustomBuffer, &GlobalSignDistanceFieldCustomBuffer::OnSDFTextureDeleted>(this);
@@ -216,6 +260,18 @@ class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer,
         }
     }
 
+    void WaitForAsync(GPUContext* context)
+    {
+        // Sync with the update executed on the async compute queue before using its results
+        if (AsyncSyncPoint == 0)
+            return;
+        context->Wait(AsyncContext, AsyncSyncPoint);
+        AsyncSyncPoint = 0;
+        for (GPUTexture* texture : AsyncTempTextures)
+            RenderTargetPool::Release(texture);
+        AsyncTempTextures.Clear();
+    }
+
     FORCE_INLINE void OnSceneRenderingDirty(const BoundingBox& objectBounds)
     {
         for (auto& cascade : Cascades)
@@ -257,7 +313,7 @@ class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer,
 
 namespace
 {
-    Dictionary<RasterizeChunkKey, RasterizeChunk> ChunksCache;
+    FlatDictionary<RasterizeChunkKey, RasterizeChunk> ChunksCache;
     Array<RasterizeObject> RasterizeObjectsCache;
     Dictionary<uint16, uint16> ObjectIndexToDataIndexCache;
 }
@@ -273,6 +329,7 @@ bool GlobalSignDistanceFieldPass::Init()
     const auto device = GPUDevice::Instance;
     _supported = device->GetFeatureLevel() >= FeatureLevel::SM5 && device->Limits.HasCompute && device->Limits.HasTypedUAVLoad
             && EnumHasAllFlags(device->GetFormatFeatures(GLOBAL_SDF_FORMAT).Support, FormatSupport::ShaderSample | FormatSupport::Texture3D);
+    _supportedCompact = _supported && EnumHasAllFlags(device->GetFormatFeatures(GLOBAL_SDF_FORMAT_COMPACT).Support, FormatSupport::ShaderSample | FormatSupport::Texture3D);
     return false;
 }
 
@@ -307,6 +364,7 @@ bool GlobalSignDistanceFieldPass::setupResources()
     _csRasterizeHeightfield = shader->GetCS("CS_RasterizeHeightfield");
     _csClearChunk = shader->GetCS("CS_ClearChunk");
     _csGenerateMip = shader->GetCS("CS_GenerateMip");
+    _csCopyCascade = shader->GetCS("CS_CopyCascade");
 
     // Init buffer
     if (!_objectsBuffer)
@@ -335,6 +393,7 @@ void GlobalSignDistanceFieldPass::OnShaderReloading(Asset* obj)
     _csRasterizeHeightfield = nullptr;
     _csClearChunk = nullptr;
     _csGenerateMip = nullptr;
+    _csCopyCascade = nullptr;
     _cb0 = nullptr;
     _cb1 = nullptr;
     invalidateResources();
@@ -359,7 +418,7 @@ void GlobalSignDistanceFieldPass::Dispose()
 bool GlobalSignDistanceFieldPass::Get(const RenderBuffers* buffers, BindingData& result)
 {
     auto* sdfData = buffers ? buffers->FindCustomBuffer<GlobalSignDistanceFieldCustomBuffer>(TEXT("GlobalSignDistanceField")) : nullptr;
-    if (sdfData && sdfData->LastFrameUsed + 1 >= Engine::FrameCount) // Allow to use SDF from the previous frame (eg. particles in Editor using the Editor viewport in Game viewport - Game render task runs first)
+    if (sdfData && sdfData->LastFrameUsed + 1 >= Engine::FrameCount && sdfData->AsyncSyncPoint == 0) // Allow to use SDF from the previous frame (eg. particles in Editor using the Editor viewport in Game viewport - Game render task runs first), skip if async update is in progress
     {
         result = sdfData->Result;
         return false;
@@ -380,12 +439,19 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
     const auto currentFrame = Engine::FrameCount;
     if (sdfData.LastFrameUsed == currentFrame)
     {
+        sdfData.WaitForAsync(context);
         result = sdfData.Result;
         return false;
     }
+    sdfData.WaitForAsync(context);
     sdfData.LastFrameUsed = currentFrame;
     PROFILE_GPU_CPU("Global SDF");
 
+    // Update on the async compute queue (if supported) to overlap with the GBuffer and shadows rendering (synced on the first use of the results)
+    GPUContext* mainContext = context;
+    if (Graphics::EnableAsyncCompute && GPUDevice::Instance->Limits.HasAsyncCompute)
+        context = GPUDevice::Instance->GetComputeContext();
+
     // Setup options
     int32 resolution, cascadesCount;
     switch (Graphics::GlobalSDFQuality)
@@ -414,18 +480,24 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
     const float cascadesDistanceScales[] = { 1.0f, 2.5f, 5.0f, 10.0f };
     const float distanceExtent = distance / cascadesDistanceScales[cascadesCount - 1];
 
+    // Setup storage format (compact format remaps normalized distance from -1..1 into 0..1)
+    const PixelFormat format = Graphics::GlobalSDFCompactStorage && _supportedCompact ? GLOBAL_SDF_FORMAT_COMPACT : GLOBAL_SDF_FORMAT;
+    const bool compact = format == GLOBAL_SDF_FORMAT_COMPACT;
+    const Float2 distanceEncode = compact ? Float2(0.5f, 0.5f) : Float2(1.0f, 0.0f);
+    const Float2 distanceDecode = compact ? Float2(2.0f, -1.0f) : Float2(1.0f, 0.0f);
+
     // Initialize buffers
     bool updated = false;
-    if (sdfData.Cascades.Count() != cascadesCount || sdfData.Resolution != resolution)
+    if (sdfData.Cascades.Count() != cascadesCount || sdfData.Resolution != resolution || (sdfData.Texture && sdfData.Texture->Format() != format))
     {
         sdfData.Cascades.Resize(cascadesCount);
         sdfData.Resolution = resolution;
         sdfData.FrameIndex = 0;
         updated = true;
-        auto desc = GPUTextureDescription::New3D(resolution * cascadesCount, resolution, resolution, GLOBAL_SDF_FORMAT, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess, 1);
+        auto desc = GPUTextureDescription::New3D(resolution * cascadesCount, resolution, resolution, format, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess, 1);
         {
             GPUTexture*& texture = sdfData.Texture;
-            if (texture && texture->Width() != desc.Width)
+            if (texture && (texture->Width() != desc.Width || texture->Format() != format))
             {
                 RenderTargetPool::Release(texture);
                 sdfData.Texture = nullptr;
@@ -435,6 +507,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 texture = RenderTargetPool::Get(desc);
                 if (!texture)
                     return true;
+                texture->SetCategory(GPUResourceCategory::GlobalIllumination);
                 RENDER_TARGET_POOL_SET_NAME(texture, "GlobalSDF.Cascade");
             }
         }
@@ -442,7 +515,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         desc.Height = desc.Depth = resolutionMip;
         {
             GPUTexture*& texture = sdfData.TextureMip;
-            if (texture && texture->Width() != desc.Width)
+            if (texture && (texture->Width() != desc.Width || texture->Format() != format))
             {
                 RenderTargetPool::Release(texture);
                 texture = nullptr;
@@ -452,11 +525,12 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 texture = RenderTargetPool::Get(desc);
                 if (!texture)
                     return true;
+                texture->SetCategory(GPUResourceCategory::GlobalIllumination);
                 RENDER_TARGET_POOL_SET_NAME(texture, "GlobalSDF.Cascade");
             }
         }
         uint64 memoryUsage = sdfData.Texture->GetMemoryUsage() + sdfData.TextureMip->GetMemoryUsage();
-        LOG(Info, "Global SDF memory usage: {0} MB", memoryUsage / 1024 / 1024);
+        LOG(Info, "Global SDF memory usage: {0} MB ({1})", memoryUsage / 1024 / 1024, ScriptingEnum::ToString(format));
     }
     if (sdfData.Origin != renderContext.View.Origin)
     {
@@ -464,6 +538,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         updated = true;
     }
     GPUTexture* tmpMip = nullptr;
+    GPUTexture* tmpScroll = nullptr;
     if (updated)
     {
         PROFILE_GPU_CPU_NAMED("Init");
@@ -530,10 +605,61 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         }
 
         // Check if cascade center has been moved
+        bool scrolled = false;
         if (!(useCache && Float3::NearEqual(cascade.Position, center, cascadeVoxelSize)))
         {
-            // TODO: optimize for moving camera (copy sdf for cached chunks)
-            cascade.StaticChunks.Clear();
+            const Int3 chunksOffset(Float3::Round((center - cascade.Position) / cascadeChunkSize));
+            if (useCache && Math::Abs(chunksOffset.X) < rasterizeChunks && Math::Abs(chunksOffset.Y) < rasterizeChunks && Math::Abs(chunksOffset.Z) < rasterizeChunks)
+            {
+                // Scroll cascade contents to reuse cached chunks (only newly exposed chunks will be rasterized)
+                PROFILE_GPU_CPU_NAMED("Scroll");
+                if (!tmpScroll)
+                {
+                    auto desc = GPUTextureDescription::New3D(resolution, resolution, resolution, format, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess, 1);
+                    tmpScroll = RenderTargetPool::Get(desc);
+                    if (!tmpScroll)
+                        return true;
+                    RENDER_TARGET_POOL_SET_NAME(tmpScroll, "GlobalSDF.Scroll");
+                }
+                const int32 scrollDispatchGroups = resolution / GLOBAL_SDF_RASTERIZE_GROUP_SIZE;
+                ModelsRasterizeData data;
+                data.CascadeResolution = resolution;
+                GenerateMipData mipData;
+                mipData.GenerateMipTexResolution = resolution;
+                mipData.GenerateMipCoordScale = 1;
+
+                // Cascade -> Tmp
+                data.ChunkCoord = Int3::Zero;
+                mipData.GenerateMipTexOffsetX = cascadeIndex * resolution;
+                mipData.GenerateMipMipOffsetX = 0;
+                context->BindCB(1, _cb1);
+                context->UpdateCB(_cb1, &data);
+                context->SetPushConstants(&mipData, sizeof(mipData));
+                context->BindSR(0, textureView);
+                context->BindUA(0, tmpScroll->ViewVolume());
+                context->Dispatch(_csCopyCascade, scrollDispatchGroups, scrollDispatchGroups, scrollDispatchGroups);
+                context->ResetUA();
+                context->ResetSR();
+
+                // Tmp -> Cascade (with offset)
+                data.ChunkCoord = chunksOffset * GLOBAL_SDF_RASTERIZE_CHUNK_SIZE;
+                mipData.GenerateMipTexOffsetX = 0;
+                mipData.GenerateMipMipOffsetX = cascadeIndex * resolution;
+                context->UpdateCB(_cb1, &data);
+                context->SetPushConstants(&mipData, sizeof(mipData));
+                context->BindSR(0, tmpScroll->ViewVolume());
+                context->BindUA(0, textureView);
+                context->Dispatch(_csCopyCascade, scrollDispatchGroups, scrollDispatchGroups, scrollDispatchGroups);
+                context->ResetUA();
+                context->ResetSR();
+
+                cascade.Scroll(chunksOffset, rasterizeChunks);
+                scrolled = true;
+            }
+            else
+            {
+                cascade.StaticChunks.Clear();
+            }
         }
         cascade.Position = center;
         cascade.VoxelSize = cascadeVoxelSize;
@@ -588,12 +714,15 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         data.CascadeIndex = cascadeIndex;
         data.CascadeMipFactor = GLOBAL_SDF_RASTERIZE_MIP_FACTOR;
         data.CascadeVoxelSize = cascadeVoxelSize;
+        data.DistanceEncode = distanceEncode;
+        data.DistanceDecode = distanceDecode;
         context->BindUA(0, textureView);
         context->BindCB(1, _cb1);
         const int32 chunkDispatchGroups = GLOBAL_SDF_RASTERIZE_CHUNK_SIZE / GLOBAL_SDF_RASTERIZE_GROUP_SIZE;
-        bool anyChunkDispatch = false;
+        bool anyChunkDispatch = scrolled;
         {
             PROFILE_GPU_CPU_NAMED("Clear Chunks");
+            context->OverlapUA(false); // Chunks don't overlap so dispatches can run without barriers in between
             for (auto it = cascade.NonEmptyChunks.Begin(); it.IsNotEnd(); ++it)
             {
                 auto& key = it->Item;
@@ -606,8 +735,8 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 context->UpdateCB(_cb1, &data);
                 context->Dispatch(_csClearChunk, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
                 anyChunkDispatch = true;
-                // TODO: don't stall with UAV barrier on D3D12/Vulkan if UAVs don't change between dispatches
             }
+            context->OverlapUA(true);
         }
         {
             PROFILE_GPU_CPU_NAMED("Rasterize Chunks");
@@ -725,6 +854,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
             context->BindSR(0, _objectsBuffer->GetBuffer() ? _objectsBuffer->GetBuffer()->View() : nullptr);
 
             // Rasterize non-empty chunks (first layer so can override existing chunk data)
+            context->OverlapUA(false);
             for (const auto& e : chunks)
             {
                 if (e.Key.Layer != 0)
@@ -746,23 +876,6 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 auto cs = data.ObjectsCount != 0 ? _csRasterizeModel0 : _csClearChunk; // Terrain-only chunk can be quickly cleared
                 context->Dispatch(cs, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
                 anyChunkDispatch = true;
-                // TODO: don't stall with UAV barrier on D3D12/Vulkan if UAVs don't change between dispatches (maybe cache per-shader write/read flags for all UAVs?)
-
-                if (chunk.HeightfieldsCount != 0)
-                {
-                    // Inject heightfield (additive)
-                    for (int32 i = 0; i < chunk.HeightfieldsCount; i++)
-                    {
-                        auto objectIndex = objectIndexToDataIndex.At(chunk.Heightfields[i]);
-                        data.Objects[i] = objectIndex;
-                        context->BindSR(i + 1, _objectsTextures[objectIndex]);
-                    }
-                    for (int32 i = chunk.HeightfieldsCount; i < GLOBAL_SDF_RASTERIZE_HEIGHTFIELD_MAX_COUNT; i++)
-                        context->UnBindSR(i + 1);
-                    data.ObjectsCount = chunk.HeightfieldsCount;
-                    context->UpdateCB(_cb1, &data);
-                    context->Dispatch(_csRasterizeHeightfield, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
-                }
 
 #if GLOBAL_SDF_DEBUG_CHUNKS
                 // Debug draw chunk bounds in world space with number of models in it
@@ -783,6 +896,29 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 }
 #endif
             }
+            context->OverlapUA(true);
+
+            // Inject heightfields into the first layer chunks (additive so done after all chunks got rasterized)
+            context->OverlapUA(false);
+            for (const auto& e : chunks)
+            {
+                auto& chunk = e.Value;
+                if (e.Key.Layer != 0 || chunk.HeightfieldsCount == 0)
+                    continue;
+                for (int32 i = 0; i < chunk.HeightfieldsCount; i++)
+                {
+                    auto objectIndex = objectIndexToDataIndex.At(chunk.Heightfields[i]);
+                    data.Objects[i] = objectIndex;
+                    context->BindSR(i + 1, _objectsTextures[objectIndex]);
+                }
+                for (int32 i = chunk.HeightfieldsCount; i < GLOBAL_SDF_RASTERIZE_HEIGHTFIELD_MAX_COUNT; i++)
+                    context->UnBindSR(i + 1);
+                data.ChunkCoord = e.Key.Coord * GLOBAL_SDF_RASTERIZE_CHUNK_SIZE;
+                data.ObjectsCount = chunk.HeightfieldsCount;
+                context->UpdateCB(_cb1, &data);
+                context->Dispatch(_csRasterizeHeightfield, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
+            }
+            context->OverlapUA(true);
 
             // Rasterize non-empty chunks (additive layers so so need combine with existing chunk data)
             for (const auto& e : chunks)
@@ -838,7 +974,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
             if (!tmpMip)
             {
                 // Use temporary texture to flood fill mip
-                auto desc = GPUTextureDescription::New3D(resolutionMip, resolutionMip, resolutionMip, GLOBAL_SDF_FORMAT, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess, 1);
+                auto desc = GPUTextureDescription::New3D(resolutionMip, resolutionMip, resolutionMip, format, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess, 1);
                 tmpMip = RenderTargetPool::Get(desc);
                 if (!tmpMip)
                     return true;
@@ -847,18 +983,19 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
             GPUTextureView* tmpMipView = tmpMip->ViewVolume();
 
             // Tex -> Mip
-            // TODO: use push constants on DX12/Vulkan to provide those 4 uints to the shader
-            data.GenerateMipTexResolution = data.CascadeResolution;
-            data.GenerateMipCoordScale = data.CascadeMipFactor;
-            data.GenerateMipTexOffsetX = data.CascadeIndex * data.CascadeResolution;
-            data.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
+            GenerateMipData mipData;
+            mipData.GenerateMipTexResolution = data.CascadeResolution;
+            mipData.GenerateMipCoordScale = data.CascadeMipFactor;
+            mipData.GenerateMipTexOffsetX = data.CascadeIndex * data.CascadeResolution;
+            mipData.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
             context->UpdateCB(_cb1, &data);
+            context->SetPushConstants(&mipData, sizeof(mipData));
             context->BindSR(0, textureView);
             context->BindUA(0, textureMipView);
             context->Dispatch(_csGenerateMip, mipDispatchGroups, mipDispatchGroups, mipDispatchGroups);
 
-            data.GenerateMipTexResolution = data.CascadeMipResolution;
-            data.GenerateMipCoordScale = 1;
+            mipData.GenerateMipTexResolution = data.CascadeMipResolution;
+            mipData.GenerateMipCoordScale = 1;
             for (int32 i = 1; i < floodFillIterations; i++)
             {
                 context->ResetUA();
@@ -867,24 +1004,23 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                     // Mip -> Tmp
                     context->BindSR(0, textureMipView);
                     context->BindUA(0, tmpMipView);
-                    data.GenerateMipTexOffsetX = data.CascadeIndex * data.CascadeMipResolution;
-                    data.GenerateMipMipOffsetX = 0;
+                    mipData.GenerateMipTexOffsetX = data.CascadeIndex * data.CascadeMipResolution;
+                    mipData.GenerateMipMipOffsetX = 0;
                 }
                 else
                 {
                     // Tmp -> Mip
                     context->BindSR(0, tmpMipView);
                     context->BindUA(0, textureMipView);
-                    data.GenerateMipTexOffsetX = 0;
-                    data.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
+                    mipData.GenerateMipTexOffsetX = 0;
+                    mipData.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
                 }
-                context->UpdateCB(_cb1, &data);
+                context->SetPushConstants(&mipData, sizeof(mipData));
                 context->Dispatch(_csGenerateMip, mipDispatchGroups, mipDispatchGroups, mipDispatchGroups);
             }
         }
     }
 
-    RenderTargetPool::Release(tmpMip);
     if (anyDraw)
     {
         context->UnBindCB(1);
@@ -893,6 +1029,21 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         context->ResetSR();
         context->FlushState();
     }
+    if (context != mainContext)
+    {
+        // Temporary textures are used by the async work so release them after sync
+        sdfData.AsyncContext = context;
+        sdfData.AsyncSyncPoint = context->Submit();
+        if (tmpMip)
+            sdfData.AsyncTempTextures.Add(tmpMip);
+        if (tmpScroll)
+            sdfData.AsyncTempTextures.Add(tmpScroll);
+    }
+    else
+    {
+        RenderTargetPool::Release(tmpMip);
+        RenderTargetPool::Release(tmpScroll);
+    }
 
     // Copy results
     result.Texture = sdfData.Texture;
@@ -914,6 +1065,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
     }
     result.Constants.Resolution = (float)resolution;
     result.Constants.CascadesCount = cascadesCount;
+    result.Constants.DistanceDecode = distanceDecode;
     sdfData.Result = result;
     return false;
 }
@@ -16,7 +16,7 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
         {
         Float4 CascadePosDistance[4];
         Float4 CascadeVoxelSize;
-        Float2 Padding;
+        Float2 DistanceDecode;
         uint32 CascadesCount;
         float Resolution;
         });
@@ -31,6 +31,7 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
 
 private:
     bool _supported = false;
+    bool _supportedCompact = false;
     AssetReference<Shader> _shader;
     GPUPipelineState* _psDebug = nullptr;
     GPUShaderProgramCS* _csRasterizeModel0 = nullptr;
@@ -38,6 +39,7 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
     GPUShaderProgramCS* _csRasterizeHeightfield = nullptr;
     GPUShaderProgramCS* _csClearChunk = nullptr;
     GPUShaderProgramCS* _csGenerateMip = nullptr;
+    GPUShaderProgramCS* _csCopyCascade = nullptr;
     GPUConstantBuffer* _cb0 = nullptr;
     GPUConstantBuffer* _cb1 = nullptr;
 
@@ -0,0 +1,149 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "ImpostorsPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Assets/Shader.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Graphics/Textures/GPUTexture.h"
+
+PACK_STRUCT(struct ImpostorsData {
+    Matrix ViewProjectionMatrix;
+    Float3 ViewPos;
+    uint32 Frames;
+    uint32 StartInstance;
+    Float3 Dummy0;
+    });
+
+PACK_STRUCT(struct ImpostorInstance {
+    Float3 Position;
+    float Radius;
+    Float4 Rotation;
+    });
+
+ImpostorsPass::ImpostorsPass()
+    : _instances(256u * (uint32)sizeof(ImpostorInstance), (uint32)sizeof(ImpostorInstance), false, TEXT("Impostors.Instances"))
+{
+}
+
+String ImpostorsPass::ToString() const
+{
+    return TEXT("ImpostorsPass");
+}
+
+bool ImpostorsPass::Init()
+{
+    // Check platform support (vertex shader reads instances from the structured buffer)
+    _supported = GPUDevice::Instance->GetFeatureLevel() >= FeatureLevel::SM5;
+    if (!_supported)
+        return false;
+
+    // Create pipeline state
+    _psImpostors = GPUDevice::Instance->CreatePipelineState();
+
+    // Load shader
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/Impostors"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<ImpostorsPass, &ImpostorsPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+void ImpostorsPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _instances.Dispose();
+    SAFE_DELETE_GPU_RESOURCE(_psImpostors);
+    _shader = nullptr;
+}
+
+bool ImpostorsPass::setupResources()
+{
+    // Wait for shader
+    if (!_supported || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(ImpostorsData))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, ImpostorsData);
+        return true;
+    }
+
+    // Create pipeline state
+    if (!_psImpostors->IsValid())
+    {
+        GPUPipelineState::Description psDesc = GPUPipelineState::Description::Default;
+        psDesc.VS = shader->GetVS("VS");
+        psDesc.PS = shader->GetPS("PS");
+        psDesc.CullMode = CullMode::TwoSided;
+        if (_psImpostors->Init(psDesc))
+            return true;
+    }
+
+    return false;
+}
+
+bool SortImpostor(const ImpostorDrawCall& a, const ImpostorDrawCall& b)
+{
+    return a.Texture < b.Texture;
+}
+
+void ImpostorsPass::Draw(RenderContext& renderContext, GPUContext* context)
+{
+    auto& impostors = renderContext.List->Impostors;
+    if (impostors.Count() == 0 || checkIfSkipPass())
+        return;
+    PROFILE_GPU_CPU("Impostors");
+
+    // Sort impostors by atlas to draw them in batches
+    Sorting::QuickSort(impostors.Get(), impostors.Count(), &SortImpostor);
+
+    // Upload instances data
+    _instances.Clear();
+    auto instances = _instances.WriteReserve<ImpostorInstance>(impostors.Count());
+    for (int32 i = 0; i < impostors.Count(); i++)
+    {
+        const ImpostorDrawCall& impostor = impostors[i];
+        auto& instance = instances[i];
+        instance.Position = impostor.Position;
+        instance.Radius = impostor.Radius;
+        instance.Rotation = Float4(impostor.Rotation.X, impostor.Rotation.Y, impostor.Rotation.Z, impostor.Rotation.W);
+    }
+    _instances.Flush(context);
+
+    // Draw instanced quads per atlas
+    ImpostorsData data;
+    Matrix::Transpose(renderContext.View.ViewProjection(), data.ViewProjectionMatrix);
+    data.ViewPos = renderContext.View.Position;
+    const auto cb = _shader->GetShader()->GetCB(0);
+    context->BindSR(0, _instances.GetBuffer()->View());
+    context->SetState(_psImpostors);
+    for (int32 start = 0; start < impostors.Count();)
+    {
+        GPUTexture* texture = impostors[start].Texture;
+        int32 end = start + 1;
+        while (end < impostors.Count() && impostors[end].Texture == texture)
+            end++;
+        data.Frames = impostors[start].Frames;
+        data.StartInstance = start;
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
+        context->BindSR(1, texture);
+        context->DrawInstanced(6, end - start);
+        start = end;
+    }
+    context->ResetSR();
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Graphics/DynamicBuffer.h"
+
+/// <summary>
+/// Model impostors rendering pass. Draws the distant models as single quads using their baked octahedral atlases (albedo, normal and depth) into the GBuffer.
+/// </summary>
+class ImpostorsPass : public RendererPass<ImpostorsPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUPipelineState* _psImpostors = nullptr;
+    DynamicStructuredBuffer _instances;
+    bool _supported = false;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="ImpostorsPass"/> class.
+    /// </summary>
+    ImpostorsPass();
+
+public:
+    /// <summary>
+    /// Draws the impostors from the render list into the GBuffer. GBuffer render targets and depth buffer have to be bound before.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Draw(RenderContext& renderContext, GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _psImpostors->ReleaseGPU();
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
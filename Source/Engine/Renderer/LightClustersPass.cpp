@@ -0,0 +1,148 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "LightClustersPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Assets/Shader.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define LIGHT_CLUSTERS_GROUP_SIZE 64
+
+PACK_STRUCT(struct LightClustersBuildData {
+    Matrix ViewMatrix;
+    Float2 ProjectionScale;
+    Float2 Dummy0;
+    LightClustersData LightClusters;
+    });
+
+LightClustersPass::LightClustersPass()
+    : _lights(64u * (uint32)sizeof(LightData), (uint32)sizeof(LightData), false, TEXT("LightClusters.Lights"))
+{
+}
+
+String LightClustersPass::ToString() const
+{
+    return TEXT("LightClustersPass");
+}
+
+bool LightClustersPass::Init()
+{
+    // Check platform support
+    const auto device = GPUDevice::Instance;
+    _supported = device->GetFeatureLevel() >= FeatureLevel::SM5 && device->Limits.HasCompute;
+    if (!_supported)
+        return false;
+
+    // Load shader
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/LightClusters"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<LightClustersPass, &LightClustersPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+void LightClustersPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _lights.Dispose();
+    SAFE_DELETE_GPU_RESOURCE(_clusters);
+    _csBuild = nullptr;
+    _shader = nullptr;
+}
+
+bool LightClustersPass::setupResources()
+{
+    // Wait for shader
+    if (!_supported || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(LightClustersBuildData))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, LightClustersBuildData);
+        return true;
+    }
+    _csBuild = shader->GetCS("CS_Build");
+
+    // Create clusters buffer
+    if (!_clusters)
+    {
+        _clusters = GPUDevice::Instance->CreateBuffer(TEXT("LightClusters.Clusters"));
+        if (_clusters->Init(GPUBufferDescription::Structured(LIGHT_CLUSTERS_COUNT * LIGHT_CLUSTERS_STRIDE, sizeof(uint32), true)))
+            return true;
+    }
+
+    return false;
+}
+
+bool LightClustersPass::Render(RenderContext& renderContext, GPUContext* context, bool useShadows)
+{
+    auto& view = renderContext.View;
+    auto& list = *renderContext.List;
+    list.LightClusters = nullptr;
+    list.LightClustersLights = nullptr;
+    if (!Graphics::EnableClusteredLighting || view.Projection.M44 == 1.0f || (list.PointLights.IsEmpty() && list.SpotLights.IsEmpty()) || checkIfSkipPass())
+        return false;
+    PROFILE_GPU_CPU("Light Clusters");
+
+    // Upload lights data (lights resolved with clusters are placed first, then the ones rendered separately)
+    _lights.Clear();
+    uint32 deferredLightsCount = 0;
+    for (int32 pass = 0; pass < 2; pass++)
+    {
+        const bool deferred = pass == 0;
+        for (const auto& light : list.PointLights)
+        {
+            if (IsDeferredLight(useShadows, light.ShadowDataIndex, light.IESTexture) == deferred)
+                light.SetupLightData(_lights.WriteReserve<LightData>(1), false);
+        }
+        for (const auto& light : list.SpotLights)
+        {
+            if (IsDeferredLight(useShadows, light.ShadowDataIndex, light.IESTexture) == deferred)
+                light.SetupLightData(_lights.WriteReserve<LightData>(1), false);
+        }
+        if (deferred)
+            deferredLightsCount = _lights.Data.Count() / sizeof(LightData);
+    }
+    _lights.Flush(context);
+
+    // Setup exponential depth slices within the view depth range (slice = log(depth) * scale + bias)
+    LightClustersData& clusters = list.LightClustersConstants;
+    const float depthRange = Math::Log(view.Far / view.Near);
+    clusters.DepthScale = (float)LIGHT_CLUSTERS_SIZE_Z / depthRange;
+    clusters.DepthBias = -(float)LIGHT_CLUSTERS_SIZE_Z * Math::Log(view.Near) / depthRange;
+    clusters.LightsCount = _lights.Data.Count() / sizeof(LightData);
+    clusters.DeferredLightsCount = deferredLightsCount;
+
+    // Cull lights into clusters
+    LightClustersBuildData data;
+    Matrix::Transpose(view.View, data.ViewMatrix);
+    data.ProjectionScale = Float2(1.0f / view.Projection.M11, 1.0f / view.Projection.M22);
+    data.Dummy0 = Float2::Zero;
+    data.LightClusters = clusters;
+    const auto cb = _shader->GetShader()->GetCB(0);
+    context->UpdateCB(cb, &data);
+    context->BindCB(0, cb);
+    context->BindSR(0, _lights.GetBuffer()->View());
+    context->BindUA(0, _clusters->View());
+    context->Dispatch(_csBuild, Math::DivideAndRoundUp(LIGHT_CLUSTERS_COUNT, LIGHT_CLUSTERS_GROUP_SIZE), 1, 1);
+    context->ResetUA();
+    context->UnBindSR(0);
+
+    list.LightClusters = _clusters;
+    list.LightClustersLights = _lights.GetBuffer();
+    return true;
+}
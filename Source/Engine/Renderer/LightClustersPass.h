@@ -0,0 +1,78 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Graphics/DynamicBuffer.h"
+
+// The amount of the view frustum clusters (screen tiles and exponential depth slices, must match shader source)
+#define LIGHT_CLUSTERS_SIZE_X 16
+#define LIGHT_CLUSTERS_SIZE_Y 8
+#define LIGHT_CLUSTERS_SIZE_Z 24
+#define LIGHT_CLUSTERS_COUNT (LIGHT_CLUSTERS_SIZE_X * LIGHT_CLUSTERS_SIZE_Y * LIGHT_CLUSTERS_SIZE_Z)
+
+// The maximum amount of the lights per cluster (must match shader source)
+#define LIGHT_CLUSTERS_MAX_LIGHTS 32
+
+// The stride (in elements) of the cluster data (lights count followed by the light indices)
+#define LIGHT_CLUSTERS_STRIDE (LIGHT_CLUSTERS_MAX_LIGHTS + 1)
+
+/// <summary>
+/// Local lights clustering pass. Culls point and spot lights into the view frustum clusters (froxels) on the GPU so the deferred and forward lighting can evaluate only the lights affecting the pixel.
+/// </summary>
+class LightClustersPass : public RendererPass<LightClustersPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUShaderProgramCS* _csBuild = nullptr;
+    GPUBuffer* _clusters = nullptr;
+    DynamicStructuredBuffer _lights;
+    bool _supported = false;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="LightClustersPass"/> class.
+    /// </summary>
+    LightClustersPass();
+
+public:
+    /// <summary>
+    /// Checks if the clustered lighting can be used for the given light (lights with shadows or IES profiles are rendered separately).
+    /// </summary>
+    /// <param name="useShadows">True if view renders shadows.</param>
+    /// <param name="shadowDataIndex">The light shadow data index (-1 if light has no shadow).</param>
+    /// <param name="iesTexture">The light IES profile texture.</param>
+    /// <returns>True if light is resolved with the clusters, otherwise false.</returns>
+    FORCE_INLINE static bool IsDeferredLight(bool useShadows, int32 shadowDataIndex, const void* iesTexture)
+    {
+        return !(useShadows && shadowDataIndex != -1) && iesTexture == nullptr;
+    }
+
+    /// <summary>
+    /// Builds the local lights clusters for the view. Assigns the clusters data to the render list (used by the lights and forward materials rendering).
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="useShadows">True if view renders shadows.</param>
+    /// <returns>True if clusters are used by the view, otherwise false.</returns>
+    bool Render(RenderContext& renderContext, GPUContext* context, bool useShadows);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csBuild = nullptr;
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
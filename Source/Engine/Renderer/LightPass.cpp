@@ -3,6 +3,7 @@
 #include "LightPass.h"
 #include "ShadowsPass.h"
 #include "GBufferPass.h"
+#include "LightClustersPass.h"
 #include "Engine/Graphics/RenderBuffers.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/GPULimits.h"
@@ -34,6 +35,7 @@ bool LightPass::Init()
     _psLightPointInverted.CreatePipelineStates();
     _psLightSpotNormal.CreatePipelineStates();
     _psLightSpotInverted.CreatePipelineStates();
+    _psLightClustered.CreatePipelineStates();
     _psLightSkyNormal = GPUDevice::Instance->CreatePipelineState();
     _psLightSkyInverted = GPUDevice::Instance->CreatePipelineState();
 
@@ -116,6 +118,19 @@ bool LightPass::setupResources()
         if (_psLightSpotNormal.Create(psDesc, shader, "PS_Spot"))
             return true;
     }
+    if (!_psLightClustered.IsValid() && GPUDevice::Instance->GetFeatureLevel() >= FeatureLevel::SM5)
+    {
+        if (shader->GetCB(2)->GetSize() != sizeof(LightClustersData))
+        {
+            REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 2, LightClustersData);
+            return true;
+        }
+        psDesc = GPUPipelineState::Description::DefaultFullscreenTriangle;
+        psDesc.BlendMode = BlendingMode::Add;
+        psDesc.BlendMode.RenderTargetWriteMask = BlendingMode::ColorWrite::RGB;
+        if (_psLightClustered.Create(psDesc, shader, "PS_Clustered"))
+            return true;
+    }
     if (!_psLightSkyNormal->IsValid() || !_psLightSkyInverted->IsValid())
     {
         psDesc = GPUPipelineState::Description::DefaultNoDepth;
@@ -145,6 +160,7 @@ void LightPass::Dispose()
     _psLightPointInverted.Delete();
     _psLightSpotNormal.Delete();
     _psLightSpotInverted.Delete();
+    _psLightClustered.Delete();
     SAFE_DELETE_GPU_RESOURCE(_psLightSkyNormal);
     SAFE_DELETE_GPU_RESOURCE(_psLightSkyInverted);
     SAFE_DELETE_GPU_RESOURCE(_psClearDiffuse);
@@ -204,6 +220,9 @@ void LightPass::RenderLight(RenderContextBatch& renderContextBatch, GPUTextureVi
         }
     }
 
+    // Build local lights clusters (lights without shadows and IES profiles are rendered in a single pass)
+    const bool useClusters = _psLightClustered.IsValid() && LightClustersPass::Instance()->Render(renderContext, context, useShadows);
+
     // Temporary data
     PerLight perLight;
     PerFrame perFrame;
@@ -238,13 +257,32 @@ void LightPass::RenderLight(RenderContextBatch& renderContextBatch, GPUTextureVi
     } \
     auto shadowMaskView = shadowMask->View()
 
+    // Render all clustered lights
+    if (useClusters && mainCache->LightClustersConstants.DeferredLightsCount != 0)
+    {
+        PROFILE_GPU_CPU_NAMED("Clustered Lights");
+        auto cb2 = lightShader->GetCB(2);
+        context->UpdateCB(cb2, &mainCache->LightClustersConstants);
+        context->BindCB(1, cb1);
+        context->BindCB(2, cb2);
+        context->UnBindSR(5);
+        context->BindSR(8, mainCache->LightClusters->View());
+        context->BindSR(9, mainCache->LightClustersLights->View());
+        context->SetState(_psLightClustered.Get(disableSpecular ? 1 : 0));
+        context->DrawFullscreenTriangle();
+        context->UnBindSR(8);
+        context->UnBindSR(9);
+    }
+
     // Render all point lights
     for (int32 lightIndex = 0; lightIndex < mainCache->PointLights.Count(); lightIndex++)
     {
+        auto& light = mainCache->PointLights[lightIndex];
+        if (useClusters && LightClustersPass::IsDeferredLight(useShadows, light.ShadowDataIndex, light.IESTexture))
+            continue;
         PROFILE_GPU_CPU_NAMED("Point Light");
 
         // Cache data
-        auto& light = mainCache->PointLights[lightIndex];
         float lightRadius = light.Radius;
         Float3 lightPosition = light.Position;
         const bool renderShadow = useShadows && light.ShadowDataIndex != -1;
@@ -298,10 +336,12 @@ void LightPass::RenderLight(RenderContextBatch& renderContextBatch, GPUTextureVi
     // Render all spot lights
     for (int32 lightIndex = 0; lightIndex < mainCache->SpotLights.Count(); lightIndex++)
     {
+        auto& light = mainCache->SpotLights[lightIndex];
+        if (useClusters && LightClustersPass::IsDeferredLight(useShadows, light.ShadowDataIndex, light.IESTexture))
+            continue;
         PROFILE_GPU_CPU_NAMED("Spot Light");
 
         // Cache data
-        auto& light = mainCache->SpotLights[lightIndex];
         float lightRadius = light.Radius;
         Float3 lightPosition = light.Position;
         const bool renderShadow = useShadows && light.ShadowDataIndex != -1;
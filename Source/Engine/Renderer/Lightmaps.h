@@ -107,6 +107,22 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(LightmapSettings);
         _4096 = 4096,
     };
 
+    /// <summary>
+    /// Lightmaps baking methods.
+    /// </summary>
+    API_ENUM() enum class BakeModes
+    {
+        /// <summary>
+        /// Renders the scene hemisphere for every lightmap texel. The highest quality but slow.
+        /// </summary>
+        Rasterization = 0,
+
+        /// <summary>
+        /// Traces rays for many lightmap texels at once with compute shaders using Global SDF and samples the lighting from Global Surface Atlas. Much faster but less accurate for small-scale details (limited by the Global SDF resolution). Requires Global SDF enabled in Graphics Settings (uses Rasterization otherwise).
+        /// </summary>
+        RayTracing = 1,
+    };
+
     /// <summary>
     /// Controls how much all lights will contribute indirect lighting.
     /// </summary>
@@ -155,6 +171,12 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(LightmapSettings);
     API_FIELD(Attributes="EditorOrder(60), Limit(0, 100, 0.1f)")
     int32 Quality = 10;
 
+    /// <summary>
+    /// The lightmaps baking method.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(70)")
+    BakeModes BakeMode = BakeModes::Rasterization;
+
 public:
 
     // [ISerializable]
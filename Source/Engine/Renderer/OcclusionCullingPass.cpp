@@ -0,0 +1,310 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "OcclusionCullingPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Assets/Shader.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Graphics/Textures/TextureData.h"
+
+PACK_STRUCT(struct HZBData {
+    Int2 InputMaxCoord;
+    Float2 Padding;
+    });
+
+class OcclusionCullingCustomBuffer : public RenderBuffers::CustomBuffer
+{
+public:
+    struct Readback
+    {
+        GPUTexture* Texture = nullptr;
+        uint64 Frame = 0;
+        Matrix ViewProjection;
+        Vector3 Origin;
+        bool Pending = false;
+    };
+
+    Readback Readbacks[OCCLUSION_CULLING_LATENCY + 1];
+    OcclusionCullingData Data;
+
+    void Reset()
+    {
+        for (auto& readback : Readbacks)
+            readback.Pending = false;
+        Data.MipLevels = 0;
+    }
+
+    ~OcclusionCullingCustomBuffer()
+    {
+        for (auto& readback : Readbacks)
+            SAFE_DELETE_GPU_RESOURCE(readback.Texture);
+    }
+};
+
+bool OcclusionCullingData::IsOccluded(const BoundingBox& bounds) const
+{
+    // Project the bounds into the depth buffer space
+    Vector3 corners[8];
+    bounds.GetCorners(corners);
+    Float2 rectMin(MAX_float), rectMax(MIN_float);
+    float minDepth = MAX_float;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Float4 position;
+        Float3::Transform((Float3)corners[i], ViewProjection, position);
+        if (position.W <= ZeroTolerance)
+            return false; // Crosses the view plane
+        const float invW = 1.0f / position.W;
+        const Float2 uv(position.X * invW * 0.5f + 0.5f, position.Y * invW * -0.5f + 0.5f);
+        rectMin = Float2::Min(rectMin, uv);
+        rectMax = Float2::Max(rectMax, uv);
+        minDepth = Math::Min(minDepth, position.Z * invW);
+    }
+    if (minDepth <= 0.0f)
+        return false;
+    rectMin = Float2::Max(rectMin, Float2::Zero);
+    rectMax = Float2::Min(rectMax, Float2::One);
+    if (rectMin.X > rectMax.X || rectMin.Y > rectMax.Y)
+        return false; // Outside the view (handled by frustum culling)
+
+    // Pick the mip level where the bounds cover at most 2x2 texels
+    const Float2 rectSize = (rectMax - rectMin) * Float2(MipSizes[0]);
+    const float size = Math::Max(rectSize.X, rectSize.Y);
+    const int32 mipIndex = Math::Clamp((int32)Math::Ceil(Math::Log2(Math::Max(size, 1.0f))), 0, MipLevels - 1);
+    const Int2 mipSize = MipSizes[mipIndex];
+    const float* depth = Depth.Get() + MipOffsets[mipIndex];
+    const int32 x0 = Math::Min((int32)(rectMin.X * (float)mipSize.X), mipSize.X - 1);
+    const int32 y0 = Math::Min((int32)(rectMin.Y * (float)mipSize.Y), mipSize.Y - 1);
+    const int32 x1 = Math::Min((int32)(rectMax.X * (float)mipSize.X), mipSize.X - 1);
+    const int32 y1 = Math::Min((int32)(rectMax.Y * (float)mipSize.Y), mipSize.Y - 1);
+
+    // Object is occluded if its nearest point is behind the farthest occluder in the covered area
+    for (int32 y = y0; y <= y1; y++)
+    {
+        for (int32 x = x0; x <= x1; x++)
+        {
+            if (minDepth <= depth[y * mipSize.X + x])
+                return false;
+        }
+    }
+    return true;
+}
+
+void OcclusionCullingData::BuildMips()
+{
+    MipOffsets[0] = 0;
+    MipLevels = 1;
+    int32 totalSize = MipSizes[0].X * MipSizes[0].Y;
+    while (MipLevels < OCCLUSION_CULLING_MAX_MIPS && (MipSizes[MipLevels - 1].X > 1 || MipSizes[MipLevels - 1].Y > 1))
+    {
+        const Int2 prevSize = MipSizes[MipLevels - 1];
+        MipSizes[MipLevels] = Int2(Math::Max((prevSize.X + 1) / 2, 1), Math::Max((prevSize.Y + 1) / 2, 1));
+        MipOffsets[MipLevels] = totalSize;
+        totalSize += MipSizes[MipLevels].X * MipSizes[MipLevels].Y;
+        MipLevels++;
+    }
+    Depth.Resize(totalSize);
+    for (int32 mipIndex = 1; mipIndex < MipLevels; mipIndex++)
+    {
+        const Int2 srcSize = MipSizes[mipIndex - 1];
+        const Int2 dstSize = MipSizes[mipIndex];
+        const float* src = Depth.Get() + MipOffsets[mipIndex - 1];
+        float* dst = Depth.Get() + MipOffsets[mipIndex];
+        for (int32 y = 0; y < dstSize.Y; y++)
+        {
+            const int32 y0 = y * 2, y1 = Math::Min(y * 2 + 1, srcSize.Y - 1);
+            for (int32 x = 0; x < dstSize.X; x++)
+            {
+                const int32 x0 = x * 2, x1 = Math::Min(x * 2 + 1, srcSize.X - 1);
+                dst[y * dstSize.X + x] = Math::Max(Math::Max(src[y0 * srcSize.X + x0], src[y0 * srcSize.X + x1]), Math::Max(src[y1 * srcSize.X + x0], src[y1 * srcSize.X + x1]));
+            }
+        }
+    }
+}
+
+String OcclusionCullingPass::ToString() const
+{
+    return TEXT("OcclusionCullingPass");
+}
+
+bool OcclusionCullingPass::Init()
+{
+    // Create pipeline state
+    _psDownscale = GPUDevice::Instance->CreatePipelineState();
+
+    // Load shader
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/OcclusionCulling"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<OcclusionCullingPass, &OcclusionCullingPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+void OcclusionCullingPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_psDownscale);
+    _shader = nullptr;
+}
+
+bool OcclusionCullingPass::setupResources()
+{
+    // Wait for shader
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(HZBData))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, HZBData);
+        return true;
+    }
+
+    // Create pipeline state
+    if (!_psDownscale->IsValid())
+    {
+        GPUPipelineState::Description psDesc = GPUPipelineState::Description::DefaultFullscreenTriangle;
+        psDesc.PS = shader->GetPS("PS_Downscale");
+        if (_psDownscale->Init(psDesc))
+            return true;
+    }
+
+    return false;
+}
+
+void OcclusionCullingPass::Prepare(RenderContext& renderContext)
+{
+    if (!Graphics::EnableOcclusionCulling || renderContext.View.IsOfflinePass || renderContext.View.IsSingleFrame)
+        return;
+    auto& buffer = *renderContext.Buffers->GetCustomBuffer<OcclusionCullingCustomBuffer>(TEXT("OcclusionCulling"));
+    buffer.LastFrameUsed = Engine::FrameCount;
+    if (renderContext.Task->IsCameraCut)
+    {
+        // Depth from the previous frames doesn't match the current view
+        buffer.Reset();
+        return;
+    }
+
+    // Pick the latest readback that has been already completed by the GPU (accept the latency to prevent stalls)
+    OcclusionCullingCustomBuffer::Readback* latest = nullptr;
+    for (auto& readback : buffer.Readbacks)
+    {
+        if (readback.Pending && Engine::FrameCount - readback.Frame >= OCCLUSION_CULLING_LATENCY && (!latest || readback.Frame > latest->Frame))
+            latest = &readback;
+    }
+    if (latest)
+    {
+        PROFILE_CPU_NAMED("Occlusion Culling Readback");
+        auto& data = buffer.Data;
+        TextureMipData mip;
+        if (latest->Texture->GetData(0, 0, mip))
+        {
+            data.MipLevels = 0;
+        }
+        else
+        {
+            const int32 width = latest->Texture->Width();
+            const int32 height = latest->Texture->Height();
+            data.ViewProjection = latest->ViewProjection;
+            data.Origin = latest->Origin;
+            data.MipSizes[0] = Int2(width, height);
+            data.Depth.Resize(width * height, false);
+            for (int32 y = 0; y < height; y++)
+                Platform::MemoryCopy(data.Depth.Get() + y * width, mip.Data.Get() + y * mip.RowPitch, width * sizeof(float));
+            data.BuildMips();
+        }
+
+        // Skip any older readbacks
+        for (auto& readback : buffer.Readbacks)
+        {
+            if (readback.Frame <= latest->Frame)
+                readback.Pending = false;
+        }
+    }
+
+    // Use the occlusion data only if it matches the current rendering origin
+    if (buffer.Data.MipLevels != 0 && buffer.Data.Origin == renderContext.View.Origin)
+        renderContext.List->Occlusion = &buffer.Data;
+}
+
+void OcclusionCullingPass::Render(RenderContext& renderContext, GPUContext* context)
+{
+    if (!Graphics::EnableOcclusionCulling || renderContext.View.IsOfflinePass || renderContext.View.IsSingleFrame || checkIfSkipPass())
+        return;
+    auto& buffer = *renderContext.Buffers->GetCustomBuffer<OcclusionCullingCustomBuffer>(TEXT("OcclusionCulling"));
+
+    // Find a free readback slot (skip frame if GPU is too far behind)
+    OcclusionCullingCustomBuffer::Readback* readback = nullptr;
+    for (auto& e : buffer.Readbacks)
+    {
+        if (!e.Pending)
+        {
+            readback = &e;
+            break;
+        }
+    }
+    if (!readback)
+        return;
+    PROFILE_GPU_CPU("Occlusion Culling");
+
+    // Downscale depth buffer (keep the farthest depth) into the small texture
+    GPUTexture* depthBuffer = renderContext.Buffers->DepthBuffer;
+    int32 width = depthBuffer->Width();
+    int32 height = depthBuffer->Height();
+    GPUTexture* src = depthBuffer;
+    const auto cb = _shader->GetShader()->GetCB(0);
+    HZBData data;
+    data.Padding = Float2::Zero;
+    do
+    {
+        data.InputMaxCoord = Int2(width - 1, height - 1);
+        width = Math::Max((width + 1) / 2, 1);
+        height = Math::Max((height + 1) / 2, 1);
+        GPUTexture* dst = RenderTargetPool::Get(GPUTextureDescription::New2D(width, height, PixelFormat::R32_Float));
+        RENDER_TARGET_POOL_SET_NAME(dst, "OcclusionCulling.Depth");
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
+        context->SetViewportAndScissors((float)width, (float)height);
+        context->SetRenderTarget(dst->View());
+        context->BindSR(0, src);
+        context->SetState(_psDownscale);
+        context->DrawFullscreenTriangle();
+        context->ResetRenderTarget();
+        context->UnBindSR(0);
+        if (src != depthBuffer)
+            RenderTargetPool::Release(src);
+        src = dst;
+    } while (width > OCCLUSION_CULLING_SIZE);
+
+    // Copy it into the staging texture for the CPU readback
+    if (!readback->Texture)
+        readback->Texture = GPUDevice::Instance->CreateTexture(TEXT("OcclusionCulling.Readback"));
+    if (readback->Texture->Width() != width || readback->Texture->Height() != height)
+    {
+        if (readback->Texture->Init(GPUTextureDescription::New2D(width, height, PixelFormat::R32_Float, GPUTextureFlags::None).ToStagingReadback()))
+        {
+            RenderTargetPool::Release(src);
+            return;
+        }
+    }
+    context->CopyTexture(readback->Texture, 0, 0, 0, 0, src, 0);
+    RenderTargetPool::Release(src);
+    readback->Frame = Engine::FrameCount;
+    readback->ViewProjection = renderContext.View.ViewProjection();
+    readback->Origin = renderContext.View.Origin;
+    readback->Pending = true;
+}
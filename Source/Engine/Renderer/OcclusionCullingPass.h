@@ -0,0 +1,120 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+
+// The maximum width (in pixels) of the depth buffer read back to the CPU
+#define OCCLUSION_CULLING_SIZE 256
+
+// The maximum amount of the CPU depth buffer mip levels
+#define OCCLUSION_CULLING_MAX_MIPS 10
+
+// The amount of the frames to wait for the depth buffer readback (to prevent GPU stall)
+#define OCCLUSION_CULLING_LATENCY 3
+
+/// <summary>
+/// The hierarchical depth buffer (HZB) of the one of the previous frames read back to the CPU. Used to cull objects hidden behind the occluders.
+/// </summary>
+struct FLAXENGINE_API OcclusionCullingData
+{
+    /// <summary>
+    /// The view projection matrix used to render the depth buffer.
+    /// </summary>
+    Matrix ViewProjection;
+
+    /// <summary>
+    /// The rendering origin of the view used to render the depth buffer.
+    /// </summary>
+    Vector3 Origin;
+
+    /// <summary>
+    /// The amount of the depth mip levels (0 if data is invalid).
+    /// </summary>
+    int32 MipLevels = 0;
+
+    /// <summary>
+    /// The size (in texels) of the depth mip levels.
+    /// </summary>
+    Int2 MipSizes[OCCLUSION_CULLING_MAX_MIPS];
+
+    /// <summary>
+    /// The offsets (in elements) of the depth mip levels in the data array.
+    /// </summary>
+    int32 MipOffsets[OCCLUSION_CULLING_MAX_MIPS];
+
+    /// <summary>
+    /// The farthest depth values (hardware depth) of the every mip level (largest mip first).
+    /// </summary>
+    Array<float> Depth;
+
+public:
+    /// <summary>
+    /// Checks if the given bounds (relative to the rendering origin) are fully hidden behind the occluders.
+    /// </summary>
+    /// <param name="bounds">The object bounds.</param>
+    /// <returns>True if object is occluded, otherwise false.</returns>
+    bool IsOccluded(const BoundingBox& bounds) const;
+
+    /// <summary>
+    /// Checks if the given bounds (relative to the rendering origin) are fully hidden behind the occluders.
+    /// </summary>
+    /// <param name="bounds">The object bounds.</param>
+    /// <returns>True if object is occluded, otherwise false.</returns>
+    FORCE_INLINE bool IsOccluded(const BoundingSphere& bounds) const
+    {
+        return IsOccluded(BoundingBox::FromSphere(bounds));
+    }
+
+    /// <summary>
+    /// Builds the depth mip levels from the largest mip.
+    /// </summary>
+    void BuildMips();
+};
+
+/// <summary>
+/// Occlusion culling rendering pass. Downscales the scene depth buffer into the small hierarchical depth buffer which is read back to the CPU and used for culling objects in the next frames (with a few frames latency).
+/// </summary>
+class OcclusionCullingPass : public RendererPass<OcclusionCullingPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUPipelineState* _psDownscale = nullptr;
+
+public:
+    /// <summary>
+    /// Prepares the occlusion culling for the view before collecting the draw calls. Assigns the latest available occlusion data to the render list.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    void Prepare(RenderContext& renderContext);
+
+    /// <summary>
+    /// Downscales the current frame depth buffer and requests its readback to the CPU.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Render(RenderContext& renderContext, GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _psDownscale->ReleaseGPU();
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
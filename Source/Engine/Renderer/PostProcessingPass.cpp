@@ -5,6 +5,8 @@
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderTargetPool.h"
 #include "Engine/Engine/Time.h"
@@ -104,6 +106,12 @@ bool PostProcessingPass::setupResources()
         if (_psComposite.Create(psDesc, shader, "PS_Composite"))
             return true;
     }
+    if (GPUDevice::Instance->Limits.HasCompute)
+    {
+        _csBloomDownsample[0] = shader->GetCS("CS_BloomDownsample", 0);
+        _csBloomDownsample[1] = shader->GetCS("CS_BloomDownsample", 1);
+        _csBloomUpsample = shader->GetCS("CS_BloomUpsample");
+    }
 
     return false;
 }
@@ -161,6 +169,47 @@ void PostProcessingPass::GB_ComputeKernel(float sigma, float width, float height
     _gbData.Size = Float2(width, height);
 }
 
+void PostProcessingPass::RenderBloomCS(GPUContext* context, GPUTexture* input, int32 width, int32 height, float blurSigma, GPUTexture** mipsDown, GPUTexture** mipsUp, int32 mipsCount)
+{
+    BloomPassData data;
+    data.UpsampleScale = 1.0f;
+    data.UpsampleRadius = Math::Clamp(blurSigma * 0.25f, 0.5f, 4.0f);
+
+    // Threshold and downsample the scene color to the half-res, then downsample the following mips (13-tap filter)
+    for (int32 mip = 0; mip < mipsCount; mip++)
+    {
+        GPUTexture* src = mip == 0 ? input : mipsDown[mip - 1];
+        GPUTexture* dst = mipsDown[mip];
+        data.SrcTexelSize = Float2(1.0f / (float)src->Width(), 1.0f / (float)src->Height());
+        data.DstSize[0] = dst->Width();
+        data.DstSize[1] = dst->Height();
+        context->SetPushConstants(&data, sizeof(data));
+        context->BindSR(0, src->View());
+        context->BindUA(0, dst->View());
+        context->Dispatch(_csBloomDownsample[mip == 0 ? 1 : 0], Math::DivideAndRoundUp<uint32>(data.DstSize[0], 8), Math::DivideAndRoundUp<uint32>(data.DstSize[1], 8), 1);
+        context->ResetUA();
+    }
+
+    // Upsample the lower mip (9-tap tent filter) and combine it with the current mip (normalize the sum of all mips in the last pass)
+    for (int32 mip = mipsCount - 2; mip >= 0; mip--)
+    {
+        GPUTexture* src = mip == mipsCount - 2 ? mipsDown[mip + 1] : mipsUp[mip + 1];
+        GPUTexture* dst = mipsUp[mip];
+        data.SrcTexelSize = Float2(1.0f / (float)src->Width(), 1.0f / (float)src->Height());
+        data.DstSize[0] = dst->Width();
+        data.DstSize[1] = dst->Height();
+        data.UpsampleScale = mip == 0 ? 1.0f / (float)mipsCount : 1.0f;
+        context->SetPushConstants(&data, sizeof(data));
+        context->BindSR(0, src->View());
+        context->BindSR(1, mipsDown[mip]->View());
+        context->BindUA(0, dst->View());
+        context->Dispatch(_csBloomUpsample, Math::DivideAndRoundUp<uint32>(data.DstSize[0], 8), Math::DivideAndRoundUp<uint32>(data.DstSize[1], 8), 1);
+        context->ResetUA();
+    }
+    context->UnBindSR(0);
+    context->UnBindSR(1);
+}
+
 void PostProcessingPass::Dispose()
 {
     // Base
@@ -173,6 +222,8 @@ void PostProcessingPass::Dispose()
     SAFE_DELETE_GPU_RESOURCE(_psBlurV);
     SAFE_DELETE_GPU_RESOURCE(_psGenGhosts);
     _psComposite.Delete();
+    _csBloomDownsample[0] = _csBloomDownsample[1] = nullptr;
+    _csBloomUpsample = nullptr;
     _shader = nullptr;
     _defaultLensColor = nullptr;
     _defaultLensDirt = nullptr;
@@ -298,16 +349,51 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
     ////////////////////////////////////////////////////////////////////////////////////
     // Bloom
 
-    auto tempDesc = GPUTextureDescription::New2D(w2, h2, 0, output->Format(), GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerMipViews);
-    auto bloomTmp1 = RenderTargetPool::Get(tempDesc);
-    RENDER_TARGET_POOL_SET_NAME(bloomTmp1, "PostProcessing.Bloom");
-    // TODO: bloomTmp2 could be quarter res because we don't use it's first mip
-    auto bloomTmp2 = RenderTargetPool::Get(tempDesc);
-    RENDER_TARGET_POOL_SET_NAME(bloomTmp2, "PostProcessing.Bloom");
+    GPUTexture* bloomTmp1 = nullptr;
+    GPUTexture* bloomTmp2 = nullptr;
+    GPUTexture* bloomMipsDown[BLOOM_MAX_MIPS] = {};
+    GPUTexture* bloomMipsUp[BLOOM_MAX_MIPS] = {};
+    int32 bloomMipsCount = 0;
+    GPUTextureView* lensFlaresTmp1 = nullptr;
+    GPUTextureView* lensFlaresTmp2 = nullptr;
 
     // Check if use bloom
-    if (useBloom)
+    if (useBloom && _csBloomUpsample && w8 > 0 && h8 > 0)
     {
+        // Use compute shaders with the mips chain of the separate textures (the amount of mips is based on the quality)
+        bloomMipsCount = Math::Min(4 + (int32)Graphics::BloomQuality, BLOOM_MAX_MIPS);
+        while (bloomMipsCount > 3 && ((w2 >> (bloomMipsCount - 1)) < 1 || (h2 >> (bloomMipsCount - 1)) < 1))
+            bloomMipsCount--;
+        for (int32 mip = 0; mip < bloomMipsCount; mip++)
+        {
+            auto tempDesc = GPUTextureDescription::New2D(Math::Max(w2 >> mip, 1), Math::Max(h2 >> mip, 1), output->Format(), GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::UnorderedAccess);
+            bloomMipsDown[mip] = RenderTargetPool::Get(tempDesc);
+            RENDER_TARGET_POOL_SET_NAME(bloomMipsDown[mip], "PostProcessing.Bloom");
+            if (mip < bloomMipsCount - 1)
+            {
+                bloomMipsUp[mip] = RenderTargetPool::Get(tempDesc);
+                RENDER_TARGET_POOL_SET_NAME(bloomMipsUp[mip], "PostProcessing.Bloom");
+            }
+        }
+        RenderBloomCS(context, input, w2, h2, data.BloomBlurSigma, bloomMipsDown, bloomMipsUp, bloomMipsCount);
+
+        // Lens flares use the quarter-res thresholded scene color
+        lensFlaresTmp1 = bloomMipsDown[1]->View();
+        lensFlaresTmp2 = bloomMipsUp[1]->View();
+
+        // Set bloom
+        context->BindSR(2, bloomMipsUp[0]->View());
+    }
+    else if (useBloom)
+    {
+        auto tempDesc = GPUTextureDescription::New2D(w2, h2, 0, output->Format(), GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerMipViews);
+        bloomTmp1 = RenderTargetPool::Get(tempDesc);
+        RENDER_TARGET_POOL_SET_NAME(bloomTmp1, "PostProcessing.Bloom");
+        tempDesc.Width = Math::Max(w4, 1);
+        tempDesc.Height = Math::Max(h4, 1);
+        bloomTmp2 = RenderTargetPool::Get(tempDesc); // Quarter-res since it's used only for lower mips
+        RENDER_TARGET_POOL_SET_NAME(bloomTmp2, "PostProcessing.Bloom");
+
         // Bloom Threshold and downscale to 1/2
         context->SetRenderTarget(bloomTmp1->View(0, 0));
         context->SetViewportAndScissors((float)w2, (float)h2);
@@ -332,8 +418,6 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
 
-        // TODO: perform blur when downscaling (13 tap) and when upscaling? (9 tap)
-
         // Gaussian Blur
         GB_ComputeKernel(data.BloomBlurSigma, static_cast<float>(w8), static_cast<float>(h8));
         //int32 blurStages = (int)Rendering.Quality + 1;
@@ -345,7 +429,7 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
             context->UpdateCB(cb1, &_gbData);
             context->BindCB(1, cb1);
             //
-            context->SetRenderTarget(bloomTmp2->View(0, 2));
+            context->SetRenderTarget(bloomTmp2->View(0, 1));
             context->BindSR(0, bloomTmp1->View(0, 2));
             context->SetState(_psBlurH);
             context->DrawFullscreenTriangle();
@@ -357,14 +441,14 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
             context->BindCB(1, cb1);
             //
             context->SetRenderTarget(bloomTmp1->View(0, 2));
-            context->BindSR(0, bloomTmp2->View(0, 2));
+            context->BindSR(0, bloomTmp2->View(0, 1));
             context->SetState(_psBlurV);
             context->DrawFullscreenTriangle();
             context->ResetRenderTarget();
         }
 
         // Upscale to 1/4 (use second tmp target to cache that downscale thress data for lens flares)
-        context->SetRenderTarget(bloomTmp2->View(0, 1));
+        context->SetRenderTarget(bloomTmp2->View(0, 0));
         context->SetViewportAndScissors((float)w4, (float)h4);
         context->BindSR(0, bloomTmp1->View(0, 2));
         context->SetState(_psScale);
@@ -374,11 +458,15 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
         // Upscale to 1/2
         context->SetRenderTarget(bloomTmp1->View(0, 0));
         context->SetViewportAndScissors((float)w2, (float)h2);
-        context->BindSR(0, bloomTmp2->View(0, 1));
+        context->BindSR(0, bloomTmp2->View(0, 0));
         context->SetState(_psScale);
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
 
+        // Lens flares use the quarter-res thresholded scene color
+        lensFlaresTmp1 = bloomTmp1->View(0, 1);
+        lensFlaresTmp2 = bloomTmp2->View(0, 0);
+
         // Set bloom
         context->UnBindSR(0);
         context->BindSR(2, bloomTmp1->View(0, 0));
@@ -400,9 +488,9 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
         context->BindSR(6, getCustomOrDefault(settings.LensFlares.LensColor, _defaultLensColor, TEXT("Engine/Textures/DefaultLensColor")));
 
         // Render lens flares
-        context->SetRenderTarget(bloomTmp2->View(0, 1));
+        context->SetRenderTarget(lensFlaresTmp2);
         context->SetViewportAndScissors((float)w4, (float)h4);
-        context->BindSR(3, bloomTmp1->View(0, 1));
+        context->BindSR(3, lensFlaresTmp1);
         context->SetState(_psGenGhosts);
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
@@ -415,8 +503,8 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
         Platform::MemoryCopy(_gbData.GaussianBlurCache, GaussianBlurCacheH, sizeof(GaussianBlurCacheH));
         context->UpdateCB(cb1, &_gbData);
         context->BindCB(1, cb1);
-        context->SetRenderTarget(bloomTmp1->View(0, 1));
-        context->BindSR(0, bloomTmp2->View(0, 1));
+        context->SetRenderTarget(lensFlaresTmp1);
+        context->BindSR(0, lensFlaresTmp2);
         context->SetState(_psBlurH);
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
@@ -425,21 +513,19 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
         Platform::MemoryCopy(_gbData.GaussianBlurCache, GaussianBlurCacheV, sizeof(GaussianBlurCacheV));
         context->UpdateCB(cb1, &_gbData);
         context->BindCB(1, cb1);
-        context->SetRenderTarget(bloomTmp2->View(0, 1));
-        context->BindSR(0, bloomTmp1->View(0, 1));
+        context->SetRenderTarget(lensFlaresTmp2);
+        context->BindSR(0, lensFlaresTmp1);
         context->SetState(_psBlurV);
         context->DrawFullscreenTriangle();
         context->ResetRenderTarget();
 
         // Set lens flares output
-        context->BindSR(3, bloomTmp2->View(0, 1));
+        context->BindSR(3, lensFlaresTmp2);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////
     // Final composite
 
-    // TODO: consider to use more compute shader for post processing
-
     // TODO: maybe don't use this rt swap and start using GetTempRt to make this design easier
 
     // Check if use Tone Mapping + Color Grading LUT
@@ -480,4 +566,9 @@ void PostProcessingPass::Render(RenderContext& renderContext, GPUTexture* input,
     // Cleanup
     RenderTargetPool::Release(bloomTmp1);
     RenderTargetPool::Release(bloomTmp2);
+    for (int32 mip = 0; mip < bloomMipsCount; mip++)
+    {
+        RenderTargetPool::Release(bloomMipsDown[mip]);
+        RenderTargetPool::Release(bloomMipsUp[mip]);
+    }
 }
@@ -8,6 +8,9 @@
 #define GB_RADIUS 6
 #define GB_KERNEL_SIZE (GB_RADIUS * 2 + 1)
 
+// The maximum amount of the mip levels used by the compute shaders bloom
+#define BLOOM_MAX_MIPS 7
+
 /// <summary>
 /// Post processing rendering service
 /// </summary>
@@ -56,6 +59,14 @@ class PostProcessingPass : public RendererPass<PostProcessingPass>
         Matrix LensFlareStarMat;
         });
 
+    PACK_STRUCT(struct BloomPassData {
+        Float2 SrcTexelSize;
+        uint32 DstSize[2];
+        float UpsampleRadius;
+        float UpsampleScale;
+        Float2 Dummy;
+        });
+
     PACK_STRUCT(struct GaussianBlurData {
         Float2 Size;
         float Dummy3;
@@ -71,6 +82,8 @@ class PostProcessingPass : public RendererPass<PostProcessingPass>
     GPUPipelineState* _psBlurV;
     GPUPipelineState* _psGenGhosts;
     GPUPipelineStatePermutationsPs<3> _psComposite;
+    GPUShaderProgramCS* _csBloomDownsample[2] = {};
+    GPUShaderProgramCS* _csBloomUpsample = nullptr;
 
     GaussianBlurData _gbData;
     Float4 GaussianBlurCacheH[GB_KERNEL_SIZE];
@@ -112,6 +125,8 @@ class PostProcessingPass : public RendererPass<PostProcessingPass>
     /// <param name="height">Texture to blur height in pixels</param>
     void GB_ComputeKernel(float sigma, float width, float height);
 
+    void RenderBloomCS(GPUContext* context, GPUTexture* input, int32 width, int32 height, float blurSigma, GPUTexture** mipsDown, GPUTexture** mipsUp, int32 mipsCount);
+
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj)
     {
@@ -121,6 +136,8 @@ class PostProcessingPass : public RendererPass<PostProcessingPass>
         _psBlurV->ReleaseGPU();
         _psGenGhosts->ReleaseGPU();
         _psComposite.Release();
+        _csBloomDownsample[0] = _csBloomDownsample[1] = nullptr;
+        _csBloomUpsample = nullptr;
         invalidateResources();
     }
 #endif
@@ -92,6 +92,7 @@ namespace ProbesRendererImpl
     GPUTexture* _tmpFace = nullptr;
     GPUTexture* _skySHIrradianceMap = nullptr;
     uint64 _updateFrameNumber = 0;
+    int32 _updateFace = 0;
 
     FORCE_INLINE bool isUpdateSynced()
     {
@@ -107,6 +108,7 @@ class ProbesRendererService : public EngineService
     ProbesRendererService()
         : EngineService(TEXT("Probes Renderer"), 70)
     {
+        RenderOnly = true;
     }
 
     void Update() override;
@@ -117,6 +119,7 @@ ProbesRendererService ProbesRendererServiceInstance;
 
 TimeSpan ProbesRenderer::ProbesUpdatedBreak(0, 0, 0, 0, 500);
 TimeSpan ProbesRenderer::ProbesReleaseDataTime(0, 0, 0, 60);
+int32 ProbesRenderer::RealtimeFacesPerFrame = 1;
 Delegate<const ProbesRenderer::Entry&> ProbesRenderer::OnRegisterBake;
 Delegate<const ProbesRenderer::Entry&> ProbesRenderer::OnFinishBake;
 
@@ -348,16 +351,31 @@ void ProbesRendererService::Update()
     }
     else if (_current.Type == ProbesRenderer::EntryType::Invalid)
     {
+        // Baked probes go first (in the registration order), then real-time probes weighted by the priority, distance to the camera and the waiting time (to round-robin between them)
         int32 firstValidEntryIndex = -1;
+        float bestScore = 0.0f;
         auto dt = (float)Time::Update.UnscaledDeltaTime.GetTotalSeconds();
+        const Vector3 viewPosition = MainRenderTask::Instance ? MainRenderTask::Instance->View.Position + MainRenderTask::Instance->View.Origin : Vector3::Zero;
         for (int32 i = 0; i < _probesToBake.Count(); i++)
         {
-            _probesToBake[i].Timeout -= dt;
-            if (_probesToBake[i].Timeout <= 0)
+            auto& e = _probesToBake[i];
+            e.Timeout -= dt;
+            e.WaitTime += dt;
+            if (e.Timeout > 0)
+                continue;
+            if (e.UseTextureData())
             {
                 firstValidEntryIndex = i;
                 break;
             }
+            const auto envProbe = e.Actor.As<EnvironmentProbe>();
+            const float distance = envProbe ? Math::Max((float)Vector3::Distance(envProbe->GetPosition(), viewPosition) - envProbe->GetScaledRadius(), 1.0f) : 1.0f;
+            const float score = (1.0f + (envProbe ? (float)envProbe->UpdatePriority : 0.0f)) * e.WaitTime / distance;
+            if (firstValidEntryIndex == -1 || score > bestScore)
+            {
+                firstValidEntryIndex = i;
+                bestScore = score;
+            }
         }
 
         // Check if need to update probe
@@ -376,6 +394,7 @@ void ProbesRendererService::Update()
             _probesToBake.RemoveAtKeepOrder(firstValidEntryIndex);
             _task->Enabled = true;
             _updateFrameNumber = 0;
+            _updateFace = 0;
 
             // Store time of the last probe update
             _lastProbeUpdate = timeNow;
@@ -473,12 +492,22 @@ void ProbesRenderer::OnRender(RenderTask* task, GPUContext* context)
     if (resizeFailed)
         LOG(Error, "Failed to resize probe");
 
+    // Real-time probes are time-sliced (a few faces per frame and filtering in a separate frame), baked probes are rendered at once
+    const bool timeSliced = !_current.UseTextureData() && RealtimeFacesPerFrame < 6;
+    int32 faceStart = 0, faceEnd = 6;
+    if (timeSliced)
+    {
+        faceStart = _updateFace;
+        faceEnd = Math::Min(_updateFace + Math::Max(RealtimeFacesPerFrame, 1), 6);
+        _updateFace = faceEnd;
+    }
+
     // Disable actor during baking (it cannot influence own results)
     const bool isActorActive = _current.Actor->GetIsActive();
     _current.Actor->SetIsActive(false);
 
-    // Render scene for all faces
-    for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
+    // Render scene for the faces
+    for (int32 faceIndex = faceStart; faceIndex < faceEnd; faceIndex++)
     {
         _task->View.SetFace(faceIndex);
 
@@ -507,6 +536,10 @@ void ProbesRenderer::OnRender(RenderTask* task, GPUContext* context)
     // Enable actor back
     _current.Actor->SetIsActive(isActorActive);
 
+    // Wait for the remaining faces to be rendered in the next frames (filtering runs in a separate frame after the last face)
+    if (timeSliced && faceStart != faceEnd)
+        return;
+
     // Filter all lower mip levels
     {
         PROFILE_GPU("Filtering");
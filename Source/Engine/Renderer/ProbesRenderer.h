@@ -31,10 +31,12 @@ class ProbesRenderer
         EntryType Type;
         ScriptingObjectReference<Actor> Actor;
         float Timeout;
+        float WaitTime;
 
         Entry()
         {
             Type = EntryType::Invalid;
+            WaitTime = 0.0f;
         }
 
         Entry(const Entry& other)
@@ -42,6 +44,7 @@ class ProbesRenderer
             Type = other.Type;
             Actor = other.Actor;
             Timeout = other.Timeout;
+            WaitTime = other.WaitTime;
         }
 
         bool UseTextureData() const;
@@ -60,6 +63,11 @@ class ProbesRenderer
     /// </summary>
     static TimeSpan ProbesReleaseDataTime;
 
+    /// <summary>
+    /// Maximum amount of cube faces rendered per frame for real-time probes (updates are time-sliced over several frames to bound the per-frame cost). Use 6 to update the whole probe in a single frame.
+    /// </summary>
+    static int32 RealtimeFacesPerFrame;
+
     int32 GetBakeQueueSize();
 
     static Delegate<const Entry&> OnRegisterBake;
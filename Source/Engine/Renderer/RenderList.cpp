@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "RenderList.h"
+#include "OcclusionCullingPass.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Graphics/Materials/IMaterial.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -15,6 +16,13 @@
 #include "Engine/Content/Assets/CubeTexture.h"
 #include "Engine/Level/Scene/Lightmap.h"
 #include "Engine/Level/Actors/PostFxVolume.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/ThreadLocal.h"
+
+#define RENDERER_ARENA_PAGE_SIZE (256 * 1024)
+#define RENDERER_ARENA_MAX_ALLOCATION (RENDERER_ARENA_PAGE_SIZE / 4)
+#define RENDER_LIST_ASYNC_INSTANCES_MIN 4096
+#define RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB 256
 
 static_assert(sizeof(DrawCall) <= 288, "Too big draw call data size.");
 static_assert(sizeof(DrawCall::Surface) >= sizeof(DrawCall::Terrain), "Wrong draw call data size.");
@@ -23,9 +31,14 @@ static_assert(sizeof(DrawCall::Surface) >= sizeof(DrawCall::Custom), "Wrong draw
 
 namespace
 {
-    // Cached data for the draw calls sorting
-    Array<uint64> SortingKeys[2];
-    Array<int32> SortingIndices;
+    // Cached data for the draw calls sorting (one per thread to sort multiple lists in parallel)
+    struct SortingCache
+    {
+        Array<uint64> Keys[2];
+        Array<int32> Indices;
+    };
+
+    ThreadLocalObject<SortingCache> SortingCaches;
     Array<RenderList*> FreeRenderList;
 
     struct MemPoolEntry
@@ -36,6 +49,55 @@ namespace
 
     Array<MemPoolEntry> MemPool;
     CriticalSection MemPoolLocker;
+
+    // Header placed at the beginning of every arena page (counts the allocations that were not freed yet)
+    struct alignas(16) ArenaPage
+    {
+        volatile int64 Live;
+    };
+
+    // Per-thread linear allocator for transient rendering data (pages are recycled by the owning thread once the frame ends and their allocations got freed)
+    struct FrameArena
+    {
+        // The pages are modified only by the owning thread
+        Array<ArenaPage*> Pages;
+        Array<ArenaPage*> FreePages;
+        ArenaPage* Page = nullptr;
+        uintptr PageOffset = RENDERER_ARENA_PAGE_SIZE;
+        volatile int64 Generation = 0;
+        volatile int64 Used = 0;
+    };
+
+    // Header placed before every allocation to route the memory back to its source (null page for the memory pool allocations)
+    struct alignas(16) AllocationHeader
+    {
+        ArenaPage* Page;
+    };
+
+    static_assert(sizeof(ArenaPage) == 16, "Invalid renderer arena page header size.");
+    static_assert(sizeof(AllocationHeader) == 16, "Invalid renderer allocation header size.");
+
+    Array<FrameArena*> Arenas;
+    CriticalSection ArenasLocker;
+    THREADLOCAL FrameArena* ThisArena = nullptr;
+    volatile int64 ArenasGeneration = 1;
+    volatile int64 ArenasReserved = 0;
+    uint64 ArenasFramePeak = 0;
+
+    void ResetArena(FrameArena* arena, int64 generation)
+    {
+        // Recycle pages that have no allocations alive (long-lived allocations keep only their own page until they get freed)
+        arena->FreePages.Clear();
+        for (ArenaPage* page : arena->Pages)
+        {
+            if (Platform::AtomicRead(&page->Live) == 0)
+                arena->FreePages.Add(page);
+        }
+        arena->Page = nullptr;
+        arena->PageOffset = RENDERER_ARENA_PAGE_SIZE;
+        Platform::AtomicStore(&arena->Used, 0);
+        Platform::AtomicStore(&arena->Generation, generation);
+    }
 }
 
 void RendererDirectionalLightData::SetupLightData(LightData* data, bool useShadow) const
@@ -108,32 +170,107 @@ void RendererSkyLightData::SetupLightData(LightData* data, bool useShadow) const
 
 void* RendererAllocation::Allocate(uintptr size)
 {
-    void* result = nullptr;
+    AllocationHeader* header = nullptr;
+    const uintptr sizeWithHeader = Math::AlignUp<uintptr>(size + sizeof(AllocationHeader), 16);
+    if (sizeWithHeader <= RENDERER_ARENA_MAX_ALLOCATION)
+    {
+        // Bump-allocate from the current thread arena
+        FrameArena* arena = ThisArena;
+        if (!arena)
+        {
+            arena = New<FrameArena>();
+            arena->Generation = Platform::AtomicRead(&ArenasGeneration);
+            ArenasLocker.Lock();
+            Arenas.Add(arena);
+            ArenasLocker.Unlock();
+            ThisArena = arena;
+        }
+        const int64 generation = Platform::AtomicRead(&ArenasGeneration);
+        if (arena->Generation != generation)
+            ResetArena(arena, generation);
+        if (arena->PageOffset + sizeWithHeader > RENDERER_ARENA_PAGE_SIZE)
+        {
+            if (arena->FreePages.HasItems())
+            {
+                arena->Page = arena->FreePages.Pop();
+            }
+            else
+            {
+                arena->Page = (ArenaPage*)Platform::Allocate(RENDERER_ARENA_PAGE_SIZE, 16);
+                arena->Page->Live = 0;
+                arena->Pages.Add(arena->Page);
+                Platform::InterlockedAdd(&ArenasReserved, RENDERER_ARENA_PAGE_SIZE);
+            }
+            arena->PageOffset = sizeof(ArenaPage);
+        }
+        header = (AllocationHeader*)((byte*)arena->Page + arena->PageOffset);
+        header->Page = arena->Page;
+        arena->PageOffset += sizeWithHeader;
+        Platform::AtomicStore(&arena->Used, arena->Used + (int64)sizeWithHeader);
+        Platform::InterlockedIncrement(&arena->Page->Live);
+        return header + 1;
+    }
+
+    // Large allocations use memory pool
     MemPoolLocker.Lock();
     for (int32 i = 0; i < MemPool.Count(); i++)
     {
         if (MemPool[i].Size == size)
         {
-            result = MemPool[i].Ptr;
+            header = (AllocationHeader*)MemPool[i].Ptr;
             MemPool.RemoveAt(i);
             break;
         }
     }
     MemPoolLocker.Unlock();
-    if (!result)
+    if (!header)
     {
-        result = Platform::Allocate(size, 16);
+        header = (AllocationHeader*)Platform::Allocate(size + sizeof(AllocationHeader), 16);
+        header->Page = nullptr;
     }
-    return result;
+    return header + 1;
 }
 
 void RendererAllocation::Free(void* ptr, uintptr size)
 {
+    AllocationHeader* header = (AllocationHeader*)ptr - 1;
+    if (header->Page)
+    {
+        // Arena page gets recycled by its owning thread when all of its allocations are freed
+        Platform::InterlockedDecrement(&header->Page->Live);
+        return;
+    }
     MemPoolLocker.Lock();
-    MemPool.Add({ ptr, size });
+    MemPool.Add({ header, size });
     MemPoolLocker.Unlock();
 }
 
+void RendererAllocation::ResetFrame()
+{
+    PROFILE_CPU();
+
+    // Sum the memory used within the ending frame (arenas that didn't allocate anything still hold the older generation)
+    const int64 generation = Platform::AtomicRead(&ArenasGeneration);
+    uint64 used = 0;
+    ArenasLocker.Lock();
+    for (FrameArena* arena : Arenas)
+    {
+        if (Platform::AtomicRead(&arena->Generation) == generation)
+            used += (uint64)Platform::AtomicRead(&arena->Used);
+    }
+    ArenasLocker.Unlock();
+    ArenasFramePeak = Math::Max(ArenasFramePeak, used);
+
+    // Start a new frame, arenas are reset by their owning threads on the next allocation (no writes to the other threads data)
+    Platform::InterlockedIncrement(&ArenasGeneration);
+}
+
+void RendererAllocation::GetStats(uint64& framePeak, uint64& reserved)
+{
+    framePeak = ArenasFramePeak;
+    reserved = (uint64)Platform::AtomicRead(&ArenasReserved);
+}
+
 RenderList* RenderList::GetFromPool()
 {
     if (FreeRenderList.HasItems())
@@ -161,13 +298,32 @@ void RenderList::CleanupCache()
     // Don't call it during rendering (data may be already in use)
     ASSERT(GPUDevice::Instance == nullptr || GPUDevice::Instance->CurrentTask == nullptr);
 
-    SortingKeys[0].Resize(0);
-    SortingKeys[1].Resize(0);
-    SortingIndices.Resize(0);
+    SortingCaches.DeleteAll();
     FreeRenderList.ClearDelete();
     for (auto& e : MemPool)
         Platform::Free(e.Ptr);
     MemPool.Clear();
+    ArenasLocker.Lock();
+    for (FrameArena* arena : Arenas)
+    {
+        // Release pages with no allocations alive (no rendering happens at this point so the owning threads don't allocate)
+        for (int32 i = arena->Pages.Count() - 1; i >= 0; i--)
+        {
+            ArenaPage* page = arena->Pages[i];
+            if (Platform::AtomicRead(&page->Live) != 0)
+                continue;
+            arena->Pages.RemoveAtKeepOrder(i);
+            arena->FreePages.Remove(page);
+            if (arena->Page == page)
+            {
+                arena->Page = nullptr;
+                arena->PageOffset = RENDERER_ARENA_PAGE_SIZE;
+            }
+            Platform::Free(page);
+            Platform::InterlockedAdd(&ArenasReserved, -RENDERER_ARENA_PAGE_SIZE);
+        }
+    }
+    ArenasLocker.Unlock();
 }
 
 bool RenderList::BlendableSettings::operator<(const BlendableSettings& other) const
@@ -367,6 +523,7 @@ bool DrawCallsList::IsEmpty() const
 
 RenderList::RenderList(const SpawnParams& params)
     : ScriptingObject(params)
+    , SkipStaticShadowCasters(false)
     , DirectionalLights(4)
     , PointLights(32)
     , SpotLights(32)
@@ -376,6 +533,9 @@ RenderList::RenderList(const SpawnParams& params)
     , Sky(nullptr)
     , AtmosphericFog(nullptr)
     , Fog(nullptr)
+    , Occlusion(nullptr)
+    , LightClusters(nullptr)
+    , LightClustersLights(nullptr)
     , Blendable(32)
     , _instanceBuffer(1024 * sizeof(InstanceData), sizeof(InstanceData), TEXT("Instance Buffer"))
 {
@@ -393,9 +553,12 @@ void RenderList::Clear()
     Scenes.Clear();
     DrawCalls.Clear();
     BatchedDrawCalls.Clear();
+    Impostors.Clear();
     for (auto& list : DrawCallsLists)
         list.Clear();
     ShadowDepthDrawCallsList.Clear();
+    ShadowDepthStaticDrawCallsList.Clear();
+    SkipStaticShadowCasters = false;
     PointLights.Clear();
     SpotLights.Clear();
     SkyLights.Clear();
@@ -406,12 +569,25 @@ void RenderList::Clear()
     Sky = nullptr;
     AtmosphericFog = nullptr;
     Fog = nullptr;
+    Occlusion = nullptr;
+    LightClusters = nullptr;
+    LightClustersLights = nullptr;
     PostFx.Clear();
     Settings = PostProcessSettings();
     Blendable.Clear();
     _instanceBuffer.Clear();
 }
 
+bool RenderList::IsOccluded(const BoundingSphere& bounds) const
+{
+    return Occlusion && Occlusion->IsOccluded(bounds);
+}
+
+bool RenderList::IsOccluded(const BoundingBox& bounds) const
+{
+    return Occlusion && Occlusion->IsOccluded(bounds);
+}
+
 struct PackedSortKey
 {
     union
@@ -502,7 +678,7 @@ void RenderList::AddDrawCall(const RenderContextBatch& renderContextBatch, DrawP
     // Add draw call to proper draw lists
     DrawPass modes = drawModes & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
     drawModes = modes & mainRenderContext.View.Pass;
-    if (drawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(bounds))
+    if (drawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(bounds) && !IsOccluded(bounds))
     {
         if ((drawModes & DrawPass::Depth) != DrawPass::None)
         {
@@ -535,7 +711,36 @@ void RenderList::AddDrawCall(const RenderContextBatch& renderContextBatch, DrawP
         drawModes = modes & renderContext.View.Pass;
         if (drawModes != DrawPass::None && renderContext.View.CullingFrustum.Intersects(bounds))
         {
-            renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
+            if ((staticFlags & StaticFlags::Transform) == StaticFlags::None)
+                renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
+            else if (!renderContext.List->SkipStaticShadowCasters)
+                renderContext.List->ShadowDepthStaticDrawCallsList.Indices.Add(index);
+        }
+    }
+}
+
+void RenderList::AddShadowsDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, int16 sortOrder)
+{
+    const RenderContext& mainRenderContext = renderContextBatch.Contexts.Get()[0];
+    const DrawPass modes = drawModes & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
+    int32 index = -1;
+    for (int32 i = 1; i < renderContextBatch.Contexts.Count(); i++)
+    {
+        const RenderContext& renderContext = renderContextBatch.Contexts.Get()[i];
+        ASSERT_LOW_LAYER(renderContext.View.Pass == DrawPass::Depth);
+        drawModes = modes & renderContext.View.Pass;
+        if (drawModes != DrawPass::None && renderContext.View.CullingFrustum.Intersects(bounds))
+        {
+            if (index == -1)
+            {
+                // Append draw call data (shadow projections reference the draw calls of the main context)
+                CalculateSortKey(mainRenderContext, drawCall, sortOrder);
+                index = DrawCalls.Add(drawCall);
+            }
+            if ((staticFlags & StaticFlags::Transform) == StaticFlags::None)
+                renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
+            else if (!renderContext.List->SkipStaticShadowCasters)
+                renderContext.List->ShadowDepthStaticDrawCallsList.Indices.Add(index);
         }
     }
 }
@@ -556,6 +761,8 @@ namespace
                 Platform::MemoryCompare(&a.Geometry, &b.Geometry, sizeof(a.Geometry)) == 0 &&
                 a.InstanceCount != 0 &&
                 b.InstanceCount != 0 &&
+                a.Draw.StartIndex == b.Draw.StartIndex &&
+                a.Draw.IndicesCount == b.Draw.IndicesCount &&
                 handler.CanBatch(a, b) &&
                 a.WorldDeterminantSign == b.WorldDeterminantSign;
     }
@@ -569,12 +776,18 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
     const int32 listSize = list.Indices.Count();
 
     // Peek shared memory
+    SortingCache* cache = SortingCaches.Get();
+    if (!cache)
+    {
+        cache = New<SortingCache>();
+        SortingCaches.Set(cache);
+    }
 #define PREPARE_CACHE(list) (list).Clear(); (list).Resize(listSize)
-    PREPARE_CACHE(SortingKeys[0]);
-    PREPARE_CACHE(SortingKeys[1]);
-    PREPARE_CACHE(SortingIndices);
+    PREPARE_CACHE(cache->Keys[0]);
+    PREPARE_CACHE(cache->Keys[1]);
+    PREPARE_CACHE(cache->Indices);
 #undef PREPARE_CACHE
-    uint64* sortedKeys = SortingKeys[0].Get();
+    uint64* sortedKeys = cache->Keys[0].Get();
 
     // Setup sort keys
     if (reverseDistance)
@@ -600,7 +813,7 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
 
     // Sort draw calls indices
     int32* resultIndices = list.Indices.Get();
-    Sorting::RadixSort(sortedKeys, resultIndices, SortingKeys[1].Get(), SortingIndices.Get(), listSize);
+    Sorting::RadixSortParallel(sortedKeys, resultIndices, cache->Keys[1].Get(), cache->Indices.Get(), listSize);
     if (resultIndices != list.Indices.Get())
         Platform::MemoryCopy(list.Indices.Get(), resultIndices, sizeof(int32) * listSize);
 
@@ -642,6 +855,28 @@ FORCE_INLINE bool CanUseInstancing(DrawPass pass)
     return pass == DrawPass::GBuffer || pass == DrawPass::Depth;
 }
 
+FORCE_INLINE void DrawGPUInstances(GPUContext* context, MaterialBase::BindParameters& bindParams, const BatchedDrawCall& batch)
+{
+    // Instances count and offset are known only by the GPU (via indirect arguments) so always use the instanced shader
+    const DrawCall& drawCall = batch.DrawCall;
+    ASSERT_LOW_LAYER(drawCall.InstanceCount == 0);
+    GPUBuffer* vb[4];
+    uint32 vbOffsets[4];
+    for (int32 j = 0; j < 3; j++)
+    {
+        vb[j] = drawCall.Geometry.VertexBuffers[j];
+        vbOffsets[j] = drawCall.Geometry.VertexBuffersOffsets[j];
+    }
+    vb[3] = batch.InstancesBuffer;
+    vbOffsets[3] = 0;
+    bindParams.FirstDrawCall = &drawCall;
+    bindParams.DrawCallsCount = MAX_int32;
+    drawCall.Material->Bind(bindParams);
+    context->BindIB(drawCall.Geometry.IndexBuffer);
+    context->BindVB(ToSpan(vb, 4), vbOffsets);
+    context->DrawIndexedInstancedIndirect(drawCall.Draw.IndirectArgsBuffer, drawCall.Draw.IndirectArgsOffset);
+}
+
 void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsList& list, const RenderListBuffer<DrawCall>& drawCalls, GPUTextureView* input)
 {
     if (list.IsEmpty())
@@ -667,16 +902,18 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
             if (batch.BatchSize > 1)
                 instancedBatchesCount += batch.BatchSize;
         }
+        bool hasGPUInstances = false;
         for (int32 i = 0; i < list.PreBatchedDrawCalls.Count(); i++)
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
             if (batch.Instances.Count() > 1)
                 instancedBatchesCount += batch.Instances.Count();
+            hasGPUInstances |= batch.InstancesBuffer != nullptr;
         }
         if (instancedBatchesCount == 0)
         {
-            // Faster path if none of the draw batches requires instancing
-            useInstancing = false;
+            // Faster path if none of the draw batches requires instancing (instances written by the GPU don't need the instance buffer)
+            useInstancing = hasGPUInstances;
             goto DRAW;
         }
         _instanceBuffer.Clear();
@@ -684,18 +921,60 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
         auto instanceData = (InstanceData*)_instanceBuffer.Data.Get();
 
         // Write to instance buffer
-        for (int32 i = 0; i < list.Batches.Count(); i++)
+        const int32 batchesCount = list.Batches.Count();
+        if (instancedBatchesCount >= RENDER_LIST_ASYNC_INSTANCES_MIN && batchesCount > RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB)
         {
-            auto& batch = batchesData[i];
-            if (batch.BatchSize > 1)
+            // Every instanced batch has a fixed location in the buffer so the large lists can be written on job system workers
+            Array<int32, RendererAllocation> batchOffsets;
+            batchOffsets.Resize(batchesCount);
+            int32 instancesCount = 0;
+            for (int32 i = 0; i < batchesCount; i++)
             {
-                IMaterial::InstancingHandler handler;
-                drawCallsData[listData[batch.StartIndex]].Material->CanUseInstancing(handler);
-                for (int32 j = 0; j < batch.BatchSize; j++)
+                batchOffsets.Get()[i] = instancesCount;
+                if (batchesData[i].BatchSize > 1)
+                    instancesCount += batchesData[i].BatchSize;
+            }
+            InstanceData* instanceDataStart = instanceData;
+            const int32* batchOffsetsData = batchOffsets.Get();
+            const Function<void(int32)> job = [batchesData, batchesCount, batchOffsetsData, drawCallsData, listData, instanceDataStart](int32 jobIndex)
+            {
+                const int32 start = jobIndex * RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB;
+                const int32 end = Math::Min(start + RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB, batchesCount);
+                for (int32 i = start; i < end; i++)
+                {
+                    auto& batch = batchesData[i];
+                    if (batch.BatchSize > 1)
+                    {
+                        IMaterial::InstancingHandler handler;
+                        drawCallsData[listData[batch.StartIndex]].Material->CanUseInstancing(handler);
+                        InstanceData* batchInstanceData = instanceDataStart + batchOffsetsData[i];
+                        for (int32 j = 0; j < batch.BatchSize; j++)
+                        {
+                            auto& drawCall = drawCallsData[listData[batch.StartIndex + j]];
+                            handler.WriteDrawCall(batchInstanceData, drawCall);
+                            batchInstanceData++;
+                        }
+                    }
+                }
+            };
+            JobSystem::Execute(job, (batchesCount + RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB - 1) / RENDER_LIST_ASYNC_INSTANCES_BATCHES_PER_JOB);
+            instanceData += instancesCount;
+        }
+        else
+        {
+            for (int32 i = 0; i < batchesCount; i++)
+            {
+                auto& batch = batchesData[i];
+                if (batch.BatchSize > 1)
                 {
-                    auto& drawCall = drawCallsData[listData[batch.StartIndex + j]];
-                    handler.WriteDrawCall(instanceData, drawCall);
-                    instanceData++;
+                    IMaterial::InstancingHandler handler;
+                    drawCallsData[listData[batch.StartIndex]].Material->CanUseInstancing(handler);
+                    for (int32 j = 0; j < batch.BatchSize; j++)
+                    {
+                        auto& drawCall = drawCallsData[listData[batch.StartIndex + j]];
+                        handler.WriteDrawCall(instanceData, drawCall);
+                        instanceData++;
+                    }
                 }
             }
         }
@@ -738,8 +1017,8 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
             }
             for (int32 j = vbCount; j < ARRAY_COUNT(drawCall.Geometry.VertexBuffers); j++)
             {
-                vb[vbCount] = nullptr;
-                vbOffsets[vbCount] = 0;
+                vb[j] = nullptr;
+                vbOffsets[j] = 0;
             }
 
             bindParams.FirstDrawCall = &drawCall;
@@ -779,6 +1058,11 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
             auto& drawCall = batch.DrawCall;
+            if (batch.InstancesBuffer)
+            {
+                DrawGPUInstances(context, bindParams, batch);
+                continue;
+            }
 
             int32 vbCount = 0;
             while (vbCount < ARRAY_COUNT(drawCall.Geometry.VertexBuffers) && drawCall.Geometry.VertexBuffers[vbCount])
@@ -789,8 +1073,8 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
             }
             for (int32 j = vbCount; j < ARRAY_COUNT(drawCall.Geometry.VertexBuffers); j++)
             {
-                vb[vbCount] = nullptr;
-                vbOffsets[vbCount] = 0;
+                vb[j] = nullptr;
+                vbOffsets[j] = 0;
             }
 
             bindParams.FirstDrawCall = &drawCall;
@@ -854,6 +1138,12 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
         for (int32 i = 0; i < list.PreBatchedDrawCalls.Count(); i++)
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
+            if (batch.InstancesBuffer)
+            {
+                DrawGPUInstances(context, bindParams, batch);
+                bindParams.DrawCallsCount = 1;
+                continue;
+            }
             auto drawCall = batch.DrawCall;
             bindParams.FirstDrawCall = &drawCall;
             const auto* instancesData = batch.Instances.Get();
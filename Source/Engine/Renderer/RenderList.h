@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Math/Half.h"
+#include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Graphics/PostProcessSettings.h"
 #include "Engine/Graphics/DynamicBuffer.h"
 #include "Engine/Scripting/ScriptingObject.h"
@@ -21,6 +22,7 @@ class IPostFxSettingsProvider;
 class CubeTexture;
 struct RenderContext;
 struct RenderContextBatch;
+struct OcclusionCullingData;
 
 struct RendererDirectionalLightData
 {
@@ -82,6 +84,8 @@ struct RendererSpotLightData
     float InvCosConeDifference;
     float ContactShadowsLength;
     float IndirectLightingIntensity;
+    float ShadowsUpdateRate;
+    float ShadowsUpdateRateAtDistance;
     ShadowsCastingMode ShadowsMode;
 
     StaticFlags StaticFlags;
@@ -120,6 +124,8 @@ struct RendererPointLightData
     float SourceLength;
     float ContactShadowsLength;
     float IndirectLightingIntensity;
+    float ShadowsUpdateRate;
+    float ShadowsUpdateRateAtDistance;
     ShadowsCastingMode ShadowsMode;
 
     StaticFlags StaticFlags;
@@ -228,6 +234,32 @@ struct BatchedDrawCall
 {
     DrawCall DrawCall;
     Array<struct InstanceData, RendererAllocation> Instances;
+
+    // The GPU-written instances buffer (InstanceData elements) used by the indirect draw call (DrawCall.InstanceCount is 0). Instances list is unused in that case.
+    GPUBuffer* InstancesBuffer = nullptr;
+};
+
+template<>
+struct TIsTriviallyRelocatable<BatchedDrawCall>
+{
+    enum { Value = true };
+};
+
+/// <summary>
+/// The model impostor drawn as a single quad with the octahedral atlas view facing the camera.
+/// </summary>
+struct ImpostorDrawCall
+{
+    // The impostor atlas texture array.
+    GPUTexture* Texture;
+    // The amount of views per atlas side.
+    int32 Frames;
+    // The world-space center of the impostor (relative to the view origin).
+    Float3 Position;
+    // The world-space radius of the impostor.
+    float Radius;
+    // The world-space orientation of the impostor.
+    Quaternion Rotation;
 };
 
 /// <summary>
@@ -299,6 +331,11 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     RenderListBuffer<BatchedDrawCall> BatchedDrawCalls;
 
+    /// <summary>
+    /// Model impostors to draw into the GBuffer (drawn by the ImpostorsPass).
+    /// </summary>
+    RenderListBuffer<ImpostorDrawCall> Impostors;
+
     /// <summary>
     /// The draw calls lists. Each for the separate draw pass.
     /// </summary>
@@ -309,6 +346,16 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     DrawCallsList ShadowDepthDrawCallsList;
 
+    /// <summary>
+    /// The additional draw calls list for Depth drawing into Shadow Projections that contains only static shadow casters (objects with static transform). Used by the cached shadow maps of the static lights.
+    /// </summary>
+    DrawCallsList ShadowDepthStaticDrawCallsList;
+
+    /// <summary>
+    /// True if skip collecting static shadow casters into ShadowDepthStaticDrawCallsList (eg. they are already cached in the light shadow map).
+    /// </summary>
+    bool SkipStaticShadowCasters;
+
     /// <summary>
     /// Light pass members - directional lights
     /// </summary>
@@ -369,6 +416,26 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     RenderSetup Setup;
 
+    /// <summary>
+    /// The occlusion culling data to use for the objects culling (null if unused).
+    /// </summary>
+    const OcclusionCullingData* Occlusion;
+
+    /// <summary>
+    /// The local lights clusters buffer (lights count and indices per view frustum cluster) built by the LightClustersPass (null if unused).
+    /// </summary>
+    GPUBuffer* LightClusters;
+
+    /// <summary>
+    /// The local lights data buffer referenced by the light clusters (null if unused).
+    /// </summary>
+    GPUBuffer* LightClustersLights;
+
+    /// <summary>
+    /// The local lights clusters parameters for shaders.
+    /// </summary>
+    LightClustersData LightClustersConstants;
+
     /// <summary>
     /// The post process settings.
     /// </summary>
@@ -480,6 +547,20 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Checks if the given bounds are hidden behind the occluders (using the view occlusion culling data).
+    /// </summary>
+    /// <param name="bounds">The object bounds (relative to the rendering origin).</param>
+    /// <returns>True if object is occluded and can be skipped from drawing, otherwise false.</returns>
+    bool IsOccluded(const BoundingSphere& bounds) const;
+
+    /// <summary>
+    /// Checks if the given bounds are hidden behind the occluders (using the view occlusion culling data).
+    /// </summary>
+    /// <param name="bounds">The object bounds (relative to the rendering origin).</param>
+    /// <returns>True if object is occluded and can be skipped from drawing, otherwise false.</returns>
+    bool IsOccluded(const BoundingBox& bounds) const;
+
 public:
     /// <summary>
     /// Adds the draw call to the draw lists.
@@ -505,6 +586,18 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// <param name="sortOrder">Object sorting key.</param>
     void AddDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, bool receivesDecals = true, int16 sortOrder = 0);
 
+    /// <summary>
+    /// Adds the draw call to the draw lists of the shadow projections only (skips the main render context). Used when the main view geometry is submitted separately (eg. after the mesh clusters culling). Performs additional per-context frustum culling.
+    /// </summary>
+    /// <param name="renderContextBatch">The rendering context batch. This assumes that RenderContextBatch contains main context and shadow projections only.</param>
+    /// <param name="drawModes">The object draw modes.</param>
+    /// <param name="staticFlags">The object static flags.</param>
+    /// <param name="shadowsMode">The object shadows casting mode.</param>
+    /// <param name="bounds">The object bounds.</param>
+    /// <param name="drawCall">The draw call data.</param>
+    /// <param name="sortOrder">Object sorting key.</param>
+    void AddShadowsDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, int16 sortOrder = 0);
+
     /// <summary>
     /// Sorts the collected draw calls list.
     /// </summary>
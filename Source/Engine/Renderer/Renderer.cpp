@@ -21,12 +21,21 @@
 #include "MotionBlurPass.h"
 #include "VolumetricFogPass.h"
 #include "HistogramPass.h"
+#include "OcclusionCullingPass.h"
+#include "LightClustersPass.h"
+#include "ImpostorsPass.h"
+#include "TerrainVirtualTexturePass.h"
+#include "VariableRateShadingPass.h"
 #include "AtmospherePreCompute.h"
 #include "GlobalSignDistanceFieldPass.h"
 #include "GI/GlobalSurfaceAtlasPass.h"
 #include "GI/DynamicDiffuseGlobalIllumination.h"
 #include "Utils/MultiScaler.h"
 #include "Utils/BitonicSort.h"
+#include "Utils/BlendShapesPass.h"
+#include "Utils/SkinningCache.h"
+#include "Utils/InstancesCulling.h"
+#include "Utils/SpriteBatching.h"
 #include "AntiAliasing/FXAA.h"
 #include "AntiAliasing/TAA.h"
 #include "AntiAliasing/SMAA.h"
@@ -83,10 +92,19 @@ bool RendererService::Init()
     PassList.Add(MotionBlurPass::Instance());
     PassList.Add(MultiScaler::Instance());
     PassList.Add(BitonicSort::Instance());
+    PassList.Add(BlendShapesPass::Instance());
+    PassList.Add(SkinningCache::Instance());
+    PassList.Add(InstancesCulling::Instance());
+    PassList.Add(SpriteBatching::Instance());
+    PassList.Add(VariableRateShadingPass::Instance());
     PassList.Add(FXAA::Instance());
     PassList.Add(TAA::Instance());
     PassList.Add(SMAA::Instance());
     PassList.Add(HistogramPass::Instance());
+    PassList.Add(OcclusionCullingPass::Instance());
+    PassList.Add(LightClustersPass::Instance());
+    PassList.Add(ImpostorsPass::Instance());
+    PassList.Add(TerrainVirtualTexturePass::Instance());
     PassList.Add(GlobalSignDistanceFieldPass::Instance());
     PassList.Add(GlobalSurfaceAtlasPass::Instance());
     PassList.Add(DynamicDiffuseGlobalIlluminationPass::Instance());
@@ -343,6 +361,7 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     // Prepare
     renderContext.View.Prepare(renderContext);
     renderContext.Buffers->Prepare();
+    OcclusionCullingPass::Instance()->Prepare(renderContext);
 
     // Build batch of render contexts (main view and shadow projections)
     {
@@ -372,6 +391,7 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
 #endif
 
         // Dispatch drawing (via JobSystem - multiple job batches for every scene)
+        SpriteBatching::Instance()->Begin(renderContextBatch);
         JobSystem::SetJobStartingOnDispatch(false);
         task->OnCollectDrawCalls(renderContextBatch, SceneRendering::DrawCategory::SceneDraw);
         task->OnCollectDrawCalls(renderContextBatch, SceneRendering::DrawCategory::SceneDrawAsync);
@@ -382,26 +402,52 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
             JobSystem::Wait(label);
         renderContextBatch.WaitLabels.Clear();
 
+        // Add the batched sprites and texts draw calls
+        SpriteBatching::Instance()->Execute(context);
+
 #if USE_EDITOR
         GBufferPass::Instance()->OverrideDrawCalls(renderContext);
 #endif
     }
 
+    // Run compute shaders blending of the blend shapes used by the collected draw calls
+    BlendShapesPass::Instance()->Execute(context);
+
+    // Run compute shaders skinning of the animated meshes drawn as static geometry by the collected draw calls
+    SkinningCache::Instance()->Execute(context);
+
+    // Run GPU-driven culling of the instances drawn by the collected draw calls
+    InstancesCulling::Instance()->Execute(context);
+
+    // Bake the terrain virtual texture pages requested by the collected draw calls
+    TerrainVirtualTexturePass::Instance()->Execute(renderContext, context);
+
     // Sort draw calls
     {
         PROFILE_CPU_NAMED("Sort Draw Calls");
+
+        // Sort shadow projections on job system workers (every projection uses its own render list) while sorting the main view on a render thread
+        int64 shadowsSortLabel = 0;
+        if (renderContextBatch.Contexts.Count() > 1)
+        {
+            const Function<void(int32)> job = [&renderContextBatch, &renderContext](int32 i)
+            {
+                auto& shadowContext = renderContextBatch.Contexts[i + 1];
+                shadowContext.List->SortDrawCalls(shadowContext, false, DrawCallsListType::Depth);
+                shadowContext.List->SortDrawCalls(shadowContext, false, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls);
+                shadowContext.List->SortDrawCalls(shadowContext, false, shadowContext.List->ShadowDepthStaticDrawCallsList, renderContext.List->DrawCalls);
+            };
+            shadowsSortLabel = JobSystem::Dispatch(job, renderContextBatch.Contexts.Count() - 1);
+        }
+
         renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::GBuffer);
         renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::GBufferNoDecals);
         renderContext.List->SortDrawCalls(renderContext, true, DrawCallsListType::Forward);
         renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::Distortion);
         if (setup.UseMotionVectors)
             renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::MotionVectors);
-        for (int32 i = 1; i < renderContextBatch.Contexts.Count(); i++)
-        {
-            auto& shadowContext = renderContextBatch.Contexts[i];
-            shadowContext.List->SortDrawCalls(shadowContext, false, DrawCallsListType::Depth);
-            shadowContext.List->SortDrawCalls(shadowContext, false, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls);
-        }
+        if (shadowsSortLabel != 0)
+            JobSystem::Wait(shadowsSortLabel);
     }
 
     // Get the light accumulation buffer
@@ -433,6 +479,9 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     // Fill GBuffer
     GBufferPass::Instance()->Fill(renderContext, lightBuffer);
 
+    // Read back depth buffer for the occlusion culling in the next frames
+    OcclusionCullingPass::Instance()->Render(renderContext, context);
+
     // Debug drawing
     if (renderContext.View.Mode == ViewMode::GlobalSDF)
         GlobalSignDistanceFieldPass::Instance()->RenderDebug(renderContext, context, lightBuffer);
@@ -549,6 +598,9 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     renderContext.List->RunMaterialPostFxPass(context, renderContext, MaterialPostFxLocation::AfterForwardPass, frameBuffer, lightBuffer);
     renderContext.List->RunCustomPostFxPass(context, renderContext, PostProcessEffectLocation::AfterForwardPass, frameBuffer, lightBuffer);
 
+    // Generate the shading rate image for the next frame
+    VariableRateShadingPass::Instance()->Render(renderContext, context, frameBuffer);
+
     // Cleanup
     context->ResetRenderTarget();
     context->ResetSR();
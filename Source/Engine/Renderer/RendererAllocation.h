@@ -11,6 +11,18 @@ class RendererAllocation
     static FLAXENGINE_API void* Allocate(uintptr size);
     static FLAXENGINE_API void Free(void* ptr, uintptr size);
 
+    /// <summary>
+    /// Ends the frame for the per-thread arenas used by the small transient allocations. Called once the frame rendering ends. Each thread recycles its arena pages that have no allocations alive on its next allocation.
+    /// </summary>
+    static FLAXENGINE_API void ResetFrame();
+
+    /// <summary>
+    /// Gets the frame arenas memory stats.
+    /// </summary>
+    /// <param name="framePeak">The high-water mark of the memory used by the arenas within a single frame (in bytes).</param>
+    /// <param name="reserved">The total memory reserved by the arenas (in bytes).</param>
+    static FLAXENGINE_API void GetStats(uint64& framePeak, uint64& reserved);
+
     template<typename T>
     class Data
     {
@@ -58,8 +70,8 @@ class RendererAllocation
             if (oldCount)
             {
                 if (newCount > 0)
-                    Memory::MoveItems(newData, _data, newCount);
-                Memory::DestructItems(_data, oldCount);
+                    Memory::RelocateItems(newData, _data, newCount);
+                Memory::DestructItems(_data + newCount, oldCount - newCount);
             }
             if (_data)
                 RendererAllocation::Free(_data, _size);
@@ -9,6 +9,12 @@
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Level/Actor.h"
+#include "Engine/Level/Scene/SceneRendering.h"
+#include "Engine/Utilities/RectPack.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Lightmaps.h"
 #endif
@@ -17,6 +23,18 @@
 #define SpotLight_NearPlane 10.0f
 #define PointLight_NearPlane 10.0f
 
+// The maximum amount of the lights with cached shadow maps (per view)
+#define SHADOWS_CACHE_MAX_LIGHTS 16
+
+// The amount of frames after which the cached shadow maps of the unused light get released
+#define SHADOWS_CACHE_RELEASE_FRAMES 60
+
+// The minimum resolution (in pixels) of the local light shadow map
+#define SHADOWS_MIN_RESOLUTION 32
+
+// The padding (in pixels) between the shadow atlas tiles (prevents filtering from sampling the neighbour tiles)
+#define SHADOWS_ATLAS_PADDING 4
+
 PACK_STRUCT(struct Data{
     GBufferData GBuffer;
     LightData Light;
@@ -28,12 +46,107 @@ PACK_STRUCT(struct Data{
     float ContactShadowsLength;
     });
 
+struct ShadowsLightCache
+{
+    Guid ID;
+    GPUTexture* StaticShadowMap;
+    GPUTexture* ShadowMap;
+    Float3 Position;
+    Float3 Direction;
+    float Radius;
+    float Angle;
+    int32 Size;
+    uint64 LastFrameUsed;
+    float UpdateProgress;
+    bool StaticValid;
+    bool DynamicValid;
+
+    void Release()
+    {
+        RenderTargetPool::Release(StaticShadowMap);
+        RenderTargetPool::Release(ShadowMap);
+        StaticShadowMap = nullptr;
+        ShadowMap = nullptr;
+    }
+};
+
+struct ShadowAtlasTile : RectPack<ShadowAtlasTile, uint16>
+{
+    ShadowAtlasTile(uint16 x, uint16 y, uint16 width, uint16 height)
+        : RectPack<ShadowAtlasTile, uint16>(x, y, width, height)
+    {
+    }
+
+    void OnInsert()
+    {
+    }
+
+    void OnFree()
+    {
+    }
+};
+
+// Cached shadow maps of the static lights (with static transform). Static shadow casters are rendered once (until they change) and dynamic ones are drawn on top of the cached depth.
+class ShadowsCustomBuffer : public RenderBuffers::CustomBuffer, public ISceneRenderingListener
+{
+public:
+    Vector3 Origin = Vector3::Zero;
+    Array<ShadowsLightCache, FixedAllocation<SHADOWS_CACHE_MAX_LIGHTS>> Lights;
+
+    ~ShadowsCustomBuffer()
+    {
+        for (auto& light : Lights)
+            light.Release();
+    }
+
+    void OnSceneRenderingDirty(const BoundingSphere& objectBounds)
+    {
+        for (auto& light : Lights)
+        {
+            const float radius = (float)objectBounds.Radius + light.Radius;
+            if (Float3::DistanceSquared(Float3(objectBounds.Center - Origin), light.Position) <= radius * radius)
+                light.StaticValid = false;
+        }
+    }
+
+    // [ISceneRenderingListener]
+    void OnSceneRenderingAddActor(Actor* a) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+            OnSceneRenderingDirty(a->GetSphere());
+    }
+
+    void OnSceneRenderingUpdateActor(Actor* a, const BoundingSphere& prevBounds) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+        {
+            OnSceneRenderingDirty(prevBounds);
+            OnSceneRenderingDirty(a->GetSphere());
+        }
+    }
+
+    void OnSceneRenderingRemoveActor(Actor* a) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+            OnSceneRenderingDirty(a->GetSphere());
+    }
+
+    void OnSceneRenderingClear(SceneRendering* scene) override
+    {
+        for (auto& light : Lights)
+            light.StaticValid = false;
+    }
+};
+
 ShadowsPass::ShadowsPass()
     : _shader(nullptr)
     , _shadowMapsSizeCSM(0)
     , _shadowMapsSizeCube(0)
+    , _shadowMapsSizeAtlas(0)
     , _shadowMapCSM(nullptr)
-    , _shadowMapCube(nullptr)
+    , _shadowMapAtlas(nullptr)
+    , _shadowMapAtlasTiles(nullptr)
+    , _shadowMapAtlasCleared(false)
     , _currentShadowMapsQuality((Quality)((int32)Quality::Ultra + 1))
     , _sphereModel(nullptr)
     , maxShadowsQuality(0)
@@ -46,8 +159,8 @@ uint64 ShadowsPass::GetShadowMapsMemoryUsage() const
 
     if (_shadowMapCSM)
         result += _shadowMapCSM->GetMemoryUsage();
-    if (_shadowMapCube)
-        result += _shadowMapCube->GetMemoryUsage();
+    if (_shadowMapAtlas)
+        result += _shadowMapAtlas->GetMemoryUsage();
 
     return result;
 }
@@ -74,7 +187,7 @@ bool ShadowsPass::Init()
 
     // Create shadow maps
     _shadowMapCSM = GPUDevice::Instance->CreateTexture(TEXT("Shadow Map CSM"));
-    _shadowMapCube = GPUDevice::Instance->CreateTexture(TEXT("Shadow Map Cube"));
+    _shadowMapAtlas = GPUDevice::Instance->CreateTexture(TEXT("Shadow Map Atlas"));
 
 #if COMPILE_WITH_DEV_ENV
     _shader.Get()->OnReloading.Bind<ShadowsPass, &ShadowsPass::OnShaderReloading>(this);
@@ -143,6 +256,7 @@ void ShadowsPass::updateShadowMapSize()
     // Temporary data
     int32 newSizeCSM = 0;
     int32 newSizeCube = 0;
+    int32 newSizeAtlas = 0;
 
     // Select new size
     _currentShadowMapsQuality = Graphics::ShadowMapsQuality;
@@ -153,18 +267,22 @@ void ShadowsPass::updateShadowMapSize()
         case Quality::Ultra:
             newSizeCSM = 2048;
             newSizeCube = 1024;
+            newSizeAtlas = 4096;
             break;
         case Quality::High:
             newSizeCSM = 1024;
             newSizeCube = 1024;
+            newSizeAtlas = 4096;
             break;
         case Quality::Medium:
             newSizeCSM = 1024;
             newSizeCube = 512;
+            newSizeAtlas = 2048;
             break;
         case Quality::Low:
             newSizeCSM = 512;
             newSizeCube = 256;
+            newSizeAtlas = 1024;
             break;
         }
     }
@@ -179,15 +297,44 @@ void ShadowsPass::updateShadowMapSize()
         }
         _shadowMapsSizeCSM = newSizeCSM;
     }
-    if (newSizeCube > 0 && newSizeCube != _shadowMapsSizeCube)
+    if (newSizeAtlas > 0 && newSizeAtlas != _shadowMapsSizeAtlas)
     {
-        if (_shadowMapCube->Init(GPUTextureDescription::NewCube(newSizeCube, SHADOW_MAPS_FORMAT, GPUTextureFlags::ShaderResource | GPUTextureFlags::DepthStencil)))
+        if (_shadowMapAtlas->Init(GPUTextureDescription::New2D(newSizeAtlas, newSizeAtlas, SHADOW_MAPS_FORMAT, GPUTextureFlags::ShaderResource | GPUTextureFlags::DepthStencil)))
         {
-            LOG(Fatal, "Cannot setup shadow map '{0}' Size: {1}, format: {2}.", TEXT("Cube"), newSizeCube, (int32)SHADOW_MAPS_FORMAT);
+            LOG(Fatal, "Cannot setup shadow map '{0}' Size: {1}, format: {2}.", TEXT("Atlas"), newSizeAtlas, (int32)SHADOW_MAPS_FORMAT);
             return;
         }
+        _shadowMapsSizeAtlas = newSizeAtlas;
+    }
+    if (newSizeCube > 0)
         _shadowMapsSizeCube = newSizeCube;
+}
+
+int32 ShadowsPass::GetShadowMapResolution(const RenderView& view, const Float3& position, float radius) const
+{
+    // Scale the local light shadow map resolution with the light screen coverage
+    const float screenRadius = Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(position, radius, view));
+    const float coverage = Math::Saturate(screenRadius * 2.0f);
+    const int32 resolution = Math::RoundUpToPowerOf2((int32)(coverage * (float)_shadowMapsSizeCube));
+    return Math::Clamp(resolution, SHADOWS_MIN_RESOLUTION, Math::Max(_shadowMapsSizeCube, SHADOWS_MIN_RESOLUTION));
+}
+
+bool ShadowsPass::AllocateAtlasTile(ShadowData& shadowData, int32 resolution)
+{
+    // Try to fit the shadow map into the atlas (reduce resolution if atlas is full)
+    ShadowAtlasTile* tile = nullptr;
+    while (!tile && resolution >= SHADOWS_MIN_RESOLUTION)
+    {
+        tile = _shadowMapAtlasTiles->Insert((uint16)resolution, (uint16)resolution, SHADOWS_ATLAS_PADDING);
+        if (!tile)
+            resolution /= 2;
     }
+    if (!tile)
+        return true;
+    shadowData.UseAtlas = true;
+    shadowData.Resolution = resolution;
+    shadowData.Viewport = Viewport((float)tile->X, (float)tile->Y, (float)resolution, (float)resolution);
+    return false;
 }
 
 void ShadowsPass::SetupRenderContext(RenderContext& renderContext, RenderContext& shadowContext)
@@ -203,7 +350,7 @@ void ShadowsPass::SetupRenderContext(RenderContext& renderContext, RenderContext
     shadowView.StaticFlagsMask = view.StaticFlagsMask;
     shadowView.RenderLayersMask = view.RenderLayersMask;
     shadowView.IsOfflinePass = view.IsOfflinePass;
-    shadowView.ModelLODBias = view.ModelLODBias;
+    shadowView.ModelLODBias = view.ModelLODBias + Graphics::ShadowsModelLODBias;
     shadowView.ModelLODDistanceFactor = view.ModelLODDistanceFactor;
     shadowView.Pass = DrawPass::Depth;
     shadowView.Origin = view.Origin;
@@ -329,6 +476,12 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
     shadowData.ContextIndex = renderContextBatch.Contexts.Count();
     shadowData.ContextCount = csmCount;
     shadowData.BlendCSM = blendCSM;
+    shadowData.RenderStatic = true;
+    shadowData.UseAtlas = false;
+    shadowData.Resolution = _shadowMapsSizeCSM;
+    shadowData.Viewport = Viewport(0, 0, shadowMapsSizeCSM, shadowMapsSizeCSM);
+    shadowData.Cache = nullptr;
+    shadowData.ShadowMap = nullptr;
     renderContextBatch.Contexts.AddDefault(shadowData.ContextCount);
 
     // Create the different view and projection matrices for each split
@@ -452,15 +605,24 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
 
 void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererPointLightData& light)
 {
+    const auto& view = renderContext.View;
+    const int32 resolution = GetShadowMapResolution(view, light.Position, light.Radius);
+
     // Init shadow data
     light.ShadowDataIndex = _shadowData.Count();
     auto& shadowData = _shadowData.AddOne();
     shadowData.ContextIndex = renderContextBatch.Contexts.Count();
     shadowData.ContextCount = 6;
+    shadowData.BlendCSM = false;
+    shadowData.UseAtlas = false;
+    shadowData.Resolution = resolution;
+    shadowData.Viewport = Viewport(0, 0, (float)resolution, (float)resolution);
+    shadowData.Cache = SetupLightCache(renderContext, light.ID, light.StaticFlags, light.Position, Float3::Zero, light.Radius, 0.0f, resolution, true);
+    shadowData.ShadowMap = nullptr;
+    shadowData.RenderStatic = !shadowData.Cache || !shadowData.Cache->StaticValid;
     renderContextBatch.Contexts.AddDefault(shadowData.ContextCount);
 
-    const auto& view = renderContext.View;
-    const auto shadowMapsSizeCube = (float)_shadowMapsSizeCube;
+    const auto shadowMapsSizeCube = (float)resolution;
 
     // Fade shadow on distance
     const float fadeDistance = Math::Max(light.ShadowsFadeDistance, 0.1f);
@@ -473,6 +635,7 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
         SetupRenderContext(renderContext, shadowContext);
         shadowContext.List->Clear();
+        shadowContext.List->SkipStaticShadowCasters = !shadowData.RenderStatic;
         shadowContext.View.SetUpCube(PointLight_NearPlane, light.Radius, light.Position);
         shadowContext.View.SetFace(faceIndex);
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
@@ -492,15 +655,25 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
 
 void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererSpotLightData& light)
 {
-    // Init shadow data
-    light.ShadowDataIndex = _shadowData.Count();
-    auto& shadowData = _shadowData.AddOne();
-    shadowData.ContextIndex = renderContextBatch.Contexts.Count();
+    const auto& view = renderContext.View;
+    const int32 resolution = GetShadowMapResolution(view, light.Position, light.Radius);
+
+    // Init shadow data (lights without a cached shadow map are rendered into the shared atlas)
+    ShadowData shadowData;
     shadowData.ContextCount = 1;
+    shadowData.BlendCSM = false;
+    shadowData.UseAtlas = false;
+    shadowData.Resolution = resolution;
+    shadowData.Viewport = Viewport(0, 0, (float)resolution, (float)resolution);
+    shadowData.Cache = SetupLightCache(renderContext, light.ID, light.StaticFlags, light.Position, light.Direction, light.Radius, light.OuterConeAngle, resolution, false);
+    shadowData.ShadowMap = nullptr;
+    shadowData.RenderStatic = !shadowData.Cache || !shadowData.Cache->StaticValid;
+    if (!shadowData.Cache && AllocateAtlasTile(shadowData, resolution))
+        return;
+    shadowData.ContextIndex = renderContextBatch.Contexts.Count();
     renderContextBatch.Contexts.AddDefault(shadowData.ContextCount);
 
-    const auto& view = renderContext.View;
-    const auto shadowMapsSizeCube = (float)_shadowMapsSizeCube;
+    const auto shadowMapsSizeCube = (float)shadowData.Resolution;
 
     // Fade shadow on distance
     const float fadeDistance = Math::Max(light.ShadowsFadeDistance, 0.1f);
@@ -513,13 +686,25 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
         SetupRenderContext(renderContext, shadowContext);
         shadowContext.List->Clear();
+        shadowContext.List->SkipStaticShadowCasters = !shadowData.RenderStatic;
         shadowContext.View.SetProjector(SpotLight_NearPlane, light.Radius, light.Position, light.Direction, light.UpVector, light.OuterConeAngle * 2.0f);
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
-        Matrix::Transpose(shadowContext.View.ViewProjection(), shadowData.Constants.ShadowVP[faceIndex]);
+        Matrix shadowVP = shadowContext.View.ViewProjection();
+        if (shadowData.UseAtlas)
+        {
+            // Remap projection into the atlas tile
+            const float atlasSizeInv = 1.0f / (float)_shadowMapsSizeAtlas;
+            const float scale = shadowData.Viewport.Width * atlasSizeInv;
+            Matrix tileMatrix = Matrix::Scaling(scale, scale, 1.0f);
+            tileMatrix.M41 = scale + 2.0f * shadowData.Viewport.X * atlasSizeInv - 1.0f;
+            tileMatrix.M42 = 1.0f - scale - 2.0f * shadowData.Viewport.Y * atlasSizeInv;
+            shadowVP = shadowVP * tileMatrix;
+        }
+        Matrix::Transpose(shadowVP, shadowData.Constants.ShadowVP[faceIndex]);
     }
 
     // Setup constant buffer data
-    shadowData.Constants.ShadowMapSize = shadowMapsSizeCube;
+    shadowData.Constants.ShadowMapSize = shadowData.UseAtlas ? (float)_shadowMapsSizeAtlas : shadowMapsSizeCube;
     shadowData.Constants.Sharpness = light.ShadowsSharpness;
     shadowData.Constants.Fade = Math::Saturate(light.ShadowsStrength * fade);
     shadowData.Constants.NormalOffsetScale = light.ShadowsNormalOffsetScale * NormalOffsetScaleTweak * (1.0f / shadowMapsSizeCube);
@@ -527,6 +712,8 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
     shadowData.Constants.FadeDistance = Math::Max(light.ShadowsFadeDistance, 0.1f);
     shadowData.Constants.NumCascades = 1;
     shadowData.Constants.CascadeSplits = Float4::Zero;
+    light.ShadowDataIndex = _shadowData.Count();
+    _shadowData.Add(shadowData);
 }
 
 void ShadowsPass::Dispose()
@@ -541,7 +728,165 @@ void ShadowsPass::Dispose()
     _shader = nullptr;
     _sphereModel = nullptr;
     SAFE_DELETE_GPU_RESOURCE(_shadowMapCSM);
-    SAFE_DELETE_GPU_RESOURCE(_shadowMapCube);
+    SAFE_DELETE_GPU_RESOURCE(_shadowMapAtlas);
+    if (_shadowMapAtlasTiles)
+    {
+        Delete(_shadowMapAtlasTiles);
+        _shadowMapAtlasTiles = nullptr;
+    }
+}
+
+ShadowsLightCache* ShadowsPass::SetupLightCache(RenderContext& renderContext, const Guid& id, StaticFlags staticFlags, const Float3& position, const Float3& direction, float radius, float angle, int32 resolution, bool isCube)
+{
+    if (!_cache || !EnumHasAllFlags(staticFlags, StaticFlags::Transform))
+        return nullptr;
+
+    // Find or add the light cache
+    ShadowsLightCache* cache = nullptr;
+    for (auto& e : _cache->Lights)
+    {
+        if (e.ID == id)
+        {
+            cache = &e;
+            break;
+        }
+    }
+    if (!cache)
+    {
+        if (_cache->Lights.Count() == SHADOWS_CACHE_MAX_LIGHTS)
+            return nullptr;
+        cache = &_cache->Lights.AddOne();
+        cache->ID = id;
+        cache->StaticShadowMap = nullptr;
+        cache->ShadowMap = nullptr;
+        cache->Size = 0;
+        cache->UpdateProgress = 0.0f;
+        cache->StaticValid = false;
+        cache->DynamicValid = false;
+    }
+    cache->LastFrameUsed = Engine::FrameCount;
+
+    // Invalidate cache if light projection or shadow map resolution changes
+    const int32 size = resolution;
+    if (cache->Position != position || cache->Direction != direction || cache->Radius != radius || cache->Angle != angle || cache->Size != size)
+    {
+        cache->Position = position;
+        cache->Direction = direction;
+        cache->Radius = radius;
+        cache->Angle = angle;
+        cache->Size = size;
+        cache->StaticValid = false;
+        cache->Release();
+    }
+    if (!cache->StaticShadowMap)
+    {
+        const auto flags = GPUTextureFlags::ShaderResource | GPUTextureFlags::DepthStencil;
+        const auto desc = isCube ? GPUTextureDescription::NewCube(size, SHADOW_MAPS_FORMAT, flags) : GPUTextureDescription::New2D(size, size, SHADOW_MAPS_FORMAT, flags);
+        cache->StaticShadowMap = RenderTargetPool::Get(desc);
+        if (!cache->StaticShadowMap)
+            return nullptr;
+        RENDER_TARGET_POOL_SET_NAME(cache->StaticShadowMap, "Shadows.Static");
+        cache->StaticValid = false;
+    }
+    return cache;
+}
+
+void ShadowsPass::RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, const ShadowData& shadowData, GPUTexture* shadowMap, bool drawStatic, bool drawDynamic)
+{
+    RenderContext& renderContext = renderContextBatch.GetMainContext();
+    for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+    {
+        const auto rt = shadowMap->View(faceIndex);
+        context->ResetSR();
+        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+        context->SetViewportAndScissors(shadowData.Viewport);
+        if (drawStatic && !shadowData.UseAtlas)
+            context->ClearDepth(rt);
+        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
+        if (drawDynamic)
+        {
+            shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
+            shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
+        }
+        if (drawStatic)
+            shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthStaticDrawCallsList, renderContext.List->DrawCalls, nullptr);
+    }
+}
+
+GPUTextureView* ShadowsPass::RenderShadowMaps(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, float updateRate, bool isCube)
+{
+    ShadowsLightCache* cache = shadowData.Cache;
+    if (!cache)
+    {
+        if (isCube)
+        {
+            // Render all shadow casters into the temporary cube map
+            const auto desc = GPUTextureDescription::NewCube(shadowData.Resolution, SHADOW_MAPS_FORMAT, GPUTextureFlags::ShaderResource | GPUTextureFlags::DepthStencil);
+            shadowData.ShadowMap = RenderTargetPool::Get(desc);
+            if (!shadowData.ShadowMap)
+                return nullptr;
+            RENDER_TARGET_POOL_SET_NAME(shadowData.ShadowMap, "Shadows.Cube");
+            RenderShadowMap(context, renderContextBatch, shadowData, shadowData.ShadowMap, true, true);
+            return shadowData.ShadowMap->ViewArray();
+        }
+
+        // Render all shadow casters into the atlas tile (atlas is cleared once per frame)
+        if (!_shadowMapAtlasCleared)
+        {
+            _shadowMapAtlasCleared = true;
+            context->ClearDepth(_shadowMapAtlas->View());
+        }
+        RenderShadowMap(context, renderContextBatch, shadowData, _shadowMapAtlas, true, true);
+        return _shadowMapAtlas->View();
+    }
+
+    // Render static shadow casters only if they were changed
+    if (shadowData.RenderStatic)
+    {
+        RenderShadowMap(context, renderContextBatch, shadowData, cache->StaticShadowMap, true, false);
+        cache->StaticValid = true;
+        cache->DynamicValid = false;
+    }
+
+    // Draw dynamic shadow casters on top of the cached static shadow map (time-sliced by the light update rate)
+    bool hasDynamic = false;
+    for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount && !hasDynamic; faceIndex++)
+    {
+        const RenderList* list = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex].List;
+        hasDynamic = !list->DrawCallsLists[(int32)DrawCallsListType::Depth].IsEmpty() || !list->ShadowDepthDrawCallsList.IsEmpty();
+    }
+    GPUTexture* shadowMap = cache->StaticShadowMap;
+    if (hasDynamic)
+    {
+        cache->UpdateProgress += updateRate;
+        if (!cache->DynamicValid || cache->UpdateProgress >= 1.0f)
+        {
+            cache->UpdateProgress = Math::Max(cache->UpdateProgress - 1.0f, 0.0f);
+            if (!cache->ShadowMap)
+            {
+                cache->ShadowMap = RenderTargetPool::Get(cache->StaticShadowMap->GetDescription());
+                RENDER_TARGET_POOL_SET_NAME(cache->ShadowMap, "Shadows.Dynamic");
+            }
+            if (cache->ShadowMap)
+            {
+                context->ResetSR();
+                context->ResetRenderTarget();
+                context->CopyResource(cache->ShadowMap, cache->StaticShadowMap);
+                RenderShadowMap(context, renderContextBatch, shadowData, cache->ShadowMap, false, true);
+                cache->DynamicValid = true;
+            }
+        }
+        if (cache->ShadowMap && cache->DynamicValid)
+            shadowMap = cache->ShadowMap;
+    }
+    else if (cache->ShadowMap)
+    {
+        // Free the memory when no dynamic objects are in the light range
+        RenderTargetPool::Release(cache->ShadowMap);
+        cache->ShadowMap = nullptr;
+        cache->DynamicValid = false;
+    }
+    return isCube ? shadowMap->ViewArray() : shadowMap->View();
 }
 
 void ShadowsPass::SetupShadows(RenderContext& renderContext, RenderContextBatch& renderContextBatch)
@@ -557,6 +902,32 @@ void ShadowsPass::SetupShadows(RenderContext& renderContext, RenderContextBatch&
     auto shadowsQuality = Graphics::ShadowsQuality;
     maxShadowsQuality = Math::Clamp(Math::Min<int32>(static_cast<int32>(shadowsQuality), static_cast<int32>(view.MaxShadowsQuality)), 0, static_cast<int32>(Quality::MAX) - 1);
 
+    // Reset the local lights shadow atlas
+    if (_shadowMapAtlasTiles)
+        Delete(_shadowMapAtlasTiles);
+    _shadowMapAtlasTiles = New<ShadowAtlasTile>(0, 0, _shadowMapsSizeAtlas, _shadowMapsSizeAtlas);
+    _shadowMapAtlasCleared = false;
+
+    // Prepare the shadow maps cache for the static lights
+    _cache = nullptr;
+    if (!view.IsOfflinePass && !view.IsSingleFrame && renderContext.Buffers)
+    {
+        _cache = renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"));
+        _cache->LastFrameUsed = Engine::FrameCount;
+        _cache->Origin = view.Origin;
+        for (SceneRendering* scene : renderContext.List->Scenes)
+            _cache->ListenSceneRendering(scene);
+        for (int32 i = _cache->Lights.Count() - 1; i >= 0; i--)
+        {
+            auto& light = _cache->Lights[i];
+            if (light.LastFrameUsed + SHADOWS_CACHE_RELEASE_FRAMES < Engine::FrameCount)
+            {
+                light.Release();
+                _cache->Lights.RemoveAt(i);
+            }
+        }
+    }
+
     // Create shadow projections for lights
     for (auto& light : renderContext.List->DirectionalLights)
     {
@@ -619,21 +990,12 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererP
     // TODO: here we can use lower shadows quality based on light distance to view (LOD switching) and per light setting for max quality
     int32 shadowQuality = maxShadowsQuality;
 
-    // Set up GPU context and render view
-    const auto shadowMapsSizeCube = (float)_shadowMapsSizeCube;
-    context->SetViewportAndScissors(shadowMapsSizeCube, shadowMapsSizeCube);
-
     // Render depth to all 6 faces of the cube map
-    for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    const float updateDistance = Math::Saturate((Float3::Distance(light.Position, view.Position) - light.Radius) / Math::Max(light.ShadowsDistance, 1.0f));
+    const float updateRate = Math::Lerp(light.ShadowsUpdateRate, light.ShadowsUpdateRateAtDistance, updateDistance);
+    GPUTextureView* shadowMap = RenderShadowMaps(context, renderContextBatch, shadowData, updateRate, true);
+    if (!shadowMap)
+        return;
 
     // Restore GPU context
     context->ResetSR();
@@ -669,7 +1031,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererP
     context->UpdateCB(shader->GetCB(0), &sperLight);
     context->BindCB(0, shader->GetCB(0));
     context->BindCB(1, shader->GetCB(1));
-    context->BindSR(5, _shadowMapCube->ViewArray());
+    context->BindSR(5, shadowMap);
     context->SetRenderTarget(shadowMask);
     context->SetState(_psShadowPoint.Get(shadowQuality + (sperLight.ContactShadowsLength > ZeroTolerance ? 4 : 0)));
     _sphereModel->Render(context);
@@ -679,7 +1041,14 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererP
     context->UnBindSR(5);
 
     // Render volumetric light with shadow
-    VolumetricFogPass::Instance()->RenderLight(renderContext, context, light, _shadowMapCube->ViewArray(), sperLight.LightShadow);
+    VolumetricFogPass::Instance()->RenderLight(renderContext, context, light, shadowMap, sperLight.LightShadow);
+
+    // Release the temporary shadow map
+    if (shadowData.ShadowMap)
+    {
+        RenderTargetPool::Release(shadowData.ShadowMap);
+        shadowData.ShadowMap = nullptr;
+    }
 }
 
 void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererSpotLightData& light, GPUTextureView* shadowMask)
@@ -697,21 +1066,10 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererS
     // TODO: here we can use lower shadows quality based on light distance to view (LOD switching) and per light setting for max quality
     int32 shadowQuality = maxShadowsQuality;
 
-    // Set up GPU context and render view
-    const auto shadowMapsSizeCube = (float)_shadowMapsSizeCube;
-    context->SetViewportAndScissors(shadowMapsSizeCube, shadowMapsSizeCube);
-
-    // Render depth to all 1 face of the cube map
-    constexpr int32 faceIndex = 0;
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    // Render depth to the shadow map
+    const float updateDistance = Math::Saturate((Float3::Distance(light.Position, view.Position) - light.Radius) / Math::Max(light.ShadowsDistance, 1.0f));
+    const float updateRate = Math::Lerp(light.ShadowsUpdateRate, light.ShadowsUpdateRateAtDistance, updateDistance);
+    GPUTextureView* shadowMap = RenderShadowMaps(context, renderContextBatch, shadowData, updateRate, false);
 
     // Restore GPU context
     context->ResetSR();
@@ -747,7 +1105,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererS
     context->UpdateCB(shader->GetCB(0), &sperLight);
     context->BindCB(0, shader->GetCB(0));
     context->BindCB(1, shader->GetCB(1));
-    context->BindSR(5, _shadowMapCube->View(faceIndex));
+    context->BindSR(5, shadowMap);
     context->SetRenderTarget(shadowMask);
     context->SetState(_psShadowSpot.Get(shadowQuality + (sperLight.ContactShadowsLength > ZeroTolerance ? 4 : 0)));
     _sphereModel->Render(context);
@@ -757,7 +1115,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererS
     context->UnBindSR(5);
 
     // Render volumetric light with shadow
-    VolumetricFogPass::Instance()->RenderLight(renderContext, context, light, _shadowMapCube->View(faceIndex), sperLight.LightShadow);
+    VolumetricFogPass::Instance()->RenderLight(renderContext, context, light, shadowMap, sperLight.LightShadow);
 }
 
 void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererDirectionalLightData& light, int32 index, GPUTextureView* shadowMask)
@@ -768,20 +1126,9 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererD
     GPUContext* context = GPUDevice::Instance->GetMainContext();
     RenderContext& renderContext = renderContextBatch.GetMainContext();
     ShadowData& shadowData = _shadowData[light.ShadowDataIndex];
-    const float shadowMapsSizeCSM = (float)_shadowMapsSizeCSM;
-    context->SetViewportAndScissors(shadowMapsSizeCSM, shadowMapsSizeCSM);
 
     // Render shadow map for each projection
-    for (int32 cascadeIndex = 0; cascadeIndex < shadowData.ContextCount; cascadeIndex++)
-    {
-        const auto rt = _shadowMapCSM->View(cascadeIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + cascadeIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, _shadowMapCSM, true, true);
 
     // Restore GPU context
     context->ResetSR();
@@ -8,12 +8,17 @@
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Graphics/RenderTask.h"
+#include "Engine/Core/Math/Viewport.h"
 
 /// <summary>
 /// Pixel format for fullscreen render target used for shadows calculations
 /// </summary>
 #define SHADOWS_PASS_SS_RR_FORMAT PixelFormat::R11G11B10_Float
 
+struct ShadowsLightCache;
+struct ShadowAtlasTile;
+class ShadowsCustomBuffer;
+
 template<typename T>
 bool CanRenderShadow(const RenderView& view, const T& light)
 {
@@ -47,6 +52,12 @@ class ShadowsPass : public RendererPass<ShadowsPass>
         int32 ContextIndex;
         int32 ContextCount;
         bool BlendCSM;
+        bool RenderStatic;
+        bool UseAtlas;
+        int32 Resolution;
+        Viewport Viewport;
+        ShadowsLightCache* Cache;
+        GPUTexture* ShadowMap;
         LightShadowData Constants;
     };
 
@@ -60,8 +71,11 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     // Shadow maps stuff
     int32 _shadowMapsSizeCSM;
     int32 _shadowMapsSizeCube;
+    int32 _shadowMapsSizeAtlas;
     GPUTexture* _shadowMapCSM;
-    GPUTexture* _shadowMapCube;
+    GPUTexture* _shadowMapAtlas;
+    ShadowAtlasTile* _shadowMapAtlasTiles;
+    bool _shadowMapAtlasCleared;
     Quality _currentShadowMapsQuality;
 
     // Shadow map rendering stuff
@@ -70,6 +84,7 @@ class ShadowsPass : public RendererPass<ShadowsPass>
 
     // Cached state for the current frame rendering (setup via Prepare)
     int32 maxShadowsQuality;
+    ShadowsCustomBuffer* _cache = nullptr;
 
 public:
 
@@ -151,10 +166,15 @@ class ShadowsPass : public RendererPass<ShadowsPass>
 private:
 
     void updateShadowMapSize();
+    int32 GetShadowMapResolution(const RenderView& view, const Float3& position, float radius) const;
+    bool AllocateAtlasTile(ShadowData& shadowData, int32 resolution);
     void SetupRenderContext(RenderContext& renderContext, RenderContext& shadowContext);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererDirectionalLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererPointLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererSpotLightData& light);
+    ShadowsLightCache* SetupLightCache(RenderContext& renderContext, const Guid& id, StaticFlags staticFlags, const Float3& position, const Float3& direction, float radius, float angle, int32 resolution, bool isCube);
+    void RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, const ShadowData& shadowData, GPUTexture* shadowMap, bool drawStatic, bool drawDynamic);
+    GPUTextureView* RenderShadowMaps(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, float updateRate, bool isCube);
 
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj)
@@ -0,0 +1,256 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "TerrainVirtualTexturePass.h"
+#include "RenderList.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Content/Assets/MaterialBase.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Terrain/Terrain.h"
+#include "Engine/Terrain/TerrainPatch.h"
+#include "Engine/Terrain/TerrainChunk.h"
+
+// The amount of frames after which unused atlas gets released
+#define TERRAIN_VIRTUAL_TEXTURE_ATLAS_LIFETIME 60
+
+#define PAGES_COUNT_EDGE (TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION / TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION)
+
+String TerrainVirtualTexturePass::ToString() const
+{
+    return TEXT("TerrainVirtualTexturePass");
+}
+
+bool TerrainVirtualTexturePass::Init()
+{
+    ReleaseAtlas();
+    return false;
+}
+
+void TerrainVirtualTexturePass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    ReleaseAtlas();
+}
+
+void TerrainVirtualTexturePass::ReleaseAtlas()
+{
+    for (GPUTexture*& texture : _atlas)
+    {
+        RenderTargetPool::Release(texture);
+        texture = nullptr;
+    }
+    for (Page& page : _pages)
+    {
+        page.Chunk = nullptr;
+        page.Material = nullptr;
+        page.Version = 0;
+        page.LastFrameUsed = 0;
+        page.IsBaked = false;
+    }
+    _chunkToPage.Clear();
+    _pendingPages.Clear();
+}
+
+bool TerrainVirtualTexturePass::GetPage(const TerrainChunk* chunk, MaterialBase* material, uint32 version, Float4& uvScaleBias)
+{
+    ScopeLock lock(_locker);
+    const uint64 frame = Engine::FrameCount;
+    int32 pageIndex;
+    if (_chunkToPage.TryGet(chunk, pageIndex))
+    {
+        Page& page = _pages[pageIndex];
+        if (page.Material != material || page.Version != version || !page.IsBaked)
+        {
+            // Rebake outdated page (keep using it until it's updated)
+            page.Material = material;
+            page.Version = version;
+            if (!_pendingPages.Contains(pageIndex))
+                _pendingPages.Add(pageIndex);
+        }
+        page.LastFrameUsed = frame;
+        if (!page.IsBaked)
+            return false;
+    }
+    else
+    {
+        // Find the free or the least recently used page (pages used in this frame cannot be reused)
+        pageIndex = -1;
+        uint64 minFrameUsed = frame;
+        for (int32 i = 0; i < ARRAY_COUNT(_pages); i++)
+        {
+            if (_pages[i].Chunk == nullptr)
+            {
+                pageIndex = i;
+                break;
+            }
+            if (_pages[i].LastFrameUsed < minFrameUsed)
+            {
+                minFrameUsed = _pages[i].LastFrameUsed;
+                pageIndex = i;
+            }
+        }
+        if (pageIndex == -1)
+            return false;
+        Page& page = _pages[pageIndex];
+        if (page.Chunk)
+            _chunkToPage.Remove(page.Chunk);
+        page.Chunk = chunk;
+        page.Material = material;
+        page.Version = version;
+        page.LastFrameUsed = frame;
+        page.IsBaked = false;
+        _chunkToPage.Add(chunk, pageIndex);
+        if (!_pendingPages.Contains(pageIndex))
+            _pendingPages.Add(pageIndex);
+        return false;
+    }
+
+    // Chunk UVs are mapped into the inner area of the page (with the border for filtering), page is baked from the top so V axis is flipped
+    const float scale = (float)(TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION - 2 * TERRAIN_VIRTUAL_TEXTURE_PAGE_PADDING) / TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION;
+    const float pageX = (float)(pageIndex % PAGES_COUNT_EDGE * TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION + TERRAIN_VIRTUAL_TEXTURE_PAGE_PADDING) / TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION;
+    const float pageY = (float)(pageIndex / PAGES_COUNT_EDGE * TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION + TERRAIN_VIRTUAL_TEXTURE_PAGE_PADDING) / TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION;
+    uvScaleBias = Float4(scale, -scale, pageX, pageY + scale);
+    return true;
+}
+
+void TerrainVirtualTexturePass::Invalidate(const Terrain* terrain)
+{
+    ScopeLock lock(_locker);
+    for (int32 i = 0; i < ARRAY_COUNT(_pages); i++)
+    {
+        Page& page = _pages[i];
+        if (page.Chunk && page.Chunk->GetPatch()->GetTerrain() == terrain)
+        {
+            _chunkToPage.Remove(page.Chunk);
+            _pendingPages.Remove(i);
+            page.Chunk = nullptr;
+            page.Material = nullptr;
+            page.LastFrameUsed = 0;
+            page.IsBaked = false;
+        }
+    }
+}
+
+void TerrainVirtualTexturePass::Execute(const RenderContext& renderContext, GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    const uint64 frame = Engine::FrameCount;
+    if (_pendingPages.IsEmpty())
+    {
+        // Release atlas when it's not used
+        if (_atlas[0])
+        {
+            bool anyUsed = false;
+            for (const Page& page : _pages)
+                anyUsed |= page.Chunk && page.LastFrameUsed + TERRAIN_VIRTUAL_TEXTURE_ATLAS_LIFETIME >= frame;
+            if (!anyUsed)
+                ReleaseAtlas();
+        }
+        return;
+    }
+    PROFILE_GPU_CPU("Terrain Virtual Texture");
+
+    // Allocate atlas
+    if (!_atlas[0])
+    {
+        auto desc = GPUTextureDescription::New2D(TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION, TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION, PixelFormat::Unknown);
+        const PixelFormat formats[3] = { GBUFFER0_FORMAT, GBUFFER1_FORMAT, GBUFFER2_FORMAT };
+        for (int32 i = 0; i < 3; i++)
+        {
+            desc.Format = formats[i];
+            _atlas[i] = RenderTargetPool::Get(desc);
+            if (!_atlas[i])
+            {
+                ReleaseAtlas();
+                return;
+            }
+            RENDER_TARGET_POOL_SET_NAME(_atlas[i], "TerrainVirtualTexture.Atlas");
+        }
+    }
+    auto lightDesc = GPUTextureDescription::New2D(TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION, TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION, PixelFormat::R11G11B10_Float);
+    auto lightBuffer = RenderTargetPool::Get(lightDesc);
+    if (!lightBuffer)
+        return;
+    RENDER_TARGET_POOL_SET_NAME(lightBuffer, "TerrainVirtualTexture.Light");
+
+    // Setup view for baking (material layers are evaluated with the virtual texture disabled, see TerrainChunk::Draw)
+    RenderContext renderContextBake = renderContext;
+    renderContextBake.List = RenderList::GetFromPool();
+    renderContextBake.View.Pass = DrawPass::GBuffer;
+    renderContextBake.View.Mode = ViewMode::Default;
+    renderContextBake.View.IsSingleFrame = true;
+    renderContextBake.View.IsCullingDisabled = true;
+    renderContextBake.View.Prepare(renderContextBake);
+    auto& drawCallsList = renderContextBake.List->DrawCallsLists[(int32)DrawCallsListType::GBuffer];
+    drawCallsList.CanUseInstancing = false;
+
+    // Bake pages (limited amount per frame)
+    const int32 bakesCount = Math::Min(_pendingPages.Count(), TERRAIN_VIRTUAL_TEXTURE_MAX_BAKES_PER_FRAME);
+    const float pageScale = (float)TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION / (TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION - 2 * TERRAIN_VIRTUAL_TEXTURE_PAGE_PADDING);
+    for (int32 i = 0; i < bakesCount; i++)
+    {
+        const int32 pageIndex = _pendingPages[i];
+        Page& page = _pages[pageIndex];
+        if (!page.Chunk || !page.Material || !page.Material->IsReady())
+            continue;
+        const TerrainChunk* chunk = page.Chunk;
+
+        // Collect draw calls
+        renderContextBake.List->DrawCalls.Clear();
+        renderContextBake.List->BatchedDrawCalls.Clear();
+        drawCallsList.Indices.Clear();
+        drawCallsList.PreBatchedDrawCalls.Clear();
+        chunk->Draw(renderContextBake, page.Material, 0);
+
+        // Setup orthographic projection to capture chunk from the top (in chunk local-space to support rotated terrains)
+        Matrix world;
+        renderContextBake.View.GetWorldMatrix(chunk->GetTransform(), world);
+        const float chunkSize = TERRAIN_UNITS_PER_VERTEX * chunk->GetPatch()->GetTerrain()->GetChunkSize();
+        Float3 right, up, forward, center;
+        Float3::TransformNormal(Float3::Right, world, right);
+        Float3::TransformNormal(Float3::Up, world, up);
+        Float3::TransformNormal(Float3::Forward, world, forward);
+        Float3::Transform(Float3(chunkSize * 0.5f, 1.0f, chunkSize * 0.5f), world, center);
+        const float height = up.Length();
+        const float margin = 10.0f;
+        center += up * (margin / Math::Max(height, ZeroTolerance));
+        Matrix viewMatrix, projectionMatrix;
+        Matrix::LookAt(center, center - up, forward, viewMatrix);
+        Matrix::Ortho(chunkSize * right.Length() * pageScale, chunkSize * forward.Length() * pageScale, 0.0f, height + 2 * margin, projectionMatrix);
+        renderContextBake.View.Position = center;
+        renderContextBake.View.Direction = -up.GetNormalized();
+        renderContextBake.View.Near = 0.0f;
+        renderContextBake.View.Far = height + 2 * margin;
+        renderContextBake.View.SetUp(viewMatrix, projectionMatrix);
+
+        // Draw
+        const Viewport viewport((float)(pageIndex % PAGES_COUNT_EDGE * TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION), (float)(pageIndex / PAGES_COUNT_EDGE * TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION), TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION, TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION);
+        GPUTextureView* targetBuffers[4] =
+        {
+            lightBuffer->View(),
+            _atlas[0]->View(),
+            _atlas[1]->View(),
+            _atlas[2]->View(),
+        };
+        context->SetRenderTarget(nullptr, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
+        context->SetViewportAndScissors(viewport);
+        renderContextBake.List->ExecuteDrawCalls(renderContextBake, drawCallsList);
+        page.IsBaked = true;
+    }
+    for (int32 i = 0; i < bakesCount; i++)
+        _pendingPages.RemoveAtKeepOrder(0);
+    context->ResetRenderTarget();
+    RenderList::ReturnToPool(renderContextBake.List);
+    RenderTargetPool::Release(lightBuffer);
+}
+
+void TerrainVirtualTexturePass::Bind(GPUContext* context, int32 slot) const
+{
+    for (int32 i = 0; i < ARRAY_COUNT(_atlas); i++)
+        context->BindSR(slot + i, _atlas[i]);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Threading/Threading.h"
+
+// The resolution of the terrain virtual texture atlas (per GBuffer channel texture)
+#define TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION 2048
+// The resolution of the single page (baked terrain chunk)
+#define TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION 256
+// The border (in texels) around the baked chunk within the page to prevent filtering artifacts on page edges
+#define TERRAIN_VIRTUAL_TEXTURE_PAGE_PADDING 2
+// The maximum amount of pages to bake in a single frame (time-slicing)
+#define TERRAIN_VIRTUAL_TEXTURE_MAX_BAKES_PER_FRAME 4
+
+class TerrainChunk;
+class Terrain;
+class MaterialBase;
+class GPUTexture;
+
+/// <summary>
+/// Terrain runtime virtual texture. Bakes the blended terrain material layers (albedo, normal, roughness, metalness and specular) of the chunks near the camera into the cached pages of the atlas (one page per chunk) so terrain pixel shaders can sample the baked surface instead of evaluating every layer each frame. Pages are rebaked only when the terrain data (heightmap, holes, splatmaps), its streamed resolution or material parameters change.
+/// </summary>
+/// <remarks>
+/// Pages are requested by the terrain chunks during drawing (see Terrain.VirtualTextureDistance) and baked after collecting the draw calls (limited amount per-frame), so the newly requested chunks use the regular material layers until their page is ready. Least recently used pages are reused for the new chunks when the atlas is full.
+/// </remarks>
+class TerrainVirtualTexturePass : public RendererPass<TerrainVirtualTexturePass>
+{
+private:
+    struct Page
+    {
+        const TerrainChunk* Chunk;
+        MaterialBase* Material;
+        uint32 Version;
+        uint64 LastFrameUsed;
+        bool IsBaked;
+    };
+
+    CriticalSection _locker;
+    Page _pages[(TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION / TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION) * (TERRAIN_VIRTUAL_TEXTURE_ATLAS_RESOLUTION / TERRAIN_VIRTUAL_TEXTURE_PAGE_RESOLUTION)];
+    Dictionary<const TerrainChunk*, int32> _chunkToPage;
+    Array<int32> _pendingPages;
+    GPUTexture* _atlas[3] = {};
+
+    void ReleaseAtlas();
+
+public:
+    /// <summary>
+    /// Gets the baked page of the terrain chunk virtual texture. Requests the page baking if it's missing or outdated. Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="chunk">The terrain chunk.</param>
+    /// <param name="material">The terrain chunk material.</param>
+    /// <param name="version">The version of the chunk data used to detect outdated pages (eg. after terrain modification).</param>
+    /// <param name="uvScaleBias">The result page UVs transformation (xy-scale, zw-offset) from the chunk UVs into the atlas UVs.</param>
+    /// <returns>True if page is ready to use, otherwise false.</returns>
+    bool GetPage(const TerrainChunk* chunk, MaterialBase* material, uint32 version, Float4& uvScaleBias);
+
+    /// <summary>
+    /// Releases the pages used by the terrain (eg. when it gets disabled or modified).
+    /// </summary>
+    /// <param name="terrain">The terrain.</param>
+    void Invalidate(const Terrain* terrain);
+
+    /// <summary>
+    /// Bakes the pages requested during drawing. Called by the renderer after collecting draw calls.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Execute(const RenderContext& renderContext, GPUContext* context);
+
+    /// <summary>
+    /// Binds the atlas textures to the shader resources slots (starting from the given slot).
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="slot">The first slot index.</param>
+    void Bind(GPUContext* context, int32 slot) const;
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+};
@@ -0,0 +1,165 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "BlendShapesPass.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Models/SkinnedMesh.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+// The amount of vertices processed by a single thread group
+#define BLEND_SHAPES_GROUP_SIZE 64
+
+PACK_STRUCT(struct Data {
+    uint32 VertexOffset;
+    uint32 VertexCount;
+    uint32 VertexStride;
+    uint32 RangesOffset;
+    });
+
+String BlendShapesPass::ToString() const
+{
+    return TEXT("BlendShapesPass");
+}
+
+bool BlendShapesPass::Init()
+{
+    // Compute shaders support is required for this implementation
+    if (!GPUDevice::Instance->Limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/BlendShapes"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<BlendShapesPass, &BlendShapesPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool BlendShapesPass::setupResources()
+{
+    // Check if shader has not been loaded
+    if (!_shader || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _csBlend[0] = shader->GetCS("CS_Blend", 0);
+    _csBlend[1] = shader->GetCS("CS_Blend", 1);
+
+    return false;
+}
+
+void BlendShapesPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _queue.Resize(0);
+    _csBlend[0] = _csBlend[1] = nullptr;
+    _shader = nullptr;
+}
+
+bool BlendShapesPass::CanUse()
+{
+    return _shader && _shader->IsLoaded();
+}
+
+void BlendShapesPass::Add(BlendShapesInstance::MeshInstance* instance, const SkinnedMesh* mesh)
+{
+    ScopeLock lock(_locker);
+    for (const QueuedMesh& e : _queue)
+    {
+        if (e.Instance == instance)
+            return;
+    }
+    _queue.Add({ instance, mesh });
+}
+
+void BlendShapesPass::Remove(BlendShapesInstance::MeshInstance* instance)
+{
+    ScopeLock lock(_locker);
+    for (int32 i = _queue.Count() - 1; i >= 0; i--)
+    {
+        if (_queue[i].Instance == instance)
+            _queue.RemoveAtKeepOrder(i);
+    }
+}
+
+void BlendShapesPass::Execute(GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    if (_queue.IsEmpty())
+        return;
+    PROFILE_GPU_CPU("Blend Shapes");
+    const bool canBlend = !checkIfSkipPass();
+    const auto cb = canBlend ? _shader->GetShader()->GetCB(0) : nullptr;
+    const uint32 stride = sizeof(VB0SkinnedElementType);
+    for (const QueuedMesh& e : _queue)
+    {
+        auto& instance = *e.Instance;
+        const SkinnedMesh* mesh = e.Mesh;
+        const uint32 vertexCount = mesh->GetVertexCount();
+        if (!instance.GPUVertexBuffer || !mesh->GetVertexBuffer() || vertexCount == 0)
+            continue;
+
+        // Restore the original vertices modified by the previous blending and the ones to blend now
+        const uint32 minVertexIndex = Math::Min(instance.GPUMinVertexIndex, instance.DirtyMinVertexIndex);
+        const uint32 maxVertexIndex = Math::Min(Math::Max(instance.GPUMaxVertexIndex, instance.DirtyMaxVertexIndex), vertexCount - 1);
+        if (minVertexIndex <= maxVertexIndex)
+            context->CopyBuffer(instance.GPUVertexBuffer, mesh->GetVertexBuffer(), (maxVertexIndex - minVertexIndex + 1) * stride, minVertexIndex * stride, minVertexIndex * stride);
+        instance.GPUMinVertexIndex = instance.DirtyMinVertexIndex;
+        instance.GPUMaxVertexIndex = instance.DirtyMaxVertexIndex;
+        if (!canBlend || instance.DirtyMinVertexIndex > instance.DirtyMaxVertexIndex)
+            continue;
+
+        // Prepare the blend shapes data resident on the GPU (shared by all instances of the mesh)
+        auto& meshData = mesh->GetBlendShapesData();
+        if (!meshData.IsReady() && meshData.Init(mesh))
+            continue;
+        const uint32 startVertex = Math::Max(instance.DirtyMinVertexIndex, meshData.MinVertexIndex);
+        const uint32 endVertex = Math::Min(instance.DirtyMaxVertexIndex, meshData.MaxVertexIndex);
+        if (startVertex > endVertex)
+            continue;
+
+        // Upload weights (the only per-frame data)
+        const uint32 weightsSize = instance.GPUWeights.Count() * sizeof(float);
+        if (!instance.GPUWeightsBuffer)
+            instance.GPUWeightsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("BlendShapes.Weights"));
+        if (instance.GPUWeightsBuffer->GetSize() != weightsSize &&
+            instance.GPUWeightsBuffer->Init(GPUBufferDescription::Structured(instance.GPUWeights.Count(), sizeof(float))))
+            continue;
+        context->UpdateBuffer(instance.GPUWeightsBuffer, instance.GPUWeights.Get(), weightsSize);
+
+        // Blend vertices (single thread per vertex loops over all its deltas)
+        Data data;
+        data.VertexOffset = startVertex;
+        data.VertexCount = endVertex - startVertex + 1;
+        data.VertexStride = stride;
+        data.RangesOffset = startVertex - meshData.MinVertexIndex;
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
+        context->BindSR(0, meshData.Ranges->View());
+        context->BindSR(1, meshData.Deltas->View());
+        context->BindSR(2, instance.GPUWeightsBuffer->View());
+        context->BindUA(0, instance.GPUVertexBuffer->View());
+        context->Dispatch(_csBlend[instance.UseNormals ? 1 : 0], Math::DivideAndRoundUp<uint32>(data.VertexCount, BLEND_SHAPES_GROUP_SIZE), 1, 1);
+        context->ResetUA();
+    }
+    context->ResetSR();
+    context->ResetCB();
+    _queue.Clear();
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "Engine/Graphics/Models/BlendShape.h"
+#include "Engine/Threading/Threading.h"
+
+/// <summary>
+/// Blend shapes blending performed on compute shaders. The blend shape deltas are resident in the mesh GPU buffers and only the weights are uploaded when they change. Outputs the blended vertex buffer used by the skinned mesh draw calls (skinning is applied later in the vertex shader).
+/// </summary>
+class BlendShapesPass : public RendererPass<BlendShapesPass>
+{
+private:
+    struct QueuedMesh
+    {
+        BlendShapesInstance::MeshInstance* Instance;
+        const SkinnedMesh* Mesh;
+    };
+
+    AssetReference<Shader> _shader;
+    GPUShaderProgramCS* _csBlend[2] = {};
+    CriticalSection _locker;
+    Array<QueuedMesh> _queue;
+
+public:
+    /// <summary>
+    /// Checks if the compute shaders blending can be used (device supports compute shaders, shader is loaded).
+    /// </summary>
+    bool CanUse();
+
+    /// <summary>
+    /// Queues the mesh instance blending. Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="instance">The blend shapes mesh instance (with the weights and the output vertex buffer).</param>
+    /// <param name="mesh">The skinned mesh.</param>
+    void Add(BlendShapesInstance::MeshInstance* instance, const SkinnedMesh* mesh);
+
+    /// <summary>
+    /// Removes the mesh instance from the queue (eg. when it's being deleted).
+    /// </summary>
+    /// <param name="instance">The blend shapes mesh instance.</param>
+    void Remove(BlendShapesInstance::MeshInstance* instance);
+
+    /// <summary>
+    /// Executes all queued meshes blending. Called by the renderer after collecting draw calls, before drawing them.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    void Execute(GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csBlend[0] = _csBlend[1] = nullptr;
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
@@ -0,0 +1,291 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "InstancesCulling.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Core/Math/Half.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Renderer/RenderList.h"
+
+// The amount of frames after which unused buffers get released
+#define INSTANCES_CULLING_BUFFERS_LIFETIME 60
+
+PACK_STRUCT(struct Data {
+    Float3 Origin;
+    uint32 MaxInstances;
+    Float3 ViewPosition;
+    float LODScreenMultipleSq;
+    Float3 LODViewPosition;
+    float MinScreenSizeSq;
+    int32 LODBias;
+    int32 LODsCount;
+    uint32 DrawsCount;
+    uint32 RangesCount;
+    Float4 LODScreenSizesSq[2];
+    Float4 FrustumPlanes[6];
+    });
+
+static_assert(sizeof(InstancesCulling::CullingInstance) == 32, "Invalid instance data size. Update the shader structure.");
+static_assert(sizeof(InstancesCulling::CullingRange) == 32, "Invalid instances range size. Update the shader structure.");
+static_assert(sizeof(InstancesCulling::DrawArgs) == 20, "Invalid indirect draw arguments size.");
+static_assert(MODEL_MAX_LODS <= 8, "Update LODScreenSizesSq in the culling shader to match the maximum amount of model LODs.");
+
+namespace
+{
+    uint32 Quantize(float value, float min, float size)
+    {
+        return size > ZeroTolerance ? (uint32)Math::Clamp((value - min) / size * 65535.0f + 0.5f, 0.0f, 65535.0f) : 0;
+    }
+
+    uint32 PackHalf2(float x, float y)
+    {
+        return (uint32)Float16Compressor::Compress(x) | ((uint32)Float16Compressor::Compress(y) << 16);
+    }
+}
+
+void InstancesCulling::CullingInstance::Pack(const Float3& translation, const Quaternion& rotation, const Float3& scale, const Float3& center, float radius, float random, float cullDistance, const Float3& boundsMin, const Float3& boundsSize)
+{
+    TranslationXY = Quantize(translation.X, boundsMin.X, boundsSize.X) | (Quantize(translation.Y, boundsMin.Y, boundsSize.Y) << 16);
+    TranslationZRandom = Quantize(translation.Z, boundsMin.Z, boundsSize.Z) | ((uint32)(Math::Saturate(random) * 65535.0f + 0.5f) << 16);
+    CenterXY = Quantize(center.X, boundsMin.X, boundsSize.X) | (Quantize(center.Y, boundsMin.Y, boundsSize.Y) << 16);
+    CenterZRadius = Quantize(center.Z, boundsMin.Z, boundsSize.Z) | ((uint32)Float16Compressor::Compress(Math::Min(radius + ZeroTolerance, 65504.0f)) << 16);
+    ScaleXY = PackHalf2(scale.X, scale.Y);
+    ScaleZ = (uint32)Float16Compressor::Compress(scale.Z);
+    CullDistance = cullDistance;
+
+    // Smallest three components (quaternion and its negation represent the same rotation so the largest component is always positive)
+    const float q[4] = { rotation.X, rotation.Y, rotation.Z, rotation.W };
+    uint32 largest = 0;
+    for (uint32 i = 1; i < 4; i++)
+    {
+        if (Math::Abs(q[i]) > Math::Abs(q[largest]))
+            largest = i;
+    }
+    const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+    Rotation = largest << 30;
+    for (uint32 i = 0, shift = 0; i < 4; i++)
+    {
+        if (i == largest)
+            continue;
+        const float value = Math::Clamp(q[i] * sign * 0.70710678f + 0.5f, 0.0f, 1.0f);
+        Rotation |= (uint32)(value * 1023.0f + 0.5f) << shift;
+        shift += 10;
+    }
+}
+
+String InstancesCulling::ToString() const
+{
+    return TEXT("InstancesCulling");
+}
+
+bool InstancesCulling::Init()
+{
+    // Compute shaders and indirect draws support is required for this implementation
+    const auto& limits = GPUDevice::Instance->Limits;
+    if (!limits.HasCompute || !limits.HasDrawIndirect || !limits.HasInstancing)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/InstancesCulling"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<InstancesCulling, &InstancesCulling::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool InstancesCulling::setupResources()
+{
+    // Check if shader has not been loaded
+    if (!_shader || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _csCount = shader->GetCS("CS_Count");
+    _csArgs = shader->GetCS("CS_Args");
+    _csWrite = shader->GetCS("CS_Write");
+
+    return false;
+}
+
+void InstancesCulling::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    for (auto& e : _buffers)
+    {
+        SAFE_DELETE_GPU_RESOURCE(e.Ranges);
+        SAFE_DELETE_GPU_RESOURCE(e.Instances);
+        SAFE_DELETE_GPU_RESOURCE(e.Args);
+    }
+    _buffers.Resize(0);
+    _requests.Resize(0);
+    _csCount = nullptr;
+    _csArgs = nullptr;
+    _csWrite = nullptr;
+    _shader = nullptr;
+}
+
+bool InstancesCulling::CanUse()
+{
+    return _shader && _shader->IsLoaded();
+}
+
+bool InstancesCulling::Add(const RenderContext& renderContext, Request& request)
+{
+    ASSERT_LOW_LAYER(request.Instances && request.Draws.HasItems() && request.LODsCount > 0 && request.LODsCount <= MODEL_MAX_LODS);
+    const uint32 instancesSize = request.MaxInstances * sizeof(InstanceData);
+    const uint32 argsSize = INSTANCES_CULLING_ARGS_HEADER_SIZE + request.Draws.Count() * sizeof(DrawArgs);
+    const uint32 rangesSize = request.Ranges.Count() * sizeof(CullingRange);
+    ScopeLock lock(_locker);
+    const uint64 frame = Engine::FrameCount;
+
+    // Pick the buffers not used during the current frame (every view needs own buffers since culling for all views runs before drawing)
+    Buffers* buffers = nullptr;
+    for (int32 i = _buffers.Count() - 1; i >= 0; i--)
+    {
+        auto& e = _buffers[i];
+        if (e.LastFrameUsed == frame)
+            continue;
+        if (!buffers || (e.Instances->GetSize() >= instancesSize && buffers->Instances->GetSize() < instancesSize))
+            buffers = &e;
+    }
+    if (!buffers)
+    {
+        auto& e = _buffers.AddOne();
+        e.Ranges = GPUDevice::Instance->CreateBuffer(TEXT("InstancesCulling.Ranges"));
+        e.Instances = GPUDevice::Instance->CreateBuffer(TEXT("InstancesCulling.Instances"));
+        e.Args = GPUDevice::Instance->CreateBuffer(TEXT("InstancesCulling.Args"));
+        buffers = &e;
+    }
+    buffers->LastFrameUsed = frame;
+
+    // Ensure to have enough space (allocate a bit more to reduce buffers reallocations)
+    if (buffers->Instances->GetSize() < instancesSize)
+    {
+        auto desc = GPUBufferDescription::Raw(Math::RoundUpToPowerOf2(instancesSize), GPUBufferFlags::VertexBuffer | GPUBufferFlags::UnorderedAccess);
+        desc.Stride = sizeof(InstanceData);
+        if (buffers->Instances->Init(desc))
+            return true;
+    }
+    if (buffers->Args->GetSize() < argsSize &&
+        buffers->Args->Init(GPUBufferDescription::Raw(Math::RoundUpToPowerOf2(argsSize), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+        return true;
+    if (buffers->Ranges->GetSize() < rangesSize &&
+        buffers->Ranges->Init(GPUBufferDescription::Structured(Math::RoundUpToPowerOf2(request.Ranges.Count()), sizeof(CullingRange))))
+        return true;
+    request.OutputInstances = buffers->Instances;
+    request.OutputArgs = buffers->Args;
+
+    // Queue the request with the view data
+    auto& queued = _requests.AddOne();
+    queued.Data = request;
+    queued.Ranges = buffers->Ranges;
+    const RenderView& view = renderContext.View;
+    const RenderView& lodView = renderContext.LodProxyView ? *renderContext.LodProxyView : view;
+    queued.ViewPosition = view.Position;
+    queued.LODViewPosition = lodView.Position;
+    queued.LODScreenMultipleSq = Math::Square(0.5f * Math::Max(lodView.Projection.Values[0][0], lodView.Projection.Values[1][1])) * view.ModelLODDistanceFactorSqrt;
+    queued.LODBias = view.ModelLODBias;
+    queued.Frustum = view.CullingFrustum;
+
+    // Release old buffers
+    for (int32 i = _buffers.Count() - 1; i >= 0; i--)
+    {
+        auto& e = _buffers[i];
+        if (e.LastFrameUsed + INSTANCES_CULLING_BUFFERS_LIFETIME < frame)
+        {
+            SAFE_DELETE_GPU_RESOURCE(e.Ranges);
+            SAFE_DELETE_GPU_RESOURCE(e.Instances);
+            SAFE_DELETE_GPU_RESOURCE(e.Args);
+            _buffers.RemoveAt(i);
+        }
+    }
+
+    return false;
+}
+
+void InstancesCulling::Execute(GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    if (_requests.IsEmpty())
+        return;
+    PROFILE_GPU_CPU("Instances Culling");
+    const bool canCull = !checkIfSkipPass();
+    const auto cb = canCull ? _shader->GetShader()->GetCB(0) : nullptr;
+    Array<byte, RendererAllocation> argsData;
+    for (auto& queued : _requests)
+    {
+        auto& request = queued.Data;
+
+        // Initialize arguments (counters are zeroed, StartInstance contains the LOD index until the GPU writes the instances offset)
+        const int32 drawsCount = request.Draws.Count();
+        argsData.Resize(INSTANCES_CULLING_ARGS_HEADER_SIZE + drawsCount * sizeof(DrawArgs));
+        Platform::MemoryClear(argsData.Get(), INSTANCES_CULLING_ARGS_HEADER_SIZE);
+        auto draws = (DrawArgs*)(argsData.Get() + INSTANCES_CULLING_ARGS_HEADER_SIZE);
+        for (int32 i = 0; i < drawsCount; i++)
+        {
+            draws[i] = request.Draws[i];
+            draws[i].InstanceCount = 0;
+        }
+        context->UpdateBuffer(request.OutputArgs, argsData.Get(), argsData.Count());
+        if (!canCull || request.Ranges.IsEmpty())
+            continue;
+        context->UpdateBuffer(queued.Ranges, request.Ranges.Get(), request.Ranges.Count() * sizeof(CullingRange));
+
+        // Setup constants
+        Data data;
+        data.Origin = request.Origin;
+        data.MaxInstances = request.MaxInstances;
+        data.ViewPosition = queued.ViewPosition;
+        data.LODScreenMultipleSq = queued.LODScreenMultipleSq;
+        data.LODViewPosition = queued.LODViewPosition;
+        data.MinScreenSizeSq = Math::Square(request.MinScreenSize * 0.5f);
+        data.LODBias = queued.LODBias;
+        data.LODsCount = request.LODsCount;
+        data.DrawsCount = drawsCount;
+        data.RangesCount = request.Ranges.Count();
+        float* lodScreenSizesSq = (float*)data.LODScreenSizesSq;
+        for (int32 i = 0; i < 8; i++)
+            lodScreenSizesSq[i] = i < request.LODsCount ? Math::Square(request.LODScreenSizes[i] * 0.5f) : 0.0f;
+        for (int32 i = 0; i < 6; i++)
+        {
+            const Plane plane = queued.Frustum.GetPlane(i);
+            data.FrustumPlanes[i] = Float4(Float3(plane.Normal), (float)plane.D);
+        }
+        context->UpdateCB(cb, &data);
+        context->BindCB(0, cb);
+        context->BindSR(0, request.Instances->View());
+        context->BindSR(1, queued.Ranges->View());
+        context->BindUA(0, request.OutputArgs->View());
+        context->BindUA(1, request.OutputInstances->View());
+
+        // Count visible instances per LOD, then compute the output offsets with draw arguments and write the instances data
+        const uint32 groupsX = Math::Min<uint32>(data.RangesCount, GPU_MAX_CS_DISPATCH_THREAD_GROUPS);
+        const uint32 groupsY = Math::DivideAndRoundUp<uint32>(data.RangesCount, GPU_MAX_CS_DISPATCH_THREAD_GROUPS);
+        context->Dispatch(_csCount, groupsX, groupsY, 1);
+        context->Dispatch(_csArgs, 1, 1, 1);
+        context->Dispatch(_csWrite, groupsX, groupsY, 1);
+        context->ResetUA();
+    }
+    context->ResetSR();
+    context->ResetCB();
+    _requests.Clear();
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "../RendererAllocation.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+#include "Engine/Graphics/Models/Config.h"
+#include "Engine/Threading/Threading.h"
+
+// The size of the instances group processed by a single thread group (maximum amount of instances within a single culling range)
+#define INSTANCES_CULLING_GROUP_SIZE 64
+
+// The size (in bytes) of the indirect draw arguments header (per-LOD instance counters) in the culling arguments buffer
+#define INSTANCES_CULLING_ARGS_HEADER_SIZE (MODEL_MAX_LODS * 2 * sizeof(uint32))
+
+/// <summary>
+/// GPU-driven instances culling and LOD selection performed on compute shaders. Outputs the visible instances data (used as instance vertex buffer) and the indirect draw arguments used to draw the instances with hardware instancing without the CPU readback.
+/// </summary>
+class InstancesCulling : public RendererPass<InstancesCulling>
+{
+public:
+    /// <summary>
+    /// The compact instance data used by the culling (matches the shader structure). Positions are quantized to 16-bit within the bounds of the range that contains the instance (see CullingRange), the world matrix is reconstructed on the GPU.
+    /// </summary>
+    PACK_STRUCT(struct CullingInstance
+        {
+        // The quantized translation (X and Y components).
+        uint32 TranslationXY;
+        // The quantized translation (Z component) and the per-instance random value (unorm 16-bit).
+        uint32 TranslationZRandom;
+        // The quantized bounds sphere center (X and Y components).
+        uint32 CenterXY;
+        // The quantized bounds sphere center (Z component) and the bounds sphere radius (half).
+        uint32 CenterZRadius;
+        // The rotation quaternion (smallest three components, 10 bits each, and 2 bits of the largest component index).
+        uint32 Rotation;
+        // The X and Y scale (half).
+        uint32 ScaleXY;
+        // The Z scale (half).
+        uint32 ScaleZ;
+        // The cull distance.
+        float CullDistance;
+
+        /// <summary>
+        /// Packs the instance data.
+        /// </summary>
+        /// <param name="translation">The instance translation (relative to the instances origin).</param>
+        /// <param name="rotation">The instance rotation.</param>
+        /// <param name="scale">The instance scale.</param>
+        /// <param name="center">The instance bounds sphere center (relative to the instances origin).</param>
+        /// <param name="radius">The instance bounds sphere radius.</param>
+        /// <param name="random">The per-instance random value from range [0;1].</param>
+        /// <param name="cullDistance">The instance cull distance.</param>
+        /// <param name="boundsMin">The quantization bounds minimum (see CullingRange).</param>
+        /// <param name="boundsSize">The quantization bounds size (see CullingRange).</param>
+        void Pack(const Float3& translation, const Quaternion& rotation, const Float3& scale, const Float3& center, float radius, float random, float cullDistance, const Float3& boundsMin, const Float3& boundsSize);
+        });
+
+    /// <summary>
+    /// The range of the instances to process (matches the shader structure). Contains the bounds used to dequantize the positions of the instances within the range.
+    /// </summary>
+    PACK_STRUCT(struct CullingRange
+        {
+        // The quantization bounds minimum (relative to the instances origin).
+        Float3 BoundsMin;
+        // The index of the first instance.
+        uint32 Start;
+        // The quantization bounds size.
+        Float3 BoundsSize;
+        // The amount of instances (up to INSTANCES_CULLING_GROUP_SIZE).
+        uint32 Count;
+        });
+
+    /// <summary>
+    /// The indirect draw arguments used to render the culled instances (matches the graphics API layout of DrawIndexedInstancedIndirect arguments).
+    /// </summary>
+    struct DrawArgs
+    {
+        uint32 IndicesCount;
+        uint32 InstanceCount;
+        uint32 StartIndex;
+        int32 BaseVertex;
+        uint32 StartInstance;
+    };
+
+    /// <summary>
+    /// The culling request for a set of instances drawn in a single view.
+    /// </summary>
+    struct Request
+    {
+        /// <summary>
+        /// The instances buffer (structured buffer of CullingInstance elements).
+        /// </summary>
+        GPUBuffer* Instances;
+
+        /// <summary>
+        /// The ranges of the instances to process. Every range can contain up to INSTANCES_CULLING_GROUP_SIZE instances.
+        /// </summary>
+        Array<CullingRange, RendererAllocation> Ranges;
+
+        /// <summary>
+        /// The instances origin (relative to the view rendering origin).
+        /// </summary>
+        Float3 Origin;
+
+        /// <summary>
+        /// The maximum amount of the visible instances to output.
+        /// </summary>
+        uint32 MaxInstances;
+
+        /// <summary>
+        /// The amount of the model LODs.
+        /// </summary>
+        int32 LODsCount;
+
+        /// <summary>
+        /// The model minimum screen size (instances below it are culled).
+        /// </summary>
+        float MinScreenSize;
+
+        /// <summary>
+        /// The model LODs screen sizes.
+        /// </summary>
+        float LODScreenSizes[MODEL_MAX_LODS];
+
+        /// <summary>
+        /// The indirect draw arguments for every drawn mesh. The StartInstance has to contain the LOD index of the mesh, the InstanceCount is ignored (both are computed on the GPU).
+        /// </summary>
+        Array<DrawArgs, InlinedAllocation<16>> Draws;
+
+        /// <summary>
+        /// The output buffer with visible instances data (InstanceData elements). Used as instances vertex buffer by the draw calls.
+        /// </summary>
+        GPUBuffer* OutputInstances = nullptr;
+
+        /// <summary>
+        /// The output buffer with indirect draw arguments (Draws elements after INSTANCES_CULLING_ARGS_HEADER_SIZE bytes of header).
+        /// </summary>
+        GPUBuffer* OutputArgs = nullptr;
+    };
+
+private:
+    struct Buffers
+    {
+        GPUBuffer* Ranges;
+        GPUBuffer* Instances;
+        GPUBuffer* Args;
+        uint64 LastFrameUsed;
+    };
+
+    struct QueuedRequest
+    {
+        Request Data;
+        GPUBuffer* Ranges;
+        Float3 ViewPosition;
+        Float3 LODViewPosition;
+        float LODScreenMultipleSq;
+        int32 LODBias;
+        BoundingFrustum Frustum;
+    };
+
+    AssetReference<Shader> _shader;
+    GPUShaderProgramCS* _csCount = nullptr;
+    GPUShaderProgramCS* _csArgs = nullptr;
+    GPUShaderProgramCS* _csWrite = nullptr;
+    CriticalSection _locker;
+    Array<Buffers> _buffers;
+    Array<QueuedRequest> _requests;
+
+public:
+    /// <summary>
+    /// Checks if the GPU-driven instances culling can be used (device supports compute shaders and indirect draws, shader is loaded).
+    /// </summary>
+    bool CanUse();
+
+    /// <summary>
+    /// Queues the culling request for the view and allocates its output buffers (valid only for the current frame). Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="renderContext">The rendering context of the view to cull the instances for.</param>
+    /// <param name="request">The culling request. Output buffers are assigned on success.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Add(const RenderContext& renderContext, Request& request);
+
+    /// <summary>
+    /// Executes all queued culling requests. Called by the renderer after collecting draw calls, before drawing them.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    void Execute(GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csCount = nullptr;
+        _csArgs = nullptr;
+        _csWrite = nullptr;
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
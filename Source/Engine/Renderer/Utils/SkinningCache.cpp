@@ -0,0 +1,189 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "SkinningCache.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Core/Math/Color32.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Models/SkinnedMesh.h"
+#include "Engine/Graphics/Models/SkinnedMeshDrawData.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+// The amount of vertices processed by a single thread group
+#define SKINNING_CACHE_GROUP_SIZE 64
+
+// The amount of frames after which unused buffers get released
+#define SKINNING_CACHE_BUFFERS_LIFETIME 60
+
+PACK_STRUCT(struct Data {
+    uint32 VertexCount;
+    uint32 InputStride;
+    Float2 Dummy0;
+    });
+
+String SkinningCache::ToString() const
+{
+    return TEXT("SkinningCache");
+}
+
+bool SkinningCache::Init()
+{
+    // Compute shaders support is required for this implementation
+    if (!GPUDevice::Instance->Limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/SkinningCache"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<SkinningCache, &SkinningCache::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool SkinningCache::setupResources()
+{
+    // Check if shader has not been loaded
+    if (!_shader || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _csSkin = shader->GetCS("CS_Skin");
+
+    return false;
+}
+
+void SkinningCache::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    for (auto& e : _entries)
+    {
+        SAFE_DELETE_GPU_RESOURCE(e.Value.Positions);
+        SAFE_DELETE_GPU_RESOURCE(e.Value.Attributes);
+    }
+    _entries.Clear();
+    _queue.Resize(0);
+    SAFE_DELETE_GPU_RESOURCE(_colors);
+    _csSkin = nullptr;
+    _shader = nullptr;
+}
+
+bool SkinningCache::CanUse()
+{
+    return Graphics::EnableSkinningCache && _shader && _shader->IsLoaded();
+}
+
+bool SkinningCache::Get(const SkinnedMeshDrawData* skinning, const SkinnedMesh* mesh, GPUBuffer* input, GPUBuffer* vertexBuffers[3])
+{
+    const uint32 vertexCount = mesh->GetVertexCount();
+    if (!skinning->IsReady() || !input || vertexCount == 0)
+        return true;
+    ScopeLock lock(_locker);
+    const uint64 frame = Engine::FrameCount;
+
+    // Ensure to have the output buffers (in static mesh vertex layout)
+    Entry* entry = _entries.TryGet(ToPair(skinning, mesh));
+    if (!entry)
+    {
+        entry = &_entries[ToPair(skinning, mesh)];
+        entry->Positions = GPUDevice::Instance->CreateBuffer(TEXT("SkinningCache.Positions"));
+        entry->Attributes = GPUDevice::Instance->CreateBuffer(TEXT("SkinningCache.Attributes"));
+        entry->LastFrameUsed = 0;
+    }
+    if (entry->Positions->GetSize() != vertexCount * sizeof(VB0ElementType))
+    {
+        auto desc = GPUBufferDescription::Raw(vertexCount * sizeof(VB0ElementType), GPUBufferFlags::VertexBuffer | GPUBufferFlags::UnorderedAccess);
+        desc.Stride = sizeof(VB0ElementType);
+        if (entry->Positions->Init(desc))
+            return true;
+        desc = GPUBufferDescription::Raw(vertexCount * sizeof(VB1ElementType), GPUBufferFlags::VertexBuffer | GPUBufferFlags::UnorderedAccess);
+        desc.Stride = sizeof(VB1ElementType);
+        if (entry->Attributes->Init(desc))
+            return true;
+        entry->LastFrameUsed = 0;
+    }
+
+    // Skinned meshes have no vertex colors so use white color (matches the skinned vertex shader)
+    if (!_colors || _colors->GetElementsCount() < vertexCount)
+    {
+        if (!_colors)
+            _colors = GPUDevice::Instance->CreateBuffer(TEXT("SkinningCache.Colors"));
+        const uint32 colorsCount = Math::RoundUpToPowerOf2(vertexCount);
+        Array<Color32> colors;
+        colors.Resize(colorsCount);
+        for (Color32& c : colors)
+            c = Color32::White;
+        if (_colors->Init(GPUBufferDescription::Vertex(sizeof(VB2ElementType), colorsCount, colors.Get())))
+            return true;
+    }
+
+    // Skin once per frame
+    if (entry->LastFrameUsed != frame)
+    {
+        entry->LastFrameUsed = frame;
+        _queue.Add({ input, skinning->BoneMatrices, entry->Positions, entry->Attributes, vertexCount });
+    }
+
+    vertexBuffers[0] = entry->Positions;
+    vertexBuffers[1] = entry->Attributes;
+    vertexBuffers[2] = _colors;
+    return false;
+}
+
+void SkinningCache::Execute(GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    const uint64 frame = Engine::FrameCount;
+    if (_queue.HasItems() && !checkIfSkipPass())
+    {
+        PROFILE_GPU_CPU("Skinning Cache");
+        const auto cb = _shader->GetShader()->GetCB(0);
+        for (const QueuedEntry& e : _queue)
+        {
+            Data data;
+            data.VertexCount = e.VertexCount;
+            data.InputStride = sizeof(VB0SkinnedElementType);
+            data.Dummy0 = Float2::Zero;
+            context->UpdateCB(cb, &data);
+            context->BindCB(0, cb);
+            context->BindSR(0, e.Input->View());
+            context->BindSR(1, e.BoneMatrices->View());
+            context->BindUA(0, e.Positions->View());
+            context->BindUA(1, e.Attributes->View());
+            context->Dispatch(_csSkin, Math::DivideAndRoundUp<uint32>(e.VertexCount, SKINNING_CACHE_GROUP_SIZE), 1, 1);
+        }
+        context->ResetUA();
+        context->ResetSR();
+        context->ResetCB();
+    }
+    _queue.Clear();
+
+    // Release old buffers
+    for (auto it = _entries.Begin(); it.IsNotEnd(); ++it)
+    {
+        Entry& e = it->Value;
+        if (e.LastFrameUsed + SKINNING_CACHE_BUFFERS_LIFETIME < frame)
+        {
+            SAFE_DELETE_GPU_RESOURCE(e.Positions);
+            SAFE_DELETE_GPU_RESOURCE(e.Attributes);
+            _entries.Remove(it);
+        }
+    }
+}
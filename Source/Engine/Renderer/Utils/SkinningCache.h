@@ -0,0 +1,82 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Threading/Threading.h"
+
+class SkinnedMesh;
+class SkinnedMeshDrawData;
+
+/// <summary>
+/// Skinning cache that skins the animated meshes with compute shaders once per frame. Outputs the skinned vertex buffers (in static mesh layout) that are drawn as static geometry by all passes (eg. GBuffer and every shadow map cascade or cube face) instead of skinning the vertices in the vertex shader of every pass.
+/// </summary>
+class SkinningCache : public RendererPass<SkinningCache>
+{
+private:
+    struct Entry
+    {
+        GPUBuffer* Positions;
+        GPUBuffer* Attributes;
+        uint64 LastFrameUsed;
+    };
+
+    struct QueuedEntry
+    {
+        GPUBuffer* Input;
+        GPUBuffer* BoneMatrices;
+        GPUBuffer* Positions;
+        GPUBuffer* Attributes;
+        uint32 VertexCount;
+    };
+
+    AssetReference<Shader> _shader;
+    GPUShaderProgramCS* _csSkin = nullptr;
+    CriticalSection _locker;
+    Dictionary<Pair<const SkinnedMeshDrawData*, const SkinnedMesh*>, Entry> _entries;
+    Array<QueuedEntry> _queue;
+    GPUBuffer* _colors = nullptr;
+
+public:
+    /// <summary>
+    /// Checks if the skinning cache can be used (enabled in graphics settings, device supports compute shaders, shader is loaded).
+    /// </summary>
+    bool CanUse();
+
+    /// <summary>
+    /// Gets the skinned vertex buffers of the mesh for the current frame (skinning gets queued once per frame). Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="skinning">The skinning data with the bone matrices.</param>
+    /// <param name="mesh">The skinned mesh.</param>
+    /// <param name="input">The vertex buffer to skin (mesh vertex buffer or the blended vertices from the blend shapes).</param>
+    /// <param name="vertexBuffers">The output vertex buffers (in static mesh layout: positions, attributes and vertex colors).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Get(const SkinnedMeshDrawData* skinning, const SkinnedMesh* mesh, GPUBuffer* input, GPUBuffer* vertexBuffers[3]);
+
+    /// <summary>
+    /// Executes all queued meshes skinning. Called by the renderer after collecting draw calls, before drawing them.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    void Execute(GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csSkin = nullptr;
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
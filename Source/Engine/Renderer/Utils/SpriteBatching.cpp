@@ -0,0 +1,259 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "SpriteBatching.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Math/Color32.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/DynamicBuffer.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Renderer/RenderList.h"
+
+// The amount of frames after which unused buffers get released
+#define SPRITE_BATCHING_BUFFERS_LIFETIME 60
+
+String SpriteBatching::ToString() const
+{
+    return TEXT("SpriteBatching");
+}
+
+void SpriteBatching::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    for (auto& e : _buffers)
+    {
+        Delete(e.VB0);
+        Delete(e.VB1);
+        Delete(e.VB2);
+        Delete(e.IB);
+    }
+    _buffers.Resize(0);
+    for (View* view : _views)
+    {
+        for (auto& e : view->Batches)
+            _freeBatches.Add(e.Value);
+        _freeViews.Add(view);
+    }
+    _views.Resize(0);
+    _freeViews.ClearDelete();
+    _freeBatches.ClearDelete();
+}
+
+void SpriteBatching::Begin(const RenderContextBatch& renderContextBatch)
+{
+    ScopeLock lock(_locker);
+    for (const RenderContext& renderContext : renderContextBatch.Contexts)
+    {
+        View* view = _freeViews.HasItems() ? _freeViews.Pop() : New<View>();
+        view->Context = renderContext;
+        _views.Add(view);
+    }
+}
+
+bool SpriteBatching::Add(const RenderContext& renderContext, const Key& key, MaterialBase* material, const Matrix& world, const Geometry& geometry)
+{
+    if (geometry.VerticesCount > SPRITE_BATCHING_MAX_VERTICES || geometry.IndicesCount == 0 || key.DrawModes == DrawPass::None || !material)
+        return true;
+    ScopeLock lock(_locker);
+
+    // Find the view (only registered views are batched)
+    View* view = nullptr;
+    for (View* e : _views)
+    {
+        if (e->Context.List == renderContext.List)
+        {
+            view = e;
+            break;
+        }
+    }
+    if (!view)
+        return true;
+
+    // Get batch
+    Batch* batch;
+    if (!view->Batches.TryGet(key, batch))
+    {
+        batch = _freeBatches.HasItems() ? _freeBatches.Pop() : New<Batch>();
+        batch->Material = material;
+        batch->Box = BoundingBox::Empty;
+        view->Batches.Add(key, batch);
+    }
+
+    // Transform vertices into the world-space
+    const int32 vertexStart = batch->VB0.Count();
+    batch->VB0.AddUninitialized(geometry.VerticesCount);
+    batch->VB1.AddUninitialized(geometry.VerticesCount);
+    batch->VB2.AddUninitialized(geometry.VerticesCount);
+    VB0ElementType* vb0 = batch->VB0.Get() + vertexStart;
+    VB1ElementType* vb1 = batch->VB1.Get() + vertexStart;
+    VB2ElementType* vb2 = batch->VB2.Get() + vertexStart;
+    Float3 min = Float3::Maximum, max = Float3::Minimum;
+    for (int32 i = 0; i < geometry.VerticesCount; i++)
+    {
+        Float3::Transform(geometry.VB0[i].Position, world, vb0[i].Position);
+        min = Float3::Min(min, vb0[i].Position);
+        max = Float3::Max(max, vb0[i].Position);
+
+        const VB1ElementType& src = geometry.VB1[i];
+        Float3 normal = src.Normal.ToFloat3() * 2.0f - 1.0f;
+        Float3 tangent = src.Tangent.ToFloat3() * 2.0f - 1.0f;
+        Float3::TransformNormal(normal, world, normal);
+        Float3::TransformNormal(tangent, world, tangent);
+        normal.Normalize();
+        tangent.Normalize();
+        vb1[i].TexCoord = src.TexCoord;
+        vb1[i].Normal = Float1010102(normal * 0.5f + 0.5f, 0);
+        vb1[i].Tangent = Float1010102(tangent * 0.5f + 0.5f, 0);
+        vb1[i].Tangent.W = src.Tangent.W;
+        vb1[i].LightmapUVs = Half2::Zero;
+
+        vb2[i].Color = geometry.VB2 ? geometry.VB2[i].Color : Color32::White;
+    }
+    batch->Box.Merge(BoundingBox(min, max));
+
+    // Copy indices
+    Item& item = batch->Items.AddOne();
+    item.StartIndex = batch->Indices.Count();
+    item.IndicesCount = geometry.IndicesCount;
+    item.Distance = Float3::DistanceSquared((min + max) * 0.5f, renderContext.View.Position);
+    batch->Indices.AddUninitialized(geometry.IndicesCount);
+    uint32* indices = batch->Indices.Get() + item.StartIndex;
+    const uint32 indexOffset = vertexStart - geometry.BaseVertex;
+    if (geometry.Use16BitIndices)
+    {
+        const uint16* src = (const uint16*)geometry.Indices;
+        for (int32 i = 0; i < geometry.IndicesCount; i++)
+            indices[i] = indexOffset + src[i];
+    }
+    else
+    {
+        const uint32* src = (const uint32*)geometry.Indices;
+        for (int32 i = 0; i < geometry.IndicesCount; i++)
+            indices[i] = indexOffset + src[i];
+    }
+
+    return false;
+}
+
+void SpriteBatching::Execute(GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    if (_views.IsEmpty())
+        return;
+    PROFILE_CPU_NAMED("Sprite Batching");
+    const uint64 frame = Engine::FrameCount;
+    for (View* view : _views)
+    {
+        if (view->Batches.HasItems())
+        {
+            // Pick the buffers not used during the current frame (every view needs own buffers since all views are drawn after collecting draw calls)
+            Buffers* buffers = nullptr;
+            for (auto& e : _buffers)
+            {
+                if (e.LastFrameUsed != frame)
+                {
+                    buffers = &e;
+                    break;
+                }
+            }
+            if (!buffers)
+            {
+                buffers = &_buffers.AddOne();
+                buffers->VB0 = New<DynamicVertexBuffer>(1024, (uint32)sizeof(VB0ElementType), TEXT("SpriteBatching.VB0"));
+                buffers->VB1 = New<DynamicVertexBuffer>(1024, (uint32)sizeof(VB1ElementType), TEXT("SpriteBatching.VB1"));
+                buffers->VB2 = New<DynamicVertexBuffer>(1024, (uint32)sizeof(VB2ElementType), TEXT("SpriteBatching.VB2"));
+                buffers->IB = New<DynamicIndexBuffer>(1024, (uint32)sizeof(uint32), TEXT("SpriteBatching.IB"));
+            }
+            buffers->LastFrameUsed = frame;
+            buffers->VB0->Clear();
+            buffers->VB1->Clear();
+            buffers->VB2->Clear();
+            buffers->IB->Clear();
+
+            // Write all batches into the shared buffers (indices are sorted per-item for transparency)
+            int32 verticesCount = 0;
+            for (auto& e : view->Batches)
+            {
+                Batch* batch = e.Value;
+                batch->VertexOffset = verticesCount;
+                batch->IndexOffset = buffers->IB->Data.Count() / sizeof(uint32);
+                verticesCount += batch->VB0.Count();
+                buffers->VB0->Write(batch->VB0.Get(), batch->VB0.Count() * sizeof(VB0ElementType));
+                buffers->VB1->Write(batch->VB1.Get(), batch->VB1.Count() * sizeof(VB1ElementType));
+                buffers->VB2->Write(batch->VB2.Get(), batch->VB2.Count() * sizeof(VB2ElementType));
+                if (batch->Items.Count() > 1)
+                {
+                    // Back-to-front
+                    Sorting::QuickSort(batch->Items.Get(), batch->Items.Count(), +[](const Item& a, const Item& b) { return a.Distance > b.Distance; });
+                }
+                for (const Item& item : batch->Items)
+                    buffers->IB->Write(batch->Indices.Get() + item.StartIndex, item.IndicesCount * sizeof(uint32));
+            }
+            buffers->VB0->Flush(context);
+            buffers->VB1->Flush(context);
+            buffers->VB2->Flush(context);
+            buffers->IB->Flush(context);
+
+            // Draw every batch with a single draw call
+            DrawCall drawCall;
+            drawCall.Geometry.IndexBuffer = buffers->IB->GetBuffer();
+            drawCall.Geometry.VertexBuffers[0] = buffers->VB0->GetBuffer();
+            drawCall.Geometry.VertexBuffers[1] = buffers->VB1->GetBuffer();
+            drawCall.Geometry.VertexBuffers[2] = buffers->VB2->GetBuffer();
+            drawCall.InstanceCount = 1;
+            drawCall.World = Matrix::Identity;
+            drawCall.Surface.PrevWorld = Matrix::Identity;
+            drawCall.Surface.Lightmap = nullptr;
+            drawCall.Surface.LightmapUVsArea = Rectangle::Empty;
+            drawCall.Surface.Skinning = nullptr;
+            drawCall.Surface.LODDitherFactor = 0.0f;
+            drawCall.WorldDeterminantSign = 1.0f;
+            drawCall.PerInstanceRandom = 0.0f;
+            for (auto& e : view->Batches)
+            {
+                const Key& key = e.Key;
+                Batch* batch = e.Value;
+                drawCall.Geometry.VertexBuffersOffsets[0] = batch->VertexOffset * sizeof(VB0ElementType);
+                drawCall.Geometry.VertexBuffersOffsets[1] = batch->VertexOffset * sizeof(VB1ElementType);
+                drawCall.Geometry.VertexBuffersOffsets[2] = batch->VertexOffset * sizeof(VB2ElementType);
+                drawCall.Draw.StartIndex = batch->IndexOffset;
+                drawCall.Draw.IndicesCount = batch->Indices.Count();
+                drawCall.Material = batch->Material;
+                drawCall.ObjectPosition = batch->Box.GetCenter();
+                drawCall.Surface.GeometrySize = batch->Box.GetSize();
+                view->Context.List->AddDrawCall(view->Context, key.DrawModes, key.StaticFlags, drawCall, true, key.SortOrder);
+            }
+        }
+
+        // Recycle the view data
+        for (auto& e : view->Batches)
+        {
+            Batch* batch = e.Value;
+            batch->VB0.Clear();
+            batch->VB1.Clear();
+            batch->VB2.Clear();
+            batch->Indices.Clear();
+            batch->Items.Clear();
+            _freeBatches.Add(batch);
+        }
+        view->Batches.Clear();
+        _freeViews.Add(view);
+    }
+    _views.Clear();
+
+    // Release old buffers
+    for (int32 i = _buffers.Count() - 1; i >= 0; i--)
+    {
+        auto& e = _buffers[i];
+        if (e.LastFrameUsed + SPRITE_BATCHING_BUFFERS_LIFETIME < frame)
+        {
+            Delete(e.VB0);
+            Delete(e.VB1);
+            Delete(e.VB2);
+            Delete(e.IB);
+            _buffers.RemoveAt(i);
+        }
+    }
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/HashFunctions.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/Math/Color.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Graphics/Enums.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Models/Types.h"
+#include "Engine/Threading/Threading.h"
+
+// The maximum amount of vertices of the single geometry that can be batched (larger geometry is drawn directly)
+#define SPRITE_BATCHING_MAX_VERTICES 1024
+
+class DynamicVertexBuffer;
+class DynamicIndexBuffer;
+
+/// <summary>
+/// World-space 2D geometry batching (sprites and texts). Merges the geometry drawn with the same material and parameters into shared dynamic buffers, sorted back-to-front within the batch, to draw many small objects (eg. SpriteRender and TextRender actors) with a single draw call per material.
+/// </summary>
+/// <remarks>
+/// Geometry is transformed into the world-space (relative to the view origin) on the CPU so the batched draw calls use the identity world matrix. Views are registered by the renderer before collecting the draw calls (geometry drawn into other views is not batched).
+/// </remarks>
+class SpriteBatching : public RendererPass<SpriteBatching>
+{
+public:
+    /// <summary>
+    /// The batch key. Geometry with the same key can be merged into a single draw call (the material and all its parameters used by the geometry are the same).
+    /// </summary>
+    struct Key
+    {
+        /// <summary>
+        /// The base material of the material instance used by the geometry.
+        /// </summary>
+        MaterialBase* Material;
+
+        /// <summary>
+        /// The texture (or other object) set as the material parameter (eg. sprite image or font atlas).
+        /// </summary>
+        const void* Texture;
+
+        /// <summary>
+        /// The additional vector set as the material parameter (eg. sprite UVs transformation).
+        /// </summary>
+        Float4 Params;
+
+        /// <summary>
+        /// The color set as the material parameter.
+        /// </summary>
+        Color Color;
+
+        /// <summary>
+        /// The draw passes to use (already masked by the view and material draw passes).
+        /// </summary>
+        DrawPass DrawModes;
+
+        /// <summary>
+        /// The object static flags.
+        /// </summary>
+        StaticFlags StaticFlags;
+
+        /// <summary>
+        /// The object sort order key.
+        /// </summary>
+        int16 SortOrder;
+
+        bool operator==(const Key& other) const
+        {
+            return Material == other.Material && Texture == other.Texture && Params == other.Params && Color == other.Color && DrawModes == other.DrawModes && StaticFlags == other.StaticFlags && SortOrder == other.SortOrder;
+        }
+    };
+
+    /// <summary>
+    /// The geometry to batch (in the local-space).
+    /// </summary>
+    struct Geometry
+    {
+        const VB0ElementType* VB0;
+        const VB1ElementType* VB1;
+        // Optional vertex colors (white is used if not provided).
+        const VB2ElementType* VB2;
+        int32 VerticesCount;
+        const void* Indices;
+        int32 IndicesCount;
+        // The value subtracted from the indices (eg. when the vertices are the range of the larger vertex buffer).
+        int32 BaseVertex;
+        bool Use16BitIndices;
+    };
+
+private:
+    struct Item
+    {
+        int32 StartIndex;
+        int32 IndicesCount;
+        float Distance;
+    };
+
+    struct Batch
+    {
+        MaterialBase* Material;
+        BoundingBox Box;
+        int32 VertexOffset;
+        int32 IndexOffset;
+        Array<VB0ElementType> VB0;
+        Array<VB1ElementType> VB1;
+        Array<VB2ElementType> VB2;
+        Array<uint32> Indices;
+        Array<Item> Items;
+    };
+
+    struct View
+    {
+        RenderContext Context;
+        Dictionary<Key, Batch*> Batches;
+    };
+
+    struct Buffers
+    {
+        DynamicVertexBuffer* VB0;
+        DynamicVertexBuffer* VB1;
+        DynamicVertexBuffer* VB2;
+        DynamicIndexBuffer* IB;
+        uint64 LastFrameUsed;
+    };
+
+    CriticalSection _locker;
+    Array<View*> _views;
+    Array<View*> _freeViews;
+    Array<Batch*> _freeBatches;
+    Array<Buffers> _buffers;
+
+public:
+    /// <summary>
+    /// Registers the views to batch the geometry drawn into them. Called by the renderer before collecting draw calls.
+    /// </summary>
+    /// <param name="renderContextBatch">The rendering context batch.</param>
+    void Begin(const RenderContextBatch& renderContextBatch);
+
+    /// <summary>
+    /// Adds the geometry to the batch. Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="key">The batch key.</param>
+    /// <param name="material">The material used by the geometry. The first material added to the batch is used to draw it.</param>
+    /// <param name="world">The world matrix of the geometry (relative to the view origin).</param>
+    /// <param name="geometry">The geometry data (copied).</param>
+    /// <returns>True if cannot batch the geometry (eg. view is not registered or geometry is too large) so it has to be drawn directly, otherwise false.</returns>
+    bool Add(const RenderContext& renderContext, const Key& key, MaterialBase* material, const Matrix& world, const Geometry& geometry);
+
+    /// <summary>
+    /// Uploads the batched geometry and adds the draw calls to the registered views. Called by the renderer after collecting draw calls, before sorting them.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    void Execute(GPUContext* context);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    void Dispose() override;
+};
+
+inline uint32 GetHash(const SpriteBatching::Key& key)
+{
+    uint32 hash = GetHash(key.Material);
+    CombineHash(hash, GetHash(key.Texture));
+    CombineHash(hash, GetHash(key.Params.X));
+    CombineHash(hash, GetHash(key.Params.Y));
+    CombineHash(hash, GetHash(key.Params.Z));
+    CombineHash(hash, GetHash(key.Params.W));
+    CombineHash(hash, GetHash(key.Color.R));
+    CombineHash(hash, GetHash(key.Color.G));
+    CombineHash(hash, GetHash(key.Color.B));
+    CombineHash(hash, GetHash(key.Color.A));
+    CombineHash(hash, (uint32)key.DrawModes);
+    CombineHash(hash, (uint32)key.StaticFlags);
+    CombineHash(hash, (uint32)key.SortOrder);
+    return hash;
+}
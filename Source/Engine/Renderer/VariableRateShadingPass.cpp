@@ -0,0 +1,151 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "VariableRateShadingPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+// The minimum relative luminance difference between the neighbor pixels that requires the full shading rate
+#define VRS_CONTRAST_THRESHOLD 0.06f
+
+// The motion length (in pixels) above which the contrast threshold is increased (fast moving areas are blurred by motion blur and TAA)
+#define VRS_MOTION_THRESHOLD 8.0f
+
+PACK_STRUCT(struct Data {
+    Float2 InputSize;
+    uint32 TileSize;
+    uint32 SampleStride;
+    float ContrastThreshold;
+    float MotionThreshold;
+    uint32 MaxShadingRate;
+    float Dummy0;
+    });
+
+String VariableRateShadingPass::ToString() const
+{
+    return TEXT("VariableRateShadingPass");
+}
+
+bool VariableRateShadingPass::Init()
+{
+    // Shading rate image and compute shaders support is required for this implementation
+    const auto& limits = GPUDevice::Instance->Limits;
+    if (!limits.HasVariableRateShadingImage || !limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/VariableRateShading"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<VariableRateShadingPass, &VariableRateShadingPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool VariableRateShadingPass::setupResources()
+{
+    // Check if shader has not been loaded
+    if (!_shader || !_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    if (shader->GetCB(0)->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _csGenerate[0] = shader->GetCS("CS_Generate", 0);
+    _csGenerate[1] = shader->GetCS("CS_Generate", 1);
+
+    return false;
+}
+
+void VariableRateShadingPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _csGenerate[0] = _csGenerate[1] = nullptr;
+    _shader = nullptr;
+}
+
+bool VariableRateShadingPass::CanUse() const
+{
+    return Graphics::EnableVariableRateShading && _shader && _shader->IsLoaded();
+}
+
+void VariableRateShadingPass::Render(RenderContext& renderContext, GPUContext* context, GPUTexture* frame)
+{
+    if (!CanUse() || checkIfSkipPass())
+        return;
+    PROFILE_GPU_CPU("Shading Rate Image");
+    auto& limits = GPUDevice::Instance->Limits;
+    auto buffers = renderContext.Buffers;
+    const int32 tileSize = limits.VariableRateShadingTileSize;
+    const int32 width = Math::DivideAndRoundUp(frame->Width(), tileSize);
+    const int32 height = Math::DivideAndRoundUp(frame->Height(), tileSize);
+
+    // Prepare the image
+    buffers->LastFrameShadingRateImage = Engine::FrameCount;
+    if (buffers->ShadingRateImage && (buffers->ShadingRateImage->Width() != width || buffers->ShadingRateImage->Height() != height))
+    {
+        // Wrong size image
+        RenderTargetPool::Release(buffers->ShadingRateImage);
+        buffers->ShadingRateImage = nullptr;
+    }
+    if (buffers->ShadingRateImage == nullptr)
+    {
+        auto desc = GPUTextureDescription::New2D(width, height, PixelFormat::R8_UInt, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess);
+        buffers->ShadingRateImage = RenderTargetPool::Get(desc);
+        if (!buffers->ShadingRateImage)
+            return;
+        RENDER_TARGET_POOL_SET_NAME(buffers->ShadingRateImage, "ShadingRateImage");
+    }
+
+    // Generate the shading rates (single thread group per tile)
+    const bool useMotionVectors = renderContext.List->Setup.UseMotionVectors && buffers->MotionVectors && buffers->MotionVectors->IsAllocated();
+    Data data;
+    data.InputSize = Float2((float)frame->Width(), (float)frame->Height());
+    data.TileSize = tileSize;
+    data.SampleStride = Math::Max(tileSize / 8, 1);
+    data.ContrastThreshold = VRS_CONTRAST_THRESHOLD;
+    data.MotionThreshold = VRS_MOTION_THRESHOLD;
+    data.MaxShadingRate = (uint32)(limits.HasVariableRateShadingLargeRates ? GPUShadingRate::Rate4x4 : GPUShadingRate::Rate2x2);
+    data.Dummy0 = 0.0f;
+    const auto cb = _shader->GetShader()->GetCB(0);
+    context->UpdateCB(cb, &data);
+    context->BindCB(0, cb);
+    context->BindSR(0, frame->View());
+    context->BindSR(1, useMotionVectors ? buffers->MotionVectors->View() : nullptr);
+    context->BindUA(0, buffers->ShadingRateImage->View());
+    context->Dispatch(_csGenerate[useMotionVectors ? 1 : 0], width, height, 1);
+    context->ResetUA();
+    context->ResetSR();
+}
+
+bool VariableRateShadingPass::Bind(RenderContext& renderContext, GPUContext* context)
+{
+    // Use the image from the previous frame only if it matches the current view size
+    auto buffers = renderContext.Buffers;
+    if (!CanUse() || !buffers || !buffers->ShadingRateImage || buffers->LastFrameShadingRateImage + 1 != Engine::FrameCount)
+        return false;
+    const int32 tileSize = GPUDevice::Instance->Limits.VariableRateShadingTileSize;
+    if (buffers->ShadingRateImage->Width() != Math::DivideAndRoundUp(buffers->GetWidth(), tileSize) ||
+        buffers->ShadingRateImage->Height() != Math::DivideAndRoundUp(buffers->GetHeight(), tileSize))
+        return false;
+    context->SetShadingRateImage(buffers->ShadingRateImage);
+    return true;
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+
+/// <summary>
+/// Variable rate shading support. Generates the screen-space shading rate image from the scene color contrast and motion vectors that is used to reduce the pixel shading cost of the low-detail regions during the next frame GBuffer and forward passes.
+/// </summary>
+class VariableRateShadingPass : public RendererPass<VariableRateShadingPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUShaderProgramCS* _csGenerate[2] = {};
+
+public:
+    /// <summary>
+    /// Checks if the shading rate image can be used (enabled in graphics settings, supported by the device and shader is loaded).
+    /// </summary>
+    bool CanUse() const;
+
+    /// <summary>
+    /// Generates the shading rate image from the rendered scene color (used by the next frame).
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="frame">The rendered scene color (before post-processing).</param>
+    void Render(RenderContext& renderContext, GPUContext* context, GPUTexture* frame);
+
+    /// <summary>
+    /// Sets the shading rate image generated in the previous frame for the following draw calls (if valid for the current view).
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    /// <returns>True if shading rate image has been set, otherwise false.</returns>
+    bool Bind(RenderContext& renderContext, GPUContext* context);
+
+private:
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csGenerate[0] = _csGenerate[1] = nullptr;
+        invalidateResources();
+    }
+#endif
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
@@ -0,0 +1,20 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+using System;
+
+namespace FlaxEngine
+{
+    /// <summary>
+    /// Makes a script OnUpdate method called from the Job System threads in parallel with other scripts marked with this attribute (before the regular scripts update). Script update must be thread-safe: it cannot modify the scene hierarchy (spawn, destroy, reparent or enable/disable objects), access the level or share state with other scripts. Use OnLateUpdate to apply results on the main thread.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Class)]
+    public sealed class ParallelUpdateAttribute : Attribute
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ParallelUpdateAttribute"/> class.
+        /// </summary>
+        public ParallelUpdateAttribute()
+        {
+        }
+    }
+}
@@ -672,6 +672,18 @@ void MCore::GC::WaitForPendingFinalizers()
 #endif
 }
 
+int32 MCore::GC::GetCollectionsCount()
+{
+#if USE_MONO
+    int32 result = 0;
+    for (int32 generation = 0; generation <= mono_gc_max_generation(); generation++)
+        result += mono_gc_collection_count(generation);
+    return result;
+#else
+    return 0;
+#endif
+}
+
 #if USE_MONO && PLATFORM_WIN32 && !USE_MONO_DYNAMIC_LIB
 
 // Export Mono functions
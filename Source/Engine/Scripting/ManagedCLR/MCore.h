@@ -81,5 +81,10 @@ class FLAXENGINE_API MCore
         /// Suspends the current thread until the thread that is processing the queue of finalizers has emptied that queue.
         /// </summary>
         static void WaitForPendingFinalizers();
+
+        /// <summary>
+        /// Gets the total amount of garbage collections (of all generations) executed since the runtime start.
+        /// </summary>
+        static int32 GetCollectionsCount();
     };
 };
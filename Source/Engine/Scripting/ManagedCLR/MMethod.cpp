@@ -89,7 +89,14 @@ MObject* MMethod::InvokeVirtual(MObject* instance, void** params, MObject** exce
 #endif
 }
 
-#if !USE_MONO_AOT
+#if USE_MONO_AOT
+
+void* MMethod::UnboxResult(MObject* obj)
+{
+    return mono_object_unbox(obj);
+}
+
+#else
 
 void* MMethod::GetThunk()
 {
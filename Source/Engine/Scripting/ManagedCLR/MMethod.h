@@ -34,6 +34,48 @@ class FLAXENGINE_API MMethod
 
     Array<MObject*> _attributes;
 
+#if USE_MONO_AOT
+    static void* UnboxResult(MObject* obj);
+
+    template<typename T>
+    static void* ThunkParam(T& value)
+    {
+        return &value;
+    }
+
+    template<typename T>
+    static void* ThunkParam(T* value)
+    {
+        return (void*)value;
+    }
+
+    template<typename T, typename Dummy = void>
+    struct ThunkResult
+    {
+        static T Get(MObject* result)
+        {
+            return *(T*)UnboxResult(result);
+        }
+    };
+
+    template<typename T, typename Dummy>
+    struct ThunkResult<T*, Dummy>
+    {
+        static T* Get(MObject* result)
+        {
+            return (T*)result;
+        }
+    };
+
+    template<typename Dummy>
+    struct ThunkResult<void, Dummy>
+    {
+        static void Get(MObject* result)
+        {
+        }
+    };
+#endif
+
 public:
 
 #if USE_MONO
@@ -90,6 +132,28 @@ class FLAXENGINE_API MMethod
     void* GetThunk();
 #endif
 
+    /// <summary>
+    /// Invokes the method with the typed arguments. Uses the cached method thunk (if supported) so there is no params array and primitive values are not boxed.
+    /// </summary>
+    /// <remarks>
+    /// Arguments and the return value have to be primitive types or enums (passed by value), or pointers (managed objects as MObject*, structures boxed). For instance methods the first argument is the object instance.
+    /// </remarks>
+    /// <param name="exception">An optional pointer to the exception value to store exception object reference.</param>
+    /// <param name="args">The method arguments.</param>
+    /// <returns>The method result value.</returns>
+    template<typename R, typename... Args>
+    R InvokeThunk(MObject** exception, Args... args)
+    {
+#if USE_MONO_AOT
+        void* params[sizeof...(Args) + 1] = { ThunkParam(args)... };
+        MObject* result = _isStatic ? Invoke(nullptr, params, exception) : Invoke(params[0], params + 1, exception);
+        return ThunkResult<R>::Get(result);
+#else
+        typedef R (*Thunk)(Args..., MObject**);
+        return ((Thunk)GetThunk())(args..., exception);
+#endif
+    }
+
     /// <summary>
     /// Gets the method name.
     /// </summary>
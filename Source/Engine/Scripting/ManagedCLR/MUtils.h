@@ -465,6 +465,23 @@ namespace MUtils
         return MUtils::ToArray(Span<T>(data.Get(), data.Count()), valueClass);
     }
 
+    /// <summary>
+    /// Copies contents from given native array into the existing managed array (caller-provided buffer, no allocations). Items that don't fit into the managed array are skipped.
+    /// </summary>
+    /// <param name="arrayObj">The managed array object.</param>
+    /// <param name="data">The native array data.</param>
+    template<typename T>
+    void CopyToArray(MonoArray* arrayObj, const Span<T>& data)
+    {
+        if (!arrayObj)
+            return;
+        int32 length = (int32)mono_array_length(arrayObj);
+        if (length > data.Length())
+            length = data.Length();
+        MConverter<T> converter;
+        converter.ToManagedArray(arrayObj, Span<T>(data.Get(), length));
+    }
+
     /// <summary>
     /// Converts the managed array into native array container object.
     /// </summary>
@@ -20,16 +20,10 @@ void ManagedSerialization::Serialize(ISerializable::SerializeStream& stream, MOb
         return;
     }
 
-    // Prepare arguments
-    bool isManagedOnly = true;
-    void* params[2];
-    params[0] = object;
-    params[1] = &isManagedOnly;
-
     // Call serialization tool
+    const bool isManagedOnly = true;
     MObject* exception = nullptr;
-    // TODO: use method thunk
-    auto invokeResultStr = (MonoString*)StdTypesContainer::Instance()->Json_Serialize->Invoke(nullptr, params, &exception);
+    auto invokeResultStr = StdTypesContainer::Instance()->Json_Serialize->InvokeThunk<MonoString*>(&exception, object, isManagedOnly);
     if (exception)
     {
         MException ex(exception);
@@ -57,17 +51,10 @@ void ManagedSerialization::SerializeDiff(ISerializable::SerializeStream& stream,
         return;
     }
 
-    // Prepare arguments
-    bool isManagedOnly = true;
-    void* params[3];
-    params[0] = object;
-    params[1] = other;
-    params[2] = &isManagedOnly;
-
     // Call serialization tool
+    const bool isManagedOnly = true;
     MObject* exception = nullptr;
-    // TODO: use method thunk
-    auto invokeResultStr = (MonoString*)StdTypesContainer::Instance()->Json_SerializeDiff->Invoke(nullptr, params, &exception);
+    auto invokeResultStr = StdTypesContainer::Instance()->Json_SerializeDiff->InvokeThunk<MonoString*>(&exception, object, other, isManagedOnly);
     if (exception)
     {
         MException ex(exception);
@@ -109,16 +96,9 @@ void ManagedSerialization::Deserialize(const StringAnsiView& data, MObject* obje
     if (StringUtils::Compare(str, "{}") == 0)
         return;
 
-    // Prepare arguments
-    void* args[3];
-    args[0] = object;
-    args[1] = (void*)str;
-    args[2] = (void*)&len;
-
     // Call serialization tool
     MObject* exception = nullptr;
-    // TODO: use method thunk
-    StdTypesContainer::Instance()->Json_Deserialize->Invoke(nullptr, args, &exception);
+    StdTypesContainer::Instance()->Json_Deserialize->InvokeThunk<void>(&exception, object, (void*)str, len);
     if (exception)
     {
         MException ex(exception);
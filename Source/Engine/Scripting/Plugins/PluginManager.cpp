@@ -92,6 +92,10 @@ class PluginManagerService : public EngineService
     PluginManagerService()
         : EngineService(TEXT("Plugin Manager"), 130)
     {
+        // Plugins code can use any engine system
+        AddDependency(TEXT("Audio"));
+        AddDependency(TEXT("Physics"));
+        AddDependency(TEXT("Navigation"));
     }
 
     bool Init() override;
@@ -260,10 +264,19 @@ void PluginManagerImpl::OnBinaryModuleLoaded(BinaryModule* module)
 void PluginManagerImpl::OnScriptsReloading()
 {
     // When scripting is reloading (eg. for hot-reload in Editor) we have to deinitialize plugins (Scripting service destroys C# objects later on)
+    // Plugins from the unchanged modules are kept loaded
+#if USE_EDITOR
+    Array<BinaryModule*> modulesToReload;
+    Scripting::GetModulesToReload(modulesToReload);
+#endif
     bool changed = false;
     for (int32 i = EditorPlugins.Count() - 1; i >= 0 && EditorPlugins.Count() > 0; i--)
     {
         auto plugin = EditorPlugins[i];
+#if USE_EDITOR
+        if (!modulesToReload.Contains(plugin->GetTypeHandle().Module))
+            continue;
+#endif
         {
             PluginManagerService::InvokeDeinitialize(plugin);
             EditorPlugins.RemoveAtKeepOrder(i);
@@ -273,6 +286,10 @@ void PluginManagerImpl::OnScriptsReloading()
     for (int32 i = GamePlugins.Count() - 1; i >= 0 && GamePlugins.Count() > 0; i--)
     {
         auto plugin = GamePlugins[i];
+#if USE_EDITOR
+        if (!modulesToReload.Contains(plugin->GetTypeHandle().Module))
+            continue;
+#endif
         {
             PluginManagerService::InvokeDeinitialize(plugin);
             GamePlugins.RemoveAtKeepOrder(i);
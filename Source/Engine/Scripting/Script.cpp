@@ -2,9 +2,9 @@
 
 #include "Script.h"
 #include "Engine/Core/Log.h"
-#if USE_EDITOR
 #include "StdTypesContainer.h"
 #include "ManagedCLR/MClass.h"
+#if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
 #include "Scripting.h"
@@ -26,8 +26,11 @@ Script::Script(const SpawnParams& params)
     , _tickFixedUpdate(false)
     , _tickUpdate(false)
     , _tickLateUpdate(false)
+    , _tickParallelUpdate(false)
     , _wasStartCalled(false)
     , _wasEnableCalled(false)
+    , _tickIndex{ -1, -1, -1 }
+    , _tickGroup(-1)
 {
 #if USE_EDITOR
     _executeInEditor = GetClass()->HasAttribute(StdTypesContainer::Instance()->ExecuteInEditModeAttribute);
@@ -184,6 +187,14 @@ void Script::SetupType()
         }
         typeHandle = type.GetBaseType();
     }
+#if !COMPILE_WITHOUT_CSHARP
+
+    // Check if script can be updated from the Job System
+    const MClass* klass = GetClass();
+    const MClass* parallelUpdateAttribute = StdTypesContainer::Instance()->ParallelUpdateAttribute;
+    if (klass && parallelUpdateAttribute)
+        _tickParallelUpdate = klass->HasAttribute(parallelUpdateAttribute);
+#endif
 }
 
 void Script::Start()
@@ -231,6 +242,19 @@ void Script::Disable()
     }
 }
 
+void Script::SetTickGroup(int32 value)
+{
+    value = Math::Max(value, -1);
+    if (_tickGroup == value)
+        return;
+    const bool isTicking = _wasEnableCalled && _parent && _parent->GetScene();
+    if (isTicking)
+        _parent->GetScene()->Ticking.RemoveScript(this);
+    _tickGroup = value;
+    if (isTicking)
+        _parent->GetScene()->Ticking.AddScript(this);
+}
+
 String Script::ToString() const
 {
     const auto& type = GetType();
@@ -285,12 +309,14 @@ void Script::BeginPlay(SceneBeginData* data)
 
     // Set flag
     Flags |= ObjectFlags::IsDuringPlay;
+    Level::registerScript(this);
 }
 
 void Script::EndPlay()
 {
     // Clear flag
     Flags &= ~ObjectFlags::IsDuringPlay;
+    Level::unregisterScript(this);
 
     // Cleanup managed object
     DestroyManaged();
@@ -306,6 +332,11 @@ void Script::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_GET_OTHER_OBJ(Script);
 
     SERIALIZE_BIT_MEMBER(Enabled, _enabled);
+    if (other ? _tickGroup != other->_tickGroup : _tickGroup != -1)
+    {
+        stream.JKEY("TickGroup");
+        stream.Int(_tickGroup);
+    }
 }
 
 void Script::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -315,6 +346,11 @@ void Script::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier
 
     DESERIALIZE_BIT_MEMBER(Enabled, _enabled);
     DESERIALIZE_MEMBER(PrefabID, _prefabID);
+    {
+        int32 tickGroup = _tickGroup;
+        DESERIALIZE_MEMBER(TickGroup, tickGroup);
+        SetTickGroup(tickGroup);
+    }
 
     {
         const auto member = SERIALIZE_FIND_MEMBER(stream, "ParentID");
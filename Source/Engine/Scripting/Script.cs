@@ -1,5 +1,7 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
+using System;
+
 namespace FlaxEngine
 {
     partial class Script
@@ -36,5 +38,21 @@ public Transform LocalTransform
             get => Actor.LocalTransform;
             set => Actor.LocalTransform = value;
         }
+
+        internal static void Internal_UpdateBatch(Script[] scripts, int count)
+        {
+            // Batched update of the scripts (see Level.BatchManagedScriptsUpdate)
+            for (int i = 0; i < count; i++)
+            {
+                try
+                {
+                    scripts[i].OnUpdate();
+                }
+                catch (Exception ex)
+                {
+                    Debug.LogException(ex);
+                }
+            }
+        }
     }
 }
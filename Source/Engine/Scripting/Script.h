@@ -19,11 +19,14 @@ API_CLASS(Abstract) class FLAXENGINE_API Script : public SceneObject
     int32 _tickFixedUpdate : 1;
     int32 _tickUpdate : 1;
     int32 _tickLateUpdate : 1;
+    int32 _tickParallelUpdate : 1;
     int32 _wasStartCalled : 1;
     int32 _wasEnableCalled : 1;
 #if USE_EDITOR
     int32 _executeInEditor : 1;
 #endif
+    int32 _tickIndex[3];
+    int32 _tickGroup;
 
 public:
     /// <summary>
@@ -51,6 +54,20 @@ API_CLASS(Abstract) class FLAXENGINE_API Script : public SceneObject
     /// </summary>
     API_PROPERTY() void SetActor(Actor* value);
 
+    /// <summary>
+    /// Gets the index of the tick group (see TimeSettings.TickGroups) used to update this script at the custom rate with time-slicing across frames. Affects only OnUpdate (ignored for scripts with ParallelUpdate attribute). Value -1 means that script is updated every frame.
+    /// </summary>
+    API_PROPERTY(Attributes="HideInEditor, NoAnimate")
+    FORCE_INLINE int32 GetTickGroup() const
+    {
+        return _tickGroup;
+    }
+
+    /// <summary>
+    /// Sets the index of the tick group (see TimeSettings.TickGroups) used to update this script at the custom rate with time-slicing across frames. Affects only OnUpdate (ignored for scripts with ParallelUpdate attribute). Value -1 means that script is updated every frame.
+    /// </summary>
+    API_PROPERTY() void SetTickGroup(int32 value);
+
 public:
     /// <summary>
     /// Called after the object is loaded.
@@ -80,6 +97,13 @@ API_CLASS(Abstract) class FLAXENGINE_API Script : public SceneObject
     {
     }
 
+    /// <summary>
+    /// Called when the prefab instance that contains this script gets reused from the pool (see PrefabManager.SpawnPooled). Can be used to reset the object state. Called before the object becomes active again.
+    /// </summary>
+    API_FUNCTION(Attributes="NoAnimate") virtual void OnPoolReuse()
+    {
+    }
+
     /// <summary>
     /// Called when a script is enabled just before any of the Update methods is called for the first time.
     /// </summary>
@@ -3,6 +3,7 @@
 #include "BinaryModule.h"
 #include "Scripting.h"
 #include "StdTypesContainer.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
 #include "ScriptingType.h"
 #include "FlaxEngine.Gen.h"
 #include "Engine/Threading/Threading.h"
@@ -24,6 +25,7 @@
 #include "Engine/Core/ObjectsRemovalService.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Engine/EngineService.h"
@@ -58,7 +60,6 @@ namespace
 {
     MDomain* _rootDomain = nullptr;
     MDomain* _scriptsDomain = nullptr;
-    CriticalSection _objectsLocker;
 #define USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING 0
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     struct ScriptingObjectData
@@ -94,10 +95,31 @@ namespace
         }
     };
 
-    Dictionary<Guid, ScriptingObjectData> _objectsDictionary(1024 * 16);
+    typedef ScriptingObjectData ObjectsRegistryItem;
 #else
-    Dictionary<Guid, ScriptingObject*> _objectsDictionary(1024 * 16);
+    typedef ScriptingObject* ObjectsRegistryItem;
 #endif
+
+    // The objects registry is split into shards (by the object id) with a separate lock each so lookups from multiple threads don't serialize on a single lock
+#define SCRIPTING_OBJECTS_SHARDS 64
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) ObjectsShard
+    {
+        CriticalSection Locker;
+        FlatDictionary<Guid, ObjectsRegistryItem> Objects;
+
+        ObjectsShard()
+            : Objects(1024 * 16 / SCRIPTING_OBJECTS_SHARDS)
+        {
+        }
+    };
+
+    ObjectsShard _objectsShards[SCRIPTING_OBJECTS_SHARDS];
+
+    FORCE_INLINE ObjectsShard& GetObjectsShard(const Guid& id)
+    {
+        // Use the high bits of the scrambled hash so the keys within the shard are not clustered in the dictionary buckets
+        return _objectsShards[(GetHash(id) * 2654435761u) >> 26];
+    }
     bool _isEngineAssemblyLoaded = false;
     bool _hasGameModulesLoaded = false;
     MMethod* _method_Update = nullptr;
@@ -108,6 +130,28 @@ namespace
     Array<BinaryModule*, InlinedAllocation<64>> _nonNativeModules;
 #if USE_EDITOR
     bool LastBinariesLoadTriggeredCompilation = false;
+
+    // Game binary modules files with their modification time at load (used to skip reloading unchanged modules)
+    struct ModuleBinariesInfo
+    {
+        String NativePath;
+        String ManagedPath;
+        DateTime Time;
+    };
+
+    Dictionary<BinaryModule*, ModuleBinariesInfo> _modulesBinaries;
+    Array<BinaryModule*> _modulesToReload;
+    bool _isReloading = false;
+
+    DateTime GetModuleBinariesTime(const ModuleBinariesInfo& info)
+    {
+        DateTime result = DateTime::MinValue();
+        if (info.NativePath.HasChars() && FileSystem::FileExists(info.NativePath))
+            result = FileSystem::GetFileLastEditTime(info.NativePath);
+        if (info.ManagedPath.HasChars() && FileSystem::FileExists(info.ManagedPath))
+            result = Math::Max(result, FileSystem::GetFileLastEditTime(info.ManagedPath));
+        return result;
+    }
 #endif
 }
 
@@ -191,13 +235,14 @@ bool ScriptingService::Init()
 		} \
 	} \
 	MObject* exception = nullptr; \
-	_method_##name->Invoke(nullptr, nullptr, &exception); \
+	_method_##name->InvokeThunk<void>(&exception); \
 	DebugLog::LogException(exception)
 #endif
 
 void ScriptingService::Update()
 {
     PROFILE_CPU_NAMED("Scripting::Update");
+    PROFILE_MEM(Scripting);
 
     INVOKE_EVENT(Update);
 }
@@ -205,6 +250,7 @@ void ScriptingService::Update()
 void ScriptingService::LateUpdate()
 {
     PROFILE_CPU_NAMED("Scripting::LateUpdate");
+    PROFILE_MEM(Scripting);
 
     INVOKE_EVENT(LateUpdate);
 }
@@ -212,6 +258,7 @@ void ScriptingService::LateUpdate()
 void ScriptingService::FixedUpdate()
 {
     PROFILE_CPU_NAMED("Scripting::FixedUpdate");
+    PROFILE_MEM(Scripting);
 
     INVOKE_EVENT(FixedUpdate);
 }
@@ -334,6 +381,13 @@ bool Scripting::LoadBinaryModules(const String& path, const String& projectFolde
 
             // Check if that module has been already registered
             BinaryModule* module = BinaryModule::GetModule(nameAnsi);
+#if USE_EDITOR
+            if (module && _modulesBinaries.ContainsKey(module))
+            {
+                // Skip module that has been kept loaded during scripts reload
+                continue;
+            }
+#endif
             if (!module)
             {
                 // C++
@@ -411,6 +465,13 @@ bool Scripting::LoadBinaryModules(const String& path, const String& projectFolde
             }
 #endif
 
+#if USE_EDITOR
+            auto& binaries = _modulesBinaries[module];
+            binaries.NativePath = nativePath;
+            binaries.ManagedPath = managedPath;
+            binaries.Time = GetModuleBinariesTime(binaries);
+#endif
+
             BinaryModuleLoaded(module);
         }
     }
@@ -421,6 +482,7 @@ bool Scripting::LoadBinaryModules(const String& path, const String& projectFolde
 bool Scripting::Load()
 {
     PROFILE_CPU();
+    PROFILE_MEM(Scripting);
     // Note: this action can be called from main thread (due to Mono problems with assemblies actions from other threads)
     ASSERT(IsInMainThread());
 
@@ -505,9 +567,10 @@ void Scripting::Release()
     MCore::GC::WaitForPendingFinalizers();
 
     // Release managed objects instances for persistent objects (assets etc.)
-    _objectsLocker.Lock();
+    for (auto& shard : _objectsShards)
     {
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
         {
             auto obj = i->Value;
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
@@ -516,7 +579,6 @@ void Scripting::Release()
             obj->OnScriptingDispose();
         }
     }
-    _objectsLocker.Unlock();
 
     // Unload assemblies (from back to front)
     {
@@ -536,6 +598,9 @@ void Scripting::Release()
         }
         _nonNativeModules.ClearDelete();
         _hasGameModulesLoaded = false;
+#if USE_EDITOR
+        _modulesBinaries.Clear();
+#endif
     }
 
     // Cleanup
@@ -581,6 +646,38 @@ void Scripting::Reload(bool canTriggerSceneReload)
         return;
     }
 
+    ReloadModules();
+}
+
+void Scripting::GetModulesToReload(Array<BinaryModule*>& result)
+{
+    result.Clear();
+    if (_isReloading)
+    {
+        result.Add(_modulesToReload);
+        return;
+    }
+
+    // Modules are registered in the load order (references go first) so every module loaded after the modified one is reloaded too as it might depend on it
+    const auto& modules = BinaryModule::GetModules();
+    bool modified = false;
+    for (int32 i = 0; i < modules.Count(); i++)
+    {
+        BinaryModule* module = modules[i];
+        if (module == GetBinaryModuleCorlib() || module == GetBinaryModuleFlaxEngine())
+            continue;
+        if (!modified)
+        {
+            const ModuleBinariesInfo* binaries = _modulesBinaries.TryGet(module);
+            modified = !binaries || GetModuleBinariesTime(*binaries) != binaries->Time;
+        }
+        if (modified)
+            result.Add(module);
+    }
+}
+
+void Scripting::ReloadModules()
+{
     PROFILE_CPU();
 
     // Ideally we would call Release and Load but this would also reload Editor objects which we want avoid
@@ -596,6 +693,9 @@ void Scripting::Reload(bool canTriggerSceneReload)
     }
 
     LOG(Info, "Start user scripts reload");
+    GetModulesToReload(_modulesToReload);
+    _isReloading = true;
+    LOG(Info, "Reloading {0} game binary module(s)", _modulesToReload.Count());
     ScriptsReloading();
 
     // Flush cache (some objects may be deleted after reload start event)
@@ -605,37 +705,35 @@ void Scripting::Reload(bool canTriggerSceneReload)
     MCore::GC::Collect();
     MCore::GC::WaitForPendingFinalizers();
 
-    // Destroy objects from game assemblies (eg. not released objects that might crash if persist in memory after reload)
-    _objectsLocker.Lock();
+    // Destroy objects from reloaded game assemblies (eg. not released objects that might crash if persist in memory after reload)
     {
-        const auto flaxModule = GetBinaryModuleFlaxEngine();
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+        for (auto& shard : _objectsShards)
         {
-            auto obj = i->Value;
-            if (obj->GetTypeHandle().Module == flaxModule)
-                continue;
+            ScopeLock lock(shard.Locker);
+            for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+            {
+                auto obj = i->Value;
+                if (!_modulesToReload.Contains(obj->GetTypeHandle().Module))
+                    continue;
 
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-            LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj.Ptr, String(obj.TypeName));
+                LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj.Ptr, String(obj.TypeName));
 #endif
-            obj->OnScriptingDispose();
+                obj->OnScriptingDispose();
+            }
         }
     }
-    _objectsLocker.Unlock();
 
-    // Unload all game modules
+    // Unload modified game modules (from back to front)
     LOG(Info, "Unloading game binary modules");
-    auto modules = BinaryModule::GetModules();
-    for (int32 i = modules.Count() - 1; i >= 0; i--)
+    for (int32 i = _modulesToReload.Count() - 1; i >= 0; i--)
     {
-        BinaryModule* module = modules[i];
-        if (module == GetBinaryModuleCorlib() || module == GetBinaryModuleFlaxEngine())
-            continue;
-
+        BinaryModule* module = _modulesToReload[i];
+        _modulesBinaries.Remove(module);
         module->Destroy(true);
+        if (_nonNativeModules.Remove(module))
+            Delete(module);
     }
-    modules.Clear();
-    _nonNativeModules.ClearDelete();
     _hasGameModulesLoaded = false;
 
     // Give GC a try to cleanup old user objects and the other mess
@@ -648,6 +746,8 @@ void Scripting::Reload(bool canTriggerSceneReload)
         LOG(Error, "User assemblies reload failed.");
     }
 
+    _isReloading = false;
+    _modulesToReload.Clear();
     ScriptsReloaded();
     LOG(Info, "End user scripts reload");
 }
@@ -808,15 +908,17 @@ ScriptingObject* Scripting::FindObject(Guid id, MClass* type)
     // Try to find it
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
+    ObjectsShard& shard = GetObjectsShard(id);
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, data);
+    shard.Locker.Unlock();
     auto result = data.Ptr;
 #else
     ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
+    ObjectsShard& shard = GetObjectsShard(id);
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, result);
+    shard.Locker.Unlock();
 #endif
     if (result)
     {
@@ -862,15 +964,17 @@ ScriptingObject* Scripting::TryFindObject(Guid id, MClass* type)
     // Try to find it
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
+    ObjectsShard& shard = GetObjectsShard(id);
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, data);
+    shard.Locker.Unlock();
     auto result = data.Ptr;
 #else
     ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
+    ObjectsShard& shard = GetObjectsShard(id);
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, result);
+    shard.Locker.Unlock();
 #endif
 
     // Check type
@@ -886,12 +990,15 @@ ScriptingObject* Scripting::TryFindObject(MClass* mclass)
 {
     if (mclass == nullptr)
         return nullptr;
-    ScopeLock lock(_objectsLocker);
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+    for (auto& shard : _objectsShards)
     {
-        const auto obj = i->Value;
-        if (obj->GetClass() == mclass)
-            return obj;
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+        {
+            const auto obj = i->Value;
+            if (obj->GetClass() == mclass)
+                return obj;
+        }
     }
     return nullptr;
 }
@@ -904,13 +1011,15 @@ ScriptingObject* Scripting::FindObject(const MObject* managedInstance)
 
     // TODO: optimize it by reading the unmanagedPtr or _internalId from managed Object property
 
-    ScopeLock lock(_objectsLocker);
-
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+    for (auto& shard : _objectsShards)
     {
-        const auto obj = i->Value;
-        if (obj->GetManagedInstance() == managedInstance)
-            return obj;
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+        {
+            const auto obj = i->Value;
+            if (obj->GetManagedInstance() == managedInstance)
+                return obj;
+        }
     }
     return nullptr;
 }
@@ -921,8 +1030,10 @@ void Scripting::OnManagedInstanceDeleted(ScriptingObject* obj)
     ASSERT(obj);
 
     // Validate if object still exists
-    _objectsLocker.Lock();
-    if (_objectsDictionary.ContainsValue(obj))
+    ObjectsShard& shard = GetObjectsShard(obj->GetID());
+    shard.Locker.Lock();
+    ObjectsRegistryItem item;
+    if (shard.Objects.TryGet(obj->GetID(), item) && (ScriptingObject*)item == obj)
     {
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
         LOG(Info, "[OnManagedInstanceDeleted] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
@@ -933,7 +1044,7 @@ void Scripting::OnManagedInstanceDeleted(ScriptingObject* obj)
     {
         //LOG(Warning, "Object finalization called for already removed object (address={0:x})", (uint64)obj);
     }
-    _objectsLocker.Unlock();
+    shard.Locker.Unlock();
 }
 
 bool Scripting::HasGameModulesLoaded()
@@ -960,56 +1071,55 @@ bool Scripting::IsTypeFromGameScripts(MClass* type)
 
 void Scripting::RegisterObject(ScriptingObject* obj)
 {
-    ScopeLock lock(_objectsLocker);
+    ObjectsShard& shard = GetObjectsShard(obj->GetID());
+    ScopeLock lock(shard.Locker);
 
-    //ASSERT(!_objectsDictionary.ContainsValue(obj));
 #if ENABLE_ASSERTION
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-    ScriptingObjectData other;
-    if (_objectsDictionary.TryGet(obj->GetID(), other))
-#else
-    ScriptingObject* other;
-    if (_objectsDictionary.TryGet(obj->GetID(), other))
-#endif
+    ObjectsRegistryItem other;
+    if (shard.Objects.TryGet(obj->GetID(), other))
     {
         // Something went wrong...
         LOG(Error, "Objects registry already contains object with ID={0} (type '{3}')! Trying to register object {1} (type '{2}').", obj->GetID(), obj->ToString(), String(obj->GetClass()->GetFullName()), String(other->GetClass()->GetFullName()));
-        _objectsDictionary.Remove(obj->GetID());
+        shard.Objects.Remove(obj->GetID());
     }
 #else
-	ASSERT(!_objectsDictionary.ContainsKey(obj->_id));
+	ASSERT(!shard.Objects.ContainsKey(obj->_id));
 #endif
 
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[RegisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary.Add(obj->GetID(), obj);
+    shard.Objects.Add(obj->GetID(), obj);
 }
 
 void Scripting::UnregisterObject(ScriptingObject* obj)
 {
-    ScopeLock lock(_objectsLocker);
-
-    //ASSERT(!obj->_id.IsValid() || _objectsDictionary.ContainsValue(obj));
+    ObjectsShard& shard = GetObjectsShard(obj->GetID());
+    ScopeLock lock(shard.Locker);
 
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[UnregisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary.Remove(obj->GetID());
+    shard.Objects.Remove(obj->GetID());
 }
 
 void Scripting::OnObjectIdChanged(ScriptingObject* obj, const Guid& oldId)
 {
-    ScopeLock lock(_objectsLocker);
-
     ASSERT(obj && oldId.IsValid());
     ASSERT(obj->GetID() != oldId);
-    ASSERT(_objectsDictionary.ContainsKey(oldId));
-    //ASSERT(_objectsDictionary.ContainsValue(obj));
-    ASSERT(!_objectsDictionary.ContainsKey(obj->GetID()));
 
-    _objectsDictionary.Remove(oldId);
-    _objectsDictionary.Add(obj->GetID(), obj);
+    // Register the new id before removing the old one so concurrent lookups always find the object under one of the ids
+    ObjectsShard& shard = GetObjectsShard(obj->GetID());
+    shard.Locker.Lock();
+    ASSERT(!shard.Objects.ContainsKey(obj->GetID()));
+    shard.Objects.Add(obj->GetID(), obj);
+    shard.Locker.Unlock();
+
+    ObjectsShard& oldShard = GetObjectsShard(oldId);
+    oldShard.Locker.Lock();
+    ASSERT(oldShard.Objects.ContainsKey(oldId));
+    oldShard.Objects.Remove(oldId);
+    oldShard.Locker.Unlock();
 }
 
 bool initFlaxEngine()
@@ -17,6 +17,9 @@ class FLAXENGINE_API Scripting
 DECLARE_SCRIPTING_TYPE_NO_SPAWN(Scripting);
     friend ScriptingObject;
     friend BinaryModule;
+#if USE_EDITOR
+    friend class ReloadScriptsAction;
+#endif
 public:
 
     /// <summary>
@@ -75,6 +78,15 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Scripting);
     /// </summary>
     /// <param name="canTriggerSceneReload">True if allow to scene scripts reload callback, otherwise it won't be possible.</param>
     static void Reload(bool canTriggerSceneReload = true);
+
+    /// <summary>
+    /// Gets the game binary modules that will be unloaded on scripts reload. Modules are reloaded if their binaries have been modified (or they were loaded after the modified module, thus might depend on it). Other modules are kept loaded (including their objects and cached reflection data).
+    /// </summary>
+    /// <param name="result">The output list of modules to reload.</param>
+    static void GetModulesToReload(Array<BinaryModule*>& result);
+
+private:
+    static void ReloadModules();
 #endif
 
 public:
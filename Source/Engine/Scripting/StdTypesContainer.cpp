@@ -40,6 +40,7 @@ void StdTypesContainer::Clear()
     Json_SerializeDiff = nullptr;
     Json_Deserialize = nullptr;
 
+    ParallelUpdateAttribute = nullptr;
 #if USE_EDITOR
     ExecuteInEditModeAttribute = nullptr;
 #endif
@@ -88,6 +89,7 @@ bool StdTypesContainer::Gather()
     GET_METHOD(Json_SerializeDiff, JSON, "SerializeDiff", 3);
     GET_METHOD(Json_Deserialize, JSON, "Deserialize", 3);
 
+    GET_CLASS(FlaxEngine, ParallelUpdateAttribute, "FlaxEngine.ParallelUpdateAttribute");
 #if USE_EDITOR
     GET_CLASS(FlaxEngine, ExecuteInEditModeAttribute, "FlaxEngine.ExecuteInEditModeAttribute");
 #endif
@@ -45,6 +45,7 @@ class FLAXENGINE_API StdTypesContainer : public Singleton<StdTypesContainer>
     MMethod* Json_SerializeDiff;
     MMethod* Json_Deserialize;
 
+    MClass* ParallelUpdateAttribute;
 #if USE_EDITOR
     MClass* ExecuteInEditModeAttribute;
 #endif
@@ -43,6 +43,15 @@ class FLAXENGINE_API FileReadStream : public ReadStream
         return _file;
     }
 
+    /// <summary>
+    /// Gets the file handle.
+    /// </summary>
+    /// <returns>File</returns>
+    FORCE_INLINE File* GetFile()
+    {
+        return _file;
+    }
+
     /// <summary>
     /// Unlink file object passed via constructor
     /// </summary>
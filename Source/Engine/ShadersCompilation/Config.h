@@ -58,6 +58,11 @@ struct FLAXENGINE_API ShaderCompilationOptions
     /// </summary>
     bool TreatWarningsAsErrors = false;
 
+    /// <summary>
+    /// Skips the skinned meshes rendering permutations (used by materials). Can be used when cooking materials that are never used by any skinned model.
+    /// </summary>
+    bool StripSkinning = false;
+
     /// <summary>
     /// Custom macros for the shader compilation
     /// </summary>
@@ -49,6 +49,11 @@ ShaderCompilerD3D::ShaderCompilerD3D(ShaderProfile profile)
 {
 }
 
+StringAnsi ShaderCompilerD3D::GetVersion() const
+{
+    return StringAnsi::Format("D3DCompiler {0}", D3D_COMPILER_VERSION);
+}
+
 #ifdef GPU_USE_SHADERS_DEBUG_LAYER
 
 namespace
@@ -24,6 +24,11 @@ class ShaderCompilerD3D : public ShaderCompiler
     /// <param name="profile">The profile.</param>
     ShaderCompilerD3D(ShaderProfile profile);
 
+public:
+
+    // [ShaderCompiler]
+    StringAnsi GetVersion() const override;
+
 protected:
 
     // [ShaderCompiler]
@@ -103,6 +103,21 @@ ShaderCompilerDX::ShaderCompilerDX(ShaderProfile profile)
     }
 }
 
+StringAnsi ShaderCompilerDX::GetVersion() const
+{
+    StringAnsi result("DXC");
+    auto compiler = (IDxcCompiler2*)_compiler;
+    IDxcVersionInfo* version = nullptr;
+    if (compiler && SUCCEEDED(compiler->QueryInterface(__uuidof(version), reinterpret_cast<void**>(&version))))
+    {
+        UINT32 major, minor;
+        version->GetVersion(&major, &minor);
+        result = StringAnsi::Format("DXC {0}.{1}", major, minor);
+        version->Release();
+    }
+    return result;
+}
+
 ShaderCompilerDX::~ShaderCompilerDX()
 {
     auto compiler = (IDxcCompiler2*)_compiler;
@@ -31,6 +31,11 @@ class ShaderCompilerDX : public ShaderCompiler
     /// </summary>
     ~ShaderCompilerDX();
 
+public:
+
+    // [ShaderCompiler]
+    StringAnsi GetVersion() const override;
+
 protected:
 
     // [ShaderCompiler]
@@ -3,6 +3,7 @@
 #if COMPILE_WITH_SHADER_COMPILER
 
 #include "ShaderCompiler.h"
+#include "ShadersCompilation.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Engine/Globals.h"
@@ -11,6 +12,7 @@
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Utilities/StringConverter.h"
@@ -57,7 +59,7 @@ namespace IncludedFiles
 #endif
 }
 
-bool ShaderCompiler::Compile(ShaderCompilationContext* context)
+bool ShaderCompiler::Prepare(ShaderCompilationContext* context)
 {
     // Clear cache
     _globalMacros.Clear();
@@ -68,9 +70,7 @@ bool ShaderCompiler::Compile(ShaderCompilationContext* context)
     _context = context;
 
     // Prepare
-    auto output = context->Output;
     auto meta = context->Meta;
-    const int32 shadersCount = meta->GetShadersCount();
     if (OnCompileBegin())
         return true;
     _globalMacros.Add({ nullptr, nullptr });
@@ -80,6 +80,18 @@ bool ShaderCompiler::Compile(ShaderCompilationContext* context)
     for (int32 i = 0; i < meta->CB.Count(); i++)
         _constantBuffers.Add({ meta->CB[i].Slot, false, 0 });
 
+    return false;
+}
+
+bool ShaderCompiler::Compile(ShaderCompilationContext* context)
+{
+    // Prepare
+    auto output = context->Output;
+    auto meta = context->Meta;
+    const int32 shadersCount = meta->GetShadersCount();
+    if (Prepare(context))
+        return true;
+
     // [Output] Version number
     output->WriteInt32(GPU_SHADER_CACHE_VERSION);
 
@@ -249,91 +261,107 @@ void ShaderCompiler::DisposeIncludedFilesCache()
 bool ShaderCompiler::CompileShaders()
 {
     auto meta = _context->Meta;
-#if BUILD_DEBUG
-#define PROFILE_COMPILE_SHADER(s) ZoneTransientN(___tracy_scoped_zone, s.Name.Get(), true);
-#else
-#define PROFILE_COMPILE_SHADER(s)
-#endif
 
-    // Generate vertex shaders cache
-    for (int32 i = 0; i < meta->VS.Count(); i++)
+    // Collect shader functions in the order of the output (vertex, hull, domain, geometry, pixel and compute shaders)
+    Array<ShaderFunctionCompilation, InlinedAllocation<32>> functions;
+    functions.EnsureCapacity(meta->GetShadersCount());
+    for (auto& shader : meta->VS)
+        functions.Add({ &shader, &WriteCustomDataVS });
+    for (auto& shader : meta->HS)
+        functions.Add({ &shader, &WriteCustomDataHS });
+    for (auto& shader : meta->DS)
+        functions.Add({ &shader, nullptr });
+    for (auto& shader : meta->GS)
+        functions.Add({ &shader, nullptr });
+    for (auto& shader : meta->PS)
+        functions.Add({ &shader, nullptr });
+    for (auto& shader : meta->CS)
+        functions.Add({ &shader, nullptr });
+    for (auto& function : functions)
     {
-        auto& shader = meta->VS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Vertex && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader, &WriteCustomDataVS))
-        {
-            LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
-            return true;
-        }
+        ASSERT((function.Meta->Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
     }
 
-    // Generate hull shaders cache
-    for (int32 i = 0; i < meta->HS.Count(); i++)
+    // Compile functions in parallel if there are more of them
+    if (functions.Count() > 1 && JobSystem::GetThreadsCount() > 1)
+        return CompileShadersParallel(Span<ShaderFunctionCompilation>(functions.Get(), functions.Count()));
+
+    // Generate shaders cache
+    for (auto& function : functions)
     {
-        auto& shader = meta->HS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Hull && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader, &WriteCustomDataHS))
+        auto& shader = *function.Meta;
+#if BUILD_DEBUG
+        ZoneTransientN(___tracy_scoped_zone, shader.Name.Get(), true);
+#endif
+        if (CompileShader(shader, function.CustomDataWrite))
         {
             LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
             return true;
         }
     }
 
-    // Generate domain shaders cache
-    for (int32 i = 0; i < meta->DS.Count(); i++)
+    return false;
+}
+
+bool ShaderCompiler::CompileShadersParallel(const Span<ShaderFunctionCompilation>& functions)
+{
+    PROFILE_CPU();
+    struct Result
     {
-        auto& shader = meta->DS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Domain && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader))
-        {
-            LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
-            return true;
-        }
-    }
+        MemoryWriteStream Output;
+        HashSet<String> Includes;
+        Array<ShaderResourceBuffer> ConstantBuffers;
+        bool Failed;
+    };
+    Array<Result> results;
+    results.Resize(functions.Length());
 
-    // Generate geometry shaders cache
-    for (int32 i = 0; i < meta->GS.Count(); i++)
+    // Compile every function with a separate compiler into own output (compilers are pooled by the shaders compilation service)
+    const Function<void(int32)> job = [this, &functions, &results](int32 i)
     {
-        auto& shader = meta->GS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Geometry && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader))
+        auto& shader = *functions[i].Meta;
+        auto& result = results[i];
+#if BUILD_DEBUG
+        ZoneTransientN(___tracy_scoped_zone, shader.Name.Get(), true);
+#endif
+        result.Failed = true;
+        ShaderCompiler* compiler = ShadersCompilation::RequestCompiler(_profile);
+        if (!compiler)
+            return;
+        ShaderCompilationContext context(_context->Options, _context->Meta);
+        context.Output = &result.Output;
+        if (!compiler->Prepare(&context) && !compiler->CompileShader(shader, functions[i].CustomDataWrite))
         {
-            LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
-            return true;
+            result.Includes = context.Includes;
+            result.ConstantBuffers = compiler->_constantBuffers;
+            result.Failed = false;
         }
-    }
+        compiler->_context = nullptr;
+        ShadersCompilation::FreeCompiler(compiler);
+    };
+    JobSystem::Execute(job, functions.Length());
 
-    // Generate pixel shaders cache
-    for (int32 i = 0; i < meta->PS.Count(); i++)
+    // Merge the results in the original order
+    for (int32 i = 0; i < results.Count(); i++)
     {
-        auto& shader = meta->PS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Pixel && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader))
+        auto& result = results[i];
+        if (result.Failed)
         {
-            LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
+            LOG(Error, "Failed to compile \'{0}\'", String(functions[i].Meta->Name));
             return true;
         }
-    }
-
-    // Generate compute shaders cache
-    for (int32 i = 0; i < meta->CS.Count(); i++)
-    {
-        auto& shader = meta->CS[i];
-        ASSERT(shader.GetStage() == ShaderStage::Compute && (shader.Flags & ShaderFlags::Hidden) == (ShaderFlags)0);
-        PROFILE_COMPILE_SHADER(shader);
-        if (CompileShader(shader))
+        _context->Output->WriteBytes(result.Output.GetHandle(), result.Output.GetPosition());
+        for (auto& include : result.Includes)
+            _context->Includes.Add(include.Item);
+        for (int32 j = 0; j < _constantBuffers.Count(); j++)
         {
-            LOG(Error, "Failed to compile \'{0}\'", String(shader.Name));
-            return true;
+            auto& cb = _constantBuffers[j];
+            const auto& resultCb = result.ConstantBuffers[j];
+            cb.IsUsed |= resultCb.IsUsed;
+            cb.Size = Math::Max(cb.Size, resultCb.Size);
         }
     }
 
-#undef PROFILE_COMPILE_SHADER
     return false;
 }
 
@@ -26,6 +26,8 @@ class ShaderCompiler
 
     Array<char> _funcNameDefineBuffer;
 
+    bool Prepare(ShaderCompilationContext* context);
+
 protected:
 
     ShaderProfile _profile;
@@ -61,6 +63,15 @@ class ShaderCompiler
         return _profile;
     }
 
+    /// <summary>
+    /// Gets the version of the shader compiler (used to invalidate the shared shaders cache after compiler update).
+    /// </summary>
+    /// <returns>The compiler version text.</returns>
+    virtual StringAnsi GetVersion() const
+    {
+        return StringAnsi::Empty;
+    }
+
     /// <summary>
     /// Performs the shader compilation.
     /// </summary>
@@ -88,9 +99,16 @@ class ShaderCompiler
 
     typedef bool (*WritePermutationData)(ShaderCompilationContext*, ShaderFunctionMeta&, int32, const Array<ShaderMacro>&);
 
+    struct ShaderFunctionCompilation
+    {
+        ShaderFunctionMeta* Meta;
+        WritePermutationData CustomDataWrite;
+    };
+
     virtual bool CompileShader(ShaderFunctionMeta& meta, WritePermutationData customDataWrite = nullptr) = 0;
 
     bool CompileShaders();
+    bool CompileShadersParallel(const Span<ShaderFunctionCompilation>& functions);
 
     virtual bool OnCompileBegin();
     virtual bool OnCompileEnd();
@@ -28,6 +28,10 @@
 #include "Engine/ContentImporters/AssetsImportingManager.h"
 #include "Engine/Platform/FileSystemWatcher.h"
 #include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
 #include "Editor/Editor.h"
 #include "Editor/ProjectInfo.h"
 #endif
@@ -57,6 +61,178 @@ namespace ShadersCompilationImpl
 
 using namespace ShadersCompilationImpl;
 
+#if USE_EDITOR
+
+// Version of the shared shaders cache entry format
+#define SHADERS_SHARED_CACHE_VERSION 1
+
+namespace SharedCache
+{
+    struct IncludeHash
+    {
+        DateTime LastEditTime;
+        uint64 Hash;
+    };
+
+    CriticalSection Locker;
+    Dictionary<String, IncludeHash> IncludeHashes;
+
+    // FNV-1a
+    constexpr uint64 HashInit = 14695981039346656037ull;
+
+    void Hash(uint64& hash, const void* data, int32 length)
+    {
+        for (int32 i = 0; i < length; i++)
+            hash = (hash ^ ((const byte*)data)[i]) * 1099511628211ull;
+    }
+
+    void Hash(uint64& hash, const char* text)
+    {
+        if (text)
+            Hash(hash, text, StringUtils::Length(text));
+        Hash(hash, "\n", 1);
+    }
+
+    bool GetIncludeHash(const String& path, uint64& hash)
+    {
+        const DateTime lastEditTime = FileSystem::GetFileLastEditTime(path);
+        {
+            ScopeLock lock(Locker);
+            const IncludeHash* e = IncludeHashes.TryGet(path);
+            if (e && e->LastEditTime == lastEditTime)
+            {
+                hash = e->Hash;
+                return false;
+            }
+        }
+        Array<byte> data;
+        if (File::ReadAllBytes(path, data))
+            return true;
+        hash = HashInit;
+        Hash(hash, data.Get(), data.Count());
+        ScopeLock lock(Locker);
+        IncludeHashes[path] = { lastEditTime, hash };
+        return false;
+    }
+
+    // Converts the included file path to be relative to the engine or project folder (the longest match) so the cache can be shared between machines
+    String ToPortablePath(const String& path)
+    {
+        const bool inProject = path.StartsWith(Globals::ProjectFolder);
+        const bool inEngine = path.StartsWith(Globals::StartupFolder);
+        if (inProject && (!inEngine || Globals::ProjectFolder.Length() >= Globals::StartupFolder.Length()))
+            return TEXT("$(ProjectFolder)") + path.Substring(Globals::ProjectFolder.Length());
+        if (inEngine)
+            return TEXT("$(EngineFolder)") + path.Substring(Globals::StartupFolder.Length());
+        return path;
+    }
+
+    String FromPortablePath(const String& path)
+    {
+        if (path.StartsWith(TEXT("$(ProjectFolder)")))
+            return Globals::ProjectFolder + path.Substring(ARRAY_COUNT("$(ProjectFolder)") - 1);
+        if (path.StartsWith(TEXT("$(EngineFolder)")))
+            return Globals::StartupFolder + path.Substring(ARRAY_COUNT("$(EngineFolder)") - 1);
+        return path;
+    }
+
+    // Gets the path of the cache entry for the shader (key is a hash of the source code, compilation options, macros and compiler version, includes are validated when loading the entry)
+    String GetEntryPath(const ShaderCompilationOptions& options, const StringAnsi& compilerVersion)
+    {
+        uint64 hash = HashInit;
+        const int32 versions[2] = { GPU_SHADER_CACHE_VERSION, SHADERS_SHARED_CACHE_VERSION };
+        Hash(hash, versions, sizeof(versions));
+        const byte flags[3] = { (byte)options.Profile, (byte)options.NoOptimize, (byte)options.TreatWarningsAsErrors };
+        Hash(hash, flags, sizeof(flags));
+        Hash(hash, compilerVersion.Get());
+        for (const ShaderMacro& macro : options.Macros)
+        {
+            Hash(hash, macro.Name);
+            Hash(hash, macro.Definition);
+        }
+        Hash(hash, options.Source, (int32)options.SourceLength);
+        return CommandLine::Options.ShaderCache.GetValue() / ::ToString(options.Profile) / String::Format(TEXT("{0:016x}.cache"), hash);
+    }
+
+    bool Load(const String& path, const ShaderCompilationOptions& options)
+    {
+        Array<byte> data;
+        if (!FileSystem::FileExists(path) || File::ReadAllBytes(path, data))
+            return true;
+        MemoryReadStream stream(data.Get(), data.Count());
+        int32 version;
+        stream.ReadInt32(&version);
+        if (version != SHADERS_SHARED_CACHE_VERSION)
+            return true;
+
+        // Validate includes
+        int32 includesCount;
+        stream.ReadInt32(&includesCount);
+        Array<String> includes;
+        includes.Resize(includesCount);
+        for (int32 i = 0; i < includesCount; i++)
+        {
+            String& include = includes[i];
+            stream.ReadString(&include, 11);
+            include = FromPortablePath(include);
+            uint64 hash, localHash;
+            stream.ReadUint64(&hash);
+            if (GetIncludeHash(include, localHash) || hash != localHash)
+                return true;
+        }
+
+        // [Output] Shader cache
+        int32 size;
+        stream.ReadInt32(&size);
+        if (size < (int32)(2 * sizeof(int32)) || stream.GetPosition() + size > stream.GetLength())
+            return true;
+        auto output = options.Output;
+        const uint32 start = output->GetPosition();
+        output->WriteBytes(stream.GetPositionHandle(), size);
+
+        // [Output] Includes (with local files paths and modification dates)
+        *(int32*)(output->GetHandle() + start + sizeof(int32)) = output->GetPosition();
+        output->WriteInt32(includes.Count());
+        for (const String& include : includes)
+        {
+            output->WriteString(include, 11);
+            const auto date = FileSystem::GetFileLastEditTime(include);
+            output->Write(date);
+        }
+        return false;
+    }
+
+    void Save(const String& path, const ShaderCompilationContext& context, uint32 start)
+    {
+        MemoryWriteStream stream(32 * 1024);
+        stream.WriteInt32(SHADERS_SHARED_CACHE_VERSION);
+        stream.WriteInt32(context.Includes.Count());
+        for (const auto& include : context.Includes)
+        {
+            uint64 hash;
+            if (GetIncludeHash(include.Item, hash))
+                return;
+            stream.WriteString(ToPortablePath(include.Item), 11);
+            stream.WriteUint64(hash);
+        }
+        const byte* data = context.Output->GetHandle() + start;
+        const int32 size = *(const int32*)(data + sizeof(int32)) - (int32)start;
+        stream.WriteInt32(size);
+        stream.WriteBytes(data, size);
+
+        // Write into a temporary file and move it to prevent other processes reading incomplete entry
+        const String tmpPath = path + TEXT(".") + Guid::New().ToString(Guid::FormatType::N) + TEXT(".tmp");
+        FileSystem::CreateDirectory(StringUtils::GetDirectoryName(path));
+        if (File::WriteAllBytes(tmpPath, stream.GetHandle(), stream.GetPosition()) || FileSystem::MoveFile(path, tmpPath, true))
+        {
+            LOG(Warning, "Failed to write shared shader cache entry '{0}'.", path);
+            FileSystem::DeleteFile(tmpPath);
+        }
+    }
+}
+
+#endif
+
 class ShadersCompilationService : public EngineService
 {
 public:
@@ -104,6 +280,25 @@ bool ShadersCompilation::Compile(ShaderCompilationOptions& options)
     const DateTime startTime = DateTime::NowUTC();
     const FeatureLevel featureLevel = RenderTools::GetFeatureLevel(options.Profile);
 
+#if USE_EDITOR
+    // Try to reuse the shader from the shared cache (debug data is not shared)
+    String sharedCachePath;
+    if (CommandLine::Options.ShaderCache.HasValue() && !options.GenerateDebugData)
+    {
+        auto compiler = RequestCompiler(options.Profile);
+        if (compiler)
+        {
+            sharedCachePath = SharedCache::GetEntryPath(options, compiler->GetVersion());
+            FreeCompiler(compiler);
+            if (!SharedCache::Load(sharedCachePath, options))
+            {
+                LOG(Info, "Shader '{0}' loaded from the shared cache (profile: {1})", options.TargetName, ::ToString(options.Profile));
+                return false;
+            }
+        }
+    }
+#endif
+
     // Process shader source to collect metadata
     ShaderMeta meta;
     if (ShaderProcessing::Parser::Process(options.TargetName, options.Source, options.SourceLength, options.Macros, featureLevel, &meta))
@@ -132,11 +327,18 @@ bool ShadersCompilation::Compile(ShaderCompilationOptions& options)
         ASSERT(compiler->GetProfile() == options.Profile);
 
         // Call compilation process
+        const uint32 outputStart = options.Output->GetPosition();
         result = compiler->Compile(&context);
 
         // Dismiss compiler
         FreeCompiler(compiler);
 
+#if USE_EDITOR
+        // Store the shader in the shared cache
+        if (!result && sharedCachePath.HasChars())
+            SharedCache::Save(sharedCachePath, context, outputStart);
+#endif
+
 #if GPU_USE_SHADERS_DEBUG_LAYER
         // Export debug data
         ShaderDebugDataExporter::Export(&context);
@@ -44,6 +44,7 @@ class FLAXENGINE_API ShadersCompilation
     static void ExtractShaderIncludes(byte* shaderCache, int32 shaderCacheLength, Array<String>& includes);
 
 private:
+    friend ShaderCompiler;
 
     static ShaderCompiler* CreateCompiler(ShaderProfile profile);
     static ShaderCompiler* RequestCompiler(ShaderProfile profile);
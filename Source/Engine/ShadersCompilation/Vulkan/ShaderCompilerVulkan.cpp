@@ -93,6 +93,12 @@ ShaderCompilerVulkan::~ShaderCompilerVulkan()
     }
 }
 
+StringAnsi ShaderCompilerVulkan::GetVersion() const
+{
+    const glslang::Version version = glslang::GetVersion();
+    return StringAnsi::Format("glslang {0}.{1}.{2}{3}", version.major, version.minor, version.patch, version.flavor ? version.flavor : "");
+}
+
 // @formatter:off
 const TBuiltInResource DefaultTBuiltInResource =
 {
@@ -438,8 +444,8 @@ class MyIoMapResolver : public glslang::TDefaultIoResolverBase
 
     int resolveBinding(EShLanguage stage, glslang::TVarEntryInfo& ent) override
     {
-        // Skip unused things
-        if (!ent.live)
+        // Skip unused things and push constants (not using descriptors)
+        if (!ent.live || ent.symbol->getQualifier().isPushConstant())
             return -1;
 
         // Add resource
@@ -453,8 +459,8 @@ class MyIoMapResolver : public glslang::TDefaultIoResolverBase
 
     int resolveSet(EShLanguage stage, glslang::TVarEntryInfo& ent) override
     {
-        // Skip unused things
-        if (!ent.live)
+        // Skip unused things and push constants (not using descriptors)
+        if (!ent.live || ent.symbol->getQualifier().isPushConstant())
             return -1;
 
         // Use different slot per-stage
@@ -28,6 +28,11 @@ class ShaderCompilerVulkan : public ShaderCompiler
     /// </summary>
     ~ShaderCompilerVulkan();
 
+public:
+
+    // [ShaderCompiler]
+    StringAnsi GetVersion() const override;
+
 protected:
 
     // [ShaderCompiler]
@@ -331,6 +331,8 @@ int32 ShadowsOfMordor::Builder::doWork()
     _lastStepStart = buildStart;
     _hemispheresPerJob = HEMISPHERES_PER_JOB_MIN;
     _hemispheresPerJobUpdateTime = DateTime::Now();
+    _traceViewRadius = 0.0f;
+    _traceViewFrames = -1;
     LOG(Info, "Start building lightmaps...");
     _isActive = true;
     OnBuildStarted();
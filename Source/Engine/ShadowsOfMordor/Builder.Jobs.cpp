@@ -5,6 +5,9 @@
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/GBufferPass.h"
+#include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
+#include "Engine/Renderer/GI/GlobalSurfaceAtlasPass.h"
 #include "Engine/Level/Scene/Lightmap.h"
 #include "Engine/Level/Actors/StaticModel.h"
 #include "Engine/Level/Actors/BoxBrush.h"
@@ -35,6 +38,120 @@ namespace ShadowsOfMordor
         Float3 WorldInvScale;
         float Dummy1;
         });
+
+    PACK_STRUCT(struct TraceData {
+        GlobalSignDistanceFieldPass::ConstantsData GlobalSDF;
+        GlobalSurfaceAtlasPass::ConstantsData GlobalSurfaceAtlas;
+        uint32 HemispheresCount;
+        float SkyboxIntensity;
+        float TraceMaxDistance;
+        float Dummy2;
+        });
+
+    struct TraceHemisphere
+    {
+        Float3 Position;
+        uint32 TexelAddress;
+        Float3 Normal;
+        float Padding;
+    };
+}
+
+bool ShadowsOfMordor::Builder::traceHemispheres(GPUContext* context, LightmapBuildCache& lightmapEntry, int32 atlasSize)
+{
+    auto shader = _shader->GetShader();
+    if (!_hemispheresTrace || shader->GetCB(1)->GetSize() != sizeof(TraceData))
+        return true;
+    if (_workerStagePosition1 >= lightmapEntry.Hemispheres.Count())
+        return false;
+
+    // Move the view to the next hemispheres to bake (Global SDF cascades and Global Surface Atlas are centered around the view)
+    const auto& firstHemisphere = lightmapEntry.Hemispheres[_workerStagePosition1];
+    if (_traceViewFrames < 0 || Float3::Distance(firstHemisphere.Position, _traceViewPosition) > _traceViewRadius)
+    {
+        _traceViewPosition = firstHemisphere.Position;
+        _traceViewFrames = 0;
+    }
+
+    // Render the scene with Global SDF and Global Surface Atlas (including the sky and the lighting of the surfaces)
+    auto& view = _task->View;
+    const auto prevMode = view.Mode;
+    const auto prevFlags = view.Flags;
+    view.Mode = ViewMode::GlobalSurfaceAtlas;
+    view.Flags |= ViewFlags::GlobalSDF;
+    Matrix viewMatrix, projection;
+    Matrix::PerspectiveFov(HEMISPHERES_FOV * DegreesToRadians, 1.0f, HEMISPHERES_NEAR_PLANE, HEMISPHERES_FAR_PLANE, projection);
+    Matrix::LookAt(_traceViewPosition, _traceViewPosition + Float3::Forward, Float3::Up, viewMatrix);
+    view.SetUp(viewMatrix, projection);
+    view.Position = _traceViewPosition;
+    view.Direction = Float3::Forward;
+    IsRunningRadiancePass = true;
+    EnableLightmapsUsage = _giBounceRunningIndex != 0;
+    Renderer::Render(_task);
+    context->ClearState();
+    IsRunningRadiancePass = false;
+    EnableLightmapsUsage = true;
+    view.Mode = prevMode;
+    view.Flags = prevFlags;
+    GlobalSignDistanceFieldPass::BindingData bindingDataSDF;
+    GlobalSurfaceAtlasPass::BindingData bindingDataSurfaceAtlas;
+    GPUTextureView* skybox = GBufferPass::Instance()->GetSkybox(_task->Buffers);
+    if (GlobalSignDistanceFieldPass::Instance()->Get(_task->Buffers, bindingDataSDF) ||
+        GlobalSurfaceAtlasPass::Instance()->Get(_task->Buffers, bindingDataSurfaceAtlas))
+    {
+        LOG(Warning, "Cannot trace lightmap hemispheres without Global SDF and Global Surface Atlas. Using rasterization instead.");
+        SAFE_DELETE_GPU_RESOURCE(_hemispheresTrace);
+        return true;
+    }
+    _traceViewRadius = bindingDataSDF.Constants.CascadePosDistance[0].W;
+
+    // Wait for the Global SDF and Global Surface Atlas to be updated around the new location
+    if (_traceViewFrames++ < HEMISPHERES_TRACE_WARMUP_FRAMES)
+        return false;
+
+    // Collect the hemispheres within the first cascade around the view
+    Array<TraceHemisphere> hemispheres;
+    hemispheres.EnsureCapacity(Math::Min(lightmapEntry.Hemispheres.Count() - _workerStagePosition1, HEMISPHERES_TRACE_PER_JOB));
+    for (; _workerStagePosition1 < lightmapEntry.Hemispheres.Count() && hemispheres.Count() < HEMISPHERES_TRACE_PER_JOB; _workerStagePosition1++)
+    {
+        const auto& hemisphere = lightmapEntry.Hemispheres[_workerStagePosition1];
+        if (Float3::Distance(hemisphere.Position, _traceViewPosition) > _traceViewRadius)
+            break;
+        auto& e = hemispheres.AddOne();
+        e.Position = hemisphere.Position;
+        e.TexelAddress = (hemisphere.TexelY * atlasSize + hemisphere.TexelX) * NUM_SH_TARGETS;
+        e.Normal = hemisphere.Normal;
+        e.Padding = 0.0f;
+    }
+    if (hemispheres.IsEmpty())
+        return false;
+
+    // Trace hemispheres rays and write the irradiance to the lightmap data buffer
+    TraceData data;
+    data.GlobalSDF = bindingDataSDF.Constants;
+    data.GlobalSurfaceAtlas = bindingDataSurfaceAtlas.Constants;
+    data.HemispheresCount = hemispheres.Count();
+    data.SkyboxIntensity = 1.0f;
+    data.TraceMaxDistance = bindingDataSDF.Constants.CascadePosDistance[bindingDataSDF.Constants.CascadesCount - 1].W * 2.0f;
+    data.Dummy2 = 0.0f;
+    context->UpdateBuffer(_hemispheresTrace, hemispheres.Get(), hemispheres.Count() * sizeof(TraceHemisphere));
+    auto cb = shader->GetCB(1);
+    context->UpdateCB(cb, &data);
+    context->BindCB(1, cb);
+    context->BindSR(0, _hemispheresTrace->View());
+    context->BindSR(1, bindingDataSDF.Texture ? bindingDataSDF.Texture->ViewVolume() : nullptr);
+    context->BindSR(2, bindingDataSDF.TextureMip ? bindingDataSDF.TextureMip->ViewVolume() : nullptr);
+    context->BindSR(3, bindingDataSurfaceAtlas.Chunks ? bindingDataSurfaceAtlas.Chunks->View() : nullptr);
+    context->BindSR(4, bindingDataSurfaceAtlas.CulledObjects ? bindingDataSurfaceAtlas.CulledObjects->View() : nullptr);
+    context->BindSR(5, bindingDataSurfaceAtlas.Objects ? bindingDataSurfaceAtlas.Objects->View() : nullptr);
+    context->BindSR(6, bindingDataSurfaceAtlas.AtlasDepth->View());
+    context->BindSR(7, bindingDataSurfaceAtlas.AtlasLighting->View());
+    context->BindSR(8, skybox);
+    context->BindUA(0, lightmapEntry.LightmapData->View());
+    context->Dispatch(shader->GetCS("CS_TraceHemispheres"), hemispheres.Count(), 1, 1);
+    context->ResetSR();
+    context->ResetUA();
+    return false;
 }
 
 void ShadowsOfMordor::Builder::onJobRender(GPUContext* context)
@@ -306,126 +423,130 @@ void ShadowsOfMordor::Builder::onJobRender(GPUContext* context)
 
         PROFILE_GPU_CPU_NAMED("RenderHemispheres");
 
-        // Dynamically adjust hemispheres to render per-job to minimize the bake speed but without GPU hangs
-        if (now - _hemispheresPerJobUpdateTime >= TimeSpan::FromSeconds(1.0))
+        // Trace hemispheres with compute shaders (rasterize them if not supported)
+        if (scene->GetSettings().BakeMode != LightmapSettings::BakeModes::RayTracing || traceHemispheres(context, lightmapEntry, atlasSize))
         {
-            _hemispheresPerJobUpdateTime = now;
-            const int32 fps = Engine::GetFramesPerSecond();
-            int32 hemispheresPerJob = _hemispheresPerJob;
-            if (fps > HEMISPHERES_RENDERING_TARGET_FPS * 5)
-                hemispheresPerJob *= 4;
-            else if (fps > HEMISPHERES_RENDERING_TARGET_FPS * 3)
-                hemispheresPerJob *= 2;
-            else if (fps > (int32)(HEMISPHERES_RENDERING_TARGET_FPS * 1.5f))
-                hemispheresPerJob = Math::RoundToInt((float)hemispheresPerJob * 1.1f);
-            else if (fps < (int32)(HEMISPHERES_RENDERING_TARGET_FPS * 0.8f))
-                hemispheresPerJob = Math::RoundToInt((float)hemispheresPerJob * 0.9f);
-            hemispheresPerJob = Math::Clamp(hemispheresPerJob, HEMISPHERES_PER_JOB_MIN, HEMISPHERES_PER_JOB_MAX);
-            if (hemispheresPerJob != _hemispheresPerJob)
+            // Dynamically adjust hemispheres to render per-job to minimize the bake speed but without GPU hangs
+            if (now - _hemispheresPerJobUpdateTime >= TimeSpan::FromSeconds(1.0))
             {
-                LOG(Info, "Changing GI baking hemispheres count per job from {0} to {1}", _hemispheresPerJob, hemispheresPerJob);
-                _hemispheresPerJob = hemispheresPerJob;
+                _hemispheresPerJobUpdateTime = now;
+                const int32 fps = Engine::GetFramesPerSecond();
+                int32 hemispheresPerJob = _hemispheresPerJob;
+                if (fps > HEMISPHERES_RENDERING_TARGET_FPS * 5)
+                    hemispheresPerJob *= 4;
+                else if (fps > HEMISPHERES_RENDERING_TARGET_FPS * 3)
+                    hemispheresPerJob *= 2;
+                else if (fps > (int32)(HEMISPHERES_RENDERING_TARGET_FPS * 1.5f))
+                    hemispheresPerJob = Math::RoundToInt((float)hemispheresPerJob * 1.1f);
+                else if (fps < (int32)(HEMISPHERES_RENDERING_TARGET_FPS * 0.8f))
+                    hemispheresPerJob = Math::RoundToInt((float)hemispheresPerJob * 0.9f);
+                hemispheresPerJob = Math::Clamp(hemispheresPerJob, HEMISPHERES_PER_JOB_MIN, HEMISPHERES_PER_JOB_MAX);
+                if (hemispheresPerJob != _hemispheresPerJob)
+                {
+                    LOG(Info, "Changing GI baking hemispheres count per job from {0} to {1}", _hemispheresPerJob, hemispheresPerJob);
+                    _hemispheresPerJob = hemispheresPerJob;
+                }
             }
-        }
 
-        // Prepare
-        int32 hemispheresToRenderLeft = _hemispheresPerJob;
-        int32 hemispheresToRenderBeforeSyncLeft = hemispheresToRenderLeft > 10 ? HEMISPHERES_PER_GPU_FLUSH : HEMISPHERES_PER_JOB_MAX;
-        Matrix view, projection;
-        Matrix::PerspectiveFov(HEMISPHERES_FOV * DegreesToRadians, 1.0f, HEMISPHERES_NEAR_PLANE, HEMISPHERES_FAR_PLANE, projection);
-        ShaderData shaderData;
+            // Prepare
+            int32 hemispheresToRenderLeft = _hemispheresPerJob;
+            int32 hemispheresToRenderBeforeSyncLeft = hemispheresToRenderLeft > 10 ? HEMISPHERES_PER_GPU_FLUSH : HEMISPHERES_PER_JOB_MAX;
+            Matrix view, projection;
+            Matrix::PerspectiveFov(HEMISPHERES_FOV * DegreesToRadians, 1.0f, HEMISPHERES_NEAR_PLANE, HEMISPHERES_FAR_PLANE, projection);
+            ShaderData shaderData;
 #if COMPILE_WITH_PROFILER
-        auto gpuProfilerEnabled = ProfilerGPU::Enabled;
-        ProfilerGPU::Enabled = false;
+            auto gpuProfilerEnabled = ProfilerGPU::Enabled;
+            ProfilerGPU::Enabled = false;
 #endif
 
-        // Render hemispheres
-        for (; _workerStagePosition1 < lightmapEntry.Hemispheres.Count(); _workerStagePosition1++)
-        {
-            if (hemispheresToRenderLeft == 0)
-                break;
-            hemispheresToRenderLeft--;
-            auto& hemisphere = lightmapEntry.Hemispheres[_workerStagePosition1];
-
-            // Create tangent frame
-            Float3 tangent;
-            Float3 c1 = Float3::Cross(hemisphere.Normal, Float3(0.0, 0.0, 1.0));
-            Float3 c2 = Float3::Cross(hemisphere.Normal, Float3(0.0, 1.0, 0.0));
-            tangent = c1.Length() > c2.Length() ? c1 : c2;
-            tangent = Float3::Normalize(tangent);
-            const Float3 binormal = Float3::Cross(tangent, hemisphere.Normal);
-
-            // Setup view
-            const Vector3 pos = hemisphere.Position + hemisphere.Normal * 0.001f;
-            Matrix::LookAt(pos, pos + hemisphere.Normal, tangent, view);
-            _task->View.SetUp(view, projection);
-            _task->View.Position = pos;
-            _task->View.Direction = hemisphere.Normal;
-
-            // Render hemisphere
-            // TODO: maybe render geometry backfaces in postLightPass to set the pure black? - to remove light leaking
-            IsRunningRadiancePass = true;
-            EnableLightmapsUsage = _giBounceRunningIndex != 0;
-            //
-            Renderer::Render(_task);
-            context->ClearState();
-            //
-            IsRunningRadiancePass = false;
-            EnableLightmapsUsage = true;
-            auto radianceMap = _output->View();
+            // Render hemispheres
+            for (; _workerStagePosition1 < lightmapEntry.Hemispheres.Count(); _workerStagePosition1++)
+            {
+                if (hemispheresToRenderLeft == 0)
+                    break;
+                hemispheresToRenderLeft--;
+                auto& hemisphere = lightmapEntry.Hemispheres[_workerStagePosition1];
+
+                // Create tangent frame
+                Float3 tangent;
+                Float3 c1 = Float3::Cross(hemisphere.Normal, Float3(0.0, 0.0, 1.0));
+                Float3 c2 = Float3::Cross(hemisphere.Normal, Float3(0.0, 1.0, 0.0));
+                tangent = c1.Length() > c2.Length() ? c1 : c2;
+                tangent = Float3::Normalize(tangent);
+                const Float3 binormal = Float3::Cross(tangent, hemisphere.Normal);
+
+                // Setup view
+                const Vector3 pos = hemisphere.Position + hemisphere.Normal * 0.001f;
+                Matrix::LookAt(pos, pos + hemisphere.Normal, tangent, view);
+                _task->View.SetUp(view, projection);
+                _task->View.Position = pos;
+                _task->View.Direction = hemisphere.Normal;
+
+                // Render hemisphere
+                // TODO: maybe render geometry backfaces in postLightPass to set the pure black? - to remove light leaking
+                IsRunningRadiancePass = true;
+                EnableLightmapsUsage = _giBounceRunningIndex != 0;
+                //
+                Renderer::Render(_task);
+                context->ClearState();
+                //
+                IsRunningRadiancePass = false;
+                EnableLightmapsUsage = true;
+                auto radianceMap = _output->View();
 
 #if DEBUG_EXPORT_HEMISPHERES_PREVIEW
-            addDebugHemisphere(context, radianceMap);
+                addDebugHemisphere(context, radianceMap);
 #endif
 
-            // Setup shader data
-            Matrix worldToTangent;
-            worldToTangent.SetRow1(Float4(tangent, 0.0f));
-            worldToTangent.SetRow2(Float4(binormal, 0.0f));
-            worldToTangent.SetRow3(Float4(hemisphere.Normal, 0.0f));
-            worldToTangent.SetRow4(Float4(0.0f, 0.0f, 0.0f, 1.0f));
-            worldToTangent.Invert();
-            //
-            Matrix viewToWorld; // viewToWorld is inverted view, since view is worldToView
-            Matrix::Invert(view, viewToWorld);
-            viewToWorld.SetRow4(Float4(0.0f, 0.0f, 0.0f, 1.0f)); // reset translation row
-            Matrix viewToTangent;
-            Matrix::Multiply(viewToWorld, worldToTangent, viewToTangent);
-            Matrix::Transpose(viewToTangent, shaderData.ToTangentSpace);
-            shaderData.FinalWeight = _hemisphereTexelsTotalWeight;
-            shaderData.AtlasSize = atlasSize;
-            shaderData.TexelAddress = (hemisphere.TexelY * atlasSize + hemisphere.TexelX) * NUM_SH_TARGETS;
-
-            // Calculate per pixel irradiance using compute shaders
-            auto cb = _shader->GetShader()->GetCB(0);
-            context->UpdateCB(cb, &shaderData);
-            context->BindCB(0, cb);
-            context->BindUA(0, _irradianceReduction->View());
-            context->BindSR(0, radianceMap);
-            context->Dispatch(_shader->GetShader()->GetCS("CS_Integrate"), 1, HEMISPHERES_RESOLUTION, 1);
-            context->ResetUA();
-            context->ResetSR();
-
-            // Downscale H-basis to 1x1 and copy results to lightmap data buffer
-            context->BindUA(0, lightmapEntry.LightmapData->View());
-            context->BindSR(0, _irradianceReduction->View());
-            // TODO: cache shader handle
-            context->Dispatch(_shader->GetShader()->GetCS("CS_Reduction"), 1, NUM_SH_TARGETS, 1);
-
-            // Unbind slots now to make rendering backend live easier
-            context->ResetSR();
-            context->ResetUA();
-
-            // Keep GPU busy
-            if (hemispheresToRenderBeforeSyncLeft-- < 0)
-            {
-                hemispheresToRenderBeforeSyncLeft = HEMISPHERES_PER_GPU_FLUSH;
-                context->Flush();
+                // Setup shader data
+                Matrix worldToTangent;
+                worldToTangent.SetRow1(Float4(tangent, 0.0f));
+                worldToTangent.SetRow2(Float4(binormal, 0.0f));
+                worldToTangent.SetRow3(Float4(hemisphere.Normal, 0.0f));
+                worldToTangent.SetRow4(Float4(0.0f, 0.0f, 0.0f, 1.0f));
+                worldToTangent.Invert();
+                //
+                Matrix viewToWorld; // viewToWorld is inverted view, since view is worldToView
+                Matrix::Invert(view, viewToWorld);
+                viewToWorld.SetRow4(Float4(0.0f, 0.0f, 0.0f, 1.0f)); // reset translation row
+                Matrix viewToTangent;
+                Matrix::Multiply(viewToWorld, worldToTangent, viewToTangent);
+                Matrix::Transpose(viewToTangent, shaderData.ToTangentSpace);
+                shaderData.FinalWeight = _hemisphereTexelsTotalWeight;
+                shaderData.AtlasSize = atlasSize;
+                shaderData.TexelAddress = (hemisphere.TexelY * atlasSize + hemisphere.TexelX) * NUM_SH_TARGETS;
+
+                // Calculate per pixel irradiance using compute shaders
+                auto cb = _shader->GetShader()->GetCB(0);
+                context->UpdateCB(cb, &shaderData);
+                context->BindCB(0, cb);
+                context->BindUA(0, _irradianceReduction->View());
+                context->BindSR(0, radianceMap);
+                context->Dispatch(_shader->GetShader()->GetCS("CS_Integrate"), 1, HEMISPHERES_RESOLUTION, 1);
+                context->ResetUA();
+                context->ResetSR();
+
+                // Downscale H-basis to 1x1 and copy results to lightmap data buffer
+                context->BindUA(0, lightmapEntry.LightmapData->View());
+                context->BindSR(0, _irradianceReduction->View());
+                // TODO: cache shader handle
+                context->Dispatch(_shader->GetShader()->GetCS("CS_Reduction"), 1, NUM_SH_TARGETS, 1);
+
+                // Unbind slots now to make rendering backend live easier
+                context->ResetSR();
+                context->ResetUA();
+
+                // Keep GPU busy
+                if (hemispheresToRenderBeforeSyncLeft-- < 0)
+                {
+                    hemispheresToRenderBeforeSyncLeft = HEMISPHERES_PER_GPU_FLUSH;
+                    context->Flush();
+                }
             }
-        }
 #if COMPILE_WITH_PROFILER
-        ProfilerGPU::Enabled = gpuProfilerEnabled;
+            ProfilerGPU::Enabled = gpuProfilerEnabled;
 #endif
+        }
 
         // Report progress
         float hemispheresProgress = static_cast<float>(_workerStagePosition1) / Math::Max(lightmapEntry.Hemispheres.Count(), 1);
@@ -16,6 +16,7 @@
 #include "Engine/Graphics/GPUPipelineState.h"
 #include "Engine/Graphics/RenderTargetPool.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Core/Config/GraphicsSettings.h"
 
 namespace ShadowsOfMordor
 {
@@ -490,6 +491,14 @@ bool ShadowsOfMordor::Builder::initResources()
     if (_irradianceReduction->Init(GPUBufferDescription::Typed(HEMISPHERES_RESOLUTION * NUM_SH_TARGETS, HemispheresFormatToPixelFormat[HEMISPHERES_IRRADIANCE_FORMAT], true)))
         return true;
 
+    // Ray Tracing bake mode uses Global SDF (if not supported then hemispheres are rasterized)
+    if (GraphicsSettings::Get()->EnableGlobalSDF && GPUDevice::Instance->GetFeatureLevel() >= FeatureLevel::SM5)
+    {
+        _hemispheresTrace = GPUDevice::Instance->CreateBuffer(TEXT("HemispheresTrace"));
+        if (_hemispheresTrace->Init(GPUBufferDescription::Structured(HEMISPHERES_TRACE_PER_JOB, 32)))
+            return true;
+    }
+
 #if DEBUG_EXPORT_HEMISPHERES_PREVIEW
     releaseDebugHemisphereAtlases();
 #endif
@@ -509,6 +518,7 @@ void ShadowsOfMordor::Builder::releaseResources()
     _shader = nullptr;
 
     SAFE_DELETE_GPU_RESOURCE(_irradianceReduction);
+    SAFE_DELETE_GPU_RESOURCE(_hemispheresTrace);
 
     RenderTargetPool::Release(_cachePositions);
     _cachePositions = nullptr;
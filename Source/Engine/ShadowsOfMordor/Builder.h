@@ -253,6 +253,10 @@ namespace ShadowsOfMordor
         GPUBuffer* _irradianceReduction = nullptr;
         GPUTexture* _cachePositions = nullptr;
         GPUTexture* _cacheNormals = nullptr;
+        GPUBuffer* _hemispheresTrace = nullptr;
+        Float3 _traceViewPosition;
+        float _traceViewRadius;
+        int32 _traceViewFrames;
 
     public:
 
@@ -311,6 +315,7 @@ namespace ShadowsOfMordor
         void reportProgress(BuildProgressStep step, float stepProgress, int32 subSteps);
         void reportProgress(BuildProgressStep step, float stepProgress, float totalProgress);
         void onJobRender(GPUContext* context);
+        bool traceHemispheres(GPUContext* context, LightmapBuildCache& lightmapEntry, int32 atlasSize);
         bool checkBuildCancelled();
         bool runStage(BuildingStage stage, bool resetPosition = true);
         bool initResources();
@@ -56,6 +56,14 @@ class FLAXENGINE_API StreamableResource
         return Streaming.TargetResidency;
     }
 
+    /// <summary>
+    /// Gets a value indicating whether resource residency is limited by the streaming memory budget.
+    /// </summary>
+    FORCE_INLINE bool IsBudgetLimited() const
+    {
+        return Streaming.MaxResidency != MAX_int32;
+    }
+
     /// <summary>
     /// Gets a value indicating whether this resource has been allocated. 
     /// </summary>
@@ -79,6 +87,23 @@ class FLAXENGINE_API StreamableResource
     /// </summary>
     virtual int32 GetAllocatedResidency() const = 0;
 
+    /// <summary>
+    /// Gets the amount of memory (in bytes) used by the resource data at the current residency level. Used by the streaming memory budgets. Returns 0 if resource doesn't report memory usage (not counted in budgets).
+    /// </summary>
+    virtual uint64 GetMemoryUsage() const
+    {
+        return 0;
+    }
+
+    /// <summary>
+    /// Gets the estimated amount of data (in bytes) to read and upload when streaming the resource from the current residency level to the given one. Used by the streaming scheduler to limit the data streamed per frame. Returns 0 if resource doesn't report it (streamed without limits).
+    /// </summary>
+    /// <param name="residency">The target residency.</param>
+    virtual uint64 GetStreamingSize(int32 residency) const
+    {
+        return 0;
+    }
+
 public:
 
     /// <summary>
@@ -114,6 +139,9 @@ class FLAXENGINE_API StreamableResource
         int32 TargetResidency = 0;
         int64 TargetResidencyChange = 0;
         SamplesBuffer<float, 5> QualitySamples;
+        float TargetQuality = 0.0f;
+        int32 MaxResidency = MAX_int32;
+        uint64 MemoryUsage = 0;
     };
 
     StreamingCache Streaming;
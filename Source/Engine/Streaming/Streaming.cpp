@@ -4,6 +4,7 @@
 #include "StreamableResource.h"
 #include "StreamingGroup.h"
 #include "StreamingSettings.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -11,12 +12,32 @@
 #include "Engine/Threading/TaskGraph.h"
 #include "Engine/Threading/Task.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Textures/GPUSampler.h"
+#include "Engine/Graphics/Textures/StreamingTexture.h"
+#include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Serialization/Serialization.h"
 
 namespace StreamingManagerImpl
 {
+    struct StreamingRequest
+    {
+        StreamableResource* Resource;
+        int32 Residency;
+        uint64 Size;
+        float Priority;
+    };
+
     int32 LastUpdateResourcesIndex = 0;
+    Array<StreamingRequest> Requests;
+    Array<StreamableResource*> DeferredResources;
+    int64 LastBudgetsUpdate = 0;
+    bool IsOverBudget = false;
+    uint64 MemoryUsage = 0;
+    Vector3 ViewLastPosition = Vector3::Zero;
+    double ViewLastTime = 0;
+    Float3 ViewVelocity = Float3::Zero;
+    Float3 ViewPredictionOffset = Float3::Zero;
     CriticalSection ResourcesLock;
     Array<StreamableResource*> Resources;
     Array<GPUSampler*, InlinedAllocation<32>> TextureGroupSamplers;
@@ -31,6 +52,7 @@ class StreamingService : public EngineService
     StreamingService()
         : EngineService(TEXT("Streaming"), 100)
     {
+        RenderOnly = true;
     }
 
     bool Init() override;
@@ -41,6 +63,9 @@ class StreamingSystem : public TaskGraphSystem
 {
 public:
     void Job(int32 index);
+    void UpdateBudgets();
+    void UpdateViewPrediction();
+    void StartRequests();
     void Execute(TaskGraph* graph) override;
 };
 
@@ -52,16 +77,40 @@ namespace
 StreamingService StreamingServiceInstance;
 
 Array<TextureGroup, InlinedAllocation<32>> Streaming::TextureGroups;
+uint64 Streaming::MemoryBudget = 0;
+float Streaming::PredictionTime = 1.0f;
+uint64 Streaming::PrefetchBandwidth = 32 * 1024 * 1024;
+uint64 Streaming::MaxStreamingBytesPerFrame = 16 * 1024 * 1024;
 
 void StreamingSettings::Apply()
 {
     Streaming::TextureGroups = TextureGroups;
+    Streaming::MemoryBudget = (uint64)Math::Max(MemoryBudget, 0) * 1024 * 1024;
+    Streaming::PredictionTime = Math::Max(PredictionTime, 0.0f);
+    Streaming::PrefetchBandwidth = (uint64)Math::Max(PrefetchBandwidth, 0) * 1024 * 1024;
+    Streaming::MaxStreamingBytesPerFrame = (uint64)Math::Max(MaxStreamingDataPerFrame, 0) * 1024 * 1024;
+    for (StreamingGroup* group : StreamingGroups::Instance()->Groups())
+    {
+        int32 budget = 0;
+        if (group->GetType() == StreamingGroup::Type::Textures)
+            budget = TexturesMemoryBudget;
+        else if (group->GetType() == StreamingGroup::Type::Models)
+            budget = ModelsMemoryBudget;
+        group->SetMemoryBudget((uint64)Math::Max(budget, 0) * 1024 * 1024);
+    }
+    Streaming::RequestStreamingUpdate();
     SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
     TextureGroupSamplers.Resize(TextureGroups.Count(), false);
 }
 
 void StreamingSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
 {
+    DESERIALIZE(MemoryBudget);
+    DESERIALIZE(TexturesMemoryBudget);
+    DESERIALIZE(ModelsMemoryBudget);
+    DESERIALIZE(PredictionTime);
+    DESERIALIZE(PrefetchBandwidth);
+    DESERIALIZE(MaxStreamingDataPerFrame);
     DESERIALIZE(TextureGroups);
 }
 
@@ -108,6 +157,7 @@ void StreamableResource::StopStreaming()
     {
         ResourcesLock.Lock();
         Resources.Remove(this);
+        DeferredResources.Remove(this);
         ResourcesLock.Unlock();
         Streaming = StreamingCache();
         _isStreaming = false;
@@ -134,6 +184,7 @@ void UpdateResource(StreamableResource* resource, DateTime now, double currentTi
     resource->Streaming.QualitySamples.Add(targetQuality);
     targetQuality = resource->Streaming.QualitySamples.Maximum();
     targetQuality = Math::Saturate(targetQuality);
+    resource->Streaming.TargetQuality = targetQuality;
 
     // Calculate target residency level (discrete value)
     auto maxResidency = resource->GetMaxResidency();
@@ -143,6 +194,11 @@ void UpdateResource(StreamableResource* resource, DateTime now, double currentTi
     ASSERT(allocatedResidency >= currentResidency && allocatedResidency >= 0);
     resource->Streaming.LastUpdate = now.Ticks;
 
+    // Apply memory budget limits (residency trimmed by the budgets update and no residency increase when out of budget)
+    targetResidency = Math::Min(targetResidency, resource->Streaming.MaxResidency);
+    if (targetResidency > currentResidency && currentResidency != 0 && resource->IsDynamic() && (IsOverBudget || group->IsOverBudget()))
+        targetResidency = currentResidency;
+
     // Check if a target residency level has been changed
     if (targetResidency != resource->Streaming.TargetResidency)
     {
@@ -177,12 +233,12 @@ void UpdateResource(StreamableResource* resource, DateTime now, double currentTi
         // Calculate residency level to stream in (resources may want to increase/decrease it's quality in steps rather than at once)
         int32 requestedResidency = handler->CalculateRequestedResidency(resource, targetResidency);
 
-        // Create streaming task (resource type specific)
-        Task* streamingTask = resource->CreateStreamingTask(requestedResidency);
-        if (streamingTask != nullptr)
-        {
-            streamingTask->Start();
-        }
+        // Enqueue streaming request (started by the scheduler within the per-frame data budget)
+        auto& request = Requests.AddOne();
+        request.Resource = resource;
+        request.Residency = requestedResidency;
+        request.Size = resource->GetStreamingSize(requestedResidency);
+        request.Priority = resource->Streaming.TargetQuality;
     }
     else
     {
@@ -191,16 +247,6 @@ void UpdateResource(StreamableResource* resource, DateTime now, double currentTi
         // TODO: deallocate or decrease memory usage after timeout? (timeout should be smaller on low mem)
     }
 
-    // low memory case:
-    // if we are on budget and cannot load everything we have to:
-    // decrease global resources quality scale (per resources group)
-    // decrease asset deallocate timeout
-
-    // low mem detecting:
-    // for low mem we have to get whole memory budget for a group and then
-    // subtract immutable resources mem usage (like render targets or non dynamic resources)
-    // so we get amount of memory we can distribute and we can detect if we are out of the limit
-    // low mem should be updated once per a few frames
 }
 
 bool StreamingService::Init()
@@ -224,6 +270,7 @@ void StreamingSystem::Job(int32 index)
 
     // TODO: use streaming settings
     TimeSpan ResourceUpdatesInterval = TimeSpan::FromMilliseconds(100);
+    TimeSpan BudgetsUpdateInterval = TimeSpan::FromMilliseconds(500);
     int32 MaxResourcesPerUpdate = 50;
 
     // Start update
@@ -233,6 +280,17 @@ void StreamingSystem::Job(int32 index)
     int32 resourcesUpdates = Math::Min(MaxResourcesPerUpdate, resourcesCount);
     double currentTime = Platform::GetTimeSeconds();
 
+    // Update resources deferred by the scheduler in the previous frame first
+    for (StreamableResource* resource : DeferredResources)
+    {
+        if (resource->CanBeUpdated())
+        {
+            UpdateResource(resource, now, currentTime);
+            resourcesUpdates--;
+        }
+    }
+    DeferredResources.Clear();
+
     // Update high priority queue and then rest of the resources
     // Note: resources in the update queue are updated always, while others only between specified intervals
     int32 resourcesChecks = resourcesCount;
@@ -254,11 +312,190 @@ void StreamingSystem::Job(int32 index)
         }
     }
 
+    // Start streaming requests
+    StartRequests();
+
+    // Arbitrate residency of all resources to fit into memory budgets
+    if (now.Ticks - LastBudgetsUpdate >= BudgetsUpdateInterval.Ticks)
+    {
+        LastBudgetsUpdate = now.Ticks;
+        UpdateBudgets();
+    }
+
     // TODO: add StreamingManager stats, update time per frame, updates per frame, etc.
 }
 
+namespace
+{
+    // The maximum speed (in units per second) of the view movement used for streaming prediction (faster movement is considered a teleport)
+    constexpr float MaxViewPredictionSpeed = 100000.0f;
+
+    // The quality used to query the lowest residency level that the budgets can trim resources to
+    constexpr float MinBudgetQuality = 0.01f;
+
+    bool SortStreamingRequests(const StreamingRequest& a, const StreamingRequest& b)
+    {
+        // Residency decrease goes first (releases memory), then higher priority and smaller requests
+        if ((a.Size == 0) != (b.Size == 0))
+            return a.Size == 0;
+        if (a.Priority != b.Priority)
+            return a.Priority > b.Priority;
+        return a.Size < b.Size;
+    }
+
+    bool SortByStreamingPriority(StreamableResource* const& a, StreamableResource* const& b)
+    {
+        // Lower target quality goes first, then bigger resources (trim the least important memory first)
+        if (a->Streaming.TargetQuality != b->Streaming.TargetQuality)
+            return a->Streaming.TargetQuality < b->Streaming.TargetQuality;
+        return a->Streaming.MemoryUsage > b->Streaming.MemoryUsage;
+    }
+}
+
+void StreamingSystem::UpdateBudgets()
+{
+    PROFILE_CPU();
+
+    // Measure memory usage
+    const auto& groups = StreamingGroups::Instance()->Groups();
+    for (StreamingGroup* group : groups)
+        group->_memoryUsage = 0;
+    MemoryUsage = 0;
+    for (StreamableResource* resource : Resources)
+    {
+        const uint64 usage = resource->GetMemoryUsage();
+        resource->Streaming.MemoryUsage = usage;
+        resource->GetGroup()->_memoryUsage += usage;
+        MemoryUsage += usage;
+    }
+
+    // Detect over budget (with hysteresis to prevent trimming and streaming the same resources back and forth)
+    const uint64 budget = Streaming::MemoryBudget;
+    int64 overBudget = budget != 0 ? (int64)MemoryUsage - (int64)budget : 0;
+    IsOverBudget = budget != 0 && MemoryUsage > budget * 9 / 10 && (IsOverBudget || overBudget > 0);
+    bool anyOverBudget = overBudget > 0;
+    bool anyLimited = false;
+    for (StreamingGroup* group : groups)
+    {
+        const uint64 groupBudget = group->_memoryBudget;
+        group->_isOverBudget = groupBudget != 0 && group->_memoryUsage > groupBudget * 9 / 10 && (group->_isOverBudget || group->_memoryUsage > groupBudget);
+        anyOverBudget |= groupBudget != 0 && group->_memoryUsage > groupBudget;
+    }
+    for (StreamableResource* resource : Resources)
+        anyLimited |= resource->IsBudgetLimited();
+    if (!anyOverBudget && !anyLimited)
+        return;
+
+    // Rank dynamic resources by priority
+    Array<StreamableResource*> candidates;
+    for (StreamableResource* resource : Resources)
+    {
+        if (resource->IsDynamic() && resource->Streaming.MemoryUsage != 0 && resource->CanBeUpdated())
+            candidates.Add(resource);
+    }
+    Sorting::QuickSort(candidates.Get(), candidates.Count(), &SortByStreamingPriority);
+
+    if (anyOverBudget)
+    {
+        // Trim residency of the lowest priority resources by a single level until the estimated memory fits into the budgets (the next update will measure the actual usage)
+        Array<int64, InlinedAllocation<8>> groupsOverBudget;
+        groupsOverBudget.Resize(groups.Count());
+        for (int32 i = 0; i < groups.Count(); i++)
+            groupsOverBudget[i] = groups[i]->_memoryBudget != 0 ? (int64)groups[i]->_memoryUsage - (int64)groups[i]->_memoryBudget : 0;
+        for (StreamableResource* resource : candidates)
+        {
+            const int32 groupIndex = groups.Find(resource->GetGroup());
+            int64& groupOverBudget = groupsOverBudget[groupIndex];
+            if (overBudget <= 0 && groupOverBudget <= 0)
+                continue;
+            const int32 currentResidency = resource->GetCurrentResidency();
+            const int32 minResidency = Math::Max(resource->GetGroup()->GetHandler()->CalculateResidency(resource, MinBudgetQuality), 1);
+            if (currentResidency <= minResidency)
+                continue;
+            resource->Streaming.MaxResidency = currentResidency - 1;
+            resource->RequestStreamingUpdate();
+
+            // Dropping the top residency level frees at least half of the memory for textures and most of the models (conservative estimate)
+            const int64 freed = (int64)(resource->Streaming.MemoryUsage / 2);
+            overBudget -= freed;
+            groupOverBudget -= freed;
+        }
+    }
+    else if (!IsOverBudget)
+    {
+        // Relax limits (from the highest priority) when memory usage gets back below budgets
+        for (int32 i = candidates.Count() - 1; i >= 0; i--)
+        {
+            StreamableResource* resource = candidates[i];
+            if (!resource->IsBudgetLimited() || resource->GetGroup()->_isOverBudget)
+                continue;
+            if (resource->Streaming.MaxResidency >= resource->GetMaxResidency())
+                resource->Streaming.MaxResidency = MAX_int32;
+            else
+                resource->Streaming.MaxResidency++;
+            resource->RequestStreamingUpdate();
+        }
+    }
+}
+
+void StreamingSystem::StartRequests()
+{
+    if (Requests.IsEmpty())
+        return;
+    PROFILE_CPU();
+    Sorting::QuickSort(Requests.Get(), Requests.Count(), &SortStreamingRequests);
+
+    // Start requests within the per-frame data budget (at least one to progress with big ones)
+    // Note: deferred requests are not created but resources get updated again in the next frame (obsolete requests are dropped)
+    const uint64 budget = Streaming::MaxStreamingBytesPerFrame;
+    uint64 size = 0;
+    for (const StreamingRequest& request : Requests)
+    {
+        if (budget != 0 && request.Size != 0 && size != 0 && size + request.Size > budget)
+        {
+            DeferredResources.Add(request.Resource);
+            continue;
+        }
+        size += request.Size;
+        Task* streamingTask = request.Resource->CreateStreamingTask(request.Residency);
+        if (streamingTask != nullptr)
+        {
+            streamingTask->Start();
+        }
+    }
+    Requests.Clear();
+}
+
+void StreamingSystem::UpdateViewPrediction()
+{
+    const MainRenderTask* task = MainRenderTask::Instance;
+    if (!task || Streaming::PredictionTime <= 0.0f)
+    {
+        ViewLastTime = 0;
+        ViewVelocity = ViewPredictionOffset = Float3::Zero;
+        return;
+    }
+
+    // Track the main view velocity (smoothed, ignores teleports)
+    const double time = Platform::GetTimeSeconds();
+    const Vector3 position = task->View.Origin + task->View.Position;
+    const float deltaTime = (float)(time - ViewLastTime);
+    if (ViewLastTime > 0 && deltaTime > ZeroTolerance)
+    {
+        const Float3 velocity = Float3(position - ViewLastPosition) / deltaTime;
+        if (velocity.LengthSquared() < Math::Square(MaxViewPredictionSpeed))
+            ViewVelocity = Float3::Lerp(ViewVelocity, velocity, Math::Saturate(deltaTime * 5.0f));
+        else
+            ViewVelocity = Float3::Zero;
+    }
+    ViewLastPosition = position;
+    ViewLastTime = time;
+    ViewPredictionOffset = ViewVelocity * Streaming::PredictionTime;
+}
+
 void StreamingSystem::Execute(TaskGraph* graph)
 {
+    UpdateViewPrediction();
     if (Resources.Count() == 0 || GPUDevice::Instance->GetState() != GPUDevice::DeviceState::Ready)
         return;
 
@@ -277,11 +514,57 @@ StreamingStats Streaming::GetStats()
     {
         if (e->Streaming.TargetResidency > e->GetCurrentResidency())
             stats.StreamingResourcesCount++;
+        if (e->IsBudgetLimited())
+            stats.BudgetLimitedResourcesCount++;
+    }
+    stats.DeferredRequestsCount = DeferredResources.Count();
+    stats.MemoryUsage = MemoryUsage;
+    stats.MemoryBudget = Streaming::MemoryBudget;
+    for (const StreamingGroup* group : StreamingGroups::Instance()->Groups())
+    {
+        if (group->GetType() == StreamingGroup::Type::Textures)
+        {
+            stats.TexturesMemoryUsage += group->GetMemoryUsage();
+            stats.TexturesMemoryBudget += group->GetMemoryBudget();
+        }
+        else if (group->GetType() == StreamingGroup::Type::Models)
+        {
+            stats.ModelsMemoryUsage += group->GetMemoryUsage();
+            stats.ModelsMemoryBudget += group->GetMemoryBudget();
+        }
     }
     ResourcesLock.Unlock();
     return stats;
 }
 
+void Streaming::GetTextureGroupsMemoryUsage(Array<uint64>& memoryUsage, Array<int32>& counts)
+{
+    const int32 groupsCount = TextureGroups.Count();
+    memoryUsage.Resize(groupsCount + 1);
+    counts.Resize(groupsCount + 1);
+    Platform::MemoryClear(memoryUsage.Get(), memoryUsage.Count() * sizeof(uint64));
+    Platform::MemoryClear(counts.Get(), counts.Count() * sizeof(int32));
+    const StreamingGroup* texturesGroup = StreamingGroups::Instance()->Textures();
+    ResourcesLock.Lock();
+    for (const StreamableResource* e : Resources)
+    {
+        if (e->GetGroup() != texturesGroup)
+            continue;
+        const auto texture = static_cast<const StreamingTexture*>(e);
+        int32 groupIndex = texture->GetHeader()->TextureGroup;
+        if (groupIndex < 0 || groupIndex >= groupsCount)
+            groupIndex = groupsCount;
+        memoryUsage[groupIndex] += texture->GetTexture()->GetMemoryUsage();
+        counts[groupIndex]++;
+    }
+    ResourcesLock.Unlock();
+}
+
+Float3 Streaming::GetViewPredictionOffset()
+{
+    return ViewPredictionOffset;
+}
+
 void Streaming::RequestStreamingUpdate()
 {
     PROFILE_CPU();
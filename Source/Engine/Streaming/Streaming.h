@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Vector3.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "TextureGroup.h"
 
@@ -16,6 +17,22 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingStats);
     API_FIELD() int32 ResourcesCount = 0;
     // Amount of resources that are during streaming in (target residency is higher that the current). Zero if all resources are streamed in.
     API_FIELD() int32 StreamingResourcesCount = 0;
+    // Amount of streaming requests deferred to the next frame due to the per-frame data budget.
+    API_FIELD() int32 DeferredRequestsCount = 0;
+    // Amount of resources that have residency limited by the memory budget.
+    API_FIELD() int32 BudgetLimitedResourcesCount = 0;
+    // Memory usage (in bytes) of all streamable resources (as measured by the last budget update).
+    API_FIELD() uint64 MemoryUsage = 0;
+    // Global memory budget (in bytes) for streamable resources. Zero if unlimited.
+    API_FIELD() uint64 MemoryBudget = 0;
+    // Memory usage (in bytes) of the streamed textures.
+    API_FIELD() uint64 TexturesMemoryUsage = 0;
+    // Memory budget (in bytes) of the streamed textures. Zero if unlimited.
+    API_FIELD() uint64 TexturesMemoryBudget = 0;
+    // Memory usage (in bytes) of the streamed models (including skinned models).
+    API_FIELD() uint64 ModelsMemoryUsage = 0;
+    // Memory budget (in bytes) of the streamed models (sum of the models and skinned models groups budgets). Zero if unlimited.
+    API_FIELD() uint64 ModelsMemoryBudget = 0;
 };
 
 /// <summary>
@@ -30,11 +47,43 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Streaming);
     /// </summary>
     API_FIELD() static Array<TextureGroup, InlinedAllocation<32>> TextureGroups;
 
+    /// <summary>
+    /// The global memory budget (in bytes) for all streamable resources. When exceeded, the lowest priority resources get their residency trimmed down and the further residency increases are denied. Value 0 means no limit.
+    /// </summary>
+    API_FIELD() static uint64 MemoryBudget;
+
+    /// <summary>
+    /// The time (in seconds) ahead used to predict the main view movement for models streaming. Models get LODs prefetched for the view position extrapolated from its velocity. Value 0 disables prediction.
+    /// </summary>
+    API_FIELD() static float PredictionTime;
+
+    /// <summary>
+    /// The maximum bandwidth (in bytes per second) of the prefetched model LODs data (for the predicted view position). Limits prefetching so it doesn't starve the on-demand streaming. Value 0 means no limit.
+    /// </summary>
+    API_FIELD() static uint64 PrefetchBandwidth;
+
+    /// <summary>
+    /// The maximum amount of data (in bytes) that can be requested for streaming in a single frame (read from disk and uploaded to GPU). Streaming requests are started by the on-screen priority and the remaining ones get deferred to the next frames to prevent hitches (eg. after a camera cut). Value 0 means no limit.
+    /// </summary>
+    API_FIELD() static uint64 MaxStreamingBytesPerFrame;
+
+    /// <summary>
+    /// Gets the offset of the main view position predicted ahead of its movement (see PredictionTime). Zero if view is not moving or prediction is disabled.
+    /// </summary>
+    API_PROPERTY() static Float3 GetViewPredictionOffset();
+
     /// <summary>
     /// Gets streaming statistics.
     /// </summary>
     API_PROPERTY() static StreamingStats GetStats();
 
+    /// <summary>
+    /// Gets the GPU memory usage of the streamed textures per texture group.
+    /// </summary>
+    /// <param name="memoryUsage">The output memory usage (in bytes) per texture group. Indexed like TextureGroups with an additional last item for the textures without a valid group.</param>
+    /// <param name="counts">The output amount of the textures per texture group (indexed like memoryUsage).</param>
+    static void GetTextureGroupsMemoryUsage(Array<uint64>& memoryUsage, Array<int32>& counts);
+
     /// <summary>
     /// Requests the streaming update for all the loaded resources. Use it to refresh content streaming after changing configuration.
     /// </summary>
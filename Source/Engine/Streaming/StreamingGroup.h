@@ -20,6 +20,11 @@ class FLAXENGINE_API StreamingGroup
 
     Type _type;
     IStreamingHandler* _handler;
+    uint64 _memoryBudget = 0;
+    uint64 _memoryUsage = 0;
+    bool _isOverBudget = false;
+
+    friend class StreamingSystem;
 
 public:
 
@@ -55,6 +60,38 @@ class FLAXENGINE_API StreamingGroup
     {
         return _handler;
     }
+
+    /// <summary>
+    /// Gets the memory budget (in bytes) for the resources in this group. Value 0 means no limit.
+    /// </summary>
+    FORCE_INLINE uint64 GetMemoryBudget() const
+    {
+        return _memoryBudget;
+    }
+
+    /// <summary>
+    /// Sets the memory budget (in bytes) for the resources in this group. Value 0 means no limit.
+    /// </summary>
+    FORCE_INLINE void SetMemoryBudget(uint64 value)
+    {
+        _memoryBudget = value;
+    }
+
+    /// <summary>
+    /// Gets the memory usage (in bytes) of the resources in this group. Updated by the streaming service periodically.
+    /// </summary>
+    FORCE_INLINE uint64 GetMemoryUsage() const
+    {
+        return _memoryUsage;
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether group memory usage exceeds its budget (resources residency increase is denied until it gets trimmed down).
+    /// </summary>
+    FORCE_INLINE bool IsOverBudget() const
+    {
+        return _isOverBudget;
+    }
 };
 
 /// <summary>
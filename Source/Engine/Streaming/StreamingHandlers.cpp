@@ -10,6 +10,7 @@
 #include "Engine/Audio/AudioClip.h"
 #include "Engine/Audio/Audio.h"
 #include "Engine/Audio/AudioSource.h"
+#include "Engine/Audio/AudioStreamingVoice.h"
 
 float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resource, DateTime now, double currentTime)
 {
@@ -17,11 +18,19 @@ float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resou
     auto& texture = *(StreamingTexture*)resource;
     const TextureHeader& header = *texture.GetHeader();
     float result = 1.0f;
+    bool useScreenSize = true;
+
+    // Pick the latest resolution requested by the meshes drawn with this texture (keep the last one if texture was not drawn since the previous update)
+    const int32 requestedResolution = (int32)Platform::InterlockedExchange(&texture._requestedResolution, 0);
+    if (requestedResolution > 0)
+        texture._onScreenResolution = requestedResolution;
+
     if (header.TextureGroup >= 0 && header.TextureGroup < Streaming::TextureGroups.Count())
     {
         // Quality based on texture group settings
         const TextureGroup& group = Streaming::TextureGroups[header.TextureGroup];
         result = group.Quality;
+        useScreenSize = group.UseScreenSize;
 
         // Drop quality if invisible
         const double lastRenderTime = texture.GetTexture()->LastRenderTime;
@@ -30,6 +39,17 @@ float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resou
             result *= group.QualityIfInvisible;
         }
     }
+
+    if (useScreenSize && texture._onScreenResolution > 0)
+    {
+        // Limit quality to the mip levels needed for the on-screen resolution (drop the mips that are bigger than required)
+        const int32 totalMipLevels = texture.TotalMipLevels();
+        const int32 size = Math::Max(texture.TotalWidth(), texture.TotalHeight());
+        int32 droppedMips = 0;
+        while (droppedMips + 1 < totalMipLevels && (size >> (droppedMips + 1)) >= texture._onScreenResolution)
+            droppedMips++;
+        result = Math::Min(result, (float)(totalMipLevels - droppedMips) / (float)totalMipLevels - ZeroTolerance);
+    }
     return result;
 }
 
@@ -93,10 +113,64 @@ int32 TexturesStreamingHandler::CalculateRequestedResidency(StreamableResource*
     return residency;
 }
 
+namespace
+{
+    double PrefetchBudget = 0.0;
+    double PrefetchBudgetTime = 0.0;
+
+    bool ConsumePrefetchBandwidth(uint64 size, double currentTime)
+    {
+        const double bandwidth = (double)Streaming::PrefetchBandwidth;
+        if (bandwidth <= 0.0)
+            return true;
+
+        // Token bucket refilled with the bandwidth (up to a second of data), big requests can go when it's full
+        PrefetchBudget = Math::Min(PrefetchBudget + (currentTime - PrefetchBudgetTime) * bandwidth, bandwidth);
+        PrefetchBudgetTime = currentTime;
+        if (PrefetchBudget < Math::Min((double)size, bandwidth))
+            return false;
+        PrefetchBudget -= (double)size;
+        return true;
+    }
+}
+
+float ModelsStreamingHandler::CalculateModelQuality(ModelBase* model, double currentTime)
+{
+    // Pick the latest LODs requested by the model drawing (keep the last ones if model was not drawn since the previous update)
+    const int32 requestedResidency = (int32)Platform::InterlockedExchange(&model->_requestedResidency, 0);
+    const int32 requestedPredictedResidency = (int32)Platform::InterlockedExchange(&model->_requestedPredictedResidency, 0);
+    if (requestedResidency > 0)
+    {
+        model->_drawResidency = requestedResidency;
+        model->_predictedResidency = Math::Max(requestedResidency, requestedPredictedResidency);
+    }
+    const int32 lodsCount = model->GetLODsCount();
+    if (model->_drawResidency <= 0 || lodsCount <= 0)
+    {
+        // Use the best quality until model gets drawn
+        return 1.0f;
+    }
+
+    int32 residency = model->_drawResidency;
+    if (model->_predictedResidency > residency)
+    {
+        // Keep already prefetched LODs and prefetch the next one (if bandwidth allows it)
+        const int32 currentResidency = model->GetCurrentResidency();
+        residency = Math::Max(residency, Math::Min(model->_predictedResidency, currentResidency));
+        if (model->_predictedResidency > currentResidency && currentResidency >= model->_drawResidency)
+        {
+            const FlaxChunk* chunk = model->GetChunk(MODEL_LOD_TO_CHUNK_INDEX(lodsCount - currentResidency - 1));
+            if (ConsumePrefetchBandwidth(chunk ? chunk->LocationInFile.Size : 0, currentTime))
+                residency = model->_predictedResidency;
+        }
+    }
+    return (float)residency / (float)lodsCount - ZeroTolerance;
+}
+
 float ModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, DateTime now, double currentTime)
 {
-    // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
-    return 1.0f;
+    ASSERT(resource);
+    return CalculateModelQuality((Model*)resource, currentTime);
 }
 
 int32 ModelsStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
@@ -134,8 +208,8 @@ int32 ModelsStreamingHandler::CalculateRequestedResidency(StreamableResource* re
 
 float SkinnedModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, DateTime now, double currentTime)
 {
-    // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
-    return 1.0f;
+    ASSERT(resource);
+    return CalculateModelQuality((SkinnedModel*)resource, currentTime);
 }
 
 int32 SkinnedModelsStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
@@ -185,9 +259,9 @@ int32 AudioStreamingHandler::CalculateResidency(StreamableResource* resource, fl
     bool chunksMask[ASSET_FILE_DATA_CHUNKS]; // TODO: use single int as bit mask
     Platform::MemoryClear(chunksMask, sizeof(chunksMask));
 
-    // Find audio chunks required for streaming
+    // Find audio chunks required for streaming (streaming voices decode the clip data on their own so clip buffers are not used)
     clip->StreamingQueue.Clear();
-    for (int32 sourceIndex = 0; sourceIndex < Audio::Sources.Count(); sourceIndex++)
+    for (int32 sourceIndex = 0; sourceIndex < Audio::Sources.Count() && !AudioStreamingVoice::Enabled; sourceIndex++)
     {
         // TODO: collect refs to audio clip from sources and use faster iteration (but do it thread-safe)
 
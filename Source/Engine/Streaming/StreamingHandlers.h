@@ -21,6 +21,9 @@ class FLAXENGINE_API TexturesStreamingHandler : public IStreamingHandler
 /// </summary>
 class FLAXENGINE_API ModelsStreamingHandler : public IStreamingHandler
 {
+protected:
+    static float CalculateModelQuality(class ModelBase* model, double currentTime);
+
 public:
     // [IStreamingHandler]
     float CalculateTargetQuality(StreamableResource* resource, DateTime now, double currentTime) override;
@@ -31,7 +34,7 @@ class FLAXENGINE_API ModelsStreamingHandler : public IStreamingHandler
 /// <summary>
 /// Implementation of IStreamingHandler for streamable skinned models.
 /// </summary>
-class FLAXENGINE_API SkinnedModelsStreamingHandler : public IStreamingHandler
+class FLAXENGINE_API SkinnedModelsStreamingHandler : public ModelsStreamingHandler
 {
 public:
     // [IStreamingHandler]
@@ -13,6 +13,42 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
 DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingSettings);
 public:
 
+    /// <summary>
+    /// The global memory budget (in megabytes) for all streamable resources (textures, models, etc.). When exceeded, the lowest priority resources get their quality trimmed down. Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), Limit(0), EditorDisplay(\"Memory\")")
+    int32 MemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the streamed textures. Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(0), EditorDisplay(\"Memory\")")
+    int32 TexturesMemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the streamed models (each for the models and the skinned models). Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0), EditorDisplay(\"Memory\")")
+    int32 ModelsMemoryBudget = 0;
+
+    /// <summary>
+    /// The time (in seconds) ahead used to predict the camera movement for models streaming. Models get LODs prefetched for the camera position extrapolated from its velocity (eg. for fast moving vehicles). Value 0 disables prediction.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(50), Limit(0, 10), EditorDisplay(\"Models\")")
+    float PredictionTime = 1.0f;
+
+    /// <summary>
+    /// The maximum bandwidth (in megabytes per second) of the prefetched model LODs data (for the predicted camera position). Limits prefetching so it doesn't starve the on-demand streaming. Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(60), Limit(0), EditorDisplay(\"Models\")")
+    int32 PrefetchBandwidth = 32;
+
+    /// <summary>
+    /// The maximum amount of data (in megabytes) that can be requested for streaming in a single frame (read from disk and uploaded to GPU). Requests are started by the on-screen priority and the remaining ones get deferred to the next frames to prevent hitches (eg. after a camera cut). Value 0 means no limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(70), Limit(0), EditorDisplay(\"General\")")
+    int32 MaxStreamingDataPerFrame = 16;
+
     /// <summary>
     /// Textures streaming configuration (per-group).
     /// </summary>
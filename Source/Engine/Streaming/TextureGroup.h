@@ -53,6 +53,12 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(TextureGroup);
     API_FIELD(Attributes="EditorOrder(26), Limit(0)")
     float TimeToInvisible = 20.0f;
 
+    /// <summary>
+    /// If checked, textures in this group load only the mip levels needed for their size on screen (estimated from the meshes drawn with them). Disable it for textures used mostly outside of the meshes (eg. in UI).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(27)")
+    bool UseScreenSize = true;
+
     /// <summary>
     /// The minimum amount of loaded mip levels for textures in this group. Defines the amount of the mips that should be always loaded. Higher values decrease streaming usage and keep more mips loaded.
     /// </summary>
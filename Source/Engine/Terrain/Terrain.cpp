@@ -4,6 +4,9 @@
 #include "TerrainPatch.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Ray.h"
+#include "Engine/Core/Math/CollisionsHelper.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Level/WorldPartition.h"
 #include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Physics/Physics.h"
@@ -15,6 +18,14 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
 #include "Engine/Renderer/GI/GlobalSurfaceAtlasPass.h"
+#include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
+#if USE_EDITOR
+#include "Editor/Editor.h"
+#endif
+
+// The distance scale (relative to CollisionStreamingDistance) at which the streamed patches collision gets released
+#define TERRAIN_COLLISION_STREAMING_RELEASE_SCALE 1.25f
 
 Terrain::Terrain(const SpawnParams& params)
     : PhysicsColliderActor(params)
@@ -575,7 +586,7 @@ void Terrain::Draw(RenderContext& renderContext)
                 auto chunk = &patch->Chunks[chunkIndex];
                 chunk->_cachedDrawLOD = 0;
                 bounds = BoundingBox(chunk->_bounds.Minimum - origin, chunk->_bounds.Maximum - origin);
-                if (renderContext.View.IsCullingDisabled || frustum.Intersects(bounds))
+                if (renderContext.View.IsCullingDisabled || (frustum.Intersects(bounds) && !renderContext.List->IsOccluded(bounds)))
                 {
                     if (chunk->PrepareDraw(renderContext))
                     {
@@ -669,7 +680,9 @@ void Terrain::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(CollisionLOD, _collisionLod);
     SERIALIZE(Material);
     SERIALIZE(PhysicalMaterial);
+    SERIALIZE(CollisionStreamingDistance);
     SERIALIZE(DrawModes);
+    SERIALIZE(VirtualTextureDistance);
 
     SERIALIZE_MEMBER(LODCount, _lodCount);
     SERIALIZE_MEMBER(ChunkSize, _chunkSize);
@@ -716,7 +729,9 @@ void Terrain::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
     DESERIALIZE_MEMBER(BoundsExtent, _boundsExtent);
     DESERIALIZE(Material);
     DESERIALIZE(PhysicalMaterial);
+    DESERIALIZE(CollisionStreamingDistance);
     DESERIALIZE(DrawModes);
+    DESERIALIZE(VirtualTextureDistance);
 
     member = stream.FindMember("LODCount");
     if (member != stream.MemberEnd() && member->value.IsInt())
@@ -788,12 +803,59 @@ RigidBody* Terrain::GetAttachedRigidBody() const
     return nullptr;
 }
 
+void Terrain::UpdateCollisionStreaming()
+{
+    if (CollisionStreamingDistance <= 0.0f || !IsDuringPlay())
+        return;
+#if USE_EDITOR
+    if (!Editor::IsPlayMode)
+        return;
+#endif
+    PROFILE_CPU();
+
+    // Gather streaming sources
+    Array<Vector3> sources;
+    WorldPartition::GetSourcesPositions(sources);
+    if (sources.IsEmpty())
+        return;
+
+    // Create collision for the patches near the sources and release it (with CPU data caches) for the far ones (larger distance prevents creating and releasing the collision when moving around the border)
+    const Real createDistance = CollisionStreamingDistance;
+    const Real releaseDistance = CollisionStreamingDistance * TERRAIN_COLLISION_STREAMING_RELEASE_SCALE;
+    bool anyCreated = false;
+    for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
+    {
+        const auto patch = _patches[pathIndex];
+        Real distance = MAX_Real;
+        for (const Vector3& source : sources)
+            distance = Math::Min(distance, CollisionsHelper::DistanceBoxPoint(patch->_bounds, source));
+        if (patch->HasCollision())
+        {
+            if (distance > releaseDistance)
+            {
+                patch->DestroyCollision();
+#if TERRAIN_UPDATING
+                patch->ReleaseCachedData();
+#endif
+            }
+        }
+        else if (distance <= createDistance)
+        {
+            patch->CreateCollision();
+            anyCreated |= patch->HasCollision();
+        }
+    }
+    if (anyCreated)
+        UpdateLayerBits();
+}
+
 void Terrain::OnEnable()
 {
     GetSceneRendering()->AddActor(this, _sceneRenderingKey);
 #if TERRAIN_USE_PHYSICS_DEBUG
     GetSceneRendering()->AddPhysicsDebug<Terrain, &Terrain::DrawPhysicsDebug>(this);
 #endif
+    GetScene()->Ticking.Update.AddTick<Terrain, &Terrain::UpdateCollisionStreaming>(this);
 
     // Base
     Actor::OnEnable();
@@ -805,6 +867,8 @@ void Terrain::OnDisable()
 #if TERRAIN_USE_PHYSICS_DEBUG
     GetSceneRendering()->RemovePhysicsDebug<Terrain, &Terrain::DrawPhysicsDebug>(this);
 #endif
+    GetScene()->Ticking.Update.RemoveTick(this);
+    TerrainVirtualTexturePass::Instance()->Invalidate(this);
 
     // Base
     Actor::OnDisable();
@@ -873,12 +937,20 @@ void Terrain::BeginPlay(SceneBeginData* data)
 {
     CacheNeighbors();
     _cachedScale = _transform.Scale;
-    for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
+    if (CollisionStreamingDistance > 0.0f)
     {
-        const auto patch = _patches[pathIndex];
-        if (!patch->HasCollision())
+        // Create collision only near the streaming sources
+        UpdateCollisionStreaming();
+    }
+    else
+    {
+        for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
         {
-            patch->CreateCollision();
+            const auto patch = _patches[pathIndex];
+            if (!patch->HasCollision())
+            {
+                patch->CreateCollision();
+            }
         }
     }
     UpdateLayerBits();
@@ -82,12 +82,24 @@ DECLARE_SCENE_OBJECT(Terrain);
     API_FIELD(Attributes="EditorOrder(520), DefaultValue(null), Limit(-1, 100, 0.1f), EditorDisplay(\"Collision\"), AssetReference(typeof(PhysicalMaterial), true)")
     AssetReference<JsonAsset> PhysicalMaterial;
 
+    /// <summary>
+    /// The distance from the streaming sources (see WorldPartition.AddSource, eg. player or physics actors, main camera is used if there are no sources) at which the terrain patches collision gets created in game. Collision of the patches that are farther away is released to reduce memory usage. Use 0 to create collision for all patches.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(530), DefaultValue(0.0f), Limit(0), EditorDisplay(\"Collision\")")
+    float CollisionStreamingDistance = 0.0f;
+
     /// <summary>
     /// The draw passes to use for rendering this object.
     /// </summary>
     API_FIELD(Attributes="EditorOrder(115), DefaultValue(DrawPass.Default), EditorDisplay(\"Terrain\")")
     DrawPass DrawModes = DrawPass::Default;
 
+    /// <summary>
+    /// The distance from the camera within which the terrain chunks use the runtime virtual texture with the baked material layers (albedo, normal, roughness and metalness) instead of evaluating all the material layers per-pixel every frame. Pages are rebaked only when terrain data or material parameters change. Material emissive and custom opacity mask are not baked. Use 0 to disable it.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(117), DefaultValue(0.0f), Limit(0), EditorDisplay(\"Terrain\")")
+    float VirtualTextureDistance = 0.0f;
+
 public:
 
     /// <summary>
@@ -434,6 +446,7 @@ DECLARE_SCENE_OBJECT(Terrain);
 private:
 
     void OnPhysicalMaterialChanged();
+    void UpdateCollisionStreaming();
 #if TERRAIN_USE_PHYSICS_DEBUG
 	void DrawPhysicsDebug(RenderView& view);
 #endif
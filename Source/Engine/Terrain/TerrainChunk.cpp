@@ -9,6 +9,7 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Core/Math/OrientedBoundingBox.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Level/Prefabs/PrefabManager.h"
@@ -120,6 +121,33 @@ void TerrainChunk::Draw(const RenderContext& renderContext) const
     //drawCall.TerrainData.HeightmapUVScaleBias.Z += halfTexelOffset;
     //drawCall.TerrainData.HeightmapUVScaleBias.W += halfTexelOffset;
 
+    // Use the baked virtual texture page instead of evaluating material layers for the chunks near the main view
+    drawCall.Terrain.VirtualTextureUVScaleBias = Float4::Zero;
+    const float virtualTextureDistance = _patch->_terrain->VirtualTextureDistance;
+    if (virtualTextureDistance > 0.0f && (renderContext.View.Pass & (DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas)) == DrawPass::GBuffer && !renderContext.View.IsOfflinePass)
+    {
+        const auto lodView = (renderContext.LodProxyView ? renderContext.LodProxyView : &renderContext.View);
+        const float distance = Float3::Distance(_boundsCenter - lodView->Origin, lodView->Position);
+        const MaterialInfo& info = _cachedDrawMaterial->GetInfo();
+        if (distance < virtualTextureDistance && info.BlendMode == MaterialBlendMode::Opaque && info.ShadingModel == MaterialShadingModel::Lit && !EnumHasAnyFlags(info.UsageFlags, MaterialUsageFlags::UseEmissive))
+        {
+            // Page gets rebaked when terrain data, its streamed resolution or material parameters change
+            uint32 version = _patch->_dataVersion;
+            CombineHash(version, (uint32)_cachedDrawMaterial->Params.GetVersionHash());
+            CombineHash(version, (uint32)_patch->Heightmap->GetTexture()->ResidentMipLevels());
+            for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+            {
+                const auto splatmap = _patch->Splatmap[i].Get();
+                if (splatmap)
+                    CombineHash(version, (uint32)splatmap->GetTexture()->ResidentMipLevels());
+            }
+            TerrainVirtualTexturePass::Instance()->GetPage(this, _cachedDrawMaterial, version, drawCall.Terrain.VirtualTextureUVScaleBias);
+        }
+    }
+
+    // Request the heightmap and splatmaps mips used by the chunk LOD (far patches stream only the low-resolution mips)
+    _patch->RequestStreamingLOD(lod);
+
     // Submit draw call
     const DrawPass drawModes = _patch->_terrain->DrawModes & renderContext.View.Pass & drawCall.Material->GetDrawModes();
     if (drawModes != DrawPass::None)
@@ -155,6 +183,7 @@ void TerrainChunk::Draw(const RenderContext& renderContext, MaterialBase* materi
     drawCall.Terrain.NeighborLOD.Y = (float)lod;
     drawCall.Terrain.NeighborLOD.Z = (float)lod;
     drawCall.Terrain.NeighborLOD.W = (float)lod;
+    drawCall.Terrain.VirtualTextureUVScaleBias = Float4::Zero;
     const auto scene = _patch->_terrain->GetScene();
     const auto flags = _patch->_terrain->_staticFlags;
     if ((flags & StaticFlags::Lightmap) != StaticFlags::None && scene)
@@ -35,7 +35,7 @@ class FLAXENGINE_API TerrainChunk : public ISerializable
 
     TerrainChunk* _neighbors[4];
     byte _cachedDrawLOD;
-    IMaterial* _cachedDrawMaterial;
+    MaterialBase* _cachedDrawMaterial;
 
     void Init(TerrainPatch* patch, uint16 x, uint16 z);
 
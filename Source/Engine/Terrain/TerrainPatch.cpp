@@ -13,6 +13,7 @@
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Level/Level.h"
 #include "Engine/Graphics/Async/GPUTask.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Threading/Threading.h"
 #if TERRAIN_EDITING
 #include "Engine/Core/Math/Packed.h"
@@ -23,11 +24,11 @@
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #if USE_EDITOR
-#include "Editor/Editor.h"
 #include "Engine/ContentImporters/AssetsImportingManager.h"
 #endif
 #endif
 #if USE_EDITOR
+#include "Editor/Editor.h"
 #include "Engine/Debug/DebugDraw.h"
 #endif
 #include "Engine/Content/Content.h"
@@ -86,6 +87,7 @@ void TerrainPatch::Init(Terrain* terrain, int16 x, int16 z)
 
 TerrainPatch::~TerrainPatch()
 {
+    TerrainVirtualTexturePass::Instance()->Invalidate(_terrain);
 #if TERRAIN_UPDATING
     SAFE_DELETE(_dataHeightmap);
     for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
@@ -114,6 +116,25 @@ void TerrainPatch::UpdateBounds()
     }
 }
 
+void TerrainPatch::RequestStreamingLOD(int32 lod) const
+{
+    int32 textureSize = (_terrain->_chunkSize + 1) * CHUNKS_COUNT_EDGE;
+#if USE_EDITOR
+    // Terrain editing needs all mips to be resident
+    if (Editor::IsPlayMode)
+#endif
+    {
+        textureSize = Math::Max(textureSize >> Math::Max(lod, 0), 1);
+    }
+    if (const Texture* heightmap = Heightmap.Get())
+        heightmap->StreamingTexture()->RequestResolution(textureSize);
+    for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+    {
+        if (const Texture* splatmap = Splatmap[i].Get())
+            splatmap->StreamingTexture()->RequestResolution(textureSize);
+    }
+}
+
 void TerrainPatch::UpdateTransform()
 {
     // Update physics
@@ -932,6 +953,7 @@ bool TerrainPatch::SetupHeightMap(int32 heightMapLength, const float* heightMap,
     UpdateCollision();
     _terrain->UpdateBounds();
     _terrain->UpdateLayerBits();
+    _dataVersion++;
 
 #if TERRAIN_UPDATING
     // Invalidate cache
@@ -1098,6 +1120,8 @@ bool TerrainPatch::SetupSplatMap(int32 index, int32 splatMapLength, const Color3
 	}
 #endif
 
+    _dataVersion++;
+
 #if TERRAIN_UPDATING
     // Invalidate cache
     _cachedSplatMap[index].Resize(0);
@@ -1161,6 +1185,24 @@ Color32* TerrainPatch::GetSplatMapData(int32 index)
     return _cachedSplatMap[index].Get();
 }
 
+void TerrainPatch::ReleaseCachedData()
+{
+    if (!_wasHeightModified)
+    {
+        _cachedHeightMap.Resize(0);
+        _cachedHolesMask.Resize(0);
+        SAFE_DELETE(_dataHeightmap);
+    }
+    for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+    {
+        if (!_wasSplatmapModified[i])
+        {
+            _cachedSplatMap[i].Resize(0);
+            SAFE_DELETE(_dataSplatmap[i]);
+        }
+    }
+}
+
 void TerrainPatch::CacheHeightData()
 {
     PROFILE_CPU_NAMED("Terrain.CacheHeightData");
@@ -1692,6 +1734,7 @@ bool TerrainPatch::ModifySplatMap(int32 index, const Color32* samples, const Int
 
     // Mark as modified (need to save texture data during scene saving)
     _wasSplatmapModified[index] = true;
+    _dataVersion++;
 
     // Note: if terrain is using virtual storage then it won't be updated, we could synchronize that data...
 
@@ -1807,6 +1850,7 @@ bool TerrainPatch::UpdateHeightData(const TerrainDataUpdateInfo& info, const Int
 
     // Mark as modified (need to save texture data during scene saving)
     _wasHeightModified = true;
+    _dataVersion++;
 
     // Note: if terrain is using virtual storage then it won't be updated, we could synchronize that data...
 
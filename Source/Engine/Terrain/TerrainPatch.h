@@ -42,6 +42,7 @@ class FLAXENGINE_API TerrainPatch : public ISerializable
     void* _physicsHeightField;
     CriticalSection _collisionLocker;
     float _collisionScaleXZ;
+    uint32 _dataVersion = 0; // Incremented when heightmap, holes or splatmaps get modified (used to detect outdated virtual texture pages)
 #if TERRAIN_UPDATING
     Array<float> _cachedHeightMap;
     Array<byte> _cachedHolesMask;
@@ -242,6 +243,11 @@ class FLAXENGINE_API TerrainPatch : public ISerializable
     /// <returns>The splat map data.</returns>
     Color32* GetSplatMapData(int32 index);
 
+    /// <summary>
+    /// Releases the cached CPU copies of the heightmap, holes mask and splatmaps data (cached on demand, eg. when editing terrain). Modified data is kept until it's saved.
+    /// </summary>
+    void ReleaseCachedData();
+
     /// <summary>
     /// Modifies the terrain patch heightmap with the given samples.
     /// </summary>
@@ -367,6 +373,12 @@ class FLAXENGINE_API TerrainPatch : public ISerializable
     /// <param name="indexBuffer">The output index buffer.</param>
     void ExtractCollisionGeometry(Array<Float3>& vertexBuffer, Array<int32>& indexBuffer);
 
+    /// <summary>
+    /// Requests the heightmap and splatmaps textures resolution needed to draw the patch chunk with the given LOD (used by the textures streaming to load only the needed mip levels). Can be called from async drawing jobs.
+    /// </summary>
+    /// <param name="lod">The chunk LOD index.</param>
+    void RequestStreamingLOD(int32 lod) const;
+
 private:
 
     /// <summary>
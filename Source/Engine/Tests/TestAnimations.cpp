@@ -0,0 +1,110 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Engine/Animations/AnimationData.h"
+#include "Engine/Animations/AnimationPose.h"
+#include "Engine/Animations/CompressedAnimationData.h"
+#include "Engine/Animations/Config.h"
+#include "Engine/Animations/InverseKinematics.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("Animations")
+{
+    SECTION("Test CompressedAnimationData")
+    {
+        // Setup animation with every frame sampled
+        const int32 framesCount = 61;
+        AnimationData data;
+        data.Duration = framesCount - 1;
+        data.FramesPerSecond = 30.0;
+        auto& channel = data.Channels.AddOne();
+        LinearCurve<Float3>::KeyFrameCollection positions;
+        LinearCurve<Quaternion>::KeyFrameCollection rotations;
+        LinearCurve<Float3>::KeyFrameCollection scales;
+        for (int32 frame = 0; frame < framesCount; frame++)
+        {
+            const float time = (float)frame;
+            positions.Add(LinearCurveKeyframe<Float3>(time, Float3(Math::Sin(time * 0.1f) * 100.0f, time, 0.0f)));
+            rotations.Add(LinearCurveKeyframe<Quaternion>(time, Quaternion::Euler(0.0f, time * 5.0f, 0.0f)));
+            scales.Add(LinearCurveKeyframe<Float3>(time, Float3::One));
+        }
+        channel.Position.SetKeyframes(positions);
+        channel.Rotation.SetKeyframes(rotations);
+        channel.Scale.SetKeyframes(scales);
+
+        CompressedAnimationData compressed;
+        REQUIRE(!compressed.Init(data));
+        CHECK(compressed.IsValid());
+        CHECK(compressed.GetChannelsCount() == 1);
+        CHECK(compressed.GetMemoryUsage() < data.GetMemoryUsage());
+
+        // Compare with the source curves (between the frames too)
+        for (float time = 0.0f; time <= (float)(framesCount - 1); time += 0.25f)
+        {
+            Transform expected = Transform::Identity, actual = Transform::Identity;
+            channel.EvaluateAll(time, &expected, false);
+            compressed.Sample(0, time, actual);
+            CHECK(Float3::Distance(Float3(expected.Translation), Float3(actual.Translation)) <= ANIM_COMPRESSION_POSITION_ERROR * 2.0f);
+            CHECK(Math::Abs(Quaternion::Dot(expected.Orientation, actual.Orientation)) >= 1.0f - ANIM_COMPRESSION_ROTATION_ERROR * 2.0f);
+            CHECK(Float3::Distance(expected.Scale, actual.Scale) <= ANIM_COMPRESSION_SCALE_ERROR);
+        }
+    }
+
+    SECTION("Test AnimationPose")
+    {
+        // Use the nodes count that is not a multiple of the SIMD block size
+        const int32 count = 7;
+        Transform a[count], b[count], result[count];
+        for (int32 i = 0; i < count; i++)
+        {
+            a[i] = Transform(Vector3((float)i, 0.0f, 1.0f), Quaternion::Euler(10.0f * i, 0.0f, 0.0f), Float3(1.0f + i));
+            b[i] = Transform(Vector3(0.0f, (float)i, 2.0f), Quaternion::Euler(0.0f, 20.0f * i, 5.0f), Float3(2.0f));
+        }
+
+        AnimationPose::Blend(a, b, 0.3f, result, count);
+        for (int32 i = 0; i < count; i++)
+        {
+            Transform expected;
+            Transform::Lerp(a[i], b[i], 0.3f, expected);
+            CHECK(Vector3::NearEqual(expected.Translation, result[i].Translation));
+            CHECK(Float3::NearEqual(expected.Scale, result[i].Scale));
+            CHECK(Math::Abs(Quaternion::Dot(expected.Orientation, result[i].Orientation)) > 0.9999f);
+        }
+
+        AnimationPose::BlendAdditive(a, b, 1.0f, result, count);
+        for (int32 i = 0; i < count; i++)
+        {
+            Quaternion expected = a[i].Orientation * b[i].Orientation;
+            expected.Normalize();
+            CHECK(Vector3::NearEqual(a[i].Translation + b[i].Translation, result[i].Translation));
+            CHECK(Float3::NearEqual(a[i].Scale * b[i].Scale, result[i].Scale));
+            CHECK(Math::Abs(Quaternion::Dot(expected, result[i].Orientation)) > 0.9999f);
+        }
+    }
+
+    SECTION("Test InverseKinematics")
+    {
+        // Batched solver has to match the single chain one (use the chains count that is not a multiple of the SIMD block size)
+        const int32 count = 6;
+        Transform batched[count][3], expected[count][3];
+        InverseKinematics::TwoBoneChain chains[count];
+        for (int32 i = 0; i < count; i++)
+        {
+            expected[i][0] = Transform(Vector3(0.0f, 100.0f, (float)i), Quaternion::Euler(0.0f, 10.0f * i, 0.0f));
+            expected[i][1] = Transform(Vector3(0.0f, 55.0f, 5.0f + i), Quaternion::Euler(5.0f * i, 0.0f, 0.0f));
+            expected[i][2] = Transform(Vector3(0.0f, 10.0f, (float)i), Quaternion::Identity);
+            for (int32 j = 0; j < 3; j++)
+                batched[i][j] = expected[i][j];
+            chains[i] = { &batched[i][0], &batched[i][1], &batched[i][2], Vector3(10.0f * i, 20.0f + 20.0f * i, 0.0f), Vector3(0.0f, 50.0f, 100.0f) };
+        }
+        InverseKinematics::SolveTwoBoneIK(chains, count);
+        for (int32 i = 0; i < count; i++)
+        {
+            InverseKinematics::SolveTwoBoneIK(expected[i][0], expected[i][1], expected[i][2], chains[i].Target, chains[i].JointTarget);
+            for (int32 j = 0; j < 3; j++)
+            {
+                CHECK(Vector3::Distance(expected[i][j].Translation, batched[i][j].Translation) < 0.001f);
+                CHECK(Math::Abs(Quaternion::Dot(expected[i][j].Orientation, batched[i][j].Orientation)) > 0.9999f);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Engine/Audio/Mixer/AudioMixerDSP.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("AudioMixerDSP")
+{
+    SECTION("Test Resampling")
+    {
+        // Mono source at half of the output rate
+        const float src[4] = { 0.0f, 1.0f, 0.0f, -1.0f };
+        float outL[10] = {}, outR[10] = {};
+        double position = 0.0;
+        const int32 mixed = AudioMixerDSP::MixResampled(outL, outR, 10, src, 4, 1, false, position, 0.5f, 1.0f, 0.5f, 0.0f, 0.0f);
+        CHECK(mixed == 8);
+        CHECK(position == 4.0);
+        CHECK(Math::NearEqual(outL[1], 0.5f));
+        CHECK(Math::NearEqual(outL[2], 1.0f));
+        CHECK(Math::NearEqual(outR[2], 0.5f));
+        CHECK(Math::NearEqual(outL[5], -0.5f));
+        CHECK(outL[8] == 0.0f);
+
+        // Stereo source with gain ramp
+        const float stereo[8] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+        float rampL[4] = {}, rampR[4] = {};
+        position = 0.0;
+        CHECK(AudioMixerDSP::MixResampled(rampL, rampR, 4, stereo, 4, 2, false, position, 1.0f, 0.0f, 0.0f, 0.25f, 0.25f) == 4);
+        CHECK(Math::NearEqual(rampL[3], 0.75f));
+        CHECK(Math::NearEqual(rampR[3], -0.75f));
+    }
+
+    SECTION("Test Filters")
+    {
+        float data[16];
+        for (float& e : data)
+            e = 1.0f;
+        float state = 0.0f;
+        AudioMixerDSP::LowPass(data, 16, AudioMixerDSP::GetLowPassCoefficient(1000.0f, 48000.0f), state);
+        CHECK(data[0] > 0.0f);
+        CHECK(data[0] < data[15]);
+        CHECK(data[15] < 1.0f);
+        CHECK(state == data[15]);
+        CHECK(AudioMixerDSP::GetLowPassCoefficient(1000000.0f, 48000.0f) == 1.0f);
+    }
+
+    SECTION("Test Conversion")
+    {
+        const float l[5] = { 0.0f, 1.0f, -1.0f, 2.0f, 0.5f };
+        const float r[5] = { -2.0f, 0.5f, 0.0f, -0.5f, 1.0f };
+        int16 pcm[10];
+        AudioMixerDSP::ConvertToInt16(l, r, pcm, 5);
+        CHECK(pcm[0] == 0);
+        CHECK(pcm[1] == -32767);
+        CHECK(pcm[2] == 32767);
+        CHECK(pcm[4] == -32767);
+        CHECK(pcm[6] == 32767);
+        CHECK(pcm[8] == 16383);
+        CHECK(pcm[9] == 32767);
+    }
+}
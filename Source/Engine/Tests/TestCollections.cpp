@@ -3,6 +3,10 @@
 #include "Engine/Core/RandomStream.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/BitArray.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
+#include "Engine/Core/Collections/FlatHashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include <ThirdParty/catch2/catch.hpp>
 
 TEST_CASE("Array")
@@ -108,3 +112,117 @@ TEST_CASE("BitArray")
         CHECK(a1 == testData);
     }
 }
+
+TEST_CASE("FlatDictionary")
+{
+    SECTION("Test Operations")
+    {
+        RandomStream rand(101);
+        Dictionary<int32, int32> reference;
+        FlatDictionary<int32, int32> a1;
+        for (int32 i = 0; i < 20000; i++)
+        {
+            const int32 key = rand.RandRange(0, 5000);
+            if (rand.GetFraction() < 0.3f)
+            {
+                CHECK(a1.Remove(key) == reference.Remove(key));
+            }
+            else
+            {
+                a1[key] = i;
+                reference[key] = i;
+            }
+        }
+        CHECK(a1.Count() == reference.Count());
+        for (auto i = reference.Begin(); i.IsNotEnd(); ++i)
+        {
+            int32 value;
+            CHECK(a1.TryGet(i->Key, value));
+            CHECK(value == i->Value);
+        }
+        int32 count = 0;
+        for (auto i = a1.Begin(); i.IsNotEnd(); ++i)
+        {
+            CHECK(reference.ContainsKey(i->Key));
+            count++;
+        }
+        CHECK(count == a1.Count());
+
+        FlatDictionary<int32, int32> a2(a1);
+        CHECK(a2.Count() == a1.Count());
+        a1.Clear();
+        CHECK(a1.IsEmpty());
+        CHECK(!a1.ContainsKey(reference.Begin()->Key));
+        CHECK(a2.ContainsKey(reference.Begin()->Key));
+    }
+}
+
+TEST_CASE("FlatHashSet")
+{
+    SECTION("Test Operations")
+    {
+        FlatHashSet<int32> a1;
+        for (int32 i = 0; i < 1000; i++)
+            CHECK(a1.Add(i * 7));
+        CHECK(!a1.Add(7));
+        CHECK(a1.Count() == 1000);
+        for (int32 i = 0; i < 1000; i += 2)
+            CHECK(a1.Remove(i * 7));
+        CHECK(a1.Count() == 500);
+        for (int32 i = 0; i < 1000; i++)
+            CHECK(a1.Contains(i * 7) == (i % 2 == 1));
+        for (auto i = a1.Begin(); i.IsNotEnd(); ++i)
+            a1.Remove(i);
+        CHECK(a1.IsEmpty());
+    }
+}
+
+namespace
+{
+    template<typename T>
+    bool IsRadixSorted(int32 count, bool parallel)
+    {
+        RandomStream rand(101);
+        Array<T> keys, tmpKeys;
+        Array<int32> values, tmpValues;
+        keys.Resize(count);
+        tmpKeys.Resize(count);
+        values.Resize(count);
+        tmpValues.Resize(count);
+        for (int32 i = 0; i < count; i++)
+        {
+            // Use constant middle bits to test skipping the passes
+            T key = (T)(rand.GetUnsignedInt() & 0xff00ff);
+            if (sizeof(T) > 4)
+                key |= (T)rand.GetUnsignedInt() << (sizeof(T) * 4);
+            keys[i] = key;
+            values[i] = i;
+        }
+        const Array<T> input = keys;
+        T* keysData = keys.Get();
+        int32* valuesData = values.Get();
+        if (parallel)
+            Sorting::RadixSortParallel(keysData, valuesData, tmpKeys.Get(), tmpValues.Get(), count);
+        else
+            Sorting::RadixSort(keysData, valuesData, tmpKeys.Get(), tmpValues.Get(), count);
+        for (int32 i = 0; i < count; i++)
+        {
+            if (input[valuesData[i]] != keysData[i])
+                return false;
+            if (i != 0 && (keysData[i - 1] > keysData[i] || (keysData[i - 1] == keysData[i] && valuesData[i - 1] > valuesData[i])))
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Sorting")
+{
+    SECTION("Test Radix Sort")
+    {
+        CHECK(IsRadixSorted<uint32>(1000, false));
+        CHECK(IsRadixSorted<uint64>(1000, false));
+        CHECK(IsRadixSorted<uint32>(100000, true));
+        CHECK(IsRadixSorted<uint64>(100000, true));
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Engine/Content/Cache/AssetsCache.h"
+#include "Engine/Content/Cache/AssetsCacheIndex.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/FileSystem.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("AssetsCacheIndex")
+{
+    SECTION("Test Lookups")
+    {
+        AssetsCache::Registry registry;
+        AssetsCache::PathsMapping pathsMapping;
+        AssetsCache::Dependencies dependencies;
+        Guid prevId;
+        for (int32 i = 0; i < 100; i++)
+        {
+            const Guid id(i + 1, i * 7, i * 13, 1);
+            registry.Add(id, AssetsCache::Entry(id, i % 2 ? TEXT("FlaxEngine.Texture") : TEXT("FlaxEngine.Model"), String::Format(TEXT("Content/Asset{0}.flax"), i)));
+            if (i % 10 == 0)
+                pathsMapping.Add(String::Format(TEXT("Source/Asset{0}.fbx"), i), id);
+            if (i % 2 == 0 && i != 0)
+                dependencies[id].Add(prevId);
+            prevId = id;
+        }
+        const String path = Globals::TemporaryFolder / TEXT("TestAssetsCache.idx");
+        REQUIRE(!AssetsCache::SaveIndex(path, registry, pathsMapping, &dependencies));
+        AssetsCacheIndex index;
+        REQUIRE(!index.Load(path));
+        CHECK(index.Count() == 100);
+        for (auto i = registry.Begin(); i.IsNotEnd(); ++i)
+        {
+            AssetInfo info;
+            Guid id;
+            CHECK(index.FindAsset(i->Key, info));
+            CHECK(info.Path == i->Value.Info.Path);
+            CHECK(info.TypeName == i->Value.Info.TypeName);
+            CHECK(index.FindAsset(info.Path, id));
+            CHECK(id == i->Key);
+            Array<Guid> assetDependencies;
+            CHECK(index.GetDependencies(i->Key, assetDependencies));
+            const Array<Guid>* expectedDependencies = dependencies.TryGet(i->Key);
+            CHECK(assetDependencies.Count() == (expectedDependencies ? expectedDependencies->Count() : 0));
+            if (expectedDependencies && assetDependencies.Count() == 1)
+                CHECK(assetDependencies[0] == expectedDependencies->At(0));
+        }
+        for (auto i = pathsMapping.Begin(); i.IsNotEnd(); ++i)
+        {
+            Guid id;
+            CHECK(index.FindAsset(i->Key, id));
+            CHECK(id == i->Value);
+            const String* mappedPath = index.FindMappedPath(i->Value);
+            REQUIRE(mappedPath);
+            CHECK(*mappedPath == i->Key);
+        }
+        AssetInfo info;
+        Guid id;
+        CHECK(!index.FindAsset(Guid(1, 2, 3, 4), info));
+        CHECK(!index.FindAsset(TEXT("Content/Missing.flax"), id));
+        Array<Guid> ids;
+        index.GetAllByTypeName(TEXT("FlaxEngine.Model"), ids);
+        CHECK(ids.Count() == 50);
+        index.Unload();
+        FileSystem::DeleteFile(path);
+    }
+}
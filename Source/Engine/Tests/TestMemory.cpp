@@ -0,0 +1,40 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Memory/ThreadCacheAllocator.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("Allocator")
+{
+    SECTION("Test ThreadCacheAllocator")
+    {
+        // Small and large allocations with different alignments
+        for (uint64 size : { 1, 16, 100, 1000, 20000, 40000, 1000000 })
+        {
+            for (uint64 alignment : { 16, 64, 4096 })
+            {
+                byte* ptr = (byte*)ThreadCacheAllocator::Allocate(size, alignment);
+                REQUIRE(ptr != nullptr);
+                CHECK(((uintptr)ptr & (alignment - 1)) == 0);
+                Platform::MemorySet(ptr, size, 0xcd);
+                ThreadCacheAllocator::Free(ptr);
+            }
+        }
+
+        // Blocks reuse
+        void* a = ThreadCacheAllocator::Allocate(48);
+        ThreadCacheAllocator::Free(a);
+        void* b = ThreadCacheAllocator::Allocate(48);
+        CHECK(a == b);
+        ThreadCacheAllocator::Free(b);
+        CHECK(ThreadCacheAllocator::GetReservedMemory() != 0);
+
+        // Thread cache flush returns blocks to the global lists (reused without reserving more memory)
+        const uint64 reserved = ThreadCacheAllocator::GetReservedMemory();
+        ThreadCacheAllocator::FlushThreadCache();
+        void* c = ThreadCacheAllocator::Allocate(48);
+        CHECK(c == b);
+        ThreadCacheAllocator::Free(c);
+        CHECK(ThreadCacheAllocator::GetReservedMemory() == reserved);
+    }
+}
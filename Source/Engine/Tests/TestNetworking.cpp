@@ -0,0 +1,61 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "Engine/Networking/NetworkStream.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("NetworkStream")
+{
+    SECTION("Test Bits")
+    {
+        NetworkStream* stream = New<NetworkStream>();
+        stream->Initialize();
+        stream->WriteBit(true);
+        stream->WriteBits(5, 3);
+        stream->WriteBits(0xabcdef, 24);
+        stream->WriteRangedInt32(-3, -10, 10);
+        stream->WriteVarUInt32(300);
+        stream->WriteVarInt32(-2);
+        stream->WriteUint16(1234);
+        stream->WriteBit(false);
+        const uint32 size = stream->GetPosition();
+        CHECK(size == 11);
+
+        NetworkStream* reader = New<NetworkStream>();
+        reader->Initialize(stream->GetBuffer(), size);
+        CHECK(reader->ReadBit() == true);
+        CHECK(reader->ReadBits(3) == 5);
+        CHECK(reader->ReadBits(24) == 0xabcdef);
+        CHECK(reader->ReadRangedInt32(-10, 10) == -3);
+        CHECK(reader->ReadVarUInt32() == 300);
+        CHECK(reader->ReadVarInt32() == -2);
+        uint16 value;
+        reader->ReadUint16(&value);
+        CHECK(value == 1234);
+        CHECK(reader->ReadBit() == false);
+        CHECK(reader->GetPosition() == size);
+        Delete(reader);
+        Delete(stream);
+    }
+
+    SECTION("Test Quantization")
+    {
+        NetworkStream* stream = New<NetworkStream>();
+        stream->Initialize();
+        const Vector3 position(1234.567f, -0.25f, 98765.4f);
+        const Quaternion rotation = Quaternion::Euler(30.0f, -120.0f, 75.0f);
+        stream->WriteQuantized(0.3f, 0.0f, 1.0f, 8);
+        stream->WriteQuantized(position, 0.1f);
+        stream->WriteQuantized(rotation);
+        const uint32 size = stream->GetPosition();
+        CHECK(size < sizeof(float) + sizeof(Vector3) + sizeof(Quaternion));
+
+        NetworkStream* reader = New<NetworkStream>();
+        reader->Initialize(stream->GetBuffer(), size);
+        CHECK(Math::Abs(reader->ReadQuantized(0.0f, 1.0f, 8) - 0.3f) <= 1.0f / 255.0f);
+        CHECK(Vector3::NearEqual(reader->ReadQuantizedVector3(0.1f), position, 0.05f));
+        const Quaternion rotationRead = reader->ReadQuantizedQuaternion();
+        CHECK(Math::Abs(Quaternion::Dot(rotationRead, rotation)) > 0.9999f);
+        Delete(reader);
+        Delete(stream);
+    }
+}
@@ -19,6 +19,41 @@ TEST_CASE("Prefabs")
         REQUIRE(prefab);
         Content::DeleteAsset(prefab);
     }
+    SECTION("Test Spawn Multiple Instances")
+    {
+        AssetReference<Prefab> prefab = Content::CreateVirtualAsset<Prefab>();
+        REQUIRE(prefab);
+        auto prefabInit = prefab->Init(Prefab::TypeName,
+                                       "["
+                                       "{"
+                                       "\"ID\": \"9a1c3c2f4f2a3e5a8b4d1e6f7a8b9c0d\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"Name\": \"Bullet\""
+                                       "},"
+                                       "{"
+                                       "\"ID\": \"1b2c3d4e5f60718293a4b5c6d7e8f901\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"ParentID\": \"9a1c3c2f4f2a3e5a8b4d1e6f7a8b9c0d\","
+                                       "\"Name\": \"Bullet.Trail\""
+                                       "}"
+                                       "]");
+        REQUIRE(!prefabInit);
+
+        // Spawn multiple times to use the cached prefab objects types
+        Array<Actor*> instances;
+        instances.Resize(10);
+        for (int32 i = 0; i < instances.Count(); i++)
+            instances[i] = PrefabManager::SpawnPrefab(prefab, nullptr, nullptr);
+        for (Actor* instance : instances)
+        {
+            REQUIRE(instance);
+            REQUIRE(instance->GetChildrenCount() == 1);
+            CHECK(instance->GetPrefabID() == prefab->GetID());
+            CHECK(instance->Children[0]->GetName() == TEXT("Bullet.Trail"));
+            instance->DeleteObject();
+        }
+        Content::DeleteAsset(prefab);
+    }
     SECTION("Test Repareting in Nested Prefab")
     {
         // https://github.com/FlaxEngine/FlaxEngine/issues/718
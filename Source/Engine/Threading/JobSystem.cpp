@@ -2,10 +2,12 @@
 
 #include "JobSystem.h"
 #include "IRunnable.h"
+#include "WorkerStats.h"
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/Thread.h"
 #include "Engine/Platform/ConditionVariable.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Scripting/ManagedCLR/MCore.h"
@@ -20,19 +22,21 @@
 // JOB_SYSTEM_USE_MUTEX=1, enqueue=130-280 cycles, dequeue=2-6 cycles
 // JOB_SYSTEM_USE_MUTEX=0, enqueue=300-700 cycles, dequeue=10-16 cycles
 // So using RingBuffer+Mutex+Signals is better than moodycamel::ConcurrentQueue
+// The numbers above were measured for the single global RingBuffer+Mutex queue. Jobs are now stored in per-thread work-stealing queues
+// (Chase-Lev deque) and only dispatches from non-job threads go through the global RingBuffer+Mutex injector (job threads move a batch of
+// injected jobs into their own queue at once). Job completion takes the lock only for the last job of the dispatch.
+// No updated numbers are recorded yet - use JobSystem benchmarks (Source/Engine/Benchmarks/BenchmarkThreading.cpp) to compare the setups.
 
 #define JOB_SYSTEM_ENABLED 1
-#define JOB_SYSTEM_USE_MUTEX 1
 #define JOB_SYSTEM_USE_STATS 0
+#define JOB_SYSTEM_QUEUE_SIZE 1024 // Capacity of the per-thread jobs queue (power of two)
+#define JOB_SYSTEM_MAX_CONTEXTS 1024 // Limit of the dispatches that can be in-flight at once
+#define JOB_SYSTEM_INJECTOR_BATCH 32 // Max amount of jobs grabbed by the thread from the global queue at once
 
 #if JOB_SYSTEM_USE_STATS
 #include "Engine/Core/Log.h"
 #endif
-#if JOB_SYSTEM_USE_MUTEX
 #include "Engine/Core/Collections/RingBuffer.h"
-#else
-#include "ConcurrentQueue.h"
-#endif
 
 #if JOB_SYSTEM_ENABLED
 
@@ -49,25 +53,96 @@ class JobSystemService : public EngineService
     void Dispose() override;
 };
 
-struct JobData
+// Single job is encoded as a context slot (upper 32-bits) and the context generation (lower 32-bits). Job index is claimed from the context when the job runs
+// so a thread waiting for the dispatch can execute its jobs directly (queued jobs of the already claimed indices or of the reused slots are skipped).
+typedef int64 JobData;
+
+FORCE_INLINE JobData PackJob(int32 slot, uint32 generation)
 {
-    Function<void(int32)> Job;
-    int32 Index;
-    int64 JobKey;
-};
+    return ((int64)slot << 32) | (int64)generation;
+}
 
-template<>
-struct TIsPODType<JobData>
+FORCE_INLINE void UnpackJob(JobData data, int32& slot, uint32& generation)
 {
-    enum { Value = false };
+    slot = (int32)(data >> 32);
+    generation = (uint32)(data & MAX_uint32);
+}
+
+/// <summary>
+/// Fixed-capacity Chase-Lev work-stealing deque. The owner thread pushes and pops at the bottom, other threads steal from the top.
+/// </summary>
+class JobQueue
+{
+private:
+    volatile int64 _top = 0;
+    volatile int64 _bottom = 0;
+    volatile int64 _items[JOB_SYSTEM_QUEUE_SIZE];
+
+public:
+    int32 Count()
+    {
+        const int64 count = Platform::AtomicRead(&_bottom) - Platform::AtomicRead(&_top);
+        return count > 0 ? (int32)count : 0;
+    }
+
+    // Called only by the owner thread.
+    bool Push(JobData data)
+    {
+        const int64 b = Platform::AtomicRead(&_bottom);
+        const int64 t = Platform::AtomicRead(&_top);
+        if (b - t >= JOB_SYSTEM_QUEUE_SIZE)
+            return false;
+        Platform::AtomicStore(&_items[b & (JOB_SYSTEM_QUEUE_SIZE - 1)], data);
+        Platform::AtomicStore(&_bottom, b + 1);
+        return true;
+    }
+
+    // Called only by the owner thread.
+    bool Pop(JobData& data)
+    {
+        const int64 b = Platform::AtomicRead(&_bottom) - 1;
+        Platform::AtomicStore(&_bottom, b);
+        Platform::MemoryBarrier();
+        const int64 t = Platform::AtomicRead(&_top);
+        if (t > b)
+        {
+            // Empty
+            Platform::AtomicStore(&_bottom, b + 1);
+            return false;
+        }
+        data = Platform::AtomicRead(&_items[b & (JOB_SYSTEM_QUEUE_SIZE - 1)]);
+        if (t != b)
+            return true;
+
+        // Last item so race against the thieves
+        const bool result = Platform::InterlockedCompareExchange(&_top, t + 1, t) == t;
+        Platform::AtomicStore(&_bottom, b + 1);
+        return result;
+    }
+
+    // Called by any thread.
+    bool Steal(JobData& data)
+    {
+        const int64 t = Platform::AtomicRead(&_top);
+        Platform::MemoryBarrier();
+        const int64 b = Platform::AtomicRead(&_bottom);
+        if (t >= b)
+            return false;
+        data = Platform::AtomicRead(&_items[t & (JOB_SYSTEM_QUEUE_SIZE - 1)]);
+        return Platform::InterlockedCompareExchange(&_top, t + 1, t) == t;
+    }
 };
 
 class JobSystemThread : public IRunnable
 {
 public:
     uint64 Index;
+    JobQueue Queue;
+    WorkerCounters Stats;
 
 public:
+    bool TryGetJob(JobData& data);
+
     // [IRunnable]
     String ToString() const override
     {
@@ -78,40 +153,57 @@ class JobSystemThread : public IRunnable
 
     void AfterWork(bool wasKilled) override
     {
-        Delete(this);
     }
 };
 
 struct JobContext
 {
+    Function<void(int32)> Job;
     volatile int64 JobsLeft;
-};
-
-template<>
-struct TIsPODType<JobContext>
-{
-    enum { Value = true };
+    volatile int64 State; // Generation (upper 32-bits) and the next job index to claim (lower 32-bits)
+    int64 Label;
+    uint32 Generation = 0;
+    int32 JobsCount;
+    int32 DependenciesLeft;
+    Array<int32, InlinedAllocation<8>> Dependants;
+
+    bool ClaimJob(uint32 generation, int32& index)
+    {
+        while (true)
+        {
+            const int64 state = Platform::AtomicRead(&State);
+            index = (int32)(uint32)(state & MAX_uint32);
+            if ((uint32)(state >> 32) != generation || index >= JobsCount)
+                return false;
+            if (Platform::InterlockedCompareExchange(&State, state + 1, state) == state)
+                return true;
+        }
+    }
 };
 
 namespace
 {
     JobSystemService JobSystemInstance;
     Thread* Threads[PLATFORM_THREADS_LIMIT] = {};
+    JobSystemThread* ThreadsRunnables[PLATFORM_THREADS_LIMIT] = {};
+    THREADLOCAL JobSystemThread* ThisThread = nullptr;
     int32 ThreadsCount = 0;
     bool JobStartingOnDispatch = true;
     volatile int64 ExitFlag = 0;
     volatile int64 JobLabel = 0;
-    Dictionary<int64, JobContext> JobContexts;
+    volatile int64 ThreadsAffinityMask = 0;
+    volatile int64 WaitTime = 0; // In microseconds
+    volatile int64 WaitsCount = 0;
+    Dictionary<int64, int32> JobContexts;
+    JobContext Contexts[JOB_SYSTEM_MAX_CONTEXTS];
+    int32 ContextsFree[JOB_SYSTEM_MAX_CONTEXTS];
+    int32 ContextsFreeCount = 0;
     ConditionVariable JobsSignal;
     CriticalSection JobsMutex;
     ConditionVariable WaitSignal;
     CriticalSection WaitMutex;
     CriticalSection JobsLocker;
-#if JOB_SYSTEM_USE_MUTEX
     RingBuffer<JobData, InlinedAllocation<256>> Jobs;
-#else
-    ConcurrentQueue<JobData> Jobs;
-#endif
 #if JOB_SYSTEM_USE_STATS
     int64 DequeueCount = 0;
     int64 DequeueSum = 0;
@@ -120,12 +212,19 @@ namespace
 
 bool JobSystemService::Init()
 {
+    for (int32 i = 0; i < JOB_SYSTEM_MAX_CONTEXTS; i++)
+        ContextsFree[i] = JOB_SYSTEM_MAX_CONTEXTS - i - 1;
+    ContextsFreeCount = JOB_SYSTEM_MAX_CONTEXTS;
     ThreadsCount = Math::Min<int32>(Platform::GetCPUInfo().LogicalProcessorCount, ARRAY_COUNT(Threads));
     for (int32 i = 0; i < ThreadsCount; i++)
     {
         auto runnable = New<JobSystemThread>();
         runnable->Index = (uint64)i;
-        auto thread = Thread::Create(runnable, String::Format(TEXT("Job System {0}"), i), ThreadPriority::AboveNormal);
+        ThreadsRunnables[i] = runnable;
+    }
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        auto thread = Thread::Create(ThreadsRunnables[i], String::Format(TEXT("Job System {0}"), i), ThreadPriority::AboveNormal);
         if (thread == nullptr)
             return true;
         Threads[i] = thread;
@@ -154,86 +253,227 @@ void JobSystemService::Dispose()
             Delete(Threads[i]);
             Threads[i] = nullptr;
         }
+        if (ThreadsRunnables[i])
+        {
+            Delete(ThreadsRunnables[i]);
+            ThreadsRunnables[i] = nullptr;
+        }
+    }
+}
+
+// Adds dispatch jobs to the execution queues (job threads use own queue, others use global queue). Called within JobsLocker.
+void EnqueueJobs(int32 slot, int32 jobCount)
+{
+    JobContext& context = Contexts[slot];
+    const JobData data = PackJob(slot, context.Generation);
+    Platform::AtomicStore(&context.State, (int64)context.Generation << 32);
+    int32 index = 0;
+    if (ThisThread)
+    {
+        while (index < jobCount && ThisThread->Queue.Push(data))
+            index++;
     }
+    for (; index < jobCount; index++)
+        Jobs.PushBack(data);
+}
+
+bool JobSystemThread::TryGetJob(JobData& data)
+{
+    // Local queue
+    if (Queue.Pop(data))
+        return true;
+
+    // Global queue (take a batch of jobs to reduce lock contention, others can steal them from this thread)
+    if (Jobs.Count() != 0)
+    {
+        bool result = false;
+        JobsLocker.Lock();
+        int32 count = Jobs.Count();
+        if (count != 0)
+        {
+            data = Jobs.PeekFront();
+            Jobs.PopFront();
+            result = true;
+            count = Math::Min(count / ThreadsCount, JOB_SYSTEM_INJECTOR_BATCH);
+            for (int32 i = 0; i < count && Queue.Push(Jobs.PeekFront()); i++)
+                Jobs.PopFront();
+        }
+        JobsLocker.Unlock();
+        if (result)
+        {
+            if (count > 0)
+                JobsSignal.NotifyOne();
+            return true;
+        }
+    }
+
+    // Steal from other threads
+    for (int32 i = 1; i < ThreadsCount; i++)
+    {
+        JobSystemThread* victim = ThreadsRunnables[(Index + i) % ThreadsCount];
+        if (victim && victim->Queue.Steal(data))
+        {
+            Stats.OnSteal();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SetJobThreadAffinity(uint64 index, uint64 mask)
+{
+    // Pick a single processor from the mask for the thread
+    if (mask == 0)
+        mask = Platform::GetCPUInfo().GetAllProcessorsMask();
+    int32 processorsCount = 0;
+    for (int32 i = 0; i < 64; i++)
+        processorsCount += (mask >> i) & 1;
+    int32 processor = (int32)(index % processorsCount);
+    for (int32 i = 0; i < 64; i++)
+    {
+        if ((mask >> i) & 1)
+        {
+            if (processor-- == 0)
+            {
+                Platform::SetThreadAffinityMask(1ull << i);
+                break;
+            }
+        }
+    }
+}
+
+void RunJob(JobContext& context, int32 slot, int32 index)
+{
+    context.Job(index);
+
+    // Move forward with the job queue
+    if (Platform::InterlockedDecrement(&context.JobsLeft) <= 0)
+    {
+        ASSERT_LOW_LAYER(context.JobsLeft <= 0);
+        context.Job.Unbind();
+        int32 jobsStarted = 0;
+        JobsLocker.Lock();
+        JobContexts.Remove(context.Label);
+        for (const int32 dependantSlot : context.Dependants)
+        {
+            // Schedule dependant jobs that have all dependencies completed
+            JobContext& dependant = Contexts[dependantSlot];
+            if (--dependant.DependenciesLeft <= 0)
+            {
+                EnqueueJobs(dependantSlot, dependant.JobsCount);
+                jobsStarted += dependant.JobsCount;
+            }
+        }
+        context.Dependants.Clear();
+        ContextsFree[ContextsFreeCount++] = slot;
+        JobsLocker.Unlock();
+
+        if (jobsStarted == 1)
+            JobsSignal.NotifyOne();
+        else if (jobsStarted != 0)
+            JobsSignal.NotifyAll();
+        WaitSignal.NotifyAll();
+    }
+}
+
+bool RunJob(const JobData& data)
+{
+    int32 slot, index;
+    uint32 generation;
+    UnpackJob(data, slot, generation);
+    JobContext& context = Contexts[slot];
+    if (!context.ClaimJob(generation, index))
+        return false;
+    RunJob(context, slot, index);
+    return true;
 }
 
 int32 JobSystemThread::Run()
 {
-    Platform::SetThreadAffinityMask(1ull << Index);
+    int64 affinityMask = Platform::AtomicRead(&ThreadsAffinityMask);
+    SetJobThreadAffinity(Index, (uint64)affinityMask);
+    ThisThread = this;
 
     JobData data;
     bool attachMonoThread = true;
-#if !JOB_SYSTEM_USE_MUTEX
-    moodycamel::ConsumerToken consumerToken(Jobs);
-#endif
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
+        // Update the thread affinity if it has been changed
+        if (Platform::AtomicRead(&ThreadsAffinityMask) != affinityMask)
+        {
+            affinityMask = Platform::AtomicRead(&ThreadsAffinityMask);
+            SetJobThreadAffinity(Index, (uint64)affinityMask);
+        }
+
         // Try to get a job
 #if JOB_SYSTEM_USE_STATS
         const auto start = Platform::GetTimeCycles();
 #endif
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        if (Jobs.Count() != 0)
-        {
-            data = Jobs.PeekFront();
-            Jobs.PopFront();
-        }
-        JobsLocker.Unlock();
-#else
-        if (!Jobs.try_dequeue(consumerToken, data))
-            data.Job.Unbind();
-#endif
+        const bool hasJob = TryGetJob(data);
 #if JOB_SYSTEM_USE_STATS
         Platform::InterlockedIncrement(&DequeueCount);
         Platform::InterlockedAdd(&DequeueSum, Platform::GetTimeCycles() - start);
 #endif
 
-        if (data.Job.IsBinded())
+        if (hasJob)
         {
 #if USE_MONO
             // Ensure to have C# thread attached to this thead (late init due to MCore being initialized after Job System)
+            // Skip it until the domain gets created (engine services initialized in parallel run jobs before Scripting)
             if (attachMonoThread && !mono_domain_get())
             {
                 const auto domain = MCore::GetActiveDomain();
-                mono_thread_attach(domain->GetNative());
-                attachMonoThread = false;
+                if (domain)
+                {
+                    mono_thread_attach(domain->GetNative());
+                    attachMonoThread = false;
+                }
             }
 #endif
 
             // Run job
-            data.Job(data.Index);
-
-            // Move forward with the job queue
-            JobsLocker.Lock();
-            JobContext& context = JobContexts.At(data.JobKey);
-            if (Platform::InterlockedDecrement(&context.JobsLeft) <= 0)
-            {
-                ASSERT_LOW_LAYER(context.JobsLeft <= 0);
-                JobContexts.Remove(data.JobKey);
-            }
-            JobsLocker.Unlock();
-
-            WaitSignal.NotifyAll();
-
-            data.Job.Unbind();
+            const double startTime = Platform::GetTimeSeconds();
+            if (RunJob(data))
+                Stats.OnJob(startTime, Platform::GetTimeSeconds());
         }
         else
         {
             // Wait for signal
+            const double startTime = Platform::GetTimeSeconds();
             JobsMutex.Lock();
             JobsSignal.Wait(JobsMutex);
             JobsMutex.Unlock();
+            Stats.OnIdle(startTime, Platform::GetTimeSeconds());
         }
     }
+    ThisThread = nullptr;
     return 0;
 }
 
+int32 GetJobsCount()
+{
+    JobsLocker.Lock();
+    int32 count = Jobs.Count();
+    JobsLocker.Unlock();
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        if (ThreadsRunnables[i])
+            count += ThreadsRunnables[i]->Queue.Count();
+    }
+    return count;
+}
+
+FORCE_INLINE void OnWaitEnd(double startTime)
+{
+    Platform::InterlockedAdd(&WaitTime, (int64)((Platform::GetTimeSeconds() - startTime) * 1000000.0));
+    Platform::InterlockedIncrement(&WaitsCount);
+}
+
 #endif
 
 void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
 {
-    // TODO: disable async if called on job thread? or maybe Wait should handle waiting in job thread to do the processing?
     if (jobCount > 1)
     {
         // Async
@@ -249,6 +489,11 @@ void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
 }
 
 int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
+{
+    return Dispatch(job, Span<int64>(), jobCount);
+}
+
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, const Span<int64>& dependencies, int32 jobCount)
 {
     PROFILE_CPU();
     if (jobCount <= 0)
@@ -259,32 +504,62 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 #endif
     const auto label = Platform::InterlockedAdd(&JobLabel, (int64)jobCount) + jobCount;
 
-    JobData data;
-    data.Job = job;
-    data.JobKey = label;
-
-    JobContext context;
+    // Allocate the dispatch context
+    int32 slot;
+    JobsLocker.Lock();
+    while (ContextsFreeCount == 0)
+    {
+        // Too many dispatches in-flight so wait for any to finish (contexts are released when the last job of the dispatch completes)
+        JobsLocker.Unlock();
+        JobData data;
+        if (ThisThread && ThisThread->TryGetJob(data))
+        {
+            // Job thread helps with the queued jobs instead of waiting (all job threads could be stuck in dispatch otherwise)
+            RunJob(data);
+        }
+        else
+        {
+            // Sleep until any dispatch completes (timeout covers the completion signaled between the check and the wait)
+            JobsSignal.NotifyAll();
+            WaitMutex.Lock();
+            WaitSignal.Wait(WaitMutex, 1);
+            WaitMutex.Unlock();
+        }
+        JobsLocker.Lock();
+    }
+    slot = ContextsFree[--ContextsFreeCount];
+    JobContext& context = Contexts[slot];
+    context.Generation++;
+    Platform::AtomicStore(&context.State, ((int64)context.Generation << 32) | (int64)jobCount); // Nothing to claim until jobs are enqueued
+    context.Job = job;
     context.JobsLeft = jobCount;
+    context.Label = label;
+    context.JobsCount = jobCount;
+    context.DependenciesLeft = 0;
+    JobContexts.Add(label, slot);
 
-#if JOB_SYSTEM_USE_MUTEX
-    JobsLocker.Lock();
-    JobContexts.Add(label, context);
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.PushBack(data);
-    JobsLocker.Unlock();
-#else
-    JobsLocker.Lock();
-    JobContexts.Add(label, context);
+    // Link to the dependencies that are still in-flight (completed ones are already removed from the contexts)
+    for (int32 i = 0; i < dependencies.Length(); i++)
+    {
+        const int32* dependencySlot = JobContexts.TryGet(dependencies[i]);
+        if (dependencySlot && *dependencySlot != slot)
+        {
+            Contexts[*dependencySlot].Dependants.Add(slot);
+            context.DependenciesLeft++;
+        }
+    }
+
+    // Enqueue jobs (unless waiting for dependencies, last dependency job will enqueue them)
+    const bool canStart = context.DependenciesLeft == 0;
+    if (canStart)
+        EnqueueJobs(slot, jobCount);
     JobsLocker.Unlock();
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.enqueue(data);
-#endif
 
 #if JOB_SYSTEM_USE_STATS
     LOG(Info, "Job enqueue time: {0} cycles", (int64)(Platform::GetTimeCycles() - start));
 #endif
 
-    if (JobStartingOnDispatch)
+    if (JobStartingOnDispatch && canStart)
     {
         if (jobCount == 1)
             JobsSignal.NotifyOne();
@@ -303,6 +578,7 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 void JobSystem::Wait()
 {
 #if JOB_SYSTEM_ENABLED
+    const double startTime = Platform::GetTimeSeconds();
     JobsLocker.Lock();
     int32 numJobs = JobContexts.Count();
     JobsLocker.Unlock();
@@ -317,6 +593,7 @@ void JobSystem::Wait()
         numJobs = JobContexts.Count();
         JobsLocker.Unlock();
     }
+    OnWaitEnd(startTime);
 #endif
 }
 
@@ -324,17 +601,35 @@ void JobSystem::Wait(int64 label)
 {
 #if JOB_SYSTEM_ENABLED
     PROFILE_CPU();
+    const double startTime = Platform::GetTimeSeconds();
 
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
         JobsLocker.Lock();
-        const JobContext* context = JobContexts.TryGet(label);
+        const int32* slotPtr = JobContexts.TryGet(label);
+        const int32 slot = slotPtr ? *slotPtr : -1;
+        const uint32 generation = slotPtr ? Contexts[slot].Generation : 0;
         JobsLocker.Unlock();
 
         // Skip if context has been already executed (last job removes it)
-        if (!context)
+        if (slot == -1)
             break;
 
+        // Job threads execute the jobs of the awaited dispatch while waiting (prevents deadlocks when all threads wait for the nested dispatches).
+        // Other queued jobs are not executed here as they could re-enter locks held by the waiting job or take much longer than the awaited work.
+        if (ThisThread)
+        {
+            JobContext& context = Contexts[slot];
+            int32 index;
+            if (context.ClaimJob(generation, index))
+            {
+                // Nested job time is already included in the busy time of the waiting job
+                RunJob(context, slot, index);
+                Platform::InterlockedIncrement(&ThisThread->Stats.JobsCount);
+                continue;
+            }
+        }
+
         // Wait on signal until input label is not yet done
         WaitMutex.Lock();
         WaitSignal.Wait(WaitMutex, 1);
@@ -343,6 +638,7 @@ void JobSystem::Wait(int64 label)
         // Wake up any thread to prevent stalling in highly multi-threaded environment
         JobsSignal.NotifyOne();
     }
+    OnWaitEnd(startTime);
 
 #if JOB_SYSTEM_USE_STATS
     LOG(Info, "Job average dequeue time: {0} cycles", DequeueSum / DequeueCount);
@@ -358,13 +654,7 @@ void JobSystem::SetJobStartingOnDispatch(bool value)
 
     if (value)
     {
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        const int32 count = Jobs.Count();
-        JobsLocker.Unlock();
-#else
-        const int32 count = Jobs.Count();
-#endif
+        const int32 count = GetJobsCount();
         if (count == 1)
             JobsSignal.NotifyOne();
         else if (count != 0)
@@ -381,3 +671,54 @@ int32 JobSystem::GetThreadsCount()
     return 0;
 #endif
 }
+
+void JobSystem::SetThreadsAffinityMask(uint64 affinityMask)
+{
+#if JOB_SYSTEM_ENABLED
+    Platform::AtomicStore(&ThreadsAffinityMask, (int64)affinityMask);
+    JobsSignal.NotifyAll();
+#endif
+}
+
+void JobSystem::GetThreadsStats(Array<WorkerStats>& result, bool reset)
+{
+    result.Clear();
+#if JOB_SYSTEM_ENABLED
+    result.Resize(ThreadsCount);
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        if (ThreadsRunnables[i])
+            ThreadsRunnables[i]->Stats.Get(result[i], reset);
+        else
+            Platform::MemoryClear(&result[i], sizeof(WorkerStats));
+    }
+#endif
+}
+
+void JobSystem::GetWaitStats(double& waitTime, int32& waitsCount, bool reset)
+{
+#if JOB_SYSTEM_ENABLED
+    if (reset)
+    {
+        waitTime = (double)Platform::InterlockedExchange(&WaitTime, 0) / 1000000.0;
+        waitsCount = (int32)Platform::InterlockedExchange(&WaitsCount, 0);
+    }
+    else
+    {
+        waitTime = (double)Platform::AtomicRead(&WaitTime) / 1000000.0;
+        waitsCount = (int32)Platform::AtomicRead(&WaitsCount);
+    }
+#else
+    waitTime = 0.0;
+    waitsCount = 0;
+#endif
+}
+
+int32 JobSystem::GetQueueSize()
+{
+#if JOB_SYSTEM_ENABLED
+    return GetJobsCount();
+#else
+    return 0;
+#endif
+}
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "Engine/Core/Delegate.h"
+#include "Engine/Core/Types/Span.h"
+
+struct WorkerStats;
 
 /// <summary>
 /// Lightweight multi-threaded jobs execution scheduler. Uses a pool of threads and supports work-stealing concept.
@@ -26,13 +29,22 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// <returns>The label identifying this dispatch. Can be used to wait for the execution end.</returns>
     API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1);
 
+    /// <summary>
+    /// Dispatches the job for the execution after all the given dependencies complete. Doesn't block any thread - jobs are scheduled by the last finished dependency.
+    /// </summary>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="dependencies">The labels of the dispatches (returned by Dispatch) that have to finish before starting this job. Labels of already completed jobs are ignored.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    /// <returns>The label identifying this dispatch. Can be used to wait for the execution end or as a dependency for other dispatches.</returns>
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, const Span<int64>& dependencies, int32 jobCount = 1);
+
     /// <summary>
     /// Waits for all dispatched jobs to finish.
     /// </summary>
     API_FUNCTION() static void Wait();
 
     /// <summary>
-    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label).
+    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label). When called from the job thread, the jobs of the awaited dispatch are executed while waiting so jobs can safely dispatch and wait for the nested jobs (other queued jobs are not executed by the waiting thread).
     /// </summary>
     /// <param name="label">The label.</param>
     API_FUNCTION() static void Wait(int64 label);
@@ -46,4 +58,29 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// Gets the amount of job system threads.
     /// </summary>
     API_PROPERTY() static int32 GetThreadsCount();
+
+    /// <summary>
+    /// Sets the processors affinity mask used by the job system threads (each thread uses a single processor from the mask). Use 0 to use all processors.
+    /// </summary>
+    static void SetThreadsAffinityMask(uint64 affinityMask);
+
+    /// <summary>
+    /// Gets the activity stats of the job system threads.
+    /// </summary>
+    /// <param name="result">The output stats (one per thread).</param>
+    /// <param name="reset">True if reset the counters after reading (eg. to gather stats per frame), otherwise false.</param>
+    static void GetThreadsStats(Array<WorkerStats, HeapAllocation>& result, bool reset = false);
+
+    /// <summary>
+    /// Gets the stats of the threads waiting for the jobs to finish (see Wait).
+    /// </summary>
+    /// <param name="waitTime">The total time spent inside Wait calls (in seconds).</param>
+    /// <param name="waitsCount">The amount of Wait calls.</param>
+    /// <param name="reset">True if reset the counters after reading, otherwise false.</param>
+    static void GetWaitStats(double& waitTime, int32& waitsCount, bool reset = false);
+
+    /// <summary>
+    /// Gets the amount of the jobs waiting in the queues for the execution.
+    /// </summary>
+    static int32 GetQueueSize();
 };
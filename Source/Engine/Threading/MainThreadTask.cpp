@@ -1,20 +1,42 @@
 // Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
 
 #include "MainThreadTask.h"
-#include "Engine/Platform/CriticalSection.h"
+#include "ConcurrentTaskQueue.h"
+#include "Engine/Platform/Platform.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
 namespace
 {
-    CriticalSection Locker;
+    // Tasks enqueued from any thread (lock-free, consumed only by the main thread)
+    ConcurrentTaskQueue<MainThreadTask> Pending;
+
+    // Main thread only
     Array<MainThreadTask*> Waiting;
     Array<MainThreadTask*> Queue;
 }
 
+float MainThreadTask::TimeBudget = 0.0f;
+
 void MainThreadTask::RunAll(float dt)
 {
     PROFILE_CPU();
-    Locker.Lock();
+
+    // Collect the new tasks
+    MainThreadTask* tasks[64];
+    std::size_t count;
+    while ((count = Pending.try_dequeue_bulk(tasks, ARRAY_COUNT(tasks))) != 0)
+    {
+        for (std::size_t i = 0; i != count; i++)
+        {
+            auto task = tasks[i];
+            if (task->InitialDelay <= ZeroTolerance)
+                Queue.Add(task);
+            else
+                Waiting.Add(task);
+        }
+    }
+
+    // Update the delayed tasks
     for (int32 i = Waiting.Count() - 1; i >= 0; i--)
     {
         auto task = Waiting[i];
@@ -25,12 +47,20 @@ void MainThreadTask::RunAll(float dt)
             Queue.Add(task);
         }
     }
-    for (int32 i = 0; i < Queue.Count(); i++)
+
+    // Execute tasks in order, the ones exceeding the time budget are left for the next frame (at least one task runs every frame)
+    const double endTime = TimeBudget > 0.0f ? Platform::GetTimeSeconds() + TimeBudget * 0.001 : 0.0;
+    int32 executed = 0;
+    while (executed < Queue.Count())
     {
-        Queue[i]->Execute();
+        Queue[executed++]->Execute();
+        if (endTime > 0.0 && Platform::GetTimeSeconds() >= endTime)
+            break;
     }
-    Queue.Clear();
-    Locker.Unlock();
+    const int32 left = Queue.Count() - executed;
+    for (int32 i = 0; i < left; i++)
+        Queue[i] = Queue[executed + i];
+    Queue.Resize(left);
 }
 
 String MainThreadTask::ToString() const
@@ -40,12 +70,7 @@ String MainThreadTask::ToString() const
 
 void MainThreadTask::Enqueue()
 {
-    Locker.Lock();
-    if (InitialDelay <= ZeroTolerance)
-        Queue.Add(this);
-    else
-        Waiting.Add(this);
-    Locker.Unlock();
+    Pending.Add(this);
 }
 
 bool MainThreadActionTask::Run()
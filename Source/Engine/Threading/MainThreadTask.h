@@ -28,6 +28,12 @@ class FLAXENGINE_API MainThreadTask : public Task
 private:
     static void RunAll(float dt);
 
+public:
+    /// <summary>
+    /// The maximum time (in milliseconds) spent on executing main thread tasks per frame. Remaining tasks are executed in the next frames. Use 0 to execute all queued tasks every frame.
+    /// </summary>
+    static float TimeBudget;
+
 public:
 
     /// <summary>
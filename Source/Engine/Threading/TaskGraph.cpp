@@ -65,6 +65,7 @@ void TaskGraph::Execute()
     _queue.Clear();
     _remaining.Clear();
     _remaining.Add(_systems);
+    _labels.Clear();
 
     while (_remaining.HasItems())
     {
@@ -94,22 +95,35 @@ void TaskGraph::Execute()
 
         // Execute in order
         Sorting::QuickSort(_queue.Get(), _queue.Count(), &SortTaskGraphSystem);
-        JobSystem::SetJobStartingOnDispatch(false);
-        _labels.Clear();
         for (int32 i = 0; i < _queue.Count(); i++)
         {
             _currentSystem = _queue[i];
+            _currentSystem->_labelsStart = _labels.Count();
             _currentSystem->Execute(this);
+            if (_labels.Count() == _currentSystem->_labelsStart)
+            {
+                // System without jobs forwards the jobs of its dependencies to the dependant systems (keeps the ordering transitive)
+                for (auto d : _currentSystem->_dependencies)
+                {
+                    if (!_systems.Contains(d))
+                        continue;
+                    for (int32 j = d->_labelsStart; j < d->_labelsEnd; j++)
+                    {
+                        const int64 label = _labels[j];
+                        _labels.Add(label);
+                    }
+                }
+            }
+            _currentSystem->_labelsEnd = _labels.Count();
         }
         _currentSystem = nullptr;
         _queue.Clear();
-
-        // Wait for async jobs to finish
-        JobSystem::SetJobStartingOnDispatch(true);
-        for (const int64 label : _labels)
-            JobSystem::Wait(label);
     }
 
+    // Wait for async jobs to finish
+    for (const int64 label : _labels)
+        JobSystem::Wait(label);
+
     for (auto system : _systems)
         system->PostExecute(this);
 }
@@ -117,6 +131,16 @@ void TaskGraph::Execute()
 void TaskGraph::DispatchJob(const Function<void(int32)>& job, int32 jobCount)
 {
     ASSERT(_currentSystem);
-    const int64 label = JobSystem::Dispatch(job, jobCount);
+
+    // Start the job after the jobs of the system dependencies (without blocking the main thread)
+    Array<int64, InlinedAllocation<64>> dependencies;
+    for (auto d : _currentSystem->_dependencies)
+    {
+        if (!_systems.Contains(d))
+            continue;
+        for (int32 j = d->_labelsStart; j < d->_labelsEnd; j++)
+            dependencies.Add(_labels[j]);
+    }
+    const int64 label = JobSystem::Dispatch(job, ToSpan(dependencies.Get(), dependencies.Count()), jobCount);
     _labels.Add(label);
 }
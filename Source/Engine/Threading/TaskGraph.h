@@ -16,6 +16,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     friend TaskGraph;
 private:
     Array<TaskGraphSystem*, InlinedAllocation<16>> _dependencies;
+    int32 _labelsStart = 0, _labelsEnd = 0;
 
 public:
     /// <summary>
@@ -27,6 +28,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     /// <summary>
     /// Adds the dependency on the system execution. Before this system can be executed the given dependant system has to be executed first.
     /// </summary>
+    /// <remarks>Execute of this system is called after Execute of the dependency system and the jobs dispatched by this system start after all the jobs of the dependency system are done (jobs of the systems without dependencies between each other run at the same time).</remarks>
     /// <param name="system">The system to depend on.</param>
     API_FUNCTION() void AddDependency(TaskGraphSystem* system);
 
@@ -39,6 +41,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     /// <summary>
     /// Executes the system logic and schedules the asynchronous work.
     /// </summary>
+    /// <remarks>Called on the main thread after Execute of the dependency systems, while their jobs can be still running. Use TaskGraph::DispatchJob for the work that uses their results (these jobs start after the jobs of the dependency systems are done).</remarks>
     /// <param name="graph">The graph executing the system.</param>
     API_FUNCTION() virtual void Execute(TaskGraph* graph);
 
@@ -88,7 +91,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraph);
     /// <summary>
     /// Dispatches the job for the execution.
     /// </summary>
-    /// <remarks>Call only from system's Execute method to properly schedule job.</remarks>
+    /// <remarks>Call only from system's Execute method to properly schedule job. The job starts after all the jobs dispatched by the dependency systems are done.</remarks>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
     API_FUNCTION() void DispatchJob(const Function<void(int32)>& job, int32 jobCount = 1);
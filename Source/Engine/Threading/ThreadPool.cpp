@@ -5,6 +5,7 @@
 #include "Threading.h"
 #include "ThreadPoolTask.h"
 #include "ConcurrentTaskQueue.h"
+#include "WorkerStats.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Core/Types/String.h"
@@ -19,11 +20,26 @@ FLAXENGINE_API bool IsInMainThread()
     return Globals::MainThreadID == Platform::GetCurrentThreadID();
 }
 
+FLAXENGINE_API bool IsInRenderThread()
+{
+    return Globals::RenderThreadID == Platform::GetCurrentThreadID();
+}
+
+// Task queue state (used to skip canceled tasks that are still in the queue without using them after deletion)
+#define TASK_QUEUE_STATE_NONE 0
+#define TASK_QUEUE_STATE_QUEUED 1
+#define TASK_QUEUE_STATE_ENDED 2
+
 namespace ThreadPoolImpl
 {
     volatile int64 ExitFlag = 0;
     Array<Thread*> Threads;
-    ConcurrentTaskQueue<ThreadPoolTask> Jobs; // Hello Steve!
+    ConcurrentTaskQueue<ThreadPoolTask> Jobs[(int32)ThreadPoolTaskPriority::MAX]; // Hello Steve!
+    volatile int64 RunningJobs[(int32)ThreadPoolTaskPriority::MAX] = {};
+    int64 MaxRunningJobs[(int32)ThreadPoolTaskPriority::MAX] = {};
+    volatile int64 ThreadsAffinityMask = 0;
+    volatile int64 ThreadsStarted = 0;
+    WorkerCounters ThreadsStats[PLATFORM_THREADS_LIMIT];
     ConditionVariable JobsSignal;
     CriticalSection JobsMutex;
 }
@@ -35,10 +51,20 @@ String ThreadPoolTask::ToString() const
 
 void ThreadPoolTask::Enqueue()
 {
-    ThreadPoolImpl::Jobs.Add(this);
+    Platform::AtomicStore(&_queueState, TASK_QUEUE_STATE_QUEUED);
+    ThreadPoolImpl::Jobs[(int32)_priority].Add(this);
     ThreadPoolImpl::JobsSignal.NotifyOne();
 }
 
+void ThreadPoolTask::OnEnd()
+{
+    // Task canceled while waiting in a queue is deleted by the worker that removes it from the queue (without waking up any worker)
+    if (Platform::InterlockedCompareExchange(&_queueState, TASK_QUEUE_STATE_ENDED, TASK_QUEUE_STATE_QUEUED) == TASK_QUEUE_STATE_QUEUED)
+        return;
+
+    Task::OnEnd();
+}
+
 class ThreadPoolService : public EngineService
 {
 public:
@@ -76,6 +102,11 @@ bool ThreadPoolService::Init()
         ThreadPoolImpl::Threads.Add(thread);
     }
 
+    // Reserve workers for higher priority tasks
+    ThreadPoolImpl::MaxRunningJobs[(int32)ThreadPoolTaskPriority::Critical] = numThreads;
+    ThreadPoolImpl::MaxRunningJobs[(int32)ThreadPoolTaskPriority::Normal] = Math::Max(numThreads - 1, 1);
+    ThreadPoolImpl::MaxRunningJobs[(int32)ThreadPoolTaskPriority::Background] = Math::Max(numThreads / 2, 1);
+
     return false;
 }
 
@@ -104,25 +135,121 @@ void ThreadPoolService::Dispose()
         }
     }
     ThreadPoolImpl::Threads.ClearDelete();
+
+    // Release tasks left in the queues
+    ThreadPool::ReleaseQueuedJobs();
+}
+
+void ThreadPool::SetThreadsAffinityMask(uint64 affinityMask)
+{
+    Platform::AtomicStore(&ThreadPoolImpl::ThreadsAffinityMask, (int64)affinityMask);
+    ThreadPoolImpl::JobsSignal.NotifyAll();
+}
+
+void ThreadPool::GetThreadsStats(Array<WorkerStats>& result, bool reset)
+{
+    using namespace ThreadPoolImpl;
+    const int32 count = Math::Min((int32)Platform::AtomicRead(&ThreadsStarted), PLATFORM_THREADS_LIMIT);
+    result.Resize(count);
+    for (int32 i = 0; i < count; i++)
+        ThreadsStats[i].Get(result[i], reset);
+}
+
+int32 ThreadPool::GetQueueSize()
+{
+    using namespace ThreadPoolImpl;
+    int32 count = 0;
+    for (int32 lane = 0; lane < (int32)ThreadPoolTaskPriority::MAX; lane++)
+        count += (int32)Jobs[lane].size_approx();
+    return count;
+}
+
+bool ThreadPool::TryGetJob(ThreadPoolTask*& task, int32& lane)
+{
+    using namespace ThreadPoolImpl;
+    for (lane = 0; lane < (int32)ThreadPoolTaskPriority::MAX; lane++)
+    {
+        auto& jobs = Jobs[lane];
+        while (jobs.size_approx() != 0)
+        {
+            // Skip if all workers that can run this priority class are busy
+            if (Platform::InterlockedIncrement(&RunningJobs[lane]) > MaxRunningJobs[lane])
+            {
+                Platform::InterlockedDecrement(&RunningJobs[lane]);
+                break;
+            }
+            if (!jobs.try_dequeue(task))
+            {
+                Platform::InterlockedDecrement(&RunningJobs[lane]);
+                break;
+            }
+            if (Platform::InterlockedExchange(&task->_queueState, TASK_QUEUE_STATE_NONE) != TASK_QUEUE_STATE_ENDED)
+                return true;
+
+            // Task has been canceled before running so just release it
+            Platform::InterlockedDecrement(&RunningJobs[lane]);
+            task->DeleteObject(30.0f, false);
+        }
+    }
+    return false;
+}
+
+void ThreadPool::ReleaseQueuedJobs()
+{
+    using namespace ThreadPoolImpl;
+    ThreadPoolTask* task;
+    for (int32 lane = 0; lane < (int32)ThreadPoolTaskPriority::MAX; lane++)
+    {
+        while (Jobs[lane].try_dequeue(task))
+        {
+            if (Platform::InterlockedExchange(&task->_queueState, TASK_QUEUE_STATE_NONE) == TASK_QUEUE_STATE_ENDED)
+            {
+                // Task has been canceled before running so just release it (deleted by the objects removal service dispose)
+                task->DeleteObject(30.0f, false);
+            }
+            else
+            {
+                // Task will never run so cancel it (ends and gets deleted)
+                task->Cancel();
+            }
+        }
+    }
 }
 
 int32 ThreadPool::ThreadProc()
 {
     ThreadPoolTask* task;
+    int32 lane;
+    int64 affinityMask = 0;
+    const int32 index = (int32)Platform::InterlockedIncrement(&ThreadPoolImpl::ThreadsStarted) - 1;
+    WorkerCounters dummyStats;
+    WorkerCounters& stats = index < PLATFORM_THREADS_LIMIT ? ThreadPoolImpl::ThreadsStats[index] : dummyStats;
 
     // Work until end
     while (Platform::AtomicRead(&ThreadPoolImpl::ExitFlag) == 0)
     {
+        // Update the thread affinity if it has been changed
+        if (Platform::AtomicRead(&ThreadPoolImpl::ThreadsAffinityMask) != affinityMask)
+        {
+            affinityMask = Platform::AtomicRead(&ThreadPoolImpl::ThreadsAffinityMask);
+            Platform::SetThreadAffinityMask(affinityMask != 0 ? (uint64)affinityMask : Platform::GetCPUInfo().GetAllProcessorsMask());
+        }
+
         // Try to get a job
-        if (ThreadPoolImpl::Jobs.try_dequeue(task))
+        if (TryGetJob(task, lane))
         {
+            const double startTime = Platform::GetTimeSeconds();
             task->Execute();
+            stats.OnJob(startTime, Platform::GetTimeSeconds());
+            Platform::InterlockedDecrement(&ThreadPoolImpl::RunningJobs[lane]);
         }
         else
         {
+            const double startTime = Platform::GetTimeSeconds();
             ThreadPoolImpl::JobsMutex.Lock();
             ThreadPoolImpl::JobsSignal.Wait(ThreadPoolImpl::JobsMutex);
             ThreadPoolImpl::JobsMutex.Unlock();
+            stats.OnIdle(startTime, Platform::GetTimeSeconds());
         }
     }
 
@@ -4,6 +4,9 @@
 
 #include "Engine/Core/Types/BaseTypes.h"
 
+class ThreadPoolTask;
+struct WorkerStats;
+
 /// <summary>
 /// Main engine thread pool for threaded tasks system.
 /// </summary>
@@ -11,7 +14,28 @@ class ThreadPool
 {
     friend class ThreadPoolTask;
     friend class ThreadPoolService;
+public:
+
+    /// <summary>
+    /// Sets the processors affinity mask used by the thread pool threads. Use 0 to use all processors.
+    /// </summary>
+    static void SetThreadsAffinityMask(uint64 affinityMask);
+
+    /// <summary>
+    /// Gets the activity stats of the thread pool threads.
+    /// </summary>
+    /// <param name="result">The output stats (one per thread).</param>
+    /// <param name="reset">True if reset the counters after reading (eg. to gather stats per frame), otherwise false.</param>
+    static void GetThreadsStats(Array<WorkerStats, HeapAllocation>& result, bool reset = false);
+
+    /// <summary>
+    /// Gets the amount of the tasks waiting in the queues for the execution.
+    /// </summary>
+    static int32 GetQueueSize();
+
 private:
 
+    static bool TryGetJob(ThreadPoolTask*& task, int32& lane);
+    static void ReleaseQueuedJobs();
     static int32 ThreadProc();
 };
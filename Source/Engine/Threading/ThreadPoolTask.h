@@ -6,6 +6,21 @@
 
 class ThreadPool;
 
+/// <summary>
+/// The Thread Pool tasks priority classes. Each class uses a separate queue and the higher priority tasks are always picked first.
+/// </summary>
+enum class ThreadPoolTaskPriority
+{
+    // Latency-sensitive work (eg. audio streaming). Can use all the workers.
+    Critical = 0,
+    // General-purpose and content streaming work. Can use all the workers except one that is reserved for critical tasks.
+    Normal = 1,
+    // Low-priority background work (eg. navmesh building). Can use up to half of the workers.
+    Background = 2,
+
+    MAX
+};
+
 /// <summary>
 /// General purpose task executed using Thread Pool.
 /// </summary>
@@ -14,14 +29,41 @@ class ThreadPoolTask : public Task
 {
     friend ThreadPool;
 
+private:
+
+    ThreadPoolTaskPriority _priority;
+    volatile int64 _queueState = 0;
+
 protected:
 
     /// <summary>
     /// Initializes a new instance of the <see cref="ThreadPoolTask"/> class.
     /// </summary>
-    ThreadPoolTask()
+    /// <param name="priority">The task priority class.</param>
+    ThreadPoolTask(ThreadPoolTaskPriority priority = ThreadPoolTaskPriority::Normal)
         : Task()
+        , _priority(priority)
+    {
+    }
+
+public:
+
+    /// <summary>
+    /// Gets the task priority class.
+    /// </summary>
+    FORCE_INLINE ThreadPoolTaskPriority GetPriority() const
+    {
+        return _priority;
+    }
+
+    /// <summary>
+    /// Sets the task priority class. Can be changed only before starting the task.
+    /// </summary>
+    /// <param name="priority">The task priority class.</param>
+    void SetPriority(ThreadPoolTaskPriority priority)
     {
+        ASSERT(GetState() == TaskState::Created);
+        _priority = priority;
     }
 
 public:
@@ -33,6 +75,7 @@ class ThreadPoolTask : public Task
 
     // [Task]
     void Enqueue() override;
+    void OnEnd() override;
 };
 
 /// <summary>
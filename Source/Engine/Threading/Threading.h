@@ -9,6 +9,11 @@
 /// </summary>
 FLAXENGINE_API bool IsInMainThread();
 
+/// <summary>
+/// Checks if current execution in on the thread that draws the frames (the main thread or the render thread if pipelined rendering is active).
+/// </summary>
+FLAXENGINE_API bool IsInRenderThread();
+
 /// <summary>
 /// Scope locker for critical section.
 /// </summary>
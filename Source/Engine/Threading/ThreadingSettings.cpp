@@ -0,0 +1,51 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "ThreadingSettings.h"
+#include "JobSystem.h"
+#include "MainThreadTask.h"
+#include "ThreadPool.h"
+#include "Engine/Content/Loading/ContentLoadingManager.h"
+#include "Engine/Platform/CPUInfo.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Serialization/Serialization.h"
+
+uint64 ThreadingSettings::GetAffinityMask(ThreadCoresClass cores) const
+{
+    const CPUInfo cpuInfo = Platform::GetCPUInfo();
+    uint64 mask = 0;
+    switch (cores)
+    {
+    case ThreadCoresClass::Performance:
+        mask = cpuInfo.PerformanceCoresMask;
+        break;
+    case ThreadCoresClass::Efficiency:
+        mask = cpuInfo.EfficiencyCoresMask != 0 ? cpuInfo.EfficiencyCoresMask : cpuInfo.PerformanceCoresMask;
+        break;
+    default:
+        break;
+    }
+    if (UsePrimaryNumaNode && cpuInfo.NumaNodeCount > 1 && cpuInfo.PrimaryNumaNodeMask != 0)
+    {
+        // Use the cores class from the primary node only (fallback to the whole node if there are no such cores)
+        const uint64 nodeMask = mask & cpuInfo.PrimaryNumaNodeMask;
+        mask = nodeMask != 0 ? nodeMask : cpuInfo.PrimaryNumaNodeMask;
+    }
+    return mask;
+}
+
+void ThreadingSettings::Apply()
+{
+    JobSystem::SetThreadsAffinityMask(GetAffinityMask(JobSystemCores));
+    ThreadPool::SetThreadsAffinityMask(GetAffinityMask(ThreadPoolCores));
+    ContentLoadingManager::SetThreadsAffinityMask(GetAffinityMask(ContentLoadingCores));
+    MainThreadTask::TimeBudget = MainThreadTasksTimeBudget;
+}
+
+void ThreadingSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
+{
+    DESERIALIZE(JobSystemCores);
+    DESERIALIZE(ThreadPoolCores);
+    DESERIALIZE(ContentLoadingCores);
+    DESERIALIZE(UsePrimaryNumaNode);
+    DESERIALIZE(MainThreadTasksTimeBudget);
+}
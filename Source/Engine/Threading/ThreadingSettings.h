@@ -0,0 +1,84 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Config/Settings.h"
+#include "Engine/Core/Types/BaseTypes.h"
+
+/// <summary>
+/// The processor cores classes that can be used to run the engine threads on.
+/// </summary>
+API_ENUM() enum class ThreadCoresClass
+{
+    /// <summary>
+    /// Threads can run on any processor core.
+    /// </summary>
+    Any = 0,
+
+    /// <summary>
+    /// Threads are restricted to the performance cores (eg. P-cores on hybrid CPUs). Uses all cores if CPU doesn't have different core types.
+    /// </summary>
+    Performance = 1,
+
+    /// <summary>
+    /// Threads are restricted to the efficiency cores (eg. E-cores on hybrid CPUs). Uses all cores if CPU doesn't have different core types.
+    /// </summary>
+    Efficiency = 2,
+};
+
+/// <summary>
+/// Threading and multi-core processing settings.
+/// </summary>
+API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class FLAXENGINE_API ThreadingSettings : public SettingsBase
+{
+DECLARE_SCRIPTING_TYPE_MINIMAL(ThreadingSettings);
+public:
+
+    /// <summary>
+    /// The processor cores used by the Job System threads (eg. animations, particles and physics jobs).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), EditorDisplay(\"Affinity\")")
+    ThreadCoresClass JobSystemCores = ThreadCoresClass::Any;
+
+    /// <summary>
+    /// The processor cores used by the Thread Pool threads (eg. streaming and background tasks).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), EditorDisplay(\"Affinity\")")
+    ThreadCoresClass ThreadPoolCores = ThreadCoresClass::Any;
+
+    /// <summary>
+    /// The processor cores used by the content loading threads.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), EditorDisplay(\"Affinity\")")
+    ThreadCoresClass ContentLoadingCores = ThreadCoresClass::Any;
+
+    /// <summary>
+    /// If checked, all the engine threads will be restricted to the processors of the primary NUMA node (the one with the main thread memory). Used only on systems with multiple NUMA nodes.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), EditorDisplay(\"Affinity\", \"Use Primary NUMA Node\")")
+    bool UsePrimaryNumaNode = false;
+
+    /// <summary>
+    /// The maximum time (in milliseconds) spent on executing main thread tasks per frame (eg. content loading and streaming completions). Remaining tasks are executed in the next frames to prevent spikes. Use 0 to disable this limit (default).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(100), Limit(0, 100, 0.1f), EditorDisplay(\"Main Thread\", \"Tasks Time Budget (ms)\")")
+    float MainThreadTasksTimeBudget = 0.0f;
+
+public:
+
+    /// <summary>
+    /// Gets the instance of the settings asset (default value if missing). Object returned by this method is always loaded with valid data to use.
+    /// </summary>
+    static ThreadingSettings* Get();
+
+    /// <summary>
+    /// Gets the processors affinity mask for threads that should run on the given cores class.
+    /// </summary>
+    /// <param name="cores">The processor cores class.</param>
+    /// <returns>The affinity mask or 0 if threads are not restricted.</returns>
+    uint64 GetAffinityMask(ThreadCoresClass cores) const;
+
+    // [SettingsBase]
+    void Apply() override;
+    void Deserialize(DeserializeStream& stream, ISerializeModifier* modifier) final override;
+};
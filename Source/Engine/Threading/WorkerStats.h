@@ -0,0 +1,89 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Platform/Platform.h"
+
+/// <summary>
+/// The activity stats of the worker thread (times are in seconds).
+/// </summary>
+struct WorkerStats
+{
+    /// <summary>
+    /// The time spent on executing the jobs.
+    /// </summary>
+    double BusyTime;
+
+    /// <summary>
+    /// The time spent on waiting for the jobs.
+    /// </summary>
+    double IdleTime;
+
+    /// <summary>
+    /// The longest single job execution time.
+    /// </summary>
+    double LongestJobTime;
+
+    /// <summary>
+    /// The amount of the executed jobs.
+    /// </summary>
+    int32 JobsCount;
+
+    /// <summary>
+    /// The amount of the jobs taken from the other threads queues.
+    /// </summary>
+    int32 StealsCount;
+};
+
+/// <summary>
+/// The lightweight worker thread activity counters. Updated by the worker thread and read (with reset) by the other threads (eg. profiler).
+/// </summary>
+struct WorkerCounters
+{
+    // Times are stored in microseconds to use atomic integer operations
+    volatile int64 BusyTime = 0;
+    volatile int64 IdleTime = 0;
+    volatile int64 LongestJobTime = 0;
+    volatile int64 JobsCount = 0;
+    volatile int64 StealsCount = 0;
+
+    FORCE_INLINE void OnJob(double startTime, double endTime)
+    {
+        const int64 time = (int64)((endTime - startTime) * 1000000.0);
+        Platform::InterlockedAdd(&BusyTime, time);
+        Platform::InterlockedIncrement(&JobsCount);
+        if (time > Platform::AtomicRead(&LongestJobTime))
+            Platform::AtomicStore(&LongestJobTime, time);
+    }
+
+    FORCE_INLINE void OnIdle(double startTime, double endTime)
+    {
+        Platform::InterlockedAdd(&IdleTime, (int64)((endTime - startTime) * 1000000.0));
+    }
+
+    FORCE_INLINE void OnSteal()
+    {
+        Platform::InterlockedIncrement(&StealsCount);
+    }
+
+    void Get(WorkerStats& result, bool reset)
+    {
+        if (reset)
+        {
+            result.BusyTime = (double)Platform::InterlockedExchange(&BusyTime, 0) / 1000000.0;
+            result.IdleTime = (double)Platform::InterlockedExchange(&IdleTime, 0) / 1000000.0;
+            result.LongestJobTime = (double)Platform::InterlockedExchange(&LongestJobTime, 0) / 1000000.0;
+            result.JobsCount = (int32)Platform::InterlockedExchange(&JobsCount, 0);
+            result.StealsCount = (int32)Platform::InterlockedExchange(&StealsCount, 0);
+        }
+        else
+        {
+            result.BusyTime = (double)Platform::AtomicRead(&BusyTime) / 1000000.0;
+            result.IdleTime = (double)Platform::AtomicRead(&IdleTime) / 1000000.0;
+            result.LongestJobTime = (double)Platform::AtomicRead(&LongestJobTime) / 1000000.0;
+            result.JobsCount = (int32)Platform::AtomicRead(&JobsCount);
+            result.StealsCount = (int32)Platform::AtomicRead(&StealsCount);
+        }
+    }
+};
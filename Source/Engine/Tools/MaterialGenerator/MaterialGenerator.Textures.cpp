@@ -668,6 +668,62 @@ void MaterialGenerator::ProcessGroupTextures(Box* box, Node* node, Value& value)
         value = box == gradientBox ? gradient : distance;
         break;
     }
+    // Vertex Animation Texture
+    case 18:
+    {
+        auto textureBox = node->GetBox(0);
+        auto positionOffsetBox = node->GetBox(2);
+        auto normalBox = node->GetBox(3);
+        if (!textureBox->HasConnection() || _treeType != MaterialTreeType::VertexShader)
+        {
+            // Vertex animation is evaluated only per-vertex
+            value = Value::Zero;
+            break;
+        }
+        const auto texture = eatBox(textureBox->GetParent<Node>(), textureBox->FirstConnection());
+        if (texture.Type != VariantType::Object)
+        {
+            value = Value::Zero;
+            break;
+        }
+        const auto time = tryGetValue(node->GetBox(1), getTime).AsFloat();
+        _treeLayer->UsageFlags |= MaterialUsageFlags::UseVertexColor;
+
+        // Texture layout matches ModelTool::BakeVertexAnimation (header texel, positions of all frames, normals of all frames; vertex index stored in vertex color)
+        auto positionOffset = writeLocal(VariantType::Float3, node);
+        auto normal = writeLocal(VariantType::Float3, node);
+        const String code = String::Format(TEXT(
+            "	{{\n"
+            "	float4 vatInfo = {0}.Load(int3(0, 0, 0));\n"
+            "	uint vatWidth, vatHeight;\n"
+            "	{0}.GetDimensions(vatWidth, vatHeight);\n"
+            "	uint3 vatBytes = (uint3)round(input.VertexColor.rgb * 255.0f);\n"
+            "	uint vatIndex = vatBytes.r | (vatBytes.g << 8) | (vatBytes.b << 16);\n"
+            "	uint vatFrames = (uint)vatInfo.x;\n"
+            "	uint vatRowsPerFrame = (uint)vatInfo.z;\n"
+            "	float vatFrame = frac({1} * vatInfo.y / vatInfo.x) * vatInfo.x;\n"
+            "	uint vatFrame0 = min((uint)vatFrame, vatFrames - 1);\n"
+            "	uint vatFrame1 = (vatFrame0 + 1) % vatFrames;\n"
+            "	float vatAlpha = saturate(vatFrame - (float)vatFrame0);\n"
+            "	int2 vatTexel = int2(vatIndex % vatWidth, 1 + vatIndex / vatWidth);\n"
+            "	int vatNormals = vatFrames * vatRowsPerFrame;\n"
+            "	float3 vatPosition = lerp({0}.Load(int3(vatTexel.x, vatTexel.y + vatFrame0 * vatRowsPerFrame, 0)).xyz, {0}.Load(int3(vatTexel.x, vatTexel.y + vatFrame1 * vatRowsPerFrame, 0)).xyz, vatAlpha);\n"
+            "	float3 vatNormal = lerp({0}.Load(int3(vatTexel.x, vatTexel.y + vatNormals + vatFrame0 * vatRowsPerFrame, 0)).xyz, {0}.Load(int3(vatTexel.x, vatTexel.y + vatNormals + vatFrame1 * vatRowsPerFrame, 0)).xyz, vatAlpha);\n"
+            "	{2} = TransformLocalVectorToWorld(input, vatPosition - input.PreSkinnedPosition);\n"
+            "	{3} = normalize(TransformLocalVectorToWorld(input, vatNormal));\n"
+            "	}}\n"
+        ),
+                                           texture.Value, // {0}
+                                           time.Value, // {1}
+                                           positionOffset.Value, // {2}
+                                           normal.Value // {3}
+        );
+        _writer.Write(*code);
+        positionOffsetBox->Cache = positionOffset;
+        normalBox->Cache = normal;
+        value = box == normalBox ? normal : positionOffset;
+        break;
+    }
     // World Triplanar Texture
     case 16:
     {
@@ -467,7 +467,7 @@ bool MaterialGenerator::Generate(WriteStream& source, MaterialInfo& materialInfo
             srv = 1; // Depth buffer
             break;
         case MaterialDomain::Terrain:
-            srv = 3; // Heightmap + 2 splatmaps
+            srv = 6; // Heightmap + 2 splatmaps + 3 virtual texture pages atlases
             break;
         case MaterialDomain::Particle:
             srv = 2; // Particles data + Sorted indices/Ribbon segments
@@ -384,6 +384,32 @@ void MeshAccelerationStructure::Add(Float3* vb, int32 vertices, void* ib, int32
     meshData.Use16BitIndexBuffer = use16BitIndex;
 }
 
+void MeshAccelerationStructure::GetTriangles(Array<Float3>& result) const
+{
+    int32 verticesCount = 0;
+    for (const Mesh& meshData : _meshes)
+        verticesCount += meshData.Indices;
+    result.Clear();
+    result.Resize(verticesCount);
+    Float3* dst = result.Get();
+    for (const Mesh& meshData : _meshes)
+    {
+        const Float3* vb = meshData.VertexBuffer.Get<Float3>();
+        if (meshData.Use16BitIndexBuffer)
+        {
+            const uint16* ib16 = meshData.IndexBuffer.Get<uint16>();
+            for (int32 i = 0; i < meshData.Indices; i++)
+                *dst++ = vb[ib16[i]];
+        }
+        else
+        {
+            const uint32* ib32 = meshData.IndexBuffer.Get<uint32>();
+            for (int32 i = 0; i < meshData.Indices; i++)
+                *dst++ = vb[ib32[i]];
+        }
+    }
+}
+
 void MeshAccelerationStructure::BuildBVH(int32 maxLeafSize)
 {
     if (_meshes.Count() == 0)
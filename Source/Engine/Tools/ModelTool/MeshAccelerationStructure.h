@@ -66,6 +66,9 @@ class FLAXENGINE_API MeshAccelerationStructure
     // Adds the triangles geometry for the build to the structure.
     void Add(Float3* vb, int32 vertices, void* ib, int32 indices, bool use16BitIndex, bool copy = false);
 
+    // Gets all triangles geometry as a flat list of vertices (3 vertices per triangle).
+    void GetTriangles(Array<Float3>& result) const;
+
     // Builds Bounding Volume Hierarchy (BVH) structure for accelerated geometry queries.
     void BuildBVH(int32 maxLeafSize = 16);
 
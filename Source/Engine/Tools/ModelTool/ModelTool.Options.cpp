@@ -64,6 +64,10 @@ void ModelTool::Options::Serialize(SerializeStream& stream, const void* otherObj
     SERIALIZE(RestoreMaterialsOnReimport);
     SERIALIZE(GenerateSDF);
     SERIALIZE(SDFResolution);
+    SERIALIZE(GenerateImpostor);
+    SERIALIZE(ImpostorFrames);
+    SERIALIZE(ImpostorResolution);
+    SERIALIZE(ImpostorScreenSize);
     SERIALIZE(SplitObjects);
     SERIALIZE(ObjectIndex);
 }
@@ -104,6 +108,10 @@ void ModelTool::Options::Deserialize(DeserializeStream& stream, ISerializeModifi
     DESERIALIZE(RestoreMaterialsOnReimport);
     DESERIALIZE(GenerateSDF);
     DESERIALIZE(SDFResolution);
+    DESERIALIZE(GenerateImpostor);
+    DESERIALIZE(ImpostorFrames);
+    DESERIALIZE(ImpostorResolution);
+    DESERIALIZE(ImpostorScreenSize);
     DESERIALIZE(SplitObjects);
     DESERIALIZE(ObjectIndex);
 
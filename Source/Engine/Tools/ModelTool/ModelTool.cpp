@@ -8,16 +8,28 @@
 #include "Engine/Core/RandomStream.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Math/Ray.h"
-#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Animations/AnimationUtils.h"
+#include "Engine/Animations/Config.h"
+#include "Engine/Profiler/Profiler.h"
 #include "Engine/Threading/JobSystem.h"
 #include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/Async/GPUTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Graphics/Models/ModelData.h"
 #include "Engine/Content/Assets/Model.h"
+#include "Engine/Content/Assets/Shader.h"
+#include "Engine/Content/Content.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Threading/Threading.h"
 #if USE_EDITOR
+#include "Engine/Content/Assets/SkinnedModel.h"
+#include "Engine/Content/Assets/Animation.h"
 #include "Engine/Core/Types/DateTime.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Core/Types/Pair.h"
@@ -66,6 +78,163 @@ ModelSDFMip::ModelSDFMip(int32 mipIndex, const TextureMipData& mip)
 {
 }
 
+// The maximum amount of triangles processed by the GPU model SDF generation (limited by the dispatch size)
+#define GPU_SDF_MAX_TRIANGLES (GPU_MAX_CS_DISPATCH_THREAD_GROUPS * 64)
+
+PACK_STRUCT(struct GPUSDFData {
+    Float3 VoxelToPosMul;
+    uint32 TrianglesCount;
+    Float3 VoxelToPosAdd;
+    float MaxDistance;
+    Int3 Resolution;
+    int32 JumpStep;
+    });
+
+class GPUGenerateModelSDFTask : public GPUTask
+{
+private:
+    GPUShader* _shader;
+    GPUSDFData _data;
+    const Array<Float3>& _triangles;
+    GPUBuffer* _trianglesBuffer;
+    GPUBuffer* _distances;
+    GPUBuffer* _nearest[2];
+    GPUBuffer* _staging;
+
+public:
+    GPUGenerateModelSDFTask(GPUShader* shader, const GPUSDFData& data, const Array<Float3>& triangles, GPUBuffer* trianglesBuffer, GPUBuffer* distances, GPUBuffer* nearest0, GPUBuffer* nearest1, GPUBuffer* staging)
+        : GPUTask(Type::Custom)
+        , _shader(shader)
+        , _data(data)
+        , _triangles(triangles)
+        , _trianglesBuffer(trianglesBuffer)
+        , _distances(distances)
+        , _nearest{ nearest0, nearest1 }
+        , _staging(staging)
+    {
+    }
+
+protected:
+    // [GPUTask]
+    Result run(GPUTasksContext* tasksContext) override
+    {
+        PROFILE_GPU_CPU("Model SDF");
+        GPUContext* context = tasksContext->GPU;
+        GPUConstantBuffer* cb = _shader->GetCB(0);
+        const Int3 resolution = _data.Resolution;
+        const int32 voxelGroups = 4; // VOXELS_GROUP_SIZE
+        const uint32 groupsX = Math::DivideAndRoundUp(resolution.X, voxelGroups);
+        const uint32 groupsY = Math::DivideAndRoundUp(resolution.Y, voxelGroups);
+        const uint32 groupsZ = Math::DivideAndRoundUp(resolution.Z, voxelGroups);
+        const uint32 trianglesGroups = Math::DivideAndRoundUp(_data.TrianglesCount, 64u); // TRIANGLES_GROUP_SIZE
+        context->UpdateBuffer(_trianglesBuffer, _triangles.Get(), _triangles.Count() * sizeof(Float3));
+
+        // Rasterize triangles into the voxels near the surface (closest distance first, then the closest triangle)
+        _data.JumpStep = 0;
+        context->UpdateCB(cb, &_data);
+        context->BindCB(0, cb);
+        context->BindUA(0, _distances->View());
+        context->BindUA(1, _nearest[0]->View());
+        context->Dispatch(_shader->GetCS("CS_Init"), groupsX, groupsY, groupsZ);
+        context->BindSR(0, _trianglesBuffer->View());
+        context->Dispatch(_shader->GetCS("CS_RasterizeTriangle"), trianglesGroups, 1, 1);
+        context->Dispatch(_shader->GetCS("CS_ResolveTriangle"), trianglesGroups, 1, 1);
+
+        // Propagate the closest triangles into the whole volume with the jump flooding
+        int32 src = 0;
+        for (int32 step = Math::RoundUpToPowerOf2(resolution.MaxValue()) / 2; step >= 1; step /= 2)
+        {
+            _data.JumpStep = step;
+            context->UpdateCB(cb, &_data);
+            context->BindCB(0, cb);
+            context->ResetUA();
+            context->BindSR(1, _nearest[src]->View());
+            context->BindUA(0, _distances->View());
+            context->BindUA(1, _nearest[src ^ 1]->View());
+            context->Dispatch(_shader->GetCS("CS_JumpFlood"), groupsX, groupsY, groupsZ);
+            src ^= 1;
+        }
+
+        // Calculate the signed distances and copy them for the readback
+        context->ResetUA();
+        context->BindSR(1, _nearest[src]->View());
+        context->BindUA(0, _distances->View());
+        context->Dispatch(_shader->GetCS("CS_Encode"), groupsX, groupsY, groupsZ);
+        context->ResetUA();
+        context->ResetSR();
+        context->ResetCB();
+        context->CopyBuffer(_staging, _distances, _distances->GetSize());
+        return Result::Ok;
+    }
+};
+
+// Generates the signed distances of the voxels on the GPU (model local-space). Returns true if failed (eg. GPU is not available) so the CPU generation should be used.
+bool GenerateModelSDFGPU(const MeshAccelerationStructure& scene, const Int3& resolution, const Float3& xyzToLocalMul, const Float3& xyzToLocalAdd, float maxDistance, Array<float>& distances)
+{
+    // GPU work is flushed by the main thread (rendering) so it cannot wait for it
+    if (IsInMainThread() || !GPUDevice::Instance || GPUDevice::Instance->GetState() != GPUDevice::DeviceState::Ready || !GPUDevice::Instance->Limits.HasCompute)
+        return true;
+    PROFILE_CPU();
+    AssetReference<Shader> shaderAsset = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/SDF"));
+    if (!shaderAsset || shaderAsset->WaitForLoaded())
+        return true;
+    GPUShader* shader = shaderAsset->GetShader();
+    if (shader->GetCB(0)->GetSize() != sizeof(GPUSDFData))
+    {
+        LOG(Warning, "Shader {0} has incorrect constant buffer {1} size: {2} bytes. Expected: {3} bytes", shader->ToString(), 0, shader->GetCB(0)->GetSize(), sizeof(GPUSDFData));
+        return true;
+    }
+    Array<Float3> triangles;
+    scene.GetTriangles(triangles);
+    const int32 trianglesCount = triangles.Count() / 3;
+    if (trianglesCount == 0 || trianglesCount > GPU_SDF_MAX_TRIANGLES)
+        return true;
+
+    // Create resources
+    const int32 voxelsCount = resolution.X * resolution.Y * resolution.Z;
+    GPUBuffer* trianglesBuffer = GPUBuffer::New();
+    GPUBuffer* distancesBuffer = GPUBuffer::New();
+    GPUBuffer* nearestBuffers[2] = { GPUBuffer::New(), GPUBuffer::New() };
+    GPUBuffer* stagingBuffer = GPUBuffer::New();
+    bool failed = trianglesBuffer->Init(GPUBufferDescription::Raw(triangles.Count() * sizeof(Float3)));
+    failed |= distancesBuffer->Init(GPUBufferDescription::Raw(voxelsCount * sizeof(float), GPUBufferFlags::UnorderedAccess));
+    failed |= nearestBuffers[0]->Init(GPUBufferDescription::Raw(voxelsCount * sizeof(uint32), GPUBufferFlags::UnorderedAccess));
+    failed |= nearestBuffers[1]->Init(GPUBufferDescription::Raw(voxelsCount * sizeof(uint32), GPUBufferFlags::UnorderedAccess));
+    failed |= stagingBuffer->Init(distancesBuffer->GetDescription().ToStagingReadback());
+
+    // Run on the GPU and wait for the results
+    if (!failed)
+    {
+        GPUSDFData data;
+        data.VoxelToPosMul = xyzToLocalMul;
+        data.TrianglesCount = trianglesCount;
+        data.VoxelToPosAdd = xyzToLocalAdd;
+        data.MaxDistance = maxDistance;
+        data.Resolution = resolution;
+        data.JumpStep = 0;
+        auto task = New<GPUGenerateModelSDFTask>(shader, data, triangles, trianglesBuffer, distancesBuffer, nearestBuffers[0], nearestBuffers[1], stagingBuffer);
+        task->Start();
+        failed = task->Wait();
+        if (!failed)
+        {
+            BytesContainer result;
+            failed = stagingBuffer->GetData(result) || result.Length() < voxelsCount * (int32)sizeof(float);
+            if (!failed)
+            {
+                distances.Resize(voxelsCount);
+                Platform::MemoryCopy(distances.Get(), result.Get(), voxelsCount * sizeof(float));
+            }
+        }
+    }
+
+    SAFE_DELETE_GPU_RESOURCE(trianglesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(distancesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(nearestBuffers[0]);
+    SAFE_DELETE_GPU_RESOURCE(nearestBuffers[1]);
+    SAFE_DELETE_GPU_RESOURCE(stagingBuffer);
+    return failed;
+}
+
 bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float resolutionScale, int32 lodIndex, ModelBase::SDFData* outputSDF, MemoryWriteStream* outputStream, const StringView& assetName, float backfacesThreshold)
 {
     PROFILE_CPU();
@@ -147,7 +316,6 @@ bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float
         scene.Add(inputModel, lodIndex);
     else if (modelData)
         scene.Add(modelData, lodIndex);
-    scene.BuildBVH();
 
     // Allocate memory for the distant field
     const int32 voxelsSize = resolution.X * resolution.Y * resolution.Z * formatStride;
@@ -164,67 +332,81 @@ bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float
     // http://ramakarl.com/pdfs/2016_Hoetzlein_GVDB.pdf
     // https://www.cse.chalmers.se/~uffe/HighResolutionSparseVoxelDAGs.pdf
 
-    // Brute-force for each voxel to calculate distance to the closest triangle with point query and distance sign by raycasting around the voxel
-    const int32 sampleCount = 12;
-    Array<Float3> sampleDirections;
-    sampleDirections.Resize(sampleCount);
+    // Try to generate distances on the GPU (sign is based on the closest triangle facing instead of counting the backfaces hits)
+    Array<float> distances;
+    const bool useGPU = !GenerateModelSDFGPU(scene, resolution, xyzToLocalMul, xyzToLocalAdd, sdf.MaxDistance, distances);
+    if (useGPU)
     {
-        RandomStream rand;
-        sampleDirections.Get()[0] = Float3::Up;
-        sampleDirections.Get()[1] = Float3::Down;
-        sampleDirections.Get()[2] = Float3::Left;
-        sampleDirections.Get()[3] = Float3::Right;
-        sampleDirections.Get()[4] = Float3::Forward;
-        sampleDirections.Get()[5] = Float3::Backward;
-        for (int32 i = 6; i < sampleCount; i++)
-            sampleDirections.Get()[i] = rand.GetUnitVector();
+        const float* src = distances.Get();
+        for (int32 i = 0; i < distances.Count(); i++)
+            formatWrite((byte*)voxels + i * formatStride, src[i] * encodeMAD.X + encodeMAD.Y);
     }
-    Function<void(int32)> sdfJob = [&sdf, &resolution, &backfacesThreshold, &sampleDirections, &scene, &voxels, &xyzToLocalMul, &xyzToLocalAdd, &encodeMAD, &formatStride, &formatWrite](int32 z)
+    else
     {
-        PROFILE_CPU_NAMED("Model SDF Job");
-        Real hitDistance;
-        Vector3 hitNormal, hitPoint;
-        Triangle hitTriangle;
-        const int32 zAddress = resolution.Y * resolution.X * z;
-        for (int32 y = 0; y < resolution.Y; y++)
-        {
-            const int32 yAddress = resolution.X * y + zAddress;
-            for (int32 x = 0; x < resolution.X; x++)
+        scene.BuildBVH();
+
+        // Brute-force for each voxel to calculate distance to the closest triangle with point query and distance sign by raycasting around the voxel
+        const int32 sampleCount = 12;
+        Array<Float3> sampleDirections;
+        sampleDirections.Resize(sampleCount);
+        {
+            RandomStream rand;
+            sampleDirections.Get()[0] = Float3::Up;
+            sampleDirections.Get()[1] = Float3::Down;
+            sampleDirections.Get()[2] = Float3::Left;
+            sampleDirections.Get()[3] = Float3::Right;
+            sampleDirections.Get()[4] = Float3::Forward;
+            sampleDirections.Get()[5] = Float3::Backward;
+            for (int32 i = 6; i < sampleCount; i++)
+                sampleDirections.Get()[i] = rand.GetUnitVector();
+        }
+        Function<void(int32)> sdfJob = [&sdf, &resolution, &backfacesThreshold, &sampleDirections, &scene, &voxels, &xyzToLocalMul, &xyzToLocalAdd, &encodeMAD, &formatStride, &formatWrite](int32 z)
+        {
+            PROFILE_CPU_NAMED("Model SDF Job");
+            Real hitDistance;
+            Vector3 hitNormal, hitPoint;
+            Triangle hitTriangle;
+            const int32 zAddress = resolution.Y * resolution.X * z;
+            for (int32 y = 0; y < resolution.Y; y++)
             {
-                Real minDistance = sdf.MaxDistance;
-                Vector3 voxelPos = Float3((float)x, (float)y, (float)z) * xyzToLocalMul + xyzToLocalAdd;
+                const int32 yAddress = resolution.X * y + zAddress;
+                for (int32 x = 0; x < resolution.X; x++)
+                {
+                    Real minDistance = sdf.MaxDistance;
+                    Vector3 voxelPos = Float3((float)x, (float)y, (float)z) * xyzToLocalMul + xyzToLocalAdd;
 
-                // Point query to find the distance to the closest surface
-                scene.PointQuery(voxelPos, minDistance, hitPoint, hitTriangle);
+                    // Point query to find the distance to the closest surface
+                    scene.PointQuery(voxelPos, minDistance, hitPoint, hitTriangle);
 
-                // Raycast samples around voxel to count triangle backfaces hit
-                int32 hitBackCount = 0, hitCount = 0;
-                for (int32 sample = 0; sample < sampleDirections.Count(); sample++)
-                {
-                    Ray sampleRay(voxelPos, sampleDirections[sample]);
-                    if (scene.RayCast(sampleRay, hitDistance, hitNormal, hitTriangle))
+                    // Raycast samples around voxel to count triangle backfaces hit
+                    int32 hitBackCount = 0, hitCount = 0;
+                    for (int32 sample = 0; sample < sampleDirections.Count(); sample++)
                     {
-                        hitCount++;
-                        const bool backHit = Float3::Dot(sampleRay.Direction, hitTriangle.GetNormal()) > 0;
-                        if (backHit)
-                            hitBackCount++;
+                        Ray sampleRay(voxelPos, sampleDirections[sample]);
+                        if (scene.RayCast(sampleRay, hitDistance, hitNormal, hitTriangle))
+                        {
+                            hitCount++;
+                            const bool backHit = Float3::Dot(sampleRay.Direction, hitTriangle.GetNormal()) > 0;
+                            if (backHit)
+                                hitBackCount++;
+                        }
                     }
-                }
 
-                float distance = (float)minDistance;
-                // TODO: surface thickness threshold? shift reduce distance for all voxels by something like 0.01 to enlarge thin geometry
-                // if ((float)hitBackCount > (float)hitCount * 0.3f && hitCount != 0)
-                if ((float)hitBackCount > (float)sampleDirections.Count() * backfacesThreshold && hitCount != 0)
-                {
-                    // Voxel is inside the geometry so turn it into negative distance to the surface
-                    distance *= -1;
+                    float distance = (float)minDistance;
+                    // TODO: surface thickness threshold? shift reduce distance for all voxels by something like 0.01 to enlarge thin geometry
+                    // if ((float)hitBackCount > (float)hitCount * 0.3f && hitCount != 0)
+                    if ((float)hitBackCount > (float)sampleDirections.Count() * backfacesThreshold && hitCount != 0)
+                    {
+                        // Voxel is inside the geometry so turn it into negative distance to the surface
+                        distance *= -1;
+                    }
+                    const int32 xAddress = x + yAddress;
+                    formatWrite((byte*)voxels + xAddress * formatStride, distance * encodeMAD.X + encodeMAD.Y);
                 }
-                const int32 xAddress = x + yAddress;
-                formatWrite((byte*)voxels + xAddress * formatStride, distance * encodeMAD.X + encodeMAD.Y);
             }
-        }
-    };
-    JobSystem::Execute(sdfJob, resolution.Z);
+        };
+        JobSystem::Execute(sdfJob, resolution.Z);
+    }
 
     // Cache SDF data on a CPU
     if (outputStream)
@@ -321,13 +503,422 @@ bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float
 
 #if !BUILD_RELEASE
     auto endTime = Platform::GetTimeSeconds();
-    LOG(Info, "Generated SDF {}x{}x{} ({} kB) in {}ms for {}", resolution.X, resolution.Y, resolution.Z, voxelSizeSum / 1024, (int32)((endTime - startTime) * 1000.0), assetName);
+    LOG(Info, "Generated SDF {}x{}x{} ({} kB) in {}ms for {}{}", resolution.X, resolution.Y, resolution.Z, voxelSizeSum / 1024, (int32)((endTime - startTime) * 1000.0), assetName, useGPU ? TEXT(" (GPU)") : TEXT(""));
 #endif
     return false;
 }
 
 #if USE_EDITOR
 
+namespace
+{
+    Float3 GetImpostorFrameDirection(int32 x, int32 y, int32 frames)
+    {
+        // Octahedral mapping of the frame center into the view direction (octahedron Z axis is model up axis, matches Impostors.shader)
+        const Float2 coords(((float)x + 0.5f) / (float)frames * 2.0f - 1.0f, ((float)y + 0.5f) / (float)frames * 2.0f - 1.0f);
+        Float3 direction(coords.X, 1.0f - Math::Abs(coords.X) - Math::Abs(coords.Y), coords.Y);
+        if (direction.Y < 0.0f)
+        {
+            const float dirX = (1.0f - Math::Abs(direction.Z)) * (direction.X >= 0.0f ? 1.0f : -1.0f);
+            const float dirZ = (1.0f - Math::Abs(direction.X)) * (direction.Z >= 0.0f ? 1.0f : -1.0f);
+            direction.X = dirX;
+            direction.Z = dirZ;
+        }
+        return Float3::Normalize(direction);
+    }
+
+    void GetImpostorFrameBasis(const Float3& direction, Float3& right, Float3& up)
+    {
+        const Float3 upRef = Math::Abs(direction.Y) > 0.999f ? Float3::Forward : Float3::Up;
+        right = Float3::Normalize(Float3::Cross(upRef, direction));
+        up = Float3::Cross(direction, right);
+    }
+
+    FORCE_INLINE float EdgeFunction(const Float3& a, const Float3& b, const Float2& c)
+    {
+        return (c.X - a.X) * (b.Y - a.Y) - (c.Y - a.Y) * (b.X - a.X);
+    }
+}
+
+bool ModelTool::GenerateModelImpostor(const ModelData& modelData, int32 lodIndex, int32 frames, int32 frameResolution, float screenSize, MemoryWriteStream& outputStream, const StringView& assetName)
+{
+    PROFILE_CPU();
+    auto startTime = Platform::GetTimeSeconds();
+    if (lodIndex < 0 || lodIndex >= modelData.LODs.Count())
+        return true;
+    const ModelLodData& lod = modelData.LODs[lodIndex];
+    BoundingSphere sphere;
+    BoundingSphere::FromBox(lod.GetBox(), sphere);
+    if (sphere.Radius <= ZeroTolerance)
+        return true;
+
+    // Setup atlas
+    frames = Math::Clamp(frames, 2, 32);
+    frameResolution = Math::Clamp(Math::RoundUpToPowerOf2(frameResolution), 16, 1024);
+    const int32 atlasSize = frames * frameResolution;
+    if (atlasSize > GPU_MAX_TEXTURE_SIZE)
+    {
+        LOG(Warning, "Impostor atlas size {} is too big for {}. Use less frames or lower resolution.", atlasSize, assetName);
+        return true;
+    }
+    const int32 mipLevels = Math::Max(MipLevelsCount(frameResolution) - 2, 1); // Stop at 4x4 frames to reduce neighbor views bleeding
+    const int32 pixelsCount = atlasSize * atlasSize;
+    Array<Color32> albedo, normalDepth;
+    Array<float> depth;
+    albedo.Resize(pixelsCount);
+    normalDepth.Resize(pixelsCount);
+    depth.Resize(pixelsCount);
+    Platform::MemoryClear(albedo.Get(), albedo.Count() * sizeof(Color32));
+    Platform::MemoryClear(normalDepth.Get(), normalDepth.Count() * sizeof(Color32));
+    for (int32 i = 0; i < pixelsCount; i++)
+        depth.Get()[i] = -MAX_float;
+
+    // Rasterize the model for each view direction (orthographic projection of the bounding sphere, albedo from material diffuse color and vertex colors)
+    const Float3 center = sphere.Center;
+    const float invRadius = 1.0f / (float)sphere.Radius;
+    Function<void(int32)> frameJob = [&](int32 frameIndex)
+    {
+        PROFILE_CPU_NAMED("Model Impostor Job");
+        const int32 frameX = frameIndex % frames, frameY = frameIndex / frames;
+        const Float3 direction = GetImpostorFrameDirection(frameX, frameY, frames);
+        Float3 right, up;
+        GetImpostorFrameBasis(direction, right, up);
+        const int32 frameAddress = frameY * frameResolution * atlasSize + frameX * frameResolution;
+        const float res = (float)frameResolution;
+        for (const MeshData* mesh : lod.Meshes)
+        {
+            const Color materialColor = mesh->MaterialSlotIndex >= 0 && mesh->MaterialSlotIndex < modelData.Materials.Count() ? modelData.Materials[mesh->MaterialSlotIndex].Diffuse.Color : Color::White;
+            const bool hasColors = mesh->Colors.Count() == mesh->Positions.Count();
+            const bool hasNormals = mesh->Normals.Count() == mesh->Positions.Count();
+            const uint32* indices = mesh->Indices.Get();
+            const Float3* positions = mesh->Positions.Get();
+            for (int32 i = 0; i + 2 < mesh->Indices.Count(); i += 3)
+            {
+                const uint32 idx[3] = { indices[i], indices[i + 1], indices[i + 2] };
+                Float3 s[3];
+                for (int32 k = 0; k < 3; k++)
+                {
+                    const Float3 local = positions[idx[k]] - center;
+                    s[k] = Float3((Float3::Dot(local, right) * invRadius * 0.5f + 0.5f) * res, (0.5f - Float3::Dot(local, up) * invRadius * 0.5f) * res, Float3::Dot(local, direction) * invRadius);
+                }
+                const float area = EdgeFunction(s[0], s[1], Float2(s[2].X, s[2].Y));
+                if (Math::Abs(area) < ZeroTolerance)
+                    continue;
+                const float invArea = 1.0f / area;
+                const Float3 faceNormal = Float3::Normalize(Float3::Cross(positions[idx[1]] - positions[idx[0]], positions[idx[2]] - positions[idx[0]]));
+                const int32 minX = Math::Max((int32)Math::Floor(Math::Min(s[0].X, s[1].X, s[2].X)), 0);
+                const int32 minY = Math::Max((int32)Math::Floor(Math::Min(s[0].Y, s[1].Y, s[2].Y)), 0);
+                const int32 maxX = Math::Min((int32)Math::Ceil(Math::Max(s[0].X, s[1].X, s[2].X)), frameResolution - 1);
+                const int32 maxY = Math::Min((int32)Math::Ceil(Math::Max(s[0].Y, s[1].Y, s[2].Y)), frameResolution - 1);
+                for (int32 y = minY; y <= maxY; y++)
+                {
+                    for (int32 x = minX; x <= maxX; x++)
+                    {
+                        const Float2 p((float)x + 0.5f, (float)y + 0.5f);
+                        const float w0 = EdgeFunction(s[1], s[2], p) * invArea;
+                        const float w1 = EdgeFunction(s[2], s[0], p) * invArea;
+                        const float w2 = 1.0f - w0 - w1;
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                            continue;
+                        const float z = w0 * s[0].Z + w1 * s[1].Z + w2 * s[2].Z;
+                        const int32 address = frameAddress + y * atlasSize + x;
+                        if (z <= depth.Get()[address])
+                            continue;
+                        depth.Get()[address] = z;
+
+                        // Interpolate vertex attributes (flip normal of the faces visible from the back)
+                        Float3 normal = hasNormals ? Float3::Normalize(mesh->Normals[idx[0]] * w0 + mesh->Normals[idx[1]] * w1 + mesh->Normals[idx[2]] * w2) : faceNormal;
+                        if (Float3::Dot(normal, direction) < 0.0f)
+                            normal = -normal;
+                        Color color = materialColor;
+                        if (hasColors)
+                            color *= mesh->Colors[idx[0]] * w0 + mesh->Colors[idx[1]] * w1 + mesh->Colors[idx[2]] * w2;
+                        albedo.Get()[address] = Color32(Color(color.R, color.G, color.B, 1.0f));
+                        normalDepth.Get()[address] = Color32(Color(normal.X * 0.5f + 0.5f, normal.Y * 0.5f + 0.5f, normal.Z * 0.5f + 0.5f, Math::Saturate(z * 0.5f + 0.5f)));
+                    }
+                }
+            }
+        }
+
+        // Dilate the frame edges to reduce the background color bleeding with bilinear filtering and mip maps
+        for (int32 iteration = 0; iteration < 4; iteration++)
+        {
+            for (int32 y = 0; y < frameResolution; y++)
+            {
+                for (int32 x = 0; x < frameResolution; x++)
+                {
+                    const int32 address = frameAddress + y * atlasSize + x;
+                    if (albedo.Get()[address].A != 0)
+                        continue;
+                    const int32 neighbors[4] = { x > 0 ? address - 1 : -1, x < frameResolution - 1 ? address + 1 : -1, y > 0 ? address - atlasSize : -1, y < frameResolution - 1 ? address + atlasSize : -1 };
+                    int32 sum[4] = {}, count = 0;
+                    for (int32 neighbor : neighbors)
+                    {
+                        if (neighbor == -1 || albedo.Get()[neighbor].A == 0)
+                            continue;
+                        const Color32 c = albedo.Get()[neighbor];
+                        sum[0] += c.R;
+                        sum[1] += c.G;
+                        sum[2] += c.B;
+                        count++;
+                    }
+                    if (count != 0)
+                    {
+                        albedo.Get()[address] = Color32((byte)(sum[0] / count), (byte)(sum[1] / count), (byte)(sum[2] / count), 1);
+                        normalDepth.Get()[address] = Color32(128, 128, 128, 0);
+                    }
+                }
+            }
+        }
+
+        // Clear the coverage of the dilated pixels
+        for (int32 y = 0; y < frameResolution; y++)
+        {
+            for (int32 x = 0; x < frameResolution; x++)
+            {
+                auto& c = albedo.Get()[frameAddress + y * atlasSize + x];
+                if (c.A != 255)
+                    c.A = 0;
+            }
+        }
+    };
+    JobSystem::Execute(frameJob, frames * frames);
+
+    // Write data with mip maps (box filter)
+    outputStream.WriteInt32(1); // Version
+    ModelImpostorHeader header;
+    header.Center = center;
+    header.Radius = (float)sphere.Radius;
+    header.Frames = frames;
+    header.Resolution = atlasSize;
+    header.MipLevels = mipLevels;
+    header.ScreenSize = screenSize;
+    outputStream.WriteBytes(&header, sizeof(header));
+    int32 mipSize = atlasSize;
+    int32 dataSize = 0;
+    for (int32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+    {
+        if (mipLevel != 0)
+        {
+            const int32 prevSize = mipSize;
+            mipSize /= 2;
+            for (Array<Color32>* mip : { &albedo, &normalDepth })
+            {
+                Color32* data = mip->Get();
+                for (int32 y = 0; y < mipSize; y++)
+                {
+                    for (int32 x = 0; x < mipSize; x++)
+                    {
+                        const Color32* src = data + y * 2 * prevSize + x * 2;
+                        const Color32 samples[4] = { src[0], src[1], src[prevSize], src[prevSize + 1] };
+                        int32 sum[4] = {};
+                        for (const Color32& e : samples)
+                        {
+                            sum[0] += e.R;
+                            sum[1] += e.G;
+                            sum[2] += e.B;
+                            sum[3] += e.A;
+                        }
+                        data[y * mipSize + x] = Color32((byte)(sum[0] / 4), (byte)(sum[1] / 4), (byte)(sum[2] / 4), (byte)(sum[3] / 4));
+                    }
+                }
+            }
+        }
+        const int32 mipDataSize = mipSize * mipSize * sizeof(Color32);
+        outputStream.WriteBytes(albedo.Get(), mipDataSize);
+        outputStream.WriteBytes(normalDepth.Get(), mipDataSize);
+        dataSize += mipDataSize * 2;
+    }
+
+#if !BUILD_RELEASE
+    auto endTime = Platform::GetTimeSeconds();
+    LOG(Info, "Generated impostor {}x{} ({} kB) in {}ms for {}", atlasSize, atlasSize, dataSize / 1024, (int32)((endTime - startTime) * 1000.0), assetName);
+#endif
+    return false;
+}
+
+bool ModelTool::BakeVertexAnimation(SkinnedModel* model, Animation* animation, float framesPerSecond, ModelData& outputModel, TextureData& outputTexture)
+{
+    PROFILE_CPU();
+    auto startTime = Platform::GetTimeSeconds();
+    if (!model || !animation || model->WaitForLoaded() || animation->WaitForLoaded())
+        return true;
+    const SkeletonData& skeleton = model->Skeleton;
+    const auto mapping = animation->GetMapping(model);
+    if (!mapping || skeleton.Bones.IsEmpty())
+        return true;
+
+    // Setup texture layout (header row, then positions and normals of all frames with vertices wrapped into rows)
+    int32 verticesCount = 0;
+    for (const auto& lod : model->LODs)
+    {
+        for (const auto& mesh : lod.Meshes)
+            verticesCount += mesh.GetVertexCount();
+    }
+    if (verticesCount == 0 || verticesCount > (1 << 24))
+        return true;
+    framesPerSecond = Math::Clamp(framesPerSecond, 1.0f, 120.0f);
+    const int32 framesCount = Math::Max(Math::RoundToInt(animation->GetLength() * framesPerSecond), 1);
+    const int32 width = Math::Min(verticesCount, 4096);
+    const int32 rowsPerFrame = Math::DivideAndRoundUp(verticesCount, width);
+    const int32 height = 1 + framesCount * rowsPerFrame * 2;
+    if (height > GPU_MAX_TEXTURE_SIZE)
+    {
+        LOG(Warning, "Cannot bake vertex animation of '{}' with {} frames for {} vertices. Use lower frames per second or less vertices.", model->ToString(), framesCount, verticesCount);
+        return true;
+    }
+    outputTexture.Width = width;
+    outputTexture.Height = height;
+    outputTexture.Depth = 1;
+    outputTexture.Format = PixelFormat::R32G32B32A32_Float;
+    outputTexture.Items.Resize(1);
+    outputTexture.Items[0].Mips.Resize(1);
+    auto& mip = outputTexture.Items[0].Mips[0];
+    mip.RowPitch = width * sizeof(Float4);
+    mip.DepthPitch = mip.RowPitch * height;
+    mip.Lines = height;
+    mip.Data.Allocate(mip.DepthPitch);
+    Platform::MemoryClear(mip.Data.Get(), mip.DepthPitch);
+    mip.Get<Float4>(0, 0) = Float4((float)framesCount, framesPerSecond, (float)rowsPerFrame, (float)verticesCount);
+
+    // Convert meshes into the static model (vertex index is encoded in the vertex color)
+    outputModel.LODs.Resize(model->LODs.Count());
+    outputModel.MinScreenSize = model->MinScreenSize;
+    outputModel.Materials.Resize(model->MaterialSlots.Count());
+    for (int32 i = 0; i < model->MaterialSlots.Count(); i++)
+    {
+        const auto& slot = model->MaterialSlots[i];
+        auto& material = outputModel.Materials[i];
+        material.Name = slot.Name;
+        material.ShadowsMode = slot.ShadowsMode;
+        material.AssetID = slot.Material.GetID();
+    }
+    Array<VB0SkinnedElementType> vertices;
+    vertices.Resize(verticesCount);
+    int32 vertexIndex = 0;
+    for (int32 lodIndex = 0; lodIndex < model->LODs.Count(); lodIndex++)
+    {
+        const auto& lod = model->LODs[lodIndex];
+        auto& outputLod = outputModel.LODs[lodIndex];
+        outputLod.ScreenSize = lod.ScreenSize;
+        for (const auto& mesh : lod.Meshes)
+        {
+            BytesContainer vb, ib;
+            int32 vertexCount, indexCount;
+            if (mesh.DownloadDataCPU(MeshBufferType::Vertex0, vb, vertexCount) || mesh.DownloadDataCPU(MeshBufferType::Index, ib, indexCount))
+                return true;
+            const auto vb0 = (const VB0SkinnedElementType*)vb.Get();
+            Platform::MemoryCopy(vertices.Get() + vertexIndex, vb0, vertexCount * sizeof(VB0SkinnedElementType));
+
+            auto outputMesh = New<MeshData>();
+            outputLod.Meshes.Add(outputMesh);
+            outputMesh->MaterialSlotIndex = mesh.GetMaterialSlotIndex();
+            outputMesh->Positions.Resize(vertexCount);
+            outputMesh->UVs.Resize(vertexCount);
+            outputMesh->Normals.Resize(vertexCount);
+            outputMesh->Tangents.Resize(vertexCount);
+            outputMesh->BitangentSigns.Resize(vertexCount);
+            outputMesh->Colors.Resize(vertexCount);
+            for (int32 i = 0; i < vertexCount; i++)
+            {
+                const auto& v = vb0[i];
+                const Float4 tangent = v.Tangent.ToFloat4();
+                outputMesh->Positions[i] = v.Position;
+                outputMesh->UVs[i] = v.TexCoord.ToFloat2();
+                outputMesh->Normals[i] = v.Normal.ToFloat3() * 2.0f - 1.0f;
+                outputMesh->Tangents[i] = Float3(tangent) * 2.0f - 1.0f;
+                outputMesh->BitangentSigns[i] = tangent.W > 0.5f ? -1.0f : 1.0f;
+                const uint32 index = vertexIndex + i;
+                outputMesh->Colors[i] = Color(((float)(index & 0xff) + 0.5f) / 255.0f, ((float)((index >> 8) & 0xff) + 0.5f) / 255.0f, ((float)((index >> 16) & 0xff) + 0.5f) / 255.0f, 1.0f);
+            }
+            outputMesh->Indices.Resize(indexCount);
+            if (ib.Length() == indexCount * sizeof(uint16))
+            {
+                const auto ib16 = (const uint16*)ib.Get();
+                for (int32 i = 0; i < indexCount; i++)
+                    outputMesh->Indices[i] = ib16[i];
+            }
+            else
+            {
+                Platform::MemoryCopy(outputMesh->Indices.Get(), ib.Get(), indexCount * sizeof(uint32));
+            }
+            vertexIndex += vertexCount;
+        }
+    }
+
+    // Bake frames
+    Array<Transform> nodes;
+    Array<Matrix> bones;
+    nodes.Resize(skeleton.Nodes.Count());
+    bones.Resize(skeleton.Bones.Count());
+    const float animationFramesPerSample = (float)animation->Data.FramesPerSecond / framesPerSecond;
+    BoundingBox bounds(vertices[0].Position);
+    for (int32 frame = 0; frame < framesCount; frame++)
+    {
+        // Sample the pose (time is in animation frames)
+        const float time = (float)frame * animationFramesPerSample;
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            nodes[i] = skeleton.Nodes[i].LocalTransform;
+            const int32 channelIndex = mapping->Get()[i];
+            if (channelIndex == -1)
+                continue;
+            if (animation->CompressedData.IsValid())
+                animation->CompressedData.Sample(channelIndex, time, nodes[i]);
+            else
+                animation->Data.Channels[channelIndex].Evaluate(time, &nodes[i], false);
+        }
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            // Note: this assumes that nodes are sorted (parents first)
+            const int32 parentIndex = skeleton.Nodes[i].ParentIndex;
+            if (parentIndex != -1)
+                nodes[parentIndex].LocalToWorld(nodes[i], nodes[i]);
+        }
+        for (int32 i = 0; i < bones.Count(); i++)
+        {
+            const SkeletonBone& bone = skeleton.Bones[i];
+            Matrix pose;
+            nodes[bone.NodeIndex].GetWorld(pose);
+            bones[i] = bone.OffsetMatrix * pose;
+        }
+
+        // Skin vertices on a CPU
+        const int32 positionsRow = 1 + frame * rowsPerFrame;
+        const int32 normalsRow = positionsRow + framesCount * rowsPerFrame;
+        for (int32 i = 0; i < verticesCount; i++)
+        {
+            const auto& v = vertices[i];
+            const Float4 weights = v.BlendWeights.ToFloat4();
+            const Float3 normal = v.Normal.ToFloat3() * 2.0f - 1.0f;
+            const byte indices[4] = { v.BlendIndices.R, v.BlendIndices.G, v.BlendIndices.B, v.BlendIndices.A };
+            Float3 skinnedPosition = Float3::Zero, skinnedNormal = Float3::Zero;
+            for (int32 j = 0; j < 4; j++)
+            {
+                const float weight = weights.Raw[j];
+                if (weight <= ZeroTolerance || indices[j] >= bones.Count())
+                    continue;
+                const Matrix& bone = bones[indices[j]];
+                Float3 boneNormal;
+                Float3::TransformNormal(normal, bone, boneNormal);
+                skinnedPosition += Float3::Transform(v.Position, bone) * weight;
+                skinnedNormal += boneNormal * weight;
+            }
+            skinnedNormal.Normalize();
+            bounds.Merge(skinnedPosition);
+            const int32 x = i % width, y = i / width;
+            mip.Get<Float4>(x, positionsRow + y) = Float4(skinnedPosition, 1.0f);
+            mip.Get<Float4>(x, normalsRow + y) = Float4(skinnedNormal, 0.0f);
+        }
+    }
+
+#if !BUILD_RELEASE
+    auto endTime = Platform::GetTimeSeconds();
+    LOG(Info, "Baked vertex animation {}x{} ({} frames, {} kB) in {}ms for {}. Animated bounds: {}", width, height, framesCount, (int32)(mip.DepthPitch / 1024), (int32)((endTime - startTime) * 1000.0), model->ToString(), bounds);
+#endif
+    return false;
+}
+
 void RemoveNamespace(String& name)
 {
     const int32 namespaceStart = name.Find(':');
@@ -613,6 +1204,56 @@ void OptimizeCurve(LinearCurve<T>& curve)
     }
 }
 
+FORCE_INLINE float GetKeyframeError(const Float3& a, const Float3& b)
+{
+    return Float3::Distance(a, b);
+}
+
+FORCE_INLINE float GetKeyframeError(const Quaternion& a, const Quaternion& b)
+{
+    return 1.0f - Math::Abs(Quaternion::Dot(a, b));
+}
+
+template<typename T>
+void ReduceCurve(LinearCurve<T>& curve, float maxError)
+{
+    // Remove keyframes that can be reconstructed by interpolating between the neighbors within the error threshold
+    auto& oldKeyframes = curve.GetKeyframes();
+    const int32 keyCount = oldKeyframes.Count();
+    if (keyCount < 3)
+        return;
+    typename LinearCurve<T>::KeyFrameCollection newKeyframes(keyCount);
+    newKeyframes.Add(oldKeyframes[0]);
+    int32 lastKept = 0;
+    for (int32 i = 1; i < keyCount - 1; i++)
+    {
+        // Check all keyframes skipped since the last kept one to prevent accumulating the error
+        const auto& start = oldKeyframes[lastKept];
+        const auto& end = oldKeyframes[i + 1];
+        const float length = Math::Max(end.Time - start.Time, ZeroTolerance);
+        bool canRemove = true;
+        for (int32 j = lastKept + 1; j <= i && canRemove; j++)
+        {
+            const auto& key = oldKeyframes[j];
+            T value;
+            AnimationUtils::Interpolate(start.Value, end.Value, (key.Time - start.Time) / length, value);
+            canRemove = GetKeyframeError(value, key.Value) <= maxError;
+        }
+        if (!canRemove)
+        {
+            newKeyframes.Add(oldKeyframes[i]);
+            lastKept = i;
+        }
+    }
+    newKeyframes.Add(oldKeyframes.Last());
+
+    // Update keyframes if size changed
+    if (keyCount != newKeyframes.Count())
+    {
+        curve.SetKeyframes(newKeyframes);
+    }
+}
+
 void* MeshOptAllocate(size_t size)
 {
     return Allocator::Allocate(size);
@@ -623,6 +1264,89 @@ void MeshOptDeallocate(void* ptr)
     Allocator::Free(ptr);
 }
 
+void OptimizeMesh(MeshData* mesh)
+{
+    const int32 indexCount = mesh->Indices.Count();
+    const int32 vertexCount = mesh->Positions.Count();
+    if (indexCount == 0 || vertexCount == 0)
+        return;
+
+    // Reorder triangles for the post-transform vertex cache and then for the overdraw (allow a small vertex cache efficiency loss)
+    meshopt_optimizeVertexCache(mesh->Indices.Get(), mesh->Indices.Get(), indexCount, vertexCount);
+    meshopt_optimizeOverdraw(mesh->Indices.Get(), mesh->Indices.Get(), indexCount, (const float*)mesh->Positions.Get(), vertexCount, sizeof(Float3), 1.05f);
+
+    // Reorder vertices for the vertex fetch locality (in order of the first use by the index buffer, unused vertices get removed)
+    Array<unsigned int> remap;
+    remap.Resize(vertexCount);
+    const int32 optimizedVertexCount = (int32)meshopt_optimizeVertexFetchRemap(remap.Get(), mesh->Indices.Get(), indexCount, vertexCount);
+    meshopt_remapIndexBuffer(mesh->Indices.Get(), mesh->Indices.Get(), indexCount, remap.Get());
+#define REMAP_VERTEX_BUFFER(name, type) \
+    if (mesh->name.HasItems()) \
+    { \
+        ASSERT(mesh->name.Count() == vertexCount); \
+        meshopt_remapVertexBuffer(mesh->name.Get(), mesh->name.Get(), vertexCount, sizeof(type), remap.Get()); \
+        mesh->name.Resize(optimizedVertexCount); \
+    }
+    REMAP_VERTEX_BUFFER(Positions, Float3);
+    REMAP_VERTEX_BUFFER(UVs, Float2);
+    REMAP_VERTEX_BUFFER(Normals, Float3);
+    REMAP_VERTEX_BUFFER(Tangents, Float3);
+    REMAP_VERTEX_BUFFER(BitangentSigns, float);
+    REMAP_VERTEX_BUFFER(LightmapUVs, Float2);
+    REMAP_VERTEX_BUFFER(Colors, Color);
+    REMAP_VERTEX_BUFFER(BlendIndices, Int4);
+    REMAP_VERTEX_BUFFER(BlendWeights, Float4);
+#undef REMAP_VERTEX_BUFFER
+
+    // Remap blend shapes
+    for (int32 blendShapeIndex = mesh->BlendShapes.Count() - 1; blendShapeIndex >= 0; blendShapeIndex--)
+    {
+        auto& blendShape = mesh->BlendShapes[blendShapeIndex];
+        for (int32 i = blendShape.Vertices.Count() - 1; i >= 0; i--)
+        {
+            auto& v = blendShape.Vertices[i];
+            v.VertexIndex = remap[v.VertexIndex];
+            if (v.VertexIndex == ~0u)
+                blendShape.Vertices.RemoveAtKeepOrder(i);
+        }
+        if (blendShape.Vertices.IsEmpty())
+            mesh->BlendShapes.RemoveAtKeepOrder(blendShapeIndex);
+    }
+}
+
+void BuildMeshClusters(MeshData* mesh)
+{
+    const int32 indexCount = mesh->Indices.Count();
+    const int32 vertexCount = mesh->Positions.Count();
+    Array<meshopt_Meshlet> meshlets;
+    meshlets.Resize((int32)meshopt_buildMeshletsBound(indexCount, MODEL_MESH_CLUSTER_MAX_VERTICES, MODEL_MESH_CLUSTER_MAX_TRIANGLES), false);
+    const int32 meshletsCount = (int32)meshopt_buildMeshlets(meshlets.Get(), mesh->Indices.Get(), indexCount, vertexCount, MODEL_MESH_CLUSTER_MAX_VERTICES, MODEL_MESH_CLUSTER_MAX_TRIANGLES);
+
+    // Rewrite the index buffer in the clusters order so every cluster is a contiguous range of the mesh triangles
+    mesh->Clusters.Resize(meshletsCount, false);
+    uint32* indices = mesh->Indices.Get();
+    uint32 index = 0;
+    for (int32 i = 0; i < meshletsCount; i++)
+    {
+        const meshopt_Meshlet& meshlet = meshlets[i];
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(&meshlet, (const float*)mesh->Positions.Get(), vertexCount, sizeof(Float3));
+        MeshCluster& cluster = mesh->Clusters[i];
+        cluster.Center = Float3(bounds.center[0], bounds.center[1], bounds.center[2]);
+        cluster.Radius = bounds.radius;
+        cluster.ConeAxis = Float3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+        cluster.ConeCutoff = bounds.cone_cutoff;
+        cluster.StartIndex = index;
+        cluster.IndicesCount = meshlet.triangle_count * 3;
+        for (int32 t = 0; t < meshlet.triangle_count; t++)
+        {
+            indices[index++] = meshlet.vertices[meshlet.indices[t][0]];
+            indices[index++] = meshlet.vertices[meshlet.indices[t][1]];
+            indices[index++] = meshlet.vertices[meshlet.indices[t][2]];
+        }
+    }
+    ASSERT(index == (uint32)indexCount);
+}
+
 bool ModelTool::ImportModel(const String& path, ModelData& meshData, Options& options, String& errorMsg, const String& autoImportOutput)
 {
     LOG(Info, "Importing model from \'{0}\'", path);
@@ -1321,6 +2045,9 @@ bool ModelTool::ImportModel(const String& path, ModelData& meshData, Options& op
                 OptimizeCurve(anim.Position);
                 OptimizeCurve(anim.Rotation);
                 OptimizeCurve(anim.Scale);
+                ReduceCurve(anim.Position, ANIM_COMPRESSION_POSITION_ERROR);
+                ReduceCurve(anim.Rotation, ANIM_COMPRESSION_ROTATION_ERROR);
+                ReduceCurve(anim.Scale, ANIM_COMPRESSION_SCALE_ERROR);
 
                 // Remove empty channels
                 if (anim.GetKeyframesCount() == 0)
@@ -1478,9 +2205,12 @@ bool ModelTool::ImportModel(const String& path, ModelData& meshData, Options& op
                         dstMesh->BlendShapes.RemoveAt(blendShapeIndex);
                 }
 
-                // Optimize generated LOD
-                meshopt_optimizeVertexCache(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, dstMeshVertexCount);
-                meshopt_optimizeOverdraw(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, (const float*)dstMesh->Positions.Get(), dstMeshVertexCount, sizeof(Float3), 1.05f);
+                // Optimize generated LOD (unless all meshes get optimized later)
+                if (!options.OptimizeMeshes)
+                {
+                    meshopt_optimizeVertexCache(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, dstMeshVertexCount);
+                    meshopt_optimizeOverdraw(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, (const float*)dstMesh->Positions.Get(), dstMeshVertexCount, sizeof(Float3), 1.05f);
+                }
 
                 lodTriangleCount += dstMeshIndexCount / 3;
                 lodVertexCount += dstMeshVertexCount;
@@ -1506,6 +2236,49 @@ bool ModelTool::ImportModel(const String& path, ModelData& meshData, Options& op
         }
     }
 
+    // Optimize meshes of all LODs for the vertex cache, overdraw and vertex fetch (in parallel)
+    if (options.OptimizeMeshes && options.Type != ModelType::Animation)
+    {
+        auto optimizeStartTime = DateTime::NowUTC();
+        meshopt_setAllocator(MeshOptAllocate, MeshOptDeallocate);
+        Array<MeshData*> meshes;
+        for (auto& lod : data.LODs)
+            meshes.Add(lod.Meshes);
+        const Function<void(int32)> optimizeJob = [&meshes](int32 i)
+        {
+            PROFILE_CPU_NAMED("Optimize Mesh Job");
+            OptimizeMesh(meshes[i]);
+        };
+        JobSystem::Execute(optimizeJob, meshes.Count());
+        if (meshes.HasItems())
+        {
+            auto optimizeEndTime = DateTime::NowUTC();
+            LOG(Info, "Optimized {1} meshes in {0} ms", static_cast<int32>((optimizeEndTime - optimizeStartTime).GetTotalMilliseconds()), meshes.Count());
+        }
+    }
+
+    // Split high-poly meshes into clusters for the fine-grained culling
+    if (options.Type == ModelType::Model)
+    {
+        meshopt_setAllocator(MeshOptAllocate, MeshOptDeallocate);
+        int32 clusteredMeshes = 0;
+        for (auto& lod : data.LODs)
+        {
+            for (auto& mesh : lod.Meshes)
+            {
+                if (mesh->Indices.Count() / 3 >= MODEL_MESH_CLUSTERS_MIN_TRIANGLES)
+                {
+                    BuildMeshClusters(mesh);
+                    clusteredMeshes++;
+                }
+            }
+        }
+        if (clusteredMeshes)
+        {
+            LOG(Info, "Generated clusters for {0} meshes", clusteredMeshes);
+        }
+    }
+
     // Export imported data to the output container (we reduce vertex data copy operations to minimum)
     {
         meshData.Textures.Swap(data.Textures);
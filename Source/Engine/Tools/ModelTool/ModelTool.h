@@ -178,6 +178,16 @@ struct ModelSDFMip
     ModelSDFMip(int32 mipIndex, const TextureMipData& mip);
 };
 
+struct ModelImpostorHeader
+{
+    Float3 Center;
+    float Radius;
+    int32 Frames;
+    int32 Resolution;
+    int32 MipLevels;
+    float ScreenSize;
+};
+
 /// <summary>
 /// Models data  importing and processing utility.
 /// </summary>
@@ -253,6 +263,12 @@ class FLAXENGINE_API ModelTool
         bool GenerateSDF = false;
         float SDFResolution = 1.0f;
 
+        // Impostor
+        bool GenerateImpostor = false;
+        int32 ImpostorFrames = 8;
+        int32 ImpostorResolution = 128;
+        float ImpostorScreenSize = 0.05f;
+
         // Splitting
         bool SplitObjects = false;
         int32 ObjectIndex = -1;
@@ -291,6 +307,31 @@ class FLAXENGINE_API ModelTool
     /// <returns>True if fails, otherwise false.</returns>
     static bool ImportModel(const String& path, ModelData& meshData, Options& options, String& errorMsg, const String& autoImportOutput = String::Empty);
 
+    /// <summary>
+    /// Bakes the octahedral impostor of the model (atlas of the model views captured from the directions around it). Outputs array texture data with albedo and coverage (slice 0) and local-space normal and depth (slice 1).
+    /// </summary>
+    /// <param name="modelData">The model data.</param>
+    /// <param name="lodIndex">The index of the LOD to use for the impostor baking.</param>
+    /// <param name="frames">The amount of captured views per atlas side (total views count is frames x frames).</param>
+    /// <param name="frameResolution">The resolution (in pixels) of a single view in the atlas.</param>
+    /// <param name="screenSize">The model screen size below which the impostor is used instead of the meshes.</param>
+    /// <param name="outputStream">The output stream for the impostor data (stored in the model asset).</param>
+    /// <param name="assetName">The asset name (for logging).</param>
+    /// <returns>True if fails, otherwise false.</returns>
+    static bool GenerateModelImpostor(const ModelData& modelData, int32 lodIndex, int32 frames, int32 frameResolution, float screenSize, class MemoryWriteStream& outputStream, const StringView& assetName);
+
+    /// <summary>
+    /// Bakes the skinned model animation into the vertex animation texture (VAT) and converts the skinned model into the static model data that can play it fully on the GPU (via Vertex Animation Texture material node).
+    /// The output texture (RGBA32F) contains the header texel (frames count, frames per second, rows per frame, vertices count) in the first row, followed by the model-space vertex positions of all frames and then the vertex normals of all frames. The output model meshes store the vertex index within the texture in the vertex colors.
+    /// </summary>
+    /// <param name="model">The source skinned model.</param>
+    /// <param name="animation">The animation to bake.</param>
+    /// <param name="framesPerSecond">The amount of the baked frames per second of the animation.</param>
+    /// <param name="outputModel">The output static model data.</param>
+    /// <param name="outputTexture">The output vertex animation texture data.</param>
+    /// <returns>True if fails, otherwise false.</returns>
+    static bool BakeVertexAnimation(class SkinnedModel* model, class Animation* animation, float framesPerSecond, ModelData& outputModel, class TextureData& outputTexture);
+
 public:
 
     static int32 DetectLodIndex(const String& nodeName);
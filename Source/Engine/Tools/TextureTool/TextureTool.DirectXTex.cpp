@@ -13,6 +13,8 @@
 #include "Engine/Graphics/Textures/TextureUtils.h"
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Engine/Graphics/GPUDevice.h"
 #endif
@@ -37,6 +39,60 @@ namespace
         return static_cast<DXGI_FORMAT>(format);
     }
 
+    HRESULT CompressParallel(const DirectX::Image* srcImages, size_t nimages, const DirectX::TexMetadata& metadata, DXGI_FORMAT format, DWORD compress, float threshold, DirectX::ScratchImage& cImages)
+    {
+        DirectX::TexMetadata dstMetadata = metadata;
+        dstMetadata.format = format;
+        HRESULT result = cImages.Initialize(dstMetadata);
+        if (FAILED(result))
+            return result;
+        if (cImages.GetImageCount() != nimages)
+            return E_FAIL;
+
+        // Split all images (array slices, mip maps and depth slices) into jobs (ranges of the block rows)
+        struct CompressJob
+        {
+            int32 ImageIndex;
+            int32 Y;
+            int32 Height;
+        };
+        Array<CompressJob> jobs;
+        for (int32 imageIndex = 0; imageIndex < (int32)nimages; imageIndex++)
+        {
+            const int32 height = (int32)srcImages[imageIndex].height;
+            for (int32 y = 0; y < height; y += TEXTURE_TOOL_COMPRESS_JOB_BLOCK_ROWS * 4)
+                jobs.Add({ imageIndex, y, Math::Min(TEXTURE_TOOL_COMPRESS_JOB_BLOCK_ROWS * 4, height - y) });
+        }
+
+        // Compress every part into the temporary image and copy the blocks into the destination image
+        int64 failedJobs = 0;
+        const DirectX::Image* dstImages = cImages.GetImages();
+        const Function<void(int32)> compressJob = [&jobs, &failedJobs, srcImages, dstImages, format, compress, threshold](int32 jobIndex)
+        {
+            PROFILE_CPU_NAMED("Texture Compress Job");
+            const CompressJob& job = jobs[jobIndex];
+            const DirectX::Image& srcImage = srcImages[job.ImageIndex];
+            const DirectX::Image& dstImage = dstImages[job.ImageIndex];
+            DirectX::Image srcPart = srcImage;
+            srcPart.height = job.Height;
+            srcPart.pixels = srcImage.pixels + srcImage.rowPitch * job.Y;
+            srcPart.slicePitch = srcImage.rowPitch * job.Height;
+            DirectX::ScratchImage dstPart;
+            if (FAILED(DirectX::Compress(srcPart, format, compress & ~DirectX::TEX_COMPRESS_PARALLEL, threshold, dstPart)))
+            {
+                Platform::InterlockedIncrement(&failedJobs);
+                return;
+            }
+            const DirectX::Image& part = *dstPart.GetImage(0, 0, 0);
+            const size_t rowSize = Math::Min(part.rowPitch, dstImage.rowPitch);
+            const size_t blockRow = job.Y / 4;
+            for (size_t row = 0; row < (size_t)Math::DivideAndRoundUp(job.Height, 4); row++)
+                Platform::MemoryCopy(dstImage.pixels + (blockRow + row) * dstImage.rowPitch, part.pixels + row * part.rowPitch, rowSize);
+        };
+        JobSystem::Execute(compressJob, jobs.Count());
+        return failedJobs == 0 ? S_OK : E_FAIL;
+    }
+
     HRESULT Compress(const DirectX::Image* srcImages, size_t nimages, const DirectX::TexMetadata& metadata, DXGI_FORMAT format, DWORD compress, float threshold, DirectX::ScratchImage& cImages)
     {
 #if USE_EDITOR
@@ -112,7 +168,7 @@ namespace
             return task->CompressResult;
         }
 #endif
-        return DirectX::Compress(srcImages, nimages, metadata, format, compress, threshold, cImages);
+        return CompressParallel(srcImages, nimages, metadata, format, compress, threshold, cImages);
     }
 }
 
@@ -9,6 +9,9 @@
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Core/ISerializable.h"
 
+// The amount of 4x4 block rows compressed by a single job (texture compression is split into jobs per array slice, mip map and range of the block rows)
+#define TEXTURE_TOOL_COMPRESS_JOB_BLOCK_ROWS 16
+
 class JsonWriter;
 
 /// <summary>
@@ -12,6 +12,8 @@
 #include "Engine/Graphics/Textures/TextureUtils.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Platform/File.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 
 #define STBI_ASSERT(x) ASSERT(x)
 #define STBI_MALLOC(sz) Allocator::Allocate(sz)
@@ -561,6 +563,22 @@ bool TextureTool::ConvertStb(TextureData& dst, const TextureData& src, const Pix
         }
         bool isDstSRGB = PixelFormatExtensions::IsSRGB(dstFormat);
 
+        switch (dstFormat)
+        {
+        case PixelFormat::BC1_UNorm:
+        case PixelFormat::BC1_UNorm_sRGB:
+        case PixelFormat::BC3_UNorm:
+        case PixelFormat::BC3_UNorm_sRGB:
+        case PixelFormat::BC4_UNorm:
+        case PixelFormat::BC5_UNorm:
+        case PixelFormat::BC7_UNorm:
+        case PixelFormat::BC7_UNorm_sRGB:
+            break;
+        default:
+            LOG(Warning, "Cannot compress image. Unsupported format {0}", static_cast<int32>(dstFormat));
+            return true;
+        }
+
         // bc7enc init
         bc7enc16_compress_block_params params;
         if (dstFormat == PixelFormat::BC7_UNorm || dstFormat == PixelFormat::BC7_UNorm_sRGB)
@@ -568,83 +586,103 @@ bool TextureTool::ConvertStb(TextureData& dst, const TextureData& src, const Pix
             bc7enc16_compress_block_params_init(&params);
             bc7enc16_compress_block_init();
         }
+        else
+        {
+            // Warm up stb_dxt tables (lazy-initialized on the first use which is not thread-safe)
+            byte dummyBlock[16];
+            Color32 dummySrc[16] = {};
+            stb_compress_dxt_block(dummyBlock, (byte*)&dummySrc, 0, STB_DXT_HIGHQUAL);
+        }
 
-        // Compress all array slices
+        // Allocate memory for all array slices and mip levels and split them into jobs (ranges of the blocks rows)
+        struct CompressJob
+        {
+            int32 ArrayIndex;
+            int32 MipIndex;
+            int32 BlockRowStart;
+            int32 BlockRowEnd;
+        };
+        Array<CompressJob> jobs;
         for (int32 arrayIndex = 0; arrayIndex < arraySize; arrayIndex++)
         {
             const auto& srcSlice = textureData->Items[arrayIndex];
             auto& dstSlice = dst.Items[arrayIndex];
             auto mipLevels = srcSlice.Mips.Count();
             dstSlice.Mips.Resize(mipLevels, false);
-
-            // Compress all mip levels
             for (int32 mipIndex = 0; mipIndex < mipLevels; mipIndex++)
             {
-                const auto& srcMip = srcSlice.Mips[mipIndex];
                 auto& dstMip = dstSlice.Mips[mipIndex];
                 auto mipWidth = Math::Max(textureData->Width >> mipIndex, 1);
                 auto mipHeight = Math::Max(textureData->Height >> mipIndex, 1);
                 auto blocksWidth = Math::Max(Math::DivideAndRoundUp(mipWidth, 4), 1);
                 auto blocksHeight = Math::Max(Math::DivideAndRoundUp(mipHeight, 4), 1);
-
-                // Allocate memory
                 dstMip.RowPitch = blocksWidth * bytesPerBlock;
                 dstMip.DepthPitch = dstMip.RowPitch * blocksHeight;
                 dstMip.Lines = blocksHeight;
                 dstMip.Data.Allocate(dstMip.DepthPitch);
+                for (int32 blockRow = 0; blockRow < blocksHeight; blockRow += TEXTURE_TOOL_COMPRESS_JOB_BLOCK_ROWS)
+                    jobs.Add({ arrayIndex, mipIndex, blockRow, Math::Min(blockRow + TEXTURE_TOOL_COMPRESS_JOB_BLOCK_ROWS, blocksHeight) });
+            }
+        }
 
-                // Compress texture
-                for (int32 yBlock = 0; yBlock < blocksHeight; yBlock++)
+        // Compress texture (in parallel)
+        const Function<void(int32)> compressJob = [&jobs, &textureData, &dst, &params, sampler, dstFormat, bytesPerBlock, isDstSRGB](int32 jobIndex)
+        {
+            PROFILE_CPU_NAMED("Texture Compress Job");
+            const CompressJob& job = jobs[jobIndex];
+            const auto& srcMip = textureData->Items[job.ArrayIndex].Mips[job.MipIndex];
+            auto& dstMip = dst.Items[job.ArrayIndex].Mips[job.MipIndex];
+            auto blocksWidth = dstMip.RowPitch / bytesPerBlock;
+            for (int32 yBlock = job.BlockRowStart; yBlock < job.BlockRowEnd; yBlock++)
+            {
+                for (int32 xBlock = 0; xBlock < blocksWidth; xBlock++)
                 {
-                    for (int32 xBlock = 0; xBlock < blocksWidth; xBlock++)
+                    // Sample source texture 4x4 block
+                    Color32 srcBlock[16];
+                    for (int32 y = 0; y < 4; y++)
                     {
-                        // Sample source texture 4x4 block
-                        Color32 srcBlock[16];
-                        for (int32 y = 0; y < 4; y++)
+                        for (int32 x = 0; x < 4; x++)
                         {
-                            for (int32 x = 0; x < 4; x++)
-                            {
-                                Color color = TextureTool::SamplePoint(sampler, xBlock * 4 + x, yBlock * 4 + y, srcMip.Data.Get(), srcMip.RowPitch);
-                                if (isDstSRGB)
-                                    color = Color::LinearToSrgb(color);
-                                srcBlock[y * 4 + x] = Color32(color);
-                            }
+                            Color color = TextureTool::SamplePoint(sampler, xBlock * 4 + x, yBlock * 4 + y, srcMip.Data.Get(), srcMip.RowPitch);
+                            if (isDstSRGB)
+                                color = Color::LinearToSrgb(color);
+                            srcBlock[y * 4 + x] = Color32(color);
                         }
+                    }
 
-                        // Compress block
-                        byte* dstBlock = dstMip.Data.Get() + (yBlock * blocksWidth + xBlock) * bytesPerBlock;
-                        switch (dstFormat)
-                        {
-                        case PixelFormat::BC1_UNorm:
-                        case PixelFormat::BC1_UNorm_sRGB:
-                            stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 0, STB_DXT_HIGHQUAL);
-                            break;
-                        case PixelFormat::BC3_UNorm:
-                        case PixelFormat::BC3_UNorm_sRGB:
-                            stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 1, STB_DXT_HIGHQUAL);
-                            break;
-                        case PixelFormat::BC4_UNorm:
-                            for (int32 i = 1; i < 16; i++)
-                                ((byte*)&srcBlock)[i] = srcBlock[i].R;
-                            stb_compress_bc4_block(dstBlock, (byte*)&srcBlock);
-                            break;
-                        case PixelFormat::BC5_UNorm:
-                            for (int32 i = 0; i < 16; i++)
-                                ((uint16*)&srcBlock)[i] = srcBlock[i].R << 8 | srcBlock[i].G;
-                            stb_compress_bc5_block(dstBlock, (byte*)&srcBlock);
-                            break;
-                        case PixelFormat::BC7_UNorm:
-                        case PixelFormat::BC7_UNorm_sRGB:
-                            bc7enc16_compress_block(dstBlock, &srcBlock, &params);
-                            break;
-                        default:
-                            LOG(Warning, "Cannot compress image. Unsupported format {0}", static_cast<int32>(dstFormat));
-                            return true;
-                        }
+                    // Compress block
+                    byte* dstBlock = dstMip.Data.Get() + (yBlock * blocksWidth + xBlock) * bytesPerBlock;
+                    switch (dstFormat)
+                    {
+                    case PixelFormat::BC1_UNorm:
+                    case PixelFormat::BC1_UNorm_sRGB:
+                        stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 0, STB_DXT_HIGHQUAL);
+                        break;
+                    case PixelFormat::BC3_UNorm:
+                    case PixelFormat::BC3_UNorm_sRGB:
+                        stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 1, STB_DXT_HIGHQUAL);
+                        break;
+                    case PixelFormat::BC4_UNorm:
+                        for (int32 i = 1; i < 16; i++)
+                            ((byte*)&srcBlock)[i] = srcBlock[i].R;
+                        stb_compress_bc4_block(dstBlock, (byte*)&srcBlock);
+                        break;
+                    case PixelFormat::BC5_UNorm:
+                        for (int32 i = 0; i < 16; i++)
+                            ((uint16*)&srcBlock)[i] = srcBlock[i].R << 8 | srcBlock[i].G;
+                        stb_compress_bc5_block(dstBlock, (byte*)&srcBlock);
+                        break;
+                    case PixelFormat::BC7_UNorm:
+                    case PixelFormat::BC7_UNorm_sRGB:
+                        bc7enc16_compress_block(dstBlock, &srcBlock, &params);
+                        break;
+                    default:
+                        break;
                     }
                 }
             }
-        }
+        };
+        JobSystem::Execute(compressJob, jobs.Count());
     }
     else
 #endif
@@ -136,6 +136,12 @@ public override Float2 PointToParent(ref Float2 location)
             return location;
         }
 
+        /// <inheritdoc />
+        public override void Invalidate()
+        {
+            _canvas.OnGUIInvalidated();
+        }
+
         /// <inheritdoc />
         public override bool ContainsPoint(ref Float2 location)
         {
@@ -220,6 +226,7 @@ public override bool OnCharInput(char c)
             if (!_canvas.ReceivesEvents)
                 return false;
 
+            Invalidate();
             return base.OnCharInput(c);
         }
 
@@ -265,6 +272,7 @@ public override bool OnKeyDown(KeyboardKeys key)
             if (!_canvas.ReceivesEvents)
                 return false;
 
+            Invalidate();
             return base.OnKeyDown(key);
         }
 
@@ -292,6 +300,7 @@ public override bool OnMouseDown(Float2 location, MouseButton button)
             if (!_canvas.ReceivesEvents)
                 return false;
 
+            Invalidate();
             return base.OnMouseDown(location, button);
         }
 
@@ -332,6 +341,7 @@ public override bool OnMouseUp(Float2 location, MouseButton button)
             if (!_canvas.ReceivesEvents)
                 return false;
 
+            Invalidate();
             return base.OnMouseUp(location, button);
         }
 
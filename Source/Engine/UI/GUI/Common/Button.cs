@@ -36,7 +36,11 @@ public class Button : ContainerControl
         public LocalizedString Text
         {
             get => _text;
-            set => _text = value;
+            set
+            {
+                _text = value;
+                Invalidate();
+            }
         }
 
         /// <summary>
@@ -179,6 +183,7 @@ protected virtual void OnClick()
         protected virtual void OnPressBegin()
         {
             _isPressed = true;
+            Invalidate();
             if (AutoFocus)
                 Focus();
         }
@@ -189,6 +194,7 @@ protected virtual void OnPressBegin()
         protected virtual void OnPressEnd()
         {
             _isPressed = false;
+            Invalidate();
         }
 
         /// <summary>
@@ -68,6 +68,7 @@ public CheckBoxState State
                 if (_state != value)
                 {
                     _state = value;
+                    Invalidate();
 
                     StateChanged?.Invoke(this);
                 }
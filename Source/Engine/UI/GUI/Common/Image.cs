@@ -10,11 +10,24 @@ namespace FlaxEngine.GUI
     /// <seealso cref="FlaxEngine.GUI.ContainerControl" />
     public class Image : ContainerControl
     {
+        private IBrush _brush;
+
         /// <summary>
         /// Gets or sets the image source.
         /// </summary>
         [EditorOrder(10), Tooltip("The image to draw.")]
-        public IBrush Brush { get; set; }
+        public IBrush Brush
+        {
+            get => _brush;
+            set
+            {
+                if (_brush != value)
+                {
+                    _brush = value;
+                    Invalidate();
+                }
+            }
+        }
 
         /// <summary>
         /// Gets or sets the margin for the image.
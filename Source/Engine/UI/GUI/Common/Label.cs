@@ -40,6 +40,7 @@ public LocalizedString Text
                     _text = value;
                     _textSize = Float2.Zero;
                     PerformLayout();
+                    Invalidate();
                 }
             }
         }
@@ -91,6 +91,7 @@ public float Value
                     if (!UseSmoothing)
                     {
                         _current = _value;
+                        Invalidate();
                     }
                 }
             }
@@ -150,10 +151,12 @@ public override void Update(float deltaTime)
                     if (!isDeltaSlow && UseSmoothing)
                         value = Mathf.Lerp(_current, _value, Mathf.Saturate(deltaTime * 5.0f * SmoothingScale));
                     _current = value;
+                    Invalidate();
                 }
-                else
+                else if (_current != _value)
                 {
                     _current = _value;
+                    Invalidate();
                 }
             }
 
@@ -62,7 +62,7 @@ public Float2 TextureSize
         /// Invalidates the cached image of children controls and invokes the redraw to the texture.
         /// </summary>
         [Tooltip("Invalidates the cached image of children controls and invokes the redraw to the texture.")]
-        public void Invalidate()
+        public override void Invalidate()
         {
             _invalid = true;
 
@@ -71,6 +71,8 @@ public void Invalidate()
                 _redrawRegistered = true;
                 Scripting.Draw += OnDraw;
             }
+
+            base.Invalidate();
         }
 
         private void OnDraw()
@@ -143,6 +145,14 @@ public override void OnChildResized(Control control)
                 Invalidate();
         }
 
+        /// <inheritdoc />
+        public override void OnChildInvalidated(Control control)
+        {
+            // Skip base to not invalidate parents if the cached image stays the same
+            if (AutomaticInvalidate)
+                Invalidate();
+        }
+
         /// <inheritdoc />
         public override void OnChildrenChanged()
         {
@@ -1035,6 +1035,7 @@ protected virtual void OnEditEnd()
         protected virtual void OnTextChanged()
         {
             _textSize = GetTextSize();
+            Invalidate();
             TextChanged?.Invoke();
         }
 
@@ -1046,8 +1047,13 @@ public override void Update(float deltaTime)
             _animateTime += deltaTime;
 
             // Animate view offset
+            var viewOffset = _viewOffset;
             _viewOffset = isDeltaSlow ? _targetViewOffset : Float2.Lerp(_viewOffset, _targetViewOffset, deltaTime * 20.0f);
 
+            // Redraw cached UI when animating view or caret blinking
+            if (IsFocused || viewOffset != _viewOffset)
+                Invalidate();
+
             // Clicking outside of the text box will end text editing. Left will keep the value, right will restore original value
             if (_isEditing && EndEditOnClick)
             {
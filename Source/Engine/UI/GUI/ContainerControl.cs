@@ -280,6 +280,7 @@ internal void ChangeChildIndex(Control child, int newIndex)
             }
 
             PerformLayout();
+            Invalidate();
         }
 
         /// <summary>
@@ -414,6 +415,15 @@ public virtual void OnChildResized(Control control)
         {
         }
 
+        /// <summary>
+        /// Called when child control visuals get modified (see <see cref="Control.Invalidate"/>).
+        /// </summary>
+        /// <param name="control">The modified control.</param>
+        public virtual void OnChildInvalidated(Control control)
+        {
+            Invalidate();
+        }
+
         /// <summary>
         /// Called when children collection gets changed (child added or removed).
         /// </summary>
@@ -425,6 +435,7 @@ public virtual void OnChildrenChanged()
             {
                 // Arrange child controls
                 PerformLayout();
+                Invalidate();
             }
         }
 
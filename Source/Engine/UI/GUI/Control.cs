@@ -170,7 +170,14 @@ public int IndexInParent
         public Color BackgroundColor
         {
             get => _backgroundColor;
-            set => _backgroundColor = value;
+            set
+            {
+                if (_backgroundColor != value)
+                {
+                    _backgroundColor = value;
+                    Invalidate();
+                }
+            }
         }
 
         /// <summary>
@@ -217,6 +224,7 @@ public bool Enabled
                     _isEnabled = value;
                     if (!_isEnabled)
                         ClearState();
+                    Invalidate();
                 }
             }
         }
@@ -421,6 +429,15 @@ public virtual void Draw()
             }
         }
 
+        /// <summary>
+        /// Marks the control visuals as modified. Used by the retained rendering (eg. <see cref="RenderToTextureControl"/> or <see cref="UICanvas.CacheRendering"/>) to redraw the cached contents of the parent controls. Should be called by the custom controls when their appearance changes (eg. on property change or animation).
+        /// </summary>
+        [NoAnimate]
+        public virtual void Invalidate()
+        {
+            _parent?.OnChildInvalidated(this);
+        }
+
         /// <summary>
         /// Update control layout
         /// </summary>
@@ -502,6 +519,7 @@ public virtual void OnGotFocus()
             // Cache flag
             _isFocused = true;
             _isNavFocused = false;
+            Invalidate();
         }
 
         /// <summary>
@@ -513,6 +531,7 @@ public virtual void OnLostFocus()
             // Clear flag
             _isFocused = false;
             _isNavFocused = false;
+            Invalidate();
         }
 
         /// <summary>
@@ -701,6 +720,7 @@ public virtual void OnMouseEnter(Float2 location)
         {
             // Set flag
             _isMouseOver = true;
+            Invalidate();
 
             // Update tooltip
             if (ShowTooltip && OnTestTooltipOverControl(ref location))
@@ -741,6 +761,7 @@ public virtual void OnMouseLeave()
         {
             // Clear flag
             _isMouseOver = false;
+            Invalidate();
 
             // Update tooltip
             if (_tooltipUpdate != null)
@@ -1269,6 +1290,7 @@ public virtual Float2 PointFromScreen(Float2 location)
         protected virtual void OnLocationChanged()
         {
             LocationChanged?.Invoke(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1278,6 +1300,7 @@ protected virtual void OnSizeChanged()
         {
             SizeChanged?.Invoke(this);
             _parent?.OnChildResized(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1289,6 +1312,7 @@ protected virtual void SetScaleInternal(ref Float2 scale)
             _scale = scale;
             UpdateTransform();
             _parent?.OnChildResized(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1300,6 +1324,7 @@ protected virtual void SetPivotInternal(ref Float2 pivot)
             _pivot = pivot;
             UpdateTransform();
             _parent?.OnChildResized(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1311,6 +1336,7 @@ protected virtual void SetShearInternal(ref Float2 shear)
             _shear = shear;
             UpdateTransform();
             _parent?.OnChildResized(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1322,6 +1348,7 @@ protected virtual void SetRotationInternal(float rotation)
             _rotation = rotation;
             UpdateTransform();
             _parent?.OnChildResized(this);
+            Invalidate();
         }
 
         /// <summary>
@@ -1336,6 +1363,7 @@ protected virtual void OnVisibleChanged()
             }
 
             VisibleChanged?.Invoke(this);
+            _parent?.OnChildInvalidated(this);
         }
 
         /// <summary>
@@ -301,6 +301,7 @@ private void OnUpdate(float deltaTime)
             {
                 SetUpdate(ref _update, null);
             }
+            Invalidate();
         }
 
         /// <summary>
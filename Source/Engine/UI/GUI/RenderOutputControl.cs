@@ -177,6 +177,10 @@ private void OnUpdate()
             {
                 SyncBackbufferSize();
             }
+
+            // Output changes every frame
+            if (_task.Enabled)
+                Invalidate();
         }
 
         /// <inheritdoc />
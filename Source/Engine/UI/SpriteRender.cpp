@@ -9,7 +9,53 @@
 #include "Engine/Content/Assets/MaterialInstance.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Level/Actors/Camera.h"
+#include "Engine/Renderer/Utils/SpriteBatching.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    // The quad model geometry copied from the mesh CPU data (used by the sprites batching)
+    CriticalSection QuadLocker;
+    volatile int32 QuadState = 0; // 0 - not loaded, 1 - loaded, 2 - failed
+    BytesContainer QuadVB0, QuadVB1, QuadIB;
+    SpriteBatching::Geometry QuadGeometry;
+
+    bool GetQuadGeometry(Model* model, SpriteBatching::Geometry& geometry)
+    {
+        if (QuadState == 0)
+        {
+            ScopeLock lock(QuadLocker);
+            if (QuadState == 0)
+            {
+                const Mesh& mesh = model->LODs[0].Meshes[0];
+                BytesContainer vb0, vb1, ib;
+                int32 verticesCount, indicesCount;
+                if (mesh.DownloadDataCPU(MeshBufferType::Vertex0, vb0, verticesCount) ||
+                    mesh.DownloadDataCPU(MeshBufferType::Vertex1, vb1, verticesCount) ||
+                    mesh.DownloadDataCPU(MeshBufferType::Index, ib, indicesCount))
+                {
+                    Platform::AtomicStore(&QuadState, 2);
+                    return true;
+                }
+                QuadVB0.Copy(vb0);
+                QuadVB1.Copy(vb1);
+                QuadIB.Copy(ib);
+                QuadGeometry.VB0 = (const VB0ElementType*)QuadVB0.Get();
+                QuadGeometry.VB1 = (const VB1ElementType*)QuadVB1.Get();
+                QuadGeometry.VB2 = nullptr;
+                QuadGeometry.VerticesCount = verticesCount;
+                QuadGeometry.Indices = QuadIB.Get();
+                QuadGeometry.IndicesCount = indicesCount;
+                QuadGeometry.BaseVertex = 0;
+                QuadGeometry.Use16BitIndices = mesh.Use16BitIndexBuffer();
+                Platform::AtomicStore(&QuadState, 1);
+            }
+        }
+        geometry = QuadGeometry;
+        return QuadState != 1;
+    }
+}
 
 SpriteRender::SpriteRender(const SpawnParams& params)
     : Actor(params)
@@ -83,16 +129,23 @@ void SpriteRender::OnMaterialLoaded()
         _paramColor->SetValue(_color);
 }
 
-void SpriteRender::SetImage()
+void SpriteRender::GetImage(TextureBase*& image, Vector4& imageMAD) const
 {
-    TextureBase* image = Image.Get();
-    Vector4 imageMAD(Vector2::One, Vector2::Zero);
+    image = Image.Get();
+    imageMAD = Vector4(Vector2::One, Vector2::Zero);
     if (!image && _sprite.IsValid())
     {
         image = _sprite.Atlas.Get();
-        Sprite* sprite = &_sprite.Atlas->Sprites.At(_sprite.Index);
+        const Sprite* sprite = &_sprite.Atlas->Sprites.At(_sprite.Index);
         imageMAD = Vector4(sprite->Area.Size, sprite->Area.Location);
     }
+}
+
+void SpriteRender::SetImage()
+{
+    TextureBase* image;
+    Vector4 imageMAD;
+    GetImage(image, imageMAD);
     if (_paramImage)
         _paramImage->SetValue(image);
     if (_paramImageMAD)
@@ -130,6 +183,26 @@ void SpriteRender::Draw(RenderContext& renderContext)
         view.GetWorldMatrix(_transform, m2);
         Matrix::Multiply(m1, m2, world);
     }
+
+    // Try to merge the sprite with other sprites using the same material and parameters (drawn with a single draw call)
+    SpriteBatching::Geometry geometry;
+    if (_materialInstance && !GetQuadGeometry(model, geometry))
+    {
+        TextureBase* image;
+        Vector4 imageMAD;
+        GetImage(image, imageMAD);
+        SpriteBatching::Key key;
+        key.Material = Material.Get();
+        key.Texture = image;
+        key.Params = imageMAD;
+        key.Color = _color;
+        key.DrawModes = DrawModes & view.Pass & Material->GetDrawModes();
+        key.StaticFlags = GetStaticFlags();
+        key.SortOrder = SortOrder;
+        if (!SpriteBatching::Instance()->Add(renderContext, key, _materialInstance, world, geometry))
+            return;
+    }
+
     model->LODs[0].Draw(renderContext, _materialInstance, world, GetStaticFlags(), false, DrawModes, GetPerInstanceRandom(), SortOrder);
 }
 
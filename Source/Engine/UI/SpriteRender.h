@@ -92,6 +92,7 @@ class FLAXENGINE_API SpriteRender : public Actor
 
 private:
     void OnMaterialLoaded();
+    void GetImage(TextureBase*& image, Vector4& imageMAD) const;
     void SetImage();
 
 public:
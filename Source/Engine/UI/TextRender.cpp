@@ -13,6 +13,7 @@
 #include "Engine/Render2D/FontManager.h"
 #include "Engine/Render2D/FontTextureAtlas.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/Utils/SpriteBatching.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Content/Assets/MaterialInstance.h"
 #include "Engine/Content/Content.h"
@@ -149,6 +150,7 @@ void TextRender::UpdateLayout()
     // Pick a font (remove DPI text scale as the text is being placed in the world)
     auto font = Font->CreateFont(_size);
     float scale = 1.0f / FontManager::FontScale;
+    const float glyphScale = font->GetGlyphScale();
 
     // Prepare
     FontTextureAtlas* fontAtlas = nullptr;
@@ -191,6 +193,11 @@ void TextRender::UpdateLayout()
             if (c != '\n')
             {
                 font->GetCharacter(c, entry);
+                if (entry.IsPending)
+                {
+                    // Update layout again once the character gets rasterized
+                    _isDirty = true;
+                }
 
                 // Check if need to select/change font atlas (since characters even in the same font may be located in different atlases)
                 if (fontAtlas == nullptr || entry.TextureIndex != drawChunk.FontAtlasIndex)
@@ -255,7 +262,7 @@ void TextRender::UpdateLayout()
                     const float x = pointer.X + (float)entry.OffsetX * scale;
                     const float y = pointer.Y + (float)(font->GetHeight() + font->GetDescender() - entry.OffsetY) * scale;
 
-                    Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
+                    Rectangle charRect(x, y, entry.UVSize.X * glyphScale * scale, entry.UVSize.Y * glyphScale * scale);
                     charRect.Offset(_layoutOptions.Bounds.Location);
 
                     Float2 upperLeftUV = entry.UV * invAtlasSize;
@@ -383,12 +390,38 @@ void TextRender::Draw(RenderContext& renderContext)
         drawCall.Geometry.VertexBuffersOffsets[2] = 0;
         drawCall.InstanceCount = 1;
 
+        // Static text can be merged with other texts using the same material and font atlas (batched geometry has no motion vectors)
+        const bool canBatch = !EnumHasAnyFlags(drawModes, DrawPass::MotionVectors) || _drawState.PrevWorld == world;
+        SpriteBatching::Geometry geometry;
+        geometry.Use16BitIndices = true;
+
         // Submit draw calls
         for (const auto& e : _drawChunks)
         {
             const DrawPass chunkDrawModes = drawModes & e.Material->GetDrawModes();
             if (chunkDrawModes == DrawPass::None)
                 continue;
+            if (canBatch)
+            {
+                // Every character uses 4 vertices and 6 indices
+                geometry.BaseVertex = e.StartIndex / 6 * 4;
+                geometry.VerticesCount = e.IndicesCount / 6 * 4;
+                geometry.VB0 = (const VB0ElementType*)_vb0.Data.Get() + geometry.BaseVertex;
+                geometry.VB1 = (const VB1ElementType*)_vb1.Data.Get() + geometry.BaseVertex;
+                geometry.VB2 = (const VB2ElementType*)_vb2.Data.Get() + geometry.BaseVertex;
+                geometry.Indices = (const uint16*)_ib.Data.Get() + e.StartIndex;
+                geometry.IndicesCount = e.IndicesCount;
+                SpriteBatching::Key key;
+                key.Material = Material.Get();
+                key.Texture = FontManager::GetAtlas(e.FontAtlasIndex);
+                key.Params = Float4::Zero;
+                key.Color = Color::Transparent;
+                key.DrawModes = chunkDrawModes;
+                key.StaticFlags = GetStaticFlags();
+                key.SortOrder = SortOrder;
+                if (!SpriteBatching::Instance()->Add(renderContext, key, e.Material, world, geometry))
+                    continue;
+            }
             drawCall.Draw.IndicesCount = e.IndicesCount;
             drawCall.Draw.StartIndex = e.StartIndex;
             drawCall.Material = e.Material;
@@ -81,11 +81,29 @@ public override void Render(GPUContext context, ref RenderContext renderContext,
             // Pick a depth buffer
             GPUTexture depthBuffer = Canvas.IgnoreDepth ? null : renderContext.Buffers.DepthBuffer;
 
+            // Redraw cached GUI only if it was modified
+            var cache = Canvas.CacheRendering ? Canvas.UpdateCache(context) : null;
+
             // Render GUI in 3D
             var features = Render2D.Features;
             if (Canvas.RenderMode == CanvasRenderMode.WorldSpace || Canvas.RenderMode == CanvasRenderMode.WorldSpaceFaceCamera)
                 Render2D.Features &= ~Render2D.RenderingFeatures.VertexSnapping;
-            Render2D.CallDrawing(Canvas.GUI, context, input, depthBuffer, ref viewProjectionMatrix);
+            if (cache != null)
+            {
+                Render2D.Begin(context, input, depthBuffer, ref viewProjectionMatrix);
+                try
+                {
+                    Render2D.DrawTexture(cache, new Rectangle(Float2.Zero, Canvas.GUI.Size));
+                }
+                finally
+                {
+                    Render2D.End();
+                }
+            }
+            else
+            {
+                Render2D.CallDrawing(Canvas.GUI, context, input, depthBuffer, ref viewProjectionMatrix);
+            }
             Render2D.Features = features;
 
             Profiler.EndEventGPU();
@@ -98,6 +116,8 @@ partial class UICanvas
         private readonly CanvasRootControl _guiRoot;
         private CanvasRenderer _renderer;
         private bool _isLoading, _isRegisteredForTick;
+        private bool _cacheRendering, _isCacheInvalid = true;
+        private GPUTexture _cacheTexture;
 
         /// <summary>
         /// Gets or sets the canvas rendering mode.
@@ -186,6 +206,24 @@ public Float2 Size
         [EditorOrder(30), EditorDisplay("Canvas"), VisibleIf("Editor_Is3D"), Tooltip("If checked, scene depth will be ignored when rendering the GUI (scene objects won't cover the interface).")]
         public bool IgnoreDepth { get; set; } = false;
 
+        /// <summary>
+        /// Gets or sets a value indicating whether cache the 3D canvas GUI in a texture that is redrawn only when any of the controls gets modified (see <see cref="Control.Invalidate"/>). Unchanged canvas is drawn as a single textured quad. Used only in <see cref="CanvasRenderMode.CameraSpace"/> or <see cref="CanvasRenderMode.WorldSpace"/> or <see cref="CanvasRenderMode.WorldSpaceFaceCamera"/>.
+        /// </summary>
+        [EditorOrder(35), EditorDisplay("Canvas"), VisibleIf("Editor_Is3D"), Tooltip("If checked, the GUI is rendered into the cached texture that is updated only when any of the controls gets modified. Reduces the rendering cost of the static interface. Texture resolution matches the canvas size.")]
+        public bool CacheRendering
+        {
+            get => _cacheRendering;
+            set
+            {
+                if (_cacheRendering == value)
+                    return;
+                _cacheRendering = value;
+                _isCacheInvalid = true;
+                if (!value)
+                    Destroy(ref _cacheTexture);
+            }
+        }
+
         /// <summary>
         /// Gets or sets the camera used to place the GUI when render mode is set to <see cref="CanvasRenderMode.CameraSpace"/> or <see cref="CanvasRenderMode.WorldSpaceFaceCamera"/>.
         /// </summary>
@@ -556,6 +594,41 @@ private void Setup()
             }
         }
 
+        internal void OnGUIInvalidated()
+        {
+            _isCacheInvalid = true;
+        }
+
+        internal GPUTexture UpdateCache(GPUContext context)
+        {
+            var size = _guiRoot.Size;
+            var width = Mathf.Clamp(Mathf.CeilToInt(size.X), 1, 4096);
+            var height = Mathf.Clamp(Mathf.CeilToInt(size.Y), 1, 4096);
+            if (!_cacheTexture)
+                _cacheTexture = new GPUTexture();
+            if (_cacheTexture.Width != width || _cacheTexture.Height != height)
+            {
+                var desc = GPUTextureDescription.New2D(width, height, PixelFormat.R8G8B8A8_UNorm);
+                if (_cacheTexture.Init(ref desc))
+                {
+                    Debug.Logger.LogHandler.LogWrite(LogType.Error, "Failed to allocate texture for UICanvas rendering cache");
+                    Destroy(ref _cacheTexture);
+                    return null;
+                }
+                _isCacheInvalid = true;
+            }
+            if (_isCacheInvalid)
+            {
+                // Clear flag before drawing so controls modified during drawing will be redrawn in the next frame
+                _isCacheInvalid = false;
+                Profiler.BeginEventGPU("Update Cache");
+                context.Clear(_cacheTexture.View(), Color.Transparent);
+                Render2D.CallDrawing(_guiRoot, context, _cacheTexture);
+                Profiler.EndEventGPU();
+            }
+            return _cacheTexture;
+        }
+
         private void OnUpdate()
         {
             if (this && IsActiveInHierarchy && _renderMode != CanvasRenderMode.ScreenSpace)
@@ -599,6 +672,9 @@ internal string Serialize()
                 jsonWriter.WritePropertyName("IgnoreDepth");
                 jsonWriter.WriteValue(IgnoreDepth);
 
+                jsonWriter.WritePropertyName("CacheRendering");
+                jsonWriter.WriteValue(CacheRendering);
+
                 jsonWriter.WritePropertyName("RenderCamera");
                 jsonWriter.WriteValue(Json.JsonSerializer.GetStringID(RenderCamera));
 
@@ -677,6 +753,12 @@ internal string SerializeDiff(UICanvas other)
                     jsonWriter.WriteValue(IgnoreDepth);
                 }
 
+                if (CacheRendering != other.CacheRendering)
+                {
+                    jsonWriter.WritePropertyName("CacheRendering");
+                    jsonWriter.WriteValue(CacheRendering);
+                }
+
                 if (RenderCamera != other.RenderCamera)
                 {
                     jsonWriter.WritePropertyName("RenderCamera");
@@ -828,6 +910,7 @@ internal void EndPlay()
                 Destroy(_renderer);
                 _renderer = null;
             }
+            Destroy(ref _cacheTexture);
         }
 
 #if FLAX_EDITOR
@@ -627,9 +627,8 @@ void GraphUtilities::ApplySomeMathHere(Variant& v, Variant& a, Variant& b, Varia
     }
 }
 
-void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a)
+GraphUtilities::MathOp1 GraphUtilities::GetMathOp1(uint16 typeId)
 {
-    // Select operation
     MathOp1 op;
     switch (typeId)
     {
@@ -748,16 +747,24 @@ void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a)
     }
 
     default:
-        return;
+        return nullptr;
     }
+    return op;
+}
+
+void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a)
+{
+    // Select operation
+    const MathOp1 op = GetMathOp1(typeId);
+    if (!op)
+        return;
 
     // Perform operation
     ApplySomeMathHere(v, a, op);
 }
 
-void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a, Variant& b)
+GraphUtilities::MathOp2 GraphUtilities::GetMathOp2(uint16 typeId)
 {
-    // Select operation
     MathOp2 op;
     switch (typeId)
     {
@@ -822,8 +829,17 @@ void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a, Va
         };
         break;
     default:
-        return;
+        return nullptr;
     }
+    return op;
+}
+
+void GraphUtilities::ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a, Variant& b)
+{
+    // Select operation
+    const MathOp2 op = GetMathOp2(typeId);
+    if (!op)
+        return;
 
     // Perform operation
     ApplySomeMathHere(v, a, b, op);
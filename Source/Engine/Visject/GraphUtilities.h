@@ -15,6 +15,10 @@ namespace GraphUtilities
     void ApplySomeMathHere(Variant& v, Variant& a, Variant& b, MathOp2 op);
     void ApplySomeMathHere(Variant& v, Variant& a, Variant& b, Variant& c, MathOp3 op);
 
+    // Gets the per-component operation of the Math group node (null if node type is not a simple unary/binary math operation).
+    MathOp1 GetMathOp1(uint16 typeId);
+    MathOp2 GetMathOp2(uint16 typeId);
+
     void ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a);
     void ApplySomeMathHere(uint16 typeId, Variant& v, Variant& a, Variant& b);
 
@@ -151,8 +151,146 @@ void VisjectExecutor::ProcessGroupConstants(Box* box, Node* node, Value& value)
     }
 }
 
+bool VisjectExecutor::ExecuteProgram(VisjectProgram* program, Value& result)
+{
+    if (program->IsConstant)
+    {
+        result = program->Constant;
+        return true;
+    }
+    if (program->Disabled)
+        return false;
+
+    Float4 registers[VISJECT_PROGRAM_MAX_REGISTERS];
+    if (!ExecuteProgram(program, registers))
+        return false;
+    result = program->GetResult(registers);
+    return true;
+}
+
+bool VisjectExecutor::ExecuteProgram(VisjectProgram* program, Float4* registers)
+{
+    // Evaluate inputs
+    Platform::MemoryCopy(registers, program->Registers.Get(), program->Registers.Count() * sizeof(Float4));
+    for (const auto& input : program->Inputs)
+    {
+        const Value value = eatBox((Node*)input.Caller, (Box*)input.Box);
+        if (value.Type.Type != input.Type)
+        {
+            // Graph returned value of the other type than it was compiled for so fallback to the graph walking
+            program->Disabled = true;
+            return false;
+        }
+        Platform::MemoryCopy(&registers[input.Register], value.AsData, input.Components * sizeof(float));
+    }
+
+    program->Run(registers);
+    return true;
+}
+
+bool VisjectExecutor::tryGetPodValue(Box* box, VariantType::Types type, void* result)
+{
+    const Node* node = box->GetParent<Node>();
+    const Variant* value = nullptr;
+    switch (node->GroupID)
+    {
+    // Constants
+    case 2:
+        switch (node->TypeID)
+        {
+        // Constant value
+        case 1:
+        case 2:
+        case 3:
+        case 12:
+        case 15:
+            value = &node->Values[0];
+            break;
+        // Float2/3/4, Color
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+            if (box->ID == 0)
+            {
+                value = &node->Values[0];
+            }
+            else if (type == VariantType::Float && box->ID <= 4)
+            {
+                *(float*)result = ((Float4)node->Values[0]).Raw[box->ID - 1];
+                return true;
+            }
+            break;
+        // Rotation
+        case 8:
+            if (type == VariantType::Quaternion)
+            {
+                *(Quaternion*)result = Quaternion::Euler((float)node->Values[0], (float)node->Values[1], (float)node->Values[2]);
+                return true;
+            }
+            break;
+        // PI
+        case 10:
+            if (type == VariantType::Float)
+            {
+                *(float*)result = PI;
+                return true;
+            }
+            break;
+        }
+        break;
+    // Math
+    case 3:
+    {
+        VisjectProgram* program = node->Data.Math.Program;
+        if (!program)
+            break;
+        if (program->IsConstant)
+        {
+            value = &program->Constant;
+            break;
+        }
+        const int32 components = GraphUtilities::CountComponents(type);
+        if (program->Disabled || program->ResultComponents != components || type == VariantType::Int || type == VariantType::Bool)
+            break;
+        Float4 registers[VISJECT_PROGRAM_MAX_REGISTERS];
+        if (!ExecuteProgram(program, registers))
+            break;
+        Platform::MemoryCopy(result, &registers[program->ResultRegister], components * sizeof(float));
+        return true;
+    }
+    }
+    if (!value || value->Type.Type != type)
+        return false;
+
+    // Copy constant value of the matching type
+    switch (type)
+    {
+    case VariantType::Bool:
+        *(bool*)result = value->AsBool;
+        return true;
+    case VariantType::Int:
+        *(int32*)result = value->AsInt;
+        return true;
+    case VariantType::Float:
+    case VariantType::Float2:
+    case VariantType::Float3:
+    case VariantType::Float4:
+    case VariantType::Quaternion:
+        Platform::MemoryCopy(result, value->AsData, GraphUtilities::CountComponents(type == VariantType::Quaternion ? VariantType::Float4 : type) * sizeof(float));
+        return true;
+    case VariantType::Transform:
+        *(Transform*)result = *(const Transform*)value->AsBlob.Data;
+        return true;
+    default:
+        return false;
+    }
+}
+
 void VisjectExecutor::ProcessGroupMath(Box* box, Node* node, Value& value)
 {
+    if (node->Data.Math.Program && ExecuteProgram(node->Data.Math.Program, value))
+        return;
     switch (node->TypeID)
     {
     // Add, Subtract, Multiply, Divide, Modulo, Max, Min, Pow, Fmod, Atan2
@@ -406,7 +544,7 @@ void VisjectExecutor::ProcessGroupMath(Box* box, Node* node, Value& value)
     // Extract Largest Component
     case 32:
     {
-        const auto v1 = (Float3)tryGetValue(node->GetBox(0), Value::Zero);
+        const auto v1 = tryGetValue<Float3>(node->GetBox(0), Value::Zero);
         value = Math::ExtractLargestComponent(v1);
         break;
     }
@@ -416,17 +554,17 @@ void VisjectExecutor::ProcessGroupMath(Box* box, Node* node, Value& value)
         ASSERT(node->Values.Count() == 2 && node->Values[0].Type == VariantType::Float && node->Values[1].Type == VariantType::Float);
         const auto bias = node->Values[0].AsFloat;
         const auto scale = node->Values[1].AsFloat;
-        const auto input = (Float3)tryGetValue(node->GetBox(0), Value::Zero);
+        const auto input = tryGetValue<Float3>(node->GetBox(0), Value::Zero);
         value = (input + bias) * scale;
         break;
     }
     // Rotate About Axis
     case 37:
     {
-        const auto normalizedRotationAxis = (Float3)tryGetValue(node->GetBox(0), Value::Zero);
-        const auto rotationAngle = (float)tryGetValue(node->GetBox(1), Value::Zero);
-        const auto pivotPoint = (Float3)tryGetValue(node->GetBox(2), Value::Zero);
-        const auto position = (Float3)tryGetValue(node->GetBox(3), Value::Zero);
+        const auto normalizedRotationAxis = tryGetValue<Float3>(node->GetBox(0), Value::Zero);
+        const auto rotationAngle = tryGetValue<float>(node->GetBox(1), Value::Zero);
+        const auto pivotPoint = tryGetValue<Float3>(node->GetBox(2), Value::Zero);
+        const auto position = tryGetValue<Float3>(node->GetBox(3), Value::Zero);
         value = Math::RotateAboutAxis(normalizedRotationAxis, rotationAngle, pivotPoint, position);
         break;
     }
@@ -435,7 +573,7 @@ void VisjectExecutor::ProcessGroupMath(Box* box, Node* node, Value& value)
     {
         const Value a = tryGetValue(node->GetBox(0), node->Values[0]);
         const Value b = tryGetValue(node->GetBox(1), node->Values[1]).Cast(a.Type);
-        const float epsilon = (float)tryGetValue(node->GetBox(2), node->Values[2]);
+        const float epsilon = tryGetValue<float>(node->GetBox(2), node->Values[2]);
         value = Value::NearEqual(a, b, epsilon);
         break;
     }
@@ -469,8 +607,8 @@ void VisjectExecutor::ProcessGroupMath(Box* box, Node* node, Value& value)
     // Rotate Vector
     case 49:
     {
-        const Quaternion quaternion = (Quaternion)tryGetValue(node->GetBox(0), Quaternion::Identity);
-        const Float3 vector = (Float3)tryGetValue(node->GetBox(1), Float3::Forward);
+        const Quaternion quaternion = tryGetValue<Quaternion>(node->GetBox(0), Quaternion::Identity);
+        const Float3 vector = tryGetValue<Float3>(node->GetBox(1), Float3::Forward);
         value = quaternion * vector;
         break;
     }
@@ -486,41 +624,41 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     // Pack
     case 20:
     {
-        float vX = (float)tryGetValue(node->GetBox(1), node->Values[0]);
-        float vY = (float)tryGetValue(node->GetBox(2), node->Values[1]);
+        float vX = tryGetValue<float>(node->GetBox(1), node->Values[0]);
+        float vY = tryGetValue<float>(node->GetBox(2), node->Values[1]);
         value = Float2(vX, vY);
         break;
     }
     case 21:
     {
-        float vX = (float)tryGetValue(node->GetBox(1), node->Values[0]);
-        float vY = (float)tryGetValue(node->GetBox(2), node->Values[1]);
-        float vZ = (float)tryGetValue(node->GetBox(3), node->Values[2]);
+        float vX = tryGetValue<float>(node->GetBox(1), node->Values[0]);
+        float vY = tryGetValue<float>(node->GetBox(2), node->Values[1]);
+        float vZ = tryGetValue<float>(node->GetBox(3), node->Values[2]);
         value = Float3(vX, vY, vZ);
         break;
     }
     case 22:
     {
-        float vX = (float)tryGetValue(node->GetBox(1), node->Values[0]);
-        float vY = (float)tryGetValue(node->GetBox(2), node->Values[1]);
-        float vZ = (float)tryGetValue(node->GetBox(3), node->Values[2]);
-        float vW = (float)tryGetValue(node->GetBox(4), node->Values[3]);
+        float vX = tryGetValue<float>(node->GetBox(1), node->Values[0]);
+        float vY = tryGetValue<float>(node->GetBox(2), node->Values[1]);
+        float vZ = tryGetValue<float>(node->GetBox(3), node->Values[2]);
+        float vW = tryGetValue<float>(node->GetBox(4), node->Values[3]);
         value = Float4(vX, vY, vZ, vW);
         break;
     }
     case 23:
     {
-        float vX = (float)tryGetValue(node->GetBox(1), node->Values[0]);
-        float vY = (float)tryGetValue(node->GetBox(2), node->Values[1]);
-        float vZ = (float)tryGetValue(node->GetBox(3), node->Values[2]);
+        float vX = tryGetValue<float>(node->GetBox(1), node->Values[0]);
+        float vY = tryGetValue<float>(node->GetBox(2), node->Values[1]);
+        float vZ = tryGetValue<float>(node->GetBox(3), node->Values[2]);
         value = Quaternion::Euler(vX, vY, vZ);
         break;
     }
     case 24:
     {
         const Vector3 vX = (Vector3)tryGetValue(node->GetBox(1), Vector3::Zero);
-        const Quaternion vY = (Quaternion)tryGetValue(node->GetBox(2), Quaternion::Identity);
-        const Float3 vZ = (Float3)tryGetValue(node->GetBox(3), Float3::One);
+        const Quaternion vY = tryGetValue<Quaternion>(node->GetBox(2), Quaternion::Identity);
+        const Float3 vZ = tryGetValue<Float3>(node->GetBox(3), Float3::One);
         value = Variant(Transform(vX, vY, vZ));
         break;
     }
@@ -534,7 +672,7 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     // Unpack
     case 30:
     {
-        Float2 v = (Float2)tryGetValue(node->GetBox(0), Float2::Zero);
+        Float2 v = tryGetValue<Float2>(node->GetBox(0), Float2::Zero);
         int32 subIndex = box->ID - 1;
         ASSERT(subIndex >= 0 && subIndex < 2);
         value = v.Raw[subIndex];
@@ -542,7 +680,7 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     }
     case 31:
     {
-        Float3 v = (Float3)tryGetValue(node->GetBox(0), Float3::Zero);
+        Float3 v = tryGetValue<Float3>(node->GetBox(0), Float3::Zero);
         int32 subIndex = box->ID - 1;
         ASSERT(subIndex >= 0 && subIndex < 3);
         value = v.Raw[subIndex];
@@ -550,7 +688,7 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     }
     case 32:
     {
-        Float4 v = (Float4)tryGetValue(node->GetBox(0), Float4::Zero);
+        Float4 v = tryGetValue<Float4>(node->GetBox(0), Float4::Zero);
         int32 subIndex = box->ID - 1;
         ASSERT(subIndex >= 0 && subIndex < 4);
         value = v.Raw[subIndex];
@@ -558,7 +696,7 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     }
     case 33:
     {
-        const Float3 v = ((Quaternion)tryGetValue(node->GetBox(0), Quaternion::Identity)).GetEuler();
+        const Float3 v = (tryGetValue<Quaternion>(node->GetBox(0), Quaternion::Identity)).GetEuler();
         const int32 subIndex = box->ID - 1;
         ASSERT(subIndex >= 0 && subIndex < 3);
         value = v.Raw[subIndex];
@@ -566,7 +704,7 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     }
     case 34:
     {
-        const Transform v = (Transform)tryGetValue(node->GetBox(0), Variant::Zero);
+        const Transform v = tryGetValue<Transform>(node->GetBox(0), Variant::Zero);
         switch (box->ID)
         {
         case 1:
@@ -774,38 +912,38 @@ void VisjectExecutor::ProcessGroupPacking(Box* box, Node* node, Value& value)
     case 42:
     case 43:
     {
-        const Float4 v = (Float4)tryGetValue(node->GetBox(0), Float4::Zero);
+        const Float4 v = tryGetValue<Float4>(node->GetBox(0), Float4::Zero);
         value = v.Raw[node->TypeID - 40];
         break;
     }
     // Mask XY, YZ, XZ,...
     case 44:
     {
-        value = (Float2)tryGetValue(node->GetBox(0), Float2::Zero);
+        value = tryGetValue<Float2>(node->GetBox(0), Float2::Zero);
         break;
     }
     case 45:
     {
-        const Float4 v = (Float4)tryGetValue(node->GetBox(0), Float4::Zero);
+        const Float4 v = tryGetValue<Float4>(node->GetBox(0), Float4::Zero);
         value = Float2(v.X, v.Z);
         break;
     }
     case 46:
     {
-        const Float4 v = (Float4)tryGetValue(node->GetBox(0), Float4::Zero);
+        const Float4 v = tryGetValue<Float4>(node->GetBox(0), Float4::Zero);
         value = Float2(v.Y, v.Z);
         break;
     }
     case 47:
     {
-        const Float4 v = (Float4)tryGetValue(node->GetBox(0), Float4::Zero);
+        const Float4 v = tryGetValue<Float4>(node->GetBox(0), Float4::Zero);
         value = Float2(v.Z, v.W);
         break;
     }
     // Mask XYZ
     case 70:
     {
-        value = (Float3)tryGetValue(node->GetBox(0), Float3::Zero);
+        value = tryGetValue<Float3>(node->GetBox(0), Float3::Zero);
         break;
     }
     // Append
@@ -881,7 +1019,7 @@ void VisjectExecutor::ProcessGroupTools(Box* box, Node* node, Value& value)
             break;
         case 2:
             // Linear blend between 2 samples
-            time = (float)tryGetValue(node->GetBox(0), Value::Zero);
+            time = tryGetValue<float>(node->GetBox(0), Value::Zero);
             prevTime = (float)node->Values[1];
             prevColor = (Color)node->Values[2];
             curTime = (float)node->Values[3];
@@ -889,7 +1027,7 @@ void VisjectExecutor::ProcessGroupTools(Box* box, Node* node, Value& value)
             value = Color::Lerp(prevColor, curColor, Math::Saturate((time - prevTime) / (curTime - prevTime)));
             break;
         default:
-            time = (float)tryGetValue(node->GetBox(0), Value::Zero);
+            time = tryGetValue<float>(node->GetBox(0), Value::Zero);
             if (time >= node->Values[1 + count * 2 - 2].AsFloat)
             {
                 // Outside the range
@@ -924,7 +1062,7 @@ void VisjectExecutor::ProcessGroupTools(Box* box, Node* node, Value& value)
 		case id: \
 		{ \
 			const auto& curve = GetCurrentGraph()->curves[node->Data.Curve.CurveIndex]; \
-			const float time = (float)tryGetValue(node->GetBox(0), Value::Zero); \
+			const float time = tryGetValue<float>(node->GetBox(0), Value::Zero); \
 			value.Type = VariantType(VariantType::graphType); \
 			curve.Evaluate(*(type*)value.AsData, time, false); \
 			break; \
@@ -1055,19 +1193,19 @@ void VisjectExecutor::ProcessGroupTools(Box* box, Node* node, Value& value)
         break;
     // Noises
     case 30:
-        value = Noise::PerlinNoise((Float2)tryGetValue(node->GetBox(0)));
+        value = Noise::PerlinNoise(tryGetValue<Float2>(node->GetBox(0)));
         break;
     case 31:
-        value = Noise::SimplexNoise((Float2)tryGetValue(node->GetBox(0)));
+        value = Noise::SimplexNoise(tryGetValue<Float2>(node->GetBox(0)));
         break;
     case 32:
-        value = Noise::WorleyNoise((Float2)tryGetValue(node->GetBox(0)));
+        value = Noise::WorleyNoise(tryGetValue<Float2>(node->GetBox(0)));
         break;
     case 33:
-        value = Noise::VoronoiNoise((Float2)tryGetValue(node->GetBox(0)));
+        value = Noise::VoronoiNoise(tryGetValue<Float2>(node->GetBox(0)));
         break;
     case 34:
-        value = Noise::CustomNoise((Float3)tryGetValue(node->GetBox(0)));
+        value = Noise::CustomNoise(tryGetValue<Float3>(node->GetBox(0)));
         break;
     default:
         break;
@@ -1081,7 +1219,7 @@ void VisjectExecutor::ProcessGroupBoolean(Box* box, Node* node, Value& value)
     // NOT
     case 1:
     {
-        const bool a = (bool)tryGetValue(node->GetBox(0), Value::False);
+        const bool a = tryGetValue<bool>(node->GetBox(0), Value::False);
         value = !a;
         break;
     }
@@ -1092,8 +1230,8 @@ void VisjectExecutor::ProcessGroupBoolean(Box* box, Node* node, Value& value)
     case 5:
     case 6:
     {
-        const bool a = (bool)tryGetValue(node->GetBox(0), 0, node->Values[0]);
-        const bool b = (bool)tryGetValue(node->GetBox(1), 1, node->Values[1]);
+        const bool a = tryGetValue<bool>(node->GetBox(0), 0, node->Values[0]);
+        const bool b = tryGetValue<bool>(node->GetBox(1), 1, node->Values[1]);
         bool result = false;
         switch (node->TypeID)
         {
@@ -1133,7 +1271,7 @@ void VisjectExecutor::ProcessGroupBitwise(Box* box, Node* node, Value& value)
     // NOT
     case 1:
     {
-        const int32 a = (int32)tryGetValue(node->GetBox(0), Value(0));
+        const int32 a = tryGetValue<int32>(node->GetBox(0), Value(0));
         value = !a;
         break;
     }
@@ -1142,8 +1280,8 @@ void VisjectExecutor::ProcessGroupBitwise(Box* box, Node* node, Value& value)
     case 3:
     case 4:
     {
-        const int32 a = (int32)tryGetValue(node->GetBox(0), 0, node->Values[0]);
-        const int32 b = (int32)tryGetValue(node->GetBox(1), 1, node->Values[1]);
+        const int32 a = tryGetValue<int32>(node->GetBox(0), 0, node->Values[0]);
+        const int32 b = tryGetValue<int32>(node->GetBox(1), 1, node->Values[1]);
         int32 result = 0;
         switch (node->TypeID)
         {
@@ -1367,7 +1505,7 @@ void VisjectExecutor::ProcessGroupCollections(Box* box, Node* node, Value& value
         // Remove At
         case 7:
         {
-            const int32 index = (int32)tryGetValue(node->GetBox(1), 0, Value::Null);
+            const int32 index = tryGetValue<int32>(node->GetBox(1), 0, Value::Null);
             ENSURE(index >= 0 && index < array.Count(), String::Format(TEXT("Array index {0} is out of range [0;{1}]."), index, array.Count() - 1));
             array.RemoveAt(index);
             value = MoveTemp(v);
@@ -1385,7 +1523,7 @@ void VisjectExecutor::ProcessGroupCollections(Box* box, Node* node, Value& value
         {
             b = node->GetBox(1);
             ENSURE(b->HasConnection(), TEXT("Missing value to add."));
-            const int32 index = (int32)tryGetValue(node->GetBox(2), 0, Value::Null);
+            const int32 index = tryGetValue<int32>(node->GetBox(2), 0, Value::Null);
             ENSURE(index >= 0 && index <= array.Count(), String::Format(TEXT("Array index {0} is out of range [0;{1}]."), index, array.Count()));
             array.Insert(index, eatBox(b->GetParent<Node>(), b->FirstConnection()));
             value = MoveTemp(v);
@@ -1394,7 +1532,7 @@ void VisjectExecutor::ProcessGroupCollections(Box* box, Node* node, Value& value
         // Get
         case 10:
         {
-            const int32 index = (int32)tryGetValue(node->GetBox(1), 0, Value::Null);
+            const int32 index = tryGetValue<int32>(node->GetBox(1), 0, Value::Null);
             ENSURE(index >= 0 && index < array.Count(), String::Format(TEXT("Array index {0} is out of range [0;{1}]."), index, array.Count() - 1));
             value = MoveTemp(array[index]);
             break;
@@ -1404,7 +1542,7 @@ void VisjectExecutor::ProcessGroupCollections(Box* box, Node* node, Value& value
         {
             b = node->GetBox(2);
             ENSURE(b->HasConnection(), TEXT("Missing value to set."));
-            const int32 index = (int32)tryGetValue(node->GetBox(1), 0, Value::Null);
+            const int32 index = tryGetValue<int32>(node->GetBox(1), 0, Value::Null);
             ENSURE(index >= 0 && index < array.Count(), String::Format(TEXT("Array index {0} is out of range [0;{1}]."), index, array.Count() - 1));
             array[index] = MoveTemp(eatBox(b->GetParent<Node>(), b->FirstConnection()));
             value = MoveTemp(v);
@@ -10,6 +10,7 @@
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Content/AssetsContainer.h"
 #include "Engine/Animations/Curve.h"
+#include "VisjectProgram.h"
 
 #define VISJECT_GRAPH_NODE_MAX_ASSETS 14
 
@@ -76,6 +77,11 @@ class VisjectGraphNode : public GraphNode<BoxType>
                 BinaryModule* Module;
                 bool IsStatic;
             } GetSetField;
+
+            struct
+            {
+                VisjectProgram* Program;
+            } Math;
         };
     };
 
@@ -151,12 +157,56 @@ class VisjectGraph : public Graph<NodeType, BoxType, ParameterType>
     /// </summary>
     Array<BezierCurve<Float4>> Float4Curves;
 
+    /// <summary>
+    /// The compiled math expressions used by the graph (linked by the output nodes).
+    /// </summary>
+    Array<VisjectProgram*> Programs;
+
+public:
+    ~VisjectGraph()
+    {
+        Programs.ClearDelete();
+    }
+
+private:
+    void CompilePrograms()
+    {
+        // Flatten math expressions into programs (executor evaluates them instead of walking all nodes)
+        for (int32 i = 0; i < this->Nodes.Count(); i++)
+        {
+            auto node = (VisjectGraphNode<>*)&this->Nodes[i];
+            if (node->GroupID != 3)
+                continue;
+            node->Data.Math.Program = VisjectProgram::Compile(node);
+            if (node->Data.Math.Program)
+                Programs.Add(node->Data.Math.Program);
+        }
+    }
+
 public:
     // [Graph]
+    bool Load(ReadStream* stream, bool loadMeta) override
+    {
+        if (Base::Load(stream, loadMeta))
+            return true;
+        CompilePrograms();
+        return false;
+    }
+
+    void Clear() override
+    {
+        Programs.ClearDelete();
+        Base::Clear();
+    }
+
     bool onNodeLoaded(NodeType* n) override
     {
         switch (n->GroupID)
         {
+        // Math
+        case 3:
+            ((VisjectGraphNode<>*)n)->Data.Math.Program = nullptr;
+            break;
         // Tools
         case 7:
             switch (n->TypeID)
@@ -200,6 +250,26 @@ class VisjectGraph : public Graph<NodeType, BoxType, ParameterType>
     }
 };
 
+/// <summary>
+/// The value types that graph executors can get from the boxes without constructing Variant.
+/// </summary>
+template<typename T>
+struct VisjectValueType
+{
+    static constexpr VariantType::Types Type = VariantType::Null;
+};
+
+#define VISJECT_VALUE_TYPE(type, variantType) template<> struct VisjectValueType<type> { static constexpr VariantType::Types Type = VariantType::variantType; }
+VISJECT_VALUE_TYPE(bool, Bool);
+VISJECT_VALUE_TYPE(int32, Int);
+VISJECT_VALUE_TYPE(float, Float);
+VISJECT_VALUE_TYPE(Float2, Float2);
+VISJECT_VALUE_TYPE(Float3, Float3);
+VISJECT_VALUE_TYPE(Float4, Float4);
+VISJECT_VALUE_TYPE(Quaternion, Quaternion);
+VISJECT_VALUE_TYPE(Transform, Transform);
+#undef VISJECT_VALUE_TYPE
+
 /// <summary>
 /// Visject Surface graph executor at runtime.
 /// </summary>
@@ -249,6 +319,13 @@ class VisjectExecutor
     virtual Value eatBox(Node* caller, Box* box) = 0;
     virtual Graph* GetCurrentGraph() const = 0;
 
+    // Evaluates the compiled expression. Returns false if the program cannot be used and the graph has to be walked instead.
+    bool ExecuteProgram(VisjectProgram* program, Value& result);
+    bool ExecuteProgram(VisjectProgram* program, Float4* registers);
+
+    // Gets the value of the given output box without constructing Variant (works for constants and compiled math expressions with the exactly matching type). Returns false if the value has to be evaluated by the executor.
+    bool tryGetPodValue(Box* box, VariantType::Types type, void* result);
+
     FORCE_INLINE Value tryGetValue(Box* box, int32 defaultValueBoxIndex, const Value& defaultValue)
     {
         const auto parentNode = box->GetParent<Node>();
@@ -268,4 +345,36 @@ class VisjectExecutor
     {
         return box && box->HasConnection() ? eatBox(box->GetParent<Node>(), box->FirstConnection()) : defaultValue;
     }
+
+    template<typename T>
+    FORCE_INLINE T tryGetValue(Box* box, int32 defaultValueBoxIndex, const Value& defaultValue)
+    {
+        const auto parentNode = box->GetParent<Node>();
+        if (box->HasConnection())
+            return getTypedValue<T>(parentNode, box->FirstConnection());
+        if (parentNode->Values.Count() > defaultValueBoxIndex)
+            return (T)parentNode->Values[defaultValueBoxIndex];
+        return (T)defaultValue;
+    }
+
+    template<typename T>
+    FORCE_INLINE T tryGetValue(Box* box)
+    {
+        return box && box->HasConnection() ? getTypedValue<T>(box->GetParent<Node>(), box->FirstConnection()) : (T)Value::Zero;
+    }
+
+    template<typename T>
+    FORCE_INLINE T tryGetValue(Box* box, const Value& defaultValue)
+    {
+        return box && box->HasConnection() ? getTypedValue<T>(box->GetParent<Node>(), box->FirstConnection()) : (T)defaultValue;
+    }
+
+    template<typename T>
+    FORCE_INLINE T getTypedValue(Node* caller, Box* box)
+    {
+        T result;
+        if (VisjectValueType<T>::Type != VariantType::Null && tryGetPodValue(box, VisjectValueType<T>::Type, &result))
+            return result;
+        return (T)eatBox(caller, box);
+    }
 };
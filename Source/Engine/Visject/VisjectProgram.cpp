@@ -0,0 +1,437 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "VisjectProgram.h"
+#include "VisjectGraph.h"
+
+namespace
+{
+    typedef VisjectGraphNode<> Node;
+    typedef VisjectGraphBox Box;
+
+    struct Operand
+    {
+        bool IsConstant;
+        Variant Constant;
+        byte Register;
+        byte Components;
+
+        VariantType GetType() const
+        {
+            if (IsConstant)
+                return Constant.Type;
+            switch (Components)
+            {
+            case 1:
+                return VariantType(VariantType::Float);
+            case 2:
+                return VariantType(VariantType::Float2);
+            case 3:
+                return VariantType(VariantType::Float3);
+            default:
+                return VariantType(VariantType::Float4);
+            }
+        }
+    };
+
+    int32 GetComponents(VariantType::Types type)
+    {
+        switch (type)
+        {
+        case VariantType::Float:
+            return 1;
+        case VariantType::Float2:
+            return 2;
+        case VariantType::Float3:
+            return 3;
+        case VariantType::Float4:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    bool IsLerp(const Node* node)
+    {
+        return node->TypeID == 25;
+    }
+
+    bool CanCompile(const Node* node)
+    {
+        return node->GroupID == 3 && (GraphUtilities::GetMathOp1(node->TypeID) || GraphUtilities::GetMathOp2(node->TypeID) || IsLerp(node));
+    }
+
+    int32 GetInputsCount(const Node* node)
+    {
+        if (IsLerp(node))
+            return 3;
+        return GraphUtilities::GetMathOp2(node->TypeID) ? 2 : 1;
+    }
+
+    // Matches VisjectExecutor::ProcessGroupConstants for the constant values
+    bool GetConstant(Node* node, Box* box, Variant& value)
+    {
+        switch (node->TypeID)
+        {
+        // Constant value
+        case 1:
+        case 2:
+        case 3:
+        case 12:
+        case 15:
+            value = node->Values[0];
+            return true;
+        // Float2/3/4, Color
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+        {
+            const Variant& v = node->Values[0];
+            const Float4 cv = (Float4)v;
+            if (box->ID == 0)
+                value = v;
+            else if (box->ID <= 4)
+                value = cv.Raw[box->ID - 1];
+            else
+                return false;
+            return true;
+        }
+        // PI
+        case 10:
+            value = PI;
+            return true;
+        // Vector2/3/4
+        case 16:
+        case 17:
+        case 18:
+        {
+            const Variant& v = node->Values[0];
+            const Vector4 cv = (Vector4)v;
+            if (box->ID == 0)
+                value = v;
+            else if (box->ID <= 4)
+                value = cv.Raw[box->ID - 1];
+            else
+                return false;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    struct Compiler
+    {
+        VisjectProgram* Program;
+        int32 NodesCount = 0;
+        int32 OpsCount = 0;
+
+        bool AddRegister(const Float4& value, byte& result)
+        {
+            if (Program->Registers.Count() >= VISJECT_PROGRAM_MAX_REGISTERS)
+                return false;
+            result = (byte)Program->Registers.Count();
+            Program->Registers.Add(value);
+            return true;
+        }
+
+        bool ToRegister(Operand& operand)
+        {
+            if (!operand.IsConstant)
+                return true;
+            const int32 components = GetComponents(operand.Constant.Type.Type);
+            if (components == 0)
+                return false;
+            Float4 value = Float4::Zero;
+            Platform::MemoryCopy(&value, operand.Constant.AsData, components * sizeof(float));
+            if (!AddRegister(value, operand.Register))
+                return false;
+            operand.IsConstant = false;
+            operand.Components = (byte)components;
+            return true;
+        }
+
+        bool Cast(Operand& operand, const VariantType& type)
+        {
+            if (operand.IsConstant)
+            {
+                operand.Constant = operand.Constant.Cast(type);
+                return true;
+            }
+            const int32 components = GetComponents(type.Type);
+            if (components == 0)
+                return false;
+            if (components == operand.Components)
+                return true;
+            auto& e = Program->Code.AddOne();
+            e.Op = VisjectProgram::OpCode::Cast;
+            e.Components = (byte)components;
+            e.A = operand.Register;
+            e.B = operand.Components;
+            e.C = 0;
+            e.TypeID = 0;
+            e.Op1 = nullptr;
+            if (!AddRegister(Float4::Zero, e.Result))
+                return false;
+            operand.Register = e.Result;
+            operand.Components = (byte)components;
+            return true;
+        }
+
+        bool GetOperand(Node* node, int32 boxId, int32 defaultValueIndex, const Variant& defaultValue, Operand& result)
+        {
+            Box* box = node->TryGetBox(boxId);
+            if (box && box->HasConnection())
+            {
+                Box* source = box->FirstConnection();
+                Node* sourceNode = source->GetParent<Node>();
+                if (CanCompile(sourceNode))
+                    return CompileNode(sourceNode, result);
+                if (sourceNode->GroupID == 2 && GetConstant(sourceNode, source, result.Constant))
+                {
+                    result.IsConstant = true;
+                    return true;
+                }
+
+                // Value evaluated by the graph executor
+                const int32 components = GetComponents(source->Type.Type);
+                if (components == 0)
+                    return false;
+                result.IsConstant = false;
+                result.Components = (byte)components;
+                if (!AddRegister(Float4::Zero, result.Register))
+                    return false;
+                auto& input = Program->Inputs.AddOne();
+                input.Caller = node;
+                input.Box = source;
+                input.Type = source->Type.Type;
+                input.Components = result.Components;
+                input.Register = result.Register;
+                return true;
+            }
+            result.IsConstant = true;
+            if (defaultValueIndex != -1 && node->Values.Count() > defaultValueIndex)
+                result.Constant = node->Values[defaultValueIndex];
+            else
+                result.Constant = defaultValue;
+            return true;
+        }
+
+        bool Emit(VisjectProgram::OpCode op, Node* node, const Operand* operands, int32 operandsCount, Operand& result)
+        {
+            auto& e = Program->Code.AddOne();
+            e.Op = op;
+            e.Components = operands[0].Components;
+            e.A = operands[0].Register;
+            e.B = operandsCount > 1 ? operands[1].Register : 0;
+            e.C = operandsCount > 2 ? operands[2].Register : 0;
+            e.TypeID = node->TypeID;
+            if (op == VisjectProgram::OpCode::Binary)
+                e.Op2 = GraphUtilities::GetMathOp2(node->TypeID);
+            else
+                e.Op1 = GraphUtilities::GetMathOp1(node->TypeID);
+            if (!AddRegister(Float4::Zero, e.Result))
+                return false;
+            result.IsConstant = false;
+            result.Register = e.Result;
+            result.Components = e.Components;
+            OpsCount++;
+            return true;
+        }
+
+        // Matches VisjectExecutor::ProcessGroupMath for the supported nodes
+        bool CompileNode(Node* node, Operand& result)
+        {
+            if (++NodesCount > VISJECT_PROGRAM_MAX_NODES)
+                return false;
+            if (IsLerp(node))
+            {
+                Operand operands[3];
+                if (!GetOperand(node, 0, 0, Variant::Zero, operands[0]) ||
+                    !GetOperand(node, 1, 1, Variant::One, operands[1]) ||
+                    !GetOperand(node, 2, 2, Variant::Zero, operands[2]))
+                    return false;
+                if (!Cast(operands[1], operands[0].GetType()) ||
+                    !Cast(operands[2], VariantType(VariantType::Float)))
+                    return false;
+                if (operands[0].IsConstant && operands[1].IsConstant && operands[2].IsConstant)
+                {
+                    result.IsConstant = true;
+                    result.Constant = Variant::Lerp(operands[0].Constant, operands[1].Constant, operands[2].Constant.AsFloat);
+                    return true;
+                }
+                if (!ToRegister(operands[0]) || !ToRegister(operands[1]) || !ToRegister(operands[2]))
+                    return false;
+                return Emit(VisjectProgram::OpCode::Lerp, node, operands, 3, result);
+            }
+            if (GraphUtilities::GetMathOp2(node->TypeID))
+            {
+                Operand operands[2];
+                if (!GetOperand(node, 0, 0, Variant::Zero, operands[0]) ||
+                    !GetOperand(node, 1, 1, Variant::Zero, operands[1]))
+                    return false;
+                if (node->GetBox(0)->HasConnection())
+                {
+                    if (!Cast(operands[1], operands[0].GetType()))
+                        return false;
+                }
+                else
+                {
+                    if (!Cast(operands[0], operands[1].GetType()))
+                        return false;
+                }
+                if (operands[0].IsConstant && operands[1].IsConstant)
+                {
+                    result.IsConstant = true;
+                    GraphUtilities::ApplySomeMathHere(node->TypeID, result.Constant, operands[0].Constant, operands[1].Constant);
+                    return true;
+                }
+                if (!ToRegister(operands[0]) || !ToRegister(operands[1]))
+                    return false;
+                return Emit(VisjectProgram::OpCode::Binary, node, operands, 2, result);
+            }
+            Operand operand;
+            if (!GetOperand(node, 0, -1, Variant::Zero, operand))
+                return false;
+            if (operand.IsConstant)
+            {
+                result.IsConstant = true;
+                GraphUtilities::ApplySomeMathHere(node->TypeID, result.Constant, operand.Constant);
+                return true;
+            }
+            return Emit(VisjectProgram::OpCode::Unary, node, &operand, 1, result);
+        }
+    };
+
+    bool IsInlined(Node* node)
+    {
+        // Check if all nodes that use this node output can be compiled (it will be evaluated within their programs)
+        bool hasConsumers = false;
+        const int32 inputsCount = GetInputsCount(node);
+        for (auto& box : node->Boxes)
+        {
+            if (box.ID < inputsCount || box.Parent == nullptr)
+                continue;
+            for (int32 i = 0; i < box.Connections.Count(); i++)
+            {
+                Node* consumer = ((Box*)box.Connections[i])->GetParent<Node>();
+                if (!CanCompile(consumer))
+                    return false;
+                VisjectProgram program;
+                Compiler compiler;
+                compiler.Program = &program;
+                Operand result;
+                if (!compiler.CompileNode(consumer, result))
+                    return false;
+                hasConsumers = true;
+            }
+        }
+        return hasConsumers;
+    }
+}
+
+VisjectProgram* VisjectProgram::Compile(VisjectGraphNode<VisjectGraphBox>* node)
+{
+    if (!CanCompile(node) || IsInlined(node))
+        return nullptr;
+    auto program = New<VisjectProgram>();
+    Compiler compiler;
+    compiler.Program = program;
+    Operand result;
+    if (compiler.CompileNode(node, result))
+    {
+        if (result.IsConstant)
+        {
+            program->IsConstant = true;
+            program->Constant = result.Constant;
+            program->Registers.Resize(0);
+            program->Inputs.Resize(0);
+            program->Code.Resize(0);
+            return program;
+        }
+
+        // Skip too simple expressions (walking the graph is fast enough)
+        if (compiler.OpsCount >= 2)
+        {
+            program->ResultRegister = result.Register;
+            program->ResultComponents = result.Components;
+            return program;
+        }
+    }
+    Delete(program);
+    return nullptr;
+}
+
+void VisjectProgram::Run(Float4* registers) const
+{
+    for (const Instruction& e : Code)
+    {
+        Float4& result = registers[e.Result];
+        const Float4& a = registers[e.A];
+        const Float4& b = registers[e.B];
+        switch (e.Op)
+        {
+        case OpCode::Cast:
+            // Matches Variant::Cast (scalars are replicated, vectors are truncated or extended with zeros)
+            if (e.B == 1)
+            {
+                result = Float4(a.X);
+            }
+            else
+            {
+                result = Float4::Zero;
+                Platform::MemoryCopy(&result, &a, Math::Min<int32>(e.B, e.Components) * sizeof(float));
+            }
+            break;
+        case OpCode::Unary:
+            for (int32 i = 0; i < e.Components; i++)
+                result.Raw[i] = e.Op1(a.Raw[i]);
+            break;
+        case OpCode::Binary:
+            switch (e.TypeID)
+            {
+            // Add, Subtract, Multiply, Divide
+            case 1:
+                result = a + b;
+                break;
+            case 2:
+                result = a - b;
+                break;
+            case 3:
+                result = a * b;
+                break;
+            case 5:
+                result = a / b;
+                break;
+            default:
+                for (int32 i = 0; i < e.Components; i++)
+                    result.Raw[i] = e.Op2(a.Raw[i], b.Raw[i]);
+                break;
+            }
+            break;
+        case OpCode::Lerp:
+        {
+            const float alpha = registers[e.C].X;
+            for (int32 i = 0; i < e.Components; i++)
+                result.Raw[i] = Math::Lerp(a.Raw[i], b.Raw[i], alpha);
+            break;
+        }
+        }
+    }
+}
+
+Variant VisjectProgram::GetResult(const Float4* registers) const
+{
+    const Float4& result = registers[ResultRegister];
+    switch (ResultComponents)
+    {
+    case 1:
+        return Variant(result.X);
+    case 2:
+        return Variant(Float2(result));
+    case 3:
+        return Variant(Float3(result));
+    default:
+        return Variant(result);
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/Variant.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/Collections/Array.h"
+#include "GraphUtilities.h"
+
+// The maximum amount of registers that can be used by a single compiled program.
+#define VISJECT_PROGRAM_MAX_REGISTERS 32
+
+// The maximum amount of nodes that can be flattened into a single compiled program.
+#define VISJECT_PROGRAM_MAX_NODES 64
+
+template<class BoxType>
+class VisjectGraphNode;
+class VisjectGraphBox;
+
+/// <summary>
+/// The compiled expression of the Visject graph math nodes. Flattens the tree of math nodes into a linear stream of instructions that operate on typed float vector registers (constant inputs are folded during compilation). Used by the graph executors to evaluate expressions without visiting every box and passing Variant values between nodes.
+/// </summary>
+struct FLAXENGINE_API VisjectProgram
+{
+    enum class OpCode : byte
+    {
+        // Result = Cast(A) (converts components count from B to Components)
+        Cast,
+        // Result = Op1(A)
+        Unary,
+        // Result = Op2(A, B)
+        Binary,
+        // Result = Lerp(A, B, C.X)
+        Lerp,
+    };
+
+    struct Instruction
+    {
+        OpCode Op;
+        byte Components;
+        byte Result;
+        byte A;
+        byte B;
+        byte C;
+        uint16 TypeID;
+
+        union
+        {
+            GraphUtilities::MathOp1 Op1;
+            GraphUtilities::MathOp2 Op2;
+        };
+    };
+
+    struct Input
+    {
+        // The node that reads the input and the box connected to it (the same as used when walking the graph).
+        VisjectGraphNode<VisjectGraphBox>* Caller;
+        VisjectGraphBox* Box;
+        // The expected value type (program is disabled if the graph returns the other type).
+        VariantType::Types Type;
+        byte Components;
+        byte Register;
+    };
+
+public:
+    /// <summary>
+    /// The initial state of the registers (with constants).
+    /// </summary>
+    Array<Float4> Registers;
+
+    /// <summary>
+    /// The values to evaluate from the graph before running the program (in order of the graph evaluation).
+    /// </summary>
+    Array<Input> Inputs;
+
+    /// <summary>
+    /// The instructions to run.
+    /// </summary>
+    Array<Instruction> Code;
+
+    /// <summary>
+    /// The register that contains the result value.
+    /// </summary>
+    byte ResultRegister = 0;
+
+    /// <summary>
+    /// The components count of the result value (1 for Float, 4 for Float4).
+    /// </summary>
+    byte ResultComponents = 0;
+
+    /// <summary>
+    /// True if the whole expression is constant and has been folded into the Constant value.
+    /// </summary>
+    bool IsConstant = false;
+
+    /// <summary>
+    /// True if the program cannot be used because the graph returned the input value of the other type than expected. The executor walks the graph instead.
+    /// </summary>
+    bool Disabled = false;
+
+    /// <summary>
+    /// The result value of the constant program.
+    /// </summary>
+    Variant Constant;
+
+public:
+    /// <summary>
+    /// Compiles the expression that ends at the given math node. Returns null if the expression cannot be compiled, is too small to benefit from it or is always inlined into programs of the nodes that use it.
+    /// </summary>
+    /// <param name="node">The output node of the expression (from Math group).</param>
+    /// <returns>The compiled program or null. Must be deleted by the caller.</returns>
+    static VisjectProgram* Compile(VisjectGraphNode<VisjectGraphBox>* node);
+
+    /// <summary>
+    /// Runs the program code on the registers (inputs have to be loaded before).
+    /// </summary>
+    /// <param name="registers">The registers (initialized from the Registers array and with all inputs loaded).</param>
+    void Run(Float4* registers) const;
+
+    /// <summary>
+    /// Gets the result value from the registers after running the program.
+    /// </summary>
+    /// <param name="registers">The registers.</param>
+    /// <returns>The result value.</returns>
+    Variant GetResult(const Float4* registers) const;
+};
@@ -0,0 +1,28 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+using Flax.Build;
+
+/// <summary>
+/// Target that builds standalone, native benchmarks.
+/// </summary>
+public class FlaxBenchmarksTarget : FlaxTestsTarget
+{
+    /// <inheritdoc />
+    public override void Init()
+    {
+        base.Init();
+
+        // Initialize
+        OutputName = "FlaxBenchmarks";
+        ConfigurationName = "Benchmarks";
+        Configurations = new[]
+        {
+            TargetConfiguration.Development,
+            TargetConfiguration.Release,
+        };
+        GlobalDefinitions.Add("FLAX_BENCHMARKS");
+
+        Modules.Remove("Tests");
+        Modules.Add("Benchmarks");
+    }
+}
@@ -300,3 +300,11 @@ float4 PS_Inscatter1_B(Quad_VS2PS input) : SV_Target
     Inscatter(AtmosphereR, mu, mus, nu, ray, mie);
     return float4(mie, 1);
 }
+
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_ReadInscatter(Quad_VS2PS input) : SV_Target0
+{
+	// Copies the inscatter volume slice for the data download
+	float3 uvw = float3(input.TexCoord, (float(AtmosphereLayer) + 0.5f) / float(AtmosphericFogInscatterAltitudeSampleNum));
+	return AtmosphereDeltaSRTexture.SampleLevel(SamplerPointClamp, uvw, 0);
+}
@@ -5,10 +5,14 @@
 #include "./Flax/Common.hlsl"
 #include "./Flax/MaterialCommon.hlsl"
 #include "./Flax/SH.hlsl"
+#include "./Flax/GlobalSignDistanceField.hlsl"
+#include "./Flax/GI/GlobalSurfaceAtlas.hlsl"
 
 // This config must match C++ code
 #define HEMISPHERES_RESOLUTION 64
 #define NUM_SH_TARGETS 3
+#define HEMISPHERES_TRACE_THREADS 64
+#define HEMISPHERES_TRACE_RAYS_PER_THREAD 4
 
 META_CB_BEGIN(0, Data)
 float4 LightmapArea;
@@ -23,6 +27,15 @@ float3 WorldInvScale;
 float Dummy1;
 META_CB_END
 
+META_CB_BEGIN(1, TraceData)
+GlobalSDFData GlobalSDF;
+GlobalSurfaceAtlasData GlobalSurfaceAtlas;
+uint HemispheresCount;
+float SkyboxIntensity;
+float TraceMaxDistance;
+float Dummy2;
+META_CB_END
+
 #define USED_TEXELS_BIAS 0.001f
 #define BACKGROUND_TEXELS_MARK -1.0f
 
@@ -487,4 +500,129 @@ void CS_Finalize(uint3 GroupID : SV_GroupID, uint3 GroupThreadID : SV_GroupThrea
 	OutputBuffer[texelAdress + 2] = clearColor;
 }
 
+#elif defined(_CS_TraceHemispheres)
+
+#define HEMISPHERES_TRACE_RAYS (HEMISPHERES_TRACE_THREADS * HEMISPHERES_TRACE_RAYS_PER_THREAD)
+
+struct TraceHemisphere
+{
+	float3 Position;
+	uint TexelAddress;
+	float3 Normal;
+	float Padding;
+};
+
+StructuredBuffer<TraceHemisphere> Hemispheres : register(t0);
+Texture3D<float> GlobalSDFTex : register(t1);
+Texture3D<float> GlobalSDFMip : register(t2);
+ByteAddressBuffer GlobalSurfaceAtlasChunks : register(t3);
+ByteAddressBuffer GlobalSurfaceAtlasCulledObjects : register(t4);
+Buffer<float4> GlobalSurfaceAtlasObjects : register(t5);
+Texture2D GlobalSurfaceAtlasDepth : register(t6);
+Texture2D GlobalSurfaceAtlasTex : register(t7);
+TextureCube Skybox : register(t8);
+RWBuffer<float4> OutputBuffer : register(u0);
+
+// Shared memory for summing H-Basis coefficients of the hemisphere rays
+groupshared float3 RaysHBasis[HEMISPHERES_TRACE_THREADS][4];
+
+// Traces the rays over the hemisphere of the lightmap texel using Global SDF and samples the lighting at the hit locations from Global Surface Atlas (single thread group per hemisphere).
+// Radiance is projected onto SH and converted to H-Basis like in CS_Integrate and CS_Reduction (uniformly distributed rays over the whole hemisphere).
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(HEMISPHERES_TRACE_THREADS, 1, 1)]
+void CS_TraceHemispheres(uint3 GroupID : SV_GroupID, uint3 GroupThreadID : SV_GroupThreadID)
+{
+	if (GroupID.x >= HemispheresCount)
+		return;
+	TraceHemisphere hemisphere = Hemispheres[GroupID.x];
+	float3x3 tangentToWorld = CalcTangentBasisFromWorldNormal(hemisphere.Normal);
+	float3 rayOrigin = hemisphere.Position + hemisphere.Normal * GlobalSDF.CascadeVoxelSize[0];
+	float weight = (2.0f * PI) / HEMISPHERES_TRACE_RAYS;
+
+	float3 hBasisSum[4] = { float3(0, 0, 0), float3(0, 0, 0), float3(0, 0, 0), float3(0, 0, 0) };
+	UNROLL
+	for (uint i = 0; i < HEMISPHERES_TRACE_RAYS_PER_THREAD; i++)
+	{
+		// Fibonacci spiral over the hemisphere (uniform solid angle per ray)
+		float rayIndex = (float)(GroupThreadID.x * HEMISPHERES_TRACE_RAYS_PER_THREAD + i);
+		float spiral = rayIndex * ((sqrt(5.0f) * 0.5f + 0.5f) - 1.0f);
+		float phi = (2.0f * PI) * (spiral - floor(spiral));
+		float cosTheta = 1.0f - (rayIndex + 0.5f) * (1.0f / HEMISPHERES_TRACE_RAYS);
+		float sinTheta = sqrt(saturate(1.0f - cosTheta * cosTheta));
+		float3 dirTS = float3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+		float3 dirWS = normalize(mul(dirTS, tangentToWorld));
+
+		// Trace ray with Global SDF
+		GlobalSDFTrace trace;
+		trace.Init(rayOrigin, dirWS, 0.0f, TraceMaxDistance);
+		GlobalSDFHit hit = RayTraceGlobalSDF(GlobalSDF, GlobalSDFTex, GlobalSDFMip, trace);
+		float3 radiance;
+		if (hit.IsHit())
+		{
+			if (hit.HitSDF <= 0.0f && hit.HitTime <= GlobalSDF.CascadeVoxelSize[0])
+			{
+				// Ray starts inside geometry
+				radiance = float3(0, 0, 0);
+			}
+			else
+			{
+				// Sample Global Surface Atlas to get the lighting at the hit location
+				float3 hitPosition = hit.GetHitPosition(trace);
+				float surfaceThreshold = GetGlobalSurfaceAtlasThreshold(GlobalSDF, hit);
+				radiance = SampleGlobalSurfaceAtlas(GlobalSurfaceAtlas, GlobalSurfaceAtlasChunks, GlobalSurfaceAtlasCulledObjects, GlobalSurfaceAtlasObjects, GlobalSurfaceAtlasDepth, GlobalSurfaceAtlasTex, hitPosition, -dirWS, surfaceThreshold).rgb;
+			}
+		}
+		else
+		{
+			// Ray hits sky
+			radiance = Skybox.SampleLevel(SamplerLinearClamp, dirWS, 0).rgb * SkyboxIntensity;
+		}
+
+		// Project onto SH and convert to H-Basis
+		float3 sh[9];
+		ProjectOntoSH3(dirTS, radiance * weight, sh);
+		float3 hBasis[4];
+		ConvertSH3ToHBasis(sh, hBasis);
+		hBasisSum[0] += hBasis[0];
+		hBasisSum[1] += hBasis[1];
+		hBasisSum[2] += hBasis[2];
+		hBasisSum[3] += hBasis[3];
+	}
+
+	// Store in shared memory
+	RaysHBasis[GroupThreadID.x][0] = hBasisSum[0];
+	RaysHBasis[GroupThreadID.x][1] = hBasisSum[1];
+	RaysHBasis[GroupThreadID.x][2] = hBasisSum[2];
+	RaysHBasis[GroupThreadID.x][3] = hBasisSum[3];
+	GroupMemoryBarrierWithGroupSync();
+
+	// Sum the coefficients for all rays
+	[unroll(HEMISPHERES_TRACE_THREADS)]
+	for (uint s = HEMISPHERES_TRACE_THREADS / 2; s > 0; s >>= 1)
+	{
+		if (GroupThreadID.x < s)
+		{
+			RaysHBasis[GroupThreadID.x][0] += RaysHBasis[GroupThreadID.x + s][0];
+			RaysHBasis[GroupThreadID.x][1] += RaysHBasis[GroupThreadID.x + s][1];
+			RaysHBasis[GroupThreadID.x][2] += RaysHBasis[GroupThreadID.x + s][2];
+			RaysHBasis[GroupThreadID.x][3] += RaysHBasis[GroupThreadID.x + s][3];
+		}
+
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	// Have the first thread write out to the lightmap data buffer
+	if (GroupThreadID.x == 0)
+	{
+		UNROLL
+		for (uint i = 0; i < NUM_SH_TARGETS; i++)
+		{
+			// Note: we add some bias to indicate that this texel has been used
+			float4 output = float4(RaysHBasis[0][0][i], RaysHBasis[0][1][i], RaysHBasis[0][2][i], RaysHBasis[0][3][i]);
+			output = clamp(output + USED_TEXELS_BIAS, 0, 10000);
+			OutputBuffer[hemisphere.TexelAddress + i] = output;
+		}
+	}
+}
+
 #endif
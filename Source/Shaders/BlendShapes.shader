@@ -0,0 +1,80 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Amount of vertices processed by a single thread group
+#define THREAD_GROUP_SIZE 64
+
+// Offset (in bytes) of the tangent frame (normal and tangent) in the skinned mesh vertex (VB0SkinnedElementType)
+#define VERTEX_TANGENT_FRAME_OFFSET 16
+
+META_CB_BEGIN(0, Data)
+uint VertexOffset;
+uint VertexCount;
+uint VertexStride;
+uint RangesOffset;
+META_CB_END
+
+struct BlendShapeDelta
+{
+	float3 PositionDelta;
+	uint BlendShapeIndex;
+	float3 NormalDelta;
+	float Padding;
+};
+
+StructuredBuffer<uint2> Ranges : register(t0);
+StructuredBuffer<BlendShapeDelta> Deltas : register(t1);
+StructuredBuffer<float> Weights : register(t2);
+RWByteAddressBuffer VertexBuffer : register(u0);
+
+// Unpacks the R10G10B10A2 vector from [0;1] to [-1;1] range
+float3 UnpackVector(uint packed)
+{
+	return float3(packed & 0x3FF, (packed >> 10) & 0x3FF, (packed >> 20) & 0x3FF) * (2.0f / 1023.0f) - 1.0f;
+}
+
+// Packs the vector from [-1;1] to [0;1] range into R10G10B10A2 (preserves the 2-bit alpha)
+uint PackVector(float3 v, uint packed)
+{
+	uint3 u = (uint3)round(saturate(v * 0.5f + 0.5f) * 1023.0f);
+	return (packed & 0xC0000000) | (u.z << 20) | (u.y << 10) | u.x;
+}
+
+// Applies the weighted blend shape deltas to the vertices of the skinned mesh. Every thread processes a single vertex.
+META_CS(true, FEATURE_LEVEL_SM5)
+META_PERMUTATION_1(USE_NORMALS=0)
+META_PERMUTATION_1(USE_NORMALS=1)
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void CS_Blend(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= VertexCount)
+		return;
+	uint2 range = Ranges[RangesOffset + index];
+	if (range.y == 0)
+		return;
+
+	// Accumulate weighted deltas of all blend shapes
+	float3 positionDelta = 0;
+	float3 normalDelta = 0;
+	for (uint i = 0; i < range.y; i++)
+	{
+		BlendShapeDelta delta = Deltas[range.x + i];
+		float weight = Weights[delta.BlendShapeIndex];
+		positionDelta += delta.PositionDelta * weight;
+		normalDelta += delta.NormalDelta * weight;
+	}
+
+	uint address = (VertexOffset + index) * VertexStride;
+	float3 position = asfloat(VertexBuffer.Load3(address)) + positionDelta;
+	VertexBuffer.Store3(address, asuint(position));
+#if USE_NORMALS
+	// Normalize normal vector and rebuild tangent frame
+	uint2 tangentFrame = VertexBuffer.Load2(address + VERTEX_TANGENT_FRAME_OFFSET);
+	float3 normal = normalize(UnpackVector(tangentFrame.x) + normalDelta);
+	float3 tangent = UnpackVector(tangentFrame.y);
+	tangent = normalize(tangent - dot(tangent, normal) * normal);
+	VertexBuffer.Store2(address + VERTEX_TANGENT_FRAME_OFFSET, uint2(PackVector(normal, tangentFrame.x), PackVector(tangent, tangentFrame.y)));
+#endif
+}
@@ -46,6 +46,12 @@
 #define META_PERMUTATION_4(param0, param1, param2, param3)
 #define META_CB_BEGIN(index, name) cbuffer name : register(b##index) {
 #define META_CB_END };
+#if VULKAN
+#define META_PUSH_CONSTANTS_BEGIN(name) [[vk::push_constant]] cbuffer name {
+#else
+#define META_PUSH_CONSTANTS_BEGIN(name) cbuffer name : register(b4) {
+#endif
+#define META_PUSH_CONSTANTS_END };
 
 #define SHADING_MODEL_UNLIT 0
 #define SHADING_MODEL_LIT 1
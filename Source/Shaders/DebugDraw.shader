@@ -27,6 +27,24 @@ VS2PS VS(float3 Position : POSITION, float4 Color : COLOR)
 	return output;
 }
 
+// Vertex shader for the instanced primitives (instance data contains the transposed 3x4 local-to-geometry matrix and the instance color)
+META_VS(true, FEATURE_LEVEL_ES2)
+META_VS_IN_ELEMENT(POSITION,  0, R32G32B32_FLOAT,    0, ALIGN, PER_VERTEX,   0, true)
+META_VS_IN_ELEMENT(COLOR,     0, R8G8B8A8_UNORM,     0, ALIGN, PER_VERTEX,   0, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 0, R32G32B32A32_FLOAT, 1, 0,     PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 1, R32G32B32A32_FLOAT, 1, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 2, R32G32B32A32_FLOAT, 1, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 3, R8G8B8A8_UNORM,     1, ALIGN, PER_INSTANCE, 1, true)
+VS2PS VS_Instanced(float3 Position : POSITION, float4 Color : COLOR, float4 InstanceRow0 : ATTRIBUTE0, float4 InstanceRow1 : ATTRIBUTE1, float4 InstanceRow2 : ATTRIBUTE2, float4 InstanceColor : ATTRIBUTE3)
+{
+	VS2PS output;
+	float4 position = float4(Position, 1);
+	position.xyz = float3(dot(InstanceRow0, position), dot(InstanceRow1, position), dot(InstanceRow2, position));
+	output.Position = mul(position, ViewProjection);
+	output.Color = Color * InstanceColor;
+	return output;
+}
+
 void PerformDepthTest(float4 svPosition)
 {
 	// Depth test manually if compositing editor primitives
@@ -335,6 +335,20 @@ float4 PS_DoNotGenerateBokeh(Quad_VS2PS input) : SV_Target
 	return float4(centerColor, centerSample.a);
 }
 
+#elif defined(_PS_DofComposite)
+
+Texture2D Input2 : register(t2);
+
+// Upscales the low-resolution depth of field and blends it with the full-resolution frame in the focused areas
+META_PS(true, FEATURE_LEVEL_SM5)
+float4 PS_DofComposite(Quad_VS2PS input) : SV_Target
+{
+	float4 sharpSample = Input0.SampleLevel(SamplerPointClamp, input.TexCoord, 0);
+	float3 dofColor = Input1.SampleLevel(SamplerLinearClamp, input.TexCoord, 0).rgb;
+	float blur = Input2.SampleLevel(SamplerLinearClamp, input.TexCoord, 0).y;
+	return float4(lerp(sharpSample.rgb, dofColor, saturate(blur * 4.0f)), sharpSample.a);
+}
+
 #else
 
 StructuredBuffer<BokehPoint> BokehPointBuffer : register(t2);
@@ -9,7 +9,8 @@ Texture2D Distortion : register(t1);
 META_PS(true, FEATURE_LEVEL_ES2)
 float4 PS_ApplyDistortion(Quad_VS2PS input) : SV_Target
 {
-	float4 accumDist = Distortion.Sample(SamplerPointClamp, input.TexCoord);
+	// Use bilinear filtering to upscale the distortion vectors when rendered in lower resolution
+	float4 accumDist = Distortion.Sample(SamplerLinearClamp, input.TexCoord);
 	float2 distOffset = (accumDist.rg - accumDist.ba) / 4.0f;
 	float2 newTexCoord = input.TexCoord + distOffset;
 
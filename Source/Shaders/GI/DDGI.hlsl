@@ -16,6 +16,7 @@
 #define DDGI_PROBE_STATE_INACTIVE 0
 #define DDGI_PROBE_STATE_ACTIVATED 1
 #define DDGI_PROBE_STATE_ACTIVE 2
+#define DDGI_PROBE_STATE_SLEEPING 3
 #define DDGI_PROBE_RESOLUTION_IRRADIANCE 6 // Resolution (in texels) for probe irradiance data (excluding 1px padding on each side)
 #define DDGI_PROBE_RESOLUTION_DISTANCE 14 // Resolution (in texels) for probe distance data (excluding 1px padding on each side)
 #define DDGI_SRGB_BLENDING 1 // Enables blending in sRGB color space, otherwise irradiance blending is done in linear space
@@ -105,7 +106,7 @@ float4 EncodeDDGIProbeData(float3 probeOffset, uint probeState)
 // Decodes probe state from the encoded state
 uint DecodeDDGIProbeState(float4 probeData)
 {
-    return (uint)(probeData.w * 8.0f);
+    return (uint)(probeData.w * 8.0f + 0.5f);
 }
 
 // Decodes probe world-space position (XYZ) from the encoded state
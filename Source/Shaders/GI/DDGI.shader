@@ -21,6 +21,8 @@
 #define DDGI_TRACE_RAYS_LIMIT 256 // Limit of rays per-probe (runtime value can be smaller)
 #define DDGI_PROBE_UPDATE_BORDERS_GROUP_SIZE 8
 #define DDGI_PROBE_CLASSIFY_GROUP_SIZE 32
+#define DDGI_PROBE_SLEEP_DELAY 16 // Amount of probe classifications without nearby geometry changes after which the active probe goes to sleep
+#define DDGI_PROBE_SLEEP_UPDATE_INTERVAL 8 // Sleeping probes are refreshed once per this amount of cascade updates (to catch up with lighting changes)
 
 META_CB_BEGIN(0, Data0)
 DDGIData DDGI;
@@ -35,7 +37,8 @@ int4 ProbeScrollClears[4];
 META_CB_END
 
 META_CB_BEGIN(1, Data1)
-float2 Padding1;
+uint UpdateIndex;
+uint ProbesUpdateBudget;
 uint CascadeIndex;
 uint ProbeIndexOffset;
 META_CB_END
@@ -71,6 +74,7 @@ uint GetProbeRaysCount(DDGIData data, uint probeState)
 
 RWTexture2D<snorm float4> RWProbesData : register(u0);
 RWByteAddressBuffer RWActiveProbes : register(u1);
+RWTexture2D<float2> RWProbesStability : register(u2);
 
 Texture3D<float> GlobalSDFTex : register(t0);
 Texture3D<float> GlobalSDFMip : register(t1);
@@ -80,15 +84,18 @@ float3 Remap(float3 value, float3 fromMin, float3 fromMax, float3 toMin, float3
     return (value - fromMin) / (fromMax - fromMin) * (toMax - toMin) + toMin;
 }
 
-// Compute shader for updating probes state between active and inactive and performing probes relocation.
+// Compute shader for updating probes state between active, sleeping and inactive and performing probes relocation.
 META_CS(true, FEATURE_LEVEL_SM5)
 [numthreads(DDGI_PROBE_CLASSIFY_GROUP_SIZE, 1, 1)]
 void CS_Classify(uint3 DispatchThreadId : SV_DispatchThreadID)
 {
-    uint probeIndex = DispatchThreadId.x;
     uint probesCount = DDGI.ProbesCounts.x * DDGI.ProbesCounts.y * DDGI.ProbesCounts.z;
-    if (probeIndex >= probesCount)
+    if (DispatchThreadId.x >= probesCount)
         return;
+
+    // Rotate probes order when using the update budget so the active probes list doesn't always get truncated at the same probes
+    uint probeIndex = (DispatchThreadId.x + UpdateIndex * ProbesUpdateBudget) % probesCount;
+    uint probeListIndex = probeIndex;
     uint3 probeCoords = GetDDGIProbeCoords(DDGI, probeIndex);
     probeIndex = GetDDGIScrollingProbeIndex(DDGI, CascadeIndex, probeCoords);
     int2 probeDataCoords = GetDDGIProbeTexelCoords(DDGI, CascadeIndex, probeIndex);
@@ -112,6 +119,7 @@ void CS_Classify(uint3 DispatchThreadId : SV_DispatchThreadID)
 #else
     float sdf = SampleGlobalSDF(GlobalSDF, GlobalSDFTex, GlobalSDFMip, probePosition);
 #endif
+    float surfaceSignature = sdf;
     float sdfDst = abs(sdf);
     float threshold = GlobalSDF.CascadeVoxelSize[CascadeIndex];
     float distanceLimit = length(probesSpacing) * ProbesDistanceLimit;
@@ -167,6 +175,7 @@ void CS_Classify(uint3 DispatchThreadId : SV_DispatchThreadID)
             float3 offset = Remap(float3(x, y, z), 0, 3, -0.5f, 0.5f) * relocateLimit;
             float offsetSdf = SampleGlobalSDFCascade(GlobalSDF, GlobalSDFTex, probeBasePosition + offset, sdfCascade);
             CachedProbeOffsets[x * 16 + y * 4 + z] = float4(offset, offsetSdf);
+            surfaceSignature += offsetSdf * (1.0f / 64.0f);
         }
 
         // Select the best probe location around the base position
@@ -201,16 +210,31 @@ void CS_Classify(uint3 DispatchThreadId : SV_DispatchThreadID)
         probeState = wasInactive || wasScrolled || wasRelocated ? DDGI_PROBE_STATE_ACTIVATED : DDGI_PROBE_STATE_ACTIVE;
     }
 
+    // Put probe to sleep if the nearby geometry didn't change for a longer time (detected via Global SDF around the probe)
+    float2 probeStability = RWProbesStability[probeDataCoords];
+    bool surfaceChanged = abs(surfaceSignature - probeStability.x) > threshold * 0.5f;
+    if (probeState != DDGI_PROBE_STATE_ACTIVE || surfaceChanged)
+        probeStability.y = 0;
+    else
+        probeStability.y = min(probeStability.y + 1, 255);
+    probeStability.x = surfaceSignature;
+    RWProbesStability[probeDataCoords] = probeStability;
+    if (probeState == DDGI_PROBE_STATE_ACTIVE && probeStability.y >= DDGI_PROBE_SLEEP_DELAY)
+        probeState = DDGI_PROBE_STATE_SLEEPING;
+
     // Save probe state
     probeOffset /= probesSpacing; // Move offset back to [-1;1] space
     RWProbesData[probeDataCoords] = EncodeDDGIProbeData(probeOffset, probeState);
 
-    // Collect active probes
-    if (probeState != DDGI_PROBE_STATE_INACTIVE)
+    // Collect active probes (sleeping probes are refreshed once in a while to react to the lighting changes)
+    bool update = probeState != DDGI_PROBE_STATE_INACTIVE;
+    if (probeState == DDGI_PROBE_STATE_SLEEPING)
+        update = (probeListIndex + UpdateIndex) % DDGI_PROBE_SLEEP_UPDATE_INTERVAL == 0;
+    if (update)
     {
         uint activeProbeIndex;
         RWActiveProbes.InterlockedAdd(0, 1, activeProbeIndex); // Counter at 0
-        RWActiveProbes.Store(activeProbeIndex * 4 + 4, DispatchThreadId.x);
+        RWActiveProbes.Store(activeProbeIndex * 4 + 4, probeListIndex);
     }
 }
 
@@ -228,6 +252,8 @@ void CS_UpdateProbesInitArgs()
 {
     uint probesCount = DDGI.ProbesCounts.x * DDGI.ProbesCounts.y * DDGI.ProbesCounts.z;
     uint activeProbesCount = ActiveProbes.Load(0);
+    if (ProbesUpdateBudget != 0)
+        activeProbesCount = min(activeProbesCount, ProbesUpdateBudget);
     uint arg = 0;
     for (uint probesOffset = 0; probesOffset < activeProbesCount; probesOffset += DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT)
     {
@@ -15,11 +15,16 @@ uint ParticleCapacity;
 uint PositionOffset;
 uint CustomOffset;
 float4x4 PositionTransform;
+uint DrawArgsCount;
+uint DispatchArgsOffset;
+float2 Dummy0;
 META_CB_END
 
 // Particles data buffer
 ByteAddressBuffer ParticlesData : register(t0);
 
+#ifdef _CS_Sort
+
 // Output sorting keys buffer (index + key)
 struct Item
 {
@@ -85,3 +90,27 @@ void CS_Sort(uint3 dispatchThreadId : SV_DispatchThreadID)
 	item.Value = index;
 	SortingKeys[index] = item;
 }
+
+#endif
+
+#ifdef _CS_IndirectArgs
+
+// Output indirect arguments buffer (draw arguments of the emitter draw calls followed by the sorting keys generation dispatch arguments)
+RWByteAddressBuffer IndirectArgs : register(u0);
+
+// Indirect arguments generation shader (uses particles counter to skip any work for the empty emitters without reading it back on CPU)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(1, 1, 1)]
+void CS_IndirectArgs()
+{
+	uint particlesCount = min(ParticlesData.Load(ParticleCounterOffset), ParticleCapacity);
+
+	// Write instances count of every draw call (GPUDrawIndexedIndirectArgs::InstanceCount)
+	for (uint i = 0; i < DrawArgsCount; i++)
+		IndirectArgs.Store(i * 20 + 4, particlesCount);
+
+	// Write sorting keys generation thread groups count (GPUDispatchIndirectArgs)
+	IndirectArgs.Store3(DispatchArgsOffset, uint3((particlesCount + 1023) / 1024, 1, 1));
+}
+
+#endif
@@ -101,6 +101,19 @@ float4 PS_Font(VS2PS input) : SV_Target0
 	return color;
 }
 
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_FontSDF(VS2PS input) : SV_Target0
+{
+	PerformClipping(input);
+
+	// Signed distance field glyph (0.5 is the glyph edge), filter it over the screen pixel footprint to get antialiased edges at any scale
+	float distance = Image.Sample(SamplerLinearClamp, input.TexCoord).r;
+	float filterWidth = max(fwidth(distance), 0.0001f);
+	float4 color = input.Color;
+	color.a *= smoothstep(0.5f - filterWidth, 0.5f + filterWidth, distance);
+	return color;
+}
+
 float4 GetSample(float weight, float offset, float2 uv)
 {
 #if BLUR_V
@@ -13,7 +13,7 @@ struct GlobalSDFData
 {
     float4 CascadePosDistance[4];
     float4 CascadeVoxelSize;
-    float2 Padding;
+    float2 DistanceDecode;
     uint CascadesCount;
     float Resolution;
 };
@@ -68,6 +68,12 @@ void GetGlobalSDFCascadeUV(const GlobalSDFData data, uint cascade, float3 worldP
     textureUV = float3(((float)cascade + cascadeUV.x) / (float)data.CascadesCount, cascadeUV.y, cascadeUV.z); // cascades are placed next to each other on X axis
 }
 
+// Decodes the normalized distance (-1..1) from the Global SDF texture value (compact storage uses 0..1 range).
+float DecodeGlobalSDF(const GlobalSDFData data, float value)
+{
+    return value * data.DistanceDecode.x + data.DistanceDecode.y;
+}
+
 // Gets the Global SDF cascade index for the given world location.
 uint GetGlobalSDFCascade(const GlobalSDFData data, float3 worldPosition)
 {
@@ -89,7 +95,7 @@ float SampleGlobalSDFCascade(const GlobalSDFData data, Texture3D<float> tex, flo
     float cascadeMaxDistance;
     float3 cascadeUV, textureUV;
     GetGlobalSDFCascadeUV(data, cascade, worldPosition, cascadeMaxDistance, cascadeUV, textureUV);
-    float cascadeDistance = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+    float cascadeDistance = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
     if (cascadeDistance < 1.0f && !any(cascadeUV < 0) && !any(cascadeUV > 1))
         distance = cascadeDistance * cascadeMaxDistance;
     return distance;
@@ -106,7 +112,7 @@ float SampleGlobalSDF(const GlobalSDFData data, Texture3D<float> tex, float3 wor
         float cascadeMaxDistance;
         float3 cascadeUV, textureUV;
         GetGlobalSDFCascadeUV(data, cascade, worldPosition, cascadeMaxDistance, cascadeUV, textureUV);
-        float cascadeDistance = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+        float cascadeDistance = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
         if (cascadeDistance < 0.9f && !any(cascadeUV < 0) && !any(cascadeUV > 1))
         {
             distance = cascadeDistance * cascadeMaxDistance;
@@ -129,10 +135,10 @@ float SampleGlobalSDF(const GlobalSDFData data, Texture3D<float> tex, Texture3D<
         float cascadeMaxDistance;
         float3 cascadeUV, textureUV;
         GetGlobalSDFCascadeUV(data, cascade, worldPosition, cascadeMaxDistance, cascadeUV, textureUV);
-        float cascadeDistance = mip.SampleLevel(SamplerLinearClamp, textureUV, 0);
+        float cascadeDistance = DecodeGlobalSDF(data, mip.SampleLevel(SamplerLinearClamp, textureUV, 0));
         if (cascadeDistance < chunkSizeDistance && !any(cascadeUV < 0) && !any(cascadeUV > 1))
         {
-            float cascadeDistanceTex = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+            float cascadeDistanceTex = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
             if (cascadeDistanceTex < chunkMarginDistance * 2)
                 cascadeDistance = cascadeDistanceTex;
             distance = cascadeDistance * cascadeMaxDistance;
@@ -154,7 +160,7 @@ float3 SampleGlobalSDFGradient(const GlobalSDFData data, Texture3D<float> tex, f
         float cascadeMaxDistance;
         float3 cascadeUV, textureUV;
         GetGlobalSDFCascadeUV(data, cascade, worldPosition, cascadeMaxDistance, cascadeUV, textureUV);
-        float cascadeDistance = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+        float cascadeDistance = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
         if (cascadeDistance < 0.9f && !any(cascadeUV < 0) && !any(cascadeUV > 1))
         {
             float texelOffset = 1.0f / data.Resolution;
@@ -164,7 +170,7 @@ float3 SampleGlobalSDFGradient(const GlobalSDFData data, Texture3D<float> tex, f
             float yn = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y - texelOffset, textureUV.z), 0).x;
             float zp = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y, textureUV.z + texelOffset), 0).x;
             float zn = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y, textureUV.z - texelOffset), 0).x;
-            gradient = float3(xp - xn, yp - yn, zp - zn) * cascadeMaxDistance;
+            gradient = float3(xp - xn, yp - yn, zp - zn) * (cascadeMaxDistance * data.DistanceDecode.x);
             distance = cascadeDistance * cascadeMaxDistance;
             break;
         }
@@ -186,10 +192,10 @@ float3 SampleGlobalSDFGradient(const GlobalSDFData data, Texture3D<float> tex, T
         float cascadeMaxDistance;
         float3 cascadeUV, textureUV;
         GetGlobalSDFCascadeUV(data, cascade, worldPosition, cascadeMaxDistance, cascadeUV, textureUV);
-        float cascadeDistance = mip.SampleLevel(SamplerLinearClamp, textureUV, 0);
+        float cascadeDistance = DecodeGlobalSDF(data, mip.SampleLevel(SamplerLinearClamp, textureUV, 0));
         if (cascadeDistance < chunkSizeDistance && !any(cascadeUV < 0) && !any(cascadeUV > 1))
         {
-            float cascadeDistanceTex = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+            float cascadeDistanceTex = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
             if (cascadeDistanceTex < chunkMarginDistance * 2)
                 cascadeDistance = cascadeDistanceTex;
             float texelOffset = 1.0f / data.Resolution;
@@ -199,7 +205,7 @@ float3 SampleGlobalSDFGradient(const GlobalSDFData data, Texture3D<float> tex, T
             float yn = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y - texelOffset, textureUV.z), 0).x;
             float zp = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y, textureUV.z + texelOffset), 0).x;
             float zn = tex.SampleLevel(SamplerLinearClamp, float3(textureUV.x, textureUV.y, textureUV.z - texelOffset), 0).x;
-            gradient = float3(xp - xn, yp - yn, zp - zn) * cascadeMaxDistance;
+            gradient = float3(xp - xn, yp - yn, zp - zn) * (cascadeMaxDistance * data.DistanceDecode.x);
             distance = cascadeDistance * cascadeMaxDistance;
             break;
         }
@@ -253,10 +259,10 @@ GlobalSDFHit RayTraceGlobalSDF(const GlobalSDFData data, Texture3D<float> tex, T
             float cascadeMaxDistance;
             float3 cascadeUV, textureUV;
             GetGlobalSDFCascadeUV(data, cascade, stepPosition, cascadeMaxDistance, cascadeUV, textureUV);
-            float stepDistance = mip.SampleLevel(SamplerLinearClamp, textureUV, 0);
+            float stepDistance = DecodeGlobalSDF(data, mip.SampleLevel(SamplerLinearClamp, textureUV, 0));
             if (stepDistance < chunkSizeDistance)
             {
-                float stepDistanceTex = tex.SampleLevel(SamplerLinearClamp, textureUV, 0);
+                float stepDistanceTex = DecodeGlobalSDF(data, tex.SampleLevel(SamplerLinearClamp, textureUV, 0));
                 if (stepDistanceTex < chunkMarginDistance * 2)
                 {
                     stepDistance = stepDistanceTex;
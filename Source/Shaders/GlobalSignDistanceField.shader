@@ -42,11 +42,16 @@ float CascadeVoxelSize;
 int CascadeMipResolution;
 int CascadeMipFactor;
 uint4 Objects[GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT / 4];
+float2 DistanceEncode;
+float2 DistanceDecode;
+META_CB_END
+
+META_PUSH_CONSTANTS_BEGIN(GenerateMipData)
 uint GenerateMipTexResolution;
 uint GenerateMipCoordScale;
 uint GenerateMipTexOffsetX;
 uint GenerateMipMipOffsetX;
-META_CB_END
+META_PUSH_CONSTANTS_END
 
 float CombineDistanceToSDF(float sdf, float distanceToSDF)
 {
@@ -116,7 +121,7 @@ void CS_RasterizeModel(uint3 DispatchThreadId : SV_DispatchThreadID)
 	voxelCoord.x += CascadeIndex * CascadeResolution;
 	float minDistance = MaxDistance;
 #if READ_SDF
-	minDistance *= GlobalSDFTex[voxelCoord];
+	minDistance *= GlobalSDFTex[voxelCoord] * DistanceDecode.x + DistanceDecode.y;
 #endif
 	for (uint i = 0; i < ObjectsCount; i++)
 	{
@@ -124,7 +129,7 @@ void CS_RasterizeModel(uint3 DispatchThreadId : SV_DispatchThreadID)
 		float objectDistance = DistanceToModelSDF(minDistance, objectData, ObjectsTextures[i], voxelWorldPos);
 		minDistance = min(minDistance, objectDistance);
 	}
-	GlobalSDFTex[voxelCoord] = clamp(minDistance / MaxDistance, -1, 1);
+	GlobalSDFTex[voxelCoord] = clamp(minDistance / MaxDistance, -1, 1) * DistanceEncode.x + DistanceEncode.y;
 }
 
 #endif
@@ -141,7 +146,7 @@ void CS_RasterizeHeightfield(uint3 DispatchThreadId : SV_DispatchThreadID)
 	uint3 voxelCoord = ChunkCoord + DispatchThreadId;
 	float3 voxelWorldPos = voxelCoord * CascadeCoordToPosMul + CascadeCoordToPosAdd;
 	voxelCoord.x += CascadeIndex * CascadeResolution;
-	float minDistance = MaxDistance * GlobalSDFTex[voxelCoord];
+	float minDistance = MaxDistance * (GlobalSDFTex[voxelCoord] * DistanceDecode.x + DistanceDecode.y);
 	float thickness = CascadeVoxelSize * -8;
 	for (uint i = 0; i < ObjectsCount; i++)
 	{
@@ -169,7 +174,7 @@ void CS_RasterizeHeightfield(uint3 DispatchThreadId : SV_DispatchThreadID)
 			objectDistance = thickness - objectDistance;
 		minDistance = min(minDistance, objectDistance);
 	}
-	GlobalSDFTex[voxelCoord] = clamp(minDistance / MaxDistance, -1, 1);
+	GlobalSDFTex[voxelCoord] = clamp(minDistance / MaxDistance, -1, 1) * DistanceEncode.x + DistanceEncode.y;
 }
 
 #endif
@@ -190,6 +195,31 @@ void CS_ClearChunk(uint3 DispatchThreadId : SV_DispatchThreadID)
 
 #endif
 
+#if defined(_CS_CopyCascade)
+
+RWTexture3D<float> GlobalSDFTex : register(u0);
+Texture3D<float> GlobalSDFSrc : register(t0);
+
+// Compute shader for copying Global SDF cascade with an offset (used to scroll cascade on view movement, uncovered voxels are cleared)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(GLOBAL_SDF_RASTERIZE_GROUP_SIZE, GLOBAL_SDF_RASTERIZE_GROUP_SIZE, GLOBAL_SDF_RASTERIZE_GROUP_SIZE)]
+void CS_CopyCascade(uint3 DispatchThreadId : SV_DispatchThreadID)
+{
+	// Reuses mip generation offsets for the source and destination cascade location in the texture
+	int3 srcCoord = (int3)DispatchThreadId + ChunkCoord;
+	float sdf = 1.0f;
+	if (all(srcCoord >= 0) && all(srcCoord < CascadeResolution))
+	{
+		srcCoord.x += GenerateMipTexOffsetX;
+		sdf = GlobalSDFSrc[srcCoord].r;
+	}
+	uint3 voxelCoord = DispatchThreadId;
+	voxelCoord.x += GenerateMipMipOffsetX;
+	GlobalSDFTex[voxelCoord] = sdf;
+}
+
+#endif
+
 #if defined(_CS_GenerateMip)
 
 RWTexture3D<float> GlobalSDFMip : register(u0);
@@ -200,7 +230,7 @@ float SampleSDF(uint3 voxelCoordMip, int3 offset)
 	// Sample SDF
 	voxelCoordMip = (uint3)clamp((int3)voxelCoordMip * GenerateMipCoordScale + offset, 0, GenerateMipTexResolution - 1);
 	voxelCoordMip.x += GenerateMipTexOffsetX;
-	float result = GlobalSDFTex[voxelCoordMip].r;
+	float result = GlobalSDFTex[voxelCoordMip].r * DistanceDecode.x + DistanceDecode.y;
 
 	// Extend by distance to the sampled texel location
 	float distanceInWorldUnits = length(offset) * (MaxDistance / (float)GenerateMipTexResolution);
@@ -227,7 +257,7 @@ void CS_GenerateMip(uint3 DispatchThreadId : SV_DispatchThreadID)
 	minDistance = min(minDistance, SampleSDF(voxelCoordMip, int3(0, 0, -1)));
 
 	voxelCoordMip.x += GenerateMipMipOffsetX;
-	GlobalSDFMip[voxelCoordMip] = minDistance;
+	GlobalSDFMip[voxelCoordMip] = minDistance * DistanceEncode.x + DistanceEncode.y;
 }
 
 #endif
@@ -0,0 +1,96 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+#include "./Flax/Octahedral.hlsl"
+#include "./Flax/Quaternion.hlsl"
+
+META_CB_BEGIN(0, Data)
+float4x4 ViewProjectionMatrix;
+float3 ViewPos;
+uint Frames;
+uint StartInstance;
+float3 Dummy0;
+META_CB_END
+
+struct ImpostorInstance
+{
+	float3 Position;
+	float Radius;
+	float4 Rotation;
+};
+
+StructuredBuffer<ImpostorInstance> Instances : register(t0);
+Texture2DArray Atlas : register(t1);
+
+struct ImpostorVSOutput
+{
+	float4 Position : SV_Position;
+	float3 WorldPosition : TEXCOORD0;
+	float2 TexCoord : TEXCOORD1;
+	nointerpolation float4 Rotation : TEXCOORD2;
+	nointerpolation float4 FrameDirection : TEXCOORD3;
+};
+
+// Gets the atlas view basis for the local-space view direction (matches ModelTool::GenerateModelImpostor)
+void GetFrameBasis(float3 direction, out float3 right, out float3 up)
+{
+	float3 upRef = abs(direction.y) > 0.999f ? float3(0, 0, 1) : float3(0, 1, 0);
+	right = normalize(cross(upRef, direction));
+	up = cross(direction, right);
+}
+
+// Vertex Shader that expands the camera-facing quad of the impostor and selects the closest atlas view
+META_VS(true, FEATURE_LEVEL_SM5)
+ImpostorVSOutput VS(uint vertexID : SV_VertexID, uint instanceID : SV_InstanceID)
+{
+	ImpostorInstance instance = Instances[StartInstance + instanceID];
+	float4 invRotation = float4(-instance.Rotation.xyz, instance.Rotation.w);
+
+	// Pick the atlas view closest to the local-space direction towards the camera (octahedron Z axis is model up axis)
+	float3 toView = QuaternionRotate(invRotation, normalize(ViewPos - instance.Position));
+	float2 octahedral = GetOctahedralCoords(toView.xzy);
+	uint2 frame = (uint2)clamp((int2)((octahedral * 0.5f + 0.5f) * Frames), 0, (int)Frames - 1);
+	float3 direction = GetOctahedralDirection(((float2)frame + 0.5f) / Frames * 2.0f - 1.0f).xzy;
+	float3 right, up;
+	GetFrameBasis(direction, right, up);
+
+	// Build quad (two triangles) in the view plane
+	const float2 corners[6] = { float2(-1, 1), float2(1, 1), float2(1, -1), float2(-1, 1), float2(1, -1), float2(-1, -1) };
+	float2 corner = corners[vertexID % 6];
+	float3 local = (right * corner.x + up * corner.y) * instance.Radius;
+
+	ImpostorVSOutput output;
+	output.WorldPosition = instance.Position + QuaternionRotate(instance.Rotation, local);
+	output.Position = mul(float4(output.WorldPosition, 1), ViewProjectionMatrix);
+	output.TexCoord = ((float2)frame + float2(corner.x * 0.5f + 0.5f, 0.5f - corner.y * 0.5f)) / Frames;
+	output.Rotation = instance.Rotation;
+	output.FrameDirection = float4(QuaternionRotate(instance.Rotation, direction), instance.Radius);
+	return output;
+}
+
+// Pixel Shader that writes the impostor view into the GBuffer
+META_PS(true, FEATURE_LEVEL_SM5)
+void PS(in ImpostorVSOutput input,
+	out float4 Light : SV_Target0,
+	out float4 RT0 : SV_Target1,
+	out float4 RT1 : SV_Target2,
+	out float4 RT2 : SV_Target3,
+	out float4 RT3 : SV_Target4,
+	out float Depth : SV_Depth)
+{
+	float4 albedo = Atlas.Sample(SamplerLinearClamp, float3(input.TexCoord, 0));
+	clip(albedo.a - 0.5f);
+	float4 normalDepth = Atlas.Sample(SamplerLinearClamp, float3(input.TexCoord, 1));
+	float3 normal = normalize(QuaternionRotate(input.Rotation, normalDepth.xyz * 2.0f - 1.0f));
+
+	// Offset the depth by the baked surface distance from the quad plane
+	float3 worldPosition = input.WorldPosition + input.FrameDirection.xyz * ((normalDepth.w * 2.0f - 1.0f) * input.FrameDirection.w);
+	float4 clipPosition = mul(float4(worldPosition, 1), ViewProjectionMatrix);
+	Depth = clipPosition.z / clipPosition.w;
+
+	Light = float4(0, 0, 0, 1);
+	RT0 = float4(albedo.rgb, 1.0f);
+	RT1 = float4(normal * 0.5f + 0.5f, SHADING_MODEL_LIT * (1.0 / 3.0));
+	RT2 = float4(0.8f, 0.0f, 0.5f, 0);
+	RT3 = float4(0, 0, 0, 0);
+}
@@ -0,0 +1,229 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Size of the instances group (maximum amount of the instances in a single range)
+#define GROUP_SIZE 64
+
+// Maximum amount of model LODs (matches MODEL_MAX_LODS)
+#define MAX_LODS 6
+
+// Layout of the arguments buffer: per-LOD instances end offsets, per-LOD write cursors, draw arguments (5 uints per draw)
+#define ARGS_COUNTERS_OFFSET 0
+#define ARGS_CURSORS_OFFSET (MAX_LODS * 4)
+#define ARGS_DRAWS_OFFSET (MAX_LODS * 8)
+#define ARGS_DRAW_STRIDE 20
+
+META_CB_BEGIN(0, Data)
+float3 Origin;
+uint MaxInstances;
+float3 ViewPosition;
+float LODScreenMultipleSq;
+float3 LODViewPosition;
+float MinScreenSizeSq;
+int LODBias;
+int LODsCount;
+uint DrawsCount;
+uint RangesCount;
+float4 LODScreenSizesSq[2];
+float4 FrustumPlanes[6];
+META_CB_END
+
+// Source instance data (compact, positions quantized within the range bounds)
+struct PackedInstance
+{
+	uint TranslationXY;
+	uint TranslationZRandom;
+	uint CenterXY;
+	uint CenterZRadius;
+	uint Rotation;
+	uint ScaleXY;
+	uint ScaleZ;
+	float CullDistance;
+};
+
+// Instances range (bounds are relative to the instances origin)
+struct Range
+{
+	float3 BoundsMin;
+	uint Start;
+	float3 BoundsSize;
+	uint Count;
+};
+
+// Unpacked instance data (positions relative to the instances origin)
+struct Instance
+{
+	float3 Translation;
+	float Random;
+	float3 Center;
+	float Radius;
+	float4 Rotation;
+	float3 Scale;
+	float CullDistance;
+};
+
+StructuredBuffer<PackedInstance> Instances : register(t0);
+StructuredBuffer<Range> Ranges : register(t1);
+RWByteAddressBuffer Args : register(u0);
+RWByteAddressBuffer OutputInstances : register(u1);
+
+float GetLODScreenSizeSq(int lod)
+{
+	float4 sizes = LODScreenSizesSq[lod / 4];
+	return sizes[lod % 4];
+}
+
+float3 Dequantize(uint xy, uint z, Range range)
+{
+	float3 value = float3(xy & 0xffff, xy >> 16, z & 0xffff) * (1.0f / 65535.0f);
+	return range.BoundsMin + value * range.BoundsSize;
+}
+
+// Decodes the smallest three quaternion components packed by InstancesCulling::CullingInstance::Pack
+float4 UnpackRotation(uint packed)
+{
+	float3 smallest = float3(packed & 0x3ff, (packed >> 10) & 0x3ff, (packed >> 20) & 0x3ff) * (1.0f / 1023.0f);
+	smallest = (smallest - 0.5f) * 1.41421356f;
+	float largest = sqrt(saturate(1.0f - dot(smallest, smallest)));
+	uint largestIndex = packed >> 30;
+	if (largestIndex == 0)
+		return float4(largest, smallest.x, smallest.y, smallest.z);
+	if (largestIndex == 1)
+		return float4(smallest.x, largest, smallest.y, smallest.z);
+	if (largestIndex == 2)
+		return float4(smallest.x, smallest.y, largest, smallest.z);
+	return float4(smallest.x, smallest.y, smallest.z, largest);
+}
+
+Instance UnpackInstance(PackedInstance packed, Range range)
+{
+	Instance instance;
+	instance.Translation = Dequantize(packed.TranslationXY, packed.TranslationZRandom, range);
+	instance.Random = (packed.TranslationZRandom >> 16) * (1.0f / 65535.0f);
+	instance.Center = Dequantize(packed.CenterXY, packed.CenterZRadius, range);
+	instance.Radius = f16tof32(packed.CenterZRadius >> 16);
+	instance.Rotation = UnpackRotation(packed.Rotation);
+	instance.Scale = float3(f16tof32(packed.ScaleXY), f16tof32(packed.ScaleXY >> 16), f16tof32(packed.ScaleZ));
+	instance.CullDistance = packed.CullDistance;
+	return instance;
+}
+
+// Gets the instance to process by the thread (returns false if thread has no instance assigned)
+bool GetInstance(uint3 groupId, uint groupIndex, out Instance instance)
+{
+	uint rangeIndex = groupId.y * 65535 + groupId.x;
+	instance = (Instance)0;
+	if (rangeIndex >= RangesCount)
+		return false;
+	Range range = Ranges[rangeIndex];
+	if (groupIndex >= range.Count)
+		return false;
+	instance = UnpackInstance(Instances[range.Start + groupIndex], range);
+	return true;
+}
+
+// Culls the instance and selects its LOD (returns false if instance is not visible)
+bool CullInstance(Instance instance, out int lod)
+{
+	lod = 0;
+	float3 center = Origin + instance.Center;
+
+	// Cull distance
+	if (distance(ViewPosition, center) - instance.Radius >= instance.CullDistance)
+		return false;
+
+	// Frustum
+	UNROLL
+	for (int i = 0; i < 6; i++)
+	{
+		if (dot(FrustumPlanes[i].xyz, center) + FrustumPlanes[i].w < -instance.Radius)
+			return false;
+	}
+
+	// LOD selection (matches RenderTools::ComputeModelLOD)
+	float3 toLODView = center - LODViewPosition;
+	float screenRadiusSq = instance.Radius * instance.Radius * LODScreenMultipleSq / max(1.0f, dot(toLODView, toLODView));
+	if (MinScreenSizeSq > screenRadiusSq)
+		return false;
+	if (LODsCount > 1)
+	{
+		for (int l = LODsCount - 1; l >= 0; l--)
+		{
+			if (GetLODScreenSizeSq(l) >= screenRadiusSq)
+			{
+				lod = l;
+				break;
+			}
+		}
+	}
+	lod = clamp(lod + LODBias, 0, LODsCount - 1);
+	return true;
+}
+
+// Counts visible instances per LOD
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(GROUP_SIZE, 1, 1)]
+void CS_Count(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+	Instance instance;
+	int lod;
+	if (GetInstance(groupId, groupIndex, instance) && CullInstance(instance, lod))
+		Args.InterlockedAdd(ARGS_COUNTERS_OFFSET + lod * 4, 1);
+}
+
+// Computes output instances ranges per LOD and writes the indirect draw arguments
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(1, 1, 1)]
+void CS_Args()
+{
+	uint offsets[MAX_LODS];
+	uint counts[MAX_LODS];
+	uint offset = 0;
+	for (int lod = 0; lod < LODsCount; lod++)
+	{
+		uint count = min(Args.Load(ARGS_COUNTERS_OFFSET + lod * 4), MaxInstances - offset);
+		offsets[lod] = offset;
+		counts[lod] = count;
+		Args.Store(ARGS_COUNTERS_OFFSET + lod * 4, offset + count);
+		Args.Store(ARGS_CURSORS_OFFSET + lod * 4, offset);
+		offset += count;
+	}
+	for (uint draw = 0; draw < DrawsCount; draw++)
+	{
+		uint address = ARGS_DRAWS_OFFSET + draw * ARGS_DRAW_STRIDE;
+		uint drawLOD = Args.Load(address + 16);
+		Args.Store(address + 4, counts[drawLOD]);
+		Args.Store(address + 16, offsets[drawLOD]);
+	}
+}
+
+// Writes the visible instances data (matches InstanceData structure used by the instanced vertex shaders)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(GROUP_SIZE, 1, 1)]
+void CS_Write(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+	Instance instance;
+	int lod;
+	if (!GetInstance(groupId, groupIndex, instance) || !CullInstance(instance, lod))
+		return;
+	uint slot;
+	Args.InterlockedAdd(ARGS_CURSORS_OFFSET + lod * 4, 1, slot);
+	if (slot >= Args.Load(ARGS_COUNTERS_OFFSET + lod * 4))
+		return;
+
+	// Reconstruct the world matrix rows (matches Matrix::Transformation)
+	float4 q = instance.Rotation;
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, zw = q.z * q.w, zx = q.z * q.x;
+	float yw = q.y * q.w, yz = q.y * q.z, xw = q.x * q.w;
+	float3 transform1 = float3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + zw), 2.0f * (zx - yw)) * instance.Scale.x;
+	float3 transform2 = float3(2.0f * (xy - zw), 1.0f - 2.0f * (zz + xx), 2.0f * (yz + xw)) * instance.Scale.y;
+	float3 transform3 = float3(2.0f * (zx + yw), 2.0f * (yz - xw), 1.0f - 2.0f * (yy + xx)) * instance.Scale.z;
+
+	uint address = slot * 64;
+	OutputInstances.Store4(address, asuint(float4(Origin + instance.Translation, instance.Random)));
+	OutputInstances.Store4(address + 16, asuint(float4(transform1, 0.0f)));
+	OutputInstances.Store4(address + 32, asuint(float4(transform2, transform3.x)));
+	OutputInstances.Store4(address + 48, uint4(asuint(transform3.yz), 0, 0));
+}
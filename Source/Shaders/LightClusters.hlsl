@@ -0,0 +1,34 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#ifndef __LIGHT_CLUSTERS__
+#define __LIGHT_CLUSTERS__
+
+// The amount of the view frustum clusters (screen tiles and exponential depth slices)
+#define LIGHT_CLUSTERS_SIZE_X 16
+#define LIGHT_CLUSTERS_SIZE_Y 8
+#define LIGHT_CLUSTERS_SIZE_Z 24
+
+// The maximum amount of the lights per cluster
+#define LIGHT_CLUSTERS_MAX_LIGHTS 32
+
+// The stride (in elements) of the cluster data (lights count followed by the light indices)
+#define LIGHT_CLUSTERS_STRIDE (LIGHT_CLUSTERS_MAX_LIGHTS + 1)
+
+// Structure that contains information about local lights clusters
+struct LightClustersData
+{
+    float DepthScale;
+    float DepthBias;
+    uint LightsCount;
+    uint DeferredLightsCount;
+};
+
+// Gets the offset of the cluster data for the given pixel (screen-space UV and view-space depth)
+uint GetLightClusterOffset(LightClustersData data, float2 uv, float viewDepth)
+{
+    uint2 tile = (uint2)clamp(uv * float2(LIGHT_CLUSTERS_SIZE_X, LIGHT_CLUSTERS_SIZE_Y), 0, float2(LIGHT_CLUSTERS_SIZE_X - 1, LIGHT_CLUSTERS_SIZE_Y - 1));
+    uint slice = (uint)clamp(log(max(viewDepth, 0.0001f)) * data.DepthScale + data.DepthBias, 0, LIGHT_CLUSTERS_SIZE_Z - 1);
+    return ((slice * LIGHT_CLUSTERS_SIZE_Y + tile.y) * LIGHT_CLUSTERS_SIZE_X + tile.x) * LIGHT_CLUSTERS_STRIDE;
+}
+
+#endif
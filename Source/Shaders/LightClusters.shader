@@ -0,0 +1,62 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+#include "./Flax/LightingCommon.hlsl"
+#include "./Flax/LightClusters.hlsl"
+
+#define LIGHT_CLUSTERS_GROUP_SIZE 64
+
+META_CB_BEGIN(0, Data)
+float4x4 ViewMatrix;
+float2 ProjectionScale;
+float2 Dummy0;
+LightClustersData LightClusters;
+META_CB_END
+
+#ifdef _CS_Build
+
+StructuredBuffer<LightData> Lights : register(t0);
+RWStructuredBuffer<uint> Clusters : register(u0);
+
+// Compute shader for culling the local lights into the view frustum clusters (one thread per cluster)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(LIGHT_CLUSTERS_GROUP_SIZE, 1, 1)]
+void CS_Build(uint3 DispatchThreadId : SV_DispatchThreadID)
+{
+	uint clusterIndex = DispatchThreadId.x;
+	if (clusterIndex >= LIGHT_CLUSTERS_SIZE_X * LIGHT_CLUSTERS_SIZE_Y * LIGHT_CLUSTERS_SIZE_Z)
+		return;
+	uint3 cluster;
+	cluster.x = clusterIndex % LIGHT_CLUSTERS_SIZE_X;
+	cluster.y = (clusterIndex / LIGHT_CLUSTERS_SIZE_X) % LIGHT_CLUSTERS_SIZE_Y;
+	cluster.z = clusterIndex / (LIGHT_CLUSTERS_SIZE_X * LIGHT_CLUSTERS_SIZE_Y);
+
+	// Calculate the cluster bounds in view space
+	float depthMin = exp(((float)cluster.z - LightClusters.DepthBias) / LightClusters.DepthScale);
+	float depthMax = exp(((float)cluster.z + 1.0f - LightClusters.DepthBias) / LightClusters.DepthScale);
+	float2 uvMin = (float2)cluster.xy / float2(LIGHT_CLUSTERS_SIZE_X, LIGHT_CLUSTERS_SIZE_Y);
+	float2 uvMax = (float2)(cluster.xy + 1) / float2(LIGHT_CLUSTERS_SIZE_X, LIGHT_CLUSTERS_SIZE_Y);
+	float2 viewMin = float2(uvMin.x * 2.0f - 1.0f, 1.0f - uvMax.y * 2.0f) * ProjectionScale;
+	float2 viewMax = float2(uvMax.x * 2.0f - 1.0f, 1.0f - uvMin.y * 2.0f) * ProjectionScale;
+	float3 boundsMin = float3(min(viewMin * depthMin, viewMin * depthMax), depthMin);
+	float3 boundsMax = float3(max(viewMax * depthMin, viewMax * depthMax), depthMax);
+
+	// Find the lights that intersect with the cluster (lights order is preserved)
+	uint offset = clusterIndex * LIGHT_CLUSTERS_STRIDE;
+	uint count = 0;
+	LOOP
+	for (uint lightIndex = 0; lightIndex < LightClusters.LightsCount && count < LIGHT_CLUSTERS_MAX_LIGHTS; lightIndex++)
+	{
+		LightData light = Lights[lightIndex];
+		float3 center = mul(float4(light.Position, 1), ViewMatrix).xyz;
+		float3 delta = center - clamp(center, boundsMin, boundsMax);
+		if (dot(delta, delta) <= light.Radius * light.Radius)
+		{
+			count++;
+			Clusters[offset + count] = lightIndex;
+		}
+	}
+	Clusters[offset] = count;
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "./Flax/IESProfile.hlsl"
 #include "./Flax/GBuffer.hlsl"
 #include "./Flax/Lighting.hlsl"
+#include "./Flax/LightClusters.hlsl"
 
 // Per light data
 META_CB_BEGIN(0, PerLight)
@@ -27,6 +28,18 @@ Texture2D Shadow : register(t5);
 Texture2D IESTexture : register(t6);
 TextureCube CubeImage : register(t7);
 
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+
+// Local lights clusters data
+META_CB_BEGIN(2, Clusters)
+LightClustersData LightClusters;
+META_CB_END
+
+StructuredBuffer<uint> LightClustersIndices : register(t8);
+StructuredBuffer<LightData> LightClustersLights : register(t9);
+
+#endif
+
 // Vertex Shader for models rendering
 META_VS(true, FEATURE_LEVEL_ES2)
 META_VS_IN_ELEMENT(POSITION, 0, R32G32B32_FLOAT, 0, 0, PER_VERTEX, 0, true)
@@ -154,6 +167,47 @@ void PS_Spot(Model_VS2PS input, out float4 output : SV_Target0)
 #endif
 }
 
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+
+// Pixel shader for clustered local lights rendering (lights without shadows and IES profiles)
+META_PS(true, FEATURE_LEVEL_SM5)
+META_PERMUTATION_1(LIGHTING_NO_SPECULAR=0)
+META_PERMUTATION_1(LIGHTING_NO_SPECULAR=1)
+void PS_Clustered(Quad_VS2PS input, out float4 output : SV_Target0)
+{
+	output = 0;
+
+	// Sample GBuffer
+	GBufferData gBufferData = GetGBufferData();
+	GBufferSample gBuffer = SampleGBuffer(gBufferData, input.TexCoord);
+
+	// Check if cannot light pixel
+	BRANCH
+	if (gBuffer.ShadingModel == SHADING_MODEL_UNLIT)
+	{
+		discard;
+		return;
+	}
+
+	// Calculate lighting from all lights in the pixel cluster
+	uint clusterOffset = GetLightClusterOffset(LightClusters, input.TexCoord, gBuffer.ViewPos.z);
+	uint count = LightClustersIndices[clusterOffset];
+	float4 shadowMask = 1;
+	LOOP
+	for (uint i = 1; i <= count; i++)
+	{
+		// Lights rendered separately (eg. with shadows) are placed after the deferred ones
+		uint lightIndex = LightClustersIndices[clusterOffset + i];
+		if (lightIndex >= LightClusters.DeferredLightsCount)
+			break;
+		LightData light = LightClustersLights[lightIndex];
+		bool isSpotLight = light.SpotAngles.x > -2.0f;
+		output += GetLighting(gBufferData.ViewPos, light, gBuffer, shadowMask, true, isSpotLight);
+	}
+}
+
+#endif
+
 // Pixel shader for sky light rendering
 META_PS(true, FEATURE_LEVEL_ES2)
 float4 PS_Sky(Model_VS2PS input) : SV_Target0
@@ -0,0 +1,23 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+META_CB_BEGIN(0, Data)
+int2 InputMaxCoord;
+float2 Padding;
+META_CB_END
+
+Texture2D Input : register(t0);
+
+// Pixel Shader for depth buffer downscale (to half res) that keeps the farthest depth (used to build the conservative occlusion culling depth buffer)
+META_PS(true, FEATURE_LEVEL_ES3)
+float PS_Downscale(Quad_VS2PS input) : SV_Target
+{
+	int2 coord = (int2)input.Position.xy * 2;
+	float4 depths;
+	depths.x = Input.Load(int3(min(coord, InputMaxCoord), 0)).r;
+	depths.y = Input.Load(int3(min(coord + int2(1, 0), InputMaxCoord), 0)).r;
+	depths.z = Input.Load(int3(min(coord + int2(0, 1), InputMaxCoord), 0)).r;
+	depths.w = Input.Load(int3(min(coord + int2(1, 1), InputMaxCoord), 0)).r;
+	return max(max(depths.x, depths.y), max(depths.z, depths.w));
+}
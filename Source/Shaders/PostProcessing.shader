@@ -311,6 +311,81 @@ float4 PS_GaussainBlurV(Quad_VS2PS input) : SV_Target
 	return color;
 }
 
+#if defined(_CS_BloomDownsample) || defined(_CS_BloomUpsample)
+
+#define BLOOM_GROUP_SIZE 8
+
+META_PUSH_CONSTANTS_BEGIN(BloomPassData)
+float2 BloomSrcTexelSize;
+uint2 BloomDstSize;
+float BloomUpsampleRadius;
+float BloomUpsampleScale;
+float2 BloomDummy;
+META_PUSH_CONSTANTS_END
+
+RWTexture2D<float4> BloomOutput : register(u0);
+
+float3 SampleBloomSource(float2 uv)
+{
+	float3 color = Input0.SampleLevel(SamplerLinearClamp, uv, 0).rgb;
+#if BLOOM_THRESHOLD
+	color = clamp(color - BloomThreshold, 0, BloomLimit);
+#endif
+	return color;
+}
+
+// Bloom downsample with 13 bilinear taps (thresholding is fused into the first downsample from the scene color)
+META_CS(true, FEATURE_LEVEL_SM5)
+META_PERMUTATION_1(BLOOM_THRESHOLD=0)
+META_PERMUTATION_1(BLOOM_THRESHOLD=1)
+[numthreads(BLOOM_GROUP_SIZE, BLOOM_GROUP_SIZE, 1)]
+void CS_BloomDownsample(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	if (any(dispatchThreadId.xy >= BloomDstSize))
+		return;
+	float2 uv = ((float2)dispatchThreadId.xy + 0.5f) / (float2)BloomDstSize;
+	float2 t = BloomSrcTexelSize;
+	float3 a = SampleBloomSource(uv + t * float2(-2, -2));
+	float3 b = SampleBloomSource(uv + t * float2(0, -2));
+	float3 c = SampleBloomSource(uv + t * float2(2, -2));
+	float3 d = SampleBloomSource(uv + t * float2(-2, 0));
+	float3 e = SampleBloomSource(uv);
+	float3 f = SampleBloomSource(uv + t * float2(2, 0));
+	float3 g = SampleBloomSource(uv + t * float2(-2, 2));
+	float3 h = SampleBloomSource(uv + t * float2(0, 2));
+	float3 i = SampleBloomSource(uv + t * float2(2, 2));
+	float3 j = SampleBloomSource(uv + t * float2(-1, -1));
+	float3 k = SampleBloomSource(uv + t * float2(1, -1));
+	float3 l = SampleBloomSource(uv + t * float2(-1, 1));
+	float3 m = SampleBloomSource(uv + t * float2(1, 1));
+	float3 color = e * 0.125f + (a + c + g + i) * 0.03125f + (b + d + f + h) * 0.0625f + (j + k + l + m) * 0.125f;
+	BloomOutput[dispatchThreadId.xy] = float4(color, 1);
+}
+
+// Bloom upsample with 9-tap tent filter of the lower mip combined with the current mip downsample
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(BLOOM_GROUP_SIZE, BLOOM_GROUP_SIZE, 1)]
+void CS_BloomUpsample(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	if (any(dispatchThreadId.xy >= BloomDstSize))
+		return;
+	float2 uv = ((float2)dispatchThreadId.xy + 0.5f) / (float2)BloomDstSize;
+	float4 t = float4(BloomSrcTexelSize, -BloomSrcTexelSize.x, 0) * BloomUpsampleRadius;
+	float3 color = Input0.SampleLevel(SamplerLinearClamp, uv - t.xy, 0).rgb;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv - t.wy, 0).rgb * 2.0f;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv - t.zy, 0).rgb;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv + t.zw, 0).rgb * 2.0f;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv, 0).rgb * 4.0f;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv + t.xw, 0).rgb * 2.0f;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv + t.zy, 0).rgb;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv + t.wy, 0).rgb * 2.0f;
+	color += Input0.SampleLevel(SamplerLinearClamp, uv + t.xy, 0).rgb;
+	color = (color * (1.0f / 16.0f) + Input1[dispatchThreadId.xy].rgb) * BloomUpsampleScale;
+	BloomOutput[dispatchThreadId.xy] = float4(color, 1);
+}
+
+#endif
+
 // Generate 'ghosts' for lens flare
 META_PS(true, FEATURE_LEVEL_ES2)
 float4 PS_Ghosts(Quad_VS2PS input) : SV_Target
@@ -0,0 +1,233 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Amount of triangles processed by a single thread group
+#define TRIANGLES_GROUP_SIZE 64
+
+// Size of the voxels group processed by a single thread group (per axis)
+#define VOXELS_GROUP_SIZE 4
+
+// Distance (in voxels) from the triangle plane within which the voxels get the exact distance during rasterization (the rest is filled by the jump flooding)
+#define RASTERIZE_BAND 1.0f
+
+// Value of the voxel without the closest triangle assigned
+#define INVALID_TRIANGLE 0xffffffff
+
+META_CB_BEGIN(0, Data)
+float3 VoxelToPosMul;
+uint TrianglesCount;
+float3 VoxelToPosAdd;
+float MaxDistance;
+int3 Resolution;
+int JumpStep;
+META_CB_END
+
+// Triangles vertices (9 floats per triangle, model local-space)
+ByteAddressBuffer Triangles : register(t0);
+ByteAddressBuffer InputNearest : register(t1);
+RWByteAddressBuffer Distances : register(u0);
+RWByteAddressBuffer Nearest : register(u1);
+
+struct TriangleData
+{
+	float3 V0;
+	float3 V1;
+	float3 V2;
+};
+
+TriangleData LoadTriangle(uint index)
+{
+	uint address = index * 36;
+	TriangleData tri;
+	tri.V0 = asfloat(Triangles.Load3(address));
+	tri.V1 = asfloat(Triangles.Load3(address + 12));
+	tri.V2 = asfloat(Triangles.Load3(address + 24));
+	return tri;
+}
+
+// Calculates the closest point on the triangle to the given point (Real-Time Collision Detection, Christer Ericson)
+float3 ClosestPointOnTriangle(float3 p, TriangleData tri)
+{
+	float3 ab = tri.V1 - tri.V0;
+	float3 ac = tri.V2 - tri.V0;
+	float3 ap = p - tri.V0;
+	float d1 = dot(ab, ap);
+	float d2 = dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+		return tri.V0;
+	float3 bp = p - tri.V1;
+	float d3 = dot(ab, bp);
+	float d4 = dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+		return tri.V1;
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		return tri.V0 + ab * (d1 / (d1 - d3));
+	float3 cp = p - tri.V2;
+	float d5 = dot(ab, cp);
+	float d6 = dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+		return tri.V2;
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		return tri.V0 + ac * (d2 / (d2 - d6));
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		return tri.V1 + (tri.V2 - tri.V1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	float denom = 1.0f / (va + vb + vc);
+	return tri.V0 + ab * (vb * denom) + ac * (vc * denom);
+}
+
+uint GetVoxelAddress(int3 voxel)
+{
+	return ((voxel.z * Resolution.y + voxel.y) * Resolution.x + voxel.x) * 4;
+}
+
+float3 GetVoxelPosition(int3 voxel)
+{
+	return (float3)voxel * VoxelToPosMul + VoxelToPosAdd;
+}
+
+// Visits the voxels near the triangle surface (iterates over the triangle bounds projected on the dominant plane and the band around the triangle plane along its normal)
+void RasterizeTriangle(uint triangleIndex, bool resolve)
+{
+	TriangleData tri = LoadTriangle(triangleIndex);
+	float3 v0 = (tri.V0 - VoxelToPosAdd) / VoxelToPosMul;
+	float3 v1 = (tri.V1 - VoxelToPosAdd) / VoxelToPosMul;
+	float3 v2 = (tri.V2 - VoxelToPosAdd) / VoxelToPosMul;
+	int3 boundsMin = max((int3)floor(min(v0, min(v1, v2)) - RASTERIZE_BAND), 0);
+	int3 boundsMax = min((int3)ceil(max(v0, max(v1, v2)) + RASTERIZE_BAND), Resolution - 1);
+
+	// Pick the dominant axis of the triangle normal (in voxel-space) to iterate over the columns of voxels crossing the triangle plane
+	float3 normal = cross(v1 - v0, v2 - v0);
+	float normalLength = length(normal);
+	normal = normalLength > 0.000001f ? normal / normalLength : float3(0, 0, 1);
+	float3 normalAbs = abs(normal);
+	uint3 axes = normalAbs.x > normalAbs.y ? (normalAbs.x > normalAbs.z ? uint3(1, 2, 0) : uint3(0, 1, 2)) : (normalAbs.y > normalAbs.z ? uint3(2, 0, 1) : uint3(0, 1, 2));
+	float planeDistance = dot(normal, v0);
+	float bandW = normalLength > 0.000001f ? RASTERIZE_BAND / normalAbs[axes.z] : (float)Resolution[axes.z];
+
+	for (int u = boundsMin[axes.x]; u <= boundsMax[axes.x]; u++)
+	{
+		for (int v = boundsMin[axes.y]; v <= boundsMax[axes.y]; v++)
+		{
+			// Find the plane intersection along the column
+			float w = (planeDistance - normal[axes.x] * u - normal[axes.y] * v) / (normal[axes.z] != 0.0f ? normal[axes.z] : 1.0f);
+			int wMin = max((int)floor(w - bandW), boundsMin[axes.z]);
+			int wMax = min((int)ceil(w + bandW), boundsMax[axes.z]);
+			for (int i = wMin; i <= wMax; i++)
+			{
+				int3 voxel;
+				voxel[axes.x] = u;
+				voxel[axes.y] = v;
+				voxel[axes.z] = i;
+				float3 position = GetVoxelPosition(voxel);
+				float distance = length(position - ClosestPointOnTriangle(position, tri));
+				uint address = GetVoxelAddress(voxel);
+				if (resolve)
+				{
+					// Pick the triangle that matches the closest distance (the same value is computed in both passes)
+					if (asuint(distance) == Distances.Load(address))
+						Nearest.InterlockedMin(address, triangleIndex);
+				}
+				else
+				{
+					// Positive floats keep the order when compared as integers
+					Distances.InterlockedMin(address, asuint(distance));
+				}
+			}
+		}
+	}
+}
+
+// Initializes the voxels (no distance and no closest triangle)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE)]
+void CS_Init(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	int3 voxel = (int3)dispatchThreadId;
+	if (any(voxel >= Resolution))
+		return;
+	uint address = GetVoxelAddress(voxel);
+	Distances.Store(address, asuint(MaxDistance));
+	Nearest.Store(address, INVALID_TRIANGLE);
+}
+
+// Calculates the closest distance for the voxels near every triangle
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(TRIANGLES_GROUP_SIZE, 1, 1)]
+void CS_RasterizeTriangle(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	if (dispatchThreadId.x < TrianglesCount)
+		RasterizeTriangle(dispatchThreadId.x, false);
+}
+
+// Assigns the closest triangle for the voxels near every triangle (after CS_RasterizeTriangle)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(TRIANGLES_GROUP_SIZE, 1, 1)]
+void CS_ResolveTriangle(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	if (dispatchThreadId.x < TrianglesCount)
+		RasterizeTriangle(dispatchThreadId.x, true);
+}
+
+// Propagates the closest triangle to the voxels far from the surface with the jump flooding (single step)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE)]
+void CS_JumpFlood(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	int3 voxel = (int3)dispatchThreadId;
+	if (any(voxel >= Resolution))
+		return;
+	float3 position = GetVoxelPosition(voxel);
+	uint nearest = InputNearest.Load(GetVoxelAddress(voxel));
+	float nearestDistance = MaxDistance * 2;
+	if (nearest != INVALID_TRIANGLE)
+		nearestDistance = length(position - ClosestPointOnTriangle(position, LoadTriangle(nearest)));
+	for (int z = -1; z <= 1; z++)
+	{
+		for (int y = -1; y <= 1; y++)
+		{
+			for (int x = -1; x <= 1; x++)
+			{
+				int3 neighbor = voxel + int3(x, y, z) * JumpStep;
+				if (any(neighbor < 0) || any(neighbor >= Resolution) || (x == 0 && y == 0 && z == 0))
+					continue;
+				uint triangleIndex = InputNearest.Load(GetVoxelAddress(neighbor));
+				if (triangleIndex == INVALID_TRIANGLE || triangleIndex == nearest)
+					continue;
+				float distance = length(position - ClosestPointOnTriangle(position, LoadTriangle(triangleIndex)));
+				if (distance < nearestDistance)
+				{
+					nearestDistance = distance;
+					nearest = triangleIndex;
+				}
+			}
+		}
+	}
+	Nearest.Store(GetVoxelAddress(voxel), nearest);
+}
+
+// Calculates the final signed distance of the voxels (sign is based on the closest triangle facing)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE, VOXELS_GROUP_SIZE)]
+void CS_Encode(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	int3 voxel = (int3)dispatchThreadId;
+	if (any(voxel >= Resolution))
+		return;
+	uint address = GetVoxelAddress(voxel);
+	uint nearest = InputNearest.Load(address);
+	float distance = MaxDistance;
+	if (nearest != INVALID_TRIANGLE)
+	{
+		float3 position = GetVoxelPosition(voxel);
+		TriangleData tri = LoadTriangle(nearest);
+		float3 direction = position - ClosestPointOnTriangle(position, tri);
+		distance = min(length(direction), MaxDistance);
+		if (dot(direction, cross(tri.V1 - tri.V0, tri.V2 - tri.V0)) < 0.0f)
+			distance = -distance;
+	}
+	Distances.Store(address, asuint(distance));
+}
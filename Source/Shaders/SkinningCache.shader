@@ -0,0 +1,70 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Amount of vertices processed by a single thread group
+#define THREAD_GROUP_SIZE 64
+
+META_CB_BEGIN(0, Data)
+uint VertexCount;
+uint InputStride;
+float2 Dummy0;
+META_CB_END
+
+ByteAddressBuffer InputVertices : register(t0);
+Buffer<float4> BoneMatrices : register(t1);
+RWByteAddressBuffer OutputPositions : register(u0);
+RWByteAddressBuffer OutputAttributes : register(u1);
+
+// Unpacks the R10G10B10A2 vector from [0;1] to [-1;1] range
+float3 UnpackVector(uint packed)
+{
+	return float3(packed & 0x3FF, (packed >> 10) & 0x3FF, (packed >> 20) & 0x3FF) * (2.0f / 1023.0f) - 1.0f;
+}
+
+// Packs the vector from [-1;1] to [0;1] range into R10G10B10A2 (preserves the 2-bit alpha)
+uint PackVector(float3 v, uint packed)
+{
+	uint3 u = (uint3)round(saturate(v * 0.5f + 0.5f) * 1023.0f);
+	return (packed & 0xC0000000) | (u.z << 20) | (u.y << 10) | u.x;
+}
+
+// Calculates the transposed transform matrix for the given bone index
+float3x4 GetBoneMatrix(uint index)
+{
+	float4 a = BoneMatrices[index * 3];
+	float4 b = BoneMatrices[index * 3 + 1];
+	float4 c = BoneMatrices[index * 3 + 2];
+	return float3x4(a, b, c);
+}
+
+// Skins the vertices of the skinned mesh (VB0SkinnedElementType) and writes them in the static mesh layout (VB0ElementType and VB1ElementType). Every thread processes a single vertex.
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void CS_Skin(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= VertexCount)
+		return;
+
+	// Load vertex (position, texcoord, normal, tangent, blend indices and blend weights)
+	uint address = index * InputStride;
+	float3 position = asfloat(InputVertices.Load3(address));
+	uint4 attributes = InputVertices.Load4(address + 12);
+	uint2 blendWeightsPacked = InputVertices.Load2(address + 28);
+	uint4 blendIndices = uint4(attributes.w & 0xFF, (attributes.w >> 8) & 0xFF, (attributes.w >> 16) & 0xFF, attributes.w >> 24);
+	float4 blendWeights = float4(f16tof32(blendWeightsPacked.x), f16tof32(blendWeightsPacked.x >> 16), f16tof32(blendWeightsPacked.y), f16tof32(blendWeightsPacked.y >> 16));
+
+	// Perform skinning
+	float3x4 boneMatrix = blendWeights.x * GetBoneMatrix(blendIndices.x);
+	boneMatrix += blendWeights.y * GetBoneMatrix(blendIndices.y);
+	boneMatrix += blendWeights.z * GetBoneMatrix(blendIndices.z);
+	boneMatrix += blendWeights.w * GetBoneMatrix(blendIndices.w);
+	position = mul(boneMatrix, float4(position, 1));
+	float3 normal = normalize(mul(boneMatrix, float4(UnpackVector(attributes.y), 0)));
+	float3 tangent = normalize(mul(boneMatrix, float4(UnpackVector(attributes.z), 0)));
+
+	// Write vertex (bitangent sign is kept in the tangent alpha, lightmap UVs are unused)
+	OutputPositions.Store3(index * 12, asuint(position));
+	OutputAttributes.Store4(index * 16, uint4(attributes.x, PackVector(normal, attributes.y), PackVector(tangent, attributes.z), 0));
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2012-2023 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Amount of samples per tile in every dimension (each thread processes a single sample)
+#define THREAD_GROUP_SIZE 8
+
+// Shading rates (matches GPUShadingRate)
+#define SHADING_RATE_1X1 0
+#define SHADING_RATE_1X2 1
+#define SHADING_RATE_2X1 4
+#define SHADING_RATE_2X2 5
+#define SHADING_RATE_4X4 10
+
+META_CB_BEGIN(0, Data)
+float2 InputSize;
+uint TileSize;
+uint SampleStride;
+float ContrastThreshold;
+float MotionThreshold;
+uint MaxShadingRate;
+float Dummy0;
+META_CB_END
+
+Texture2D Input : register(t0);
+Texture2D MotionVectors : register(t1);
+RWTexture2D<uint> Output : register(u0);
+
+groupshared uint TileContrastX;
+groupshared uint TileContrastY;
+groupshared uint TileMotion;
+
+float GetPerceptualLuminance(uint2 pixel)
+{
+	// Compress HDR range so the contrast in very bright areas doesn't dominate
+	float luminance = Luminance(Input.Load(int3(min(pixel, (uint2)InputSize - 1), 0)).rgb);
+	return luminance / (1.0f + luminance);
+}
+
+// Generates the shading rate image from the scene color contrast (and motion vectors, if available). Every thread group processes a single tile.
+META_CS(true, FEATURE_LEVEL_SM5)
+META_PERMUTATION_1(USE_MOTION_VECTORS=0)
+META_PERMUTATION_1(USE_MOTION_VECTORS=1)
+[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]
+void CS_Generate(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+	if (groupIndex == 0)
+	{
+		TileContrastX = 0;
+		TileContrastY = 0;
+		TileMotion = 0;
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	// Measure the local contrast relative to the neighbors (positive floats can be compared as uints)
+	uint2 pixel = groupId.xy * TileSize + groupThreadId.xy * SampleStride;
+	float luminance = GetPerceptualLuminance(pixel);
+	float luminanceX = GetPerceptualLuminance(pixel + uint2(1, 0));
+	float luminanceY = GetPerceptualLuminance(pixel + uint2(0, 1));
+	float normalization = 1.0f / (luminance + 0.05f);
+	InterlockedMax(TileContrastX, asuint(abs(luminance - luminanceX) * normalization));
+	InterlockedMax(TileContrastY, asuint(abs(luminance - luminanceY) * normalization));
+#if USE_MOTION_VECTORS
+	float2 uv = ((float2)pixel + 0.5f) / InputSize;
+	float2 motion = MotionVectors.SampleLevel(SamplerPointClamp, uv, 0).xy * InputSize;
+	InterlockedMax(TileMotion, asuint(length(motion)));
+#endif
+	GroupMemoryBarrierWithGroupSync();
+
+	if (groupIndex == 0)
+	{
+		// Fast moving areas get blurred so they can use coarser shading
+		float threshold = ContrastThreshold;
+		float motionLength = asfloat(TileMotion);
+		if (motionLength > MotionThreshold)
+			threshold *= min(motionLength / MotionThreshold, 4.0f);
+
+		// Pick the shading rate (coarser along the direction with low contrast)
+		float contrastX = asfloat(TileContrastX);
+		float contrastY = asfloat(TileContrastY);
+		uint rate = SHADING_RATE_1X1;
+		if (contrastX < threshold * 0.25f && contrastY < threshold * 0.25f)
+			rate = MaxShadingRate;
+		else if (contrastX < threshold && contrastY < threshold)
+			rate = SHADING_RATE_2X2;
+		else if (contrastX < threshold)
+			rate = SHADING_RATE_2X1;
+		else if (contrastY < threshold)
+			rate = SHADING_RATE_1X2;
+		Output[groupId.xy] = rate;
+	}
+}
@@ -0,0 +1,261 @@
+/*
+   LZ4 HC - High Compression Mode of LZ4
+
+   Hash-chain match finder producing the standard LZ4 block format (decoded with LZ4_decompress_safe()).
+   Implements the LZ4_compress_HC() entry point of the upstream lz4hc.c API (https://github.com/lz4/lz4).
+
+   BSD 2-Clause License (http://www.opensource.org/licenses/bsd-license.php)
+*/
+
+#include "lz4hc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/*-************************************
+*  Constants
+**************************************/
+#define MINMATCH 4
+#define LASTLITERALS 5
+#define MFLIMIT 12
+#define MAX_DISTANCE 65535
+
+#define ML_BITS  4
+#define ML_MASK  ((1U<<ML_BITS)-1)
+#define RUN_BITS (8-ML_BITS)
+#define RUN_MASK ((1U<<RUN_BITS)-1)
+
+#define LZ4HC_HASH_LOG 15
+#define LZ4HC_HASHTABLESIZE (1 << LZ4HC_HASH_LOG)
+#define LZ4HC_MAXD (1 << 16)
+#define LZ4HC_MAXD_MASK (LZ4HC_MAXD - 1)
+
+typedef unsigned char BYTE;
+typedef unsigned short U16;
+typedef unsigned int U32;
+
+
+/*-************************************
+*  HC context
+**************************************/
+typedef struct
+{
+    int hashTable[LZ4HC_HASHTABLESIZE]; /* last position with the given hash (-1 if none) */
+    U16 chainTable[LZ4HC_MAXD];         /* distance to the previous position with the same hash (0 if none) */
+    const BYTE* base;
+    int nextToUpdate;
+} LZ4HC_Context;
+
+static U32 LZ4HC_read32(const void* ptr)
+{
+    U32 val;
+    memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+static U32 LZ4HC_hashPtr(const void* ptr)
+{
+    return (LZ4HC_read32(ptr) * 2654435761U) >> ((MINMATCH * 8) - LZ4HC_HASH_LOG);
+}
+
+static void LZ4HC_writeLE16(void* ptr, U16 value)
+{
+    BYTE* p = (BYTE*)ptr;
+    p[0] = (BYTE)value;
+    p[1] = (BYTE)(value >> 8);
+}
+
+/* Inserts all positions preceding `ip` into the hash chains */
+static void LZ4HC_insert(LZ4HC_Context* ctx, const BYTE* ip)
+{
+    const int target = (int)(ip - ctx->base);
+    int idx = ctx->nextToUpdate;
+    while (idx < target)
+    {
+        const U32 h = LZ4HC_hashPtr(ctx->base + idx);
+        const int prev = ctx->hashTable[h];
+        int delta = idx - prev;
+        if (prev < 0 || delta > MAX_DISTANCE)
+            delta = 0;
+        ctx->chainTable[idx & LZ4HC_MAXD_MASK] = (U16)delta;
+        ctx->hashTable[h] = idx;
+        idx++;
+    }
+    ctx->nextToUpdate = target;
+}
+
+static int LZ4HC_count(const BYTE* ip, const BYTE* match, const BYTE* iLimit)
+{
+    const BYTE* const start = ip;
+    while (ip < iLimit && *ip == *match)
+    {
+        ip++;
+        match++;
+    }
+    return (int)(ip - start);
+}
+
+/* Finds the longest match for `ip` (ending before `iLimit`), testing up to `maxAttempts` candidates */
+static int LZ4HC_findBestMatch(LZ4HC_Context* ctx, const BYTE* ip, const BYTE* iLimit, const BYTE** matchPos, int maxAttempts)
+{
+    const BYTE* const base = ctx->base;
+    const int ipIndex = (int)(ip - base);
+    int bestLength = 0;
+    LZ4HC_insert(ctx, ip);
+    int matchIndex = ctx->hashTable[LZ4HC_hashPtr(ip)];
+    while (matchIndex >= 0 && ipIndex - matchIndex <= MAX_DISTANCE && maxAttempts-- > 0)
+    {
+        const BYTE* const match = base + matchIndex;
+        if (match[bestLength] == ip[bestLength] && LZ4HC_read32(match) == LZ4HC_read32(ip))
+        {
+            const int length = MINMATCH + LZ4HC_count(ip + MINMATCH, match + MINMATCH, iLimit);
+            if (length > bestLength)
+            {
+                bestLength = length;
+                *matchPos = match;
+                if (ip + length >= iLimit)
+                    break;
+            }
+        }
+        const U16 delta = ctx->chainTable[matchIndex & LZ4HC_MAXD_MASK];
+        if (delta == 0)
+            break;
+        matchIndex -= delta;
+    }
+    return bestLength;
+}
+
+static BYTE* LZ4HC_writeLength(BYTE* op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = (BYTE)length;
+    return op;
+}
+
+/* Writes a single sequence (literals + match), returns 0 if output buffer is too small */
+static int LZ4HC_encodeSequence(const BYTE** ip, BYTE** op, const BYTE** anchor, int matchLength, const BYTE* match, const BYTE* oend)
+{
+    const size_t litLength = (size_t)(*ip - *anchor);
+    BYTE* token = (*op)++;
+    if (*op + litLength + (litLength / 255) + 2 + 1 + ((size_t)matchLength / 255) + 1 > oend)
+        return 0;
+
+    /* Literals */
+    if (litLength >= RUN_MASK)
+    {
+        *token = (BYTE)(RUN_MASK << ML_BITS);
+        *op = LZ4HC_writeLength(*op, litLength - RUN_MASK);
+    }
+    else
+    {
+        *token = (BYTE)(litLength << ML_BITS);
+    }
+    memcpy(*op, *anchor, litLength);
+    *op += litLength;
+
+    /* Offset */
+    LZ4HC_writeLE16(*op, (U16)(*ip - match));
+    *op += 2;
+
+    /* Match length */
+    const size_t length = (size_t)(matchLength - MINMATCH);
+    if (length >= ML_MASK)
+    {
+        *token += ML_MASK;
+        *op = LZ4HC_writeLength(*op, length - ML_MASK);
+    }
+    else
+    {
+        *token += (BYTE)length;
+    }
+
+    *ip += matchLength;
+    *anchor = *ip;
+    return 1;
+}
+
+static int LZ4HC_compress_generic(LZ4HC_Context* ctx, const char* src, char* dst, int srcSize, int dstCapacity, int compressionLevel)
+{
+    const BYTE* ip = (const BYTE*)src;
+    const BYTE* anchor = ip;
+    const BYTE* const iend = ip + srcSize;
+    BYTE* op = (BYTE*)dst;
+    BYTE* const oend = op + dstCapacity;
+
+    if (compressionLevel < LZ4HC_CLEVEL_MIN)
+        compressionLevel = LZ4HC_CLEVEL_MIN;
+    if (compressionLevel > LZ4HC_CLEVEL_MAX)
+        compressionLevel = LZ4HC_CLEVEL_MAX;
+    const int maxAttempts = 1 << (compressionLevel - 1);
+
+    ctx->base = ip;
+    ctx->nextToUpdate = 0;
+    memset(ctx->hashTable, 0xFF, sizeof(ctx->hashTable));
+
+    if (srcSize >= MFLIMIT + 1)
+    {
+        const BYTE* const mflimit = iend - MFLIMIT;
+        const BYTE* const matchlimit = iend - LASTLITERALS;
+        ip++;
+        while (ip <= mflimit)
+        {
+            const BYTE* match = NULL;
+            int matchLength = LZ4HC_findBestMatch(ctx, ip, matchlimit, &match, maxAttempts);
+            if (matchLength < MINMATCH)
+            {
+                ip++;
+                continue;
+            }
+
+            /* Lazy matching: prefer a longer match starting at the next position */
+            while (ip + 1 <= mflimit)
+            {
+                const BYTE* nextMatch = NULL;
+                const int nextLength = LZ4HC_findBestMatch(ctx, ip + 1, matchlimit, &nextMatch, maxAttempts);
+                if (nextLength <= matchLength)
+                    break;
+                ip++;
+                matchLength = nextLength;
+                match = nextMatch;
+            }
+
+            if (!LZ4HC_encodeSequence(&ip, &op, &anchor, matchLength, match, oend))
+                return 0;
+        }
+    }
+
+    /* Last literals */
+    {
+        const size_t lastRun = (size_t)(iend - anchor);
+        if (op + 1 + lastRun + ((lastRun + 255 - RUN_MASK) / 255) > oend)
+            return 0;
+        if (lastRun >= RUN_MASK)
+        {
+            *op++ = (BYTE)(RUN_MASK << ML_BITS);
+            op = LZ4HC_writeLength(op, lastRun - RUN_MASK);
+        }
+        else
+        {
+            *op++ = (BYTE)(lastRun << ML_BITS);
+        }
+        if (lastRun != 0)
+            memcpy(op, anchor, lastRun);
+        op += lastRun;
+    }
+
+    return (int)(op - (BYTE*)dst);
+}
+
+int LZ4_compress_HC(const char* src, char* dst, int srcSize, int dstCapacity, int compressionLevel)
+{
+    if ((unsigned)srcSize > (unsigned)LZ4_MAX_INPUT_SIZE || dstCapacity <= 0)
+        return 0;
+    LZ4HC_Context* const ctx = (LZ4HC_Context*)malloc(sizeof(LZ4HC_Context));
+    if (ctx == NULL)
+        return 0;
+    const int result = LZ4HC_compress_generic(ctx, src, dst, srcSize, dstCapacity, compressionLevel);
+    free(ctx);
+    return result;
+}
@@ -0,0 +1,42 @@
+/*
+   LZ4 HC - High Compression Mode of LZ4
+   Header File
+
+   Compatible subset of the upstream lz4hc.h API (https://github.com/lz4/lz4).
+   The encoder produces the standard LZ4 block format so the output is decoded with LZ4_decompress_safe().
+
+   BSD 2-Clause License (http://www.opensource.org/licenses/bsd-license.php)
+*/
+#ifndef LZ4_HC_H_19834876238432
+#define LZ4_HC_H_19834876238432
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#include "lz4.h"
+
+/* --- Useful constants --- */
+#define LZ4HC_CLEVEL_MIN         3
+#define LZ4HC_CLEVEL_DEFAULT     9
+#define LZ4HC_CLEVEL_MAX        12
+
+/*! LZ4_compress_HC() :
+ *  Compress data from `src` into `dst`, using the more powerful but slower "HC" algorithm.
+ *  `dst` must be already allocated.
+ *  Compression is guaranteed to succeed if `dstCapacity >= LZ4_compressBound(srcSize)` (see "lz4.h")
+ *  Max supported `srcSize` value is LZ4_MAX_INPUT_SIZE (see "lz4.h")
+ *  `compressionLevel` : any value between 1 and LZ4HC_CLEVEL_MAX will work.
+ *                       Values > LZ4HC_CLEVEL_MAX behave the same as LZ4HC_CLEVEL_MAX.
+ *                       Values < LZ4HC_CLEVEL_MIN behave the same as LZ4HC_CLEVEL_MIN.
+ *                       Each level doubles the amount of match candidates tested per position.
+ * @return : the number of bytes written into 'dst'
+ *           or 0 if compression fails.
+ */
+LZ4LIB_API int LZ4_compress_HC (const char* src, char* dst, int srcSize, int dstCapacity, int compressionLevel);
+
+#if defined (__cplusplus)
+}
+#endif
+
+#endif /* LZ4_HC_H_19834876238432 */
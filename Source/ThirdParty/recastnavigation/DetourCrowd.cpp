@@ -340,8 +340,20 @@ dtCrowd::dtCrowd() :
 	m_maxPathResult(0),
 	m_maxAgentRadius(0),
 	m_velocitySampleCount(0),
-	m_navquery(0)
+	m_navquery(0),
+	m_scheduler(0),
+	m_maxWorkers(1),
+	m_nworkers(0),
+	m_lodDistance(0),
+	m_lodUpdateInterval(1),
+	m_updateCounter(0),
+	m_nactiveAgents(0),
+	m_debug(0)
 {
+	memset(m_workerNavQueries, 0, sizeof(m_workerNavQueries));
+	memset(m_workerObstacleQueries, 0, sizeof(m_workerObstacleQueries));
+	memset(m_workerVelocitySampleCount, 0, sizeof(m_workerVelocitySampleCount));
+	dtVset(m_lodOrigin, 0, 0, 0);
 }
 
 dtCrowd::~dtCrowd()
@@ -351,6 +363,8 @@ dtCrowd::~dtCrowd()
 
 void dtCrowd::purge()
 {
+	purgeWorkers();
+
 	for (int i = 0; i < m_maxAgents; ++i)
 		m_agents[i].~dtCrowdAgent();
 	dtFree(m_agents);
@@ -458,10 +472,71 @@ bool dtCrowd::init(const int maxAgents, const float maxAgentRadius, dtNavMesh* n
 		return false;
 	if (dtStatusFailed(m_navquery->init(nav, MAX_COMMON_NODES)))
 		return false;
+
+	if (!initWorkers())
+		return false;
 	
 	return true;
 }
 
+void dtCrowd::purgeWorkers()
+{
+	// Worker 0 uses the crowd objects
+	for (int i = 1; i < m_nworkers; ++i)
+	{
+		dtFreeNavMeshQuery(m_workerNavQueries[i]);
+		dtFreeObstacleAvoidanceQuery(m_workerObstacleQueries[i]);
+	}
+	memset(m_workerNavQueries, 0, sizeof(m_workerNavQueries));
+	memset(m_workerObstacleQueries, 0, sizeof(m_workerObstacleQueries));
+	m_nworkers = 0;
+}
+
+bool dtCrowd::initWorkers()
+{
+	purgeWorkers();
+	if (!m_navquery || !m_obstacleQuery)
+		return true;
+
+	m_workerNavQueries[0] = m_navquery;
+	m_workerObstacleQueries[0] = m_obstacleQuery;
+	m_nworkers = 1;
+	const int maxWorkers = m_scheduler ? m_maxWorkers : 1;
+	for (int i = 1; i < maxWorkers; ++i)
+	{
+		dtNavMeshQuery* navquery = dtAllocNavMeshQuery();
+		if (!navquery)
+			return false;
+		m_workerNavQueries[i] = navquery;
+		dtObstacleAvoidanceQuery* obstacleQuery = dtAllocObstacleAvoidanceQuery();
+		if (!obstacleQuery)
+		{
+			dtFreeNavMeshQuery(navquery);
+			m_workerNavQueries[i] = 0;
+			return false;
+		}
+		m_workerObstacleQueries[i] = obstacleQuery;
+		m_nworkers++;
+		if (dtStatusFailed(navquery->init(m_navquery->getAttachedNavMesh(), MAX_COMMON_NODES)) || !obstacleQuery->init(6, 8))
+			return false;
+	}
+	return true;
+}
+
+bool dtCrowd::setJobScheduler(dtCrowdJobScheduler* scheduler, const int maxWorkers)
+{
+	m_scheduler = scheduler;
+	m_maxWorkers = dtClamp(maxWorkers, 1, DT_CROWD_MAX_WORKERS);
+	return initWorkers();
+}
+
+void dtCrowd::setLOD(const float* origin, const float distance, const int updateInterval)
+{
+	dtVcopy(m_lodOrigin, origin);
+	m_lodDistance = distance;
+	m_lodUpdateInterval = dtMax(updateInterval, 1);
+}
+
 void dtCrowd::setObstacleAvoidanceParams(const int idx, const dtObstacleAvoidanceParams* params)
 {
 	if (idx >= 0 && idx < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS)
@@ -545,6 +620,7 @@ int dtCrowd::addAgent(const float* pos, const dtCrowdAgentParams* params)
 
 	ag->topologyOptTime = 0;
 	ag->targetReplanTime = 0;
+	ag->lod = 0;
 	ag->nneis = 0;
 	
 	dtVset(ag->dvel, 0,0,0);
@@ -1044,49 +1120,54 @@ void dtCrowd::checkPathValidity(dtCrowdAgent** agents, const int nagents, const
 	}
 }
 	
-void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
+void dtCrowd::runPhaseJob(void* context, const int index)
 {
-	m_velocitySampleCount = 0;
-	
-	const int debugIdx = debug ? debug->idx : -1;
-	
-	dtCrowdAgent** agents = m_activeAgents;
-	int nagents = getActiveAgents(agents, m_maxAgents);
-
-	// Check that all agents still have valid paths.
-	checkPathValidity(agents, nagents, dt);
-	
-	// Update async move request and path finder.
-	updateMoveRequest(dt);
+	const PhaseContext* ctx = (const PhaseContext*)context;
+	const int begin = (int)((long long)ctx->nagents * index / ctx->njobs);
+	const int end = (int)((long long)ctx->nagents * (index + 1) / ctx->njobs);
+	(ctx->crowd->*ctx->func)(ctx->agents, begin, end, index, ctx->dt);
+}
 
-	// Optimize path topology.
-	updateTopologyOptimization(agents, nagents, dt);
-	
-	// Register agents to proximity grid.
-	m_grid->clear();
-	for (int i = 0; i < nagents; ++i)
+void dtCrowd::runPhase(const int phase, PhaseFunc func, dtCrowdAgent** agents, const int nagents, const float dt)
+{
+	if (!m_scheduler)
 	{
-		dtCrowdAgent* ag = agents[i];
-		const float* p = ag->npos;
-		const float r = ag->params.radius;
-		m_grid->addItem((unsigned short)i, p[0]-r, p[2]-r, p[0]+r, p[2]+r);
+		(this->*func)(agents, 0, nagents, 0, dt);
+		return;
 	}
-	
-	// Get nearby navmesh segments and agents to collide with.
-	for (int i = 0; i < nagents; ++i)
+
+	// Split agents into ranges processed by the workers (small crowds are not worth the jobs overhead).
+	static const int MIN_AGENTS_PER_JOB = 32;
+	PhaseContext ctx;
+	ctx.crowd = this;
+	ctx.func = func;
+	ctx.agents = agents;
+	ctx.nagents = nagents;
+	ctx.njobs = dtClamp(nagents / MIN_AGENTS_PER_JOB, 1, m_nworkers);
+	ctx.dt = dt;
+	m_scheduler->run(phase, &dtCrowd::runPhaseJob, &ctx, ctx.njobs);
+}
+
+void dtCrowd::updateNeighbourhood(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float /*dt*/)
+{
+	dtNavMeshQuery* navquery = m_workerNavQueries[worker];
+	const int nagents = m_nactiveAgents;
+	for (int i = begin; i < end; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 			continue;
+		if (!isLODUpdateFrame(ag))
+			continue;
 
 		// Update the collision boundary after certain distance has been passed or
 		// if it has become invalid.
 		const float updateThr = ag->params.collisionQueryRange*0.25f;
 		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
-			!ag->boundary.isValid(m_navquery, &m_filters[ag->params.queryFilterType]))
+			!ag->boundary.isValid(navquery, &m_filters[ag->params.queryFilterType]))
 		{
 			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
-								m_navquery, &m_filters[ag->params.queryFilterType]);
+								navquery, &m_filters[ag->params.queryFilterType]);
 		}
 		// Query neighbour agents
 		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
@@ -1095,9 +1176,13 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		for (int j = 0; j < ag->nneis; j++)
 			ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
 	}
-	
-	// Find next corner to steer to.
-	for (int i = 0; i < nagents; ++i)
+}
+
+void dtCrowd::updateCorners(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float /*dt*/)
+{
+	dtNavMeshQuery* navquery = m_workerNavQueries[worker];
+	const int debugIdx = m_debug ? m_debug->idx : -1;
+	for (int i = begin; i < end; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 		
@@ -1108,20 +1193,20 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		
 		// Find corners for steering
 		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
-												DT_CROWDAGENT_MAX_CORNERS, m_navquery, &m_filters[ag->params.queryFilterType]);
+												DT_CROWDAGENT_MAX_CORNERS, navquery, &m_filters[ag->params.queryFilterType]);
 		
 		// Check to see if the corner after the next corner is directly visible,
 		// and short cut to there.
-		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
+		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0 && isLODUpdateFrame(ag))
 		{
 			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
-			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, m_navquery, &m_filters[ag->params.queryFilterType]);
+			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, navquery, &m_filters[ag->params.queryFilterType]);
 			
 			// Copy data for debug purposes.
 			if (debugIdx == i)
 			{
-				dtVcopy(debug->optStart, ag->corridor.getPos());
-				dtVcopy(debug->optEnd, target);
+				dtVcopy(m_debug->optStart, ag->corridor.getPos());
+				dtVcopy(m_debug->optEnd, target);
 			}
 		}
 		else
@@ -1129,55 +1214,16 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 			// Copy data for debug purposes.
 			if (debugIdx == i)
 			{
-				dtVset(debug->optStart, 0,0,0);
-				dtVset(debug->optEnd, 0,0,0);
-			}
-		}
-	}
-	
-	// Trigger off-mesh connections (depends on corners).
-	for (int i = 0; i < nagents; ++i)
-	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-			continue;
-		
-		// Check 
-		const float triggerRadius = ag->params.radius*2.25f;
-		if (overOffmeshConnection(ag, triggerRadius))
-		{
-			// Prepare to off-mesh connection.
-			const int idx = (int)(ag - m_agents);
-			dtCrowdAgentAnimation* anim = &m_agentAnims[idx];
-			
-			// Adjust the path over the off-mesh connection.
-			dtPolyRef refs[2];
-			if (ag->corridor.moveOverOffmeshConnection(ag->cornerPolys[ag->ncorners-1], refs,
-													   anim->startPos, anim->endPos, m_navquery))
-			{
-				dtVcopy(anim->initPos, ag->npos);
-				anim->polyRef = refs[1];
-				anim->active = true;
-				anim->t = 0.0f;
-				anim->tmax = (dtVdist2D(anim->startPos, anim->endPos) / ag->params.maxSpeed) * 0.5f;
-				
-				ag->state = DT_CROWDAGENT_STATE_OFFMESH;
-				ag->ncorners = 0;
-				ag->nneis = 0;
-				continue;
-			}
-			else
-			{
-				// Path validity check will ensure that bad/blocked connections will be replanned.
+				dtVset(m_debug->optStart, 0,0,0);
+				dtVset(m_debug->optEnd, 0,0,0);
 			}
 		}
 	}
-		
-	// Calculate steering.
-	for (int i = 0; i < nagents; ++i)
+}
+
+void dtCrowd::updateSteering(dtCrowdAgent** agents, const int begin, const int end, const int /*worker*/, const float /*dt*/)
+{
+	for (int i = begin; i < end; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 
@@ -1254,24 +1300,30 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		// Set the desired velocity.
 		dtVcopy(ag->dvel, dvel);
 	}
-	
-	// Velocity planning.	
-	for (int i = 0; i < nagents; ++i)
+}
+
+void dtCrowd::updateAvoidance(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float /*dt*/)
+{
+	dtObstacleAvoidanceQuery* obstacleQuery = m_workerObstacleQueries[worker];
+	const int debugIdx = m_debug ? m_debug->idx : -1;
+	int velocitySampleCount = 0;
+	for (int i = begin; i < end; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 		
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 			continue;
 		
-		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
+		// Distant agents skip the velocity sampling
+		if ((ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE) && ag->lod == 0)
 		{
-			m_obstacleQuery->reset();
+			obstacleQuery->reset();
 			
 			// Add neighbours as obstacles.
 			for (int j = 0; j < ag->nneis; ++j)
 			{
 				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+				obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
 			}
 
 			// Append neighbour segments as obstacles.
@@ -1280,12 +1332,12 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				const float* s = ag->boundary.getSegment(j);
 				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
 					continue;
-				m_obstacleQuery->addSegment(s, s+3);
+				obstacleQuery->addSegment(s, s+3);
 			}
 
 			dtObstacleAvoidanceDebugData* vod = 0;
 			if (debugIdx == i) 
-				vod = debug->vod;
+				vod = m_debug->vod;
 			
 			// Sample new safe velocity.
 			bool adaptive = true;
@@ -1295,15 +1347,15 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				
 			if (adaptive)
 			{
-				ns = m_obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
-															 ag->vel, ag->dvel, ag->nvel, params, vod);
+				ns = obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+														   ag->vel, ag->dvel, ag->nvel, params, vod);
 			}
 			else
 			{
-				ns = m_obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
-														 ag->vel, ag->dvel, ag->nvel, params, vod);
+				ns = obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
+													   ag->vel, ag->dvel, ag->nvel, params, vod);
 			}
-			m_velocitySampleCount += ns;
+			velocitySampleCount += ns;
 		}
 		else
 		{
@@ -1311,15 +1363,139 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 			dtVcopy(ag->nvel, ag->dvel);
 		}
 	}
+	m_workerVelocitySampleCount[worker] += velocitySampleCount;
+}
 
-	// Integrate.
-	for (int i = 0; i < nagents; ++i)
+void dtCrowd::updateIntegration(dtCrowdAgent** agents, const int begin, const int end, const int /*worker*/, const float dt)
+{
+	for (int i = begin; i < end; ++i)
 	{
 		dtCrowdAgent* ag = agents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 			continue;
 		integrate(ag, dt);
 	}
+}
+
+void dtCrowd::updateMovement(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float /*dt*/)
+{
+	dtNavMeshQuery* navquery = m_workerNavQueries[worker];
+	for (int i = begin; i < end; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+		
+		// Move along navmesh.
+		ag->corridor.movePosition(ag->npos, navquery, &m_filters[ag->params.queryFilterType]);
+		// Get valid constrained position back.
+		dtVcopy(ag->npos, ag->corridor.getPos());
+
+		// If not using path, truncate the corridor to just one poly.
+		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+		{
+			ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
+			ag->partial = false;
+		}
+	}
+}
+
+void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
+{
+	m_velocitySampleCount = 0;
+	m_debug = debug;
+	m_updateCounter++;
+	
+	dtCrowdAgent** agents = m_activeAgents;
+	int nagents = getActiveAgents(agents, m_maxAgents);
+	m_nactiveAgents = nagents;
+
+	// Update agents level of detail.
+	const float lodDistanceSqr = dtSqr(m_lodDistance);
+	for (int i = 0; i < nagents; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		ag->lod = m_lodDistance > 0.0f && dtVdist2DSqr(ag->npos, m_lodOrigin) > lodDistanceSqr ? 1 : 0;
+	}
+
+	// Check that all agents still have valid paths.
+	checkPathValidity(agents, nagents, dt);
+	
+	// Update async move request and path finder.
+	updateMoveRequest(dt);
+
+	// Optimize path topology.
+	updateTopologyOptimization(agents, nagents, dt);
+	
+	// Register agents to proximity grid.
+	m_grid->clear();
+	for (int i = 0; i < nagents; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		const float* p = ag->npos;
+		const float r = ag->params.radius;
+		m_grid->addItem((unsigned short)i, p[0]-r, p[2]-r, p[0]+r, p[2]+r);
+	}
+	
+	// Get nearby navmesh segments and agents to collide with.
+	runPhase(DT_CROWD_PHASE_NEIGHBOURHOOD, &dtCrowd::updateNeighbourhood, agents, nagents, dt);
+	
+	// Find next corner to steer to.
+	runPhase(DT_CROWD_PHASE_CORNERS, &dtCrowd::updateCorners, agents, nagents, dt);
+	
+	// Trigger off-mesh connections (depends on corners).
+	for (int i = 0; i < nagents; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+			continue;
+		
+		// Check 
+		const float triggerRadius = ag->params.radius*2.25f;
+		if (overOffmeshConnection(ag, triggerRadius))
+		{
+			// Prepare to off-mesh connection.
+			const int idx = (int)(ag - m_agents);
+			dtCrowdAgentAnimation* anim = &m_agentAnims[idx];
+			
+			// Adjust the path over the off-mesh connection.
+			dtPolyRef refs[2];
+			if (ag->corridor.moveOverOffmeshConnection(ag->cornerPolys[ag->ncorners-1], refs,
+													   anim->startPos, anim->endPos, m_navquery))
+			{
+				dtVcopy(anim->initPos, ag->npos);
+				anim->polyRef = refs[1];
+				anim->active = true;
+				anim->t = 0.0f;
+				anim->tmax = (dtVdist2D(anim->startPos, anim->endPos) / ag->params.maxSpeed) * 0.5f;
+				
+				ag->state = DT_CROWDAGENT_STATE_OFFMESH;
+				ag->ncorners = 0;
+				ag->nneis = 0;
+				continue;
+			}
+			else
+			{
+				// Path validity check will ensure that bad/blocked connections will be replanned.
+			}
+		}
+	}
+		
+	// Calculate steering.
+	runPhase(DT_CROWD_PHASE_STEERING, &dtCrowd::updateSteering, agents, nagents, dt);
+	
+	// Velocity planning.	
+	for (int i = 0; i < m_nworkers; ++i)
+		m_workerVelocitySampleCount[i] = 0;
+	runPhase(DT_CROWD_PHASE_AVOIDANCE, &dtCrowd::updateAvoidance, agents, nagents, dt);
+	for (int i = 0; i < m_nworkers; ++i)
+		m_velocitySampleCount += m_workerVelocitySampleCount[i];
+
+	// Integrate.
+	runPhase(DT_CROWD_PHASE_INTEGRATE, &dtCrowd::updateIntegration, agents, nagents, dt);
 	
 	// Handle collisions.
 	static const float COLLISION_RESOLVE_FACTOR = 0.7f;
@@ -1388,25 +1564,8 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		}
 	}
 	
-	for (int i = 0; i < nagents; ++i)
-	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		// Move along navmesh.
-		ag->corridor.movePosition(ag->npos, m_navquery, &m_filters[ag->params.queryFilterType]);
-		// Get valid constrained position back.
-		dtVcopy(ag->npos, ag->corridor.getPos());
-
-		// If not using path, truncate the corridor to just one poly.
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-		{
-			ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
-			ag->partial = false;
-		}
-
-	}
+	// Move along navmesh.
+	runPhase(DT_CROWD_PHASE_MOVE, &dtCrowd::updateMovement, agents, nagents, dt);
 	
 	// Update agents using off-mesh connection.
 	for (int i = 0; i < nagents; ++i)
@@ -51,6 +51,11 @@ static const int DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS = 8;
 ///		dtCrowdAgentParams::queryFilterType
 static const int DT_CROWD_MAX_QUERY_FILTER_TYPE = 16;
 
+/// The maximum number of worker threads that can be used to update the crowd.
+/// @ingroup crowd
+/// @see dtCrowd::setJobScheduler()
+static const int DT_CROWD_MAX_WORKERS = 16;
+
 /// Provides neighbor data for agents managed by the crowd.
 /// @ingroup crowd
 /// @see dtCrowdAgent::neis, dtCrowd
@@ -169,6 +174,9 @@ struct dtCrowdAgent
 	dtPathQueueRef targetPathqRef;		///< Path finder ref.
 	bool targetReplan;					///< Flag indicating that the current path is being replanned.
 	float targetReplanTime;				/// <Time since the agent's target was replanned.
+
+	/// The simulation level of detail. 0 for full simulation, 1 for distant agents which skip obstacle avoidance sampling and update the local neighbourhood at lower rate. (See: #dtCrowd::setLOD)
+	unsigned char lod;
 };
 
 struct dtCrowdAgentAnimation
@@ -198,6 +206,36 @@ struct dtCrowdAgentDebugInfo
 	dtObstacleAvoidanceDebugData* vod;
 };
 
+/// The phases of the crowd update that can be executed in parallel.
+/// @ingroup crowd
+/// @see dtCrowdJobScheduler
+enum dtCrowdUpdatePhase
+{
+	DT_CROWD_PHASE_NEIGHBOURHOOD = 0,	///< Local boundary and neighbour agents queries.
+	DT_CROWD_PHASE_CORNERS,				///< Path corners and visibility optimization.
+	DT_CROWD_PHASE_STEERING,			///< Desired velocity and separation.
+	DT_CROWD_PHASE_AVOIDANCE,			///< Obstacle avoidance velocity sampling.
+	DT_CROWD_PHASE_INTEGRATE,			///< Velocity integration.
+	DT_CROWD_PHASE_MOVE,				///< Moving agents along the navmesh surface.
+	DT_CROWD_PHASE_COUNT,
+};
+
+/// Interface used by the crowd to run its update phases on multiple threads.
+/// @ingroup crowd
+/// @see dtCrowd::setJobScheduler()
+class dtCrowdJobScheduler
+{
+public:
+	virtual ~dtCrowdJobScheduler() {}
+
+	/// Executes the jobs and waits for all of them to finish. Jobs can run concurrently.
+	///  @param[in]		phase		The update phase. (See: #dtCrowdUpdatePhase)
+	///  @param[in]		job			The job function, called once for every job index.
+	///  @param[in]		context		The context to pass to the job function.
+	///  @param[in]		count		The number of jobs.
+	virtual void run(const int phase, void (*job)(void* context, const int index), void* context, const int count) = 0;
+};
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
@@ -227,6 +265,43 @@ class dtCrowd
 
 	dtNavMeshQuery* m_navquery;
 
+	dtCrowdJobScheduler* m_scheduler;
+	int m_maxWorkers;
+	int m_nworkers;
+	dtNavMeshQuery* m_workerNavQueries[DT_CROWD_MAX_WORKERS];
+	dtObstacleAvoidanceQuery* m_workerObstacleQueries[DT_CROWD_MAX_WORKERS];
+	int m_workerVelocitySampleCount[DT_CROWD_MAX_WORKERS];
+
+	float m_lodOrigin[3];
+	float m_lodDistance;
+	int m_lodUpdateInterval;
+	unsigned int m_updateCounter;
+
+	int m_nactiveAgents;
+	dtCrowdAgentDebugInfo* m_debug;
+
+	typedef void (dtCrowd::*PhaseFunc)(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	struct PhaseContext
+	{
+		dtCrowd* crowd;
+		PhaseFunc func;
+		dtCrowdAgent** agents;
+		int nagents;
+		int njobs;
+		float dt;
+	};
+	static void runPhaseJob(void* context, const int index);
+	void runPhase(const int phase, PhaseFunc func, dtCrowdAgent** agents, const int nagents, const float dt);
+	void updateNeighbourhood(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	void updateCorners(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	void updateSteering(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	void updateAvoidance(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	void updateIntegration(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	void updateMovement(dtCrowdAgent** agents, const int begin, const int end, const int worker, const float dt);
+	bool initWorkers();
+	void purgeWorkers();
+	inline bool isLODUpdateFrame(const dtCrowdAgent* ag) const { return ag->lod == 0 || m_lodUpdateInterval <= 1 || ((m_updateCounter + (unsigned int)getAgentIndex(ag)) % (unsigned int)m_lodUpdateInterval) == 0; }
+
 	void updateTopologyOptimization(dtCrowdAgent** agents, const int nagents, const float dt);
 	void updateMoveRequest(const float dt);
 	void checkPathValidity(dtCrowdAgent** agents, const int nagents, const float dt);
@@ -316,6 +391,18 @@ class dtCrowd
 	///  @param[in]		dt		The time, in seconds, to update the simulation. [Limit: > 0]
 	///  @param[out]	debug	A debug object to load with debug information. [Opt]
 	void update(const float dt, dtCrowdAgentDebugInfo* debug);
+
+	/// Sets the job scheduler used to run the update phases on multiple threads.
+	///  @param[in]		scheduler	The job scheduler. Use null to update the crowd on the calling thread. [Opt]
+	///  @param[in]		maxWorkers	The maximum number of concurrent jobs. [Limits: 1 <= value <= #DT_CROWD_MAX_WORKERS]
+	/// @return True if the workers data was successfully allocated.
+	bool setJobScheduler(dtCrowdJobScheduler* scheduler, const int maxWorkers);
+
+	/// Sets the agents simulation level of detail. Agents further than the distance from the origin use the simplified simulation. (See: #dtCrowdAgent::lod)
+	///  @param[in]		origin			The level of detail origin. [(x, y, z)]
+	///  @param[in]		distance		The distance (on xz-plane) at which the agents use simplified simulation. Use 0 to disable level of detail.
+	///  @param[in]		updateInterval	The interval (in updates) of the local neighbourhood updates for simplified agents. [Limit: >= 1]
+	void setLOD(const float* origin, const float distance, const int updateInterval);
 	
 	/// Gets the filter used by the crowd.
 	/// @return The filter used by the crowd.
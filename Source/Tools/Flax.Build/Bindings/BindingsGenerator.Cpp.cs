@@ -13,6 +13,7 @@ partial class BindingsGenerator
     {
         private static readonly bool[] CppParamsThatNeedLocalVariable = new bool[64];
         private static readonly bool[] CppParamsThatNeedConversion = new bool[64];
+        private static readonly bool[] CppParamsThatNeedWriteBack = new bool[64];
         private static readonly string[] CppParamsThatNeedConversionWrappers = new string[64];
         private static readonly string[] CppParamsThatNeedConversionTypes = new string[64];
         private static readonly string[] CppParamsWrappersCache = new string[64];
@@ -868,6 +869,18 @@ private static bool GenerateCppWrapperFunctionImplicitBinding(BuildData buildDat
             return false;
         }
 
+        private static bool IsSpanOfScriptingObjectsOutput(BuildData buildData, TypeInfo typeInfo, ApiTypeInfo caller)
+        {
+            // Mutable Span of scripting objects pointers (eg. Span<Collider*>) is used as a caller-provided output buffer so native results has to be written back into the managed array
+            if (typeInfo.Type != "Span" || typeInfo.IsConst || typeInfo.GenericArgs == null || typeInfo.GenericArgs.Count != 1)
+                return false;
+            var elementType = typeInfo.GenericArgs[0];
+            if (!elementType.IsPtr || elementType.IsConst)
+                return false;
+            var apiType = FindApiTypeInfo(buildData, elementType, caller);
+            return apiType != null && apiType.IsScriptingObject;
+        }
+
         private static bool GenerateCppWrapperFunctionImplicitBinding(BuildData buildData, FunctionInfo functionInfo, ApiTypeInfo caller)
         {
             if (!functionInfo.IsStatic || functionInfo.Access != AccessLevel.Public || (functionInfo.Glue.CustomParameters != null && functionInfo.Glue.CustomParameters.Count != 0))
@@ -942,6 +955,9 @@ private static void GenerateCppWrapperFunction(BuildData buildData, StringBuilde
 
                 CppParamsThatNeedConversion[i] = false;
                 CppParamsWrappersCache[i] = GenerateCppWrapperManagedToNative(buildData, parameterInfo.Type, caller, out var managedType, out var apiType, functionInfo, out CppParamsThatNeedLocalVariable[i]);
+                CppParamsThatNeedWriteBack[i] = IsSpanOfScriptingObjectsOutput(buildData, parameterInfo.Type, caller);
+                if (CppParamsThatNeedWriteBack[i])
+                    useInlinedReturn = false;
 
                 // Out parameters that need additional converting will be converted at the native side (eg. object reference)
                 var isOutWithManagedConverter = parameterInfo.IsOut && !string.IsNullOrEmpty(GenerateCSharpManagedToNativeConverter(buildData, parameterInfo.Type, caller));
@@ -1083,6 +1099,12 @@ private static void GenerateCppWrapperFunction(BuildData buildData, StringBuilde
                         callParams += "Temp";
                     }
                 }
+                // Special case for output buffer of objects that is converted into native array (written back to the managed array after the call)
+                else if (CppParamsThatNeedWriteBack[i])
+                {
+                    contents.AppendFormat("        auto {0}Temp = MUtils::ToArray<{1}>({0});", parameterInfo.Name, parameterInfo.Type.GenericArgs[0]).AppendLine();
+                    callParams += string.Format("MUtils::ToSpan({0}Temp)", parameterInfo.Name);
+                }
                 // Special case for parameter that cannot be passed directly to the function from the wrapper method input parameter (eg. MonoArray* converted into BytesContainer uses as BytesContainer&)
                 else if (CppParamsThatNeedLocalVariable[i])
                 {
@@ -1156,6 +1178,11 @@ private static void GenerateCppWrapperFunction(BuildData buildData, StringBuilde
                         }
                         contents.AppendFormat("        *{0} = {1};", parameterInfo.Name, value).AppendLine();
                     }
+                    // Output buffer of objects written by the native code into the caller-provided managed array (no new managed array allocated)
+                    else if (CppParamsThatNeedWriteBack[i])
+                    {
+                        contents.AppendFormat("        MUtils::CopyToArray({0}, MUtils::ToSpan({0}Temp));", parameterInfo.Name).AppendLine();
+                    }
                 }
             }
 
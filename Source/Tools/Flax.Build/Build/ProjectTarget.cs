@@ -76,6 +76,14 @@ public override void SetupTargetEnvironment(BuildOptions options)
                 options.CompileEnv.PreprocessorDefinitions.Add("USE_LARGE_WORLDS");
                 options.ScriptingAPI.Defines.Add("USE_LARGE_WORLDS");
             }
+            if (EngineConfiguration.UseThreadCacheAllocator)
+            {
+                options.CompileEnv.PreprocessorDefinitions.Add("USE_THREAD_CACHE_ALLOCATOR");
+            }
+            if (EngineConfiguration.WithMemoryTracking(options))
+            {
+                options.CompileEnv.PreprocessorDefinitions.Add("COMPILE_WITH_MEMORY_TRACKING");
+            }
 
             // Add include paths for this and all referenced projects sources
             foreach (var project in Project.GetAllProjects())
@@ -236,6 +236,18 @@ public static partial class EngineConfiguration
         [CommandLine("useLargeWorlds", "1 to enable large worlds with 64-bit coordinates precision support in build (USE_LARGE_WORLDS=1)")]
         public static bool UseLargeWorlds = false;
 
+        /// <summary>
+        /// 1 to use the scalable thread-caching memory allocator as the engine Allocator instead of the CRT allocator (USE_THREAD_CACHE_ALLOCATOR=1).
+        /// </summary>
+        [CommandLine("useThreadCacheAllocator", "1 to use the scalable thread-caching memory allocator as the engine Allocator instead of the CRT allocator (USE_THREAD_CACHE_ALLOCATOR=1)")]
+        public static bool UseThreadCacheAllocator = false;
+
+        /// <summary>
+        /// 1 to enable native memory allocations tracking per engine subsystem in builds with profiler (COMPILE_WITH_MEMORY_TRACKING=1).
+        /// </summary>
+        [CommandLine("useMemoryTracking", "1 to enable native memory allocations tracking per engine subsystem in builds with profiler (COMPILE_WITH_MEMORY_TRACKING=1)")]
+        public static bool UseMemoryTracking = false;
+
         /// <summary>
         /// True if managed C# scripting should be enabled, otherwise false. Engine without C# is partially supported and can be used when porting to a new platform before implementing C# runtime on it.
         /// </summary>
@@ -249,6 +261,12 @@ public static bool WithCSharp(NativeCpp.BuildOptions options)
             return UseCSharp || options.Target.IsEditor;
         }
 
+        public static bool WithMemoryTracking(NativeCpp.BuildOptions options)
+        {
+            // Tracking is a part of the profiler tools so skip it in Release game builds
+            return UseMemoryTracking && (options.Configuration != TargetConfiguration.Release || options.Target.IsEditor);
+        }
+
         public static bool WithLargeWorlds(NativeCpp.BuildOptions options)
         {
             // This can be used to selectively control 64-bit coordinates per-platform or build configuration